@@ -1,9 +1,19 @@
 #pragma once
 
 #include <glm/vec2.hpp>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/PerformanceHud.h"
+#include "pers/core/DamageTracker.h"
+#include "pers/core/DeviceStartup.h"
+#include "pers/core/FramePacer.h"
+#include "pers/core/JobSystem.h"
+#include "pers/core/RenderThread.h"
+#include "pers/utils/ThreadAffinity.h"
 
 class IWindow;
 class IWindowFactory;
@@ -11,10 +21,66 @@ class IWindowFactory;
 namespace pers {
     class IGraphicsInstanceFactory;
     class IInstance;
+    class ILogicalDevice;
+    struct InstanceDesc;
 
 /**
  * Base application class providing common functionality for graphics applications
  * Handles window creation, graphics initialization, and lifecycle management
+ *
+ * initializeHeadless() skips the window and surface entirely, for batch
+ * rendering on machines without a display. Request the physical device
+ * without a compatibleSurface and render into offscreen framebuffers
+ * (see OffscreenRenderQueue); run() then loops until requestExit().
+ *
+ * Overriding onConfigureStartup() moves adapter and device creation onto a
+ * worker that runs while the window is created. onInitialize() then picks
+ * the device up with getDeviceStartup().wait().
+ *
+ * getJobSystem() schedules work across cores from onUpdate() and onRender():
+ * culling, animation, command encoding, asset decode. Jobs may outlive the
+ * frame that spawned them, so wait on the handles a frame depends on. All
+ * jobs are finished before onCleanup() runs.
+ *
+ * _threadAffinity places the main, render, worker, IO and logger threads,
+ * e.g. ThreadAffinityConfig::latencyFocused() keeps the main and render
+ * threads on performance cores and spreads workers over NUMA nodes.
+ *
+ * With _pipelinedRendering set, onRender() runs on a dedicated render thread
+ * one frame behind: while it encodes and submits frame N, the main thread
+ * polls input and runs onUpdate() for frame N+1. Between the two,
+ * onPublishFrame() runs on the main thread with the render thread idle; hand
+ * the simulated state over there, e.g. with FrameSnapshot. onRender() must
+ * then only read that snapshot, never state onUpdate() writes.
+ *
+ * Tools with several viewports open more windows with createViewportWindow()
+ * and give each its own surface, all on one logical device; present them
+ * together with SurfacePresentGroup. The main window still ends run() when
+ * closed, viewport windows are closed by the derived class.
+ *
+ * With _renderOnDemand set, run() blocks in IWindow::waitEvents() while
+ * nothing is damaged and skips onRender() for frames without damage, so an
+ * idle window costs no CPU or GPU time. Key presses, resizes and window
+ * refreshes damage the whole frame; anything else calls requestRedraw(),
+ * from any thread, with or without a rect. onRender() reads the frame's
+ * damage from getRenderDamage() and may scissor to it (see DamageTracker).
+ * _onDemandTimeout wakes the loop for an onUpdate() without input, e.g.
+ * to poll data; deltaTime then spans the whole wait. Headless runs render
+ * every frame.
+ *
+ * Rendering continuously under a frame cap, run() spends the time the
+ * FramePacer leaves to spare blocked in IWindow::waitEvents() as well, so the
+ * loop handles input during the wait instead of sleeping and spinning.
+ *
+ * In builds with PERS_ALLOCATION_TRACKING, each frame from onUpdate() to
+ * the end of onRender() (on the render thread as well) is an
+ * AllocationFrameScope; set AllocationTracker's mode to have heap
+ * allocations there reported once warmup frames are over.
+ *
+ * enablePerformanceHud() creates a PerformanceHud that run() feeds with
+ * frame times and FramePacer stats every frame; _performanceHudKey toggles
+ * it. onRender() records it into its last pass while it is visible and may
+ * hand it GpuPassTimer reports and the backend's caches.
  */
 class Application {
 public:
@@ -25,18 +91,34 @@ public:
     bool initialize(const std::shared_ptr<IWindowFactory>& windowFactory, 
                    const std::shared_ptr<pers::IGraphicsInstanceFactory>& graphicsFactory);
     
+    // Initialize without window or surface
+    bool initializeHeadless(const std::shared_ptr<pers::IGraphicsInstanceFactory>& graphicsFactory);
+    
     // Main run loop
     void run();
     
+    // Leave run() after the current frame
+    void requestExit() { _exitRequested = true; }
+    
+    bool isHeadless() const { return _headless; }
+    
+    // Damage the whole frame, or one region of it; wakes run() in on-demand mode
+    void requestRedraw();
+    void requestRedraw(const pers::DamageRect& rect);
+    
     // Accessor methods
     glm::ivec2 getFramebufferSize() const;
     
 protected:
     // Virtual methods for derived classes to override
     virtual bool onInitialize() { return true; }  // Called after window and instance are created
+    virtual void onConfigureInstance(pers::InstanceDesc& desc) {} // Adjust instance settings, e.g. desc = pers::InstanceDesc::fastInit()
+    virtual bool onConfigureStartup(pers::DeviceStartup& startup, pers::DeviceStartupDesc& desc) { return false; } // Return true to create the device during window creation
     virtual void onUpdate(float deltaTime) {}      // Called each frame
     virtual void onRender() {}                     // Called each frame for rendering
+    virtual void onPublishFrame() {}               // Pipelined mode: between onUpdate and onRender, render thread idle
     virtual void onResize(int width, int height) {} // Window resize event
+    virtual void onViewportResize(IWindow* window, int width, int height) {} // Viewport window resize event
     virtual void onKeyPress(int key, int scancode, int action, int mods) {} // Key press event
     virtual void onCleanup() {}                    // Called before cleanup
     
@@ -46,16 +128,51 @@ protected:
     
     // Helper method for surface creation
     pers::NativeSurfaceHandle createSurface() const;
+    pers::NativeSurfaceHandle createSurface(IWindow& window) const;
+    
+    // Additional window sharing the instance and device, owned until destroyed or cleanup
+    IWindow* createViewportWindow(int width, int height, const std::string& title);
+    void destroyViewportWindow(IWindow* window);
+    
+    // Device started by onConfigureStartup(), not started otherwise
+    pers::DeviceStartup& getDeviceStartup() { return _deviceStartup; }
+    
+    // Frame pacing used by run(); report each frame's last submission with trackSubmission()
+    pers::FramePacer& getFramePacer() { return _framePacer; }
+    
+    // Work-stealing job scheduler, created by initialize()
+    pers::JobSystem& getJobSystem() { return *_jobSystem; }
+    
+    // Damage of the frame onRender() is drawing, the whole frame outside on-demand mode
+    const pers::DamageTracker& getRenderDamage() const { return _renderDamage; }
+    
+    // Live overlay of frame, GPU, memory and cache stats, null until enabled
+    pers::PerformanceHud* enablePerformanceHud(const std::shared_ptr<pers::ILogicalDevice>& device,
+                                               const pers::PerformanceHud::Config& config = {});
+    pers::PerformanceHud* getPerformanceHud() const { return _performanceHud.get(); }
+    void setPerformanceHudVisible(bool visible);
+    bool isPerformanceHudVisible() const { return _performanceHud && _performanceHudVisible; }
     
 private:
     // Initialization methods
     bool createWindow();
     bool setupWindowCallbacks();
     bool createInstance();
+    void createJobSystem();
+    void beginDeviceStartup();
     
     // Runtime methods
     void cleanup();
     
+    // Render on the calling thread outside the loop, e.g. during a resize
+    void renderNow();
+    
+    // On-demand mode: wait on window events until damaged, closed or timed out
+    void waitForRedraw();
+    
+    // Move the accumulated damage to the frame about to render, false if clean
+    bool takeDamage();
+    
     // Event handlers (forward to virtual methods)
     void handleResize(int width, int height);
     void handleKeyPress(int key, int scancode, int action, int mods);
@@ -70,6 +187,24 @@ protected:
     int _windowHeight = DEFAULT_HEIGHT;
     std::string _windowTitle = "Application";
     
+    // Job system worker threads, 0 = hardware concurrency - 1
+    uint32_t _jobWorkerCount = 0;
+    
+    // Core and NUMA placement per engine thread role, applied by initialize(); OS scheduling by default
+    pers::ThreadAffinityConfig _threadAffinity;
+    
+    // Render on a dedicated thread one frame behind simulation (read by run())
+    bool _pipelinedRendering = false;
+    
+    // Render only damaged frames, sleeping on window events in between (read by run())
+    bool _renderOnDemand = false;
+    
+    // Longest on-demand wait before an onUpdate() without damage, < 0 = until an event
+    double _onDemandTimeout = -1.0;
+    
+    // Key toggling the performance HUD, GLFW_KEY_F3 by default, < 0 = none
+    int _performanceHudKey = 292;
+    
 private:
     // Factories
     std::shared_ptr<IWindowFactory> _windowFactory;
@@ -77,7 +212,23 @@ private:
     
     // Created resources
     std::unique_ptr<IWindow> _window;
+    std::vector<std::unique_ptr<IWindow>> _viewportWindows;
     std::shared_ptr<pers::IInstance> _instance;
+    
+    pers::DeviceStartup _deviceStartup;
+    pers::FramePacer _framePacer;
+    std::unique_ptr<pers::JobSystem> _jobSystem;
+    std::unique_ptr<pers::RenderThread> _renderThread;  // Pipelined mode only, while run() runs
+    
+    std::mutex _damageMutex;  // Guards _damage, requestRedraw() may come from any thread
+    pers::DamageTracker _damage;
+    pers::DamageTracker _renderDamage;
+    
+    std::unique_ptr<pers::PerformanceHud> _performanceHud;
+    std::atomic<bool> _performanceHudVisible{true};  // Read by the render thread in pipelined mode
+    
+    bool _headless = false;
+    bool _exitRequested = false;
 };
 
 }
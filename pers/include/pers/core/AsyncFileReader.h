@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace pers {
+
+class ImmediateStagingBuffer;
+
+/**
+ * @brief Asynchronous file reads on the platform's native IO queue
+ *
+ * Reads go straight into caller memory, typically the mapped range of an
+ * ImmediateStagingBuffer, so cooked asset blobs reach staging without an
+ * intermediate copy while decode and upload of earlier reads carry on.
+ *
+ * Backends, picked at construction:
+ * - IoUring: one ring per reader on Linux, batched submits, completions
+ *   reaped on the reader's IO thread.
+ * - CompletionPort: overlapped ReadFile on an IOCP on Windows.
+ * - ThreadPool: pread workers; used on macOS, and when io_uring is
+ *   unavailable (old kernels, seccomp) or forceThreadPool is set.
+ *
+ * Completions run on an IO thread: keep them short or hand off to JobSystem.
+ * Files are opened on first use and stay open until closeFile() or
+ * destruction. Short reads at end of file complete with success false and
+ * the bytes actually read.
+ *
+ *   AsyncFileReader reader;
+ *   reader.readIntoStaging(path, blobs.vertexOffset, vertexBytes, staging, 0,
+ *       [](const AsyncFileReader::Result& result) { ... });
+ */
+class AsyncFileReader {
+public:
+    enum class Backend {
+        IoUring,
+        CompletionPort,
+        ThreadPool
+    };
+
+    struct Result {
+        bool success = false;
+        uint64_t bytesRead = 0;
+        int error = 0;  // errno or GetLastError() of the failing call, 0 on success
+    };
+
+    using Completion = std::function<void(const Result& result)>;
+
+    struct Desc {
+        uint32_t queueDepth = 64;    // Reads in flight at once
+        uint32_t threadCount = 2;    // ThreadPool backend only
+        bool forceThreadPool = false;
+    };
+
+    struct Stats {
+        uint64_t reads = 0;         // Completed reads
+        uint64_t failedReads = 0;
+        uint64_t bytesRead = 0;
+        uint64_t submitCalls = 0;   // io_uring_enter / ReadFile / pread calls
+    };
+
+    AsyncFileReader();
+    explicit AsyncFileReader(const Desc& desc);
+
+    /**
+     * @brief Completes every queued read, then closes the files
+     */
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    /**
+     * @brief Queue a read of size bytes at offset into destination
+     * destination must stay valid until the completion has run.
+     * @return false if the file cannot be opened; completion is not called then
+     */
+    bool read(const std::string& path, uint64_t offset, uint64_t size, void* destination, Completion completion);
+
+    /**
+     * @brief Queue a read into the mapped memory of an unfinalized staging buffer
+     * The buffer is kept alive until the completion has run.
+     * @return false if the range is outside the mapping or the file cannot be opened
+     */
+    bool readIntoStaging(const std::string& path, uint64_t offset, uint64_t size,
+                         const std::shared_ptr<ImmediateStagingBuffer>& staging, uint64_t stagingOffset,
+                         Completion completion);
+
+    /**
+     * @brief Close a file once no read of it is queued or in flight
+     */
+    void closeFile(const std::string& path);
+
+    /**
+     * @brief Block until every read queued so far has completed
+     */
+    void waitIdle();
+
+    Backend getBackend() const;
+    Stats getStats() const;
+
+    static const char* getBackendName(Backend backend);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> _impl;
+};
+
+} // namespace pers
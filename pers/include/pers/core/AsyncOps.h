@@ -0,0 +1,136 @@
+#pragma once
+
+#include "pers/core/DeviceStartup.h"
+#include "pers/core/JobSystem.h"
+#include "pers/core/Task.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+namespace detail {
+
+/**
+ * @brief Awaits an operation that reports its result through a callback
+ *
+ * start receives the function to deliver the result with. It may run on any
+ * thread, including synchronously inside start; the coroutine resumes on
+ * that thread.
+ */
+template<typename T>
+class CallbackAwaiter {
+public:
+    using Deliver = std::function<void(T value)>;
+    using Start = std::function<void(Deliver deliver)>;
+
+    explicit CallbackAwaiter(Start start) : _start(std::move(start)) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        _handle = handle;
+        _start([this](T value) {
+            _result.emplace(std::move(value));
+            const std::coroutine_handle<> resume = _handle;
+            // Whoever comes second resumes: this callback, or await_suspend below
+            if (_delivered.exchange(true, std::memory_order_acq_rel)) {
+                resume.resume();
+            }
+        });
+        return !_delivered.exchange(true, std::memory_order_acq_rel);
+    }
+
+    T await_resume() { return std::move(*_result); }
+
+private:
+    Start _start;
+    std::coroutine_handle<> _handle;
+    std::optional<T> _result;
+    std::atomic<bool> _delivered{false};
+};
+
+} // namespace detail
+
+/**
+ * @brief Map a staging buffer; resumes on the event pump with the mapping
+ * The MappedData is empty (data() == nullptr) if the map failed.
+ */
+inline detail::CallbackAwaiter<MappedData> awaitMap(const std::shared_ptr<DeferredStagingBuffer>& buffer,
+                                                     MapMode mode = MapMode::Read,
+                                                     const BufferMapRange& range = {}) {
+    return detail::CallbackAwaiter<MappedData>([buffer, mode, range](auto deliver) {
+        // On failure the callback has already run with an empty mapping
+        buffer->mapAsync(mode, range, std::move(deliver));
+    });
+}
+
+/**
+ * @brief Wait for queue work; resumes with true once the submission completed
+ */
+inline detail::CallbackAwaiter<bool> awaitFence(const SubmissionFence& fence) {
+    return detail::CallbackAwaiter<bool>([fence](auto deliver) {
+        fence.then(std::move(deliver));
+    });
+}
+
+/**
+ * @brief Wait for an async pipeline; resumes with the pipeline, null if it failed
+ */
+inline detail::CallbackAwaiter<std::shared_ptr<IRenderPipeline>> awaitPipeline(
+    const std::shared_ptr<AsyncRenderPipeline>& pipeline) {
+    return detail::CallbackAwaiter<std::shared_ptr<IRenderPipeline>>([pipeline](auto deliver) {
+        if (!pipeline) {
+            deliver(nullptr);
+            return;
+        }
+        pipeline->then([deliver = std::move(deliver)](const std::shared_ptr<IRenderPipeline>& compiled) {
+            deliver(compiled);
+        });
+    });
+}
+
+/**
+ * @brief Continue the coroutine as a job, e.g. before blocking or heavy work
+ */
+inline auto resumeOn(JobSystem& jobs) {
+    struct Awaiter {
+        JobSystem& jobs;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const {
+            jobs.schedule([handle] { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+    return Awaiter{jobs};
+}
+
+/**
+ * @brief Read a whole file on a job worker
+ * @return The contents, or nullopt if the file could not be read
+ */
+Task<std::optional<std::vector<std::byte>>> readFileAsync(JobSystem& jobs, std::string path);
+
+struct DeviceRequestResult {
+    std::shared_ptr<IPhysicalDevice> physicalDevice;
+    std::shared_ptr<ILogicalDevice> logicalDevice;  // Null if the request failed
+};
+
+/**
+ * @brief Request an adapter and create a device on a job worker
+ * The backend request blocks while it pumps instance events; running it as a
+ * job keeps the awaiting thread free.
+ */
+Task<DeviceRequestResult> requestDeviceAsync(JobSystem& jobs, std::shared_ptr<IInstance> instance,
+                                             DeviceStartupDesc desc);
+
+} // namespace pers
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Region of the framebuffer in pixels, origin top-left
+ */
+struct DamageRect {
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    bool isEmpty() const { return width == 0 || height == 0; }
+};
+
+/**
+ * @brief Accumulates the regions that changed since the last rendered frame
+ *
+ * invalidate() without a rect damages the whole frame. Rects are kept as
+ * submitted up to MAX_RECTS; past that they collapse into their bounds, so
+ * a burst of small updates costs one scissor instead of many. Not thread
+ * safe, Application guards its tracker.
+ *
+ * Partial redraw needs the previous contents: render into a persistent
+ * OffscreenFramebuffer with LoadOp::Load and setScissorRect(getBounds()),
+ * then copy it to the surface. Swapchain images rotate and keep no
+ * history, so they cannot be the scissored target themselves.
+ */
+class DamageTracker {
+public:
+    static constexpr size_t MAX_RECTS = 8;
+
+    void invalidate();
+    void invalidate(const DamageRect& rect);
+    void merge(const DamageTracker& other);
+    void clear();
+
+    bool isDirty() const { return _fullFrame || !_rects.empty(); }
+    bool isFullFrame() const { return _fullFrame; }
+
+    /**
+     * @brief Damaged rects clipped to a width x height framebuffer; one full rect when the frame is dirty
+     */
+    std::vector<DamageRect> getRects(uint32_t width, uint32_t height) const;
+
+    /**
+     * @brief Union of the damage clipped to the framebuffer, empty when clean
+     */
+    DamageRect getBounds(uint32_t width, uint32_t height) const;
+
+private:
+    std::vector<DamageRect> _rects;
+    bool _fullFrame = false;
+};
+
+} // namespace pers
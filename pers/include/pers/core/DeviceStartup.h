@@ -0,0 +1,110 @@
+#pragma once
+
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+
+/**
+ * @brief Startup request for DeviceStartup
+ *
+ * physicalDevice.compatibleSurface is ignored: the window does not exist yet
+ * when the request starts. Check the adapter against the surface with
+ * DeviceStartup::supportsSurface() once it has been created.
+ */
+struct DeviceStartupDesc {
+    PhysicalDeviceOptions physicalDevice;
+    LogicalDeviceDesc logicalDevice;
+};
+
+/**
+ * @brief Requests the adapter and creates the device on a worker thread
+ *
+ * Adapter and device creation take a large share of time-to-first-frame and
+ * do not need the window, so Application starts them before creating it.
+ * Callbacks added with onDeviceReady() run on the worker as soon as the
+ * device exists, which lets shader modules and async pipelines start
+ * compiling while the main thread is still busy with the window:
+ *
+ *     startup.onDeviceReady([&](const auto& device) {
+ *         _pipeline = device->getResourceFactory()->createRenderPipelineAsync(desc);
+ *     });
+ *     startup.begin(instance, desc);
+ *     createWindow();
+ *     auto device = startup.wait();
+ *
+ * Callbacks must be added before begin(). wait() returns after they ran.
+ */
+class DeviceStartup {
+public:
+    using DeviceReadyCallback = std::function<void(const std::shared_ptr<ILogicalDevice>& device)>;
+
+    DeviceStartup() = default;
+    ~DeviceStartup();
+
+    DeviceStartup(const DeviceStartup&) = delete;
+    DeviceStartup& operator=(const DeviceStartup&) = delete;
+
+    /**
+     * @brief Add work to run on the worker right after the device is created
+     */
+    void onDeviceReady(DeviceReadyCallback callback);
+
+    /**
+     * @brief Start the adapter request and device creation
+     * @return false if already started or the instance is null
+     */
+    bool begin(const std::shared_ptr<IInstance>& instance, const DeviceStartupDesc& desc);
+
+    bool isStarted() const { return _started; }
+
+    /**
+     * @brief Block until the device and its ready callbacks are done
+     * @return The device, or nullptr if creation failed or never started
+     */
+    std::shared_ptr<ILogicalDevice> wait();
+
+    /**
+     * @brief Physical device picked by the worker, null until wait() returned
+     */
+    std::shared_ptr<IPhysicalDevice> getPhysicalDevice() const;
+    std::shared_ptr<ILogicalDevice> getLogicalDevice() const;
+
+    /**
+     * @brief Check the adapter against the window surface, waiting for it first
+     *
+     * When this fails, request an adapter with compatibleSurface set instead.
+     */
+    bool supportsSurface(const NativeSurfaceHandle& surface);
+
+    /**
+     * @brief Time from begin() until the device and callbacks were done
+     */
+    std::chrono::microseconds getElapsed() const;
+
+private:
+    void run(std::shared_ptr<IInstance> instance, DeviceStartupDesc desc);
+
+    std::vector<DeviceReadyCallback> _callbacks;
+    std::thread _worker;
+    bool _started = false;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _done;
+    std::shared_ptr<IPhysicalDevice> _physicalDevice;
+    std::shared_ptr<ILogicalDevice> _logicalDevice;
+    std::chrono::steady_clock::time_point _startTime;
+    std::chrono::microseconds _elapsed{0};
+    bool _finished = false;
+};
+
+} // namespace pers
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "pers/graphics/SubmissionFence.h"
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace pers {
+
+struct FramePacerConfig {
+    // Frames submitted but not retired by the GPU before beginFrame blocks
+    uint32_t maxFramesInFlight = 2;
+    
+    // Frame rate cap, 0 = uncapped
+    double targetFps = 0.0;
+    
+    // Keep one frame in flight and start CPU work as late as the cap allows,
+    // so input is sampled just before the expected present
+    bool lowLatency = false;
+    
+    // Safety margin subtracted from the predicted CPU time in low latency mode
+    std::chrono::microseconds lowLatencyMargin{1000};
+};
+
+/**
+ * @brief Paces the application loop against GPU completion and a frame cap
+ *
+ * beginFrame() blocks until the frame may start: the oldest in-flight
+ * submission has retired if the limit is reached, then the cap deadline
+ * has passed. Poll input after it returns. Report the frame's last
+ * submission with trackSubmission(); frames without one only count
+ * against the cap.
+ *
+ * In low latency mode the loop waits for the previous frame's GPU work and
+ * aims to finish CPU work at the cap deadline, using the smoothed CPU time
+ * of recent frames, instead of starting right at it.
+ *
+ * trackSubmission() may be called from a render thread while the main thread
+ * is in beginFrame(). A frame's submissions normally end at the next
+ * beginFrame(); with setRenderThreadSubmissions(true) they end at
+ * endSubmissions() instead, called by the render thread after each frame.
+ *
+ * The time the cap leaves to spare is slept away by default. With
+ * setIdleWait() it goes to a blocking event wait instead, so a window
+ * handles input while the thread idles rather than sleeping or spinning;
+ * Application installs IWindow::waitEvents there.
+ */
+class FramePacer {
+public:
+    struct Stats {
+        double cpuTimeMs = 0.0;      // beginFrame return to endFrame, smoothed
+        double gpuLatencyMs = 0.0;   // Submit to observed completion, smoothed
+        double waitTimeMs = 0.0;     // Blocked in the last beginFrame
+        uint32_t framesInFlight = 0;
+    };
+
+    explicit FramePacer(const FramePacerConfig& config = {});
+
+    void setConfig(const FramePacerConfig& config);
+    const FramePacerConfig& getConfig() const { return _config; }
+
+    /**
+     * @brief Wait until the next frame may start
+     * @return Seconds since the previous beginFrame returned, 0 for the first frame
+     */
+    float beginFrame();
+
+    /**
+     * @brief Track the frame's final submission for the frames-in-flight limit
+     * Calling it again in the same frame replaces the earlier fence.
+     */
+    void trackSubmission(const SubmissionFence& fence);
+
+    void endFrame();
+
+    /**
+     * @brief End the current frame's submissions
+     * Only needed with setRenderThreadSubmissions(true).
+     */
+    void endSubmissions();
+
+    // Frames are submitted by a render thread that lags the main thread by a frame
+    void setRenderThreadSubmissions(bool enabled);
+
+    Stats getStats() const;
+
+    // Blocks for at most the given seconds and may return early, e.g. on a window event
+    using IdleWait = std::function<void(double seconds)>;
+
+    /**
+     * @brief Wait through the frame cap's spare time with wait instead of sleeping
+     * Called on the beginFrame() thread; an empty function restores sleeping.
+     */
+    void setIdleWait(IdleWait wait) { _idleWait = std::move(wait); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct InFlightFrame {
+        SubmissionFence fence;
+        Clock::time_point submitted;
+    };
+
+    void retire(const InFlightFrame& frame, Clock::time_point now);
+    void sleepUntil(Clock::time_point deadline);
+
+    FramePacerConfig _config;
+    IdleWait _idleWait;
+
+    mutable std::mutex _mutex;  // Guards the in-flight list, shared with the render thread
+    std::deque<InFlightFrame> _inFlight;
+    bool _renderThreadSubmissions = false;
+
+    Clock::time_point _frameStart{};
+    Clock::time_point _nextDeadline{};
+    bool _started = false;
+    bool _submittedThisFrame = false;
+
+    double _cpuTimeUs = 0.0;
+    double _gpuLatencyUs = 0.0;
+    double _waitTimeUs = 0.0;
+};
+
+} // namespace pers
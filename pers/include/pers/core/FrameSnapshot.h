@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pers {
+
+/**
+ * @brief Double-buffered state handed from simulation to rendering
+ *
+ * In Application's pipelined mode, onUpdate() fills write() for frame N+1
+ * while the render thread reads read() for frame N. publish() swaps them and
+ * must be called while the render thread is idle, i.e. from onPublishFrame().
+ *
+ *     struct SceneSnapshot { std::vector<glm::mat4> transforms; glm::mat4 viewProjection; };
+ *     FrameSnapshot<SceneSnapshot> _snapshot;
+ *
+ *     void onUpdate(float dt) override { simulate(dt); fill(_snapshot.write()); }
+ *     void onPublishFrame() override { _snapshot.publish(); }
+ *     void onRender() override { draw(_snapshot.read()); }
+ *
+ * The buffers are reused; write() still holds the contents of two frames ago,
+ * so containers keep their capacity across frames.
+ */
+template<typename T>
+class FrameSnapshot {
+public:
+    FrameSnapshot() = default;
+    explicit FrameSnapshot(const T& initial) : _buffers{initial, initial} {}
+
+    T& write() { return _buffers[_writeIndex]; }
+    const T& read() const { return _buffers[_writeIndex ^ 1u]; }
+
+    void publish() { _writeIndex ^= 1u; }
+
+private:
+    T _buffers[2]{};
+    uint32_t _writeIndex = 0;
+};
+
+} // namespace pers
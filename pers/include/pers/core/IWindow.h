@@ -33,6 +33,10 @@ public:
     
     // Event handling
     virtual void pollEvents() = 0;
+    // Block until an event arrives or timeoutSeconds pass (< 0 = no timeout), then process events
+    virtual void waitEvents(double timeoutSeconds = -1.0) = 0;
+    // Wake a waitEvents() in progress; callable from any thread
+    virtual void postEmptyEvent() = 0;
     virtual void setResizeCallback(ResizeCallback callback) = 0;
     virtual void setKeyCallback(KeyCallback callback) = 0;
     virtual void setRefreshCallback(RefreshCallback callback) = 0;
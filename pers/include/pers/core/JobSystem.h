@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+class JobSystem;
+
+namespace detail {
+
+struct Job {
+    std::function<void()> task;
+    std::atomic<uint32_t> pendingDependencies{1};  // Held by schedule() until registered
+    std::atomic<bool> finished{false};
+
+    std::mutex dependentsMutex;
+    std::vector<std::shared_ptr<Job>> dependents;  // Scheduled when this job finishes
+};
+
+} // namespace detail
+
+/**
+ * @brief Completion handle of a scheduled job
+ * An empty handle counts as complete, so it can be passed as a dependency.
+ */
+class JobHandle {
+public:
+    JobHandle() = default;
+
+    bool isValid() const { return _job != nullptr; }
+    explicit operator bool() const { return isValid(); }
+
+    bool isComplete() const { return !_job || _job->finished.load(std::memory_order_acquire); }
+
+private:
+    friend class JobSystem;
+    explicit JobHandle(std::shared_ptr<detail::Job> job) : _job(std::move(job)) {}
+
+    std::shared_ptr<detail::Job> _job;
+};
+
+/**
+ * @brief Work-stealing scheduler for frame jobs
+ *
+ * Each worker owns a deque: jobs scheduled from a worker go to the back of
+ * its own deque and are popped from there (newest first, still hot in the
+ * cache), idle workers steal from the front of other deques. Jobs scheduled
+ * from other threads go to a shared deque that every worker steals from.
+ *
+ * A job runs once all of its dependencies have finished:
+ *
+ *     auto cull = jobs.parallelFor(objectCount, 64, [&](uint32_t begin, uint32_t end) { ... });
+ *     auto animate = jobs.schedule([&] { ... });
+ *     auto encode = jobs.schedule([&] { ... }, {cull, animate});
+ *     jobs.wait(encode);
+ *
+ * wait() runs other jobs while the awaited one is pending, so waiting from
+ * inside a job neither deadlocks nor idles the core. Jobs must not block on
+ * anything but wait().
+ */
+class JobSystem {
+public:
+    using ParallelForTask = std::function<void(uint32_t begin, uint32_t end)>;
+
+    /**
+     * @param workerCount Worker threads, 0 = hardware concurrency - 1 (at least one)
+     */
+    explicit JobSystem(uint32_t workerCount = 0);
+
+    /**
+     * @brief Finishes every scheduled job, then stops the workers
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    JobHandle schedule(std::function<void()> task, std::span<const JobHandle> dependencies = {});
+    JobHandle schedule(std::function<void()> task, std::initializer_list<JobHandle> dependencies) {
+        return schedule(std::move(task), std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+    }
+
+    /**
+     * @brief Split [0, count) into batches of batchSize run as separate jobs
+     * @return Handle completing when every batch has run
+     */
+    JobHandle parallelFor(uint32_t count, uint32_t batchSize, ParallelForTask task,
+                          std::span<const JobHandle> dependencies = {});
+    JobHandle parallelFor(uint32_t count, uint32_t batchSize, ParallelForTask task,
+                          std::initializer_list<JobHandle> dependencies) {
+        return parallelFor(count, batchSize, std::move(task),
+                           std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+    }
+
+    /**
+     * @brief Run jobs on the calling thread until the handle completes
+     */
+    void wait(const JobHandle& handle);
+
+    /**
+     * @brief Run jobs on the calling thread until nothing is scheduled or running
+     */
+    void waitIdle();
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::shared_ptr<detail::Job>> jobs;
+    };
+
+    void enqueue(std::shared_ptr<detail::Job> job);
+    void release(const std::shared_ptr<detail::Job>& job);  // Drops one pending dependency
+    std::shared_ptr<detail::Job> take(uint32_t queueIndex);
+    bool runOne(uint32_t queueIndex);
+    void execute(const std::shared_ptr<detail::Job>& job);
+    void sleepUntil(std::condition_variable& condition, std::atomic<uint32_t>& sleepers,
+                    const std::function<bool()>& ready);
+    void workerLoop(uint32_t queueIndex);
+    uint32_t currentQueue() const;
+
+    // Index 0 is shared by threads outside the pool, workers use 1..N
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::atomic<uint32_t> _queuedJobs{0};
+    std::atomic<uint32_t> _unfinishedJobs{0};  // Scheduled, not yet finished
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;       // Idle workers, on new work
+    std::condition_variable _completed;  // Threads in wait(), on new work or a finished job
+    std::atomic<uint32_t> _sleepers{0};
+    std::atomic<uint32_t> _waiters{0};
+    std::atomic<bool> _stopping{false};
+};
+
+} // namespace pers
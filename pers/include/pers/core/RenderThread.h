@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace pers {
+
+/**
+ * @brief Dedicated thread that encodes and submits one frame at a time
+ *
+ * Used by Application's pipelined mode: the main thread hands frame N over
+ * with submit() and goes on simulating frame N+1 while this thread renders.
+ * submit() first waits for the previous frame, so at most one frame is
+ * being rendered and the main thread never runs more than one frame ahead.
+ */
+class RenderThread {
+public:
+    RenderThread();
+
+    /**
+     * @brief Finishes the frame being rendered, then joins the thread
+     */
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /**
+     * @brief Wait for the previous frame, then start rendering this one
+     */
+    void submit(std::function<void()> frame);
+
+    /**
+     * @brief Block until the frame being rendered has finished
+     */
+    void wait();
+
+    bool isBusy() const;
+
+    std::thread::id getThreadId() const { return _thread.get_id(); }
+
+private:
+    void threadLoop();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::function<void()> _frame;
+    bool _busy = false;
+    bool _stopping = false;
+    std::thread _thread;  // Last, starts once the state above is constructed
+};
+
+} // namespace pers
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace pers {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+enum class TaskState : uint8_t {
+    Running,   // Not finished, nobody waiting
+    Awaited,   // Not finished, continuation set
+    Finished,
+    Detached   // Task object destroyed first, the frame frees itself
+};
+
+struct TaskPromiseBase {
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            TaskPromiseBase& promise = handle.promise();
+            const TaskState previous = promise.state.exchange(TaskState::Finished, std::memory_order_acq_rel);
+            if (previous == TaskState::Detached) {
+                handle.destroy();
+                return std::noop_coroutine();
+            }
+            if (previous == TaskState::Awaited) {
+                // The awaiting coroutine owns the task and is suspended, the frame stays alive
+                return promise.continuation;
+            }
+            // Running: the owner may destroy the frame from now on, don't touch it
+            return std::noop_coroutine();
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    // The engine does not use exceptions; one escaping a task is a bug
+    void unhandled_exception() const noexcept { std::terminate(); }
+
+    std::coroutine_handle<> continuation;
+    std::atomic<TaskState> state{TaskState::Running};
+};
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase {
+    Task<T> get_return_object() noexcept;
+
+    template<typename U>
+    void return_value(U&& value) { result.emplace(std::forward<U>(value)); }
+
+    std::optional<T> result;
+};
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() const noexcept {}
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * A task starts when it is first awaited, or explicitly with start() to
+ * overlap it with other work before awaiting it:
+ *
+ *     Task<MeshData> loadMesh(JobSystem& jobs, std::string path) {
+ *         auto file = readFileAsync(jobs, path);
+ *         auto pipeline = awaitPipeline(_meshPipeline);
+ *         file.start();                      // IO runs while the pipeline compiles
+ *         auto bytes = co_await file;
+ *         auto compiled = co_await pipeline;
+ *         co_return parseMesh(*bytes, compiled);
+ *     }
+ *
+ * A coroutine continues on whichever thread completed the operation it
+ * awaited: the event pump for GPU awaitables, a job worker for resumeOn()
+ * and file reads. Frame code that is not a coroutine itself polls isDone()
+ * and takes the result with get().
+ *
+ * Destroying a task that is still running detaches it: the coroutine runs to
+ * completion and frees itself, the result is discarded. Coroutine parameters
+ * should be taken by value, references must outlive the task.
+ */
+template<typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : _handle(handle) {}
+    ~Task() { release(); }
+
+    Task(Task&& other) noexcept
+        : _handle(std::exchange(other._handle, nullptr))
+        , _started(std::exchange(other._started, false)) {
+    }
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            release();
+            _handle = std::exchange(other._handle, nullptr);
+            _started = std::exchange(other._started, false);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    bool isValid() const { return static_cast<bool>(_handle); }
+
+    /**
+     * @brief Run the coroutine up to its first suspension, no-op once started
+     */
+    void start() {
+        if (_handle && !_started) {
+            _started = true;
+            _handle.resume();
+        }
+    }
+
+    bool isDone() const {
+        return _handle && _handle.promise().state.load(std::memory_order_acquire) == detail::TaskState::Finished;
+    }
+
+    /**
+     * @brief Result of a finished task, call only once isDone() returned true
+     */
+    decltype(auto) get() {
+        if constexpr (!std::is_void_v<T>) {
+            return *_handle.promise().result;
+        }
+    }
+
+    auto operator co_await() noexcept {
+        struct Awaiter {
+            Task& task;
+
+            bool await_ready() const noexcept { return task.isDone(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                auto& promise = task._handle.promise();
+                promise.continuation = awaiting;
+                if (!task._started) {
+                    // Not running yet, nobody else touches the state
+                    task._started = true;
+                    promise.state.store(detail::TaskState::Awaited, std::memory_order_relaxed);
+                    return task._handle;
+                }
+                if (promise.state.exchange(detail::TaskState::Awaited, std::memory_order_acq_rel) ==
+                    detail::TaskState::Finished) {
+                    // Finished in between; the coroutine is done with the state
+                    promise.state.store(detail::TaskState::Finished, std::memory_order_release);
+                    return awaiting;
+                }
+                return std::noop_coroutine();
+            }
+
+            auto await_resume() {
+                if constexpr (!std::is_void_v<T>) {
+                    return std::move(*task._handle.promise().result);
+                }
+            }
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    void release() {
+        if (!_handle) {
+            return;
+        }
+        if (!_started ||
+            _handle.promise().state.exchange(detail::TaskState::Detached, std::memory_order_acq_rel) ==
+                detail::TaskState::Finished) {
+            _handle.destroy();
+        }
+        _handle = nullptr;
+    }
+
+    Handle _handle;
+    bool _started = false;
+};
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} // namespace detail
+
+} // namespace pers
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/utils/Mutex.h"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Measured throughput of one adapter
+ */
+struct AdapterBenchmarkResult {
+    std::string fingerprint;         // PipelineDiskCache::makeDeviceFingerprint of the adapter
+    std::string deviceName;
+    double fillRate = 0.0;           // Gigapixels per second
+    double copyBandwidth = 0.0;      // Gigabytes per second, buffer to buffer
+    bool valid = false;
+
+    /**
+     * @brief Geometric mean of fill rate and copy bandwidth, 0 if invalid
+     */
+    double getScore() const;
+};
+
+/**
+ * @brief Picks an adapter by measured throughput instead of reported type
+ *
+ * On machines with several GPUs the adapter reported as high performance is
+ * not always the fastest one. measure() creates a short-lived device on the
+ * adapter, times an overdraw pass into an offscreen target (fill rate) and a
+ * few large buffer copies (copy bandwidth), and keeps the best of a few
+ * repetitions. Timings are wall clock from submit to the fence signalling,
+ * so small configurations mostly measure submission overhead.
+ *
+ * Results are keyed by the adapter fingerprint (device, ids and driver). With
+ * a cache path, load() and save() keep them on disk so a benchmark runs once
+ * per adapter and driver rather than on every launch.
+ */
+class AdapterBenchmark {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct Config {
+        uint32_t targetSize = 1024;              // Offscreen target edge in pixels
+        uint32_t fillDraws = 32;                 // Full-screen triangles per pass
+        uint64_t copySize = 32ull * 1024 * 1024; // Bytes per buffer copy
+        uint32_t copiesPerSubmit = 4;
+        uint32_t repetitions = 3;                // Best of, after one warm-up
+        std::chrono::milliseconds timeout = std::chrono::seconds(5);
+    };
+
+    /**
+     * @param cachePath File results are loaded from and saved to, empty to keep them in memory
+     */
+    explicit AdapterBenchmark(const std::string& cachePath = "");
+    AdapterBenchmark(const std::string& cachePath, const Config& config);
+    ~AdapterBenchmark() = default;
+
+    AdapterBenchmark(const AdapterBenchmark&) = delete;
+    AdapterBenchmark& operator=(const AdapterBenchmark&) = delete;
+
+    /**
+     * @brief Read cached results
+     * @return false if there is no cache path or the file is missing or stale
+     */
+    bool load();
+
+    /**
+     * @brief Write all results measured or loaded so far
+     */
+    bool save() const;
+
+    /**
+     * @brief Cached result for the adapter, running the benchmark on a miss
+     */
+    AdapterBenchmarkResult measure(const std::shared_ptr<IPhysicalDevice>& physicalDevice);
+
+    /**
+     * @brief Adapter with the highest score
+     * @return Null if no candidate could be benchmarked
+     */
+    std::shared_ptr<IPhysicalDevice> selectBest(const std::vector<std::shared_ptr<IPhysicalDevice>>& candidates);
+
+    /**
+     * @brief Benchmark an adapter without touching any cache
+     */
+    static AdapterBenchmarkResult run(const std::shared_ptr<IPhysicalDevice>& physicalDevice, const Config& config);
+
+    size_t getCachedCount() const;
+    const std::string& getCachePath() const { return _cachePath; }
+
+private:
+    std::string _cachePath;
+    Config _config;
+
+    mutable Mutex<false> _mutex;
+    std::map<std::string, AdapterBenchmarkResult> _results;  // By fingerprint, ordered for stable output
+};
+
+} // namespace pers
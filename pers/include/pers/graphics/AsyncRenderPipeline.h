@@ -0,0 +1,98 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Handle to a render pipeline that is compiled in the background
+ *
+ * Returned by IResourceFactory::createRenderPipelineAsync. It can be bound
+ * with IRenderPassEncoder::setPipeline at any time: until compilation
+ * finishes the optional fallback pipeline is used instead, and once it is
+ * ready the compiled pipeline is used. A ready handle can later be pointed
+ * at a rebuilt pipeline with replace(), which is how shader hot-reload swaps
+ * pipelines without touching the code that binds them.
+ */
+class AsyncRenderPipeline final : public IRenderPipeline {
+public:
+    enum class State {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    using ReadyCallback = std::function<void(const std::shared_ptr<IRenderPipeline>& pipeline)>;
+
+    /**
+     * @param debugName Debug name reported until compilation finishes
+     * @param fallback Pipeline used for draws issued before ready, may be null
+     */
+    AsyncRenderPipeline(const std::string& debugName, std::shared_ptr<IRenderPipeline> fallback);
+    ~AsyncRenderPipeline() override = default;
+
+    // IRenderPipeline interface
+    const std::string& getDebugName() const override;
+    bool isValid() const override;
+    RenderPipelineDesc getDesc() const override;                    // Of the active pipeline
+    NativePipelineHandle getNativePipelineHandle() const override;  // Of the active pipeline
+
+    State getState() const;
+    bool isReady() const { return getState() == State::Ready; }
+
+    /**
+     * @brief Pipeline to bind right now
+     * @return The compiled pipeline when ready, otherwise the fallback (may be null)
+     */
+    std::shared_ptr<IRenderPipeline> getActive() const;
+
+    /**
+     * @brief Compiled pipeline, null until ready
+     */
+    std::shared_ptr<IRenderPipeline> getPipeline() const;
+
+    /**
+     * @brief Block until compilation finishes
+     * @return true if the pipeline is ready
+     */
+    bool wait(std::chrono::milliseconds timeout = std::chrono::seconds(30)) const;
+
+    /**
+     * @brief Run callback once compilation finishes
+     * Runs immediately if already finished; receives null on failure.
+     */
+    void then(ReadyCallback callback);
+
+    /**
+     * @brief Publish the compilation result, called by the backend
+     * @param pipeline Compiled pipeline, or null if compilation failed
+     */
+    void resolve(std::shared_ptr<IRenderPipeline> pipeline);
+
+    /**
+     * @brief Swap in a rebuilt pipeline
+     * Binds issued after the call use it; passes already encoded keep the old
+     * one alive through the command buffer. Resolves a pending handle.
+     * @return false if the pipeline is null or invalid, the handle is unchanged then
+     */
+    bool replace(std::shared_ptr<IRenderPipeline> pipeline);
+
+private:
+    std::string _debugName;
+    std::shared_ptr<IRenderPipeline> _fallback;
+
+    mutable std::mutex _mutex;
+    mutable std::condition_variable _cv;
+    State _state = State::Pending;
+    std::shared_ptr<IRenderPipeline> _pipeline;
+    std::vector<ReadyCallback> _callbacks;
+};
+
+} // namespace pers
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBindGroup;
+class ITextureView;
+class DeviceBuffer;
+class ReadbackRing;
+
+/**
+ * @brief Adapted exposure as stored in the exposure buffer, 16 bytes
+ */
+struct AutoExposureState {
+    float averageLuminance = 0.0f;  // Adapted scene luminance, 0 until the first frame
+    float exposure = 1.0f;          // Scale applied before tonemapping
+    float targetLuminance = 0.0f;   // This frame's histogram average
+    uint32_t sampleCount = 0;       // Pixels between the percentiles
+};
+static_assert(sizeof(AutoExposureState) == 16, "AutoExposureState must match the WGSL layout");
+
+/**
+ * @brief Luminance histogram and eye adaptation that never leave the GPU
+ *
+ * execute() records one compute pass: a dispatch per 16x16 tile bins the
+ * log2 luminance of the HDR scene into BIN_COUNT bins through workgroup
+ * atomics, then a single workgroup averages the bins between lowPercentile
+ * and highPercentile, adapts toward it in log space and writes
+ * AutoExposureState into the exposure buffer, clearing the histogram for
+ * the next frame. Tonemapping reads the buffer directly, so each frame is
+ * exposed from its own histogram and the CPU never waits on the GPU:
+ *
+ *     exposure.execute(*encoder, hdrView, deltaSeconds);
+ *     post.setExposureBuffer(exposure.getExposureBuffer());   // once
+ *     post.execute(*encoder, hdrView, swapChainView, settings);
+ *
+ * With Config::telemetry the state is also mirrored to the CPU through a
+ * ReadbackRing; getLastState() then trails the GPU by a few frames and is
+ * meant for display and logging, not for feeding back into rendering:
+ *
+ *     exposure.readback(encoder);
+ *     queue->submit(...);
+ *     exposure.submitted();
+ *     exposure.collect();          // never blocks
+ *
+ * Uniforms reach the GPU through IQueue::writeBuffer, so execute once per
+ * submission. The scene view must be a single-sampled float 2D texture.
+ */
+class AutoExposure {
+public:
+    static constexpr uint32_t BIN_COUNT = 256;
+    static constexpr uint32_t TILE_SIZE = 16;  // 16x16 texels per histogram workgroup
+
+    struct Config {
+        float minLogLuminance = -10.0f;  // log2 luminance range the histogram covers
+        float maxLogLuminance = 6.0f;
+        float lowPercentile = 0.5f;      // Darker pixels are ignored
+        float highPercentile = 0.95f;    // Brighter pixels are ignored
+        float speedUp = 3.0f;            // Adaptation rate to brighter scenes, 1 / seconds
+        float speedDown = 1.0f;          // Adaptation rate to darker scenes
+        float keyValue = 0.18f;          // Luminance the average is exposed to
+        float minExposure = 1.0f / 64.0f;
+        float maxExposure = 64.0f;
+        bool telemetry = false;
+    };
+
+    AutoExposure(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~AutoExposure();
+
+    AutoExposure(const AutoExposure&) = delete;
+    AutoExposure& operator=(const AutoExposure&) = delete;
+
+    bool isValid() const { return _adaptBindGroup != nullptr; }
+
+    /**
+     * @brief Record the histogram and adaptation of sceneView
+     * @param deltaSeconds Time since the previous execute(), drives the adaptation
+     * @return false if the view is unusable or a resource failed to create
+     */
+    bool execute(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& sceneView, float deltaSeconds);
+
+    /**
+     * @brief Jump to the next frame's luminance instead of adapting, e.g. after a camera cut
+     */
+    void reset() { _reset = true; }
+
+    const Config& getConfig() const { return _config; }
+    void setConfig(const Config& config) { _config = config; }
+
+    /**
+     * @brief Storage buffer holding one AutoExposureState, read by tonemapping
+     */
+    const std::shared_ptr<DeviceBuffer>& getExposureBuffer() const { return _stateBuffer; }
+
+    /**
+     * @brief Storage buffer of BIN_COUNT u32 counts; cleared again once execute() has adapted
+     */
+    const std::shared_ptr<DeviceBuffer>& getHistogramBuffer() const { return _histogramBuffer; }
+
+    /**
+     * @brief Record the telemetry copy of the state; after execute(), before finish()
+     * @return false without Config::telemetry or when every readback slot is in flight
+     */
+    bool readback(const std::shared_ptr<ICommandEncoder>& encoder);
+
+    // Must be called after the command buffer passed to readback() is submitted
+    void submitted();
+
+    /**
+     * @brief Consume finished readbacks
+     * @return Number of states that arrived
+     */
+    size_t collect();
+
+    /**
+     * @brief Newest state mirrored to the CPU, a few frames old
+     */
+    const AutoExposureState& getLastState() const { return _lastState; }
+
+private:
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    bool _reset = true;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::shared_ptr<DeviceBuffer> _histogramBuffer;
+    std::shared_ptr<DeviceBuffer> _stateBuffer;
+    std::shared_ptr<IBindGroupLayout> _histogramLayout;
+    std::shared_ptr<IBindGroupLayout> _adaptLayout;
+    std::shared_ptr<IComputePipeline> _histogramPipeline;
+    std::shared_ptr<IComputePipeline> _adaptPipeline;
+    std::shared_ptr<IBindGroup> _adaptBindGroup;
+
+    std::unique_ptr<ReadbackRing> _readback;
+    AutoExposureState _lastState;
+};
+
+} // namespace pers
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/utils/ConcurrentLookupTable.h"
+#include "pers/utils/CpuMemoryTracker.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Content-hashed cache for bind group layouts and bind groups
+ *
+ * Layouts are keyed by their entries. Bind groups are keyed by layout and
+ * the native resources, offsets and sizes they bind, so rebuilding a bind
+ * group for the same resource set every frame returns one native object.
+ * Binding a DynamicBuffer yields one cached bind group per frame slot,
+ * addressed with dynamic offsets. Pipeline layouts are keyed by their bind
+ * group layouts, which are already deduplicated, so pointer identity is
+ * content identity. debugName is ignored in all keys.
+ *
+ * Cached bind groups keep their resources alive on the GPU; call trim()
+ * after releasing resources to drop bind groups nobody else holds.
+ *
+ * Thread-safe. Each kind of entry lives in a ConcurrentLookupTable, so hits
+ * take no lock and encoding threads resolving bind groups per draw never
+ * contend; only inserts, trim and clear serialize. Statistics are atomic
+ * counters.
+ */
+class BindGroupCache {
+public:
+    using LayoutCreateFunction = std::function<std::shared_ptr<IBindGroupLayout>(const BindGroupLayoutDesc&)>;
+    using BindGroupCreateFunction = std::function<std::shared_ptr<IBindGroup>(const BindGroupDesc&)>;
+    using PipelineLayoutCreateFunction = std::function<std::shared_ptr<IPipelineLayout>(const PipelineLayoutDesc&)>;
+
+    struct Stats {
+        uint64_t layoutHits = 0;
+        uint64_t layoutMisses = 0;
+        uint64_t bindGroupHits = 0;
+        uint64_t bindGroupMisses = 0;
+        uint64_t pipelineLayoutHits = 0;
+        uint64_t pipelineLayoutMisses = 0;
+        size_t layouts = 0;
+        size_t bindGroups = 0;
+        size_t pipelineLayouts = 0;
+    };
+
+    BindGroupCache() = default;
+    ~BindGroupCache() = default;
+
+    BindGroupCache(const BindGroupCache&) = delete;
+    BindGroupCache& operator=(const BindGroupCache&) = delete;
+
+    std::shared_ptr<IBindGroupLayout> getOrCreateLayout(const BindGroupLayoutDesc& desc,
+                                                        const LayoutCreateFunction& create);
+
+    std::shared_ptr<IBindGroup> getOrCreateBindGroup(const BindGroupDesc& desc,
+                                                     const BindGroupCreateFunction& create);
+
+    std::shared_ptr<IPipelineLayout> getOrCreatePipelineLayout(const PipelineLayoutDesc& desc,
+                                                               const PipelineLayoutCreateFunction& create);
+
+    /**
+     * @brief Drop bind groups referenced only by the cache
+     * @return Number of bind groups released
+     */
+    size_t trim();
+
+    void clear();
+
+    Stats getStats() const;
+
+private:
+    struct LayoutEntry {
+        BindGroupLayoutDesc desc;
+        std::shared_ptr<IBindGroupLayout> layout;
+    };
+
+    struct BindingKey {
+        uint32_t binding = 0;
+        void* resource = nullptr;  // Native buffer, texture view or sampler
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        TaggedVector<void*, MemoryTag::Descriptors> elements;  // Binding arrays, native handles in slot order
+
+        bool operator==(const BindingKey& other) const {
+            return binding == other.binding && resource == other.resource &&
+                   offset == other.offset && size == other.size && elements == other.elements;
+        }
+    };
+
+    using BindingKeys = TaggedVector<BindingKey, MemoryTag::Descriptors>;
+
+    struct BindGroupEntry {
+        const IBindGroupLayout* layout = nullptr;  // Kept alive by the bind group
+        BindingKeys bindings;
+        std::shared_ptr<IBindGroup> bindGroup;
+    };
+
+    static uint64_t computeLayoutHash(const BindGroupLayoutDesc& desc);
+    static bool isEquivalent(const BindGroupLayoutDesc& a, const BindGroupLayoutDesc& b);
+    static BindingKeys makeBindingKeys(const BindGroupDesc& desc);
+    static uint64_t computeBindGroupHash(const IBindGroupLayout* layout, const BindingKeys& bindings);
+    static uint64_t computePipelineLayoutHash(const std::vector<const IBindGroupLayout*>& layouts,
+                                              const std::vector<PushConstantRange>& pushConstantRanges);
+
+    ConcurrentLookupTable<LayoutEntry, MemoryTag::Caches> _layouts;
+    ConcurrentLookupTable<BindGroupEntry, MemoryTag::Caches> _bindGroups;
+    ConcurrentLookupTable<std::shared_ptr<IPipelineLayout>, MemoryTag::Caches> _pipelineLayouts;
+    std::atomic<size_t> _layoutCount{0};
+    std::atomic<size_t> _bindGroupCount{0};
+    std::atomic<size_t> _pipelineLayoutCount{0};
+    std::atomic<uint64_t> _layoutHits{0};
+    std::atomic<uint64_t> _layoutMisses{0};
+    std::atomic<uint64_t> _bindGroupHits{0};
+    std::atomic<uint64_t> _bindGroupMisses{0};
+    std::atomic<uint64_t> _pipelineLayoutHits{0};
+    std::atomic<uint64_t> _pipelineLayoutMisses{0};
+};
+
+} // namespace pers
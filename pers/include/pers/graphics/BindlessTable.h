@@ -0,0 +1,148 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IShaderModule.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IBindGroup;
+class IBindGroupLayout;
+class ITexture;
+class ITextureView;
+class ISampler;
+class DeviceBuffer;
+
+/**
+ * @brief All material resources in one bind group, indexed from the shader
+ *
+ * Textures and samplers go into binding arrays and material parameters into
+ * one storage buffer, so switching materials is an index change instead of a
+ * setBindGroup. Draws that differ only by material can then share a pipeline
+ * and bind group and be merged into indirect batches.
+ *
+ * The group has three bindings:
+ *   0  read-only storage buffer, array of materialSize-byte records
+ *   1  binding_array<texture_2d<f32>, maxTextures>
+ *   2  binding_array<sampler, maxSamplers>
+ * getShaderDeclarations() returns the matching WGSL. A material record
+ * stores the texture and sampler indices it uses; the shader reads the
+ * material id from instance_index by drawing with firstInstance = id
+ * (indirect batches need DeviceFeature::IndirectFirstInstance for that).
+ *
+ * Binding arrays are wgpu-native extensions. Request getRequiredFeatures()
+ * through LogicalDeviceDesc::preferredFeatures and check isSupported(); when
+ * the device lacks them create() returns null and the caller keeps per-material
+ * bind groups. Unused slots hold a 1x1 placeholder texture and sampler, so
+ * PartiallyBoundBindingArray is not needed.
+ *
+ * Adding or removing textures and samplers marks the group dirty; it is
+ * rebuilt by the next getBindGroup(). Material writes go through the queue
+ * and never rebuild it. Not thread-safe.
+ */
+class BindlessTable {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    struct Config {
+        uint32_t maxTextures = 256;
+        uint32_t maxSamplers = 16;
+        uint32_t maxMaterials = 1024;
+        uint32_t materialSize = 64;  // Bytes per record, multiple of 16 (std430 struct stride)
+        ShaderStage visibility = ShaderStage::Vertex | ShaderStage::Fragment;
+        std::string debugName = "BindlessTable";
+    };
+
+    /**
+     * @brief Features the device must have for create() to succeed
+     */
+    static std::vector<DeviceFeature> getRequiredFeatures();
+
+    static bool isSupported(const std::shared_ptr<ILogicalDevice>& device);
+
+    /**
+     * @return Null if the device lacks binding arrays, the config exceeds
+     *         device limits or a resource failed to create
+     */
+    static std::unique_ptr<BindlessTable> create(const std::shared_ptr<ILogicalDevice>& device,
+                                                 const Config& config);
+
+    ~BindlessTable();
+
+    BindlessTable(const BindlessTable&) = delete;
+    BindlessTable& operator=(const BindlessTable&) = delete;
+
+    /**
+     * @return Slot index for the shader, INVALID_INDEX if the table is full
+     */
+    uint32_t addTexture(const std::shared_ptr<ITextureView>& textureView);
+    uint32_t addSampler(const std::shared_ptr<ISampler>& sampler);
+    void removeTexture(uint32_t index);
+    void removeSampler(uint32_t index);
+
+    /**
+     * @brief Allocate a material record and upload its parameters
+     * @param data At most materialSize bytes, the rest of the record is zeroed
+     * @return Material id, INVALID_INDEX if the table is full or data is too large
+     */
+    uint32_t addMaterial(std::span<const std::byte> data);
+    bool updateMaterial(uint32_t id, std::span<const std::byte> data);
+    void removeMaterial(uint32_t id);
+
+    /**
+     * @brief The table's bind group, rebuilt first if slots changed
+     */
+    const std::shared_ptr<IBindGroup>& getBindGroup();
+    const std::shared_ptr<IBindGroupLayout>& getBindGroupLayout() const { return _layout; }
+
+    /**
+     * @brief WGSL declarations for the three bindings
+     * @param group Bind group index the table is set at
+     * @param materialType WGSL struct name of one material record, declared by the caller
+     */
+    std::string getShaderDeclarations(uint32_t group, const std::string& materialType) const;
+
+    const Config& getConfig() const { return _config; }
+    uint32_t getTextureCount() const { return _textureCount; }
+    uint32_t getSamplerCount() const { return _samplerCount; }
+    uint32_t getMaterialCount() const { return _materialCount; }
+
+private:
+    BindlessTable(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    bool initialize();
+    bool writeMaterial(uint32_t id, std::span<const std::byte> data);
+
+    static uint32_t allocateSlot(std::vector<uint32_t>& freeSlots, uint32_t& nextSlot, uint32_t capacity);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::shared_ptr<IBindGroup> _bindGroup;
+    std::shared_ptr<DeviceBuffer> _materialBuffer;
+    std::shared_ptr<ITexture> _placeholderTexture;
+    std::shared_ptr<ITextureView> _placeholderView;
+    std::shared_ptr<ISampler> _placeholderSampler;
+
+    std::vector<std::shared_ptr<ITextureView>> _textures;  // One per slot, placeholder when free
+    std::vector<std::shared_ptr<ISampler>> _samplers;
+    std::vector<uint32_t> _freeTextures;
+    std::vector<uint32_t> _freeSamplers;
+    std::vector<uint32_t> _freeMaterials;
+    std::vector<std::byte> _scratch;  // One zero-padded record
+    uint32_t _nextTexture = 0;
+    uint32_t _nextSampler = 0;
+    uint32_t _nextMaterial = 0;
+    uint32_t _textureCount = 0;
+    uint32_t _samplerCount = 0;
+    uint32_t _materialCount = 0;
+    bool _dirty = true;
+};
+
+} // namespace pers
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pers/graphics/FrameCapture.h"
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IQueue;
+
+namespace detail {
+class CaptureSession;
+}
+
+/**
+ * @brief Records a frame's GPU work into a FrameCapture
+ *
+ * The queue and encoders handed to the renderer are wrapped; wrappers forward
+ * every call and, while a capture is running, also append it to the command
+ * stream together with descriptions of the resources it references:
+ *
+ *     CaptureRecorder recorder(device);
+ *     auto queue = recorder.wrapQueue(device->getQueue());
+ *     ...
+ *     recorder.beginCapture();
+ *     auto encoder = recorder.wrapEncoder(device->createCommandEncoder());
+ *     renderFrame(encoder, queue);
+ *     FrameCapture capture;
+ *     if (recorder.endCapture(capture)) {
+ *         capture.save("spike.pcap");
+ *     }
+ *
+ * Only encoders wrapped after beginCapture() are recorded. Buffer contents
+ * come from the queue writes and staging uploads made during the capture and,
+ * for buffers with BufferUsage::CopySrc, from a readback in endCapture(), so
+ * static geometry is only reproduced when created with CopySrc. Texture
+ * contents are not captured; replay renders into and samples from textures of
+ * the same size and format.
+ *
+ * Compute passes, render bundles, queries, texture copies and readbacks have
+ * no command in the stream. They still execute, but are counted in
+ * FrameCapture::skippedCommands and missing from the replay.
+ *
+ * The wrappers are thread-safe as far as the wrapped objects are: commands
+ * recorded from several threads are serialized into one stream.
+ */
+class CaptureRecorder {
+public:
+    explicit CaptureRecorder(const std::shared_ptr<ILogicalDevice>& device);
+    ~CaptureRecorder();
+
+    CaptureRecorder(const CaptureRecorder&) = delete;
+    CaptureRecorder& operator=(const CaptureRecorder&) = delete;
+
+    std::shared_ptr<IQueue> wrapQueue(const std::shared_ptr<IQueue>& queue);
+    std::shared_ptr<ICommandEncoder> wrapEncoder(const std::shared_ptr<ICommandEncoder>& encoder);
+
+    /**
+     * @brief Start recording, discarding any unfinished capture
+     */
+    void beginCapture();
+
+    bool isCapturing() const;
+
+    /**
+     * @brief Stop recording, read back buffer contents and hand over the capture
+     * Waits for the GPU to finish the readback.
+     * @return false if no capture was running
+     */
+    bool endCapture(FrameCapture& capture);
+
+private:
+    std::shared_ptr<detail::CaptureSession> _session;  // Shared with the wrappers
+};
+
+} // namespace pers
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class IBindGroupLayout;
+class IBindGroup;
+class ISampler;
+class ITexture;
+class ITextureView;
+class DeviceBuffer;
+
+/**
+ * @brief Directional light cascaded shadow maps with cached static casters
+ *
+ * The view range up to shadowDistance is split into cascadeCount slices,
+ * blending logarithmic and uniform splits by splitLambda. Each slice is
+ * fitted with a bounding sphere, which keeps the cascade's size constant
+ * as the camera turns, and rendered orthographically from the light into
+ * one layer of a depth texture array.
+ *
+ * Static casters are drawn into a separate cache array and only redrawn
+ * for a cascade when it moves more than texelThreshold texels, when the
+ * light turns, or after invalidateStatic(). Until then the cascade keeps
+ * its matrix: its extent is padded by the threshold so the slice stays
+ * covered, and its origin is snapped to whole texels so re-fits do not
+ * shimmer. Every frame each cached layer is copied into the shadow map and
+ * dynamic casters are drawn on top with depth loaded:
+ *
+ *     shadows.setView(view, projection, near, sunDirection);
+ *     shadows.render(*encoder,
+ *         [&](IRenderPassEncoder& pass, uint32_t cascade) { drawStatic(pass); },
+ *         [&](IRenderPassEncoder& pass, uint32_t cascade) { drawDynamic(pass); });
+ *     ...
+ *     pass->setBindGroup(3, shadows.getBindGroup());    // Shading
+ *
+ * Caster pipelines render depth in Config::depthFormat and take
+ * getCasterBindGroupLayout() at Config::casterGroup, which render() binds
+ * before each callback; getCasterShaderDeclarations() declares the light
+ * view-projection there. getShaderDeclarations() gives material shaders
+ * shadowFactor(), a 3x3 PCF lookup in the cascade covering the fragment.
+ *
+ * The view must be rigid and the projection perspective with clip w = -z,
+ * as for ClusteredLighting. The depth format must be copyable, so
+ * Depth16Unorm or Depth32Float. Uniforms reach the GPU through
+ * IQueue::writeBuffer, so render once per submission.
+ */
+class CascadedShadowMaps {
+public:
+    using Mat4 = std::array<float, 16>;  // Column-major
+    using DrawCasters = std::function<void(IRenderPassEncoder& pass, uint32_t cascade)>;
+
+    static constexpr uint32_t MAX_CASCADES = 4;
+
+    struct Config {
+        uint32_t cascadeCount = 4;
+        uint32_t resolution = 2048;      // Texels per side of each cascade
+        TextureFormat depthFormat = TextureFormat::Depth32Float;
+        float shadowDistance = 100.0f;   // View distance where the last cascade ends
+        float splitLambda = 0.75f;       // 1 = logarithmic splits, 0 = uniform
+        float texelThreshold = 16.0f;    // Drift in texels before static casters are redrawn
+        float casterDistance = 100.0f;   // Depth added toward the light for casters outside the view
+        float depthBias = 0.0005f;
+        float normalBias = 1.5f;         // Normal offset in texels
+        uint32_t casterGroup = 0;
+    };
+
+    CascadedShadowMaps(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~CascadedShadowMaps();
+
+    CascadedShadowMaps(const CascadedShadowMaps&) = delete;
+    CascadedShadowMaps& operator=(const CascadedShadowMaps&) = delete;
+
+    bool isValid() const { return _shadingBindGroup != nullptr; }
+
+    /**
+     * @param view World to view transform of the camera
+     * @param projection Perspective projection the scene is rendered with
+     * @param nearPlane View distance where the first cascade starts
+     * @param lightDirection World-space direction the light travels in
+     */
+    void setView(const Mat4& view, const Mat4& projection, float nearPlane, const std::array<float, 3>& lightDirection);
+
+    /**
+     * @brief Redraw static casters in every cascade on the next render()
+     */
+    void invalidateStatic();
+
+    /**
+     * @brief Redraw static casters in the cascades a changed sphere of geometry touches
+     */
+    void invalidateStatic(const std::array<float, 3>& center, float radius);
+
+    /**
+     * @brief Record the shadow passes; drawDynamic may be empty
+     * @return false if the maps are invalid or a pass failed to begin
+     */
+    bool render(ICommandEncoder& encoder, const DrawCasters& drawStatic, const DrawCasters& drawDynamic);
+
+    /**
+     * @brief Light view-projection of a cascade as last fitted
+     */
+    const Mat4& getViewProjection(uint32_t cascade) const { return _cascades[cascade].viewProjection; }
+
+    /**
+     * @brief View distance where a cascade ends
+     */
+    float getSplitDistance(uint32_t cascade) const { return _cascades[cascade].splitFar; }
+
+    /**
+     * @brief Group for material shaders, declared by getShaderDeclarations()
+     */
+    const std::shared_ptr<IBindGroup>& getBindGroup() const { return _shadingBindGroup; }
+    const std::shared_ptr<IBindGroupLayout>& getBindGroupLayout() const { return _shadingLayout; }
+    const std::shared_ptr<IBindGroupLayout>& getCasterBindGroupLayout() const { return _casterLayout; }
+
+    /**
+     * @brief WGSL uniforms, shadow map bindings, shadowCascade() and shadowFactor()
+     */
+    std::string getShaderDeclarations(uint32_t group) const;
+
+    /**
+     * @brief WGSL binding of shadowCasterViewProjection for caster vertex shaders
+     */
+    std::string getCasterShaderDeclarations() const;
+
+    const std::shared_ptr<ITexture>& getShadowTexture() const { return _shadowTexture; }
+    const Config& getConfig() const { return _config; }
+
+    /**
+     * @brief Cascades whose static casters were redrawn, summed over all render() calls
+     */
+    uint64_t getStaticRenderCount() const { return _staticRenderCount; }
+
+private:
+    struct Cascade {
+        std::array<float, 3> center{};  // Light space, x and y snapped to texels
+        float halfExtent = 0.0f;
+        float splitFar = 0.0f;
+        Mat4 viewProjection{};
+        bool valid = false;
+        bool staticDirty = true;
+        bool layerCurrent = false;      // Shadow layer holds exactly the static cache
+    };
+
+    void fitCascade(Cascade& cascade, const std::array<float, 3>& worldCenter, float radius) const;
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+
+    std::shared_ptr<ITexture> _staticTexture;
+    std::shared_ptr<ITexture> _shadowTexture;
+    std::array<std::shared_ptr<ITextureView>, MAX_CASCADES> _staticViews;
+    std::array<std::shared_ptr<ITextureView>, MAX_CASCADES> _shadowViews;
+    std::shared_ptr<ITextureView> _shadowArrayView;
+    std::shared_ptr<ISampler> _comparisonSampler;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::array<std::shared_ptr<DeviceBuffer>, MAX_CASCADES> _casterBuffers;
+    std::array<std::shared_ptr<IBindGroup>, MAX_CASCADES> _casterBindGroups;
+    std::shared_ptr<IBindGroupLayout> _casterLayout;
+    std::shared_ptr<IBindGroupLayout> _shadingLayout;
+    std::shared_ptr<IBindGroup> _shadingBindGroup;
+
+    std::array<Cascade, MAX_CASCADES> _cascades;
+    std::array<float, 3> _lightRight{1.0f, 0.0f, 0.0f};
+    std::array<float, 3> _lightUp{0.0f, 1.0f, 0.0f};
+    std::array<float, 3> _lightForward{0.0f, 0.0f, -1.0f};
+    uint64_t _staticRenderCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/utils/CpuMemoryTracker.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IComputePassEncoder;
+class IRenderPassEncoder;
+class IComputePipeline;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroup;
+class IPipelineLayout;
+class IBuffer;
+class ITexture;
+class DeviceBuffer;
+
+/**
+ * @brief Terrain drawn as nested clipmap rings around the camera
+ *
+ * Level l is a square of 4 * blockSize + 2 cells of size cellSize * 2^l,
+ * so every level covers twice the extent of the one inside it at half the
+ * resolution. All geometry is one grid mesh of blockSize^2 cells, drawn
+ * instanced: full blocks, 2-cell fix-up strips between them, the 1-cell
+ * L-shaped trim that lets a level sit off-centre in its parent, and single
+ * cells are all prefixes of its index buffer, rotated per instance where
+ * needed. Level 0 is a full square, coarser levels are rings around it.
+ *
+ * Heights live in a 2D array texture, one layer per level. Each layer is a
+ * toroidal window around the camera: when a level moves, update() asks the
+ * HeightLoader only for the newly exposed rows and columns and writes them
+ * over the ones that left, so streaming cost follows camera motion, not
+ * world size. Near its outer edge a level blends its vertices towards the
+ * parent's heights, so neighbouring levels meet without cracks.
+ *
+ * cull() tests every piece against the frustum in a compute pass and
+ * appends the visible ones to per-shape instance lists; render() draws
+ * them with four drawIndexedIndirect calls. The CPU only rebuilds the
+ * candidate list, at most 32 pieces per level, when a level moves, so the
+ * frame cost does not depend on terrain size:
+ *
+ *     terrain.update(cameraPosition);
+ *     auto pass = encoder->beginComputePass(ComputePassDesc{"Terrain"});
+ *     terrain.cull(*pass, viewProjection);
+ *     pass->end();
+ *     ...
+ *     terrain.render(*renderPass, target);
+ *
+ * Uniforms reach the GPU through IQueue::writeBuffer, so call cull() and
+ * render() once per submission.
+ */
+class ClipmapTerrain {
+public:
+    using Vec3 = std::array<float, 3>;
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    static constexpr TextureFormat HEIGHT_FORMAT = TextureFormat::R32Float;
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+    static constexpr uint32_t MIN_BLOCK_SIZE = 8;
+    static constexpr uint32_t MAX_BLOCK_SIZE = 255;  // Grid vertices fit 16-bit indices
+    static constexpr uint32_t MAX_LEVEL_COUNT = 16;
+
+    /**
+     * @brief Fill the heights of a width x height region of one level, row by row along z
+     * Sample (x, z) of level l is at world (x, z) * cellSize * 2^l; levels
+     * must agree where their samples coincide. Called from update().
+     * @return false if the data is not available yet; the update is retried next time
+     */
+    using HeightLoader = std::function<bool(uint32_t level, int32_t x, int32_t z, uint32_t width, uint32_t height,
+                                            std::span<float> heights)>;
+
+    struct Config {
+        uint32_t blockSize = 63;     // Cells per block side, a level is 4 * blockSize + 2 cells wide
+        uint32_t levelCount = 8;
+        float cellSize = 1.0f;       // World units between level 0 vertices
+        float minHeight = 0.0f;      // Height range of the whole terrain, bounds every piece for culling
+        float maxHeight = 1000.0f;
+        HeightLoader loader;
+    };
+
+    struct Shading {
+        Vec3 lightDirection{0.3f, 1.0f, 0.2f};  // Towards the light
+        uint32_t lowColor = 0xFF3A6B2E;         // Unorm8x4 in memory order at minHeight, see DebugDraw::rgba
+        uint32_t highColor = 0xFFE6E6E6;        // At maxHeight
+    };
+
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::BGRA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Depth24Plus;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    struct Stats {
+        uint32_t movedLevels = 0;     // During the last update()
+        uint64_t uploadedTexels = 0;  // During the last update()
+        uint32_t pieceCount = 0;      // Candidates cull() tests
+    };
+
+    ClipmapTerrain(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~ClipmapTerrain();
+
+    ClipmapTerrain(const ClipmapTerrain&) = delete;
+    ClipmapTerrain& operator=(const ClipmapTerrain&) = delete;
+
+    bool isValid() const { return _renderBindGroup != nullptr; }
+
+    void setShading(const Shading& shading) { _shading = shading; }
+    const Shading& getShading() const { return _shading; }
+
+    /**
+     * @brief Recentre the levels on the camera and stream the heights they uncover
+     * @return false if the loader had no data; the levels stay where they were
+     */
+    bool update(const Vec3& cameraPosition);
+
+    /**
+     * @brief Record frustum culling of the pieces into an open compute pass
+     */
+    bool cull(IComputePassEncoder& pass, const Mat4& viewProjection);
+
+    /**
+     * @brief Draw the pieces the last cull() kept
+     */
+    bool render(IRenderPassEncoder& pass, const Target& target);
+
+    /**
+     * @brief Drop the resident heights; the next update() reloads every level
+     */
+    void invalidate();
+
+    uint32_t getLevelCount() const { return _levelCount; }
+    uint32_t getBlockSize() const { return _blockSize; }
+    uint32_t getTextureSize() const { return _textureSize; }
+    std::shared_ptr<ITexture> getHeightTexture() const { return _heightTexture; }
+    const Stats& getStats() const { return _stats; }
+
+private:
+    struct Level {
+        int32_t originX = 0;   // First vertex of the footprint, in level grid units
+        int32_t originZ = 0;
+        uint32_t trimX = 0;    // 1 puts the interior trim on the low side, see buildPieces()
+        uint32_t trimZ = 0;
+        bool resident = false;
+    };
+
+    struct Region {
+        uint32_t level = 0;
+        int32_t x = 0;
+        int32_t z = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        size_t offset = 0;    // Into _uploadData
+    };
+
+    struct PipelineEntry {
+        Target target;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    void addRegion(std::vector<Region>& regions, uint32_t level, int32_t x, int32_t z,
+                   uint32_t width, uint32_t height);
+    bool writeRegion(const Region& region);
+    bool buildPieces();
+    std::shared_ptr<IRenderPipeline> getPipeline(const Target& target);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    uint32_t _blockSize = 0;
+    uint32_t _levelCount = 0;
+    uint32_t _textureSize = 0;  // Texels per layer side, the footprint plus a 1-texel apron
+    Config _config;
+    Shading _shading;
+    Vec3 _cameraPosition{0.0f, 0.0f, 0.0f};
+    std::vector<Level> _levels;
+    TaggedVector<float, MemoryTag::Loaders> _uploadData;  // Heights loaded this update, one region after another
+    Stats _stats;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::shared_ptr<DeviceBuffer> _gridVertices;
+    std::shared_ptr<DeviceBuffer> _gridIndices;
+    std::shared_ptr<DeviceBuffer> _pieces;
+    std::shared_ptr<DeviceBuffer> _visiblePieces;  // One instance list per shape, see PIECE_CAPACITY
+    std::shared_ptr<DeviceBuffer> _drawArgs;       // DrawIndexedIndirectArgs per shape
+    std::shared_ptr<ITexture> _heightTexture;
+
+    std::shared_ptr<IComputePipeline> _cullPipeline;
+    std::shared_ptr<IBindGroup> _cullBindGroup;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IPipelineLayout> _renderLayout;
+    std::shared_ptr<IBindGroup> _renderBindGroup;
+    std::vector<PipelineEntry> _pipelines;
+};
+
+} // namespace pers
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "pers/graphics/RenderGraph.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace pers {
+
+class ILogicalDevice;
+class IComputePassEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBindGroup;
+class DeviceBuffer;
+
+/**
+ * @brief Point or spot light as stored for clustered shading, 64 bytes
+ *
+ * Spot lights attenuate between cosOuter and cosInner around direction;
+ * cosOuter <= -1 makes a point light. Binning is conservative and uses the
+ * bounding sphere of position and range for both kinds.
+ */
+struct ClusterLight {
+    float position[3] = {0.0f, 0.0f, 0.0f};  // World space
+    float range = 1.0f;
+    float color[3] = {1.0f, 1.0f, 1.0f};
+    float intensity = 1.0f;
+    float direction[3] = {0.0f, 0.0f, -1.0f};
+    float cosOuter = -1.0f;
+    float cosInner = -1.0f;
+    float padding[3] = {};
+};
+static_assert(sizeof(ClusterLight) == 64, "ClusterLight must match the WGSL layout");
+
+/**
+ * @brief Bins lights into a froxel grid with one compute dispatch per frame
+ *
+ * The view frustum is split into gridX x gridY screen tiles and gridZ
+ * exponential depth slices. cull() runs one thread per cluster: it derives
+ * the cluster's view-space bounds from the projection, streams the lights
+ * through workgroup memory, and writes the indices of the lights touching
+ * it into a fixed maxLightsPerCluster slice of the index buffer. Material
+ * shaders find their cluster from the fragment position and view depth and
+ * loop over at most maxLightsPerCluster lights:
+ *
+ *     clustered.setLights(lights);
+ *     clustered.setView(view, projection, near, far, width, height);
+ *     const auto binned = clustered.addToGraph(graph);
+ *     graph.addPass("Opaque", [&](RenderGraphBuilder& builder) {
+ *         builder.read(binned.lightIndices);
+ *         ...
+ *     }, [&](RenderGraphContext& context) {
+ *         context.getRenderPass()->setBindGroup(2, clustered.getBindGroup());
+ *         ...
+ *     });
+ *
+ * getShaderDeclarations() returns the WGSL bindings and clusterIndex()
+ * helper for the material side. Lights past maxLightsPerCluster in one
+ * cluster are dropped in upload order, so pass the important ones first.
+ * The projection must be perspective with clip w = -z (right-handed view);
+ * near and far bound the slices and are independent of the depth mapping,
+ * so reversed or infinite projections work. Pipelines come from the
+ * resource factory and so from its PipelineCache. Uniforms reach the GPU
+ * through IQueue::writeBuffer, so cull once per submission.
+ */
+class ClusteredLighting {
+public:
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    struct Config {
+        uint32_t gridX = 16;
+        uint32_t gridY = 9;
+        uint32_t gridZ = 24;
+        uint32_t maxLights = 1024;
+        uint32_t maxLightsPerCluster = 128;  // Bounds the per-pixel light loop
+    };
+
+    /**
+     * @brief Buffers written by the culling pass, for passes that shade with them
+     */
+    struct GraphOutputs {
+        RenderGraphBuffer lightCounts;
+        RenderGraphBuffer lightIndices;
+    };
+
+    ClusteredLighting(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~ClusteredLighting();
+
+    ClusteredLighting(const ClusteredLighting&) = delete;
+    ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+
+    bool isValid() const { return _shadingBindGroup != nullptr; }
+
+    /**
+     * @brief Upload this frame's lights; more than maxLights are truncated
+     */
+    bool setLights(std::span<const ClusterLight> lights);
+
+    /**
+     * @param view World to view transform
+     * @param projection Perspective projection the scene is rendered with
+     * @param nearPlane View-space distance of the first slice
+     * @param farPlane View-space distance where the last slice ends
+     */
+    void setView(const Mat4& view, const Mat4& projection, float nearPlane, float farPlane,
+                 uint32_t width, uint32_t height);
+
+    /**
+     * @brief Record the binning dispatch into an open compute pass
+     */
+    bool cull(IComputePassEncoder& pass);
+
+    /**
+     * @brief Add the binning as a compute pass of graph
+     */
+    GraphOutputs addToGraph(RenderGraph& graph);
+
+    /**
+     * @brief Group for material shaders, declared by getShaderDeclarations()
+     */
+    const std::shared_ptr<IBindGroup>& getBindGroup() const { return _shadingBindGroup; }
+    const std::shared_ptr<IBindGroupLayout>& getBindGroupLayout() const { return _shadingLayout; }
+
+    /**
+     * @brief WGSL structs, fragment-visible bindings, clusterIndex() and clusterSpotFactor()
+     */
+    std::string getShaderDeclarations(uint32_t group) const;
+
+    const Config& getConfig() const { return _config; }
+    uint32_t getClusterCount() const { return _config.gridX * _config.gridY * _config.gridZ; }
+    uint32_t getLightCount() const { return _lightCount; }
+
+private:
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::shared_ptr<DeviceBuffer> _lights;
+    std::shared_ptr<DeviceBuffer> _lightCounts;
+    std::shared_ptr<DeviceBuffer> _lightIndices;
+
+    std::shared_ptr<IComputePipeline> _cullPipeline;
+    std::shared_ptr<IBindGroup> _cullBindGroup;
+    std::shared_ptr<IBindGroupLayout> _shadingLayout;
+    std::shared_ptr<IBindGroup> _shadingBindGroup;
+
+    Mat4 _view{};
+    std::array<float, 4> _projection{};  // m[0], m[5], m[8], m[9]
+    float _near = 0.1f;
+    float _far = 1000.0f;
+    uint32_t _width = 1;
+    uint32_t _height = 1;
+    uint32_t _lightCount = 0;
+};
+
+} // namespace pers
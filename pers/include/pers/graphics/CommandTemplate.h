@@ -0,0 +1,155 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace pers {
+
+class IBindGroup;
+class IBuffer;
+class ICommandEncoder;
+class IPreparedRenderPass;
+class IRenderBundle;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class ITextureView;
+
+/**
+ * @brief Render pass command sequence recorded once and re-emitted every frame
+ *
+ * For workloads that encode the same stream frame after frame. Commands are
+ * recorded through the IRenderPassEncoder-like setters into flat arrays, and
+ * encode() replays them with one switch per command and no validation,
+ * sorting or descriptor translation. What changes between frames is patched
+ * in place: the target views through the prepared pass, and dynamic offsets
+ * through the parameter a setBindGroup() call returns:
+ *
+ *     CommandTemplate frame(factory->createPreparedRenderPass(desc));
+ *     frame.setPipeline(pipeline);
+ *     const auto object = frame.setBindGroup(0, group, offsets);
+ *     frame.draw(3);
+ *     ...
+ *     frame.setColorView(0, swapChain->getCurrentTextureView());  // per frame
+ *     frame.setDynamicOffsets(object, nextOffsets);
+ *     frame.encode(*commandEncoder);
+ *
+ * The template holds references to everything it records until clear().
+ * Unlike a render bundle it can set viewport, scissor, stencil and blend
+ * state, execute bundles, and be patched without re-recording.
+ */
+class CommandTemplate {
+public:
+    using Parameter = uint32_t;
+    static constexpr Parameter INVALID_PARAMETER = 0xFFFFFFFFu;
+
+    /**
+     * @param pass Pass encode(ICommandEncoder&) begins; may be null when only
+     *             encodeInto() is used
+     */
+    explicit CommandTemplate(std::shared_ptr<IPreparedRenderPass> pass = nullptr);
+    ~CommandTemplate();
+
+    CommandTemplate(const CommandTemplate&) = delete;
+    CommandTemplate& operator=(const CommandTemplate&) = delete;
+
+    // Recording; arguments match IRenderPassEncoder
+    void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline);
+
+    /**
+     * @return Parameter for setDynamicOffsets(), or INVALID_PARAMETER without offsets
+     */
+    Parameter setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                           std::span<const uint32_t> dynamicOffsets = {});
+    void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                         uint64_t offset = 0, uint64_t size = 0);
+    void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer, IndexFormat indexFormat,
+                        uint64_t offset = 0, uint64_t size = 0);
+    void setViewport(float x, float y, float width, float height, float minDepth = 0.0f, float maxDepth = 1.0f);
+    void setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+    void setStencilReference(uint32_t reference);
+    void setBlendConstant(const Color& color);
+    void draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0);
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0,
+                     int32_t baseVertex = 0, uint32_t firstInstance = 0);
+    void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0);
+    void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0);
+    void executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles);
+
+    /**
+     * @brief Replace the dynamic offsets of a recorded setBindGroup()
+     * @return false if parameter is unknown or the offset count differs
+     */
+    bool setDynamicOffsets(Parameter parameter, std::span<const uint32_t> dynamicOffsets);
+
+    /**
+     * @brief Retarget a color attachment of the prepared pass
+     */
+    bool setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view);
+
+    /**
+     * @brief Begin the prepared pass, replay the commands and end it
+     */
+    bool encode(ICommandEncoder& encoder) const;
+
+    /**
+     * @brief Replay the commands into an already open pass, e.g. a render graph pass
+     */
+    void encodeInto(IRenderPassEncoder& pass) const;
+
+    /**
+     * @brief Drop recorded commands and references, keeping storage and the pass
+     */
+    void clear();
+
+    const std::shared_ptr<IPreparedRenderPass>& getPass() const { return _pass; }
+    size_t getCommandCount() const { return _commands.size(); }
+
+private:
+    enum class Op : uint8_t {
+        SetPipeline,
+        SetBindGroup,
+        SetVertexBuffer,
+        SetIndexBuffer,
+        SetViewport,
+        SetScissorRect,
+        SetStencilReference,
+        SetBlendConstant,
+        Draw,
+        DrawIndexed,
+        DrawIndirect,
+        DrawIndexedIndirect,
+        ExecuteBundles
+    };
+
+    // resource indexes the array the op reads; floats are stored as their bits
+    struct Command {
+        Op op;
+        uint32_t resource = 0;
+        std::array<uint32_t, 6> values{};
+        uint64_t offset = 0;
+        uint64_t size = 0;
+    };
+
+    struct OffsetRange {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    Command& push(Op op);
+
+    std::shared_ptr<IPreparedRenderPass> _pass;
+    std::vector<Command> _commands;
+    std::vector<std::shared_ptr<IRenderPipeline>> _pipelines;
+    std::vector<std::shared_ptr<IBindGroup>> _bindGroups;
+    std::vector<std::shared_ptr<IBuffer>> _buffers;
+    std::vector<std::shared_ptr<IRenderBundle>> _bundles;
+    std::vector<uint32_t> _dynamicOffsets;
+    std::vector<OffsetRange> _parameters;
+};
+
+} // namespace pers
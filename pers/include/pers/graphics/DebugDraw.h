@@ -0,0 +1,176 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class DynamicBuffer;
+
+/**
+ * @brief Immediate-mode lines, shapes and text for diagnostics
+ *
+ * Primitives are accumulated on the CPU during the frame and drawn by
+ * render() with at most three instanced draws: depth-tested lines, overlay
+ * lines and text. Shapes are decomposed into line instances (two endpoints
+ * and a color), text into one instance per glyph of a built-in 5x7 ASCII
+ * font; nothing is vertex-buffered per primitive. Instances and uniforms
+ * go into one DynamicBuffer sub-allocated per frame, and primitives that no
+ * longer fit are dropped and counted rather than growing the buffer.
+ *
+ *     debug.aabb(bounds.min, bounds.max, DebugDraw::rgba(0, 255, 0));
+ *     debug.text(8, 8, "frame 0.42 ms", DebugDraw::rgba(255, 255, 255));
+ *     ...
+ *     debug.render(*pass, target, viewProjection, width, height);
+ *     pass->end();
+ *     debug.flush();                     // before queue submit
+ *     queue->submit(encoder->finish());
+ *     debug.nextFrame();                 // after queue submit, clears primitives
+ *
+ * Pipelines are created per Target through the resource factory, which
+ * shares them through its PipelineCache. Output is opaque; there is no
+ * blend state. Text coordinates are pixels from the top-left corner.
+ */
+class DebugDraw {
+public:
+    using Vec3 = std::array<float, 3>;
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    struct Config {
+        uint64_t bufferSize = 1 << 20;  // Per frame, shared by instances and uniforms
+        uint32_t frameCount = 3;
+    };
+
+    /**
+     * @brief Attachments of the pass render() records into
+     * depthFormat Undefined draws everything without depth testing.
+     */
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::BGRA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Undefined;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    DebugDraw(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~DebugDraw();
+
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+
+    bool isValid() const { return _pipelineLayout != nullptr; }
+
+    /**
+     * @brief Pack a color as Unorm8x4 in memory order
+     */
+    static constexpr uint32_t rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+        return uint32_t(r) | uint32_t(g) << 8 | uint32_t(b) << 16 | uint32_t(a) << 24;
+    }
+
+    void line(const Vec3& from, const Vec3& to, uint32_t color, bool depthTest = true);
+    void aabb(const Vec3& min, const Vec3& max, uint32_t color, bool depthTest = true);
+
+    /**
+     * @brief Edges of the unit cube [-0.5, 0.5]^3 under transform
+     */
+    void box(const Mat4& transform, uint32_t color, bool depthTest = true);
+
+    /**
+     * @brief Three great circles around center
+     */
+    void sphere(const Vec3& center, float radius, uint32_t color, bool depthTest = true, uint32_t segments = 24);
+
+    /**
+     * @brief X, Y and Z axes of transform in red, green and blue
+     */
+    void axes(const Mat4& transform, float length = 1.0f, bool depthTest = false);
+
+    /**
+     * @brief Edges of the frustum with this view-projection (depth range 0..1)
+     */
+    void frustum(const Mat4& viewProjection, uint32_t color, bool depthTest = true);
+
+    /**
+     * @brief Screen-space text; '\n' starts a new line, characters outside ASCII 32-126 draw as '?'
+     * @param scale Pixels per font texel
+     */
+    void text(float x, float y, std::string_view string, uint32_t color, float scale = 2.0f);
+
+    /**
+     * @brief Upload this frame's primitives and record their draws
+     * May be called once per view; primitives stay until nextFrame().
+     * @param viewProjection Column-major matrix for the 3D primitives
+     * @return Number of draws recorded
+     */
+    uint32_t render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                    uint32_t viewportWidth, uint32_t viewportHeight);
+
+    /**
+     * @brief Upload what render() wrote; call before queue submit
+     */
+    bool flush();
+
+    /**
+     * @brief Advance the buffer ring and clear the primitives; call after queue submit
+     */
+    void nextFrame();
+
+    void clear();
+
+    size_t getLineCount() const { return _lines[0].size() + _lines[1].size(); }
+    size_t getGlyphCount() const { return _glyphs.size(); }
+    uint64_t getDroppedCount() const { return _droppedCount; }
+
+private:
+    struct LineInstance {
+        Vec3 from;
+        uint32_t color;
+        Vec3 to;
+    };
+
+    struct GlyphInstance {
+        float x;
+        float y;
+        uint32_t glyph;  // Index into the font, character - 32
+        uint32_t color;
+        float scale;
+    };
+
+    struct Pipelines {
+        Target target;
+        std::shared_ptr<IRenderPipeline> depthLines;
+        std::shared_ptr<IRenderPipeline> overlayLines;
+        std::shared_ptr<IRenderPipeline> glyphs;
+    };
+
+    const Pipelines* getPipelines(const Target& target);
+    std::shared_ptr<IRenderPipeline> createPipeline(const Target& target, bool glyphs, bool depthTest) const;
+    void boxEdges(const std::array<Vec3, 8>& corners, uint32_t color, bool depthTest);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::unique_ptr<DynamicBuffer> _buffer;
+    std::shared_ptr<IShaderModule> _lineVertexShader;
+    std::shared_ptr<IShaderModule> _glyphVertexShader;
+    std::shared_ptr<IShaderModule> _lineFragmentShader;
+    std::shared_ptr<IShaderModule> _glyphFragmentShader;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::vector<Pipelines> _pipelines;
+
+    std::vector<LineInstance> _lines[2];  // Depth-tested, overlay
+    std::vector<GlyphInstance> _glyphs;
+    uint64_t _droppedCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+
+namespace pers {
+
+class IQueue;
+
+/**
+ * @brief Keeps retired GPU resources alive until the GPU is done with them
+ *
+ * Dropping the last reference to a buffer or texture releases its native
+ * handle right away, which is only safe once no submitted work still uses
+ * it. retire() takes over a reference and holds it until the queue's most
+ * recent submission, or an explicit fence, has completed; collect() then
+ * drops it. Streaming code can swap resources mid-frame without waitIdle.
+ *
+ * Resources are released in retirement order on the thread calling
+ * collect(). Owned by the logical device, see ILogicalDevice::getDeletionQueue();
+ * the swap chain collects once per presented frame.
+ *
+ *   deletionQueue->retire(std::move(oldTexture));  // Still sampled by in-flight frames
+ */
+class DeferredDeletionQueue {
+public:
+    struct Stats {
+        uint64_t retired = 0;   // Entries queued so far
+        uint64_t released = 0;  // Entries dropped after their fence completed
+        uint64_t pending = 0;   // Entries still waiting for the GPU
+    };
+
+    explicit DeferredDeletionQueue(const std::shared_ptr<IQueue>& queue);
+
+    /**
+     * @brief Release everything still queued
+     * The owner must have waited for the GPU, as the device does on shutdown.
+     */
+    ~DeferredDeletionQueue();
+
+    DeferredDeletionQueue(const DeferredDeletionQueue&) = delete;
+    DeferredDeletionQueue& operator=(const DeferredDeletionQueue&) = delete;
+
+    /**
+     * @brief Hold a resource until work submitted so far has completed
+     */
+    void retire(std::shared_ptr<void> resource);
+
+    /**
+     * @brief Hold a resource until fence completes
+     * An invalid fence falls back to the queue's most recent submission.
+     */
+    void retire(std::shared_ptr<void> resource, const SubmissionFence& fence);
+
+    /**
+     * @brief Run release once work submitted so far has completed
+     * For native handles that are not owned by a shared_ptr.
+     */
+    void retire(std::function<void()> release);
+    void retire(std::function<void()> release, const SubmissionFence& fence);
+
+    /**
+     * @brief Drop entries whose fence has completed, without blocking
+     * @return Number of entries released
+     */
+    size_t collect();
+
+    /**
+     * @brief Wait for every pending fence, then release all entries
+     * @return false if a fence did not complete in time; its entries are still released
+     */
+    bool flush(std::chrono::milliseconds timeout = SubmissionFence::DEFAULT_WAIT_TIMEOUT);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        SubmissionFence fence;
+        std::shared_ptr<void> resource;
+        std::function<void()> release;
+    };
+
+    SubmissionFence resolveFence(const SubmissionFence& fence) const;
+    void push(Entry entry);
+    static void releaseEntries(std::deque<Entry>& entries);
+
+    std::weak_ptr<IQueue> _queue;
+    mutable Mutex<false> _mutex;
+    std::deque<Entry> _entries;
+    uint64_t _retired = 0;
+    uint64_t _released = 0;
+};
+
+} // namespace pers
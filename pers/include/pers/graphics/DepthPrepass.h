@@ -0,0 +1,81 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include <memory>
+#include <unordered_map>
+
+namespace pers {
+
+class IResourceFactory;
+
+/**
+ * @brief Derives depth pre-pass pipelines from material pipelines
+ *
+ * The pre-pass draws opaque geometry with a depth-only pipeline: the
+ * material's vertex stage and layout, no color targets and no fragment
+ * stage, so bind groups set for the material stay valid. The shading pass
+ * then uses a copy of the material pipeline that tests depth with Equal and
+ * does not write it, running every fragment shader exactly once per pixel:
+ *
+ *     pass->setPipeline(prepass.getDepthPipeline(material));   // Depth only
+ *     drawOpaque(pass);
+ *     ...
+ *     pass->setPipeline(prepass.getShadingPipeline(material)); // Equal, no depth write
+ *     drawOpaque(pass);
+ *
+ * Both pipelines run the same vertex module, so positions match as long as
+ * the shader declares its position output @invariant or computes it the
+ * same way in every pipeline. Alpha-tested materials keep their fragment
+ * stage in the pre-pass so discard still carves the depth.
+ *
+ * Pipelines go through the factory and its PipelineCache, and are kept per
+ * material until the material pipeline is released.
+ */
+class DepthPrepass {
+public:
+    explicit DepthPrepass(const std::shared_ptr<IResourceFactory>& factory);
+    ~DepthPrepass() = default;
+
+    DepthPrepass(const DepthPrepass&) = delete;
+    DepthPrepass& operator=(const DepthPrepass&) = delete;
+
+    /**
+     * @brief Depth-only variant of a material descriptor
+     * @param alphaTested Keep the fragment stage for shaders that discard
+     * @return Descriptor with no color targets; vertex is null if the material has no depth format
+     */
+    static RenderPipelineDesc makeDepthOnlyDesc(const RenderPipelineDesc& material, bool alphaTested = false);
+
+    /**
+     * @brief Shading variant that only passes fragments the pre-pass left in front
+     */
+    static RenderPipelineDesc makeShadingDesc(const RenderPipelineDesc& material);
+
+    /**
+     * @return Pipeline or nullptr if the material is not ready or has no depth format
+     */
+    std::shared_ptr<IRenderPipeline> getDepthPipeline(const std::shared_ptr<IRenderPipeline>& material,
+                                                      bool alphaTested = false);
+    std::shared_ptr<IRenderPipeline> getShadingPipeline(const std::shared_ptr<IRenderPipeline>& material);
+
+    /**
+     * @brief Drop pipelines whose material pipeline was released
+     */
+    void purge();
+
+private:
+    struct Variants {
+        std::weak_ptr<IRenderPipeline> material;
+        std::shared_ptr<IRenderPipeline> depth;
+        std::shared_ptr<IRenderPipeline> alphaTestedDepth;
+        std::shared_ptr<IRenderPipeline> shading;
+    };
+
+    Variants* findVariants(const std::shared_ptr<IRenderPipeline>& material);
+    std::shared_ptr<IRenderPipeline> createPipeline(const RenderPipelineDesc& desc) const;
+
+    std::weak_ptr<IResourceFactory> _factory;
+    std::unordered_map<const IRenderPipeline*, Variants> _variants;
+};
+
+} // namespace pers
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/OffscreenRenderQueue.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class IInstance;
+class ILogicalDevice;
+
+/**
+ * @brief One logical device per GPU with offscreen jobs spread across them
+ *
+ * Each device gets its own OffscreenRenderQueue. submit() hands a job to the
+ * device with the fewest jobs in flight, so every GPU stays busy while the
+ * caller records and throughput grows with the number of adapters.
+ *
+ * Pipelines, bind groups and buffers belong to one device. Create them per
+ * device up front and pick them by the index the record function receives.
+ */
+class DevicePool {
+public:
+    using RecordFunction = std::function<bool(uint32_t deviceIndex, ICommandEncoder& encoder, const IFramebuffer& target)>;
+
+    struct Config {
+        LogicalDeviceDesc deviceDesc;
+        uint32_t maxDevices = 0;                 // 0 = every enumerated adapter
+        uint32_t maxInFlightPerDevice = OffscreenRenderQueue::DEFAULT_MAX_IN_FLIGHT;
+    };
+
+    struct DeviceStats {
+        std::string deviceName;
+        OffscreenRenderQueue::Stats queue;
+        uint32_t inFlight = 0;
+    };
+
+    /**
+     * @brief Enumerate the instance's adapters and create a device on each
+     * @return Pool, or null if no device could be created
+     */
+    static std::unique_ptr<DevicePool> create(const std::shared_ptr<IInstance>& instance, const Config& config);
+
+    ~DevicePool();
+
+    DevicePool(const DevicePool&) = delete;
+    DevicePool& operator=(const DevicePool&) = delete;
+
+    uint32_t getDeviceCount() const { return static_cast<uint32_t>(_devices.size()); }
+    std::shared_ptr<ILogicalDevice> getDevice(uint32_t index) const;
+    const std::string& getDeviceName(uint32_t index) const { return _devices[index].name; }
+
+    /**
+     * @brief Queue of one device, for callers that drive each device from its own thread
+     * A queue is not thread-safe; do not mix this with submit() and poll().
+     */
+    OffscreenRenderQueue* getQueue(uint32_t index) const;
+
+    /**
+     * @brief Submit a job to the least loaded device
+     * @return Job id, unique within its device, 0 on failure
+     */
+    uint64_t submit(const OffscreenRenderJobDesc& desc, const RecordFunction& record,
+                    OffscreenRenderQueue::CompletionFunction onComplete, uint32_t* deviceIndex = nullptr);
+
+    /**
+     * @brief Deliver finished jobs of every device without blocking
+     */
+    size_t poll();
+
+    /**
+     * @brief Wait for every device's jobs
+     * @return false if any device timed out
+     */
+    bool waitIdle(std::chrono::milliseconds timeout = OffscreenRenderQueue::DEFAULT_WAIT_TIMEOUT);
+
+    std::vector<DeviceStats> getStats() const;
+
+private:
+    struct Entry {
+        std::shared_ptr<IPhysicalDevice> physicalDevice;
+        std::shared_ptr<ILogicalDevice> device;
+        std::unique_ptr<OffscreenRenderQueue> queue;
+        std::string name;
+    };
+
+    DevicePool() = default;
+
+    uint32_t pickDevice() const;
+
+    std::vector<Entry> _devices;
+};
+
+} // namespace pers
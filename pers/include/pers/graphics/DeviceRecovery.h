@@ -0,0 +1,211 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class JobSystem;
+
+/**
+ * @brief GPU object that DeviceRecovery recreates after a device loss
+ *
+ * get() returns the object of the current device. The generation changes
+ * with every recreation, so anything keyed on the object (caches, recorded
+ * render bundles) can tell it has to rebuild.
+ */
+template<typename T>
+class Recoverable {
+public:
+    const std::shared_ptr<T>& get() const { return _object; }
+    T* operator->() const { return _object.get(); }
+    explicit operator bool() const { return _object != nullptr; }
+    uint32_t getGeneration() const { return _generation; }
+
+private:
+    friend class DeviceRecovery;
+
+    std::shared_ptr<T> _object;
+    uint32_t _generation = 0;
+};
+
+template<typename T>
+using RecoverableHandle = std::shared_ptr<Recoverable<T>>;
+
+/**
+ * @brief Order in which recover() rebuilds objects; each stage may use the ones before
+ */
+enum class RecoveryStage : uint32_t {
+    Resources,   // Buffers, textures, samplers, shader modules, bind group layouts
+    Views,       // Texture views
+    Layouts,     // Pipeline layouts
+    Pipelines,   // Render and compute pipelines
+    BindGroups,
+    Count
+};
+
+/**
+ * @brief Resource registry that survives device loss
+ *
+ * Objects created through the registry keep their creation descriptor and
+ * a way to get their contents back: a CPU copy (keepCopy) or a reference
+ * into a cooked file (fromFile). When the device is lost, recover() creates
+ * a new device on the same adapter and replays every live object stage by
+ * stage, each stage in parallel, instead of reloading the scene from disk.
+ * Pipelines are rebuilt through the new factory's PipelineCache, so equal
+ * pipelines compile once.
+ *
+ * Objects that depend on other objects take a builder that reads the
+ * current handles, so the replayed desc points at the new objects:
+ *
+ *     auto shader = recovery.createShaderModule(shaderDesc);
+ *     auto pipeline = recovery.createRenderPipeline([=] {
+ *         RenderPipelineDesc desc = pipelineDesc;
+ *         desc.vertex.module = shader->get();
+ *         return desc;
+ *     });
+ *
+ * Handles are shared; an object whose handle is dropped is not replayed.
+ * Creation is thread-safe, recover() must run while nothing records or
+ * reads handles, typically between frames:
+ *
+ *     if (recovery.isLost() && recovery.recover()) { rebuildSwapChain(recovery.getDevice()); }
+ */
+class DeviceRecovery {
+public:
+    using ContentFunction = std::function<bool(std::vector<uint8_t>& contents)>;
+    using TextureContentFunction = std::function<bool(uint32_t mipLevel, std::vector<uint8_t>& contents)>;
+    using DeviceFunction = std::function<std::shared_ptr<ILogicalDevice>()>;
+    using RecoveredFunction = std::function<void(const std::shared_ptr<ILogicalDevice>& device)>;
+
+    struct Stats {
+        uint32_t objects = 0;        // Live registered objects
+        uint32_t recoveries = 0;
+        uint32_t failedObjects = 0;  // Objects the last recover() could not recreate
+        double lastRecoveryMs = 0.0;
+    };
+
+    /**
+     * @param device Device objects are created on until the first recovery
+     * @param deviceDesc Desc recover() creates the replacement with
+     * @param jobSystem Runs each stage in parallel; null uses temporary threads
+     */
+    DeviceRecovery(const std::shared_ptr<ILogicalDevice>& device, const LogicalDeviceDesc& deviceDesc,
+                   JobSystem* jobSystem = nullptr);
+    ~DeviceRecovery() = default;
+
+    DeviceRecovery(const DeviceRecovery&) = delete;
+    DeviceRecovery& operator=(const DeviceRecovery&) = delete;
+
+    /**
+     * @brief Contents kept as a CPU copy
+     */
+    static ContentFunction keepCopy(std::span<const uint8_t> data);
+
+    /**
+     * @brief Contents read back from a byte range of a cooked file, size 0 = to the end
+     */
+    static ContentFunction fromFile(const std::string& path, uint64_t offset = 0, uint64_t size = 0);
+
+    /**
+     * @brief Each mip level tightly packed, as IQueue::writeTexture() takes it
+     */
+    static TextureContentFunction keepMipCopies(std::vector<std::vector<uint8_t>> mipLevels);
+
+    RecoverableHandle<INativeBuffer> createBuffer(const BufferDesc& desc, ContentFunction contents = nullptr);
+    RecoverableHandle<ITexture> createTexture(const TextureDesc& desc, TextureContentFunction contents = nullptr);
+    RecoverableHandle<ITextureView> createTextureView(const RecoverableHandle<ITexture>& texture, const TextureViewDesc& desc);
+    RecoverableHandle<ISampler> createSampler(const SamplerDesc& desc);
+    RecoverableHandle<IShaderModule> createShaderModule(const ShaderModuleDesc& desc);
+    RecoverableHandle<IBindGroupLayout> createBindGroupLayout(const BindGroupLayoutDesc& desc);
+    RecoverableHandle<IPipelineLayout> createPipelineLayout(std::function<PipelineLayoutDesc()> build);
+    RecoverableHandle<IRenderPipeline> createRenderPipeline(std::function<RenderPipelineDesc()> build);
+    RecoverableHandle<IComputePipeline> createComputePipeline(std::function<ComputePipelineDesc()> build);
+    RecoverableHandle<IBindGroup> createBindGroup(std::function<BindGroupDesc()> build);
+
+    /**
+     * @brief Register any other object with its own creation function
+     * @return Null handle if the first creation fails
+     */
+    template<typename T>
+    RecoverableHandle<T> createCustom(RecoveryStage stage, std::function<std::shared_ptr<T>(ILogicalDevice& device)> create);
+
+    /**
+     * @brief Replace the default replacement device (same adapter, same desc)
+     */
+    void setDeviceFunction(DeviceFunction createDevice) { _createDevice = std::move(createDevice); }
+
+    /**
+     * @brief Called after every successful recover(), e.g. to rebuild swap chains
+     */
+    void addRecoveredCallback(RecoveredFunction callback);
+
+    bool isLost() const;
+
+    /**
+     * @brief Create a new device and recreate every live object on it
+     * @return false if no device could be created or some object failed
+     */
+    bool recover(std::string* error = nullptr);
+
+    std::shared_ptr<ILogicalDevice> getDevice() const;
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        RecoveryStage stage = RecoveryStage::Resources;
+        std::function<bool(ILogicalDevice& device)> recreate;  // true if created or no longer needed
+        std::function<void()> release;
+        std::function<bool()> expired;
+    };
+
+    bool addEntry(Entry entry);
+    size_t runParallel(size_t count, const std::function<bool(size_t index)>& task);
+
+    std::shared_ptr<ILogicalDevice> _device;
+    LogicalDeviceDesc _deviceDesc;
+    JobSystem* _jobSystem = nullptr;
+    DeviceFunction _createDevice;
+
+    mutable std::mutex _mutex;
+    std::vector<Entry> _entries;  // In creation order
+    std::vector<RecoveredFunction> _recoveredCallbacks;
+    Stats _stats;
+};
+
+template<typename T>
+RecoverableHandle<T> DeviceRecovery::createCustom(RecoveryStage stage,
+                                                  std::function<std::shared_ptr<T>(ILogicalDevice& device)> create) {
+    auto handle = std::make_shared<Recoverable<T>>();
+    std::weak_ptr<Recoverable<T>> weak = handle;
+
+    Entry entry;
+    entry.stage = stage;
+    entry.recreate = [weak, create = std::move(create)](ILogicalDevice& device) {
+        auto target = weak.lock();
+        if (!target) {
+            return true;
+        }
+        target->_object = create(device);
+        ++target->_generation;
+        return target->_object != nullptr;
+    };
+    entry.release = [weak] {
+        if (auto target = weak.lock()) {
+            target->_object.reset();
+        }
+    };
+    entry.expired = [weak] { return weak.expired(); };
+
+    return addEntry(std::move(entry)) ? handle : nullptr;
+}
+
+} // namespace pers
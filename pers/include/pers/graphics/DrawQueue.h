@@ -0,0 +1,132 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class IBindGroup;
+class IBuffer;
+class IRenderPassEncoder;
+class IRenderPipeline;
+
+/**
+ * @brief One draw recorded into a DrawQueue
+ *
+ * Indexed when indexBuffer is set, otherwise vertexCount vertices are drawn.
+ * Bind groups are set in slot order; bit N of dynamicOffsetMask passes
+ * dynamicOffsets[N] with bind group N.
+ */
+struct DrawCommand {
+    static constexpr uint32_t MAX_BIND_GROUPS = 4;
+
+    std::shared_ptr<IRenderPipeline> pipeline;
+    std::array<std::shared_ptr<IBindGroup>, MAX_BIND_GROUPS> bindGroups;
+    std::array<uint32_t, MAX_BIND_GROUPS> dynamicOffsets{};
+    uint32_t dynamicOffsetMask = 0;
+
+    std::shared_ptr<IBuffer> vertexBuffer;
+    uint64_t vertexOffset = 0;
+    std::shared_ptr<IBuffer> indexBuffer;
+    IndexFormat indexFormat = IndexFormat::Uint32;
+    uint64_t indexOffset = 0;
+
+    uint32_t vertexCount = 0;
+    uint32_t firstVertex = 0;
+    uint32_t indexCount = 0;
+    uint32_t instanceCount = 1;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t firstInstance = 0;
+};
+
+/**
+ * @brief Draw list sorted by packed 64-bit keys before encoding
+ *
+ * Opaque keys are pass(8) | pipeline(16) | bind group 0(16) | depth(24) so a
+ * pass changes pipeline and material as rarely as possible and draws each
+ * state run front to back for early-Z. Translucent keys put depth right after
+ * the pass, back to front, since blending order wins over state changes.
+ *
+ * Pipeline and bind group IDs are handed out on first sight and stay stable
+ * across frames, so equal state sorts next to itself frame after frame. IDs
+ * key on object addresses; call resetStateIds() after releasing many
+ * pipelines or bind groups. The queue holds references until clear().
+ */
+class DrawQueue {
+public:
+    enum class Order {
+        Opaque,       // State first, then front to back
+        Translucent   // Back to front
+    };
+
+    struct Stats {
+        uint32_t draws = 0;
+        uint32_t pipelineChanges = 0;
+        uint32_t bindGroupChanges = 0;
+        uint32_t bufferChanges = 0;
+    };
+
+    DrawQueue() = default;
+    ~DrawQueue() = default;
+
+    DrawQueue(const DrawQueue&) = delete;
+    DrawQueue& operator=(const DrawQueue&) = delete;
+
+    /**
+     * @brief Queue a draw
+     * @param pass Pass the draw belongs to; encode() draws one pass at a time
+     * @param viewDepth Distance along the view direction, >= 0
+     */
+    void add(const DrawCommand& command, uint8_t pass, float viewDepth, Order order = Order::Opaque);
+
+    /**
+     * @brief Sort all queued draws by key (LSD radix sort)
+     */
+    void sort();
+
+    /**
+     * @brief Encode the draws of one pass in key order, skipping redundant state
+     * sort() must have run since the last add().
+     * @return Number of draws encoded
+     */
+    uint32_t encode(IRenderPassEncoder& encoder, uint8_t pass);
+
+    /**
+     * @brief Drop queued draws, keeping storage and state IDs
+     */
+    void clear();
+
+    /**
+     * @brief Forget pipeline and bind group IDs; only valid with an empty queue
+     */
+    void resetStateIds();
+
+    size_t getDrawCount() const { return _commands.size(); }
+    Stats getStats() const { return _stats; }
+
+    static uint64_t makeKey(uint8_t pass, uint16_t pipelineId, uint16_t bindGroupId, float viewDepth, Order order);
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t command;
+    };
+
+    uint16_t getStateId(std::unordered_map<const void*, uint16_t>& ids, const void* object);
+
+    std::vector<DrawCommand> _commands;
+    std::vector<SortEntry> _entries;
+    std::vector<SortEntry> _scratch;
+    bool _sorted = true;
+
+    std::unordered_map<const void*, uint16_t> _pipelineIds;
+    std::unordered_map<const void*, uint16_t> _bindGroupIds;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class ISampler;
+class IFramebuffer;
+class OffscreenFramebuffer;
+class DeviceBuffer;
+struct GpuFrameTiming;
+
+struct DynamicResolutionConfig {
+    double targetFrameMilliseconds = 1000.0 / 60.0;
+    float headroom = 0.9f;        // Fraction of the target the GPU is steered to
+    float minScale = 0.5f;        // Per-axis bounds of the render scale
+    float maxScale = 1.0f;
+    float maxStep = 0.05f;        // Largest scale change per new timing result
+    float deadband = 0.05f;       // Relative time error ignored, against oscillation
+    float smoothing = 0.25f;      // Weight of a new sample in the moving average
+    uint32_t alignment = 8;       // Render sizes are rounded down to a multiple of this
+};
+
+/**
+ * @brief Render scale steered by GPU frame time, plus the upscale to the surface
+ *
+ * The scene renders into OffscreenFramebuffers allocated once at the maximum
+ * size; each frame only the top-left getRenderWidth() x getRenderHeight()
+ * region is drawn through a viewport, so scaling never reallocates:
+ *
+ *     timer.collect();
+ *     resolution.update(timer.getLastReport());
+ *     auto pass = encoder->beginRenderPass(sceneDesc);
+ *     resolution.applyViewport(*pass, scene);
+ *     ...
+ *     resolution.upscale(*encoder, scene, surfaceFramebuffer);
+ *
+ * GPU time scales with pixel count, so the per-axis scale moves by the
+ * square root of target / smoothed time, limited to maxStep per result.
+ * GpuPassTimer reports arrive a few frames late; a report is applied once,
+ * on the first update() that sees its frameIndex, which together with the
+ * step limit and deadband keeps the controller from chasing its own lag.
+ *
+ * The upscale is a fullscreen bilinear pass reading the rendered region of
+ * color attachment 0 into the destination's color attachment 0, which may
+ * be the surface in any renderable format. It clamps samples to the region
+ * so texels outside the viewport, stale from larger frames, never bleed in.
+ * With motion vectors, TemporalUpscaler::resolve() takes the place of
+ * upscale() and reconstructs detail instead of stretching it.
+ */
+class DynamicResolution {
+public:
+    explicit DynamicResolution(const std::shared_ptr<ILogicalDevice>& device,
+                               const DynamicResolutionConfig& config = {});
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    bool isValid() const { return _pipelineLayout != nullptr; }
+
+    /**
+     * @brief Feed the latest timer report; repeats of an applied frame are ignored
+     * @return true if the scale changed
+     */
+    bool update(const GpuFrameTiming& timing);
+
+    /**
+     * @brief Feed one GPU frame time directly, e.g. from another timer
+     */
+    bool update(double gpuMilliseconds);
+
+    /**
+     * @brief Restart at scale, dropping the averaged history
+     */
+    void reset(float scale = 1.0f);
+
+    float getScale() const { return _scale; }
+    double getSmoothedMilliseconds() const { return _smoothedMilliseconds; }
+    const DynamicResolutionConfig& getConfig() const { return _config; }
+    void setConfig(const DynamicResolutionConfig& config);
+
+    /**
+     * @brief Size of the rendered region inside a target allocated at maxWidth x maxHeight
+     */
+    uint32_t getRenderWidth(uint32_t maxWidth) const;
+    uint32_t getRenderHeight(uint32_t maxHeight) const;
+
+    /**
+     * @brief Restrict an open pass on target to the rendered region
+     */
+    void applyViewport(IRenderPassEncoder& pass, const IFramebuffer& target) const;
+
+    /**
+     * @brief Record the bilinear upscale of source's rendered region into destination
+     * @return false if an attachment is missing or a resource failed to create
+     */
+    bool upscale(ICommandEncoder& encoder, const OffscreenFramebuffer& source, const IFramebuffer& destination);
+
+private:
+    uint32_t scaledSize(uint32_t maxSize) const;
+    std::shared_ptr<IRenderPipeline> getPipeline(TextureFormat format);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    DynamicResolutionConfig _config;
+    float _scale = 1.0f;
+    double _smoothedMilliseconds = 0.0;
+    uint64_t _lastFrameIndex = 0;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::shared_ptr<ISampler> _sampler;
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::unordered_map<TextureFormat, std::shared_ptr<IRenderPipeline>> _pipelines;
+};
+
+} // namespace pers
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Id meaning "no resource" in capture records and commands
+ */
+constexpr uint32_t CAPTURE_NONE = 0xFFFFFFFFu;
+
+/**
+ * @brief Opcodes of the FrameCapture command stream
+ *
+ * Each command starts with its opcode byte; encoder commands are followed by
+ * the encoder id, pass commands by the pass id, so commands of encoders
+ * recorded on different threads can interleave.
+ */
+enum class CaptureCommand : uint8_t {
+    WriteBuffer,               // buffer, offset, bytes (IQueue::writeBuffer)
+    BeginEncoder,              // encoder
+    UploadBuffer,              // encoder, buffer, offset, bytes (staging upload)
+    CopyBuffer,                // encoder, source, sourceOffset, destination, destinationOffset, size
+    BeginRenderPass,           // encoder, pass, color attachments, depth attachment, label
+    SetPipeline,               // pass, pipeline
+    SetBindGroup,              // pass, index, bind group, dynamic offsets
+    SetVertexBuffer,           // pass, slot, buffer, offset, size
+    SetIndexBuffer,            // pass, buffer, format, offset, size
+    SetViewport,               // pass, x, y, width, height, minDepth, maxDepth
+    SetScissorRect,            // pass, x, y, width, height
+    SetStencilReference,       // pass, reference
+    SetBlendConstant,          // pass, r, g, b, a
+    SetPushConstants,          // pass, stages, offset, bytes
+    Draw,                      // pass, vertexCount, instanceCount, firstVertex, firstInstance
+    DrawIndexed,               // pass, indexCount, instanceCount, firstIndex, baseVertex, firstInstance
+    DrawIndirect,              // pass, buffer, offset
+    DrawIndexedIndirect,       // pass, buffer, offset
+    MultiDrawIndirect,         // pass, buffer, offset, drawCount
+    MultiDrawIndexedIndirect,  // pass, buffer, offset, drawCount
+    MultiDrawIndirectCount,         // pass, buffer, offset, maxDrawCount, count buffer, count offset
+    MultiDrawIndexedIndirectCount,  // pass, buffer, offset, maxDrawCount, count buffer, count offset
+    EndRenderPass,             // pass
+    Finish,                    // encoder
+    Submit                     // encoder count, encoders
+};
+
+struct CapturedBuffer {
+    uint64_t size = 0;
+    BufferUsage usage = BufferUsage::None;
+    std::string debugName;
+    std::vector<std::byte> contents;  // Empty when the contents could not be read back
+};
+
+/**
+ * @brief Texture recreated for one captured texture view
+ * Views do not expose their texture, so each view gets its own texture of
+ * the view's size and format. Contents are not captured.
+ */
+struct CapturedTexture {
+    uint32_t width = 1;
+    uint32_t height = 1;
+    uint32_t sampleCount = 1;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    TextureViewDimension dimension = TextureViewDimension::D2;
+    TextureUsage usage = TextureUsage::None;
+};
+
+struct CapturedShader {
+    ShaderStage stage = ShaderStage::None;
+    std::string entryPoint;
+    std::string debugName;
+    std::string code;
+    std::vector<uint32_t> spirv;  // Empty for WGSL shaders
+};
+
+struct CapturedPipelineLayout {
+    std::vector<uint32_t> bindGroupLayouts;
+    std::vector<PushConstantRange> pushConstantRanges;
+    std::string debugName;
+};
+
+struct CapturedRenderPipeline {
+    uint32_t vertex = CAPTURE_NONE;
+    uint32_t fragment = CAPTURE_NONE;
+    uint32_t layout = CAPTURE_NONE;  // NONE lets the factory derive one
+    RenderPipelineDesc state;        // Shaders and layout are null, see the ids above
+};
+
+struct CapturedBindGroupEntry {
+    uint32_t binding = 0;
+    uint32_t buffer = CAPTURE_NONE;
+    uint64_t offset = 0;
+    uint64_t size = BufferCopyDesc::WHOLE_SIZE;
+    uint32_t textureView = CAPTURE_NONE;
+    uint32_t sampler = CAPTURE_NONE;
+    std::vector<uint32_t> buffers;
+    std::vector<uint32_t> textureViews;
+    std::vector<uint32_t> samplers;
+};
+
+struct CapturedBindGroup {
+    uint32_t layout = CAPTURE_NONE;
+    std::vector<CapturedBindGroupEntry> entries;
+    std::string debugName;
+};
+
+/**
+ * @brief Resources and commands of one captured frame
+ *
+ * Produced by CaptureRecorder and executed by FrameReplayer. Resource ids in
+ * the command stream index the vectors below. save()/load() store the
+ * capture as one binary file.
+ */
+struct FrameCapture {
+    static constexpr uint32_t FORMAT_VERSION = 8;
+
+    std::vector<CapturedBuffer> buffers;
+    std::vector<CapturedTexture> textures;
+    std::vector<SamplerDesc> samplers;
+    std::vector<CapturedShader> shaders;
+    std::vector<BindGroupLayoutDesc> bindGroupLayouts;
+    std::vector<CapturedPipelineLayout> pipelineLayouts;
+    std::vector<CapturedRenderPipeline> pipelines;
+    std::vector<CapturedBindGroup> bindGroups;
+
+    std::vector<std::byte> commands;
+    uint32_t commandCount = 0;
+    uint32_t encoderCount = 0;
+    uint32_t passCount = 0;
+    uint32_t skippedCommands = 0;  // Calls the capture cannot express, see CaptureRecorder
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+namespace detail {
+
+/**
+ * @brief Appends little-endian values to a capture byte stream
+ */
+class CaptureWriter {
+public:
+    explicit CaptureWriter(std::vector<std::byte>& bytes) : _bytes(bytes) {}
+
+    void u8(uint8_t value) { raw(&value, sizeof(value)); }
+    void u32(uint32_t value) { raw(&value, sizeof(value)); }
+    void u64(uint64_t value) { raw(&value, sizeof(value)); }
+    void i32(int32_t value) { raw(&value, sizeof(value)); }
+    void f32(float value) { raw(&value, sizeof(value)); }
+    void str(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        raw(value.data(), value.size());
+    }
+    void bytes(std::span<const std::byte> value) {
+        u64(value.size());
+        raw(value.data(), value.size());
+    }
+
+    template<typename E>
+    void enumValue(E value) { u32(static_cast<uint32_t>(value)); }
+
+private:
+    void raw(const void* data, size_t size) {
+        const auto* begin = static_cast<const std::byte*>(data);
+        _bytes.insert(_bytes.end(), begin, begin + size);
+    }
+
+    std::vector<std::byte>& _bytes;
+};
+
+/**
+ * @brief Reads values written by CaptureWriter, failing instead of overrunning
+ */
+class CaptureReader {
+public:
+    explicit CaptureReader(std::span<const std::byte> bytes) : _bytes(bytes) {}
+
+    uint8_t u8() { return value<uint8_t>(); }
+    uint32_t u32() { return value<uint32_t>(); }
+    uint64_t u64() { return value<uint64_t>(); }
+    int32_t i32() { return value<int32_t>(); }
+    float f32() { return value<float>(); }
+    std::string str() {
+        const uint32_t size = u32();
+        if (!take(size)) {
+            return {};
+        }
+        return std::string(reinterpret_cast<const char*>(_bytes.data() + _offset - size), size);
+    }
+    std::span<const std::byte> bytes() {
+        const uint64_t size = u64();
+        if (!take(size)) {
+            return {};
+        }
+        return _bytes.subspan(_offset - size, size);
+    }
+
+    template<typename E>
+    E enumValue() { return static_cast<E>(u32()); }
+
+    bool ok() const { return _ok; }
+    void fail() { _ok = false; }
+    bool atEnd() const { return _offset == _bytes.size(); }
+    size_t remaining() const { return _bytes.size() - _offset; }
+
+private:
+    bool take(uint64_t size) {
+        if (!_ok || size > _bytes.size() - _offset) {
+            _ok = false;
+            return false;
+        }
+        _offset += size;
+        return true;
+    }
+
+    template<typename T>
+    T value() {
+        T result{};
+        if (take(sizeof(T))) {
+            std::memcpy(&result, _bytes.data() + _offset - sizeof(T), sizeof(T));
+        }
+        return result;
+    }
+
+    std::span<const std::byte> _bytes;
+    size_t _offset = 0;
+    bool _ok = true;
+};
+
+} // namespace detail
+
+} // namespace pers
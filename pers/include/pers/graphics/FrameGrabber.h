@@ -0,0 +1,145 @@
+#pragma once
+
+#include "pers/core/JobSystem.h"
+#include "pers/graphics/GraphicsFormats.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ITexture;
+class ReadbackRing;
+
+enum class FrameEncoding {
+    Raw,  // Tightly packed RGBA8
+    Png
+};
+
+/**
+ * @brief One captured frame, valid only for the duration of the callback
+ */
+struct CapturedFrame {
+    uint64_t frameIndex = 0;  // As passed to capture()
+    uint32_t width = 0;
+    uint32_t height = 0;
+    FrameEncoding encoding = FrameEncoding::Raw;
+    std::vector<uint8_t> data;
+};
+
+struct FrameGrabberDesc {
+    // Largest capture; slots hold maxHeight rows of the aligned pitch of format
+    uint32_t maxWidth = 1920;
+    uint32_t maxHeight = 1080;
+    TextureFormat format = TextureFormat::BGRA8Unorm;
+
+    uint32_t slotCount = 4;
+    uint32_t maxPendingEncodes = 8;  // Frames queued on workers before poll() drops
+    FrameEncoding encoding = FrameEncoding::Png;
+    bool opaque = true;              // Write alpha 255, swap chain alpha is rarely meaningful
+
+    // Called on a worker in capture order, one frame at a time
+    std::function<void(const CapturedFrame&)> onFrame;
+};
+
+/**
+ * @brief Continuous screenshot and video capture without stalling the frame
+ *
+ * capture() records a texture-to-buffer copy into a ReadbackRing slot, with
+ * rows padded to the 256-byte pitch the copy requires. Once the map
+ * resolves, poll() strips the padding into a pooled buffer on the calling
+ * thread and hands the frame to a JobSystem worker, which converts it to
+ * RGBA8 (BGRA8, RGBA8 and RGBA16Float are supported, sRGB values are kept
+ * as stored) and encodes it. Results reach onFrame in capture order.
+ *
+ *     // Swap chain created with SwapChainDesc::usage including CopySrc
+ *     grabber.capture(encoder, surface->getCurrentTexture(), frameIndex);
+ *     queue->submit(encoder->finish());
+ *     grabber.submitted();
+ *     grabber.poll();
+ *
+ * When every ring slot is in flight or maxPendingEncodes frames are
+ * waiting for a worker, frames are dropped and counted instead of
+ * throttling the renderer. The grabber must outlive its jobs; the
+ * destructor waits for them.
+ */
+class FrameGrabber {
+public:
+    FrameGrabber(const std::shared_ptr<ILogicalDevice>& device, JobSystem& jobs, FrameGrabberDesc desc);
+    ~FrameGrabber();
+
+    FrameGrabber(const FrameGrabber&) = delete;
+    FrameGrabber& operator=(const FrameGrabber&) = delete;
+
+    bool isValid() const;
+
+    /**
+     * @brief Record a copy of mip 0 of the texture
+     * The texture needs CopySrc usage; swap chain images stay valid until present.
+     * @return false if the frame was dropped or cannot be captured
+     */
+    bool capture(const std::shared_ptr<ICommandEncoder>& encoder, const std::shared_ptr<ITexture>& texture,
+                 uint64_t frameIndex);
+
+    /**
+     * @brief Start the maps of this frame's captures, after the encoder was submitted
+     */
+    void submitted();
+
+    /**
+     * @brief Hand finished readbacks to workers; call once per frame
+     * @return Number of frames scheduled for encoding
+     */
+    uint32_t poll();
+
+    /**
+     * @brief Wait until every scheduled frame was delivered
+     * Captures whose readback has not resolved yet are kept for later polls.
+     */
+    void flush();
+
+    uint64_t getCapturedCount() const { return _capturedCount.load(std::memory_order_relaxed); }
+    uint64_t getDroppedCount() const;
+
+private:
+    struct PendingCapture {
+        uint64_t ticket = 0;
+        uint64_t frameIndex = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t bytesPerRow = 0;
+        TextureFormat format = TextureFormat::Undefined;
+    };
+
+    void encode(uint64_t sequence, PendingCapture capture, std::vector<uint8_t> pixels);
+    void deliver(uint64_t sequence, CapturedFrame frame);
+    std::vector<uint8_t> takeBuffer();
+    void recycleBuffer(std::vector<uint8_t> buffer);
+
+    JobSystem& _jobs;
+    FrameGrabberDesc _desc;
+    std::unique_ptr<ReadbackRing> _ring;
+
+    // Owner thread only
+    std::deque<PendingCapture> _pending;
+    std::vector<JobHandle> _encodeJobs;
+    uint64_t _nextSequence = 0;
+    uint64_t _droppedEncodes = 0;
+
+    std::mutex _poolMutex;
+    std::vector<std::vector<uint8_t>> _freeBuffers;
+
+    std::mutex _deliveryMutex;
+    std::map<uint64_t, CapturedFrame> _completed;  // Encoded out of order, waiting for earlier frames
+    uint64_t _nextDelivery = 0;
+    std::atomic<uint64_t> _capturedCount{0};  // Delivered frames
+};
+
+} // namespace pers
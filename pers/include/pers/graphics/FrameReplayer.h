@@ -0,0 +1,109 @@
+#pragma once
+
+#include "pers/graphics/FrameCapture.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class IBindGroup;
+class IBindGroupLayout;
+class IBuffer;
+class ILogicalDevice;
+class IPipelineLayout;
+class IRenderPipeline;
+class ISampler;
+class IShaderModule;
+class ITexture;
+class ITextureView;
+
+/**
+ * @brief Re-executes a FrameCapture on a device, without the application
+ *
+ * prepare() creates every captured resource and decodes the command stream
+ * once; replay() then encodes and submits the frame as often as asked and
+ * times it, so an expensive frame can be profiled and compared across
+ * drivers or builds in isolation:
+ *
+ *     FrameReplayer replayer(device);
+ *     FrameReplayer::Stats stats;
+ *     if (replayer.prepare(capture) && replayer.replay(100, stats)) { ... }
+ *
+ * Buffers are reset to their captured contents before every iteration.
+ * Staging uploads are replayed as queue writes, which the queue orders before
+ * the submit that follows them.
+ */
+class FrameReplayer {
+public:
+    struct Timing {
+        double minMs = 0.0;
+        double medianMs = 0.0;
+        double maxMs = 0.0;
+        double meanMs = 0.0;
+    };
+
+    struct Stats {
+        uint32_t iterations = 0;
+        Timing encode;     // CPU time to encode and submit the frame
+        Timing frame;      // Until the GPU finished the frame
+        uint32_t skippedDraws = 0;  // Per iteration, draws without a usable pipeline
+    };
+
+    explicit FrameReplayer(const std::shared_ptr<ILogicalDevice>& device);
+    ~FrameReplayer();
+
+    FrameReplayer(const FrameReplayer&) = delete;
+    FrameReplayer& operator=(const FrameReplayer&) = delete;
+
+    /**
+     * @brief Create the capture's resources and decode its commands
+     * Resources that fail to create are logged; commands using them are dropped.
+     * @return false if the command stream is malformed
+     */
+    bool prepare(const FrameCapture& capture);
+
+    /**
+     * @brief Replay the prepared frame, waiting for the GPU after each iteration
+     * @return false if nothing is prepared or iterations is 0
+     */
+    bool replay(uint32_t iterations, Stats& stats);
+
+private:
+    struct Op {
+        CaptureCommand command;
+        uint32_t target = 0;  // Encoder id, or pass id for pass commands
+        uint32_t ids[4] = {CAPTURE_NONE, CAPTURE_NONE, CAPTURE_NONE, CAPTURE_NONE};
+        uint64_t values[3] = {0, 0, 0};
+        uint32_t extra = 0;   // Index into _payloads, _passes or _idLists
+    };
+
+    bool createResources(const FrameCapture& capture);
+    bool decode(const FrameCapture& capture);
+    void resetBuffers();
+    uint32_t replayOnce();
+
+    std::weak_ptr<ILogicalDevice> _device;
+
+    std::vector<std::shared_ptr<IBuffer>> _buffers;
+    std::vector<std::vector<std::byte>> _initialContents;  // Indexed like _buffers
+    std::vector<std::shared_ptr<ITexture>> _textures;
+    std::vector<std::shared_ptr<ITextureView>> _views;
+    std::vector<std::shared_ptr<ISampler>> _samplers;
+    std::vector<std::shared_ptr<IShaderModule>> _shaders;
+    std::vector<std::shared_ptr<IBindGroupLayout>> _bindGroupLayouts;
+    std::vector<std::shared_ptr<IPipelineLayout>> _pipelineLayouts;
+    std::vector<std::shared_ptr<IRenderPipeline>> _pipelines;
+    std::vector<std::shared_ptr<IBindGroup>> _bindGroups;
+
+    std::vector<Op> _ops;
+    std::vector<std::vector<std::byte>> _payloads;
+    std::vector<RenderPassDesc> _passes;  // Views resolved at prepare time
+    std::vector<std::vector<uint32_t>> _idLists;
+    uint32_t _encoderCount = 0;
+    uint32_t _passCount = 0;
+    bool _prepared = false;
+};
+
+} // namespace pers
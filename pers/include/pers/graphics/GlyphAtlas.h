@@ -0,0 +1,135 @@
+#pragma once
+
+#include "pers/graphics/TextureAtlas.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class ICommandEncoder;
+
+/**
+ * @brief Coverage bitmap of one glyph as produced by a font rasterizer
+ */
+struct GlyphBitmap {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    float bearingX = 0.0f;  // Pen to the bitmap's left edge
+    float bearingY = 0.0f;  // Baseline up to the bitmap's top edge
+    float advance = 0.0f;
+    std::vector<uint8_t> coverage;  // width * height, rows top-down
+};
+
+struct FontMetrics {
+    float ascent = 0.0f;      // Baseline to the top of the tallest glyph
+    float descent = 0.0f;     // Baseline to the bottom, positive downwards
+    float lineHeight = 0.0f;  // Baseline to baseline
+};
+
+/**
+ * @brief Source of glyph shapes, typically wrapping FreeType or stb_truetype
+ *
+ * pers ships no font parser; the application supplies the rasterizer and
+ * GlyphAtlas turns its coverage into distance fields. Called on the thread
+ * that uses the atlas.
+ */
+class IGlyphRasterizer {
+public:
+    virtual ~IGlyphRasterizer() = default;
+
+    /**
+     * @return false if the font has no glyph for codepoint
+     */
+    virtual bool rasterize(uint32_t codepoint, float pixelSize, GlyphBitmap& bitmap) = 0;
+    virtual FontMetrics getMetrics(float pixelSize) const = 0;
+    virtual float getKerning(uint32_t left, uint32_t right, float pixelSize) const {
+        (void)left; (void)right; (void)pixelSize;
+        return 0.0f;
+    }
+};
+
+/**
+ * @brief Atlas placement and layout of one cached glyph, in atlas pixels
+ */
+struct GlyphInfo {
+    AtlasRegion region;       // Empty for glyphs without ink, such as space
+    float offsetX = 0.0f;     // Pen to the quad's left edge, spread included
+    float offsetY = 0.0f;     // Baseline up to the quad's top edge
+    float advance = 0.0f;
+    bool hasInk = false;
+};
+
+/**
+ * @brief Signed distance field glyph cache on a TextureAtlas
+ *
+ * Glyphs are rasterized once at Config::pixelSize, converted to a
+ * single-channel distance field and packed into an R8Unorm atlas. 0.5 is
+ * the outline and each 1/255 step is (2 * spread / 255) pixels, so text
+ * scales to any size from one cache entry and an alpha test keeps the
+ * edges sharp. Distances come from an exact Euclidean distance transform
+ * of the thresholded coverage; multi-channel fields would need access to
+ * the font's outlines, which the rasterizer interface does not expose.
+ *
+ *     auto* glyph = atlas.getGlyph('A');   // Rasterized and queued on first use
+ *     atlas.flush(*encoder);               // Before the pass sampling the atlas
+ *
+ * Codepoints the font lacks resolve to Config::fallback.
+ */
+class GlyphAtlas {
+public:
+    struct Config {
+        float pixelSize = 48.0f;    // Size glyphs are rasterized at
+        uint32_t spread = 6;        // Distance range in pixels on each side of the outline
+        uint32_t fallback = '?';
+        TextureAtlas::Config atlas = {1024, 1, 4, 1, TextureFormat::R8Unorm, "GlyphAtlas"};
+    };
+
+    GlyphAtlas(const std::shared_ptr<ILogicalDevice>& device, const std::shared_ptr<IGlyphRasterizer>& rasterizer,
+               const Config& config);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    bool isValid() const { return _rasterizer && _atlas.isValid(); }
+
+    /**
+     * @return Cached glyph, or nullptr if it does not fit in the atlas
+     * Codepoints without a glyph or fallback get an empty entry with no advance.
+     */
+    const GlyphInfo* getGlyph(uint32_t codepoint);
+
+    /**
+     * @brief Kerning between two glyphs at the cache size
+     */
+    float getKerning(uint32_t left, uint32_t right) const;
+
+    /**
+     * @brief Upload glyphs added since the last flush
+     */
+    bool flush(ICommandEncoder& encoder) { return _atlas.flush(encoder); }
+
+    /**
+     * @brief Convert coverage into a distance field of (width + 2 * spread) x (height + 2 * spread)
+     */
+    static std::vector<uint8_t> generateDistanceField(const uint8_t* coverage, uint32_t width, uint32_t height,
+                                                      uint32_t spread);
+
+    const FontMetrics& getMetrics() const { return _metrics; }
+    const Config& getConfig() const { return _config; }
+    const TextureAtlas& getAtlas() const { return _atlas; }
+    size_t getGlyphCount() const { return _glyphs.size(); }
+
+private:
+    const GlyphInfo* loadGlyph(uint32_t codepoint);
+
+    std::shared_ptr<IGlyphRasterizer> _rasterizer;
+    Config _config;
+    FontMetrics _metrics;
+    TextureAtlas _atlas;
+    std::unordered_map<uint32_t, GlyphInfo> _glyphs;  // Codepoints the font lacks hold a copy of the fallback
+};
+
+} // namespace pers
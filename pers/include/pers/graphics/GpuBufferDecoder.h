@@ -0,0 +1,75 @@
+#pragma once
+
+#include "pers/graphics/buffers/BufferCodec.h"
+#include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include <memory>
+#include <string>
+
+namespace pers {
+
+class IResourceFactory;
+class ILogicalDevice;
+class ICommandEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBuffer;
+class DeviceBuffer;
+
+/**
+ * @brief Expands BufferCodec payloads on the GPU
+ *
+ * Compressed blobs are uploaded as-is and a compute pass writes the decoded
+ * words into the destination buffer, so streaming skips the CPU decode and
+ * moves only the compressed bytes across the bus. Each invocation decodes one
+ * (block, channel) stream of the payload; see BufferCodec.h for the format.
+ *
+ * Bindings (group 0):
+ *   0 read-only storage, payload words (usage Storage)
+ *   1 storage, decoded output (usage Storage, at least decodedSize bytes)
+ *
+ *     auto vertices = decoder.decodeToDeviceBuffer(device, blob.data(), blob.size(),
+ *                                                  DeviceBufferUsage::Vertex, "Mesh");
+ */
+class GpuBufferDecoder {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+    static constexpr uint32_t MAX_WORKGROUPS_PER_DIMENSION = 65535;
+
+    explicit GpuBufferDecoder(const std::shared_ptr<IResourceFactory>& factory);
+    ~GpuBufferDecoder() = default;
+
+    GpuBufferDecoder(const GpuBufferDecoder&) = delete;
+    GpuBufferDecoder& operator=(const GpuBufferDecoder&) = delete;
+
+    bool isValid() const { return _pipeline != nullptr; }
+
+    /**
+     * @brief Record a decode pass into an encoder
+     * @param info Header of the payload, from readBufferPayloadInfo
+     * @return false if the decoder is invalid or a resource failed to create
+     */
+    bool record(ICommandEncoder& encoder,
+                const std::shared_ptr<IBuffer>& payload,
+                const std::shared_ptr<IBuffer>& output,
+                const BufferPayloadInfo& info) const;
+
+    /**
+     * @brief Upload a payload, decode it into a new device buffer and submit
+     *
+     * The temporary payload buffer is retired on the device's deletion queue
+     * against the decode submission. Storage usage is added to the output.
+     * @return Decoded buffer, or nullptr if the payload is malformed or submission failed
+     */
+    std::shared_ptr<DeviceBuffer> decodeToDeviceBuffer(const std::shared_ptr<ILogicalDevice>& device,
+                                                       const void* payload,
+                                                       size_t payloadSize,
+                                                       DeviceBufferUsage usage,
+                                                       const std::string& debugName = "") const;
+
+private:
+    std::weak_ptr<IResourceFactory> _factory;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IComputePipeline> _pipeline;
+};
+
+} // namespace pers
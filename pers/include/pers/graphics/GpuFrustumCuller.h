@@ -0,0 +1,83 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class IResourceFactory;
+class IComputePassEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBindGroup;
+class IBuffer;
+
+/**
+ * @brief Uniform block read by the culling shader
+ *
+ * Planes are (normal.xyz, distance) with normals pointing into the frustum;
+ * a sphere is kept when dot(normal, center) + distance >= -radius for all six.
+ */
+struct FrustumCullUniforms {
+    std::array<std::array<float, 4>, 6> planes{};
+    uint32_t objectCount = 0;
+    uint32_t padding[3] = {};
+};
+static_assert(sizeof(FrustumCullUniforms) == 112, "FrustumCullUniforms must match the WGSL layout");
+
+/**
+ * @brief Compute stage that writes per-object indexed indirect draw args
+ *
+ * Object i's bounding sphere (center.xyz, radius) is tested against the
+ * frustum and its DrawIndexedIndirectArgs template is copied to the output
+ * with instanceCount forced to 0 when culled. Draw the output with
+ * multiDrawIndexedIndirect(drawArgs, 0, objectCount); the CPU never touches
+ * per-object visibility.
+ *
+ * Bindings (group 0):
+ *   0 uniform FrustumCullUniforms
+ *   1 read-only storage, vec4 sphere per object
+ *   2 read-only storage, DrawIndexedIndirectArgs template per object
+ *   3 storage, DrawIndexedIndirectArgs output (usage Storage | Indirect)
+ *
+ * Occlusion culling against a depth pyramid is GpuOcclusionCuller.
+ */
+class GpuFrustumCuller {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    struct Buffers {
+        std::shared_ptr<IBuffer> uniforms;
+        std::shared_ptr<IBuffer> bounds;
+        std::shared_ptr<IBuffer> drawTemplates;
+        std::shared_ptr<IBuffer> drawArgs;
+    };
+
+    explicit GpuFrustumCuller(const std::shared_ptr<IResourceFactory>& factory);
+    ~GpuFrustumCuller() = default;
+
+    GpuFrustumCuller(const GpuFrustumCuller&) = delete;
+    GpuFrustumCuller& operator=(const GpuFrustumCuller&) = delete;
+
+    bool isValid() const { return _pipeline != nullptr; }
+
+    /**
+     * @brief Create the bind group for a buffer set, cached by the factory
+     * @return Bind group or nullptr if a buffer is missing
+     */
+    std::shared_ptr<IBindGroup> createBindGroup(const Buffers& buffers) const;
+
+    /**
+     * @brief Record the culling dispatch into an open compute pass
+     * @param objectCount Must match FrustumCullUniforms::objectCount
+     */
+    void encode(IComputePassEncoder& pass, const std::shared_ptr<IBindGroup>& bindGroup, uint32_t objectCount) const;
+
+private:
+    std::weak_ptr<IResourceFactory> _factory;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IComputePipeline> _pipeline;
+};
+
+} // namespace pers
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/utils/Mutex.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+struct TextureDesc;
+
+enum class GpuMemoryCategory : uint32_t {
+    Vertex,
+    Index,
+    Uniform,
+    Storage,        // Storage and indirect buffers
+    Staging,        // Mappable buffers
+    Texture,
+    RenderTarget,   // Textures with RenderAttachment usage
+    Other,
+    Count
+};
+
+/**
+ * @brief Tracked allocation, released from the tracker when destroyed
+ */
+class GpuMemoryAllocation {
+public:
+    GpuMemoryAllocation() = default;
+    ~GpuMemoryAllocation() { reset(); }
+
+    GpuMemoryAllocation(GpuMemoryAllocation&& other) noexcept
+        : _category(other._category), _size(other._size) {
+        other._size = 0;
+    }
+    GpuMemoryAllocation& operator=(GpuMemoryAllocation&& other) noexcept {
+        if (this != &other) {
+            reset();
+            _category = other._category;
+            _size = other._size;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    GpuMemoryAllocation(const GpuMemoryAllocation&) = delete;
+    GpuMemoryAllocation& operator=(const GpuMemoryAllocation&) = delete;
+
+    void reset();
+
+    GpuMemoryCategory getCategory() const { return _category; }
+    uint64_t getSize() const { return _size; }
+
+private:
+    friend class GpuMemoryTracker;
+    GpuMemoryAllocation(GpuMemoryCategory category, uint64_t size) : _category(category), _size(size) {}
+
+    GpuMemoryCategory _category = GpuMemoryCategory::Other;
+    uint64_t _size = 0;
+};
+
+/**
+ * @brief Process-wide accounting of GPU buffer and texture memory
+ *
+ * WebGPUBuffer and the resource factory's textures register every native
+ * allocation here by category. With a budget set, an allocation that would
+ * exceed it first runs the registered eviction callbacks, lowest priority
+ * first, until enough has been freed. The allocation itself always
+ * proceeds; WebGPU reports real out-of-memory through its own errors.
+ *
+ * Eviction callbacks run on the allocating thread without tracker locks
+ * held, and never recursively: allocations made by a callback skip eviction.
+ */
+class GpuMemoryTracker {
+public:
+    /**
+     * @brief Free cached memory
+     * @param bytesNeeded Bytes the allocation is over budget by
+     * @return Bytes released, an estimate is fine
+     */
+    using EvictionCallback = std::function<uint64_t(uint64_t bytesNeeded)>;
+    using EvictionCallbackId = uint64_t;
+
+    struct Stats {
+        std::array<uint64_t, static_cast<size_t>(GpuMemoryCategory::Count)> bytes{};
+        std::array<uint64_t, static_cast<size_t>(GpuMemoryCategory::Count)> allocations{};
+        uint64_t totalBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t budget = 0;
+        uint64_t evictionRuns = 0;
+        uint64_t evictedBytes = 0;     // As reported by callbacks
+        uint64_t overBudgetAllocations = 0;
+    };
+
+    static GpuMemoryTracker& instance();
+
+    // 0 disables the budget
+    void setBudget(uint64_t bytes) { _budget.store(bytes, std::memory_order_relaxed); }
+    uint64_t getBudget() const { return _budget.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Register a cache or streamer that can give memory back
+     * @param priority Lower values are asked first
+     * @return Id for removeEvictionCallback
+     */
+    EvictionCallbackId addEvictionCallback(const std::string& name, EvictionCallback callback, int priority = 0);
+
+    // Blocks while the callback is running on another thread
+    void removeEvictionCallback(EvictionCallbackId id);
+
+    /**
+     * @brief Account an allocation, evicting first if it would exceed the budget
+     * @param debugName Named in the warning when the budget cannot be met
+     */
+    GpuMemoryAllocation allocate(GpuMemoryCategory category, uint64_t size, const std::string& debugName = "");
+
+    /**
+     * @brief Run eviction callbacks until bytes are freed or none are left
+     * @return Bytes the callbacks reported freeing
+     */
+    uint64_t evict(uint64_t bytes);
+
+    uint64_t getUsage() const { return _totalBytes.load(std::memory_order_relaxed); }
+    uint64_t getUsage(GpuMemoryCategory category) const;
+    // Bytes above the budget, 0 when within it or without a budget
+    uint64_t getOverBudgetBytes() const;
+
+    Stats getStats() const;
+    std::string formatReport() const;
+
+    static const char* getCategoryName(GpuMemoryCategory category);
+    static GpuMemoryCategory categorize(BufferUsage usage);
+    static GpuMemoryCategory categorize(TextureUsage usage);
+
+    // Bytes of every mip, layer and sample of a texture
+    static uint64_t estimateTextureSize(const TextureDesc& desc);
+
+private:
+    friend class GpuMemoryAllocation;
+
+    struct CallbackEntry {
+        EvictionCallbackId id = 0;
+        std::string name;
+        int priority = 0;
+        EvictionCallback callback;
+        Mutex<false> running{"GpuMemoryTracker::Callback"};  // Held while the callback runs
+    };
+
+    GpuMemoryTracker() = default;
+
+    void release(GpuMemoryCategory category, uint64_t size);
+
+    std::atomic<uint64_t> _budget{0};
+    std::atomic<uint64_t> _totalBytes{0};
+    std::atomic<uint64_t> _peakBytes{0};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(GpuMemoryCategory::Count)> _bytes{};
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(GpuMemoryCategory::Count)> _allocations{};
+    std::atomic<uint64_t> _evictionRuns{0};
+    std::atomic<uint64_t> _evictedBytes{0};
+    std::atomic<uint64_t> _overBudgetAllocations{0};
+
+    // Callbacks run outside it
+    mutable Mutex<false> _callbackMutex{"GpuMemoryTracker"};
+    std::vector<std::shared_ptr<CallbackEntry>> _callbacks;  // Sorted by priority
+    EvictionCallbackId _nextCallbackId = 1;
+};
+
+} // namespace pers
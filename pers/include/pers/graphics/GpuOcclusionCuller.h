@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class IResourceFactory;
+class IComputePassEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBindGroup;
+class IBuffer;
+class HiZPyramid;
+
+/**
+ * @brief Uniform block read by the occlusion culling shader
+ *
+ * planes are the current frustum, as in FrustumCullUniforms. viewProjection
+ * is the column-major matrix the pyramid's depth was rendered with, usually
+ * last frame's; pyramidScale converts screen UV to level 0 texels. A
+ * mipCount of 0 disables the occlusion test, e.g. before the first pyramid.
+ */
+struct OcclusionCullUniforms {
+    std::array<std::array<float, 4>, 6> planes{};
+    std::array<float, 16> viewProjection{};
+    std::array<float, 2> pyramidScale{};
+    uint32_t mipCount = 0;
+    uint32_t objectCount = 0;
+};
+static_assert(sizeof(OcclusionCullUniforms) == 176, "OcclusionCullUniforms must match the WGSL layout");
+
+/**
+ * @brief GPU frustum and Hi-Z occlusion culling into indexed indirect draw args
+ *
+ * Like GpuFrustumCuller, object i's sphere is tested against the frustum
+ * and its DrawIndexedIndirectArgs template copied with instanceCount 0 when
+ * culled. Survivors are then tested against a HiZPyramid: the sphere's box
+ * is projected, the pyramid level where it spans at most 2x2 texels is read
+ * and the object is culled when its nearest depth lies behind the farthest
+ * occluder depth there. Boxes crossing the near plane are always kept.
+ *
+ * Testing this frame's candidates against last frame's pyramid is
+ * conservative for static occluders; an object uncovered by a moving one
+ * can appear a frame late.
+ *
+ *     GpuOcclusionCuller::setPyramid(uniforms, pyramid, previousViewProjection);
+ *     culler.encode(*pass, culler.createBindGroup(buffers, pyramid), objectCount);
+ *     ...
+ *     pyramid.build(*encoder, depthView);  // For the next frame
+ *
+ * Bindings (group 0):
+ *   0 uniform OcclusionCullUniforms
+ *   1 read-only storage, vec4 sphere per object
+ *   2 read-only storage, DrawIndexedIndirectArgs template per object
+ *   3 storage, DrawIndexedIndirectArgs output (usage Storage | Indirect)
+ *   4 texture_2d<f32>, HiZPyramid::getView()
+ */
+class GpuOcclusionCuller {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    struct Buffers {
+        std::shared_ptr<IBuffer> uniforms;
+        std::shared_ptr<IBuffer> bounds;
+        std::shared_ptr<IBuffer> drawTemplates;
+        std::shared_ptr<IBuffer> drawArgs;
+    };
+
+    explicit GpuOcclusionCuller(const std::shared_ptr<IResourceFactory>& factory);
+    ~GpuOcclusionCuller() = default;
+
+    GpuOcclusionCuller(const GpuOcclusionCuller&) = delete;
+    GpuOcclusionCuller& operator=(const GpuOcclusionCuller&) = delete;
+
+    bool isValid() const { return _pipeline != nullptr; }
+
+    /**
+     * @brief Fill the pyramid fields of the uniforms
+     * @param viewProjection Column-major matrix the pyramid's depth was rendered with
+     */
+    static void setPyramid(OcclusionCullUniforms& uniforms, const HiZPyramid& pyramid, const float viewProjection[16]);
+
+    /**
+     * @brief Create the bind group for a buffer set and pyramid, cached by the factory
+     * Recreate it after the pyramid was resized.
+     * @return Bind group or nullptr if a buffer or the pyramid is missing
+     */
+    std::shared_ptr<IBindGroup> createBindGroup(const Buffers& buffers, const HiZPyramid& pyramid) const;
+
+    /**
+     * @brief Record the culling dispatch into an open compute pass
+     * @param objectCount Must match OcclusionCullUniforms::objectCount
+     */
+    void encode(IComputePassEncoder& pass, const std::shared_ptr<IBindGroup>& bindGroup, uint32_t objectCount) const;
+
+private:
+    std::weak_ptr<IResourceFactory> _factory;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IComputePipeline> _pipeline;
+};
+
+} // namespace pers
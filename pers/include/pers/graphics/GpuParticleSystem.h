@@ -0,0 +1,170 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IComputePassEncoder;
+class IRenderPassEncoder;
+class IComputePipeline;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IBindGroup;
+class IPipelineLayout;
+class IBuffer;
+class DeviceBuffer;
+
+/**
+ * @brief Spawn and integration parameters shared by every particle of a system
+ */
+struct ParticleEmitter {
+    std::array<float, 3> position{0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;                              // Spawn sphere radius
+    std::array<float, 3> velocity{0.0f, 1.0f, 0.0f};
+    float velocitySpread = 0.5f;                      // Random offset per axis
+    std::array<float, 3> gravity{0.0f, -9.81f, 0.0f};
+    float drag = 0.0f;                                // Velocity lost per second, as a fraction
+    float lifetimeMin = 1.0f;
+    float lifetimeMax = 2.0f;
+    float sizeStart = 0.1f;                           // World units, interpolated over the lifetime
+    float sizeEnd = 0.0f;
+    uint32_t colorStart = 0xFFFFFFFF;                 // Unorm8x4 in memory order, see DebugDraw::rgba
+    uint32_t colorEnd = 0x00FFFFFF;
+};
+
+/**
+ * @brief Particles emitted, simulated and drawn entirely on the GPU
+ *
+ * Particle state lives in storage buffers sized for the capacity at
+ * construction. update() records five dispatches into an open compute
+ * pass, and the CPU only uploads the emitter uniforms:
+ *
+ *   begin     clamps the requested spawn count to the free list
+ *   emit      pops free slots and appends them to this frame's alive list
+ *   prepare   writes the simulate dispatch size from the alive counter
+ *   simulate  integrates each alive particle and appends it to the next
+ *             alive list, or returns it to the free list when it expires
+ *   finalize  writes the DrawIndirectArgs from the surviving count
+ *
+ * Appends go through atomic counters, so the alive list is compacted as a
+ * side effect of simulation and the next frame only visits survivors.
+ * simulate runs through dispatchIndirect and render() through drawIndirect,
+ * so nothing is read back and no CPU work scales with the particle count:
+ *
+ *     auto pass = encoder->beginComputePass(ComputePassDesc{"Particles"});
+ *     particles.update(*pass, deltaTime, spawnCount);
+ *     pass->end();
+ *     ...
+ *     particles.render(*renderPass, target, viewProjection, cameraRight, cameraUp);
+ *
+ * Uniforms reach the GPU through IQueue::writeBuffer, so call update() and
+ * render() once per submission. Particles are camera-facing round sprites;
+ * there is no blend state, so single-sampled targets alpha-test and
+ * multisampled targets fade through alpha-to-coverage. For custom drawing,
+ * the surviving indices are at getAliveListOffset() in getAliveList() and
+ * the draw arguments in getDrawArgs().
+ */
+class GpuParticleSystem {
+public:
+    using Vec3 = std::array<float, 3>;
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+    static constexpr uint32_t MAX_CAPACITY = 65535 * WORKGROUP_SIZE;  // One dispatch dimension
+
+    struct Config {
+        uint32_t capacity = 1 << 20;
+    };
+
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::BGRA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Undefined;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    GpuParticleSystem(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~GpuParticleSystem();
+
+    GpuParticleSystem(const GpuParticleSystem&) = delete;
+    GpuParticleSystem& operator=(const GpuParticleSystem&) = delete;
+
+    bool isValid() const { return _renderBindGroup != nullptr; }
+
+    void setEmitter(const ParticleEmitter& emitter) { _emitter = emitter; }
+    const ParticleEmitter& getEmitter() const { return _emitter; }
+
+    /**
+     * @brief Record spawning and simulation into an open compute pass
+     * @param emitCount Particles to spawn, fewer if the system is full
+     */
+    bool update(IComputePassEncoder& pass, float deltaTime, uint32_t emitCount);
+
+    /**
+     * @brief Draw the particles that survived the last update()
+     */
+    bool render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                const Vec3& cameraRight, const Vec3& cameraUp);
+
+    /**
+     * @brief Kill every particle; takes effect at the next submission
+     */
+    bool reset();
+
+    uint32_t getCapacity() const { return _capacity; }
+    std::shared_ptr<IBuffer> getParticles() const;
+    std::shared_ptr<IBuffer> getAliveList() const;
+    std::shared_ptr<IBuffer> getDrawArgs() const;
+
+    /**
+     * @brief Element offset of the indices drawn by the last update()
+     */
+    uint32_t getAliveListOffset() const { return _parity * _capacity; }
+
+private:
+    struct PipelineEntry {
+        Target target;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    std::shared_ptr<IRenderPipeline> getPipeline(const Target& target);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    uint32_t _capacity = 0;
+    ParticleEmitter _emitter;
+
+    std::shared_ptr<DeviceBuffer> _emitterBuffer;
+    std::shared_ptr<DeviceBuffer> _viewBuffer;
+    std::shared_ptr<DeviceBuffer> _particles;
+    std::shared_ptr<DeviceBuffer> _aliveList;  // Two lists of capacity indices, alternating each update
+    std::shared_ptr<DeviceBuffer> _deadList;
+    std::shared_ptr<DeviceBuffer> _counters;
+    std::shared_ptr<DeviceBuffer> _dispatchArgs;
+    std::shared_ptr<DeviceBuffer> _drawArgs;
+
+    std::shared_ptr<IComputePipeline> _beginPipeline;
+    std::shared_ptr<IComputePipeline> _emitPipeline;
+    std::shared_ptr<IComputePipeline> _preparePipeline;
+    std::shared_ptr<IComputePipeline> _simulatePipeline;
+    std::shared_ptr<IComputePipeline> _finalizePipeline;
+    std::shared_ptr<IBindGroup> _simulateBindGroup;
+    std::shared_ptr<IBindGroup> _argsBindGroup;
+
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IPipelineLayout> _renderLayout;
+    std::shared_ptr<IBindGroup> _renderBindGroup;
+    std::vector<PipelineEntry> _pipelines;
+
+    uint32_t _parity = 0;  // Alive list simulated by the next update()
+    uint32_t _frame = 0;
+};
+
+} // namespace pers
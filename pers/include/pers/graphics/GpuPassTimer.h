@@ -0,0 +1,111 @@
+#pragma once
+
+#include "pers/graphics/IQuerySet.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class DeviceBuffer;
+class ReadbackRing;
+
+/**
+ * @brief GPU time of one pass
+ */
+struct GpuPassTiming {
+    std::string name;
+    double milliseconds = 0.0;
+};
+
+/**
+ * @brief GPU times of every timed pass in one frame
+ */
+struct GpuFrameTiming {
+    std::vector<GpuPassTiming> passes;
+    double totalMilliseconds = 0.0;  // Sum of pass times
+    uint64_t frameIndex = 0;         // Counted by beginFrame, 0 before the first result
+};
+
+/**
+ * @brief Per-pass GPU timing through pass timestamp writes
+ *
+ * Each frame:
+ *     timer.beginFrame();
+ *     passDesc.timestampWrites = timer.timestampWrites("Shadow");
+ *     ...
+ *     timer.resolve(encoder);     // after the last timed pass, before finish()
+ *     queue->submit(...);
+ *     timer.submitted();
+ *     timer.collect();            // never blocks
+ *     timer.getLastReport();
+ *
+ * Results go through a ReadbackRing and arrive a few frames late. Needs
+ * DeviceFeature::TimestampQuery in the device's requiredFeatures; without
+ * it the timer stays inactive and timestampWrites() returns empty writes.
+ */
+class GpuPassTimer {
+public:
+    static constexpr uint32_t DEFAULT_MAX_PASSES = 32;
+
+    explicit GpuPassTimer(const std::shared_ptr<ILogicalDevice>& device,
+                          uint32_t maxPasses = DEFAULT_MAX_PASSES);
+    ~GpuPassTimer();
+
+    GpuPassTimer(const GpuPassTimer&) = delete;
+    GpuPassTimer& operator=(const GpuPassTimer&) = delete;
+
+    bool isActive() const { return _readback != nullptr; }
+
+    // Start a new frame, dropping passes named since the last resolve
+    void beginFrame();
+
+    /**
+     * @brief Reserve timestamps for one pass of this frame
+     * @return Writes for RenderPassDesc/ComputePassDesc, empty when inactive or full
+     */
+    PassTimestampWrites timestampWrites(const std::string& name);
+
+    /**
+     * @brief Record the resolve and readback of this frame's timestamps
+     * @return false if nothing was recorded
+     */
+    bool resolve(const std::shared_ptr<ICommandEncoder>& encoder);
+
+    // Must be called after the command buffer passed to resolve() is submitted
+    void submitted();
+
+    /**
+     * @brief Consume finished readbacks
+     * @return Number of frames whose results arrived
+     */
+    size_t collect();
+
+    const GpuFrameTiming& getLastReport() const { return _lastReport; }
+
+    // Last report as a table, one row per pass
+    std::string formatReport() const;
+
+private:
+    struct PendingFrame {
+        uint64_t ticket = 0;
+        uint64_t frameIndex = 0;
+        std::vector<std::string> names;
+    };
+
+    uint32_t _maxPasses;
+    std::shared_ptr<IQuerySet> _querySet;
+    std::shared_ptr<DeviceBuffer> _resolveBuffer;
+    std::unique_ptr<ReadbackRing> _readback;
+
+    uint64_t _frameIndex = 0;
+    std::vector<std::string> _frameNames;
+    std::deque<PendingFrame> _pending;
+    GpuFrameTiming _lastReport;
+};
+
+} // namespace pers
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IComputePassEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBuffer;
+class DeviceBuffer;
+class DynamicBuffer;
+
+enum class GpuReduceOp : uint32_t {
+    Sum,
+    Min,
+    Max,
+};
+
+/**
+ * @brief Interpretation of the 32-bit elements of a reduction
+ */
+enum class GpuScalarType : uint32_t {
+    U32,
+    I32,
+    F32,
+};
+
+/**
+ * @brief Data-parallel building blocks over storage buffers of 32-bit elements
+ *
+ * Every operation records compute dispatches into an open compute pass and
+ * reads its element count from the CPU; nothing is read back. Scans run one
+ * element per invocation: each workgroup scans its block in workgroup
+ * memory and writes the block total, the totals are scanned the same way
+ * until one block remains, and the prefixes are added back level by level.
+ * Segmented scans carry head flags through the same levels, so a segment
+ * may span any number of blocks. Stream compaction is a scan of the
+ * predicates and a scatter; radix sort is stable and least-significant
+ * digit first, RADIX_BITS per pass, each pass a per-block histogram, a scan
+ * of the digit-major histogram and a scatter ranked in workgroup memory.
+ *
+ * The workgroup size is the largest power of two within Config and the
+ * device's invocation, size and workgroup storage limits, and maxElements
+ * is clamped so every level fits maxComputeWorkgroupsPerDimension and
+ * maxStorageBufferBindingSize. Scratch buffers are sized once for it.
+ *
+ *     primitives.exclusiveScan(*pass, counts, offsets, n);
+ *     primitives.sortPairs(*pass, keys, indices, n);
+ *     pass->end();
+ *     primitives.flush();                // before queue submit
+ *     queue->submit(encoder->finish());
+ *     primitives.nextFrame();            // after queue submit
+ *
+ * Each dispatch takes a parameter slot from a DynamicBuffer, so recording
+ * stops with an error once Config::parameterBufferSize is used up in a
+ * frame. Buffers need Storage usage, at least count elements, and must be
+ * distinct within one call; scratch is shared, so operations are ordered
+ * by the pass rather than run concurrently.
+ */
+class GpuPrimitives {
+public:
+    static constexpr uint32_t RADIX_BITS = 4;
+    static constexpr uint32_t RADIX = 1u << RADIX_BITS;
+
+    struct Config {
+        uint32_t maxElements = 1u << 20;
+        uint32_t maxWorkgroupSize = 256;        // Upper bound, lowered to the device limits
+        uint64_t parameterBufferSize = 1 << 16;  // Per frame, 256 bytes per dispatch
+        uint32_t frameCount = 3;
+    };
+
+    GpuPrimitives(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~GpuPrimitives();
+
+    GpuPrimitives(const GpuPrimitives&) = delete;
+    GpuPrimitives& operator=(const GpuPrimitives&) = delete;
+
+    bool isValid() const { return _valid; }
+
+    uint32_t getWorkgroupSize() const { return _workgroupSize; }
+
+    /**
+     * @brief Largest count accepted, Config::maxElements after clamping to the limits
+     */
+    uint32_t getMaxElements() const { return _maxElements; }
+
+    /**
+     * @brief output[i] = input[0] + ... + input[i - 1], output[0] = 0
+     */
+    bool exclusiveScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                       const std::shared_ptr<IBuffer>& output, uint32_t count);
+
+    /**
+     * @brief output[i] = input[0] + ... + input[i]
+     */
+    bool inclusiveScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                       const std::shared_ptr<IBuffer>& output, uint32_t count);
+
+    /**
+     * @brief Scan restarting wherever heads[i] != 0; an exclusive scan is 0 at each head
+     */
+    bool segmentedScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                       const std::shared_ptr<IBuffer>& heads, const std::shared_ptr<IBuffer>& output,
+                       uint32_t count, bool inclusive = false);
+
+    /**
+     * @brief Copy input[i] where predicates[i] != 0 to the front of output, in order
+     * @param selectedCount Receives the number of elements kept at element 0
+     */
+    bool compact(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                 const std::shared_ptr<IBuffer>& predicates, const std::shared_ptr<IBuffer>& output,
+                 const std::shared_ptr<IBuffer>& selectedCount, uint32_t count);
+
+    /**
+     * @brief Sort unsigned keys ascending in place, permuting values with them
+     * @param values May be null to sort keys only
+     * @param keyBits Low key bits that may be non-zero; passes are rounded up to an even count
+     */
+    bool sortPairs(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& keys,
+                   const std::shared_ptr<IBuffer>& values, uint32_t count, uint32_t keyBits = 32);
+
+    /**
+     * @brief Combine all elements into output[0]; an empty input yields the identity
+     */
+    bool reduce(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                const std::shared_ptr<IBuffer>& output, uint32_t count, GpuReduceOp op,
+                GpuScalarType type = GpuScalarType::U32);
+
+    /**
+     * @brief Upload the recorded dispatch parameters; call before queue submit
+     */
+    bool flush();
+
+    /**
+     * @brief Advance the parameter ring; call after queue submit
+     */
+    void nextFrame();
+
+private:
+    enum Kernel : uint32_t {
+        ScanBlocks,
+        AddCarry,
+        CompactScatter,
+        RadixHistogram,
+        RadixScatter,
+        ReduceBlocks,
+        KernelCount,
+    };
+
+    struct Params {
+        uint32_t count;
+        uint32_t mode;
+        uint32_t shift;
+        uint32_t flags;
+    };
+
+    struct Level {
+        std::shared_ptr<DeviceBuffer> sums;
+        std::shared_ptr<DeviceBuffer> heads;
+        std::shared_ptr<DeviceBuffer> carries;
+    };
+
+    bool scan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input, const std::shared_ptr<IBuffer>& heads,
+              const std::shared_ptr<IBuffer>& output, uint32_t count, uint32_t mode, uint32_t flags);
+    bool dispatch(IComputePassEncoder& pass, Kernel kernel, const Params& params,
+                  const std::vector<std::shared_ptr<IBuffer>>& buffers, uint32_t workgroups);
+    bool checkCount(uint32_t count, uint32_t capacity) const;
+    uint32_t blocks(uint32_t count) const { return (count + _workgroupSize - 1) / _workgroupSize; }
+
+    std::weak_ptr<ILogicalDevice> _device;
+    uint32_t _workgroupSize = 0;
+    uint32_t _maxElements = 0;
+    uint32_t _scanCapacity = 0;   // Largest scan, maxElements or a full radix histogram
+    bool _valid = false;
+
+    std::unique_ptr<DynamicBuffer> _parameters;
+    std::shared_ptr<IBindGroupLayout> _parameterLayout;
+    std::array<std::shared_ptr<IBindGroupLayout>, KernelCount> _layouts;
+    std::array<std::shared_ptr<IComputePipeline>, KernelCount> _pipelines;
+
+    std::vector<Level> _levels;   // Block totals of scan level i + 1 and partials of reductions
+    std::shared_ptr<DeviceBuffer> _indices;
+    std::shared_ptr<DeviceBuffer> _histogram;
+    std::shared_ptr<DeviceBuffer> _offsets;
+    std::shared_ptr<DeviceBuffer> _sortKeys;
+    std::shared_ptr<DeviceBuffer> _sortValues;
+    std::shared_ptr<DeviceBuffer> _dummyRead;    // Stands in for unused bindings
+    std::shared_ptr<DeviceBuffer> _dummyWrite;
+};
+
+} // namespace pers
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace pers {
+
+class ILogicalDevice;
+class IComputePassEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBuffer;
+class DynamicBuffer;
+
+/**
+ * @brief Bind-pose vertex read by the skinning stage, 40 bytes
+ */
+struct SkinningVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+    uint8_t joints[4];   // Palette indices
+    uint8_t weights[4];  // Unorm8, renormalized by the shader
+};
+static_assert(sizeof(SkinningVertex) == 40, "SkinningVertex must match the WGSL layout");
+
+/**
+ * @brief Vertex written by the skinning stage, 32 bytes
+ */
+struct SkinnedVertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+static_assert(sizeof(SkinnedVertex) == 32, "SkinnedVertex must match the WGSL layout");
+
+/**
+ * @brief Linear blend skinning in a compute dispatch per mesh
+ *
+ * skin() copies the joint palette into a DynamicBuffer ring and records one
+ * dispatch that reads SkinningVertex records from the bind-pose buffer and
+ * writes SkinnedVertex records to the output. The bind pose is uploaded
+ * once and only the palette changes per frame, so no vertex data crosses
+ * the bus after load. Outputs are typically views of a DeviceBufferHeap
+ * created with BufferUsage::Vertex | BufferUsage::Storage, so every skinned
+ * mesh shares a few native buffers and draws through the usual vertex path
+ * with getVertexLayout():
+ *
+ *     auto heap = std::make_shared<DeviceBufferHeap>(factory, BufferUsage::Vertex | BufferUsage::Storage);
+ *     auto skinned = heap->allocate(vertexCount * sizeof(SkinnedVertex));
+ *     ...
+ *     skinner.skin(*computePass, bindPose, skinned, vertexCount, palette);
+ *     computePass->end();
+ *     ...                                   // draw with skinned as vertex buffer
+ *     skinner.flush();                      // before queue submit
+ *     queue->submit(encoder->finish());
+ *     skinner.nextFrame();                  // after queue submit
+ *
+ * Palette matrices are column-major; normals are transformed by the upper
+ * 3x3 and renormalized, which is exact for rotations and uniform scale.
+ */
+class GpuSkinner {
+public:
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    struct Config {
+        uint64_t paletteBufferSize = 1 << 20;  // Per frame, about 4k joints
+        uint32_t frameCount = 3;
+        uint32_t maxJoints = 256;              // Per mesh, sets the palette binding size
+    };
+
+    GpuSkinner(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~GpuSkinner();
+
+    GpuSkinner(const GpuSkinner&) = delete;
+    GpuSkinner& operator=(const GpuSkinner&) = delete;
+
+    bool isValid() const { return _pipeline != nullptr; }
+
+    /**
+     * @brief Record the skinning dispatch of one mesh into an open compute pass
+     * @param bindPose Storage buffer of vertexCount SkinningVertex records
+     * @param output Storage | Vertex buffer receiving vertexCount SkinnedVertex records
+     * @return false if a buffer is too small, the palette is too large or the ring is full
+     */
+    bool skin(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& bindPose,
+              const std::shared_ptr<IBuffer>& output, uint32_t vertexCount, std::span<const Mat4> palette);
+
+    /**
+     * @brief Upload the palettes written this frame; call before queue submit
+     */
+    bool flush();
+
+    /**
+     * @brief Advance the palette ring; call after queue submit
+     */
+    void nextFrame();
+
+    /**
+     * @brief Layout of SkinnedVertex: position, normal and uv at locations 0, 1 and 2
+     */
+    static VertexBufferLayout getVertexLayout();
+
+    uint32_t getDispatchCount() const { return _dispatchCount; }
+
+private:
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    uint64_t _paletteBindingSize = 0;
+    std::unique_ptr<DynamicBuffer> _palettes;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IComputePipeline> _pipeline;
+    uint32_t _dispatchCount = 0;  // Since the last nextFrame()
+};
+
+} // namespace pers
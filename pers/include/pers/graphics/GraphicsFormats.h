@@ -27,18 +27,17 @@ enum class CompareFunction : uint32_t {
  * 
  * COMPRESSED FORMATS:
  * - BC formats (BC1-BC7): Supported on Desktop (D3D, Vulkan on Windows/Linux, Metal on macOS with extension)
- *   NOT supported on: Mobile, WebGPU (optional feature)
+ *   NOT supported on: Mobile. WebGPU: optional feature TextureCompressionBC
  * 
  * - ETC2/EAC formats: Supported on Mobile (OpenGL ES 3.0+, Vulkan, Metal)
- *   NOT supported on: D3D (any version), WebGPU (optional feature)
- *   Formats not included: ETC2_RGB8, ETC2_RGBA8, ETC2_RGB8_SRGB, ETC2_RGBA8_SRGB,
- *                        EAC_R11, EAC_RG11, ETC2_RGB8A1, ETC2_RGB8A1_SRGB
+ *   NOT supported on: D3D (any version). WebGPU: optional feature TextureCompressionETC2
  * 
- * - ASTC formats: Supported on Mobile (newer devices), Metal, Vulkan (with extension)
- *   NOT supported on: D3D, WebGPU (optional feature)
- *   Formats not included: ASTC_4x4, ASTC_5x4, ASTC_5x5, ASTC_6x5, ASTC_6x6,
- *                        ASTC_8x5, ASTC_8x6, ASTC_8x8, ASTC_10x5, ASTC_10x6,
- *                        ASTC_10x8, ASTC_10x10, ASTC_12x10, ASTC_12x12 (all with UNORM/SRGB variants)
+ * - ASTC formats (LDR profile): Supported on Mobile (newer devices), Metal, Vulkan (with extension)
+ *   NOT supported on: D3D. WebGPU: optional feature TextureCompressionASTC
+ * 
+ *   Compressed formats are sampled only: no render attachment or storage use.
+ *   Only create them when the feature was requested on the device (see
+ *   TextureFormatSelector.h for picking a format the adapter supports).
  * 
  * - PVRTC formats: Supported ONLY on iOS/Metal (PowerVR GPUs)
  *   NOT supported on: Any other platform
@@ -140,6 +139,49 @@ enum class TextureFormat {
     BC7RGBAUnorm,     // High quality compression
     BC7RGBAUnormSrgb,
     
+    // ETC2/EAC compressed formats (Mobile, requires TextureCompressionETC2)
+    ETC2RGB8Unorm,     // 4bpp, opaque
+    ETC2RGB8UnormSrgb,
+    ETC2RGB8A1Unorm,   // 4bpp, 1-bit alpha
+    ETC2RGB8A1UnormSrgb,
+    ETC2RGBA8Unorm,    // 8bpp, full alpha
+    ETC2RGBA8UnormSrgb,
+    EACR11Unorm,       // Single channel compression
+    EACR11Snorm,
+    EACRG11Unorm,      // Two channel compression (normal maps)
+    EACRG11Snorm,
+    
+    // ASTC compressed formats (Mobile/Apple, requires TextureCompressionASTC)
+    // 128-bit blocks, block footprint sets the rate: 4x4 = 8bpp ... 12x12 = 0.89bpp
+    ASTC4x4Unorm,
+    ASTC4x4UnormSrgb,
+    ASTC5x4Unorm,
+    ASTC5x4UnormSrgb,
+    ASTC5x5Unorm,
+    ASTC5x5UnormSrgb,
+    ASTC6x5Unorm,
+    ASTC6x5UnormSrgb,
+    ASTC6x6Unorm,
+    ASTC6x6UnormSrgb,
+    ASTC8x5Unorm,
+    ASTC8x5UnormSrgb,
+    ASTC8x6Unorm,
+    ASTC8x6UnormSrgb,
+    ASTC8x8Unorm,
+    ASTC8x8UnormSrgb,
+    ASTC10x5Unorm,
+    ASTC10x5UnormSrgb,
+    ASTC10x6Unorm,
+    ASTC10x6UnormSrgb,
+    ASTC10x8Unorm,
+    ASTC10x8UnormSrgb,
+    ASTC10x10Unorm,
+    ASTC10x10UnormSrgb,
+    ASTC12x10Unorm,
+    ASTC12x10UnormSrgb,
+    ASTC12x12Unorm,
+    ASTC12x12UnormSrgb,
+    
     // Default/undefined
     Undefined
 };
@@ -183,9 +225,80 @@ enum class VertexFormat {
     Sint32,
     Sint32x2,
     Sint32x3,
-    Sint32x4
+    Sint32x4,
+    
+    // Single-component formats (appended to keep serialized values stable)
+    Uint8,
+    Sint8,
+    Unorm8,
+    Snorm8,
+    Uint16,
+    Sint16,
+    Unorm16,
+    Snorm16,
+    Float16,
+    
+    // Packed formats
+    Unorm10_10_10_2,   // RGB 10 bits each, A 2 bits, in one 32-bit word
+    Unorm8x4BGRA       // Unorm8x4 with R and B swapped on fetch
 };
 
+/**
+ * @brief Size in bytes of one vertex attribute of the given format
+ */
+inline constexpr uint32_t getVertexFormatSize(VertexFormat format) {
+    switch (format) {
+        case VertexFormat::Uint8:
+        case VertexFormat::Sint8:
+        case VertexFormat::Unorm8:
+        case VertexFormat::Snorm8:
+            return 1;
+        case VertexFormat::Uint8x2:
+        case VertexFormat::Sint8x2:
+        case VertexFormat::Unorm8x2:
+        case VertexFormat::Snorm8x2:
+        case VertexFormat::Uint16:
+        case VertexFormat::Sint16:
+        case VertexFormat::Unorm16:
+        case VertexFormat::Snorm16:
+        case VertexFormat::Float16:
+            return 2;
+        case VertexFormat::Uint8x4:
+        case VertexFormat::Sint8x4:
+        case VertexFormat::Unorm8x4:
+        case VertexFormat::Snorm8x4:
+        case VertexFormat::Unorm8x4BGRA:
+        case VertexFormat::Uint16x2:
+        case VertexFormat::Sint16x2:
+        case VertexFormat::Unorm16x2:
+        case VertexFormat::Snorm16x2:
+        case VertexFormat::Float16x2:
+        case VertexFormat::Unorm10_10_10_2:
+        case VertexFormat::Float32:
+        case VertexFormat::Uint32:
+        case VertexFormat::Sint32:
+            return 4;
+        case VertexFormat::Uint16x4:
+        case VertexFormat::Sint16x4:
+        case VertexFormat::Unorm16x4:
+        case VertexFormat::Snorm16x4:
+        case VertexFormat::Float16x4:
+        case VertexFormat::Float32x2:
+        case VertexFormat::Uint32x2:
+        case VertexFormat::Sint32x2:
+            return 8;
+        case VertexFormat::Float32x3:
+        case VertexFormat::Uint32x3:
+        case VertexFormat::Sint32x3:
+            return 12;
+        case VertexFormat::Float32x4:
+        case VertexFormat::Uint32x4:
+        case VertexFormat::Sint32x4:
+            return 16;
+    }
+    return 0;
+}
+
 /**
  * @brief Index format enumeration
  */
@@ -195,4 +308,185 @@ enum class IndexFormat {
     Uint32
 };
 
+/**
+ * @brief Block compression family of a texture format
+ */
+enum class TextureCompressionFamily {
+    None,
+    BC,
+    ETC2,
+    ASTC
+};
+
+inline constexpr TextureCompressionFamily getTextureCompressionFamily(TextureFormat format) {
+    if (format >= TextureFormat::BC1RGBAUnorm && format <= TextureFormat::BC7RGBAUnormSrgb) {
+        return TextureCompressionFamily::BC;
+    }
+    if (format >= TextureFormat::ETC2RGB8Unorm && format <= TextureFormat::EACRG11Snorm) {
+        return TextureCompressionFamily::ETC2;
+    }
+    if (format >= TextureFormat::ASTC4x4Unorm && format <= TextureFormat::ASTC12x12UnormSrgb) {
+        return TextureCompressionFamily::ASTC;
+    }
+    return TextureCompressionFamily::None;
+}
+
+inline constexpr bool isCompressedFormat(TextureFormat format) {
+    return getTextureCompressionFamily(format) != TextureCompressionFamily::None;
+}
+
+/**
+ * @brief Copy footprint of one texel block
+ * Uncompressed formats use 1x1 blocks. Formats that cannot be copied from a
+ * buffer (e.g. Depth24Plus) report blockBytes = 0.
+ */
+struct TextureFormatBlockInfo {
+    uint32_t blockBytes = 0;
+    uint32_t blockWidth = 1;
+    uint32_t blockHeight = 1;
+};
+
+/**
+ * @brief Get the block footprint used for buffer/texture copies
+ * @param format Texture format
+ * @return Block info, blockBytes is 0 if the format is not copyable
+ */
+inline constexpr TextureFormatBlockInfo getTextureFormatBlockInfo(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8Unorm:
+        case TextureFormat::R8Snorm:
+        case TextureFormat::R8Uint:
+        case TextureFormat::R8Sint:
+        case TextureFormat::Stencil8:
+            return {1, 1, 1};
+            
+        case TextureFormat::R16Uint:
+        case TextureFormat::R16Sint:
+        case TextureFormat::R16Float:
+        case TextureFormat::R16Unorm:
+        case TextureFormat::R16Snorm:
+        case TextureFormat::RG8Unorm:
+        case TextureFormat::RG8Snorm:
+        case TextureFormat::RG8Uint:
+        case TextureFormat::RG8Sint:
+        case TextureFormat::Depth16Unorm:
+            return {2, 1, 1};
+            
+        case TextureFormat::R32Uint:
+        case TextureFormat::R32Sint:
+        case TextureFormat::R32Float:
+        case TextureFormat::RG16Uint:
+        case TextureFormat::RG16Sint:
+        case TextureFormat::RG16Float:
+        case TextureFormat::RG16Unorm:
+        case TextureFormat::RG16Snorm:
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::RGBA8Snorm:
+        case TextureFormat::RGBA8Uint:
+        case TextureFormat::RGBA8Sint:
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::RGB9E5Ufloat:
+        case TextureFormat::RGB10A2Unorm:
+        case TextureFormat::RG11B10Ufloat:
+        case TextureFormat::Depth32Float:
+            return {4, 1, 1};
+            
+        case TextureFormat::RG32Uint:
+        case TextureFormat::RG32Sint:
+        case TextureFormat::RG32Float:
+        case TextureFormat::RGBA16Uint:
+        case TextureFormat::RGBA16Sint:
+        case TextureFormat::RGBA16Float:
+        case TextureFormat::RGBA16Unorm:
+        case TextureFormat::RGBA16Snorm:
+            return {8, 1, 1};
+            
+        case TextureFormat::RGBA32Uint:
+        case TextureFormat::RGBA32Sint:
+        case TextureFormat::RGBA32Float:
+            return {16, 1, 1};
+            
+        case TextureFormat::BC1RGBAUnorm:
+        case TextureFormat::BC1RGBAUnormSrgb:
+        case TextureFormat::BC4RUnorm:
+        case TextureFormat::BC4RSnorm:
+            return {8, 4, 4};
+            
+        case TextureFormat::BC2RGBAUnorm:
+        case TextureFormat::BC2RGBAUnormSrgb:
+        case TextureFormat::BC3RGBAUnorm:
+        case TextureFormat::BC3RGBAUnormSrgb:
+        case TextureFormat::BC5RGUnorm:
+        case TextureFormat::BC5RGSnorm:
+        case TextureFormat::BC6HRGBUfloat:
+        case TextureFormat::BC6HRGBFloat:
+        case TextureFormat::BC7RGBAUnorm:
+        case TextureFormat::BC7RGBAUnormSrgb:
+            return {16, 4, 4};
+            
+        case TextureFormat::ETC2RGB8Unorm:
+        case TextureFormat::ETC2RGB8UnormSrgb:
+        case TextureFormat::ETC2RGB8A1Unorm:
+        case TextureFormat::ETC2RGB8A1UnormSrgb:
+        case TextureFormat::EACR11Unorm:
+        case TextureFormat::EACR11Snorm:
+            return {8, 4, 4};
+            
+        case TextureFormat::ETC2RGBA8Unorm:
+        case TextureFormat::ETC2RGBA8UnormSrgb:
+        case TextureFormat::EACRG11Unorm:
+        case TextureFormat::EACRG11Snorm:
+            return {16, 4, 4};
+            
+        case TextureFormat::ASTC4x4Unorm:
+        case TextureFormat::ASTC4x4UnormSrgb:
+            return {16, 4, 4};
+        case TextureFormat::ASTC5x4Unorm:
+        case TextureFormat::ASTC5x4UnormSrgb:
+            return {16, 5, 4};
+        case TextureFormat::ASTC5x5Unorm:
+        case TextureFormat::ASTC5x5UnormSrgb:
+            return {16, 5, 5};
+        case TextureFormat::ASTC6x5Unorm:
+        case TextureFormat::ASTC6x5UnormSrgb:
+            return {16, 6, 5};
+        case TextureFormat::ASTC6x6Unorm:
+        case TextureFormat::ASTC6x6UnormSrgb:
+            return {16, 6, 6};
+        case TextureFormat::ASTC8x5Unorm:
+        case TextureFormat::ASTC8x5UnormSrgb:
+            return {16, 8, 5};
+        case TextureFormat::ASTC8x6Unorm:
+        case TextureFormat::ASTC8x6UnormSrgb:
+            return {16, 8, 6};
+        case TextureFormat::ASTC8x8Unorm:
+        case TextureFormat::ASTC8x8UnormSrgb:
+            return {16, 8, 8};
+        case TextureFormat::ASTC10x5Unorm:
+        case TextureFormat::ASTC10x5UnormSrgb:
+            return {16, 10, 5};
+        case TextureFormat::ASTC10x6Unorm:
+        case TextureFormat::ASTC10x6UnormSrgb:
+            return {16, 10, 6};
+        case TextureFormat::ASTC10x8Unorm:
+        case TextureFormat::ASTC10x8UnormSrgb:
+            return {16, 10, 8};
+        case TextureFormat::ASTC10x10Unorm:
+        case TextureFormat::ASTC10x10UnormSrgb:
+            return {16, 10, 10};
+        case TextureFormat::ASTC12x10Unorm:
+        case TextureFormat::ASTC12x10UnormSrgb:
+            return {16, 12, 10};
+        case TextureFormat::ASTC12x12Unorm:
+        case TextureFormat::ASTC12x12UnormSrgb:
+            return {16, 12, 12};
+            
+        default:
+            // Depth24Plus, Depth24PlusStencil8, Depth32FloatStencil8 and Undefined
+            return {0, 1, 1};
+    }
+}
+
 } // namespace pers
\ No newline at end of file
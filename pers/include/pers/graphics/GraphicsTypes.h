@@ -134,7 +134,11 @@ enum class HandleType {
     Shader,
     BindGroup,
     BindGroupLayout,
-    PipelineLayout
+    PipelineLayout,
+    RenderBundle,
+    RenderBundleEncoder,
+    ComputePass,
+    QuerySet
 };
 
 /**
@@ -208,6 +212,9 @@ using NativeQueueHandle = TypedHandle<HandleType::Queue>;               // WGPUQ
 using NativeCommandBufferHandle = TypedHandle<HandleType::CommandBuffer>; // WGPUCommandBuffer for WebGPU
 using NativeEncoderHandle = TypedHandle<HandleType::CommandEncoder>;    // WGPUCommandEncoder for WebGPU
 using NativeRenderPassHandle = TypedHandle<HandleType::RenderPass>;     // WGPURenderPassEncoder for WebGPU
+using NativeRenderBundleHandle = TypedHandle<HandleType::RenderBundle>; // WGPURenderBundle for WebGPU
+using NativeComputePassEncoderHandle = TypedHandle<HandleType::ComputePass>; // WGPUComputePassEncoder for WebGPU
+using NativeRenderBundleEncoderHandle = TypedHandle<HandleType::RenderBundleEncoder>; // WGPURenderBundleEncoder for WebGPU
 
 // Resource handles
 using NativeSwapChainHandle = TypedHandle<HandleType::SwapChain>;       // Implementation-specific
@@ -215,6 +222,7 @@ using NativeTextureViewHandle = TypedHandle<HandleType::TextureView>;   // WGPUT
 using NativeBufferHandle = TypedHandle<HandleType::Buffer>;             // WGPUBuffer for WebGPU
 using NativeTextureHandle = TypedHandle<HandleType::Texture>;           // WGPUTexture for WebGPU
 using NativeSamplerHandle = TypedHandle<HandleType::Sampler>;           // WGPUSampler for WebGPU
+using NativeQuerySetHandle = TypedHandle<HandleType::QuerySet>;         // WGPUQuerySet for WebGPU
 
 // Pipeline and shader handles
 using NativePipelineHandle = TypedHandle<HandleType::Pipeline>;         // WGPURenderPipeline for WebGPU
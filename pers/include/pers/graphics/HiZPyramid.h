@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class IResourceFactory;
+class ICommandEncoder;
+class IComputePipeline;
+class IBindGroupLayout;
+class IBindGroup;
+class ITexture;
+class ITextureView;
+
+/**
+ * @brief Hierarchical max-depth pyramid built from a depth buffer
+ *
+ * Level 0 is half the depth buffer's size rounded up, each texel the
+ * farthest of the 2x2 depth texels it covers; every further level halves
+ * again with the usual round-down mip sizes and folds the leftover row or
+ * column of an odd level into its last texel, so no source texel is
+ * skipped. With the Less depth test a texel therefore bounds everything
+ * drawn in its footprint, and anything nearer than the bound may be visible.
+ *
+ * One compute pass with a dispatch per level; the pyramid is R32Float with
+ * TextureBinding and StorageBinding usage and is recreated when the depth
+ * buffer size changes. The depth view must be single-sampled, from a
+ * texture with TextureBinding usage and, for depth-stencil formats, of
+ * aspect DepthOnly:
+ *
+ *     pyramid.build(*encoder, depthView);    // After the depth pre-pass or frame
+ *     // Next frame: GpuOcclusionCuller tests candidates against getView()
+ */
+class HiZPyramid {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 8;  // 8x8 texels per workgroup
+
+    explicit HiZPyramid(const std::shared_ptr<IResourceFactory>& factory);
+    ~HiZPyramid();
+
+    HiZPyramid(const HiZPyramid&) = delete;
+    HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+    bool isValid() const { return _reducePipeline != nullptr; }
+
+    /**
+     * @brief Record the passes rebuilding every level from depthView
+     * @return false if the depth view or a resource is unusable
+     */
+    bool build(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& depthView);
+
+    /**
+     * @brief View of the whole mip chain for texture_2d<f32> bindings, null before the first build
+     */
+    const std::shared_ptr<ITextureView>& getView() const { return _view; }
+    const std::shared_ptr<ITexture>& getTexture() const { return _texture; }
+
+    /**
+     * @brief Size of level 0
+     */
+    uint32_t getWidth() const { return _width; }
+    uint32_t getHeight() const { return _height; }
+    uint32_t getMipLevelCount() const { return static_cast<uint32_t>(_levelViews.size()); }
+
+    /**
+     * @brief Size of the depth buffer the pyramid was last built from
+     */
+    uint32_t getDepthWidth() const { return _depthWidth; }
+    uint32_t getDepthHeight() const { return _depthHeight; }
+
+private:
+    bool resize(uint32_t depthWidth, uint32_t depthHeight);
+
+    std::weak_ptr<IResourceFactory> _factory;
+    std::shared_ptr<IBindGroupLayout> _seedLayout;
+    std::shared_ptr<IBindGroupLayout> _reduceLayout;
+    std::shared_ptr<IComputePipeline> _seedPipeline;
+    std::shared_ptr<IComputePipeline> _reducePipeline;
+
+    std::shared_ptr<ITexture> _texture;
+    std::shared_ptr<ITextureView> _view;
+    std::vector<std::shared_ptr<ITextureView>> _levelViews;
+    std::vector<std::shared_ptr<IBindGroup>> _reduceBindGroups;  // Level i + 1 from level i
+    std::weak_ptr<ITextureView> _seedDepthView;
+    std::shared_ptr<IBindGroup> _seedBindGroup;
+    uint32_t _depthWidth = 0;
+    uint32_t _depthHeight = 0;
+    uint32_t _width = 0;
+    uint32_t _height = 0;
+};
+
+} // namespace pers
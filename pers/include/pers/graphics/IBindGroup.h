@@ -1,18 +1,67 @@
 #pragma once
 
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace pers {
 
+class IBindGroupLayout;
+class IBuffer;
+class ISampler;
+class ITextureView;
+
+/**
+ * @brief One resource in a bind group
+ * Set buffer for buffer bindings, textureView for texture bindings or
+ * sampler for sampler bindings. Binding arrays take the plural members
+ * instead, one element per array slot; buffers in an array are bound whole.
+ */
+struct BindGroupEntry {
+    uint32_t binding = 0;
+
+    std::shared_ptr<IBuffer> buffer;
+    uint64_t offset = 0;
+    uint64_t size = BufferCopyDesc::WHOLE_SIZE;  // WHOLE_SIZE binds to the end of the buffer
+
+    std::shared_ptr<ITextureView> textureView;
+
+    std::shared_ptr<ISampler> sampler;
+
+    // Binding arrays
+    std::vector<std::shared_ptr<IBuffer>> buffers;
+    std::vector<std::shared_ptr<ITextureView>> textureViews;
+    std::vector<std::shared_ptr<ISampler>> samplers;
+};
+
+struct BindGroupDesc {
+    std::shared_ptr<IBindGroupLayout> layout;
+    std::vector<BindGroupEntry> entries;
+    std::string debugName;
+};
+
 /**
  * @brief Bind group interface
- * 
+ *
  * Represents a collection of resources that are bound together.
  */
 class IBindGroup {
 public:
     virtual ~IBindGroup() = default;
-    
+
+    /**
+     * @brief Get the layout this bind group was created against
+     */
+    virtual const std::shared_ptr<IBindGroupLayout>& getLayout() const = 0;
+
+    /**
+     * @brief Get the descriptor the bind group was created from
+     */
+    virtual const BindGroupDesc& getDesc() const = 0;
+
     /**
      * @brief Get native bind group handle for backend-specific operations
      * @return Native bind group handle (WGPUBindGroup for WebGPU)
@@ -20,4 +69,4 @@ public:
     virtual NativeBindGroupHandle getNativeBindGroupHandle() const = 0;
 };
 
-} // namespace pers
\ No newline at end of file
+} // namespace pers
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IShaderModule.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Kind of resource bound at a binding slot
+ */
+enum class BindingType {
+    UniformBuffer,
+    StorageBuffer,
+    ReadOnlyStorageBuffer,
+    SampledTexture,
+    Sampler,                // Filtering sampler
+    NonFilteringSampler,    // For UnfilterableFloat/integer textures
+    ComparisonSampler,      // Depth comparison (shadow maps)
+    StorageTexture          // Write-only texture_storage_* (compute outputs)
+};
+
+/**
+ * @brief Texture sample type for SampledTexture bindings
+ */
+enum class TextureSampleType {
+    Float,
+    UnfilterableFloat,
+    Depth,
+    Sint,
+    Uint
+};
+
+struct BindGroupLayoutEntry {
+    uint32_t binding = 0;
+    ShaderStage visibility = ShaderStage::Vertex | ShaderStage::Fragment;
+    BindingType type = BindingType::UniformBuffer;
+
+    // Buffer bindings
+    bool hasDynamicOffset = false;  // Offset supplied at setBindGroup time
+    uint64_t minBindingSize = 0;    // 0 = validated at draw time
+
+    // Texture bindings
+    TextureSampleType sampleType = TextureSampleType::Float;
+    TextureViewDimension viewDimension = TextureViewDimension::D2;
+    bool multisampled = false;
+    TextureFormat storageTextureFormat = TextureFormat::Undefined;  // StorageTexture only
+
+    // Binding array size, 0 for a single resource. Texture and sampler arrays need
+    // DeviceFeature::TextureBindingArray, buffer arrays DeviceFeature::BufferBindingArray.
+    uint32_t count = 0;
+};
+
+struct BindGroupLayoutDesc {
+    std::vector<BindGroupLayoutEntry> entries;
+    std::string debugName;
+};
+
+/**
+ * @brief Bind group layout interface
+ *
+ * Describes the bindings a bind group provides and a pipeline expects.
+ */
+class IBindGroupLayout {
+public:
+    virtual ~IBindGroupLayout() = default;
+
+    /**
+     * @brief Get the description the layout was created from
+     */
+    virtual const BindGroupLayoutDesc& getDesc() const = 0;
+
+    /**
+     * @brief Get native bind group layout handle for backend-specific operations
+     * @return Native bind group layout handle (WGPUBindGroupLayout for WebGPU)
+     */
+    virtual NativeBindGroupLayoutHandle getNativeBindGroupLayoutHandle() const = 0;
+};
+
+} // namespace pers
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include "pers/graphics/GraphicsFormats.h"
 #include "pers/graphics/RenderPassTypes.h"
 #include "pers/graphics/buffers/BufferTypes.h"
 
@@ -12,6 +13,87 @@ class ImmediateStagingBuffer;
 class DeferredStagingBuffer;
 class ICommandBuffer;
 class IRenderPassEncoder;
+class IComputePassEncoder;
+class IPreparedRenderPass;
+class ITexture;
+class IQuerySet;
+struct ComputePassDesc;
+
+/**
+ * @brief Texture-to-buffer copies need row pitches aligned to this many bytes
+ */
+constexpr uint32_t TEXTURE_READBACK_ROW_ALIGNMENT = 256;
+
+/**
+ * @brief Row pitch a readback of `width` texels of `format` uses by default
+ * @return 0 if the format cannot be copied into a buffer
+ */
+inline constexpr uint32_t getTextureReadbackRowPitch(TextureFormat format, uint32_t width) {
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(format);
+    const uint32_t rowBytes = (width + block.blockWidth - 1) / block.blockWidth * block.blockBytes;
+    return (rowBytes + TEXTURE_READBACK_ROW_ALIGNMENT - 1) & ~(TEXTURE_READBACK_ROW_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Region of one texture mip level copied into a readback buffer
+ */
+struct TextureReadbackDesc {
+    uint32_t mipLevel = 0;
+    uint32_t originX = 0;
+    uint32_t originY = 0;
+    uint32_t arrayLayer = 0;
+    
+    // Region extent, 0 means up to the edge of the mip level
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    TextureAspect aspect = TextureAspect::All;
+    
+    // Destination layout
+    uint64_t bufferOffset = 0;
+    uint32_t bytesPerRow = 0;  // 0 = getTextureReadbackRowPitch of the region width
+};
+
+/**
+ * @brief Region of one texture mip level written from a staging buffer
+ */
+struct TextureUploadDesc {
+    uint32_t mipLevel = 0;
+    uint32_t originX = 0;
+    uint32_t originY = 0;
+    uint32_t arrayLayer = 0;
+    
+    // Region extent, 0 means up to the edge of the mip level
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    TextureAspect aspect = TextureAspect::All;
+    
+    // Source layout, rows use the same 256-byte alignment as readbacks
+    uint64_t bufferOffset = 0;
+    uint32_t bytesPerRow = 0;  // 0 = getTextureReadbackRowPitch of the region width
+};
+
+/**
+ * @brief Region copied between two textures of the same format and sample count
+ */
+struct TextureCopyDesc {
+    uint32_t srcMipLevel = 0;
+    uint32_t srcX = 0;
+    uint32_t srcY = 0;
+    uint32_t srcArrayLayer = 0;
+    
+    uint32_t dstMipLevel = 0;
+    uint32_t dstX = 0;
+    uint32_t dstY = 0;
+    uint32_t dstArrayLayer = 0;
+    
+    // Region extent, 0 means up to the edge of the source mip level
+    uint32_t width = 0;
+    uint32_t height = 0;
+    
+    TextureAspect aspect = TextureAspect::All;
+};
 
 /**
  * @brief Command encoder interface for recording GPU commands
@@ -30,6 +112,20 @@ public:
      */
     virtual std::shared_ptr<IRenderPassEncoder> beginRenderPass(const RenderPassDesc& desc) = 0;
     
+    /**
+     * @brief Begin a render pass from a descriptor translated ahead of time
+     * @param pass Prepared by the same device's resource factory, with every color view set
+     * @return Render pass encoder for recording draw commands
+     */
+    virtual std::shared_ptr<IRenderPassEncoder> beginRenderPass(const IPreparedRenderPass& pass) = 0;
+    
+    /**
+     * @brief Begin a compute pass
+     * @param desc Compute pass descriptor
+     * @return Compute pass encoder for recording dispatches
+     */
+    virtual std::shared_ptr<IComputePassEncoder> beginComputePass(const ComputePassDesc& desc) = 0;
+    
     /**
      * @brief Upload data from staging buffer to device buffer
      * @param stagingBuffer Source staging buffer with CPU data
@@ -62,6 +158,61 @@ public:
                                           const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
                                           const BufferCopyDesc& copyDesc) = 0;
     
+    /**
+     * @brief Copy staging buffer data into a texture region
+     * @param stagingBuffer Source staging buffer with CPU data
+     * @param texture Destination texture, needs TextureUsage::CopyDst
+     * @param desc Destination region and source layout
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                                 const std::shared_ptr<ITexture>& texture,
+                                 const TextureUploadDesc& desc) = 0;
+    
+    /**
+     * @brief Copy a region of a device buffer into a texture (GPU to GPU)
+     * @param source Device buffer with BufferUsage::CopySrc, laid out as for uploadToTexture
+     * @param texture Destination texture, needs TextureUsage::CopyDst
+     * @param desc Destination region and source layout
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                                     const std::shared_ptr<ITexture>& texture,
+                                     const TextureUploadDesc& desc) = 0;
+    
+    /**
+     * @brief Copy a texture region into a buffer for CPU readback
+     * @param texture Source texture, needs TextureUsage::CopySrc
+     * @param readbackBuffer Destination buffer for CPU readback
+     * @param desc Source region and destination layout
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                                     const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                     const TextureReadbackDesc& desc) = 0;
+    
+    /**
+     * @brief Copy a texture region into a device buffer (GPU to GPU)
+     * @param texture Source texture, needs TextureUsage::CopySrc
+     * @param destination Device buffer with BufferUsage::CopyDst
+     * @param desc Source region and destination layout
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                                     const std::shared_ptr<DeviceBuffer>& destination,
+                                     const TextureReadbackDesc& desc) = 0;
+    
+    /**
+     * @brief Copy a texture region into another texture (GPU to GPU)
+     * @param source Source texture, needs TextureUsage::CopySrc
+     * @param destination Destination texture, needs TextureUsage::CopyDst
+     * @param desc Source and destination regions
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                                      const std::shared_ptr<ITexture>& destination,
+                                      const TextureCopyDesc& desc) = 0;
+    
     /**
      * @brief Copy data between device buffers (GPU to GPU)
      * @param source Source GPU buffer
@@ -73,6 +224,32 @@ public:
                                     const std::shared_ptr<DeviceBuffer>& destination,
                                     const BufferCopyDesc& copyDesc) = 0;
     
+    /**
+     * @brief Fill a device buffer range with zeros
+     * @param buffer Device buffer with BufferUsage::CopyDst
+     * @param offset Byte offset, multiple of 4
+     * @param size Byte count, multiple of 4, or WHOLE_SIZE for the rest of the buffer
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer,
+                             uint64_t offset = 0,
+                             uint64_t size = BufferCopyDesc::WHOLE_SIZE) = 0;
+    
+    /**
+     * @brief Resolve query results into a device buffer
+     * @param querySet Query set the results are read from
+     * @param firstQuery First query to resolve
+     * @param queryCount Number of queries, each written as getQueryValueCount() uint64_t values
+     * @param destination Buffer created with DeviceBufferUsage::QueryResolve
+     * @param destinationOffset Byte offset in destination, multiple of 256
+     * @return true if command was successfully encoded, false otherwise
+     */
+    virtual bool resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet,
+                                 uint32_t firstQuery,
+                                 uint32_t queryCount,
+                                 const std::shared_ptr<DeviceBuffer>& destination,
+                                 uint64_t destinationOffset = 0) = 0;
+    
     /**
      * @brief Finish recording and create command buffer
      * @return Command buffer ready for submission
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <memory>
+#include <cstdint>
+#include <span>
+#include <string>
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IQuerySet.h"
+
+namespace pers {
+
+// Forward declarations
+class IComputePipeline;
+class IBindGroup;
+class IBuffer;
+
+/**
+ * @brief Compute pass descriptor
+ */
+struct ComputePassDesc {
+    std::string label;
+    
+    // GPU timestamps at pass begin/end (optional)
+    PassTimestampWrites timestampWrites;
+};
+
+/**
+ * @brief Argument layout of dispatchIndirect, as written into an Indirect buffer
+ */
+struct DispatchIndirectArgs {
+    uint32_t workgroupCountX = 0;
+    uint32_t workgroupCountY = 1;
+    uint32_t workgroupCountZ = 1;
+};
+static_assert(sizeof(DispatchIndirectArgs) == 12, "DispatchIndirectArgs must match the GPU layout");
+
+/**
+ * @brief Compute pass encoder interface for recording dispatches
+ * 
+ * Based on WebGPU ComputePassEncoder concept but abstracted for cross-platform use.
+ */
+class IComputePassEncoder {
+public:
+    virtual ~IComputePassEncoder() = default;
+    
+    /**
+     * @brief Set the compute pipeline
+     * @param pipeline Compute pipeline used by following dispatches
+     */
+    virtual void setPipeline(const std::shared_ptr<IComputePipeline>& pipeline) = 0;
+    
+    /**
+     * @brief Set a bind group
+     * @param index Bind group index
+     * @param bindGroup Bind group to set, typically with StorageBuffer bindings
+     * @param dynamicOffsets One offset per dynamic-offset binding, in binding order
+     */
+    virtual void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                              std::span<const uint32_t> dynamicOffsets = {}) = 0;
+    
+    /**
+     * @brief Write push constant bytes of the compute range read by following dispatches
+     * Needs DeviceFeature::PushConstants and a covering PushConstantRange in the layout.
+     * @param offset Byte offset in the push constant block, multiple of 4
+     * @param data Bytes to write, size a multiple of 4
+     */
+    virtual void setPushConstants(uint32_t offset, std::span<const std::byte> data) = 0;
+    
+    /**
+     * @brief Dispatch workgroups
+     * @param workgroupCountX Workgroups along X
+     * @param workgroupCountY Workgroups along Y
+     * @param workgroupCountZ Workgroups along Z
+     */
+    virtual void dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY = 1,
+                          uint32_t workgroupCountZ = 1) = 0;
+    
+    /**
+     * @brief Dispatch with workgroup counts read from a GPU buffer
+     * @param indirectBuffer Buffer created with BufferUsage::Indirect holding DispatchIndirectArgs
+     * @param indirectOffset Byte offset of the arguments, multiple of 4
+     */
+    virtual void dispatchIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) = 0;
+    
+    /**
+     * @brief Start recording pipeline statistics
+     * @param querySet Query set of type PipelineStatistics
+     * @param queryIndex Index in querySet
+     */
+    virtual void beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet, uint32_t queryIndex) = 0;
+    
+    /**
+     * @brief End the pipeline statistics query
+     */
+    virtual void endPipelineStatisticsQuery() = 0;
+    
+    /**
+     * @brief End the compute pass
+     */
+    virtual void end() = 0;
+    
+    /**
+     * @brief Get native compute pass encoder handle for backend-specific operations
+     * @return Native compute pass encoder handle (WGPUComputePassEncoder for WebGPU)
+     */
+    virtual NativeComputePassEncoderHandle getNativeComputePassEncoderHandle() const = 0;
+};
+
+} // namespace pers
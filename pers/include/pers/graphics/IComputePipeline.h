@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IShaderModule.h"
+
+namespace pers {
+
+// Forward declarations
+class IShaderModule;
+class IPipelineLayout;
+
+struct ComputePipelineDesc {
+    // Compute shader (required)
+    std::shared_ptr<IShaderModule> compute;
+    
+    // Override constants of the compute stage
+    std::vector<PipelineConstant> constants;
+    
+    // Resource layout (optional - null derives a shared layout from shader reflection,
+    // falling back to the backend's implicit layout when reflection cannot express it)
+    std::shared_ptr<IPipelineLayout> layout;
+    
+    // Optional debug name
+    std::string debugName;
+};
+
+class IComputePipeline {
+public:
+    virtual ~IComputePipeline() = default;
+    
+    virtual const std::string& getDebugName() const = 0;
+    virtual bool isValid() const = 0;
+    
+    /**
+     * @brief Get native pipeline handle for backend-specific operations
+     * @return Native pipeline handle (WGPUComputePipeline for WebGPU)
+     */
+    virtual NativePipelineHandle getNativePipelineHandle() const = 0;
+};
+
+} // namespace pers
@@ -78,6 +78,13 @@ public:
      * @return True if depth/stencil attachment exists
      */
     virtual bool hasDepthStencilAttachment() const = 0;
+    
+    /**
+     * @brief Get the single-sample view a multisampled color attachment resolves into
+     * @param index The color attachment index
+     * @return Resolve target view, or nullptr if the attachment is not resolved
+     */
+    virtual std::shared_ptr<ITextureView> getResolveTarget(uint32_t index = 0) const { return nullptr; }
 };
 
 /**
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "pers/graphics/GraphicsTypes.h"
 
 namespace pers {
@@ -80,6 +81,17 @@ struct PhysicalDeviceOptions {
      * @note Leave empty (nullptr) for offscreen rendering or when surface compatibility doesn't matter
      */
     NativeSurfaceHandle compatibleSurface;
+    
+    /**
+     * @brief Pick the adapter by measured throughput (see AdapterBenchmark)
+     * 
+     * Every enumerated adapter that can present to compatibleSurface (when
+     * set) gets a short fill-rate and copy-bandwidth test and the fastest one
+     * is returned; powerPreference is ignored. Falls back to the regular
+     * request if no candidate could be benchmarked.
+     */
+    bool selectByBenchmark = false;
+    std::string benchmarkCachePath;  // Results kept here between launches, empty = measure every time
 };
 
 /**
@@ -101,6 +113,16 @@ public:
     virtual std::shared_ptr<IPhysicalDevice> requestPhysicalDevice(
         const PhysicalDeviceOptions& options) = 0;
     
+    /**
+     * @brief Enumerate every usable physical device (adapter)
+     * 
+     * For spreading work over several GPUs (see DevicePool). Software
+     * adapters are included only if the instance allows software rendering.
+     * 
+     * @return Physical devices in backend order, empty if none are available
+     */
+    virtual std::vector<std::shared_ptr<IPhysicalDevice>> enumeratePhysicalDevices() = 0;
+    
     /**
      * @brief Create a surface from a native window handle
      * @param windowHandle Native window handle (GLFWwindow*, HWND, etc.)
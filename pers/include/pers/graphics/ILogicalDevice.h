@@ -3,6 +3,7 @@
 #include <memory>
 #include <cstdint>
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IPhysicalDevice.h"
 
 namespace pers {
 
@@ -12,6 +13,10 @@ class ICommandEncoder;
 class ISwapChain;
 class IResourceFactory;
 class IPhysicalDevice;
+class StagingBufferPool;
+class DeferredDeletionQueue;
+class IRenderBundleEncoder;
+struct RenderBundleEncoderDesc;
 struct SwapChainDesc;
 
 /**
@@ -31,18 +36,47 @@ public:
      */
     virtual std::shared_ptr<IQueue> getQueue() const = 0;
     
+    /**
+     * @brief Get a queue for async compute work
+     * 
+     * Backends exposing a compute-only queue family return its queue so
+     * compute overlaps graphics; the default shares the device queue.
+     * 
+     * @return Shared pointer to the compute queue
+     */
+    virtual std::shared_ptr<IQueue> getComputeQueue() const { return getQueue(); }
+    
     /**
      * @brief Get the resource factory for creating GPU resources
      * @return Shared pointer to resource factory
      */
     virtual const std::shared_ptr<IResourceFactory>& getResourceFactory() const = 0;
     
+    /**
+     * @brief Get the device-wide pool of recycled upload staging buffers
+     * @return Shared pointer to staging buffer pool
+     */
+    virtual const std::shared_ptr<StagingBufferPool>& getStagingBufferPool() const = 0;
+    
+    /**
+     * @brief Get the queue that holds retired resources until the GPU is done with them
+     * @return Shared pointer to the deletion queue, null without a default queue
+     */
+    virtual const std::shared_ptr<DeferredDeletionQueue>& getDeletionQueue() const = 0;
+    
     /**
      * @brief Create a command encoder for recording GPU commands
      * @return Shared pointer to command encoder
      */
     virtual std::shared_ptr<ICommandEncoder> createCommandEncoder() = 0;
     
+    /**
+     * @brief Create an encoder for recording a reusable render bundle
+     * @param desc Attachment formats the bundle will be executed against
+     * @return Shared pointer to render bundle encoder or nullptr if failed
+     */
+    virtual std::shared_ptr<IRenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDesc& desc) = 0;
+    
     /**
      * @brief Create a swap chain for surface presentation
      * @param surface Surface handle created by IInstance
@@ -63,11 +97,32 @@ public:
      */
     virtual NativeDeviceHandle getNativeDeviceHandle() const = 0;
     
+    /**
+     * @brief Limits the device was created with
+     * 
+     * With LogicalDeviceDesc::negotiateLimits these are the granted values,
+     * which may be below the adapter maximum.
+     */
+    virtual DeviceLimits getLimits() const = 0;
+    
+    /**
+     * @brief Check whether a feature was enabled at device creation
+     */
+    virtual bool hasFeature(DeviceFeature feature) const = 0;
+    
     /**
      * @brief Get the physical device this logical device was created from
      * @return Shared pointer to physical device or nullptr if expired
      */
     virtual std::shared_ptr<IPhysicalDevice> getPhysicalDevice() const = 0;
+    
+    /**
+     * @brief Whether the device was lost (driver reset, GPU removed or destroyed)
+     * 
+     * Every resource of a lost device is dead; see DeviceRecovery for
+     * recreating them on a new device. Cheap enough to check every frame.
+     */
+    virtual bool isLost() const { return false; }
 };
 
 } // namespace pers
\ No newline at end of file
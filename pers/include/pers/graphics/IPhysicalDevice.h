@@ -16,6 +16,10 @@ class ILogicalDevice;
 struct PhysicalDeviceCapabilities {
     std::string deviceName;
     std::string driverInfo;
+    std::string vendorName;
+    std::string architecture;
+    uint32_t vendorId = 0;
+    uint32_t deviceId = 0;
     uint64_t dedicatedVideoMemory = 0;
     uint64_t dedicatedSystemMemory = 0;
     uint64_t sharedSystemMemory = 0;
@@ -42,8 +46,23 @@ struct PhysicalDeviceCapabilities {
     
     // Query capabilities
     bool supportsTimestampQuery = false;         // GPU timestamp queries
-    bool supportsPipelineStatisticsQuery = false; // Pipeline statistics queries (not in WebGPU spec yet)
+    bool supportsPipelineStatisticsQuery = false; // Pipeline statistics queries (wgpu-native extension)
     bool supportsIndirectFirstInstance = false;  // First instance in indirect draw
+    bool supportsMultiDrawIndirect = false;      // One call for many indirect records (wgpu-native extension)
+    bool supportsMultiDrawIndirectCount = false; // Record count read from a GPU buffer (wgpu-native extension)
+    
+    // Binding arrays (wgpu-native extensions)
+    bool supportsTextureBindingArray = false;
+    bool supportsBufferBindingArray = false;
+    bool supportsNonUniformIndexing = false;
+    
+    // Memory
+    bool isUnifiedMemory = false;                // Integrated or CPU adapter sharing memory with the host
+    bool supportsMappablePrimaryBuffers = false; // Directly mappable vertex/uniform buffers (wgpu-native extension)
+    
+    // Push constants (wgpu-native extension)
+    bool supportsPushConstants = false;
+    uint32_t maxPushConstantSize = 0;            // Bytes, 0 without support
     
     // Limits
     uint32_t maxTextureSize2D = 0;
@@ -78,11 +97,21 @@ enum class DeviceFeature {
     ShaderF16,
     RG11B10UfloatRenderable,
     BGRA8UnormStorage,
-    Float32Filterable
+    Float32Filterable,
+    MultiDrawIndirect,           // Native extension, multiDraw*Indirect run as one call
+    TextureBindingArray,         // Native extension, binding_array of textures and samplers
+    BufferBindingArray,          // Native extension, binding_array of uniform/storage buffers
+    NonUniformIndexing,          // Native extension, sampled texture and storage buffer arrays indexed per invocation
+    PartiallyBoundBindingArray,  // Native extension, binding arrays may leave slots empty
+    MappablePrimaryBuffers,      // Native extension, MapWrite buffers may also be vertex/index/uniform/storage
+    PushConstants,               // Native extension, var<push_constant> set per draw without a buffer
+    MultiDrawIndirectCount       // Native extension, multiDraw*IndirectCount read the draw count on the GPU
 };
 
 /**
  * @brief Device resource limits
+ *
+ * In a descriptor, 0 leaves a limit unspecified.
  */
 struct DeviceLimits {
     uint32_t maxTextureDimension1D = 0;
@@ -99,7 +128,8 @@ struct DeviceLimits {
     uint32_t maxStorageTexturesPerShaderStage = 0;
     uint32_t maxUniformBuffersPerShaderStage = 0;
     uint32_t maxUniformBufferBindingSize = 0;
-    uint32_t maxStorageBufferBindingSize = 0;
+    uint64_t maxStorageBufferBindingSize = 0;
+    uint64_t maxBufferSize = 0;
     uint32_t maxVertexBuffers = 0;
     uint32_t maxVertexAttributes = 0;
     uint32_t maxVertexBufferArrayStride = 0;
@@ -110,6 +140,7 @@ struct DeviceLimits {
     uint32_t maxComputeWorkgroupSizeY = 0;
     uint32_t maxComputeWorkgroupSizeZ = 0;
     uint32_t maxComputeWorkgroupsPerDimension = 0;
+    uint32_t maxPushConstantSize = 0;  // Native limit, only with DeviceFeature::PushConstants
 };
 
 /**
@@ -125,6 +156,21 @@ struct LogicalDeviceDesc {
     // Optional: If not provided, adapter's default limits will be used
     std::shared_ptr<DeviceLimits> requiredLimits;
     
+    /**
+     * Limit negotiation: request only what the workload needs
+     *
+     * Without negotiation every limit is requested at the adapter maximum and
+     * requiredLimits overrides individual values. With negotiateLimits set,
+     * unspecified limits stay at the WebGPU defaults, requiredLimits must be
+     * supported or creation fails, and preferredLimits are granted up to the
+     * adapter maximum. Read the result back with ILogicalDevice::getLimits().
+     */
+    bool negotiateLimits = false;
+    std::shared_ptr<DeviceLimits> preferredLimits;
+    
+    // Enabled when the adapter supports them, skipped otherwise; see ILogicalDevice::hasFeature()
+    std::vector<DeviceFeature> preferredFeatures;
+    
     // Optional: Timeout for device creation (default: 5 seconds)
     std::chrono::milliseconds timeout = std::chrono::seconds(5);
 };
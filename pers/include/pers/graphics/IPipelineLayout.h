@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IShaderModule.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class IBindGroupLayout;
+
+/**
+ * @brief Byte range of the push constant block visible to some stages
+ * Offset and size are multiples of 4; the end must not exceed DeviceLimits::maxPushConstantSize.
+ * Ranges of different stage sets must not overlap.
+ */
+struct PushConstantRange {
+    ShaderStage stages = ShaderStage::Vertex | ShaderStage::Fragment;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+
+    bool operator==(const PushConstantRange&) const = default;
+};
+
+/**
+ * @brief Pipeline layout description: bind group layouts by group index
+ */
+struct PipelineLayoutDesc {
+    std::vector<std::shared_ptr<IBindGroupLayout>> bindGroupLayouts;
+    // Needs DeviceFeature::PushConstants. Shaders declaring var<push_constant> are not
+    // derivable, so their pipelines must pass a layout with these ranges
+    std::vector<PushConstantRange> pushConstantRanges;
+    std::string debugName;
+};
+
+/**
+ * @brief Pipeline layout interface
+ */
+class IPipelineLayout {
+public:
+    virtual ~IPipelineLayout() = default;
+
+    virtual const PipelineLayoutDesc& getDesc() const = 0;
+
+    /**
+     * @brief Get native pipeline layout handle for backend-specific operations
+     * @return Native pipeline layout handle (WGPUPipelineLayout for WebGPU)
+     */
+    virtual NativePipelineLayoutHandle getNativePipelineLayoutHandle() const = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "pers/graphics/RenderPassTypes.h"
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class ITextureView;
+
+/**
+ * @brief Render pass descriptor translated once and retargeted per frame
+ *
+ * Created by IResourceFactory::createPreparedRenderPass from a RenderPassDesc
+ * whose attachments, load/store ops, clears and queries stay fixed; only the
+ * views change, typically to the current swapchain image:
+ *
+ *     auto pass = factory->createPreparedRenderPass(desc);   // once
+ *     ...
+ *     pass->setColorView(0, swapChain->getCurrentTextureView());  // per frame
+ *     auto encoder = commandEncoder->beginRenderPass(*pass);
+ *
+ * Retargeting swaps the native view handle in place, so beginning the pass
+ * skips descriptor conversion. The object must outlive the passes begun from
+ * it only until ICommandEncoder::beginRenderPass returns.
+ */
+class IPreparedRenderPass {
+public:
+    virtual ~IPreparedRenderPass() = default;
+
+    /**
+     * @brief Descriptor as currently targeted, views included
+     */
+    virtual const RenderPassDesc& getDesc() const = 0;
+
+    /**
+     * @return false if index is out of range or view is null
+     */
+    virtual bool setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) = 0;
+
+    /**
+     * @brief Set or clear (null) the multisample resolve target of a color attachment
+     */
+    virtual bool setResolveTarget(uint32_t index, const std::shared_ptr<ITextureView>& view) = 0;
+
+    virtual bool setClearColor(uint32_t index, const Color& color) = 0;
+
+    /**
+     * @return false if the pass was prepared without a depth stencil attachment or view is null
+     */
+    virtual bool setDepthStencilView(const std::shared_ptr<ITextureView>& view) = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pers/graphics/GraphicsTypes.h"
+
+namespace pers {
+
+/**
+ * @brief Kind of value a query set records
+ */
+enum class QueryType {
+    Occlusion,           // Samples passing depth/stencil, needs no feature
+    Timestamp,           // GPU clock in nanoseconds, needs DeviceFeature::TimestampQuery
+    PipelineStatistics   // Invocation counters, needs DeviceFeature::PipelineStatisticsQuery
+};
+
+/**
+ * @brief Counter recorded by a pipeline statistics query
+ */
+enum class PipelineStatistic {
+    VertexShaderInvocations,
+    ClipperInvocations,
+    ClipperPrimitivesOut,
+    FragmentShaderInvocations,
+    ComputeShaderInvocations
+};
+
+/**
+ * @brief Query set descriptor
+ */
+struct QuerySetDesc {
+    QueryType type = QueryType::Timestamp;
+    uint32_t count = 0;
+    std::string label;
+    
+    // PipelineStatistics only: counters recorded per query, resolved in this order
+    std::vector<PipelineStatistic> pipelineStatistics;
+};
+
+/**
+ * @brief Each resolved value is one 64-bit integer
+ */
+constexpr uint64_t QUERY_RESULT_SIZE = sizeof(uint64_t);
+
+/**
+ * @brief Resolved values per query: one, or one per pipeline statistic
+ */
+inline uint32_t getQueryValueCount(const QuerySetDesc& desc) {
+    return desc.type == QueryType::PipelineStatistics
+         ? static_cast<uint32_t>(desc.pipelineStatistics.size()) : 1u;
+}
+
+/**
+ * @brief Marks a timestamp write slot that is not written
+ */
+constexpr uint32_t QUERY_INDEX_UNUSED = 0xFFFFFFFFu;
+
+class IQuerySet;
+
+/**
+ * @brief Timestamps written when a pass begins and ends
+ */
+struct PassTimestampWrites {
+    std::shared_ptr<IQuerySet> querySet;  // Timestamp query set, null writes nothing
+    uint32_t beginIndex = QUERY_INDEX_UNUSED;
+    uint32_t endIndex = QUERY_INDEX_UNUSED;
+};
+
+/**
+ * @brief Interface for a set of GPU queries
+ * Results are copied into a QueryResolve buffer with
+ * ICommandEncoder::resolveQuerySet.
+ */
+class IQuerySet {
+public:
+    virtual ~IQuerySet() = default;
+    
+    virtual QueryType getType() const = 0;
+    virtual uint32_t getCount() const = 0;
+    
+    /**
+     * @brief Get the descriptor the query set was created from
+     */
+    virtual const QuerySetDesc& getDesc() const = 0;
+    
+    /**
+     * @brief Get native query set handle
+     * @return Native handle to the query set
+     */
+    virtual NativeQuerySetHandle getNativeQuerySetHandle() const = 0;
+    
+    virtual bool isValid() const = 0;
+};
+
+} // namespace pers
@@ -3,7 +3,11 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <functional>
+#include <span>
+#include <cstddef>
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/SubmissionFence.h"
 
 namespace pers {
 
@@ -22,6 +26,37 @@ struct BufferWriteDesc {
     uint64_t size = 0;
 };
 
+/**
+ * @brief Texture write descriptor
+ * 
+ * Describes a region of one mip level and the layout of the source data.
+ * Sizes are in texels; for block-compressed formats origin and extent must
+ * be block aligned (extents may stop short at the mip edge).
+ */
+struct TextureWriteDesc {
+    std::shared_ptr<ITexture> texture;
+    uint32_t mipLevel = 0;
+    
+    // Destination origin; originZ is the depth slice or first array layer
+    uint32_t originX = 0;
+    uint32_t originY = 0;
+    uint32_t originZ = 0;
+    
+    // Region extent, 0 means up to the edge of the mip level
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t depthOrArrayLayers = 0;
+    
+    TextureAspect aspect = TextureAspect::All;
+    
+    // Source data layout
+    const void* data = nullptr;
+    uint64_t dataSize = 0;
+    uint64_t dataOffset = 0;   // Offset of the first texel block in data
+    uint32_t bytesPerRow = 0;  // Bytes between block rows, 0 means tightly packed
+    uint32_t rowsPerImage = 0; // Block rows between images, 0 means the region height
+};
+
 /**
  * @brief Queue interface for GPU command submission
  * 
@@ -32,26 +67,81 @@ class IQueue {
 public:
     virtual ~IQueue() = default;
     
+    /**
+     * @brief Submit command buffers for execution
+     * 
+     * Takes any contiguous range, e.g. a std::array or a frame-scratch span,
+     * so multi-buffer submits need no heap allocation on either side.
+     * 
+     * @param commandBuffers Command buffers to submit, in order
+     * @return Fence for the submission, invalid if submission failed.
+     *         An empty array returns the fence of the previous submission.
+     */
+    virtual SubmissionFence submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) = 0;
+    
+    /**
+     * @brief Submit command buffers by native handle
+     * 
+     * For callers that keep their command buffers in native form. The queue
+     * does not own them: the caller keeps them alive until they reached the
+     * GPU, which inside a submission batch is the flush of that batch.
+     * 
+     * @param commandBuffers Native command buffer handles, in order
+     * @return Fence for the submission, invalid if submission failed
+     */
+    virtual SubmissionFence submit(std::span<const NativeCommandBufferHandle> commandBuffers) = 0;
+    
     /**
      * @brief Submit command buffers for execution
      * @param commandBuffers Array of command buffers to submit
-     * @return true if submission succeeded
+     * @return Fence for the submission, invalid if submission failed.
+     *         An empty array returns the fence of the previous submission.
      */
-    virtual bool submit(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) = 0;
+    SubmissionFence submit(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) {
+        return submit(std::span<const std::shared_ptr<ICommandBuffer>>(commandBuffers));
+    }
     
     /**
      * @brief Submit a single command buffer for execution
      * @param commandBuffer Command buffer to submit
-     * @return true if submission succeeded
+     * @return Fence for the submission, invalid if submission failed
      */
-    virtual bool submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) = 0;
+    virtual SubmissionFence submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) = 0;
     
     /**
      * @brief Submit multiple command buffers as a batch
      * @param commandBuffers Array of command buffers to submit
-     * @return true if submission succeeded
+     * @return Fence for the submission, invalid if submission failed
      */
-    virtual bool submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) = 0;
+    virtual SubmissionFence submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) = 0;
+    
+    /**
+     * @brief Start collecting submits into one native submission per frame
+     * 
+     * Until endSubmissionBatch(), submit() appends command buffers in call
+     * order and returns the fence of the open batch; the batch reaches the
+     * GPU in a single submit at endSubmissionBatch() or flushSubmissions().
+     * Queue writes are not deferred, so they land before every command
+     * buffer of the open batch. Waiting on a fence of the open batch,
+     * waitIdle() and pollSubmittedWork(true) flush it first. Calls nest.
+     */
+    virtual void beginSubmissionBatch() = 0;
+    
+    /**
+     * @brief Leave batching; the outermost call submits the collected command buffers
+     * @return Fence of the batch, or of the previous submission if nothing was collected
+     */
+    virtual SubmissionFence endSubmissionBatch() = 0;
+    
+    /**
+     * @brief Submit the collected command buffers now and keep batching
+     * 
+     * Needed before a queue write that recorded work must not observe, or
+     * before handing a fence to code that only polls it.
+     * 
+     * @return Fence of the flushed batch, or of the previous submission if nothing was collected
+     */
+    virtual SubmissionFence flushSubmissions() = 0;
     
     /**
      * @brief Write data to a buffer
@@ -61,7 +151,34 @@ public:
     virtual bool writeBuffer(const BufferWriteDesc& desc) = 0;
     
     /**
-     * @brief Write data to a texture
+     * @brief Write borrowed caller memory to a buffer
+     * 
+     * The data is copied into the queue's internal staging before this call
+     * returns, so the span only has to outlive the call itself.
+     * 
+     * @param buffer Target buffer
+     * @param offset Offset in buffer, must be 4-byte aligned
+     * @param data Source bytes, size must be a multiple of 4
+     * @return true if write succeeded
+     */
+    virtual bool writeBuffer(const std::shared_ptr<IBuffer>& buffer,
+                             uint64_t offset,
+                             std::span<const std::byte> data) = 0;
+    
+    /**
+     * @brief Write a batch of buffer regions
+     * 
+     * Native handles are resolved once per run of writes targeting the same
+     * buffer, and writes whose source and destination are both contiguous
+     * are merged into one native call.
+     * 
+     * @param writes Write descriptors, each follows writeBuffer(const BufferWriteDesc&) rules
+     * @return true if every write succeeded; invalid entries are skipped
+     */
+    virtual bool writeBuffers(std::span<const BufferWriteDesc> writes) = 0;
+    
+    /**
+     * @brief Write a whole mip level from tightly packed data
      * @param texture Target texture
      * @param data Source data
      * @param dataSize Size of data in bytes
@@ -73,12 +190,41 @@ public:
                              uint64_t dataSize,
                              uint32_t mipLevel = 0) = 0;
     
+    /**
+     * @brief Write a region of a texture
+     * 
+     * Large regions are streamed in row bands through pooled staging buffers
+     * so the backend never needs one staging allocation for the whole image.
+     * 
+     * @param desc Texture write descriptor
+     * @return true if write succeeded
+     */
+    virtual bool writeTexture(const TextureWriteDesc& desc) = 0;
+    
     /**
      * @brief Wait for all submitted work to complete
      * @return true if wait succeeded
      */
     virtual bool waitIdle() = 0;
     
+    /**
+     * @brief Register a callback for completion of all work submitted so far
+     * 
+     * Does not block. The callback may fire on any thread, typically from
+     * within pollSubmittedWork() or a later submit.
+     * 
+     * @param callback Callback to invoke on completion
+     * @return true if the callback was registered
+     */
+    virtual bool onSubmittedWorkDone(QueueWorkDoneCallback callback) = 0;
+    
+    /**
+     * @brief Drive completion callbacks for submitted work
+     * @param wait If true, block until all submitted work has completed
+     * @return true if no submissions are still in flight
+     */
+    virtual bool pollSubmittedWork(bool wait) = 0;
+    
     /**
      * @brief Get native queue handle for backend-specific operations
      * @return Native queue handle (WGPUQueue for WebGPU)
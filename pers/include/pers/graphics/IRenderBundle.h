@@ -0,0 +1,130 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/IShaderModule.h"
+
+namespace pers {
+
+// Forward declarations
+class IRenderPipeline;
+class IBindGroup;
+class IBuffer;
+
+/**
+ * @brief Attachment formats a bundle is compatible with
+ * Must match the render pass the bundle is executed in.
+ */
+struct RenderBundleEncoderDesc {
+    std::vector<TextureFormat> colorFormats;
+    TextureFormat depthStencilFormat = TextureFormat::Undefined;
+    uint32_t sampleCount = 1;
+    bool depthReadOnly = false;
+    bool stencilReadOnly = false;
+    std::string label;
+};
+
+/**
+ * @brief Pre-recorded draw commands replayed with IRenderPassEncoder::executeBundles
+ *
+ * Encoding happens once; executing costs one native call per batch of
+ * bundles no matter how many draws they contain.
+ */
+class IRenderBundle {
+public:
+    virtual ~IRenderBundle() = default;
+    
+    /**
+     * @brief Number of draw calls recorded in the bundle
+     */
+    virtual uint32_t getDrawCount() const = 0;
+    
+    /**
+     * @brief Get native render bundle handle for backend-specific operations
+     * @return Native render bundle handle (WGPURenderBundle for WebGPU)
+     */
+    virtual NativeRenderBundleHandle getNativeRenderBundleHandle() const = 0;
+};
+
+/**
+ * @brief Records draw commands into a reusable render bundle
+ *
+ * Mirrors the draw subset of IRenderPassEncoder. Created by
+ * ILogicalDevice::createRenderBundleEncoder, single use: finish() ends recording.
+ */
+class IRenderBundleEncoder {
+public:
+    virtual ~IRenderBundleEncoder() = default;
+    
+    /**
+     * @brief Set the render pipeline
+     * @param pipeline Render pipeline; async pipelines must be ready when recorded
+     */
+    virtual void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) = 0;
+    
+    /**
+     * @brief Set a bind group
+     * @param index Bind group index
+     * @param bindGroup Bind group to set
+     * @param dynamicOffsets One offset per dynamic-offset binding, in binding order
+     */
+    virtual void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                              std::span<const uint32_t> dynamicOffsets = {}) = 0;
+    
+    /**
+     * @brief Set vertex buffer
+     * @param slot Vertex buffer slot
+     * @param buffer Vertex buffer
+     * @param offset Offset in buffer
+     * @param size Size of data to use, 0 = rest of the buffer
+     */
+    virtual void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                                 uint64_t offset = 0, uint64_t size = 0) = 0;
+    
+    /**
+     * @brief Set index buffer
+     * @param buffer Index buffer
+     * @param indexFormat Format of indices
+     * @param offset Offset in buffer
+     * @param size Size of data to use, 0 = rest of the buffer
+     */
+    virtual void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                                IndexFormat indexFormat,
+                                uint64_t offset = 0, uint64_t size = 0) = 0;
+    
+    /**
+     * @brief Write push constant bytes, as IRenderPassEncoder::setPushConstants
+     */
+    virtual void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) = 0;
+    
+    virtual void draw(uint32_t vertexCount, uint32_t instanceCount = 1,
+                      uint32_t firstVertex = 0, uint32_t firstInstance = 0) = 0;
+    
+    virtual void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1,
+                             uint32_t firstIndex = 0, int32_t baseVertex = 0,
+                             uint32_t firstInstance = 0) = 0;
+    
+    /**
+     * @brief Draw with DrawIndirectArgs read from a GPU buffer at replay time
+     */
+    virtual void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) = 0;
+    
+    /**
+     * @brief Indexed draw with DrawIndexedIndirectArgs read from a GPU buffer at replay time
+     */
+    virtual void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) = 0;
+    
+    /**
+     * @brief End recording
+     * @return The bundle, or nullptr if recording failed
+     */
+    virtual std::shared_ptr<IRenderBundle> finish() = 0;
+};
+
+} // namespace pers
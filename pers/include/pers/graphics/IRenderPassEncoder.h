@@ -1,9 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include "pers/graphics/RenderResourceTable.h"
 
 namespace pers {
 
@@ -11,6 +16,51 @@ namespace pers {
 class IRenderPipeline;
 class IBindGroup;
 class IBuffer;
+class IRenderBundle;
+class IQuerySet;
+
+/**
+ * @brief Argument layout of drawIndirect, as written into an Indirect buffer
+ */
+struct DrawIndirectArgs {
+    uint32_t vertexCount = 0;
+    uint32_t instanceCount = 0;
+    uint32_t firstVertex = 0;
+    uint32_t firstInstance = 0;  // Must be 0 without DeviceFeature::IndirectFirstInstance
+};
+static_assert(sizeof(DrawIndirectArgs) == 16, "DrawIndirectArgs must match the GPU layout");
+
+/**
+ * @brief Argument layout of drawIndexedIndirect, as written into an Indirect buffer
+ */
+struct DrawIndexedIndirectArgs {
+    uint32_t indexCount = 0;
+    uint32_t instanceCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+    uint32_t firstInstance = 0;  // Must be 0 without DeviceFeature::IndirectFirstInstance
+};
+static_assert(sizeof(DrawIndexedIndirectArgs) == 20, "DrawIndexedIndirectArgs must match the GPU layout");
+
+/**
+ * @brief Per-pass counters for state setters
+ * "Elided" calls matched the currently bound state and never reached the backend.
+ */
+struct RenderPassEncoderStats {
+    uint32_t pipelineSets = 0;
+    uint32_t pipelinesElided = 0;
+    uint32_t bindGroupSets = 0;
+    uint32_t bindGroupsElided = 0;
+    uint32_t vertexBufferSets = 0;
+    uint32_t vertexBuffersElided = 0;
+    uint32_t indexBufferSets = 0;
+    uint32_t indexBuffersElided = 0;
+    uint32_t pushConstantSets = 0;
+    uint32_t draws = 0;
+    uint32_t indirectDraws = 0;  // Draw records consumed from indirect buffers
+    uint32_t bundlesExecuted = 0;
+    uint32_t bundleDraws = 0;
+};
 
 /**
  * @brief Render pass encoder interface for recording draw commands
@@ -32,8 +82,10 @@ public:
      * @brief Set a bind group
      * @param index Bind group index
      * @param bindGroup Bind group to set
+     * @param dynamicOffsets One offset per dynamic-offset binding, in binding order
      */
-    virtual void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup) = 0;
+    virtual void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                              std::span<const uint32_t> dynamicOffsets = {}) = 0;
     
     /**
      * @brief Set vertex buffer
@@ -56,6 +108,68 @@ public:
                                IndexFormat indexFormat,
                                uint64_t offset = 0, uint64_t size = 0) = 0;
     
+    /**
+     * @brief Set the render pipeline by handle
+     * Handle setters resolve through RenderPassDesc::resourceTable and behave
+     * like the shared_ptr overloads without RTTI or refcounting per call.
+     * Stale or null handles are skipped with an error.
+     */
+    virtual void setPipeline(PipelineHandle pipeline) = 0;
+    
+    /**
+     * @brief Set a bind group by handle
+     */
+    virtual void setBindGroup(uint32_t index, BindGroupHandle bindGroup,
+                              std::span<const uint32_t> dynamicOffsets = {}) = 0;
+    
+    /**
+     * @brief Set vertex buffer by handle
+     */
+    virtual void setVertexBuffer(uint32_t slot, BufferHandle buffer,
+                                 uint64_t offset = 0, uint64_t size = 0) = 0;
+    
+    /**
+     * @brief Set index buffer by handle
+     */
+    virtual void setIndexBuffer(BufferHandle buffer, IndexFormat indexFormat,
+                                uint64_t offset = 0, uint64_t size = 0) = 0;
+    
+    /**
+     * @brief Set the region later draws map to, in framebuffer pixels
+     * Each pass starts with the full attachment and depth range 0..1.
+     */
+    virtual void setViewport(float x, float y, float width, float height,
+                             float minDepth = 0.0f, float maxDepth = 1.0f) = 0;
+    
+    /**
+     * @brief Discard fragments outside the rectangle, which must lie inside the attachments
+     * Each pass starts with the full attachment.
+     */
+    virtual void setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+    
+    /**
+     * @brief Set the value stencil tests compare against and Replace writes
+     * Each pass starts with 0.
+     */
+    virtual void setStencilReference(uint32_t reference) = 0;
+    
+    /**
+     * @brief Set the color BlendFactor::Constant and OneMinusConstant refer to
+     * Each pass starts with transparent black.
+     */
+    virtual void setBlendConstant(const Color& color) = 0;
+    
+    /**
+     * @brief Write push constant bytes read by following draws
+     * Needs DeviceFeature::PushConstants and a pipeline layout whose
+     * PushConstantRange for exactly these stages covers the bytes. Contents
+     * persist across pipeline changes with a compatible layout.
+     * @param stages Stages of the range being written
+     * @param offset Byte offset in the push constant block, multiple of 4
+     * @param data Bytes to write, size a multiple of 4
+     */
+    virtual void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) = 0;
+    
     /**
      * @brief Draw vertices
      * @param vertexCount Number of vertices to draw
@@ -78,6 +192,84 @@ public:
                            uint32_t firstIndex = 0, int32_t baseVertex = 0,
                            uint32_t firstInstance = 0) = 0;
     
+    /**
+     * @brief Draw with arguments read from a GPU buffer
+     * @param indirectBuffer Buffer created with BufferUsage::Indirect holding DrawIndirectArgs
+     * @param indirectOffset Byte offset of the arguments, multiple of 4
+     */
+    virtual void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) = 0;
+    
+    /**
+     * @brief Indexed draw with arguments read from a GPU buffer
+     * @param indirectBuffer Buffer created with BufferUsage::Indirect holding DrawIndexedIndirectArgs
+     * @param indirectOffset Byte offset of the arguments, multiple of 4
+     */
+    virtual void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) = 0;
+    
+    /**
+     * @brief Issue drawCount consecutive DrawIndirectArgs records
+     * A single native call with DeviceFeature::MultiDrawIndirect, otherwise one drawIndirect per record.
+     */
+    virtual void multiDrawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                   uint64_t indirectOffset, uint32_t drawCount) = 0;
+    
+    /**
+     * @brief Issue drawCount consecutive DrawIndexedIndirectArgs records
+     * A single native call with DeviceFeature::MultiDrawIndirect, otherwise one call per record.
+     */
+    virtual void multiDrawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                          uint64_t indirectOffset, uint32_t drawCount) = 0;
+    
+    /**
+     * @brief Issue up to maxDrawCount DrawIndirectArgs records, the count read from a GPU buffer
+     * A single native call with DeviceFeature::MultiDrawIndirectCount. Without it all
+     * maxDrawCount records are issued, as multiDrawIndirect, so producers must leave
+     * records past the count with instanceCount 0.
+     * @param countBuffer Buffer created with BufferUsage::Indirect holding a uint32_t count
+     * @param countOffset Byte offset of the count, multiple of 4
+     */
+    virtual void multiDrawIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                        const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                        uint32_t maxDrawCount) = 0;
+    
+    /**
+     * @brief Indexed variant of multiDrawIndirectCount over DrawIndexedIndirectArgs records
+     */
+    virtual void multiDrawIndexedIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                               const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                               uint32_t maxDrawCount) = 0;
+    
+    /**
+     * @brief Replay pre-recorded render bundles
+     * Pipeline, bind group and buffer state is reset afterwards, as in WebGPU.
+     * @param bundles Bundles compatible with this pass's attachment formats
+     */
+    virtual void executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) = 0;
+    
+    /**
+     * @brief Start counting samples that pass depth/stencil tests
+     * Queries cannot nest; each index may be used once per pass.
+     * @param queryIndex Index in RenderPassDesc::occlusionQuerySet
+     */
+    virtual void beginOcclusionQuery(uint32_t queryIndex) = 0;
+    
+    /**
+     * @brief End the occlusion query started by beginOcclusionQuery
+     */
+    virtual void endOcclusionQuery() = 0;
+    
+    /**
+     * @brief Start recording pipeline statistics
+     * @param querySet Query set of type PipelineStatistics
+     * @param queryIndex Index in querySet
+     */
+    virtual void beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet, uint32_t queryIndex) = 0;
+    
+    /**
+     * @brief End the pipeline statistics query
+     */
+    virtual void endPipelineStatisticsQuery() = 0;
+    
     /**
      * @brief End the render pass
      */
@@ -88,6 +280,11 @@ public:
      * @return Native render pass encoder handle (WGPURenderPassEncoder for WebGPU)
      */
     virtual NativeRenderPassEncoderHandle getNativeRenderPassEncoderHandle() const = 0;
+    
+    /**
+     * @brief Get state setter counters recorded so far in this pass
+     */
+    virtual RenderPassEncoderStats getStats() const { return {}; }
 };
 
 } // namespace pers
\ No newline at end of file
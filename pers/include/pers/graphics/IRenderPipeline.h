@@ -5,11 +5,14 @@
 #include <vector>
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/utils/DebugLabel.h"
 
 namespace pers {
 
 // Forward declarations
 class IShaderModule;
+class IPipelineLayout;
 
 enum class PrimitiveTopology {
     PointList,
@@ -56,17 +59,80 @@ struct PrimitiveState {
     CullMode cullMode = CullMode::None;
 };
 
+enum class StencilOperation {
+    Keep,
+    Zero,
+    Replace,  // Write the pass's stencil reference
+    Invert,
+    IncrementClamp,
+    DecrementClamp,
+    IncrementWrap,
+    DecrementWrap
+};
+
+/**
+ * @brief Stencil test and update for one facing; the defaults leave stencil untouched
+ */
+struct StencilFaceState {
+    CompareFunction compare = CompareFunction::Always;
+    StencilOperation failOp = StencilOperation::Keep;
+    StencilOperation depthFailOp = StencilOperation::Keep;
+    StencilOperation passOp = StencilOperation::Keep;
+};
+
 struct DepthStencilState {
     TextureFormat format = TextureFormat::Undefined;  // Depth format to use
     bool depthWriteEnabled = false;
     CompareFunction depthCompare = CompareFunction::Less;
+    StencilFaceState stencilFront;
+    StencilFaceState stencilBack;
     uint32_t stencilReadMask = 0xFFFFFFFF;
     uint32_t stencilWriteMask = 0xFFFFFFFF;
 };
 
+enum class BlendOperation {
+    Add,
+    Subtract,
+    ReverseSubtract,
+    Min,
+    Max
+};
+
+enum class BlendFactor {
+    Zero,
+    One,
+    Src,
+    OneMinusSrc,
+    SrcAlpha,
+    OneMinusSrcAlpha,
+    Dst,
+    OneMinusDst,
+    DstAlpha,
+    OneMinusDstAlpha,
+    SrcAlphaSaturated,
+    Constant,
+    OneMinusConstant
+};
+
+/**
+ * @brief result = src * srcFactor (operation) dst * dstFactor; Min and Max ignore the factors
+ */
+struct BlendComponent {
+    BlendOperation operation = BlendOperation::Add;
+    BlendFactor srcFactor = BlendFactor::One;
+    BlendFactor dstFactor = BlendFactor::Zero;
+};
+
+struct BlendState {
+    BlendComponent color;
+    BlendComponent alpha;
+};
+
 struct ColorTargetState {
     TextureFormat format = TextureFormat::BGRA8Unorm;
     ColorWriteMask writeMask = ColorWriteMask::All;
+    bool blendEnabled = false;  // Without it the fragment output replaces the target
+    BlendState blend;
 };
 
 struct MultisampleState {
@@ -76,11 +142,17 @@ struct MultisampleState {
 };
 
 struct RenderPipelineDesc {
-    // Shaders (required)
+    // Shaders (vertex required; fragment may be null for depth-only pipelines,
+    // i.e. no color targets and a depth format)
     std::shared_ptr<IShaderModule> vertex;
     std::shared_ptr<IShaderModule> fragment;
     
-    // Vertex state (optional - can be empty for vertex-less rendering)
+    // Override constants of each stage, part of the pipeline identity
+    std::vector<PipelineConstant> vertexConstants;
+    std::vector<PipelineConstant> fragmentConstants;
+    
+    // Vertex state (optional - empty derives one packed buffer from the vertex shader's @location inputs,
+    // or none for vertex-less rendering)
     std::vector<VertexBufferLayout> vertexLayouts;
     
     // Pipeline states with smart defaults
@@ -89,8 +161,12 @@ struct RenderPipelineDesc {
     MultisampleState multisample;
     std::vector<ColorTargetState> colorTargets;
     
+    // Resource layout (optional - null derives a shared layout from shader reflection,
+    // falling back to the backend's implicit layout when reflection cannot express it)
+    std::shared_ptr<IPipelineLayout> layout;
+    
     // Optional debug name
-    std::string debugName;
+    DebugLabel debugName;
 };
 
 class IRenderPipeline {
@@ -99,6 +175,19 @@ public:
     
     virtual const std::string& getDebugName() const = 0;
     virtual bool isValid() const = 0;
+    
+    /**
+     * @brief Get the descriptor the pipeline was created from
+     * Returned by value because async handles can swap pipelines; vertex is
+     * null while no pipeline is available.
+     */
+    virtual RenderPipelineDesc getDesc() const = 0;
+    
+    /**
+     * @brief Get native pipeline handle for backend-specific operations
+     * @return Native pipeline handle (WGPURenderPipeline for WebGPU)
+     */
+    virtual NativePipelineHandle getNativePipelineHandle() const = 0;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -9,7 +10,14 @@
 #include "pers/graphics/IShaderModule.h"
 #include "pers/graphics/buffers/IBuffer.h"  // Include for BufferDesc
 #include "pers/graphics/IRenderPipeline.h"  // Include for RenderPipelineDesc
+#include "pers/graphics/IComputePipeline.h"  // Include for ComputePipelineDesc
 #include "pers/graphics/ITexture.h"  // Include for TextureDesc
+#include "pers/graphics/IBindGroup.h"  // Include for BindGroupDesc
+#include "pers/graphics/IBindGroupLayout.h"  // Include for BindGroupLayoutDesc
+#include "pers/graphics/IPipelineLayout.h"  // Include for PipelineLayoutDesc
+#include "pers/graphics/IQuerySet.h"  // Include for QuerySetDesc
+#include "pers/graphics/RenderPassTypes.h"  // Include for RenderPassDesc
+#include "pers/utils/DebugLabel.h"
 
 namespace pers {
 
@@ -18,12 +26,14 @@ class ITexture;
 class ITextureView;
 class ISampler;
 class IRenderPipeline;
+class AsyncRenderPipeline;
 class INativeMappableBuffer;
 class IComputePipeline;
 class IBindGroupLayout;
 class IBindGroup;
 class IPipelineLayout;
 class IFramebuffer;
+class IPreparedRenderPass;
 class INativeBuffer;
 class IMappableBuffer;
 
@@ -55,7 +65,16 @@ struct SamplerDesc {
     float lodMaxClamp = 1000.0f;
     CompareFunction compare = CompareFunction::Undefined;
     uint16_t maxAnisotropy = 1;
-    std::string label;
+    DebugLabel label;
+};
+
+/**
+ * @brief One buffer of a createInitializableDeviceBuffers batch
+ */
+struct BufferInitDesc {
+    BufferDesc desc;
+    const void* initialData = nullptr;  // Must stay valid until the batch call returns
+    size_t dataSize = 0;
 };
 
 // ShaderModuleDesc is defined in IShaderModule.h
@@ -65,6 +84,10 @@ struct SamplerDesc {
  * 
  * Factory for creating buffers, textures, shaders, and other GPU resources.
  * All resource creation goes through this interface.
+ *
+ * Every create method may be called concurrently from any number of
+ * threads, e.g. asset loader workers. Implementations take no lock shared by
+ * all calls; their deduplicating caches are sharded.
  */
 class IResourceFactory {
 public:
@@ -89,6 +112,37 @@ public:
         const void* initialData,
         size_t dataSize) const = 0;
     
+    /**
+     * @brief Create many buffers in one call, e.g. during a scene load
+     * @param descs Buffer descriptors
+     * @return One entry per desc, nullptr where creation failed
+     */
+    virtual std::vector<std::shared_ptr<INativeBuffer>> createBuffers(std::span<const BufferDesc> descs) const {
+        std::vector<std::shared_ptr<INativeBuffer>> buffers;
+        buffers.reserve(descs.size());
+        for (const auto& desc : descs) {
+            buffers.push_back(createBuffer(desc));
+        }
+        return buffers;
+    }
+    
+    /**
+     * @brief Create many buffers with initial data in one call
+     * Implementations may pack all data into a single staging upload, so the
+     * contents are on the GPU timeline rather than written at creation
+     * @param buffers Buffer descriptors with their data
+     * @return One entry per desc, nullptr where creation failed
+     */
+    virtual std::vector<std::shared_ptr<INativeBuffer>> createInitializableDeviceBuffers(
+        std::span<const BufferInitDesc> buffers) const {
+        std::vector<std::shared_ptr<INativeBuffer>> created;
+        created.reserve(buffers.size());
+        for (const auto& buffer : buffers) {
+            created.push_back(createInitializableDeviceBuffer(buffer.desc, buffer.initialData, buffer.dataSize));
+        }
+        return created;
+    }
+    
     /**
      * @brief Create a texture
      * @param desc Texture descriptor
@@ -96,6 +150,20 @@ public:
      */
     virtual std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) const = 0;
     
+    /**
+     * @brief Create many textures in one call
+     * @param descs Texture descriptors
+     * @return One entry per desc, nullptr where creation failed
+     */
+    virtual std::vector<std::shared_ptr<ITexture>> createTextures(std::span<const TextureDesc> descs) const {
+        std::vector<std::shared_ptr<ITexture>> textures;
+        textures.reserve(descs.size());
+        for (const auto& desc : descs) {
+            textures.push_back(createTexture(desc));
+        }
+        return textures;
+    }
+    
     /**
      * @brief Create a texture view
      * @param texture Source texture
@@ -126,6 +194,24 @@ public:
      * @return Shared pointer to render pipeline or nullptr if failed
      */
     virtual std::shared_ptr<IRenderPipeline> createRenderPipeline(const RenderPipelineDesc& desc) const = 0;
+    
+    /**
+     * @brief Create a render pipeline without blocking the calling thread
+     * @param desc Render pipeline descriptor
+     * @param fallback Pipeline bound by draws issued before compilation finishes, may be null
+     * @return Handle that becomes ready later, or nullptr if creation could not start
+     */
+    virtual std::shared_ptr<AsyncRenderPipeline> createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        const std::shared_ptr<IRenderPipeline>& fallback = nullptr) const = 0;
+    
+    /**
+     * @brief Create a compute pipeline
+     * @param desc Compute pipeline descriptor
+     * @return Shared pointer to compute pipeline or nullptr if failed
+     */
+    virtual std::shared_ptr<IComputePipeline> createComputePipeline(const ComputePipelineDesc& desc) const = 0;
+    
     /**
      * @brief Create a mappable buffer for CPU-GPU data transfer
      * @param desc Buffer descriptor
@@ -133,6 +219,41 @@ public:
      */
     virtual std::shared_ptr<INativeMappableBuffer> createMappableBuffer(const BufferDesc& desc) const = 0;
     
+    /**
+     * @brief Create a bind group layout
+     * @param desc Bind group layout descriptor
+     * @return Shared pointer to layout or nullptr if failed; identical descs share one layout
+     */
+    virtual std::shared_ptr<IBindGroupLayout> createBindGroupLayout(const BindGroupLayoutDesc& desc) const = 0;
+    
+    /**
+     * @brief Create a bind group
+     * @param desc Bind group descriptor
+     * @return Shared pointer to bind group or nullptr if failed; identical resource sets share one bind group
+     */
+    virtual std::shared_ptr<IBindGroup> createBindGroup(const BindGroupDesc& desc) const = 0;
+    
+    /**
+     * @brief Create a pipeline layout from bind group layouts
+     * @param desc Pipeline layout descriptor
+     * @return Shared pointer to pipeline layout or nullptr if failed
+     */
+    virtual std::shared_ptr<IPipelineLayout> createPipelineLayout(const PipelineLayoutDesc& desc) const = 0;
+    
+    /**
+     * @brief Create a query set
+     * @param desc Query set descriptor
+     * @return Shared pointer to query set, or nullptr if failed or the device lacks the query feature
+     */
+    virtual std::shared_ptr<IQuerySet> createQuerySet(const QuerySetDesc& desc) const = 0;
+    
+    /**
+     * @brief Translate a render pass descriptor once for reuse across frames
+     * @param desc Pass to prepare; color views may be null until set on the result
+     * @return Prepared pass, or nullptr if failed
+     */
+    virtual std::shared_ptr<IPreparedRenderPass> createPreparedRenderPass(const RenderPassDesc& desc) const = 0;
+    
 };
 
 } // namespace pers
\ No newline at end of file
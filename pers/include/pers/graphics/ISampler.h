@@ -0,0 +1,32 @@
+#pragma once
+
+#include "pers/graphics/GraphicsTypes.h"
+
+namespace pers {
+
+struct SamplerDesc;
+
+/**
+ * @brief Interface for texture samplers
+ * Samplers are immutable; the resource factory hands out shared instances
+ * for equal descriptors.
+ */
+class ISampler {
+public:
+    virtual ~ISampler() = default;
+    
+    /**
+     * @brief Get native sampler handle
+     * @return Native handle to the sampler
+     */
+    virtual NativeSamplerHandle getNativeSamplerHandle() const = 0;
+    
+    /**
+     * @brief Get the descriptor the sampler was created from
+     */
+    virtual const SamplerDesc& getDesc() const = 0;
+    
+    virtual bool isValid() const = 0;
+};
+
+} // namespace pers
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
+#include "pers/utils/DebugLabel.h"
 
 namespace pers {
 
+class ShaderReflection;
+
 enum class ShaderStage : uint32_t {
     None = 0,
     Vertex = 1,
@@ -12,11 +17,44 @@ enum class ShaderStage : uint32_t {
     Compute = 4
 };
 
+// Bitwise operators for ShaderStage, used for binding visibility
+inline ShaderStage operator|(ShaderStage a, ShaderStage b) {
+    return static_cast<ShaderStage>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline ShaderStage operator&(ShaderStage a, ShaderStage b) {
+    return static_cast<ShaderStage>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+/**
+ * @brief Value for a WGSL `override` declaration, keyed by its name or numeric @id
+ *
+ * Set per stage in the pipeline descriptor, so variants that differ only in
+ * constants share one shader module. Keys must exist in that stage's module.
+ */
+struct PipelineConstant {
+    std::string key;
+    double value = 0.0;
+
+    bool operator==(const PipelineConstant& other) const = default;
+};
+
+/**
+ * @brief Shader module source
+ *
+ * Modules compile from WGSL `code`, or from `spirv` when it is set, which
+ * skips WGSL parsing and validation at creation. Binaries are cooked offline
+ * by pers_shader_cook. Reflection comes from `reflection` when set, as
+ * shader bundles do, else from `code`; with neither the stage must be given
+ * and pipelines fall back to the backend's implicit layouts.
+ */
 struct ShaderModuleDesc {
     std::string code;
+    std::vector<uint32_t> spirv;            // Precompiled SPIR-V, used instead of code when set
+    std::shared_ptr<const ShaderReflection> reflection;  // Precomputed, skips reflecting code
     ShaderStage stage = ShaderStage::None;  // Auto-detect from code if None
     std::string entryPoint = "main";         // Smart default
-    std::string debugName;                   // Optional
+    DebugLabel debugName;                    // Optional
 };
 
 class IShaderModule {
@@ -27,6 +65,23 @@ public:
     virtual const std::string& getEntryPoint() const = 0;
     virtual const std::string& getDebugName() const = 0;
     virtual bool isValid() const = 0;
+    
+    /**
+     * @brief WGSL source the module was compiled or reflected from
+     * Empty for SPIR-V modules created without their source.
+     */
+    virtual const std::string& getCode() const = 0;
+    
+    /**
+     * @brief SPIR-V the module was compiled from, empty for WGSL modules
+     */
+    virtual const std::vector<uint32_t>& getSpirv() const = 0;
+    
+    /**
+     * @brief Bindings, entry points and vertex inputs read from the source
+     * Invalid if the source could not be parsed.
+     */
+    virtual const ShaderReflection& getReflection() const = 0;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 namespace pers {
 
+class ITexture;
+
 /**
  * @brief Interface for surface framebuffers
  * 
@@ -56,6 +58,16 @@ public:
      */
     virtual bool isReady() const = 0;
     
+    /**
+     * @brief Swap chain image acquired for this frame
+     * @return Texture for copies, nullptr when no image is acquired
+     * 
+     * With MSAA this is the resolve target, so it holds the final image
+     * once the frame's pass has ended. Needs SwapChainDesc::usage to
+     * include CopySrc to be read back.
+     */
+    virtual std::shared_ptr<ITexture> getCurrentTexture() const = 0;
+    
     /**
      * @brief Set an external depth framebuffer
      * @param depthFramebuffer The depth framebuffer to use
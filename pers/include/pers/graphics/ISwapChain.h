@@ -11,6 +11,7 @@
 namespace pers {
 
 // Forward declarations
+class ITexture;
 class ITextureView;
 class IPhysicalDevice;
 
@@ -36,6 +37,16 @@ public:
      */
     virtual std::shared_ptr<ITextureView> getCurrentTextureView() = 0;
     
+    /**
+     * @brief Get the texture behind the current texture view
+     * 
+     * Can be copied into a buffer when SwapChainDesc::usage includes CopySrc
+     * and the surface supports it. Valid until present() like the view.
+     * 
+     * @return Current texture or nullptr if none is acquired
+     */
+    virtual std::shared_ptr<ITexture> getCurrentTexture() const = 0;
+    
     /**
      * @brief Present the current frame to the surface
      * 
@@ -69,6 +80,18 @@ public:
      */
     virtual PresentMode getPresentMode() const = 0;
     
+    /**
+     * @brief Switch the present mode at runtime
+     * 
+     * Reconfigures the surface in place; the device and swap chain object
+     * stay valid. Any acquired texture is released, call
+     * getCurrentTextureView() again afterwards.
+     * 
+     * @param mode Present mode, must be in querySurfaceCapabilities().presentModes
+     * @return true if the surface now uses mode
+     */
+    virtual bool setPresentMode(PresentMode mode) = 0;
+    
     /**
      * @brief Get the texture format
      * @return Current texture format
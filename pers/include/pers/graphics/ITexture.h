@@ -5,6 +5,7 @@
 #include <string>
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/graphics/GraphicsFormats.h"
+#include "pers/utils/DebugLabel.h"
 
 namespace pers {
 
@@ -26,7 +27,7 @@ struct TextureDesc {
     uint32_t sampleCount = 1;
     TextureFormat format = TextureFormat::RGBA8Unorm;
     TextureUsage usage = TextureUsage::None;
-    std::string label;
+    DebugLabel label;
 };
 
 /**
@@ -0,0 +1,221 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IFramebuffer;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroup;
+class IPipelineLayout;
+class ITexture;
+class DeviceBuffer;
+class MipmapGenerator;
+class OffscreenFramebuffer;
+
+/**
+ * @brief Views of one object baked into a grid of frames
+ *
+ * Frame (x, y) shows the object from the direction that the octahedral map
+ * assigns to (x, y) / (framesPerSide - 1). Hemisphere atlases only cover
+ * views from above the horizon, which suits buildings and trees.
+ * Frames are premultiplied: the object over transparent black.
+ */
+struct ImpostorAtlas {
+    std::shared_ptr<ITexture> texture;
+    uint32_t framesPerSide = 0;
+    uint32_t frameSize = 0;                      // Texels per frame side
+    bool hemisphere = true;
+    std::array<float, 3> center{0.0f, 0.0f, 0.0f};  // Bounding sphere in object space
+    float radius = 0.0f;
+};
+
+/**
+ * @brief Renders an object from many directions into an ImpostorAtlas
+ *
+ * Each view is drawn by the application into a frame-sized
+ * OffscreenFramebuffer with an orthographic view-projection that fits the
+ * bounding sphere, then copied into its frame of the atlas. Everything is
+ * recorded into one encoder; the mip chain is generated at the end, so
+ * frames stay usable down to 4 texels per side.
+ *
+ *     ImpostorAtlas atlas;
+ *     baker.bake(*encoder, config, center, radius,
+ *         [&](ICommandEncoder& encoder, const IFramebuffer& target, const ImpostorBaker::View& view) {
+ *             // Clear to transparent black, draw the mesh at its object-space origin with alpha 1
+ *             return drawTree(encoder, target, view.viewProjection);
+ *         }, atlas);
+ *     queue->submit(encoder->finish());
+ *
+ * The baker reuses one framebuffer for every view, so submit the encoder
+ * before baking with a different frame size or format.
+ */
+class ImpostorBaker {
+public:
+    using Vec3 = std::array<float, 3>;
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    struct Config {
+        uint32_t framesPerSide = 8;
+        uint32_t frameSize = 256;    // Power of two
+        bool hemisphere = true;
+        TextureFormat colorFormat = TextureFormat::RGBA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Depth24Plus;
+        bool mipmaps = true;
+        std::string label = "Impostor";
+    };
+
+    struct View {
+        uint32_t index = 0;           // frameY * framesPerSide + frameX
+        uint32_t frameX = 0;
+        uint32_t frameY = 0;
+        Vec3 direction{0.0f, 1.0f, 0.0f};  // From the object towards the viewer
+        Mat4 viewProjection{};  // From object space
+    };
+
+    using RecordFunction = std::function<bool(ICommandEncoder& encoder, const IFramebuffer& target, const View& view)>;
+
+    explicit ImpostorBaker(const std::shared_ptr<ILogicalDevice>& device);
+    ~ImpostorBaker();
+
+    ImpostorBaker(const ImpostorBaker&) = delete;
+    ImpostorBaker& operator=(const ImpostorBaker&) = delete;
+
+    /**
+     * @brief Record every view of the object and the atlas copies
+     * @param center Bounding sphere of the object in object space
+     * @return false if the atlas could not be created or a view failed to record
+     */
+    bool bake(ICommandEncoder& encoder, const Config& config, const Vec3& center, float radius,
+              const RecordFunction& record, ImpostorAtlas& atlas);
+
+    /**
+     * @brief Direction of frame (x, y), the inverse of the runtime's octahedral lookup
+     */
+    static Vec3 getFrameDirection(uint32_t x, uint32_t y, uint32_t framesPerSide, bool hemisphere);
+
+    /**
+     * @brief Orthographic view-projection looking at the sphere from direction
+     * Depth covers the sphere in WebGPU's [0, 1] range.
+     */
+    static Mat4 getViewProjection(const Vec3& direction, const Vec3& center, float radius);
+
+private:
+    std::weak_ptr<ILogicalDevice> _device;
+    std::unique_ptr<OffscreenFramebuffer> _framebuffer;
+    std::unique_ptr<MipmapGenerator> _mipmapGenerator;
+};
+
+/**
+ * @brief Draws distant instances of a baked object as camera-facing quads
+ *
+ * Each instance is one quad; the fragment shader blends the three atlas
+ * frames whose directions surround the view direction in the instance's
+ * object space, so the view turns smoothly as the camera moves. Instances
+ * rotate about y only. Lighting is whatever the bake drew.
+ *
+ * The application picks the LOD per instance and queues the distant ones,
+ * so a far city block costs six vertices per object instead of its mesh:
+ *
+ *     impostors.clear();
+ *     for (const auto& tree : trees) {
+ *         if (impostors.isDistant(tree.position, tree.scale, cameraPosition)) {
+ *             impostors.add(tree.position, tree.scale, tree.yaw);
+ *         } else {
+ *             batcher.add(treePipeline, treeMesh, treeMaterial, &tree.transform);
+ *         }
+ *     }
+ *     ...
+ *     impostors.render(*pass, target, viewProjection, cameraPosition);
+ *
+ * Instances and uniforms reach the GPU through IQueue::writeBuffer, so
+ * render once per submission. Single-sampled targets alpha-test,
+ * multisampled targets fade edges through alpha-to-coverage.
+ */
+class ImpostorRenderer {
+public:
+    using Vec3 = std::array<float, 3>;
+    using Mat4 = std::array<float, 16>;  // Column-major
+
+    struct Config {
+        uint32_t maxInstances = 1 << 16;
+        float switchDistance = 40.0f;  // In bounding radii of the scaled object
+    };
+
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::BGRA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Depth24Plus;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    ImpostorRenderer(const std::shared_ptr<ILogicalDevice>& device, const ImpostorAtlas& atlas);
+    ImpostorRenderer(const std::shared_ptr<ILogicalDevice>& device, const ImpostorAtlas& atlas, const Config& config);
+    ~ImpostorRenderer();
+
+    ImpostorRenderer(const ImpostorRenderer&) = delete;
+    ImpostorRenderer& operator=(const ImpostorRenderer&) = delete;
+
+    bool isValid() const { return _bindGroup != nullptr; }
+
+    /**
+     * @brief Whether an instance is far enough to be drawn as an impostor
+     */
+    bool isDistant(const Vec3& position, float scale, const Vec3& cameraPosition) const;
+
+    /**
+     * @brief Queue an instance, position is its object-space origin in the world
+     * @return false once maxInstances are queued
+     */
+    bool add(const Vec3& position, float scale = 1.0f, float yaw = 0.0f);
+
+    void clear() { _instances.clear(); }
+    uint32_t getInstanceCount() const { return static_cast<uint32_t>(_instances.size()); }
+
+    /**
+     * @brief Draw the queued instances
+     */
+    bool render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                const Vec3& cameraPosition);
+
+private:
+    struct Instance {
+        float position[3];
+        float scale;
+        float yaw;
+        float padding[3];
+    };
+
+    struct PipelineEntry {
+        Target target;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    std::shared_ptr<IRenderPipeline> getPipeline(const Target& target);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    ImpostorAtlas _atlas;
+    Config _config;
+    std::vector<Instance> _instances;
+
+    std::shared_ptr<DeviceBuffer> _viewBuffer;
+    std::shared_ptr<DeviceBuffer> _instanceBuffer;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IPipelineLayout> _layout;
+    std::shared_ptr<IBindGroup> _bindGroup;
+    std::vector<PipelineEntry> _pipelines;
+};
+
+} // namespace pers
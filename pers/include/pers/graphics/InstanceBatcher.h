@@ -0,0 +1,134 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class IBindGroup;
+class IBuffer;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class DynamicBuffer;
+
+/**
+ * @brief Indexed geometry drawn by InstanceBatcher
+ *
+ * Two draws batch together only if every field matches, so LODs or
+ * submeshes of one buffer pair are distinct meshes.
+ */
+struct InstanceMesh {
+    std::shared_ptr<IBuffer> vertexBuffer;
+    std::shared_ptr<IBuffer> indexBuffer;
+    IndexFormat indexFormat = IndexFormat::Uint32;
+    uint32_t vertexSlot = 0;
+    uint32_t indexCount = 0;
+    uint32_t firstIndex = 0;
+    int32_t baseVertex = 0;
+};
+
+/**
+ * @brief Collapses identical-object draws into one instanced drawIndexed per group
+ *
+ * add() files a draw's per-instance data (transform, tint, ...) under its
+ * (pipeline, mesh, material) group. record() sorts groups by pipeline and
+ * material, streams each group's instances into one slice of the per-frame
+ * DynamicBuffer, binds the slice on the instance vertex slot and issues a
+ * single drawIndexed. Pipelines read the data through a VertexStepMode::Instance
+ * layout with arrayStride == instanceStride.
+ *
+ * The instance buffer must have Vertex usage. Call its flush() before
+ * submitting and nextFrame() after, as with any DynamicBuffer.
+ */
+class InstanceBatcher {
+public:
+    struct Stats {
+        uint32_t instances = 0;
+        uint32_t draws = 0;            // Instanced draws issued by the last record()
+        uint32_t droppedInstances = 0; // Instances that did not fit the frame's slice budget
+    };
+
+    /**
+     * @param instanceBuffer Per-frame ring the instance data is streamed into
+     * @param instanceStride Bytes of instance data per draw, multiple of 4
+     * @param instanceSlot Vertex buffer slot of the instance layout
+     * @param materialGroupIndex Bind group index the material is bound to
+     */
+    InstanceBatcher(const std::shared_ptr<DynamicBuffer>& instanceBuffer,
+                    uint32_t instanceStride,
+                    uint32_t instanceSlot = 1,
+                    uint32_t materialGroupIndex = 0);
+    ~InstanceBatcher() = default;
+
+    InstanceBatcher(const InstanceBatcher&) = delete;
+    InstanceBatcher& operator=(const InstanceBatcher&) = delete;
+
+    /**
+     * @brief Queue one instance
+     * @param instanceData instanceStride bytes, copied
+     * @param material Bind group for materialGroupIndex, may be null
+     */
+    void add(const std::shared_ptr<IRenderPipeline>& pipeline,
+             const InstanceMesh& mesh,
+             const std::shared_ptr<IBindGroup>& material,
+             const void* instanceData);
+
+    /**
+     * @brief Stream instance data and record one draw per group
+     * Bind groups other than the material one must already be set.
+     * Queued instances are consumed; groups keep their storage for the next frame.
+     * @return Number of draws recorded
+     */
+    uint32_t record(IRenderPassEncoder& pass);
+
+    /**
+     * @brief Drop queued instances without drawing
+     */
+    void clear();
+
+    Stats getStats() const { return _stats; }
+
+private:
+    struct GroupKey {
+        const IRenderPipeline* pipeline = nullptr;
+        const IBuffer* vertexBuffer = nullptr;
+        const IBuffer* indexBuffer = nullptr;
+        const IBindGroup* material = nullptr;
+        IndexFormat indexFormat = IndexFormat::Uint32;
+        uint32_t vertexSlot = 0;
+        uint32_t indexCount = 0;
+        uint32_t firstIndex = 0;
+        int32_t baseVertex = 0;
+
+        bool operator==(const GroupKey& other) const;
+    };
+
+    struct GroupKeyHash {
+        size_t operator()(const GroupKey& key) const;
+    };
+
+    struct Group {
+        std::shared_ptr<IRenderPipeline> pipeline;
+        InstanceMesh mesh;
+        std::shared_ptr<IBindGroup> material;
+        std::vector<uint8_t> instanceData;
+        uint32_t instanceCount = 0;
+    };
+
+    static GroupKey makeKey(const IRenderPipeline* pipeline, const InstanceMesh& mesh, const IBindGroup* material);
+
+    std::shared_ptr<DynamicBuffer> _instanceBuffer;
+    uint32_t _instanceStride;
+    uint32_t _instanceSlot;
+    uint32_t _materialGroupIndex;
+
+    std::unordered_map<GroupKey, size_t, GroupKeyHash> _groupIndex;
+    std::vector<Group> _groups;
+    std::vector<size_t> _drawOrder;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <memory>
+#include <unordered_map>
+
+namespace pers {
+
+class IResourceFactory;
+class ICommandEncoder;
+class ITexture;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+
+/**
+ * @brief Fills a texture's mip chain on the GPU from its top level
+ *
+ * Each level is one render pass drawing a fullscreen triangle that averages
+ * the 2x2 texels of the level above. Texels are fetched with textureLoad,
+ * so no sampler is involved and unfilterable formats (R32Float) work too.
+ * sRGB formats are averaged in linear space: loads from an sRGB view decode
+ * and writes to an sRGB attachment encode.
+ *
+ * The texture needs TextureBinding and RenderAttachment usage and a
+ * renderable float format (see supportsFormat). Every array layer of a 2D
+ * texture is processed. Pipelines are created per format on first use.
+ *
+ *     queue->writeTexture(topLevel);
+ *     generator.generate(*encoder, texture);
+ *     queue->submit(encoder->finish());
+ */
+class MipmapGenerator {
+public:
+    explicit MipmapGenerator(const std::shared_ptr<IResourceFactory>& factory);
+    ~MipmapGenerator();
+
+    MipmapGenerator(const MipmapGenerator&) = delete;
+    MipmapGenerator& operator=(const MipmapGenerator&) = delete;
+
+    /**
+     * @brief Whether mips of this format can be generated
+     * Integer, snorm, depth and block-compressed formats are not renderable
+     * or not meaningfully averaged.
+     */
+    static bool supportsFormat(TextureFormat format);
+
+    /**
+     * @brief Record passes generating levels baseMipLevel+1 .. last from baseMipLevel
+     * @return false if the texture is unsuitable or a resource failed to create
+     */
+    bool generate(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& texture, uint32_t baseMipLevel = 0);
+
+    bool isValid() const { return _bindGroupLayout != nullptr; }
+
+private:
+    std::shared_ptr<IRenderPipeline> getPipeline(TextureFormat format);
+
+    std::weak_ptr<IResourceFactory> _factory;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::unordered_map<TextureFormat, std::shared_ptr<IRenderPipeline>> _pipelines;
+};
+
+} // namespace pers
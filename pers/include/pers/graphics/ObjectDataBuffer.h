@@ -0,0 +1,124 @@
+#pragma once
+
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/ShadowedDeviceBuffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IBindGroup;
+class IBindGroupLayout;
+class UploadBatcher;
+
+/**
+ * @brief Per-object constants of a whole scene in one storage buffer
+ *
+ * Each object owns a persistent slot of objectSize bytes for its lifetime.
+ * Writes land in the CPU shadow of a ShadowedDeviceBuffer, and upload()
+ * once per frame sends only the granules that changed, so static objects
+ * cost nothing after their first frame and moving objects one coalesced
+ * span each. Nothing is written per draw.
+ *
+ * Shaders index the array with the object id. Drawing with
+ * firstInstance = id makes instance_index the id without a vertex buffer:
+ *
+ *     const uint32_t id = objects.allocate(ObjectConstants{model});
+ *     ...
+ *     objects.update(id, ObjectConstants{newModel});   // When it moves
+ *     objects.upload();                                // Once, before submit
+ *     pass->setBindGroup(1, objects.getBindGroup());
+ *     pass->drawIndexed(indexCount, 1, 0, 0, id);
+ *
+ * getShaderDeclarations() emits the matching binding. Indirect draws need
+ * DeviceFeature::IndirectFirstInstance to carry the id; instanced draws can
+ * add their own per-instance id instead. Slots freed by remove() are reused
+ * by later allocations. Not thread-safe.
+ */
+class ObjectDataBuffer {
+public:
+    static constexpr uint32_t INVALID_INDEX = UINT32_MAX;
+
+    struct Config {
+        uint32_t capacity = 16384;
+        uint32_t objectSize = 256;  // Bytes per record, multiple of 16 (std430 struct stride)
+        ShaderStage visibility = ShaderStage::Vertex | ShaderStage::Fragment;
+        uint64_t granularity = ShadowedDeviceBuffer::DEFAULT_GRANULARITY;
+        std::string debugName = "ObjectData";
+    };
+
+    ObjectDataBuffer(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~ObjectDataBuffer();
+
+    ObjectDataBuffer(const ObjectDataBuffer&) = delete;
+    ObjectDataBuffer& operator=(const ObjectDataBuffer&) = delete;
+
+    bool isValid() const { return _bindGroup != nullptr; }
+
+    /**
+     * @brief Reserve a slot and write its initial data
+     * @param data At most objectSize bytes, the rest of the record is zeroed
+     * @return Object id, INVALID_INDEX if the buffer is full or data is too large
+     */
+    uint32_t allocate(std::span<const std::byte> data = {});
+
+    template<typename T>
+    uint32_t allocate(const T& value) {
+        return allocate(std::as_bytes(std::span<const T>(&value, 1)));
+    }
+
+    /**
+     * @brief Overwrite the start of a record; the rest keeps its contents
+     */
+    bool update(uint32_t id, std::span<const std::byte> data);
+
+    template<typename T>
+    bool update(uint32_t id, const T& value) {
+        return update(id, std::as_bytes(std::span<const T>(&value, 1)));
+    }
+
+    /**
+     * @brief Return the slot to the free list; the record stays until it is reused
+     */
+    void remove(uint32_t id);
+
+    /**
+     * @brief Upload the records changed since the last upload
+     */
+    bool upload();
+    bool upload(UploadBatcher& batcher);
+
+    const std::shared_ptr<IBindGroup>& getBindGroup() const { return _bindGroup; }
+    const std::shared_ptr<IBindGroupLayout>& getBindGroupLayout() const { return _layout; }
+    const ShadowedDeviceBuffer& getBuffer() const { return _buffer; }
+
+    /**
+     * @brief WGSL declaration of the record array
+     * @param group Bind group index the buffer is set at
+     * @param objectType WGSL struct name of one record, declared by the caller
+     */
+    std::string getShaderDeclarations(uint32_t group, const std::string& objectType) const;
+
+    const Config& getConfig() const { return _config; }
+    uint32_t getObjectCount() const { return _objectCount; }
+
+private:
+    bool isLive(uint32_t id) const { return id < _live.size() && _live[id]; }
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    ShadowedDeviceBuffer _buffer;
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::shared_ptr<IBindGroup> _bindGroup;
+
+    std::vector<uint32_t> _freeSlots;
+    std::vector<bool> _live;  // One per slot handed out so far
+    uint32_t _objectCount = 0;
+};
+
+} // namespace pers
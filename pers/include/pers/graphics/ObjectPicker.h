@@ -0,0 +1,138 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class OffscreenFramebuffer;
+class ReadbackRing;
+
+/**
+ * @brief Object ids read back from a region of the ID buffer
+ */
+struct PickResult {
+    uint64_t request = 0;  // As returned by ObjectPicker::pick()
+    uint32_t x = 0;        // Region actually read, clipped to the ID buffer
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t centerX = 0;  // Pixel the pick was aimed at
+    uint32_t centerY = 0;
+    std::vector<uint32_t> ids;  // Row-major, ObjectPicker::NO_OBJECT where nothing was drawn
+
+    uint32_t at(uint32_t px, uint32_t py) const { return ids[(py - y) * width + (px - x)]; }
+
+    /**
+     * @brief Id under the aimed pixel, or else the nearest hit in the region
+     */
+    uint32_t getClosestId() const;
+};
+
+/**
+ * @brief Picking through an R32Uint ID buffer and asynchronous readback
+ *
+ * The editor draws pickable objects into the picker's offscreen target
+ * with pipelines whose fragment shader writes the object id to
+ * `@location(0) u32`, depth tested against the picker's own depth buffer.
+ * pick() then copies only the requested pixels into a ReadbackRing slot,
+ * whose DeferredStagingBuffers map asynchronously; collect() delivers the
+ * ids once the map resolves, typically one or two frames later. The cost
+ * is one ID pass and a copy of at most maxRegionSize^2 texels, whatever the
+ * scene complexity:
+ *
+ *     auto pass = picker.beginPass(*encoder);
+ *     mesh.drawIds(*pass);               // Id pipelines, any number of draws
+ *     pass->end();
+ *     const uint64_t request = picker.pick(encoder, mouseX, mouseY, 2);
+ *     queue->submit(encoder->finish());
+ *     picker.submitted();
+ *     picker.collect([&](const PickResult& result) { select(result.getClosestId()); });
+ *
+ * Id 0 is NO_OBJECT, the clear value. The ID pass may be recorded only on
+ * frames that pick. When every slot is in flight pick() returns 0 and the
+ * request is dropped rather than stalling.
+ */
+class ObjectPicker {
+public:
+    static constexpr uint32_t NO_OBJECT = 0;
+    static constexpr TextureFormat ID_FORMAT = TextureFormat::R32Uint;
+
+    struct Config {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        TextureFormat depthFormat = TextureFormat::Depth32Float;  // Undefined for no depth test
+        uint32_t maxRegionSize = 32;  // Texels per side a single pick may read
+        uint32_t slotCount = 4;
+    };
+
+    using ResultCallback = std::function<void(const PickResult& result)>;
+
+    ObjectPicker(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~ObjectPicker();
+
+    ObjectPicker(const ObjectPicker&) = delete;
+    ObjectPicker& operator=(const ObjectPicker&) = delete;
+
+    bool isValid() const { return _readback != nullptr; }
+
+    /**
+     * @brief Match the viewport; pending picks still resolve against the old contents
+     */
+    bool resize(uint32_t width, uint32_t height);
+
+    /**
+     * @brief Begin the ID pass, cleared to NO_OBJECT and far depth
+     */
+    std::shared_ptr<IRenderPassEncoder> beginPass(ICommandEncoder& encoder);
+
+    /**
+     * @brief Read the square of pixels within radius of (x, y), after the ID pass
+     * @return Request id passed back in PickResult, 0 if the pick was dropped
+     */
+    uint64_t pick(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y, uint32_t radius = 0);
+
+    /**
+     * @brief Read a rectangle, e.g. for marquee selection; clipped to maxRegionSize
+     */
+    uint64_t pickRegion(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y, uint32_t width,
+                        uint32_t height);
+
+    // Must be called after the command buffer passed to pick() is submitted
+    void submitted();
+
+    /**
+     * @brief Deliver finished picks in request order, never blocks
+     * @return Number of results delivered
+     */
+    size_t collect(const ResultCallback& callback);
+
+    const std::shared_ptr<OffscreenFramebuffer>& getFramebuffer() const { return _framebuffer; }
+    uint32_t getPendingCount() const { return static_cast<uint32_t>(_pending.size()); }
+    uint64_t getDroppedCount() const;
+
+private:
+    struct PendingPick {
+        uint64_t ticket = 0;
+        PickResult result;  // Region filled in, ids on arrival
+        uint32_t bytesPerRow = 0;
+    };
+
+    uint64_t enqueue(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y, uint32_t width,
+                     uint32_t height, uint32_t centerX, uint32_t centerY);
+
+    Config _config;
+    std::shared_ptr<OffscreenFramebuffer> _framebuffer;
+    std::unique_ptr<ReadbackRing> _readback;
+    std::deque<PendingPick> _pending;
+    uint64_t _nextRequest = 1;
+};
+
+} // namespace pers
@@ -4,6 +4,7 @@
 #include "pers/graphics/ITexture.h"
 #include "pers/graphics/ITextureView.h"
 #include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/TransientTexturePool.h"
 #include <vector>
 #include <memory>
 
@@ -27,6 +28,8 @@ struct OffscreenFramebufferConfig {
  * 
  * Creates and manages textures for offscreen rendering.
  * Works with any graphics backend through the IResourceFactory interface.
+ * With a texture pool, attachments are drawn from and returned to the pool
+ * on resize and destruction instead of being reallocated.
  */
 class OffscreenFramebuffer final : public IResizableFramebuffer {
 public:
@@ -34,10 +37,12 @@ public:
      * @brief Construct an offscreen framebuffer
      * @param factory Resource factory for creating textures
      * @param config Framebuffer configuration
+     * @param texturePool Pool to share attachments through (optional)
      */
     OffscreenFramebuffer(
         const std::shared_ptr<IResourceFactory>& factory,
-        const OffscreenFramebufferConfig& config);
+        const OffscreenFramebufferConfig& config,
+        const std::shared_ptr<TransientTexturePool>& texturePool = nullptr);
     
     ~OffscreenFramebuffer() override;
     
@@ -55,12 +60,21 @@ public:
     // IResizableFramebuffer interface
     bool resize(uint32_t width, uint32_t height) override;
     
+    /**
+     * @brief Texture behind a color attachment, for copies and readback
+     */
+    std::shared_ptr<ITexture> getColorTexture(uint32_t index = 0) const;
+    
+    const OffscreenFramebufferConfig& getConfig() const { return _config; }
+    
 private:
     void createTextures();
     void releaseTextures();
+    PooledTexture acquireTexture(const TextureDesc& desc, const std::string& viewLabel);
     
 private:
     std::shared_ptr<IResourceFactory> _factory;
+    std::shared_ptr<TransientTexturePool> _texturePool;
     OffscreenFramebufferConfig _config;
     
     std::vector<std::shared_ptr<ITexture>> _colorTextures;
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/buffers/MappedData.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IFramebuffer;
+class OffscreenFramebuffer;
+class DeferredStagingBuffer;
+class TransientTexturePool;
+
+/**
+ * @brief Target of one offscreen render job
+ */
+struct OffscreenRenderJobDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat colorFormat = TextureFormat::RGBA8Unorm;
+    TextureFormat depthFormat = TextureFormat::Undefined;
+    std::string label;
+};
+
+/**
+ * @brief Pixels of a finished job, valid only during the completion callback
+ * Rows are bytesPerRow apart (256-byte aligned), not tightly packed.
+ */
+struct OffscreenImage {
+    uint64_t jobId = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::Undefined;
+    uint32_t bytesPerRow = 0;
+    const void* data = nullptr;
+    uint64_t size = 0;
+};
+
+/**
+ * @brief Renders jobs into offscreen framebuffers and reads them back, pipelined
+ *
+ * Needs no surface or window, for batch rendering on headless machines.
+ * Each job records into its own framebuffer, the color attachment is copied
+ * into a readback buffer in the same submission, and the map completes on
+ * the device's event pump while later jobs are already being recorded.
+ * Up to maxInFlight jobs are in flight; submit() waits for a slot beyond that.
+ *
+ * Completion callbacks run on the calling thread from poll(), submit() or
+ * waitIdle(). Slots keep their framebuffer and readback buffer between jobs
+ * of the same size and formats.
+ *
+ *     OffscreenRenderQueue queue(device);
+ *     for (const auto& item : items) {
+ *         queue.submit(desc, record(item), [](const OffscreenImage& image) { save(image); });
+ *     }
+ *     queue.waitIdle();
+ */
+class OffscreenRenderQueue {
+public:
+    using RecordFunction = std::function<bool(ICommandEncoder& encoder, const IFramebuffer& target)>;
+    using CompletionFunction = std::function<void(const OffscreenImage& image)>;
+
+    static constexpr uint32_t DEFAULT_MAX_IN_FLIGHT = 4;
+    static constexpr std::chrono::milliseconds DEFAULT_WAIT_TIMEOUT{5000};
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        uint64_t stalls = 0;  // submit() calls that had to wait for a free slot
+    };
+
+    /**
+     * @param device Device to render on
+     * @param maxInFlight Jobs allowed between submit and completion
+     * @param texturePool Pool the framebuffers draw their attachments from (optional)
+     */
+    explicit OffscreenRenderQueue(const std::shared_ptr<ILogicalDevice>& device,
+                                  uint32_t maxInFlight = DEFAULT_MAX_IN_FLIGHT,
+                                  const std::shared_ptr<TransientTexturePool>& texturePool = nullptr);
+    ~OffscreenRenderQueue();
+
+    OffscreenRenderQueue(const OffscreenRenderQueue&) = delete;
+    OffscreenRenderQueue& operator=(const OffscreenRenderQueue&) = delete;
+
+    /**
+     * @brief Record, submit and start reading back one job
+     * @param record Encodes the job's passes into the target; return false to abort
+     * @param onComplete Receives the pixels, or is never called if the job fails
+     * @return Job id, 0 if the job could not be submitted
+     */
+    uint64_t submit(const OffscreenRenderJobDesc& desc, const RecordFunction& record, CompletionFunction onComplete);
+
+    /**
+     * @brief Deliver finished jobs without blocking
+     * @return Number of completion callbacks invoked
+     */
+    size_t poll();
+
+    /**
+     * @brief Wait for and deliver every job in flight
+     * @return false if the wait timed out
+     */
+    bool waitIdle(std::chrono::milliseconds timeout = DEFAULT_WAIT_TIMEOUT);
+
+    uint32_t getInFlightCount() const;
+    uint32_t getMaxInFlight() const { return static_cast<uint32_t>(_slots.size()); }
+    Stats getStats() const { return _stats; }
+
+private:
+    enum class SlotState : uint32_t {
+        Free,
+        MapPending,
+        Ready,
+        Failed
+    };
+
+    // Map callbacks fire on the event pump; they reach the slot and the
+    // signal through shared ownership so a late completion is harmless
+    struct Signal {
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+
+    struct Slot {
+        std::shared_ptr<OffscreenFramebuffer> framebuffer;
+        std::shared_ptr<DeferredStagingBuffer> readback;
+        std::atomic<SlotState> state{SlotState::Free};
+        uint64_t jobId = 0;
+        OffscreenRenderJobDesc desc;
+        uint32_t bytesPerRow = 0;
+        uint64_t readbackSize = 0;
+        CompletionFunction onComplete;
+        MappedData mapping{nullptr, 0, nullptr};
+    };
+
+    std::shared_ptr<Slot> acquireSlot();
+    bool prepareSlot(Slot& slot, const OffscreenRenderJobDesc& desc);
+    bool waitForSlot(std::chrono::milliseconds timeout, bool all);
+    void recycle(Slot& slot);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::shared_ptr<TransientTexturePool> _texturePool;
+    std::vector<std::shared_ptr<Slot>> _slots;
+    std::shared_ptr<Signal> _signal;
+    uint64_t _nextJobId = 0;
+    Stats _stats;
+};
+
+} // namespace pers
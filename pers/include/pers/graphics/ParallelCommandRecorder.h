@@ -0,0 +1,90 @@
+#pragma once
+
+#include "pers/graphics/IRenderBundle.h"
+#include "pers/graphics/SubmissionFence.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ICommandBuffer;
+
+/**
+ * @brief Records command encoders or render bundles on a pool of worker threads
+ *
+ * Each job gets an encoder of its own, so jobs never share recording state.
+ * Results come back indexed by job, independent of which worker ran what,
+ * and recordAndSubmit() hands them to the queue in one submit call.
+ *
+ * The calling thread works through jobs too. One batch runs at a time;
+ * calls from several threads are serialized.
+ */
+class ParallelCommandRecorder {
+public:
+    using EncoderJob = std::function<void(ICommandEncoder& encoder, uint32_t jobIndex)>;
+    using BundleJob = std::function<void(IRenderBundleEncoder& encoder, uint32_t jobIndex)>;
+
+    /**
+     * @param device Device encoders are created from
+     * @param workerCount Worker threads besides the caller, 0 = hardware concurrency - 1
+     */
+    explicit ParallelCommandRecorder(const std::shared_ptr<ILogicalDevice>& device, uint32_t workerCount = 0);
+    ~ParallelCommandRecorder();
+
+    ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+    /**
+     * @brief Run each job on its own command encoder
+     * @return One command buffer per job in job order; null where encoding failed
+     */
+    std::vector<std::shared_ptr<ICommandBuffer>> record(std::span<const EncoderJob> jobs);
+
+    /**
+     * @brief Record and submit all jobs' command buffers in job order
+     * @return Fence of the submission, invalid if any job failed to encode
+     */
+    SubmissionFence recordAndSubmit(std::span<const EncoderJob> jobs);
+
+    /**
+     * @brief Run each job on its own render bundle encoder
+     * @param desc Attachment formats shared by all bundles
+     * @return One bundle per job in job order; null where recording failed
+     */
+    std::vector<std::shared_ptr<IRenderBundle>> recordBundles(const RenderBundleEncoderDesc& desc,
+                                                              std::span<const BundleJob> jobs);
+
+    uint32_t getWorkerCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+    // Run task(i) for i in [0, count) across workers and the caller
+    void runParallel(uint32_t count, const std::function<void(uint32_t)>& task);
+    void drainBatch(const std::function<void(uint32_t)>& task, uint32_t count);
+    void workerLoop();
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::vector<std::thread> _workers;
+
+    std::mutex _batchMutex;  // Serializes runParallel callers
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const std::function<void(uint32_t)>* _task = nullptr;
+    uint32_t _taskCount = 0;
+    uint64_t _batchId = 0;
+    uint32_t _activeWorkers = 0;
+    std::atomic<uint32_t> _nextIndex{0};
+    bool _stopping = false;
+};
+
+} // namespace pers
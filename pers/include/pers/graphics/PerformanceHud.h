@@ -0,0 +1,132 @@
+#pragma once
+
+#include "pers/graphics/DebugDraw.h"
+#include "pers/graphics/GpuPassTimer.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace pers {
+
+class ILogicalDevice;
+class IRenderPassEncoder;
+class MetricCounter;
+class PipelineCache;
+class BindGroupCache;
+class SamplerCache;
+
+/**
+ * @brief CPU side of one frame as Application reports it to the HUD
+ */
+struct PerformanceHudFrame {
+    double frameMs = 0.0;       // Main loop time of the frame
+    double cpuMs = 0.0;         // FramePacer CPU time, smoothed
+    double gpuLatencyMs = 0.0;  // FramePacer submit to completion, smoothed
+};
+
+/**
+ * @brief Live performance overlay drawn with its own DebugDraw
+ *
+ * Shows frame and GPU time graphs over the last HISTORY_SIZE frames, the
+ * most recent GpuPassTimer report per pass, draws, submits and upload bytes
+ * per frame from the engine Metrics counters, GpuMemoryTracker usage against
+ * its budget, and hit rates of the caches handed to setCaches().
+ *
+ *     hud.addFrame(frame);                  // Once per frame, any thread
+ *     hud.setGpuTiming(timer.getLastReport());
+ *     hud.render(*pass, target, width, height);
+ *     pass->end();
+ *     hud.flush();                          // before queue submit
+ *     queue->submit(encoder->finish());
+ *     hud.nextFrame();                      // after queue submit
+ *
+ * Application owns one when enablePerformanceHud() was called and feeds it
+ * every frame; onRender() only records it. Everything is screen-space and
+ * drawn without depth testing into the last pass of the frame.
+ */
+class PerformanceHud {
+public:
+    static constexpr size_t HISTORY_SIZE = 120;
+
+    struct Config {
+        float x = 8.0f;              // Top-left corner in pixels
+        float y = 8.0f;
+        float graphWidth = 240.0f;
+        float graphHeight = 60.0f;
+        double graphRangeMs = 33.3;  // Frame time at the top of the graphs
+        float textScale = 2.0f;
+    };
+
+    PerformanceHud(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~PerformanceHud() = default;
+
+    PerformanceHud(const PerformanceHud&) = delete;
+    PerformanceHud& operator=(const PerformanceHud&) = delete;
+
+    bool isValid() const { return _debugDraw.isValid(); }
+
+    /**
+     * @brief Record one frame's CPU times and sample the engine counters
+     */
+    void addFrame(const PerformanceHudFrame& frame);
+
+    /**
+     * @brief Latest per-pass GPU timings, typically GpuPassTimer::getLastReport()
+     */
+    void setGpuTiming(const GpuFrameTiming& timing);
+
+    /**
+     * @brief Caches whose hit rates are shown, any may be null
+     */
+    void setCaches(const PipelineCache* pipelines, const BindGroupCache* bindGroups, const SamplerCache* samplers);
+
+    /**
+     * @brief Lay out the overlay and record its draws into an open pass
+     * @return Number of draws recorded
+     */
+    uint32_t render(IRenderPassEncoder& pass, const DebugDraw::Target& target,
+                    uint32_t viewportWidth, uint32_t viewportHeight);
+
+    bool flush() { return _debugDraw.flush(); }
+    void nextFrame() { _debugDraw.nextFrame(); }
+
+private:
+    struct FrameRecord {
+        double frameMs = 0.0;
+        double gpuMs = 0.0;  // GpuPassTimer total, 0 until a report arrived
+    };
+
+    struct CounterSample {
+        int64_t draws = 0;
+        int64_t submits = 0;
+        int64_t uploadBytes = 0;
+    };
+
+    void graph(float x, float y, size_t count, size_t newest, bool gpu, uint32_t color);
+
+    DebugDraw _debugDraw;
+    Config _config;
+
+    MetricCounter& _drawCounter;
+    MetricCounter& _submitCounter;
+    MetricCounter& _writeBytesCounter;
+    MetricCounter& _stagingBytesCounter;
+
+    // Written by addFrame() on the main thread, read by render() on the render thread
+    mutable std::mutex _mutex;
+    std::array<FrameRecord, HISTORY_SIZE> _history{};
+    size_t _historyCount = 0;
+    size_t _historyIndex = 0;  // Next slot to write
+    PerformanceHudFrame _lastFrame;
+    CounterSample _counterTotals;
+    CounterSample _lastCounters;  // Per frame, difference of the totals
+    GpuFrameTiming _gpuTiming;
+
+    const PipelineCache* _pipelineCache = nullptr;
+    const BindGroupCache* _bindGroupCache = nullptr;
+    const SamplerCache* _samplerCache = nullptr;
+};
+
+} // namespace pers
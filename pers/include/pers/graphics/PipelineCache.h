@@ -0,0 +1,95 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/utils/ConcurrentLookupTable.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Deduplicates render pipelines by their creation state
+ *
+ * Pipelines are keyed by a hash over everything that affects compilation:
+ * shader module identity, vertex layouts, primitive, depth-stencil and
+ * multisample state, and color targets. debugName is ignored. Hash
+ * collisions are resolved with a full comparison, so two descs only share
+ * a pipeline when they are equivalent.
+ *
+ * Cached entries keep their shader modules alive, which keeps pointer
+ * identity stable for the lifetime of the entry.
+ *
+ * Thread-safe. Entries live in a ConcurrentLookupTable, so hits take no
+ * lock and any number of encoding threads can resolve pipelines per draw;
+ * only inserts and clear serialize. Statistics are atomic counters.
+ */
+class PipelineCache {
+public:
+    using CreateFunction = std::function<std::shared_ptr<IRenderPipeline>(const RenderPipelineDesc&)>;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t entries = 0;
+    };
+
+    PipelineCache() = default;
+    ~PipelineCache() = default;
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    /**
+     * @brief Return the cached pipeline for desc, creating it on a miss
+     * @param desc Pipeline description
+     * @param create Called without the cache lock held when no entry matches
+     * @return Cached or newly created pipeline, nullptr if creation failed
+     */
+    std::shared_ptr<IRenderPipeline> getOrCreate(const RenderPipelineDesc& desc, const CreateFunction& create);
+
+    /**
+     * @brief Find a cached pipeline without creating one
+     * @return Cached pipeline or nullptr (counted as a hit or a miss)
+     */
+    std::shared_ptr<IRenderPipeline> lookup(const RenderPipelineDesc& desc);
+
+    /**
+     * @brief Add a pipeline compiled outside the cache, e.g. asynchronously
+     * @return The pipeline now cached for desc; an existing entry wins
+     */
+    std::shared_ptr<IRenderPipeline> insert(const RenderPipelineDesc& desc, const std::shared_ptr<IRenderPipeline>& pipeline);
+
+    /**
+     * @brief Drop all cached pipelines
+     */
+    void clear();
+
+    Stats getStats() const;
+
+    /**
+     * @brief Stable hash over the pipeline-relevant parts of desc
+     */
+    static uint64_t computeHash(const RenderPipelineDesc& desc);
+
+    /**
+     * @brief Full equivalence check, ignoring debugName
+     */
+    static bool isEquivalent(const RenderPipelineDesc& a, const RenderPipelineDesc& b);
+
+private:
+    struct Entry {
+        RenderPipelineDesc desc;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    std::shared_ptr<IRenderPipeline> find(uint64_t hash, const RenderPipelineDesc& desc) const;
+
+    ConcurrentLookupTable<Entry, MemoryTag::Caches> _entries;
+    std::atomic<size_t> _entryCount{0};
+    std::atomic<uint64_t> _hits{0};
+    std::atomic<uint64_t> _misses{0};
+};
+
+} // namespace pers
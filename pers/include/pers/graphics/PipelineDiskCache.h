@@ -0,0 +1,108 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace pers {
+
+class IResourceFactory;
+
+/**
+ * @brief Disk-backed pre-warm list of shader modules and render pipelines
+ *
+ * Shaders and pipelines created through this cache are recorded, keyed by a
+ * hash of the WGSL source, stage and entry point. save() writes the records
+ * together with a fingerprint of the adapter (vendor, device, architecture,
+ * ids and driver description). On the next launch load() rejects the file if
+ * the fingerprint differs, and prewarm() recreates every recorded module and
+ * pipeline up front, so the first frames do not hit shader compilation.
+ *
+ * Prewarmed pipelines land in the resource factory's PipelineCache. Requests
+ * made later through createShaderModule() return the prewarmed module for the
+ * same source, so matching pipeline requests resolve to cache hits.
+ *
+ * wgpu-native exposes no pipeline binary cache, so compilation still happens
+ * once per launch; it is just moved to load time.
+ */
+class PipelineDiskCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 6;
+
+    /**
+     * @param path File the cache is loaded from and saved to
+     * @param capabilities Adapter capabilities used for the fingerprint
+     */
+    PipelineDiskCache(const std::string& path, const PhysicalDeviceCapabilities& capabilities);
+    ~PipelineDiskCache() = default;
+
+    PipelineDiskCache(const PipelineDiskCache&) = delete;
+    PipelineDiskCache& operator=(const PipelineDiskCache&) = delete;
+
+    /**
+     * @brief Read records from disk
+     * @return false if the file is missing, corrupt or from another adapter/driver
+     */
+    bool load();
+
+    /**
+     * @brief Write all records to disk
+     */
+    bool save() const;
+
+    /**
+     * @brief Create every loaded shader module and pipeline
+     * @return Number of pipelines created
+     */
+    size_t prewarm(const std::shared_ptr<IResourceFactory>& factory);
+
+    /**
+     * @brief Create a shader module, reusing a prewarmed one with the same source
+     */
+    std::shared_ptr<IShaderModule> createShaderModule(const std::shared_ptr<IResourceFactory>& factory,
+                                                      const ShaderModuleDesc& desc);
+
+    /**
+     * @brief Create a render pipeline and record it for the next launch
+     * Only pipelines whose shaders came from createShaderModule() are recorded.
+     */
+    std::shared_ptr<IRenderPipeline> createRenderPipeline(const std::shared_ptr<IResourceFactory>& factory,
+                                                          const RenderPipelineDesc& desc);
+
+    size_t getShaderCount() const;
+    size_t getPipelineCount() const;
+    const std::string& getFingerprint() const { return _fingerprint; }
+
+    static std::string makeDeviceFingerprint(const PhysicalDeviceCapabilities& capabilities);
+    static uint64_t computeShaderKey(const ShaderModuleDesc& desc);
+
+private:
+    struct PipelineRecord {
+        uint64_t vertexKey = 0;
+        uint64_t fragmentKey = 0;
+        RenderPipelineDesc desc;  // Shader pointers are left empty
+    };
+
+    static uint64_t computePipelineKey(const PipelineRecord& record);
+    bool recordPipeline(const RenderPipelineDesc& desc);
+
+    std::string _path;
+    std::string _fingerprint;
+
+    mutable Mutex<false> _mutex;
+    std::map<uint64_t, ShaderModuleDesc> _shaders;  // Ordered for deterministic output
+    std::unordered_map<uint64_t, std::shared_ptr<IShaderModule>> _modules;
+    std::unordered_map<const IShaderModule*, uint64_t> _moduleKeys;
+    std::vector<PipelineRecord> _pipelines;
+    std::unordered_set<uint64_t> _pipelineKeys;
+};
+
+} // namespace pers
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IComputePipeline;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class ISampler;
+class ITexture;
+class ITextureView;
+class DeviceBuffer;
+class TransientTexturePool;
+
+enum class Tonemapper : uint32_t {
+    Clamp,
+    Reinhard,
+    Aces  // Narkowicz's fit of the ACES filmic curve
+};
+
+struct PostProcessSettings {
+    // Bloom, thresholded in scene units before exposure
+    bool bloom = true;
+    float bloomThreshold = 1.0f;
+    float bloomKnee = 0.5f;       // Soft threshold width
+    float bloomIntensity = 0.5f;
+    float bloomRadius = 1.0f;     // Upsample tent radius in texels
+    uint32_t bloomLevels = 6;     // Half-resolution downsample levels
+
+    float exposure = 1.0f;        // Multiplies the exposure buffer's value when one is set
+    Tonemapper tonemapper = Tonemapper::Aces;
+
+    // Grading of the tonemapped, display-referred color
+    std::array<float, 3> lift{0.0f, 0.0f, 0.0f};
+    std::array<float, 3> gamma{1.0f, 1.0f, 1.0f};
+    std::array<float, 3> gain{1.0f, 1.0f, 1.0f};
+    float contrast = 1.0f;
+    float saturation = 1.0f;
+
+    bool fxaa = true;
+};
+
+/**
+ * @brief Bloom, tonemapping, color grading and FXAA in two passes
+ *
+ * One compute pass runs the bloom chain and then a single fused dispatch
+ * that adds bloom, applies exposure, tonemapping and grading, encodes to
+ * sRGB and stores luma for FXAA. The threshold is folded into the first
+ * downsample and each upsample adds its level in the same dispatch, so
+ * the chain costs 2 * bloomLevels dispatches and no render passes. A
+ * fullscreen render pass then applies FXAA while writing the destination,
+ * which may be any renderable color format, the swap chain included:
+ *
+ *     post.execute(*encoder, hdrView, swapChainView, settings);
+ *
+ * Bloom levels and the LDR intermediate are acquired from the
+ * TransientTexturePool and released once recorded, so later passes of the
+ * frame and the next frame reuse them. Settings reach the GPU through
+ * IQueue::writeBuffer, so call execute() once per submission. With
+ * setExposureBuffer() the composite also scales by an AutoExposureState
+ * read straight from the GPU, so adapted exposure needs no readback.
+ *
+ * The scene view must be a single-sampled float 2D texture with
+ * TextureBinding usage and the same size as the destination.
+ */
+class PostProcessChain {
+public:
+    static constexpr uint32_t WORKGROUP_SIZE = 8;  // 8x8 texels per workgroup
+
+    PostProcessChain(const std::shared_ptr<ILogicalDevice>& device,
+                     const std::shared_ptr<TransientTexturePool>& texturePool = nullptr);
+    ~PostProcessChain();
+
+    PostProcessChain(const PostProcessChain&) = delete;
+    PostProcessChain& operator=(const PostProcessChain&) = delete;
+
+    bool isValid() const { return _compositePipeline != nullptr; }
+
+    /**
+     * @brief Record the post stack from sceneView into destination
+     * @return false if a view is unusable or a resource failed to create
+     */
+    bool execute(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& sceneView,
+                 const std::shared_ptr<ITextureView>& destination, const PostProcessSettings& settings);
+
+    /**
+     * @brief Storage buffer holding an AutoExposureState, e.g. AutoExposure::getExposureBuffer()
+     * Null restores the fixed PostProcessSettings::exposure.
+     */
+    void setExposureBuffer(const std::shared_ptr<DeviceBuffer>& buffer);
+
+    /**
+     * @brief Dispatches recorded by the last execute(), for profiling
+     */
+    uint32_t getDispatchCount() const { return _dispatchCount; }
+
+private:
+    struct LevelViews {
+        std::weak_ptr<ITexture> texture;
+        std::vector<std::shared_ptr<ITextureView>> views;
+        bool used = false;
+    };
+
+    const std::vector<std::shared_ptr<ITextureView>>& getLevelViews(const std::shared_ptr<ITexture>& texture,
+                                                                    uint32_t mipCount);
+    std::shared_ptr<IRenderPipeline> getOutputPipeline(TextureFormat format);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::shared_ptr<TransientTexturePool> _texturePool;
+    std::shared_ptr<DeviceBuffer> _settingsBuffer;
+    std::shared_ptr<DeviceBuffer> _exposureBuffer;
+    std::shared_ptr<DeviceBuffer> _neutralExposureBuffer;
+    std::shared_ptr<ISampler> _sampler;
+
+    std::shared_ptr<IBindGroupLayout> _bloomLayout;
+    std::shared_ptr<IBindGroupLayout> _compositeLayout;
+    std::shared_ptr<IBindGroupLayout> _outputLayout;
+    std::shared_ptr<IComputePipeline> _prefilterPipeline;
+    std::shared_ptr<IComputePipeline> _downsamplePipeline;
+    std::shared_ptr<IComputePipeline> _upsamplePipeline;
+    std::shared_ptr<IComputePipeline> _compositePipeline;
+
+    std::shared_ptr<IShaderModule> _outputVertexShader;
+    std::shared_ptr<IShaderModule> _outputFragmentShader;
+    std::shared_ptr<IPipelineLayout> _outputPipelineLayout;
+    std::unordered_map<TextureFormat, std::shared_ptr<IRenderPipeline>> _outputPipelines;
+
+    std::vector<LevelViews> _levelViews;  // Mip views of pooled bloom textures seen last frame
+    uint32_t _dispatchCount = 0;
+};
+
+} // namespace pers
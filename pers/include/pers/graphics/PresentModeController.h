@@ -0,0 +1,95 @@
+#pragma once
+
+#include "pers/graphics/SwapChainTypes.h"
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ISwapChain;
+
+/**
+ * @brief Latency-vs-tearing trade-off applied while the application is interactive
+ */
+enum class LatencyPolicy {
+    PowerSaving,  // Always Fifo
+    Balanced,     // Fifo while frames fit the interval, tear-free fast mode when they overrun
+    LowLatency    // Mailbox, or Immediate (tearing) where Mailbox is missing
+};
+
+/**
+ * @brief Switches a swap chain's present mode from measured frame times
+ *
+ * Call recordFrame() once per presented frame. Idle mode always drops to
+ * Fifo for power. Interactive mode follows the policy; Balanced leaves Fifo
+ * only when the smoothed frame time exceeds the target interval, where
+ * vsync would halve the rate, and returns once it fits again.
+ *
+ * Switches reconfigure the surface, which costs a hitch, so a new mode must
+ * be wanted for switchHoldFrames consecutive frames before it is applied.
+ * Modes the surface lacks are skipped in favour of the next preference.
+ */
+class PresentModeController {
+public:
+    struct Config {
+        LatencyPolicy policy = LatencyPolicy::Balanced;
+        std::chrono::microseconds targetFrameInterval{16667};  // Display refresh interval
+        uint32_t switchHoldFrames = 30;
+        double smoothing = 0.1;  // Exponential moving average weight of the newest frame
+    };
+
+    struct Stats {
+        PresentMode currentMode = PresentMode::Fifo;
+        double averageFrameTimeMs = 0.0;
+        uint32_t switches = 0;
+    };
+
+    PresentModeController(const std::shared_ptr<ISwapChain>& swapChain, const Config& config);
+    explicit PresentModeController(const std::shared_ptr<ISwapChain>& swapChain);
+
+    void setPolicy(LatencyPolicy policy);
+    LatencyPolicy getPolicy() const { return _config.policy; }
+
+    /**
+     * @brief Interactive follows the policy, idle presents with Fifo
+     */
+    void setInteractive(bool interactive);
+    bool isInteractive() const { return _interactive; }
+
+    /**
+     * @brief Feed the CPU time of the last frame and apply a pending switch
+     * Call between present() and the next getCurrentTextureView().
+     */
+    void recordFrame(std::chrono::microseconds frameTime);
+
+    /**
+     * @brief Same, measuring the time since the previous call
+     */
+    void recordFrame();
+
+    Stats getStats() const;
+
+private:
+    // Balanced hysteresis around the target interval
+    static constexpr double OVERRUN_RATIO = 1.25;
+    static constexpr double FIT_RATIO = 0.9;
+
+    PresentMode chooseMode(PresentMode current) const;
+    PresentMode firstSupported(std::initializer_list<PresentMode> preferences) const;
+
+    std::weak_ptr<ISwapChain> _swapChain;
+    Config _config;
+    std::vector<PresentMode> _supportedModes;
+    bool _interactive = true;
+
+    double _averageFrameTimeUs = 0.0;
+    std::chrono::steady_clock::time_point _lastFrame{};
+    PresentMode _pendingMode = PresentMode::Fifo;
+    uint32_t _pendingFrames = 0;
+    uint32_t _switches = 0;
+};
+
+} // namespace pers
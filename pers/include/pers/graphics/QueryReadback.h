@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pers/graphics/IQuerySet.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class DeviceBuffer;
+
+/**
+ * @brief Asynchronous delivery of query set results
+ *
+ * Each frame:
+ *     uint64_t ticket = readback.resolve(encoder);   // after the queried passes
+ *     queue->submit(...);
+ *     readback.submitted();
+ *     readback.collect([](uint64_t ticket, std::span<const uint64_t> values) { ... });
+ *
+ * values holds getQueryValueCount() entries per query: the passing sample
+ * count for occlusion queries (0 means hidden, e.g. skip the object next
+ * frame), nanoseconds for timestamps, or one counter per requested
+ * statistic for pipeline statistics. Results go through a ReadbackRing and
+ * arrive a few frames late; collect() never blocks.
+ */
+class QueryReadback {
+public:
+    using ResultCallback = std::function<void(uint64_t ticket, std::span<const uint64_t> values)>;
+
+    /**
+     * @param device Logical device used to create the resolve and readback buffers
+     * @param querySet Query set whose results are read back
+     * @param slotCount Frames of results that can be in flight
+     */
+    QueryReadback(const std::shared_ptr<ILogicalDevice>& device,
+                  const std::shared_ptr<IQuerySet>& querySet,
+                  uint32_t slotCount = ReadbackRing::DEFAULT_SLOT_COUNT);
+    ~QueryReadback();
+
+    QueryReadback(const QueryReadback&) = delete;
+    QueryReadback& operator=(const QueryReadback&) = delete;
+
+    bool isValid() const { return _readback != nullptr; }
+
+    /**
+     * @brief Record the resolve and readback of a query range
+     * @param queryCount Number of queries, 0 resolves up to the end of the set
+     * @return Ticket identifying the result, 0 if nothing was recorded
+     */
+    uint64_t resolve(const std::shared_ptr<ICommandEncoder>& encoder,
+                     uint32_t firstQuery = 0,
+                     uint32_t queryCount = 0);
+
+    // Must be called after the command buffer passed to resolve() is submitted
+    void submitted();
+
+    /**
+     * @brief Deliver finished results in ticket order
+     * @return Number of results delivered
+     */
+    size_t collect(const ResultCallback& callback);
+
+    const std::shared_ptr<IQuerySet>& getQuerySet() const { return _querySet; }
+    uint64_t getDroppedCount() const { return _readback ? _readback->getDroppedCount() : 0; }
+
+private:
+    std::shared_ptr<IQuerySet> _querySet;
+    std::shared_ptr<DeviceBuffer> _resolveBuffer;
+    std::unique_ptr<ReadbackRing> _readback;
+    uint32_t _valuesPerQuery = 1;
+};
+
+} // namespace pers
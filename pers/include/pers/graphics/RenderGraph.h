@@ -0,0 +1,293 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class IResourceFactory;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class ITexture;
+class ITextureView;
+class IBuffer;
+class RenderGraph;
+
+/**
+ * @brief Texture declared to a RenderGraph
+ *
+ * Usage is the minimum the caller needs; the graph adds RenderAttachment
+ * and TextureBinding for the passes that write and sample it.
+ */
+struct RenderGraphTextureDesc {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    uint32_t sampleCount = 1;
+    TextureUsage usage = TextureUsage::None;
+    std::string label;
+};
+
+/**
+ * @brief Graph-local ids, valid until RenderGraph::reset()
+ */
+struct RenderGraphTexture {
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+    uint32_t index = INVALID_INDEX;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    explicit operator bool() const { return isValid(); }
+};
+
+struct RenderGraphBuffer {
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+    uint32_t index = INVALID_INDEX;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+    explicit operator bool() const { return isValid(); }
+};
+
+/**
+ * @brief Declares what a pass reads and writes, handed to the setup callback
+ *
+ * A pass with attachments becomes a render pass begun by the graph; one
+ * without attachments gets only the command encoder (compute, copies).
+ * Color attachments bind in the order writeColor is called.
+ */
+class RenderGraphBuilder {
+public:
+    /**
+     * @brief Render to a color attachment
+     * @param clearColor Clear on first write; without it a transient target is
+     *        cleared to black and later writes load the previous contents
+     */
+    void writeColor(RenderGraphTexture texture, std::optional<Color> clearColor = std::nullopt);
+
+    /**
+     * @brief Render to the depth/stencil attachment
+     * @param clearDepth Clear on first write, same rules as writeColor
+     */
+    void writeDepth(RenderGraphTexture texture, std::optional<float> clearDepth = std::nullopt);
+
+    /**
+     * @brief Bind the depth/stencil attachment read-only (depth test without writes)
+     */
+    void readDepth(RenderGraphTexture texture);
+
+    /**
+     * @brief Sample or copy from a texture
+     */
+    void read(RenderGraphTexture texture);
+
+    void read(RenderGraphBuffer buffer);
+    void write(RenderGraphBuffer buffer);
+
+    /**
+     * @brief Keep the pass even if nothing reads what it produces
+     */
+    void setSideEffect();
+
+private:
+    friend class RenderGraph;
+
+    struct ColorWrite {
+        RenderGraphTexture texture;
+        std::optional<Color> clearColor;
+    };
+
+    struct DepthAccess {
+        RenderGraphTexture texture;
+        std::optional<float> clearDepth;
+        bool readOnly = false;
+    };
+
+    std::vector<ColorWrite> _colorWrites;
+    std::optional<DepthAccess> _depth;
+    std::vector<RenderGraphTexture> _textureReads;
+    std::vector<RenderGraphBuffer> _bufferReads;
+    std::vector<RenderGraphBuffer> _bufferWrites;
+    bool _sideEffect = false;
+};
+
+/**
+ * @brief Resources and encoders available while a pass executes
+ */
+class RenderGraphContext {
+public:
+    ICommandEncoder& getCommandEncoder() const { return *_commandEncoder; }
+
+    /**
+     * @brief Render pass begun for this pass, null for passes without attachments
+     */
+    IRenderPassEncoder* getRenderPass() const { return _renderPass; }
+
+    std::shared_ptr<ITexture> getTexture(RenderGraphTexture texture) const;
+    std::shared_ptr<ITextureView> getTextureView(RenderGraphTexture texture) const;
+    std::shared_ptr<IBuffer> getBuffer(RenderGraphBuffer buffer) const;
+
+private:
+    friend class RenderGraph;
+
+    RenderGraphContext(const RenderGraph& graph, ICommandEncoder& commandEncoder)
+        : _graph(graph), _commandEncoder(&commandEncoder) {}
+
+    const RenderGraph& _graph;
+    ICommandEncoder* _commandEncoder = nullptr;
+    IRenderPassEncoder* _renderPass = nullptr;
+};
+
+/**
+ * @brief Frame graph that derives pass order details from declared resource use
+ *
+ * Per frame: declare resources and passes, compile(), execute(), reset().
+ *
+ * compile()
+ *  - culls passes whose outputs nobody reads; imported resources and
+ *    side-effect passes count as read
+ *  - computes each transient texture's first and last live use and maps
+ *    transients with matching descs and disjoint lifetimes onto one
+ *    physical texture
+ *  - picks Clear for the first write of a transient (its contents are
+ *    undefined anyway) and Discard for the last write nothing reads
+ *  - merges adjacent live passes with the same attachments into one render
+ *    pass when the later one neither clears nor samples them, so the
+ *    attachments stay on chip between them; the later pass starts with the
+ *    full viewport and scissor, stencil reference 0 and a black blend
+ *    constant, as a fresh pass would
+ *
+ * Physical textures outlive reset() and are reused by later frames; ones
+ * idle for MAX_IDLE_FRAMES compiles are released.
+ *
+ * Passes execute in declaration order on the calling thread.
+ */
+class RenderGraph {
+public:
+    using SetupFunction = std::function<void(RenderGraphBuilder& builder)>;
+    using ExecuteFunction = std::function<void(RenderGraphContext& context)>;
+
+    static constexpr uint32_t MAX_IDLE_FRAMES = 8;
+
+    struct Stats {
+        uint32_t declaredPasses = 0;
+        uint32_t culledPasses = 0;
+        uint32_t transientTextures = 0;
+        uint32_t physicalTextures = 0;   // Distinct textures backing the transients
+        uint32_t texturesCreated = 0;    // Allocated by this compile
+        uint32_t discardedStores = 0;
+        uint32_t mergedPasses = 0;       // Passes recorded into the previous pass's render pass
+    };
+
+    explicit RenderGraph(const std::shared_ptr<IResourceFactory>& factory);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&) = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    /**
+     * @brief Declare a transient texture, allocated and aliased by compile()
+     */
+    RenderGraphTexture createTexture(const RenderGraphTextureDesc& desc);
+
+    /**
+     * @brief Use an external texture (e.g. the swap chain's); its contents are kept
+     */
+    RenderGraphTexture importTexture(const std::shared_ptr<ITextureView>& view, const RenderGraphTextureDesc& desc);
+
+    /**
+     * @brief Use an external buffer for dependency tracking
+     */
+    RenderGraphBuffer importBuffer(const std::shared_ptr<IBuffer>& buffer);
+
+    /**
+     * @brief Declare a pass; setup runs immediately, execute runs in execute()
+     */
+    void addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute);
+
+    /**
+     * @brief Cull passes, assign physical textures and choose load/store ops
+     * @return false if a declaration is invalid or a texture failed to allocate
+     */
+    bool compile();
+
+    /**
+     * @brief Run the live passes of the last compile()
+     * @return false if not compiled or a render pass failed to begin
+     */
+    bool execute(ICommandEncoder& encoder);
+
+    /**
+     * @brief Drop passes and declarations for the next frame, keep physical textures
+     */
+    void reset();
+
+    /**
+     * @brief Release every physical texture not in use by the current compile
+     * Call after execute(); the graph must be compiled again before the next execute.
+     */
+    void releaseUnusedTextures();
+
+    Stats getStats() const { return _stats; }
+
+private:
+    friend class RenderGraphContext;
+
+    struct TextureResource {
+        RenderGraphTextureDesc desc;
+        std::shared_ptr<ITextureView> importedView;
+        bool imported = false;
+
+        // compile() results
+        uint32_t firstPass = std::numeric_limits<uint32_t>::max();
+        uint32_t lastPass = 0;
+        int32_t physical = -1;
+    };
+
+    struct BufferResource {
+        std::shared_ptr<IBuffer> buffer;
+    };
+
+    struct Pass {
+        std::string name;
+        RenderGraphBuilder builder;
+        ExecuteFunction execute;
+        bool culled = false;
+        bool continuesPrevious = false;  // Runs in the render pass of the previous live pass
+        RenderPassDesc renderPassDesc;
+    };
+
+    struct PhysicalTexture {
+        RenderGraphTextureDesc desc;
+        std::shared_ptr<ITexture> texture;
+        std::shared_ptr<ITextureView> view;
+        uint32_t idleFrames = 0;
+        bool assigned = false;
+        uint32_t availableAfter = 0;  // Pass index after which the slot is free again
+    };
+
+    void cullPasses();
+    bool assignPhysicalTextures();
+    void buildRenderPassDescs();
+    void mergeRenderPasses();
+    bool canMerge(uint32_t groupStart, uint32_t passIndex) const;
+    int32_t acquirePhysical(const RenderGraphTextureDesc& desc, uint32_t firstPass);
+    std::shared_ptr<ITextureView> resolveView(RenderGraphTexture texture) const;
+    bool isValidTexture(RenderGraphTexture texture) const;
+
+    std::weak_ptr<IResourceFactory> _factory;
+    std::vector<TextureResource> _textures;
+    std::vector<BufferResource> _buffers;
+    std::vector<Pass> _passes;
+    std::vector<PhysicalTexture> _physicalTextures;
+    bool _compiled = false;
+    Stats _stats;
+};
+
+} // namespace pers
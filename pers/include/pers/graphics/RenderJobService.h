@@ -0,0 +1,181 @@
+#pragma once
+
+#include "pers/graphics/DevicePool.h"
+#include <glm/mat4x4.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief One image to render
+ */
+struct RenderJob {
+    std::string scene;  // Key the renderer loads resources by; jobs of a scene share them
+    glm::mat4 view{1.0f};
+    glm::mat4 projection{1.0f};
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    TextureFormat depthFormat = TextureFormat::Depth24Plus;
+    uint64_t userData = 0;
+};
+
+/**
+ * @brief Outcome of a job, valid only during the completion callback
+ */
+struct RenderJobResult {
+    uint64_t jobId = 0;
+    uint32_t deviceIndex = 0;
+    const OffscreenImage* image = nullptr;  // Null if the job failed
+    std::string error;
+};
+
+/**
+ * @brief Draws jobs on one device, created once per device by the service
+ *
+ * Everything it creates (pipelines, bind groups, scene buffers) stays
+ * alive across jobs; the service only calls it from its device's thread.
+ */
+class IRenderJobRenderer {
+public:
+    virtual ~IRenderJobRenderer() = default;
+
+    /**
+     * @brief Load what a scene needs before its first job on this device
+     * @return false to fail every job of the batch
+     */
+    virtual bool prepareScene(const std::string& scene) = 0;
+
+    /**
+     * @brief Drop a scene the service evicted to stay within maxScenesPerDevice
+     */
+    virtual void releaseScene(const std::string& scene) { (void)scene; }
+
+    /**
+     * @brief Encode a job of a prepared scene into the target
+     */
+    virtual bool record(const RenderJob& job, ICommandEncoder& encoder, const IFramebuffer& target) = 0;
+};
+
+/**
+ * @brief Long-running headless render service over every GPU of a DevicePool
+ *
+ * Each device has its own job queue and thread. submit() routes a job to
+ * a device that already holds its scene unless that device is much busier
+ * than the least loaded one, so scene loads happen once per device rather
+ * than once per job. A device thread takes jobs in batches of one scene,
+ * prepares the scene if it is not resident, and feeds the batch to the
+ * device's OffscreenRenderQueue, so readbacks of one job overlap recording
+ * of the next. The queue is drained whenever the device runs out of work.
+ *
+ * Completion callbacks run on the device's thread; copy the pixels out or
+ * encode them there.
+ *
+ *     auto service = RenderJobService::create(std::move(pool), config,
+ *         [](uint32_t, const std::shared_ptr<ILogicalDevice>& device) {
+ *             return std::make_unique<ThumbnailRenderer>(device);
+ *         });
+ *     service->submit(job, [](const RenderJob& job, const RenderJobResult& result) { ... });
+ */
+class RenderJobService {
+public:
+    using RendererFactory = std::function<std::unique_ptr<IRenderJobRenderer>(
+        uint32_t deviceIndex, const std::shared_ptr<ILogicalDevice>& device)>;
+    using CompletionFunction = std::function<void(const RenderJob& job, const RenderJobResult& result)>;
+
+    struct Config {
+        uint32_t maxBatchSize = 32;          // Jobs of one scene taken per batch
+        uint32_t maxScenesPerDevice = 8;     // Resident scenes before the least recently used is released
+        uint32_t sceneAffinitySlack = 16;    // Extra queued jobs accepted to keep a scene on its device
+        uint32_t maxQueuedJobs = 0;          // Per device, submit() waits beyond it; 0 = unbounded
+    };
+
+    struct DeviceStats {
+        std::string deviceName;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        uint64_t batches = 0;
+        uint64_t scenesPrepared = 0;  // Scene loads, including reloads after eviction
+        uint32_t queued = 0;
+        uint32_t residentScenes = 0;
+    };
+
+    /**
+     * @brief Start a thread per pool device with its own renderer
+     * @return Service, or null if the pool is empty or no renderer could be created
+     */
+    static std::unique_ptr<RenderJobService> create(std::unique_ptr<DevicePool> pool, const Config& config,
+                                                    const RendererFactory& factory);
+
+    /**
+     * @brief Fail queued jobs, finish the ones in flight and stop the threads
+     */
+    ~RenderJobService();
+
+    RenderJobService(const RenderJobService&) = delete;
+    RenderJobService& operator=(const RenderJobService&) = delete;
+
+    /**
+     * @brief Queue a job; thread-safe
+     * @return Job id, 0 if the job is invalid or the service is stopping
+     */
+    uint64_t submit(const RenderJob& job, CompletionFunction onComplete);
+
+    /**
+     * @brief Wait until every submitted job has completed
+     * @return false if the timeout passed first
+     */
+    bool waitIdle(std::chrono::milliseconds timeout = OffscreenRenderQueue::DEFAULT_WAIT_TIMEOUT);
+
+    uint32_t getDeviceCount() const { return static_cast<uint32_t>(_devices.size()); }
+    std::vector<DeviceStats> getStats() const;
+
+private:
+    struct QueuedJob {
+        uint64_t id = 0;
+        RenderJob job;
+        CompletionFunction onComplete;
+    };
+
+    struct Device {
+        uint32_t index = 0;
+        std::unique_ptr<IRenderJobRenderer> renderer;
+        std::thread thread;
+        std::deque<QueuedJob> jobs;
+        std::list<std::string> scenes;  // Resident scenes, most recently used first
+        std::string lastRoutedScene;    // Scene of the last job submit() queued here
+        std::condition_variable cv;
+        uint32_t inFlight = 0;          // Taken by the thread, not completed yet
+        DeviceStats stats;
+    };
+
+    RenderJobService() = default;
+
+    void deviceLoop(Device& device);
+    std::vector<QueuedJob> takeBatch(Device& device);
+    bool makeResident(Device& device, const std::string& scene);
+    uint32_t pickDevice(const std::string& scene) const;
+    void finish(Device& device, const QueuedJob& job, const RenderJobResult& result);
+
+    Config _config;
+    std::unique_ptr<DevicePool> _pool;
+    std::vector<std::unique_ptr<Device>> _devices;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _idleCv;  // Jobs completed or queue space freed
+    std::atomic<uint64_t> _nextJobId{1};
+    uint64_t _pending = 0;            // Submitted and not completed
+    bool _stopping = false;
+};
+
+} // namespace pers
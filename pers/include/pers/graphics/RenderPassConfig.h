@@ -2,6 +2,7 @@
 
 #include "pers/graphics/RenderPassTypes.h"
 #include "pers/graphics/IFramebuffer.h"
+#include "pers/graphics/IPreparedRenderPass.h"
 #include <vector>
 #include <memory>
 
@@ -23,6 +24,10 @@ public:
         LoadOp loadOp = LoadOp::Clear;
         StoreOp storeOp = StoreOp::Store;
         Color clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
+        
+        // Keep multisampled contents after resolving; by default they are
+        // discarded so only the resolved image is written back to memory
+        bool keepMultisampled = false;
     };
     
     /**
@@ -81,6 +86,15 @@ public:
      */
     RenderPassDesc makeDescriptor(const std::shared_ptr<IFramebuffer>& framebuffer) const;
     
+    /**
+     * @brief Point a pass prepared from makeDescriptor() at the framebuffer's current views
+     * 
+     * Cheaper than rebuilding the descriptor each frame; prepare again only when
+     * the framebuffer gains or loses resolve targets or depth.
+     * @return false if the framebuffer lacks an attachment the pass uses
+     */
+    bool retarget(IPreparedRenderPass& pass, const std::shared_ptr<IFramebuffer>& framebuffer) const;
+    
 private:
     std::vector<ColorConfig> _colorConfigs;
     std::shared_ptr<DepthStencilConfig> _depthStencilConfig;
@@ -4,11 +4,13 @@
 #include <string>
 #include <vector>
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IQuerySet.h"
 
 namespace pers {
 
 // Forward declarations
 class ITextureView;
+class RenderResourceTable;
 
 /**
  * @brief Color for clear operations
@@ -53,6 +55,15 @@ struct RenderPassDesc {
     std::vector<RenderPassColorAttachment> colorAttachments;
     std::shared_ptr<RenderPassDepthStencilAttachment> depthStencilAttachment = nullptr;
     std::string label;
+    
+    // Resolves the handle-based encoder setters, must outlive the pass (optional)
+    const RenderResourceTable* resourceTable = nullptr;
+    
+    // GPU timestamps at pass begin/end (optional)
+    PassTimestampWrites timestampWrites;
+    
+    // Query set used by IRenderPassEncoder::beginOcclusionQuery (optional)
+    std::shared_ptr<IQuerySet> occlusionQuerySet;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -0,0 +1,180 @@
+#pragma once
+
+#include "pers/graphics/GraphicsTypes.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class IRenderPipeline;
+class IBuffer;
+class IBindGroup;
+class ITextureView;
+class ISampler;
+
+/**
+ * @brief 32-bit POD id for a resource registered in a RenderResourceTable
+ *
+ * Copying a handle touches no refcount. The generation detects use after
+ * removal: a stale handle resolves to null instead of a recycled slot. It
+ * wraps after 2048 reuses of the same slot, tables hold up to MAX_INDEX + 1
+ * slots.
+ */
+template<typename Tag>
+struct ResourceHandle {
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t GENERATION_BITS = 12;
+    static constexpr uint32_t MAX_INDEX = (1u << INDEX_BITS) - 1;
+
+    uint32_t index : INDEX_BITS = 0;
+    uint32_t generation : GENERATION_BITS = 0;  // 0 = null handle, odd = live
+
+    /**
+     * @brief Generation a slot moves to when it is filled or released; keeps
+     * the odd = live parity across the wrap
+     */
+    static constexpr uint32_t nextGeneration(uint32_t generation) {
+        return (generation + 1) & ((1u << GENERATION_BITS) - 1);
+    }
+
+    bool isValid() const { return generation != 0; }
+    explicit operator bool() const { return isValid(); }
+
+    bool operator==(const ResourceHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+};
+
+using PipelineHandle = ResourceHandle<struct PipelineHandleTag>;
+using BufferHandle = ResourceHandle<struct BufferHandleTag>;
+using BindGroupHandle = ResourceHandle<struct BindGroupHandleTag>;
+using TextureViewHandle = ResourceHandle<struct TextureViewHandleTag>;
+using SamplerHandle = ResourceHandle<struct SamplerHandleTag>;
+
+static_assert(sizeof(BufferHandle) == sizeof(uint32_t), "Resource handles are packed into 32 bits");
+
+/**
+ * @brief Slot table behind the handle-based render pass encoding path
+ *
+ * Registration takes a strong reference and caches what the encoder needs
+ * per draw, so the handle overloads on IRenderPassEncoder resolve with an
+ * index and a generation compare: no RTTI and no atomic refcounting.
+ *
+ * Slots are stored as parallel dense arrays: resolving reads a generation
+ * and an entry, the owning references sit in a separate cold array.
+ *
+ * Pipelines, bind groups, texture views and samplers are immutable, their
+ * native handles are cached.
+ * Async pipelines and buffers are resolved through the object on each call
+ * because their native handle can change (compilation finishing, the
+ * DynamicBuffer frame ring).
+ *
+ * Resolution is lock-free; add/remove must not race with passes encoding
+ * against the table. Put the table in RenderPassDesc::resourceTable. Debug
+ * builds log every stale handle that is resolved.
+ */
+class RenderResourceTable {
+public:
+    struct BufferEntry {
+        const IBuffer* buffer = nullptr;
+        uint64_t size = 0;
+    };
+
+    RenderResourceTable() = default;
+    ~RenderResourceTable() = default;
+
+    RenderResourceTable(const RenderResourceTable&) = delete;
+    RenderResourceTable& operator=(const RenderResourceTable&) = delete;
+
+    PipelineHandle add(const std::shared_ptr<IRenderPipeline>& pipeline);
+    BufferHandle add(const std::shared_ptr<IBuffer>& buffer);
+    BindGroupHandle add(const std::shared_ptr<IBindGroup>& bindGroup);
+    TextureViewHandle add(const std::shared_ptr<ITextureView>& view);
+    SamplerHandle add(const std::shared_ptr<ISampler>& sampler);
+
+    /**
+     * @brief Release a slot; the handle and its copies resolve to null afterwards
+     * @return false if the handle was already stale
+     */
+    bool remove(PipelineHandle handle);
+    bool remove(BufferHandle handle);
+    bool remove(BindGroupHandle handle);
+    bool remove(TextureViewHandle handle);
+    bool remove(SamplerHandle handle);
+
+    // Hot path, return null for stale or null handles
+    NativePipelineHandle resolve(PipelineHandle handle) const;
+    const BufferEntry* resolve(BufferHandle handle) const;
+    NativeBindGroupHandle resolve(BindGroupHandle handle) const;
+    NativeTextureViewHandle resolve(TextureViewHandle handle) const;
+    NativeSamplerHandle resolve(SamplerHandle handle) const;
+
+    // Owning objects, for tools that need more than the native handle
+    std::shared_ptr<IRenderPipeline> getObject(PipelineHandle handle) const;
+    std::shared_ptr<IBuffer> getObject(BufferHandle handle) const;
+    std::shared_ptr<IBindGroup> getObject(BindGroupHandle handle) const;
+    std::shared_ptr<ITextureView> getObject(TextureViewHandle handle) const;
+    std::shared_ptr<ISampler> getObject(SamplerHandle handle) const;
+
+    size_t getPipelineCount() const { return _pipelines.liveCount; }
+    size_t getBufferCount() const { return _buffers.liveCount; }
+    size_t getBindGroupCount() const { return _bindGroups.liveCount; }
+    size_t getTextureViewCount() const { return _textureViews.liveCount; }
+    size_t getSamplerCount() const { return _samplers.liveCount; }
+
+    void clear();
+
+private:
+    struct PipelineEntry {
+        NativePipelineHandle native;           // Null when resolved per call
+        const IRenderPipeline* pipeline = nullptr;
+    };
+
+    static void reportStaleHandle(uint32_t index, uint32_t generation);
+
+    template<typename Entry, typename Object>
+    struct SlotArray {
+        std::vector<uint32_t> generations;  // Odd = live
+        std::vector<Entry> entries;
+        std::vector<std::shared_ptr<Object>> owners;
+        std::vector<uint32_t> freeList;
+        size_t liveCount = 0;
+
+        template<typename Handle>
+        Handle insert(std::shared_ptr<Object> owner, const Entry& entry);
+
+        template<typename Handle>
+        bool erase(Handle handle);
+
+        template<typename Handle>
+        const Entry* find(Handle handle) const {
+            if (handle.index < generations.size() && generations[handle.index] == handle.generation &&
+                (handle.generation & 1u)) {
+                return &entries[handle.index];
+            }
+#ifndef NDEBUG
+            if (handle.isValid()) {
+                reportStaleHandle(handle.index, handle.generation);
+            }
+#endif
+            return nullptr;
+        }
+
+        template<typename Handle>
+        std::shared_ptr<Object> findOwner(Handle handle) const {
+            return find(handle) ? owners[handle.index] : nullptr;
+        }
+
+        void clear();
+    };
+
+    SlotArray<PipelineEntry, IRenderPipeline> _pipelines;
+    SlotArray<BufferEntry, IBuffer> _buffers;
+    SlotArray<NativeBindGroupHandle, IBindGroup> _bindGroups;
+    SlotArray<NativeTextureViewHandle, ITextureView> _textureViews;
+    SlotArray<NativeSamplerHandle, ISampler> _samplers;
+};
+
+} // namespace pers
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/utils/ConcurrentLookupTable.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Deduplicates samplers by their state
+ *
+ * Materials ask for the same handful of samplers over and over, while
+ * backends cap the number of live samplers (2048 in a D3D12 sampler heap).
+ * Samplers are keyed by filters, address modes, LOD clamps, compare
+ * function and anisotropy; label is ignored. Equal descs share one sampler.
+ *
+ * Thread-safe. Entries live in a ConcurrentLookupTable, so hits take no
+ * lock and encoding threads resolving samplers per draw never contend;
+ * only inserts, trim and clear serialize. Statistics are atomic counters.
+ */
+class SamplerCache {
+public:
+    using CreateFunction = std::function<std::shared_ptr<ISampler>(const SamplerDesc&)>;
+
+    // Live samplers past this count are likely a leak of unique descs
+    static constexpr size_t WARN_SAMPLER_COUNT = 2048;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        size_t entries = 0;
+    };
+
+    SamplerCache() = default;
+    ~SamplerCache() = default;
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator=(const SamplerCache&) = delete;
+
+    /**
+     * @brief Return the cached sampler for desc, creating it on a miss
+     * @param create Called without the cache lock held when no entry matches
+     * @return Cached or newly created sampler, nullptr if creation failed
+     */
+    std::shared_ptr<ISampler> getOrCreate(const SamplerDesc& desc, const CreateFunction& create);
+
+    /**
+     * @brief Drop samplers referenced only by the cache
+     * @return Number of samplers released
+     */
+    size_t trim();
+
+    void clear();
+
+    Stats getStats() const;
+
+    static uint64_t computeHash(const SamplerDesc& desc);
+    static bool isEquivalent(const SamplerDesc& a, const SamplerDesc& b);
+
+private:
+    struct Entry {
+        SamplerDesc desc;
+        std::shared_ptr<ISampler> sampler;
+    };
+
+    std::shared_ptr<ISampler> find(uint64_t hash, const SamplerDesc& desc) const;
+
+    ConcurrentLookupTable<Entry, MemoryTag::Caches> _entries;
+    std::atomic<size_t> _count{0};
+    std::atomic<uint64_t> _hits{0};
+    std::atomic<uint64_t> _misses{0};
+    std::atomic<bool> _warned{false};
+};
+
+} // namespace pers
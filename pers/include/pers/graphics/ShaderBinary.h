@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief First word of every SPIR-V module, in the byte order it was written
+ */
+constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+/**
+ * @brief Whether words hold a SPIR-V module in native byte order
+ * Only checks the magic and the 5-word header, the backend validates the rest.
+ */
+bool isSpirvBinary(std::span<const uint32_t> words);
+
+/**
+ * @brief Read a SPIR-V binary, as written by pers_shader_cook
+ * @param error Receives a message on failure
+ * @return true if the file was read and has a SPIR-V header
+ */
+bool loadSpirvFile(const std::string& path, std::vector<uint32_t>& words, std::string* error = nullptr);
+
+/**
+ * @brief Write a SPIR-V binary
+ */
+bool saveSpirvFile(const std::string& path, std::span<const uint32_t> words, std::string* error = nullptr);
+
+} // namespace pers
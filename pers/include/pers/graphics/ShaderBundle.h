@@ -0,0 +1,126 @@
+#pragma once
+
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ShaderLibrary.h"
+#include "pers/utils/MappedFile.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class ShaderReflection;
+
+/**
+ * @brief Every cooked shader permutation of a project in one mapped file
+ *
+ * Written offline by pers_shader_cook --bundle. Each permutation is a shader
+ * name plus its defines, pointing at a SPIR-V blob and a serialized
+ * ShaderReflection blob; identical blobs are stored once. The permutation
+ * table is sorted by key, so lookups binary-search the mapping in place and
+ * opening reads nothing but the header. Reflection blobs are decoded on
+ * first use and shared by every module created from them:
+ *
+ *     auto bundle = ShaderBundle::open("shaders.psb");
+ *     auto vs = bundle->getModule(library, "mesh", "vs_main", {{"SKINNED", ""}});
+ *
+ * Modules then need no file IO, preprocessing or WGSL parsing. Thread-safe.
+ */
+class ShaderBundle {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    struct PermutationInfo {
+        std::string_view name;
+        std::string_view defines;  // Canonical form, see canonicalDefines()
+        uint64_t spirvBytes = 0;
+    };
+
+    /**
+     * @brief Map a bundle and validate its tables
+     * @return Null if the file is missing, truncated or of another version
+     */
+    static std::shared_ptr<ShaderBundle> open(const std::string& path);
+
+    /**
+     * @brief Desc for one entry point of a cooked permutation
+     * Stage and reflection come from the bundle, SPIR-V is copied out of the mapping.
+     * @return false if the permutation or entry point was not cooked
+     */
+    bool getModuleDesc(std::string_view name, std::string_view entryPoint,
+                       const ShaderDefines& defines, ShaderModuleDesc& desc) const;
+
+    /**
+     * @brief Module for a cooked permutation, deduplicated through the library
+     */
+    std::shared_ptr<IShaderModule> getModule(ShaderLibrary& library, std::string_view name,
+                                             std::string_view entryPoint,
+                                             const ShaderDefines& defines = {}) const;
+
+    bool contains(std::string_view name, const ShaderDefines& defines = {}) const;
+
+    size_t getPermutationCount() const;
+    PermutationInfo getPermutation(size_t index) const;
+    size_t getSize() const { return _file.size(); }
+
+    /**
+     * @brief Permutation key shared by the writer and lookups
+     */
+    static uint64_t computeKey(std::string_view name, std::string_view canonicalDefines);
+
+    /**
+     * @brief NAME=VALUE lines in name order, the form stored in the bundle
+     */
+    static std::string canonicalDefines(const ShaderDefines& defines);
+
+private:
+    ShaderBundle() = default;
+
+    const void* findPermutation(std::string_view name, const ShaderDefines& defines) const;
+    std::shared_ptr<const ShaderReflection> getReflection(uint32_t blob) const;
+
+    MappedFile _file;
+    std::string _path;
+
+    mutable Mutex<false> _mutex;
+    mutable std::unordered_map<uint32_t, std::shared_ptr<const ShaderReflection>> _reflections;  // Blob index -> decoded
+};
+
+/**
+ * @brief Collects cooked permutations and writes a ShaderBundle file
+ */
+class ShaderBundleWriter {
+public:
+    /**
+     * @brief Add one permutation
+     * @return false if the same name and defines were added before
+     */
+    bool add(const std::string& name, const ShaderDefines& defines, std::vector<uint32_t> spirv,
+             const ShaderReflection& reflection, std::string* error = nullptr);
+
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+    size_t getPermutationCount() const { return _permutations.size(); }
+    size_t getBlobCount() const { return _blobs.size(); }
+
+private:
+    struct Permutation {
+        uint64_t key = 0;
+        std::string name;
+        std::string defines;
+        uint32_t spirvBlob = 0;
+        uint32_t reflectionBlob = 0;
+    };
+
+    uint32_t addBlob(std::vector<uint8_t> bytes);
+
+    std::vector<Permutation> _permutations;
+    std::vector<std::vector<uint8_t>> _blobs;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> _blobsByHash;  // Content hash -> candidate blobs
+};
+
+} // namespace pers
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/ShaderLibrary.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class AsyncRenderPipeline;
+class IResourceFactory;
+
+/**
+ * @brief Recompiles WGSL files when they change and swaps dependent pipelines
+ *
+ * Modules loaded through loadModule() remember their file, and pipelines
+ * created through createRenderPipeline() are recorded against the modules
+ * they use. poll() checks file timestamps; for each changed file it
+ * recompiles only the modules built from it and starts an asynchronous
+ * rebuild of only the pipelines using those modules, with the new modules
+ * substituted into their descs. applyReloads() swaps every finished rebuild
+ * into its handle, so call it between frames:
+ *
+ *     auto vs = reloader.loadModule("shaders/mesh.wgsl", {.entryPoint = "vs_main"});
+ *     auto fs = reloader.loadModule("shaders/mesh.wgsl", {.entryPoint = "fs_main"});
+ *     auto pipeline = reloader.createRenderPipeline(desc);  // desc.vertex = vs, fragment = fs
+ *     ...
+ *     reloader.poll();
+ *     reloader.applyReloads();
+ *     renderFrame(pipeline);
+ *
+ * The returned handles are AsyncRenderPipelines and bind like any pipeline.
+ * A file that fails to preprocess or compile keeps its previous modules and
+ * pipelines; the next save triggers another attempt. Modules replaced by a
+ * reload stay in the library until ShaderLibrary::trim().
+ *
+ * Not thread-safe, drive it from the thread that renders.
+ */
+class ShaderHotReloader {
+public:
+    struct Stats {
+        uint64_t reloadedFiles = 0;
+        uint64_t failedFiles = 0;      // Read, preprocess or compile errors
+        uint64_t rebuiltPipelines = 0; // Swapped into their handles
+        uint64_t failedPipelines = 0;
+        size_t watchedFiles = 0;
+        size_t trackedPipelines = 0;
+    };
+
+    explicit ShaderHotReloader(const std::shared_ptr<IResourceFactory>& factory,
+                               std::chrono::milliseconds pollInterval = std::chrono::milliseconds(250));
+    ~ShaderHotReloader();
+
+    ShaderHotReloader(const ShaderHotReloader&) = delete;
+    ShaderHotReloader& operator=(const ShaderHotReloader&) = delete;
+
+    /**
+     * @brief Compile a module from a file and watch it
+     * @param desc Entry point, stage and debug name; code is read from the file
+     * @return Null if the file cannot be read or the shader fails to compile
+     */
+    std::shared_ptr<IShaderModule> loadModule(const std::string& path, const ShaderModuleDesc& desc,
+                                              const ShaderDefines& defines = {});
+
+    /**
+     * @brief Create a pipeline that is rebuilt when its watched modules change
+     * Modules not loaded through this reloader are used as they are.
+     */
+    std::shared_ptr<AsyncRenderPipeline> createRenderPipeline(const RenderPipelineDesc& desc);
+
+    /**
+     * @brief Check watched files and start rebuilding what depends on changed ones
+     * Returns immediately if called again within the poll interval.
+     * @return Number of files reloaded
+     */
+    size_t poll();
+
+    /**
+     * @brief Force a reload of one watched file, ignoring its timestamp
+     */
+    bool reload(const std::string& path);
+
+    /**
+     * @brief Swap finished pipeline rebuilds into their handles
+     * @return Number of pipelines swapped
+     */
+    size_t applyReloads();
+
+    bool hasPendingReloads() const { return !_pending.empty(); }
+
+    ShaderLibrary& getLibrary() { return _library; }
+    Stats getStats() const;
+
+private:
+    struct ModuleRecord {
+        std::string path;
+        ShaderModuleDesc desc;
+        ShaderDefines defines;
+        std::shared_ptr<IShaderModule> module;
+    };
+
+    struct FileRecord {
+        std::filesystem::file_time_type lastWrite;
+        std::vector<size_t> modules;  // Indices into _modules
+    };
+
+    struct PipelineRecord {
+        std::weak_ptr<AsyncRenderPipeline> handle;
+        RenderPipelineDesc desc;  // With the latest modules, even while their rebuild is pending
+    };
+
+    struct PendingRebuild {
+        size_t pipeline = 0;  // Index into _pipelines
+        std::shared_ptr<AsyncRenderPipeline> build;
+    };
+
+    using ModuleReplacements = std::unordered_map<const IShaderModule*, std::shared_ptr<IShaderModule>>;
+
+    bool reloadFile(const std::string& path, FileRecord& file, ModuleReplacements& replaced);
+    void rebuildDependents(const ModuleReplacements& replaced);
+    static bool readFile(const std::string& path, std::string& contents);
+
+    std::weak_ptr<IResourceFactory> _factory;
+    ShaderLibrary _library;
+    std::chrono::milliseconds _pollInterval;
+    std::chrono::steady_clock::time_point _lastPoll;
+
+    std::vector<ModuleRecord> _modules;
+    std::unordered_map<std::string, FileRecord> _files;
+    std::vector<PipelineRecord> _pipelines;
+    std::unordered_map<const IShaderModule*, std::vector<size_t>> _dependents;  // Module -> _pipelines indices
+    std::vector<PendingRebuild> _pending;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "pers/graphics/IShaderModule.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace pers {
+
+class IResourceFactory;
+
+/**
+ * @brief Preprocessor defines selecting a shader permutation
+ * Ordered so the same set always produces the same permutation key.
+ */
+using ShaderDefines = std::map<std::string, std::string>;
+
+/**
+ * @brief Shared, deduplicated shader modules with permutation support
+ *
+ * Sources may use a small line-based preprocessor before being handed to
+ * WGSL compilation:
+ *     #define NAME [value]
+ *     #undef NAME
+ *     #ifdef NAME / #ifndef NAME / #if NAME / #else / #endif
+ * Defines with a value are substituted where NAME appears as a whole
+ * identifier. Directive lines are replaced by empty lines so compiler
+ * diagnostics keep their line numbers.
+ *
+ * Each (source, defines, entry point, stage) request is cached as a
+ * permutation. Permutations that preprocess to the same WGSL share one
+ * module, so only unique shaders are compiled.
+ *
+ * SPIR-V descs are deduplicated by their binary. They take no defines:
+ * pers_shader_cook applies them when the binary is cooked.
+ */
+class ShaderLibrary {
+public:
+    struct Stats {
+        uint64_t permutationHits = 0;     // Served without preprocessing
+        uint64_t sourceHits = 0;          // Preprocessed, matched an existing module
+        uint64_t compiled = 0;            // New modules created
+        size_t permutations = 0;
+        size_t modules = 0;
+    };
+
+    explicit ShaderLibrary(const std::shared_ptr<IResourceFactory>& factory);
+    ~ShaderLibrary() = default;
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    /**
+     * @brief Get the module for a shader permutation, compiling it on first use
+     * @param desc Shader source, entry point and stage
+     * @param defines Permutation defines applied before compilation
+     * @return Shared module, nullptr if preprocessing or compilation failed
+     */
+    std::shared_ptr<IShaderModule> getModule(const ShaderModuleDesc& desc, const ShaderDefines& defines = {});
+
+    /**
+     * @brief Drop modules no longer referenced outside the library
+     * @return Number of modules released
+     */
+    size_t trim();
+
+    void clear();
+
+    Stats getStats() const;
+
+    /**
+     * @brief Apply defines and directives to a source
+     * @param error Receives a message on failure
+     * @return true on success
+     */
+    static bool preprocess(const std::string& source, const ShaderDefines& defines,
+                           std::string& output, std::string* error = nullptr);
+
+private:
+    std::weak_ptr<IResourceFactory> _factory;
+
+    mutable Mutex<false> _mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<IShaderModule>> _permutations;  // Request key -> module
+    std::unordered_map<uint64_t, std::shared_ptr<IShaderModule>> _modules;       // Preprocessed source key -> module
+    uint64_t _permutationHits = 0;
+    uint64_t _sourceHits = 0;
+    uint64_t _compiled = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IShaderModule.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace pers {
+
+class IResourceFactory;
+class IPipelineLayout;
+
+/**
+ * @brief One @group/@binding resource declared by a shader
+ */
+struct ShaderBindingInfo {
+    uint32_t group = 0;
+    uint32_t binding = 0;
+    std::string name;
+    BindingType type = BindingType::UniformBuffer;
+    TextureSampleType sampleType = TextureSampleType::Float;
+    TextureViewDimension viewDimension = TextureViewDimension::D2;
+    bool multisampled = false;
+    uint32_t count = 0;  // binding_array length, 0 for a single resource
+};
+
+/**
+ * @brief One @location input of a vertex entry point
+ */
+struct ShaderVertexInput {
+    uint32_t location = 0;
+    std::string name;
+    VertexFormat format = VertexFormat::Float32x4;
+};
+
+struct ShaderEntryPoint {
+    std::string name;
+    ShaderStage stage = ShaderStage::None;
+    std::array<uint32_t, 3> workgroupSize{1, 1, 1};  // Compute only, 0 for override-expressions
+    std::vector<ShaderVertexInput> vertexInputs;      // Vertex only, sorted by location
+    std::vector<uint32_t> bindings;                   // Indices into getBindings() reachable from the entry point
+};
+
+/**
+ * @brief Resource bindings, entry points and vertex inputs read from WGSL
+ *
+ * Parsing is structural: declarations, attributes, struct members and the
+ * identifiers each function body mentions. A binding is attributed to an
+ * entry point when that entry point or a function it calls names it, which
+ * gives each derived layout entry the tightest visibility.
+ *
+ * Storage textures, external textures and override-sized arrays have no
+ * BindGroupLayoutEntry equivalent; modules using them report
+ * isLayoutDerivable() false and pipelines keep the backend's own layout.
+ * Texture sample types follow WGSL's scalar (f32 is Float), so textures read
+ * with textureLoad only from unfilterable formats need an explicit layout.
+ *
+ * Deriving through IResourceFactory::createBindGroupLayout goes through its
+ * content-hashed cache, so pipelines whose shaders declare the same bindings
+ * share one layout object and bind groups built for one work with the others.
+ */
+class ShaderReflection {
+public:
+    ShaderReflection() = default;
+
+    /**
+     * @brief Reflect WGSL source
+     * Returns an invalid reflection if the source does not parse.
+     */
+    static ShaderReflection reflect(std::string_view source);
+
+    /**
+     * @brief Compact binary form, stored by shader bundles and the pipeline disk cache
+     * Appends to out. Invalid reflections serialize to an empty blob.
+     */
+    void serialize(std::vector<uint8_t>& out) const;
+
+    /**
+     * @brief Rebuild a reflection from serialize() output
+     * Returns an invalid reflection if the blob is empty, truncated or from another version.
+     */
+    static ShaderReflection deserialize(const uint8_t* data, size_t size);
+
+    bool isValid() const { return _valid; }
+    bool isLayoutDerivable() const { return _valid && _layoutDerivable; }
+
+    const std::vector<ShaderBindingInfo>& getBindings() const { return _bindings; }
+    const std::vector<ShaderEntryPoint>& getEntryPoints() const { return _entryPoints; }
+    const ShaderEntryPoint* findEntryPoint(std::string_view name) const;
+
+    /**
+     * @brief Stage of the named entry point, or the first of vertex, fragment, compute present
+     */
+    ShaderStage detectStage(std::string_view entryPoint) const;
+
+    /**
+     * @brief Bind group layouts for a set of shader stages, indexed by group
+     *
+     * Bindings shared between stages merge their visibility. Groups without
+     * bindings below the highest used group are empty layouts.
+     * @return false if a module is not derivable, lacks its entry point, or
+     *         two stages declare one binding differently
+     */
+    static bool deriveBindGroupLayouts(const std::vector<std::shared_ptr<IShaderModule>>& modules,
+                                       std::vector<BindGroupLayoutDesc>& layouts);
+
+    /**
+     * @brief Shared pipeline layout for a set of shader stages
+     * @return Null if the layouts cannot be derived or created
+     */
+    static std::shared_ptr<IPipelineLayout> derivePipelineLayout(const IResourceFactory& factory,
+                                                                 const std::vector<std::shared_ptr<IShaderModule>>& modules,
+                                                                 const std::string& debugName = "");
+
+    /**
+     * @brief One tightly packed per-vertex buffer holding every @location input
+     * @return false if the vertex module has no entry point or no inputs
+     */
+    static bool deriveVertexLayout(const IShaderModule& vertex, VertexBufferLayout& layout);
+
+private:
+    friend class WgslReflector;
+
+    std::vector<ShaderBindingInfo> _bindings;
+    std::vector<ShaderEntryPoint> _entryPoints;
+    bool _valid = false;
+    bool _layoutDerivable = true;
+};
+
+} // namespace pers
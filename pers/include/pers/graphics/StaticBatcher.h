@@ -0,0 +1,182 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class DeviceBufferHeap;
+class DeviceBufferView;
+class IBindGroup;
+class IQueue;
+class IRenderPassEncoder;
+class IRenderPipeline;
+
+/**
+ * @brief Static mesh handed to StaticBatcher, read during add() only
+ */
+struct StaticMesh {
+    static constexpr uint32_t NO_ATTRIBUTE = ~0u;
+
+    const void* vertices = nullptr;
+    uint32_t vertexCount = 0;
+    uint32_t vertexStride = 0;                 // Bytes per vertex, multiple of 4
+    uint32_t positionOffset = 0;               // float3 position inside a vertex
+    uint32_t normalOffset = NO_ATTRIBUTE;      // float3 normal, left untouched if absent
+    const uint32_t* indices = nullptr;
+    uint32_t indexCount = 0;
+
+    // Column-major model matrix baked into the vertices
+    std::array<float, 16> transform = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    std::shared_ptr<IRenderPipeline> pipeline;
+    std::shared_ptr<IBindGroup> material;
+};
+
+/**
+ * @brief One source mesh inside a StaticBatch, in world space
+ */
+struct StaticSubmesh {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+    std::array<float, 3> boundsMin = {};
+    std::array<float, 3> boundsMax = {};
+    std::array<float, 4> sphere = {};  // center.xyz, radius as GpuFrustumCuller reads it
+    uint32_t sourceIndex = 0;          // Position of the mesh among add() calls
+};
+
+/**
+ * @brief Merged geometry of meshes sharing pipeline, material and vertex layout
+ */
+struct StaticBatch {
+    std::shared_ptr<IRenderPipeline> pipeline;
+    std::shared_ptr<IBindGroup> material;
+    std::shared_ptr<DeviceBufferView> vertexBuffer;
+    std::shared_ptr<DeviceBufferView> indexBuffer;
+    IndexFormat indexFormat = IndexFormat::Uint32;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    std::vector<StaticSubmesh> submeshes;  // Contiguous index ranges, in add() order
+};
+
+/**
+ * @brief Load-time merger of small static meshes into a few large draws
+ *
+ * add() bakes each mesh's transform into a copy of its vertices (positions,
+ * and normals through the inverse transpose) and appends it to the group of
+ * meshes with the same pipeline, material and vertex stride. build() uploads
+ * every group into ranges of a DeviceBufferHeap as one StaticBatch and keeps
+ * per-submesh world bounds, so culling still works per source mesh.
+ *
+ * Typical load:
+ *   for (const auto& mesh : sceneMeshes) batcher.add(mesh);
+ *   auto batches = batcher.build();
+ *   ... per frame: batcher.record(pass, batch) or recordVisible(pass, batch, visibility) ...
+ *
+ * Indices are rebased, so every draw uses baseVertex 0, and narrowed to
+ * Uint16 when a batch has at most 65535 vertices. A group that would exceed
+ * maxBatchVertices starts a new batch. The heap needs Vertex | Index usage.
+ */
+class StaticBatcher {
+public:
+    static constexpr uint32_t DEFAULT_MAX_BATCH_VERTICES = 1u << 20;
+
+    struct Stats {
+        uint32_t meshes = 0;      // Meshes merged by the last build()
+        uint32_t batches = 0;     // Batches produced by the last build()
+        uint64_t vertexBytes = 0;
+        uint64_t indexBytes = 0;
+    };
+
+    /**
+     * @param heap Heap the merged buffers are allocated from
+     * @param queue Queue the merged geometry is written through
+     * @param maxBatchVertices Vertex limit of one batch
+     * @param vertexSlot Vertex buffer slot record() binds the batch to
+     * @param materialGroupIndex Bind group index the material is bound to
+     */
+    StaticBatcher(const std::shared_ptr<DeviceBufferHeap>& heap,
+                  const std::shared_ptr<IQueue>& queue,
+                  uint32_t maxBatchVertices = DEFAULT_MAX_BATCH_VERTICES,
+                  uint32_t vertexSlot = 0,
+                  uint32_t materialGroupIndex = 0);
+    ~StaticBatcher() = default;
+
+    StaticBatcher(const StaticBatcher&) = delete;
+    StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+    /**
+     * @brief Transform and queue a mesh; its arrays may be freed on return
+     * @return false if the mesh is malformed or larger than one batch
+     */
+    bool add(const StaticMesh& mesh);
+
+    /**
+     * @brief Upload every queued group and reset the batcher
+     * @return Batches in first-added order; a group whose upload failed is left out
+     */
+    std::vector<StaticBatch> build();
+
+    /**
+     * @brief Bind a batch and draw all of it
+     * Bind groups other than the material one must already be set.
+     */
+    void record(IRenderPassEncoder& pass, const StaticBatch& batch) const;
+
+    /**
+     * @brief Bind a batch and draw its visible submeshes
+     * Neighbouring visible submeshes share one drawIndexed.
+     * @param visible One entry per submesh, non-zero to draw it
+     * @return Number of draws recorded
+     */
+    uint32_t recordVisible(IRenderPassEncoder& pass,
+                           const StaticBatch& batch,
+                           std::span<const uint8_t> visible) const;
+
+    Stats getStats() const { return _stats; }
+
+private:
+    struct GroupKey {
+        const IRenderPipeline* pipeline = nullptr;
+        const IBindGroup* material = nullptr;
+        uint32_t vertexStride = 0;
+
+        bool operator==(const GroupKey& other) const;
+    };
+
+    struct GroupKeyHash {
+        size_t operator()(const GroupKey& key) const;
+    };
+
+    struct Group {
+        std::shared_ptr<IRenderPipeline> pipeline;
+        std::shared_ptr<IBindGroup> material;
+        std::vector<uint8_t> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<StaticSubmesh> submeshes;
+        uint32_t vertexCount = 0;
+    };
+
+    // Open group for the mesh, a fresh one if the current is full
+    Group& groupFor(const StaticMesh& mesh);
+    bool upload(const Group& group, StaticBatch& batch) const;
+    void bind(IRenderPassEncoder& pass, const StaticBatch& batch) const;
+
+    std::shared_ptr<DeviceBufferHeap> _heap;
+    std::shared_ptr<IQueue> _queue;
+    uint32_t _maxBatchVertices;
+    uint32_t _vertexSlot;
+    uint32_t _materialGroupIndex;
+
+    std::unordered_map<GroupKey, size_t, GroupKeyHash> _openGroups;
+    std::vector<Group> _groups;
+    uint32_t _meshCount = 0;
+    Stats _stats;
+};
+
+} // namespace pers
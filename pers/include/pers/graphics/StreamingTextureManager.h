@@ -0,0 +1,156 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/RenderResourceTable.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ITexture;
+class ITextureView;
+
+using StreamingTextureHandle = ResourceHandle<struct StreamingTextureHandleTag>;
+
+/**
+ * @brief Texture whose mip levels stream in on demand
+ */
+struct StreamingTextureDesc {
+    /**
+     * @brief Provide the pixels of one level of the full chain, tightly packed
+     * Called again whenever the level has to be re-uploaded, so the source
+     * must stay available (memory, file, archive) for the texture's lifetime.
+     */
+    using MipLoader = std::function<bool(uint32_t mipLevel, std::vector<uint8_t>& data)>;
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipLevelCount = 0;         // 0 = full chain
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    TextureUsage usage = TextureUsage::TextureBinding;
+    MipLoader loader;
+    std::string label;
+};
+
+/**
+ * @brief Keeps the detail of streamed textures in line with screen-space demand
+ *
+ * A texture starts with only the small tail of its mip chain resident, so
+ * it can be bound right away. Each frame callers report how large each
+ * texture appears on screen; update() then raises the most under-detailed
+ * textures first within a per-update upload budget and takes detail away
+ * from textures that no longer need it when the memory budget is exceeded.
+ * While GpuMemoryTracker reports usage over its budget, update() also
+ * lowers detail until the overshoot is covered.
+ *
+ * WebGPU has no sparse residency, so "resident mips" means the texture
+ * object is sized to the finest resident level: raising or lowering detail
+ * recreates it and re-uploads its levels from the loader. Normalized UVs
+ * are unaffected. The view changes when that happens, getVersion() tells
+ * bind group owners to rebuild. Replaced textures go to the device's
+ * DeferredDeletionQueue, so frames still in flight can finish sampling them.
+ */
+class StreamingTextureManager {
+public:
+    struct Config {
+        uint64_t memoryBudget = 256ull * 1024 * 1024;
+        uint64_t uploadBudgetPerUpdate = 8ull * 1024 * 1024;
+        uint32_t initialResidentSize = 64;   // Longest edge of the finest initially resident mip
+        uint32_t demandTimeoutFrames = 120;  // Updates without a report before demand drops to the tail
+    };
+
+    struct Stats {
+        uint32_t textureCount = 0;
+        uint64_t residentBytes = 0;
+        uint64_t uploadedBytes = 0;     // During the last update()
+        uint32_t raised = 0;            // Textures given more detail in the last update()
+        uint32_t lowered = 0;           // Textures evicted to fewer mips in the last update()
+        uint32_t pending = 0;           // Textures still below their wanted detail
+    };
+
+    explicit StreamingTextureManager(const std::shared_ptr<ILogicalDevice>& device);
+    StreamingTextureManager(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~StreamingTextureManager();
+
+    StreamingTextureManager(const StreamingTextureManager&) = delete;
+    StreamingTextureManager& operator=(const StreamingTextureManager&) = delete;
+
+    /**
+     * @brief Create a texture and upload its tail mips
+     * @return Handle, null if creation or the initial upload failed
+     */
+    StreamingTextureHandle add(const StreamingTextureDesc& desc);
+
+    bool remove(StreamingTextureHandle handle);
+
+    /**
+     * @brief Report the on-screen size of a texture this frame
+     * @param screenSize Pixels covered along the texture's longest edge; the
+     *        largest report per update wins
+     */
+    void reportUsage(StreamingTextureHandle handle, float screenSize);
+
+    /**
+     * @brief Apply demand: upload wanted mips and evict within the budgets
+     */
+    void update();
+
+    std::shared_ptr<ITextureView> getView(StreamingTextureHandle handle) const;
+    std::shared_ptr<ITexture> getTexture(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Incremented whenever the texture and view objects are replaced
+     */
+    uint64_t getVersion(StreamingTextureHandle handle) const;
+
+    /**
+     * @brief Finest resident level of the full chain, 0 = fully resident
+     */
+    uint32_t getResidentMip(StreamingTextureHandle handle) const;
+
+    const Config& getConfig() const { return _config; }
+    void setConfig(const Config& config) { _config = config; }
+    Stats getStats() const { return _stats; }
+
+private:
+    struct Entry {
+        StreamingTextureDesc desc;
+        std::shared_ptr<ITexture> texture;
+        std::shared_ptr<ITextureView> view;
+        uint32_t residentMip = 0;       // Finest level currently in the texture
+        uint32_t coarsestTopMip = 0;    // Lowest detail the texture is ever reduced to
+        uint64_t residentBytes = 0;
+        uint64_t version = 0;
+        float demand = 0.0f;            // Largest screen size reported since the last update
+        float lastDemand = 0.0f;
+        uint64_t lastReportFrame = 0;
+    };
+
+    struct Slot {
+        uint32_t generation = 0;  // Odd = live
+        Entry entry;
+    };
+
+    Entry* find(StreamingTextureHandle handle);
+    const Entry* find(StreamingTextureHandle handle) const;
+
+    uint32_t wantedMip(const Entry& entry) const;
+    uint64_t bytesFrom(const Entry& entry, uint32_t topMip) const;
+    bool rebuild(Entry& entry, uint32_t topMip);
+    void retire(Entry& entry);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeList;
+    uint64_t _frame = 0;
+    uint64_t _residentBytes = 0;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Callback invoked when all work submitted before registration has completed
+ * @param success false if the queue reported an error or the device was lost
+ */
+using QueueWorkDoneCallback = std::function<void(bool success)>;
+
+/**
+ * @brief Monotonic timeline of queue submissions
+ *
+ * Each submit takes the next value with signal() and the backend calls
+ * complete() from its work-done callback. Queues retire work in order, so
+ * completing a value implicitly completes every earlier one.
+ *
+ * Owned by the queue and shared with outstanding fences.
+ */
+class SubmissionTimeline {
+public:
+    /**
+     * @brief Drives backend completion callbacks without blocking
+     */
+    using PollFunction = std::function<void()>;
+
+    /**
+     * @brief Hands deferred work up to value to the backend before it is waited on
+     */
+    using FlushFunction = std::function<void(uint64_t value)>;
+
+    explicit SubmissionTimeline(PollFunction poll = nullptr);
+
+    SubmissionTimeline(const SubmissionTimeline&) = delete;
+    SubmissionTimeline& operator=(const SubmissionTimeline&) = delete;
+
+    /**
+     * @brief Allocate the value for a new submission
+     * @return Timeline value, starting at 1
+     */
+    uint64_t signal();
+
+    /**
+     * @brief Mark all values up to and including value as complete
+     * @param value Completed timeline value
+     * @param success false if the submission failed or the device was lost
+     */
+    void complete(uint64_t value, bool success);
+
+    /**
+     * @brief Replace the poll function, nullptr once the backend is gone
+     */
+    void setPollFunction(PollFunction poll);
+
+    /**
+     * @brief Replace the flush function used by wait(), nullptr to clear
+     */
+    void setFlushFunction(FlushFunction flush);
+
+    uint64_t getCompletedValue() const;
+    uint64_t getLastSubmittedValue() const;
+    bool isComplete(uint64_t value) const;
+
+    /**
+     * @brief Block until value completes or the timeout expires
+     * @return true if value completed successfully
+     */
+    bool wait(uint64_t value, std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Invoke callback once value completes
+     * Runs immediately on the calling thread if value already completed.
+     */
+    void then(uint64_t value, QueueWorkDoneCallback callback);
+
+private:
+    struct PendingCallback {
+        uint64_t value;
+        QueueWorkDoneCallback callback;
+    };
+
+    void poll();
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    uint64_t _submittedValue = 0;
+    uint64_t _completedValue = 0;
+    uint64_t _lastSuccessValue = 0;  // Values at or below completed successfully
+    std::vector<PendingCallback> _callbacks;
+
+    std::mutex _pollMutex;  // Separate so completion callbacks fired by poll can take _mutex
+    PollFunction _poll;
+    FlushFunction _flush;
+};
+
+/**
+ * @brief Lightweight handle to one queue submission
+ *
+ * Returned by IQueue::submit. Copyable; it holds a reference to the queue's
+ * timeline and the value assigned to the submission. A default constructed
+ * fence is invalid and represents a failed submit, so existing
+ * `if (!queue->submit(...))` checks keep working.
+ */
+class SubmissionFence {
+public:
+    static constexpr std::chrono::milliseconds DEFAULT_WAIT_TIMEOUT{30000};
+
+    SubmissionFence() = default;
+    SubmissionFence(std::shared_ptr<SubmissionTimeline> timeline, uint64_t value);
+
+    /**
+     * @brief Check whether the submit succeeded
+     */
+    bool isValid() const { return _timeline != nullptr; }
+    explicit operator bool() const { return isValid(); }
+
+    /**
+     * @brief Timeline value of the submission, 0 for an invalid fence
+     */
+    uint64_t getValue() const { return _value; }
+
+    /**
+     * @brief Check completion without blocking
+     * Does not poll the backend; completion is observed once callbacks run.
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Poll the backend until the submission completes
+     * @param timeout Maximum time to wait
+     * @return true if the submission completed successfully in time
+     */
+    bool wait(std::chrono::milliseconds timeout = DEFAULT_WAIT_TIMEOUT) const;
+
+    /**
+     * @brief Register a continuation for the submission
+     * Invoked immediately with false for an invalid fence.
+     */
+    void then(QueueWorkDoneCallback callback) const;
+
+private:
+    std::shared_ptr<SubmissionTimeline> _timeline;
+    uint64_t _value = 0;
+};
+
+} // namespace pers
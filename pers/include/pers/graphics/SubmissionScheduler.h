@@ -0,0 +1,93 @@
+#pragma once
+
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IQueue;
+class ICommandBuffer;
+
+/**
+ * @brief Kind of work a queued command buffer carries
+ */
+enum class SubmissionKind {
+    Render,
+    // Compute consumed by the next render submission (skinning, culling)
+    DependentCompute,
+    // Compute nothing later in the frame reads (simulation for the next frame)
+    IndependentCompute
+};
+
+/**
+ * @brief Orders a frame's command buffers so compute overlaps rasterization
+ *
+ * Command buffers are queued with a kind and handed to the queue on flush().
+ * Render and dependent compute keep their relative order. Independent
+ * compute is spread between render submissions, starting after the first,
+ * so no long kernel sits in front of the frame or after the last draw.
+ *
+ * When the device has a dedicated compute queue (ILogicalDevice::getComputeQueue
+ * differs from getQueue) independent compute is submitted there instead; the
+ * caller waits on ScheduledSubmission::compute before reading its results.
+ * On a shared queue everything goes out in one submit.
+ */
+class SubmissionScheduler {
+public:
+    struct ScheduledSubmission {
+        SubmissionFence graphics;
+        SubmissionFence compute;  // Same as graphics on a shared queue
+    };
+
+    struct Stats {
+        uint64_t flushes = 0;
+        uint64_t renderBuffers = 0;
+        uint64_t dependentComputeBuffers = 0;
+        uint64_t independentComputeBuffers = 0;
+        uint64_t asyncQueueSubmits = 0;
+    };
+
+    explicit SubmissionScheduler(const std::shared_ptr<ILogicalDevice>& device);
+    ~SubmissionScheduler() = default;
+
+    SubmissionScheduler(const SubmissionScheduler&) = delete;
+    SubmissionScheduler& operator=(const SubmissionScheduler&) = delete;
+
+    /**
+     * @brief Queue a command buffer for the next flush
+     * @return false if the command buffer is null
+     */
+    bool enqueue(const std::shared_ptr<ICommandBuffer>& commandBuffer, SubmissionKind kind);
+
+    /**
+     * @brief Submit everything queued since the last flush
+     * @return Fences of the submissions, invalid on failure
+     */
+    ScheduledSubmission flush();
+
+    bool hasAsyncComputeQueue() const { return _computeQueue != _graphicsQueue; }
+    Stats getStats() const;
+
+private:
+    struct Pending {
+        std::shared_ptr<ICommandBuffer> commandBuffer;
+        SubmissionKind kind;
+    };
+
+    // Graphics queue order with independent compute interleaved
+    static std::vector<std::shared_ptr<ICommandBuffer>> interleave(const std::vector<Pending>& pending,
+                                                                   bool includeIndependent);
+
+    std::shared_ptr<IQueue> _graphicsQueue;
+    std::shared_ptr<IQueue> _computeQueue;
+
+    mutable Mutex<false> _mutex;
+    std::vector<Pending> _pending;
+    Stats _stats;
+};
+
+} // namespace pers
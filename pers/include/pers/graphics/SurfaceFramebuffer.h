@@ -5,7 +5,10 @@
 #include "pers/graphics/ILogicalDevice.h"
 #include "pers/graphics/IResourceFactory.h"
 #include "pers/graphics/SwapChainDescBuilder.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 namespace pers {
 
@@ -16,6 +19,23 @@ namespace pers {
  * for surface rendering. It automatically manages an associated depth buffer
  * and provides a consistent API regardless of the graphics backend.
  * 
+ * With SwapChainDesc::msaaLevel above None, color attachment 0 is a
+ * multisampled render-only texture resolving into the swap chain image
+ * (getResolveTarget), and the depth buffer uses the same sample count.
+ * RenderPassConfig discards the multisampled contents after the resolve.
+ * 
+ * resize() only records the requested size. The swap chain, multisampled
+ * color and depth buffers are recreated once at the next acquireNextImage(),
+ * so a burst of resize events during a window drag costs one reconfigure.
+ * getWidth()/getHeight() report the size of the current attachments.
+ * 
+ * With SwapChainDesc::presentThread, present() hands the frame to a present
+ * thread and returns. That thread presents it, applies a pending resize and
+ * acquires the next image ahead of time; acquireNextImage() waits for that
+ * image. Work done between present() and the next acquireNextImage()
+ * (simulation, culling, offscreen passes) overlaps the vsync wait. Attachments
+ * and getWidth()/getHeight() may only be read while an image is acquired.
+ * 
  * The actual SwapChain implementation (WebGPU, Vulkan, D3D12, etc.) is
  * created through the ILogicalDevice interface, making this class completely
  * backend-agnostic.
@@ -40,6 +60,7 @@ public:
     TextureFormat getDepthFormat() const override;
     uint32_t getColorAttachmentCount() const override;
     bool hasDepthStencilAttachment() const override;
+    std::shared_ptr<ITextureView> getResolveTarget(uint32_t index = 0) const override;
     
     // IResizableFramebuffer interface
     bool resize(uint32_t width, uint32_t height) override;
@@ -51,6 +72,7 @@ public:
     bool acquireNextImage() override;
     void present() override;
     bool isReady() const override;
+    std::shared_ptr<ITexture> getCurrentTexture() const override;
     void setDepthFramebuffer(const std::shared_ptr<IFramebuffer>& depthFramebuffer) override;
     
     /**
@@ -61,18 +83,44 @@ public:
     
 private:
     void createDepthBuffer();
+    void createMultisampleBuffer();
+    bool applyPendingResize();
+    std::shared_ptr<ITextureView> acquireFromSwapChain();
+    void startPresentThread();
+    void stopPresentThread();
+    void runPresentThread();
     
 private:
     std::shared_ptr<ILogicalDevice> _device;
     std::shared_ptr<ISwapChain> _swapChain;
     std::shared_ptr<IFramebuffer> _depthFramebuffer;
+    std::shared_ptr<IFramebuffer> _msaaFramebuffer;
     std::shared_ptr<ITextureView> _currentColorView;
     
     uint32_t _width;
     uint32_t _height;
     TextureFormat _format;
     TextureFormat _depthFormat;
+    uint32_t _sampleCount;
     bool _acquired;
+    
+    // Latest size requested by resize(), applied at acquire time
+    std::mutex _resizeMutex;
+    uint32_t _pendingWidth;
+    uint32_t _pendingHeight;
+    bool _resizePending;
+    
+    // Present thread handoff, guarded by _presentMutex
+    std::thread _presentThread;
+    std::mutex _presentMutex;
+    std::condition_variable _presentCv;  // Wakes the present thread
+    std::condition_variable _readyCv;    // Wakes acquireNextImage()
+    std::shared_ptr<ITextureView> _nextColorView;
+    bool _presentPending = false;        // Frame handed off, not yet presented
+    bool _acquireRequested = false;      // Present thread should acquire the next image
+    bool _imageReady = false;            // _nextColorView holds the acquire result
+    bool _stopPresent = false;
+
     SurfaceCapabilities _surfaceCapabilities;
 };
 
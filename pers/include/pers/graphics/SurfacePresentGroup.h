@@ -0,0 +1,92 @@
+#pragma once
+
+#include "pers/graphics/SubmissionFence.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class IQueue;
+class ICommandBuffer;
+class ISurfaceFramebuffer;
+
+/**
+ * @brief Presents several surfaces of one device with a single submission
+ *
+ * Multi-viewport tools create one SurfaceFramebuffer per window on the same
+ * logical device and add them here. Each frame acquires every surface,
+ * lets each viewport record into its own slot, submits all command buffers
+ * in one queue submission and then presents the surfaces in order:
+ *
+ *     group.acquireAll();
+ *     for (uint32_t i = 0; i < group.getSurfaceCount(); ++i) {
+ *         if (group.isAcquired(i)) {
+ *             group.setCommandBuffer(i, recordViewport(i, *group.getSurface(i)));
+ *         }
+ *     }
+ *     getFramePacer().trackSubmission(group.submitAndPresent());
+ *
+ * Surfaces that fail to acquire, e.g. minimized windows, are skipped for
+ * the frame. setCommandBuffer() writes only its own slot, so viewports may
+ * record on different jobs; acquireAll() and submitAndPresent() must not
+ * overlap with them.
+ */
+class SurfacePresentGroup {
+public:
+    explicit SurfacePresentGroup(const std::shared_ptr<IQueue>& queue);
+    ~SurfacePresentGroup() = default;
+
+    SurfacePresentGroup(const SurfacePresentGroup&) = delete;
+    SurfacePresentGroup& operator=(const SurfacePresentGroup&) = delete;
+
+    /**
+     * @return Slot index of the surface, stable until it is removed
+     */
+    uint32_t addSurface(const std::shared_ptr<ISurfaceFramebuffer>& surface);
+
+    /**
+     * @brief Remove a surface; later surfaces move down one slot
+     */
+    void removeSurface(const std::shared_ptr<ISurfaceFramebuffer>& surface);
+
+    uint32_t getSurfaceCount() const { return static_cast<uint32_t>(_slots.size()); }
+    const std::shared_ptr<ISurfaceFramebuffer>& getSurface(uint32_t index) const { return _slots[index].surface; }
+
+    /**
+     * @brief Acquire the next image of every surface
+     * @return Number of surfaces acquired
+     */
+    uint32_t acquireAll();
+    bool isAcquired(uint32_t index) const { return _slots[index].acquired; }
+
+    /**
+     * @brief Command buffer rendering into the surface at index, submitted in slot order
+     */
+    void setCommandBuffer(uint32_t index, const std::shared_ptr<ICommandBuffer>& commandBuffer);
+
+    /**
+     * @brief Work not tied to one surface (uploads, shared passes), submitted before the slots
+     */
+    void addSharedCommandBuffer(const std::shared_ptr<ICommandBuffer>& commandBuffer);
+
+    /**
+     * @brief Submit every recorded command buffer at once, then present each acquired surface
+     * @return Fence of the submission, empty if nothing was recorded
+     */
+    SubmissionFence submitAndPresent();
+
+private:
+    struct Slot {
+        std::shared_ptr<ISurfaceFramebuffer> surface;
+        std::shared_ptr<ICommandBuffer> commandBuffer;
+        bool acquired = false;
+    };
+
+    std::shared_ptr<IQueue> _queue;
+    std::vector<Slot> _slots;
+    std::vector<std::shared_ptr<ICommandBuffer>> _sharedCommandBuffers;
+    std::vector<std::shared_ptr<ICommandBuffer>> _submission;  // Reused between frames
+};
+
+} // namespace pers
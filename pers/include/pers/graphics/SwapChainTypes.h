@@ -84,6 +84,10 @@ struct SwapChainDesc {
     // MSAA level (defaults to no MSAA)
     MSAALevel msaaLevel = MSAALevel::None;
     
+    // SurfaceFramebuffer presents and acquires on its own thread, so a present
+    // blocked on vsync (Fifo) does not stall the caller
+    bool presentThread = false;
+    
     // Optional
     std::string debugName;
 };
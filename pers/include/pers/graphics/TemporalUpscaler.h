@@ -0,0 +1,129 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class ISampler;
+class IFramebuffer;
+class DeviceBuffer;
+
+struct TemporalUpscalerConfig {
+    uint32_t jitterPhases = 16;   // Length of the Halton(2, 3) jitter cycle
+    float feedback = 0.9f;        // Weight of the reprojected history
+};
+
+/**
+ * @brief Temporal upscaling and anti-aliasing into a native-resolution target
+ *
+ * Renders at a lower internal resolution (0.7 per axis halves the shaded
+ * pixels) and reconstructs the native image by accumulating jittered frames:
+ *
+ *     upscaler.beginFrame();
+ *     const auto jitter = upscaler.getClipJitter(renderWidth, renderHeight);
+ *     projection[2][0] += jitter[0];   // column-major, before the view matrix
+ *     projection[2][1] += jitter[1];
+ *     ... render color (attachment 0) and motion vectors (attachment 1)
+ *         into the top-left renderWidth x renderHeight of scene ...
+ *     upscaler.resolve(*encoder, scene, renderWidth, renderHeight, surfaceFramebuffer);
+ *
+ * createSceneConfig() describes a matching scene target. Motion vectors are
+ * previous minus current position in viewport UV (0..1, y down), written by
+ * the scene's shaders without jitter. Each destination pixel samples the
+ * current frame at its jittered position, reprojects the history along the
+ * motion vector, clamps it to the 3x3 neighbourhood of the current color
+ * to reject disoccluded and stale samples, and blends by feedback. The
+ * result is written to the destination and to the next history, both in
+ * one render pass; history lives in two RGBA16Float OffscreenFramebuffers
+ * at destination size, recreated when it changes.
+ *
+ * The render size may change every frame, as DynamicResolution does;
+ * motion vectors in UV keep the history valid across the change. Call
+ * reset() on camera cuts. Uniforms reach the GPU through IQueue::writeBuffer,
+ * so call resolve() once per submission.
+ */
+class TemporalUpscaler {
+public:
+    static constexpr TextureFormat HISTORY_FORMAT = TextureFormat::RGBA16Float;
+    static constexpr TextureFormat MOTION_VECTOR_FORMAT = TextureFormat::RG16Float;
+    static constexpr uint32_t MOTION_VECTOR_ATTACHMENT = 1;
+
+    explicit TemporalUpscaler(const std::shared_ptr<ILogicalDevice>& device,
+                              const TemporalUpscalerConfig& config = {});
+    ~TemporalUpscaler();
+
+    TemporalUpscaler(const TemporalUpscaler&) = delete;
+    TemporalUpscaler& operator=(const TemporalUpscaler&) = delete;
+
+    bool isValid() const { return _pipelineLayout != nullptr; }
+
+    /**
+     * @brief Scene target at maximum render size: color, motion vectors and depth
+     */
+    static OffscreenFramebufferConfig createSceneConfig(uint32_t width, uint32_t height,
+                                                        TextureFormat colorFormat = TextureFormat::RGBA16Float,
+                                                        TextureFormat depthFormat = TextureFormat::Depth24Plus);
+
+    /**
+     * @brief Advance to the next jitter phase
+     */
+    void beginFrame();
+
+    /**
+     * @brief Drop the history, e.g. on a camera cut
+     */
+    void reset() { _historyValid = false; }
+
+    /**
+     * @brief Sub-pixel offset of this frame in render pixels, within (-0.5, 0.5)
+     */
+    std::array<float, 2> getJitter() const { return _jitter; }
+
+    /**
+     * @brief The same offset in clip space, to add to the projection's x/y translation
+     */
+    std::array<float, 2> getClipJitter(uint32_t renderWidth, uint32_t renderHeight) const;
+
+    const TemporalUpscalerConfig& getConfig() const { return _config; }
+    void setConfig(const TemporalUpscalerConfig& config) { _config = config; }
+
+    /**
+     * @brief Record the reconstruction of scene's rendered region into destination
+     * @return false if an attachment is missing or a resource failed to create
+     */
+    bool resolve(ICommandEncoder& encoder, const OffscreenFramebuffer& scene,
+                 uint32_t renderWidth, uint32_t renderHeight, const IFramebuffer& destination);
+
+private:
+    bool prepareHistory(uint32_t width, uint32_t height);
+    std::shared_ptr<IRenderPipeline> getPipeline(TextureFormat format);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    TemporalUpscalerConfig _config;
+    uint32_t _phase = 0;
+    std::array<float, 2> _jitter{0.0f, 0.0f};
+    bool _historyValid = false;
+    uint32_t _historyIndex = 0;  // History written by the next resolve
+    std::array<std::unique_ptr<OffscreenFramebuffer>, 2> _history;
+
+    std::shared_ptr<DeviceBuffer> _uniformBuffer;
+    std::shared_ptr<ISampler> _sampler;
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::unordered_map<TextureFormat, std::shared_ptr<IRenderPipeline>> _pipelines;
+};
+
+} // namespace pers
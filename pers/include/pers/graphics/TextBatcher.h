@@ -0,0 +1,144 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class IRenderPipeline;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class ISampler;
+class DynamicBuffer;
+class GlyphAtlas;
+
+struct TextStyle {
+    float size = 16.0f;           // Pixel size, scaled from the atlas size
+    uint32_t color = 0xFFFFFFFF;  // Unorm8x4 in memory order, see DebugDraw::rgba
+    float lineSpacing = 1.0f;     // Multiplier of the font's line height
+};
+
+/**
+ * @brief Lays out UTF-8 strings as glyph quads and draws all of them at once
+ *
+ * addText() resolves each codepoint through the GlyphAtlas, applies
+ * kerning and line breaks, and appends one instance per visible glyph to
+ * a CPU list. render() copies the list into a DynamicBuffer ring and draws
+ * every string of the frame with one pipeline, one bind group and one
+ * instanced draw of six vertices per glyph, however many labels there are.
+ *
+ *     batcher.addText(x, y, label, style);   // Any number of strings
+ *     batcher.prepare(*encoder);             // Uploads new glyphs, before the pass
+ *     batcher.render(*pass, target, width, height);
+ *     pass->end();
+ *     batcher.flush();                       // before queue submit
+ *     queue->submit(encoder->finish());
+ *     batcher.nextFrame();                   // after queue submit, clears the text
+ *
+ * Glyphs are distance fields, so one atlas serves every size. There is no
+ * blend state: single-sampled targets alpha-test at the outline, and
+ * multisampled targets use alpha-to-coverage for antialiased edges.
+ * Coordinates are pixels from the top-left corner, y at the top of the
+ * first line.
+ */
+class TextBatcher {
+public:
+    struct Config {
+        uint64_t bufferSize = 4 << 20;  // Per frame, about 95k glyphs
+        uint32_t frameCount = 3;
+    };
+
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::BGRA8Unorm;
+        TextureFormat depthFormat = TextureFormat::Undefined;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    TextBatcher(const std::shared_ptr<ILogicalDevice>& device, const std::shared_ptr<GlyphAtlas>& atlas,
+                const Config& config);
+    ~TextBatcher();
+
+    TextBatcher(const TextBatcher&) = delete;
+    TextBatcher& operator=(const TextBatcher&) = delete;
+
+    bool isValid() const { return _pipelineLayout != nullptr; }
+
+    /**
+     * @return Size of the laid out text, width of the widest line by total height
+     */
+    std::array<float, 2> addText(float x, float y, std::string_view utf8, const TextStyle& style);
+
+    /**
+     * @brief Size addText() would lay the text out at, without adding it
+     */
+    std::array<float, 2> measure(std::string_view utf8, const TextStyle& style);
+
+    /**
+     * @brief Upload glyphs first used this frame; record before the pass render() draws into
+     */
+    bool prepare(ICommandEncoder& encoder);
+
+    /**
+     * @brief Upload this frame's glyphs and record the draw
+     * May be called once per view; text stays until nextFrame().
+     * @return false if nothing was drawn
+     */
+    bool render(IRenderPassEncoder& pass, const Target& target, uint32_t viewportWidth, uint32_t viewportHeight);
+
+    /**
+     * @brief Upload what render() wrote; call before queue submit
+     */
+    bool flush();
+
+    /**
+     * @brief Advance the buffer ring and clear the text; call after queue submit
+     */
+    void nextFrame();
+
+    void clear() { _quads.clear(); }
+
+    size_t getGlyphCount() const { return _quads.size(); }
+    uint64_t getDroppedCount() const { return _droppedCount; }
+
+private:
+    struct GlyphQuad {
+        float rect[4];        // x0, y0, x1, y1 in pixels
+        float uvRect[4];
+        uint32_t page;
+        uint32_t color;
+        float distanceRange;  // Screen pixels spanned by the field's 0..1 range
+    };
+
+    struct PipelineEntry {
+        Target target;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    std::array<float, 2> layout(float x, float y, std::string_view utf8, const TextStyle& style, bool emit);
+    std::shared_ptr<IRenderPipeline> getPipeline(const Target& target);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::shared_ptr<GlyphAtlas> _atlas;
+    std::unique_ptr<DynamicBuffer> _buffer;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<ISampler> _sampler;
+    std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::vector<PipelineEntry> _pipelines;
+
+    std::vector<GlyphQuad> _quads;
+    uint64_t _droppedCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/utils/CpuMemoryTracker.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ImmediateStagingBuffer;
+class ITexture;
+class ITextureView;
+
+/**
+ * @brief Skyline bottom-left packer for one rectangular page
+ *
+ * Keeps the top edge of the packed area as a list of horizontal segments
+ * and places each rectangle where its top ends lowest, ties broken by the
+ * narrower segment. Space below the skyline is never reused, which suits
+ * atlases filled incrementally with many small images.
+ */
+class SkylinePacker {
+public:
+    SkylinePacker(uint32_t width, uint32_t height);
+
+    /**
+     * @return false if the rectangle does not fit anywhere on the page
+     */
+    bool pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y);
+    void reset();
+
+    float getOccupancy() const;
+
+private:
+    struct Segment {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    // Height the rectangle would rest at when its left edge is at segment index
+    bool fits(size_t index, uint32_t width, uint32_t height, uint32_t& y) const;
+
+    std::vector<Segment> _skyline;
+    uint32_t _width;
+    uint32_t _height;
+    uint64_t _usedArea = 0;
+};
+
+/**
+ * @brief Placement of one image in a TextureAtlas
+ */
+struct AtlasRegion {
+    uint32_t page = 0;     // Array layer of the atlas texture
+    uint32_t x = 0;        // Texel rectangle of the image, padding excluded
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::array<float, 4> uvRect{};  // u0, v0, u1, v1
+};
+
+/**
+ * @brief Dynamic atlas packing many small images into one texture array
+ *
+ * Each page is a layer of one D2Array texture, so every image in the atlas
+ * is drawn through one view and one bind group. add() packs the image with
+ * SkylinePacker, copies it into a CPU batch with its edge texels
+ * replicated into the padding, and returns the region right away; flush()
+ * uploads the whole batch:
+ *
+ *     auto icon = atlas.add(pixels, 24, 24);        // Sample uvRect on layer page
+ *     ...
+ *     atlas.flush(*encoder);                        // One staging buffer, one copy per image
+ *     queue->submit(encoder->finish());
+ *
+ * flush(encoder) stages the batch in one pooled ImmediateStagingBuffer and
+ * records a buffer-to-texture copy per image; the buffer is released on
+ * the next flush, so the encoder must be submitted before then. flush()
+ * without an encoder writes each image through IQueue::writeTexture,
+ * cheaper for a handful of images.
+ *
+ * When every page is full a page is added up to maxPages. Adding layers
+ * recreates the texture with twice as many and copies the old pages over on
+ * the GPU during flush; getVersion() changes so bind groups can be rebuilt.
+ * Only uncompressed formats are supported.
+ */
+class TextureAtlas {
+public:
+    struct Config {
+        uint32_t pageSize = 2048;
+        uint32_t initialPages = 1;
+        uint32_t maxPages = 8;
+        uint32_t padding = 1;  // Texels around each image, filled from its edges
+        TextureFormat format = TextureFormat::RGBA8Unorm;
+        std::string label = "TextureAtlas";
+    };
+
+    TextureAtlas(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    bool isValid() const { return _texture != nullptr; }
+
+    /**
+     * @brief Place an image and queue its upload
+     * @param pixels Texels in the atlas format
+     * @param bytesPerRow Source row pitch, 0 for tightly packed
+     * @return Region, or nullopt if it does not fit even on a new page
+     */
+    std::optional<AtlasRegion> add(const void* pixels, uint32_t width, uint32_t height, uint32_t bytesPerRow = 0);
+
+    /**
+     * @brief Record growth copies and every queued upload into encoder
+     */
+    bool flush(ICommandEncoder& encoder);
+
+    /**
+     * @brief Upload queued images through the queue, submitting growth copies itself
+     */
+    bool flush();
+
+    /**
+     * @brief Forget every region and pack from an empty atlas
+     * The texture keeps its pages; old texels stay until overwritten.
+     */
+    void clear();
+
+    const std::shared_ptr<ITexture>& getTexture() const { return _texture; }
+    const std::shared_ptr<ITextureView>& getView() const { return _view; }  // D2Array over all layers
+    uint32_t getPageCount() const { return static_cast<uint32_t>(_pages.size()); }
+    uint32_t getVersion() const { return _version; }
+    size_t getPendingCount() const { return _pending.size(); }
+
+private:
+    struct PendingUpload {
+        uint32_t page;
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;        // Padding included
+        uint32_t height;
+        uint64_t dataOffset;   // Into _pendingData, tightly packed rows
+    };
+
+    bool createTexture(uint32_t layers);
+    bool recordGrowth(ICommandEncoder& encoder);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    uint32_t _texelBytes = 0;
+
+    std::vector<SkylinePacker> _pages;
+    std::shared_ptr<ITexture> _texture;
+    std::shared_ptr<ITextureView> _view;
+    std::shared_ptr<ITexture> _retiredTexture;  // Source of the pending growth copy
+    uint32_t _retiredLayers = 0;
+    uint32_t _version = 0;
+
+    std::vector<PendingUpload> _pending;
+    TaggedVector<uint8_t, MemoryTag::Loaders> _pendingData;
+    std::shared_ptr<ImmediateStagingBuffer> _staging;  // Read by the last flushed encoder
+};
+
+} // namespace pers
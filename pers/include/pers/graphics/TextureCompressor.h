@@ -0,0 +1,117 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ITexture;
+class IComputePipeline;
+class IBindGroupLayout;
+class DeviceBuffer;
+class DynamicBuffer;
+
+/**
+ * @brief Block-compresses rendered or uploaded textures on the GPU
+ *
+ * Each 4x4 block is encoded by one compute invocation into a scratch
+ * storage buffer laid out in 256-byte aligned block rows, which
+ * copyBufferToTexture then moves into the compressed texture; no data
+ * passes through the CPU. The encoders favour speed over quality:
+ *
+ * - BC1:  endpoints on the bounding-box diagonal, inset by 1/16, four-colour mode
+ * - BC3:  BC1 colour plus an eight-value interpolated alpha block
+ * - BC7:  mode 6 only, one RGBA subset on the box diagonal, 7-bit endpoints and p-bits
+ * - ETC2 RGB8: ETC1 individual or differential mode, both flips tried
+ * - ETC2 RGBA8: the RGB block plus an EAC alpha block, all 16 tables tried
+ *
+ * so a 2048x2048 RGBA8 texture drops from 16 MiB to 2 MiB (BC1, ETC2 RGB)
+ * or 4 MiB (BC3, BC7, ETC2 RGBA) per level at the cost of one dispatch.
+ *
+ *     auto compressed = compressor.compress(*encoder, renderedTexture, compressor.selectFormat(true, true));
+ *     compressor.flush();                // before queue submit
+ *     queue->submit(encoder->finish());
+ *     compressor.nextFrame();            // after queue submit
+ *
+ * The source needs TextureBinding usage and a filterable float format;
+ * values are clamped to [0, 1]. Blocks store the values the source stores,
+ * sRGB sources are re-encoded after the view decodes them, so pair sRGB
+ * sources with sRGB targets. Levels larger than the scratch buffer are
+ * encoded in bands of block rows. The target family's feature must be
+ * enabled on the device, see TextureFormatSelector::getCompressionFeatures().
+ */
+class TextureCompressor {
+public:
+    static constexpr uint32_t BLOCK_SIZE = 4;
+
+    struct Config {
+        uint64_t scratchSize = 4u << 20;         // Encoded blocks per band, lowered to the binding limit
+        uint64_t parameterBufferSize = 1 << 14;  // Per frame, 256 bytes per dispatch
+        uint32_t frameCount = 3;
+    };
+
+    TextureCompressor(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~TextureCompressor();
+
+    TextureCompressor(const TextureCompressor&) = delete;
+    TextureCompressor& operator=(const TextureCompressor&) = delete;
+
+    bool isValid() const { return _blocks != nullptr; }
+
+    /**
+     * @brief Whether a target format has an encoder (BC1, BC3, BC7, ETC2 RGB8/RGBA8)
+     */
+    static bool supportsFormat(TextureFormat format);
+
+    /**
+     * @brief Format the device can sample: BC7 or BC1, else ETC2 RGBA8 or RGB8
+     * @param alpha The alpha channel carries data
+     * @return Undefined when the device enabled neither compression feature
+     */
+    TextureFormat selectFormat(bool alpha, bool srgb) const;
+
+    /**
+     * @brief Create a texture of the format holding every mip level of source
+     * @param usage Usage of the new texture, CopyDst is always added
+     * @return nullptr if the source is unsuitable, its size is not a multiple
+     *         of BLOCK_SIZE, or recording failed
+     */
+    std::shared_ptr<ITexture> compress(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& source,
+                                       TextureFormat format,
+                                       TextureUsage usage = TextureUsage::TextureBinding);
+
+    /**
+     * @brief Encode one level of source into a level of the same size of target
+     * @return false if the textures are unsuitable or the parameter buffer is full
+     */
+    bool compressLevel(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& source, uint32_t sourceMip,
+                       const std::shared_ptr<ITexture>& target, uint32_t targetMip);
+
+    bool flush();
+    void nextFrame();
+
+private:
+    enum Encoder : uint32_t {
+        Bc1,
+        Bc3,
+        Bc7,
+        Etc2Rgb,
+        Etc2Rgba,
+        EncoderCount
+    };
+
+    std::shared_ptr<IComputePipeline> getPipeline(Encoder encoder);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::shared_ptr<DeviceBuffer> _blocks;
+    std::unique_ptr<DynamicBuffer> _parameters;
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::array<std::shared_ptr<IComputePipeline>, EncoderCount> _pipelines;
+};
+
+} // namespace pers
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief What a texture stores, decides which block format fits it
+ */
+enum class TextureContent {
+    Color,          // Opaque RGB (albedo without alpha)
+    ColorAlpha,     // RGB with meaningful alpha
+    NormalMap,      // Two channels, Z reconstructed in the shader
+    SingleChannel,  // Masks, roughness, height
+    HDR             // Unsigned float RGB (environment maps, lightmaps)
+};
+
+/**
+ * @brief Picks texture formats based on the adapter's compression features
+ *
+ * Block compression keeps textures compressed in GPU memory and during
+ * upload: BC1/ETC2 RGB store 0.5 bytes per texel and BC7/ASTC 4x4 one byte,
+ * against four bytes for RGBA8. Families are tried in order BC, ASTC, ETC2
+ * (best quality per bit first) and the uncompressed fallback is used when
+ * the adapter supports none of them.
+ *
+ * A compressed format can only be created on a device that enabled the
+ * matching feature, so add getCompressionFeatures() to the device's
+ * requiredFeatures on creation.
+ */
+class TextureFormatSelector {
+public:
+    explicit TextureFormatSelector(const PhysicalDeviceCapabilities& capabilities);
+
+    /**
+     * @brief Best supported format for the content
+     * @param srgb Color data is sRGB encoded; ignored for non-color content
+     * @return Compressed format when available, else the uncompressed fallback
+     */
+    TextureFormat select(TextureContent content, bool srgb) const;
+
+    /**
+     * @brief Compressed format from the first supported family, or Undefined
+     */
+    TextureFormat selectCompressed(TextureContent content, bool srgb) const;
+
+    bool isSupported(TextureFormat format) const;
+    bool isFamilySupported(TextureCompressionFamily family) const;
+
+    /**
+     * @brief Features to request on device creation for every supported family
+     */
+    std::vector<DeviceFeature> getCompressionFeatures() const;
+
+    /**
+     * @brief Uncompressed format holding the same content
+     */
+    static TextureFormat getUncompressedFormat(TextureContent content, bool srgb);
+
+    /**
+     * @brief Format of a family for the content, Undefined if the family has none
+     */
+    static TextureFormat getCompressedFormat(TextureCompressionFamily family, TextureContent content, bool srgb);
+
+private:
+    bool _bc = false;
+    bool _etc2 = false;
+    bool _astc = false;
+};
+
+} // namespace pers
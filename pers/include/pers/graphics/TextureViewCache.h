@@ -0,0 +1,59 @@
+#pragma once
+
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/CpuMemoryTracker.h"
+#include "pers/utils/Mutex.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Views of one texture, deduplicated by TextureViewDesc
+ *
+ * Owned by the backend texture, so render graph setup, framebuffers and mip
+ * passes asking for the same view every frame get one native view back
+ * instead of a new one. Views are keyed by every desc field except label;
+ * the first requester's label sticks. A texture has few distinct views, so
+ * entries are a short vector scanned under one lock.
+ *
+ * Cached views hold no reference to their texture and are released with it.
+ */
+class TextureViewCache {
+public:
+    using CreateFunction = std::function<std::shared_ptr<ITextureView>(const TextureViewDesc&)>;
+
+    TextureViewCache() = default;
+    ~TextureViewCache() = default;
+
+    TextureViewCache(const TextureViewCache&) = delete;
+    TextureViewCache& operator=(const TextureViewCache&) = delete;
+
+    /**
+     * @brief Return the cached view for desc, creating it on a miss
+     * @param create Called without the cache lock held when no entry matches
+     * @return Cached or newly created view, nullptr if creation failed
+     */
+    std::shared_ptr<ITextureView> getOrCreate(const TextureViewDesc& desc, const CreateFunction& create);
+
+    void clear();
+
+    size_t size() const;
+
+    static bool isEquivalent(const TextureViewDesc& a, const TextureViewDesc& b);
+
+private:
+    struct Entry {
+        TextureViewDesc desc;
+        std::shared_ptr<ITextureView> view;
+    };
+
+    std::shared_ptr<ITextureView> find(const TextureViewDesc& desc) const;
+
+    mutable Mutex<false> _mutex;
+    TaggedVector<Entry, MemoryTag::Caches> _entries;
+};
+
+} // namespace pers
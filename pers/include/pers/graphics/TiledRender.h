@@ -0,0 +1,240 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/utils/TcpSocket.h"
+#include <glm/mat4x4.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IFramebuffer;
+
+/**
+ * @brief Pixel rectangle of one tile within the full image
+ */
+struct TileRect {
+    uint32_t index = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+};
+
+/**
+ * @brief Splits an image into a row-major grid of tiles
+ *
+ * Edge tiles are cropped to the image. getTileProjection() narrows a camera
+ * to one tile, so every tile renders with the full image's projection and
+ * the tiles line up without seams.
+ */
+class TileGrid {
+public:
+    TileGrid() = default;
+    TileGrid(uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight);
+
+    uint32_t getColumns() const { return _columns; }
+    uint32_t getRows() const { return _rows; }
+    uint32_t getTileCount() const { return _columns * _rows; }
+    uint32_t getWidth() const { return _width; }
+    uint32_t getHeight() const { return _height; }
+
+    TileRect getTile(uint32_t index) const;
+
+    /**
+     * @brief Clip-space scale and offset mapping the tile's part of the image onto the whole target
+     * Multiply in front of the projection: tileProjection * projection * view.
+     */
+    glm::mat4 getTileProjection(const TileRect& tile) const;
+
+private:
+    uint32_t _width = 0;
+    uint32_t _height = 0;
+    uint32_t _tileWidth = 0;
+    uint32_t _tileHeight = 0;
+    uint32_t _columns = 0;
+    uint32_t _rows = 0;
+};
+
+/**
+ * @brief Job a render node receives from the coordinator
+ */
+struct TiledRenderJob {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t tileWidth = 0;
+    uint32_t tileHeight = 0;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    std::string scenePath;  // Local copy of the scene the coordinator shipped
+};
+
+/**
+ * @brief Spreads the tiles of one large image over render nodes on the network
+ *
+ * Nodes are TiledRenderNode processes, usually headless pers on other
+ * machines, that connect to the coordinator's port. Each node gets the job
+ * and the cooked scene (a SceneFile, or any bytes the node understands)
+ * once when it connects, then tiles from a shared queue with a few in
+ * flight per node so transfers overlap rendering. Faster nodes simply take
+ * more tiles. Tiles of a node that disconnects go back to the queue.
+ * Nodes may join while a render is running.
+ *
+ *     TiledRenderCoordinator coordinator(desc);
+ *     coordinator.listen();  // Start nodes against coordinator.getPort()
+ *     std::vector<uint8_t> image;
+ *     coordinator.render(sceneBytes, image);
+ *     encodePng(image.data(), desc.width, desc.height, 4, desc.width * 4, png);
+ *
+ * The result is tightly packed, width * bytes per pixel per row.
+ * Uncompressed color formats only.
+ */
+class TiledRenderCoordinator {
+public:
+    static constexpr uint32_t DEFAULT_TILE_SIZE = 1024;
+    static constexpr uint32_t DEFAULT_TILES_IN_FLIGHT = 2;
+    static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{std::chrono::minutes(30)};
+
+    struct Desc {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t tileWidth = DEFAULT_TILE_SIZE;
+        uint32_t tileHeight = DEFAULT_TILE_SIZE;
+        TextureFormat format = TextureFormat::RGBA8Unorm;
+        uint16_t port = 0;              // 0 picks a free port
+        std::string address;            // Interface to listen on, empty for all
+        uint32_t tilesInFlight = DEFAULT_TILES_IN_FLIGHT;  // Per node
+    };
+
+    struct Stats {
+        uint32_t nodes = 0;           // Nodes that joined
+        uint32_t tilesRendered = 0;
+        uint32_t tilesReassigned = 0;  // Returned to the queue by a lost node
+        uint64_t bytesReceived = 0;
+    };
+
+    explicit TiledRenderCoordinator(const Desc& desc);
+    ~TiledRenderCoordinator();
+
+    TiledRenderCoordinator(const TiledRenderCoordinator&) = delete;
+    TiledRenderCoordinator& operator=(const TiledRenderCoordinator&) = delete;
+
+    /**
+     * @brief Open the port so nodes can connect before render() starts
+     */
+    bool listen();
+    uint16_t getPort() const { return _listener.getLocalPort(); }
+
+    /**
+     * @brief Render every tile on the connected nodes and assemble the image
+     * Blocks until the last tile arrives, cancel() is called or the timeout passes.
+     * @param scene Bytes sent to each node once, before its first tile
+     */
+    bool render(std::span<const uint8_t> scene, std::vector<uint8_t>& image,
+                std::chrono::milliseconds timeout = DEFAULT_TIMEOUT, std::string* error = nullptr);
+
+    /**
+     * @brief Stop a running render() from another thread
+     */
+    void cancel();
+
+    const TileGrid& getGrid() const { return _grid; }
+    Stats getStats() const;
+
+private:
+    struct Connection {
+        TcpSocket socket;
+        std::thread thread;
+        std::deque<uint32_t> pending;  // Tiles sent, result not yet received
+        bool finished = false;
+    };
+
+    void acceptLoop();
+    void serveNode(Connection& connection);
+    bool receiveTile(Connection& connection);
+    bool takeTile(uint32_t& tile, bool wait);
+    void returnTiles(Connection& connection);
+    void stopNodes();
+
+    Desc _desc;
+    TileGrid _grid;
+    uint32_t _bytesPerPixel = 0;
+    TcpSocket _listener;
+    std::thread _acceptThread;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    std::vector<std::unique_ptr<Connection>> _connections;
+    std::deque<uint32_t> _queue;
+    std::vector<uint8_t> _tileDone;
+    uint32_t _remaining = 0;
+    uint32_t _activeNodes = 0;  // Nodes serving the current render
+    bool _rendering = false;
+    bool _cancelled = false;
+    bool _stopping = false;
+    std::span<const uint8_t> _scene;
+    std::vector<uint8_t>* _image = nullptr;
+    Stats _stats;
+};
+
+/**
+ * @brief Headless render node serving a TiledRenderCoordinator
+ *
+ * run() connects, stores the shipped scene at the cache path, calls the
+ * setup function once so the application can load it, and then renders
+ * each assigned tile through an OffscreenRenderQueue into a tile-sized
+ * framebuffer. The record function draws the scene with
+ * tile.projection * projection; padded readback rows are packed before the
+ * pixels are sent back.
+ */
+class TiledRenderNode {
+public:
+    struct Tile {
+        TileRect rect;
+        glm::mat4 projection{1.0f};  // See TileGrid::getTileProjection()
+    };
+
+    using SetupFunction = std::function<bool(const TiledRenderJob& job)>;
+    using RecordFunction = std::function<bool(ICommandEncoder& encoder, const IFramebuffer& target, const Tile& tile)>;
+
+    struct Desc {
+        std::string sceneCachePath;  // Empty for a file in the temp directory
+        TextureFormat depthFormat = TextureFormat::Depth24Plus;
+    };
+
+    explicit TiledRenderNode(const std::shared_ptr<ILogicalDevice>& device);
+    TiledRenderNode(const std::shared_ptr<ILogicalDevice>& device, const Desc& desc);
+
+    /**
+     * @brief Serve tiles until the coordinator is done or the connection breaks
+     * @return true if the coordinator finished the job
+     */
+    bool run(const std::string& host, uint16_t port, const SetupFunction& setup, const RecordFunction& record);
+
+    /**
+     * @brief Drop the connection from another thread, run() returns false
+     */
+    void stop();
+
+    uint32_t getTilesRendered() const { return _tilesRendered.load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<ILogicalDevice> _device;
+    Desc _desc;
+    std::mutex _socketMutex;  // Guards _socket against stop()
+    TcpSocket _socket;
+    std::atomic<uint32_t> _tilesRendered{0};
+};
+
+} // namespace pers
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class IResourceFactory;
+class ITextureView;
+
+/**
+ * @brief Texture and its full-resource view handed out by TransientTexturePool
+ */
+struct PooledTexture {
+    std::shared_ptr<ITexture> texture;
+    std::shared_ptr<ITextureView> view;
+
+    explicit operator bool() const { return texture && view; }
+};
+
+/**
+ * @brief Recycles render target textures keyed by format, size, sample count and usage
+ *
+ * Framebuffers acquire their attachments here and release them on resize or
+ * destruction, so resizing back and forth and chains of same-sized
+ * post-processing targets reuse textures instead of reallocating VRAM.
+ * Textures released during a frame can be acquired again by later passes
+ * of the same frame; the queue orders the accesses.
+ *
+ * Free textures not reused for maxIdleFrames endFrame() calls are released.
+ * The pool registers with GpuMemoryTracker, which releases free textures
+ * through evict() when an allocation would exceed the GPU memory budget.
+ */
+class TransientTexturePool {
+public:
+    static constexpr uint32_t DEFAULT_MAX_IDLE_FRAMES = 60;
+
+    struct Stats {
+        uint64_t allocations = 0;  // Textures created through the resource factory
+        uint64_t reuses = 0;       // Requests served from the free list
+        uint32_t freeTextures = 0;
+    };
+
+    explicit TransientTexturePool(const std::shared_ptr<IResourceFactory>& factory,
+                                  uint32_t maxIdleFrames = DEFAULT_MAX_IDLE_FRAMES);
+    ~TransientTexturePool();
+
+    TransientTexturePool(const TransientTexturePool&) = delete;
+    TransientTexturePool& operator=(const TransientTexturePool&) = delete;
+
+    /**
+     * @brief Get a texture matching desc; the label only applies to new textures
+     * @return Texture and view, empty on failure
+     */
+    PooledTexture acquire(const TextureDesc& desc);
+
+    /**
+     * @brief Return a texture for reuse, the caller must drop its own references
+     */
+    void release(PooledTexture texture);
+
+    /**
+     * @brief Age free textures and release the ones idle too long
+     */
+    void endFrame();
+
+    /**
+     * @brief Release all free textures
+     */
+    void trim();
+
+    /**
+     * @brief Release free textures, longest idle first, until about bytes are freed
+     * @return Estimated bytes released
+     */
+    uint64_t evict(uint64_t bytes);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        TextureDesc desc;
+        PooledTexture texture;
+        uint32_t idleFrames = 0;
+    };
+
+    static bool isCompatible(const TextureDesc& a, const TextureDesc& b);
+
+    std::weak_ptr<IResourceFactory> _factory;
+    uint32_t _maxIdleFrames;
+
+    GpuMemoryTracker::EvictionCallbackId _evictionCallback = 0;
+
+    mutable Mutex<false> _mutex;
+    std::vector<Entry> _free;
+    Stats _stats;
+};
+
+} // namespace pers
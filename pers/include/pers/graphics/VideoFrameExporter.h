@@ -0,0 +1,151 @@
+#pragma once
+
+#include "pers/graphics/FrameGrabber.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/SubmissionFence.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ITexture;
+class OffscreenFramebuffer;
+
+/**
+ * @brief Frame handed to an encoder as a backend texture on the engine's device
+ *
+ * texture holds the frame until VideoFrameExporter::releaseFrame(slot); the
+ * copy into it completes with ready, and work the encoder submits to the
+ * same queue afterwards is ordered behind it.
+ */
+struct ExportedVideoFrame {
+    uint64_t frameIndex = 0;
+    uint32_t slot = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::Undefined;
+    NativeDeviceHandle device;
+    NativeTextureHandle texture;  // WGPUTexture for WebGPU
+    SubmissionFence ready;
+};
+
+/**
+ * @brief Destination of exported frames, typically a hardware video encoder
+ */
+class IVideoFrameSink {
+public:
+    virtual ~IVideoFrameSink() = default;
+
+    /**
+     * @brief Whether the sink can read backend textures of this device directly
+     * Checked once by the exporter; false selects the readback fallback.
+     */
+    virtual bool acceptsNativeTextures(const ILogicalDevice& device) const = 0;
+
+    /**
+     * @brief Zero-copy path, called on the exporting thread after submission
+     */
+    virtual void onGpuFrame(const ExportedVideoFrame& frame) = 0;
+
+    /**
+     * @brief Readback fallback with tightly packed RGBA8, called on a worker in capture order
+     */
+    virtual void onCpuFrame(const CapturedFrame& frame) = 0;
+};
+
+struct VideoFrameExporterDesc {
+    uint32_t width = 1920;
+    uint32_t height = 1080;
+    TextureFormat format = TextureFormat::RGBA8Unorm;
+    uint32_t slotCount = 3;   // Frames the encoder may hold at once, or readback slots
+    bool forceReadback = false;
+};
+
+/**
+ * @brief Feeds OffscreenFramebuffer color attachments to a video encoder
+ *
+ * When the sink accepts native textures, each exported frame is copied on
+ * the GPU into one of slotCount export textures (CopySrc | CopyDst |
+ * TextureBinding) and the backend handle is passed to onGpuFrame(); nothing
+ * crosses the bus. The copy decouples the encoder from the framebuffer,
+ * which is redrawn the next frame. Slots are reused once the sink calls
+ * releaseFrame(); frames arriving while every slot is held are dropped.
+ *
+ * wgpu-native does not export external memory (dma-buf, NT handles or
+ * CUDA interop), so handing frames to NVENC or VA-API across APIs needs a
+ * sink that shares the device's native backend, e.g. one built on the same
+ * WGPUDevice. Everything else uses the fallback: a FrameGrabber readback
+ * with raw RGBA8 delivered to onCpuFrame() from worker threads.
+ *
+ *     exporter.exportFrame(encoder, *offscreen, frameIndex);
+ *     auto fence = queue->submit(encoder->finish());
+ *     exporter.submitted(fence);
+ *     exporter.poll();
+ *
+ * The framebuffer must be single-sampled and its colorUsage include CopySrc.
+ */
+class VideoFrameExporter {
+public:
+    VideoFrameExporter(const std::shared_ptr<ILogicalDevice>& device, JobSystem& jobs,
+                       const std::shared_ptr<IVideoFrameSink>& sink, const VideoFrameExporterDesc& desc);
+    ~VideoFrameExporter();
+
+    VideoFrameExporter(const VideoFrameExporter&) = delete;
+    VideoFrameExporter& operator=(const VideoFrameExporter&) = delete;
+
+    bool isValid() const;
+    bool isZeroCopy() const { return _grabber == nullptr && !_slots.empty(); }
+
+    /**
+     * @brief Record the export of a color attachment into the encoder
+     * @return false if the frame was dropped or cannot be exported
+     */
+    bool exportFrame(const std::shared_ptr<ICommandEncoder>& encoder, const OffscreenFramebuffer& framebuffer,
+                     uint64_t frameIndex, uint32_t colorIndex = 0);
+
+    /**
+     * @brief Hand this frame's exports on, after the encoder was submitted
+     */
+    void submitted(const SubmissionFence& fence);
+
+    /**
+     * @brief Drive the readback fallback; call once per frame
+     */
+    void poll();
+
+    /**
+     * @brief Return a slot from onGpuFrame(); safe from any thread
+     */
+    void releaseFrame(uint32_t slot);
+
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Slot {
+        std::shared_ptr<ITexture> texture;
+        std::atomic<bool> held{false};
+    };
+
+    struct PendingExport {
+        uint32_t slot = 0;
+        uint64_t frameIndex = 0;
+    };
+
+    std::shared_ptr<ITexture> slotTexture(Slot& slot, uint32_t width, uint32_t height, TextureFormat format);
+
+    std::shared_ptr<ILogicalDevice> _device;
+    std::shared_ptr<IVideoFrameSink> _sink;
+    VideoFrameExporterDesc _desc;
+    std::unique_ptr<FrameGrabber> _grabber;
+
+    std::vector<std::unique_ptr<Slot>> _slots;
+    std::vector<PendingExport> _pending;
+    uint32_t _nextSlot = 0;
+    uint64_t _droppedCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,216 @@
+#pragma once
+
+#include "pers/graphics/GraphicsFormats.h"
+#include "pers/utils/CpuMemoryTracker.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class IRenderPassEncoder;
+class ITexture;
+class IBindGroupLayout;
+class IBindGroup;
+class DeviceBuffer;
+class OffscreenFramebuffer;
+class ReadbackRing;
+class ImmediateStagingBuffer;
+
+/**
+ * @brief One page of a virtual texture
+ *
+ * Level mip is split into getPagesWide(mip) x getPagesHigh(mip) pages, so
+ * page (x, y) covers UVs [x, x + 1] / pagesWide by [y, y + 1] / pagesHigh.
+ */
+struct VirtualPage {
+    uint32_t mip = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+};
+
+/**
+ * @brief Texture larger than VRAM, streamed in pages on demand
+ *
+ * Only a fixed cache of pages lives on the GPU, as tiles of one physical
+ * texture. An indirection table in a storage buffer maps every page of
+ * every level to the tile of its finest resident ancestor, so a missing
+ * page samples blurrier data instead of nothing, and the root page is
+ * loaded first and never evicted.
+ *
+ * Demand comes from a feedback pass drawn at 1/feedbackScale of the
+ * viewport: its R32Uint target receives virtualTextureFeedback(uv) from
+ * scene pipelines sharing getShaderDeclarations(), i.e. the page each pixel
+ * wants. readbackFeedback() copies the target into a ReadbackRing, and
+ * update() takes whatever readback has arrived, loads missing pages
+ * coarsest first through Config::loader, evicts least recently requested
+ * tiles once the cache is full, and records the uploads from one pooled
+ * staging buffer:
+ *
+ *     texture.update(*encoder);                     // Uploads and page table
+ *     auto feedback = texture.beginFeedbackPass(*encoder);
+ *     terrain.drawFeedback(*feedback);              // Writes virtualTextureFeedback(uv)
+ *     feedback->end();
+ *     texture.readbackFeedback(encoder);
+ *     ...                                           // Passes sampling virtualTextureSample(uv)
+ *     queue->submit(encoder->finish());
+ *     texture.submitted();
+ *
+ * Call resize() with the viewport before the first feedback pass.
+ * Feedback trails the frame by the readback latency, a few frames. Pages
+ * carry a border of neighbouring texels so bilinear filtering never
+ * crosses into another tile. Page counts must be powers of two. The
+ * staging buffer is released on the next update(), so the encoder must be
+ * submitted before then. Page table writes go through IQueue::writeBuffer,
+ * so update once per submission.
+ */
+class VirtualTexture {
+public:
+    static constexpr TextureFormat FEEDBACK_FORMAT = TextureFormat::R32Uint;
+    static constexpr uint32_t MAX_MIP_COUNT = 13;  // 4096 pages per side
+    static constexpr uint32_t NO_TILE = UINT32_MAX;
+
+    /**
+     * @brief Provide one page as a (pageSize + 2 * border)^2 tile, tightly packed
+     * The border repeats the neighbouring pages' texels, clamped at the edges.
+     * @return false if the data is not available yet; the page is retried later
+     */
+    using PageLoader = std::function<bool(const VirtualPage& page, std::vector<uint8_t>& data)>;
+
+    struct Config {
+        uint32_t pagesWide = 0;        // Pages of level 0, powers of two
+        uint32_t pagesHigh = 0;
+        uint32_t pageSize = 128;       // Texels per page side, border excluded
+        uint32_t border = 4;
+        TextureFormat format = TextureFormat::RGBA8Unorm;
+        uint32_t cachePagesX = 32;     // Tiles of the physical texture, lowered to the device limit
+        uint32_t cachePagesY = 32;
+        uint32_t feedbackScale = 8;    // Viewport pixels per feedback pixel along each axis
+        uint32_t maxUploadsPerUpdate = 16;
+        uint32_t readbackSlots = 3;
+        PageLoader loader;
+        std::string label = "VirtualTexture";
+    };
+
+    struct Stats {
+        uint32_t residentPages = 0;
+        uint32_t requestedPages = 0;   // Distinct pages in the feedback harvested by the last update()
+        uint32_t uploadedPages = 0;    // During the last update()
+        uint32_t evictedPages = 0;
+        uint32_t missingPages = 0;     // Requested pages still not resident after the last update()
+    };
+
+    VirtualTexture(const std::shared_ptr<ILogicalDevice>& device, const Config& config);
+    ~VirtualTexture();
+
+    VirtualTexture(const VirtualTexture&) = delete;
+    VirtualTexture& operator=(const VirtualTexture&) = delete;
+
+    bool isValid() const { return _bindGroup != nullptr; }
+
+    /**
+     * @brief Size the feedback target for a viewport; pending readbacks are dropped
+     */
+    bool resize(uint32_t viewportWidth, uint32_t viewportHeight);
+
+    /**
+     * @brief Begin the feedback pass, cleared to no request and far depth
+     */
+    std::shared_ptr<IRenderPassEncoder> beginFeedbackPass(ICommandEncoder& encoder);
+
+    /**
+     * @brief Copy the feedback target for update(); after the feedback pass
+     * @return false when every readback slot is in flight, the frame's feedback is skipped
+     */
+    bool readbackFeedback(const std::shared_ptr<ICommandEncoder>& encoder);
+
+    // Must be called after the command buffer passed to readbackFeedback() is submitted
+    void submitted();
+
+    /**
+     * @brief Ask for a page outside of feedback, e.g. ahead of a camera cut
+     */
+    void request(const VirtualPage& page);
+
+    /**
+     * @brief Apply arrived feedback: stream missing pages and update the page table
+     * @return false if an upload failed to record
+     */
+    bool update(ICommandEncoder& encoder);
+
+    /**
+     * @brief Group declared by getShaderDeclarations(): info, page table, cache, sampler
+     */
+    const std::shared_ptr<IBindGroup>& getBindGroup() const { return _bindGroup; }
+    const std::shared_ptr<IBindGroupLayout>& getBindGroupLayout() const { return _layout; }
+
+    /**
+     * @brief WGSL bindings, virtualTextureFeedback(uv) and virtualTextureSample(uv)
+     * Both derive the level from screen-space derivatives, so call them in
+     * uniform control flow of a fragment shader.
+     */
+    std::string getShaderDeclarations(uint32_t group) const;
+
+    const std::shared_ptr<ITexture>& getPhysicalTexture() const { return _physicalTexture; }
+    const std::shared_ptr<DeviceBuffer>& getPageTableBuffer() const { return _pageTableBuffer; }
+    const std::shared_ptr<OffscreenFramebuffer>& getFeedbackFramebuffer() const { return _feedback; }
+
+    uint32_t getMipCount() const { return _mipCount; }
+    uint32_t getPagesWide(uint32_t mip) const { return std::max(_config.pagesWide >> mip, 1u); }
+    uint32_t getPagesHigh(uint32_t mip) const { return std::max(_config.pagesHigh >> mip, 1u); }
+    bool isResident(const VirtualPage& page) const;
+    const Config& getConfig() const { return _config; }
+    Stats getStats() const { return _stats; }
+
+private:
+    struct Tile {
+        uint32_t page = NO_TILE;  // Page table index of the page held, NO_TILE when free
+        uint64_t lastUsed = 0;    // Update that last saw the page requested
+    };
+
+    uint32_t pageIndex(const VirtualPage& page) const;
+    VirtualPage pageAt(uint32_t index) const;
+    void touch(uint32_t index);
+    uint32_t allocateTile();
+    void refreshEntries(const VirtualPage& page);
+    void harvestFeedback();
+    bool writeInfo();
+
+    std::weak_ptr<ILogicalDevice> _device;
+    Config _config;
+    uint32_t _mipCount = 0;
+    uint32_t _tileSize = 0;       // Page plus border on both sides
+    uint32_t _texelBytes = 0;
+    std::vector<uint32_t> _levelOffsets;
+    float _feedbackBias = 0.0f;
+
+    std::shared_ptr<ITexture> _physicalTexture;
+    std::shared_ptr<DeviceBuffer> _infoBuffer;
+    std::shared_ptr<DeviceBuffer> _pageTableBuffer;
+    std::shared_ptr<IBindGroupLayout> _layout;
+    std::shared_ptr<IBindGroup> _bindGroup;
+    std::shared_ptr<OffscreenFramebuffer> _feedback;
+    std::unique_ptr<ReadbackRing> _readback;
+    std::shared_ptr<ImmediateStagingBuffer> _staging;  // Read by the last update's copies
+
+    std::vector<uint32_t> _pageTable;   // GPU entries: tile x | tile y << 12 | source mip << 24
+    std::vector<uint32_t> _pageTiles;   // Tile holding each page, NO_TILE if not resident
+    std::vector<Tile> _tiles;
+    std::vector<uint32_t> _freeTiles;
+    std::unordered_map<uint32_t, uint32_t> _requests;  // Page index to pixels asking for it
+    std::vector<uint8_t> _loadData;     // Handed to the loader
+    TaggedVector<uint8_t, MemoryTag::Loaders> _uploadData;   // Tiles loaded this update, tightly packed
+    uint32_t _feedbackPitch = 0;
+    uint32_t _dirtyBegin = UINT32_MAX;  // Page table entries changed since the last write
+    uint32_t _dirtyEnd = 0;
+    uint64_t _updateCount = 0;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/RenderGraph.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IRenderPassEncoder;
+class IShaderModule;
+class IBindGroupLayout;
+class IPipelineLayout;
+class ITextureView;
+
+/**
+ * @brief Order-independent transparency after McGuire and Bavoil's weighted blended OIT
+ *
+ * Transparent surfaces render in any order into two targets instead of the
+ * scene color: an accumulation target summing weighted premultiplied color
+ * and a revealage target multiplying (1 - alpha). A fullscreen composite
+ * then blends their weighted average over the opaque scene, so transparent
+ * draws need no per-frame sorting and batch like opaque ones:
+ *
+ *     const auto color = graph.importTexture(sceneView, sceneDesc);
+ *     ... opaque passes write color and depth ...
+ *     oit.addToGraph(graph, color, depth, target, width, height,
+ *                    [&](IRenderPassEncoder& pass) { drawTransparent(pass); });
+ *
+ * Transparent pipelines take their color targets and depth state from
+ * configureTransparentPipeline(), and their fragment shaders return
+ * oitOutput() from getShaderDeclarations(). The weight falls off with view
+ * depth, so nearer surfaces dominate; the result approximates sorted
+ * blending and is exact for a single layer. Additive and refractive effects
+ * still belong in a pass of their own.
+ */
+class WeightedBlendedOit {
+public:
+    static constexpr TextureFormat ACCUMULATION_FORMAT = TextureFormat::RGBA16Float;
+    static constexpr TextureFormat REVEALAGE_FORMAT = TextureFormat::R16Float;  // R8 bands after a few layers
+
+    /**
+     * @brief Attachments of the scene the transparency composites onto
+     */
+    struct Target {
+        TextureFormat colorFormat = TextureFormat::RGBA16Float;
+        TextureFormat depthFormat = TextureFormat::Depth24Plus;
+        uint32_t sampleCount = 1;
+
+        bool operator==(const Target& other) const = default;
+    };
+
+    using DrawFunction = std::function<void(IRenderPassEncoder& pass)>;
+
+    explicit WeightedBlendedOit(const std::shared_ptr<ILogicalDevice>& device);
+    ~WeightedBlendedOit();
+
+    WeightedBlendedOit(const WeightedBlendedOit&) = delete;
+    WeightedBlendedOit& operator=(const WeightedBlendedOit&) = delete;
+
+    bool isValid() const { return _compositeLayout != nullptr; }
+
+    /**
+     * @brief Set the color targets, blending and depth state of a transparent pipeline
+     *
+     * Depth is tested against the opaque scene but never written, since every
+     * layer must reach the accumulation.
+     */
+    static void configureTransparentPipeline(RenderPipelineDesc& desc, const Target& target);
+
+    /**
+     * @brief WGSL OitOutput struct and oitOutput(premultipliedColor, viewDepth)
+     */
+    static std::string getShaderDeclarations();
+
+    /**
+     * @brief Add the transparent and composite passes to graph
+     * @param color Scene color, composited onto in place
+     * @param depth Opaque depth the transparent draws are tested against
+     * @param draw Records the transparent draws into the accumulation pass
+     */
+    void addToGraph(RenderGraph& graph, RenderGraphTexture color, RenderGraphTexture depth, const Target& target,
+                    uint32_t width, uint32_t height, DrawFunction draw);
+
+    /**
+     * @brief Blend the accumulated layers over an open pass on the scene color
+     *
+     * The pass must have the scene color as its only attachment, without depth.
+     */
+    bool composite(IRenderPassEncoder& pass, const Target& target,
+                   const std::shared_ptr<ITextureView>& accumulation,
+                   const std::shared_ptr<ITextureView>& revealage);
+
+private:
+    struct PipelineEntry {
+        Target target;
+        std::shared_ptr<IRenderPipeline> pipeline;
+    };
+
+    std::shared_ptr<IRenderPipeline> getCompositePipeline(const Target& target);
+
+    std::weak_ptr<ILogicalDevice> _device;
+    std::shared_ptr<IShaderModule> _vertexShader;
+    std::shared_ptr<IShaderModule> _fragmentShader;
+    std::shared_ptr<IShaderModule> _multisampledFragmentShader;
+    std::shared_ptr<IPipelineLayout> _pipelineLayout;
+    std::shared_ptr<IPipelineLayout> _multisampledPipelineLayout;
+    std::shared_ptr<IBindGroupLayout> _multisampledLayout;
+    std::shared_ptr<IBindGroupLayout> _compositeLayout;
+    std::vector<PipelineEntry> _pipelines;
+};
+
+} // namespace pers
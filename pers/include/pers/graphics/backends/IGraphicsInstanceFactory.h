@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,6 +9,56 @@ namespace pers {
 
 class IInstance;
 
+/**
+ * @brief Native backends an instance may probe (bitmask)
+ *
+ * Auto keeps the implicit choice driven by allowSoftwareRenderer. Naming
+ * fewer backends makes instance creation and adapter enumeration cheaper,
+ * since every listed backend is loaded and queried for adapters.
+ */
+enum class InstanceBackend : uint32_t {
+    Auto = 0,
+    Vulkan = 1 << 0,
+    GL = 1 << 1,
+    Metal = 1 << 2,
+    DX12 = 1 << 3,
+    DX11 = 1 << 4,
+    BrowserWebGPU = 1 << 5,
+    Primary = Vulkan | Metal | DX12 | BrowserWebGPU,
+    Secondary = GL | DX11,
+    All = Primary | Secondary
+};
+
+inline InstanceBackend operator|(InstanceBackend a, InstanceBackend b) {
+    return static_cast<InstanceBackend>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline InstanceBackend operator&(InstanceBackend a, InstanceBackend b) {
+    return static_cast<InstanceBackend>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+inline InstanceBackend& operator|=(InstanceBackend& a, InstanceBackend b) {
+    a = a | b;
+    return a;
+}
+
+inline bool hasFlag(InstanceBackend flags, InstanceBackend flag) {
+    return (flags & flag) == flag;
+}
+
+/**
+ * @brief The single backend a platform is expected to run on
+ */
+constexpr InstanceBackend getPlatformBackend() {
+#if defined(_WIN32)
+    return InstanceBackend::DX12;
+#elif defined(__APPLE__)
+    return InstanceBackend::Metal;
+#else
+    return InstanceBackend::Vulkan;
+#endif
+}
+
 /**
  * @brief Instance descriptor for creating graphics instance
  * 
@@ -29,9 +80,13 @@ struct InstanceDesc {
     bool enableGPUBasedValidation = false; // GPU-assisted validation (Vulkan, D3D12)
     bool enableSynchronizationValidation = false; // Thread safety validation
     
+    bool enableDebugMessages = true;     // Detailed backend messages, only applies with enableValidation
+    bool discardBackendLabels = false;   // Do not forward debug labels to the native API
+    
     // Performance and features
     bool preferHighPerformanceGPU = true; // Prefer discrete GPU over integrated
     bool allowSoftwareRenderer = false;   // Allow CPU fallback (SwiftShader, WARP, etc.)
+    InstanceBackend backends = InstanceBackend::Auto; // Backends to probe, Auto = primary (all with allowSoftwareRenderer)
     
     // Required extensions/features (API-specific, but common patterns)
     std::vector<std::string> requiredExtensions;  // Instance extensions for Vulkan
@@ -41,6 +96,24 @@ struct InstanceDesc {
     uint32_t apiVersionMajor = 0; // 0 = use latest available
     uint32_t apiVersionMinor = 0;
     uint32_t apiVersionPatch = 0;
+    
+    /**
+     * @brief Cheapest instance to create for production builds
+     *
+     * Validation off, no backend labels and a single backend, so only one
+     * driver is loaded and asked for adapters.
+     */
+    static InstanceDesc fastInit(InstanceBackend backend = getPlatformBackend()) {
+        InstanceDesc desc;
+        desc.enableValidation = false;
+        desc.enableDebugMessages = false;
+        desc.enableGPUBasedValidation = false;
+        desc.enableSynchronizationValidation = false;
+        desc.discardBackendLabels = true;
+        desc.allowSoftwareRenderer = false;
+        desc.backends = backend;
+        return desc;
+    }
 };
 
 /**
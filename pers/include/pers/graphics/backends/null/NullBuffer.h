@@ -0,0 +1,91 @@
+#pragma once
+
+#include "pers/graphics/buffers/INativeBuffer.h"
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace pers {
+
+/**
+ * @brief Buffer of the null backend
+ *
+ * Holds no storage: queue writes and copies into it are validated against
+ * its size and usage, then dropped. The size is still reported to the
+ * GpuMemoryTracker so budget bookkeeping costs the same as on a real device.
+ */
+class NullBuffer : public INativeBuffer {
+public:
+    explicit NullBuffer(const BufferDesc& desc);
+    ~NullBuffer() override = default;
+
+    NullBuffer(const NullBuffer&) = delete;
+    NullBuffer& operator=(const NullBuffer&) = delete;
+
+    uint64_t getSize() const override { return _desc.size; }
+    BufferUsage getUsage() const override { return _desc.usage; }
+    const std::string& getDebugName() const override { return _desc.debugName; }
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override { return _valid; }
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override { return _desc.memoryLocation; }
+    AccessPattern getAccessPattern() const override { return _desc.accessPattern; }
+
+private:
+    BufferDesc _desc;
+    GpuMemoryAllocation _allocation;
+    bool _valid = false;
+};
+
+/**
+ * @brief Mappable buffer of the null backend, backed by host memory
+ *
+ * Maps complete before mapAsync returns and hand out the host allocation, so
+ * staging writes and readbacks exercise the real copy paths. Nothing written
+ * through a mapping reaches other buffers, there is no GPU to copy it.
+ */
+class NullMappableBuffer : public INativeMappableBuffer {
+public:
+    explicit NullMappableBuffer(const BufferDesc& desc);
+    ~NullMappableBuffer() override = default;
+
+    NullMappableBuffer(const NullMappableBuffer&) = delete;
+    NullMappableBuffer& operator=(const NullMappableBuffer&) = delete;
+
+    // INativeMappableBuffer interface
+    void* getMappedData() override;
+    const void* getMappedData() const override;
+    std::future<MappedData> mapAsync(MapMode mode = MapMode::Write,
+                                     const BufferMapRange& range = {0, BufferMapRange::WHOLE_BUFFER}) override;
+    bool mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) override;
+    void unmap() override;
+    bool isMapped() const override { return _isMapped; }
+    bool isMapPending() const override { return false; }
+    void flushMappedRange(uint64_t offset, uint64_t size) override {}
+    void invalidateMappedRange(uint64_t offset, uint64_t size) override {}
+
+    // INativeBuffer interface
+    uint64_t getSize() const override { return _desc.size; }
+    BufferUsage getUsage() const override { return _desc.usage; }
+    const std::string& getDebugName() const override { return _desc.debugName; }
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override { return _storage != nullptr; }
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override { return _desc.memoryLocation; }
+    AccessPattern getAccessPattern() const override { return _desc.accessPattern; }
+
+private:
+    // Map the range now, null data if it does not fit or the buffer is invalid
+    MappedData map(const BufferMapRange& range);
+
+    BufferDesc _desc;
+    GpuMemoryAllocation _allocation;
+    std::unique_ptr<uint8_t[]> _storage;
+    std::atomic<bool> _isMapped{false};
+    uint64_t _mappedOffset = 0;
+    uint64_t _mappedSize = 0;
+};
+
+} // namespace pers
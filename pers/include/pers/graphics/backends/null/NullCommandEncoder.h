@@ -0,0 +1,88 @@
+#pragma once
+
+#include "pers/graphics/ICommandEncoder.h"
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Command encoder of the null backend
+ *
+ * Runs the same argument validation as WebGPUCommandEncoder and hands out
+ * null pass encoders, but records no copies: the resulting command buffer
+ * carries nothing to execute.
+ */
+class NullCommandEncoder : public ICommandEncoder {
+public:
+    /**
+     * @param multiDrawIndirect Device has native multi-draw-indirect enabled
+     * @param multiDrawIndirectCount Device has native multi-draw-indirect-count enabled
+     */
+    explicit NullCommandEncoder(bool multiDrawIndirect = false, bool multiDrawIndirectCount = false);
+    ~NullCommandEncoder() override = default;
+    
+    // ICommandEncoder interface implementation
+    std::shared_ptr<IRenderPassEncoder> beginRenderPass(const RenderPassDesc& desc) override;
+    std::shared_ptr<IRenderPassEncoder> beginRenderPass(const IPreparedRenderPass& pass) override;
+    std::shared_ptr<IComputePassEncoder> beginComputePass(const ComputePassDesc& desc) override;
+    
+    bool uploadToDeviceBuffer(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                             const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                             const BufferCopyDesc& copyDesc) override;
+    bool downloadFromDeviceBuffer(const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                                 const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                 const BufferCopyDesc& copyDesc) override;
+    bool downloadFromDeviceBuffer(const std::shared_ptr<ImmediateDeviceBuffer>& deviceBuffer,
+                                 const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                 const BufferCopyDesc& copyDesc) override;
+    bool uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                        const std::shared_ptr<ITexture>& texture,
+                        const TextureUploadDesc& desc) override;
+    bool copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                            const std::shared_ptr<ITexture>& texture,
+                            const TextureUploadDesc& desc) override;
+    bool downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                            const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                            const TextureReadbackDesc& desc) override;
+    bool copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                            const std::shared_ptr<DeviceBuffer>& destination,
+                            const TextureReadbackDesc& desc) override;
+    bool copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                             const std::shared_ptr<ITexture>& destination,
+                             const TextureCopyDesc& desc) override;
+    bool copyDeviceToDevice(const std::shared_ptr<DeviceBuffer>& source,
+                           const std::shared_ptr<DeviceBuffer>& destination,
+                           const BufferCopyDesc& copyDesc) override;
+    bool clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer,
+                    uint64_t offset = 0,
+                    uint64_t size = BufferCopyDesc::WHOLE_SIZE) override;
+    bool resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet,
+                         uint32_t firstQuery,
+                         uint32_t queryCount,
+                         const std::shared_ptr<DeviceBuffer>& destination,
+                         uint64_t destinationOffset = 0) override;
+    
+    std::shared_ptr<ICommandBuffer> finish() override;
+    NativeEncoderHandle getNativeEncoderHandle() const override;
+    
+private:
+    bool canEncode(const char* operation) const;
+    bool copyBufferToBuffer(const std::shared_ptr<IBuffer>& source,
+                           const std::shared_ptr<IBuffer>& destination,
+                           const BufferCopyDesc& copyDesc);
+    
+    // Validation shared by the buffer/texture copy directions
+    bool validateBufferTextureCopy(const IBuffer& buffer,
+                                   const std::shared_ptr<ITexture>& texture,
+                                   TextureUsage requiredUsage,
+                                   uint32_t mipLevel, uint32_t originX, uint32_t originY,
+                                   uint32_t width, uint32_t height,
+                                   uint32_t bytesPerRow, uint64_t bufferOffset,
+                                   const char* operation);
+    
+    bool _multiDrawIndirect = false;
+    bool _multiDrawIndirectCount = false;
+    bool _finished = false;
+};
+
+} // namespace pers
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"  // For InstanceDesc
+#include <memory>
+
+namespace pers {
+
+class NullPhysicalDevice;
+
+/**
+ * @brief Instance of the null backend, exposing a single null adapter
+ */
+class NullInstance : public IInstance {
+public:
+    NullInstance() = default;
+    ~NullInstance() override = default;
+    
+    NullInstance(const NullInstance&) = delete;
+    NullInstance& operator=(const NullInstance&) = delete;
+    
+    /**
+     * @brief Store the descriptor and create the adapter, cannot fail
+     * @param desc Instance descriptor
+     * @return true
+     */
+    bool initialize(const InstanceDesc& desc);
+    
+    /**
+     * @brief The null adapter, whatever the options ask for
+     */
+    std::shared_ptr<IPhysicalDevice> requestPhysicalDevice(
+        const PhysicalDeviceOptions& options) override;
+    
+    std::vector<std::shared_ptr<IPhysicalDevice>> enumeratePhysicalDevices() override;
+    
+    /**
+     * @brief Not supported, the null backend has nothing to present to
+     * @return nullptr
+     */
+    NativeSurfaceHandle createSurface(void* windowHandle) override;
+    
+    /**
+     * @brief No-op, every null operation completes before it returns
+     */
+    void processEvents() override;
+    
+private:
+    InstanceDesc _desc;
+    std::shared_ptr<NullPhysicalDevice> _physicalDevice;
+};
+
+} // namespace pers
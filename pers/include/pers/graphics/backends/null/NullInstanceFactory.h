@@ -0,0 +1,34 @@
+#pragma once
+
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"
+
+namespace pers {
+
+/**
+ * @brief Null backend factory
+ *
+ * Objects validate their arguments and record commands but never reach a
+ * driver, so benchmarks run against it measure the CPU cost of pers itself:
+ * wrappers, caches, state filtering and allocation. Always built, needs no GPU.
+ */
+class NullInstanceFactory : public IGraphicsInstanceFactory {
+public:
+    NullInstanceFactory() = default;
+    ~NullInstanceFactory() override = default;
+    
+    /**
+     * @brief Create a null instance
+     * @param desc Instance descriptor
+     * @return Shared pointer to null instance
+     */
+    std::shared_ptr<IInstance> createInstance(
+        const InstanceDesc& desc) override;
+    
+    /**
+     * @brief Get the backend name
+     * @return "Null"
+     */
+    const std::string& getBackendName() const override;
+};
+
+} // namespace pers
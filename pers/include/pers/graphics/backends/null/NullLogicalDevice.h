@@ -0,0 +1,67 @@
+#pragma once
+
+#include "pers/graphics/ILogicalDevice.h"
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Logical device of the null backend
+ *
+ * Shares the frontend plumbing of WebGPULogicalDevice (staging pool, deferred
+ * deletion, pooled command encoders) so that measured overhead includes it.
+ * Swap chains are not supported.
+ */
+class NullLogicalDevice : public ILogicalDevice,
+                          public std::enable_shared_from_this<NullLogicalDevice> {
+public:
+    /**
+     * @brief Constructor
+     * @param physicalDevice The physical device this logical device was created from
+     * @param limits Limits reported by getLimits()
+     * @param features Features reported by hasFeature()
+     */
+    NullLogicalDevice(const std::shared_ptr<IPhysicalDevice>& physicalDevice,
+                      const DeviceLimits& limits,
+                      const std::vector<DeviceFeature>& features);
+    ~NullLogicalDevice() override;
+    
+    NullLogicalDevice(const NullLogicalDevice&) = delete;
+    NullLogicalDevice& operator=(const NullLogicalDevice&) = delete;
+    
+    std::shared_ptr<IQueue> getQueue() const override;
+    const std::shared_ptr<IResourceFactory>& getResourceFactory() const override;
+    const std::shared_ptr<StagingBufferPool>& getStagingBufferPool() const override;
+    const std::shared_ptr<DeferredDeletionQueue>& getDeletionQueue() const override;
+    
+    std::shared_ptr<ICommandEncoder> createCommandEncoder() override;
+    std::shared_ptr<IRenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDesc& desc) override;
+    
+    /**
+     * @brief Not supported, logs an error and returns nullptr
+     */
+    std::shared_ptr<ISwapChain> createSwapChain(
+        const NativeSurfaceHandle& surface,
+        const SwapChainDesc& desc) override;
+    
+    void waitIdle() override;
+    NativeDeviceHandle getNativeDeviceHandle() const override;
+    DeviceLimits getLimits() const override;
+    bool hasFeature(DeviceFeature feature) const override;
+    std::shared_ptr<IPhysicalDevice> getPhysicalDevice() const override;
+    
+private:
+    std::weak_ptr<IPhysicalDevice> _physicalDevice;
+    DeviceLimits _limits;
+    uint32_t _features = 0;  // Bit per DeviceFeature
+    std::shared_ptr<IQueue> _defaultQueue;
+    mutable std::shared_ptr<IResourceFactory> _resourceFactory;
+    mutable std::shared_ptr<StagingBufferPool> _stagingBufferPool;
+    mutable std::once_flag _resourceFactoryOnce;
+    mutable std::once_flag _stagingBufferPoolOnce;
+    std::shared_ptr<DeferredDeletionQueue> _deletionQueue;
+};
+
+} // namespace pers
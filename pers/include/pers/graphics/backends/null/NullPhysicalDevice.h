@@ -0,0 +1,53 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Adapter of the null backend
+ *
+ * Reports every feature pers can use and the WebGPU default limits, so code
+ * paths gated on capabilities take the same branches a capable GPU would.
+ * Ray tracing and tessellation stay off like on the WebGPU backend.
+ */
+class NullPhysicalDevice : public IPhysicalDevice,
+                           public std::enable_shared_from_this<NullPhysicalDevice> {
+public:
+    NullPhysicalDevice();
+    ~NullPhysicalDevice() override = default;
+    
+    NullPhysicalDevice(const NullPhysicalDevice&) = delete;
+    NullPhysicalDevice& operator=(const NullPhysicalDevice&) = delete;
+    
+    PhysicalDeviceCapabilities getCapabilities() const override;
+    std::vector<QueueFamily> getQueueFamilies() const override;
+    
+    /**
+     * @brief Always false, the null backend cannot present
+     */
+    bool supportsSurface(const NativeSurfaceHandle& surface) const override;
+    
+    /**
+     * @brief Create a null logical device
+     *
+     * Required and preferred features are all granted. requiredLimits above
+     * the reported limits fail creation like on a real adapter.
+     */
+    std::shared_ptr<ILogicalDevice> createLogicalDevice(
+        const LogicalDeviceDesc& desc) override;
+    
+    NativeAdapterHandle getNativeAdapterHandle() const override;
+    
+    /**
+     * @brief Limits granted to every logical device
+     */
+    const DeviceLimits& getLimits() const { return _limits; }
+    
+private:
+    PhysicalDeviceCapabilities _capabilities;
+    DeviceLimits _limits;
+};
+
+} // namespace pers
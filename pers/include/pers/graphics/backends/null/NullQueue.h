@@ -0,0 +1,58 @@
+#pragma once
+
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Mutex.h"
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Queue of the null backend
+ *
+ * Validates submissions and writes like WebGPUQueue, then completes them on
+ * the spot: every fence is signaled before submit returns and work-done
+ * callbacks run inline. Submission batches still hold their value open until
+ * they are flushed, so batching code observes the same ordering.
+ */
+class NullQueue : public IQueue {
+public:
+    NullQueue();
+    ~NullQueue() override;
+    
+    // IQueue interface implementation
+    using IQueue::submit;
+    SubmissionFence submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) override;
+    SubmissionFence submit(std::span<const NativeCommandBufferHandle> commandBuffers) override;
+    SubmissionFence submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) override;
+    SubmissionFence submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) override;
+    void beginSubmissionBatch() override;
+    SubmissionFence endSubmissionBatch() override;
+    SubmissionFence flushSubmissions() override;
+    bool writeBuffer(const BufferWriteDesc& desc) override;
+    bool writeBuffer(const std::shared_ptr<IBuffer>& buffer,
+                     uint64_t offset,
+                     std::span<const std::byte> data) override;
+    bool writeBuffers(std::span<const BufferWriteDesc> writes) override;
+    bool writeTexture(const std::shared_ptr<ITexture>& texture,
+                     const void* data,
+                     uint64_t dataSize,
+                     uint32_t mipLevel = 0) override;
+    bool writeTexture(const TextureWriteDesc& desc) override;
+    bool waitIdle() override;
+    bool onSubmittedWorkDone(QueueWorkDoneCallback callback) override;
+    bool pollSubmittedWork(bool wait) override;
+    NativeQueueHandle getNativeQueueHandle() const override;
+    
+private:
+    // Complete now or join the open batch
+    SubmissionFence dispatch(size_t count);
+    
+    std::shared_ptr<SubmissionTimeline> _timeline;
+    
+    Mutex<false> _batchMutex{"NullQueue::Batch"};
+    uint32_t _batchDepth = 0;
+    uint64_t _batchValue = 0;  // Timeline value reserved by the open batch, 0 if empty
+    size_t _batchedCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "pers/graphics/IRenderBundle.h"
+#include <memory>
+#include <string>
+
+namespace pers {
+
+/**
+ * @brief Render bundle encoder of the null backend
+ *
+ * Same validation as WebGPURenderBundleEncoder, a bundle with a failed
+ * command is discarded. The finished bundle only carries its draw count.
+ */
+class NullRenderBundleEncoder final : public IRenderBundleEncoder {
+public:
+    /**
+     * @param label Label used in diagnostics for the finished bundle
+     */
+    explicit NullRenderBundleEncoder(const std::string& label);
+    ~NullRenderBundleEncoder() override = default;
+    
+    // Non-copyable
+    NullRenderBundleEncoder(const NullRenderBundleEncoder&) = delete;
+    NullRenderBundleEncoder& operator=(const NullRenderBundleEncoder&) = delete;
+    
+    // IRenderBundleEncoder interface
+    void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) override;
+    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                      std::span<const uint32_t> dynamicOffsets = {}) override;
+    void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                         uint64_t offset = 0, uint64_t size = 0) override;
+    void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                        IndexFormat indexFormat,
+                        uint64_t offset = 0, uint64_t size = 0) override;
+    void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) override;
+    void draw(uint32_t vertexCount, uint32_t instanceCount = 1,
+              uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1,
+                     uint32_t firstIndex = 0, int32_t baseVertex = 0,
+                     uint32_t firstInstance = 0) override;
+    void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    std::shared_ptr<IRenderBundle> finish() override;
+    
+private:
+    bool canRecord(const char* operation) const;
+    // Validate a buffer argument, marks the bundle failed when it has no native handle
+    bool validateBuffer(const std::shared_ptr<IBuffer>& buffer, const char* message);
+    
+    std::string _label;
+    uint32_t _drawCount = 0;
+    bool _finished = false;
+    bool _failed = false;  // A command could not be recorded, finish() returns null
+};
+
+} // namespace pers
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/PipelineCache.h"
+#include "pers/graphics/BindGroupCache.h"
+#include "pers/graphics/SamplerCache.h"
+#include <memory>
+
+namespace pers {
+
+// Forward declaration
+class NullLogicalDevice;
+
+/**
+ * @brief Resource factory of the null backend, safe to call from any thread
+ *
+ * Runs the same validation, layout derivation and pipeline, bind group and
+ * sampler caching as WebGPUResourceFactory; only the native object creation
+ * is skipped. Async pipelines resolve before createRenderPipelineAsync returns.
+ */
+class NullResourceFactory final : public IResourceFactory {
+public:
+    explicit NullResourceFactory(const std::shared_ptr<NullLogicalDevice>& logicalDevice);
+    ~NullResourceFactory() override = default;
+    
+    // IResourceFactory interface
+    std::shared_ptr<INativeBuffer> createBuffer(const BufferDesc& desc) const override;
+    std::shared_ptr<INativeBuffer> createInitializableDeviceBuffer(
+        const BufferDesc& desc,
+        const void* initialData,
+        size_t dataSize) const override;
+    std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) const override;
+    std::shared_ptr<ITextureView> createTextureView(
+        const std::shared_ptr<ITexture>& texture,
+        const TextureViewDesc& desc) const override;
+    std::shared_ptr<ISampler> createSampler(const SamplerDesc& desc) const override;
+    std::shared_ptr<IShaderModule> createShaderModule(const ShaderModuleDesc& desc) const override;
+    std::shared_ptr<IRenderPipeline> createRenderPipeline(const RenderPipelineDesc& desc) const override;
+    std::shared_ptr<AsyncRenderPipeline> createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        const std::shared_ptr<IRenderPipeline>& fallback = nullptr) const override;
+    std::shared_ptr<IComputePipeline> createComputePipeline(const ComputePipelineDesc& desc) const override;
+    std::shared_ptr<INativeMappableBuffer> createMappableBuffer(const BufferDesc& desc) const override;
+    std::shared_ptr<IBindGroupLayout> createBindGroupLayout(const BindGroupLayoutDesc& desc) const override;
+    std::shared_ptr<IBindGroup> createBindGroup(const BindGroupDesc& desc) const override;
+    std::shared_ptr<IPipelineLayout> createPipelineLayout(const PipelineLayoutDesc& desc) const override;
+    std::shared_ptr<IQuerySet> createQuerySet(const QuerySetDesc& desc) const override;
+    std::shared_ptr<IPreparedRenderPass> createPreparedRenderPass(const RenderPassDesc& desc) const override;
+    
+    PipelineCache& getPipelineCache() const { return _pipelineCache; }
+    BindGroupCache& getBindGroupCache() const { return _bindGroupCache; }
+    SamplerCache& getSamplerCache() const { return _samplerCache; }
+    
+private:
+    // Same derivation as WebGPUResourceFactory, @return true if derived differs from desc
+    bool deriveLayouts(const RenderPipelineDesc& desc, RenderPipelineDesc& derived) const;
+    bool deriveLayouts(const ComputePipelineDesc& desc, ComputePipelineDesc& derived) const;
+    
+    std::weak_ptr<NullLogicalDevice> _logicalDevice;
+    mutable PipelineCache _pipelineCache;
+    mutable BindGroupCache _bindGroupCache;
+    mutable SamplerCache _samplerCache;
+};
+
+} // namespace pers
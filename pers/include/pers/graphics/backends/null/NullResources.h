@@ -0,0 +1,233 @@
+#pragma once
+
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQuerySet.h"
+#include "pers/graphics/IPreparedRenderPass.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/IRenderBundle.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/graphics/TextureViewCache.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Native handle of a null backend object
+ *
+ * Null objects stand in for their own native handle, so generic code that
+ * rejects null handles accepts them and redundant-state filtering still
+ * tells two objects apart.
+ */
+template<typename Handle, typename T>
+Handle makeNullHandle(const T* object) {
+    return Handle::fromBackend(const_cast<T*>(object));
+}
+
+/**
+ * @brief Texture of the null backend, holds its desc and memory accounting only
+ */
+class NullTexture : public ITexture {
+public:
+    NullTexture(const TextureDesc& desc, GpuMemoryAllocation allocation);
+
+    uint32_t getWidth() const override { return _desc.width; }
+    uint32_t getHeight() const override { return _desc.height; }
+    uint32_t getDepthOrArrayLayers() const override { return _desc.depthOrArrayLayers; }
+    uint32_t getMipLevelCount() const override { return _desc.mipLevelCount; }
+    uint32_t getSampleCount() const override { return _desc.sampleCount; }
+    TextureDimension getDimension() const override { return _desc.dimension; }
+    TextureFormat getFormat() const override { return _desc.format; }
+    TextureUsage getUsage() const override { return _desc.usage; }
+    NativeTextureHandle getNativeTextureHandle() const override;
+
+    // Deduplicated like WebGPUTexture's, so view lookups cost the same
+    TextureViewCache& getViewCache() const { return _viewCache; }
+
+private:
+    TextureDesc _desc;
+    GpuMemoryAllocation _allocation;
+    mutable TextureViewCache _viewCache;
+};
+
+class NullTextureView : public ITextureView {
+public:
+    NullTextureView(uint32_t width, uint32_t height, TextureFormat format);
+
+    NativeTextureViewHandle getNativeTextureViewHandle() const override;
+    void getDimensions(uint32_t& width, uint32_t& height) const override;
+    TextureFormat getFormat() const override { return _format; }
+
+private:
+    uint32_t _width = 0;
+    uint32_t _height = 0;
+    TextureFormat _format = TextureFormat::Undefined;
+};
+
+class NullSampler : public ISampler {
+public:
+    explicit NullSampler(const SamplerDesc& desc);
+
+    NativeSamplerHandle getNativeSamplerHandle() const override;
+    const SamplerDesc& getDesc() const override { return _desc; }
+    bool isValid() const override { return true; }
+
+private:
+    SamplerDesc _desc;
+};
+
+/**
+ * @brief Shader module of the null backend
+ *
+ * Reflects WGSL exactly like WebGPUShaderModule so layout derivation and
+ * stage detection cost the same, but compiles nothing. Valid once a stage is
+ * known and some code or SPIR-V was given.
+ */
+class NullShaderModule : public IShaderModule {
+public:
+    explicit NullShaderModule(const ShaderModuleDesc& desc);
+
+    ShaderStage getStage() const override { return _stage; }
+    const std::string& getEntryPoint() const override { return _entryPoint; }
+    const std::string& getDebugName() const override { return _debugName; }
+    bool isValid() const override { return _valid; }
+    const std::string& getCode() const override { return _code; }
+    const std::vector<uint32_t>& getSpirv() const override { return _spirv; }
+    const ShaderReflection& getReflection() const override { return _reflection; }
+
+private:
+    ShaderStage _stage = ShaderStage::None;
+    std::string _entryPoint;
+    std::string _debugName;
+    std::string _code;
+    std::vector<uint32_t> _spirv;
+    ShaderReflection _reflection;
+    bool _valid = false;
+};
+
+class NullRenderPipeline : public IRenderPipeline {
+public:
+    explicit NullRenderPipeline(const RenderPipelineDesc& desc);
+
+    const std::string& getDebugName() const override { return _desc.debugName.str(); }
+    bool isValid() const override { return _valid; }
+    RenderPipelineDesc getDesc() const override { return _desc; }
+    NativePipelineHandle getNativePipelineHandle() const override;
+
+private:
+    RenderPipelineDesc _desc;
+    bool _valid = false;
+};
+
+class NullComputePipeline : public IComputePipeline {
+public:
+    explicit NullComputePipeline(const ComputePipelineDesc& desc);
+
+    const std::string& getDebugName() const override { return _desc.debugName; }
+    bool isValid() const override { return _valid; }
+    NativePipelineHandle getNativePipelineHandle() const override;
+
+private:
+    ComputePipelineDesc _desc;
+    bool _valid = false;
+};
+
+class NullBindGroupLayout : public IBindGroupLayout {
+public:
+    explicit NullBindGroupLayout(const BindGroupLayoutDesc& desc) : _desc(desc) {}
+
+    const BindGroupLayoutDesc& getDesc() const override { return _desc; }
+    NativeBindGroupLayoutHandle getNativeBindGroupLayoutHandle() const override;
+
+private:
+    BindGroupLayoutDesc _desc;
+};
+
+class NullBindGroup : public IBindGroup {
+public:
+    explicit NullBindGroup(const BindGroupDesc& desc);
+
+    const std::shared_ptr<IBindGroupLayout>& getLayout() const override { return _desc.layout; }
+    const BindGroupDesc& getDesc() const override { return _desc; }
+    NativeBindGroupHandle getNativeBindGroupHandle() const override;
+    bool isValid() const { return _valid; }
+
+private:
+    BindGroupDesc _desc;
+    bool _valid = false;
+};
+
+class NullPipelineLayout : public IPipelineLayout {
+public:
+    explicit NullPipelineLayout(const PipelineLayoutDesc& desc) : _desc(desc) {}
+
+    const PipelineLayoutDesc& getDesc() const override { return _desc; }
+    NativePipelineLayoutHandle getNativePipelineLayoutHandle() const override;
+
+private:
+    PipelineLayoutDesc _desc;
+};
+
+class NullQuerySet : public IQuerySet {
+public:
+    explicit NullQuerySet(const QuerySetDesc& desc);
+
+    QueryType getType() const override { return _desc.type; }
+    uint32_t getCount() const override { return _desc.count; }
+    const QuerySetDesc& getDesc() const override { return _desc; }
+    NativeQuerySetHandle getNativeQuerySetHandle() const override;
+    bool isValid() const override { return _valid; }
+
+private:
+    QuerySetDesc _desc;
+    bool _valid = false;
+};
+
+/**
+ * @brief Prepared render pass of the null backend, a retargetable copy of the desc
+ */
+class NullPreparedRenderPass : public IPreparedRenderPass {
+public:
+    explicit NullPreparedRenderPass(const RenderPassDesc& desc);
+
+    const RenderPassDesc& getDesc() const override { return _desc; }
+    bool setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) override;
+    bool setResolveTarget(uint32_t index, const std::shared_ptr<ITextureView>& view) override;
+    bool setClearColor(uint32_t index, const Color& color) override;
+    bool setDepthStencilView(const std::shared_ptr<ITextureView>& view) override;
+
+    // Every color attachment has a view, required to begin the pass
+    bool isComplete() const;
+
+private:
+    RenderPassDesc _desc;
+};
+
+class NullCommandBuffer : public ICommandBuffer {
+public:
+    NativeCommandBufferHandle getNativeCommandBufferHandle() const override;
+};
+
+class NullRenderBundle : public IRenderBundle {
+public:
+    explicit NullRenderBundle(uint32_t drawCount) : _drawCount(drawCount) {}
+
+    uint32_t getDrawCount() const override { return _drawCount; }
+    NativeRenderBundleHandle getNativeRenderBundleHandle() const override;
+
+private:
+    uint32_t _drawCount = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"  // For InstanceDesc
+#include <vulkan/vulkan.h>
+#include <memory>
+
+namespace pers {
+
+/**
+ * @brief Vulkan implementation of IInstance
+ *
+ * Talks to the Vulkan loader directly instead of going through wgpu. The
+ * validation layer and VK_EXT_debug_utils are enabled only when requested and
+ * present, so release builds on the render farm run without them.
+ */
+class VulkanInstance : public IInstance,
+                       public std::enable_shared_from_this<VulkanInstance> {
+public:
+    VulkanInstance();
+    ~VulkanInstance() override;
+    
+    VulkanInstance(const VulkanInstance&) = delete;
+    VulkanInstance& operator=(const VulkanInstance&) = delete;
+    
+    /**
+     * @brief Create the VkInstance
+     * @param desc Instance descriptor
+     * @return true on success, false on failure
+     */
+    bool initialize(const InstanceDesc& desc);
+    
+    /**
+     * @brief Pick a physical device by type and power preference
+     *
+     * Discrete GPUs win for HighPerformance, integrated ones for LowPower. CPU
+     * implementations such as lavapipe are only considered with
+     * forceFallbackAdapter or InstanceDesc::allowSoftwareRenderer.
+     */
+    std::shared_ptr<IPhysicalDevice> requestPhysicalDevice(
+        const PhysicalDeviceOptions& options) override;
+    
+    /**
+     * @brief Enumerate physical devices via vkEnumeratePhysicalDevices
+     */
+    std::vector<std::shared_ptr<IPhysicalDevice>> enumeratePhysicalDevices() override;
+    
+    /**
+     * @brief Not supported yet, the backend renders offscreen only
+     * @return nullptr
+     */
+    NativeSurfaceHandle createSurface(void* windowHandle) override;
+    
+    /**
+     * @brief No-op, Vulkan has no instance-level event queue
+     */
+    void processEvents() override;
+    
+    VkInstance getVkInstance() const { return _instance; }
+    
+    /**
+     * @brief API version the instance was created with (VK_MAKE_API_VERSION)
+     */
+    uint32_t getApiVersion() const { return _apiVersion; }
+    
+private:
+    VkInstance _instance = VK_NULL_HANDLE;
+    VkDebugUtilsMessengerEXT _messenger = VK_NULL_HANDLE;
+    uint32_t _apiVersion = 0;
+    InstanceDesc _desc;
+};
+
+} // namespace pers
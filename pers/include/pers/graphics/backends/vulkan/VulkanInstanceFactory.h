@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"
+
+namespace pers {
+
+/**
+ * @brief Native Vulkan backend factory, built with PERS_ENABLE_VULKAN
+ */
+class VulkanInstanceFactory : public IGraphicsInstanceFactory {
+public:
+    VulkanInstanceFactory() = default;
+    ~VulkanInstanceFactory() override = default;
+    
+    /**
+     * @brief Create a Vulkan instance
+     * @param desc Instance descriptor
+     * @return Shared pointer to Vulkan instance, nullptr without a loader or driver
+     */
+    std::shared_ptr<IInstance> createInstance(
+        const InstanceDesc& desc) override;
+    
+    /**
+     * @brief Get the backend name
+     * @return "Vulkan"
+     */
+    const std::string& getBackendName() const override;
+};
+
+} // namespace pers
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "pers/graphics/IPhysicalDevice.h"
+#include <vulkan/vulkan.h>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class VulkanInstance;
+
+/**
+ * @brief Vulkan implementation of IPhysicalDevice
+ *
+ * Properties, features, memory heaps and queue families are queried once at
+ * construction; a VkPhysicalDevice never changes while its instance lives.
+ * Holds a reference to the instance so the handle stays valid.
+ */
+class VulkanPhysicalDevice : public IPhysicalDevice {
+public:
+    VulkanPhysicalDevice(VkPhysicalDevice physicalDevice,
+                         const std::shared_ptr<const VulkanInstance>& instance);
+    ~VulkanPhysicalDevice() override = default;
+    
+    VulkanPhysicalDevice(const VulkanPhysicalDevice&) = delete;
+    VulkanPhysicalDevice& operator=(const VulkanPhysicalDevice&) = delete;
+    
+    PhysicalDeviceCapabilities getCapabilities() const override;
+    std::vector<QueueFamily> getQueueFamilies() const override;
+    
+    /**
+     * @brief Always false until the backend creates surfaces
+     */
+    bool supportsSurface(const NativeSurfaceHandle& surface) const override;
+    
+    /**
+     * @brief Not implemented yet, logs an error and returns nullptr
+     */
+    std::shared_ptr<ILogicalDevice> createLogicalDevice(
+        const LogicalDeviceDesc& desc) override;
+    
+    /**
+     * @brief Get native adapter handle
+     * @return Native VkPhysicalDevice handle
+     */
+    NativeAdapterHandle getNativeAdapterHandle() const override;
+    
+    /**
+     * @brief Device limits mapped onto the backend-neutral DeviceLimits
+     */
+    DeviceLimits getLimits() const;
+    
+    /**
+     * @brief Timeline semaphores, core in Vulkan 1.2
+     */
+    bool supportsTimelineSemaphores() const { return _timelineSemaphores; }
+    
+    VkPhysicalDeviceType getDeviceType() const { return _properties.deviceType; }
+    const VkPhysicalDeviceMemoryProperties& getMemoryProperties() const { return _memory; }
+    
+private:
+    void queryCapabilities();
+    bool supportsFormat(VkFormat format, VkFormatFeatureFlags features) const;
+    
+    VkPhysicalDevice _physicalDevice = VK_NULL_HANDLE;
+    std::shared_ptr<const VulkanInstance> _instance;
+    
+    VkPhysicalDeviceProperties _properties = {};
+    VkPhysicalDeviceMemoryProperties _memory = {};
+    std::vector<QueueFamily> _queueFamilies;
+    PhysicalDeviceCapabilities _capabilities;
+    bool _timelineSemaphores = false;
+};
+
+} // namespace pers
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pers/graphics/IBindGroup.h"
+#include <webgpu/webgpu.h>
+#include <memory>
+
+namespace pers {
+
+class WebGPUBindGroup final : public IBindGroup {
+public:
+    WebGPUBindGroup(const BindGroupDesc& desc, WGPUDevice device);
+    ~WebGPUBindGroup() override;
+    
+    // Non-copyable
+    WebGPUBindGroup(const WebGPUBindGroup&) = delete;
+    WebGPUBindGroup& operator=(const WebGPUBindGroup&) = delete;
+    
+    // IBindGroup interface
+    const std::shared_ptr<IBindGroupLayout>& getLayout() const override;
+    const BindGroupDesc& getDesc() const override;
+    NativeBindGroupHandle getNativeBindGroupHandle() const override;
+    
+    bool isValid() const { return _bindGroup != nullptr; }
+    
+private:
+    BindGroupDesc _desc;  // Keeps the layout and bound resources alive
+    WGPUBindGroup _bindGroup = nullptr;
+};
+
+} // namespace pers
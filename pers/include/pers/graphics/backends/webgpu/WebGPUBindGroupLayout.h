@@ -0,0 +1,28 @@
+#pragma once
+
+#include "pers/graphics/IBindGroupLayout.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+class WebGPUBindGroupLayout final : public IBindGroupLayout {
+public:
+    WebGPUBindGroupLayout(const BindGroupLayoutDesc& desc, WGPUDevice device);
+    ~WebGPUBindGroupLayout() override;
+    
+    // Non-copyable
+    WebGPUBindGroupLayout(const WebGPUBindGroupLayout&) = delete;
+    WebGPUBindGroupLayout& operator=(const WebGPUBindGroupLayout&) = delete;
+    
+    // IBindGroupLayout interface
+    const BindGroupLayoutDesc& getDesc() const override;
+    NativeBindGroupLayoutHandle getNativeBindGroupLayoutHandle() const override;
+    
+    bool isValid() const { return _layout != nullptr; }
+    
+private:
+    BindGroupLayoutDesc _desc;
+    WGPUBindGroupLayout _layout = nullptr;
+};
+
+} // namespace pers
@@ -15,11 +15,19 @@ public:
      * @brief Constructor
      * @param encoder WebGPU command encoder handle
      */
-    explicit WebGPUCommandEncoder(WGPUCommandEncoder encoder);
+    /**
+     * @param encoder Native command encoder (takes ownership of the reference)
+     * @param multiDrawIndirect Device has native multi-draw-indirect enabled
+     * @param multiDrawIndirectCount Device has native multi-draw-indirect-count enabled
+     */
+    explicit WebGPUCommandEncoder(WGPUCommandEncoder encoder, bool multiDrawIndirect = false,
+                                  bool multiDrawIndirectCount = false);
     ~WebGPUCommandEncoder() override;
     
     // ICommandEncoder interface implementation
     std::shared_ptr<IRenderPassEncoder> beginRenderPass(const RenderPassDesc& desc) override;
+    std::shared_ptr<IRenderPassEncoder> beginRenderPass(const IPreparedRenderPass& pass) override;
+    std::shared_ptr<IComputePassEncoder> beginComputePass(const ComputePassDesc& desc) override;
     
     bool uploadToDeviceBuffer(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
                              const std::shared_ptr<DeviceBuffer>& deviceBuffer,
@@ -32,9 +40,32 @@ public:
     bool downloadFromDeviceBuffer(const std::shared_ptr<ImmediateDeviceBuffer>& deviceBuffer,
                                  const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
                                  const BufferCopyDesc& copyDesc) override;
+    bool uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                        const std::shared_ptr<ITexture>& texture,
+                        const TextureUploadDesc& desc) override;
+    bool copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                            const std::shared_ptr<ITexture>& texture,
+                            const TextureUploadDesc& desc) override;
+    bool downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                            const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                            const TextureReadbackDesc& desc) override;
+    bool copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                            const std::shared_ptr<DeviceBuffer>& destination,
+                            const TextureReadbackDesc& desc) override;
+    bool copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                             const std::shared_ptr<ITexture>& destination,
+                             const TextureCopyDesc& desc) override;
     bool copyDeviceToDevice(const std::shared_ptr<DeviceBuffer>& source,
                            const std::shared_ptr<DeviceBuffer>& destination,
                            const BufferCopyDesc& copyDesc) override;
+    bool clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer,
+                    uint64_t offset = 0,
+                    uint64_t size = BufferCopyDesc::WHOLE_SIZE) override;
+    bool resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet,
+                         uint32_t firstQuery,
+                         uint32_t queryCount,
+                         const std::shared_ptr<DeviceBuffer>& destination,
+                         uint64_t destinationOffset = 0) override;
     
     std::shared_ptr<ICommandBuffer> finish() override;
     NativeEncoderHandle getNativeEncoderHandle() const override;
@@ -45,7 +76,17 @@ private:
                            const std::shared_ptr<IBuffer>& destination,
                            const BufferCopyDesc& copyDesc);
     
+    // Shared by staging and device buffer variants of the texture copies
+    bool encodeBufferToTexture(const IBuffer& buffer,
+                               const std::shared_ptr<ITexture>& texture,
+                               const TextureUploadDesc& desc);
+    bool encodeTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                               const IBuffer& buffer,
+                               const TextureReadbackDesc& desc);
+    
     WGPUCommandEncoder _encoder = nullptr;
+    bool _multiDrawIndirect = false;
+    bool _multiDrawIndirectCount = false;
     bool _finished = false;
 };
 
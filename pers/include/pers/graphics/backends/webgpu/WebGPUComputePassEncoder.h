@@ -0,0 +1,46 @@
+#pragma once
+
+#include "pers/graphics/IComputePassEncoder.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+/**
+ * @brief WebGPU implementation of IComputePassEncoder
+ */
+class WebGPUComputePassEncoder final : public IComputePassEncoder {
+public:
+    /**
+     * @param encoder Native compute pass encoder (takes ownership of the reference)
+     */
+    explicit WebGPUComputePassEncoder(WGPUComputePassEncoder encoder);
+    ~WebGPUComputePassEncoder() override;
+    
+    // Non-copyable
+    WebGPUComputePassEncoder(const WebGPUComputePassEncoder&) = delete;
+    WebGPUComputePassEncoder& operator=(const WebGPUComputePassEncoder&) = delete;
+    
+    // IComputePassEncoder interface
+    void setPipeline(const std::shared_ptr<IComputePipeline>& pipeline) override;
+    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                      std::span<const uint32_t> dynamicOffsets = {}) override;
+    void setPushConstants(uint32_t offset, std::span<const std::byte> data) override;
+    void dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY = 1,
+                  uint32_t workgroupCountZ = 1) override;
+    void dispatchIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    void beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet, uint32_t queryIndex) override;
+    void endPipelineStatisticsQuery() override;
+    void end() override;
+    NativeComputePassEncoderHandle getNativeComputePassEncoderHandle() const override;
+    
+private:
+    bool canEncode(const char* operation) const;
+    
+    WGPUComputePassEncoder _encoder = nullptr;
+    bool _hasPipeline = false;
+    bool _ended = false;
+    bool _statisticsQueryOpen = false;
+    uint32_t _dispatches = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pers/graphics/IComputePipeline.h"
+#include <webgpu/webgpu.h>
+#include <string>
+
+namespace pers {
+
+class WebGPUComputePipeline final : public IComputePipeline {
+public:
+    WebGPUComputePipeline(const ComputePipelineDesc& desc, WGPUDevice device);
+    ~WebGPUComputePipeline() override;
+    
+    // Non-copyable
+    WebGPUComputePipeline(const WebGPUComputePipeline&) = delete;
+    WebGPUComputePipeline& operator=(const WebGPUComputePipeline&) = delete;
+    
+    // IComputePipeline interface
+    const std::string& getDebugName() const override { return _debugName; }
+    bool isValid() const override { return _pipeline != nullptr; }
+    NativePipelineHandle getNativePipelineHandle() const override;
+    
+    WGPUComputePipeline getNativeHandle() const { return _pipeline; }
+    
+private:
+    WGPUComputePipeline _pipeline = nullptr;
+    std::string _debugName;
+};
+
+} // namespace pers
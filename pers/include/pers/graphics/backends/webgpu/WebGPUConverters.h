@@ -2,6 +2,11 @@
 
 #include "pers/graphics/GraphicsFormats.h"
 #include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/RenderPassTypes.h"
 #include "pers/graphics/SwapChainTypes.h"
 #include "pers/graphics/buffers/BufferTypes.h"
 #include <webgpu/webgpu.h>
@@ -12,7 +17,8 @@ namespace pers {
  * @brief Utility class for converting between Pers types and WebGPU types
  * 
  * Static helper functions for type conversions. No hardcoding,
- * all conversions based on input parameters.
+ * all conversions based on input parameters. Mappings are constexpr tables
+ * checked for completeness at compile time (see pers/utils/EnumTable.h).
  */
 class WebGPUConverters {
 public:
@@ -20,6 +26,22 @@ public:
     static WGPUTextureFormat convertTextureFormat(TextureFormat format);
     static TextureFormat convertFromWGPUTextureFormat(WGPUTextureFormat format);
     
+    // Vertex input state
+    static WGPUVertexFormat convertVertexFormat(VertexFormat format);
+    static WGPUVertexStepMode convertVertexStepMode(VertexStepMode mode);
+    static WGPUIndexFormat convertIndexFormat(IndexFormat format);
+    
+    // Primitive and color target state
+    static WGPUPrimitiveTopology convertPrimitiveTopology(PrimitiveTopology topology);
+    static WGPUCullMode convertCullMode(CullMode mode);
+    static WGPUFrontFace convertFrontFace(FrontFace face);
+    static WGPUColorWriteMask convertColorWriteMask(ColorWriteMask mask);
+    static WGPUBlendOperation convertBlendOperation(BlendOperation operation);
+    static WGPUBlendFactor convertBlendFactor(BlendFactor factor);
+    
+    // Override constants; the entry points into constant.key, which must outlive it
+    static WGPUConstantEntry convertPipelineConstant(const PipelineConstant& constant);
+    
     // Present mode conversions
     static WGPUPresentMode convertPresentMode(PresentMode mode);
     static PresentMode convertFromWGPUPresentMode(WGPUPresentMode mode);
@@ -32,15 +54,29 @@ public:
     static WGPULoadOp convertLoadOp(LoadOp op);
     static WGPUStoreOp convertStoreOp(StoreOp op);
     
+    // Pass attachments; views may be null, read-only depth/stencil aspects drop their load/store
+    static WGPURenderPassColorAttachment convertColorAttachment(const RenderPassColorAttachment& attachment);
+    static WGPURenderPassDepthStencilAttachment convertDepthStencilAttachment(
+        const RenderPassDepthStencilAttachment& attachment);
+    
+    // Pass timestamp writes, false when the pass writes none
+    static bool convertTimestampWrites(const PassTimestampWrites& writes, WGPURenderPassTimestampWrites& out);
+    static bool convertTimestampWrites(const PassTimestampWrites& writes, WGPUComputePassTimestampWrites& out);
+    
     // Compare functions
     static WGPUCompareFunction convertCompareFunction(CompareFunction func);
+    static WGPUStencilOperation convertStencilOperation(StencilOperation operation);
     
     // Texture usage flags
     static WGPUTextureUsage convertTextureUsage(TextureUsage usage);
+    static TextureUsage convertFromWGPUTextureUsage(WGPUTextureUsage usage);
     
     // Buffer usage flags
     static WGPUBufferUsage convertBufferUsage(BufferUsage usage);
     
+    // Shader stage visibility flags
+    static WGPUShaderStage convertShaderStage(ShaderStage stages);
+    
     // Texture dimension
     static WGPUTextureDimension convertTextureDimension(TextureDimension dimension);
     static WGPUTextureViewDimension convertTextureViewDimension(TextureViewDimension dimension);
@@ -48,6 +84,19 @@ public:
     // Texture aspect
     static WGPUTextureAspect convertTextureAspect(TextureAspect aspect);
     
+    // Texture binding sample type
+    static WGPUTextureSampleType convertTextureSampleType(TextureSampleType type);
+    
+    // Sampler state
+    static WGPUFilterMode convertFilterMode(FilterMode mode);
+    static WGPUMipmapFilterMode convertMipmapFilterMode(FilterMode mode);
+    static WGPUAddressMode convertAddressMode(AddressMode mode);
+    
+    // Device features and limits
+    static WGPUFeatureName convertDeviceFeature(DeviceFeature feature);
+    static WGPULimits convertToWGPULimits(const DeviceLimits& limits);
+    static DeviceLimits convertFromWGPULimits(const WGPULimits& limits);
+    
 private:
     // Static utility class, no instantiation
     WebGPUConverters() = delete;
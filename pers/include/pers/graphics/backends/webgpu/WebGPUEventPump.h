@@ -0,0 +1,87 @@
+#pragma once
+
+#include <webgpu/webgpu.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Background service that drives WebGPU async callbacks
+ *
+ * Owned by WebGPUInstance and shared with the devices, queues and buffers it
+ * creates. Each async operation (adapter/device request, mapAsync, queue
+ * work-done) brackets itself with beginAsync()/endAsync(). While operations
+ * are outstanding the pump thread calls wgpuInstanceProcessEvents and
+ * wgpuDevicePoll for every registered device, backing off exponentially from
+ * MIN_BACKOFF to MAX_BACKOFF while nothing completes. With nothing
+ * outstanding it sleeps on a condition variable and costs no CPU.
+ *
+ * wgpu-native does not implement wgpuInstanceWaitAny, so a poll thread is
+ * used instead of WGPUCallbackMode_WaitAnyOnly futures.
+ */
+class WebGPUEventPump {
+public:
+    static constexpr std::chrono::microseconds MIN_BACKOFF{50};
+    static constexpr std::chrono::microseconds MAX_BACKOFF{2000};
+
+    /**
+     * @brief Constructor, starts the pump thread
+     * @param instance Instance whose events are processed
+     */
+    explicit WebGPUEventPump(WGPUInstance instance);
+    ~WebGPUEventPump();
+
+    WebGPUEventPump(const WebGPUEventPump&) = delete;
+    WebGPUEventPump& operator=(const WebGPUEventPump&) = delete;
+
+    /**
+     * @brief Register a device to be polled
+     */
+    void addDevice(WGPUDevice device);
+
+    /**
+     * @brief Stop polling a device, call before releasing it
+     */
+    void removeDevice(WGPUDevice device);
+
+    /**
+     * @brief Mark an async operation as outstanding and wake the pump
+     */
+    void beginAsync();
+
+    /**
+     * @brief Mark an async operation as finished, call from its callback
+     */
+    void endAsync();
+
+    /**
+     * @brief Process events and poll devices once on the calling thread
+     */
+    void pumpOnce();
+
+    uint32_t getPendingCount() const { return _pending.load(); }
+
+private:
+    void run();
+
+    WGPUInstance _instance = nullptr;
+
+    std::mutex _deviceMutex;
+    std::vector<WGPUDevice> _devices;
+
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCv;
+    std::atomic<uint32_t> _pending{0};
+    std::atomic<uint64_t> _completed{0};  // Bumped by endAsync, used to reset backoff
+    bool _stop = false;
+
+    std::thread _thread;
+};
+
+} // namespace pers
@@ -3,9 +3,12 @@
 #include "pers/graphics/IInstance.h"
 #include "pers/graphics/backends/IGraphicsInstanceFactory.h"  // For InstanceDesc
 #include <webgpu/webgpu.h>
+#include <memory>
 
 namespace pers {
 
+class WebGPUEventPump;
+
 /**
  * @brief WebGPU implementation of IInstance
  */
@@ -29,6 +32,11 @@ public:
     std::shared_ptr<IPhysicalDevice> requestPhysicalDevice(
         const PhysicalDeviceOptions& options) override;
     
+    /**
+     * @brief Enumerate adapters via wgpuInstanceEnumerateAdapters
+     */
+    std::vector<std::shared_ptr<IPhysicalDevice>> enumeratePhysicalDevices() override;
+    
     /**
      * @brief Create a surface from a native window handle
      * @param windowHandle Native window handle (GLFWwindow*)
@@ -37,13 +45,22 @@ public:
     NativeSurfaceHandle createSurface(void* windowHandle) override;
     
     /**
-     * @brief Process pending events (for testing/headless environments)
+     * @brief Process pending events on the calling thread
+     * Not required for callbacks to fire; the event pump drives them in the background.
      */
     void processEvents() override;
     
+    /**
+     * @brief Get the event pump shared with devices created from this instance
+     */
+    const std::shared_ptr<WebGPUEventPump>& getEventPump() const;
+    
 private:
+    std::shared_ptr<IPhysicalDevice> requestPhysicalDeviceByBenchmark(const PhysicalDeviceOptions& options);
+    
     WGPUInstance _instance = nullptr;
     InstanceDesc _desc; // Stored instance configuration
+    std::shared_ptr<WebGPUEventPump> _eventPump;
 };
 
 } // namespace pers
\ No newline at end of file
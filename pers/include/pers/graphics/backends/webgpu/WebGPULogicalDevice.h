@@ -2,11 +2,22 @@
 
 #include "pers/graphics/ILogicalDevice.h"
 #include <webgpu/webgpu.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace pers {
 
+class WebGPUEventPump;
+
+/**
+ * @brief Set by the device-lost callback, which is registered before the logical device exists
+ */
+struct WebGPUDeviceLostState {
+    std::atomic<bool> lost{false};
+};
+
 /**
  * @brief WebGPU implementation of ILogicalDevice
  * 
@@ -21,9 +32,13 @@ public:
      * @brief Constructor
      * @param device WebGPU device handle (takes ownership)
      * @param physicalDevice The physical device this logical device was created from
+     * @param eventPump Instance event pump that polls this device, may be null
+     * @param lostState State the device's lost callback writes, may be null
      */
     WebGPULogicalDevice(WGPUDevice device,
-                       const std::shared_ptr<IPhysicalDevice>& physicalDevice);
+                       const std::shared_ptr<IPhysicalDevice>& physicalDevice,
+                       const std::shared_ptr<WebGPUEventPump>& eventPump = nullptr,
+                       const std::shared_ptr<WebGPUDeviceLostState>& lostState = nullptr);
     ~WebGPULogicalDevice() override;
     
     // Delete copy operations to prevent double-free
@@ -40,8 +55,15 @@ public:
     // Resource creation factory
     const std::shared_ptr<IResourceFactory>& getResourceFactory() const override;
     
+    // Upload staging buffer recycling
+    const std::shared_ptr<StagingBufferPool>& getStagingBufferPool() const override;
+    
+    // Deferred release of resources still used by in-flight work
+    const std::shared_ptr<DeferredDeletionQueue>& getDeletionQueue() const override;
+    
     // Command operations
     std::shared_ptr<ICommandEncoder> createCommandEncoder() override;
+    std::shared_ptr<IRenderBundleEncoder> createRenderBundleEncoder(const RenderBundleEncoderDesc& desc) override;
     
     // Swap chain creation
     std::shared_ptr<ISwapChain> createSwapChain(
@@ -54,19 +76,36 @@ public:
     // Native handle access
     NativeDeviceHandle getNativeDeviceHandle() const override;
     
+    // Granted limits and features
+    DeviceLimits getLimits() const override;
+    bool hasFeature(DeviceFeature feature) const override;
+    
     // Physical device access
     std::shared_ptr<IPhysicalDevice> getPhysicalDevice() const override;
     
+    bool isLost() const override;
+    
     // SwapChain management (for depth buffer auto-linking)
     void setCurrentSwapChain(const std::shared_ptr<ISwapChain>& swapChain);
     std::shared_ptr<ISwapChain> getCurrentSwapChain() const;
+    
+    // Async callback driver shared with queue and mappable buffers
+    const std::shared_ptr<WebGPUEventPump>& getEventPump() const;
 
 private:
     WGPUDevice _device = nullptr;
     std::weak_ptr<IPhysicalDevice> _physicalDevice;  // The physical device this was created from
+    std::shared_ptr<WebGPUEventPump> _eventPump;
+    std::shared_ptr<WebGPUDeviceLostState> _lostState;  // Outlives _device, the release may still report
     std::shared_ptr<IQueue> _defaultQueue;  // WebGPU has single queue
     mutable std::shared_ptr<IResourceFactory> _resourceFactory;  // Cached factory
+    mutable std::shared_ptr<StagingBufferPool> _stagingBufferPool;  // Created on first access
+    mutable std::once_flag _resourceFactoryOnce;  // Loader threads may race for the first access
+    mutable std::once_flag _stagingBufferPoolOnce;
+    std::shared_ptr<DeferredDeletionQueue> _deletionQueue;  // Created with the default queue
     std::weak_ptr<ISwapChain> _currentSwapChain;  // Track current SwapChain for auto depth buffer
+    bool _multiDrawIndirect = false;  // Native multi-draw-indirect enabled on the device
+    bool _multiDrawIndirectCount = false;
     
     bool createDefaultQueue();
 };
@@ -4,9 +4,13 @@
 #include <webgpu/webgpu.h>
 #include <optional>
 #include <mutex>
+#include <memory>
+#include <vector>
 
 namespace pers {
 
+class WebGPUEventPump;
+
 /**
  * @brief WebGPU implementation of IPhysicalDevice
  * 
@@ -17,7 +21,13 @@ namespace pers {
 class WebGPUPhysicalDevice : public IPhysicalDevice,
                              public std::enable_shared_from_this<WebGPUPhysicalDevice> {
 public:
-    explicit WebGPUPhysicalDevice(WGPUAdapter adapter);
+    /**
+     * @brief Constructor
+     * @param adapter WebGPU adapter handle
+     * @param eventPump Instance event pump, shared with logical devices created from this adapter
+     */
+    explicit WebGPUPhysicalDevice(WGPUAdapter adapter,
+                                  const std::shared_ptr<WebGPUEventPump>& eventPump = nullptr);
     ~WebGPUPhysicalDevice() override;
     
     // Delete copy operations to prevent double-free
@@ -30,10 +40,22 @@ public:
     
     /**
      * @brief Get device capabilities
+     *
+     * Limits and features are queried from the adapter once and reused by
+     * getCapabilities(), createLogicalDevice() and feature checks until
+     * invalidateCapabilities() is called.
      * @return Device capabilities structure
      */
     PhysicalDeviceCapabilities getCapabilities() const override;
     
+    /**
+     * @brief Drop cached adapter limits, features and surface capabilities
+     *
+     * Call after events that can change what the adapter reports, such as a
+     * driver reset or the window moving to another display.
+     */
+    void invalidateCapabilities();
+    
     /**
      * @brief Get available queue families
      * @return Vector of queue families
@@ -63,19 +85,32 @@ public:
     
 private:
     WGPUAdapter _adapter = nullptr;
+    std::shared_ptr<WebGPUEventPump> _eventPump;
     WGPUAdapterInfo _adapterInfo = {};  // Adapter info queried at construction
     bool _adapterInfoValid = false;     // Track if adapter info was successfully queried
     
+    // Raw adapter query results, shared by every path that needs limits or features
+    struct AdapterQuery {
+        WGPULimits limits = {};
+        bool limitsValid = false;
+        uint32_t maxPushConstantSize = 0;  // From WGPUNativeLimits, chained to the limits query
+        std::vector<WGPUFeatureName> features;
+    };
+    
     // Cached capabilities to avoid repeated queries
+    mutable std::optional<AdapterQuery> _cachedAdapterQuery;
     mutable std::optional<PhysicalDeviceCapabilities> _cachedCapabilities;
     mutable std::optional<std::vector<QueueFamily>> _cachedQueueFamilies;
     mutable std::mutex _cacheMutex;  // Thread-safety for cache access
     
     void queryAdapterInfo();
-    PhysicalDeviceCapabilities queryCapabilities() const;
+    const AdapterQuery& getAdapterQuery() const;  // Requires _cacheMutex
+    PhysicalDeviceCapabilities queryCapabilities(const AdapterQuery& query) const;
     bool validateLimitsWithinCapability(const DeviceLimits& requested, const WGPULimits& available) const;
     bool checkFeatureSupport(const std::vector<DeviceFeature>& requiredFeatures, 
                             std::vector<WGPUFeatureName>& outWGPUFeatures) const;
+    void addSupportedFeatures(const std::vector<DeviceFeature>& preferredFeatures,
+                              std::vector<WGPUFeatureName>& inOutWGPUFeatures) const;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "pers/graphics/IPipelineLayout.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+class WebGPUPipelineLayout final : public IPipelineLayout {
+public:
+    WebGPUPipelineLayout(const PipelineLayoutDesc& desc, WGPUDevice device);
+    ~WebGPUPipelineLayout() override;
+    
+    // Non-copyable
+    WebGPUPipelineLayout(const WebGPUPipelineLayout&) = delete;
+    WebGPUPipelineLayout& operator=(const WebGPUPipelineLayout&) = delete;
+    
+    // IPipelineLayout interface
+    const PipelineLayoutDesc& getDesc() const override;
+    NativePipelineLayoutHandle getNativePipelineLayoutHandle() const override;
+    
+    bool isValid() const { return _layout != nullptr; }
+    
+private:
+    PipelineLayoutDesc _desc;  // Keeps the bind group layouts alive
+    WGPUPipelineLayout _layout = nullptr;
+};
+
+} // namespace pers
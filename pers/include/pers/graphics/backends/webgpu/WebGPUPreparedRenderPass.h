@@ -0,0 +1,48 @@
+#pragma once
+
+#include "pers/graphics/IPreparedRenderPass.h"
+#include <webgpu/webgpu.h>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief WebGPU implementation of IPreparedRenderPass
+ *
+ * Owns the native descriptor and attachment arrays it points into, so it is
+ * neither copied nor moved.
+ */
+class WebGPUPreparedRenderPass : public IPreparedRenderPass {
+public:
+    explicit WebGPUPreparedRenderPass(const RenderPassDesc& desc);
+    ~WebGPUPreparedRenderPass() override = default;
+    
+    WebGPUPreparedRenderPass(const WebGPUPreparedRenderPass&) = delete;
+    WebGPUPreparedRenderPass& operator=(const WebGPUPreparedRenderPass&) = delete;
+    
+    // IPreparedRenderPass interface
+    const RenderPassDesc& getDesc() const override { return _desc; }
+    bool setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) override;
+    bool setResolveTarget(uint32_t index, const std::shared_ptr<ITextureView>& view) override;
+    bool setClearColor(uint32_t index, const Color& color) override;
+    bool setDepthStencilView(const std::shared_ptr<ITextureView>& view) override;
+    
+    /**
+     * @brief Descriptor for wgpuCommandEncoderBeginRenderPass, valid while this object lives
+     */
+    const WGPURenderPassDescriptor& getNativeDescriptor() const { return _native; }
+    
+    /**
+     * @brief Every color attachment has a view
+     */
+    bool isComplete() const;
+    
+private:
+    RenderPassDesc _desc;
+    std::vector<WGPURenderPassColorAttachment> _colorAttachments;
+    WGPURenderPassDepthStencilAttachment _depthStencilAttachment = {};
+    WGPURenderPassTimestampWrites _timestampWrites = {};
+    WGPURenderPassDescriptor _native = {};
+};
+
+} // namespace pers
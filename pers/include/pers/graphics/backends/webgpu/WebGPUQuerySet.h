@@ -0,0 +1,31 @@
+#pragma once
+
+#include "pers/graphics/IQuerySet.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+/**
+ * @brief WebGPU implementation of IQuerySet
+ */
+class WebGPUQuerySet : public IQuerySet {
+public:
+    WebGPUQuerySet(const QuerySetDesc& desc, WGPUDevice device);
+    ~WebGPUQuerySet() override;
+    
+    WebGPUQuerySet(const WebGPUQuerySet&) = delete;
+    WebGPUQuerySet& operator=(const WebGPUQuerySet&) = delete;
+    
+    // IQuerySet interface
+    QueryType getType() const override { return _desc.type; }
+    uint32_t getCount() const override { return _desc.count; }
+    const QuerySetDesc& getDesc() const override { return _desc; }
+    NativeQuerySetHandle getNativeQuerySetHandle() const override;
+    bool isValid() const override { return _querySet != nullptr; }
+    
+private:
+    QuerySetDesc _desc;
+    WGPUQuerySet _querySet = nullptr;
+};
+
+} // namespace pers
@@ -1,34 +1,61 @@
 #pragma once
 
 #include "pers/graphics/IQueue.h"
+#include "pers/utils/Mutex.h"
 #include <webgpu/webgpu.h>
 #include <memory>
 #include <vector>
 
 namespace pers {
 
+class StagingBufferPool;
+class WebGPUEventPump;
+
 /**
  * @brief WebGPU implementation of IQueue
  */
 class WebGPUQueue : public IQueue {
 public:
+    // Submits up to this many command buffers convert and flush without touching the heap
+    static constexpr size_t INLINE_SUBMIT_CAPACITY = 16;
+    
+    // Texture writes larger than this go through the staging pool in bands
+    static constexpr uint64_t TILED_TEXTURE_UPLOAD_THRESHOLD = 16ull * 1024 * 1024;
+    static constexpr uint64_t TEXTURE_UPLOAD_TILE_SIZE = 4ull * 1024 * 1024;
+    
     /**
      * @brief Constructor
      * @param queue WebGPU queue handle
+     * @param device Owning device, used to poll for completion callbacks
+     * @param eventPump Event pump that drives completion callbacks in the background
      */
-    explicit WebGPUQueue(WGPUQueue queue);
+    explicit WebGPUQueue(WGPUQueue queue,
+                         WGPUDevice device = nullptr,
+                         const std::shared_ptr<WebGPUEventPump>& eventPump = nullptr);
     ~WebGPUQueue() override;
     
     // IQueue interface implementation
-    bool submit(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) override;
-    bool submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) override;
-    bool submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) override;
+    using IQueue::submit;
+    SubmissionFence submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) override;
+    SubmissionFence submit(std::span<const NativeCommandBufferHandle> commandBuffers) override;
+    SubmissionFence submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) override;
+    SubmissionFence submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) override;
+    void beginSubmissionBatch() override;
+    SubmissionFence endSubmissionBatch() override;
+    SubmissionFence flushSubmissions() override;
     bool writeBuffer(const BufferWriteDesc& desc) override;
+    bool writeBuffer(const std::shared_ptr<IBuffer>& buffer,
+                     uint64_t offset,
+                     std::span<const std::byte> data) override;
+    bool writeBuffers(std::span<const BufferWriteDesc> writes) override;
     bool writeTexture(const std::shared_ptr<ITexture>& texture, 
                      const void* data, 
                      uint64_t dataSize,
                      uint32_t mipLevel = 0) override;
+    bool writeTexture(const TextureWriteDesc& desc) override;
     bool waitIdle() override;
+    bool onSubmittedWorkDone(QueueWorkDoneCallback callback) override;
+    bool pollSubmittedWork(bool wait) override;
     
     /**
      * @brief Get native queue handle
@@ -45,8 +72,43 @@ public:
      */
     void writeBuffer(WGPUBuffer buffer, uint64_t offset, const void* data, uint64_t size);
     
+    /**
+     * @brief Set the staging pool used for tiled texture uploads
+     * @param pool Device staging pool, held weakly since the pool references this queue
+     */
+    void setStagingBufferPool(const std::weak_ptr<StagingBufferPool>& pool);
+    
 private:
+    struct CompletionTarget;
+    
+    // Submit now or append to the open batch; null owners are native submits the caller keeps alive
+    SubmissionFence dispatch(const WGPUCommandBuffer* commandBuffers, size_t count,
+                             const std::shared_ptr<ICommandBuffer>* owners);
+    SubmissionFence signalSubmission();
+    void registerCompletion(uint64_t value);
+    
+    bool writeTextureTiled(const std::shared_ptr<StagingBufferPool>& pool,
+                           const WGPUTexelCopyTextureInfo& destination,
+                           const uint8_t* data,
+                           const WGPUTexelCopyBufferLayout& layout,
+                           const WGPUExtent3D& extent,
+                           uint32_t blockHeight,
+                           uint64_t rowBytes);
+    
     WGPUQueue _queue = nullptr;
+    WGPUDevice _device = nullptr;
+    std::weak_ptr<StagingBufferPool> _stagingBufferPool;
+    std::shared_ptr<SubmissionTimeline> _timeline;
+    std::shared_ptr<WebGPUEventPump> _eventPump;
+    CompletionTarget* _completion = nullptr;  // Referenced by every pending work-done callback
+    
+    // Guards the open batch; native submits run outside it
+    Mutex<false> _batchMutex{"WebGPUQueue::Batch"};
+    uint32_t _batchDepth = 0;
+    uint64_t _batchValue = 0;  // Timeline value reserved by the open batch, 0 if empty
+    // Cleared, not released, by each flush so steady-state batches reuse their capacity
+    std::vector<WGPUCommandBuffer> _batchedBuffers;
+    std::vector<std::shared_ptr<ICommandBuffer>> _batchedOwners;  // Keep native buffers alive until submit
 };
 
 } // namespace pers
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pers/graphics/IRenderBundle.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+class WebGPURenderBundle final : public IRenderBundle {
+public:
+    /**
+     * @param bundle Native bundle (takes ownership of the reference)
+     * @param drawCount Draw calls recorded into the bundle
+     */
+    WebGPURenderBundle(WGPURenderBundle bundle, uint32_t drawCount);
+    ~WebGPURenderBundle() override;
+    
+    // Non-copyable
+    WebGPURenderBundle(const WebGPURenderBundle&) = delete;
+    WebGPURenderBundle& operator=(const WebGPURenderBundle&) = delete;
+    
+    // IRenderBundle interface
+    uint32_t getDrawCount() const override { return _drawCount; }
+    NativeRenderBundleHandle getNativeRenderBundleHandle() const override;
+    
+private:
+    WGPURenderBundle _bundle = nullptr;
+    uint32_t _drawCount = 0;
+};
+
+} // namespace pers
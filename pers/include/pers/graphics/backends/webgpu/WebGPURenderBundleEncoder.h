@@ -0,0 +1,55 @@
+#pragma once
+
+#include "pers/graphics/IRenderBundle.h"
+#include <webgpu/webgpu.h>
+#include <memory>
+#include <string>
+
+namespace pers {
+
+/**
+ * @brief WebGPU implementation of IRenderBundleEncoder
+ */
+class WebGPURenderBundleEncoder final : public IRenderBundleEncoder {
+public:
+    /**
+     * @param encoder Native bundle encoder (takes ownership of the reference)
+     * @param label Label given to the finished bundle
+     */
+    WebGPURenderBundleEncoder(WGPURenderBundleEncoder encoder, const std::string& label);
+    ~WebGPURenderBundleEncoder() override;
+    
+    // Non-copyable
+    WebGPURenderBundleEncoder(const WebGPURenderBundleEncoder&) = delete;
+    WebGPURenderBundleEncoder& operator=(const WebGPURenderBundleEncoder&) = delete;
+    
+    // IRenderBundleEncoder interface
+    void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) override;
+    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                      std::span<const uint32_t> dynamicOffsets = {}) override;
+    void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                         uint64_t offset = 0, uint64_t size = 0) override;
+    void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                        IndexFormat indexFormat,
+                        uint64_t offset = 0, uint64_t size = 0) override;
+    void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) override;
+    void draw(uint32_t vertexCount, uint32_t instanceCount = 1,
+              uint32_t firstVertex = 0, uint32_t firstInstance = 0) override;
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1,
+                     uint32_t firstIndex = 0, int32_t baseVertex = 0,
+                     uint32_t firstInstance = 0) override;
+    void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    std::shared_ptr<IRenderBundle> finish() override;
+    
+private:
+    bool canRecord(const char* operation) const;
+    
+    WGPURenderBundleEncoder _encoder = nullptr;
+    std::string _label;
+    uint32_t _drawCount = 0;
+    bool _finished = false;
+    bool _failed = false;  // A command could not be recorded, finish() returns null
+};
+
+} // namespace pers
@@ -2,7 +2,9 @@
 
 #include "pers/graphics/IRenderPassEncoder.h"
 #include <webgpu/webgpu.h>
+#include <array>
 #include <memory>
+#include <vector>
 
 namespace pers {
 
@@ -14,13 +16,20 @@ public:
     /**
      * @brief Constructor
      * @param encoder WebGPU render pass encoder handle
+     * @param resourceTable Table resolving handle-based setters, may be null
+     * @param multiDrawIndirect Device has native multi-draw-indirect enabled
+     * @param multiDrawIndirectCount Device has native multi-draw-indirect-count enabled
      */
-    explicit WebGPURenderPassEncoder(WGPURenderPassEncoder encoder);
+    explicit WebGPURenderPassEncoder(WGPURenderPassEncoder encoder,
+                                     const RenderResourceTable* resourceTable = nullptr,
+                                     bool multiDrawIndirect = false,
+                                     bool multiDrawIndirectCount = false);
     ~WebGPURenderPassEncoder() override;
     
     // IRenderPassEncoder interface implementation
     void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) override;
-    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup) override;
+    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                      std::span<const uint32_t> dynamicOffsets = {}) override;
     void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer, 
                         uint64_t offset = 0, uint64_t size = 0) override;
     void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer, 
@@ -31,12 +40,89 @@ public:
     void drawIndexed(uint32_t indexCount, uint32_t instanceCount = 1,
                     uint32_t firstIndex = 0, int32_t baseVertex = 0,
                     uint32_t firstInstance = 0) override;
+    void setPipeline(PipelineHandle pipeline) override;
+    void setBindGroup(uint32_t index, BindGroupHandle bindGroup,
+                      std::span<const uint32_t> dynamicOffsets = {}) override;
+    void setVertexBuffer(uint32_t slot, BufferHandle buffer,
+                         uint64_t offset = 0, uint64_t size = 0) override;
+    void setIndexBuffer(BufferHandle buffer, IndexFormat indexFormat,
+                        uint64_t offset = 0, uint64_t size = 0) override;
+    void setViewport(float x, float y, float width, float height,
+                     float minDepth = 0.0f, float maxDepth = 1.0f) override;
+    void setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+    void setStencilReference(uint32_t reference) override;
+    void setBlendConstant(const Color& color) override;
+    void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) override;
+    void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset = 0) override;
+    void multiDrawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                           uint64_t indirectOffset, uint32_t drawCount) override;
+    void multiDrawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                  uint64_t indirectOffset, uint32_t drawCount) override;
+    void multiDrawIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                uint32_t maxDrawCount) override;
+    void multiDrawIndexedIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                       const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                       uint32_t maxDrawCount) override;
+    void executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) override;
+    void beginOcclusionQuery(uint32_t queryIndex) override;
+    void endOcclusionQuery() override;
+    void beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet, uint32_t queryIndex) override;
+    void endPipelineStatisticsQuery() override;
     void end() override;
     NativeRenderPassEncoderHandle getNativeRenderPassEncoderHandle() const override;
+    RenderPassEncoderStats getStats() const override { return _stats; }
     
 private:
+    // WebGPU default limits; slots beyond these are forwarded untracked
+    static constexpr uint32_t MAX_TRACKED_VERTEX_BUFFERS = 8;
+    static constexpr uint32_t MAX_TRACKED_BIND_GROUPS = 4;
+    
+    struct BufferBinding {
+        WGPUBuffer buffer = nullptr;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        
+        bool operator==(const BufferBinding& other) const {
+            return buffer == other.buffer && offset == other.offset && size == other.size;
+        }
+    };
+    
+    struct BindGroupBinding {
+        WGPUBindGroup bindGroup = nullptr;
+        std::vector<uint32_t> dynamicOffsets;
+    };
+    
+    bool canRecord(const char* operation) const;
+    bool canEncode(const char* operation) const;  // Also requires a resource table
+    void resetBoundState();
+    
+    // Native buffer and absolute offset of an indirect argument record, false if unusable
+    bool resolveIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                         uint64_t recordSize, uint32_t drawCount, WGPUBuffer& buffer, uint64_t& offset) const;
+    
+    // Shared tail of both setter paths: state filtering and the native call
+    void bindPipeline(WGPURenderPipeline pipeline);
+    void bindBindGroup(uint32_t index, WGPUBindGroup bindGroup, std::span<const uint32_t> dynamicOffsets);
+    void bindVertexBuffer(uint32_t slot, WGPUBuffer buffer, uint64_t offset, uint64_t size);
+    void bindIndexBuffer(WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size);
+    
     WGPURenderPassEncoder _encoder = nullptr;
+    const RenderResourceTable* _resourceTable = nullptr;
+    bool _multiDrawIndirect = false;
+    bool _multiDrawIndirectCount = false;
     bool _ended = false;
+    bool _occlusionQueryOpen = false;
+    bool _statisticsQueryOpen = false;
+    
+    // Currently bound state, used to skip redundant native calls
+    WGPURenderPipeline _boundPipeline = nullptr;
+    std::array<BufferBinding, MAX_TRACKED_VERTEX_BUFFERS> _boundVertexBuffers = {};
+    BufferBinding _boundIndexBuffer;
+    WGPUIndexFormat _boundIndexFormat = WGPUIndexFormat_Undefined;
+    std::array<BindGroupBinding, MAX_TRACKED_BIND_GROUPS> _boundBindGroups;
+    RenderPassEncoderStats _stats;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -2,24 +2,46 @@
 
 #include "pers/graphics/IRenderPipeline.h"
 #include <webgpu/webgpu.h>
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace pers {
 
+class WebGPUEventPump;
+
 class WebGPURenderPipeline final : public IRenderPipeline {
 public:
+    using AsyncCallback = std::function<void(std::shared_ptr<WebGPURenderPipeline> pipeline)>;
+    
     WebGPURenderPipeline(const RenderPipelineDesc& desc, WGPUDevice device);
+    
+    // Adopts an already created pipeline (takes ownership of the reference)
+    WebGPURenderPipeline(WGPURenderPipeline pipeline, const RenderPipelineDesc& desc);
     ~WebGPURenderPipeline() override;
     
     // IRenderPipeline interface
     const std::string& getDebugName() const override;
     bool isValid() const override;
+    RenderPipelineDesc getDesc() const override;
+    NativePipelineHandle getNativePipelineHandle() const override;
     
     // WebGPU specific - internal use only
     WGPURenderPipeline getNativeHandle() const;
     
+    /**
+     * Compile via wgpuDeviceCreateRenderPipelineAsync
+     * The callback receives null on failure and may run on the event pump thread.
+     * @return false if the descriptor was invalid; callback has already run
+     */
+    static bool createAsync(const RenderPipelineDesc& desc,
+                            WGPUDevice device,
+                            const std::shared_ptr<WebGPUEventPump>& eventPump,
+                            AsyncCallback callback);
+    
 private:
-    std::string _debugName;
+    DebugLabel _debugName;
+    RenderPipelineDesc _desc;
     WGPURenderPipeline _pipeline = nullptr;
 };
 
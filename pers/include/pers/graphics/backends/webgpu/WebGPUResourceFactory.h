@@ -1,6 +1,9 @@
 #pragma once
 
 #include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/PipelineCache.h"
+#include "pers/graphics/BindGroupCache.h"
+#include "pers/graphics/SamplerCache.h"
 #include <webgpu/webgpu.h>
 #include <memory>
 
@@ -9,6 +12,13 @@ namespace pers {
 // Forward declaration
 class WebGPULogicalDevice;
 
+/**
+ * @brief WebGPU resource factory, safe to call from any thread
+ *
+ * wgpu devices are internally synchronized, so the create methods hold no
+ * factory-wide lock: the device is reached through a lock-free weak_ptr and
+ * the pipeline, bind group and sampler caches lock one shard per lookup.
+ */
 class WebGPUResourceFactory final : public IResourceFactory {
 public:
     explicit WebGPUResourceFactory(const std::shared_ptr<WebGPULogicalDevice>& logicalDevice);
@@ -20,18 +30,51 @@ public:
         const BufferDesc& desc,
         const void* initialData,
         size_t dataSize) const override;
+    std::vector<std::shared_ptr<INativeBuffer>> createBuffers(std::span<const BufferDesc> descs) const override;
+    std::vector<std::shared_ptr<INativeBuffer>> createInitializableDeviceBuffers(
+        std::span<const BufferInitDesc> buffers) const override;
     std::shared_ptr<ITexture> createTexture(const TextureDesc& desc) const override;
+    std::vector<std::shared_ptr<ITexture>> createTextures(std::span<const TextureDesc> descs) const override;
     std::shared_ptr<ITextureView> createTextureView(
         const std::shared_ptr<ITexture>& texture,
         const TextureViewDesc& desc) const override;
     std::shared_ptr<ISampler> createSampler(const SamplerDesc& desc) const override;
     std::shared_ptr<IShaderModule> createShaderModule(const ShaderModuleDesc& desc) const override;
     std::shared_ptr<IRenderPipeline> createRenderPipeline(const RenderPipelineDesc& desc) const override;
+    std::shared_ptr<AsyncRenderPipeline> createRenderPipelineAsync(
+        const RenderPipelineDesc& desc,
+        const std::shared_ptr<IRenderPipeline>& fallback = nullptr) const override;
+    std::shared_ptr<IComputePipeline> createComputePipeline(const ComputePipelineDesc& desc) const override;
     std::shared_ptr<INativeMappableBuffer> createMappableBuffer(const BufferDesc& desc) const override;
+    std::shared_ptr<IBindGroupLayout> createBindGroupLayout(const BindGroupLayoutDesc& desc) const override;
+    std::shared_ptr<IBindGroup> createBindGroup(const BindGroupDesc& desc) const override;
+    std::shared_ptr<IPipelineLayout> createPipelineLayout(const PipelineLayoutDesc& desc) const override;
+    std::shared_ptr<IQuerySet> createQuerySet(const QuerySetDesc& desc) const override;
+    std::shared_ptr<IPreparedRenderPass> createPreparedRenderPass(const RenderPassDesc& desc) const override;
     
+    // Render pipelines created by this factory, deduplicated by desc
+    PipelineCache& getPipelineCache() const { return _pipelineCache; }
+    
+    // Bind groups, bind group layouts and pipeline layouts created by this factory, deduplicated by content
+    BindGroupCache& getBindGroupCache() const { return _bindGroupCache; }
+    
+    // Samplers created by this factory, deduplicated by state
+    SamplerCache& getSamplerCache() const { return _samplerCache; }
     
 private:
+    // Single-object creation on an already locked device, shared with the batch calls
+    std::shared_ptr<INativeBuffer> createBuffer(WGPUDevice wgpuDevice, const BufferDesc& desc) const;
+    std::shared_ptr<ITexture> createTexture(WGPUDevice wgpuDevice, const TextureDesc& desc) const;
+    
+    // Fill a null layout and missing vertex layouts from shader reflection
+    // @return true if derived differs from desc
+    bool deriveLayouts(const RenderPipelineDesc& desc, RenderPipelineDesc& derived) const;
+    bool deriveLayouts(const ComputePipelineDesc& desc, ComputePipelineDesc& derived) const;
+    
     std::weak_ptr<WebGPULogicalDevice> _logicalDevice;
+    mutable PipelineCache _pipelineCache;
+    mutable BindGroupCache _bindGroupCache;
+    mutable SamplerCache _samplerCache;
 };
 
 } // namespace pers
\ No newline at end of file
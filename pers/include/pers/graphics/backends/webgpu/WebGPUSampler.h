@@ -0,0 +1,30 @@
+#pragma once
+
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IResourceFactory.h"
+#include <webgpu/webgpu.h>
+
+namespace pers {
+
+/**
+ * @brief WebGPU implementation of ISampler
+ */
+class WebGPUSampler : public ISampler {
+public:
+    WebGPUSampler(const SamplerDesc& desc, WGPUDevice device);
+    ~WebGPUSampler() override;
+    
+    WebGPUSampler(const WebGPUSampler&) = delete;
+    WebGPUSampler& operator=(const WebGPUSampler&) = delete;
+    
+    // ISampler interface
+    NativeSamplerHandle getNativeSamplerHandle() const override;
+    const SamplerDesc& getDesc() const override { return _desc; }
+    bool isValid() const override { return _sampler != nullptr; }
+    
+private:
+    SamplerDesc _desc;
+    WGPUSampler _sampler = nullptr;
+};
+
+} // namespace pers
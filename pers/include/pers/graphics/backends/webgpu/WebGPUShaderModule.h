@@ -1,8 +1,10 @@
 #pragma once
 
 #include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ShaderReflection.h"
 #include <webgpu/webgpu.h>
 #include <string>
+#include <vector>
 
 namespace pers {
 
@@ -16,6 +18,9 @@ public:
     const std::string& getEntryPoint() const override;
     const std::string& getDebugName() const override;
     bool isValid() const override;
+    const std::string& getCode() const override;
+    const std::vector<uint32_t>& getSpirv() const override;
+    const ShaderReflection& getReflection() const override;
     
     // WebGPU specific - internal use only
     WGPUShaderModule getNativeHandle() const;
@@ -24,8 +29,10 @@ public:
 private:
     ShaderStage _stage;
     std::string _entryPoint;
-    std::string _debugName;
-    std::string _code;  // Store code until device is available
+    DebugLabel _debugName;
+    std::string _code;             // Compiled once the device is available, kept for getCode()
+    std::vector<uint32_t> _spirv;  // Takes the place of _code when set
+    ShaderReflection _reflection;
     WGPUShaderModule _shaderModule = nullptr;
 };
 
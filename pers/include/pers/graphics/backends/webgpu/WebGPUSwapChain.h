@@ -3,15 +3,26 @@
 #include "pers/graphics/ISwapChain.h"
 #include "pers/graphics/SwapChainDescBuilder.h"
 #include <webgpu/webgpu.h>
+#include <array>
+#include <cstdint>
 #include <memory>
 
 namespace pers {
 
 class WebGPULogicalDevice;
+class WebGPUTexture;
 class WebGPUTextureView;
 
 /**
  * @brief WebGPU implementation of ISwapChain
+ *
+ * resize() defers wgpuSurfaceConfigure to the next getCurrentTextureView(),
+ * so repeated resizes between frames reconfigure the surface once.
+ *
+ * Views of the surface textures are cached by texture identity. The surface
+ * rotates through a few images, so after warm-up acquiring the backbuffer
+ * creates no texture view and no wrapper. The cache is dropped whenever
+ * the surface is reconfigured.
  */
 class IPhysicalDevice;
 
@@ -24,32 +35,58 @@ public:
     
     // ISwapChain interface
     std::shared_ptr<ITextureView> getCurrentTextureView() override;
+    std::shared_ptr<ITexture> getCurrentTexture() const override;
     void present() override;
     void resize(uint32_t width, uint32_t height) override;
     uint32_t getWidth() const override;
     uint32_t getHeight() const override;
     PresentMode getPresentMode() const override;
+    bool setPresentMode(PresentMode mode) override;
     TextureFormat getFormat() const override;
     SurfaceCapabilities querySurfaceCapabilities() const override;
     
     /**
      * @brief Query surface capabilities from the device
+     *
+     * Results are cached per (surface, adapter) pair, so builder and resize
+     * negotiation stop hitting the driver after the first query.
      */
     static SurfaceCapabilities querySurfaceCapabilities(
         WGPUAdapter adapter,
         WGPUSurface surface);
     
+    /**
+     * @brief Drop cached surface capabilities
+     * @param surface Surface to forget, nullptr for every surface
+     * @param adapter Adapter to forget, nullptr for every adapter
+     *
+     * Call when the surface may report different capabilities, e.g. after the
+     * window moved to another display, and before releasing a surface handle.
+     */
+    static void invalidateSurfaceCapabilities(WGPUSurface surface, WGPUAdapter adapter = nullptr);
+    
 private:
     void configureSurface();
     void releaseCurrentTexture();
+    void clearViewCache();
+    
+    struct CachedView {
+        WGPUTexture texture = nullptr;        // Referenced to keep the identity stable
+        WGPUTextureView view = nullptr;
+        std::shared_ptr<WebGPUTextureView> wrapper;
+        std::shared_ptr<WebGPUTexture> textureWrapper;
+        uint64_t lastUsed = 0;
+    };
+    
+    // Enough for triple buffering (see querySurfaceCapabilities maxImageCount)
+    static constexpr size_t MAX_CACHED_VIEWS = 3;
+    
+    static void releaseCachedView(CachedView& entry);
+    static SurfaceCapabilities fetchSurfaceCapabilities(WGPUAdapter adapter, WGPUSurface surface);
     
     static WGPUTextureFormat convertToWGPUFormat(TextureFormat format);
-    static WGPUPresentMode convertToWGPUPresentMode(PresentMode mode);
-    static WGPUCompositeAlphaMode convertToWGPUAlphaMode(CompositeAlphaMode mode);
     
     static TextureFormat convertFromWGPUFormat(WGPUTextureFormat format);
-    static PresentMode convertFromWGPUPresentMode(WGPUPresentMode mode);
-    static CompositeAlphaMode convertFromWGPUAlphaMode(WGPUCompositeAlphaMode mode);
     
     std::weak_ptr<WebGPULogicalDevice> _device;
     WGPUSurface _surface = nullptr;
@@ -58,11 +95,15 @@ private:
     // Surface configuration
     WGPUSurfaceConfiguration _surfaceConfig = {};
     
-    // Current frame resources
+    // Current frame resources, the view and wrapper are borrowed from _viewCache
     WGPUSurfaceTexture _currentSurfaceTexture = {};
     WGPUTextureView _currentTextureView = nullptr;
     std::shared_ptr<WebGPUTextureView> _currentTextureViewWrapper;
+    std::shared_ptr<WebGPUTexture> _currentTextureWrapper;
+    std::array<CachedView, MAX_CACHED_VIEWS> _viewCache = {};
+    uint64_t _acquireCount = 0;
     bool _hasCurrentTexture = false;
+    bool _configurePending = false;
 };
 
 } // namespace pers
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "pers/graphics/ITexture.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/TextureViewCache.h"
 #include <webgpu/webgpu.h>
 #include <memory>
 
@@ -32,6 +34,12 @@ public:
     // WebGPU specific
     WGPUTexture getWGPUTexture() const { return _texture; }
     
+    // Accounting released together with the texture; textures owned by a surface have none
+    void setMemoryAllocation(GpuMemoryAllocation allocation) { _allocation = std::move(allocation); }
+    
+    // Views created through the resource factory, deduplicated by desc
+    TextureViewCache& getViewCache() const { return _viewCache; }
+    
 private:
     WGPUTexture _texture;
     uint32_t _width;
@@ -42,6 +50,8 @@ private:
     TextureFormat _format;
     TextureUsage _usage;
     TextureDimension _dimension;
+    GpuMemoryAllocation _allocation;
+    mutable TextureViewCache _viewCache;
 };
 
 } // namespace pers
\ No newline at end of file
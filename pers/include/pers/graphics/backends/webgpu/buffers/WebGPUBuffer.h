@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pers/graphics/buffers/INativeBuffer.h"
+#include "pers/graphics/GpuMemoryTracker.h"
 #include <webgpu/webgpu.h>
 #include <memory>
 #include <string>
@@ -43,6 +44,7 @@ private:
     WGPUBuffer _buffer;
     BufferDesc _desc;
     void* _mappedData;  // Only valid if mappedAtCreation is true
+    GpuMemoryAllocation _allocation;
 };
 
 } // namespace pers
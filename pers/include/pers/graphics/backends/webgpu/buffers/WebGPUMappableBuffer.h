@@ -9,13 +9,17 @@
 
 namespace pers {
 
+class WebGPUEventPump;
+
 /**
  * WebGPU implementation of INativeMappableBuffer
  * GPU buffer with CPU mapping capability via mapAsync
  */
 class WebGPUMappableBuffer : public INativeMappableBuffer {
 public:
-    WebGPUMappableBuffer(WGPUDevice device, const BufferDesc& desc);
+    WebGPUMappableBuffer(WGPUDevice device,
+                         const BufferDesc& desc,
+                         const std::shared_ptr<WebGPUEventPump>& eventPump = nullptr);
     virtual ~WebGPUMappableBuffer();
     
     // Delete copy operations
@@ -31,6 +35,7 @@ public:
     virtual const void* getMappedData() const override;
     virtual std::future<MappedData> mapAsync(MapMode mode = MapMode::Write, 
                                             const BufferMapRange& range = {0, BufferMapRange::WHOLE_BUFFER}) override;
+    virtual bool mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) override;
     virtual void unmap() override;
     virtual bool isMapped() const override;
     virtual bool isMapPending() const override;
@@ -60,6 +65,7 @@ public:
     
 private:
     std::unique_ptr<WebGPUBuffer> _impl;
+    std::shared_ptr<WebGPUEventPump> _eventPump;  // Drives map callbacks
 };
 
 } // namespace pers
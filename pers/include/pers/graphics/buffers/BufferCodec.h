@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Compressed buffer payload decodable by GpuBufferDecoder
+ *
+ * Data is treated as elements of channelCount 32-bit words (a vertex, or one
+ * index). Elements are grouped in blocks of BUFFER_CODEC_BLOCK_SIZE; within a
+ * block each channel stores its first value and the zigzag-coded deltas to
+ * the previous element, bit-packed at the block's widest delta. Vertex
+ * attributes and index lists change slowly between neighbours, so deltas
+ * pack into far fewer bits than the raw words. Every (block, channel) stream
+ * decodes independently, which is what makes the format GPU friendly.
+ *
+ * Layout, all little-endian 32-bit words:
+ *   [0..8)        header: magic, version, elementCount, channelCount,
+ *                 blockCount, dataOffset, 2 reserved
+ *   [8..dataOffset) directory, 2 words per stream: (wordOffset << 6 | bits), first value
+ *   [dataOffset..)  packed deltas, each stream starting on a word boundary
+ *
+ * Streams are ordered block-major, stream = block * channelCount + channel.
+ */
+constexpr uint32_t BUFFER_CODEC_MAGIC = 0x43424750;  // "PGBC"
+constexpr uint32_t BUFFER_CODEC_VERSION = 1;
+constexpr uint32_t BUFFER_CODEC_BLOCK_SIZE = 64;
+constexpr uint32_t BUFFER_CODEC_HEADER_WORDS = 8;
+
+struct BufferPayloadInfo {
+    uint32_t elementCount = 0;
+    uint32_t channelCount = 0;   // 32-bit words per element
+    uint32_t blockCount = 0;
+    uint32_t dataOffset = 0;     // In words
+    uint64_t payloadSize = 0;    // Compressed size in bytes
+    uint64_t decodedSize = 0;    // elementCount * channelCount * 4
+
+    uint32_t getStreamCount() const { return blockCount * channelCount; }
+};
+
+/**
+ * @brief Compress a buffer for GPU decoding
+ * @param data Source bytes
+ * @param size Size in bytes, a multiple of stride
+ * @param stride Element size in bytes, a multiple of 4 (4 for 32-bit indices)
+ * @return Payload words, empty on invalid input
+ */
+std::vector<uint32_t> encodeBufferPayload(const void* data, size_t size, uint32_t stride);
+
+/**
+ * @brief Validate a payload header and its directory bounds
+ * @return false if the data is not a well-formed payload
+ */
+bool readBufferPayloadInfo(const void* payload, size_t size, BufferPayloadInfo& outInfo);
+
+/**
+ * @brief Reference decoder, also the fallback when compute is unavailable
+ * @param output At least info.decodedSize bytes
+ * @return false if the payload is malformed
+ */
+bool decodeBufferPayload(const void* payload, size_t size, void* output);
+
+} // namespace pers
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include "pers/utils/DebugLabel.h"
 
 namespace pers {
 
@@ -124,7 +125,7 @@ struct BufferDesc {
     MemoryLocation memoryLocation = MemoryLocation::Auto;
     AccessPattern accessPattern = AccessPattern::Static;
     bool mappedAtCreation = false;
-    std::string debugName;
+    DebugLabel debugName;
     
     // Validation
     bool isValid() const;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pers/graphics/buffers/IMappableBuffer.h"
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
 
 #include <memory>
 #include <future>
@@ -10,7 +11,6 @@ namespace pers {
 class ICommandEncoder;
 class DeviceBuffer;
 class ILogicalDevice;
-class INativeMappableBuffer;
 
 /**
  * Deferred mapping staging buffer for asynchronous CPU access
@@ -48,6 +48,13 @@ public:
     void* getMappedData() override;
     const void* getMappedData() const override;
     std::future<MappedData> mapAsync(MapMode mode = MapMode::Write, const BufferMapRange& range = {}) override;
+    
+    /**
+     * Map without a future; callback receives the mapping when it resolves
+     * The result is not stored in the buffer, read it directly in the callback
+     * or keep the MappedData until unmap().
+     */
+    bool mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback);
     void unmap() override;
     bool isMapped() const override;
     bool isMapPending() const override;
@@ -84,7 +91,7 @@ private:
     std::shared_ptr<INativeMappableBuffer> _buffer;  // Internal WebGPU mappable buffer
     uint64_t _size;
     BufferUsage _usage;
-    std::string _debugName;
+    DebugLabel _debugName;
     MapMode _mapMode;
     mutable MappedData _currentMapping;
     mutable std::future<MappedData> _mappingFuture;
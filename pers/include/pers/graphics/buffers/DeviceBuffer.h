@@ -52,7 +52,7 @@ private:
     std::shared_ptr<INativeBuffer> _buffer;  // Internal WebGPU buffer
     uint64_t _size;
     BufferUsage _usage;
-    std::string _debugName;
+    DebugLabel _debugName;
     uint64_t _totalBytesTransferred;
     uint32_t _transferCount;
     bool _created;
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Mutex.h"
+
+namespace pers {
+
+class IResourceFactory;
+class INativeBuffer;
+class DeviceBufferHeap;
+
+/**
+ * Range of a DeviceBufferHeap page, bindable like any other IBuffer
+ *
+ * getSize() is the requested size and getNativeOffset() the start of the
+ * range inside the shared native buffer. The range returns to the heap when
+ * the view is destroyed; as with DeviceBuffer::destroy(), the caller must make
+ * sure no submitted work still references it.
+ */
+class DeviceBufferView : public IBuffer {
+public:
+    DeviceBufferView(const std::weak_ptr<DeviceBufferHeap>& heap,
+                     const std::shared_ptr<INativeBuffer>& page,
+                     uint32_t pageIndex,
+                     uint64_t offset,
+                     uint64_t size,
+                     uint32_t order);
+    ~DeviceBufferView() override;
+
+    uint64_t getSize() const override;
+    BufferUsage getUsage() const override;
+    const std::string& getDebugName() const override;
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override;
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override;
+    AccessPattern getAccessPattern() const override;
+    uint64_t getNativeOffset() const override;
+
+private:
+    std::weak_ptr<DeviceBufferHeap> _heap;
+    std::shared_ptr<INativeBuffer> _page;
+    uint32_t _pageIndex;
+    uint64_t _offset;
+    uint64_t _size;
+    uint32_t _order;
+};
+
+/**
+ * Sub-allocating heap of device-local buffers
+ *
+ * Reserves large native buffers (pages) and hands out ranges through a
+ * binary buddy allocator, so thousands of small vertex/index buffers share a
+ * handful of WGPUBuffers. Blocks are powers of two from MIN_BLOCK_SIZE up to
+ * the page size and are naturally aligned to their size, which covers every
+ * WebGPU offset alignment requirement. Requests larger than the page size get
+ * a dedicated page.
+ *
+ * Upload into views with IQueue::writeBuffer or copy commands; both honour
+ * getNativeOffset().
+ */
+class DeviceBufferHeap : public std::enable_shared_from_this<DeviceBufferHeap> {
+public:
+    static constexpr uint64_t MIN_BLOCK_SIZE = 256;
+    static constexpr uint64_t DEFAULT_PAGE_SIZE = 64ull * 1024 * 1024;
+
+    struct Stats {
+        uint32_t pageCount = 0;
+        uint64_t allocationCount = 0;
+        uint64_t reservedBytes = 0;   // Sum of page sizes
+        uint64_t allocatedBytes = 0;  // Sum of block sizes handed out
+        // Free space left between allocations, gathered by getStats(). Free
+        // bytes spread over many small blocks mean the heap is fragmented:
+        // a request larger than largestFreeBlock needs a new page.
+        uint64_t freeBlockCount = 0;
+        uint64_t largestFreeBlock = 0;
+    };
+
+    /**
+     * @param resourceFactory Factory used to create pages
+     * @param usage Usage of every page, CopyDst is always added
+     * @param pageSize Size of each page, rounded up to a power of two
+     * @param debugName Debug name prefix for pages
+     */
+    DeviceBufferHeap(const std::shared_ptr<IResourceFactory>& resourceFactory,
+                     BufferUsage usage,
+                     uint64_t pageSize = DEFAULT_PAGE_SIZE,
+                     const std::string& debugName = "");
+    ~DeviceBufferHeap();
+
+    DeviceBufferHeap(const DeviceBufferHeap&) = delete;
+    DeviceBufferHeap& operator=(const DeviceBufferHeap&) = delete;
+
+    /**
+     * Allocate a range
+     * @param size Size in bytes
+     * @param alignment Required offset alignment, must be a power of two
+     * @return View over the range or nullptr on failure
+     */
+    std::shared_ptr<DeviceBufferView> allocate(uint64_t size,
+                                               uint64_t alignment = BufferAlignment::DEFAULT);
+
+    /**
+     * Release pages that have no live allocations
+     */
+    void trim();
+
+    Stats getStats() const;
+    BufferUsage getUsage() const { return _usage; }
+
+private:
+    friend class DeviceBufferView;
+
+    struct Page {
+        std::shared_ptr<INativeBuffer> buffer;
+        uint32_t maxOrder = 0;
+        uint64_t allocatedBytes = 0;
+        std::vector<std::set<uint64_t>> freeBlocks;  // Offsets of free blocks per order
+    };
+
+    static uint32_t getOrder(uint64_t size);
+    static uint64_t getBlockSize(uint32_t order) { return MIN_BLOCK_SIZE << order; }
+
+    bool addPage(uint32_t maxOrder);
+    void free(uint32_t pageIndex, uint64_t offset, uint32_t order);
+
+    std::shared_ptr<IResourceFactory> _resourceFactory;
+    BufferUsage _usage;
+    uint32_t _pageOrder;
+    std::string _debugName;
+
+    mutable Mutex<false> _mutex;
+    std::vector<Page> _pages;  // Trimmed pages leave an empty slot so indices stay stable
+    Stats _stats;
+};
+
+} // namespace pers
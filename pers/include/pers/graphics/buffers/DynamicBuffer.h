@@ -1,8 +1,7 @@
 #pragma once
 
 #include "pers/graphics/buffers/IBuffer.h"
-#include "pers/graphics/buffers/IMappableBuffer.h"
-#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include "pers/graphics/buffers/BufferTypes.h"
 #include <memory>
 #include <atomic>
 #include <vector>
@@ -10,28 +9,48 @@
 namespace pers {
 
 class ILogicalDevice;
+class INativeBuffer;
+class IQueue;
 
 /**
  * Ring buffer for per-frame dynamic data updates
  * Automatically manages multiple buffer copies for frame overlap
+ *
+ * Each frame slot owns one GPU buffer of the full requested size. Within a
+ * frame, allocate() sub-allocates aligned slices with a bump pointer and
+ * returns the dynamic offset to bind with. All writes land in a CPU-side
+ * shadow that stays "mapped" for the lifetime of the buffer; flush() uploads
+ * the dirty range of the current slot with a single queue write.
+ *
+ * Typical frame:
+ *   auto slice = dynamic.allocate(sizeof(ObjectUniforms));
+ *   memcpy(slice.data, &uniforms, sizeof(uniforms));
+ *   ... record draw with dynamic offset slice.offset ...
+ *   dynamic.flush();     // before queue submit
+ *   dynamic.nextFrame(); // after queue submit
+ *
+ * nextFrame() fences the slot it leaves with a queue work-done callback and
+ * only reuses a slot once the GPU has retired it, blocking solely when the
+ * CPU is a full ring ahead of the GPU.
  */
 class DynamicBuffer : public IBuffer {
 public:
     static constexpr uint32_t DEFAULT_FRAME_COUNT = 3;
-    
+
     struct UpdateHandle {
         void* data;
         uint64_t size;
         uint32_t frameIndex;
+        uint64_t offset = 0;  // Offset within the frame buffer (dynamic offset)
     };
-    
+
     DynamicBuffer();
     virtual ~DynamicBuffer();
-    
+
     /**
      * Create and initialize the dynamic buffer
-     * @param size Buffer size in bytes
-     * @param usage Buffer usage flags
+     * @param size Buffer size in bytes (per frame, rounded up to DYNAMIC_OFFSET)
+     * @param usage Buffer usage flags (CopyDst is added automatically)
      * @param device Logical device to create resources
      * @param frameCount Number of frames to buffer (default 3)
      * @param debugName Optional debug name
@@ -42,29 +61,71 @@ public:
                 const std::shared_ptr<ILogicalDevice>& device,
                 uint32_t frameCount = DEFAULT_FRAME_COUNT,
                 const std::string& debugName = "");
-    
+
     /**
      * Destroy the dynamic buffer and release resources
      */
     void destroy();
-    
+
     DynamicBuffer(const DynamicBuffer&) = delete;
     DynamicBuffer& operator=(const DynamicBuffer&) = delete;
-    
+
     DynamicBuffer(DynamicBuffer&& other) noexcept;
     DynamicBuffer& operator=(DynamicBuffer&& other) noexcept;
-    
+
     // Dynamic update interface
     UpdateHandle beginUpdate();
     void endUpdate(const UpdateHandle& handle);
-    
+
+    /**
+     * Sub-allocate an aligned slice of the current frame's buffer
+     * @param size Slice size in bytes
+     * @param alignment Offset alignment (defaults to the dynamic offset alignment)
+     * @return Handle with CPU pointer and dynamic offset, data is nullptr if the frame is full
+     */
+    UpdateHandle allocate(uint64_t size, uint64_t alignment = BufferAlignment::DYNAMIC_OFFSET);
+
+    /**
+     * Allocate a slice and copy data into it
+     * @return Dynamic offset of the slice, or BufferCopyDesc::WHOLE_SIZE on failure
+     */
+    uint64_t write(const void* data, uint64_t size, uint64_t alignment = BufferAlignment::DYNAMIC_OFFSET);
+
+    template<typename T>
+    uint64_t write(const T& value) {
+        return write(&value, sizeof(T));
+    }
+
+    /**
+     * Upload everything written to the current frame since the last flush
+     * Must be called before submitting command buffers that read the frame
+     * @return true if upload succeeded or nothing was dirty
+     */
+    bool flush();
+
     // Get current frame's buffer for GPU use
     std::shared_ptr<IBuffer> getCurrentFrameBuffer() const;
     uint32_t getCurrentFrameIndex() const;
-    
+    uint32_t getFrameCount() const;
+
+    // Bump allocator statistics for the current frame
+    uint64_t getUsedBytes() const;
+    uint64_t getRemainingBytes() const;
+
     // Frame synchronization
     void nextFrame();
     
+    /**
+     * Check whether the GPU has finished with a frame slot
+     * @param frameIndex Slot index in [0, getFrameCount())
+     */
+    bool isFrameRetired(uint32_t frameIndex) const;
+    
+    /**
+     * Number of times nextFrame() had to wait for the GPU to retire a slot
+     */
+    uint64_t getStallCount() const;
+
     // IBuffer interface
     virtual uint64_t getSize() const override;
     virtual BufferUsage getUsage() const override;
@@ -74,17 +135,28 @@ public:
     virtual BufferState getState() const override;
     virtual MemoryLocation getMemoryLocation() const override;
     virtual AccessPattern getAccessPattern() const override;
-    
+
 protected:
+    struct FrameFence;
+    
+    bool waitForFrame(uint32_t frameIndex);
+    
     uint64_t _size;
     BufferUsage _usage;
     std::string _debugName;
-    std::vector<std::shared_ptr<INativeMappableBuffer>> _buffers;
+    std::vector<std::shared_ptr<INativeBuffer>> _buffers;
+    std::vector<std::shared_ptr<IBuffer>> _frameViews;  // IBuffer views of _buffers
+    std::shared_ptr<IQueue> _queue;
+    std::vector<uint8_t> _shadow;  // Persistently mapped CPU copy of the current frame
     std::atomic<uint32_t> _currentFrame;
     std::vector<bool> _mapped;
+    std::vector<std::shared_ptr<FrameFence>> _fences;  // Shared with in-flight callbacks
+    uint64_t _frameOffset;  // Bump pointer within the current frame
+    uint64_t _dirtyBegin;
+    uint64_t _dirtyEnd;
+    uint64_t _stallCount;
     uint32_t _frameCount;
     bool _created;
 };
 
 } // namespace pers
-
@@ -0,0 +1,492 @@
+#pragma once
+
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace pers {
+
+/**
+ * @brief Layout rules for a GpuStruct
+ *
+ * Std140 follows WGSL's uniform address space: array strides and the
+ * alignment of arrays are rounded up to 16. Std430 follows the storage
+ * address space, where only the natural alignment applies. vec3 aligns to 16
+ * under both, so a vec3 followed by a scalar packs into 16 bytes.
+ */
+enum class GpuLayout {
+    Std140,
+    Std430
+};
+
+enum class GpuScalar : uint8_t {
+    F32,
+    I32,
+    U32
+};
+
+/**
+ * @brief Shape of one host-shareable WGSL type
+ * Scalars are 1x1 and vectors Rowsx1. atomic<T> has the layout of T.
+ */
+struct GpuTypeInfo {
+    GpuScalar scalar = GpuScalar::F32;
+    uint32_t rows = 1;        // Vector components, or rows per matrix column
+    uint32_t columns = 1;     // Matrix columns, 1 otherwise
+    uint32_t arrayCount = 0;  // Fixed array length, 0 when not an array
+
+    constexpr bool operator==(const GpuTypeInfo&) const = default;
+};
+
+namespace detail {
+
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+constexpr uint64_t vectorAlignment(uint32_t rows) {
+    return rows == 1 ? 4 : rows == 2 ? 8 : 16;
+}
+
+// One element of an array, or the type itself
+constexpr uint64_t elementAlignment(const GpuTypeInfo& type) {
+    return vectorAlignment(type.rows);
+}
+
+constexpr uint64_t columnStride(const GpuTypeInfo& type) {
+    return alignUp(4ull * type.rows, vectorAlignment(type.rows));
+}
+
+constexpr uint64_t elementSize(const GpuTypeInfo& type) {
+    return type.columns == 1 ? 4ull * type.rows : columnStride(type) * type.columns;
+}
+
+} // namespace detail
+
+constexpr uint64_t gpuAlignment(const GpuTypeInfo& type, GpuLayout layout) {
+    const uint64_t alignment = detail::elementAlignment(type);
+    return type.arrayCount > 0 && layout == GpuLayout::Std140 ? detail::alignUp(alignment, 16) : alignment;
+}
+
+constexpr uint64_t gpuArrayStride(const GpuTypeInfo& type, GpuLayout layout) {
+    return detail::alignUp(detail::elementSize(type), gpuAlignment(type, layout));
+}
+
+constexpr uint64_t gpuSize(const GpuTypeInfo& type, GpuLayout layout) {
+    return type.arrayCount > 0 ? gpuArrayStride(type, layout) * type.arrayCount : detail::elementSize(type);
+}
+
+/**
+ * @brief Scalar, vector or matrix field of a GpuStruct
+ */
+template<GpuScalar Scalar, uint32_t Rows, uint32_t Columns = 1>
+struct GpuMatrix {
+    static_assert(Rows >= 1 && Rows <= 4 && Columns >= 1 && Columns <= 4, "Vectors and matrices have 1 to 4 rows and columns");
+    static_assert(Columns == 1 || (Rows >= 2 && Scalar == GpuScalar::F32), "WGSL matrices are f32 with 2 to 4 rows");
+    static constexpr GpuTypeInfo INFO{Scalar, Rows, Columns, 0};
+};
+
+template<GpuScalar Scalar, uint32_t Rows>
+using GpuVector = GpuMatrix<Scalar, Rows>;
+
+/**
+ * @brief Fixed-size array field of a GpuStruct
+ */
+template<typename Element, uint32_t Count>
+struct GpuArray {
+    static_assert(Element::INFO.arrayCount == 0, "Nested arrays are not supported");
+    static_assert(Count > 0, "Arrays need a fixed, non-zero length");
+    static constexpr GpuTypeInfo INFO{Element::INFO.scalar, Element::INFO.rows, Element::INFO.columns, Count};
+};
+
+using GpuF32 = GpuVector<GpuScalar::F32, 1>;
+using GpuI32 = GpuVector<GpuScalar::I32, 1>;
+using GpuU32 = GpuVector<GpuScalar::U32, 1>;
+using GpuVec2f = GpuVector<GpuScalar::F32, 2>;
+using GpuVec3f = GpuVector<GpuScalar::F32, 3>;
+using GpuVec4f = GpuVector<GpuScalar::F32, 4>;
+using GpuVec2i = GpuVector<GpuScalar::I32, 2>;
+using GpuVec3i = GpuVector<GpuScalar::I32, 3>;
+using GpuVec4i = GpuVector<GpuScalar::I32, 4>;
+using GpuVec2u = GpuVector<GpuScalar::U32, 2>;
+using GpuVec3u = GpuVector<GpuScalar::U32, 3>;
+using GpuVec4u = GpuVector<GpuScalar::U32, 4>;
+using GpuMat2x2f = GpuMatrix<GpuScalar::F32, 2, 2>;
+using GpuMat3x3f = GpuMatrix<GpuScalar::F32, 3, 3>;
+using GpuMat4x4f = GpuMatrix<GpuScalar::F32, 4, 4>;
+
+namespace detail {
+
+/**
+ * Minimal WGSL struct reader for layout checks
+ *
+ * Understands scalars, vectors and matrices in both spellings (vec3<f32>,
+ * vec3f), atomic<T> and fixed arrays of those. Anything else, including
+ * @align/@size attributes and nested structs, makes the struct unreadable.
+ */
+class WgslStructReader {
+public:
+    static constexpr size_t MAX_MEMBERS = 64;
+
+    struct Result {
+        std::array<GpuTypeInfo, MAX_MEMBERS> members{};
+        size_t count = 0;
+        bool valid = false;
+    };
+
+    static constexpr Result read(std::string_view source, std::string_view structName) {
+        WgslStructReader reader(source);
+        Result result;
+        if (!reader.findStruct(structName)) {
+            return result;
+        }
+        while (true) {
+            reader.skipSpace();
+            if (reader.consume('}')) {
+                result.valid = result.count > 0;
+                return result;
+            }
+            GpuTypeInfo type;
+            if (result.count == MAX_MEMBERS || !reader.readMember(type)) {
+                return result;
+            }
+            result.members[result.count++] = type;
+            reader.skipSpace();
+            if (!reader.consume(',')) {
+                reader.skipSpace();
+                if (reader.peek() != '}') {
+                    return result;
+                }
+            }
+        }
+    }
+
+private:
+    explicit constexpr WgslStructReader(std::string_view source) : _source(source) {}
+
+    static constexpr bool isIdentifierChar(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    constexpr char peek() const { return _pos < _source.size() ? _source[_pos] : '\0'; }
+
+    constexpr bool consume(char c) {
+        if (peek() != c) {
+            return false;
+        }
+        ++_pos;
+        return true;
+    }
+
+    constexpr void skipSpace() {
+        while (_pos < _source.size()) {
+            const char c = _source[_pos];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                ++_pos;
+            } else if (_source.substr(_pos, 2) == "//") {
+                while (_pos < _source.size() && _source[_pos] != '\n') {
+                    ++_pos;
+                }
+            } else {
+                return;
+            }
+        }
+    }
+
+    constexpr std::string_view readIdentifier() {
+        const size_t start = _pos;
+        while (_pos < _source.size() && isIdentifierChar(_source[_pos])) {
+            ++_pos;
+        }
+        return _source.substr(start, _pos - start);
+    }
+
+    constexpr bool findStruct(std::string_view structName) {
+        while (_pos < _source.size()) {
+            skipSpace();
+            const bool boundary = _pos == 0 || !isIdentifierChar(_source[_pos - 1]);
+            const std::string_view word = readIdentifier();
+            if (word.empty()) {
+                ++_pos;
+                continue;
+            }
+            if (!boundary || word != "struct") {
+                continue;
+            }
+            skipSpace();
+            if (readIdentifier() != structName) {
+                continue;
+            }
+            skipSpace();
+            return consume('{');
+        }
+        return false;
+    }
+
+    constexpr bool readMember(GpuTypeInfo& type) {
+        if (peek() == '@') {
+            return false;  // Explicit @align/@size, or an IO struct
+        }
+        if (readIdentifier().empty()) {
+            return false;
+        }
+        skipSpace();
+        if (!consume(':')) {
+            return false;
+        }
+        skipSpace();
+        return readType(type, true);
+    }
+
+    static constexpr bool readScalar(std::string_view name, GpuScalar& scalar) {
+        if (name == "f32") { scalar = GpuScalar::F32; return true; }
+        if (name == "i32") { scalar = GpuScalar::I32; return true; }
+        if (name == "u32") { scalar = GpuScalar::U32; return true; }
+        return false;
+    }
+
+    static constexpr bool readSuffix(char suffix, GpuScalar& scalar) {
+        if (suffix == 'f') { scalar = GpuScalar::F32; return true; }
+        if (suffix == 'i') { scalar = GpuScalar::I32; return true; }
+        if (suffix == 'u') { scalar = GpuScalar::U32; return true; }
+        return false;
+    }
+
+    static constexpr bool isDimension(char c) { return c >= '2' && c <= '4'; }
+
+    constexpr bool readTemplateScalar(GpuScalar& scalar) {
+        skipSpace();
+        if (!consume('<')) {
+            return false;
+        }
+        skipSpace();
+        const bool known = readScalar(readIdentifier(), scalar);
+        skipSpace();
+        return known && consume('>');
+    }
+
+    constexpr bool readType(GpuTypeInfo& type, bool allowArray) {
+        const std::string_view name = readIdentifier();
+        type = GpuTypeInfo{};
+
+        if (readScalar(name, type.scalar)) {
+            return true;
+        }
+        if (name == "atomic") {
+            return readTemplateScalar(type.scalar) && type.scalar != GpuScalar::F32;
+        }
+        if (name.size() >= 4 && name.substr(0, 3) == "vec" && isDimension(name[3])) {
+            type.rows = static_cast<uint32_t>(name[3] - '0');
+            if (name.size() == 5) {
+                return readSuffix(name[4], type.scalar);
+            }
+            return name.size() == 4 && readTemplateScalar(type.scalar);
+        }
+        if (name.size() >= 6 && name.substr(0, 3) == "mat" && isDimension(name[3]) && name[4] == 'x' &&
+            isDimension(name[5])) {
+            type.columns = static_cast<uint32_t>(name[3] - '0');
+            type.rows = static_cast<uint32_t>(name[5] - '0');
+            if (name.size() == 7) {
+                return name[6] == 'f';
+            }
+            return name.size() == 6 && readTemplateScalar(type.scalar) && type.scalar == GpuScalar::F32;
+        }
+        if (name == "array" && allowArray) {
+            skipSpace();
+            if (!consume('<')) {
+                return false;
+            }
+            skipSpace();
+            if (!readType(type, false)) {
+                return false;
+            }
+            skipSpace();
+            if (!consume(',')) {
+                return false;  // Runtime-sized
+            }
+            skipSpace();
+            uint32_t count = 0;
+            while (peek() >= '0' && peek() <= '9') {
+                count = count * 10 + static_cast<uint32_t>(peek() - '0');
+                ++_pos;
+            }
+            if (!consume('u')) {
+                consume('i');
+            }
+            skipSpace();
+            type.arrayCount = count;
+            return count > 0 && consume('>');
+        }
+        return false;
+    }
+
+    std::string_view _source;
+    size_t _pos = 0;
+};
+
+} // namespace detail
+
+/**
+ * @brief Compile-time GPU buffer layout for a list of fields
+ *
+ * Offsets, size and alignment follow the WGSL rules of the chosen layout, so
+ * structs no longer need hand-inserted padding members. Writers copy each
+ * field to its offset straight into the destination, typically a
+ * DynamicBuffer slice, without building a padded CPU copy first:
+ *
+ *     constexpr char SHADER[] = R"(
+ *         struct Object { model: mat4x4f, tint: vec3f, id: u32 };
+ *         ...)";
+ *     using ObjectUniforms = GpuStruct<GpuLayout::Std140, GpuMat4x4f, GpuVec3f, GpuU32>;
+ *     static_assert(ObjectUniforms::matchesWgsl(SHADER, "Object"), "Object layout drifted");
+ *
+ *     auto object = ObjectUniforms::allocate(dynamicBuffer);
+ *     object.set<0>(model).set<1>(tint).set<2>(id);
+ *     pass->setBindGroup(0, group, {static_cast<uint32_t>(object.getOffset())});
+ *
+ * Field values are any trivially copyable type whose size is the field's
+ * packed size (glm::vec3 for GpuVec3f, glm::mat3 for GpuMat3x3f, a
+ * std::array of elements for GpuArray); column and element padding is
+ * inserted while copying. Padding bytes in the destination are not written.
+ */
+template<GpuLayout Layout, typename... Fields>
+class GpuStruct {
+public:
+    static_assert(sizeof...(Fields) > 0, "GpuStruct needs at least one field");
+
+    static constexpr GpuLayout LAYOUT = Layout;
+    static constexpr size_t FIELD_COUNT = sizeof...(Fields);
+    static constexpr std::array<GpuTypeInfo, FIELD_COUNT> FIELDS{Fields::INFO...};
+
+private:
+    static constexpr std::array<uint64_t, FIELD_COUNT> computeOffsets() {
+        std::array<uint64_t, FIELD_COUNT> offsets{};
+        uint64_t offset = 0;
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            offset = detail::alignUp(offset, gpuAlignment(FIELDS[i], Layout));
+            offsets[i] = offset;
+            offset += gpuSize(FIELDS[i], Layout);
+        }
+        return offsets;
+    }
+
+    static constexpr uint64_t computeAlignment() {
+        uint64_t alignment = 4;
+        for (const auto& field : FIELDS) {
+            alignment = gpuAlignment(field, Layout) > alignment ? gpuAlignment(field, Layout) : alignment;
+        }
+        return alignment;
+    }
+
+public:
+    static constexpr std::array<uint64_t, FIELD_COUNT> OFFSETS = computeOffsets();
+    static constexpr uint64_t ALIGNMENT = computeAlignment();
+    static constexpr uint64_t SIZE = detail::alignUp(OFFSETS.back() + gpuSize(FIELDS.back(), Layout), ALIGNMENT);
+
+    template<size_t Index>
+    static constexpr uint64_t offsetOf() {
+        static_assert(Index < FIELD_COUNT, "Field index out of range");
+        return OFFSETS[Index];
+    }
+
+    /**
+     * @brief Whether the named WGSL struct has exactly these fields, in order
+     * Usable in static_assert when the shader source is a constexpr string.
+     */
+    static constexpr bool matchesWgsl(std::string_view source, std::string_view structName) {
+        const auto wgsl = detail::WgslStructReader::read(source, structName);
+        if (!wgsl.valid || wgsl.count != FIELD_COUNT) {
+            return false;
+        }
+        for (size_t i = 0; i < FIELD_COUNT; ++i) {
+            if (!(wgsl.members[i] == FIELDS[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Writes fields of one struct instance at a destination pointer
+     */
+    class Writer {
+    public:
+        Writer() = default;
+        Writer(void* data, uint64_t offset = 0)
+            : _data(static_cast<std::byte*>(data))
+            , _offset(offset) {}
+
+        template<size_t Index, typename Value>
+        Writer& set(const Value& value) {
+            static_assert(Index < FIELD_COUNT, "Field index out of range");
+            static_assert(std::is_trivially_copyable_v<Value>, "Field values must be trivially copyable");
+            constexpr GpuTypeInfo field = FIELDS[Index];
+            constexpr uint64_t chunkSize = 4ull * field.rows;
+            constexpr uint64_t chunkCount = static_cast<uint64_t>(field.columns) * (field.arrayCount > 0 ? field.arrayCount : 1);
+            static_assert(sizeof(Value) == chunkSize * chunkCount, "Value size does not match the field's packed size");
+
+            // Matrix columns and array elements are the only padded parts of a field
+            constexpr uint64_t columnStride = field.columns == 1 ? chunkSize : detail::columnStride(field);
+            constexpr uint64_t elementStride = gpuArrayStride(field, Layout);
+            const auto* source = reinterpret_cast<const std::byte*>(&value);
+            std::byte* destination = _data + OFFSETS[Index];
+            for (uint64_t chunk = 0; chunk < chunkCount; ++chunk) {
+                const uint64_t element = chunk / field.columns;
+                const uint64_t column = chunk % field.columns;
+                std::memcpy(destination + element * elementStride + column * columnStride,
+                            source + chunk * chunkSize, chunkSize);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Write one element of an array field
+         */
+        template<size_t Index, typename Value>
+        Writer& setElement(uint32_t element, const Value& value) {
+            static_assert(Index < FIELD_COUNT && FIELDS[Index].arrayCount > 0, "setElement needs an array field");
+            static_assert(std::is_trivially_copyable_v<Value>, "Field values must be trivially copyable");
+            constexpr GpuTypeInfo field = FIELDS[Index];
+            constexpr uint64_t chunkSize = 4ull * field.rows;
+            static_assert(sizeof(Value) == chunkSize * field.columns, "Value size does not match the element's packed size");
+
+            if (element >= field.arrayCount) {
+                return *this;
+            }
+            constexpr uint64_t columnStride = field.columns == 1 ? chunkSize : detail::columnStride(field);
+            const auto* source = reinterpret_cast<const std::byte*>(&value);
+            std::byte* destination = _data + OFFSETS[Index] + element * gpuArrayStride(field, Layout);
+            for (uint32_t column = 0; column < field.columns; ++column) {
+                std::memcpy(destination + column * columnStride, source + column * chunkSize, chunkSize);
+            }
+            return *this;
+        }
+
+        bool isValid() const { return _data != nullptr; }
+        std::byte* getData() const { return _data; }
+
+        /**
+         * @brief Dynamic offset of the slice when allocated from a DynamicBuffer
+         */
+        uint64_t getOffset() const { return _offset; }
+
+    private:
+        std::byte* _data = nullptr;
+        uint64_t _offset = 0;
+    };
+
+    /**
+     * @brief Allocate one instance from the current frame of a DynamicBuffer
+     * @return Writer over the slice, invalid if the frame is full
+     */
+    static Writer allocate(DynamicBuffer& buffer, uint64_t alignment = BufferAlignment::DYNAMIC_OFFSET) {
+        const auto handle = buffer.allocate(SIZE, alignment);
+        return handle.data ? Writer(handle.data, handle.offset) : Writer();
+    }
+};
+
+} // namespace pers
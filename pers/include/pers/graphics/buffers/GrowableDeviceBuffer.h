@@ -0,0 +1,123 @@
+#pragma once
+
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include <memory>
+
+namespace pers {
+
+class DeviceBuffer;
+class ILogicalDevice;
+class IQueue;
+
+/**
+ * Append-only device buffer that grows on the GPU
+ *
+ * append() writes through the queue at the end of the used range. When the
+ * capacity runs out a buffer growthFactor times larger is created, the used
+ * range is copied into it with copyDeviceToDevice, and the old buffer is
+ * handed to the device's deferred deletion queue. Content never round-trips
+ * through the CPU, so appends are amortized O(1).
+ *
+ * Typical use:
+ *   uint64_t offset = points.append(batch.data(), batch.size() * sizeof(Point));
+ *   if (points.getGeneration() != boundGeneration) { ... rebuild bind group ... }
+ *
+ * Growing replaces the native buffer; anything holding its handle, such as
+ * a bind group, has to be recreated once getGeneration() changes. Appends
+ * start at copy aligned offsets, unaligned tails are zero padded.
+ */
+class GrowableDeviceBuffer final : public IBuffer {
+public:
+    static constexpr uint32_t DEFAULT_GROWTH_FACTOR = 2;
+    static constexpr uint64_t INVALID_OFFSET = ~0ull;
+
+    struct Stats {
+        uint64_t appendedBytes = 0;   // Bytes written by append() so far
+        uint64_t growCount = 0;       // Times the buffer was reallocated
+        uint64_t relocatedBytes = 0;  // Bytes copied GPU-side while growing
+    };
+
+    GrowableDeviceBuffer();
+    ~GrowableDeviceBuffer() override;
+
+    GrowableDeviceBuffer(const GrowableDeviceBuffer&) = delete;
+    GrowableDeviceBuffer& operator=(const GrowableDeviceBuffer&) = delete;
+
+    /**
+     * Create the initial device buffer
+     * @param initialCapacity Capacity in bytes (rounded up to the copy alignment)
+     * @param usage Buffer usage flags (CopySrc and CopyDst are added automatically)
+     * @param device Logical device to create resources
+     * @param growthFactor Capacity multiplier applied when an append does not fit, at least 2
+     * @param debugName Optional debug name
+     * @return true if creation succeeded
+     */
+    bool create(uint64_t initialCapacity,
+                DeviceBufferUsage usage,
+                const std::shared_ptr<ILogicalDevice>& device,
+                uint32_t growthFactor = DEFAULT_GROWTH_FACTOR,
+                const std::string& debugName = "");
+
+    void destroy();
+
+    /**
+     * Write data after the used range, growing the buffer if needed
+     * @return Offset the data was written at, or INVALID_OFFSET on failure
+     */
+    uint64_t append(const void* data, uint64_t size);
+
+    /**
+     * Make room for at least capacity bytes without appending
+     * @return false if the larger buffer could not be created or filled
+     */
+    bool reserve(uint64_t capacity);
+
+    /**
+     * Forget the used range; the capacity is kept
+     */
+    void clear();
+
+    uint64_t getUsedSize() const;
+    uint64_t getCapacity() const;
+
+    /**
+     * Incremented whenever growing replaced the native buffer
+     */
+    uint32_t getGeneration() const;
+
+    Stats getStats() const;
+
+    /**
+     * Current device buffer, replaced when the buffer grows
+     */
+    const std::shared_ptr<DeviceBuffer>& getDeviceBuffer() const;
+
+    // IBuffer interface, getSize() is the capacity
+    uint64_t getSize() const override;
+    BufferUsage getUsage() const override;
+    const std::string& getDebugName() const override;
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override;
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override;
+    AccessPattern getAccessPattern() const override;
+
+private:
+    // Allocate capacity bytes and copy the used range over on the GPU
+    bool grow(uint64_t capacity);
+
+    std::shared_ptr<DeviceBuffer> _buffer;
+    std::shared_ptr<ILogicalDevice> _device;
+    std::shared_ptr<IQueue> _queue;
+    DeviceBufferUsage _usage;
+    uint64_t _used;
+    uint64_t _capacity;
+    uint32_t _growthFactor;
+    uint32_t _generation;
+    Stats _stats;
+    DebugLabel _debugName;
+    bool _created;
+};
+
+} // namespace pers
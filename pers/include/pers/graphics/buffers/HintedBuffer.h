@@ -0,0 +1,150 @@
+#pragma once
+
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class IQueue;
+class ShadowedDeviceBuffer;
+class UploadBatcher;
+
+/**
+ * Buffer whose update strategy follows the BufferDesc hints
+ *
+ * Callers declare how the contents change and get the matching backend:
+ *   Static  - written once: initial data lands through mappedAtCreation
+ *             (ImmediateDeviceBuffer), later writes are plain queue writes
+ *   Dynamic - sparse updates: ShadowedDeviceBuffer, upload() sends only the
+ *             dirty spans
+ *   Stream  - rewritten every frame: DynamicBuffer ring of frame slots, so a
+ *             write never waits on the GPU reading the previous frame
+ *
+ * Stream buffers with memoryLocation Unified on a unified-memory adapter
+ * (integrated or CPU) whose device enabled DeviceFeature::MappablePrimaryBuffers
+ * skip staging altogether: each ring slot is itself a MapWrite vertex/uniform
+ * buffer, written through its mapping and unmapped by upload(). Without the
+ * feature the hint falls back to the staged ring. Dynamic buffers keep the
+ * shadow copy either way, since their sparse writes are already cheap.
+ *
+ * Every strategy shares write() / upload(); Stream also needs nextFrame()
+ * after each submit. Staging and HostCached (readback) hints are rejected:
+ * StagingBufferPool and ReadbackRing serve those. WebGPU does not expose
+ * memory heaps, so memoryLocation is otherwise informational and
+ * getMemoryLocation() reports what the backend actually allocated.
+ *
+ * A Stream buffer changes native handle every frame: vertex and index
+ * bindings see the current slot, but bind groups must be built from
+ * getCurrentBuffer() per frame (or per slot).
+ */
+class HintedBuffer final : public IBuffer {
+public:
+    enum class Strategy : uint8_t {
+        MappedAtCreation,  // Static
+        ShadowedDiff,      // Dynamic
+        FrameRing,         // Stream
+        UnifiedMapped      // Stream + Unified on a UMA adapter
+    };
+
+    /**
+     * Strategy create() picks for desc on device
+     * @return false for hints this class does not serve (Staging, HostCached)
+     */
+    static bool selectStrategy(const BufferDesc& desc, const ILogicalDevice& device, Strategy& strategy);
+
+    HintedBuffer();
+    ~HintedBuffer() override;
+
+    /**
+     * Create the backend chosen by desc.accessPattern
+     * @param desc Size, usage (CopyDst is added) and hints; mappedAtCreation is implied by initialData
+     * @param initialData Optional contents, at most desc.size bytes
+     * @param frameCount Ring slots for Stream
+     * @return true if creation succeeded
+     */
+    bool create(const BufferDesc& desc,
+                const std::shared_ptr<ILogicalDevice>& device,
+                std::span<const std::byte> initialData = {},
+                uint32_t frameCount = DynamicBuffer::DEFAULT_FRAME_COUNT);
+
+    void destroy();
+
+    /**
+     * Write bytes at offset; Static writes go straight to the queue and need
+     * 4-byte aligned offset and size, the others are staged until upload()
+     * @return false if the range is out of bounds or the write failed
+     */
+    bool write(uint64_t offset, const void* data, uint64_t size);
+
+    template<typename T>
+    bool write(uint64_t offset, const T& value) {
+        return write(offset, &value, sizeof(T));
+    }
+
+    /**
+     * Send staged writes to the GPU, before submitting work that reads them
+     * @return true if the upload succeeded or nothing was staged
+     */
+    bool upload();
+
+    /**
+     * Queue staged Dynamic writes on a batcher; other strategies upload immediately
+     */
+    bool upload(UploadBatcher& batcher);
+
+    /**
+     * Advance the Stream ring after submitting the frame; no-op otherwise
+     */
+    void nextFrame();
+
+    Strategy getStrategy() const { return _strategy; }
+
+    /**
+     * Writes that waited for a UnifiedMapped slot to finish remapping
+     */
+    uint64_t getStallCount() const { return _stallCount; }
+
+    /**
+     * Buffer to bind this frame; the same object every frame unless Stream
+     */
+    std::shared_ptr<IBuffer> getCurrentBuffer() const;
+
+    // IBuffer interface
+    uint64_t getSize() const override;
+    BufferUsage getUsage() const override;
+    const std::string& getDebugName() const override;
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override;
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override;
+    AccessPattern getAccessPattern() const override;
+
+private:
+    struct UnifiedSlot;
+
+    IBuffer* getBackend() const;
+    bool mapCurrentSlot();
+
+    Strategy _strategy = Strategy::MappedAtCreation;
+    std::shared_ptr<IBuffer> _static;
+    std::shared_ptr<ShadowedDeviceBuffer> _shadowed;
+    std::shared_ptr<DynamicBuffer> _ring;
+    std::vector<UnifiedSlot> _slots;
+    uint32_t _currentSlot = 0;
+    uint64_t _stallCount = 0;
+    std::shared_ptr<IQueue> _queue;
+    DynamicBuffer::UpdateHandle _update{nullptr, 0, 0};  // Open Stream update of the current slot
+    uint64_t _dirtyBegin = 0;
+    uint64_t _dirtyEnd = 0;
+    uint64_t _size = 0;
+    AccessPattern _accessPattern = AccessPattern::Static;
+    std::string _emptyName;
+};
+
+} // namespace pers
@@ -63,6 +63,13 @@ public:
      * Get access pattern
      */
     virtual AccessPattern getAccessPattern() const = 0;
+    
+    /**
+     * Get byte offset of this buffer's range within the native handle
+     * Non-zero only for sub-allocated views such as DeviceBufferView.
+     * Backends add it to every offset they pass to the native API.
+     */
+    virtual uint64_t getNativeOffset() const { return 0; }
 };
 
 } // namespace pers
\ No newline at end of file
@@ -7,6 +7,12 @@
 
 namespace pers {
 
+/**
+ * Continuation for callback-based mapAsync
+ * Receives an empty MappedData (data() == nullptr) on failure.
+ */
+using MapCallback = std::function<void(MappedData mapped)>;
+
 /**
  * Interface for native backend mappable buffer implementations
  *
@@ -30,6 +36,14 @@ public:
      */
     virtual std::future<MappedData> mapAsync(MapMode mode = MapMode::Write, const BufferMapRange& range = {0, BufferMapRange::WHOLE_BUFFER}) = 0;
 
+    /**
+     * Asynchronously map buffer and invoke callback on completion
+     * No promise/future is created. The callback may run on any thread,
+     * including synchronously inside this call.
+     * @return false if the map could not be started; callback has already run
+     */
+    virtual bool mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) = 0;
+
     /**
      * Unmap buffer (if mapped)
      */
@@ -10,6 +10,7 @@ class ICommandEncoder;
 class DeviceBuffer;
 class ILogicalDevice;
 class INativeMappableBuffer;
+class StagingBufferPool;
 
 /**
  * Staging buffer with immediate CPU access (mappedAtCreation=true)
@@ -30,6 +31,19 @@ public:
                 const std::shared_ptr<ILogicalDevice>& device,
                 const std::string& debugName = "");
 
+    /**
+     * Create the staging buffer from a pool instead of allocating a new one
+     * The buffer returns to the pool on destroy(), which must therefore only
+     * happen after the command buffers that read it have been submitted.
+     * @param size Buffer size in bytes
+     * @param pool Staging buffer pool, usually ILogicalDevice::getStagingBufferPool()
+     * @param debugName Optional debug name
+     * @return true if creation succeeded
+     */
+    bool create(uint64_t size,
+                const std::shared_ptr<StagingBufferPool>& pool,
+                const std::string& debugName = "");
+
     /**
      * Destroy the staging buffer and release resources
      */
@@ -89,9 +103,10 @@ public:
     
 private:
     std::shared_ptr<INativeMappableBuffer> _buffer;  // Internal WebGPU mappable buffer
+    std::shared_ptr<StagingBufferPool> _pool;        // Owning pool, null if not pooled
     uint64_t _size;
     BufferUsage _usage;
-    std::string _debugName;
+    DebugLabel _debugName;
     void* _mappedData;
     bool _finalized;
     uint64_t _bytesWritten;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include <atomic>
+#include <coroutine>
+#include <optional>
+
+namespace pers {
+
+/**
+ * Awaitable wrapper over the callback form of INativeMappableBuffer::mapAsync
+ *
+ * Usage inside a coroutine:
+ *     MappedData mapped = co_await mapAsyncAwait(*buffer, MapMode::Read);
+ *
+ * The coroutine resumes on whichever thread delivers the map callback
+ * (the event pump thread, or inline if the map completes synchronously).
+ * The buffer must outlive the suspension.
+ */
+class MapAwaiter {
+public:
+    MapAwaiter(INativeMappableBuffer& buffer, MapMode mode, const BufferMapRange& range)
+        : _buffer(buffer)
+        , _mode(mode)
+        , _range(range) {
+    }
+
+    MapAwaiter(const MapAwaiter&) = delete;
+    MapAwaiter& operator=(const MapAwaiter&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        _handle = handle;
+        _buffer.mapAsync(_mode, _range, [this](MappedData mapped) {
+            _result.emplace(std::move(mapped));
+            // Whoever arrives second resumes: if await_suspend already returned
+            // we own the resume, otherwise it returns false and resumes inline
+            if (_state.exchange(true)) {
+                _handle.resume();
+            }
+        });
+        return !_state.exchange(true);
+    }
+
+    MappedData await_resume() {
+        if (!_result) {
+            return MappedData{nullptr, 0, nullptr};
+        }
+        return std::move(*_result);
+    }
+
+private:
+    INativeMappableBuffer& _buffer;
+    MapMode _mode;
+    BufferMapRange _range;
+    std::coroutine_handle<> _handle;
+    std::optional<MappedData> _result;
+    std::atomic<bool> _state{false};
+};
+
+/**
+ * Create an awaiter that maps the buffer without allocating a promise/future
+ */
+inline MapAwaiter mapAsyncAwait(INativeMappableBuffer& buffer,
+                                MapMode mode = MapMode::Read,
+                                const BufferMapRange& range = {0, BufferMapRange::WHOLE_BUFFER}) {
+    return MapAwaiter(buffer, mode, range);
+}
+
+} // namespace pers
@@ -1,15 +1,20 @@
 #pragma once
-#include <functional>
+#include <cstdint>
 
 namespace pers{
 
 /**
  * Mapped data wrapper with RAII auto-unmap
+ *
+ * The unmap hook is a plain function pointer plus context rather than a
+ * std::function, so constructing and moving a mapping never allocates.
  */
 
 class MappedData {
 public:
-    MappedData(void* data, uint64_t size, std::function<void()> unmapCallback);
+    using UnmapFn = void (*)(void* context);
+    
+    MappedData(void* data, uint64_t size, UnmapFn unmap = nullptr, void* unmapContext = nullptr);
     ~MappedData();
     
     // Move only, no copy
@@ -37,10 +42,12 @@ public:
     uint64_t count() const;
     
 private:
+    void release();
+    
     void* _data;
     uint64_t _size;
-    std::function<void()> _unmapCallback;
-    bool _moved;
+    UnmapFn _unmap;
+    void* _unmapContext;
 };
 
-} // namespace pers
\ No newline at end of file
+} // namespace pers
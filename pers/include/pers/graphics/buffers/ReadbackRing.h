@@ -0,0 +1,132 @@
+#pragma once
+
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/graphics/buffers/MappedData.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class ITexture;
+class DeviceBuffer;
+class DeferredStagingBuffer;
+struct TextureReadbackDesc;
+
+/**
+ * Rotating set of readback staging buffers for continuous GPU -> CPU readback
+ *
+ * Each frame:
+ *     uint64_t ticket = ring.enqueue(encoder, statsBuffer);   // record copy
+ *     queue->submit(...);
+ *     ring.submitted();                                       // start mapAsync
+ *     ring.harvest([](uint64_t ticket, const void* data, uint64_t size) { ... });
+ *
+ * Maps are completed by the event pump in the background; harvest() only
+ * consumes slots whose map has already resolved and never blocks. With a
+ * slot count of 3 results typically arrive 2-3 frames after enqueue. When
+ * every slot is still in flight enqueue() drops the request instead of
+ * stalling the frame.
+ */
+class ReadbackRing {
+public:
+    static constexpr uint32_t DEFAULT_SLOT_COUNT = 3;
+
+    using HarvestCallback = std::function<void(uint64_t ticket, const void* data, uint64_t size)>;
+
+    /**
+     * @param device Logical device used to create the staging buffers
+     * @param slotSize Capacity of each slot in bytes
+     * @param slotCount Number of buffers in rotation
+     * @param debugName Optional debug name prefix
+     */
+    ReadbackRing(const std::shared_ptr<ILogicalDevice>& device,
+                 uint64_t slotSize,
+                 uint32_t slotCount = DEFAULT_SLOT_COUNT,
+                 const std::string& debugName = "ReadbackRing");
+    ~ReadbackRing();
+
+    ReadbackRing(const ReadbackRing&) = delete;
+    ReadbackRing& operator=(const ReadbackRing&) = delete;
+
+    /**
+     * Record a copy from a device buffer into the next free slot
+     * @param encoder Encoder the copy is recorded into
+     * @param source Device buffer to read back
+     * @param copyDesc Source range; size 0 or WHOLE_SIZE copies up to the slot size
+     * @return Ticket identifying the result, 0 if no slot was free or the copy failed
+     */
+    uint64_t enqueue(const std::shared_ptr<ICommandEncoder>& encoder,
+                     const std::shared_ptr<DeviceBuffer>& source,
+                     const BufferCopyDesc& copyDesc = {});
+
+    /**
+     * Record a copy from a texture region into the next free slot
+     * Rows land desc.bytesPerRow apart (default: 256-byte aligned pitch), so
+     * the slot must hold bytesPerRow * rows; desc.bufferOffset is ignored.
+     * @return Ticket identifying the result, 0 if no slot was free or the copy failed
+     */
+    uint64_t enqueueTexture(const std::shared_ptr<ICommandEncoder>& encoder,
+                            const std::shared_ptr<ITexture>& source,
+                            const TextureReadbackDesc& desc);
+
+    /**
+     * Start mapping every slot recorded since the last call
+     * Must be called after the encoder's command buffer has been submitted.
+     */
+    void submitted();
+
+    /**
+     * Deliver finished readbacks in ticket order and recycle their slots
+     * Stops at the oldest slot that is still in flight, so results are never
+     * reordered.
+     * @return Number of results delivered
+     */
+    size_t harvest(const HarvestCallback& callback);
+
+    /**
+     * Copy out a specific result if it is ready
+     * @return true if the ticket was ready and copied; the slot is recycled
+     */
+    bool tryRead(uint64_t ticket, void* data, uint64_t size);
+
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(_slots.size()); }
+    uint64_t getSlotSize() const { return _slotSize; }
+    uint32_t getInFlightCount() const;
+    uint64_t getDroppedCount() const { return _droppedCount; }
+
+private:
+    enum class SlotState : uint32_t {
+        Free,
+        Recorded,     // Copy recorded, not yet submitted
+        MapPending,   // mapAsync issued
+        Ready,        // Mapped, data available
+        Failed        // Map failed, slot will be recycled by harvest
+    };
+
+    // Shared with map callbacks so a late completion never touches a destroyed ring
+    struct Slot {
+        std::shared_ptr<DeferredStagingBuffer> buffer;
+        std::atomic<SlotState> state{SlotState::Free};
+        uint64_t ticket = 0;
+        uint64_t size = 0;
+        MappedData mapping{nullptr, 0, nullptr};
+    };
+
+    Slot* findFreeSlot();
+    uint64_t commit(Slot& slot, uint64_t size);
+    void recycle(Slot& slot);
+
+    std::vector<std::shared_ptr<Slot>> _slots;
+    uint64_t _slotSize;
+    uint32_t _writeIndex;
+    uint64_t _nextTicket;
+    uint64_t _droppedCount;
+};
+
+} // namespace pers
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include "pers/utils/HugePages.h"
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class DeviceBuffer;
+class ILogicalDevice;
+class IQueue;
+class UploadBatcher;
+
+/**
+ * Device buffer with a CPU shadow copy and dirty-range uploads
+ *
+ * All writes land in the shadow and mark the touched granules dirty.
+ * upload() sends only the dirty spans to the GPU instead of the whole
+ * buffer, so sparse per-frame updates to large buffers cost roughly the
+ * bytes actually changed. Adjacent dirty granules are merged into one span,
+ * and clean gaps of up to mergeGap granules are uploaded as well when that
+ * saves a separate write.
+ *
+ * Typical frame:
+ *   shadowed.write(particleOffset, &particle, sizeof(particle));
+ *   shadowed.upload();   // or upload(batcher) before the batcher flushes
+ *
+ * Granularity trades tracking precision for bookkeeping: a single dirty byte
+ * uploads a whole granule. It must be a power of two and at least the copy
+ * alignment.
+ */
+class ShadowedDeviceBuffer final : public IBuffer {
+public:
+    static constexpr uint64_t DEFAULT_GRANULARITY = 256;
+    static constexpr uint32_t DEFAULT_MERGE_GAP = 1;
+
+    struct Stats {
+        uint64_t uploadedBytes = 0;   // Bytes sent by upload() so far
+        uint64_t uploadedSpans = 0;   // Spans written by upload() so far
+        uint64_t uploadCount = 0;     // upload() calls that had dirty data
+    };
+
+    ShadowedDeviceBuffer();
+    ~ShadowedDeviceBuffer() override;
+
+    ShadowedDeviceBuffer(const ShadowedDeviceBuffer&) = delete;
+    ShadowedDeviceBuffer& operator=(const ShadowedDeviceBuffer&) = delete;
+
+    /**
+     * Create the device buffer and its zeroed shadow
+     * @param size Buffer size in bytes (rounded up to the copy alignment)
+     * @param usage Buffer usage flags (CopyDst is added automatically)
+     * @param device Logical device to create resources
+     * @param granularity Dirty tracking granule in bytes
+     * @param mergeGap Clean granules between two dirty spans that are uploaded to join them
+     * @param debugName Optional debug name
+     * @return true if creation succeeded
+     */
+    bool create(uint64_t size,
+                DeviceBufferUsage usage,
+                const std::shared_ptr<ILogicalDevice>& device,
+                uint64_t granularity = DEFAULT_GRANULARITY,
+                uint32_t mergeGap = DEFAULT_MERGE_GAP,
+                const std::string& debugName = "");
+
+    void destroy();
+
+    /**
+     * Copy data into the shadow and mark the range dirty
+     * @return false if the range is out of bounds
+     */
+    bool write(uint64_t offset, const void* data, uint64_t size);
+
+    template<typename T>
+    bool write(uint64_t offset, const T& value) {
+        return write(offset, &value, sizeof(T));
+    }
+
+    /**
+     * Direct access to the shadow, call markDirty() for modified ranges
+     */
+    uint8_t* data();
+    const uint8_t* data() const;
+
+    /**
+     * Mark a range of the shadow as modified
+     */
+    void markDirty(uint64_t offset, uint64_t size);
+
+    /**
+     * Mark the whole buffer dirty, e.g. after the device buffer was overwritten
+     */
+    void markAllDirty();
+
+    /**
+     * Upload dirty spans with one batched queue write
+     * @return true if the upload succeeded or nothing was dirty
+     */
+    bool upload();
+
+    /**
+     * Queue dirty spans on a batcher; they reach the GPU on its next flush
+     * @return true if every span was queued or nothing was dirty
+     */
+    bool upload(UploadBatcher& batcher);
+
+    bool isDirty() const;
+    uint64_t getDirtyBytes() const;
+    uint64_t getGranularity() const;
+    Stats getStats() const;
+
+    /**
+     * Underlying device buffer, e.g. for UploadBatcher destinations or bindings
+     */
+    const std::shared_ptr<DeviceBuffer>& getDeviceBuffer() const;
+
+    // IBuffer interface
+    uint64_t getSize() const override;
+    BufferUsage getUsage() const override;
+    const std::string& getDebugName() const override;
+    NativeBufferHandle getNativeHandle() const override;
+    bool isValid() const override;
+    BufferState getState() const override;
+    MemoryLocation getMemoryLocation() const override;
+    AccessPattern getAccessPattern() const override;
+
+private:
+    struct Span {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    // Dirty granules as merged byte spans, clamped to the buffer size
+    std::vector<Span> collectSpans() const;
+    void clearDirty();
+    void recordUpload(const std::vector<Span>& spans);
+
+    std::shared_ptr<DeviceBuffer> _buffer;
+    std::shared_ptr<IQueue> _queue;
+    HugePageBuffer _shadow;  // Huge pages for large buffers, per the HugePages policy
+    std::vector<uint64_t> _dirtyBits;  // One bit per granule
+    uint64_t _size;
+    uint64_t _granularity;
+    uint32_t _granularityShift;
+    uint32_t _mergeGap;
+    uint64_t _dirtyGranules;
+    Stats _stats;
+    DebugLabel _debugName;
+    bool _created;
+};
+
+} // namespace pers
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+#include "pers/graphics/buffers/MappedData.h"
+#include "pers/utils/Mutex.h"
+
+namespace pers {
+
+class IResourceFactory;
+class IQueue;
+class INativeMappableBuffer;
+
+/**
+ * Pool of MapWrite|CopySrc staging buffers bucketed by power-of-two size class
+ *
+ * acquire() hands out a buffer that is already mapped for writing. Once the
+ * copies reading it have been submitted, release() fences it with a queue
+ * work-done callback; after the GPU retires it the pool re-maps it with
+ * mapAsync and hands it out again, so steady-state uploads never hit the
+ * driver allocator.
+ *
+ * Owned by the logical device, see ILogicalDevice::getStagingBufferPool().
+ */
+class StagingBufferPool : public std::enable_shared_from_this<StagingBufferPool> {
+public:
+    static constexpr uint32_t MIN_SIZE_CLASS_SHIFT = 12;  // 4 KiB
+    static constexpr uint32_t MAX_SIZE_CLASS_SHIFT = 28;  // 256 MiB, larger requests are not pooled
+    static constexpr uint32_t SIZE_CLASS_COUNT = MAX_SIZE_CLASS_SHIFT - MIN_SIZE_CLASS_SHIFT + 1;
+    static constexpr uint64_t DEFAULT_MAX_POOLED_BYTES = 64ull * 1024 * 1024;
+
+    struct Stats {
+        uint64_t allocations = 0;  // Buffers created through the resource factory
+        uint64_t reuses = 0;       // Requests served from the free lists
+        uint64_t inFlight = 0;     // Released buffers waiting for the GPU or re-map
+        uint64_t pooledBytes = 0;  // Bytes held in free lists
+    };
+
+    StagingBufferPool(const std::shared_ptr<IResourceFactory>& resourceFactory,
+                      const std::shared_ptr<IQueue>& queue);
+    ~StagingBufferPool();
+
+    StagingBufferPool(const StagingBufferPool&) = delete;
+    StagingBufferPool& operator=(const StagingBufferPool&) = delete;
+
+    /**
+     * Get a mapped staging buffer of at least the requested size
+     * @param size Minimum size in bytes
+     * @return Mapped buffer or nullptr on failure
+     */
+    std::shared_ptr<INativeMappableBuffer> acquire(uint64_t size);
+
+    /**
+     * Return a buffer to the pool
+     * Must only be called after the command buffers that read it were submitted.
+     * The buffer may be unmapped or still mapped.
+     */
+    void release(const std::shared_ptr<INativeMappableBuffer>& buffer);
+
+    /**
+     * Re-map retired buffers and move completed mappings to the free lists
+     * Called implicitly by acquire()
+     */
+    void collect();
+
+    /**
+     * Drop all idle buffers
+     */
+    void trim();
+
+    /**
+     * Limit the number of bytes kept in free lists
+     */
+    void setMaxPooledBytes(uint64_t maxBytes);
+
+    Stats getStats() const;
+
+    /**
+     * Get the pooled size for a request, 0 if the request is too large to pool
+     */
+    static uint64_t getSizeClassSize(uint64_t size);
+
+private:
+    struct PendingMap {
+        std::shared_ptr<INativeMappableBuffer> buffer;
+        std::future<MappedData> future;
+    };
+
+    static uint32_t getSizeClassIndex(uint64_t size);
+    void onRetired(const std::shared_ptr<INativeMappableBuffer>& buffer);
+
+    std::shared_ptr<IResourceFactory> _resourceFactory;
+    std::shared_ptr<IQueue> _queue;
+
+    mutable Mutex<false> _mutex;
+    std::array<std::vector<std::shared_ptr<INativeMappableBuffer>>, SIZE_CLASS_COUNT> _freeLists;
+    std::vector<std::shared_ptr<INativeMappableBuffer>> _retired;  // GPU done, not yet re-mapped
+    std::vector<PendingMap> _pendingMaps;
+    uint64_t _maxPooledBytes;
+    Stats _stats;
+};
+
+} // namespace pers
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pers {
+
+class ILogicalDevice;
+class ICommandEncoder;
+class DeviceBuffer;
+class ImmediateStagingBuffer;
+
+/**
+ * Coalesces many small device buffer uploads into shared staging arenas
+ *
+ * enqueue() linearly packs data into the current arena (a pooled
+ * ImmediateStagingBuffer) at COPY_BUFFER_OFFSET alignment and records the
+ * destination range. flush() finalizes the arenas and emits every copy into
+ * a single command encoder and submit, merging copies that are contiguous in
+ * both source and destination.
+ *
+ * Uploads larger than the arena size get a dedicated staging buffer.
+ */
+class UploadBatcher {
+public:
+    static constexpr uint64_t DEFAULT_ARENA_SIZE = 4ull * 1024 * 1024;
+
+    /**
+     * @param device Logical device used for staging buffers, encoders and submission
+     * @param arenaSize Size of each staging arena in bytes
+     */
+    explicit UploadBatcher(const std::shared_ptr<ILogicalDevice>& device,
+                           uint64_t arenaSize = DEFAULT_ARENA_SIZE);
+    ~UploadBatcher();
+
+    UploadBatcher(const UploadBatcher&) = delete;
+    UploadBatcher& operator=(const UploadBatcher&) = delete;
+
+    /**
+     * Queue an upload to a device buffer
+     * @param data Source data, copied immediately
+     * @param size Size in bytes
+     * @param destination Destination device buffer
+     * @param dstOffset Destination offset, must be 4-byte aligned
+     * @return true if the upload was queued
+     */
+    bool enqueue(const void* data,
+                 uint64_t size,
+                 const std::shared_ptr<DeviceBuffer>& destination,
+                 uint64_t dstOffset = 0);
+
+    /**
+     * Record all queued copies into an existing encoder
+     * The arenas stay alive until retire(), which must be called after the
+     * encoder's command buffer has been submitted.
+     * @return true if all copies were recorded
+     */
+    bool record(const std::shared_ptr<ICommandEncoder>& encoder);
+
+    /**
+     * Release arenas recorded by record() back to the staging pool
+     */
+    void retire();
+
+    /**
+     * Record all queued copies into one encoder and submit it
+     * @return true if submission succeeded (or nothing was queued)
+     */
+    bool flush();
+
+    uint64_t getPendingBytes() const;
+    size_t getPendingCopyCount() const;
+
+private:
+    struct PendingCopy {
+        size_t arenaIndex;
+        uint64_t srcOffset;
+        std::shared_ptr<DeviceBuffer> destination;
+        uint64_t dstOffset;
+        uint64_t size;
+    };
+
+    bool beginArena(uint64_t minSize);
+
+    std::shared_ptr<ILogicalDevice> _device;
+    uint64_t _arenaSize;
+    std::vector<std::shared_ptr<ImmediateStagingBuffer>> _arenas;
+    std::vector<std::shared_ptr<ImmediateStagingBuffer>> _recordedArenas;  // Waiting for retire()
+    std::vector<PendingCopy> _copies;
+    uint64_t _arenaOffset;
+    uint64_t _pendingBytes;
+};
+
+} // namespace pers
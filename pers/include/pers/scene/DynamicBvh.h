@@ -0,0 +1,88 @@
+#pragma once
+
+#include "pers/scene/Frustum.h"
+#include <cstdint>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Incrementally updated AABB tree for culling large scenes
+ *
+ * Leaves store a box enlarged by a margin, so objects that move a little
+ * stay in their leaf and move() is usually a compare. Insertion picks the
+ * sibling with the smallest surface-area increase and tree rotations keep
+ * the height logarithmic.
+ *
+ * queryFrustum() skips whole subtrees outside the frustum and collects
+ * subtrees fully inside it without further tests. Each node only tests the
+ * planes its parent straddled. Use it instead of cullBounds() when most of
+ * the scene is off screen; for mostly visible scenes the flat SIMD pass
+ * touches less memory.
+ */
+class DynamicBvh {
+public:
+    static constexpr uint32_t INVALID_PROXY = UINT32_MAX;
+
+    /**
+     * @param margin Distance leaves are enlarged by on every side
+     */
+    explicit DynamicBvh(float margin = 0.1f);
+    ~DynamicBvh() = default;
+
+    DynamicBvh(const DynamicBvh&) = delete;
+    DynamicBvh& operator=(const DynamicBvh&) = delete;
+
+    /**
+     * @param userData Returned by queries, typically the object or draw index
+     * @return Proxy identifying the leaf
+     */
+    uint32_t insert(const float min[3], const float max[3], uint32_t userData);
+    void remove(uint32_t proxy);
+
+    /**
+     * @brief Update a leaf's box
+     * @return true if the box left the enlarged leaf and the leaf was reinserted
+     */
+    bool move(uint32_t proxy, const float min[3], const float max[3]);
+
+    uint32_t getUserData(uint32_t proxy) const { return _nodes[proxy].userData; }
+
+    /**
+     * @brief Append the user data of every leaf intersecting the frustum
+     * The enlarged leaf boxes are tested, so results are slightly conservative.
+     */
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& userData) const;
+
+    uint32_t getLeafCount() const { return _leafCount; }
+    uint32_t getHeight() const { return _root == INVALID_PROXY ? 0 : static_cast<uint32_t>(_nodes[_root].height); }
+
+private:
+    struct Node {
+        float min[3];
+        float max[3];
+        uint32_t parent = INVALID_PROXY;  // Next free node while on the free list
+        uint32_t child1 = INVALID_PROXY;
+        uint32_t child2 = INVALID_PROXY;
+        uint32_t userData = 0;
+        int32_t height = -1;              // 0 for leaves, -1 when free
+
+        bool isLeaf() const { return child1 == INVALID_PROXY; }
+    };
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t index);
+    void insertLeaf(uint32_t leaf);
+    void removeLeaf(uint32_t leaf);
+    uint32_t balance(uint32_t index);
+    void refit(uint32_t index);
+    void collectLeaves(uint32_t index, std::vector<uint32_t>& userData, std::vector<uint32_t>& stack) const;
+
+    std::vector<Node> _nodes;
+    uint32_t _root = INVALID_PROXY;
+    uint32_t _freeList = INVALID_PROXY;
+    uint32_t _leafCount = 0;
+    float _margin;
+};
+
+} // namespace pers
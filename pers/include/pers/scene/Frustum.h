@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Six view-frustum planes
+ *
+ * Planes are (normal.xyz, distance) with unit normals pointing into the
+ * frustum, the same convention as FrustumCullUniforms, so one Frustum feeds
+ * both the CPU and the GPU culler.
+ */
+struct Frustum {
+    enum class Result : uint8_t {
+        Outside,
+        Intersects,
+        Inside
+    };
+
+    std::array<std::array<float, 4>, 6> planes{};
+
+    /**
+     * @brief Extract the planes of a column-major view-projection matrix
+     * Expects WebGPU clip space, depth in [0, 1].
+     */
+    static Frustum fromViewProjection(const float matrix[16]);
+
+    Result testSphere(const float center[3], float radius) const;
+    Result testBox(const float min[3], const float max[3]) const;
+};
+
+/**
+ * @brief Bounding volumes in structure-of-arrays layout for batch culling
+ *
+ * Every entry is a box (center, half extents) grown by a radius: spheres
+ * have zero extents, boxes zero radius. One test covers both:
+ * dot(n, center) + d >= -(radius + dot(|n|, extents)).
+ */
+class BoundsList {
+public:
+    uint32_t addSphere(const float center[3], float radius);
+    uint32_t addBox(const float min[3], const float max[3]);
+
+    void setSphere(uint32_t index, const float center[3], float radius);
+    void setBox(uint32_t index, const float min[3], const float max[3]);
+
+    void clear();
+    void reserve(uint32_t count);
+    uint32_t size() const { return static_cast<uint32_t>(_centerX.size()); }
+
+private:
+    friend uint32_t cullBounds(const Frustum& frustum, const BoundsList& bounds, std::vector<uint32_t>& visible);
+
+    std::vector<float> _centerX, _centerY, _centerZ;
+    std::vector<float> _extentX, _extentY, _extentZ;
+    std::vector<float> _radius;
+};
+
+enum class CullKernel : uint8_t {
+    Scalar = 0,
+    SSE2,
+    AVX2,
+    NEON
+};
+
+/**
+ * @brief Append the indices of entries that intersect the frustum
+ *
+ * Tests 4 (SSE2, NEON) or 8 (AVX2) volumes per iteration against all six
+ * planes. Indices are appended in ascending order, so they can index the
+ * scene's draw list directly:
+ *
+ *     visible.clear();
+ *     cullBounds(Frustum::fromViewProjection(viewProj), bounds, visible);
+ *     for (uint32_t index : visible) {
+ *         queue.add(draws[index], pass, depths[index]);
+ *     }
+ *
+ * @return Number of indices appended
+ */
+uint32_t cullBounds(const Frustum& frustum, const BoundsList& bounds, std::vector<uint32_t>& visible);
+
+/**
+ * @brief Kernel cullBounds() uses, picked from the CPU's features
+ */
+CullKernel getCullKernel();
+
+/**
+ * @brief Force a kernel, mainly for benchmarks
+ * @return false if the CPU does not support it
+ */
+bool setCullKernel(CullKernel kernel);
+
+const char* getCullKernelName(CullKernel kernel);
+
+} // namespace pers
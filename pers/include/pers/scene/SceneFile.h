@@ -0,0 +1,202 @@
+#pragma once
+
+#include "pers/scene/Frustum.h"
+#include "pers/scene/TransformHierarchy.h"
+#include "pers/utils/MappedFile.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+constexpr uint32_t SCENE_NONE = UINT32_MAX;
+
+enum SceneMaterialFlags : uint32_t {
+    SCENE_MATERIAL_DOUBLE_SIDED = 1u << 0,
+    SCENE_MATERIAL_ALPHA_BLEND = 1u << 1,
+    SCENE_MATERIAL_ALPHA_MASK = 1u << 2
+};
+
+/**
+ * @brief Material table entry, read in place from the mapping
+ * String fields index SceneFile::getString(), SCENE_NONE when unset.
+ */
+struct SceneMaterialRecord {
+    float baseColor[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float emissive[3] = {0.0f, 0.0f, 0.0f};
+    float metallic = 0.0f;
+    float roughness = 1.0f;
+    float alphaCutoff = 0.5f;
+    uint32_t flags = 0;
+    uint32_t name = SCENE_NONE;
+    uint32_t baseColorTexture = SCENE_NONE;
+    uint32_t normalTexture = SCENE_NONE;
+    uint32_t metallicRoughnessTexture = SCENE_NONE;
+    uint32_t reserved = 0;
+};
+
+/**
+ * @brief Mesh table entry: a mesh inside a cooked mesh file, with its local bounds
+ */
+struct SceneMeshRecord {
+    uint32_t path = SCENE_NONE;  // String index of the mesh file, relative to the scene
+    uint32_t meshIndex = 0;      // Mesh within that file
+    float boundsMin[3] = {};
+    float boundsMax[3] = {};
+};
+
+/**
+ * @brief Node of the precomputed BVH over nodes that have a mesh
+ * Inner nodes have count 0, their first child follows them and first is the
+ * second child. Leaves list count node indices starting at first.
+ */
+struct SceneBvhNode {
+    float min[3];
+    uint32_t first;
+    float max[3];
+    uint32_t count;
+};
+
+static_assert(sizeof(SceneMaterialRecord) == 64 && sizeof(SceneMeshRecord) == 32 && sizeof(SceneBvhNode) == 32);
+
+/**
+ * @brief Scene used in place from a memory-mapped file
+ *
+ * Written offline by SceneFileWriter. Nodes are stored as
+ * structure-of-arrays with every parent before its children: parent, mesh,
+ * material and name indices, local position, rotation and scale, and world
+ * bounds. Materials, mesh references into cooked mesh files and a BVH over
+ * the meshed nodes sit next to them, each section 16-byte aligned.
+ *
+ * open() validates the header and section table and nothing else; every
+ * accessor is a span into the mapping, so opening a scene of any size costs
+ * a few page faults and the rest streams in as it is touched:
+ *
+ *     auto scene = SceneFile::open("city.pscene");
+ *     std::vector<TransformId> ids = scene->instantiate(hierarchy);
+ *     scene->queryFrustum(frustum, visibleNodes);
+ *
+ * The bounds and BVH reflect the transforms as written; nodes animated at
+ * runtime need their own culling. Thread-safe, the mapping is read-only.
+ */
+class SceneFile {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @brief Map a scene and validate its sections
+     * @return Null if the file is missing, truncated or of another version
+     */
+    static std::shared_ptr<SceneFile> open(const std::string& path);
+
+    uint32_t getNodeCount() const { return _nodeCount; }
+
+    std::span<const uint32_t> getParents() const;          // SCENE_NONE for roots
+    std::span<const uint32_t> getMeshIndices() const;      // Into getMeshes(), SCENE_NONE without a mesh
+    std::span<const uint32_t> getMaterialIndices() const;  // Into getMaterials()
+    std::span<const std::array<float, 3>> getPositions() const;
+    std::span<const std::array<float, 4>> getRotations() const;  // Unit quaternions (x, y, z, w)
+    std::span<const std::array<float, 3>> getScales() const;
+    std::span<const std::array<float, 3>> getBoundsMin() const;  // World space, min > max without a mesh
+    std::span<const std::array<float, 3>> getBoundsMax() const;
+
+    std::span<const SceneMeshRecord> getMeshes() const;
+    std::span<const SceneMaterialRecord> getMaterials() const;
+    std::span<const SceneBvhNode> getBvhNodes() const;
+
+    std::string_view getNodeName(uint32_t node) const;
+    std::string_view getString(uint32_t index) const;  // Empty for SCENE_NONE
+    LocalTransform getLocal(uint32_t node) const;
+
+    /**
+     * @brief Create every node in a hierarchy, in file order
+     * @return Transform id of each node
+     */
+    std::vector<TransformId> instantiate(TransformHierarchy& hierarchy) const;
+
+    /**
+     * @brief Append the indices of meshed nodes whose world bounds intersect the frustum
+     */
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& nodes) const;
+
+    /**
+     * @brief Check every index and string reference, touching the whole file
+     * open() only checks the section table; run this in tools or on untrusted files.
+     */
+    bool validate(std::string* error = nullptr) const;
+
+    size_t getSize() const { return _file.size(); }
+    const std::string& getPath() const { return _path; }
+
+private:
+    SceneFile() = default;
+
+    template<typename T>
+    std::span<const T> section(uint32_t index, size_t count) const {
+        return {reinterpret_cast<const T*>(_file.data() + _sections[index]), count};
+    }
+
+    MappedFile _file;
+    std::string _path;
+    uint32_t _nodeCount = 0;
+    uint32_t _meshCount = 0;
+    uint32_t _materialCount = 0;
+    uint32_t _bvhNodeCount = 0;
+    uint32_t _bvhLeafCount = 0;
+    uint32_t _stringCount = 0;
+    uint64_t _stringDataSize = 0;
+    std::vector<uint64_t> _sections;  // Offset of each section in the file
+};
+
+/**
+ * @brief Collects a scene and writes a SceneFile
+ *
+ * save() computes world bounds from the transforms and mesh bounds and
+ * builds the BVH, so the expensive part of a scene load happens once here.
+ */
+class SceneFileWriter {
+public:
+    static constexpr uint32_t BVH_LEAF_SIZE = 4;
+
+    struct MaterialDesc {
+        std::string name;
+        SceneMaterialRecord values;  // String fields are filled from the paths below
+        std::string baseColorTexture;
+        std::string normalTexture;
+        std::string metallicRoughnessTexture;
+    };
+
+    uint32_t addMesh(const std::string& path, uint32_t meshIndex, const float boundsMin[3], const float boundsMax[3]);
+    uint32_t addMaterial(const MaterialDesc& material);
+
+    /**
+     * @param parent A node added before, or SCENE_NONE for a root
+     * @return Node index, SCENE_NONE if parent, mesh or material is unknown
+     */
+    uint32_t addNode(uint32_t parent, const LocalTransform& local, uint32_t mesh = SCENE_NONE,
+                     uint32_t material = SCENE_NONE, const std::string& name = "");
+
+    bool save(const std::string& path, std::string* error = nullptr) const;
+
+    uint32_t getNodeCount() const { return static_cast<uint32_t>(_parents.size()); }
+
+private:
+    uint32_t addString(const std::string& value);
+
+    std::vector<uint32_t> _parents;
+    std::vector<uint32_t> _meshIndices;
+    std::vector<uint32_t> _materialIndices;
+    std::vector<uint32_t> _names;
+    std::vector<LocalTransform> _locals;
+    std::vector<SceneMeshRecord> _meshes;
+    std::vector<SceneMaterialRecord> _materials;
+    std::vector<std::string> _strings;
+    std::unordered_map<std::string, uint32_t> _stringIndices;
+};
+
+} // namespace pers
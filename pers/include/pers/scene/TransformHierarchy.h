@@ -0,0 +1,145 @@
+#pragma once
+
+#include "pers/core/JobSystem.h"
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <vector>
+
+namespace pers {
+
+using TransformId = uint32_t;
+constexpr TransformId INVALID_TRANSFORM = UINT32_MAX;
+
+/**
+ * @brief Local translation, rotation and scale relative to the parent
+ * rotation is a unit quaternion (x, y, z, w).
+ */
+struct LocalTransform {
+    float position[3] = {0.0f, 0.0f, 0.0f};
+    float rotation[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+};
+
+/**
+ * @brief Scene transforms stored as structure-of-arrays, sorted by depth
+ *
+ * Local TRS components live in separate arrays ordered by hierarchy depth,
+ * so every parent is updated before its children and a depth level is a
+ * contiguous range. The update builds local matrices four transforms at a
+ * time with SSE2 or NEON, multiplies them with the parent's world matrix and
+ * writes the result both to an internal world array and, optionally, straight
+ * into a mapped instance or storage buffer:
+ *
+ *     auto slice = instances->allocate(hierarchy.getCapacity() * TransformHierarchy::MATRIX_SIZE);
+ *     auto update = hierarchy.scheduleUpdate(jobs, slice.data);
+ *     jobs.wait(update);
+ *
+ * Matrices are column-major mat4x4<f32> and written at id * stride, so a
+ * transform's id doubles as its instance index. scheduleUpdate() splits each
+ * depth level into parallel batches that depend on the previous level.
+ *
+ * Creating, destroying or reparenting re-sorts the arrays during the next
+ * update. Nothing may modify the hierarchy while a scheduled update runs.
+ */
+class TransformHierarchy {
+public:
+    static constexpr uint32_t MATRIX_SIZE = 64;    // Bytes of one mat4x4<f32>
+    static constexpr uint32_t BATCH_SIZE = 2048;   // Transforms per update job
+
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    /**
+     * @param parent Existing transform or INVALID_TRANSFORM for a root
+     * @return New id, INVALID_TRANSFORM if parent is not a live transform
+     */
+    TransformId create(TransformId parent = INVALID_TRANSFORM, const LocalTransform& local = {});
+
+    /**
+     * @brief Free a transform; its id may be reused by a later create()
+     * @return false if the id is not live or the transform still has children
+     */
+    bool destroy(TransformId id);
+
+    /**
+     * @return false if either id is not live or the change would create a cycle
+     */
+    bool setParent(TransformId id, TransformId parent);
+    TransformId getParent(TransformId id) const;
+
+    void setLocal(TransformId id, const LocalTransform& local);
+    void setPosition(TransformId id, float x, float y, float z);
+    void setRotation(TransformId id, float x, float y, float z, float w);
+    void setScale(TransformId id, float x, float y, float z);
+    LocalTransform getLocal(TransformId id) const;
+
+    /**
+     * @brief Column-major world matrix (16 floats) as of the last update
+     */
+    const float* getWorldMatrix(TransformId id) const;
+
+    bool isValid(TransformId id) const;
+
+    /**
+     * @brief Live transforms
+     */
+    uint32_t getCount() const { return _liveCount; }
+
+    /**
+     * @brief One past the highest id handed out; destinations need getCapacity() * stride bytes
+     */
+    uint32_t getCapacity() const { return static_cast<uint32_t>(_parentIds.size()); }
+
+    /**
+     * @brief Recompute every world matrix on the calling thread
+     * @param destination Optional mapped memory, receives the matrix of id at id * stride
+     * @param stride Bytes between matrices, at least MATRIX_SIZE
+     *
+     * With a 64-byte aligned destination and a stride that is a multiple of 64
+     * each matrix fills one cache line and is written with non-temporal stores.
+     */
+    void update(void* destination = nullptr, uint32_t stride = MATRIX_SIZE);
+
+    /**
+     * @brief Recompute every world matrix as jobs, one batch chain per depth level
+     * @return Handle completing when every matrix is written
+     */
+    JobHandle scheduleUpdate(JobSystem& jobs, void* destination = nullptr, uint32_t stride = MATRIX_SIZE,
+                             std::span<const JobHandle> dependencies = {});
+    JobHandle scheduleUpdate(JobSystem& jobs, void* destination, uint32_t stride,
+                             std::initializer_list<JobHandle> dependencies) {
+        return scheduleUpdate(jobs, destination, stride,
+                              std::span<const JobHandle>(dependencies.begin(), dependencies.size()));
+    }
+
+private:
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+    void sortByDepth();
+    void updateRange(uint32_t begin, uint32_t end, uint8_t* destination, uint32_t stride);
+    void appendSlot(TransformId id, const LocalTransform& local);
+
+    // Indexed by id
+    std::vector<TransformId> _parentIds;
+    std::vector<uint32_t> _childCounts;
+    std::vector<uint32_t> _slots;         // INVALID_SLOT for freed ids
+    std::vector<TransformId> _freeIds;
+
+    // Indexed by slot, sorted by depth after sortByDepth()
+    std::vector<float> _positionX, _positionY, _positionZ;
+    std::vector<float> _rotationX, _rotationY, _rotationZ, _rotationW;
+    std::vector<float> _scaleX, _scaleY, _scaleZ;
+    std::vector<uint32_t> _parentSlots;
+    std::vector<TransformId> _slotIds;    // INVALID_TRANSFORM for destroyed slots
+    std::vector<float> _world;            // 16 floats per slot
+
+    std::vector<uint32_t> _levelStarts;   // Slot range of each depth level, plus the end
+    uint32_t _liveCount = 0;
+    bool _orderDirty = false;
+};
+
+} // namespace pers
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Replaces global operator new/delete with counting versions when 1. Set
+// through the PERS_ALLOCATION_TRACKING CMake option; without it the whole
+// tracker is inert and AllocationFrameScope compiles to nothing.
+#ifndef PERS_ALLOCATION_TRACKING
+#define PERS_ALLOCATION_TRACKING 0
+#endif
+
+namespace pers {
+
+/**
+ * @brief Debug check that the frame loop stays free of heap allocations
+ *
+ * Counts every operator new made by a thread while it is inside an
+ * AllocationFrameScope, once nextFrame() has been called warmup frames
+ * times. Each allocation site is identified by a short captured call stack;
+ * when a scope that allocated ends, the thread logs the count and the sites,
+ * and Assert mode then aborts the process.
+ *
+ * Application wraps each frame's update and render in a scope and calls
+ * nextFrame() itself; set the mode before run() to enable the check:
+ *
+ *   AllocationTracker::setMode(AllocationTracker::Mode::Report);
+ *   AllocationTracker::setWarmupFrames(120);
+ *
+ * malloc() and allocations inside the native WebGPU library are not seen.
+ * With pers_shared on Windows, only allocations made by the DLL itself are.
+ */
+class AllocationTracker {
+public:
+    enum class Mode {
+        Off,
+        Report,  // Log allocating frames and keep running
+        Assert   // Log, then abort at the end of the first allocating frame
+    };
+
+    static constexpr size_t MAX_SITES = 64;
+    static constexpr size_t MAX_SITE_FRAMES = 8;
+    static constexpr uint32_t DEFAULT_WARMUP_FRAMES = 60;
+
+    struct Site {
+        const void* frames[MAX_SITE_FRAMES] = {};  // Innermost first, from about operator new
+        uint32_t frameCount = 0;
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+    };
+
+    struct Stats {
+        uint64_t frames = 0;            // nextFrame() calls
+        uint64_t allocatingFrames = 0;  // Scopes that ended with allocations
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+        uint64_t droppedSites = 0;      // Allocations from sites past MAX_SITES
+    };
+
+    // False unless built with PERS_ALLOCATION_TRACKING
+    static bool isCompiledIn() { return PERS_ALLOCATION_TRACKING != 0; }
+
+    static void setMode(Mode mode);
+    static Mode getMode();
+
+    // Frames nextFrame() must count before scopes are checked
+    static void setWarmupFrames(uint32_t frames);
+    static void nextFrame();
+
+    // Calling thread only; scopes nest
+    static void beginScope();
+    static void endScope();
+
+    static Stats getStats();
+    // Sites seen since the last reset(), most allocations first
+    static std::vector<Site> getSites();
+    static void reset();
+
+    // Hook of the replaced operator new
+    static void recordAllocation(size_t size);
+};
+
+/**
+ * @brief Marks the calling thread's code as allocation-free while it lives
+ */
+class AllocationFrameScope {
+public:
+#if PERS_ALLOCATION_TRACKING
+    AllocationFrameScope() { AllocationTracker::beginScope(); }
+    ~AllocationFrameScope() { AllocationTracker::endScope(); }
+#else
+    AllocationFrameScope() {}  // User-provided, so scopes do not warn as unused variables
+#endif
+
+    AllocationFrameScope(const AllocationFrameScope&) = delete;
+    AllocationFrameScope& operator=(const AllocationFrameScope&) = delete;
+};
+
+} // namespace pers
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pers/utils/Logger.h"
+#include "pers/utils/Mutex.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace pers {
+
+/**
+ * @brief Log output writing compact binary records into a memory-mapped file
+ *
+ * Each entry is a fixed 22-byte header (level, timestamp in nanoseconds,
+ * interned category, thread and source location ids) followed by the message
+ * bytes. Categories, threads and source locations are written once, as
+ * definition records, the first time they appear. Nothing is formatted and no
+ * system call is made per entry; the file grows by remapping in
+ * growSize steps.
+ *
+ * Pages are written back by the OS, so a crashed process still leaves every
+ * completed record on disk. Decode with BinaryLogReader.
+ */
+class BinaryLogOutput : public ILogOutput {
+public:
+    static constexpr uint32_t MAGIC = 0x474F4C50;  // "PLOG"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint64_t DEFAULT_GROW_SIZE = 16ull << 20;
+    static constexpr uint64_t HEADER_SIZE = 16;  // Magic, version, header size, written bytes
+
+    enum class RecordType : uint8_t {
+        End = 0,           // Zero-filled tail of the mapping
+        Category = 1,
+        Source = 2,
+        Thread = 3,
+        Entry = 4
+    };
+
+    // Truncates the file; throws std::runtime_error if it cannot be created and mapped
+    explicit BinaryLogOutput(const std::string& filename, uint64_t growSize = DEFAULT_GROW_SIZE);
+    ~BinaryLogOutput() override;
+
+    BinaryLogOutput(const BinaryLogOutput&) = delete;
+    BinaryLogOutput& operator=(const BinaryLogOutput&) = delete;
+
+    void Write(const LogEntry& entry) override;
+    // Publishes the written length in the file header
+    void Flush() override;
+
+    uint64_t getWrittenBytes() const { return _writePos; }
+
+private:
+    uint8_t* reserve(uint64_t size);
+    bool remap(uint64_t capacity);
+    void close();
+
+    uint16_t internCategory(const std::string& category);
+    uint16_t internThread(std::thread::id threadId);
+    uint32_t internSource(const LogEntry& entry);
+
+    uint8_t* _data = nullptr;
+    uint64_t _capacity = 0;
+    uint64_t _writePos = 0;
+    uint64_t _growSize;
+#ifdef _WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#else
+    int _fd = -1;
+#endif
+
+    std::unordered_map<std::string, uint16_t> _categoryIds;
+    std::unordered_map<std::thread::id, uint16_t> _threadIds;
+    std::unordered_map<uint64_t, uint32_t> _sourceIds;  // Keyed by hash of file, line and function
+    mutable Mutex<false> _mutex;
+};
+
+/**
+ * @brief Offline decoder for files written by BinaryLogOutput
+ *
+ * Rebuilds a LogEntry per record, so a trace can be replayed into any
+ * ILogOutput such as FileOutput. std::thread::id cannot be restored; the
+ * writing thread is reported as its index in order of first appearance.
+ */
+class BinaryLogReader {
+public:
+    using EntryCallback = std::function<void(const LogEntry& entry, uint16_t threadIndex)>;
+
+    /**
+     * @brief Decode every complete record in a binary log
+     * @return False if the file is missing or not a binary log; a truncated
+     *         tail ends decoding without failing
+     */
+    static bool read(const std::string& filename, const EntryCallback& callback);
+};
+
+} // namespace pers
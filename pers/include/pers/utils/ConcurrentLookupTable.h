@@ -0,0 +1,260 @@
+#pragma once
+
+#include "pers/utils/CpuMemoryTracker.h"
+#include "pers/utils/Mutex.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace pers {
+
+/**
+ * @brief Hash table whose lookups take no lock, for read-mostly caches
+ *
+ * Entries live in nodes referenced from an open-addressed array of atomic
+ * slots, linear probing on a caller-supplied 64-bit hash. visit() only
+ * loads atomics, so any number of threads can look up entries per draw
+ * without ever waiting for each other or for a writer. Writers (insert,
+ * removeIf, clear) are serialized by an internal mutex.
+ *
+ * Slots are only ever filled in place. Growing and removing build a new
+ * slot array and publish it, RCU style; the old array and removed nodes are
+ * freed once every reader that might still see them has left visit(). Each
+ * reader marks itself active on one of READER_STRIPES cache-line sized
+ * counters picked per thread, so readers on different threads never touch
+ * the same line; after a swap the writer waits for each counter to drain
+ * once. Lookups are a few probes, so that wait is short.
+ *
+ * Values are immutable once inserted. Visitors must not call writers on the
+ * same table, which would wait for the visiting thread itself.
+ *
+ * Nodes and slot arrays are accounted to Tag in CpuMemoryTracker; memory
+ * the values own themselves is not.
+ *
+ *   auto found = table.visit(hash, [&](const Entry& entry) {
+ *       return isEquivalent(entry.desc, desc) && (result = entry.object, true);
+ *   });
+ */
+template<typename Value, MemoryTag Tag = MemoryTag::General>
+class ConcurrentLookupTable {
+public:
+    static constexpr size_t READER_STRIPES = 64;
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    explicit ConcurrentLookupTable(size_t initialCapacity = 64)
+        : _table(new Table(roundCapacity(initialCapacity))) {}
+
+    // No reader may be inside visit()
+    ~ConcurrentLookupTable() {
+        Table* table = _table.load(std::memory_order_relaxed);
+        for (size_t i = 0; i <= table->mask; ++i) {
+            delete table->slots[i].load(std::memory_order_relaxed);
+        }
+        delete table;
+    }
+
+    ConcurrentLookupTable(const ConcurrentLookupTable&) = delete;
+    ConcurrentLookupTable& operator=(const ConcurrentLookupTable&) = delete;
+
+    /**
+     * @brief Call visitor on entries with this hash until it returns true
+     * @return true if the visitor accepted an entry
+     */
+    template<typename Visitor>
+    bool visit(uint64_t hash, Visitor&& visitor) const {
+        ReaderScope scope(_stripes[stripeIndex()]);
+        const Table* table = _table.load(std::memory_order_seq_cst);
+        for (size_t probe = 0, i = hash & table->mask; probe <= table->mask; ++probe, i = (i + 1) & table->mask) {
+            const Node* node = table->slots[i].load(std::memory_order_acquire);
+            if (!node) {
+                return false;
+            }
+            if (node->hash == hash && visitor(node->value)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Insert value unless an entry with this hash satisfies same
+     * @return The entry now in the table: value, or the one found equal
+     */
+    template<typename Same>
+    Value insert(uint64_t hash, Value value, const Same& same) {
+        auto guard = makeLockGuard(_writeMutex, PERS_SOURCE_LOC);
+        Table* table = _table.load(std::memory_order_relaxed);
+        for (size_t probe = 0, i = hash & table->mask; probe <= table->mask; ++probe, i = (i + 1) & table->mask) {
+            const Node* node = table->slots[i].load(std::memory_order_relaxed);
+            if (!node) {
+                break;
+            }
+            if (node->hash == hash && same(node->value)) {
+                return node->value;
+            }
+        }
+
+        // Keep the load factor at or below one half, so probe runs stay short
+        if ((_size + 1) * 2 > table->mask + 1) {
+            Table* grown = new Table((table->mask + 1) * 2);
+            for (size_t i = 0; i <= table->mask; ++i) {
+                if (Node* node = table->slots[i].load(std::memory_order_relaxed)) {
+                    place(*grown, node);
+                }
+            }
+            publish(grown);
+            table = grown;
+        }
+
+        Node* node = new Node(hash, std::move(value));
+        place(*table, node);
+        ++_size;
+        return node->value;
+    }
+
+    /**
+     * @brief Remove every entry for which remove returns true
+     * Removed values are destroyed once no reader can still see them.
+     * @return Number of entries removed
+     */
+    template<typename Predicate>
+    size_t removeIf(const Predicate& remove) {
+        auto guard = makeLockGuard(_writeMutex, PERS_SOURCE_LOC);
+        Table* table = _table.load(std::memory_order_relaxed);
+
+        std::unique_ptr<Node*[]> removed(new Node*[_size + 1]);
+        size_t removedCount = 0;
+        Table* rebuilt = new Table(table->mask + 1);
+        for (size_t i = 0; i <= table->mask; ++i) {
+            Node* node = table->slots[i].load(std::memory_order_relaxed);
+            if (!node) {
+                continue;
+            }
+            if (remove(static_cast<const Value&>(node->value))) {
+                removed[removedCount++] = node;
+            } else {
+                place(*rebuilt, node);
+            }
+        }
+
+        if (removedCount == 0) {
+            delete rebuilt;
+            return 0;
+        }
+
+        publish(rebuilt);
+        for (size_t i = 0; i < removedCount; ++i) {
+            delete removed[i];
+        }
+        _size -= removedCount;
+        return removedCount;
+    }
+
+    /**
+     * @brief Remove all entries
+     * @return Number of entries removed
+     */
+    size_t clear() {
+        return removeIf([](const Value&) { return true; });
+    }
+
+    // Entries at the time of the call
+    size_t size() const {
+        auto guard = makeLockGuard(_writeMutex, PERS_SOURCE_LOC);
+        return _size;
+    }
+
+private:
+    struct Node {
+        Node(uint64_t nodeHash, Value&& nodeValue)
+            : hash(nodeHash), value(std::move(nodeValue)) {
+            CpuMemoryTracker::allocate(Tag, sizeof(Node));
+        }
+        ~Node() { CpuMemoryTracker::release(Tag, sizeof(Node)); }
+
+        uint64_t hash;
+        Value value;
+    };
+
+    struct Table {
+        explicit Table(size_t capacity)
+            : mask(capacity - 1)
+            , slots(new std::atomic<Node*>[capacity]) {
+            for (size_t i = 0; i < capacity; ++i) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+            CpuMemoryTracker::allocate(Tag, bytes());
+        }
+        ~Table() { CpuMemoryTracker::release(Tag, bytes()); }
+
+        size_t bytes() const { return sizeof(Table) + (mask + 1) * sizeof(std::atomic<Node*>); }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Node*>[]> slots;
+    };
+
+    struct alignas(64) ReaderStripe {
+        std::atomic<uint32_t> active{0};
+    };
+
+    class ReaderScope {
+    public:
+        explicit ReaderScope(ReaderStripe& stripe) : _stripe(stripe) {
+            // seq_cst pairs with publish(): either the writer sees this reader, or the reader sees the new table
+            _stripe.active.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~ReaderScope() {
+            _stripe.active.fetch_sub(1, std::memory_order_release);
+        }
+
+        ReaderScope(const ReaderScope&) = delete;
+        ReaderScope& operator=(const ReaderScope&) = delete;
+
+    private:
+        ReaderStripe& _stripe;
+    };
+
+    static size_t roundCapacity(size_t capacity) {
+        size_t rounded = MIN_CAPACITY;
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    static size_t stripeIndex() {
+        static std::atomic<size_t> nextStripe{0};
+        thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % READER_STRIPES;
+        return stripe;
+    }
+
+    // Writer only; the release store makes the node's contents visible with it
+    static void place(Table& table, Node* node) {
+        size_t i = node->hash & table.mask;
+        while (table.slots[i].load(std::memory_order_relaxed)) {
+            i = (i + 1) & table.mask;
+        }
+        table.slots[i].store(node, std::memory_order_release);
+    }
+
+    // Swap in a new slot array and free the old one after a grace period
+    void publish(Table* table) {
+        Table* old = _table.exchange(table, std::memory_order_seq_cst);
+        for (const ReaderStripe& stripe : _stripes) {
+            while (stripe.active.load(std::memory_order_seq_cst) != 0) {
+                std::this_thread::yield();
+            }
+        }
+        delete old;
+    }
+
+    std::atomic<Table*> _table;
+    mutable ReaderStripe _stripes[READER_STRIPES];
+    mutable Mutex<false> _writeMutex{"ConcurrentLookupTable"};
+    size_t _size = 0;  // Guarded by _writeMutex
+};
+
+} // namespace pers
@@ -0,0 +1,22 @@
+#pragma once
+
+namespace pers {
+
+/**
+ * @brief Instruction set extensions usable on the running CPU
+ *
+ * AVX flags also require the OS to save the wider register state. Always
+ * false on non-x86 targets; NEON is part of the ARM64 baseline.
+ */
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool avx512 = false;
+};
+
+/**
+ * @brief Features detected once on first use
+ */
+const CpuFeatures& getCpuFeatures();
+
+} // namespace pers
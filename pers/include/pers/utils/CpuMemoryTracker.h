@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+enum class MemoryTag : uint32_t {
+    General,
+    Descriptors,  // Binding and layout descriptions held by caches
+    Caches,       // Cache tables and entries
+    Logging,      // Logger queues and spilled messages
+    Loaders,      // Asset data staged for upload
+    Count
+};
+
+/**
+ * @brief Process-wide accounting of CPU heap memory by subsystem
+ *
+ * Containers attribute their storage to a tag through TaggedAllocator;
+ * other owners call allocate() and release() with matching sizes. Live and
+ * peak bytes per tag are exported as Metrics gauges,
+ * pers_cpu_memory_bytes_<tag> and pers_cpu_memory_peak_bytes_<tag>, so
+ * slow growth of one subsystem shows up in any metrics scrape.
+ *
+ * Only tagged memory is counted; ProcessMemory reports the process total
+ * to compare against.
+ */
+class CpuMemoryTracker {
+public:
+    struct Stats {
+        std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> bytes{};
+        std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> peakBytes{};
+        std::array<uint64_t, static_cast<size_t>(MemoryTag::Count)> allocations{};  // Live allocations
+        uint64_t totalBytes = 0;
+    };
+
+    static void allocate(MemoryTag tag, size_t bytes);
+    static void release(MemoryTag tag, size_t bytes);
+
+    static uint64_t getUsage(MemoryTag tag);
+    static uint64_t getPeakUsage(MemoryTag tag);
+
+    static Stats getStats();
+    static std::string formatReport();
+
+    static const char* getTagName(MemoryTag tag);
+};
+
+/**
+ * @brief Standard allocator that accounts its storage to Tag
+ *
+ *   TaggedVector<BindingKey, MemoryTag::Descriptors> bindings;
+ */
+template<typename T, MemoryTag Tag>
+class TaggedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = TaggedAllocator<U, Tag>;
+    };
+
+    TaggedAllocator() noexcept = default;
+    template<typename U>
+    TaggedAllocator(const TaggedAllocator<U, Tag>&) noexcept {}
+
+    T* allocate(size_t count) {
+        T* pointer = std::allocator<T>().allocate(count);
+        CpuMemoryTracker::allocate(Tag, count * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        CpuMemoryTracker::release(Tag, count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    template<typename U>
+    bool operator==(const TaggedAllocator<U, Tag>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const TaggedAllocator<U, Tag>&) const noexcept { return false; }
+};
+
+template<typename T, MemoryTag Tag>
+using TaggedVector = std::vector<T, TaggedAllocator<T, Tag>>;
+
+} // namespace pers
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <version>
+
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+// When 0, labels are compiled out: assignments are dropped and every label
+// reads as empty. Set per build type through PERS_STRIP_RELEASE_LABELS.
+#ifndef PERS_DEBUG_LABELS
+#define PERS_DEBUG_LABELS 1
+#endif
+
+namespace pers {
+
+namespace detail {
+    struct DebugLabelEntry {
+        std::string text;
+        uint32_t id;
+    };
+}
+
+/**
+ * @brief Interned resource label
+ *
+ * Label text lives once in a process-wide string table and a DebugLabel is a
+ * pointer to its entry, so copying a descriptor or storing its label in a
+ * resource wrapper never allocates. Interning a label that already exists
+ * hashes the text without copying it. Entries are never freed; labels are
+ * meant for a bounded set of names, not per-frame formatted strings.
+ *
+ * Converts implicitly from string types and to const std::string&, so
+ * existing desc.debugName = "..." and getDebugName() code keeps working.
+ */
+class DebugLabel {
+public:
+    DebugLabel() = default;
+    DebugLabel(const char* text) : DebugLabel(std::string_view(text ? text : "")) {}
+    DebugLabel(const std::string& text) : DebugLabel(std::string_view(text)) {}
+#if PERS_DEBUG_LABELS
+    DebugLabel(std::string_view text) : _entry(intern(text)) {}
+#else
+    DebugLabel(std::string_view) {}
+#endif
+
+    /**
+     * @brief String table id, 0 for the empty label
+     */
+    uint32_t id() const { return _entry ? _entry->id : 0; }
+
+    bool empty() const { return _entry == nullptr; }
+    void clear() { _entry = nullptr; }
+
+    std::string_view view() const { return _entry ? std::string_view(_entry->text) : std::string_view(); }
+    const std::string& str() const { return _entry ? _entry->text : emptyString(); }
+    const char* c_str() const { return str().c_str(); }
+    const char* data() const { return str().data(); }
+    size_t size() const { return _entry ? _entry->text.size() : 0; }
+    size_t length() const { return size(); }
+
+    operator const std::string&() const { return str(); }
+
+    friend bool operator==(const DebugLabel& a, const DebugLabel& b) { return a._entry == b._entry; }
+    friend bool operator==(const DebugLabel& a, std::string_view b) { return a.view() == b; }
+    friend bool operator==(const DebugLabel& a, const std::string& b) { return a.view() == b; }
+    friend bool operator==(const DebugLabel& a, const char* b) { return a.view() == std::string_view(b ? b : ""); }
+
+    friend std::string operator+(const DebugLabel& a, std::string_view b) {
+        std::string result(a.view());
+        result.append(b);
+        return result;
+    }
+
+    friend std::string operator+(std::string_view a, const DebugLabel& b) {
+        std::string result(a);
+        result.append(b.view());
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& out, const DebugLabel& label) {
+        return out << label.view();
+    }
+
+    /**
+     * @brief Number of distinct labels interned so far
+     */
+    static size_t getInternedCount();
+
+private:
+    static const detail::DebugLabelEntry* intern(std::string_view text);
+    static const std::string& emptyString();
+
+    const detail::DebugLabelEntry* _entry = nullptr;
+};
+
+} // namespace pers
+
+#if defined(__cpp_lib_format)
+template<>
+struct std::formatter<pers::DebugLabel> : std::formatter<std::string_view> {
+    auto format(const pers::DebugLabel& label, std::format_context& context) const {
+        return std::formatter<std::string_view>::format(label.view(), context);
+    }
+};
+#endif
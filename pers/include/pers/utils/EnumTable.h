@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace pers {
+
+/**
+ * One entry of an enum translation list
+ */
+template<typename From, typename To>
+struct EnumMapping {
+    From from;
+    To to;
+};
+
+/**
+ * Dense lookup table from a zero-based enum to another type
+ *
+ * Built at compile time from a list of mappings so translation is a bounds
+ * check and an array load. Pair it with coversEnum() in a static_assert so
+ * adding an enumerator without a mapping fails the build:
+ *
+ *     constexpr EnumMapping<CullMode, WGPUCullMode> CULL_MODES[] = {...};
+ *     static_assert(coversEnum<3>(CULL_MODES), "CullMode mapping is incomplete");
+ *     constexpr auto CULL_MODE_TABLE = EnumTable<CullMode, WGPUCullMode, 3>(CULL_MODES, WGPUCullMode_None);
+ */
+template<typename From, typename To, size_t Count>
+class EnumTable {
+public:
+    template<size_t N>
+    constexpr EnumTable(const EnumMapping<From, To> (&mappings)[N], To fallback)
+        : _fallback(fallback) {
+        for (auto& value : _values) {
+            value = fallback;
+        }
+        for (const auto& mapping : mappings) {
+            _values[static_cast<size_t>(mapping.from)] = mapping.to;
+        }
+    }
+
+    constexpr To operator[](From value) const {
+        const auto index = static_cast<size_t>(value);
+        return index < Count ? _values[index] : _fallback;
+    }
+
+    constexpr bool contains(From value) const { return static_cast<size_t>(value) < Count; }
+
+private:
+    std::array<To, Count> _values{};
+    To _fallback;
+};
+
+/**
+ * Inverse of EnumTable for enums with a bounded native range, e.g. WGPU enums
+ * without their vendor extension blocks. First mapping wins for duplicates.
+ */
+template<typename From, typename To, size_t Count>
+class ReverseEnumTable {
+public:
+    template<size_t N>
+    constexpr ReverseEnumTable(const EnumMapping<To, From> (&mappings)[N], To fallback)
+        : _fallback(fallback) {
+        std::array<bool, Count> assigned{};
+        for (auto& value : _values) {
+            value = fallback;
+        }
+        for (const auto& mapping : mappings) {
+            const auto index = static_cast<size_t>(mapping.to);
+            if (index < Count && !assigned[index]) {
+                _values[index] = mapping.from;
+                assigned[index] = true;
+            }
+        }
+    }
+
+    constexpr To operator[](From value) const {
+        const auto index = static_cast<size_t>(value);
+        return index < Count ? _values[index] : _fallback;
+    }
+
+private:
+    std::array<To, Count> _values{};
+    To _fallback;
+};
+
+/**
+ * True when every enumerator in [0, Count) is mapped exactly once
+ */
+template<size_t Count, typename From, typename To, size_t N>
+constexpr bool coversEnum(const EnumMapping<From, To> (&mappings)[N]) {
+    std::array<uint32_t, Count> seen{};
+    for (const auto& mapping : mappings) {
+        const auto index = static_cast<size_t>(mapping.from);
+        if (index >= Count || seen[index]++ != 0) {
+            return false;
+        }
+    }
+    for (uint32_t count : seen) {
+        if (count != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Translate a flag set bit by bit through a list of (flag, native flag) pairs
+ */
+template<typename Native, typename Flags, size_t N>
+constexpr Native translateFlags(Flags flags, const EnumMapping<Flags, Native> (&mappings)[N]) {
+    using FlagBits = std::underlying_type_t<Flags>;
+    uint64_t result = 0;
+    for (const auto& mapping : mappings) {
+        if ((static_cast<FlagBits>(flags) & static_cast<FlagBits>(mapping.from)) != 0) {
+            result |= static_cast<uint64_t>(mapping.to);
+        }
+    }
+    return static_cast<Native>(result);
+}
+
+} // namespace pers
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "pers/utils/HugePages.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief Thread-local bump allocator for transient per-frame CPU data
+ *
+ * Native descriptor arrays, handle lists and other scratch that only lives
+ * for one call or one frame come from here instead of the heap. Memory is
+ * handed out linearly from large blocks and never freed individually.
+ *
+ * Two ways to give memory back:
+ *  - ScratchScope rewinds to where it started when it goes out of scope,
+ *    so nested backend calls can use the arena safely.
+ *  - beginFrame() marks a frame boundary; each thread's arena resets the
+ *    next time it is fetched outside any ScratchScope.
+ *
+ * After a frame that spilled into several blocks, the reset replaces them
+ * with one block of the combined size, so steady-state frames allocate nothing.
+ * Blocks that large come from HugePageBuffer under the HugePages policy.
+ * Only trivially destructible types may live in the arena.
+ */
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    struct Marker {
+        size_t block = 0;
+        size_t offset = 0;
+    };
+
+    /**
+     * @brief Rewinds the calling thread's arena on destruction
+     */
+    class ScratchScope {
+    public:
+        ScratchScope();
+        ~ScratchScope();
+
+        ScratchScope(const ScratchScope&) = delete;
+        ScratchScope& operator=(const ScratchScope&) = delete;
+
+        FrameArena& arena() const { return _arena; }
+
+        template<typename T>
+        std::span<T> allocateArray(size_t count) { return _arena.allocateArray<T>(count); }
+
+    private:
+        FrameArena& _arena;
+        Marker _marker;
+    };
+
+    explicit FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~FrameArena() = default;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Arena of the calling thread, reset first if a frame boundary passed
+     */
+    static FrameArena& current();
+
+    /**
+     * @brief Mark a frame boundary for every thread's arena
+     * Call once per frame, after the frame's CPU work has been handed off.
+     */
+    static void beginFrame();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Value-initialized array in the arena
+     */
+    template<typename T>
+    std::span<T> allocateArray(size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+        if (count == 0) {
+            return {};
+        }
+        T* data = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0; i < count; ++i) {
+            new (data + i) T{};
+        }
+        return {data, count};
+    }
+
+    Marker mark() const { return {_block, _offset}; }
+    void rewind(const Marker& marker);
+
+    /**
+     * @brief Release every allocation, coalescing spilled blocks into one
+     */
+    void reset();
+
+    size_t getCapacity() const;
+    size_t getPeakBytes() const { return _peakBytes; }
+
+private:
+    struct Block {
+        HugePageBuffer data;  // Huge pages once a block grows past HugePages::getPageSize()
+        size_t size = 0;
+    };
+
+    static void allocateBlock(Block& block);
+    size_t getUsedBytes() const;
+
+    static std::atomic<uint64_t> s_frameEpoch;
+
+    size_t _blockSize;
+    std::vector<Block> _blocks;
+    size_t _block = 0;
+    size_t _offset = 0;
+    size_t _peakBytes = 0;    // Largest getUsedBytes() since the last reset
+    uint32_t _scopeDepth = 0;
+    uint64_t _epoch = 0;
+};
+
+} // namespace pers
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace pers {
+
+/**
+ * Incremental 64-bit FNV-1a hasher
+ *
+ * Stable across runs and platforms of the same endianness, so results can be
+ * persisted. Feed structs field by field so padding never reaches the hash.
+ */
+class Fnv1aHasher {
+public:
+    static constexpr uint64_t OFFSET_BASIS = 14695981039346656037ull;
+    static constexpr uint64_t PRIME = 1099511628211ull;
+
+    void addBytes(const void* data, size_t size) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            _hash ^= bytes[i];
+            _hash *= PRIME;
+        }
+    }
+
+    template<typename T>
+    void add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable fields can be hashed");
+        addBytes(&value, sizeof(T));
+    }
+
+    // Length-prefixed so ("ab", "c") and ("a", "bc") hash differently
+    void addString(std::string_view value) {
+        add(static_cast<uint64_t>(value.size()));
+        addBytes(value.data(), value.size());
+    }
+
+    uint64_t get() const { return _hash; }
+
+private:
+    uint64_t _hash = OFFSET_BASIS;
+};
+
+inline uint64_t hashString(std::string_view value) {
+    Fnv1aHasher hasher;
+    hasher.addBytes(value.data(), value.size());
+    return hasher.get();
+}
+
+} // namespace pers
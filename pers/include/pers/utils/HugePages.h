@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pers {
+
+/**
+ * @brief How large CPU buffers are backed
+ *
+ * - Off: regular pages everywhere.
+ * - Transparent: 2 MiB aligned anonymous memory advised with MADV_HUGEPAGE
+ *   on Linux, so the kernel collapses it into huge pages when it can.
+ *   Needs no setup; other platforms use regular pages.
+ * - Explicit: MAP_HUGETLB on Linux (needs a reserved hugetlbfs pool) or
+ *   MEM_LARGE_PAGE on Windows (needs SeLockMemoryPrivilege), falling back
+ *   to Transparent when the pages cannot be had.
+ */
+enum class HugePageMode {
+    Off,
+    Transparent,
+    Explicit
+};
+
+/**
+ * @brief Process-wide huge page policy for FrameArena blocks, shadow copies
+ * and file mappings
+ *
+ * Only regions of at least getPageSize() bytes are affected; smaller ones
+ * come from the heap as before. Change the mode at startup, before the
+ * buffers it should apply to are created.
+ */
+class HugePages {
+public:
+    static void setMode(HugePageMode mode);
+    static HugePageMode getMode();
+
+    /**
+     * @brief Huge page size of the platform, 0 if it has none
+     */
+    static size_t getPageSize();
+
+    /**
+     * @brief Ask the kernel to back an existing mapping with huge pages
+     * Used for read-only file mappings, which Linux can collapse when built
+     * with CONFIG_READ_ONLY_THP_FOR_FS. A no-op elsewhere or when too small.
+     * @return true if the advice was accepted
+     */
+    static bool adviseRange(const void* data, size_t size);
+
+    static const char* getModeName(HugePageMode mode);
+};
+
+/**
+ * @brief Zero-initialized CPU buffer that uses huge pages when it is large enough
+ *
+ * allocate() picks the backing from HugePages::getMode() and falls back
+ * quietly, so it only fails when no memory is left. Move-only.
+ */
+class HugePageBuffer {
+public:
+    HugePageBuffer() = default;
+    ~HugePageBuffer();
+
+    HugePageBuffer(HugePageBuffer&& other) noexcept;
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept;
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+    /**
+     * @brief Allocate size zeroed bytes, releasing any previous allocation
+     */
+    bool allocate(size_t size);
+    void release();
+
+    uint8_t* data() { return _data; }
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * @brief true if the memory was set up for huge pages, explicitly or advised
+     */
+    bool isHugePageBacked() const { return _backing == Backing::Advised || _backing == Backing::Explicit; }
+
+private:
+    enum class Backing {
+        None,
+        Heap,      // operator new
+        Mapped,    // Anonymous mapping with regular pages
+        Advised,   // Anonymous mapping advised for transparent huge pages
+        Explicit   // MAP_HUGETLB or MEM_LARGE_PAGE
+    };
+
+    uint8_t* _data = nullptr;
+    size_t _size = 0;
+    size_t _mappedSize = 0;  // Length to unmap, rounded up to the page size
+    Backing _backing = Backing::None;
+};
+
+} // namespace pers
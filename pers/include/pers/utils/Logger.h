@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -9,22 +10,64 @@
 #include <thread>
 #include <atomic>
 #include <functional>
-#include <map>
+#include <array>
 #include <fstream>
+#include <string_view>
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
 #include "pers/utils/SourceLocation.h"
 #include "pers/utils/Mutex.h"
 
+// Lowest level compiled in, as a LogLevel value. Log macros below it expand
+// to nothing that survives compilation; e.g. -DPERS_LOG_MIN_LEVEL=2 strips
+// Trace and Debug from release builds.
+#ifndef PERS_LOG_MIN_LEVEL
+#define PERS_LOG_MIN_LEVEL 0
+#endif
+
 namespace pers {
 
+// Message and format arguments are only evaluated when the level is
+// compiled in and enabled at runtime; a disabled call costs one atomic load
+#define PERS_LOG_IMPL(level, category, message) \
+    do { \
+        if constexpr ((level) >= pers::COMPILED_MIN_LOG_LEVEL) { \
+            static pers::Logger& persLogger_ = pers::Logger::Instance(); \
+            if (persLogger_.ShouldLog(level)) { \
+                persLogger_.Log(level, category, message, PERS_SOURCE_LOC); \
+            } \
+        } \
+    } while (0)
+
+// std::format-style: LOG_DEBUG_FMT("Category", "size={} name={}", size, name)
+#define PERS_LOG_FMT_IMPL(level, category, ...) \
+    do { \
+        if constexpr ((level) >= pers::COMPILED_MIN_LOG_LEVEL) { \
+            static pers::Logger& persLogger_ = pers::Logger::Instance(); \
+            if (persLogger_.ShouldLog(level)) { \
+                persLogger_.Log(level, category, pers::formatLogMessage(__VA_ARGS__), PERS_SOURCE_LOC); \
+            } \
+        } \
+    } while (0)
+
 // Logger macros for easy usage
-#define LOG_TRACE(category, message) pers::Logger::Instance().Log(pers::LogLevel::Trace, category, message, PERS_SOURCE_LOC)
-#define LOG_DEBUG(category, message) pers::Logger::Instance().Log(pers::LogLevel::Debug, category, message, PERS_SOURCE_LOC)
-#define LOG_INFO(category, message) pers::Logger::Instance().Log(pers::LogLevel::Info, category, message, PERS_SOURCE_LOC)
-#define LOG_WARNING(category, message) pers::Logger::Instance().Log(pers::LogLevel::Warning, category, message, PERS_SOURCE_LOC)
-#define LOG_ERROR(category, message) pers::Logger::Instance().Log(pers::LogLevel::Error, category, message, PERS_SOURCE_LOC)
-#define LOG_CRITICAL(category, message) pers::Logger::Instance().Log(pers::LogLevel::Critical, category, message, PERS_SOURCE_LOC)
-#define LOG_TODO_SOMEDAY(category, message) pers::Logger::Instance().Log(pers::LogLevel::TodoSomeday, category, message, PERS_SOURCE_LOC)
-#define LOG_TODO_OR_DIE(category, message) pers::Logger::Instance().Log(pers::LogLevel::TodoOrDie, category, message, PERS_SOURCE_LOC)
+#define LOG_TRACE(category, message) PERS_LOG_IMPL(pers::LogLevel::Trace, category, message)
+#define LOG_DEBUG(category, message) PERS_LOG_IMPL(pers::LogLevel::Debug, category, message)
+#define LOG_INFO(category, message) PERS_LOG_IMPL(pers::LogLevel::Info, category, message)
+#define LOG_WARNING(category, message) PERS_LOG_IMPL(pers::LogLevel::Warning, category, message)
+#define LOG_ERROR(category, message) PERS_LOG_IMPL(pers::LogLevel::Error, category, message)
+#define LOG_CRITICAL(category, message) PERS_LOG_IMPL(pers::LogLevel::Critical, category, message)
+#define LOG_TODO_SOMEDAY(category, message) PERS_LOG_IMPL(pers::LogLevel::TodoSomeday, category, message)
+#define LOG_TODO_OR_DIE(category, message) PERS_LOG_IMPL(pers::LogLevel::TodoOrDie, category, message)
+
+#define LOG_TRACE_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARNING_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Warning, category, __VA_ARGS__)
+#define LOG_ERROR_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Error, category, __VA_ARGS__)
+#define LOG_CRITICAL_FMT(category, ...) PERS_LOG_FMT_IMPL(pers::LogLevel::Critical, category, __VA_ARGS__)
 
 // Compatibility macros
 #define TODO_OR_DIE(functionName, todoDescription) LOG_TODO_OR_DIE(functionName, todoDescription)
@@ -41,6 +84,56 @@ enum class LogLevel {
     Critical = 7
 };
 
+constexpr size_t LOG_LEVEL_COUNT = static_cast<size_t>(LogLevel::Critical) + 1;
+
+constexpr LogLevel COMPILED_MIN_LOG_LEVEL = static_cast<LogLevel>(PERS_LOG_MIN_LEVEL);
+
+/**
+ * @brief Format a log message with {} placeholders
+ *
+ * Uses std::format where the standard library provides it. Otherwise each {}
+ * takes the next argument through operator<<, {{ and }} are literal braces,
+ * and of the format specs only a trailing x (hex) is honoured.
+ */
+template<typename... Args>
+std::string formatLogMessage(std::string_view format, const Args&... args) {
+#if defined(__cpp_lib_format)
+    return std::vformat(format, std::make_format_args(args...));
+#else
+    std::ostringstream out;
+    size_t argIndex = 0;
+    auto writeArg = [&](size_t index) {
+        size_t current = 0;
+        ((current++ == index ? static_cast<void>(out << args) : static_cast<void>(0)), ...);
+    };
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+            out << c;
+            ++i;
+        } else if (c == '{') {
+            size_t close = format.find('}', i);
+            if (close == std::string_view::npos) {
+                out << format.substr(i);
+                break;
+            }
+            bool hex = close > i + 1 && format[close - 1] == 'x';
+            if (hex) {
+                out << std::hex;
+            }
+            writeArg(argIndex++);
+            if (hex) {
+                out << std::dec;
+            }
+            i = close;
+        } else {
+            out << c;
+        }
+    }
+    return out.str();
+#endif
+}
+
 struct LogEntry {
     LogLevel level;
     std::chrono::system_clock::time_point timestamp;
@@ -115,6 +208,29 @@ public:
     
     void SetCategoryFilter(const std::string& pattern);
     
+    // Minimum level and per-level enablement in one load, without taking the logger lock
+    bool ShouldLog(LogLevel level) const {
+        return (_activeLevels.load(std::memory_order_relaxed) & LevelBit(level)) != 0;
+    }
+    
+    /**
+     * @brief Route log entries through a background writer thread
+     *
+     * Log() copies the entry into a lock-free ring and returns; the writer
+     * drains it in batches and flushes outputs once per batch. Callbacks still
+     * run on the logging thread. When the ring is full, Log() waits for a free
+     * slot rather than dropping the entry. Flush() waits until every entry
+     * logged before it has been written.
+     *
+     * @param capacity Ring size in entries, rounded up to a power of two.
+     *                 Only used the first time async mode is enabled.
+     */
+    void EnableAsync(size_t capacity = 1024);
+    
+    // Drain pending entries, stop the writer and return to synchronous writes
+    void DisableAsync();
+    bool IsAsync() const;
+    
     void Log(LogLevel level,
              const std::string& category,
              const std::string& message,
@@ -125,6 +241,9 @@ public:
                    const LogSource& source,
                    const char* format,
                    Args... args) {
+        if (!ShouldLog(level)) {
+            return;
+        }
         char buffer[4096];
         snprintf(buffer, sizeof(buffer), format, args...);
         Log(level, category, buffer, source);
@@ -138,16 +257,31 @@ private:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
     
+    class AsyncWriter;
+    
     void LogInternal(const LogEntry& entry, const LogSource& source);
     void InvokeCallbacks(const LogEntry& entry, const LogSource& source, bool& skipLogging);
+    // Caller holds _mutex
+    void WriteToOutputs(const LogEntry& entry);
+    void FlushOutputs();
+    // Caller holds _mutex
+    void UpdateActiveLevels();
+    
+    static uint32_t LevelBit(LogLevel level) { return 1u << static_cast<uint32_t>(level); }
     
     // Member variables
     std::vector<std::shared_ptr<ILogOutput>> _outputs;
     std::atomic<LogLevel> _minLevel;
     std::string _categoryFilter;
-    std::map<LogLevel, bool> _enabledLevels;
-    std::map<LogLevel, LogCallback> _callbacks;
+    std::atomic<uint32_t> _enabledLevels;    // One bit per LogLevel, as set by SetLogLevelEnabled
+    std::atomic<uint32_t> _activeLevels;     // _enabledLevels restricted to _minLevel and above
+    std::atomic<uint32_t> _callbackLevels;   // Levels with a callback, checked before taking _mutex
+    std::array<LogCallback, LOG_LEVEL_COUNT> _callbacks;
     mutable Mutex<false> _mutex;
+    
+    std::unique_ptr<AsyncWriter> _asyncWriter;   // Kept until shutdown once created
+    std::atomic<AsyncWriter*> _activeWriter;     // Null in synchronous mode
+    Mutex<false> _asyncMutex;                    // Serializes EnableAsync/DisableAsync
 };
 
 class LogStream {
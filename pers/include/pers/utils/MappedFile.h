@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pers {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Pages are loaded on first touch, so opening is cheap however large the
+ * file is. The contents stay valid until close() or destruction. Move-only.
+ * Large mappings are advised for huge pages under the HugePages policy.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file, closing any previous mapping
+     * @return false if the file cannot be opened or is empty
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return _data != nullptr; }
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+#if defined(_WIN32)
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif
+};
+
+} // namespace pers
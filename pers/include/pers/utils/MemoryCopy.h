@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace pers {
+
+/**
+ * Copy kernels for bulk transfers into and out of mapped GPU memory
+ *
+ * Mapped upload memory is often write-combined: plain memcpy pulls every
+ * destination line into the cache hierarchy for nothing and evicts the
+ * working set on large uploads. The streaming kernels write full lines with
+ * non-temporal stores and read mapped memory with streaming loads. Copies
+ * below STREAMING_COPY_THRESHOLD stay on memcpy, where the cache helps more
+ * than it hurts.
+ *
+ * The kernel is picked once from the CPU's features: AVX-512 or AVX2 (SSE2
+ * as the x86-64 baseline) on x86, NEON on ARM64. setCopyKernel() overrides
+ * it, mainly for benchmarks.
+ */
+enum class CopyKernel : uint8_t {
+    Memcpy = 0,
+    SSE2,
+    AVX2,
+    AVX512,
+    NEON
+};
+
+constexpr size_t STREAMING_COPY_THRESHOLD = 256 * 1024;
+
+/**
+ * @brief Copy into mapped (possibly write-combined) memory
+ * Completes with a store fence, so the data is visible before unmap or submit.
+ */
+void copyToMappedMemory(void* dst, const void* src, size_t size);
+
+/**
+ * @brief Copy out of mapped read-back memory
+ */
+void copyFromMappedMemory(void* dst, const void* src, size_t size);
+
+/**
+ * @brief Kernel used for copies at or above STREAMING_COPY_THRESHOLD
+ */
+CopyKernel getCopyKernel();
+
+/**
+ * @brief Force a kernel
+ * @return false if the CPU does not support it; the active kernel is unchanged
+ */
+bool setCopyKernel(CopyKernel kernel);
+
+bool isCopyKernelSupported(CopyKernel kernel);
+
+const char* getCopyKernelName(CopyKernel kernel);
+
+} // namespace pers
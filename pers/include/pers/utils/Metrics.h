@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+namespace detail {
+class MetricsRegistry;
+}
+
+enum class MetricType {
+    Counter,   // Monotonic total
+    Gauge,     // Current level, may go down
+    Histogram
+};
+
+/**
+ * @brief Counter or gauge summed over per-thread slots
+ *
+ * add() touches only the calling thread's slot with a plain relaxed
+ * load/store, so it never contends. Look metrics up once and keep the
+ * reference:
+ *
+ *   static MetricCounter& draws = Metrics::counter("pers_draw_calls_total", "Draw calls recorded");
+ *   draws.add(drawCount);
+ */
+class MetricCounter {
+public:
+    void add(int64_t delta);
+    void increment() { add(1); }
+    void decrement() { add(-1); }
+
+    // Sum over all threads, including threads that have exited
+    int64_t value() const;
+
+    const std::string& getName() const { return _name; }
+    const std::string& getHelp() const { return _help; }
+    MetricType getType() const { return _type; }
+
+private:
+    friend class detail::MetricsRegistry;
+    MetricCounter(uint32_t slot, std::string name, std::string help, MetricType type)
+        : _slot(slot), _name(std::move(name)), _help(std::move(help)), _type(type) {}
+
+    uint32_t _slot;
+    std::string _name;
+    std::string _help;
+    MetricType _type;
+};
+
+/**
+ * @brief Bucketed distribution, e.g. frame times in seconds
+ * Meant for a few observations per frame; buckets are shared atomics.
+ */
+class MetricHistogram {
+public:
+    void observe(double value);
+
+    // Upper bounds in ascending order; values above the last bound fall into +Inf
+    const std::vector<double>& getBounds() const { return _bounds; }
+    // Non-cumulative count per bound plus the +Inf bucket
+    std::vector<uint64_t> getBucketCounts() const;
+    uint64_t getCount() const { return _count.load(std::memory_order_relaxed); }
+    double getSum() const { return _sum.load(std::memory_order_relaxed); }
+
+    const std::string& getName() const { return _name; }
+    const std::string& getHelp() const { return _help; }
+
+private:
+    friend class detail::MetricsRegistry;
+    MetricHistogram(std::string name, std::string help, std::vector<double> bounds);
+
+    std::string _name;
+    std::string _help;
+    std::vector<double> _bounds;
+    std::unique_ptr<std::atomic<uint64_t>[]> _buckets;
+    std::atomic<uint64_t> _count{0};
+    std::atomic<double> _sum{0.0};
+};
+
+/**
+ * @brief One metric's value at collection time
+ */
+struct MetricSample {
+    std::string name;
+    std::string help;
+    MetricType type = MetricType::Counter;
+    int64_t value = 0;                   // Counter and gauge
+    std::vector<double> bounds;          // Histogram only
+    std::vector<uint64_t> bucketCounts;  // Histogram only, bounds.size() + 1 entries
+    uint64_t count = 0;                  // Histogram only
+    double sum = 0.0;                    // Histogram only
+};
+
+/**
+ * @brief Process-wide registry of engine metrics
+ *
+ * Metrics are created on first lookup and live for the whole process.
+ * collect() is meant to run about once per frame or per scrape; rates such
+ * as submits per frame come from dividing pers_queue_submits_total by
+ * pers_frames_total.
+ */
+class Metrics {
+public:
+    // Counter and gauge slots per thread; later registrations share one overflow slot
+    static constexpr uint32_t MAX_COUNTERS = 256;
+
+    static MetricCounter& counter(const std::string& name, const std::string& help = "");
+    static MetricCounter& gauge(const std::string& name, const std::string& help = "");
+
+    /**
+     * @brief Find or create a histogram
+     * @param bounds Bucket upper bounds, used only by the first registration
+     */
+    static MetricHistogram& histogram(const std::string& name, const std::vector<double>& bounds,
+                                      const std::string& help = "");
+
+    // Every registered metric, sorted by name
+    static std::vector<MetricSample> collect();
+
+    // Prometheus text exposition format
+    static std::string formatPrometheus();
+
+    /**
+     * @brief Write formatPrometheus() for a textfile collector
+     * Written to a temporary file and renamed, so scrapers never see a partial file.
+     * @return False if the file cannot be written
+     */
+    static bool writePrometheus(const std::string& filename);
+};
+
+} // namespace pers
@@ -2,11 +2,23 @@
 
 #include "pers/utils/SourceLocation.h"
 #include <mutex>
+#include <shared_mutex>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
 #include <iostream>
 #include <iomanip>
 #include <thread>
 #include <atomic>
+#include <cstdint>
 #include <string>
+#include <vector>
+
+// Non-debug Mutex records wait time, hold time and contention per mutex name
+// and call site instead of only wrapping std::mutex. See MutexProfiler.
+#ifndef PERS_MUTEX_PROFILING
+#define PERS_MUTEX_PROFILING 0
+#endif
 
 namespace pers {
 
@@ -29,6 +41,100 @@ namespace detail {
     }
 }
 
+namespace detail {
+    struct MutexSite;
+}
+
+/**
+ * @brief Totals for one mutex name and lock call site
+ */
+struct MutexSiteStats {
+    std::string name;
+    std::string file;        // Empty for locks taken without a LogSource, e.g. through std::lock_guard
+    int line = 0;
+    uint64_t lockCount = 0;
+    uint64_t contentionCount = 0;  // Locks that found the mutex held
+    uint64_t waitNanoseconds = 0;
+    uint64_t maxWaitNanoseconds = 0;
+    uint64_t holdNanoseconds = 0;
+};
+
+/**
+ * @brief Lock statistics gathered by Mutex<false> when PERS_MUTEX_PROFILING is set
+ *
+ * Each thread counts into its own table, so recording takes no lock and
+ * shares no cache lines with other threads. collect() sums the tables of all
+ * threads, including ones that have exited. Without PERS_MUTEX_PROFILING
+ * nothing is recorded and collect() returns an empty list.
+ */
+class MutexProfiler {
+public:
+    // Per name and call site across all threads, highest total wait first
+    static std::vector<MutexSiteStats> collect();
+
+    // Text table of the top rows of collect()
+    static std::string formatReport(size_t maxRows = 20);
+
+    // Zero all counters; sites stay registered
+    static void reset();
+
+    // Recording hooks for Mutex<false>
+    static detail::MutexSite* site(const char* name, const LogSource& loc);
+    static uint64_t now();
+    static void recordLock(detail::MutexSite* site, uint64_t waitNanoseconds, bool contended);
+    static void recordHold(detail::MutexSite* site, uint64_t holdNanoseconds);
+};
+
+#if PERS_MUTEX_PROFILING
+// Template specialization for non-debug mode, profiling build
+template<>
+class Mutex<false> {
+private:
+    mutable std::mutex _mutex;
+    const char* _name;
+    // Written by the owning thread only
+    detail::MutexSite* _holder = nullptr;
+    uint64_t _acquiredAt = 0;
+
+    void acquired(detail::MutexSite* site, uint64_t waitNanoseconds, bool contended) {
+        MutexProfiler::recordLock(site, waitNanoseconds, contended);
+        _holder = site;
+        _acquiredAt = MutexProfiler::now();
+    }
+
+public:
+    explicit Mutex(const char* name = nullptr)
+        : _name(name ? name : "unnamed") {}
+
+    void lock(const LogSource& loc) {
+        detail::MutexSite* site = MutexProfiler::site(_name, loc);
+        if (_mutex.try_lock()) {
+            acquired(site, 0, false);
+            return;
+        }
+        uint64_t start = MutexProfiler::now();
+        _mutex.lock();
+        acquired(site, MutexProfiler::now() - start, true);
+    }
+
+    void unlock(const LogSource&) {
+        MutexProfiler::recordHold(_holder, MutexProfiler::now() - _acquiredAt);
+        _mutex.unlock();
+    }
+
+    bool tryLock(const LogSource& loc) {
+        if (!_mutex.try_lock()) {
+            return false;
+        }
+        acquired(MutexProfiler::site(_name, loc), 0, false);
+        return true;
+    }
+
+    void lock() { lock({nullptr, 0, nullptr}); }
+    void unlock() { unlock({nullptr, 0, nullptr}); }
+    bool try_lock() { return tryLock({nullptr, 0, nullptr}); }
+};
+#else
 // Template specialization for non-debug mode (just wraps std::mutex)
 template<>
 class Mutex<false> {
@@ -47,6 +153,7 @@ public:
     void unlock(const LogSource&) { _mutex.unlock(); }
     bool tryLock(const LogSource&) { return _mutex.try_lock(); }
 };
+#endif
 
 // Template specialization for debug mode (includes logging)
 template<>
@@ -186,14 +293,10 @@ private:
     LogSource _loc;
     
 public:
-    // Constructor for debug mode with location tracking
+    // Constructor with location tracking, used by debug and profiling builds
     LockGuard(Mutex<DebuggingEnabled>& mutex, const LogSource& loc) 
         : _mutex(mutex), _loc(loc) {
-        if constexpr (DebuggingEnabled) {
-            _mutex.lock(_loc);
-        } else {
-            _mutex.lock();
-        }
+        _mutex.lock(_loc);
     }
     
     // Constructor for non-debug mode or when no location is provided
@@ -203,11 +306,7 @@ public:
     }
     
     ~LockGuard() {
-        if constexpr (DebuggingEnabled) {
-            _mutex.unlock(_loc);
-        } else {
-            _mutex.unlock();
-        }
+        _mutex.unlock(_loc);
     }
     
     // Delete copy operations
@@ -221,4 +320,246 @@ inline auto makeLockGuard(Mutex<DebuggingEnabled>& mutex, const LogSource& loc)
     return LockGuard<DebuggingEnabled>(mutex, loc);
 }
 
+/**
+ * @brief Reader-writer mutex for read-mostly state such as lookup caches
+ *
+ * Any number of threads may hold it shared, or one thread exclusively.
+ * Takes a name and LogSource like Mutex; with PERS_MUTEX_PROFILING both
+ * modes count locks, contention and wait time in MutexProfiler, told apart
+ * by call site. Hold time is recorded for exclusive locks only, since
+ * several readers overlap. Also satisfies
+ * the standard SharedLockable requirements, so std::shared_lock works.
+ */
+class SharedMutex {
+private:
+    mutable std::shared_mutex _mutex;
+#if PERS_MUTEX_PROFILING
+    const char* _name;
+    // Written by the exclusive owner only
+    detail::MutexSite* _holder = nullptr;
+    uint64_t _acquiredAt = 0;
+#endif
+
+public:
+#if PERS_MUTEX_PROFILING
+    explicit SharedMutex(const char* name = nullptr)
+        : _name(name ? name : "unnamed") {}
+
+    void lock(const LogSource& loc) {
+        detail::MutexSite* site = MutexProfiler::site(_name, loc);
+        uint64_t wait = 0;
+        bool contended = !_mutex.try_lock();
+        if (contended) {
+            uint64_t start = MutexProfiler::now();
+            _mutex.lock();
+            wait = MutexProfiler::now() - start;
+        }
+        MutexProfiler::recordLock(site, wait, contended);
+        _holder = site;
+        _acquiredAt = MutexProfiler::now();
+    }
+
+    void unlock(const LogSource&) {
+        MutexProfiler::recordHold(_holder, MutexProfiler::now() - _acquiredAt);
+        _mutex.unlock();
+    }
+
+    bool tryLock(const LogSource& loc) {
+        if (!_mutex.try_lock()) {
+            return false;
+        }
+        MutexProfiler::recordLock(_holder = MutexProfiler::site(_name, loc), 0, false);
+        _acquiredAt = MutexProfiler::now();
+        return true;
+    }
+
+    void lockShared(const LogSource& loc) {
+        detail::MutexSite* site = MutexProfiler::site(_name, loc);
+        if (_mutex.try_lock_shared()) {
+            MutexProfiler::recordLock(site, 0, false);
+            return;
+        }
+        uint64_t start = MutexProfiler::now();
+        _mutex.lock_shared();
+        MutexProfiler::recordLock(site, MutexProfiler::now() - start, true);
+    }
+
+    void unlockShared(const LogSource&) { _mutex.unlock_shared(); }
+
+    bool tryLockShared(const LogSource& loc) {
+        if (!_mutex.try_lock_shared()) {
+            return false;
+        }
+        MutexProfiler::recordLock(MutexProfiler::site(_name, loc), 0, false);
+        return true;
+    }
+#else
+    explicit SharedMutex(const char* /*name*/ = nullptr) {}
+
+    void lock(const LogSource&) { _mutex.lock(); }
+    void unlock(const LogSource&) { _mutex.unlock(); }
+    bool tryLock(const LogSource&) { return _mutex.try_lock(); }
+    void lockShared(const LogSource&) { _mutex.lock_shared(); }
+    void unlockShared(const LogSource&) { _mutex.unlock_shared(); }
+    bool tryLockShared(const LogSource&) { return _mutex.try_lock_shared(); }
+#endif
+
+    void lock() { lock({nullptr, 0, nullptr}); }
+    void unlock() { unlock({nullptr, 0, nullptr}); }
+    bool try_lock() { return tryLock({nullptr, 0, nullptr}); }
+    void lock_shared() { lockShared({nullptr, 0, nullptr}); }
+    void unlock_shared() { unlockShared({nullptr, 0, nullptr}); }
+    bool try_lock_shared() { return tryLockShared({nullptr, 0, nullptr}); }
+};
+
+/**
+ * @brief Adaptive spin lock for critical sections of a few instructions
+ *
+ * Spins on a relaxed load with a CPU pause, doubling the pause count up to
+ * SPIN_LIMIT, then falls back to yielding the thread, so a preempted holder
+ * does not burn a whole time slice of every waiter. Not fair and not
+ * recursive; use Mutex for anything that may block while held. Same API
+ * and PERS_MUTEX_PROFILING instrumentation as Mutex<false>.
+ */
+class SpinLock {
+public:
+    static constexpr uint32_t SPIN_LIMIT = 64;  // Pauses per backoff step before yielding
+
+private:
+    std::atomic<bool> _locked{false};
+#if PERS_MUTEX_PROFILING
+    const char* _name;
+    detail::MutexSite* _holder = nullptr;
+    uint64_t _acquiredAt = 0;
+#endif
+
+    static void pause() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+        asm volatile("yield");
+#endif
+    }
+
+    bool tryAcquire() {
+        return !_locked.load(std::memory_order_relaxed) &&
+               !_locked.exchange(true, std::memory_order_acquire);
+    }
+
+    void acquireSlow() {
+        uint32_t spins = 1;
+        while (!tryAcquire()) {
+            if (spins <= SPIN_LIMIT) {
+                for (uint32_t i = 0; i < spins; ++i) {
+                    pause();
+                }
+                spins *= 2;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+#if PERS_MUTEX_PROFILING
+    explicit SpinLock(const char* name = nullptr)
+        : _name(name ? name : "unnamed") {}
+
+    void lock(const LogSource& loc) {
+        detail::MutexSite* site = MutexProfiler::site(_name, loc);
+        uint64_t wait = 0;
+        bool contended = !tryAcquire();
+        if (contended) {
+            uint64_t start = MutexProfiler::now();
+            acquireSlow();
+            wait = MutexProfiler::now() - start;
+        }
+        MutexProfiler::recordLock(site, wait, contended);
+        _holder = site;
+        _acquiredAt = MutexProfiler::now();
+    }
+
+    void unlock(const LogSource&) {
+        MutexProfiler::recordHold(_holder, MutexProfiler::now() - _acquiredAt);
+        _locked.store(false, std::memory_order_release);
+    }
+
+    bool tryLock(const LogSource& loc) {
+        if (!tryAcquire()) {
+            return false;
+        }
+        MutexProfiler::recordLock(_holder = MutexProfiler::site(_name, loc), 0, false);
+        _acquiredAt = MutexProfiler::now();
+        return true;
+    }
+#else
+    explicit SpinLock(const char* /*name*/ = nullptr) {}
+
+    void lock(const LogSource&) {
+        if (!tryAcquire()) {
+            acquireSlow();
+        }
+    }
+    void unlock(const LogSource&) { _locked.store(false, std::memory_order_release); }
+    bool tryLock(const LogSource&) { return tryAcquire(); }
+#endif
+
+    void lock() { lock({nullptr, 0, nullptr}); }
+    void unlock() { unlock({nullptr, 0, nullptr}); }
+    bool try_lock() { return tryLock({nullptr, 0, nullptr}); }
+};
+
+// Exclusive guard for SharedMutex and SpinLock, the LockGuard of the other lock types
+template<typename Lockable>
+class ExclusiveLockGuard {
+private:
+    Lockable& _lock;
+    LogSource _loc;
+
+public:
+    ExclusiveLockGuard(Lockable& lock, const LogSource& loc)
+        : _lock(lock), _loc(loc) {
+        _lock.lock(_loc);
+    }
+
+    explicit ExclusiveLockGuard(Lockable& lock)
+        : _lock(lock), _loc{nullptr, 0, nullptr} {
+        _lock.lock(_loc);
+    }
+
+    ~ExclusiveLockGuard() {
+        _lock.unlock(_loc);
+    }
+
+    ExclusiveLockGuard(const ExclusiveLockGuard&) = delete;
+    ExclusiveLockGuard& operator=(const ExclusiveLockGuard&) = delete;
+};
+
+// Shared (reader) guard for SharedMutex
+class SharedLockGuard {
+private:
+    SharedMutex& _mutex;
+    LogSource _loc;
+
+public:
+    SharedLockGuard(SharedMutex& mutex, const LogSource& loc)
+        : _mutex(mutex), _loc(loc) {
+        _mutex.lockShared(_loc);
+    }
+
+    explicit SharedLockGuard(SharedMutex& mutex)
+        : _mutex(mutex), _loc{nullptr, 0, nullptr} {
+        _mutex.lockShared(_loc);
+    }
+
+    ~SharedLockGuard() {
+        _mutex.unlockShared(_loc);
+    }
+
+    SharedLockGuard(const SharedLockGuard&) = delete;
+    SharedLockGuard& operator=(const SharedLockGuard&) = delete;
+};
+
 } // namespace pers
\ No newline at end of file
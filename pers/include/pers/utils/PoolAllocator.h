@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace pers {
+
+/**
+ * @brief Thread-local free list of fixed-size blocks
+ *
+ * Blocks freed on a thread are kept for reuse by later allocations on that
+ * thread, up to MAX_CACHED; beyond that, or once the thread is exiting, they
+ * go back to the heap. A block may be freed on a different thread than the
+ * one that allocated it.
+ */
+template<size_t Size, size_t Alignment>
+class FixedSizeFreeList {
+public:
+    static constexpr size_t MAX_CACHED = 256;
+    static constexpr size_t BLOCK_SIZE = Size < sizeof(void*) ? sizeof(void*) : Size;
+    static constexpr size_t BLOCK_ALIGNMENT = Alignment < alignof(void*) ? alignof(void*) : Alignment;
+
+    static void* allocate() {
+        if (ThreadCache* cache = getCache(); cache && cache->head) {
+            Node* node = cache->head;
+            cache->head = node->next;
+            --cache->count;
+            return node;
+        }
+        return ::operator new(BLOCK_SIZE, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+
+    static void deallocate(void* block) {
+        ThreadCache* cache = getCache();
+        if (cache && cache->count < MAX_CACHED) {
+            Node* node = static_cast<Node*>(block);
+            node->next = cache->head;
+            cache->head = node;
+            ++cache->count;
+            return;
+        }
+        ::operator delete(block, std::align_val_t(BLOCK_ALIGNMENT));
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    struct ThreadCache {
+        Node* head = nullptr;
+        size_t count = 0;
+
+        ~ThreadCache() {
+            s_alive = false;
+            while (head) {
+                Node* next = head->next;
+                ::operator delete(head, std::align_val_t(BLOCK_ALIGNMENT));
+                head = next;
+            }
+        }
+    };
+
+    // Null while the thread's cache is being destroyed, frees then go straight to the heap
+    static ThreadCache* getCache() {
+        if (!s_alive) {
+            return nullptr;
+        }
+        thread_local ThreadCache cache;
+        return s_alive ? &cache : nullptr;
+    }
+
+    static inline thread_local bool s_alive = true;
+};
+
+/**
+ * @brief Allocator drawing single objects from a FixedSizeFreeList
+ *
+ * Meant for std::allocate_shared on wrapper objects created every frame:
+ * the object and its control block come from one recycled block instead of
+ * a fresh heap allocation.
+ *
+ *   auto encoder = std::allocate_shared<WebGPUCommandEncoder>(PoolAllocator<WebGPUCommandEncoder>(), ...);
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        if (count == 1) {
+            return static_cast<T*>(FixedSizeFreeList<sizeof(T), alignof(T)>::allocate());
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept {
+        if (count == 1) {
+            FixedSizeFreeList<sizeof(T), alignof(T)>::deallocate(pointer);
+            return;
+        }
+        ::operator delete(pointer, std::align_val_t(alignof(T)));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+};
+
+/**
+ * @brief std::allocate_shared with a PoolAllocator
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooledShared(Args&&... args) {
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+} // namespace pers
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+namespace pers {
+
+/**
+ * @brief Resident memory of the running process, as the OS accounts it
+ *
+ * Includes driver allocations made in the process, so on unified memory
+ * systems part of the GPU memory shows up here as well. Fields the platform
+ * does not report stay 0.
+ */
+struct ProcessMemoryInfo {
+    uint64_t residentBytes = 0;
+    uint64_t peakResidentBytes = 0;
+};
+
+/**
+ * @brief Query the OS, cheap enough for once per frame
+ */
+ProcessMemoryInfo getProcessMemoryInfo();
+
+} // namespace pers
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Zone macros compile to nothing when 0
+#ifndef PERS_PROFILING
+#define PERS_PROFILING 1
+#endif
+
+#define PERS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define PERS_PROFILE_CONCAT(a, b) PERS_PROFILE_CONCAT_IMPL(a, b)
+
+#if PERS_PROFILING
+// name must be a string literal or otherwise outlive the profiler
+#define PERS_PROFILE_SCOPE(name) pers::ProfileScope PERS_PROFILE_CONCAT(persProfileScope_, __COUNTER__)(name)
+#define PERS_PROFILE_FUNCTION() PERS_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define PERS_PROFILE_SCOPE(name) static_cast<void>(0)
+#define PERS_PROFILE_FUNCTION() static_cast<void>(0)
+#endif
+
+namespace pers {
+
+/**
+ * @brief Count and summed duration of one zone name over a collection window
+ */
+struct ProfileZoneTotal {
+    const char* name = nullptr;
+    uint64_t count = 0;
+    uint64_t totalNanoseconds = 0;
+};
+
+/**
+ * @brief Read position of Profiler::collectZoneTotals() in every thread's buffer
+ * Each consumer keeps its own; a fresh cursor starts at the oldest retained zone.
+ */
+class ProfileCursor {
+private:
+    friend class Profiler;
+    std::vector<uint64_t> _next;  // Next event index, by thread index - 1
+};
+
+/**
+ * @brief CPU zone profiler exporting Chrome trace / Perfetto JSON
+ *
+ * Zones are recorded into per-thread chunked buffers: recording appends to
+ * the calling thread's buffer and publishes it with one atomic store, taking
+ * a lock only when a chunk fills. Each thread keeps its most recent
+ * MAX_EVENTS_PER_THREAD zones; older ones are recycled.
+ *
+ * Disabled by default; a disabled zone costs one relaxed atomic load.
+ *
+ *   Profiler::setEnabled(true);
+ *   ...
+ *   Profiler::writeChromeTrace("frame.json");  // Open in chrome://tracing or ui.perfetto.dev
+ */
+class Profiler {
+public:
+    static constexpr size_t EVENTS_PER_CHUNK = 4096;
+    static constexpr size_t MAX_EVENTS_PER_THREAD = 256 * EVENTS_PER_CHUNK;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // Name shown for the calling thread in the trace
+    static void setThreadName(const std::string& name);
+
+    // Discard every zone recorded so far
+    static void clear();
+
+    /**
+     * @brief Write recorded zones as a Chrome trace event JSON file
+     * @return False if the file cannot be written
+     */
+    static bool writeChromeTrace(const std::string& filename);
+
+    /**
+     * @brief Totals per zone name of zones recorded since the cursor's last call
+     * Zones recycled before the call are lost to it. Nested zones count on
+     * their own, so totals of a parent and its children overlap.
+     * @return Totals sorted by name
+     */
+    static std::vector<ProfileZoneTotal> collectZoneTotals(ProfileCursor& cursor);
+
+    // Nanoseconds since the profiler epoch
+    static uint64_t now();
+
+    // Recording hook for ProfileScope
+    static void recordZone(const char* name, uint64_t startNanoseconds, uint64_t endNanoseconds, uint32_t depth);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/**
+ * @brief Records one zone from construction to destruction on the current thread
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : _name(Profiler::isEnabled() ? name : nullptr) {
+        if (_name) {
+            _depth = s_depth++;
+            _start = Profiler::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (_name) {
+            --s_depth;
+            Profiler::recordZone(_name, _start, Profiler::now(), _depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* _name;
+    uint64_t _start = 0;
+    uint32_t _depth = 0;
+
+    static inline thread_local uint32_t s_depth = 0;
+};
+
+} // namespace pers
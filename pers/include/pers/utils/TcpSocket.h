@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pers {
+
+/**
+ * @brief Blocking TCP socket, just enough for engine-to-engine transfers
+ *
+ * Nagle is disabled on connected sockets; callers send whole messages with
+ * one sendAll() per part. Move-only, closed on destruction. Winsock is
+ * initialized on first use on Windows.
+ */
+class TcpSocket {
+public:
+    TcpSocket() = default;
+    ~TcpSocket();
+
+    TcpSocket(TcpSocket&& other) noexcept;
+    TcpSocket& operator=(TcpSocket&& other) noexcept;
+    TcpSocket(const TcpSocket&) = delete;
+    TcpSocket& operator=(const TcpSocket&) = delete;
+
+    /**
+     * @brief Connect to host:port, trying every address the name resolves to
+     * @return Invalid socket on failure
+     */
+    static TcpSocket connect(const std::string& host, uint16_t port);
+
+    /**
+     * @brief Listening socket on port, 0 picks a free one (see getLocalPort())
+     * @param address Local address to bind, empty for every interface
+     */
+    static TcpSocket listen(uint16_t port, const std::string& address = "", int backlog = 16);
+
+    /**
+     * @brief Wait for the next connection on a listening socket
+     * @return Invalid socket once the listener was shut down or on error
+     */
+    TcpSocket accept() const;
+
+    /**
+     * @return false if the connection broke before everything was sent
+     */
+    bool sendAll(const void* data, size_t size);
+
+    /**
+     * @return false if the connection closed or broke before size bytes arrived
+     */
+    bool receiveAll(void* data, size_t size);
+
+    /**
+     * @brief Stop both directions; blocked calls on other threads return
+     */
+    void shutdown();
+    void close();
+
+    bool isValid() const { return _handle != INVALID_HANDLE; }
+    uint16_t getLocalPort() const;
+    std::string getPeerName() const;  // "address:port", empty if unknown
+
+private:
+    static constexpr intptr_t INVALID_HANDLE = -1;
+
+    explicit TcpSocket(intptr_t handle) : _handle(handle) {}
+
+    intptr_t _handle = INVALID_HANDLE;  // SOCKET or file descriptor
+};
+
+} // namespace pers
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "pers/utils/Profiler.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace pers {
+
+struct TelemetryStreamDesc {
+    std::string path = "pers_telemetry.ndjson";
+    uint32_t sampleIntervalMs = 250;
+    uint32_t samplesPerWrite = 4;           // Lines buffered before they reach the file
+    uint64_t maxFileBytes = 64ull << 20;    // Rolled over to path + ".1" past this size
+    bool includeZones = true;               // Profiler zone totals, empty unless Profiler is enabled
+};
+
+/**
+ * @brief Background sampler streaming Metrics and Profiler zones as NDJSON
+ *
+ * A worker wakes every sampleIntervalMs, collects every metric and the zone
+ * totals recorded since its previous sample, and appends one JSON line per
+ * sample. Lines are written samplesPerWrite at a time, so the engine threads
+ * only pay for their usual relaxed counter updates.
+ *
+ * The test results viewer tails the file (tests/pers/unit_tests/web,
+ * node server.js <results> <history> <telemetry>) and pushes new lines to
+ * its Live tab over a websocket, which also serves remote machines.
+ *
+ *   TelemetryStream telemetry({.path = "pers_telemetry.ndjson"});
+ *   Profiler::setEnabled(true);
+ *   telemetry.start();
+ *
+ * The first line of a session is {"type":"session",...}; every sample is
+ *   {"type":"sample","seq":N,"t":seconds,"dt":seconds,
+ *    "metrics":{name:value,...},"histograms":{name:{"count":N,"sum":S},...},
+ *    "zones":[{"name":...,"count":N,"ms":total},...]}
+ * where counter values are totals; rates come from deltas over dt.
+ */
+class TelemetryStream {
+public:
+    explicit TelemetryStream(const TelemetryStreamDesc& desc = {});
+
+    /**
+     * @brief Writes the buffered samples and joins the worker
+     */
+    ~TelemetryStream();
+
+    TelemetryStream(const TelemetryStream&) = delete;
+    TelemetryStream& operator=(const TelemetryStream&) = delete;
+
+    /**
+     * @brief Truncate the file, write the session line and start sampling
+     * @return False if the file cannot be opened or the stream is running
+     */
+    bool start();
+    void stop();
+    bool isRunning() const { return _thread.joinable(); }
+
+    uint64_t getSampleCount() const { return _sampleCount.load(std::memory_order_relaxed); }
+
+private:
+    void threadLoop();
+    void appendSample(std::string& batch);
+    bool writeBatch(const std::string& batch);
+
+    TelemetryStreamDesc _desc;
+    std::ofstream _file;
+    uint64_t _fileBytes = 0;
+    ProfileCursor _zoneCursor;
+    uint64_t _lastSampleNanoseconds = 0;
+    std::atomic<uint64_t> _sampleCount{0};
+
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    bool _stopping = false;
+    std::thread _thread;
+};
+
+} // namespace pers
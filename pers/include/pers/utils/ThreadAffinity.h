@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pers {
+
+/**
+ * @brief One logical processor the process may run on
+ */
+struct CpuCore {
+    uint32_t cpu = 0;              // Logical processor number, within its group on Windows
+    uint16_t group = 0;            // Windows processor group, 0 elsewhere
+    uint32_t numaNode = 0;
+    uint32_t efficiencyClass = 0;  // Higher is faster; equal on non-hybrid CPUs
+    bool performance = true;       // In the highest efficiency class
+};
+
+/**
+ * @brief Processors, NUMA nodes and core classes of the machine
+ *
+ * Only processors in the process's affinity mask are listed. Linux reads
+ * sysfs (cpu_core/cpu_atom on Intel hybrids, cpu_capacity or the maximum
+ * frequency elsewhere), Windows GetLogicalProcessorInformationEx. macOS
+ * exposes neither, so it reports one node of performance cores.
+ */
+struct CpuTopology {
+    std::vector<CpuCore> cpus;
+    uint32_t numaNodeCount = 1;
+    bool hybrid = false;  // Performance and efficiency cores present
+};
+
+/**
+ * @brief Topology detected once on first use
+ */
+const CpuTopology& getCpuTopology();
+
+enum class CoreClass {
+    Any,
+    Performance,
+    Efficiency
+};
+
+/**
+ * @brief Engine threads an affinity policy can be set for
+ */
+enum class ThreadRole {
+    Main,    // Thread running Application::run(), presents unless pipelined
+    Render,  // RenderThread, encodes and presents in pipelined mode
+    Worker,  // JobSystem workers
+    IO,      // AsyncFileReader threads
+    Logger,  // Async log writer and TelemetryStream
+    Count
+};
+
+/**
+ * @brief Where threads of one role may run
+ *
+ * The default policy leaves scheduling to the OS. A class is only honoured
+ * on hybrid CPUs and a node only with several nodes; a policy no processor
+ * satisfies is relaxed node first, then class.
+ */
+struct ThreadAffinityPolicy {
+    CoreClass cores = CoreClass::Any;
+    int32_t numaNode = -1;         // -1 = any node
+    bool spreadNumaNodes = false;  // Thread index i of the role runs on node i % nodes
+
+    bool isDefault() const { return cores == CoreClass::Any && numaNode < 0 && !spreadNumaNodes; }
+};
+
+struct ThreadAffinityConfig {
+    std::array<ThreadAffinityPolicy, static_cast<size_t>(ThreadRole::Count)> roles{};
+
+    ThreadAffinityPolicy& operator[](ThreadRole role) { return roles[static_cast<size_t>(role)]; }
+    const ThreadAffinityPolicy& operator[](ThreadRole role) const { return roles[static_cast<size_t>(role)]; }
+
+    /**
+     * @brief Main and render threads on performance cores, workers spread
+     * across NUMA nodes, IO and logging on efficiency cores
+     */
+    static ThreadAffinityConfig latencyFocused();
+};
+
+/**
+ * @brief Per-role CPU affinity for engine threads
+ *
+ * Each engine thread calls applyCurrentThread() with its role when it
+ * starts and is remembered until it exits, so configure() also moves
+ * threads that are already running. Application calls configure() with
+ * its _threadAffinity before it starts the job system.
+ *
+ * Pinning a worker also keeps its memory local: FrameArena blocks are
+ * per thread and first touched there, so Linux and Windows place their
+ * pages on the worker's node.
+ *
+ * On macOS threads cannot be pinned; Performance and Efficiency map to
+ * the USER_INTERACTIVE and BACKGROUND QoS classes of the calling thread,
+ * and configure() only affects threads started afterwards.
+ */
+class ThreadAffinity {
+public:
+    static void configure(const ThreadAffinityConfig& config);
+    static ThreadAffinityConfig getConfig();
+
+    /**
+     * @brief Apply the role's policy to the calling thread and track it
+     * @param index Position of the thread within its role, spreads workers over nodes
+     * @return false if the OS refused the affinity
+     */
+    static bool applyCurrentThread(ThreadRole role, uint32_t index = 0);
+
+    /**
+     * @brief Processors a policy resolves to for the index-th thread of a role
+     * Empty for the default policy, meaning any processor.
+     */
+    static std::vector<CpuCore> selectCpus(const ThreadAffinityPolicy& policy, uint32_t index);
+
+    static const char* getRoleName(ThreadRole role);
+};
+
+} // namespace pers
@@ -0,0 +1,20 @@
+#pragma once
+
+// When 0, the argument checks backend wrappers run on hot calls (pass
+// encoder setters and draws, queue submits and writes, staging writes) are
+// compiled out, and instances are created without native validation.
+// Misuse then reaches the native API unchecked. Set per build type through
+// PERS_UNCHECKED_RELEASE.
+#ifndef PERS_VALIDATION
+#define PERS_VALIDATION 1
+#endif
+
+// Guards a wrapper-side check: if (PERS_CHECK_FAILED(!buffer)) { log; return; }
+// Compiled out, the condition is not evaluated and the branch folds away.
+// State the wrapper relies on itself (double end, stale handles, async
+// pipelines not yet compiled) is never guarded with it.
+#if PERS_VALIDATION
+#define PERS_CHECK_FAILED(condition) (condition)
+#else
+#define PERS_CHECK_FAILED(condition) false
+#endif
@@ -3,8 +3,11 @@
 #include "pers/core/IWindowFactory.h"
 #include "pers/graphics/backends/IGraphicsInstanceFactory.h"
 #include "pers/graphics/IInstance.h"
+#include "pers/utils/AllocationTracker.h"
 #include "pers/utils/Logger.h"
-#include <chrono>
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/ThreadAffinity.h"
 
 namespace pers {
     Application::Application() = default;
@@ -15,6 +18,7 @@ namespace pers {
 
     bool Application::initialize(const std::shared_ptr<IWindowFactory>& windowFactory,
                                 const std::shared_ptr<pers::IGraphicsInstanceFactory>& graphicsFactory) {
+        PERS_PROFILE_SCOPE("Application::initialize");
         LOG_INFO("Application", "=== Application Initialization ===");
 
         // Store factories
@@ -31,20 +35,52 @@ namespace pers {
             return false;
         }
 
-        // Create window
-        if (!createWindow()) {
+        createJobSystem();
+
+        // The instance does not need the window, create it first so the
+        // adapter and device can be requested while the window opens
+        if (!createInstance()) {
+            return false;
+        }
+        beginDeviceStartup();
+
+        // Create window and setup callbacks
+        if (!createWindow() || !setupWindowCallbacks()) {
+            // Startup callbacks may reference the derived class, finish them first
+            if (_deviceStartup.isStarted()) {
+                _deviceStartup.wait();
+            }
             return false;
         }
 
-        // Setup window callbacks
-        if (!setupWindowCallbacks()) {
+        // Call derived class initialization
+        if (!onInitialize()) {
+            LOG_ERROR("Application", "Derived class initialization failed");
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Application::initializeHeadless(const std::shared_ptr<pers::IGraphicsInstanceFactory>& graphicsFactory) {
+        PERS_PROFILE_SCOPE("Application::initializeHeadless");
+        LOG_INFO("Application", "=== Application Initialization (headless) ===");
+
+        _graphicsFactory = graphicsFactory;
+        _headless = true;
+
+        if (!_graphicsFactory) {
+            LOG_ERROR("Application", "Invalid graphics factory provided");
             return false;
         }
 
-        // Create graphics instance after window is ready
+        createJobSystem();
+
+        // No window: the instance is only used for offscreen rendering
         if (!createInstance()) {
             return false;
         }
+        beginDeviceStartup();
 
         // Call derived class initialization
         if (!onInitialize()) {
@@ -56,24 +92,187 @@ namespace pers {
     }
 
     void Application::run() {
-        auto lastTime = std::chrono::steady_clock::now();
+        if (!_headless && !_window) {
+            LOG_ERROR("Application", "run() called before initialize()");
+            return;
+        }
+
+        if (_pipelinedRendering) {
+            LOG_INFO("Application", "Pipelined rendering: onRender runs on the render thread");
+            _renderThread = std::make_unique<pers::RenderThread>();
+            _framePacer.setRenderThreadSubmissions(true);
+        }
+
+        // Spend the frame cap's spare time blocked on window events, not sleeping
+        if (_window) {
+            _framePacer.setIdleWait([this](double seconds) {
+                PERS_PROFILE_SCOPE("IWindow::waitEvents");
+                _window->waitEvents(seconds);
+            });
+        }
+
+        const bool onDemand = _renderOnDemand && _window;
+        if (onDemand) {
+            LOG_INFO("Application", "Rendering on demand: frames render only when damaged");
+            requestRedraw();  // First frame
+        }
 
-        while (!_window->shouldClose()) {
-            // Calculate delta time
-            auto currentTime = std::chrono::steady_clock::now();
-            float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
-            lastTime = currentTime;
+        while (!_exitRequested && (_headless || !_window->shouldClose())) {
+            PERS_PROFILE_SCOPE("Frame");
+
+            // Sleep until input or requestRedraw() instead of spinning
+            if (onDemand) {
+                waitForRedraw();
+            }
+
+            // Wait on frames in flight and the frame cap before sampling input
+            float deltaTime;
+            {
+                PERS_PROFILE_SCOPE("FramePacer::beginFrame");
+                deltaTime = _framePacer.beginFrame();
+            }
 
             // Poll events
-            _window->pollEvents();
+            if (_window) {
+                PERS_PROFILE_SCOPE("IWindow::pollEvents");
+                _window->pollEvents();
+            }
+
+            // Update and render; past warmup, any heap allocation here is reported
+            pers::AllocationTracker::nextFrame();
+            pers::AllocationFrameScope allocationScope;
+            {
+                PERS_PROFILE_SCOPE("Application::onUpdate");
+                onUpdate(deltaTime);
+            }
+            bool rendered = false;
+            if (_renderThread) {
+                // Overlapped with onUpdate() above, publish once the previous frame is out
+                {
+                    PERS_PROFILE_SCOPE("RenderThread::wait");
+                    _renderThread->wait();
+                }
+                rendered = takeDamage();
+                if (rendered) {
+                    onPublishFrame();
+                    _renderThread->submit([this]() {
+                        pers::AllocationFrameScope allocationScope;
+                        PERS_PROFILE_SCOPE("Application::onRender");
+                        onRender();
+                        _framePacer.endSubmissions();
+                    });
+                }
+            } else if (takeDamage()) {
+                PERS_PROFILE_SCOPE("Application::onRender");
+                onRender();
+                rendered = true;
+            }
+
+            _framePacer.endFrame();
+
+            if (_performanceHud && rendered) {
+                const pers::FramePacer::Stats pacing = _framePacer.getStats();
+                pers::PerformanceHudFrame hudFrame;
+                hudFrame.frameMs = deltaTime * 1000.0;
+                hudFrame.cpuMs = pacing.cpuTimeMs;
+                hudFrame.gpuLatencyMs = pacing.gpuLatencyMs;
+                _performanceHud->addFrame(hudFrame);
+            }
+
+            static MetricCounter& frames = Metrics::counter("pers_frames_total", "Frames run by Application");
+            static MetricCounter& skipped = Metrics::counter("pers_frames_skipped_total",
+                "Frames without damage in on-demand mode, not rendered");
+            static MetricHistogram& frameTime = Metrics::histogram("pers_frame_time_seconds",
+                {0.004, 0.007, 0.0084, 0.0112, 0.0167, 0.025, 0.0334, 0.05, 0.1, 0.25}, "Frame time");
+            if (rendered) {
+                frames.increment();
+                frameTime.observe(deltaTime);
+            } else {
+                skipped.increment();
+            }
+        }
+
+        if (_renderThread) {
+            _renderThread.reset();  // Finishes the last frame
+            _framePacer.setRenderThreadSubmissions(false);
+        }
+        _framePacer.setIdleWait(nullptr);
+    }
+
+    void Application::renderNow() {
+        if (_renderThread) {
+            // Run in place while the render thread is idle, as one more frame
+            _renderThread->wait();
+        }
+
+        // Redraws everything, pending damage included
+        {
+            std::lock_guard<std::mutex> lock(_damageMutex);
+            _damage.clear();
+        }
+        _renderDamage.invalidate();
+
+        onRender();
+        if (_renderThread) {
+            _framePacer.endSubmissions();
+        }
+    }
+
+    void Application::requestRedraw() {
+        {
+            std::lock_guard<std::mutex> lock(_damageMutex);
+            _damage.invalidate();
+        }
+        if (_renderOnDemand && _window) {
+            _window->postEmptyEvent();
+        }
+    }
+
+    void Application::requestRedraw(const pers::DamageRect& rect) {
+        {
+            std::lock_guard<std::mutex> lock(_damageMutex);
+            _damage.invalidate(rect);
+        }
+        if (_renderOnDemand && _window) {
+            _window->postEmptyEvent();
+        }
+    }
+
+    void Application::waitForRedraw() {
+        PERS_PROFILE_SCOPE("IWindow::waitEvents");
+        while (!_exitRequested && !_window->shouldClose()) {
+            {
+                std::lock_guard<std::mutex> lock(_damageMutex);
+                if (_damage.isDirty()) {
+                    return;
+                }
+            }
+            // Events without damage (e.g. mouse motion) keep waiting unless a timeout is set
+            _window->waitEvents(_onDemandTimeout);
+            if (_onDemandTimeout >= 0.0) {
+                return;
+            }
+        }
+    }
 
-            // Update and render
-            onUpdate(deltaTime);
-            onRender();
+    bool Application::takeDamage() {
+        // Called with onRender() idle, so _renderDamage is free to replace
+        _renderDamage.clear();
+        std::lock_guard<std::mutex> lock(_damageMutex);
+        if (!_renderOnDemand || !_window) {
+            _damage.clear();
+            _renderDamage.invalidate();
+            return true;
         }
+        _renderDamage.merge(_damage);
+        _damage.clear();
+        return _renderDamage.isDirty();
     }
 
     glm::ivec2 Application::getFramebufferSize() const {
+        if (_headless) {
+            return glm::ivec2(_windowWidth, _windowHeight);
+        }
         if (!_window) {
             return glm::ivec2(0, 0);
         }
@@ -81,6 +280,7 @@ namespace pers {
     }
 
     bool Application::createWindow() {
+        PERS_PROFILE_SCOPE("Application::createWindow");
         pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "Application", PERS_SOURCE_LOC,
             "Creating window using %s factory", _windowFactory->getFactoryName());
 
@@ -112,13 +312,14 @@ namespace pers {
 
         // Set refresh callback to render during window resize
         _window->setRefreshCallback([this]() {
-            onRender();
+            renderNow();
         });
 
         return true;
     }
 
     bool Application::createInstance() {
+        PERS_PROFILE_SCOPE("Application::createInstance");
         LOG_INFO("Application", "Creating graphics instance");
         pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "Application", PERS_SOURCE_LOC,
             "Using backend: %s", _graphicsFactory->getBackendName().c_str());
@@ -131,6 +332,7 @@ namespace pers {
         instanceDesc.engineVersion = 1;
         instanceDesc.enableValidation = true;
         instanceDesc.preferHighPerformanceGPU = true;
+        onConfigureInstance(instanceDesc);
 
         _instance = _graphicsFactory->createInstance(instanceDesc);
         if (!_instance) {
@@ -142,9 +344,32 @@ namespace pers {
         return true;
     }
 
+    void Application::createJobSystem() {
+        if (_jobSystem) {
+            return;
+        }
+        PERS_PROFILE_SCOPE("Application::createJobSystem");
+        // Before the workers start; threads already running are moved as well
+        pers::ThreadAffinity::configure(_threadAffinity);
+        pers::ThreadAffinity::applyCurrentThread(pers::ThreadRole::Main);
+        _jobSystem = std::make_unique<pers::JobSystem>(_jobWorkerCount);
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "Application", PERS_SOURCE_LOC,
+            "Job system started with %u workers", _jobSystem->getWorkerCount());
+    }
+
+    void Application::beginDeviceStartup() {
+        pers::DeviceStartupDesc desc;
+        if (!onConfigureStartup(_deviceStartup, desc)) {
+            return;
+        }
+
+        LOG_INFO("Application", "Creating device in parallel with window creation");
+        _deviceStartup.begin(_instance, desc);
+    }
+
     pers::NativeSurfaceHandle Application::createSurface() const {
-        if (!_instance) {
-            LOG_ERROR("Application", "Instance not initialized");
+        if (_headless) {
+            LOG_ERROR("Application", "No surface in headless mode");
             return pers::NativeSurfaceHandle(nullptr);
         }
 
@@ -153,8 +378,17 @@ namespace pers {
             return pers::NativeSurfaceHandle(nullptr);
         }
 
+        return createSurface(*_window);
+    }
+
+    pers::NativeSurfaceHandle Application::createSurface(IWindow& window) const {
+        if (!_instance) {
+            LOG_ERROR("Application", "Instance not initialized");
+            return pers::NativeSurfaceHandle(nullptr);
+        }
+
         // Get native handle from window
-        pers::NativeWindowHandle nativeHandle = _window->getNativeHandle();
+        pers::NativeWindowHandle nativeHandle = window.getNativeHandle();
 
         // Create surface using the instance
         pers::NativeSurfaceHandle surface = _instance->createSurface(&nativeHandle);
@@ -167,32 +401,113 @@ namespace pers {
         return surface;
     }
 
+    IWindow* Application::createViewportWindow(int width, int height, const std::string& title) {
+        if (_headless || !_windowFactory) {
+            LOG_ERROR("Application", "Viewport windows need a window factory");
+            return nullptr;
+        }
+
+        auto window = _windowFactory->createWindow(width, height, title);
+        if (!window || !window->isValid()) {
+            LOG_ERROR("Application", "Failed to create viewport window");
+            return nullptr;
+        }
+
+        IWindow* viewport = window.get();
+        viewport->setResizeCallback([this, viewport](int width, int height) {
+            if (_renderThread) {
+                _renderThread->wait();
+            }
+            onViewportResize(viewport, width, height);
+            renderNow();
+        });
+        viewport->setKeyCallback([this](int key, int scancode, int action, int mods) {
+            onKeyPress(key, scancode, action, mods);
+            requestRedraw();
+        });
+        viewport->setRefreshCallback([this]() {
+            renderNow();
+        });
+
+        _viewportWindows.push_back(std::move(window));
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "Application", PERS_SOURCE_LOC,
+            "Viewport window created: %dx%d", width, height);
+        return viewport;
+    }
+
+    void Application::destroyViewportWindow(IWindow* window) {
+        // The render thread may still be presenting to the window's surface
+        if (_renderThread) {
+            _renderThread->wait();
+        }
+        std::erase_if(_viewportWindows, [window](const auto& viewport) { return viewport.get() == window; });
+    }
+
     void Application::cleanup() {
         LOG_INFO("Application", "Starting cleanup");
 
+        // The device worker may still be running ready callbacks
+        if (_deviceStartup.isStarted()) {
+            _deviceStartup.wait();
+        }
+
+        // Jobs may still reference resources the derived class is about to free
+        if (_jobSystem) {
+            _jobSystem->waitIdle();
+        }
+
         // Call derived class cleanup first
         onCleanup();
 
+        // Holds GPU resources of the derived class's device
+        _performanceHud.reset();
+
         // Clean up graphics instance
         _instance.reset();
 
         // Clean up graphics factory (shared, may still be referenced elsewhere)
         _graphicsFactory.reset();
 
-        // Clean up window
+        // Clean up windows
+        _viewportWindows.clear();
         _window.reset();
 
         // Clean up window factory (shared, may still be referenced elsewhere)
         _windowFactory.reset();
 
+        _jobSystem.reset();
+
         LOG_INFO("Application", "Cleanup completed");
     }
 
     void Application::handleResize(int width, int height) {
+        // The render thread may still be using the old swapchain size
+        if (_renderThread) {
+            _renderThread->wait();
+        }
+
         // Forward to virtual method
         onResize(width, height);
         // Also render immediately after resize
-        onRender();
+        renderNow();
+    }
+
+    pers::PerformanceHud* Application::enablePerformanceHud(const std::shared_ptr<pers::ILogicalDevice>& device,
+                                                            const pers::PerformanceHud::Config& config) {
+        auto hud = std::make_unique<pers::PerformanceHud>(device, config);
+        if (!hud->isValid()) {
+            LOG_ERROR("Application", "Failed to create performance HUD");
+            return nullptr;
+        }
+
+        _performanceHud = std::move(hud);
+        _performanceHudVisible = true;
+        return _performanceHud.get();
+    }
+
+    void Application::setPerformanceHudVisible(bool visible) {
+        _performanceHudVisible = visible;
+        requestRedraw();
     }
 
     void Application::handleKeyPress(int key, int scancode, int action, int mods) {
@@ -201,6 +516,13 @@ namespace pers {
             _window->setShouldClose(true);
         }
 
+        if (action == 1 && key == _performanceHudKey && _performanceHud) {
+            setPerformanceHudVisible(!_performanceHudVisible);
+        }
+
+        // Input may change anything on screen
+        requestRedraw();
+
         // Forward to virtual method
         onKeyPress(key, scancode, action, mods);
     }
@@ -0,0 +1,817 @@
+#include "pers/core/AsyncFileReader.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/ThreadAffinity.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define PERS_HAS_IO_URING 1
+#else
+#define PERS_HAS_IO_URING 0
+#endif
+
+namespace pers {
+
+namespace {
+
+#if defined(_WIN32)
+using NativeFile = HANDLE;
+const NativeFile INVALID_FILE = INVALID_HANDLE_VALUE;
+#else
+using NativeFile = int;
+constexpr NativeFile INVALID_FILE = -1;
+#endif
+
+// Per native call; longer reads continue where the previous call stopped
+constexpr uint64_t MAX_CHUNK = 1ull << 30;
+
+struct ReadRequest {
+#if defined(_WIN32)
+    OVERLAPPED overlapped = {};  // First member, completion packets carry its address
+#endif
+    NativeFile file = INVALID_FILE;
+    std::string path;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    uint64_t done = 0;
+    uint8_t* destination = nullptr;
+    AsyncFileReader::Completion completion;
+    std::shared_ptr<ImmediateStagingBuffer> staging;  // Keeps the mapping alive
+    int error = 0;
+#if PERS_HAS_IO_URING
+    iovec iov = {};
+#endif
+
+    uint64_t nextChunk() const { return std::min(size - done, MAX_CHUNK); }
+};
+
+int lastError() {
+#if defined(_WIN32)
+    return static_cast<int>(GetLastError());
+#else
+    return errno;
+#endif
+}
+
+NativeFile openFile(const std::string& path, bool overlapped) {
+#if defined(_WIN32)
+    const DWORD flags = FILE_ATTRIBUTE_NORMAL | (overlapped ? FILE_FLAG_OVERLAPPED : 0);
+    return CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+#else
+    static_cast<void>(overlapped);
+    return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void closeNativeFile(NativeFile file) {
+#if defined(_WIN32)
+    CloseHandle(file);
+#else
+    ::close(file);
+#endif
+}
+
+#if PERS_HAS_IO_URING
+int ioUringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int ioUringEnter(int ring, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, 0));
+}
+#endif
+
+} // anonymous namespace
+
+class AsyncFileReader::Impl {
+public:
+    explicit Impl(const Desc& desc);
+    ~Impl();
+
+    bool submit(const std::string& path, uint64_t offset, uint64_t size, void* destination,
+                Completion completion, std::shared_ptr<ImmediateStagingBuffer> staging);
+    void closeFile(const std::string& path);
+    void waitIdle();
+
+    Backend getBackend() const { return _backend; }
+    Stats getStats() const;
+
+private:
+    struct FileEntry {
+        NativeFile file = INVALID_FILE;
+        uint32_t pending = 0;
+        bool closeRequested = false;
+    };
+
+    NativeFile acquireFile(const std::string& path);
+    void releaseFile(const std::string& path);
+    void complete(ReadRequest* request);
+    void wake();
+
+    void startThreadPool();
+    void workerLoop(uint32_t index);
+    void readBlocking(ReadRequest& request);
+
+#if PERS_HAS_IO_URING
+    bool setupRing();
+    void destroyRing();
+    void ringLoop();
+    void pushRead(void* userData, int file, iovec* iov, uint64_t offset);
+#endif
+
+#if defined(_WIN32)
+    bool setupPort();
+    void portLoop();
+    bool issueRead(ReadRequest* request);
+#endif
+
+    Desc _desc;
+    Backend _backend = Backend::ThreadPool;
+
+    std::mutex _queueMutex;
+    std::condition_variable _queueCv;
+    std::deque<ReadRequest*> _queue;
+    bool _stopping = false;
+    std::vector<std::thread> _threads;
+
+    std::mutex _fileMutex;
+    std::unordered_map<std::string, FileEntry> _files;
+
+    std::mutex _idleMutex;
+    std::condition_variable _idleCv;
+    uint64_t _outstanding = 0;
+
+    std::atomic<uint64_t> _reads{0};
+    std::atomic<uint64_t> _failedReads{0};
+    std::atomic<uint64_t> _bytesRead{0};
+    std::atomic<uint64_t> _submitCalls{0};
+
+#if PERS_HAS_IO_URING
+    int _ring = -1;
+    int _wakeFd = -1;
+    uint64_t _wakeValue = 0;
+    iovec _wakeIov = {};
+    void* _sqRing = nullptr;
+    void* _cqRing = nullptr;
+    size_t _sqRingSize = 0;
+    size_t _cqRingSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+    unsigned _sqEntries = 0;
+    unsigned* _sqTail = nullptr;
+    unsigned* _sqMask = nullptr;
+    unsigned* _sqArray = nullptr;
+    unsigned* _cqHead = nullptr;
+    unsigned* _cqTail = nullptr;
+    unsigned* _cqMask = nullptr;
+    io_uring_cqe* _cqes = nullptr;
+    unsigned _pendingSubmits = 0;
+#endif
+
+#if defined(_WIN32)
+    HANDLE _port = nullptr;
+    static constexpr ULONG_PTR WAKE_KEY = 1;
+    static constexpr ULONG_PTR FILE_KEY = 2;
+#endif
+};
+
+AsyncFileReader::Impl::Impl(const Desc& desc)
+    : _desc(desc) {
+    _desc.queueDepth = std::max(_desc.queueDepth, 1u);
+    _desc.threadCount = std::max(_desc.threadCount, 1u);
+
+    bool native = false;
+    if (!_desc.forceThreadPool) {
+#if PERS_HAS_IO_URING
+        native = setupRing();
+        if (native) {
+            _backend = Backend::IoUring;
+            _threads.emplace_back(&Impl::ringLoop, this);
+        }
+#elif defined(_WIN32)
+        native = setupPort();
+        if (native) {
+            _backend = Backend::CompletionPort;
+            _threads.emplace_back(&Impl::portLoop, this);
+        }
+#endif
+    }
+    if (!native) {
+        startThreadPool();
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Debug, "AsyncFileReader", PERS_SOURCE_LOC,
+        "Using %s backend, queue depth %u", getBackendName(_backend), _desc.queueDepth);
+}
+
+AsyncFileReader::Impl::~Impl() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _stopping = true;
+    }
+    wake();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+
+#if PERS_HAS_IO_URING
+    destroyRing();
+#endif
+#if defined(_WIN32)
+    if (_port) {
+        CloseHandle(_port);
+    }
+#endif
+
+    for (auto& [path, entry] : _files) {
+        closeNativeFile(entry.file);
+    }
+}
+
+bool AsyncFileReader::Impl::submit(const std::string& path, uint64_t offset, uint64_t size, void* destination,
+                                   Completion completion, std::shared_ptr<ImmediateStagingBuffer> staging) {
+    NativeFile file = acquireFile(path);
+    if (file == INVALID_FILE) {
+        return false;
+    }
+
+    auto* request = new ReadRequest();
+    request->file = file;
+    request->path = path;
+    request->offset = offset;
+    request->size = size;
+    request->destination = static_cast<uint8_t*>(destination);
+    request->completion = std::move(completion);
+    request->staging = std::move(staging);
+
+    {
+        std::lock_guard<std::mutex> lock(_idleMutex);
+        ++_outstanding;
+    }
+    if (size == 0) {
+        complete(request);
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        _queue.push_back(request);
+    }
+    wake();
+    return true;
+}
+
+void AsyncFileReader::Impl::closeFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    auto it = _files.find(path);
+    if (it == _files.end()) {
+        return;
+    }
+    if (it->second.pending > 0) {
+        it->second.closeRequested = true;
+        return;
+    }
+    closeNativeFile(it->second.file);
+    _files.erase(it);
+}
+
+void AsyncFileReader::Impl::waitIdle() {
+    std::unique_lock<std::mutex> lock(_idleMutex);
+    _idleCv.wait(lock, [this] { return _outstanding == 0; });
+}
+
+AsyncFileReader::Stats AsyncFileReader::Impl::getStats() const {
+    Stats stats;
+    stats.reads = _reads.load(std::memory_order_relaxed);
+    stats.failedReads = _failedReads.load(std::memory_order_relaxed);
+    stats.bytesRead = _bytesRead.load(std::memory_order_relaxed);
+    stats.submitCalls = _submitCalls.load(std::memory_order_relaxed);
+    return stats;
+}
+
+NativeFile AsyncFileReader::Impl::acquireFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    auto it = _files.find(path);
+    if (it == _files.end()) {
+        NativeFile file = openFile(path, _backend == Backend::CompletionPort);
+        if (file == INVALID_FILE) {
+            Logger::Instance().LogFormat(LogLevel::Error, "AsyncFileReader", PERS_SOURCE_LOC,
+                "Failed to open '%s' (error %d)", path.c_str(), lastError());
+            return INVALID_FILE;
+        }
+#if defined(_WIN32)
+        if (_port && !CreateIoCompletionPort(file, _port, FILE_KEY, 0)) {
+            Logger::Instance().LogFormat(LogLevel::Error, "AsyncFileReader", PERS_SOURCE_LOC,
+                "Failed to attach '%s' to the completion port (error %d)", path.c_str(), lastError());
+            closeNativeFile(file);
+            return INVALID_FILE;
+        }
+#endif
+        it = _files.emplace(path, FileEntry{file, 0, false}).first;
+    }
+    it->second.closeRequested = false;
+    ++it->second.pending;
+    return it->second.file;
+}
+
+void AsyncFileReader::Impl::releaseFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    auto it = _files.find(path);
+    if (it != _files.end() && --it->second.pending == 0 && it->second.closeRequested) {
+        closeNativeFile(it->second.file);
+        _files.erase(it);
+    }
+}
+
+void AsyncFileReader::Impl::complete(ReadRequest* request) {
+    Result result;
+    result.bytesRead = request->done;
+    result.error = request->error;
+    result.success = request->error == 0 && request->done == request->size;
+
+    _reads.fetch_add(1, std::memory_order_relaxed);
+    _bytesRead.fetch_add(request->done, std::memory_order_relaxed);
+    if (!result.success) {
+        _failedReads.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (request->completion) {
+        PERS_PROFILE_SCOPE("AsyncFileReader::completion");
+        request->completion(result);
+    }
+    releaseFile(request->path);
+    delete request;
+
+    std::lock_guard<std::mutex> lock(_idleMutex);
+    if (--_outstanding == 0) {
+        _idleCv.notify_all();
+    }
+}
+
+void AsyncFileReader::Impl::wake() {
+    switch (_backend) {
+        case Backend::ThreadPool:
+            _queueCv.notify_all();
+            break;
+        case Backend::IoUring:
+#if PERS_HAS_IO_URING
+        {
+            const uint64_t one = 1;
+            [[maybe_unused]] ssize_t written = ::write(_wakeFd, &one, sizeof(one));
+        }
+#endif
+            break;
+        case Backend::CompletionPort:
+#if defined(_WIN32)
+            PostQueuedCompletionStatus(_port, 0, WAKE_KEY, nullptr);
+#endif
+            break;
+    }
+}
+
+// ---- Thread pool ------------------------------------------------------------
+
+void AsyncFileReader::Impl::startThreadPool() {
+    _backend = Backend::ThreadPool;
+    for (uint32_t i = 0; i < _desc.threadCount; ++i) {
+        _threads.emplace_back(&Impl::workerLoop, this, i);
+    }
+}
+
+void AsyncFileReader::Impl::workerLoop(uint32_t index) {
+    Profiler::setThreadName("AsyncFileReader");
+    ThreadAffinity::applyCurrentThread(ThreadRole::IO, index);
+    for (;;) {
+        ReadRequest* request = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_queueMutex);
+            _queueCv.wait(lock, [this] { return _stopping || !_queue.empty(); });
+            if (_queue.empty()) {
+                return;
+            }
+            request = _queue.front();
+            _queue.pop_front();
+        }
+        readBlocking(*request);
+        complete(request);
+    }
+}
+
+void AsyncFileReader::Impl::readBlocking(ReadRequest& request) {
+    PERS_PROFILE_SCOPE("AsyncFileReader::read");
+#if defined(_WIN32)
+    // Handles of this backend are not overlapped, the offset still comes from the OVERLAPPED
+    while (request.done < request.size) {
+        OVERLAPPED overlapped = {};
+        const uint64_t position = request.offset + request.done;
+        overlapped.Offset = static_cast<DWORD>(position);
+        overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+        DWORD read = 0;
+        _submitCalls.fetch_add(1, std::memory_order_relaxed);
+        if (!ReadFile(request.file, request.destination + request.done, static_cast<DWORD>(request.nextChunk()),
+                      &read, &overlapped)) {
+            const DWORD error = GetLastError();
+            if (error != ERROR_HANDLE_EOF) {
+                request.error = static_cast<int>(error);
+            }
+            return;
+        }
+        if (read == 0) {
+            return;
+        }
+        request.done += read;
+    }
+#else
+    while (request.done < request.size) {
+        _submitCalls.fetch_add(1, std::memory_order_relaxed);
+        ssize_t read = ::pread(request.file, request.destination + request.done, request.nextChunk(),
+                               static_cast<off_t>(request.offset + request.done));
+        if (read < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            request.error = errno;
+            return;
+        }
+        if (read == 0) {
+            return;
+        }
+        request.done += static_cast<uint64_t>(read);
+    }
+#endif
+}
+
+// ---- io_uring ---------------------------------------------------------------
+
+#if PERS_HAS_IO_URING
+
+bool AsyncFileReader::Impl::setupRing() {
+    io_uring_params params = {};
+    // One slot stays reserved for the wake read
+    _ring = ioUringSetup(_desc.queueDepth + 1, &params);
+    if (_ring < 0) {
+        Logger::Instance().LogFormat(LogLevel::Info, "AsyncFileReader", PERS_SOURCE_LOC,
+            "io_uring unavailable (error %d), using thread pool reads", errno);
+        _ring = -1;
+        return false;
+    }
+
+    _sqEntries = params.sq_entries;
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+    }
+
+    _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+    if (_sqRing == MAP_FAILED) {
+        _sqRing = nullptr;
+        destroyRing();
+        return false;
+    }
+    if (singleMmap) {
+        _cqRing = _sqRing;
+    } else {
+        _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_CQ_RING);
+        if (_cqRing == MAP_FAILED) {
+            _cqRing = nullptr;
+            destroyRing();
+            return false;
+        }
+    }
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        destroyRing();
+        return false;
+    }
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    auto* sq = static_cast<uint8_t*>(_sqRing);
+    _sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    _sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    _sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    auto* cq = static_cast<uint8_t*>(_cqRing);
+    _cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    _cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    _cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    _wakeFd = eventfd(0, EFD_CLOEXEC);
+    if (_wakeFd < 0) {
+        destroyRing();
+        return false;
+    }
+    _wakeIov.iov_base = &_wakeValue;
+    _wakeIov.iov_len = sizeof(_wakeValue);
+    return true;
+}
+
+void AsyncFileReader::Impl::destroyRing() {
+    if (_sqes) {
+        munmap(_sqes, _sqesSize);
+        _sqes = nullptr;
+    }
+    if (_cqRing && _cqRing != _sqRing) {
+        munmap(_cqRing, _cqRingSize);
+    }
+    _cqRing = nullptr;
+    if (_sqRing) {
+        munmap(_sqRing, _sqRingSize);
+        _sqRing = nullptr;
+    }
+    if (_wakeFd >= 0) {
+        ::close(_wakeFd);
+        _wakeFd = -1;
+    }
+    if (_ring >= 0) {
+        ::close(_ring);
+        _ring = -1;
+    }
+}
+
+// IO thread only; the caller makes sure a submission slot is free
+void AsyncFileReader::Impl::pushRead(void* userData, int file, iovec* iov, uint64_t offset) {
+    const unsigned tail = *_sqTail;
+    const unsigned index = tail & *_sqMask;
+    io_uring_sqe& sqe = _sqes[index];
+    sqe = {};
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = file;
+    sqe.off = offset;
+    sqe.addr = reinterpret_cast<uint64_t>(iov);
+    sqe.len = 1;
+    sqe.user_data = reinterpret_cast<uint64_t>(userData);
+    _sqArray[index] = index;
+    // The kernel reads the entry once it sees the new tail
+    __atomic_store_n(_sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++_pendingSubmits;
+}
+
+void AsyncFileReader::Impl::ringLoop() {
+    Profiler::setThreadName("AsyncFileReader");
+    ThreadAffinity::applyCurrentThread(ThreadRole::IO);
+
+    // A read of the eventfd stays in flight so wake() interrupts the wait for completions
+    pushRead(nullptr, _wakeFd, &_wakeIov, 0);
+    std::vector<ReadRequest*> continued;  // Short reads to resubmit
+    uint32_t inFlight = 0;
+
+    for (;;) {
+        bool stopping = false;
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            while (inFlight < _desc.queueDepth && _pendingSubmits < _sqEntries && (!continued.empty() || !_queue.empty())) {
+                ReadRequest* request;
+                if (!continued.empty()) {
+                    request = continued.back();
+                    continued.pop_back();
+                } else {
+                    request = _queue.front();
+                    _queue.pop_front();
+                }
+                request->iov.iov_base = request->destination + request->done;
+                request->iov.iov_len = request->nextChunk();
+                pushRead(request, request->file, &request->iov, request->offset + request->done);
+                ++inFlight;
+            }
+            stopping = _stopping && _queue.empty() && continued.empty();
+        }
+        if (stopping && inFlight == 0) {
+            break;
+        }
+
+        _submitCalls.fetch_add(1, std::memory_order_relaxed);
+        const int submitted = ioUringEnter(_ring, _pendingSubmits, 1, IORING_ENTER_GETEVENTS);
+        if (submitted < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                continue;
+            }
+            Logger::Instance().LogFormat(LogLevel::Error, "AsyncFileReader", PERS_SOURCE_LOC,
+                "io_uring_enter failed (error %d)", errno);
+            break;
+        }
+        _pendingSubmits -= std::min(_pendingSubmits, static_cast<unsigned>(submitted));
+
+        unsigned head = *_cqHead;
+        const unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = _cqes[head & *_cqMask];
+            auto* request = reinterpret_cast<ReadRequest*>(cqe.user_data);
+            if (!request) {
+                pushRead(nullptr, _wakeFd, &_wakeIov, 0);
+                continue;
+            }
+
+            --inFlight;
+            if (cqe.res < 0) {
+                request->error = -cqe.res;
+            } else if (cqe.res > 0) {
+                request->done += static_cast<uint64_t>(cqe.res);
+                if (request->done < request->size) {
+                    continued.push_back(request);
+                    continue;
+                }
+            }
+            complete(request);
+        }
+        __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    // Only reached on a ring failure with reads left; finish them the blocking way
+    std::vector<ReadRequest*> remaining(continued.begin(), continued.end());
+    {
+        std::lock_guard<std::mutex> lock(_queueMutex);
+        remaining.insert(remaining.end(), _queue.begin(), _queue.end());
+        _queue.clear();
+    }
+    for (ReadRequest* request : remaining) {
+        readBlocking(*request);
+        complete(request);
+    }
+}
+
+#endif // PERS_HAS_IO_URING
+
+// ---- IOCP -------------------------------------------------------------------
+
+#if defined(_WIN32)
+
+bool AsyncFileReader::Impl::setupPort() {
+    _port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+    if (!_port) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AsyncFileReader", PERS_SOURCE_LOC,
+            "Failed to create completion port (error %d), using thread pool reads", lastError());
+        return false;
+    }
+    return true;
+}
+
+// Returns false if the read failed synchronously and was completed already
+bool AsyncFileReader::Impl::issueRead(ReadRequest* request) {
+    const uint64_t position = request->offset + request->done;
+    request->overlapped = {};
+    request->overlapped.Offset = static_cast<DWORD>(position);
+    request->overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+    _submitCalls.fetch_add(1, std::memory_order_relaxed);
+    // Completes through the port, synchronously finished reads included
+    if (!ReadFile(request->file, request->destination + request->done, static_cast<DWORD>(request->nextChunk()),
+                  nullptr, &request->overlapped)) {
+        const DWORD error = GetLastError();
+        if (error != ERROR_IO_PENDING) {
+            if (error != ERROR_HANDLE_EOF) {
+                request->error = static_cast<int>(error);
+            }
+            complete(request);
+            return false;
+        }
+    }
+    return true;
+}
+
+void AsyncFileReader::Impl::portLoop() {
+    Profiler::setThreadName("AsyncFileReader");
+    ThreadAffinity::applyCurrentThread(ThreadRole::IO);
+    uint32_t inFlight = 0;
+
+    for (;;) {
+        std::vector<ReadRequest*> issue;
+        bool stopping = false;
+        {
+            std::lock_guard<std::mutex> lock(_queueMutex);
+            while (inFlight + issue.size() < _desc.queueDepth && !_queue.empty()) {
+                issue.push_back(_queue.front());
+                _queue.pop_front();
+            }
+            stopping = _stopping && _queue.empty();
+        }
+        for (ReadRequest* request : issue) {
+            if (issueRead(request)) {
+                ++inFlight;
+            }
+        }
+        if (stopping && inFlight == 0) {
+            return;
+        }
+
+        DWORD transferred = 0;
+        ULONG_PTR key = 0;
+        OVERLAPPED* overlapped = nullptr;
+        const BOOL ok = GetQueuedCompletionStatus(_port, &transferred, &key, &overlapped, INFINITE);
+        if (!overlapped) {
+            continue;  // Wake packet
+        }
+
+        auto* request = reinterpret_cast<ReadRequest*>(overlapped);
+        --inFlight;
+        if (!ok) {
+            const DWORD error = GetLastError();
+            if (error != ERROR_HANDLE_EOF) {
+                request->error = static_cast<int>(error);
+            }
+        } else if (transferred > 0) {
+            request->done += transferred;
+            if (request->done < request->size) {
+                if (issueRead(request)) {
+                    ++inFlight;
+                }
+                continue;
+            }
+        }
+        complete(request);
+    }
+}
+
+#endif // _WIN32
+
+// ---- AsyncFileReader --------------------------------------------------------
+
+AsyncFileReader::AsyncFileReader()
+    : AsyncFileReader(Desc{}) {
+}
+
+AsyncFileReader::AsyncFileReader(const Desc& desc)
+    : _impl(std::make_unique<Impl>(desc)) {
+}
+
+AsyncFileReader::~AsyncFileReader() = default;
+
+bool AsyncFileReader::read(const std::string& path, uint64_t offset, uint64_t size, void* destination,
+                           Completion completion) {
+    if (!destination && size > 0) {
+        LOG_ERROR("AsyncFileReader", "Read destination is null");
+        return false;
+    }
+    return _impl->submit(path, offset, size, destination, std::move(completion), nullptr);
+}
+
+bool AsyncFileReader::readIntoStaging(const std::string& path, uint64_t offset, uint64_t size,
+                                      const std::shared_ptr<ImmediateStagingBuffer>& staging,
+                                      uint64_t stagingOffset, Completion completion) {
+    if (!staging || staging->isFinalized() || !staging->getMappedData()) {
+        LOG_ERROR("AsyncFileReader", "Staging buffer is not mapped");
+        return false;
+    }
+    if (stagingOffset + size > staging->getSize()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "AsyncFileReader", PERS_SOURCE_LOC,
+            "Read of %llu bytes at %llu exceeds staging buffer '%s'", static_cast<unsigned long long>(size),
+            static_cast<unsigned long long>(stagingOffset), staging->getDebugName().c_str());
+        return false;
+    }
+
+    auto* destination = static_cast<uint8_t*>(staging->getMappedData()) + stagingOffset;
+    return _impl->submit(path, offset, size, destination, std::move(completion), staging);
+}
+
+void AsyncFileReader::closeFile(const std::string& path) {
+    _impl->closeFile(path);
+}
+
+void AsyncFileReader::waitIdle() {
+    _impl->waitIdle();
+}
+
+AsyncFileReader::Backend AsyncFileReader::getBackend() const {
+    return _impl->getBackend();
+}
+
+AsyncFileReader::Stats AsyncFileReader::getStats() const {
+    return _impl->getStats();
+}
+
+const char* AsyncFileReader::getBackendName(Backend backend) {
+    switch (backend) {
+        case Backend::IoUring: return "io_uring";
+        case Backend::CompletionPort: return "IOCP";
+        case Backend::ThreadPool: return "thread pool";
+        default: return "Unknown";
+    }
+}
+
+} // namespace pers
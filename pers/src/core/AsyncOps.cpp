@@ -0,0 +1,49 @@
+#include "pers/core/AsyncOps.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/utils/Logger.h"
+#include <fstream>
+
+namespace pers {
+
+Task<std::optional<std::vector<std::byte>>> readFileAsync(JobSystem& jobs, std::string path) {
+    co_await resumeOn(jobs);
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LOG_ERROR("AsyncOps", "Failed to open " + path);
+        co_return std::nullopt;
+    }
+
+    const std::streamsize size = file.tellg();
+    std::vector<std::byte> contents(static_cast<size_t>(size > 0 ? size : 0));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(contents.data()), size)) {
+        LOG_ERROR("AsyncOps", "Failed to read " + path);
+        co_return std::nullopt;
+    }
+    co_return contents;
+}
+
+Task<DeviceRequestResult> requestDeviceAsync(JobSystem& jobs, std::shared_ptr<IInstance> instance,
+                                             DeviceStartupDesc desc) {
+    co_await resumeOn(jobs);
+
+    DeviceRequestResult result;
+    if (!instance) {
+        LOG_ERROR("AsyncOps", "Instance is null");
+        co_return result;
+    }
+
+    result.physicalDevice = instance->requestPhysicalDevice(desc.physicalDevice);
+    if (!result.physicalDevice) {
+        LOG_ERROR("AsyncOps", "Failed to request physical device");
+        co_return result;
+    }
+    result.logicalDevice = result.physicalDevice->createLogicalDevice(desc.logicalDevice);
+    if (!result.logicalDevice) {
+        LOG_ERROR("AsyncOps", "Failed to create logical device");
+    }
+    co_return result;
+}
+
+} // namespace pers
@@ -0,0 +1,95 @@
+#include "pers/core/DamageTracker.h"
+#include <algorithm>
+
+namespace pers {
+
+namespace {
+
+DamageRect unite(const DamageRect& a, const DamageRect& b) {
+    const uint64_t right = std::max(uint64_t(a.x) + a.width, uint64_t(b.x) + b.width);
+    const uint64_t bottom = std::max(uint64_t(a.y) + a.height, uint64_t(b.y) + b.height);
+    DamageRect result;
+    result.x = std::min(a.x, b.x);
+    result.y = std::min(a.y, b.y);
+    result.width = static_cast<uint32_t>(std::min<uint64_t>(right - result.x, UINT32_MAX));
+    result.height = static_cast<uint32_t>(std::min<uint64_t>(bottom - result.y, UINT32_MAX));
+    return result;
+}
+
+DamageRect clip(const DamageRect& rect, uint32_t width, uint32_t height) {
+    if (rect.x >= width || rect.y >= height) {
+        return {};
+    }
+    DamageRect result = rect;
+    result.width = std::min(rect.width, width - rect.x);
+    result.height = std::min(rect.height, height - rect.y);
+    return result;
+}
+
+} // anonymous namespace
+
+void DamageTracker::invalidate() {
+    _fullFrame = true;
+    _rects.clear();
+}
+
+void DamageTracker::invalidate(const DamageRect& rect) {
+    if (_fullFrame || rect.isEmpty()) {
+        return;
+    }
+    if (_rects.size() < MAX_RECTS) {
+        _rects.push_back(rect);
+        return;
+    }
+    DamageRect bounds = rect;
+    for (const DamageRect& other : _rects) {
+        bounds = unite(bounds, other);
+    }
+    _rects.assign(1, bounds);
+}
+
+void DamageTracker::merge(const DamageTracker& other) {
+    if (other._fullFrame) {
+        invalidate();
+        return;
+    }
+    for (const DamageRect& rect : other._rects) {
+        invalidate(rect);
+    }
+}
+
+void DamageTracker::clear() {
+    _fullFrame = false;
+    _rects.clear();
+}
+
+std::vector<DamageRect> DamageTracker::getRects(uint32_t width, uint32_t height) const {
+    std::vector<DamageRect> rects;
+    if (_fullFrame) {
+        if (width > 0 && height > 0) {
+            rects.push_back({0, 0, width, height});
+        }
+        return rects;
+    }
+    for (const DamageRect& rect : _rects) {
+        const DamageRect clipped = clip(rect, width, height);
+        if (!clipped.isEmpty()) {
+            rects.push_back(clipped);
+        }
+    }
+    return rects;
+}
+
+DamageRect DamageTracker::getBounds(uint32_t width, uint32_t height) const {
+    const auto rects = getRects(width, height);
+    if (rects.empty()) {
+        return {};
+    }
+    DamageRect bounds = rects.front();
+    for (const DamageRect& rect : rects) {
+        bounds = unite(bounds, rect);
+    }
+    return bounds;
+}
+
+} // namespace pers
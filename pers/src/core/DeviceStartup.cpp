@@ -0,0 +1,124 @@
+#include "pers/core/DeviceStartup.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+
+namespace pers {
+
+DeviceStartup::~DeviceStartup() {
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+}
+
+void DeviceStartup::onDeviceReady(DeviceReadyCallback callback) {
+    if (isStarted()) {
+        LOG_ERROR("DeviceStartup", "Device ready callbacks must be added before begin()");
+        return;
+    }
+    if (callback) {
+        _callbacks.push_back(std::move(callback));
+    }
+}
+
+bool DeviceStartup::begin(const std::shared_ptr<IInstance>& instance, const DeviceStartupDesc& desc) {
+    if (isStarted()) {
+        LOG_ERROR("DeviceStartup", "Startup already began");
+        return false;
+    }
+
+    if (!instance) {
+        LOG_ERROR("DeviceStartup", "Instance is null");
+        return false;
+    }
+
+    if (desc.physicalDevice.compatibleSurface.isValid()) {
+        LOG_WARNING("DeviceStartup", "compatibleSurface is ignored, check supportsSurface() after the window exists");
+    }
+
+    _started = true;
+    _startTime = std::chrono::steady_clock::now();
+    _worker = std::thread(&DeviceStartup::run, this, instance, desc);
+    return true;
+}
+
+void DeviceStartup::run(std::shared_ptr<IInstance> instance, DeviceStartupDesc desc) {
+    PERS_PROFILE_SCOPE("DeviceStartup::run");
+
+    desc.physicalDevice.compatibleSurface = NativeSurfaceHandle(nullptr);
+
+    std::shared_ptr<IPhysicalDevice> physicalDevice = instance->requestPhysicalDevice(desc.physicalDevice);
+    std::shared_ptr<ILogicalDevice> logicalDevice;
+    if (!physicalDevice) {
+        LOG_ERROR("DeviceStartup", "Failed to request physical device");
+    } else {
+        logicalDevice = physicalDevice->createLogicalDevice(desc.logicalDevice);
+        if (!logicalDevice) {
+            LOG_ERROR("DeviceStartup", "Failed to create logical device");
+        }
+    }
+
+    // Kick off shader and pipeline compilation before the main thread asks for the device
+    if (logicalDevice) {
+        PERS_PROFILE_SCOPE("DeviceStartup::onDeviceReady");
+        for (const auto& callback : _callbacks) {
+            callback(logicalDevice);
+        }
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - _startTime);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _physicalDevice = std::move(physicalDevice);
+        _logicalDevice = std::move(logicalDevice);
+        _elapsed = elapsed;
+        _finished = true;
+    }
+    _done.notify_all();
+
+    LOG_DEBUG_FMT("DeviceStartup", "Device startup finished in {} us", elapsed.count());
+}
+
+std::shared_ptr<ILogicalDevice> DeviceStartup::wait() {
+    if (!isStarted()) {
+        LOG_ERROR("DeviceStartup", "wait() called before begin()");
+        return nullptr;
+    }
+
+    PERS_PROFILE_SCOPE("DeviceStartup::wait");
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _finished; });
+    }
+    if (_worker.joinable()) {
+        _worker.join();
+    }
+    return getLogicalDevice();
+}
+
+std::shared_ptr<IPhysicalDevice> DeviceStartup::getPhysicalDevice() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _physicalDevice;
+}
+
+std::shared_ptr<ILogicalDevice> DeviceStartup::getLogicalDevice() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _logicalDevice;
+}
+
+bool DeviceStartup::supportsSurface(const NativeSurfaceHandle& surface) {
+    if (!wait()) {
+        return false;
+    }
+
+    auto physicalDevice = getPhysicalDevice();
+    return physicalDevice && physicalDevice->supportsSurface(surface);
+}
+
+std::chrono::microseconds DeviceStartup::getElapsed() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _elapsed;
+}
+
+} // namespace pers
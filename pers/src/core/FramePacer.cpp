@@ -0,0 +1,162 @@
+#include "pers/core/FramePacer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <thread>
+
+namespace pers {
+
+namespace {
+
+// Weight of the newest sample in the smoothed timings
+constexpr double SMOOTHING = 0.1;
+
+// The OS scheduler overshoots short sleeps, spin through the last stretch
+constexpr std::chrono::microseconds SPIN_THRESHOLD{1000};
+
+double smooth(double average, double sample) {
+    return average == 0.0 ? sample : average + SMOOTHING * (sample - average);
+}
+
+} // anonymous namespace
+
+FramePacer::FramePacer(const FramePacerConfig& config) {
+    setConfig(config);
+}
+
+void FramePacer::setConfig(const FramePacerConfig& config) {
+    _config = config;
+    if (_config.maxFramesInFlight == 0) {
+        LOG_WARNING("FramePacer", "maxFramesInFlight 0 would never start a frame, using 1");
+        _config.maxFramesInFlight = 1;
+    }
+    _nextDeadline = {};
+}
+
+void FramePacer::sleepUntil(Clock::time_point deadline) {
+    // The idle wait may return early on its own events, keep waiting until the spin stretch
+    for (auto remaining = deadline - Clock::now(); remaining > SPIN_THRESHOLD; remaining = deadline - Clock::now()) {
+        const auto idle = remaining - SPIN_THRESHOLD;
+        if (_idleWait) {
+            _idleWait(std::chrono::duration<double>(idle).count());
+        } else {
+            std::this_thread::sleep_for(idle);
+        }
+    }
+    while (Clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::retire(const InFlightFrame& frame, Clock::time_point now) {
+    const double latency = std::chrono::duration<double, std::micro>(now - frame.submitted).count();
+    _gpuLatencyUs = smooth(_gpuLatencyUs, latency);
+}
+
+float FramePacer::beginFrame() {
+    const auto waitStart = Clock::now();
+
+    // Drop frames the GPU already finished, then block on the oldest until
+    // there is room for this one. Fences are waited on outside the lock so
+    // the render thread can keep submitting.
+    const size_t limit = _config.lowLatency ? 1 : _config.maxFramesInFlight;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_inFlight.empty()) {
+        if (_inFlight.front().fence.isComplete()) {
+            retire(_inFlight.front(), Clock::now());
+            _inFlight.pop_front();
+            continue;
+        }
+        if (_inFlight.size() < limit) {
+            break;
+        }
+        const SubmissionFence oldest = _inFlight.front().fence;
+        lock.unlock();
+        const bool completed = oldest.wait();
+        lock.lock();
+        if (!completed) {
+            LOG_WARNING("FramePacer", "In-flight frame did not complete, dropping it from pacing");
+        }
+        // The render thread may have replaced the fence with a later one of the same frame
+        if (!_inFlight.empty() && _inFlight.front().fence.getValue() == oldest.getValue()) {
+            retire(_inFlight.front(), Clock::now());
+            _inFlight.pop_front();
+        }
+    }
+    if (!_renderThreadSubmissions) {
+        _submittedThisFrame = false;
+    }
+    lock.unlock();
+
+    // Frame cap; in low latency mode start early enough that CPU work ends at the deadline
+    if (_config.targetFps > 0.0) {
+        const auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(1.0 / _config.targetFps));
+        const auto now = Clock::now();
+        if (_nextDeadline == Clock::time_point{} || now > _nextDeadline + interval) {
+            // First frame or fell behind by a whole interval: don't try to catch up
+            _nextDeadline = now;
+        }
+
+        auto start = _nextDeadline;
+        if (_config.lowLatency) {
+            const auto predicted = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::micro>(_cpuTimeUs)) + _config.lowLatencyMargin;
+            start -= std::min<Clock::duration>(predicted, interval);
+        }
+        sleepUntil(start);
+        _nextDeadline += interval;
+    }
+
+    const auto now = Clock::now();
+    _waitTimeUs = std::chrono::duration<double, std::micro>(now - waitStart).count();
+
+    float deltaTime = _started ? std::chrono::duration<float>(now - _frameStart).count() : 0.0f;
+    _frameStart = now;
+    _started = true;
+    return deltaTime;
+}
+
+void FramePacer::trackSubmission(const SubmissionFence& fence) {
+    if (!fence) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Queues retire in order, the last fence of the frame covers the earlier ones
+    if (_submittedThisFrame && !_inFlight.empty()) {
+        _inFlight.back().fence = fence;
+        return;
+    }
+    _inFlight.push_back(InFlightFrame{fence, Clock::now()});
+    _submittedThisFrame = true;
+}
+
+void FramePacer::endFrame() {
+    if (!_started) {
+        return;
+    }
+    const double cpuTime = std::chrono::duration<double, std::micro>(Clock::now() - _frameStart).count();
+    _cpuTimeUs = smooth(_cpuTimeUs, cpuTime);
+}
+
+void FramePacer::endSubmissions() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _submittedThisFrame = false;
+}
+
+void FramePacer::setRenderThreadSubmissions(bool enabled) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _renderThreadSubmissions = enabled;
+    _submittedThisFrame = false;
+}
+
+FramePacer::Stats FramePacer::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats;
+    stats.cpuTimeMs = _cpuTimeUs / 1000.0;
+    stats.gpuLatencyMs = _gpuLatencyUs / 1000.0;
+    stats.waitTimeMs = _waitTimeUs / 1000.0;
+    stats.framesInFlight = static_cast<uint32_t>(_inFlight.size());
+    return stats;
+}
+
+} // namespace pers
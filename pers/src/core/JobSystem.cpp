@@ -0,0 +1,228 @@
+#include "pers/core/JobSystem.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/ThreadAffinity.h"
+#include <string>
+
+namespace pers {
+
+namespace {
+
+// Lets schedule() and wait() on a worker use that worker's own deque
+thread_local const JobSystem* t_system = nullptr;
+thread_local uint32_t t_queue = 0;
+
+} // namespace
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    if (workerCount == 0) {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    _queues.reserve(workerCount + 1);
+    for (uint32_t i = 0; i <= workerCount; ++i) {
+        _queues.push_back(std::make_unique<WorkQueue>());
+    }
+    _workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        _workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+uint32_t JobSystem::currentQueue() const {
+    return t_system == this ? t_queue : 0;
+}
+
+JobHandle JobSystem::schedule(std::function<void()> task, std::span<const JobHandle> dependencies) {
+    auto job = std::make_shared<detail::Job>();
+    job->task = std::move(task);
+    _unfinishedJobs.fetch_add(1);
+
+    for (const auto& dependency : dependencies) {
+        if (!dependency._job) {
+            continue;
+        }
+        // finished is set under the same lock, so the dependency either sees
+        // this job in its list or was already done
+        std::lock_guard<std::mutex> lock(dependency._job->dependentsMutex);
+        if (!dependency._job->finished.load()) {
+            job->pendingDependencies.fetch_add(1);
+            dependency._job->dependents.push_back(job);
+        }
+    }
+
+    release(job);
+    return JobHandle(std::move(job));
+}
+
+JobHandle JobSystem::parallelFor(uint32_t count, uint32_t batchSize, ParallelForTask task,
+                                 std::span<const JobHandle> dependencies) {
+    if (count == 0) {
+        return schedule([] {}, dependencies);
+    }
+    batchSize = batchSize == 0 ? 1 : batchSize;
+
+    // Batches share the task; the returned job completes after all of them
+    auto shared = std::make_shared<ParallelForTask>(std::move(task));
+    std::vector<JobHandle> batches;
+    batches.reserve((count + batchSize - 1) / batchSize);
+    for (uint32_t begin = 0; begin < count; begin += batchSize) {
+        const uint32_t end = count - begin > batchSize ? begin + batchSize : count;
+        batches.push_back(schedule([shared, begin, end] { (*shared)(begin, end); }, dependencies));
+    }
+    return schedule([] {}, batches);
+}
+
+void JobSystem::release(const std::shared_ptr<detail::Job>& job) {
+    if (job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        enqueue(job);
+    }
+}
+
+void JobSystem::enqueue(std::shared_ptr<detail::Job> job) {
+    // Counted before the push so the count never lags the deques
+    _queuedJobs.fetch_add(1);
+    WorkQueue& queue = *_queues[currentQueue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(std::move(job));
+    }
+
+    // Taking the lock orders the notify after a sleeper's last check
+    const bool sleepers = _sleepers.load() > 0;
+    const bool waiters = _waiters.load() > 0;
+    if (sleepers || waiters) {
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        if (sleepers) {
+            _wake.notify_one();
+        }
+        if (waiters) {
+            _completed.notify_all();
+        }
+    }
+}
+
+std::shared_ptr<detail::Job> JobSystem::take(uint32_t queueIndex) {
+    std::shared_ptr<detail::Job> job;
+    {
+        // Own deque newest first; the shared deque is drained in order
+        WorkQueue& own = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            if (queueIndex == 0) {
+                job = std::move(own.jobs.front());
+                own.jobs.pop_front();
+            } else {
+                job = std::move(own.jobs.back());
+                own.jobs.pop_back();
+            }
+        }
+    }
+
+    // Steal the oldest, typically largest, job from the other deques
+    const uint32_t queueCount = static_cast<uint32_t>(_queues.size());
+    for (uint32_t offset = 1; !job && offset < queueCount; ++offset) {
+        WorkQueue& victim = *_queues[(queueIndex + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (job) {
+        _queuedJobs.fetch_sub(1);
+    }
+    return job;
+}
+
+bool JobSystem::runOne(uint32_t queueIndex) {
+    auto job = take(queueIndex);
+    if (!job) {
+        return false;
+    }
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const std::shared_ptr<detail::Job>& job) {
+    job->task();
+    job->task = nullptr;  // Release captures before dependents run
+
+    std::vector<std::shared_ptr<detail::Job>> dependents;
+    {
+        std::lock_guard<std::mutex> lock(job->dependentsMutex);
+        job->finished.store(true);
+        dependents.swap(job->dependents);
+    }
+    for (const auto& dependent : dependents) {
+        release(dependent);
+    }
+    _unfinishedJobs.fetch_sub(1);
+
+    if (_waiters.load() > 0) {
+        { std::lock_guard<std::mutex> lock(_sleepMutex); }
+        _completed.notify_all();
+    }
+}
+
+void JobSystem::sleepUntil(std::condition_variable& condition, std::atomic<uint32_t>& sleepers,
+                           const std::function<bool()>& ready) {
+    std::unique_lock<std::mutex> lock(_sleepMutex);
+    sleepers.fetch_add(1);
+    condition.wait(lock, [&] { return ready() || _queuedJobs.load() > 0; });
+    sleepers.fetch_sub(1);
+}
+
+void JobSystem::wait(const JobHandle& handle) {
+    if (!handle._job) {
+        return;
+    }
+    const uint32_t queueIndex = currentQueue();
+    const auto& job = handle._job;
+    while (!job->finished.load()) {
+        if (!runOne(queueIndex)) {
+            sleepUntil(_completed, _waiters, [&] { return job->finished.load(); });
+        }
+    }
+}
+
+void JobSystem::waitIdle() {
+    const uint32_t queueIndex = currentQueue();
+    while (_unfinishedJobs.load() > 0) {
+        if (!runOne(queueIndex)) {
+            sleepUntil(_completed, _waiters, [&] { return _unfinishedJobs.load() == 0; });
+        }
+    }
+}
+
+void JobSystem::workerLoop(uint32_t queueIndex) {
+    t_system = this;
+    t_queue = queueIndex;
+    Profiler::setThreadName("Job Worker " + std::to_string(queueIndex));
+    ThreadAffinity::applyCurrentThread(ThreadRole::Worker, queueIndex - 1);
+
+    while (true) {
+        if (runOne(queueIndex)) {
+            continue;
+        }
+        if (_stopping.load()) {
+            return;
+        }
+        sleepUntil(_wake, _sleepers, [&] { return _stopping.load(); });
+    }
+}
+
+} // namespace pers
@@ -0,0 +1,64 @@
+#include "pers/core/RenderThread.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/ThreadAffinity.h"
+
+namespace pers {
+
+RenderThread::RenderThread()
+    : _thread(&RenderThread::threadLoop, this) {
+}
+
+RenderThread::~RenderThread() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [&] { return !_busy; });
+        _stopping = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+}
+
+void RenderThread::submit(std::function<void()> frame) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [&] { return !_busy; });
+        _frame = std::move(frame);
+        _busy = true;
+    }
+    _wake.notify_one();
+}
+
+void RenderThread::wait() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [&] { return !_busy; });
+}
+
+bool RenderThread::isBusy() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _busy;
+}
+
+void RenderThread::threadLoop() {
+    Profiler::setThreadName("Render Thread");
+    ThreadAffinity::applyCurrentThread(ThreadRole::Render);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [&] { return _stopping || _busy; });
+        if (_stopping) {
+            return;
+        }
+        auto frame = std::move(_frame);
+        _frame = nullptr;
+        lock.unlock();
+
+        frame();
+        frame = nullptr;  // Release captures before reporting idle
+
+        lock.lock();
+        _busy = false;
+        _idle.notify_all();
+    }
+}
+
+} // namespace pers
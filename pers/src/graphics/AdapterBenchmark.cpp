@@ -0,0 +1,392 @@
+#include "pers/graphics/AdapterBenchmark.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/PipelineDiskCache.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+namespace pers {
+
+namespace {
+
+constexpr char FILE_MAGIC[] = "PERSADBM";
+constexpr TextureFormat TARGET_FORMAT = TextureFormat::RGBA8Unorm;
+
+const char* FILL_VERTEX_SHADER = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* FILL_FRAGMENT_SHADER = R"(
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    return vec4<f32>(fract(position.xy * 0.01), 0.5, 1.0);
+}
+)";
+
+using Clock = std::chrono::steady_clock;
+using RecordFunction = std::function<bool(ICommandEncoder& encoder)>;
+
+/**
+ * Best wall-clock time of one submission, after a warm-up that is not counted
+ */
+bool timeSubmission(ILogicalDevice& device, const RecordFunction& record,
+                    const AdapterBenchmark::Config& config, double& bestSeconds) {
+    auto queue = device.getQueue();
+    if (!queue) {
+        return false;
+    }
+
+    bestSeconds = 0.0;
+    for (uint32_t i = 0; i <= config.repetitions; ++i) {
+        auto encoder = device.createCommandEncoder();
+        if (!encoder || !record(*encoder)) {
+            return false;
+        }
+        auto commandBuffer = encoder->finish();
+        if (!commandBuffer) {
+            return false;
+        }
+
+        const auto start = Clock::now();
+        SubmissionFence fence = queue->submit(commandBuffer);
+        if (!fence || !fence.wait(config.timeout)) {
+            return false;
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (i > 0 && (bestSeconds == 0.0 || seconds < bestSeconds)) {
+            bestSeconds = seconds;
+        }
+    }
+    return bestSeconds > 0.0;
+}
+
+bool measureFillRate(ILogicalDevice& device, const AdapterBenchmark::Config& config, double& fillRate) {
+    const auto& factory = device.getResourceFactory();
+
+    OffscreenFramebufferConfig targetConfig;
+    targetConfig.width = config.targetSize;
+    targetConfig.height = config.targetSize;
+    targetConfig.colorFormats = {TARGET_FORMAT};
+    targetConfig.colorUsage = TextureUsage::RenderAttachment;
+    OffscreenFramebuffer framebuffer(factory, targetConfig);
+
+    ShaderModuleDesc vertexDesc;
+    vertexDesc.code = FILL_VERTEX_SHADER;
+    vertexDesc.stage = ShaderStage::Vertex;
+    vertexDesc.debugName = "AdapterBenchmarkVertex";
+    ShaderModuleDesc fragmentDesc;
+    fragmentDesc.code = FILL_FRAGMENT_SHADER;
+    fragmentDesc.stage = ShaderStage::Fragment;
+    fragmentDesc.debugName = "AdapterBenchmarkFragment";
+    auto vertexShader = factory->createShaderModule(vertexDesc);
+    auto fragmentShader = factory->createShaderModule(fragmentDesc);
+    if (!framebuffer.getColorAttachment(0) || !vertexShader || !fragmentShader) {
+        return false;
+    }
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertex = vertexShader;
+    pipelineDesc.fragment = fragmentShader;
+    pipelineDesc.primitive.topology = PrimitiveTopology::TriangleList;
+    pipelineDesc.primitive.cullMode = CullMode::None;
+    ColorTargetState colorTarget;
+    colorTarget.format = TARGET_FORMAT;
+    pipelineDesc.colorTargets.push_back(colorTarget);
+    pipelineDesc.debugName = "AdapterBenchmarkFill";
+    auto pipeline = factory->createRenderPipeline(pipelineDesc);
+    if (!pipeline) {
+        return false;
+    }
+
+    RenderPassColorAttachment color;
+    color.view = framebuffer.getColorAttachment(0);
+    color.loadOp = LoadOp::Clear;
+    color.storeOp = StoreOp::Store;
+    RenderPassDesc passDesc;
+    passDesc.colorAttachments.push_back(color);
+    passDesc.label = "AdapterBenchmarkFill";
+
+    // Each instance is one full-screen triangle, without depth every one is shaded
+    double seconds = 0.0;
+    bool measured = timeSubmission(device, [&](ICommandEncoder& encoder) {
+        auto pass = encoder.beginRenderPass(passDesc);
+        if (!pass) {
+            return false;
+        }
+        pass->setPipeline(pipeline);
+        pass->draw(3, config.fillDraws, 0, 0);
+        pass->end();
+        return true;
+    }, config, seconds);
+    if (!measured) {
+        return false;
+    }
+
+    const double pixels = static_cast<double>(config.targetSize) * config.targetSize * config.fillDraws;
+    fillRate = pixels / seconds / 1e9;
+    return true;
+}
+
+bool measureCopyBandwidth(const std::shared_ptr<ILogicalDevice>& device, const AdapterBenchmark::Config& config,
+                          double& copyBandwidth) {
+    auto source = std::make_shared<DeviceBuffer>();
+    auto destination = std::make_shared<DeviceBuffer>();
+    if (!source->create(config.copySize, DeviceBufferUsage::CopySrc, device, "AdapterBenchmarkCopySource") ||
+        !destination->create(config.copySize, DeviceBufferUsage::Storage, device, "AdapterBenchmarkCopyDestination")) {
+        return false;
+    }
+
+    BufferCopyDesc copyDesc;
+    copyDesc.size = config.copySize;
+
+    double seconds = 0.0;
+    bool measured = timeSubmission(*device, [&](ICommandEncoder& encoder) {
+        for (uint32_t i = 0; i < config.copiesPerSubmit; ++i) {
+            if (!encoder.copyDeviceToDevice(source, destination, copyDesc)) {
+                return false;
+            }
+        }
+        return true;
+    }, config, seconds);
+    if (!measured) {
+        return false;
+    }
+
+    const double bytes = static_cast<double>(config.copySize) * config.copiesPerSubmit;
+    copyBandwidth = bytes / seconds / 1e9;
+    return true;
+}
+
+} // anonymous namespace
+
+double AdapterBenchmarkResult::getScore() const {
+    if (!valid || fillRate <= 0.0 || copyBandwidth <= 0.0) {
+        return 0.0;
+    }
+    return std::sqrt(fillRate * copyBandwidth);
+}
+
+AdapterBenchmark::AdapterBenchmark(const std::string& cachePath)
+    : AdapterBenchmark(cachePath, Config{}) {
+}
+
+AdapterBenchmark::AdapterBenchmark(const std::string& cachePath, const Config& config)
+    : _cachePath(cachePath)
+    , _config(config) {
+}
+
+AdapterBenchmarkResult AdapterBenchmark::run(const std::shared_ptr<IPhysicalDevice>& physicalDevice,
+                                             const Config& config) {
+    AdapterBenchmarkResult result;
+    if (!physicalDevice) {
+        LOG_ERROR("AdapterBenchmark", "Physical device is null");
+        return result;
+    }
+
+    PERS_PROFILE_SCOPE("AdapterBenchmark::run");
+
+    const PhysicalDeviceCapabilities capabilities = physicalDevice->getCapabilities();
+    result.fingerprint = PipelineDiskCache::makeDeviceFingerprint(capabilities);
+    result.deviceName = capabilities.deviceName;
+
+    LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = false;
+    deviceDesc.debugName = "AdapterBenchmarkDevice";
+    deviceDesc.timeout = config.timeout;
+    auto device = physicalDevice->createLogicalDevice(deviceDesc);
+    if (!device) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "Could not create a device on %s", result.deviceName.c_str());
+        return result;
+    }
+
+    if (!measureFillRate(*device, config, result.fillRate) ||
+        !measureCopyBandwidth(device, config, result.copyBandwidth)) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "Benchmark failed on %s", result.deviceName.c_str());
+        device->waitIdle();
+        return result;
+    }
+
+    device->waitIdle();
+    result.valid = true;
+
+    Logger::Instance().LogFormat(LogLevel::Info, "AdapterBenchmark", PERS_SOURCE_LOC,
+        "%s: fill %.2f Gpix/s, copy %.2f GB/s", result.deviceName.c_str(), result.fillRate, result.copyBandwidth);
+    return result;
+}
+
+AdapterBenchmarkResult AdapterBenchmark::measure(const std::shared_ptr<IPhysicalDevice>& physicalDevice) {
+    if (!physicalDevice) {
+        LOG_ERROR("AdapterBenchmark", "Physical device is null");
+        return {};
+    }
+
+    const std::string fingerprint = PipelineDiskCache::makeDeviceFingerprint(physicalDevice->getCapabilities());
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _results.find(fingerprint);
+        if (it != _results.end()) {
+            return it->second;
+        }
+    }
+
+    // Failed runs are cached too, so a broken adapter is not retried every launch
+    AdapterBenchmarkResult result = run(physicalDevice, _config);
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _results[fingerprint] = result;
+    return result;
+}
+
+std::shared_ptr<IPhysicalDevice> AdapterBenchmark::selectBest(
+    const std::vector<std::shared_ptr<IPhysicalDevice>>& candidates) {
+    std::shared_ptr<IPhysicalDevice> best;
+    double bestScore = 0.0;
+
+    for (const auto& candidate : candidates) {
+        if (!candidate) {
+            continue;
+        }
+        const double score = measure(candidate).getScore();
+        if (score > bestScore) {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+
+    if (best) {
+        Logger::Instance().LogFormat(LogLevel::Info, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "Selected %s (score %.2f) out of %zu candidate(s)",
+            best->getCapabilities().deviceName.c_str(), bestScore, candidates.size());
+    }
+    return best;
+}
+
+size_t AdapterBenchmark::getCachedCount() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _results.size();
+}
+
+bool AdapterBenchmark::load() {
+    if (_cachePath.empty()) {
+        return false;
+    }
+
+    std::ifstream file(_cachePath);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Info, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "No adapter benchmark cache at %s", _cachePath.c_str());
+        return false;
+    }
+
+    std::string magic;
+    uint32_t version = 0;
+    file >> magic >> version;
+    if (!file || magic != FILE_MAGIC) {
+        LOG_WARNING("AdapterBenchmark", "Adapter benchmark cache has an invalid header, ignoring");
+        return false;
+    }
+    if (version != FORMAT_VERSION) {
+        LOG_INFO("AdapterBenchmark", "Adapter benchmark cache format version changed, ignoring");
+        return false;
+    }
+
+    // One tab-separated line per adapter: fingerprint, name, fill rate, copy bandwidth, valid
+    std::map<std::string, AdapterBenchmarkResult> results;
+    std::string line;
+    std::getline(file, line);
+    while (std::getline(file, line)) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::vector<std::string> fields;
+        std::stringstream ss(line);
+        std::string field;
+        while (std::getline(ss, field, '\t')) {
+            fields.push_back(field);
+        }
+        if (fields.size() != 5) {
+            LOG_WARNING("AdapterBenchmark", "Adapter benchmark cache is corrupt, ignoring");
+            return false;
+        }
+
+        AdapterBenchmarkResult result;
+        result.fingerprint = fields[0];
+        result.deviceName = fields[1];
+        try {
+            result.fillRate = std::stod(fields[2]);
+            result.copyBandwidth = std::stod(fields[3]);
+        } catch (const std::exception&) {
+            LOG_WARNING("AdapterBenchmark", "Adapter benchmark cache is corrupt, ignoring");
+            return false;
+        }
+        result.valid = fields[4] == "1";
+        results[result.fingerprint] = std::move(result);
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (auto& [fingerprint, result] : results) {
+        _results.insert_or_assign(fingerprint, std::move(result));
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "AdapterBenchmark", PERS_SOURCE_LOC,
+        "Loaded %zu adapter benchmark result(s) from %s", results.size(), _cachePath.c_str());
+    return true;
+}
+
+bool AdapterBenchmark::save() const {
+    if (_cachePath.empty()) {
+        return false;
+    }
+
+    std::ofstream file(_cachePath, std::ios::trunc);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "Failed to open %s for writing", _cachePath.c_str());
+        return false;
+    }
+
+    file << FILE_MAGIC << " " << FORMAT_VERSION << "\n";
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (const auto& [fingerprint, result] : _results) {
+        // Tabs would break the line format, such adapters are measured again next time
+        if (fingerprint.find_first_of("\t\n") != std::string::npos ||
+            result.deviceName.find_first_of("\t\n") != std::string::npos) {
+            continue;
+        }
+        file << fingerprint << "\t" << result.deviceName << "\t"
+             << result.fillRate << "\t" << result.copyBandwidth << "\t"
+             << (result.valid ? 1 : 0) << "\n";
+    }
+
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "AdapterBenchmark", PERS_SOURCE_LOC,
+            "Failed to write adapter benchmark cache to %s", _cachePath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,124 @@
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+AsyncRenderPipeline::AsyncRenderPipeline(const std::string& debugName, std::shared_ptr<IRenderPipeline> fallback)
+    : _debugName(debugName.empty() ? "AsyncRenderPipeline" : debugName)
+    , _fallback(std::move(fallback)) {
+}
+
+const std::string& AsyncRenderPipeline::getDebugName() const {
+    return _debugName;
+}
+
+bool AsyncRenderPipeline::isValid() const {
+    auto active = getActive();
+    return active && active->isValid();
+}
+
+RenderPipelineDesc AsyncRenderPipeline::getDesc() const {
+    auto active = getActive();
+    return active ? active->getDesc() : RenderPipelineDesc{};
+}
+
+NativePipelineHandle AsyncRenderPipeline::getNativePipelineHandle() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const auto& active = _state == State::Ready ? _pipeline : _fallback;
+    return active ? active->getNativePipelineHandle() : nullptr;
+}
+
+AsyncRenderPipeline::State AsyncRenderPipeline::getState() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state;
+}
+
+std::shared_ptr<IRenderPipeline> AsyncRenderPipeline::getActive() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _state == State::Ready ? _pipeline : _fallback;
+}
+
+std::shared_ptr<IRenderPipeline> AsyncRenderPipeline::getPipeline() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pipeline;
+}
+
+bool AsyncRenderPipeline::wait(std::chrono::milliseconds timeout) const {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_cv.wait_for(lock, timeout, [this]() { return _state != State::Pending; })) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AsyncRenderPipeline", PERS_SOURCE_LOC,
+            "Timed out waiting for pipeline: %s", _debugName.c_str());
+        return false;
+    }
+    return _state == State::Ready;
+}
+
+void AsyncRenderPipeline::then(ReadyCallback callback) {
+    if (!callback) {
+        return;
+    }
+
+    std::shared_ptr<IRenderPipeline> pipeline;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_state == State::Pending) {
+            _callbacks.push_back(std::move(callback));
+            return;
+        }
+        pipeline = _pipeline;
+    }
+
+    callback(pipeline);
+}
+
+void AsyncRenderPipeline::resolve(std::shared_ptr<IRenderPipeline> pipeline) {
+    std::vector<ReadyCallback> callbacks;
+    std::shared_ptr<IRenderPipeline> result;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_state != State::Pending) {
+            LOG_WARNING("AsyncRenderPipeline", "Pipeline resolved twice, ignoring");
+            return;
+        }
+
+        if (pipeline && pipeline->isValid()) {
+            _pipeline = std::move(pipeline);
+            _state = State::Ready;
+        } else {
+            _state = State::Failed;
+        }
+        result = _pipeline;
+        callbacks.swap(_callbacks);
+    }
+    _cv.notify_all();
+
+    if (!result) {
+        Logger::Instance().LogFormat(LogLevel::Error, "AsyncRenderPipeline", PERS_SOURCE_LOC,
+            "Async pipeline compilation failed: %s", _debugName.c_str());
+    }
+
+    // Callbacks run outside the lock so they may query or bind this pipeline
+    for (auto& callback : callbacks) {
+        callback(result);
+    }
+}
+
+bool AsyncRenderPipeline::replace(std::shared_ptr<IRenderPipeline> pipeline) {
+    if (!pipeline || !pipeline->isValid()) {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_state != State::Pending) {
+            _pipeline = std::move(pipeline);
+            _state = State::Ready;
+            return true;
+        }
+    }
+
+    resolve(std::move(pipeline));
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,401 @@
+#include "pers/graphics/AutoExposure.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct ExposureUniforms {
+    float minLogLuminance;
+    float logLuminanceRange;
+    float lowPercentile;
+    float highPercentile;
+    float adaptUp;      // Fraction of the gap closed this frame
+    float adaptDown;
+    float keyValue;
+    float minExposure;
+    float maxExposure;
+    uint32_t reset;
+    uint32_t width;
+    uint32_t height;
+};
+
+static_assert(AutoExposure::BIN_COUNT == 256 && AutoExposure::TILE_SIZE * AutoExposure::TILE_SIZE == AutoExposure::BIN_COUNT,
+              "The shaders bake in 256 bins, one per histogram invocation");
+
+constexpr char TYPES_WGSL[] = R"(
+const BIN_COUNT: u32 = 256u;
+
+struct ExposureUniforms {
+    minLogLuminance: f32,
+    logLuminanceRange: f32,
+    lowPercentile: f32,
+    highPercentile: f32,
+    adaptUp: f32,
+    adaptDown: f32,
+    keyValue: f32,
+    minExposure: f32,
+    maxExposure: f32,
+    reset: u32,
+    width: u32,
+    height: u32,
+};
+
+struct ExposureState {
+    averageLuminance: f32,
+    exposure: f32,
+    targetLuminance: f32,
+    sampleCount: u32,
+};
+
+@group(0) @binding(0) var<uniform> exposureUniforms: ExposureUniforms;
+)";
+
+using UniformsLayout = GpuStruct<GpuLayout::Std140, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32,
+                                 GpuF32, GpuU32, GpuU32, GpuU32>;
+static_assert(UniformsLayout::matchesWgsl(TYPES_WGSL, "ExposureUniforms"),
+              "ExposureUniforms no longer match the exposure shaders");
+static_assert(UniformsLayout::SIZE == sizeof(ExposureUniforms) &&
+              UniformsLayout::offsetOf<9>() == offsetof(ExposureUniforms, reset),
+              "ExposureUniforms must match the WGSL layout");
+
+using StateLayout = GpuStruct<GpuLayout::Std430, GpuF32, GpuF32, GpuF32, GpuU32>;
+static_assert(StateLayout::matchesWgsl(TYPES_WGSL, "ExposureState"), "ExposureState no longer matches the shaders");
+static_assert(StateLayout::SIZE == sizeof(AutoExposureState) &&
+              StateLayout::offsetOf<3>() == offsetof(AutoExposureState, sampleCount),
+              "AutoExposureState must match the WGSL layout");
+
+constexpr char HISTOGRAM_MAIN[] = R"(
+@group(0) @binding(1) var scene: texture_2d<f32>;
+@group(0) @binding(2) var<storage, read_write> histogram: array<atomic<u32>, BIN_COUNT>;
+
+var<workgroup> sharedBins: array<atomic<u32>, BIN_COUNT>;
+
+@compute @workgroup_size(16, 16)
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(local_invocation_index) localIndex: u32) {
+    atomicStore(&sharedBins[localIndex], 0u);
+    workgroupBarrier();
+
+    // Bin 0 also takes black and everything darker than the range
+    if (id.x < exposureUniforms.width && id.y < exposureUniforms.height) {
+        let color = textureLoad(scene, vec2<i32>(id.xy), 0).rgb;
+        let luminance = dot(color, vec3<f32>(0.2126, 0.7152, 0.0722));
+        let logLuminance = log2(max(luminance, 1e-10));
+        let t = clamp((logLuminance - exposureUniforms.minLogLuminance) / exposureUniforms.logLuminanceRange, 0.0, 1.0);
+        atomicAdd(&sharedBins[u32(t * f32(BIN_COUNT - 1u) + 0.5)], 1u);
+    }
+    workgroupBarrier();
+
+    let count = atomicLoad(&sharedBins[localIndex]);
+    if (count > 0u) {
+        atomicAdd(&histogram[localIndex], count);
+    }
+}
+)";
+
+constexpr char ADAPT_MAIN[] = R"(
+@group(0) @binding(1) var<storage, read_write> histogram: array<u32, BIN_COUNT>;
+@group(0) @binding(2) var<storage, read_write> exposureState: ExposureState;
+
+var<workgroup> sharedBins: array<u32, BIN_COUNT>;
+
+@compute @workgroup_size(256)
+fn main(@builtin(local_invocation_index) localIndex: u32) {
+    sharedBins[localIndex] = histogram[localIndex];
+    histogram[localIndex] = 0u;
+    workgroupBarrier();
+    if (localIndex != 0u) {
+        return;
+    }
+
+    var total = 0u;
+    for (var bin = 0u; bin < BIN_COUNT; bin = bin + 1u) {
+        total = total + sharedBins[bin];
+    }
+
+    // Average log luminance of the pixels ranked between the two percentiles
+    let low = f32(total) * exposureUniforms.lowPercentile;
+    let high = f32(total) * exposureUniforms.highPercentile;
+    var below = 0.0;
+    var weighted = 0.0;
+    var counted = 0.0;
+    for (var bin = 0u; bin < BIN_COUNT; bin = bin + 1u) {
+        let count = f32(sharedBins[bin]);
+        let inside = max(min(below + count, high) - max(below, low), 0.0);
+        let logLuminance = exposureUniforms.minLogLuminance +
+                           f32(bin) / f32(BIN_COUNT - 1u) * exposureUniforms.logLuminanceRange;
+        weighted = weighted + inside * logLuminance;
+        counted = counted + inside;
+        below = below + count;
+    }
+
+    var state = exposureState;
+    if (counted > 0.0) {
+        let targetLog = weighted / counted;
+        var adaptedLog = targetLog;
+        if (exposureUniforms.reset == 0u && state.averageLuminance > 0.0) {
+            let previousLog = log2(state.averageLuminance);
+            let rate = select(exposureUniforms.adaptDown, exposureUniforms.adaptUp, targetLog > previousLog);
+            adaptedLog = previousLog + (targetLog - previousLog) * rate;
+        }
+        state.targetLuminance = exp2(targetLog);
+        state.averageLuminance = exp2(adaptedLog);
+        state.exposure = clamp(exposureUniforms.keyValue / state.averageLuminance,
+                               exposureUniforms.minExposure, exposureUniforms.maxExposure);
+    }
+    state.sampleCount = u32(counted + 0.5);
+    exposureState = state;
+}
+)";
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           DeviceBufferUsage usage, const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, device, name)) {
+        LOG_ERROR("AutoExposure", "Failed to create exposure buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+std::shared_ptr<IComputePipeline> createPipeline(IResourceFactory& factory, const char* main,
+                                                 const std::shared_ptr<IBindGroupLayout>& layout, const char* name) {
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = std::string(TYPES_WGSL) + main;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.entryPoint = "main";
+    shaderDesc.debugName = name;
+    auto shader = factory.createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("AutoExposure", "Failed to create exposure shader");
+        return nullptr;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {layout};
+    pipelineLayoutDesc.debugName = name;
+
+    ComputePipelineDesc desc;
+    desc.compute = shader;
+    desc.layout = factory.createPipelineLayout(pipelineLayoutDesc);
+    desc.debugName = name;
+    auto pipeline = desc.layout ? factory.createComputePipeline(desc) : nullptr;
+    if (!pipeline) {
+        LOG_ERROR("AutoExposure", "Failed to create exposure pipeline");
+    }
+    return pipeline;
+}
+
+} // anonymous namespace
+
+AutoExposure::AutoExposure(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue) {
+        LOG_ERROR("AutoExposure", "Device, queue or resource factory is null");
+        return;
+    }
+
+    _uniformBuffer = createBuffer(device, sizeof(ExposureUniforms), DeviceBufferUsage::Uniform, "ExposureUniforms");
+    _histogramBuffer = createBuffer(device, BIN_COUNT * sizeof(uint32_t), DeviceBufferUsage::Storage,
+                                    "ExposureHistogram");
+    _stateBuffer = createBuffer(device, sizeof(AutoExposureState),
+                                DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc, "ExposureState");
+    if (!_uniformBuffer || !_histogramBuffer || !_stateBuffer) {
+        return;
+    }
+
+    // Tonemapping may read the state before the first execute()
+    const AutoExposureState initial;
+    if (!queue->writeBuffer(_stateBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&initial), sizeof(initial)))) {
+        LOG_ERROR("AutoExposure", "Failed to initialize exposure state");
+        return;
+    }
+
+    BindGroupLayoutDesc histogramLayoutDesc;
+    histogramLayoutDesc.debugName = "AutoExposure::Histogram";
+    histogramLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ExposureUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::SampledTexture},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer,
+         .minBindingSize = BIN_COUNT * sizeof(uint32_t)},
+    };
+    BindGroupLayoutDesc adaptLayoutDesc;
+    adaptLayoutDesc.debugName = "AutoExposure::Adapt";
+    adaptLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ExposureUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer,
+         .minBindingSize = BIN_COUNT * sizeof(uint32_t)},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer,
+         .minBindingSize = sizeof(AutoExposureState)},
+    };
+    _histogramLayout = factory->createBindGroupLayout(histogramLayoutDesc);
+    _adaptLayout = factory->createBindGroupLayout(adaptLayoutDesc);
+    if (!_histogramLayout || !_adaptLayout) {
+        LOG_ERROR("AutoExposure", "Failed to create bind group layouts");
+        return;
+    }
+
+    _histogramPipeline = createPipeline(*factory, HISTOGRAM_MAIN, _histogramLayout, "AutoExposure::Histogram");
+    _adaptPipeline = createPipeline(*factory, ADAPT_MAIN, _adaptLayout, "AutoExposure::Adapt");
+    if (!_histogramPipeline || !_adaptPipeline) {
+        return;
+    }
+
+    if (config.telemetry) {
+        auto readback = std::make_unique<ReadbackRing>(device, sizeof(AutoExposureState),
+                                                       ReadbackRing::DEFAULT_SLOT_COUNT, "AutoExposure Readback");
+        if (readback->getSlotCount() > 0) {
+            _readback = std::move(readback);
+        } else {
+            LOG_WARNING("AutoExposure", "Failed to create telemetry readback, state stays on the GPU");
+        }
+    }
+
+    // Created last, isValid() means both dispatches are usable
+    BindGroupDesc adaptDesc;
+    adaptDesc.layout = _adaptLayout;
+    adaptDesc.debugName = "AutoExposure::Adapt";
+    adaptDesc.entries.resize(3);
+    adaptDesc.entries[0].binding = 0;
+    adaptDesc.entries[0].buffer = _uniformBuffer;
+    adaptDesc.entries[0].size = sizeof(ExposureUniforms);
+    adaptDesc.entries[1].binding = 1;
+    adaptDesc.entries[1].buffer = _histogramBuffer;
+    adaptDesc.entries[2].binding = 2;
+    adaptDesc.entries[2].buffer = _stateBuffer;
+    _adaptBindGroup = factory->createBindGroup(adaptDesc);
+    if (!_adaptBindGroup) {
+        LOG_ERROR("AutoExposure", "Failed to create adaptation bind group");
+    }
+}
+
+AutoExposure::~AutoExposure() = default;
+
+bool AutoExposure::execute(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& sceneView,
+                           float deltaSeconds) {
+    PERS_PROFILE_SCOPE("AutoExposure::execute");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue || !isValid()) {
+        LOG_ERROR("AutoExposure", "Cannot execute invalid auto exposure");
+        return false;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    if (sceneView) {
+        sceneView->getDimensions(width, height);
+    }
+    if (width == 0 || height == 0) {
+        LOG_ERROR("AutoExposure", "Scene view is null or empty");
+        return false;
+    }
+
+    BindGroupDesc histogramDesc;
+    histogramDesc.layout = _histogramLayout;
+    histogramDesc.debugName = "AutoExposure::Histogram";
+    histogramDesc.entries.resize(3);
+    histogramDesc.entries[0].binding = 0;
+    histogramDesc.entries[0].buffer = _uniformBuffer;
+    histogramDesc.entries[0].size = sizeof(ExposureUniforms);
+    histogramDesc.entries[1].binding = 1;
+    histogramDesc.entries[1].textureView = sceneView;
+    histogramDesc.entries[2].binding = 2;
+    histogramDesc.entries[2].buffer = _histogramBuffer;
+    auto histogramBindGroup = factory->createBindGroup(histogramDesc);
+    if (!histogramBindGroup) {
+        LOG_ERROR("AutoExposure", "Failed to create histogram bind group");
+        return false;
+    }
+
+    // Exponential approach, frame-rate independent: the gap shrinks by exp(-speed * dt)
+    const float dt = std::max(deltaSeconds, 0.0f);
+    ExposureUniforms uniforms = {};
+    uniforms.minLogLuminance = _config.minLogLuminance;
+    uniforms.logLuminanceRange = std::max(_config.maxLogLuminance - _config.minLogLuminance, 1e-3f);
+    uniforms.lowPercentile = std::clamp(_config.lowPercentile, 0.0f, 1.0f);
+    uniforms.highPercentile = std::clamp(_config.highPercentile, uniforms.lowPercentile, 1.0f);
+    uniforms.adaptUp = 1.0f - std::exp(-std::max(_config.speedUp, 0.0f) * dt);
+    uniforms.adaptDown = 1.0f - std::exp(-std::max(_config.speedDown, 0.0f) * dt);
+    uniforms.keyValue = _config.keyValue;
+    uniforms.minExposure = _config.minExposure;
+    uniforms.maxExposure = std::max(_config.maxExposure, _config.minExposure);
+    uniforms.reset = _reset ? 1 : 0;
+    uniforms.width = width;
+    uniforms.height = height;
+    if (!queue->writeBuffer(_uniformBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&uniforms), sizeof(uniforms)))) {
+        LOG_ERROR("AutoExposure", "Failed to write exposure uniforms");
+        return false;
+    }
+
+    ComputePassDesc passDesc;
+    passDesc.label = "AutoExposure";
+    auto pass = encoder.beginComputePass(passDesc);
+    if (!pass) {
+        LOG_ERROR("AutoExposure", "Failed to begin exposure pass");
+        return false;
+    }
+    pass->setPipeline(_histogramPipeline);
+    pass->setBindGroup(0, histogramBindGroup);
+    pass->dispatch((width + TILE_SIZE - 1) / TILE_SIZE, (height + TILE_SIZE - 1) / TILE_SIZE);
+    pass->setPipeline(_adaptPipeline);
+    pass->setBindGroup(0, _adaptBindGroup);
+    pass->dispatch(1);
+    pass->end();
+
+    _reset = false;
+    return true;
+}
+
+bool AutoExposure::readback(const std::shared_ptr<ICommandEncoder>& encoder) {
+    if (!_readback || !encoder) {
+        return false;
+    }
+    return _readback->enqueue(encoder, _stateBuffer) != 0;
+}
+
+void AutoExposure::submitted() {
+    if (_readback) {
+        _readback->submitted();
+    }
+}
+
+size_t AutoExposure::collect() {
+    if (!_readback) {
+        return 0;
+    }
+    return _readback->harvest([this](uint64_t, const void* data, uint64_t size) {
+        if (size >= sizeof(AutoExposureState)) {
+            std::memcpy(&_lastState, data, sizeof(AutoExposureState));
+        }
+    });
+}
+
+} // namespace pers
@@ -0,0 +1,257 @@
+#include "pers/graphics/BindGroupCache.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+uint64_t BindGroupCache::computeLayoutHash(const BindGroupLayoutDesc& desc) {
+    Fnv1aHasher hasher;
+    hasher.add(desc.entries.size());
+    for (const auto& entry : desc.entries) {
+        hasher.add(entry.binding);
+        hasher.add(entry.visibility);
+        hasher.add(entry.type);
+        hasher.add(entry.hasDynamicOffset);
+        hasher.add(entry.minBindingSize);
+        hasher.add(entry.sampleType);
+        hasher.add(entry.viewDimension);
+        hasher.add(entry.multisampled);
+        hasher.add(entry.storageTextureFormat);
+        hasher.add(entry.count);
+    }
+    return hasher.get();
+}
+
+bool BindGroupCache::isEquivalent(const BindGroupLayoutDesc& a, const BindGroupLayoutDesc& b) {
+    return std::equal(a.entries.begin(), a.entries.end(), b.entries.begin(), b.entries.end(),
+        [](const BindGroupLayoutEntry& x, const BindGroupLayoutEntry& y) {
+            return x.binding == y.binding &&
+                   x.visibility == y.visibility &&
+                   x.type == y.type &&
+                   x.hasDynamicOffset == y.hasDynamicOffset &&
+                   x.minBindingSize == y.minBindingSize &&
+                   x.sampleType == y.sampleType &&
+                   x.viewDimension == y.viewDimension &&
+                   x.multisampled == y.multisampled &&
+                   x.storageTextureFormat == y.storageTextureFormat &&
+                   x.count == y.count;
+        });
+}
+
+BindGroupCache::BindingKeys BindGroupCache::makeBindingKeys(const BindGroupDesc& desc) {
+    BindingKeys keys;
+    keys.reserve(desc.entries.size());
+    for (const auto& entry : desc.entries) {
+        BindingKey key;
+        key.binding = entry.binding;
+        if (entry.buffer) {
+            // Views share a native buffer, the base offset keeps them apart
+            key.resource = entry.buffer->getNativeHandle().getRaw();
+            key.offset = entry.buffer->getNativeOffset() + entry.offset;
+            key.size = entry.size;
+        } else if (entry.textureView) {
+            key.resource = entry.textureView->getNativeTextureViewHandle().getRaw();
+        } else if (entry.sampler) {
+            key.resource = entry.sampler->getNativeSamplerHandle().getRaw();
+        }
+        for (const auto& buffer : entry.buffers) {
+            key.elements.push_back(buffer ? buffer->getNativeHandle().getRaw() : nullptr);
+        }
+        for (const auto& textureView : entry.textureViews) {
+            key.elements.push_back(textureView ? textureView->getNativeTextureViewHandle().getRaw() : nullptr);
+        }
+        for (const auto& sampler : entry.samplers) {
+            key.elements.push_back(sampler ? sampler->getNativeSamplerHandle().getRaw() : nullptr);
+        }
+        keys.push_back(std::move(key));
+    }
+
+    // Entry order does not matter to the backend
+    std::sort(keys.begin(), keys.end(),
+        [](const BindingKey& a, const BindingKey& b) { return a.binding < b.binding; });
+    return keys;
+}
+
+uint64_t BindGroupCache::computeBindGroupHash(const IBindGroupLayout* layout, const BindingKeys& bindings) {
+    Fnv1aHasher hasher;
+    hasher.add(layout);
+    for (const auto& key : bindings) {
+        hasher.add(key.binding);
+        hasher.add(key.resource);
+        hasher.add(key.offset);
+        hasher.add(key.size);
+        hasher.add(key.elements.size());
+        for (void* element : key.elements) {
+            hasher.add(element);
+        }
+    }
+    return hasher.get();
+}
+
+uint64_t BindGroupCache::computePipelineLayoutHash(const std::vector<const IBindGroupLayout*>& layouts,
+                                                   const std::vector<PushConstantRange>& pushConstantRanges) {
+    Fnv1aHasher hasher;
+    hasher.add(layouts.size());
+    for (const IBindGroupLayout* layout : layouts) {
+        hasher.add(layout);
+    }
+    hasher.add(pushConstantRanges.size());
+    for (const PushConstantRange& range : pushConstantRanges) {
+        hasher.add(range.stages);
+        hasher.add(range.offset);
+        hasher.add(range.size);
+    }
+    return hasher.get();
+}
+
+std::shared_ptr<IBindGroupLayout> BindGroupCache::getOrCreateLayout(const BindGroupLayoutDesc& desc,
+                                                                    const LayoutCreateFunction& create) {
+    const uint64_t hash = computeLayoutHash(desc);
+    auto isSame = [&](const LayoutEntry& entry) { return isEquivalent(entry.desc, desc); };
+
+    std::shared_ptr<IBindGroupLayout> existing;
+    if (_layouts.visit(hash, [&](const LayoutEntry& entry) { return isSame(entry) && (existing = entry.layout, true); })) {
+        _layoutHits.fetch_add(1, std::memory_order_relaxed);
+        return existing;
+    }
+    _layoutMisses.fetch_add(1, std::memory_order_relaxed);
+
+    if (!create) {
+        LOG_ERROR("BindGroupCache", "Layout create function is null");
+        return nullptr;
+    }
+
+    auto layout = create(desc);
+    if (!layout) {
+        return nullptr;
+    }
+
+    bool existed = false;
+    auto cached = _layouts.insert(hash, LayoutEntry{desc, layout}, [&](const LayoutEntry& entry) {
+        return existed = isSame(entry);
+    });
+    if (!existed) {
+        _layoutCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return cached.layout;
+}
+
+std::shared_ptr<IBindGroup> BindGroupCache::getOrCreateBindGroup(const BindGroupDesc& desc,
+                                                                 const BindGroupCreateFunction& create) {
+    if (!desc.layout) {
+        LOG_ERROR("BindGroupCache", "Bind group desc has no layout");
+        return nullptr;
+    }
+
+    BindingKeys bindings = makeBindingKeys(desc);
+    const uint64_t hash = computeBindGroupHash(desc.layout.get(), bindings);
+
+    // Bind groups hold their layout, so a live entry's layout pointer cannot be recycled
+    auto isSame = [&](const BindGroupEntry& entry) {
+        return entry.layout == desc.layout.get() && entry.bindings == bindings;
+    };
+
+    std::shared_ptr<IBindGroup> existing;
+    if (_bindGroups.visit(hash, [&](const BindGroupEntry& entry) { return isSame(entry) && (existing = entry.bindGroup, true); })) {
+        _bindGroupHits.fetch_add(1, std::memory_order_relaxed);
+        return existing;
+    }
+    _bindGroupMisses.fetch_add(1, std::memory_order_relaxed);
+
+    if (!create) {
+        LOG_ERROR("BindGroupCache", "Bind group create function is null");
+        return nullptr;
+    }
+
+    auto bindGroup = create(desc);
+    if (!bindGroup) {
+        return nullptr;
+    }
+
+    bool existed = false;
+    auto cached = _bindGroups.insert(hash, BindGroupEntry{desc.layout.get(), bindings, bindGroup},
+                                     [&](const BindGroupEntry& entry) { return existed = isSame(entry); });
+    if (!existed) {
+        _bindGroupCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return cached.bindGroup;
+}
+
+std::shared_ptr<IPipelineLayout> BindGroupCache::getOrCreatePipelineLayout(const PipelineLayoutDesc& desc,
+                                                                          const PipelineLayoutCreateFunction& create) {
+    std::vector<const IBindGroupLayout*> layouts;
+    layouts.reserve(desc.bindGroupLayouts.size());
+    for (const auto& layout : desc.bindGroupLayouts) {
+        layouts.push_back(layout.get());
+    }
+    const uint64_t hash = computePipelineLayoutHash(layouts, desc.pushConstantRanges);
+
+    // Cached layouts hold their bind group layouts, so the pointers cannot be recycled
+    auto isSame = [&](const std::shared_ptr<IPipelineLayout>& pipelineLayout) {
+        const auto& cached = pipelineLayout->getDesc();
+        return cached.pushConstantRanges == desc.pushConstantRanges &&
+               std::equal(cached.bindGroupLayouts.begin(), cached.bindGroupLayouts.end(), layouts.begin(), layouts.end(),
+                          [](const auto& a, const IBindGroupLayout* b) { return a.get() == b; });
+    };
+
+    std::shared_ptr<IPipelineLayout> existing;
+    if (_pipelineLayouts.visit(hash, [&](const std::shared_ptr<IPipelineLayout>& pipelineLayout) {
+            return isSame(pipelineLayout) && (existing = pipelineLayout, true);
+        })) {
+        _pipelineLayoutHits.fetch_add(1, std::memory_order_relaxed);
+        return existing;
+    }
+    _pipelineLayoutMisses.fetch_add(1, std::memory_order_relaxed);
+
+    if (!create) {
+        LOG_ERROR("BindGroupCache", "Pipeline layout create function is null");
+        return nullptr;
+    }
+
+    auto pipelineLayout = create(desc);
+    if (!pipelineLayout) {
+        return nullptr;
+    }
+
+    bool existed = false;
+    auto cached = _pipelineLayouts.insert(hash, pipelineLayout,
+                                          [&](const std::shared_ptr<IPipelineLayout>& entry) { return existed = isSame(entry); });
+    if (!existed) {
+        _pipelineLayoutCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return cached;
+}
+
+size_t BindGroupCache::trim() {
+    const size_t released = _bindGroups.removeIf(
+        [](const BindGroupEntry& entry) { return entry.bindGroup.use_count() <= 1; });
+    _bindGroupCount.fetch_sub(released, std::memory_order_relaxed);
+    return released;
+}
+
+void BindGroupCache::clear() {
+    // Bind groups first, they reference the layouts
+    _bindGroupCount.fetch_sub(_bindGroups.clear(), std::memory_order_relaxed);
+    _pipelineLayoutCount.fetch_sub(_pipelineLayouts.clear(), std::memory_order_relaxed);
+    _layoutCount.fetch_sub(_layouts.clear(), std::memory_order_relaxed);
+}
+
+BindGroupCache::Stats BindGroupCache::getStats() const {
+    Stats stats;
+    stats.layoutHits = _layoutHits.load(std::memory_order_relaxed);
+    stats.layoutMisses = _layoutMisses.load(std::memory_order_relaxed);
+    stats.bindGroupHits = _bindGroupHits.load(std::memory_order_relaxed);
+    stats.bindGroupMisses = _bindGroupMisses.load(std::memory_order_relaxed);
+    stats.pipelineLayoutHits = _pipelineLayoutHits.load(std::memory_order_relaxed);
+    stats.pipelineLayoutMisses = _pipelineLayoutMisses.load(std::memory_order_relaxed);
+    stats.layouts = _layoutCount.load(std::memory_order_relaxed);
+    stats.bindGroups = _bindGroupCount.load(std::memory_order_relaxed);
+    stats.pipelineLayouts = _pipelineLayoutCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace pers
@@ -0,0 +1,283 @@
+#include "pers/graphics/BindlessTable.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+std::vector<DeviceFeature> BindlessTable::getRequiredFeatures() {
+    return {DeviceFeature::TextureBindingArray, DeviceFeature::NonUniformIndexing};
+}
+
+bool BindlessTable::isSupported(const std::shared_ptr<ILogicalDevice>& device) {
+    if (!device) {
+        return false;
+    }
+    const auto features = getRequiredFeatures();
+    return std::all_of(features.begin(), features.end(),
+                       [&](DeviceFeature feature) { return device->hasFeature(feature); });
+}
+
+std::unique_ptr<BindlessTable> BindlessTable::create(const std::shared_ptr<ILogicalDevice>& device,
+                                                     const Config& config) {
+    if (!device) {
+        LOG_ERROR("BindlessTable", "Device is null");
+        return nullptr;
+    }
+    if (!isSupported(device)) {
+        LOG_WARNING("BindlessTable", "Device has no texture binding arrays, keep per-material bind groups");
+        return nullptr;
+    }
+    if (config.maxTextures == 0 || config.maxSamplers == 0 || config.maxMaterials == 0 ||
+        config.materialSize == 0 || config.materialSize % 16 != 0) {
+        LOG_ERROR("BindlessTable", "Capacities must be non-zero and materialSize a multiple of 16");
+        return nullptr;
+    }
+
+    const DeviceLimits limits = device->getLimits();
+    const uint64_t materialBytes = static_cast<uint64_t>(config.maxMaterials) * config.materialSize;
+    if (materialBytes > limits.maxStorageBufferBindingSize) {
+        Logger::Instance().LogFormat(LogLevel::Error, "BindlessTable", PERS_SOURCE_LOC,
+            "Material buffer of %llu bytes exceeds maxStorageBufferBindingSize %llu",
+            static_cast<unsigned long long>(materialBytes),
+            static_cast<unsigned long long>(limits.maxStorageBufferBindingSize));
+        return nullptr;
+    }
+
+    std::unique_ptr<BindlessTable> table(new BindlessTable(device, config));
+    if (!table->initialize()) {
+        return nullptr;
+    }
+    return table;
+}
+
+BindlessTable::BindlessTable(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+}
+
+BindlessTable::~BindlessTable() = default;
+
+bool BindlessTable::initialize() {
+    auto device = _device.lock();
+    const auto& factory = device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("BindlessTable", "Failed to get resource factory");
+        return false;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = _config.debugName;
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = _config.visibility, .type = BindingType::ReadOnlyStorageBuffer,
+         .minBindingSize = _config.materialSize},
+        {.binding = 1, .visibility = _config.visibility, .type = BindingType::SampledTexture,
+         .count = _config.maxTextures},
+        {.binding = 2, .visibility = _config.visibility, .type = BindingType::Sampler,
+         .count = _config.maxSamplers},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+    if (!_layout) {
+        LOG_ERROR("BindlessTable", "Failed to create bind group layout");
+        return false;
+    }
+
+    _materialBuffer = std::make_shared<DeviceBuffer>();
+    const uint64_t materialBytes = static_cast<uint64_t>(_config.maxMaterials) * _config.materialSize;
+    if (!_materialBuffer->create(materialBytes, DeviceBufferUsage::Storage, device, _config.debugName + "Materials")) {
+        LOG_ERROR("BindlessTable", "Failed to create material buffer");
+        return false;
+    }
+
+    // Free slots point at these so every array element is always bound
+    TextureDesc textureDesc;
+    textureDesc.format = TextureFormat::RGBA8Unorm;
+    textureDesc.usage = TextureUsage::TextureBinding;
+    textureDesc.label = _config.debugName + "Placeholder";
+    _placeholderTexture = factory->createTexture(textureDesc);
+    if (_placeholderTexture) {
+        TextureViewDesc viewDesc;
+        viewDesc.format = TextureFormat::RGBA8Unorm;
+        viewDesc.label = _config.debugName + "Placeholder";
+        _placeholderView = factory->createTextureView(_placeholderTexture, viewDesc);
+    }
+    SamplerDesc samplerDesc;
+    samplerDesc.label = _config.debugName + "Placeholder";
+    _placeholderSampler = factory->createSampler(samplerDesc);
+    if (!_placeholderView || !_placeholderSampler) {
+        LOG_ERROR("BindlessTable", "Failed to create placeholder texture or sampler");
+        return false;
+    }
+
+    _textures.assign(_config.maxTextures, _placeholderView);
+    _samplers.assign(_config.maxSamplers, _placeholderSampler);
+    _scratch.resize(_config.materialSize);
+    return true;
+}
+
+uint32_t BindlessTable::allocateSlot(std::vector<uint32_t>& freeSlots, uint32_t& nextSlot, uint32_t capacity) {
+    if (!freeSlots.empty()) {
+        const uint32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    if (nextSlot < capacity) {
+        return nextSlot++;
+    }
+    return INVALID_INDEX;
+}
+
+uint32_t BindlessTable::addTexture(const std::shared_ptr<ITextureView>& textureView) {
+    if (!textureView) {
+        LOG_ERROR("BindlessTable", "Texture view is null");
+        return INVALID_INDEX;
+    }
+    const uint32_t index = allocateSlot(_freeTextures, _nextTexture, _config.maxTextures);
+    if (index == INVALID_INDEX) {
+        LOG_WARNING("BindlessTable", "Texture array is full");
+        return INVALID_INDEX;
+    }
+    _textures[index] = textureView;
+    ++_textureCount;
+    _dirty = true;
+    return index;
+}
+
+uint32_t BindlessTable::addSampler(const std::shared_ptr<ISampler>& sampler) {
+    if (!sampler) {
+        LOG_ERROR("BindlessTable", "Sampler is null");
+        return INVALID_INDEX;
+    }
+    const uint32_t index = allocateSlot(_freeSamplers, _nextSampler, _config.maxSamplers);
+    if (index == INVALID_INDEX) {
+        LOG_WARNING("BindlessTable", "Sampler array is full");
+        return INVALID_INDEX;
+    }
+    _samplers[index] = sampler;
+    ++_samplerCount;
+    _dirty = true;
+    return index;
+}
+
+void BindlessTable::removeTexture(uint32_t index) {
+    if (index >= _nextTexture || _textures[index] == _placeholderView) {
+        return;
+    }
+    _textures[index] = _placeholderView;
+    _freeTextures.push_back(index);
+    --_textureCount;
+    _dirty = true;
+}
+
+void BindlessTable::removeSampler(uint32_t index) {
+    if (index >= _nextSampler || _samplers[index] == _placeholderSampler) {
+        return;
+    }
+    _samplers[index] = _placeholderSampler;
+    _freeSamplers.push_back(index);
+    --_samplerCount;
+    _dirty = true;
+}
+
+uint32_t BindlessTable::addMaterial(std::span<const std::byte> data) {
+    if (data.size() > _config.materialSize) {
+        LOG_ERROR("BindlessTable", "Material data is larger than materialSize");
+        return INVALID_INDEX;
+    }
+    const uint32_t id = allocateSlot(_freeMaterials, _nextMaterial, _config.maxMaterials);
+    if (id == INVALID_INDEX) {
+        LOG_WARNING("BindlessTable", "Material buffer is full");
+        return INVALID_INDEX;
+    }
+    if (!writeMaterial(id, data)) {
+        _freeMaterials.push_back(id);
+        return INVALID_INDEX;
+    }
+    ++_materialCount;
+    return id;
+}
+
+bool BindlessTable::updateMaterial(uint32_t id, std::span<const std::byte> data) {
+    if (id >= _nextMaterial || data.size() > _config.materialSize) {
+        LOG_ERROR("BindlessTable", "Invalid material id or data larger than materialSize");
+        return false;
+    }
+    return writeMaterial(id, data);
+}
+
+void BindlessTable::removeMaterial(uint32_t id) {
+    if (id >= _nextMaterial) {
+        return;
+    }
+    // The record stays in the buffer until the slot is reused
+    _freeMaterials.push_back(id);
+    --_materialCount;
+}
+
+bool BindlessTable::writeMaterial(uint32_t id, std::span<const std::byte> data) {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        LOG_ERROR("BindlessTable", "Failed to get queue from device");
+        return false;
+    }
+
+    // Whole records keep the write 4-byte sized and clear what the last occupant left
+    std::memcpy(_scratch.data(), data.data(), data.size());
+    std::memset(_scratch.data() + data.size(), 0, _scratch.size() - data.size());
+    const uint64_t offset = static_cast<uint64_t>(id) * _config.materialSize;
+    return queue->writeBuffer(_materialBuffer, offset, std::span<const std::byte>(_scratch));
+}
+
+const std::shared_ptr<IBindGroup>& BindlessTable::getBindGroup() {
+    if (!_dirty) {
+        return _bindGroup;
+    }
+
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("BindlessTable", "Device was destroyed");
+        return _bindGroup;
+    }
+
+    BindGroupDesc desc;
+    desc.layout = _layout;
+    desc.debugName = _config.debugName;
+    desc.entries.resize(3);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = _materialBuffer;
+    desc.entries[1].binding = 1;
+    desc.entries[1].textureViews = _textures;
+    desc.entries[2].binding = 2;
+    desc.entries[2].samplers = _samplers;
+
+    auto bindGroup = device->getResourceFactory()->createBindGroup(desc);
+    if (!bindGroup) {
+        // Keep drawing with the previous group, retried on the next call
+        LOG_ERROR("BindlessTable", "Failed to rebuild bind group");
+        return _bindGroup;
+    }
+    _bindGroup = std::move(bindGroup);
+    _dirty = false;
+    return _bindGroup;
+}
+
+std::string BindlessTable::getShaderDeclarations(uint32_t group, const std::string& materialType) const {
+    const std::string prefix = "@group(" + std::to_string(group) + ") ";
+    return prefix + "@binding(0) var<storage, read> bindlessMaterials: array<" + materialType + ">;\n" +
+           prefix + "@binding(1) var bindlessTextures: binding_array<texture_2d<f32>, " +
+           std::to_string(_config.maxTextures) + ">;\n" +
+           prefix + "@binding(2) var bindlessSamplers: binding_array<sampler, " +
+           std::to_string(_config.maxSamplers) + ">;\n";
+}
+
+} // namespace pers
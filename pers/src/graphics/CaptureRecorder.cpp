@@ -0,0 +1,1131 @@
+#include "pers/graphics/CaptureRecorder.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IPreparedRenderPass.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Mutex.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace pers {
+
+namespace detail {
+
+/**
+ * @brief State shared by a CaptureRecorder and the wrappers it hands out
+ *
+ * Register functions and command() must be called with the mutex held.
+ */
+class CaptureSession {
+public:
+    explicit CaptureSession(const std::shared_ptr<ILogicalDevice>& device) : _device(device) {}
+
+    Mutex<false> mutex;
+
+    bool isRecording(uint64_t generation) const { return _capturing && generation == _generation; }
+    uint64_t getActiveGeneration() const { return _capturing ? _generation : 0; }
+
+    void begin() {
+        reset();
+        _capturing = true;
+        ++_generation;
+    }
+
+    bool end(FrameCapture& capture, std::vector<std::shared_ptr<IBuffer>>& buffers) {
+        if (!_capturing) {
+            return false;
+        }
+        _capturing = false;
+        capture = std::move(_capture);
+        buffers = std::move(_bufferObjects);
+        reset();
+        return true;
+    }
+
+    const std::weak_ptr<ILogicalDevice>& getDevice() const { return _device; }
+
+    uint32_t nextEncoder() { return _capture.encoderCount++; }
+    uint32_t nextPass() { return _capture.passCount++; }
+
+    CaptureWriter command(CaptureCommand command) {
+        CaptureWriter writer(_capture.commands);
+        writer.u8(static_cast<uint8_t>(command));
+        ++_capture.commandCount;
+        return writer;
+    }
+
+    void skip(const char* what) {
+        ++_capture.skippedCommands;
+        if (_skippedKinds.insert(what).second) {
+            LOG_WARNING("CaptureRecorder", std::string(what) + " is not captured and will be missing from replays");
+        }
+    }
+
+    void setSampleCount(uint32_t texture, uint32_t sampleCount) {
+        if (texture != CAPTURE_NONE) {
+            _capture.textures[texture].sampleCount = sampleCount;
+        }
+    }
+
+    uint32_t buffer(const std::shared_ptr<IBuffer>& buffer) {
+        if (!buffer) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(buffer.get()); it != _ids.end()) {
+            return it->second;
+        }
+        CapturedBuffer record;
+        record.size = buffer->getSize();
+        record.usage = buffer->getUsage();
+        record.debugName = buffer->getDebugName();
+        _capture.buffers.push_back(std::move(record));
+        _bufferObjects.push_back(buffer);
+        return remember(buffer, static_cast<uint32_t>(_capture.buffers.size() - 1));
+    }
+
+    uint32_t textureView(const std::shared_ptr<ITextureView>& view, TextureUsage usage,
+                         TextureViewDimension dimension = TextureViewDimension::D2, bool multisampled = false) {
+        if (!view) {
+            return CAPTURE_NONE;
+        }
+        uint32_t id;
+        if (auto it = _ids.find(view.get()); it != _ids.end()) {
+            id = it->second;
+        } else {
+            CapturedTexture record;
+            view->getDimensions(record.width, record.height);
+            record.format = view->getFormat();
+            _capture.textures.push_back(record);
+            id = remember(view, static_cast<uint32_t>(_capture.textures.size() - 1));
+        }
+        CapturedTexture& record = _capture.textures[id];
+        record.usage |= usage;
+        if (dimension != TextureViewDimension::D2 && dimension != TextureViewDimension::Undefined) {
+            record.dimension = dimension;
+        }
+        if (multisampled) {
+            record.sampleCount = 4;  // The only multisample count WebGPU allows
+        }
+        return id;
+    }
+
+    uint32_t sampler(const std::shared_ptr<ISampler>& sampler) {
+        if (!sampler) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(sampler.get()); it != _ids.end()) {
+            return it->second;
+        }
+        _capture.samplers.push_back(sampler->getDesc());
+        return remember(sampler, static_cast<uint32_t>(_capture.samplers.size() - 1));
+    }
+
+    uint32_t shader(const std::shared_ptr<IShaderModule>& shader) {
+        if (!shader) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(shader.get()); it != _ids.end()) {
+            return it->second;
+        }
+        CapturedShader record;
+        record.stage = shader->getStage();
+        record.entryPoint = shader->getEntryPoint();
+        record.debugName = shader->getDebugName();
+        record.code = shader->getCode();
+        record.spirv = shader->getSpirv();
+        _capture.shaders.push_back(std::move(record));
+        return remember(shader, static_cast<uint32_t>(_capture.shaders.size() - 1));
+    }
+
+    uint32_t bindGroupLayout(const std::shared_ptr<IBindGroupLayout>& layout) {
+        if (!layout) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(layout.get()); it != _ids.end()) {
+            return it->second;
+        }
+        _capture.bindGroupLayouts.push_back(layout->getDesc());
+        return remember(layout, static_cast<uint32_t>(_capture.bindGroupLayouts.size() - 1));
+    }
+
+    uint32_t pipelineLayout(const std::shared_ptr<IPipelineLayout>& layout) {
+        if (!layout) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(layout.get()); it != _ids.end()) {
+            return it->second;
+        }
+        CapturedPipelineLayout record;
+        for (const auto& groupLayout : layout->getDesc().bindGroupLayouts) {
+            record.bindGroupLayouts.push_back(bindGroupLayout(groupLayout));
+        }
+        record.pushConstantRanges = layout->getDesc().pushConstantRanges;
+        record.debugName = layout->getDesc().debugName;
+        _capture.pipelineLayouts.push_back(std::move(record));
+        return remember(layout, static_cast<uint32_t>(_capture.pipelineLayouts.size() - 1));
+    }
+
+    uint32_t pipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+        if (!pipeline) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(pipeline.get()); it != _ids.end()) {
+            return it->second;
+        }
+        RenderPipelineDesc desc = pipeline->getDesc();
+        if (!desc.vertex) {
+            skip("Render pipeline without descriptor");
+            return remember(pipeline, CAPTURE_NONE);
+        }
+        CapturedRenderPipeline record;
+        record.vertex = shader(desc.vertex);
+        record.fragment = shader(desc.fragment);
+        record.layout = pipelineLayout(desc.layout);
+        record.state = std::move(desc);
+        record.state.vertex = nullptr;
+        record.state.fragment = nullptr;
+        record.state.layout = nullptr;
+        _capture.pipelines.push_back(std::move(record));
+        return remember(pipeline, static_cast<uint32_t>(_capture.pipelines.size() - 1));
+    }
+
+    uint32_t sampleCount(uint32_t pipeline) const {
+        return pipeline == CAPTURE_NONE ? 1 : _capture.pipelines[pipeline].state.multisample.count;
+    }
+
+    uint32_t bindGroup(const std::shared_ptr<IBindGroup>& group) {
+        if (!group) {
+            return CAPTURE_NONE;
+        }
+        if (auto it = _ids.find(group.get()); it != _ids.end()) {
+            return it->second;
+        }
+        const BindGroupDesc& desc = group->getDesc();
+        const BindGroupLayoutDesc* layoutDesc = desc.layout ? &desc.layout->getDesc() : nullptr;
+
+        CapturedBindGroup record;
+        record.layout = bindGroupLayout(desc.layout);
+        record.debugName = desc.debugName;
+        for (const auto& entry : desc.entries) {
+            // The layout entry tells what kind of texture the view was made from
+            TextureViewDimension dimension = TextureViewDimension::D2;
+            bool multisampled = false;
+            if (layoutDesc) {
+                auto layoutEntry = std::find_if(layoutDesc->entries.begin(), layoutDesc->entries.end(),
+                    [&](const BindGroupLayoutEntry& candidate) { return candidate.binding == entry.binding; });
+                if (layoutEntry != layoutDesc->entries.end()) {
+                    dimension = layoutEntry->viewDimension;
+                    multisampled = layoutEntry->multisampled;
+                }
+            }
+
+            CapturedBindGroupEntry captured;
+            captured.binding = entry.binding;
+            captured.buffer = buffer(entry.buffer);
+            captured.offset = entry.offset;
+            captured.size = entry.size;
+            captured.textureView = textureView(entry.textureView, TextureUsage::TextureBinding,
+                                               dimension, multisampled);
+            captured.sampler = sampler(entry.sampler);
+            for (const auto& element : entry.buffers) {
+                captured.buffers.push_back(buffer(element));
+            }
+            for (const auto& element : entry.textureViews) {
+                captured.textureViews.push_back(textureView(element, TextureUsage::TextureBinding,
+                                                            dimension, multisampled));
+            }
+            for (const auto& element : entry.samplers) {
+                captured.samplers.push_back(sampler(element));
+            }
+            record.entries.push_back(std::move(captured));
+        }
+        _capture.bindGroups.push_back(std::move(record));
+        return remember(group, static_cast<uint32_t>(_capture.bindGroups.size() - 1));
+    }
+
+private:
+    // Retained so addresses are not reused by new objects during the capture
+    uint32_t remember(std::shared_ptr<const void> object, uint32_t id) {
+        _ids.emplace(object.get(), id);
+        _retained.push_back(std::move(object));
+        return id;
+    }
+
+    void reset() {
+        _capture = FrameCapture{};
+        _ids.clear();
+        _retained.clear();
+        _bufferObjects.clear();
+        _skippedKinds.clear();
+    }
+
+    std::weak_ptr<ILogicalDevice> _device;
+    bool _capturing = false;
+    uint64_t _generation = 0;
+    FrameCapture _capture;
+    std::unordered_map<const void*, uint32_t> _ids;  // Object -> index in its FrameCapture vector
+    std::vector<std::shared_ptr<const void>> _retained;
+    std::vector<std::shared_ptr<IBuffer>> _bufferObjects;  // Indexed like FrameCapture::buffers
+    std::unordered_set<std::string> _skippedKinds;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::CaptureSession;
+
+class RecordingCommandBuffer final : public ICommandBuffer {
+public:
+    RecordingCommandBuffer(std::shared_ptr<ICommandBuffer> inner, uint64_t generation, uint32_t encoder)
+        : _inner(std::move(inner))
+        , _generation(generation)
+        , _encoder(encoder) {
+    }
+
+    NativeCommandBufferHandle getNativeCommandBufferHandle() const override {
+        return _inner->getNativeCommandBufferHandle();
+    }
+
+    uint64_t getGeneration() const { return _generation; }
+    uint32_t getEncoder() const { return _encoder; }
+
+private:
+    std::shared_ptr<ICommandBuffer> _inner;
+    uint64_t _generation;
+    uint32_t _encoder;
+};
+
+class RecordingRenderPassEncoder final : public IRenderPassEncoder {
+public:
+    RecordingRenderPassEncoder(std::shared_ptr<IRenderPassEncoder> inner, std::shared_ptr<CaptureSession> session,
+                               uint64_t generation, uint32_t pass, const RenderResourceTable* resourceTable,
+                               std::vector<uint32_t> attachments)
+        : _inner(std::move(inner))
+        , _session(std::move(session))
+        , _generation(generation)
+        , _pass(pass)
+        , _resourceTable(resourceTable)
+        , _attachments(std::move(attachments)) {
+    }
+
+    void setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) override {
+        _inner->setPipeline(pipeline);
+        recordPipeline(pipeline);
+    }
+
+    void setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                      std::span<const uint32_t> dynamicOffsets) override {
+        _inner->setBindGroup(index, bindGroup, dynamicOffsets);
+        recordBindGroup(index, bindGroup, dynamicOffsets);
+    }
+
+    void setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                         uint64_t offset, uint64_t size) override {
+        _inner->setVertexBuffer(slot, buffer, offset, size);
+        recordVertexBuffer(slot, buffer, offset, size);
+    }
+
+    void setIndexBuffer(const std::shared_ptr<IBuffer>& buffer, IndexFormat indexFormat,
+                        uint64_t offset, uint64_t size) override {
+        _inner->setIndexBuffer(buffer, indexFormat, offset, size);
+        recordIndexBuffer(buffer, indexFormat, offset, size);
+    }
+
+    void setPipeline(PipelineHandle pipeline) override {
+        _inner->setPipeline(pipeline);
+        recordPipeline(_resourceTable ? _resourceTable->getObject(pipeline) : nullptr);
+    }
+
+    void setBindGroup(uint32_t index, BindGroupHandle bindGroup,
+                      std::span<const uint32_t> dynamicOffsets) override {
+        _inner->setBindGroup(index, bindGroup, dynamicOffsets);
+        recordBindGroup(index, _resourceTable ? _resourceTable->getObject(bindGroup) : nullptr, dynamicOffsets);
+    }
+
+    void setVertexBuffer(uint32_t slot, BufferHandle buffer, uint64_t offset, uint64_t size) override {
+        _inner->setVertexBuffer(slot, buffer, offset, size);
+        recordVertexBuffer(slot, _resourceTable ? _resourceTable->getObject(buffer) : nullptr, offset, size);
+    }
+
+    void setIndexBuffer(BufferHandle buffer, IndexFormat indexFormat, uint64_t offset, uint64_t size) override {
+        _inner->setIndexBuffer(buffer, indexFormat, offset, size);
+        recordIndexBuffer(_resourceTable ? _resourceTable->getObject(buffer) : nullptr, indexFormat, offset, size);
+    }
+
+    void setViewport(float x, float y, float width, float height, float minDepth, float maxDepth) override {
+        _inner->setViewport(x, y, width, height, minDepth, maxDepth);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::SetViewport);
+            writer.u32(_pass);
+            writer.f32(x);
+            writer.f32(y);
+            writer.f32(width);
+            writer.f32(height);
+            writer.f32(minDepth);
+            writer.f32(maxDepth);
+        });
+    }
+
+    void setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override {
+        _inner->setScissorRect(x, y, width, height);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::SetScissorRect);
+            writer.u32(_pass);
+            writer.u32(x);
+            writer.u32(y);
+            writer.u32(width);
+            writer.u32(height);
+        });
+    }
+
+    void setStencilReference(uint32_t reference) override {
+        _inner->setStencilReference(reference);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::SetStencilReference);
+            writer.u32(_pass);
+            writer.u32(reference);
+        });
+    }
+
+    void setBlendConstant(const Color& color) override {
+        _inner->setBlendConstant(color);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::SetBlendConstant);
+            writer.u32(_pass);
+            writer.f32(color.r);
+            writer.f32(color.g);
+            writer.f32(color.b);
+            writer.f32(color.a);
+        });
+    }
+
+    void setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) override {
+        _inner->setPushConstants(stages, offset, data);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::SetPushConstants);
+            writer.u32(_pass);
+            writer.enumValue(stages);
+            writer.u32(offset);
+            writer.bytes(data);
+        });
+    }
+
+    void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) override {
+        _inner->draw(vertexCount, instanceCount, firstVertex, firstInstance);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::Draw);
+            writer.u32(_pass);
+            writer.u32(vertexCount);
+            writer.u32(instanceCount);
+            writer.u32(firstVertex);
+            writer.u32(firstInstance);
+        });
+    }
+
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                     int32_t baseVertex, uint32_t firstInstance) override {
+        _inner->drawIndexed(indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+        record([&] {
+            auto writer = _session->command(CaptureCommand::DrawIndexed);
+            writer.u32(_pass);
+            writer.u32(indexCount);
+            writer.u32(instanceCount);
+            writer.u32(firstIndex);
+            writer.i32(baseVertex);
+            writer.u32(firstInstance);
+        });
+    }
+
+    void drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) override {
+        _inner->drawIndirect(indirectBuffer, indirectOffset);
+        recordIndirect(CaptureCommand::DrawIndirect, indirectBuffer, indirectOffset, 1);
+    }
+
+    void drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) override {
+        _inner->drawIndexedIndirect(indirectBuffer, indirectOffset);
+        recordIndirect(CaptureCommand::DrawIndexedIndirect, indirectBuffer, indirectOffset, 1);
+    }
+
+    void multiDrawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                           uint64_t indirectOffset, uint32_t drawCount) override {
+        _inner->multiDrawIndirect(indirectBuffer, indirectOffset, drawCount);
+        recordIndirect(CaptureCommand::MultiDrawIndirect, indirectBuffer, indirectOffset, drawCount);
+    }
+
+    void multiDrawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                  uint64_t indirectOffset, uint32_t drawCount) override {
+        _inner->multiDrawIndexedIndirect(indirectBuffer, indirectOffset, drawCount);
+        recordIndirect(CaptureCommand::MultiDrawIndexedIndirect, indirectBuffer, indirectOffset, drawCount);
+    }
+
+    void multiDrawIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                uint32_t maxDrawCount) override {
+        _inner->multiDrawIndirectCount(indirectBuffer, indirectOffset, countBuffer, countOffset, maxDrawCount);
+        recordIndirect(CaptureCommand::MultiDrawIndirectCount, indirectBuffer, indirectOffset, maxDrawCount,
+                       countBuffer, countOffset);
+    }
+
+    void multiDrawIndexedIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                       const std::shared_ptr<IBuffer>& countBuffer, uint64_t countOffset,
+                                       uint32_t maxDrawCount) override {
+        _inner->multiDrawIndexedIndirectCount(indirectBuffer, indirectOffset, countBuffer, countOffset, maxDrawCount);
+        recordIndirect(CaptureCommand::MultiDrawIndexedIndirectCount, indirectBuffer, indirectOffset, maxDrawCount,
+                       countBuffer, countOffset);
+    }
+
+    void executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) override {
+        _inner->executeBundles(bundles);
+        record([&] {
+            _session->skip("Render bundle execution");
+        });
+    }
+
+    void beginOcclusionQuery(uint32_t queryIndex) override {
+        _inner->beginOcclusionQuery(queryIndex);
+        record([&] {
+            _session->skip("Occlusion query");
+        });
+    }
+
+    void endOcclusionQuery() override {
+        _inner->endOcclusionQuery();
+    }
+
+    void beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet, uint32_t queryIndex) override {
+        _inner->beginPipelineStatisticsQuery(querySet, queryIndex);
+        record([&] {
+            _session->skip("Pipeline statistics query");
+        });
+    }
+
+    void endPipelineStatisticsQuery() override {
+        _inner->endPipelineStatisticsQuery();
+    }
+
+    void end() override {
+        _inner->end();
+        record([&] {
+            _session->command(CaptureCommand::EndRenderPass).u32(_pass);
+        });
+    }
+
+    NativeRenderPassEncoderHandle getNativeRenderPassEncoderHandle() const override {
+        return _inner->getNativeRenderPassEncoderHandle();
+    }
+
+    RenderPassEncoderStats getStats() const override {
+        return _inner->getStats();
+    }
+
+private:
+    template<typename F>
+    void record(F&& body) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (_session->isRecording(_generation)) {
+            body();
+        }
+    }
+
+    void recordPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+        record([&] {
+            const uint32_t id = _session->pipeline(pipeline);
+            // Views do not report their sample count, the pipeline drawing into them does
+            if (id != CAPTURE_NONE) {
+                for (uint32_t attachment : _attachments) {
+                    _session->setSampleCount(attachment, _session->sampleCount(id));
+                }
+            }
+            auto writer = _session->command(CaptureCommand::SetPipeline);
+            writer.u32(_pass);
+            writer.u32(id);
+        });
+    }
+
+    void recordBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                         std::span<const uint32_t> dynamicOffsets) {
+        record([&] {
+            const uint32_t id = _session->bindGroup(bindGroup);
+            auto writer = _session->command(CaptureCommand::SetBindGroup);
+            writer.u32(_pass);
+            writer.u32(index);
+            writer.u32(id);
+            writer.u32(static_cast<uint32_t>(dynamicOffsets.size()));
+            for (uint32_t offset : dynamicOffsets) {
+                writer.u32(offset);
+            }
+        });
+    }
+
+    void recordVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer, uint64_t offset, uint64_t size) {
+        record([&] {
+            const uint32_t id = _session->buffer(buffer);
+            auto writer = _session->command(CaptureCommand::SetVertexBuffer);
+            writer.u32(_pass);
+            writer.u32(slot);
+            writer.u32(id);
+            writer.u64(offset);
+            writer.u64(size);
+        });
+    }
+
+    void recordIndexBuffer(const std::shared_ptr<IBuffer>& buffer, IndexFormat format, uint64_t offset, uint64_t size) {
+        record([&] {
+            const uint32_t id = _session->buffer(buffer);
+            auto writer = _session->command(CaptureCommand::SetIndexBuffer);
+            writer.u32(_pass);
+            writer.u32(id);
+            writer.enumValue(format);
+            writer.u64(offset);
+            writer.u64(size);
+        });
+    }
+
+    void recordIndirect(CaptureCommand command, const std::shared_ptr<IBuffer>& buffer,
+                        uint64_t offset, uint32_t drawCount,
+                        const std::shared_ptr<IBuffer>& countBuffer = nullptr, uint64_t countOffset = 0) {
+        record([&] {
+            const uint32_t id = _session->buffer(buffer);
+            const bool counted = command == CaptureCommand::MultiDrawIndirectCount ||
+                                 command == CaptureCommand::MultiDrawIndexedIndirectCount;
+            const uint32_t countId = counted ? _session->buffer(countBuffer) : CAPTURE_NONE;
+            auto writer = _session->command(command);
+            writer.u32(_pass);
+            writer.u32(id);
+            writer.u64(offset);
+            if (command == CaptureCommand::MultiDrawIndirect || command == CaptureCommand::MultiDrawIndexedIndirect ||
+                counted) {
+                writer.u32(drawCount);
+            }
+            if (counted) {
+                writer.u32(countId);
+                writer.u64(countOffset);
+            }
+        });
+    }
+
+    std::shared_ptr<IRenderPassEncoder> _inner;
+    std::shared_ptr<CaptureSession> _session;
+    uint64_t _generation;
+    uint32_t _pass;
+    const RenderResourceTable* _resourceTable;
+    std::vector<uint32_t> _attachments;  // Texture ids of multisampled-capable attachments
+};
+
+class RecordingCommandEncoder final : public ICommandEncoder {
+public:
+    RecordingCommandEncoder(std::shared_ptr<ICommandEncoder> inner, std::shared_ptr<CaptureSession> session)
+        : _inner(std::move(inner))
+        , _session(std::move(session)) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        _generation = _session->getActiveGeneration();
+        if (_session->isRecording(_generation)) {
+            _encoder = _session->nextEncoder();
+            _session->command(CaptureCommand::BeginEncoder).u32(_encoder);
+        }
+    }
+
+    std::shared_ptr<IRenderPassEncoder> beginRenderPass(const RenderPassDesc& desc) override {
+        return recordRenderPass(_inner->beginRenderPass(desc), desc);
+    }
+
+    std::shared_ptr<IRenderPassEncoder> beginRenderPass(const IPreparedRenderPass& prepared) override {
+        return recordRenderPass(_inner->beginRenderPass(prepared), prepared.getDesc());
+    }
+
+    std::shared_ptr<IComputePassEncoder> beginComputePass(const ComputePassDesc& desc) override {
+        skip("Compute pass");
+        return _inner->beginComputePass(desc);
+    }
+
+    bool uploadToDeviceBuffer(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                              const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                              const BufferCopyDesc& copyDesc) override {
+        if (!_inner->uploadToDeviceBuffer(stagingBuffer, deviceBuffer, copyDesc)) {
+            return false;
+        }
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (!_session->isRecording(_generation)) {
+            return true;
+        }
+
+        // Staging memory is only readable while mapped; otherwise rely on the end-of-capture readback
+        const auto* data = static_cast<const std::byte*>(stagingBuffer->getMappedData());
+        uint64_t size = copyDesc.size;
+        if (size == 0 || size == BufferCopyDesc::WHOLE_SIZE) {
+            size = std::min(stagingBuffer->getSize() - copyDesc.srcOffset,
+                            deviceBuffer->getSize() - copyDesc.dstOffset);
+        }
+        if (!data) {
+            _session->skip("Upload from an unmapped staging buffer");
+            return true;
+        }
+        const uint32_t id = _session->buffer(deviceBuffer);
+        auto writer = _session->command(CaptureCommand::UploadBuffer);
+        writer.u32(_encoder);
+        writer.u32(id);
+        writer.u64(copyDesc.dstOffset);
+        writer.bytes(std::span<const std::byte>(data + copyDesc.srcOffset, size));
+        return true;
+    }
+
+    bool downloadFromDeviceBuffer(const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                                  const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                  const BufferCopyDesc& copyDesc) override {
+        skip("Buffer readback");
+        return _inner->downloadFromDeviceBuffer(deviceBuffer, readbackBuffer, copyDesc);
+    }
+
+    bool downloadFromDeviceBuffer(const std::shared_ptr<ImmediateDeviceBuffer>& deviceBuffer,
+                                  const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                  const BufferCopyDesc& copyDesc) override {
+        skip("Buffer readback");
+        return _inner->downloadFromDeviceBuffer(deviceBuffer, readbackBuffer, copyDesc);
+    }
+
+    bool uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                         const std::shared_ptr<ITexture>& texture,
+                         const TextureUploadDesc& desc) override {
+        skip("Texture upload");
+        return _inner->uploadToTexture(stagingBuffer, texture, desc);
+    }
+
+    bool downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                             const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                             const TextureReadbackDesc& desc) override {
+        skip("Texture readback");
+        return _inner->downloadFromTexture(texture, readbackBuffer, desc);
+    }
+
+    bool copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                             const std::shared_ptr<ITexture>& texture,
+                             const TextureUploadDesc& desc) override {
+        skip("Buffer to texture copy");
+        return _inner->copyBufferToTexture(source, texture, desc);
+    }
+
+    bool copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                             const std::shared_ptr<DeviceBuffer>& destination,
+                             const TextureReadbackDesc& desc) override {
+        skip("Texture to buffer copy");
+        return _inner->copyTextureToBuffer(texture, destination, desc);
+    }
+
+    bool clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer, uint64_t offset, uint64_t size) override {
+        skip("Buffer clear");
+        return _inner->clearBuffer(buffer, offset, size);
+    }
+
+    bool copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                              const std::shared_ptr<ITexture>& destination,
+                              const TextureCopyDesc& desc) override {
+        skip("Texture copy");
+        return _inner->copyTextureToTexture(source, destination, desc);
+    }
+
+    bool copyDeviceToDevice(const std::shared_ptr<DeviceBuffer>& source,
+                            const std::shared_ptr<DeviceBuffer>& destination,
+                            const BufferCopyDesc& copyDesc) override {
+        if (!_inner->copyDeviceToDevice(source, destination, copyDesc)) {
+            return false;
+        }
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (_session->isRecording(_generation)) {
+            const uint32_t sourceId = _session->buffer(source);
+            const uint32_t destinationId = _session->buffer(destination);
+            auto writer = _session->command(CaptureCommand::CopyBuffer);
+            writer.u32(_encoder);
+            writer.u32(sourceId);
+            writer.u64(copyDesc.srcOffset);
+            writer.u32(destinationId);
+            writer.u64(copyDesc.dstOffset);
+            writer.u64(copyDesc.size);
+        }
+        return true;
+    }
+
+    bool resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet, uint32_t firstQuery, uint32_t queryCount,
+                         const std::shared_ptr<DeviceBuffer>& destination, uint64_t destinationOffset) override {
+        skip("Query resolve");
+        return _inner->resolveQuerySet(querySet, firstQuery, queryCount, destination, destinationOffset);
+    }
+
+    std::shared_ptr<ICommandBuffer> finish() override {
+        auto commandBuffer = _inner->finish();
+        if (!commandBuffer) {
+            return commandBuffer;
+        }
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (!_session->isRecording(_generation)) {
+            return commandBuffer;
+        }
+        _session->command(CaptureCommand::Finish).u32(_encoder);
+        return std::make_shared<RecordingCommandBuffer>(std::move(commandBuffer), _generation, _encoder);
+    }
+
+    NativeEncoderHandle getNativeEncoderHandle() const override {
+        return _inner->getNativeEncoderHandle();
+    }
+
+private:
+    std::shared_ptr<IRenderPassEncoder> recordRenderPass(std::shared_ptr<IRenderPassEncoder> pass,
+                                                         const RenderPassDesc& desc) {
+        if (!pass) {
+            return pass;
+        }
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (!_session->isRecording(_generation)) {
+            return pass;
+        }
+
+        const uint32_t passId = _session->nextPass();
+        std::vector<uint32_t> attachments;
+        std::vector<uint32_t> colorViews;
+        std::vector<uint32_t> resolveViews;
+        for (const auto& color : desc.colorAttachments) {
+            colorViews.push_back(_session->textureView(color.view, TextureUsage::RenderAttachment));
+            resolveViews.push_back(_session->textureView(color.resolveTarget, TextureUsage::RenderAttachment));
+            attachments.push_back(colorViews.back());
+        }
+        uint32_t depthView = CAPTURE_NONE;
+        if (desc.depthStencilAttachment) {
+            depthView = _session->textureView(desc.depthStencilAttachment->view, TextureUsage::RenderAttachment);
+            attachments.push_back(depthView);
+        }
+        if (desc.timestampWrites.querySet || desc.occlusionQuerySet) {
+            _session->skip("Render pass query set");
+        }
+
+        auto writer = _session->command(CaptureCommand::BeginRenderPass);
+        writer.u32(_encoder);
+        writer.u32(passId);
+        writer.u32(static_cast<uint32_t>(desc.colorAttachments.size()));
+        for (size_t i = 0; i < desc.colorAttachments.size(); ++i) {
+            const auto& color = desc.colorAttachments[i];
+            writer.u32(colorViews[i]);
+            writer.u32(resolveViews[i]);
+            writer.enumValue(color.loadOp);
+            writer.enumValue(color.storeOp);
+            writer.f32(color.clearColor.r);
+            writer.f32(color.clearColor.g);
+            writer.f32(color.clearColor.b);
+            writer.f32(color.clearColor.a);
+        }
+        writer.u32(depthView);
+        if (depthView != CAPTURE_NONE) {
+            const auto& depth = *desc.depthStencilAttachment;
+            writer.enumValue(depth.depthLoadOp);
+            writer.enumValue(depth.depthStoreOp);
+            writer.f32(depth.depthClearValue);
+            writer.u32(depth.depthReadOnly ? 1 : 0);
+            writer.enumValue(depth.stencilLoadOp);
+            writer.enumValue(depth.stencilStoreOp);
+            writer.u32(depth.stencilClearValue);
+            writer.u32(depth.stencilReadOnly ? 1 : 0);
+        }
+        writer.str(desc.label);
+
+        return std::make_shared<RecordingRenderPassEncoder>(std::move(pass), _session, _generation, passId,
+                                                            desc.resourceTable, std::move(attachments));
+    }
+
+    void skip(const char* what) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (_session->isRecording(_generation)) {
+            _session->skip(what);
+        }
+    }
+
+    std::shared_ptr<ICommandEncoder> _inner;
+    std::shared_ptr<CaptureSession> _session;
+    uint64_t _generation = 0;
+    uint32_t _encoder = CAPTURE_NONE;
+};
+
+class RecordingQueue final : public IQueue {
+public:
+    RecordingQueue(std::shared_ptr<IQueue> inner, std::shared_ptr<CaptureSession> session)
+        : _inner(std::move(inner))
+        , _session(std::move(session)) {
+    }
+
+    using IQueue::submit;
+
+    SubmissionFence submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) override {
+        recordSubmit(commandBuffers);
+        return _inner->submit(commandBuffers);
+    }
+
+    SubmissionFence submit(std::span<const NativeCommandBufferHandle> commandBuffers) override {
+        if (!commandBuffers.empty()) {
+            auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+            if (_session->getActiveGeneration() != 0) {
+                _session->skip("Command buffers submitted by native handle");
+            }
+        }
+        return _inner->submit(commandBuffers);
+    }
+
+    SubmissionFence submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) override {
+        recordSubmit(std::span<const std::shared_ptr<ICommandBuffer>>(&commandBuffer, 1));
+        return _inner->submit(commandBuffer);
+    }
+
+    SubmissionFence submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) override {
+        recordSubmit(commandBuffers);
+        return _inner->submitBatch(commandBuffers);
+    }
+
+    void beginSubmissionBatch() override {
+        _inner->beginSubmissionBatch();
+    }
+
+    SubmissionFence endSubmissionBatch() override {
+        return _inner->endSubmissionBatch();
+    }
+
+    SubmissionFence flushSubmissions() override {
+        return _inner->flushSubmissions();
+    }
+
+    bool writeBuffer(const BufferWriteDesc& desc) override {
+        if (!_inner->writeBuffer(desc)) {
+            return false;
+        }
+        recordWrite(desc.buffer, desc.offset, desc.data, desc.size);
+        return true;
+    }
+
+    bool writeBuffer(const std::shared_ptr<IBuffer>& buffer, uint64_t offset, std::span<const std::byte> data) override {
+        if (!_inner->writeBuffer(buffer, offset, data)) {
+            return false;
+        }
+        recordWrite(buffer, offset, data.data(), data.size());
+        return true;
+    }
+
+    bool writeBuffers(std::span<const BufferWriteDesc> writes) override {
+        const bool result = _inner->writeBuffers(writes);
+        // Invalid entries are skipped by the queue, record the ones it accepts
+        for (const auto& write : writes) {
+            if (write.buffer && write.data && write.size > 0) {
+                recordWrite(write.buffer, write.offset, write.data, write.size);
+            }
+        }
+        return result;
+    }
+
+    bool writeTexture(const std::shared_ptr<ITexture>& texture, const void* data,
+                      uint64_t dataSize, uint32_t mipLevel) override {
+        skip("Texture write");
+        return _inner->writeTexture(texture, data, dataSize, mipLevel);
+    }
+
+    bool writeTexture(const TextureWriteDesc& desc) override {
+        skip("Texture write");
+        return _inner->writeTexture(desc);
+    }
+
+    bool waitIdle() override {
+        return _inner->waitIdle();
+    }
+
+    bool onSubmittedWorkDone(QueueWorkDoneCallback callback) override {
+        return _inner->onSubmittedWorkDone(std::move(callback));
+    }
+
+    bool pollSubmittedWork(bool wait) override {
+        return _inner->pollSubmittedWork(wait);
+    }
+
+    NativeQueueHandle getNativeQueueHandle() const override {
+        return _inner->getNativeQueueHandle();
+    }
+
+private:
+    void recordSubmit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        const uint64_t generation = _session->getActiveGeneration();
+        if (generation == 0 || commandBuffers.empty()) {
+            return;
+        }
+        std::vector<uint32_t> encoders;
+        for (const auto& commandBuffer : commandBuffers) {
+            const auto* recorded = dynamic_cast<const RecordingCommandBuffer*>(commandBuffer.get());
+            if (recorded && recorded->getGeneration() == generation) {
+                encoders.push_back(recorded->getEncoder());
+            } else {
+                _session->skip("Command buffer from an encoder wrapped outside the capture");
+            }
+        }
+        auto writer = _session->command(CaptureCommand::Submit);
+        writer.u32(static_cast<uint32_t>(encoders.size()));
+        for (uint32_t encoder : encoders) {
+            writer.u32(encoder);
+        }
+    }
+
+    void recordWrite(const std::shared_ptr<IBuffer>& buffer, uint64_t offset, const void* data, uint64_t size) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (_session->getActiveGeneration() == 0) {
+            return;
+        }
+        const uint32_t id = _session->buffer(buffer);
+        auto writer = _session->command(CaptureCommand::WriteBuffer);
+        writer.u32(id);
+        writer.u64(offset);
+        writer.bytes(std::span<const std::byte>(static_cast<const std::byte*>(data), size));
+    }
+
+    void skip(const char* what) {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (_session->getActiveGeneration() != 0) {
+            _session->skip(what);
+        }
+    }
+
+    std::shared_ptr<IQueue> _inner;
+    std::shared_ptr<CaptureSession> _session;
+};
+
+// Copy every CopySrc device buffer into readback memory and wait for the maps
+void readBufferContents(const std::shared_ptr<ILogicalDevice>& device,
+                        const std::vector<std::shared_ptr<IBuffer>>& buffers,
+                        FrameCapture& capture) {
+    auto encoder = device->createCommandEncoder();
+    auto queue = device->getQueue();
+    if (!encoder || !queue) {
+        LOG_ERROR("CaptureRecorder", "Failed to create encoder for buffer readback");
+        return;
+    }
+
+    struct Readback {
+        uint32_t buffer;
+        uint64_t size;
+        std::shared_ptr<DeferredStagingBuffer> staging;
+    };
+    std::vector<Readback> readbacks;
+    for (uint32_t id = 0; id < buffers.size(); ++id) {
+        const auto& buffer = buffers[id];
+        const uint64_t size = buffer->getSize() & ~uint64_t(3);  // Copies are 4-byte sized
+        if ((buffer->getUsage() & BufferUsage::CopySrc) == BufferUsage::None || size == 0) {
+            continue;
+        }
+        auto staging = std::make_shared<DeferredStagingBuffer>();
+        if (!staging->create(size, MapMode::Read, device, "CaptureReadback")) {
+            continue;
+        }
+        const BufferCopyDesc copy{0, 0, size};
+        bool recorded = false;
+        if (auto deviceBuffer = std::dynamic_pointer_cast<DeviceBuffer>(buffer)) {
+            recorded = encoder->downloadFromDeviceBuffer(deviceBuffer, staging, copy);
+        } else if (auto immediateBuffer = std::dynamic_pointer_cast<ImmediateDeviceBuffer>(buffer)) {
+            recorded = encoder->downloadFromDeviceBuffer(immediateBuffer, staging, copy);
+        }
+        if (recorded) {
+            readbacks.push_back({id, size, std::move(staging)});
+        }
+    }
+    if (readbacks.empty()) {
+        return;
+    }
+
+    SubmissionFence fence = queue->submit(encoder->finish());
+    if (!fence || !fence.wait()) {
+        LOG_ERROR("CaptureRecorder", "Buffer readback submission failed");
+        return;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (auto& readback : readbacks) {
+        auto future = readback.staging->mapAsync(MapMode::Read, {0, readback.size});
+        while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                LOG_ERROR("CaptureRecorder", "Timed out reading back buffer contents");
+                return;
+            }
+            queue->pollSubmittedWork(false);
+        }
+        MappedData mapped = future.get();
+        if (const auto* data = static_cast<const std::byte*>(mapped.data())) {
+            capture.buffers[readback.buffer].contents.assign(data, data + readback.size);
+        }
+    }
+}
+
+} // namespace
+
+CaptureRecorder::CaptureRecorder(const std::shared_ptr<ILogicalDevice>& device)
+    : _session(std::make_shared<detail::CaptureSession>(device)) {
+}
+
+CaptureRecorder::~CaptureRecorder() = default;
+
+std::shared_ptr<IQueue> CaptureRecorder::wrapQueue(const std::shared_ptr<IQueue>& queue) {
+    if (!queue) {
+        return nullptr;
+    }
+    return std::make_shared<RecordingQueue>(queue, _session);
+}
+
+std::shared_ptr<ICommandEncoder> CaptureRecorder::wrapEncoder(const std::shared_ptr<ICommandEncoder>& encoder) {
+    if (!encoder) {
+        return nullptr;
+    }
+    return std::make_shared<RecordingCommandEncoder>(encoder, _session);
+}
+
+void CaptureRecorder::beginCapture() {
+    auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+    _session->begin();
+}
+
+bool CaptureRecorder::isCapturing() const {
+    auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+    return _session->getActiveGeneration() != 0;
+}
+
+bool CaptureRecorder::endCapture(FrameCapture& capture) {
+    std::vector<std::shared_ptr<IBuffer>> buffers;
+    {
+        auto guard = makeLockGuard(_session->mutex, PERS_SOURCE_LOC);
+        if (!_session->end(capture, buffers)) {
+            LOG_WARNING("CaptureRecorder", "endCapture called without beginCapture");
+            return false;
+        }
+    }
+
+    // After the frame, so buffers filled by earlier frames are captured as
+    // they are; writes made during the frame are replayed from the stream
+    if (auto device = _session->getDevice().lock()) {
+        readBufferContents(device, buffers, capture);
+    }
+
+    size_t withContents = 0;
+    for (const auto& buffer : capture.buffers) {
+        withContents += buffer.contents.empty() ? 0 : 1;
+    }
+    Logger::Instance().LogFormat(LogLevel::Info, "CaptureRecorder", PERS_SOURCE_LOC,
+        "Captured %u commands, %zu buffers (%zu with contents), %zu pipelines, %u skipped",
+        capture.commandCount, capture.buffers.size(), withContents, capture.pipelines.size(),
+        capture.skippedCommands);
+    return true;
+}
+
+} // namespace pers
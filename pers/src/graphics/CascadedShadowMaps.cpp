@@ -0,0 +1,469 @@
+#include "pers/graphics/CascadedShadowMaps.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace pers {
+
+namespace {
+
+using Vec3 = std::array<float, 3>;
+
+struct ShadowUniforms {
+    float viewProjection[CascadedShadowMaps::MAX_CASCADES][16];
+    float splits[4];
+    float texelSizes[4];
+    uint32_t cascadeCount;
+    float depthBias;
+    float normalBias;
+    uint32_t padding;
+};
+
+constexpr char TYPES_WGSL[] = R"(
+struct ShadowUniforms {
+    viewProjection: array<mat4x4<f32>, 4>,
+    splits: vec4<f32>,
+    texelSizes: vec4<f32>,
+    cascadeCount: u32,
+    depthBias: f32,
+    normalBias: f32,
+    padding: u32,
+};
+)";
+
+using UniformsLayout = GpuStruct<GpuLayout::Std140, GpuArray<GpuMat4x4f, 4>, GpuVec4f, GpuVec4f, GpuU32, GpuF32,
+                                 GpuF32, GpuU32>;
+static_assert(UniformsLayout::matchesWgsl(TYPES_WGSL, "ShadowUniforms"),
+              "ShadowUniforms no longer match the shadow shaders");
+static_assert(UniformsLayout::SIZE == sizeof(ShadowUniforms) &&
+              UniformsLayout::offsetOf<1>() == offsetof(ShadowUniforms, splits) &&
+              UniformsLayout::offsetOf<3>() == offsetof(ShadowUniforms, cascadeCount),
+              "ShadowUniforms must match the WGSL layout");
+
+constexpr char SHADING_FUNCTIONS[] = R"(
+// Cascade covering a fragment at viewDepth, cascadeCount beyond the last split
+fn shadowCascade(viewDepth: f32) -> u32 {
+    var cascade = 0u;
+    while (cascade < shadowUniforms.cascadeCount && viewDepth > shadowUniforms.splits[cascade]) {
+        cascade++;
+    }
+    return cascade;
+}
+
+// 1 lit, 0 shadowed; worldNormal is normalized, viewDepth positive
+fn shadowFactor(worldPosition: vec3<f32>, worldNormal: vec3<f32>, viewDepth: f32) -> f32 {
+    let cascade = shadowCascade(viewDepth);
+    if (cascade >= shadowUniforms.cascadeCount) {
+        return 1.0;
+    }
+    let offset = worldNormal * shadowUniforms.texelSizes[cascade] * shadowUniforms.normalBias;
+    let clip = shadowUniforms.viewProjection[cascade] * vec4<f32>(worldPosition + offset, 1.0);
+    let uv = clip.xy * vec2<f32>(0.5, -0.5) + vec2<f32>(0.5);
+    let depth = clip.z - shadowUniforms.depthBias;
+    let texel = 1.0 / vec2<f32>(textureDimensions(shadowMap));
+    var lit = 0.0;
+    for (var y = -1; y <= 1; y++) {
+        for (var x = -1; x <= 1; x++) {
+            lit += textureSampleCompareLevel(shadowMap, shadowSampler, uv + vec2<f32>(f32(x), f32(y)) * texel,
+                                             cascade, depth);
+        }
+    }
+    return lit / 9.0;
+}
+)";
+
+float dot(const Vec3& a, const Vec3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+Vec3 normalize(const Vec3& v) {
+    const float length = std::sqrt(dot(v, v));
+    return length > 0.0f ? Vec3{v[0] / length, v[1] / length, v[2] / length} : Vec3{0.0f, 0.0f, -1.0f};
+}
+
+// Rigid view: world = R^T * (viewPoint - t)
+Vec3 viewToWorld(const CascadedShadowMaps::Mat4& view, const Vec3& point) {
+    const Vec3 q{point[0] - view[12], point[1] - view[13], point[2] - view[14]};
+    return {view[0] * q[0] + view[1] * q[1] + view[2] * q[2],
+            view[4] * q[0] + view[5] * q[1] + view[6] * q[2],
+            view[8] * q[0] + view[9] * q[1] + view[10] * q[2]};
+}
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, DeviceBufferUsage::Uniform, device, name)) {
+        LOG_ERROR("CascadedShadowMaps", "Failed to create shadow uniform buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+bool writeUniforms(IQueue& queue, const std::shared_ptr<DeviceBuffer>& buffer, const void* data, size_t size) {
+    return queue.writeBuffer(buffer, 0, std::span<const std::byte>(static_cast<const std::byte*>(data), size));
+}
+
+} // anonymous namespace
+
+CascadedShadowMaps::CascadedShadowMaps(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("CascadedShadowMaps", "Device or resource factory is null");
+        return;
+    }
+
+    if (config.cascadeCount == 0 || config.cascadeCount > MAX_CASCADES || config.resolution == 0) {
+        LOG_ERROR("CascadedShadowMaps", "Cascade count must be 1 to MAX_CASCADES and resolution non-zero");
+        return;
+    }
+    if (config.depthFormat != TextureFormat::Depth32Float && config.depthFormat != TextureFormat::Depth16Unorm) {
+        LOG_WARNING("CascadedShadowMaps", "Depth format cannot be copied between textures, using Depth32Float");
+        _config.depthFormat = TextureFormat::Depth32Float;
+    }
+    // Padding the extent by more than a quarter of the map would waste most of it
+    _config.texelThreshold = std::clamp(_config.texelThreshold, 0.0f, static_cast<float>(_config.resolution) / 4.0f);
+
+    TextureDesc textureDesc;
+    textureDesc.width = _config.resolution;
+    textureDesc.height = _config.resolution;
+    textureDesc.depthOrArrayLayers = _config.cascadeCount;
+    textureDesc.format = _config.depthFormat;
+    textureDesc.usage = TextureUsage::RenderAttachment | TextureUsage::CopySrc;
+    textureDesc.label = "ShadowStaticCache";
+    _staticTexture = factory->createTexture(textureDesc);
+    textureDesc.usage = TextureUsage::RenderAttachment | TextureUsage::TextureBinding | TextureUsage::CopyDst;
+    textureDesc.label = "ShadowMap";
+    _shadowTexture = factory->createTexture(textureDesc);
+    if (!_staticTexture || !_shadowTexture) {
+        LOG_ERROR("CascadedShadowMaps", "Failed to create shadow textures");
+        return;
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = _config.depthFormat;
+    viewDesc.label = "ShadowCascade";
+    for (uint32_t cascade = 0; cascade < _config.cascadeCount; ++cascade) {
+        viewDesc.baseArrayLayer = cascade;
+        _staticViews[cascade] = factory->createTextureView(_staticTexture, viewDesc);
+        _shadowViews[cascade] = factory->createTextureView(_shadowTexture, viewDesc);
+        if (!_staticViews[cascade] || !_shadowViews[cascade]) {
+            LOG_ERROR("CascadedShadowMaps", "Failed to create cascade views");
+            return;
+        }
+    }
+    viewDesc.dimension = TextureViewDimension::D2Array;
+    viewDesc.baseArrayLayer = 0;
+    viewDesc.arrayLayerCount = _config.cascadeCount;
+    viewDesc.label = "ShadowMapArray";
+    _shadowArrayView = factory->createTextureView(_shadowTexture, viewDesc);
+
+    SamplerDesc samplerDesc;
+    samplerDesc.compare = CompareFunction::LessEqual;
+    samplerDesc.mipmapFilter = FilterMode::Nearest;
+    samplerDesc.label = "ShadowComparison";
+    _comparisonSampler = factory->createSampler(samplerDesc);
+
+    _uniformBuffer = createBuffer(device, sizeof(ShadowUniforms), "ShadowUniforms");
+    if (!_shadowArrayView || !_comparisonSampler || !_uniformBuffer) {
+        return;
+    }
+
+    BindGroupLayoutDesc casterLayoutDesc;
+    casterLayoutDesc.debugName = "ShadowCaster";
+    casterLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(Mat4)},
+    };
+    BindGroupLayoutDesc shadingLayoutDesc;
+    shadingLayoutDesc.debugName = "ShadowShading";
+    shadingLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ShadowUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::Depth, .viewDimension = TextureViewDimension::D2Array},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::ComparisonSampler},
+    };
+    _casterLayout = factory->createBindGroupLayout(casterLayoutDesc);
+    _shadingLayout = factory->createBindGroupLayout(shadingLayoutDesc);
+    if (!_casterLayout || !_shadingLayout) {
+        LOG_ERROR("CascadedShadowMaps", "Failed to create bind group layouts");
+        return;
+    }
+
+    for (uint32_t cascade = 0; cascade < _config.cascadeCount; ++cascade) {
+        _casterBuffers[cascade] = createBuffer(device, sizeof(Mat4), "ShadowCaster");
+        if (!_casterBuffers[cascade]) {
+            return;
+        }
+        BindGroupDesc casterDesc;
+        casterDesc.layout = _casterLayout;
+        casterDesc.debugName = "ShadowCaster";
+        casterDesc.entries.resize(1);
+        casterDesc.entries[0].binding = 0;
+        casterDesc.entries[0].buffer = _casterBuffers[cascade];
+        casterDesc.entries[0].size = sizeof(Mat4);
+        _casterBindGroups[cascade] = factory->createBindGroup(casterDesc);
+        if (!_casterBindGroups[cascade]) {
+            LOG_ERROR("CascadedShadowMaps", "Failed to create caster bind group");
+            return;
+        }
+    }
+
+    BindGroupDesc shadingDesc;
+    shadingDesc.layout = _shadingLayout;
+    shadingDesc.debugName = "ShadowShading";
+    shadingDesc.entries.resize(3);
+    shadingDesc.entries[0].binding = 0;
+    shadingDesc.entries[0].buffer = _uniformBuffer;
+    shadingDesc.entries[0].size = sizeof(ShadowUniforms);
+    shadingDesc.entries[1].binding = 1;
+    shadingDesc.entries[1].textureView = _shadowArrayView;
+    shadingDesc.entries[2].binding = 2;
+    shadingDesc.entries[2].sampler = _comparisonSampler;
+    _shadingBindGroup = factory->createBindGroup(shadingDesc);
+    if (!_shadingBindGroup) {
+        LOG_ERROR("CascadedShadowMaps", "Failed to create shading bind group");
+    }
+}
+
+CascadedShadowMaps::~CascadedShadowMaps() = default;
+
+void CascadedShadowMaps::setView(const Mat4& view, const Mat4& projection, float nearPlane,
+                                 const std::array<float, 3>& lightDirection) {
+    // A turned light invalidates every cascade's basis
+    const Vec3 forward = normalize(lightDirection);
+    if (dot(forward, _lightForward) < 0.99999f) {
+        _lightForward = forward;
+        const Vec3 upHint = std::abs(forward[1]) > 0.99f ? Vec3{1.0f, 0.0f, 0.0f} : Vec3{0.0f, 1.0f, 0.0f};
+        _lightRight = normalize(cross(forward, upHint));
+        _lightUp = cross(_lightRight, forward);
+        for (Cascade& cascade : _cascades) {
+            cascade.valid = false;
+        }
+    }
+
+    const float nearDistance = std::max(nearPlane, 1e-4f);
+    const float farDistance = std::max(_config.shadowDistance, nearDistance * 1.001f);
+    const uint32_t count = _config.cascadeCount;
+    float splitNear = nearDistance;
+    for (uint32_t index = 0; index < count; ++index) {
+        const float fraction = static_cast<float>(index + 1) / static_cast<float>(count);
+        const float logarithmic = nearDistance * std::pow(farDistance / nearDistance, fraction);
+        const float uniform = nearDistance + (farDistance - nearDistance) * fraction;
+        const float splitFar = _config.splitLambda * logarithmic + (1.0f - _config.splitLambda) * uniform;
+
+        // Slice corners in view space, along the rays through the NDC corners
+        std::array<Vec3, 8> corners;
+        for (uint32_t corner = 0; corner < 8; ++corner) {
+            const float ndcX = (corner & 1) ? 1.0f : -1.0f;
+            const float ndcY = (corner & 2) ? 1.0f : -1.0f;
+            const float depth = (corner & 4) ? splitFar : splitNear;
+            corners[corner] = {depth * (ndcX + projection[8]) / projection[0],
+                               depth * (ndcY + projection[9]) / projection[5], -depth};
+        }
+
+        // Centroid and radius depend only on the projection, so the sphere is the same however the camera turns
+        Vec3 center{0.0f, 0.0f, 0.0f};
+        for (const Vec3& corner : corners) {
+            for (int axis = 0; axis < 3; ++axis) {
+                center[axis] += corner[axis] / 8.0f;
+            }
+        }
+        float radius = 0.0f;
+        for (const Vec3& corner : corners) {
+            const Vec3 delta{corner[0] - center[0], corner[1] - center[1], corner[2] - center[2]};
+            radius = std::max(radius, std::sqrt(dot(delta, delta)));
+        }
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        Cascade& cascade = _cascades[index];
+        cascade.splitFar = splitFar;
+        fitCascade(cascade, viewToWorld(view, center), radius);
+        splitNear = splitFar;
+    }
+}
+
+void CascadedShadowMaps::fitCascade(Cascade& cascade, const std::array<float, 3>& worldCenter, float radius) const {
+    // Padded so the sphere stays inside while the cascade drifts by up to the threshold
+    const float resolution = static_cast<float>(_config.resolution);
+    const float halfExtent = radius / (1.0f - 2.0f * _config.texelThreshold / resolution);
+    const float texelSize = 2.0f * halfExtent / resolution;
+    const Vec3 center{dot(worldCenter, _lightRight), dot(worldCenter, _lightUp), dot(worldCenter, _lightForward)};
+
+    if (cascade.valid && std::abs(cascade.halfExtent - halfExtent) <= halfExtent * 1e-5f) {
+        float drift = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            drift = std::max(drift, std::abs(center[axis] - cascade.center[axis]));
+        }
+        if (drift <= _config.texelThreshold * texelSize) {
+            return;
+        }
+    }
+
+    cascade.center = {std::round(center[0] / texelSize) * texelSize, std::round(center[1] / texelSize) * texelSize,
+                      center[2]};
+    cascade.halfExtent = halfExtent;
+    cascade.valid = true;
+    cascade.staticDirty = true;
+
+    // Orthographic light view-projection; depth 0 faces the light, extended toward it for off-screen casters
+    const float depthNear = cascade.center[2] - halfExtent - _config.casterDistance;
+    const float depthRange = 2.0f * halfExtent + _config.casterDistance;
+    Mat4& m = cascade.viewProjection;
+    for (int axis = 0; axis < 3; ++axis) {
+        m[axis * 4 + 0] = _lightRight[axis] / halfExtent;
+        m[axis * 4 + 1] = _lightUp[axis] / halfExtent;
+        m[axis * 4 + 2] = _lightForward[axis] / depthRange;
+        m[axis * 4 + 3] = 0.0f;
+    }
+    m[12] = -cascade.center[0] / halfExtent;
+    m[13] = -cascade.center[1] / halfExtent;
+    m[14] = -depthNear / depthRange;
+    m[15] = 1.0f;
+}
+
+void CascadedShadowMaps::invalidateStatic() {
+    for (Cascade& cascade : _cascades) {
+        cascade.staticDirty = true;
+    }
+}
+
+void CascadedShadowMaps::invalidateStatic(const std::array<float, 3>& center, float radius) {
+    const Vec3 light{dot(center, _lightRight), dot(center, _lightUp), dot(center, _lightForward)};
+    for (Cascade& cascade : _cascades) {
+        if (!cascade.valid) {
+            continue;
+        }
+        const float reach = cascade.halfExtent + radius;
+        const bool inside = std::abs(light[0] - cascade.center[0]) <= reach &&
+                            std::abs(light[1] - cascade.center[1]) <= reach &&
+                            light[2] + radius >= cascade.center[2] - cascade.halfExtent - _config.casterDistance &&
+                            light[2] - radius <= cascade.center[2] + cascade.halfExtent;
+        cascade.staticDirty = cascade.staticDirty || inside;
+    }
+}
+
+bool CascadedShadowMaps::render(ICommandEncoder& encoder, const DrawCasters& drawStatic,
+                                const DrawCasters& drawDynamic) {
+    PERS_PROFILE_SCOPE("CascadedShadowMaps::render");
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("CascadedShadowMaps", "Cannot render invalid shadow maps");
+        return false;
+    }
+
+    const uint32_t count = _config.cascadeCount;
+    ShadowUniforms uniforms = {};
+    for (uint32_t index = 0; index < count; ++index) {
+        const Cascade& cascade = _cascades[index];
+        std::copy(cascade.viewProjection.begin(), cascade.viewProjection.end(), uniforms.viewProjection[index]);
+        uniforms.splits[index] = cascade.valid ? cascade.splitFar : 0.0f;
+        uniforms.texelSizes[index] = 2.0f * cascade.halfExtent / static_cast<float>(_config.resolution);
+        if (!writeUniforms(*queue, _casterBuffers[index], cascade.viewProjection.data(), sizeof(Mat4))) {
+            LOG_ERROR("CascadedShadowMaps", "Failed to write caster uniforms");
+            return false;
+        }
+    }
+    uniforms.cascadeCount = count;
+    uniforms.depthBias = _config.depthBias;
+    uniforms.normalBias = _config.normalBias;
+    if (!writeUniforms(*queue, _uniformBuffer, &uniforms, sizeof(uniforms))) {
+        LOG_ERROR("CascadedShadowMaps", "Failed to write shadow uniforms");
+        return false;
+    }
+
+    auto drawPass = [&](const std::shared_ptr<ITextureView>& view, LoadOp loadOp, uint32_t index,
+                        const DrawCasters& draw, const char* label) {
+        RenderPassDesc passDesc;
+        passDesc.label = label;
+        passDesc.depthStencilAttachment = std::make_shared<RenderPassDepthStencilAttachment>();
+        passDesc.depthStencilAttachment->view = view;
+        passDesc.depthStencilAttachment->depthLoadOp = loadOp;
+        passDesc.depthStencilAttachment->depthStoreOp = StoreOp::Store;
+        passDesc.depthStencilAttachment->depthClearValue = 1.0f;
+        auto pass = encoder.beginRenderPass(passDesc);
+        if (!pass) {
+            LOG_ERROR("CascadedShadowMaps", "Failed to begin shadow pass");
+            return false;
+        }
+        pass->setBindGroup(_config.casterGroup, _casterBindGroups[index]);
+        if (draw) {
+            draw(*pass, index);
+        }
+        pass->end();
+        return true;
+    };
+
+    for (uint32_t index = 0; index < count; ++index) {
+        Cascade& cascade = _cascades[index];
+        if (!cascade.valid) {
+            continue;
+        }
+
+        if (cascade.staticDirty) {
+            if (!drawPass(_staticViews[index], LoadOp::Clear, index, drawStatic, "ShadowStatic")) {
+                return false;
+            }
+            cascade.staticDirty = false;
+            cascade.layerCurrent = false;
+            ++_staticRenderCount;
+        }
+
+        // Restore the cached static depth, skipped while the layer already holds exactly that
+        if (!cascade.layerCurrent || drawDynamic) {
+            TextureCopyDesc copyDesc;
+            copyDesc.srcArrayLayer = index;
+            copyDesc.dstArrayLayer = index;
+            if (!encoder.copyTextureToTexture(_staticTexture, _shadowTexture, copyDesc)) {
+                LOG_ERROR("CascadedShadowMaps", "Failed to copy cached static shadows");
+                return false;
+            }
+            cascade.layerCurrent = true;
+        }
+
+        if (drawDynamic) {
+            if (!drawPass(_shadowViews[index], LoadOp::Load, index, drawDynamic, "ShadowDynamic")) {
+                return false;
+            }
+            cascade.layerCurrent = false;
+        }
+    }
+    return true;
+}
+
+std::string CascadedShadowMaps::getShaderDeclarations(uint32_t group) const {
+    const std::string prefix = "@group(" + std::to_string(group) + ") ";
+    return std::string(TYPES_WGSL) +
+           prefix + "@binding(0) var<uniform> shadowUniforms: ShadowUniforms;\n" +
+           prefix + "@binding(1) var shadowMap: texture_depth_2d_array;\n" +
+           prefix + "@binding(2) var shadowSampler: sampler_comparison;\n" +
+           SHADING_FUNCTIONS;
+}
+
+std::string CascadedShadowMaps::getCasterShaderDeclarations() const {
+    return "@group(" + std::to_string(_config.casterGroup) +
+           ") @binding(0) var<uniform> shadowCasterViewProjection: mat4x4<f32>;\n";
+}
+
+} // namespace pers
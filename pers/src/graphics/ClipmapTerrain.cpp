@@ -0,0 +1,798 @@
+#include "pers/graphics/ClipmapTerrain.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/scene/Frustum.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct TerrainUniforms {
+    float viewProjection[16];
+    float planes[6][4];
+    float cameraPosition[3];
+    float cellSize;
+    float lightDirection[3];
+    float minHeight;
+    float maxHeight;
+    float morphStart;
+    float morphWidth;
+    uint32_t blockSize;
+    uint32_t textureSize;
+    uint32_t pieceCount;
+    uint32_t levelCount;
+    uint32_t lowColor;
+    uint32_t highColor;
+    uint32_t padding[3];
+};
+
+struct Piece {
+    int32_t originX;  // Lowest cell, in level grid units
+    int32_t originZ;
+    uint32_t level;
+    uint32_t flags;   // Shape, plus ROTATED
+};
+
+// Every shape is a prefix of the grid's row-major index buffer: rows of
+// blockSize cells, except the single cell
+constexpr uint32_t SHAPE_BLOCK = 0;  // blockSize x blockSize
+constexpr uint32_t SHAPE_FIXUP = 1;  // blockSize x 2, between the blocks of a ring
+constexpr uint32_t SHAPE_STRIP = 2;  // blockSize x 1, the interior trim
+constexpr uint32_t SHAPE_CELL = 3;   // 1 x 1
+constexpr uint32_t SHAPE_COUNT = 4;
+constexpr uint32_t ROTATED = 4;      // Quarter turn, the rows run along z
+
+// Instances per level of each shape at most; levels above 0 need fewer blocks
+// and cells but also strips
+constexpr uint32_t PIECE_CAPACITY[SHAPE_COUNT] = {16, 8, 4, 4};
+constexpr uint32_t PIECES_PER_LEVEL = 32;
+
+// Camera cells stay well inside int32, so every level's window does too
+constexpr double GRID_LIMIT = double(1 << 29);
+
+constexpr char TYPES_WGSL[] = R"(
+struct Terrain {
+    viewProjection: mat4x4<f32>,
+    planes: array<vec4<f32>, 6>,
+    cameraPosition: vec3<f32>,
+    cellSize: f32,
+    lightDirection: vec3<f32>,
+    minHeight: f32,
+    maxHeight: f32,
+    morphStart: f32,
+    morphWidth: f32,
+    blockSize: u32,
+    textureSize: u32,
+    pieceCount: u32,
+    levelCount: u32,
+    lowColor: u32,
+    highColor: u32,
+    padding0: u32,
+    padding1: u32,
+    padding2: u32,
+};
+
+struct Piece {
+    origin: vec2<i32>,
+    level: u32,
+    flags: u32,
+};
+
+const SHAPE_FIXUP = 1u;
+const SHAPE_STRIP = 2u;
+const SHAPE_CELL = 3u;
+const ROTATED = 4u;
+
+// Cells covered along x and z
+fn shapeSize(flags: u32, blockSize: u32) -> vec2<u32> {
+    let shape = flags & 3u;
+    var size = vec2<u32>(blockSize, blockSize);
+    if (shape == SHAPE_FIXUP) {
+        size.y = 2u;
+    } else if (shape == SHAPE_STRIP) {
+        size.y = 1u;
+    } else if (shape == SHAPE_CELL) {
+        size = vec2<u32>(1u, 1u);
+    }
+    if ((flags & ROTATED) != 0u) {
+        size = size.yx;
+    }
+    return size;
+}
+)";
+
+constexpr char CULL_MAIN[] = R"(
+struct DrawArgs {
+    indexCount: u32,
+    instanceCount: atomic<u32>,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+};
+
+@group(0) @binding(0) var<uniform> terrain: Terrain;
+@group(0) @binding(1) var<storage, read> pieces: array<Piece>;
+@group(0) @binding(2) var<storage, read_write> visible: array<Piece>;
+@group(0) @binding(3) var<storage, read_write> drawArgs: array<DrawArgs, 4>;
+
+// Start of each shape's instance list, see PIECE_CAPACITY
+fn shapeBase(shape: u32) -> u32 {
+    switch (shape) {
+        case 1u: { return 16u * terrain.levelCount; }
+        case 2u: { return 24u * terrain.levelCount; }
+        case 3u: { return 28u * terrain.levelCount; }
+        default: { return 0u; }
+    }
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= terrain.pieceCount) {
+        return;
+    }
+
+    let piece = pieces[i];
+    let cell = terrain.cellSize * exp2(f32(piece.level));
+    let size = vec2<i32>(shapeSize(piece.flags, terrain.blockSize));
+    let boxMin = vec3<f32>(f32(piece.origin.x) * cell, terrain.minHeight, f32(piece.origin.y) * cell);
+    let boxMax = vec3<f32>(f32(piece.origin.x + size.x) * cell, terrain.maxHeight,
+                           f32(piece.origin.y + size.y) * cell);
+    for (var p = 0u; p < 6u; p = p + 1u) {
+        let plane = terrain.planes[p];
+        let corner = select(boxMin, boxMax, plane.xyz >= vec3<f32>(0.0));
+        if (dot(plane.xyz, corner) + plane.w < 0.0) {
+            return;
+        }
+    }
+
+    let shape = piece.flags & 3u;
+    let slot = atomicAdd(&drawArgs[shape].instanceCount, 1u);
+    visible[shapeBase(shape) + slot] = piece;
+}
+)";
+
+constexpr char RENDER_BINDINGS[] = R"(
+@group(0) @binding(0) var<uniform> terrain: Terrain;
+@group(0) @binding(1) var heights: texture_2d_array<f32>;
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) normal: vec3<f32>,
+    @location(1) height: f32,
+};
+)";
+
+constexpr char VERTEX_MAIN[] = R"(
+// Layers are toroidal windows, grid coordinates wrap around the texture
+fn height(grid: vec2<i32>, level: u32) -> f32 {
+    let size = i32(terrain.textureSize);
+    let texel = ((grid % size) + size) % size;
+    return textureLoad(heights, texel, i32(level), 0).r;
+}
+
+@vertex
+fn main(@location(0) local: vec2<u32>, @location(1) piece: vec4<i32>) -> VertexOutput {
+    let flags = u32(piece.w);
+    let level = u32(piece.z);
+    var offset = vec2<i32>(local);
+    if ((flags & ROTATED) != 0u) {
+        offset = vec2<i32>(i32(shapeSize(flags, terrain.blockSize).x) - offset.y, offset.x);
+    }
+    let grid = piece.xy + offset;
+    let cell = terrain.cellSize * exp2(f32(level));
+
+    // Towards the outer edge, odd vertices slide onto the parent level's
+    // surface: the average of the even neighbours on the parent's edge or
+    // diagonal. At the edge itself they match the parent exactly.
+    let odd = grid & vec2<i32>(1);
+    let fine = height(grid, level);
+    let coarse = 0.5 * (height(grid + vec2<i32>(-odd.x, odd.y), level) +
+                        height(grid + vec2<i32>(odd.x, -odd.y), level));
+    let camera = terrain.cameraPosition.xz / cell;
+    let reach = max(abs(f32(grid.x) - camera.x), abs(f32(grid.y) - camera.y));
+    let blend = clamp((reach - terrain.morphStart) / terrain.morphWidth, 0.0, 1.0);
+    let y = mix(fine, coarse, blend);
+
+    let dx = height(grid + vec2<i32>(1, 0), level) - height(grid - vec2<i32>(1, 0), level);
+    let dz = height(grid + vec2<i32>(0, 1), level) - height(grid - vec2<i32>(0, 1), level);
+
+    var output: VertexOutput;
+    output.position = terrain.viewProjection * vec4<f32>(f32(grid.x) * cell, y, f32(grid.y) * cell, 1.0);
+    output.normal = vec3<f32>(-dx, 2.0 * cell, -dz);
+    output.height = y;
+    return output;
+}
+)";
+
+constexpr char FRAGMENT_MAIN[] = R"(
+@fragment
+fn main(input: VertexOutput) -> @location(0) vec4<f32> {
+    let range = max(terrain.maxHeight - terrain.minHeight, 1e-6);
+    let t = clamp((input.height - terrain.minHeight) / range, 0.0, 1.0);
+    let albedo = mix(unpack4x8unorm(terrain.lowColor), unpack4x8unorm(terrain.highColor), t);
+    let light = max(dot(normalize(input.normal), normalize(terrain.lightDirection)), 0.0);
+    return vec4<f32>(albedo.rgb * (0.25 + 0.75 * light), albedo.a);
+}
+)";
+
+using TerrainLayout = GpuStruct<GpuLayout::Std140, GpuMat4x4f, GpuArray<GpuVec4f, 6>, GpuVec3f, GpuF32, GpuVec3f, GpuF32,
+                                GpuF32, GpuF32, GpuF32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32,
+                                GpuU32>;
+static_assert(TerrainLayout::matchesWgsl(TYPES_WGSL, "Terrain"), "Terrain no longer matches the terrain shaders");
+static_assert(TerrainLayout::SIZE == sizeof(TerrainUniforms) &&
+              TerrainLayout::offsetOf<2>() == offsetof(TerrainUniforms, cameraPosition) &&
+              TerrainLayout::offsetOf<9>() == offsetof(TerrainUniforms, blockSize),
+              "TerrainUniforms must match the WGSL layout");
+
+using PieceLayout = GpuStruct<GpuLayout::Std430, GpuVec2i, GpuU32, GpuU32>;
+static_assert(PieceLayout::matchesWgsl(TYPES_WGSL, "Piece"), "Piece no longer matches the terrain shaders");
+static_assert(PieceLayout::SIZE == sizeof(Piece), "Piece must match the WGSL layout");
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create terrain shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           DeviceBufferUsage usage, const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, device, name)) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create terrain buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+template <typename T>
+std::span<const std::byte> asBytes(const T& value) {
+    return std::span<const std::byte>(reinterpret_cast<const std::byte*>(&value), sizeof(T));
+}
+
+uint32_t shapeIndexCount(uint32_t shape, uint32_t blockSize) {
+    switch (shape) {
+        case SHAPE_BLOCK: return blockSize * blockSize * 6;
+        case SHAPE_FIXUP: return 2 * blockSize * 6;
+        case SHAPE_STRIP: return blockSize * 6;
+        default: return 6;
+    }
+}
+
+uint32_t wrap(int32_t value, uint32_t size) {
+    const int32_t remainder = value % static_cast<int32_t>(size);
+    return static_cast<uint32_t>(remainder < 0 ? remainder + static_cast<int32_t>(size) : remainder);
+}
+
+} // anonymous namespace
+
+ClipmapTerrain::ClipmapTerrain(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _blockSize(std::clamp(config.blockSize, MIN_BLOCK_SIZE, MAX_BLOCK_SIZE))
+    , _levelCount(std::clamp(config.levelCount, 1u, MAX_LEVEL_COUNT))
+    , _textureSize(4 * _blockSize + 5)
+    , _config(config)
+    , _levels(_levelCount) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue) {
+        LOG_ERROR("ClipmapTerrain", "Device, resource factory or queue is null");
+        return;
+    }
+    if (!config.loader || !(config.cellSize > 0.0f)) {
+        LOG_ERROR("ClipmapTerrain", "Terrain needs a height loader and a positive cell size");
+        return;
+    }
+    if (_blockSize != config.blockSize || _levelCount != config.levelCount) {
+        LOG_WARNING("ClipmapTerrain", "Block size or level count clamped to " + std::to_string(_blockSize) + " and " +
+                    std::to_string(_levelCount));
+    }
+
+    // One grid of blockSize^2 cells, quads row by row along z so that every
+    // shape is a prefix of the index buffer
+    const uint32_t side = _blockSize + 1;
+    std::vector<uint16_t> vertices;
+    vertices.reserve(2 * side * side);
+    for (uint32_t z = 0; z < side; ++z) {
+        for (uint32_t x = 0; x < side; ++x) {
+            vertices.push_back(static_cast<uint16_t>(x));
+            vertices.push_back(static_cast<uint16_t>(z));
+        }
+    }
+    std::vector<uint16_t> indices;
+    indices.reserve(shapeIndexCount(SHAPE_BLOCK, _blockSize));
+    for (uint32_t z = 0; z < _blockSize; ++z) {
+        for (uint32_t x = 0; x < _blockSize; ++x) {
+            const uint16_t v = static_cast<uint16_t>(z * side + x);
+            const uint16_t below = static_cast<uint16_t>(v + side);
+            indices.insert(indices.end(), {v, below, static_cast<uint16_t>(v + 1),
+                                           static_cast<uint16_t>(v + 1), below, static_cast<uint16_t>(below + 1)});
+        }
+    }
+
+    const uint64_t pieceCapacity = uint64_t(PIECES_PER_LEVEL) * _levelCount;
+    _uniformBuffer = createBuffer(device, sizeof(TerrainUniforms), DeviceBufferUsage::Uniform, "TerrainUniforms");
+    _gridVertices = createBuffer(device, vertices.size() * sizeof(uint16_t), DeviceBufferUsage::Vertex,
+                                 "TerrainGridVertices");
+    _gridIndices = createBuffer(device, indices.size() * sizeof(uint16_t), DeviceBufferUsage::Index,
+                                "TerrainGridIndices");
+    _pieces = createBuffer(device, pieceCapacity * sizeof(Piece), DeviceBufferUsage::Storage, "TerrainPieces");
+    _visiblePieces = createBuffer(device, pieceCapacity * sizeof(Piece),
+                                  DeviceBufferUsage::Storage | DeviceBufferUsage::Vertex, "TerrainVisiblePieces");
+    _drawArgs = createBuffer(device, SHAPE_COUNT * sizeof(DrawIndexedIndirectArgs),
+                             DeviceBufferUsage::Storage | DeviceBufferUsage::Indirect, "TerrainDrawArgs");
+    if (!_uniformBuffer || !_gridVertices || !_gridIndices || !_pieces || !_visiblePieces || !_drawArgs) {
+        return;
+    }
+    if (!queue->writeBuffer(_gridVertices, 0, std::as_bytes(std::span<const uint16_t>(vertices))) ||
+        !queue->writeBuffer(_gridIndices, 0, std::as_bytes(std::span<const uint16_t>(indices)))) {
+        LOG_ERROR("ClipmapTerrain", "Failed to upload the grid mesh");
+        return;
+    }
+
+    TextureDesc textureDesc;
+    textureDesc.width = _textureSize;
+    textureDesc.height = _textureSize;
+    textureDesc.depthOrArrayLayers = _levelCount;
+    textureDesc.format = HEIGHT_FORMAT;
+    textureDesc.usage = TextureUsage::TextureBinding | TextureUsage::CopyDst;
+    textureDesc.label = "TerrainHeights";
+    _heightTexture = factory->createTexture(textureDesc);
+    TextureViewDesc viewDesc;
+    viewDesc.format = HEIGHT_FORMAT;
+    viewDesc.dimension = TextureViewDimension::D2Array;
+    viewDesc.arrayLayerCount = _levelCount;
+    auto heightView = _heightTexture ? factory->createTextureView(_heightTexture, viewDesc) : nullptr;
+    if (!heightView) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create height texture");
+        return;
+    }
+
+    BindGroupLayoutDesc cullLayoutDesc;
+    cullLayoutDesc.debugName = "TerrainCull";
+    cullLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(TerrainUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    BindGroupLayoutDesc renderLayoutDesc;
+    renderLayoutDesc.debugName = "TerrainRender";
+    renderLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex | ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(TerrainUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Vertex, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::UnfilterableFloat, .viewDimension = TextureViewDimension::D2Array},
+    };
+    auto cullLayout = factory->createBindGroupLayout(cullLayoutDesc);
+    auto renderLayout = factory->createBindGroupLayout(renderLayoutDesc);
+    if (!cullLayout || !renderLayout) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create bind group layouts");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {cullLayout};
+    pipelineLayoutDesc.debugName = "TerrainCull";
+    auto cullPipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    pipelineLayoutDesc.bindGroupLayouts = {renderLayout};
+    pipelineLayoutDesc.debugName = "TerrainRender";
+    _renderLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!cullPipelineLayout || !_renderLayout) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create pipeline layouts");
+        return;
+    }
+
+    auto cullShader = createShader(*factory, std::string(TYPES_WGSL) + CULL_MAIN, ShaderStage::Compute, "TerrainCull");
+    const std::string renderPrefix = std::string(TYPES_WGSL) + RENDER_BINDINGS;
+    _vertexShader = createShader(*factory, renderPrefix + VERTEX_MAIN, ShaderStage::Vertex, "TerrainVertex");
+    _fragmentShader = createShader(*factory, renderPrefix + FRAGMENT_MAIN, ShaderStage::Fragment, "TerrainFragment");
+    if (!cullShader || !_vertexShader || !_fragmentShader) {
+        return;
+    }
+
+    ComputePipelineDesc cullDesc;
+    cullDesc.compute = cullShader;
+    cullDesc.layout = cullPipelineLayout;
+    cullDesc.debugName = "TerrainCull";
+    _cullPipeline = factory->createComputePipeline(cullDesc);
+    if (!_cullPipeline) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create culling pipeline");
+        return;
+    }
+
+    BindGroupDesc cullBindGroupDesc;
+    cullBindGroupDesc.layout = cullLayout;
+    cullBindGroupDesc.debugName = "TerrainCull";
+    cullBindGroupDesc.entries.resize(4);
+    cullBindGroupDesc.entries[0].binding = 0;
+    cullBindGroupDesc.entries[0].buffer = _uniformBuffer;
+    cullBindGroupDesc.entries[0].size = sizeof(TerrainUniforms);
+    cullBindGroupDesc.entries[1].binding = 1;
+    cullBindGroupDesc.entries[1].buffer = _pieces;
+    cullBindGroupDesc.entries[2].binding = 2;
+    cullBindGroupDesc.entries[2].buffer = _visiblePieces;
+    cullBindGroupDesc.entries[3].binding = 3;
+    cullBindGroupDesc.entries[3].buffer = _drawArgs;
+    _cullBindGroup = factory->createBindGroup(cullBindGroupDesc);
+
+    BindGroupDesc renderBindGroupDesc;
+    renderBindGroupDesc.layout = renderLayout;
+    renderBindGroupDesc.debugName = "TerrainRender";
+    renderBindGroupDesc.entries.resize(2);
+    renderBindGroupDesc.entries[0].binding = 0;
+    renderBindGroupDesc.entries[0].buffer = _uniformBuffer;
+    renderBindGroupDesc.entries[0].size = sizeof(TerrainUniforms);
+    renderBindGroupDesc.entries[1].binding = 1;
+    renderBindGroupDesc.entries[1].textureView = heightView;
+
+    // Created last, isValid() means every stage is usable
+    if (_cullBindGroup) {
+        _renderBindGroup = factory->createBindGroup(renderBindGroupDesc);
+    }
+    if (!_renderBindGroup) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create terrain bind groups");
+    }
+}
+
+ClipmapTerrain::~ClipmapTerrain() = default;
+
+bool ClipmapTerrain::update(const Vec3& cameraPosition) {
+    PERS_PROFILE_SCOPE("ClipmapTerrain::update");
+    if (!isValid()) {
+        LOG_ERROR("ClipmapTerrain", "Cannot update invalid terrain");
+        return false;
+    }
+
+    _stats.movedLevels = 0;
+    _stats.uploadedTexels = 0;
+
+    // Camera cell of level 0
+    auto gridCoordinate = [this](float position) {
+        const double cell = std::floor(double(position) / double(_config.cellSize));
+        return static_cast<int32_t>(std::clamp(cell, -GRID_LIMIT, GRID_LIMIT));
+    };
+    const int32_t cameraX = gridCoordinate(cameraPosition[0]);
+    const int32_t cameraZ = gridCoordinate(cameraPosition[2]);
+
+    // Level l sits on even coordinates two cells around the camera's cell of
+    // level l + 1, which keeps its edges on its parent's vertices. Whether
+    // the camera is in the low or high half of that parent cell decides on
+    // which side of the parent the 1-cell trim goes.
+    const int32_t blockSize = static_cast<int32_t>(_blockSize);
+    const int32_t size = static_cast<int32_t>(_textureSize);
+    std::vector<Level> levels(_levelCount);
+    std::vector<Region> regions;
+    _uploadData.clear();
+    for (uint32_t level = 0; level < _levelCount; ++level) {
+        Level& next = levels[level];
+        next.originX = 2 * (cameraX >> (level + 1)) - 2 * blockSize;
+        next.originZ = 2 * (cameraZ >> (level + 1)) - 2 * blockSize;
+        next.trimX = static_cast<uint32_t>((cameraX >> level) & 1);
+        next.trimZ = static_cast<uint32_t>((cameraZ >> level) & 1);
+        next.resident = true;
+
+        const Level& current = _levels[level];
+        const int32_t dx = next.originX - current.originX;
+        const int32_t dz = next.originZ - current.originZ;
+        if (current.resident && dx == 0 && dz == 0) {
+            continue;
+        }
+        ++_stats.movedLevels;
+
+        // Windows start a texel before the footprint so edge normals have both neighbours
+        const int32_t x = next.originX - 1;
+        const int32_t z = next.originZ - 1;
+        if (!current.resident || std::abs(dx) >= size || std::abs(dz) >= size) {
+            addRegion(regions, level, x, z, _textureSize, _textureSize);
+            continue;
+        }
+        if (dx != 0) {
+            addRegion(regions, level, dx > 0 ? x + size - dx : x, z, std::abs(dx), _textureSize);
+        }
+        if (dz != 0) {
+            addRegion(regions, level, x + std::max(-dx, 0), dz > 0 ? z + size - dz : z, size - std::abs(dx),
+                      std::abs(dz));
+        }
+    }
+    if (regions.empty()) {
+        _cameraPosition = cameraPosition;
+        return true;
+    }
+
+    // Everything is loaded before anything is written, so a level either
+    // moves completely or stays where it was
+    for (const Region& region : regions) {
+        std::span<float> heights(_uploadData.data() + region.offset, size_t(region.width) * region.height);
+        if (!_config.loader(region.level, region.x, region.z, region.width, region.height, heights)) {
+            return false;
+        }
+    }
+    for (const Region& region : regions) {
+        if (!writeRegion(region)) {
+            LOG_ERROR("ClipmapTerrain", "Failed to write terrain heights");
+            invalidate();
+            return false;
+        }
+        _stats.uploadedTexels += uint64_t(region.width) * region.height;
+    }
+
+    _levels = std::move(levels);
+    _cameraPosition = cameraPosition;
+    return buildPieces();
+}
+
+bool ClipmapTerrain::cull(IComputePassEncoder& pass, const Mat4& viewProjection) {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("ClipmapTerrain", "Cannot cull invalid terrain");
+        return false;
+    }
+
+    // The morph must be complete at the outer edge, at least 2 * blockSize
+    // cells from the camera, and must not reach the child level's edge
+    const float morphWidth = std::max(1.0f, float(_blockSize / 2));
+    TerrainUniforms uniforms = {};
+    std::copy(viewProjection.begin(), viewProjection.end(), uniforms.viewProjection);
+    const Frustum frustum = Frustum::fromViewProjection(viewProjection.data());
+    for (size_t i = 0; i < frustum.planes.size(); ++i) {
+        std::copy(frustum.planes[i].begin(), frustum.planes[i].end(), uniforms.planes[i]);
+    }
+    std::copy(_cameraPosition.begin(), _cameraPosition.end(), uniforms.cameraPosition);
+    uniforms.cellSize = _config.cellSize;
+    std::copy(_shading.lightDirection.begin(), _shading.lightDirection.end(), uniforms.lightDirection);
+    uniforms.minHeight = _config.minHeight;
+    uniforms.maxHeight = std::max(_config.minHeight, _config.maxHeight);
+    uniforms.morphStart = float(2 * _blockSize) - morphWidth;
+    uniforms.morphWidth = morphWidth;
+    uniforms.blockSize = _blockSize;
+    uniforms.textureSize = _textureSize;
+    uniforms.pieceCount = _stats.pieceCount;
+    uniforms.levelCount = _levelCount;
+    uniforms.lowColor = _shading.lowColor;
+    uniforms.highColor = _shading.highColor;
+
+    DrawIndexedIndirectArgs drawArgs[SHAPE_COUNT];
+    for (uint32_t shape = 0; shape < SHAPE_COUNT; ++shape) {
+        drawArgs[shape].indexCount = shapeIndexCount(shape, _blockSize);
+    }
+    if (!queue->writeBuffer(_uniformBuffer, 0, asBytes(uniforms)) ||
+        !queue->writeBuffer(_drawArgs, 0, asBytes(drawArgs))) {
+        LOG_ERROR("ClipmapTerrain", "Failed to write culling uniforms");
+        return false;
+    }
+
+    if (_stats.pieceCount > 0) {
+        pass.setPipeline(_cullPipeline);
+        pass.setBindGroup(0, _cullBindGroup);
+        pass.dispatch((_stats.pieceCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+    }
+    return true;
+}
+
+bool ClipmapTerrain::render(IRenderPassEncoder& pass, const Target& target) {
+    if (!isValid()) {
+        LOG_ERROR("ClipmapTerrain", "Cannot render invalid terrain");
+        return false;
+    }
+
+    auto pipeline = getPipeline(target);
+    if (!pipeline) {
+        return false;
+    }
+
+    pass.setPipeline(pipeline);
+    pass.setBindGroup(0, _renderBindGroup);
+    pass.setIndexBuffer(_gridIndices, IndexFormat::Uint16);
+    pass.setVertexBuffer(0, _gridVertices);
+
+    // Each shape draws its own instance list as vertex-rate instance data,
+    // so no draw needs a nonzero firstInstance
+    uint64_t first = 0;
+    for (uint32_t shape = 0; shape < SHAPE_COUNT; ++shape) {
+        const uint64_t capacity = uint64_t(PIECE_CAPACITY[shape]) * _levelCount;
+        pass.setVertexBuffer(1, _visiblePieces, first * sizeof(Piece), capacity * sizeof(Piece));
+        pass.drawIndexedIndirect(_drawArgs, shape * sizeof(DrawIndexedIndirectArgs));
+        first += capacity;
+    }
+    return true;
+}
+
+void ClipmapTerrain::invalidate() {
+    for (Level& level : _levels) {
+        level.resident = false;
+    }
+}
+
+void ClipmapTerrain::addRegion(std::vector<Region>& regions, uint32_t level, int32_t x, int32_t z,
+                               uint32_t width, uint32_t height) {
+    Region region;
+    region.level = level;
+    region.x = x;
+    region.z = z;
+    region.width = width;
+    region.height = height;
+    region.offset = _uploadData.size();
+    regions.push_back(region);
+    _uploadData.resize(_uploadData.size() + size_t(width) * height);
+}
+
+bool ClipmapTerrain::writeRegion(const Region& region) {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        return false;
+    }
+
+    // A region wraps around the layer at most once per axis
+    const uint32_t texelX = wrap(region.x, _textureSize);
+    const uint32_t texelZ = wrap(region.z, _textureSize);
+    const uint32_t widths[2] = {std::min(region.width, _textureSize - texelX),
+                                region.width - std::min(region.width, _textureSize - texelX)};
+    const uint32_t heights[2] = {std::min(region.height, _textureSize - texelZ),
+                                 region.height - std::min(region.height, _textureSize - texelZ)};
+    for (uint32_t row = 0; row < 2; ++row) {
+        for (uint32_t column = 0; column < 2; ++column) {
+            if (widths[column] == 0 || heights[row] == 0) {
+                continue;
+            }
+            const uint32_t sourceX = column == 0 ? 0 : widths[0];
+            const uint32_t sourceZ = row == 0 ? 0 : heights[0];
+
+            TextureWriteDesc desc;
+            desc.texture = _heightTexture;
+            desc.originX = column == 0 ? texelX : 0;
+            desc.originY = row == 0 ? texelZ : 0;
+            desc.originZ = region.level;
+            desc.width = widths[column];
+            desc.height = heights[row];
+            desc.depthOrArrayLayers = 1;
+            desc.data = _uploadData.data();
+            desc.dataSize = _uploadData.size() * sizeof(float);
+            desc.dataOffset = (region.offset + size_t(sourceZ) * region.width + sourceX) * sizeof(float);
+            desc.bytesPerRow = region.width * sizeof(float);
+            if (!queue->writeTexture(desc)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool ClipmapTerrain::buildPieces() {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        return false;
+    }
+
+    // Along each axis a level is block, block, 2-cell fix-up, block, block.
+    // Level 0 fills all of it; coarser levels leave the middle 2 * blockSize + 2
+    // cells to the child, which covers all but a 1-cell L of it: that trim
+    // runs along the side the child does not reach.
+    const int32_t b = static_cast<int32_t>(_blockSize);
+    const int32_t segments[5] = {0, b, 2 * b, 2 * b + 2, 3 * b + 2};
+    std::vector<Piece> pieces;
+    pieces.reserve(size_t(PIECES_PER_LEVEL) * _levelCount);
+    for (uint32_t level = 0; level < _levelCount; ++level) {
+        const Level& footprint = _levels[level];
+        auto add = [&](int32_t x, int32_t z, uint32_t flags) {
+            pieces.push_back({footprint.originX + x, footprint.originZ + z, level, flags});
+        };
+
+        for (int32_t j = 0; j < 5; ++j) {
+            for (int32_t i = 0; i < 5; ++i) {
+                const bool interior = i >= 1 && i <= 3 && j >= 1 && j <= 3;
+                if (level > 0 && interior) {
+                    continue;
+                }
+                if (i != 2 && j != 2) {
+                    add(segments[i], segments[j], SHAPE_BLOCK);
+                } else if (j == 2 && i != 2) {
+                    add(segments[i], segments[j], SHAPE_FIXUP);
+                } else if (i == 2 && j != 2) {
+                    add(segments[i], segments[j], SHAPE_FIXUP | ROTATED);
+                } else {
+                    for (int32_t cell = 0; cell < 4; ++cell) {
+                        add(2 * b + (cell & 1), 2 * b + (cell >> 1), SHAPE_CELL);
+                    }
+                }
+            }
+        }
+        if (level == 0) {
+            continue;
+        }
+
+        const int32_t trimX = footprint.trimX ? b : 3 * b + 1;
+        const int32_t trimZ = footprint.trimZ ? b : 3 * b + 1;
+        add(trimX, b, SHAPE_STRIP | ROTATED);
+        add(trimX, 2 * b, SHAPE_CELL);
+        add(trimX, 2 * b + 1, SHAPE_CELL);
+        add(trimX, 2 * b + 2, SHAPE_STRIP | ROTATED);
+        const int32_t rowStart = trimX == b ? b + 1 : b;
+        add(rowStart, trimZ, SHAPE_STRIP);
+        add(rowStart + b, trimZ, SHAPE_CELL);
+        add(rowStart + b + 1, trimZ, SHAPE_STRIP);
+    }
+
+    if (!queue->writeBuffer(_pieces, 0, std::as_bytes(std::span<const Piece>(pieces)))) {
+        LOG_ERROR("ClipmapTerrain", "Failed to write terrain pieces");
+        return false;
+    }
+    _stats.pieceCount = static_cast<uint32_t>(pieces.size());
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> ClipmapTerrain::getPipeline(const Target& target) {
+    for (const PipelineEntry& entry : _pipelines) {
+        if (entry.target == target) {
+            return entry.pipeline;
+        }
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _renderLayout;
+    desc.vertexLayouts.resize(2);
+    desc.vertexLayouts[0].arrayStride = 2 * sizeof(uint16_t);
+    desc.vertexLayouts[0].attributes = {{.format = VertexFormat::Uint16x2, .offset = 0, .shaderLocation = 0}};
+    desc.vertexLayouts[1].arrayStride = sizeof(Piece);
+    desc.vertexLayouts[1].stepMode = VertexStepMode::Instance;
+    desc.vertexLayouts[1].attributes = {{.format = VertexFormat::Sint32x4, .offset = 0, .shaderLocation = 1}};
+    desc.primitive.topology = PrimitiveTopology::TriangleList;
+    desc.primitive.frontFace = FrontFace::CCW;
+    desc.primitive.cullMode = CullMode::Back;
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = true;
+    desc.depthStencil.depthCompare = CompareFunction::Less;
+    desc.multisample.count = target.sampleCount;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+    desc.debugName = "ClipmapTerrain";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("ClipmapTerrain", "Failed to create terrain pipeline");
+        return nullptr;
+    }
+
+    _pipelines.push_back({target, pipeline});
+    return pipeline;
+}
+
+} // namespace pers
@@ -0,0 +1,416 @@
+#include "pers/graphics/ClusteredLighting.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pers {
+
+namespace {
+
+struct ClusterUniforms {
+    float view[16];
+    float projection[4];
+    float screenSize[2];
+    float tileSize[2];
+    float nearPlane;
+    float farPlane;
+    float sliceScale;
+    float sliceBias;
+    uint32_t gridX;
+    uint32_t gridY;
+    uint32_t gridZ;
+    uint32_t lightCount;
+    uint32_t maxLightsPerCluster;
+    uint32_t padding[3];
+};
+
+constexpr char TYPES_WGSL[] = R"(
+struct ClusterUniforms {
+    view: mat4x4<f32>,
+    projection: vec4<f32>,
+    screenSize: vec2<f32>,
+    tileSize: vec2<f32>,
+    nearPlane: f32,
+    farPlane: f32,
+    sliceScale: f32,
+    sliceBias: f32,
+    gridX: u32,
+    gridY: u32,
+    gridZ: u32,
+    lightCount: u32,
+    maxLightsPerCluster: u32,
+    padding0: u32,
+    padding1: u32,
+    padding2: u32,
+};
+
+struct ClusterLight {
+    position: vec3<f32>,
+    range: f32,
+    color: vec3<f32>,
+    intensity: f32,
+    direction: vec3<f32>,
+    cosOuter: f32,
+    cosInner: f32,
+    padding0: f32,
+    padding1: f32,
+    padding2: f32,
+};
+)";
+
+using UniformsLayout = GpuStruct<GpuLayout::Std140, GpuMat4x4f, GpuVec4f, GpuVec2f, GpuVec2f, GpuF32, GpuF32, GpuF32,
+                                 GpuF32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(UniformsLayout::matchesWgsl(TYPES_WGSL, "ClusterUniforms"),
+              "ClusterUniforms no longer match the clustering shaders");
+static_assert(UniformsLayout::SIZE == sizeof(ClusterUniforms) &&
+              UniformsLayout::offsetOf<4>() == offsetof(ClusterUniforms, nearPlane) &&
+              UniformsLayout::offsetOf<12>() == offsetof(ClusterUniforms, maxLightsPerCluster),
+              "ClusterUniforms must match the WGSL layout");
+
+using LightLayout = GpuStruct<GpuLayout::Std430, GpuVec3f, GpuF32, GpuVec3f, GpuF32, GpuVec3f, GpuF32, GpuF32,
+                              GpuF32, GpuF32, GpuF32>;
+static_assert(LightLayout::matchesWgsl(TYPES_WGSL, "ClusterLight"), "ClusterLight no longer matches the shaders");
+static_assert(LightLayout::SIZE == sizeof(ClusterLight) &&
+              LightLayout::offsetOf<6>() == offsetof(ClusterLight, cosInner),
+              "ClusterLight must match the WGSL layout");
+
+constexpr char CULL_MAIN[] = R"(
+@group(0) @binding(0) var<uniform> clusterUniforms: ClusterUniforms;
+@group(0) @binding(1) var<storage, read> clusterLights: array<ClusterLight>;
+@group(0) @binding(2) var<storage, read_write> clusterLightCounts: array<u32>;
+@group(0) @binding(3) var<storage, read_write> clusterLightIndices: array<u32>;
+
+var<workgroup> sharedSpheres: array<vec4<f32>, 64>;
+
+// View-space point at distance depth along the ray through an NDC position
+fn viewPoint(ndc: vec2<f32>, depth: f32) -> vec3<f32> {
+    let p = clusterUniforms.projection;
+    return vec3<f32>(depth * (ndc.x + p.z) / p.x, depth * (ndc.y + p.w) / p.y, -depth);
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(local_invocation_index) localIndex: u32) {
+    let grid = vec3<u32>(clusterUniforms.gridX, clusterUniforms.gridY, clusterUniforms.gridZ);
+    let cluster = id.x;
+    let inGrid = cluster < grid.x * grid.y * grid.z;
+
+    // Bounds of the froxel from its screen tile and exponential depth slice
+    let cell = vec3<u32>(cluster % grid.x, (cluster / grid.x) % grid.y, cluster / (grid.x * grid.y));
+    let pixelMin = vec2<f32>(cell.xy) * clusterUniforms.tileSize;
+    let pixelMax = min(pixelMin + clusterUniforms.tileSize, clusterUniforms.screenSize);
+    let ndcMin = vec2<f32>(pixelMin.x, pixelMax.y) / clusterUniforms.screenSize * vec2<f32>(2.0, -2.0) + vec2<f32>(-1.0, 1.0);
+    let ndcMax = vec2<f32>(pixelMax.x, pixelMin.y) / clusterUniforms.screenSize * vec2<f32>(2.0, -2.0) + vec2<f32>(-1.0, 1.0);
+    let depthRatio = clusterUniforms.farPlane / clusterUniforms.nearPlane;
+    let nearDepth = clusterUniforms.nearPlane * pow(depthRatio, f32(cell.z) / f32(grid.z));
+    let farDepth = clusterUniforms.nearPlane * pow(depthRatio, f32(cell.z + 1u) / f32(grid.z));
+
+    var boundsMin = vec3<f32>(3.0e38);
+    var boundsMax = vec3<f32>(-3.0e38);
+    for (var corner = 0u; corner < 8u; corner = corner + 1u) {
+        let ndc = select(ndcMin, ndcMax, vec2<bool>((corner & 1u) != 0u, (corner & 2u) != 0u));
+        let point = viewPoint(ndc, select(nearDepth, farDepth, (corner & 4u) != 0u));
+        boundsMin = min(boundsMin, point);
+        boundsMax = max(boundsMax, point);
+    }
+
+    // Lights are streamed through workgroup memory, one batch per iteration
+    let maxLights = clusterUniforms.maxLightsPerCluster;
+    var count = 0u;
+    for (var base = 0u; base < clusterUniforms.lightCount; base = base + 64u) {
+        if (base + localIndex < clusterUniforms.lightCount) {
+            let light = clusterLights[base + localIndex];
+            sharedSpheres[localIndex] = vec4<f32>((clusterUniforms.view * vec4<f32>(light.position, 1.0)).xyz, light.range);
+        }
+        workgroupBarrier();
+
+        let batch = min(64u, clusterUniforms.lightCount - base);
+        for (var j = 0u; j < batch; j = j + 1u) {
+            let sphere = sharedSpheres[j];
+            let closest = clamp(sphere.xyz, boundsMin, boundsMax);
+            let offset = sphere.xyz - closest;
+            if (inGrid && count < maxLights && dot(offset, offset) <= sphere.w * sphere.w) {
+                clusterLightIndices[cluster * maxLights + count] = base + j;
+                count = count + 1u;
+            }
+        }
+        workgroupBarrier();
+    }
+
+    if (inGrid) {
+        clusterLightCounts[cluster] = count;
+    }
+}
+)";
+
+constexpr char SHADING_FUNCTIONS[] = R"(
+// Cluster of a fragment; loop i < clusterLightCounts[c] over
+// clusterLights[clusterLightIndices[c * clusterUniforms.maxLightsPerCluster + i]]
+fn clusterIndex(fragCoord: vec2<f32>, viewDepth: f32) -> u32 {
+    let grid = vec3<u32>(clusterUniforms.gridX, clusterUniforms.gridY, clusterUniforms.gridZ);
+    let tile = min(vec2<u32>(max(fragCoord / clusterUniforms.tileSize, vec2<f32>(0.0))), grid.xy - 1u);
+    let slice = log2(max(viewDepth, 1e-6)) * clusterUniforms.sliceScale + clusterUniforms.sliceBias;
+    let z = min(u32(max(slice, 0.0)), grid.z - 1u);
+    return tile.x + grid.x * (tile.y + grid.y * z);
+}
+
+// Cone falloff of a spot light, 1 for point lights; toLight is normalized
+fn clusterSpotFactor(light: ClusterLight, toLight: vec3<f32>) -> f32 {
+    if (light.cosOuter <= -1.0) {
+        return 1.0;
+    }
+    let cosAngle = dot(-toLight, normalize(light.direction));
+    return clamp((cosAngle - light.cosOuter) / max(light.cosInner - light.cosOuter, 1e-4), 0.0, 1.0);
+}
+)";
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           DeviceBufferUsage usage, const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, device, name)) {
+        LOG_ERROR("ClusteredLighting", "Failed to create clustering buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+std::shared_ptr<IBindGroup> createBindGroup(IResourceFactory& factory, const std::shared_ptr<IBindGroupLayout>& layout,
+                                            const std::shared_ptr<DeviceBuffer>& uniforms,
+                                            const std::shared_ptr<DeviceBuffer>& lights,
+                                            const std::shared_ptr<DeviceBuffer>& counts,
+                                            const std::shared_ptr<DeviceBuffer>& indices, const char* name) {
+    BindGroupDesc desc;
+    desc.layout = layout;
+    desc.debugName = name;
+    desc.entries.resize(4);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = uniforms;
+    desc.entries[0].size = sizeof(ClusterUniforms);
+    desc.entries[1].binding = 1;
+    desc.entries[1].buffer = lights;
+    desc.entries[2].binding = 2;
+    desc.entries[2].buffer = counts;
+    desc.entries[3].binding = 3;
+    desc.entries[3].buffer = indices;
+    return factory.createBindGroup(desc);
+}
+
+} // anonymous namespace
+
+ClusteredLighting::ClusteredLighting(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("ClusteredLighting", "Device or resource factory is null");
+        return;
+    }
+
+    if (config.gridX == 0 || config.gridY == 0 || config.gridZ == 0 || config.maxLights == 0 ||
+        config.maxLightsPerCluster == 0) {
+        LOG_ERROR("ClusteredLighting", "Grid dimensions and light limits must be non-zero");
+        return;
+    }
+
+    const uint64_t clusters = getClusterCount();
+    _uniformBuffer = createBuffer(device, sizeof(ClusterUniforms), DeviceBufferUsage::Uniform, "ClusterUniforms");
+    _lights = createBuffer(device, uint64_t(config.maxLights) * sizeof(ClusterLight), DeviceBufferUsage::Storage,
+                           "ClusterLights");
+    _lightCounts = createBuffer(device, clusters * sizeof(uint32_t), DeviceBufferUsage::Storage, "ClusterLightCounts");
+    _lightIndices = createBuffer(device, clusters * config.maxLightsPerCluster * sizeof(uint32_t),
+                                 DeviceBufferUsage::Storage, "ClusterLightIndices");
+    if (!_uniformBuffer || !_lights || !_lightCounts || !_lightIndices) {
+        return;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = std::string(TYPES_WGSL) + CULL_MAIN;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.entryPoint = "main";
+    shaderDesc.debugName = "ClusterLightCull";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("ClusteredLighting", "Failed to create light culling shader");
+        return;
+    }
+
+    BindGroupLayoutDesc cullLayoutDesc;
+    cullLayoutDesc.debugName = "ClusterLightCull";
+    cullLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ClusterUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    BindGroupLayoutDesc shadingLayoutDesc;
+    shadingLayoutDesc.debugName = "ClusteredShading";
+    shadingLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ClusterUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Fragment, .type = BindingType::ReadOnlyStorageBuffer},
+    };
+    auto cullLayout = factory->createBindGroupLayout(cullLayoutDesc);
+    _shadingLayout = factory->createBindGroupLayout(shadingLayoutDesc);
+    if (!cullLayout || !_shadingLayout) {
+        LOG_ERROR("ClusteredLighting", "Failed to create bind group layouts");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {cullLayout};
+    pipelineLayoutDesc.debugName = "ClusterLightCull";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("ClusteredLighting", "Failed to create pipeline layout");
+        return;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "ClusterLightCull";
+    _cullPipeline = factory->createComputePipeline(pipelineDesc);
+    if (!_cullPipeline) {
+        LOG_ERROR("ClusteredLighting", "Failed to create light culling pipeline");
+        return;
+    }
+
+    _cullBindGroup = createBindGroup(*factory, cullLayout, _uniformBuffer, _lights, _lightCounts, _lightIndices,
+                                     "ClusterLightCull");
+    if (_cullBindGroup) {
+        _shadingBindGroup = createBindGroup(*factory, _shadingLayout, _uniformBuffer, _lights, _lightCounts,
+                                            _lightIndices, "ClusteredShading");
+    }
+    if (!_shadingBindGroup) {
+        LOG_ERROR("ClusteredLighting", "Failed to create bind groups");
+    }
+}
+
+ClusteredLighting::~ClusteredLighting() = default;
+
+bool ClusteredLighting::setLights(std::span<const ClusterLight> lights) {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("ClusteredLighting", "Cannot set lights on invalid clustered lighting");
+        return false;
+    }
+
+    if (lights.size() > _config.maxLights) {
+        LOG_WARNING("ClusteredLighting", "More lights than Config::maxLights, extra lights ignored");
+        lights = lights.first(_config.maxLights);
+    }
+
+    _lightCount = static_cast<uint32_t>(lights.size());
+    if (lights.empty()) {
+        return true;
+    }
+    return queue->writeBuffer(_lights, 0, std::as_bytes(lights));
+}
+
+void ClusteredLighting::setView(const Mat4& view, const Mat4& projection, float nearPlane, float farPlane,
+                                uint32_t width, uint32_t height) {
+    _view = view;
+    _projection = {projection[0], projection[5], projection[8], projection[9]};
+    _near = std::max(nearPlane, 1e-4f);
+    _far = std::max(farPlane, _near * 1.001f);
+    _width = std::max(width, 1u);
+    _height = std::max(height, 1u);
+}
+
+bool ClusteredLighting::cull(IComputePassEncoder& pass) {
+    PERS_PROFILE_SCOPE("ClusteredLighting::cull");
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("ClusteredLighting", "Cannot cull with invalid clustered lighting");
+        return false;
+    }
+
+    ClusterUniforms uniforms = {};
+    std::copy(_view.begin(), _view.end(), uniforms.view);
+    std::copy(_projection.begin(), _projection.end(), uniforms.projection);
+    uniforms.screenSize[0] = static_cast<float>(_width);
+    uniforms.screenSize[1] = static_cast<float>(_height);
+    uniforms.tileSize[0] = std::ceil(uniforms.screenSize[0] / static_cast<float>(_config.gridX));
+    uniforms.tileSize[1] = std::ceil(uniforms.screenSize[1] / static_cast<float>(_config.gridY));
+    uniforms.nearPlane = _near;
+    uniforms.farPlane = _far;
+
+    // slice = log2(depth) * scale + bias inverts depth = near * (far / near)^(slice / gridZ)
+    const float logRatio = std::log2(_far / _near);
+    uniforms.sliceScale = static_cast<float>(_config.gridZ) / logRatio;
+    uniforms.sliceBias = -static_cast<float>(_config.gridZ) * std::log2(_near) / logRatio;
+    uniforms.gridX = _config.gridX;
+    uniforms.gridY = _config.gridY;
+    uniforms.gridZ = _config.gridZ;
+    uniforms.lightCount = _lightCount;
+    uniforms.maxLightsPerCluster = _config.maxLightsPerCluster;
+    if (!queue->writeBuffer(_uniformBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&uniforms), sizeof(uniforms)))) {
+        LOG_ERROR("ClusteredLighting", "Failed to write cluster uniforms");
+        return false;
+    }
+
+    pass.setPipeline(_cullPipeline);
+    pass.setBindGroup(0, _cullBindGroup);
+    pass.dispatch((getClusterCount() + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+    return true;
+}
+
+ClusteredLighting::GraphOutputs ClusteredLighting::addToGraph(RenderGraph& graph) {
+    GraphOutputs outputs;
+    if (!isValid()) {
+        LOG_ERROR("ClusteredLighting", "Cannot add invalid clustered lighting to a graph");
+        return outputs;
+    }
+
+    const RenderGraphBuffer lights = graph.importBuffer(_lights);
+    outputs.lightCounts = graph.importBuffer(_lightCounts);
+    outputs.lightIndices = graph.importBuffer(_lightIndices);
+    graph.addPass("ClusterLightCull",
+                  [&](RenderGraphBuilder& builder) {
+                      builder.read(lights);
+                      builder.write(outputs.lightCounts);
+                      builder.write(outputs.lightIndices);
+                  },
+                  [this](RenderGraphContext& context) {
+                      ComputePassDesc passDesc;
+                      passDesc.label = "ClusterLightCull";
+                      auto pass = context.getCommandEncoder().beginComputePass(passDesc);
+                      if (!pass) {
+                          LOG_ERROR("ClusteredLighting", "Failed to begin light culling pass");
+                          return;
+                      }
+                      cull(*pass);
+                      pass->end();
+                  });
+    return outputs;
+}
+
+std::string ClusteredLighting::getShaderDeclarations(uint32_t group) const {
+    const std::string prefix = "@group(" + std::to_string(group) + ") ";
+    return std::string(TYPES_WGSL) +
+           prefix + "@binding(0) var<uniform> clusterUniforms: ClusterUniforms;\n" +
+           prefix + "@binding(1) var<storage, read> clusterLights: array<ClusterLight>;\n" +
+           prefix + "@binding(2) var<storage, read> clusterLightCounts: array<u32>;\n" +
+           prefix + "@binding(3) var<storage, read> clusterLightIndices: array<u32>;\n" +
+           SHADING_FUNCTIONS;
+}
+
+} // namespace pers
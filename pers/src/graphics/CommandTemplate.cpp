@@ -0,0 +1,226 @@
+#include "pers/graphics/CommandTemplate.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IPreparedRenderPass.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+
+namespace pers {
+
+CommandTemplate::CommandTemplate(std::shared_ptr<IPreparedRenderPass> pass)
+    : _pass(std::move(pass)) {
+}
+
+CommandTemplate::~CommandTemplate() = default;
+
+CommandTemplate::Command& CommandTemplate::push(Op op) {
+    auto& command = _commands.emplace_back();
+    command.op = op;
+    return command;
+}
+
+void CommandTemplate::setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+    push(Op::SetPipeline).resource = static_cast<uint32_t>(_pipelines.size());
+    _pipelines.push_back(pipeline);
+}
+
+CommandTemplate::Parameter CommandTemplate::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                                         std::span<const uint32_t> dynamicOffsets) {
+    Parameter parameter = INVALID_PARAMETER;
+    if (!dynamicOffsets.empty()) {
+        parameter = static_cast<Parameter>(_parameters.size());
+        _parameters.push_back({static_cast<uint32_t>(_dynamicOffsets.size()),
+                               static_cast<uint32_t>(dynamicOffsets.size())});
+        _dynamicOffsets.insert(_dynamicOffsets.end(), dynamicOffsets.begin(), dynamicOffsets.end());
+    }
+
+    auto& command = push(Op::SetBindGroup);
+    command.resource = static_cast<uint32_t>(_bindGroups.size());
+    command.values[0] = index;
+    command.values[1] = parameter;
+    _bindGroups.push_back(bindGroup);
+    return parameter;
+}
+
+void CommandTemplate::setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                                      uint64_t offset, uint64_t size) {
+    auto& command = push(Op::SetVertexBuffer);
+    command.resource = static_cast<uint32_t>(_buffers.size());
+    command.values[0] = slot;
+    command.offset = offset;
+    command.size = size;
+    _buffers.push_back(buffer);
+}
+
+void CommandTemplate::setIndexBuffer(const std::shared_ptr<IBuffer>& buffer, IndexFormat indexFormat,
+                                     uint64_t offset, uint64_t size) {
+    auto& command = push(Op::SetIndexBuffer);
+    command.resource = static_cast<uint32_t>(_buffers.size());
+    command.values[0] = static_cast<uint32_t>(indexFormat);
+    command.offset = offset;
+    command.size = size;
+    _buffers.push_back(buffer);
+}
+
+void CommandTemplate::setViewport(float x, float y, float width, float height, float minDepth, float maxDepth) {
+    push(Op::SetViewport).values = {
+        std::bit_cast<uint32_t>(x), std::bit_cast<uint32_t>(y),
+        std::bit_cast<uint32_t>(width), std::bit_cast<uint32_t>(height),
+        std::bit_cast<uint32_t>(minDepth), std::bit_cast<uint32_t>(maxDepth)
+    };
+}
+
+void CommandTemplate::setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    push(Op::SetScissorRect).values = {x, y, width, height, 0, 0};
+}
+
+void CommandTemplate::setStencilReference(uint32_t reference) {
+    push(Op::SetStencilReference).values[0] = reference;
+}
+
+void CommandTemplate::setBlendConstant(const Color& color) {
+    push(Op::SetBlendConstant).values = {
+        std::bit_cast<uint32_t>(color.r), std::bit_cast<uint32_t>(color.g),
+        std::bit_cast<uint32_t>(color.b), std::bit_cast<uint32_t>(color.a), 0, 0
+    };
+}
+
+void CommandTemplate::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
+    push(Op::Draw).values = {vertexCount, instanceCount, firstVertex, firstInstance, 0, 0};
+}
+
+void CommandTemplate::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex,
+                                  int32_t baseVertex, uint32_t firstInstance) {
+    push(Op::DrawIndexed).values = {
+        indexCount, instanceCount, firstIndex, std::bit_cast<uint32_t>(baseVertex), firstInstance, 0
+    };
+}
+
+void CommandTemplate::drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    auto& command = push(Op::DrawIndirect);
+    command.resource = static_cast<uint32_t>(_buffers.size());
+    command.offset = indirectOffset;
+    _buffers.push_back(indirectBuffer);
+}
+
+void CommandTemplate::drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    auto& command = push(Op::DrawIndexedIndirect);
+    command.resource = static_cast<uint32_t>(_buffers.size());
+    command.offset = indirectOffset;
+    _buffers.push_back(indirectBuffer);
+}
+
+void CommandTemplate::executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) {
+    if (bundles.empty()) {
+        return;
+    }
+    auto& command = push(Op::ExecuteBundles);
+    command.resource = static_cast<uint32_t>(_bundles.size());
+    command.values[0] = static_cast<uint32_t>(bundles.size());
+    _bundles.insert(_bundles.end(), bundles.begin(), bundles.end());
+}
+
+bool CommandTemplate::setDynamicOffsets(Parameter parameter, std::span<const uint32_t> dynamicOffsets) {
+    if (parameter >= _parameters.size() || _parameters[parameter].count != dynamicOffsets.size()) {
+        LOG_ERROR("CommandTemplate", "Unknown parameter or dynamic offset count mismatch");
+        return false;
+    }
+    std::copy(dynamicOffsets.begin(), dynamicOffsets.end(), _dynamicOffsets.begin() + _parameters[parameter].first);
+    return true;
+}
+
+bool CommandTemplate::setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) {
+    if (!_pass) {
+        LOG_ERROR("CommandTemplate", "Template has no prepared pass to retarget");
+        return false;
+    }
+    return _pass->setColorView(index, view);
+}
+
+bool CommandTemplate::encode(ICommandEncoder& encoder) const {
+    PERS_PROFILE_SCOPE("CommandTemplate::encode");
+    if (!_pass) {
+        LOG_ERROR("CommandTemplate", "Template has no prepared pass to begin");
+        return false;
+    }
+
+    auto pass = encoder.beginRenderPass(*_pass);
+    if (!pass) {
+        return false;
+    }
+    encodeInto(*pass);
+    pass->end();
+    return true;
+}
+
+void CommandTemplate::encodeInto(IRenderPassEncoder& pass) const {
+    for (const auto& command : _commands) {
+        const auto& v = command.values;
+        switch (command.op) {
+            case Op::SetPipeline:
+                pass.setPipeline(_pipelines[command.resource]);
+                break;
+            case Op::SetBindGroup: {
+                std::span<const uint32_t> offsets;
+                if (v[1] != INVALID_PARAMETER) {
+                    const auto& range = _parameters[v[1]];
+                    offsets = std::span<const uint32_t>(_dynamicOffsets).subspan(range.first, range.count);
+                }
+                pass.setBindGroup(v[0], _bindGroups[command.resource], offsets);
+                break;
+            }
+            case Op::SetVertexBuffer:
+                pass.setVertexBuffer(v[0], _buffers[command.resource], command.offset, command.size);
+                break;
+            case Op::SetIndexBuffer:
+                pass.setIndexBuffer(_buffers[command.resource], static_cast<IndexFormat>(v[0]),
+                                    command.offset, command.size);
+                break;
+            case Op::SetViewport:
+                pass.setViewport(std::bit_cast<float>(v[0]), std::bit_cast<float>(v[1]),
+                                 std::bit_cast<float>(v[2]), std::bit_cast<float>(v[3]),
+                                 std::bit_cast<float>(v[4]), std::bit_cast<float>(v[5]));
+                break;
+            case Op::SetScissorRect:
+                pass.setScissorRect(v[0], v[1], v[2], v[3]);
+                break;
+            case Op::SetStencilReference:
+                pass.setStencilReference(v[0]);
+                break;
+            case Op::SetBlendConstant:
+                pass.setBlendConstant(Color{std::bit_cast<float>(v[0]), std::bit_cast<float>(v[1]),
+                                            std::bit_cast<float>(v[2]), std::bit_cast<float>(v[3])});
+                break;
+            case Op::Draw:
+                pass.draw(v[0], v[1], v[2], v[3]);
+                break;
+            case Op::DrawIndexed:
+                pass.drawIndexed(v[0], v[1], v[2], std::bit_cast<int32_t>(v[3]), v[4]);
+                break;
+            case Op::DrawIndirect:
+                pass.drawIndirect(_buffers[command.resource], command.offset);
+                break;
+            case Op::DrawIndexedIndirect:
+                pass.drawIndexedIndirect(_buffers[command.resource], command.offset);
+                break;
+            case Op::ExecuteBundles:
+                pass.executeBundles(std::span<const std::shared_ptr<IRenderBundle>>(_bundles)
+                                        .subspan(command.resource, v[0]));
+                break;
+        }
+    }
+}
+
+void CommandTemplate::clear() {
+    _commands.clear();
+    _pipelines.clear();
+    _bindGroups.clear();
+    _buffers.clear();
+    _bundles.clear();
+    _dynamicOffsets.clear();
+    _parameters.clear();
+}
+
+} // namespace pers
@@ -0,0 +1,523 @@
+#include "pers/graphics/DebugDraw.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+struct DebugUniforms {
+    float viewProjection[16];
+    float viewport[4];  // width, height, 1/width, 1/height
+};
+
+constexpr float GLYPH_ADVANCE = 6.0f;
+constexpr float LINE_ADVANCE = 9.0f;
+
+const char* LINE_VERTEX_SHADER = R"(
+struct Uniforms {
+    viewProjection: mat4x4<f32>,
+    viewport: vec4<f32>,
+};
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+
+struct Output {
+    @builtin(position) position: vec4<f32>,
+    @location(0) color: vec4<f32>,
+};
+
+@vertex
+fn main(@builtin(vertex_index) index: u32,
+        @location(0) start: vec3<f32>,
+        @location(1) color: vec4<f32>,
+        @location(2) end: vec3<f32>) -> Output {
+    var output: Output;
+    output.position = uniforms.viewProjection * vec4<f32>(select(start, end, index == 1u), 1.0);
+    output.color = color;
+    return output;
+}
+)";
+
+const char* LINE_FRAGMENT_SHADER = R"(
+@fragment
+fn main(@location(0) color: vec4<f32>) -> @location(0) vec4<f32> {
+    return color;
+}
+)";
+
+const char* GLYPH_VERTEX_SHADER = R"(
+struct Uniforms {
+    viewProjection: mat4x4<f32>,
+    viewport: vec4<f32>,
+};
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+
+struct Output {
+    @builtin(position) position: vec4<f32>,
+    @location(0) cell: vec2<f32>,
+    @location(1) @interpolate(flat) glyph: u32,
+    @location(2) color: vec4<f32>,
+};
+
+@vertex
+fn main(@builtin(vertex_index) index: u32,
+        @location(0) origin: vec2<f32>,
+        @location(1) glyph: u32,
+        @location(2) color: vec4<f32>,
+        @location(3) scale: f32) -> Output {
+    // Two triangles: corners (0,0) (1,0) (0,1), (0,1) (1,0) (1,1)
+    let corner = vec2<f32>(f32((0x32u >> index) & 1u), f32((0x2Cu >> index) & 1u));
+    let cell = corner * vec2<f32>(5.0, 7.0);
+    let pixel = origin + cell * scale;
+
+    var output: Output;
+    output.position = vec4<f32>(pixel.x * uniforms.viewport.z * 2.0 - 1.0,
+                                1.0 - pixel.y * uniforms.viewport.w * 2.0, 0.0, 1.0);
+    output.cell = cell;
+    output.glyph = glyph;
+    output.color = color;
+    return output;
+}
+)";
+
+// 5x7 font for ASCII 32-126, one byte per column with bit 0 at the top;
+// columns 0-3 are packed into x, column 4 into y
+const char* GLYPH_FRAGMENT_SHADER = R"(
+var<private> FONT: array<vec2<u32>, 95> = array<vec2<u32>, 95>(
+    vec2<u32>(0x00000000u, 0x00u), vec2<u32>(0x005F0000u, 0x00u), vec2<u32>(0x07000700u, 0x00u),
+    vec2<u32>(0x7F147F14u, 0x14u), vec2<u32>(0x2A7F2A24u, 0x12u), vec2<u32>(0x64081323u, 0x62u),
+    vec2<u32>(0x22554936u, 0x50u), vec2<u32>(0x00030500u, 0x00u), vec2<u32>(0x41221C00u, 0x00u),
+    vec2<u32>(0x1C224100u, 0x00u), vec2<u32>(0x2A1C2A08u, 0x08u), vec2<u32>(0x083E0808u, 0x08u),
+    vec2<u32>(0x00305000u, 0x00u), vec2<u32>(0x08080808u, 0x08u), vec2<u32>(0x00606000u, 0x00u),
+    vec2<u32>(0x04081020u, 0x02u), vec2<u32>(0x4549513Eu, 0x3Eu), vec2<u32>(0x407F4200u, 0x00u),
+    vec2<u32>(0x49516142u, 0x46u), vec2<u32>(0x4B454121u, 0x31u), vec2<u32>(0x7F121418u, 0x10u),
+    vec2<u32>(0x45454527u, 0x39u), vec2<u32>(0x49494A3Cu, 0x30u), vec2<u32>(0x05097101u, 0x03u),
+    vec2<u32>(0x49494936u, 0x36u), vec2<u32>(0x29494906u, 0x1Eu), vec2<u32>(0x00363600u, 0x00u),
+    vec2<u32>(0x00365600u, 0x00u), vec2<u32>(0x41221408u, 0x00u), vec2<u32>(0x14141414u, 0x14u),
+    vec2<u32>(0x14224100u, 0x08u), vec2<u32>(0x09510102u, 0x06u), vec2<u32>(0x41794932u, 0x3Eu),
+    vec2<u32>(0x1111117Eu, 0x7Eu), vec2<u32>(0x4949497Fu, 0x36u), vec2<u32>(0x4141413Eu, 0x22u),
+    vec2<u32>(0x2241417Fu, 0x1Cu), vec2<u32>(0x4949497Fu, 0x41u), vec2<u32>(0x0109097Fu, 0x01u),
+    vec2<u32>(0x5141413Eu, 0x32u), vec2<u32>(0x0808087Fu, 0x7Fu), vec2<u32>(0x417F4100u, 0x00u),
+    vec2<u32>(0x3F414020u, 0x01u), vec2<u32>(0x2214087Fu, 0x41u), vec2<u32>(0x4040407Fu, 0x40u),
+    vec2<u32>(0x0204027Fu, 0x7Fu), vec2<u32>(0x1008047Fu, 0x7Fu), vec2<u32>(0x4141413Eu, 0x3Eu),
+    vec2<u32>(0x0909097Fu, 0x06u), vec2<u32>(0x2151413Eu, 0x5Eu), vec2<u32>(0x2919097Fu, 0x46u),
+    vec2<u32>(0x49494946u, 0x31u), vec2<u32>(0x017F0101u, 0x01u), vec2<u32>(0x4040403Fu, 0x3Fu),
+    vec2<u32>(0x2040201Fu, 0x1Fu), vec2<u32>(0x2018207Fu, 0x7Fu), vec2<u32>(0x14081463u, 0x63u),
+    vec2<u32>(0x04780403u, 0x03u), vec2<u32>(0x45495161u, 0x43u), vec2<u32>(0x417F0000u, 0x41u),
+    vec2<u32>(0x10080402u, 0x20u), vec2<u32>(0x007F4141u, 0x00u), vec2<u32>(0x02010204u, 0x04u),
+    vec2<u32>(0x40404040u, 0x40u), vec2<u32>(0x04020100u, 0x00u), vec2<u32>(0x54545420u, 0x78u),
+    vec2<u32>(0x4444487Fu, 0x38u), vec2<u32>(0x44444438u, 0x20u), vec2<u32>(0x48444438u, 0x7Fu),
+    vec2<u32>(0x54545438u, 0x18u), vec2<u32>(0x01097E08u, 0x02u), vec2<u32>(0x54541408u, 0x3Cu),
+    vec2<u32>(0x0404087Fu, 0x78u), vec2<u32>(0x407D4400u, 0x00u), vec2<u32>(0x3D444020u, 0x00u),
+    vec2<u32>(0x28107F00u, 0x44u), vec2<u32>(0x407F4100u, 0x00u), vec2<u32>(0x0418047Cu, 0x78u),
+    vec2<u32>(0x0404087Cu, 0x78u), vec2<u32>(0x44444438u, 0x38u), vec2<u32>(0x1414147Cu, 0x08u),
+    vec2<u32>(0x18141408u, 0x7Cu), vec2<u32>(0x0404087Cu, 0x08u), vec2<u32>(0x54545448u, 0x20u),
+    vec2<u32>(0x40443F04u, 0x20u), vec2<u32>(0x2040403Cu, 0x7Cu), vec2<u32>(0x2040201Cu, 0x1Cu),
+    vec2<u32>(0x4030403Cu, 0x3Cu), vec2<u32>(0x28102844u, 0x44u), vec2<u32>(0x5050500Cu, 0x3Cu),
+    vec2<u32>(0x4C546444u, 0x44u), vec2<u32>(0x41360800u, 0x00u), vec2<u32>(0x007F0000u, 0x00u),
+    vec2<u32>(0x08364100u, 0x00u), vec2<u32>(0x04020102u, 0x02u)
+);
+
+struct Input {
+    @builtin(position) position: vec4<f32>,
+    @location(0) cell: vec2<f32>,
+    @location(1) @interpolate(flat) glyph: u32,
+    @location(2) color: vec4<f32>,
+};
+
+@fragment
+fn main(input: Input) -> @location(0) vec4<f32> {
+    let column = min(u32(input.cell.x), 4u);
+    let row = min(u32(input.cell.y), 6u);
+    let packed = FONT[min(input.glyph, 94u)];
+    var bits = packed.y;
+    if (column < 4u) {
+        bits = packed.x >> (column * 8u);
+    }
+    if (((bits >> row) & 1u) == 0u) {
+        discard;
+    }
+    return input.color;
+}
+)";
+
+DebugDraw::Vec3 transformPoint(const DebugDraw::Mat4& m, const DebugDraw::Vec3& p) {
+    const float x = m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12];
+    const float y = m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13];
+    const float z = m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14];
+    const float w = m[3] * p[0] + m[7] * p[1] + m[11] * p[2] + m[15];
+    const float invW = w != 0.0f ? 1.0f / w : 1.0f;
+    return {x * invW, y * invW, z * invW};
+}
+
+bool invert(const DebugDraw::Mat4& m, DebugDraw::Mat4& out) {
+    // Cofactor expansion through 2x2 sub-determinants of the top and bottom row pairs
+    const float s0 = m[0] * m[5] - m[4] * m[1];
+    const float s1 = m[0] * m[9] - m[8] * m[1];
+    const float s2 = m[0] * m[13] - m[12] * m[1];
+    const float s3 = m[4] * m[9] - m[8] * m[5];
+    const float s4 = m[4] * m[13] - m[12] * m[5];
+    const float s5 = m[8] * m[13] - m[12] * m[9];
+    const float c5 = m[10] * m[15] - m[14] * m[11];
+    const float c4 = m[6] * m[15] - m[14] * m[7];
+    const float c3 = m[6] * m[11] - m[10] * m[7];
+    const float c2 = m[2] * m[15] - m[14] * m[3];
+    const float c1 = m[2] * m[11] - m[10] * m[3];
+    const float c0 = m[2] * m[7] - m[6] * m[3];
+
+    const float determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (std::fabs(determinant) < 1e-12f) {
+        return false;
+    }
+    const float inv = 1.0f / determinant;
+
+    out[0] = (m[5] * c5 - m[9] * c4 + m[13] * c3) * inv;
+    out[1] = (-m[1] * c5 + m[9] * c2 - m[13] * c1) * inv;
+    out[2] = (m[1] * c4 - m[5] * c2 + m[13] * c0) * inv;
+    out[3] = (-m[1] * c3 + m[5] * c1 - m[9] * c0) * inv;
+    out[4] = (-m[4] * c5 + m[8] * c4 - m[12] * c3) * inv;
+    out[5] = (m[0] * c5 - m[8] * c2 + m[12] * c1) * inv;
+    out[6] = (-m[0] * c4 + m[4] * c2 - m[12] * c0) * inv;
+    out[7] = (m[0] * c3 - m[4] * c1 + m[8] * c0) * inv;
+    out[8] = (m[7] * s5 - m[11] * s4 + m[15] * s3) * inv;
+    out[9] = (-m[3] * s5 + m[11] * s2 - m[15] * s1) * inv;
+    out[10] = (m[3] * s4 - m[7] * s2 + m[15] * s0) * inv;
+    out[11] = (-m[3] * s3 + m[7] * s1 - m[11] * s0) * inv;
+    out[12] = (-m[6] * s5 + m[10] * s4 - m[14] * s3) * inv;
+    out[13] = (m[2] * s5 - m[10] * s2 + m[14] * s1) * inv;
+    out[14] = (-m[2] * s4 + m[6] * s2 - m[14] * s0) * inv;
+    out[15] = (m[2] * s3 - m[6] * s1 + m[10] * s0) * inv;
+    return true;
+}
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const char* code, ShaderStage stage,
+                                            const char* debugName) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = debugName;
+    auto shader = factory.createShaderModule(desc);
+    return shader && shader->isValid() ? shader : nullptr;
+}
+
+} // anonymous namespace
+
+DebugDraw::DebugDraw(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("DebugDraw", "Device or resource factory is null");
+        return;
+    }
+
+    _buffer = std::make_unique<DynamicBuffer>();
+    if (!_buffer->create(config.bufferSize, BufferUsage::Vertex | BufferUsage::Uniform, device,
+                         config.frameCount, "DebugDraw")) {
+        LOG_ERROR("DebugDraw", "Failed to create instance buffer");
+        return;
+    }
+
+    _lineVertexShader = createShader(*factory, LINE_VERTEX_SHADER, ShaderStage::Vertex, "DebugDraw::LineVertex");
+    _lineFragmentShader = createShader(*factory, LINE_FRAGMENT_SHADER, ShaderStage::Fragment, "DebugDraw::LineFragment");
+    _glyphVertexShader = createShader(*factory, GLYPH_VERTEX_SHADER, ShaderStage::Vertex, "DebugDraw::GlyphVertex");
+    _glyphFragmentShader = createShader(*factory, GLYPH_FRAGMENT_SHADER, ShaderStage::Fragment, "DebugDraw::GlyphFragment");
+    if (!_lineVertexShader || !_lineFragmentShader || !_glyphVertexShader || !_glyphFragmentShader) {
+        LOG_ERROR("DebugDraw", "Failed to create debug draw shaders");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "DebugDraw";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex, .type = BindingType::UniformBuffer,
+         .hasDynamicOffset = true, .minBindingSize = sizeof(DebugUniforms)},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("DebugDraw", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "DebugDraw";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!_pipelineLayout) {
+        LOG_ERROR("DebugDraw", "Failed to create pipeline layout");
+    }
+}
+
+DebugDraw::~DebugDraw() = default;
+
+void DebugDraw::line(const Vec3& from, const Vec3& to, uint32_t color, bool depthTest) {
+    _lines[depthTest ? 0 : 1].push_back({from, color, to});
+}
+
+void DebugDraw::aabb(const Vec3& min, const Vec3& max, uint32_t color, bool depthTest) {
+    std::array<Vec3, 8> corners;
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i] = {(i & 1) ? max[0] : min[0], (i & 2) ? max[1] : min[1], (i & 4) ? max[2] : min[2]};
+    }
+    boxEdges(corners, color, depthTest);
+}
+
+void DebugDraw::box(const Mat4& transform, uint32_t color, bool depthTest) {
+    std::array<Vec3, 8> corners;
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i] = transformPoint(transform, {(i & 1) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, (i & 4) ? 0.5f : -0.5f});
+    }
+    boxEdges(corners, color, depthTest);
+}
+
+void DebugDraw::sphere(const Vec3& center, float radius, uint32_t color, bool depthTest, uint32_t segments) {
+    segments = std::max(segments, 3u);
+    const float step = 6.28318530718f / static_cast<float>(segments);
+    for (uint32_t axis = 0; axis < 3; ++axis) {
+        // Circle in the plane spanned by the two other axes
+        const uint32_t u = (axis + 1) % 3;
+        const uint32_t v = (axis + 2) % 3;
+        Vec3 previous = center;
+        previous[u] += radius;
+        for (uint32_t i = 1; i <= segments; ++i) {
+            const float angle = step * static_cast<float>(i);
+            Vec3 point = center;
+            point[u] += radius * std::cos(angle);
+            point[v] += radius * std::sin(angle);
+            line(previous, point, color, depthTest);
+            previous = point;
+        }
+    }
+}
+
+void DebugDraw::axes(const Mat4& transform, float length, bool depthTest) {
+    const Vec3 origin = transformPoint(transform, {0.0f, 0.0f, 0.0f});
+    line(origin, transformPoint(transform, {length, 0.0f, 0.0f}), rgba(255, 0, 0), depthTest);
+    line(origin, transformPoint(transform, {0.0f, length, 0.0f}), rgba(0, 255, 0), depthTest);
+    line(origin, transformPoint(transform, {0.0f, 0.0f, length}), rgba(0, 0, 255), depthTest);
+}
+
+void DebugDraw::frustum(const Mat4& viewProjection, uint32_t color, bool depthTest) {
+    Mat4 inverse;
+    if (!invert(viewProjection, inverse)) {
+        LOG_WARNING("DebugDraw", "View-projection is singular, frustum not drawn");
+        return;
+    }
+
+    std::array<Vec3, 8> corners;
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i] = transformPoint(inverse, {(i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : 0.0f});
+    }
+    boxEdges(corners, color, depthTest);
+}
+
+void DebugDraw::text(float x, float y, std::string_view string, uint32_t color, float scale) {
+    float cursor = x;
+    for (char c : string) {
+        if (c == '\n') {
+            cursor = x;
+            y += LINE_ADVANCE * scale;
+            continue;
+        }
+        if (c != ' ') {
+            const bool printable = c > ' ' && c <= '~';
+            _glyphs.push_back({cursor, y, static_cast<uint32_t>((printable ? c : '?') - ' '), color, scale});
+        }
+        cursor += GLYPH_ADVANCE * scale;
+    }
+}
+
+uint32_t DebugDraw::render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                           uint32_t viewportWidth, uint32_t viewportHeight) {
+    PERS_PROFILE_SCOPE("DebugDraw::render");
+    if (!isValid() || (getLineCount() == 0 && _glyphs.empty())) {
+        return 0;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    const Pipelines* pipelines = factory ? getPipelines(target) : nullptr;
+    if (!pipelines || viewportWidth == 0 || viewportHeight == 0) {
+        return 0;
+    }
+
+    DebugUniforms uniforms;
+    std::memcpy(uniforms.viewProjection, viewProjection.data(), sizeof(uniforms.viewProjection));
+    uniforms.viewport[0] = static_cast<float>(viewportWidth);
+    uniforms.viewport[1] = static_cast<float>(viewportHeight);
+    uniforms.viewport[2] = 1.0f / uniforms.viewport[0];
+    uniforms.viewport[3] = 1.0f / uniforms.viewport[1];
+    const uint64_t uniformOffset = _buffer->write(uniforms);
+    if (uniformOffset == BufferCopyDesc::WHOLE_SIZE) {
+        _droppedCount += getLineCount() + _glyphs.size();
+        LOG_WARNING("DebugDraw", "Frame buffer is full, debug primitives dropped");
+        return 0;
+    }
+
+    // One bind group per ring slot, shared through the factory's cache
+    const auto frameBuffer = _buffer->getCurrentFrameBuffer();
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _bindGroupLayout;
+    bindGroupDesc.debugName = "DebugDraw";
+    bindGroupDesc.entries.resize(1);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = frameBuffer;
+    bindGroupDesc.entries[0].size = sizeof(DebugUniforms);
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("DebugDraw", "Failed to create bind group");
+        return 0;
+    }
+
+    const uint32_t dynamicOffset = static_cast<uint32_t>(uniformOffset);
+    pass.setBindGroup(0, bindGroup, {&dynamicOffset, 1});
+
+    uint32_t draws = 0;
+    auto drawInstances = [&](const std::shared_ptr<IRenderPipeline>& pipeline, const void* data,
+                             size_t count, uint64_t stride, uint32_t vertexCount) {
+        if (count == 0) {
+            return;
+        }
+
+        // Draw what fits; the slice offset is aligned up by at most 3 bytes
+        const uint64_t remaining = _buffer->getRemainingBytes();
+        const size_t fit = static_cast<size_t>(std::min<uint64_t>(count, remaining > 3 ? (remaining - 3) / stride : 0));
+        _droppedCount += count - fit;
+        if (fit == 0) {
+            return;
+        }
+
+        auto slice = _buffer->allocate(fit * stride, BufferAlignment::VERTEX_BUFFER_OFFSET);
+        if (!slice.data) {
+            _droppedCount += fit;
+            return;
+        }
+        std::memcpy(slice.data, data, fit * stride);
+
+        pass.setPipeline(pipeline);
+        pass.setVertexBuffer(0, frameBuffer, slice.offset, slice.size);
+        pass.draw(vertexCount, static_cast<uint32_t>(fit));
+        ++draws;
+    };
+
+    drawInstances(pipelines->depthLines, _lines[0].data(), _lines[0].size(), sizeof(LineInstance), 2);
+    drawInstances(pipelines->overlayLines, _lines[1].data(), _lines[1].size(), sizeof(LineInstance), 2);
+    drawInstances(pipelines->glyphs, _glyphs.data(), _glyphs.size(), sizeof(GlyphInstance), 6);
+    return draws;
+}
+
+bool DebugDraw::flush() {
+    return _buffer && _buffer->flush();
+}
+
+void DebugDraw::nextFrame() {
+    if (_buffer) {
+        _buffer->nextFrame();
+    }
+    clear();
+}
+
+void DebugDraw::clear() {
+    _lines[0].clear();
+    _lines[1].clear();
+    _glyphs.clear();
+}
+
+const DebugDraw::Pipelines* DebugDraw::getPipelines(const Target& target) {
+    for (const Pipelines& pipelines : _pipelines) {
+        if (pipelines.target == target) {
+            return &pipelines;
+        }
+    }
+
+    Pipelines pipelines;
+    pipelines.target = target;
+    pipelines.depthLines = createPipeline(target, false, true);
+    pipelines.overlayLines = createPipeline(target, false, false);
+    pipelines.glyphs = createPipeline(target, true, false);
+    if (!pipelines.depthLines || !pipelines.overlayLines || !pipelines.glyphs) {
+        LOG_ERROR("DebugDraw", "Failed to create debug draw pipelines");
+        return nullptr;
+    }
+
+    _pipelines.push_back(std::move(pipelines));
+    return &_pipelines.back();
+}
+
+std::shared_ptr<IRenderPipeline> DebugDraw::createPipeline(const Target& target, bool glyphs, bool depthTest) const {
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.layout = _pipelineLayout;
+    if (glyphs) {
+        desc.vertex = _glyphVertexShader;
+        desc.fragment = _glyphFragmentShader;
+        desc.vertexLayouts = {{
+            .arrayStride = sizeof(GlyphInstance),
+            .stepMode = VertexStepMode::Instance,
+            .attributes = {
+                {VertexFormat::Float32x2, offsetof(GlyphInstance, x), 0},
+                {VertexFormat::Uint32, offsetof(GlyphInstance, glyph), 1},
+                {VertexFormat::Unorm8x4, offsetof(GlyphInstance, color), 2},
+                {VertexFormat::Float32, offsetof(GlyphInstance, scale), 3},
+            },
+        }};
+        desc.primitive.topology = PrimitiveTopology::TriangleList;
+        desc.debugName = "DebugDraw::Glyphs";
+    } else {
+        desc.vertex = _lineVertexShader;
+        desc.fragment = _lineFragmentShader;
+        desc.vertexLayouts = {{
+            .arrayStride = sizeof(LineInstance),
+            .stepMode = VertexStepMode::Instance,
+            .attributes = {
+                {VertexFormat::Float32x3, offsetof(LineInstance, from), 0},
+                {VertexFormat::Unorm8x4, offsetof(LineInstance, color), 1},
+                {VertexFormat::Float32x3, offsetof(LineInstance, to), 2},
+            },
+        }};
+        desc.primitive.topology = PrimitiveTopology::LineList;
+        desc.debugName = depthTest ? "DebugDraw::Lines" : "DebugDraw::OverlayLines";
+    }
+
+    // Debug geometry reads the scene's depth but never writes it
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = false;
+    desc.depthStencil.depthCompare = depthTest ? CompareFunction::LessEqual : CompareFunction::Always;
+    desc.multisample.count = target.sampleCount;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    return pipeline && pipeline->isValid() ? pipeline : nullptr;
+}
+
+void DebugDraw::boxEdges(const std::array<Vec3, 8>& corners, uint32_t color, bool depthTest) {
+    // Corner bits are x, y, z; an edge joins corners differing in one bit
+    for (uint32_t i = 0; i < 8; ++i) {
+        for (uint32_t bit = 1; bit < 8; bit <<= 1) {
+            if (!(i & bit)) {
+                line(corners[i], corners[i | bit], color, depthTest);
+            }
+        }
+    }
+}
+
+} // namespace pers
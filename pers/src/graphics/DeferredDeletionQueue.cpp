@@ -0,0 +1,137 @@
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+DeferredDeletionQueue::DeferredDeletionQueue(const std::shared_ptr<IQueue>& queue)
+    : _queue(queue) {
+    if (!queue) {
+        LOG_WARNING("DeferredDeletionQueue", "Created without a queue, resources are released immediately");
+    }
+}
+
+DeferredDeletionQueue::~DeferredDeletionQueue() {
+    releaseEntries(_entries);
+}
+
+void DeferredDeletionQueue::retire(std::shared_ptr<void> resource) {
+    retire(std::move(resource), SubmissionFence());
+}
+
+void DeferredDeletionQueue::retire(std::shared_ptr<void> resource, const SubmissionFence& fence) {
+    if (!resource) {
+        return;
+    }
+    push(Entry{resolveFence(fence), std::move(resource), nullptr});
+}
+
+void DeferredDeletionQueue::retire(std::function<void()> release) {
+    retire(std::move(release), SubmissionFence());
+}
+
+void DeferredDeletionQueue::retire(std::function<void()> release, const SubmissionFence& fence) {
+    if (!release) {
+        return;
+    }
+    push(Entry{resolveFence(fence), nullptr, std::move(release)});
+}
+
+SubmissionFence DeferredDeletionQueue::resolveFence(const SubmissionFence& fence) const {
+    if (fence.isValid()) {
+        return fence;
+    }
+
+    // Empty submit returns the fence of the latest submission without queueing work
+    if (auto queue = _queue.lock()) {
+        return queue->submit(std::span<const std::shared_ptr<ICommandBuffer>>{});
+    }
+    return {};
+}
+
+void DeferredDeletionQueue::push(Entry entry) {
+    // No queue left to run the work, or nothing submitted yet
+    if (!entry.fence.isValid() || entry.fence.isComplete()) {
+        std::deque<Entry> ready;
+        ready.push_back(std::move(entry));
+        {
+            auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+            ++_retired;
+            ++_released;
+        }
+        releaseEntries(ready);
+        return;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _entries.push_back(std::move(entry));
+    ++_retired;
+}
+
+size_t DeferredDeletionQueue::collect() {
+    std::deque<Entry> ready;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        // Fences from one queue complete in order, but explicit fences may not be
+        auto split = std::stable_partition(_entries.begin(), _entries.end(),
+            [](const Entry& entry) { return entry.fence.isValid() && !entry.fence.isComplete(); });
+        ready.assign(std::make_move_iterator(split), std::make_move_iterator(_entries.end()));
+        _entries.erase(split, _entries.end());
+        _released += ready.size();
+    }
+
+    // Destructors run outside the lock so they may retire further resources
+    const size_t count = ready.size();
+    releaseEntries(ready);
+    return count;
+}
+
+bool DeferredDeletionQueue::flush(std::chrono::milliseconds timeout) {
+    std::deque<Entry> entries;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        entries.swap(_entries);
+        _released += entries.size();
+    }
+
+    bool complete = true;
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (const Entry& entry : entries) {
+        if (!entry.fence.isValid() || entry.fence.isComplete()) {
+            continue;
+        }
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (!entry.fence.wait(std::max(remaining, std::chrono::milliseconds(0)))) {
+            complete = false;
+        }
+    }
+    if (!complete) {
+        LOG_WARNING("DeferredDeletionQueue", "Releasing resources whose submissions did not complete");
+    }
+
+    releaseEntries(entries);
+    return complete;
+}
+
+DeferredDeletionQueue::Stats DeferredDeletionQueue::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    Stats stats;
+    stats.retired = _retired;
+    stats.released = _released;
+    stats.pending = _entries.size();
+    return stats;
+}
+
+void DeferredDeletionQueue::releaseEntries(std::deque<Entry>& entries) {
+    for (Entry& entry : entries) {
+        entry.resource.reset();
+        if (entry.release) {
+            entry.release();
+        }
+    }
+    entries.clear();
+}
+
+} // namespace pers
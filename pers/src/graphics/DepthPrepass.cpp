@@ -0,0 +1,108 @@
+#include "pers/graphics/DepthPrepass.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+DepthPrepass::DepthPrepass(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("DepthPrepass", "Resource factory is null");
+    }
+}
+
+RenderPipelineDesc DepthPrepass::makeDepthOnlyDesc(const RenderPipelineDesc& material, bool alphaTested) {
+    RenderPipelineDesc desc = material;
+    if (material.depthStencil.format == TextureFormat::Undefined) {
+        desc.vertex = nullptr;
+        return desc;
+    }
+
+    desc.colorTargets.clear();
+    if (!alphaTested) {
+        desc.fragment = nullptr;
+    }
+    desc.multisample.alphaToCoverageEnabled = alphaTested && material.multisample.alphaToCoverageEnabled;
+    desc.depthStencil.depthWriteEnabled = true;
+    desc.debugName = material.debugName.str() + ".Depth";
+    return desc;
+}
+
+RenderPipelineDesc DepthPrepass::makeShadingDesc(const RenderPipelineDesc& material) {
+    RenderPipelineDesc desc = material;
+    if (material.depthStencil.format == TextureFormat::Undefined) {
+        desc.vertex = nullptr;
+        return desc;
+    }
+
+    desc.depthStencil.depthWriteEnabled = false;
+    desc.depthStencil.depthCompare = CompareFunction::Equal;
+    desc.debugName = material.debugName.str() + ".DepthEqual";
+    return desc;
+}
+
+DepthPrepass::Variants* DepthPrepass::findVariants(const std::shared_ptr<IRenderPipeline>& material) {
+    if (!material) {
+        return nullptr;
+    }
+
+    // A released material's address can be reused, the weak pointer tells them apart
+    Variants& variants = _variants[material.get()];
+    if (variants.material.lock() != material) {
+        variants = Variants{};
+        variants.material = material;
+    }
+    return &variants;
+}
+
+std::shared_ptr<IRenderPipeline> DepthPrepass::createPipeline(const RenderPipelineDesc& desc) const {
+    if (!desc.vertex) {
+        LOG_WARNING("DepthPrepass", "Material pipeline is not ready or has no depth format");
+        return nullptr;
+    }
+
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("DepthPrepass", "Resource factory expired");
+        return nullptr;
+    }
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("DepthPrepass", "Failed to create pre-pass pipeline");
+        return nullptr;
+    }
+    return pipeline;
+}
+
+std::shared_ptr<IRenderPipeline> DepthPrepass::getDepthPipeline(const std::shared_ptr<IRenderPipeline>& material,
+                                                                bool alphaTested) {
+    Variants* variants = findVariants(material);
+    if (!variants) {
+        return nullptr;
+    }
+
+    auto& pipeline = alphaTested ? variants->alphaTestedDepth : variants->depth;
+    if (!pipeline) {
+        pipeline = createPipeline(makeDepthOnlyDesc(material->getDesc(), alphaTested));
+    }
+    return pipeline;
+}
+
+std::shared_ptr<IRenderPipeline> DepthPrepass::getShadingPipeline(const std::shared_ptr<IRenderPipeline>& material) {
+    Variants* variants = findVariants(material);
+    if (!variants) {
+        return nullptr;
+    }
+
+    if (!variants->shading) {
+        variants->shading = createPipeline(makeShadingDesc(material->getDesc()));
+    }
+    return variants->shading;
+}
+
+void DepthPrepass::purge() {
+    std::erase_if(_variants, [](const auto& entry) { return entry.second.material.expired(); });
+}
+
+} // namespace pers
@@ -0,0 +1,145 @@
+#include "pers/graphics/DevicePool.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+std::unique_ptr<DevicePool> DevicePool::create(const std::shared_ptr<IInstance>& instance, const Config& config) {
+    if (!instance) {
+        LOG_ERROR("DevicePool", "Instance is null");
+        return nullptr;
+    }
+
+    auto physicalDevices = instance->enumeratePhysicalDevices();
+    if (physicalDevices.empty()) {
+        LOG_ERROR("DevicePool", "No physical devices available");
+        return nullptr;
+    }
+
+    std::unique_ptr<DevicePool> pool(new DevicePool());
+    for (const auto& physicalDevice : physicalDevices) {
+        if (config.maxDevices != 0 && pool->_devices.size() >= config.maxDevices) {
+            break;
+        }
+
+        Entry entry;
+        entry.physicalDevice = physicalDevice;
+        entry.name = physicalDevice->getCapabilities().deviceName;
+
+        LogicalDeviceDesc deviceDesc = config.deviceDesc;
+        if (deviceDesc.debugName.empty()) {
+            deviceDesc.debugName = "DevicePool[" + std::to_string(pool->_devices.size()) + "]";
+        }
+
+        entry.device = physicalDevice->createLogicalDevice(deviceDesc);
+        if (!entry.device) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "DevicePool", PERS_SOURCE_LOC,
+                "Skipping adapter '%s', device creation failed", entry.name.c_str());
+            continue;
+        }
+
+        entry.queue = std::make_unique<OffscreenRenderQueue>(entry.device, config.maxInFlightPerDevice);
+        pool->_devices.push_back(std::move(entry));
+    }
+
+    if (pool->_devices.empty()) {
+        LOG_ERROR("DevicePool", "Failed to create any logical device");
+        return nullptr;
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "DevicePool", PERS_SOURCE_LOC,
+        "Created %zu device(s) from %zu adapter(s)", pool->_devices.size(), physicalDevices.size());
+    return pool;
+}
+
+DevicePool::~DevicePool() {
+    // Queues reference their device, tear them down first
+    for (auto& entry : _devices) {
+        entry.queue.reset();
+    }
+}
+
+std::shared_ptr<ILogicalDevice> DevicePool::getDevice(uint32_t index) const {
+    if (index >= _devices.size()) {
+        return nullptr;
+    }
+    return _devices[index].device;
+}
+
+OffscreenRenderQueue* DevicePool::getQueue(uint32_t index) const {
+    if (index >= _devices.size()) {
+        return nullptr;
+    }
+    return _devices[index].queue.get();
+}
+
+uint64_t DevicePool::submit(const OffscreenRenderJobDesc& desc, const RecordFunction& record,
+                            OffscreenRenderQueue::CompletionFunction onComplete, uint32_t* deviceIndex) {
+    if (_devices.empty() || !record) {
+        return 0;
+    }
+
+    // Recycle finished slots first so in-flight counts are current
+    poll();
+
+    uint32_t index = pickDevice();
+    if (deviceIndex) {
+        *deviceIndex = index;
+    }
+
+    auto bound = [&record, index](ICommandEncoder& encoder, const IFramebuffer& target) {
+        return record(index, encoder, target);
+    };
+    return _devices[index].queue->submit(desc, bound, std::move(onComplete));
+}
+
+size_t DevicePool::poll() {
+    size_t delivered = 0;
+    for (auto& entry : _devices) {
+        delivered += entry.queue->poll();
+    }
+    return delivered;
+}
+
+bool DevicePool::waitIdle(std::chrono::milliseconds timeout) {
+    // GPUs drain in parallel, so one timeout covers all of them
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool idle = true;
+    for (auto& entry : _devices) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        idle = entry.queue->waitIdle(std::max(remaining, std::chrono::milliseconds(0))) && idle;
+    }
+    return idle;
+}
+
+std::vector<DevicePool::DeviceStats> DevicePool::getStats() const {
+    std::vector<DeviceStats> stats;
+    stats.reserve(_devices.size());
+    for (const auto& entry : _devices) {
+        DeviceStats deviceStats;
+        deviceStats.deviceName = entry.name;
+        deviceStats.queue = entry.queue->getStats();
+        deviceStats.inFlight = entry.queue->getInFlightCount();
+        stats.push_back(deviceStats);
+    }
+    return stats;
+}
+
+uint32_t DevicePool::pickDevice() const {
+    // Fewest jobs in flight relative to capacity; ties go to the lower index
+    uint32_t best = 0;
+    double bestLoad = 2.0;
+    for (uint32_t i = 0; i < _devices.size(); ++i) {
+        const auto& queue = *_devices[i].queue;
+        double load = static_cast<double>(queue.getInFlightCount()) / queue.getMaxInFlight();
+        if (load < bestLoad) {
+            bestLoad = load;
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace pers
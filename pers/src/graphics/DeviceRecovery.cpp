@@ -0,0 +1,316 @@
+#include "pers/graphics/DeviceRecovery.h"
+#include "pers/core/JobSystem.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/MappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+namespace pers {
+
+DeviceRecovery::DeviceRecovery(const std::shared_ptr<ILogicalDevice>& device, const LogicalDeviceDesc& deviceDesc,
+                               JobSystem* jobSystem)
+    : _device(device)
+    , _deviceDesc(deviceDesc)
+    , _jobSystem(jobSystem) {
+    if (!device) {
+        LOG_ERROR("DeviceRecovery", "Created with null device");
+    }
+}
+
+DeviceRecovery::ContentFunction DeviceRecovery::keepCopy(std::span<const uint8_t> data) {
+    auto copy = std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+    return [copy](std::vector<uint8_t>& contents) {
+        contents = *copy;
+        return true;
+    };
+}
+
+DeviceRecovery::ContentFunction DeviceRecovery::fromFile(const std::string& path, uint64_t offset, uint64_t size) {
+    return [path, offset, size](std::vector<uint8_t>& contents) {
+        MappedFile file;
+        if (!file.open(path) || offset > file.size()) {
+            Logger::Instance().LogFormat(LogLevel::Error, "DeviceRecovery", PERS_SOURCE_LOC,
+                "Cannot read contents from %s", path.c_str());
+            return false;
+        }
+        const uint64_t available = file.size() - offset;
+        const uint64_t length = size == 0 ? available : size;
+        if (length > available) {
+            Logger::Instance().LogFormat(LogLevel::Error, "DeviceRecovery", PERS_SOURCE_LOC,
+                "%s is shorter than the referenced range", path.c_str());
+            return false;
+        }
+        contents.assign(file.data() + offset, file.data() + offset + length);
+        return true;
+    };
+}
+
+DeviceRecovery::TextureContentFunction DeviceRecovery::keepMipCopies(std::vector<std::vector<uint8_t>> mipLevels) {
+    auto copy = std::make_shared<const std::vector<std::vector<uint8_t>>>(std::move(mipLevels));
+    return [copy](uint32_t mipLevel, std::vector<uint8_t>& contents) {
+        if (mipLevel >= copy->size()) {
+            return false;
+        }
+        contents = (*copy)[mipLevel];
+        return true;
+    };
+}
+
+RecoverableHandle<INativeBuffer> DeviceRecovery::createBuffer(const BufferDesc& desc, ContentFunction contents) {
+    return createCustom<INativeBuffer>(RecoveryStage::Resources,
+        [desc, contents = std::move(contents)](ILogicalDevice& device) -> std::shared_ptr<INativeBuffer> {
+            const auto& factory = device.getResourceFactory();
+            if (!contents) {
+                return factory->createBuffer(desc);
+            }
+            std::vector<uint8_t> data;
+            if (!contents(data)) {
+                return nullptr;
+            }
+            return factory->createInitializableDeviceBuffer(desc, data.data(), data.size());
+        });
+}
+
+RecoverableHandle<ITexture> DeviceRecovery::createTexture(const TextureDesc& desc, TextureContentFunction contents) {
+    return createCustom<ITexture>(RecoveryStage::Resources,
+        [desc, contents = std::move(contents)](ILogicalDevice& device) -> std::shared_ptr<ITexture> {
+            auto texture = device.getResourceFactory()->createTexture(desc);
+            if (!texture || !contents) {
+                return texture;
+            }
+            auto queue = device.getQueue();
+            std::vector<uint8_t> data;
+            for (uint32_t mip = 0; mip < desc.mipLevelCount; ++mip) {
+                // Levels without contents are left for the GPU to fill, e.g. by MipmapGenerator
+                if (!contents(mip, data)) {
+                    break;
+                }
+                if (!queue || !queue->writeTexture(texture, data.data(), data.size(), mip)) {
+                    return nullptr;
+                }
+            }
+            return texture;
+        });
+}
+
+RecoverableHandle<ITextureView> DeviceRecovery::createTextureView(const RecoverableHandle<ITexture>& texture,
+                                                                  const TextureViewDesc& desc) {
+    if (!texture) {
+        return nullptr;
+    }
+    return createCustom<ITextureView>(RecoveryStage::Views,
+        [texture, desc](ILogicalDevice& device) -> std::shared_ptr<ITextureView> {
+            if (!texture->get()) {
+                return nullptr;
+            }
+            return device.getResourceFactory()->createTextureView(texture->get(), desc);
+        });
+}
+
+RecoverableHandle<ISampler> DeviceRecovery::createSampler(const SamplerDesc& desc) {
+    return createCustom<ISampler>(RecoveryStage::Resources, [desc](ILogicalDevice& device) {
+        return device.getResourceFactory()->createSampler(desc);
+    });
+}
+
+RecoverableHandle<IShaderModule> DeviceRecovery::createShaderModule(const ShaderModuleDesc& desc) {
+    return createCustom<IShaderModule>(RecoveryStage::Resources, [desc](ILogicalDevice& device) {
+        return device.getResourceFactory()->createShaderModule(desc);
+    });
+}
+
+RecoverableHandle<IBindGroupLayout> DeviceRecovery::createBindGroupLayout(const BindGroupLayoutDesc& desc) {
+    return createCustom<IBindGroupLayout>(RecoveryStage::Resources, [desc](ILogicalDevice& device) {
+        return device.getResourceFactory()->createBindGroupLayout(desc);
+    });
+}
+
+RecoverableHandle<IPipelineLayout> DeviceRecovery::createPipelineLayout(std::function<PipelineLayoutDesc()> build) {
+    return createCustom<IPipelineLayout>(RecoveryStage::Layouts, [build = std::move(build)](ILogicalDevice& device) {
+        return device.getResourceFactory()->createPipelineLayout(build());
+    });
+}
+
+RecoverableHandle<IRenderPipeline> DeviceRecovery::createRenderPipeline(std::function<RenderPipelineDesc()> build) {
+    return createCustom<IRenderPipeline>(RecoveryStage::Pipelines, [build = std::move(build)](ILogicalDevice& device) {
+        return device.getResourceFactory()->createRenderPipeline(build());
+    });
+}
+
+RecoverableHandle<IComputePipeline> DeviceRecovery::createComputePipeline(std::function<ComputePipelineDesc()> build) {
+    return createCustom<IComputePipeline>(RecoveryStage::Pipelines, [build = std::move(build)](ILogicalDevice& device) {
+        return device.getResourceFactory()->createComputePipeline(build());
+    });
+}
+
+RecoverableHandle<IBindGroup> DeviceRecovery::createBindGroup(std::function<BindGroupDesc()> build) {
+    return createCustom<IBindGroup>(RecoveryStage::BindGroups, [build = std::move(build)](ILogicalDevice& device) {
+        return device.getResourceFactory()->createBindGroup(build());
+    });
+}
+
+void DeviceRecovery::addRecoveredCallback(RecoveredFunction callback) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _recoveredCallbacks.push_back(std::move(callback));
+}
+
+bool DeviceRecovery::isLost() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _device && _device->isLost();
+}
+
+bool DeviceRecovery::recover(std::string* error) {
+    auto fail = [error](const std::string& message) {
+        LOG_ERROR("DeviceRecovery", message);
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<Entry> entries;
+    std::shared_ptr<ILogicalDevice> oldDevice;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::erase_if(_entries, [](const Entry& entry) { return entry.expired(); });
+        entries = _entries;
+        oldDevice = _device;
+    }
+
+    // Drop every object of the old device before its replacement exists,
+    // so a dead device does not hold GPU memory the new one needs
+    for (auto& entry : entries) {
+        entry.release();
+    }
+    std::shared_ptr<IPhysicalDevice> physicalDevice = oldDevice ? oldDevice->getPhysicalDevice() : nullptr;
+    oldDevice.reset();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _device.reset();
+    }
+
+    std::shared_ptr<ILogicalDevice> device;
+    if (_createDevice) {
+        device = _createDevice();
+    } else if (physicalDevice) {
+        device = physicalDevice->createLogicalDevice(_deviceDesc);
+    }
+    if (!device) {
+        return fail("Cannot create a replacement device");
+    }
+
+    // Stages run one after another, the objects within a stage in parallel
+    size_t failed = 0;
+    std::vector<size_t> stageEntries;
+    for (uint32_t stage = 0; stage < static_cast<uint32_t>(RecoveryStage::Count); ++stage) {
+        stageEntries.clear();
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].stage == static_cast<RecoveryStage>(stage)) {
+                stageEntries.push_back(i);
+            }
+        }
+        failed += runParallel(stageEntries.size(), [&](size_t index) {
+            return entries[stageEntries[index]].recreate(*device);
+        });
+    }
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    std::vector<RecoveredFunction> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _device = device;
+        ++_stats.recoveries;
+        _stats.failedObjects = static_cast<uint32_t>(failed);
+        _stats.lastRecoveryMs = elapsedMs;
+        callbacks = _recoveredCallbacks;
+    }
+
+    Logger::Instance().LogFormat(failed == 0 ? LogLevel::Info : LogLevel::Warning, "DeviceRecovery", PERS_SOURCE_LOC,
+        "Recreated %zu of %zu objects on a new device in %.1f ms",
+        entries.size() - failed, entries.size(), elapsedMs);
+    if (failed != 0) {
+        return fail(std::to_string(failed) + " objects could not be recreated");
+    }
+
+    for (const auto& callback : callbacks) {
+        callback(device);
+    }
+    return true;
+}
+
+std::shared_ptr<ILogicalDevice> DeviceRecovery::getDevice() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _device;
+}
+
+DeviceRecovery::Stats DeviceRecovery::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats = _stats;
+    stats.objects = static_cast<uint32_t>(std::count_if(_entries.begin(), _entries.end(),
+        [](const Entry& entry) { return !entry.expired(); }));
+    return stats;
+}
+
+bool DeviceRecovery::addEntry(Entry entry) {
+    std::shared_ptr<ILogicalDevice> device = getDevice();
+    if (!device || !entry.recreate(*device)) {
+        LOG_ERROR("DeviceRecovery", "Initial creation failed, object is not registered");
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Prune dropped objects whenever the registry has doubled since the last prune
+    if (_entries.size() >= 64 && (_entries.size() & (_entries.size() - 1)) == 0) {
+        std::erase_if(_entries, [](const Entry& existing) { return existing.expired(); });
+    }
+    _entries.push_back(std::move(entry));
+    return true;
+}
+
+size_t DeviceRecovery::runParallel(size_t count, const std::function<bool(size_t index)>& task) {
+    std::atomic<size_t> failed{0};
+    if (count == 0) {
+        return 0;
+    }
+
+    if (_jobSystem) {
+        JobHandle handle = _jobSystem->parallelFor(static_cast<uint32_t>(count), 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                if (!task(i)) {
+                    failed.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+        _jobSystem->wait(handle);
+        return failed.load();
+    }
+
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            if (!task(i)) {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+    const size_t threadCount = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency())) - 1;
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failed.load();
+}
+
+} // namespace pers
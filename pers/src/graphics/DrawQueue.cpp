@@ -0,0 +1,202 @@
+#include "pers/graphics/DrawQueue.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+constexpr uint64_t DEPTH_BITS = 24;
+constexpr uint64_t DEPTH_MASK = (1ull << DEPTH_BITS) - 1;
+
+// Non-negative floats order like their bit patterns; keep the top 24 bits
+uint64_t quantizeDepth(float viewDepth) {
+    const float depth = viewDepth > 0.0f ? viewDepth : 0.0f;
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return (bits >> (32 - DEPTH_BITS)) & DEPTH_MASK;
+}
+
+} // anonymous namespace
+
+uint64_t DrawQueue::makeKey(uint8_t pass, uint16_t pipelineId, uint16_t bindGroupId, float viewDepth, Order order) {
+    const uint64_t depth = quantizeDepth(viewDepth);
+    if (order == Order::Translucent) {
+        // Farthest first, state only breaks ties
+        return (uint64_t(pass) << 56) | ((DEPTH_MASK - depth) << 32) | (uint64_t(pipelineId) << 16) | bindGroupId;
+    }
+    return (uint64_t(pass) << 56) | (uint64_t(pipelineId) << 40) | (uint64_t(bindGroupId) << 24) | depth;
+}
+
+uint16_t DrawQueue::getStateId(std::unordered_map<const void*, uint16_t>& ids, const void* object) {
+    if (!object) {
+        return 0;
+    }
+    auto it = ids.find(object);
+    if (it != ids.end()) {
+        return it->second;
+    }
+    if (ids.size() >= 0xFFFE) {
+        // Out of IDs; the rest share one, sorting degrades but stays correct
+        return 0xFFFF;
+    }
+    const uint16_t id = static_cast<uint16_t>(ids.size() + 1);
+    ids.emplace(object, id);
+    return id;
+}
+
+void DrawQueue::add(const DrawCommand& command, uint8_t pass, float viewDepth, Order order) {
+    if (!command.pipeline) {
+        LOG_ERROR("DrawQueue", "Draw without a pipeline");
+        return;
+    }
+
+    const uint16_t pipelineId = getStateId(_pipelineIds, command.pipeline.get());
+    const uint16_t bindGroupId = getStateId(_bindGroupIds, command.bindGroups[0].get());
+
+    _entries.push_back({makeKey(pass, pipelineId, bindGroupId, viewDepth, order),
+                        static_cast<uint32_t>(_commands.size())});
+    _commands.push_back(command);
+    _sorted = false;
+}
+
+void DrawQueue::sort() {
+    if (_sorted) {
+        return;
+    }
+    _sorted = true;
+    const size_t count = _entries.size();
+    if (count < 2) {
+        return;
+    }
+
+    // 8 passes of 8 bits; a pass where every key shares the byte is skipped.
+    // Each pass is stable, so equal keys keep submission order.
+    _scratch.resize(count);
+    SortEntry* source = _entries.data();
+    SortEntry* target = _scratch.data();
+
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (size_t i = 0; i < count; ++i) {
+            ++histogram[(source[i].key >> shift) & 0xFF];
+        }
+        if (histogram[(source[0].key >> shift) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            const size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            target[histogram[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    if (source != _entries.data()) {
+        std::memcpy(_entries.data(), source, count * sizeof(SortEntry));
+    }
+}
+
+uint32_t DrawQueue::encode(IRenderPassEncoder& encoder, uint8_t pass) {
+    if (!_sorted) {
+        LOG_WARNING("DrawQueue", "encode() before sort(), sorting now");
+        sort();
+    }
+
+    const uint64_t passBegin = uint64_t(pass) << 56;
+    auto first = std::lower_bound(_entries.begin(), _entries.end(), passBegin,
+                                  [](const SortEntry& entry, uint64_t key) { return entry.key < key; });
+
+    const IRenderPipeline* boundPipeline = nullptr;
+    std::array<const IBindGroup*, DrawCommand::MAX_BIND_GROUPS> boundGroups{};
+    std::array<uint32_t, DrawCommand::MAX_BIND_GROUPS> boundOffsets{};
+    const IBuffer* boundVertexBuffer = nullptr;
+    uint64_t boundVertexOffset = 0;
+    const IBuffer* boundIndexBuffer = nullptr;
+    uint64_t boundIndexOffset = 0;
+
+    uint32_t encoded = 0;
+    for (auto it = first; it != _entries.end() && (it->key >> 56) == pass; ++it) {
+        const DrawCommand& command = _commands[it->command];
+
+        if (command.pipeline.get() != boundPipeline) {
+            encoder.setPipeline(command.pipeline);
+            boundPipeline = command.pipeline.get();
+            boundGroups = {};  // Layouts may differ, rebind everything
+            ++_stats.pipelineChanges;
+        }
+
+        for (uint32_t group = 0; group < DrawCommand::MAX_BIND_GROUPS; ++group) {
+            const auto& bindGroup = command.bindGroups[group];
+            if (!bindGroup) {
+                continue;
+            }
+            const bool dynamic = (command.dynamicOffsetMask >> group) & 1;
+            const uint32_t offset = dynamic ? command.dynamicOffsets[group] : 0;
+            if (bindGroup.get() == boundGroups[group] && (!dynamic || offset == boundOffsets[group])) {
+                continue;
+            }
+            if (dynamic) {
+                encoder.setBindGroup(group, bindGroup, std::span<const uint32_t>(&command.dynamicOffsets[group], 1));
+            } else {
+                encoder.setBindGroup(group, bindGroup);
+            }
+            boundGroups[group] = bindGroup.get();
+            boundOffsets[group] = offset;
+            ++_stats.bindGroupChanges;
+        }
+
+        if (command.vertexBuffer &&
+            (command.vertexBuffer.get() != boundVertexBuffer || command.vertexOffset != boundVertexOffset)) {
+            encoder.setVertexBuffer(0, command.vertexBuffer, command.vertexOffset);
+            boundVertexBuffer = command.vertexBuffer.get();
+            boundVertexOffset = command.vertexOffset;
+            ++_stats.bufferChanges;
+        }
+
+        if (command.indexBuffer) {
+            if (command.indexBuffer.get() != boundIndexBuffer || command.indexOffset != boundIndexOffset) {
+                encoder.setIndexBuffer(command.indexBuffer, command.indexFormat, command.indexOffset);
+                boundIndexBuffer = command.indexBuffer.get();
+                boundIndexOffset = command.indexOffset;
+                ++_stats.bufferChanges;
+            }
+            encoder.drawIndexed(command.indexCount, command.instanceCount, command.firstIndex,
+                                command.baseVertex, command.firstInstance);
+        } else {
+            encoder.draw(command.vertexCount, command.instanceCount, command.firstVertex, command.firstInstance);
+        }
+        ++encoded;
+    }
+
+    _stats.draws += encoded;
+    return encoded;
+}
+
+void DrawQueue::resetStateIds() {
+    if (!_commands.empty()) {
+        LOG_WARNING("DrawQueue", "resetStateIds() with queued draws ignored");
+        return;
+    }
+    _pipelineIds.clear();
+    _bindGroupIds.clear();
+}
+
+void DrawQueue::clear() {
+    _commands.clear();
+    _entries.clear();
+    _sorted = true;
+    _stats = {};
+}
+
+} // namespace pers
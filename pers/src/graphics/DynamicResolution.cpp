@@ -0,0 +1,330 @@
+#include "pers/graphics/DynamicResolution.h"
+#include "pers/graphics/GpuPassTimer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IFramebuffer.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct UpscaleUniforms {
+    float uvPerPixel[2];  // Destination pixel to source UV
+    float uvMin[2];       // Rendered region inset by half a texel
+    float uvMax[2];
+    float padding[2];
+};
+
+constexpr char UPSCALE_WGSL[] = R"(
+struct Upscale {
+    uvPerPixel: vec2<f32>,
+    uvMin: vec2<f32>,
+    uvMax: vec2<f32>,
+    padding: vec2<f32>,
+};
+@group(0) @binding(0) var<uniform> upscale: Upscale;
+@group(0) @binding(1) var source: texture_2d<f32>;
+@group(0) @binding(2) var linearSampler: sampler;
+)";
+
+using UpscaleLayout = GpuStruct<GpuLayout::Std140, GpuVec2f, GpuVec2f, GpuVec2f, GpuVec2f>;
+static_assert(UpscaleLayout::matchesWgsl(UPSCALE_WGSL, "Upscale"), "Upscale no longer matches the upscale shader");
+static_assert(UpscaleLayout::SIZE == sizeof(UpscaleUniforms) &&
+              UpscaleLayout::offsetOf<2>() == offsetof(UpscaleUniforms, uvMax),
+              "UpscaleUniforms must match the WGSL layout");
+
+constexpr char VERTEX_SHADER[] = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    // Single triangle covering the viewport
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+constexpr char FRAGMENT_MAIN[] = R"(
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    let uv = clamp(position.xy * upscale.uvPerPixel, upscale.uvMin, upscale.uvMax);
+    return textureSampleLevel(source, linearSampler, uv, 0.0);
+}
+)";
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("DynamicResolution", "Failed to create upscale shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+} // anonymous namespace
+
+DynamicResolution::DynamicResolution(const std::shared_ptr<ILogicalDevice>& device,
+                                     const DynamicResolutionConfig& config)
+    : _device(device) {
+    setConfig(config);
+    _scale = _config.maxScale;
+
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("DynamicResolution", "Device or resource factory is null");
+        return;
+    }
+
+    _uniformBuffer = std::make_shared<DeviceBuffer>();
+    if (!_uniformBuffer->create(sizeof(UpscaleUniforms), DeviceBufferUsage::Uniform, device, "DynamicResolution")) {
+        LOG_ERROR("DynamicResolution", "Failed to create upscale uniform buffer");
+        return;
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.label = "DynamicResolution";
+    _sampler = factory->createSampler(samplerDesc);
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "DynamicResolution::Upscale";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(UpscaleUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::Sampler},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+
+    _vertexShader = createShader(*factory, VERTEX_SHADER, ShaderStage::Vertex, "DynamicResolution::UpscaleVertex");
+    _fragmentShader = createShader(*factory, std::string(UPSCALE_WGSL) + FRAGMENT_MAIN, ShaderStage::Fragment,
+                                   "DynamicResolution::UpscaleFragment");
+    if (!_sampler || !_layout || !_vertexShader || !_fragmentShader) {
+        LOG_ERROR("DynamicResolution", "Failed to create upscale resources");
+        return;
+    }
+
+    // Created last, isValid() means the upscale is usable
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_layout};
+    pipelineLayoutDesc.debugName = "DynamicResolution::Upscale";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+}
+
+DynamicResolution::~DynamicResolution() = default;
+
+void DynamicResolution::setConfig(const DynamicResolutionConfig& config) {
+    _config = config;
+    _config.maxScale = std::clamp(_config.maxScale, 0.01f, 1.0f);
+    _config.minScale = std::clamp(_config.minScale, 0.01f, _config.maxScale);
+    _config.smoothing = std::clamp(_config.smoothing, 0.0f, 1.0f);
+    _config.maxStep = std::max(_config.maxStep, 0.0f);
+    _config.alignment = std::max(_config.alignment, 1u);
+    _scale = std::clamp(_scale, _config.minScale, _config.maxScale);
+}
+
+void DynamicResolution::reset(float scale) {
+    _scale = std::clamp(scale, _config.minScale, _config.maxScale);
+    _smoothedMilliseconds = 0.0;
+}
+
+bool DynamicResolution::update(const GpuFrameTiming& timing) {
+    // No result yet, or the report already applied
+    if (timing.frameIndex == 0 || timing.frameIndex == _lastFrameIndex) {
+        return false;
+    }
+    _lastFrameIndex = timing.frameIndex;
+    return update(timing.totalMilliseconds);
+}
+
+bool DynamicResolution::update(double gpuMilliseconds) {
+    if (!(gpuMilliseconds > 0.0) || _config.targetFrameMilliseconds <= 0.0) {
+        return false;
+    }
+
+    _smoothedMilliseconds = _smoothedMilliseconds > 0.0
+        ? _smoothedMilliseconds + (gpuMilliseconds - _smoothedMilliseconds) * _config.smoothing
+        : gpuMilliseconds;
+
+    const double budget = _config.targetFrameMilliseconds * _config.headroom;
+    if (std::abs(_smoothedMilliseconds / budget - 1.0) <= _config.deadband) {
+        return false;
+    }
+
+    // Time follows pixel count, the square of the per-axis scale
+    const double ideal = _scale * std::sqrt(budget / _smoothedMilliseconds);
+    const double stepped = std::clamp(ideal, static_cast<double>(_scale - _config.maxStep),
+                                      static_cast<double>(_scale + _config.maxStep));
+    const float scale = static_cast<float>(std::clamp(stepped, static_cast<double>(_config.minScale),
+                                                      static_cast<double>(_config.maxScale)));
+    if (scale == _scale) {
+        return false;
+    }
+
+    // Predict the time at the new scale so late reports of old frames do not push it further
+    _smoothedMilliseconds *= static_cast<double>(scale) * scale / (static_cast<double>(_scale) * _scale);
+    _scale = scale;
+    return true;
+}
+
+uint32_t DynamicResolution::scaledSize(uint32_t maxSize) const {
+    const uint32_t alignment = _config.alignment;
+    const auto scaled = static_cast<uint32_t>(static_cast<double>(maxSize) * _scale);
+    return std::min(maxSize, std::max(alignment, scaled / alignment * alignment));
+}
+
+uint32_t DynamicResolution::getRenderWidth(uint32_t maxWidth) const {
+    return scaledSize(maxWidth);
+}
+
+uint32_t DynamicResolution::getRenderHeight(uint32_t maxHeight) const {
+    return scaledSize(maxHeight);
+}
+
+void DynamicResolution::applyViewport(IRenderPassEncoder& pass, const IFramebuffer& target) const {
+    const uint32_t width = getRenderWidth(target.getWidth());
+    const uint32_t height = getRenderHeight(target.getHeight());
+    pass.setViewport(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height), 0.0f, 1.0f);
+    pass.setScissorRect(0, 0, width, height);
+}
+
+bool DynamicResolution::upscale(ICommandEncoder& encoder, const OffscreenFramebuffer& source,
+                                const IFramebuffer& destination) {
+    PERS_PROFILE_SCOPE("DynamicResolution::upscale");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue || !isValid()) {
+        LOG_ERROR("DynamicResolution", "Cannot upscale with an invalid dynamic resolution controller");
+        return false;
+    }
+
+    auto sourceView = source.getColorAttachment(0);
+    auto destinationView = destination.getColorAttachment(0);
+    if (!sourceView || !destinationView || source.getSampleCount() != 1) {
+        LOG_ERROR("DynamicResolution", "Upscale needs a single-sampled source and a destination color attachment");
+        return false;
+    }
+
+    const uint32_t sourceWidth = source.getWidth();
+    const uint32_t sourceHeight = source.getHeight();
+    const uint32_t destinationWidth = destination.getWidth();
+    const uint32_t destinationHeight = destination.getHeight();
+    if (sourceWidth == 0 || sourceHeight == 0 || destinationWidth == 0 || destinationHeight == 0) {
+        LOG_ERROR("DynamicResolution", "Upscale source and destination must have a non-zero size");
+        return false;
+    }
+
+    auto pipeline = getPipeline(destination.getColorFormat(0));
+    if (!pipeline) {
+        return false;
+    }
+
+    const float regionU = static_cast<float>(getRenderWidth(sourceWidth)) / static_cast<float>(sourceWidth);
+    const float regionV = static_cast<float>(getRenderHeight(sourceHeight)) / static_cast<float>(sourceHeight);
+    const float halfTexelU = 0.5f / static_cast<float>(sourceWidth);
+    const float halfTexelV = 0.5f / static_cast<float>(sourceHeight);
+    UpscaleUniforms uniforms = {};
+    uniforms.uvPerPixel[0] = regionU / static_cast<float>(destinationWidth);
+    uniforms.uvPerPixel[1] = regionV / static_cast<float>(destinationHeight);
+    uniforms.uvMin[0] = halfTexelU;
+    uniforms.uvMin[1] = halfTexelV;
+    uniforms.uvMax[0] = regionU - halfTexelU;
+    uniforms.uvMax[1] = regionV - halfTexelV;
+    if (!queue->writeBuffer(_uniformBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&uniforms), sizeof(uniforms)))) {
+        LOG_ERROR("DynamicResolution", "Failed to write upscale uniforms");
+        return false;
+    }
+
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _layout;
+    bindGroupDesc.debugName = "DynamicResolution::Upscale";
+    bindGroupDesc.entries.resize(3);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = _uniformBuffer;
+    bindGroupDesc.entries[0].size = sizeof(UpscaleUniforms);
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].textureView = sourceView;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].sampler = _sampler;
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("DynamicResolution", "Failed to create upscale bind group");
+        return false;
+    }
+
+    // Every texel is overwritten, nothing to load
+    RenderPassDesc passDesc;
+    passDesc.label = "DynamicResolution::Upscale";
+    RenderPassColorAttachment attachment;
+    attachment.view = destinationView;
+    attachment.loadOp = LoadOp::Clear;
+    attachment.storeOp = StoreOp::Store;
+    passDesc.colorAttachments.push_back(attachment);
+
+    auto renderPass = encoder.beginRenderPass(passDesc);
+    if (!renderPass) {
+        LOG_ERROR("DynamicResolution", "Failed to begin upscale pass");
+        return false;
+    }
+    renderPass->setPipeline(pipeline);
+    renderPass->setBindGroup(0, bindGroup);
+    renderPass->draw(3);
+    renderPass->end();
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> DynamicResolution::getPipeline(TextureFormat format) {
+    auto it = _pipelines.find(format);
+    if (it != _pipelines.end()) {
+        return it->second;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _pipelineLayout;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = format;
+    desc.debugName = "DynamicResolution::Upscale";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("DynamicResolution", "Failed to create upscale pipeline");
+        return nullptr;
+    }
+
+    _pipelines.emplace(format, pipeline);
+    return pipeline;
+}
+
+} // namespace pers
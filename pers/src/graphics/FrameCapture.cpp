@@ -0,0 +1,473 @@
+#include "pers/graphics/FrameCapture.h"
+#include "pers/utils/Logger.h"
+#include <bit>
+#include <fstream>
+#include <iterator>
+
+namespace pers {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'P', 'E', 'R', 'S', 'C', 'A', 'P', 'T'};
+
+using detail::CaptureReader;
+using detail::CaptureWriter;
+
+void writeIds(CaptureWriter& writer, const std::vector<uint32_t>& ids) {
+    writer.u32(static_cast<uint32_t>(ids.size()));
+    for (uint32_t id : ids) {
+        writer.u32(id);
+    }
+}
+
+// Counts come from the file, reject ones the remaining bytes cannot hold
+template<typename T>
+bool resizeChecked(CaptureReader& reader, std::vector<T>& values, uint32_t count) {
+    if (!reader.ok() || count > reader.remaining()) {
+        reader.fail();
+        return false;
+    }
+    values.resize(count);
+    return true;
+}
+
+std::vector<uint32_t> readIds(CaptureReader& reader) {
+    std::vector<uint32_t> ids;
+    if (!resizeChecked(reader, ids, reader.u32())) {
+        return ids;
+    }
+    for (size_t i = 0; i < ids.size() && reader.ok(); ++i) {
+        ids[i] = reader.u32();
+    }
+    return ids;
+}
+
+void writeConstants(CaptureWriter& writer, const std::vector<PipelineConstant>& constants) {
+    writer.u32(static_cast<uint32_t>(constants.size()));
+    for (const auto& constant : constants) {
+        writer.str(constant.key);
+        writer.u64(std::bit_cast<uint64_t>(constant.value));
+    }
+}
+
+void writePipelineState(CaptureWriter& writer, const RenderPipelineDesc& desc) {
+    writer.u32(static_cast<uint32_t>(desc.vertexLayouts.size()));
+    for (const auto& layout : desc.vertexLayouts) {
+        writer.u64(layout.arrayStride);
+        writer.enumValue(layout.stepMode);
+        writer.u32(static_cast<uint32_t>(layout.attributes.size()));
+        for (const auto& attribute : layout.attributes) {
+            writer.enumValue(attribute.format);
+            writer.u64(attribute.offset);
+            writer.u32(attribute.shaderLocation);
+        }
+    }
+
+    writer.enumValue(desc.primitive.topology);
+    writer.enumValue(desc.primitive.stripIndexFormat);
+    writer.enumValue(desc.primitive.frontFace);
+    writer.enumValue(desc.primitive.cullMode);
+
+    writer.enumValue(desc.depthStencil.format);
+    writer.u32(desc.depthStencil.depthWriteEnabled ? 1 : 0);
+    writer.enumValue(desc.depthStencil.depthCompare);
+    for (const StencilFaceState* face : {&desc.depthStencil.stencilFront, &desc.depthStencil.stencilBack}) {
+        writer.enumValue(face->compare);
+        writer.enumValue(face->failOp);
+        writer.enumValue(face->depthFailOp);
+        writer.enumValue(face->passOp);
+    }
+    writer.u32(desc.depthStencil.stencilReadMask);
+    writer.u32(desc.depthStencil.stencilWriteMask);
+
+    writer.u32(desc.multisample.count);
+    writer.u32(desc.multisample.mask);
+    writer.u32(desc.multisample.alphaToCoverageEnabled ? 1 : 0);
+
+    writer.u32(static_cast<uint32_t>(desc.colorTargets.size()));
+    for (const auto& target : desc.colorTargets) {
+        writer.enumValue(target.format);
+        writer.enumValue(target.writeMask);
+        writer.u32(target.blendEnabled ? 1 : 0);
+        for (const BlendComponent* component : {&target.blend.color, &target.blend.alpha}) {
+            writer.enumValue(component->operation);
+            writer.enumValue(component->srcFactor);
+            writer.enumValue(component->dstFactor);
+        }
+    }
+
+    writeConstants(writer, desc.vertexConstants);
+    writeConstants(writer, desc.fragmentConstants);
+
+    writer.str(desc.debugName);
+}
+
+void readConstants(CaptureReader& reader, std::vector<PipelineConstant>& constants) {
+    if (!resizeChecked(reader, constants, reader.u32())) {
+        return;
+    }
+    for (auto& constant : constants) {
+        constant.key = reader.str();
+        constant.value = std::bit_cast<double>(reader.u64());
+    }
+}
+
+void readPipelineState(CaptureReader& reader, RenderPipelineDesc& desc) {
+    if (!resizeChecked(reader, desc.vertexLayouts, reader.u32())) {
+        return;
+    }
+    for (auto& layout : desc.vertexLayouts) {
+        if (!reader.ok()) {
+            return;
+        }
+        layout.arrayStride = reader.u64();
+        layout.stepMode = reader.enumValue<VertexStepMode>();
+        if (!resizeChecked(reader, layout.attributes, reader.u32())) {
+            return;
+        }
+        for (auto& attribute : layout.attributes) {
+            if (!reader.ok()) {
+                return;
+            }
+            attribute.format = reader.enumValue<VertexFormat>();
+            attribute.offset = reader.u64();
+            attribute.shaderLocation = reader.u32();
+        }
+    }
+
+    desc.primitive.topology = reader.enumValue<PrimitiveTopology>();
+    desc.primitive.stripIndexFormat = reader.enumValue<IndexFormat>();
+    desc.primitive.frontFace = reader.enumValue<FrontFace>();
+    desc.primitive.cullMode = reader.enumValue<CullMode>();
+
+    desc.depthStencil.format = reader.enumValue<TextureFormat>();
+    desc.depthStencil.depthWriteEnabled = reader.u32() != 0;
+    desc.depthStencil.depthCompare = reader.enumValue<CompareFunction>();
+    for (StencilFaceState* face : {&desc.depthStencil.stencilFront, &desc.depthStencil.stencilBack}) {
+        face->compare = reader.enumValue<CompareFunction>();
+        face->failOp = reader.enumValue<StencilOperation>();
+        face->depthFailOp = reader.enumValue<StencilOperation>();
+        face->passOp = reader.enumValue<StencilOperation>();
+    }
+    desc.depthStencil.stencilReadMask = reader.u32();
+    desc.depthStencil.stencilWriteMask = reader.u32();
+
+    desc.multisample.count = reader.u32();
+    desc.multisample.mask = reader.u32();
+    desc.multisample.alphaToCoverageEnabled = reader.u32() != 0;
+
+    if (!resizeChecked(reader, desc.colorTargets, reader.u32())) {
+        return;
+    }
+    for (auto& target : desc.colorTargets) {
+        if (!reader.ok()) {
+            return;
+        }
+        target.format = reader.enumValue<TextureFormat>();
+        target.writeMask = reader.enumValue<ColorWriteMask>();
+        target.blendEnabled = reader.u32() != 0;
+        for (BlendComponent* component : {&target.blend.color, &target.blend.alpha}) {
+            component->operation = reader.enumValue<BlendOperation>();
+            component->srcFactor = reader.enumValue<BlendFactor>();
+            component->dstFactor = reader.enumValue<BlendFactor>();
+        }
+    }
+
+    readConstants(reader, desc.vertexConstants);
+    readConstants(reader, desc.fragmentConstants);
+
+    desc.debugName = reader.str();
+}
+
+} // namespace
+
+bool FrameCapture::save(const std::string& path) const {
+    std::vector<std::byte> bytes;
+    CaptureWriter writer(bytes);
+    writer.u32(FORMAT_VERSION);
+
+    writer.u32(static_cast<uint32_t>(buffers.size()));
+    for (const auto& buffer : buffers) {
+        writer.u64(buffer.size);
+        writer.enumValue(buffer.usage);
+        writer.str(buffer.debugName);
+        writer.bytes(buffer.contents);
+    }
+
+    writer.u32(static_cast<uint32_t>(textures.size()));
+    for (const auto& texture : textures) {
+        writer.u32(texture.width);
+        writer.u32(texture.height);
+        writer.u32(texture.sampleCount);
+        writer.enumValue(texture.format);
+        writer.enumValue(texture.dimension);
+        writer.enumValue(texture.usage);
+    }
+
+    writer.u32(static_cast<uint32_t>(samplers.size()));
+    for (const auto& sampler : samplers) {
+        writer.enumValue(sampler.magFilter);
+        writer.enumValue(sampler.minFilter);
+        writer.enumValue(sampler.mipmapFilter);
+        writer.enumValue(sampler.addressModeU);
+        writer.enumValue(sampler.addressModeV);
+        writer.enumValue(sampler.addressModeW);
+        writer.f32(sampler.lodMinClamp);
+        writer.f32(sampler.lodMaxClamp);
+        writer.enumValue(sampler.compare);
+        writer.u32(sampler.maxAnisotropy);
+        writer.str(sampler.label);
+    }
+
+    writer.u32(static_cast<uint32_t>(shaders.size()));
+    for (const auto& shader : shaders) {
+        writer.enumValue(shader.stage);
+        writer.str(shader.entryPoint);
+        writer.str(shader.debugName);
+        writer.str(shader.code);
+        writeIds(writer, shader.spirv);
+    }
+
+    writer.u32(static_cast<uint32_t>(bindGroupLayouts.size()));
+    for (const auto& layout : bindGroupLayouts) {
+        writer.u32(static_cast<uint32_t>(layout.entries.size()));
+        for (const auto& entry : layout.entries) {
+            writer.u32(entry.binding);
+            writer.enumValue(entry.visibility);
+            writer.enumValue(entry.type);
+            writer.u32(entry.hasDynamicOffset ? 1 : 0);
+            writer.u64(entry.minBindingSize);
+            writer.enumValue(entry.sampleType);
+            writer.enumValue(entry.viewDimension);
+            writer.u32(entry.multisampled ? 1 : 0);
+            writer.enumValue(entry.storageTextureFormat);
+            writer.u32(entry.count);
+        }
+        writer.str(layout.debugName);
+    }
+
+    writer.u32(static_cast<uint32_t>(pipelineLayouts.size()));
+    for (const auto& layout : pipelineLayouts) {
+        writeIds(writer, layout.bindGroupLayouts);
+        writer.u32(static_cast<uint32_t>(layout.pushConstantRanges.size()));
+        for (const auto& range : layout.pushConstantRanges) {
+            writer.enumValue(range.stages);
+            writer.u32(range.offset);
+            writer.u32(range.size);
+        }
+        writer.str(layout.debugName);
+    }
+
+    writer.u32(static_cast<uint32_t>(pipelines.size()));
+    for (const auto& pipeline : pipelines) {
+        writer.u32(pipeline.vertex);
+        writer.u32(pipeline.fragment);
+        writer.u32(pipeline.layout);
+        writePipelineState(writer, pipeline.state);
+    }
+
+    writer.u32(static_cast<uint32_t>(bindGroups.size()));
+    for (const auto& group : bindGroups) {
+        writer.u32(group.layout);
+        writer.u32(static_cast<uint32_t>(group.entries.size()));
+        for (const auto& entry : group.entries) {
+            writer.u32(entry.binding);
+            writer.u32(entry.buffer);
+            writer.u64(entry.offset);
+            writer.u64(entry.size);
+            writer.u32(entry.textureView);
+            writer.u32(entry.sampler);
+            writeIds(writer, entry.buffers);
+            writeIds(writer, entry.textureViews);
+            writeIds(writer, entry.samplers);
+        }
+        writer.str(group.debugName);
+    }
+
+    writer.u32(commandCount);
+    writer.u32(encoderCount);
+    writer.u32(passCount);
+    writer.u32(skippedCommands);
+    writer.bytes(commands);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "FrameCapture", PERS_SOURCE_LOC,
+            "Failed to open %s for writing", path.c_str());
+        return false;
+    }
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "FrameCapture", PERS_SOURCE_LOC,
+            "Failed to write capture to %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool FrameCapture::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "FrameCapture", PERS_SOURCE_LOC,
+            "Failed to open capture %s", path.c_str());
+        return false;
+    }
+
+    char magic[sizeof(FILE_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::string(magic, sizeof(magic)) != std::string(FILE_MAGIC, sizeof(FILE_MAGIC))) {
+        LOG_ERROR("FrameCapture", "File is not a frame capture");
+        return false;
+    }
+
+    std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const auto bytes = std::as_bytes(std::span<const char>(contents));
+    CaptureReader reader(bytes);
+
+    if (reader.u32() != FORMAT_VERSION) {
+        LOG_ERROR("FrameCapture", "Capture was written by an incompatible format version");
+        return false;
+    }
+
+    FrameCapture capture;
+
+    if (!resizeChecked(reader, capture.buffers, reader.u32())) {
+        return false;
+    }
+    for (auto& buffer : capture.buffers) {
+        buffer.size = reader.u64();
+        buffer.usage = reader.enumValue<BufferUsage>();
+        buffer.debugName = reader.str();
+        const auto data = reader.bytes();
+        buffer.contents.assign(data.begin(), data.end());
+    }
+
+    if (!resizeChecked(reader, capture.textures, reader.u32())) {
+        return false;
+    }
+    for (auto& texture : capture.textures) {
+        texture.width = reader.u32();
+        texture.height = reader.u32();
+        texture.sampleCount = reader.u32();
+        texture.format = reader.enumValue<TextureFormat>();
+        texture.dimension = reader.enumValue<TextureViewDimension>();
+        texture.usage = reader.enumValue<TextureUsage>();
+    }
+
+    if (!resizeChecked(reader, capture.samplers, reader.u32())) {
+        return false;
+    }
+    for (auto& sampler : capture.samplers) {
+        sampler.magFilter = reader.enumValue<FilterMode>();
+        sampler.minFilter = reader.enumValue<FilterMode>();
+        sampler.mipmapFilter = reader.enumValue<FilterMode>();
+        sampler.addressModeU = reader.enumValue<AddressMode>();
+        sampler.addressModeV = reader.enumValue<AddressMode>();
+        sampler.addressModeW = reader.enumValue<AddressMode>();
+        sampler.lodMinClamp = reader.f32();
+        sampler.lodMaxClamp = reader.f32();
+        sampler.compare = reader.enumValue<CompareFunction>();
+        sampler.maxAnisotropy = static_cast<uint16_t>(reader.u32());
+        sampler.label = reader.str();
+    }
+
+    if (!resizeChecked(reader, capture.shaders, reader.u32())) {
+        return false;
+    }
+    for (auto& shader : capture.shaders) {
+        shader.stage = reader.enumValue<ShaderStage>();
+        shader.entryPoint = reader.str();
+        shader.debugName = reader.str();
+        shader.code = reader.str();
+        shader.spirv = readIds(reader);
+    }
+
+    if (!resizeChecked(reader, capture.bindGroupLayouts, reader.u32())) {
+        return false;
+    }
+    for (auto& layout : capture.bindGroupLayouts) {
+        if (!resizeChecked(reader, layout.entries, reader.u32())) {
+            return false;
+        }
+        for (auto& entry : layout.entries) {
+            entry.binding = reader.u32();
+            entry.visibility = reader.enumValue<ShaderStage>();
+            entry.type = reader.enumValue<BindingType>();
+            entry.hasDynamicOffset = reader.u32() != 0;
+            entry.minBindingSize = reader.u64();
+            entry.sampleType = reader.enumValue<TextureSampleType>();
+            entry.viewDimension = reader.enumValue<TextureViewDimension>();
+            entry.multisampled = reader.u32() != 0;
+            entry.storageTextureFormat = reader.enumValue<TextureFormat>();
+            entry.count = reader.u32();
+        }
+        layout.debugName = reader.str();
+    }
+
+    if (!resizeChecked(reader, capture.pipelineLayouts, reader.u32())) {
+        return false;
+    }
+    for (auto& layout : capture.pipelineLayouts) {
+        layout.bindGroupLayouts = readIds(reader);
+        if (!resizeChecked(reader, layout.pushConstantRanges, reader.u32())) {
+            return false;
+        }
+        for (auto& range : layout.pushConstantRanges) {
+            range.stages = reader.enumValue<ShaderStage>();
+            range.offset = reader.u32();
+            range.size = reader.u32();
+        }
+        layout.debugName = reader.str();
+    }
+
+    if (!resizeChecked(reader, capture.pipelines, reader.u32())) {
+        return false;
+    }
+    for (auto& pipeline : capture.pipelines) {
+        pipeline.vertex = reader.u32();
+        pipeline.fragment = reader.u32();
+        pipeline.layout = reader.u32();
+        readPipelineState(reader, pipeline.state);
+    }
+
+    if (!resizeChecked(reader, capture.bindGroups, reader.u32())) {
+        return false;
+    }
+    for (auto& group : capture.bindGroups) {
+        group.layout = reader.u32();
+        if (!resizeChecked(reader, group.entries, reader.u32())) {
+            return false;
+        }
+        for (auto& entry : group.entries) {
+            entry.binding = reader.u32();
+            entry.buffer = reader.u32();
+            entry.offset = reader.u64();
+            entry.size = reader.u64();
+            entry.textureView = reader.u32();
+            entry.sampler = reader.u32();
+            entry.buffers = readIds(reader);
+            entry.textureViews = readIds(reader);
+            entry.samplers = readIds(reader);
+        }
+        group.debugName = reader.str();
+    }
+
+    capture.commandCount = reader.u32();
+    capture.encoderCount = reader.u32();
+    capture.passCount = reader.u32();
+    capture.skippedCommands = reader.u32();
+    const auto commandBytes = reader.bytes();
+    capture.commands.assign(commandBytes.begin(), commandBytes.end());
+
+    if (!reader.ok()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "FrameCapture", PERS_SOURCE_LOC,
+            "Capture %s is truncated or corrupt", path.c_str());
+        return false;
+    }
+
+    *this = std::move(capture);
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,253 @@
+#include "pers/graphics/FrameGrabber.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
+#include "pers/utils/PngWriter.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+bool isSupportedFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::RGBA16Float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint8_t halfToUnorm8(uint16_t half) {
+    const uint32_t sign = half >> 15;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+    if (sign || exponent == 0) {
+        return 0;  // Negatives clamp to 0, denormals round to 0
+    }
+    if (exponent >= 15) {
+        return 255;  // >= 1.0, infinity and NaN
+    }
+    const float value = (1.0f + mantissa / 1024.0f) / static_cast<float>(1u << (15 - exponent));
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+// In place for 4-byte texels, into rgba for RGBA16Float
+void convertToRgba8(TextureFormat format, std::vector<uint8_t>& pixels, std::vector<uint8_t>& rgba,
+                    size_t pixelCount, bool opaque) {
+    if (format == TextureFormat::RGBA16Float) {
+        rgba.resize(pixelCount * 4);
+        const auto* src = reinterpret_cast<const uint16_t*>(pixels.data());
+        for (size_t i = 0; i < pixelCount * 4; ++i) {
+            rgba[i] = halfToUnorm8(src[i]);
+        }
+    } else {
+        rgba.swap(pixels);
+        if (format == TextureFormat::BGRA8Unorm || format == TextureFormat::BGRA8UnormSrgb) {
+            for (size_t i = 0; i < pixelCount; ++i) {
+                std::swap(rgba[i * 4], rgba[i * 4 + 2]);
+            }
+        }
+    }
+
+    if (opaque) {
+        for (size_t i = 0; i < pixelCount; ++i) {
+            rgba[i * 4 + 3] = 255;
+        }
+    }
+}
+
+} // anonymous namespace
+
+FrameGrabber::FrameGrabber(const std::shared_ptr<ILogicalDevice>& device, JobSystem& jobs, FrameGrabberDesc desc)
+    : _jobs(jobs)
+    , _desc(std::move(desc)) {
+    if (!isSupportedFormat(_desc.format)) {
+        LOG_ERROR("FrameGrabber", "Unsupported capture format");
+        return;
+    }
+
+    if (_desc.maxWidth == 0 || _desc.maxHeight == 0) {
+        LOG_ERROR("FrameGrabber", "Maximum capture size must be non-zero");
+        return;
+    }
+
+    const uint64_t slotSize = static_cast<uint64_t>(getTextureReadbackRowPitch(_desc.format, _desc.maxWidth)) *
+                              _desc.maxHeight;
+    _ring = std::make_unique<ReadbackRing>(device, slotSize, _desc.slotCount, "FrameGrabber");
+    if (_ring->getSlotCount() == 0) {
+        _ring.reset();
+    }
+}
+
+FrameGrabber::~FrameGrabber() {
+    flush();
+}
+
+bool FrameGrabber::isValid() const {
+    return _ring != nullptr;
+}
+
+bool FrameGrabber::capture(const std::shared_ptr<ICommandEncoder>& encoder, const std::shared_ptr<ITexture>& texture,
+                           uint64_t frameIndex) {
+    PERS_PROFILE_SCOPE("FrameGrabber::capture");
+    if (!_ring || !texture) {
+        return false;
+    }
+
+    if (!isSupportedFormat(texture->getFormat())) {
+        LOG_ERROR("FrameGrabber", "Texture format cannot be captured");
+        return false;
+    }
+
+    PendingCapture pending;
+    pending.frameIndex = frameIndex;
+    pending.width = texture->getWidth();
+    pending.height = texture->getHeight();
+    pending.bytesPerRow = getTextureReadbackRowPitch(texture->getFormat(), pending.width);
+    pending.format = texture->getFormat();
+
+    TextureReadbackDesc desc;
+    desc.bytesPerRow = pending.bytesPerRow;
+    pending.ticket = _ring->enqueueTexture(encoder, texture, desc);
+    if (pending.ticket == 0) {
+        return false;
+    }
+
+    _pending.push_back(pending);
+    return true;
+}
+
+void FrameGrabber::submitted() {
+    if (_ring) {
+        _ring->submitted();
+    }
+}
+
+uint32_t FrameGrabber::poll() {
+    PERS_PROFILE_SCOPE("FrameGrabber::poll");
+    if (!_ring) {
+        return 0;
+    }
+
+    std::erase_if(_encodeJobs, [](const JobHandle& job) { return job.isComplete(); });
+
+    uint32_t scheduled = 0;
+    _ring->harvest([&](uint64_t ticket, const void* data, uint64_t) {
+        // Tickets of failed maps are skipped by the ring
+        while (!_pending.empty() && _pending.front().ticket < ticket) {
+            _pending.pop_front();
+        }
+        if (_pending.empty() || _pending.front().ticket != ticket) {
+            return;
+        }
+        PendingCapture pending = _pending.front();
+        _pending.pop_front();
+
+        if (_encodeJobs.size() >= _desc.maxPendingEncodes) {
+            ++_droppedEncodes;
+            return;
+        }
+
+        // The mapping is only valid inside the callback; strip the row padding now
+        const size_t rowBytes = static_cast<size_t>(pending.width) * getTextureFormatBlockInfo(pending.format).blockBytes;
+        std::vector<uint8_t> pixels = takeBuffer();
+        pixels.resize(rowBytes * pending.height);
+        const auto* src = static_cast<const uint8_t*>(data);
+        for (uint32_t y = 0; y < pending.height; ++y) {
+            copyFromMappedMemory(pixels.data() + y * rowBytes, src + static_cast<size_t>(y) * pending.bytesPerRow, rowBytes);
+        }
+
+        const uint64_t sequence = _nextSequence++;
+        _encodeJobs.push_back(_jobs.schedule(
+            [this, sequence, pending, pixels = std::move(pixels)]() mutable {
+                encode(sequence, pending, std::move(pixels));
+            }));
+        ++scheduled;
+    });
+
+    return scheduled;
+}
+
+void FrameGrabber::flush() {
+    for (const JobHandle& job : _encodeJobs) {
+        _jobs.wait(job);
+    }
+    _encodeJobs.clear();
+}
+
+uint64_t FrameGrabber::getDroppedCount() const {
+    return _droppedEncodes + (_ring ? _ring->getDroppedCount() : 0);
+}
+
+void FrameGrabber::encode(uint64_t sequence, PendingCapture capture, std::vector<uint8_t> pixels) {
+    PERS_PROFILE_SCOPE("FrameGrabber::encode");
+    CapturedFrame frame;
+    frame.frameIndex = capture.frameIndex;
+    frame.width = capture.width;
+    frame.height = capture.height;
+    frame.encoding = _desc.encoding;
+
+    const size_t pixelCount = static_cast<size_t>(capture.width) * capture.height;
+    std::vector<uint8_t> rgba = takeBuffer();
+    convertToRgba8(capture.format, pixels, rgba, pixelCount, _desc.opaque);
+
+    if (_desc.encoding == FrameEncoding::Png) {
+        frame.data = takeBuffer();
+        if (!encodePng(rgba.data(), capture.width, capture.height, 4, 0, frame.data)) {
+            LOG_ERROR("FrameGrabber", "Failed to encode frame");
+            frame.data.clear();
+        }
+        recycleBuffer(std::move(rgba));
+    } else {
+        frame.data = std::move(rgba);
+    }
+    recycleBuffer(std::move(pixels));
+
+    deliver(sequence, std::move(frame));
+}
+
+void FrameGrabber::deliver(uint64_t sequence, CapturedFrame frame) {
+    std::lock_guard<std::mutex> lock(_deliveryMutex);
+    _completed.emplace(sequence, std::move(frame));
+    while (!_completed.empty() && _completed.begin()->first == _nextDelivery) {
+        auto it = _completed.begin();
+        if (_desc.onFrame) {
+            _desc.onFrame(it->second);
+        }
+        recycleBuffer(std::move(it->second.data));
+        _completed.erase(it);
+        ++_nextDelivery;
+        _capturedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::vector<uint8_t> FrameGrabber::takeBuffer() {
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    if (_freeBuffers.empty()) {
+        return {};
+    }
+    std::vector<uint8_t> buffer = std::move(_freeBuffers.back());
+    _freeBuffers.pop_back();
+    return buffer;
+}
+
+void FrameGrabber::recycleBuffer(std::vector<uint8_t> buffer) {
+    if (buffer.capacity() == 0) {
+        return;
+    }
+    buffer.clear();
+    std::lock_guard<std::mutex> lock(_poolMutex);
+    _freeBuffers.push_back(std::move(buffer));
+}
+
+} // namespace pers
@@ -0,0 +1,646 @@
+#include "pers/graphics/FrameReplayer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <numeric>
+
+namespace pers {
+
+namespace {
+
+const DeviceBufferUsage DEVICE_USAGE_MASK = DeviceBufferUsage::Vertex | DeviceBufferUsage::Index |
+    DeviceBufferUsage::Uniform | DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc |
+    DeviceBufferUsage::Indirect | DeviceBufferUsage::QueryResolve;
+
+template<typename T>
+std::shared_ptr<T> lookupShared(const std::vector<std::shared_ptr<T>>& objects, uint32_t id) {
+    return id < objects.size() ? objects[id] : nullptr;
+}
+
+FrameReplayer::Timing summarize(std::vector<double> samples) {
+    FrameReplayer::Timing timing;
+    if (samples.empty()) {
+        return timing;
+    }
+    std::sort(samples.begin(), samples.end());
+    timing.minMs = samples.front();
+    timing.maxMs = samples.back();
+    timing.medianMs = samples[samples.size() / 2];
+    timing.meanMs = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    return timing;
+}
+
+double millisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+FrameReplayer::FrameReplayer(const std::shared_ptr<ILogicalDevice>& device)
+    : _device(device) {
+}
+
+FrameReplayer::~FrameReplayer() = default;
+
+bool FrameReplayer::prepare(const FrameCapture& capture) {
+    _prepared = false;
+    _ops.clear();
+    _payloads.clear();
+    _passes.clear();
+    _idLists.clear();
+
+    if (!createResources(capture)) {
+        return false;
+    }
+    if (!decode(capture)) {
+        LOG_ERROR("FrameReplayer", "Capture command stream is malformed");
+        return false;
+    }
+    _prepared = true;
+    return true;
+}
+
+bool FrameReplayer::createResources(const FrameCapture& capture) {
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("FrameReplayer", "Device was destroyed");
+        return false;
+    }
+    const auto& factory = device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("FrameReplayer", "Device has no resource factory");
+        return false;
+    }
+
+    _buffers.assign(capture.buffers.size(), nullptr);
+    _initialContents.assign(capture.buffers.size(), {});
+    for (size_t i = 0; i < capture.buffers.size(); ++i) {
+        const CapturedBuffer& record = capture.buffers[i];
+        // Every replayed buffer is a DeviceBuffer; mapping usages have no
+        // meaning without the application, and CopyDst is always added
+        auto buffer = std::make_shared<DeviceBuffer>();
+        const uint64_t size = std::max<uint64_t>((record.size + 3) & ~uint64_t(3), 4);
+        const auto usage = static_cast<DeviceBufferUsage>(record.usage) & DEVICE_USAGE_MASK;
+        if (!buffer->create(size, usage, device, record.debugName)) {
+            LOG_WARNING("FrameReplayer", "Failed to create buffer " + record.debugName);
+            continue;
+        }
+        _buffers[i] = std::move(buffer);
+        _initialContents[i] = record.contents;
+    }
+
+    _textures.assign(capture.textures.size(), nullptr);
+    _views.assign(capture.textures.size(), nullptr);
+    for (size_t i = 0; i < capture.textures.size(); ++i) {
+        const CapturedTexture& record = capture.textures[i];
+        const bool cube = record.dimension == TextureViewDimension::Cube ||
+                          record.dimension == TextureViewDimension::CubeArray;
+
+        TextureDesc desc;
+        desc.dimension = record.dimension == TextureViewDimension::D3 ? TextureDimension::D3
+                       : record.dimension == TextureViewDimension::D1 ? TextureDimension::D1
+                       : TextureDimension::D2;
+        desc.width = record.width;
+        desc.height = record.height;
+        desc.depthOrArrayLayers = cube ? 6 : 1;
+        desc.sampleCount = record.sampleCount;
+        desc.format = record.format;
+        desc.usage = record.usage == TextureUsage::None ? TextureUsage::TextureBinding : record.usage;
+        auto texture = factory->createTexture(desc);
+        if (!texture) {
+            LOG_WARNING("FrameReplayer", "Failed to create texture");
+            continue;
+        }
+
+        TextureViewDesc viewDesc;
+        viewDesc.format = record.format;
+        viewDesc.dimension = record.dimension;
+        viewDesc.arrayLayerCount = desc.depthOrArrayLayers;
+        _views[i] = factory->createTextureView(texture, viewDesc);
+        _textures[i] = std::move(texture);
+    }
+
+    _samplers.assign(capture.samplers.size(), nullptr);
+    for (size_t i = 0; i < capture.samplers.size(); ++i) {
+        _samplers[i] = factory->createSampler(capture.samplers[i]);
+    }
+
+    _shaders.assign(capture.shaders.size(), nullptr);
+    for (size_t i = 0; i < capture.shaders.size(); ++i) {
+        const CapturedShader& record = capture.shaders[i];
+        ShaderModuleDesc desc;
+        desc.code = record.code;
+        desc.spirv = record.spirv;
+        desc.stage = record.stage;
+        desc.entryPoint = record.entryPoint;
+        desc.debugName = record.debugName;
+        _shaders[i] = factory->createShaderModule(desc);
+    }
+
+    _bindGroupLayouts.assign(capture.bindGroupLayouts.size(), nullptr);
+    for (size_t i = 0; i < capture.bindGroupLayouts.size(); ++i) {
+        _bindGroupLayouts[i] = factory->createBindGroupLayout(capture.bindGroupLayouts[i]);
+    }
+
+    _pipelineLayouts.assign(capture.pipelineLayouts.size(), nullptr);
+    for (size_t i = 0; i < capture.pipelineLayouts.size(); ++i) {
+        PipelineLayoutDesc desc;
+        desc.debugName = capture.pipelineLayouts[i].debugName;
+        for (uint32_t id : capture.pipelineLayouts[i].bindGroupLayouts) {
+            desc.bindGroupLayouts.push_back(lookupShared(_bindGroupLayouts, id));
+        }
+        desc.pushConstantRanges = capture.pipelineLayouts[i].pushConstantRanges;
+        _pipelineLayouts[i] = factory->createPipelineLayout(desc);
+    }
+
+    _pipelines.assign(capture.pipelines.size(), nullptr);
+    for (size_t i = 0; i < capture.pipelines.size(); ++i) {
+        const CapturedRenderPipeline& record = capture.pipelines[i];
+        RenderPipelineDesc desc = record.state;
+        desc.vertex = lookupShared(_shaders, record.vertex);
+        desc.fragment = lookupShared(_shaders, record.fragment);
+        desc.layout = lookupShared(_pipelineLayouts, record.layout);
+        if (!desc.vertex) {
+            LOG_WARNING("FrameReplayer", "Pipeline has no vertex shader, its draws are skipped");
+            continue;
+        }
+        _pipelines[i] = factory->createRenderPipeline(desc);
+    }
+
+    _bindGroups.assign(capture.bindGroups.size(), nullptr);
+    for (size_t i = 0; i < capture.bindGroups.size(); ++i) {
+        const CapturedBindGroup& record = capture.bindGroups[i];
+        BindGroupDesc desc;
+        desc.layout = lookupShared(_bindGroupLayouts, record.layout);
+        desc.debugName = record.debugName;
+        for (const auto& captured : record.entries) {
+            BindGroupEntry entry;
+            entry.binding = captured.binding;
+            entry.buffer = lookupShared(_buffers, captured.buffer);
+            entry.offset = captured.offset;
+            entry.size = captured.size;
+            entry.textureView = lookupShared(_views, captured.textureView);
+            entry.sampler = lookupShared(_samplers, captured.sampler);
+            for (uint32_t id : captured.buffers) {
+                entry.buffers.push_back(lookupShared(_buffers, id));
+            }
+            for (uint32_t id : captured.textureViews) {
+                entry.textureViews.push_back(lookupShared(_views, id));
+            }
+            for (uint32_t id : captured.samplers) {
+                entry.samplers.push_back(lookupShared(_samplers, id));
+            }
+            desc.entries.push_back(std::move(entry));
+        }
+        if (desc.layout) {
+            _bindGroups[i] = factory->createBindGroup(desc);
+        }
+    }
+    return true;
+}
+
+bool FrameReplayer::decode(const FrameCapture& capture) {
+    detail::CaptureReader reader(capture.commands);
+    _encoderCount = capture.encoderCount;
+    _passCount = capture.passCount;
+
+    auto encoderId = [&]() {
+        const uint32_t id = reader.u32();
+        if (id >= _encoderCount) {
+            reader.fail();
+        }
+        return id;
+    };
+    auto passId = [&]() {
+        const uint32_t id = reader.u32();
+        if (id >= _passCount) {
+            reader.fail();
+        }
+        return id;
+    };
+    auto payload = [&]() {
+        auto bytes = reader.bytes();
+        _payloads.emplace_back(bytes.begin(), bytes.end());
+        return static_cast<uint32_t>(_payloads.size() - 1);
+    };
+    auto idList = [&](uint32_t count) {
+        if (count > reader.remaining() / sizeof(uint32_t)) {
+            reader.fail();
+            count = 0;
+        }
+        std::vector<uint32_t> ids(count);
+        for (auto& id : ids) {
+            id = reader.u32();
+        }
+        _idLists.push_back(std::move(ids));
+        return static_cast<uint32_t>(_idLists.size() - 1);
+    };
+
+    for (uint32_t i = 0; i < capture.commandCount && reader.ok(); ++i) {
+        Op op;
+        op.command = static_cast<CaptureCommand>(reader.u8());
+        switch (op.command) {
+        case CaptureCommand::WriteBuffer:
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.extra = payload();
+            break;
+        case CaptureCommand::BeginEncoder:
+        case CaptureCommand::Finish:
+            op.target = encoderId();
+            break;
+        case CaptureCommand::UploadBuffer:
+            op.target = encoderId();
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.extra = payload();
+            break;
+        case CaptureCommand::CopyBuffer:
+            op.target = encoderId();
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.ids[1] = reader.u32();
+            op.values[1] = reader.u64();
+            op.values[2] = reader.u64();
+            break;
+        case CaptureCommand::BeginRenderPass: {
+            op.ids[0] = encoderId();
+            op.target = passId();
+            RenderPassDesc desc;
+            const uint32_t colorCount = reader.u32();
+            if (colorCount > 8) {
+                reader.fail();
+                break;
+            }
+            for (uint32_t color = 0; color < colorCount; ++color) {
+                RenderPassColorAttachment attachment;
+                attachment.view = lookupShared(_views, reader.u32());
+                attachment.resolveTarget = lookupShared(_views, reader.u32());
+                attachment.loadOp = reader.enumValue<LoadOp>();
+                attachment.storeOp = reader.enumValue<StoreOp>();
+                attachment.clearColor.r = reader.f32();
+                attachment.clearColor.g = reader.f32();
+                attachment.clearColor.b = reader.f32();
+                attachment.clearColor.a = reader.f32();
+                desc.colorAttachments.push_back(std::move(attachment));
+            }
+            const uint32_t depthView = reader.u32();
+            if (depthView != CAPTURE_NONE) {
+                auto depth = std::make_shared<RenderPassDepthStencilAttachment>();
+                depth->view = lookupShared(_views, depthView);
+                depth->depthLoadOp = reader.enumValue<LoadOp>();
+                depth->depthStoreOp = reader.enumValue<StoreOp>();
+                depth->depthClearValue = reader.f32();
+                depth->depthReadOnly = reader.u32() != 0;
+                depth->stencilLoadOp = reader.enumValue<LoadOp>();
+                depth->stencilStoreOp = reader.enumValue<StoreOp>();
+                depth->stencilClearValue = reader.u32();
+                depth->stencilReadOnly = reader.u32() != 0;
+                desc.depthStencilAttachment = std::move(depth);
+            }
+            desc.label = reader.str();
+            _passes.push_back(std::move(desc));
+            op.extra = static_cast<uint32_t>(_passes.size() - 1);
+            break;
+        }
+        case CaptureCommand::SetPipeline:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            break;
+        case CaptureCommand::SetBindGroup:
+            op.target = passId();
+            op.ids[0] = reader.u32();  // Group index
+            op.ids[1] = reader.u32();
+            op.extra = idList(reader.u32());
+            break;
+        case CaptureCommand::SetVertexBuffer:
+            op.target = passId();
+            op.ids[0] = reader.u32();  // Slot
+            op.ids[1] = reader.u32();
+            op.values[0] = reader.u64();
+            op.values[1] = reader.u64();
+            break;
+        case CaptureCommand::SetIndexBuffer:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            op.ids[1] = reader.u32();  // IndexFormat
+            op.values[0] = reader.u64();
+            op.values[1] = reader.u64();
+            break;
+        case CaptureCommand::SetViewport:
+            op.target = passId();
+            for (auto& value : op.ids) {
+                value = std::bit_cast<uint32_t>(reader.f32());  // x, y, width, height
+            }
+            op.values[0] = std::bit_cast<uint32_t>(reader.f32());  // minDepth
+            op.values[1] = std::bit_cast<uint32_t>(reader.f32());  // maxDepth
+            break;
+        case CaptureCommand::SetScissorRect:
+            op.target = passId();
+            for (auto& value : op.ids) {
+                value = reader.u32();
+            }
+            break;
+        case CaptureCommand::SetStencilReference:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            break;
+        case CaptureCommand::SetBlendConstant:
+            op.target = passId();
+            for (auto& value : op.ids) {
+                value = std::bit_cast<uint32_t>(reader.f32());
+            }
+            break;
+        case CaptureCommand::SetPushConstants:
+            op.target = passId();
+            op.ids[0] = reader.u32();  // ShaderStage
+            op.ids[1] = reader.u32();  // offset
+            op.extra = payload();
+            break;
+        case CaptureCommand::Draw:
+            op.target = passId();
+            for (auto& value : op.ids) {
+                value = reader.u32();
+            }
+            break;
+        case CaptureCommand::DrawIndexed:
+            op.target = passId();
+            op.ids[0] = reader.u32();  // indexCount
+            op.ids[1] = reader.u32();  // instanceCount
+            op.ids[2] = reader.u32();  // firstIndex
+            op.values[0] = static_cast<uint64_t>(static_cast<int64_t>(reader.i32()));  // baseVertex
+            op.ids[3] = reader.u32();  // firstInstance
+            break;
+        case CaptureCommand::DrawIndirect:
+        case CaptureCommand::DrawIndexedIndirect:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.ids[1] = 1;
+            break;
+        case CaptureCommand::MultiDrawIndirect:
+        case CaptureCommand::MultiDrawIndexedIndirect:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.ids[1] = reader.u32();  // drawCount
+            break;
+        case CaptureCommand::MultiDrawIndirectCount:
+        case CaptureCommand::MultiDrawIndexedIndirectCount:
+            op.target = passId();
+            op.ids[0] = reader.u32();
+            op.values[0] = reader.u64();
+            op.ids[1] = reader.u32();  // maxDrawCount
+            op.ids[2] = reader.u32();  // count buffer
+            op.values[1] = reader.u64();
+            break;
+        case CaptureCommand::EndRenderPass:
+            op.target = passId();
+            break;
+        case CaptureCommand::Submit: {
+            op.extra = idList(reader.u32());
+            for (uint32_t encoder : _idLists.back()) {
+                if (encoder >= _encoderCount) {
+                    reader.fail();
+                }
+            }
+            break;
+        }
+        default:
+            reader.fail();
+            break;
+        }
+        _ops.push_back(op);
+    }
+    return reader.ok() && reader.atEnd();
+}
+
+void FrameReplayer::resetBuffers() {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        return;
+    }
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        if (_buffers[i] && !_initialContents[i].empty()) {
+            queue->writeBuffer(_buffers[i], 0, _initialContents[i]);
+        }
+    }
+}
+
+uint32_t FrameReplayer::replayOnce() {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        return 0;
+    }
+
+    std::vector<std::shared_ptr<ICommandEncoder>> encoders(_encoderCount);
+    std::vector<std::shared_ptr<ICommandBuffer>> commandBuffers(_encoderCount);
+    std::vector<std::shared_ptr<IRenderPassEncoder>> passes(_passCount);
+    std::vector<bool> hasPipeline(_passCount, false);
+    std::vector<std::shared_ptr<ICommandBuffer>> submission;
+    uint32_t skippedDraws = 0;
+
+    for (const Op& op : _ops) {
+        switch (op.command) {
+        case CaptureCommand::WriteBuffer:
+        case CaptureCommand::UploadBuffer:
+            if (auto buffer = lookupShared(_buffers, op.ids[0])) {
+                queue->writeBuffer(buffer, op.values[0], _payloads[op.extra]);
+            }
+            break;
+        case CaptureCommand::BeginEncoder:
+            encoders[op.target] = device->createCommandEncoder();
+            break;
+        case CaptureCommand::CopyBuffer: {
+            auto source = std::dynamic_pointer_cast<DeviceBuffer>(lookupShared(_buffers, op.ids[0]));
+            auto destination = std::dynamic_pointer_cast<DeviceBuffer>(lookupShared(_buffers, op.ids[1]));
+            if (encoders[op.target] && source && destination) {
+                encoders[op.target]->copyDeviceToDevice(source, destination,
+                                                        BufferCopyDesc{op.values[0], op.values[1], op.values[2]});
+            }
+            break;
+        }
+        case CaptureCommand::BeginRenderPass:
+            if (encoders[op.ids[0]]) {
+                passes[op.target] = encoders[op.ids[0]]->beginRenderPass(_passes[op.extra]);
+            }
+            hasPipeline[op.target] = false;
+            break;
+        case CaptureCommand::SetPipeline:
+            hasPipeline[op.target] = false;
+            if (const auto& pass = passes[op.target]) {
+                if (auto pipeline = lookupShared(_pipelines, op.ids[0])) {
+                    pass->setPipeline(pipeline);
+                    hasPipeline[op.target] = true;
+                }
+            }
+            break;
+        case CaptureCommand::SetBindGroup:
+            if (const auto& pass = passes[op.target]) {
+                if (auto group = lookupShared(_bindGroups, op.ids[1])) {
+                    pass->setBindGroup(op.ids[0], group, _idLists[op.extra]);
+                }
+            }
+            break;
+        case CaptureCommand::SetVertexBuffer:
+            if (const auto& pass = passes[op.target]) {
+                pass->setVertexBuffer(op.ids[0], lookupShared(_buffers, op.ids[1]), op.values[0], op.values[1]);
+            }
+            break;
+        case CaptureCommand::SetIndexBuffer:
+            if (const auto& pass = passes[op.target]) {
+                if (auto buffer = lookupShared(_buffers, op.ids[0])) {
+                    pass->setIndexBuffer(buffer, static_cast<IndexFormat>(op.ids[1]), op.values[0], op.values[1]);
+                }
+            }
+            break;
+        case CaptureCommand::SetViewport:
+            if (const auto& pass = passes[op.target]) {
+                auto toFloat = [](uint64_t bits) { return std::bit_cast<float>(static_cast<uint32_t>(bits)); };
+                pass->setViewport(toFloat(op.ids[0]), toFloat(op.ids[1]), toFloat(op.ids[2]), toFloat(op.ids[3]),
+                                  toFloat(op.values[0]), toFloat(op.values[1]));
+            }
+            break;
+        case CaptureCommand::SetScissorRect:
+            if (const auto& pass = passes[op.target]) {
+                pass->setScissorRect(op.ids[0], op.ids[1], op.ids[2], op.ids[3]);
+            }
+            break;
+        case CaptureCommand::SetStencilReference:
+            if (const auto& pass = passes[op.target]) {
+                pass->setStencilReference(op.ids[0]);
+            }
+            break;
+        case CaptureCommand::SetBlendConstant:
+            if (const auto& pass = passes[op.target]) {
+                pass->setBlendConstant(Color{std::bit_cast<float>(op.ids[0]), std::bit_cast<float>(op.ids[1]),
+                                             std::bit_cast<float>(op.ids[2]), std::bit_cast<float>(op.ids[3])});
+            }
+            break;
+        case CaptureCommand::SetPushConstants:
+            if (const auto& pass = passes[op.target]) {
+                pass->setPushConstants(static_cast<ShaderStage>(op.ids[0]), op.ids[1], _payloads[op.extra]);
+            }
+            break;
+        case CaptureCommand::Draw:
+            if (passes[op.target] && hasPipeline[op.target]) {
+                passes[op.target]->draw(op.ids[0], op.ids[1], op.ids[2], op.ids[3]);
+            } else {
+                ++skippedDraws;
+            }
+            break;
+        case CaptureCommand::DrawIndexed:
+            if (passes[op.target] && hasPipeline[op.target]) {
+                passes[op.target]->drawIndexed(op.ids[0], op.ids[1], op.ids[2],
+                                               static_cast<int32_t>(op.values[0]), op.ids[3]);
+            } else {
+                ++skippedDraws;
+            }
+            break;
+        case CaptureCommand::DrawIndirect:
+        case CaptureCommand::DrawIndexedIndirect:
+        case CaptureCommand::MultiDrawIndirect:
+        case CaptureCommand::MultiDrawIndexedIndirect: {
+            auto buffer = lookupShared(_buffers, op.ids[0]);
+            const auto& pass = passes[op.target];
+            if (!pass || !hasPipeline[op.target] || !buffer) {
+                ++skippedDraws;
+            } else if (op.command == CaptureCommand::DrawIndirect) {
+                pass->drawIndirect(buffer, op.values[0]);
+            } else if (op.command == CaptureCommand::DrawIndexedIndirect) {
+                pass->drawIndexedIndirect(buffer, op.values[0]);
+            } else if (op.command == CaptureCommand::MultiDrawIndirect) {
+                pass->multiDrawIndirect(buffer, op.values[0], op.ids[1]);
+            } else {
+                pass->multiDrawIndexedIndirect(buffer, op.values[0], op.ids[1]);
+            }
+            break;
+        }
+        case CaptureCommand::MultiDrawIndirectCount:
+        case CaptureCommand::MultiDrawIndexedIndirectCount: {
+            auto buffer = lookupShared(_buffers, op.ids[0]);
+            auto countBuffer = lookupShared(_buffers, op.ids[2]);
+            const auto& pass = passes[op.target];
+            if (!pass || !hasPipeline[op.target] || !buffer || !countBuffer) {
+                ++skippedDraws;
+            } else if (op.command == CaptureCommand::MultiDrawIndirectCount) {
+                pass->multiDrawIndirectCount(buffer, op.values[0], countBuffer, op.values[1], op.ids[1]);
+            } else {
+                pass->multiDrawIndexedIndirectCount(buffer, op.values[0], countBuffer, op.values[1], op.ids[1]);
+            }
+            break;
+        }
+        case CaptureCommand::EndRenderPass:
+            if (passes[op.target]) {
+                passes[op.target]->end();
+                passes[op.target].reset();
+            }
+            break;
+        case CaptureCommand::Finish:
+            if (encoders[op.target]) {
+                commandBuffers[op.target] = encoders[op.target]->finish();
+                encoders[op.target].reset();
+            }
+            break;
+        case CaptureCommand::Submit:
+            submission.clear();
+            for (uint32_t encoder : _idLists[op.extra]) {
+                if (commandBuffers[encoder]) {
+                    submission.push_back(std::move(commandBuffers[encoder]));
+                }
+            }
+            if (!submission.empty()) {
+                queue->submit(submission);
+            }
+            break;
+        }
+    }
+    return skippedDraws;
+}
+
+bool FrameReplayer::replay(uint32_t iterations, Stats& stats) {
+    auto device = _device.lock();
+    if (!_prepared || !device || iterations == 0) {
+        LOG_ERROR("FrameReplayer", "Nothing to replay");
+        return false;
+    }
+
+    std::vector<double> encodeSamples;
+    std::vector<double> frameSamples;
+    encodeSamples.reserve(iterations);
+    frameSamples.reserve(iterations);
+
+    stats = Stats{};
+    for (uint32_t i = 0; i < iterations; ++i) {
+        // Restore the captured state outside of the timed region
+        resetBuffers();
+        device->waitIdle();
+
+        const auto start = std::chrono::steady_clock::now();
+        stats.skippedDraws = replayOnce();
+        encodeSamples.push_back(millisecondsSince(start));
+        device->waitIdle();
+        frameSamples.push_back(millisecondsSince(start));
+    }
+
+    stats.iterations = iterations;
+    stats.encode = summarize(std::move(encodeSamples));
+    stats.frame = summarize(std::move(frameSamples));
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,183 @@
+#include "pers/graphics/GlyphAtlas.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pers {
+
+namespace {
+
+constexpr float FAR_DISTANCE = 1e20f;
+
+TextureAtlas::Config makeAtlasConfig(const GlyphAtlas::Config& config) {
+    TextureAtlas::Config atlas = config.atlas;
+    if (atlas.format != TextureFormat::R8Unorm) {
+        LOG_WARNING("GlyphAtlas", "Distance fields are single-channel, using R8Unorm");
+        atlas.format = TextureFormat::R8Unorm;
+    }
+    return atlas;
+}
+
+// Squared distance transform of one row or column (Felzenszwalb and Huttenlocher):
+// the lower envelope of parabolas rooted at every sample
+void distanceTransform1D(const float* f, float* d, uint32_t n, std::vector<uint32_t>& v, std::vector<float>& z) {
+    constexpr float INF = std::numeric_limits<float>::infinity();
+    v.resize(n);
+    z.resize(n + 1);
+    auto intersect = [f](uint32_t q, uint32_t p) {
+        const float fq = f[q] + static_cast<float>(q) * static_cast<float>(q);
+        const float fp = f[p] + static_cast<float>(p) * static_cast<float>(p);
+        return (fq - fp) / (2.0f * (static_cast<float>(q) - static_cast<float>(p)));
+    };
+
+    uint32_t k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (uint32_t q = 1; q < n; ++q) {
+        float s = intersect(q, v[k]);
+        while (s <= z[k]) {
+            --k;  // z[0] is -inf, so k never underflows
+            s = intersect(q, v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+
+    k = 0;
+    for (uint32_t q = 0; q < n; ++q) {
+        while (z[k + 1] < static_cast<float>(q)) {
+            ++k;
+        }
+        const float offset = static_cast<float>(q) - static_cast<float>(v[k]);
+        d[q] = offset * offset + f[v[k]];
+    }
+}
+
+// Squared distance from every texel to the nearest texel where inside matches target
+std::vector<float> distanceTransform(const std::vector<uint8_t>& inside, uint32_t width, uint32_t height, bool target) {
+    std::vector<float> grid(inside.size());
+    for (size_t i = 0; i < inside.size(); ++i) {
+        grid[i] = (inside[i] != 0) == target ? 0.0f : FAR_DISTANCE;
+    }
+
+    const uint32_t longest = std::max(width, height);
+    std::vector<float> f(longest);
+    std::vector<float> d(longest);
+    std::vector<uint32_t> v;
+    std::vector<float> z;
+
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t y = 0; y < height; ++y) {
+            f[y] = grid[y * width + x];
+        }
+        distanceTransform1D(f.data(), d.data(), height, v, z);
+        for (uint32_t y = 0; y < height; ++y) {
+            grid[y * width + x] = d[y];
+        }
+    }
+    for (uint32_t y = 0; y < height; ++y) {
+        distanceTransform1D(&grid[y * width], d.data(), width, v, z);
+        std::copy_n(d.data(), width, &grid[y * width]);
+    }
+    return grid;
+}
+
+} // anonymous namespace
+
+GlyphAtlas::GlyphAtlas(const std::shared_ptr<ILogicalDevice>& device,
+                       const std::shared_ptr<IGlyphRasterizer>& rasterizer, const Config& config)
+    : _rasterizer(rasterizer)
+    , _config(config)
+    , _atlas(device, makeAtlasConfig(config)) {
+    if (!rasterizer) {
+        LOG_ERROR("GlyphAtlas", "Glyph rasterizer is null");
+        return;
+    }
+    _metrics = rasterizer->getMetrics(config.pixelSize);
+}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+const GlyphInfo* GlyphAtlas::getGlyph(uint32_t codepoint) {
+    auto it = _glyphs.find(codepoint);
+    if (it != _glyphs.end()) {
+        return &it->second;
+    }
+    return isValid() ? loadGlyph(codepoint) : nullptr;
+}
+
+float GlyphAtlas::getKerning(uint32_t left, uint32_t right) const {
+    return _rasterizer ? _rasterizer->getKerning(left, right, _config.pixelSize) : 0.0f;
+}
+
+std::vector<uint8_t> GlyphAtlas::generateDistanceField(const uint8_t* coverage, uint32_t width, uint32_t height,
+                                                       uint32_t spread) {
+    const uint32_t fieldWidth = width + 2 * spread;
+    const uint32_t fieldHeight = height + 2 * spread;
+    std::vector<uint8_t> inside(size_t(fieldWidth) * fieldHeight, 0);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            inside[size_t(y + spread) * fieldWidth + x + spread] = coverage[size_t(y) * width + x] >= 128 ? 1 : 0;
+        }
+    }
+
+    const std::vector<float> toInside = distanceTransform(inside, fieldWidth, fieldHeight, true);
+    const std::vector<float> toOutside = distanceTransform(inside, fieldWidth, fieldHeight, false);
+
+    // The outline runs half a texel from the centers on either side of it
+    const float scale = 0.5f / static_cast<float>(std::max(spread, 1u));
+    std::vector<uint8_t> field(inside.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        const float distance = inside[i] ? std::sqrt(toOutside[i]) - 0.5f : 0.5f - std::sqrt(toInside[i]);
+        const float value = std::clamp(0.5f + distance * scale, 0.0f, 1.0f);
+        field[i] = static_cast<uint8_t>(std::lround(value * 255.0f));
+    }
+    return field;
+}
+
+const GlyphInfo* GlyphAtlas::loadGlyph(uint32_t codepoint) {
+    PERS_PROFILE_SCOPE("GlyphAtlas::loadGlyph");
+    GlyphBitmap bitmap;
+    if (!_rasterizer->rasterize(codepoint, _config.pixelSize, bitmap)) {
+        GlyphInfo substitute;
+        if (codepoint != _config.fallback) {
+            const GlyphInfo* fallback = getGlyph(_config.fallback);
+            if (!fallback) {
+                return nullptr;
+            }
+            substitute = *fallback;
+        }
+        return &(_glyphs[codepoint] = substitute);
+    }
+
+    GlyphInfo info;
+    info.advance = bitmap.advance;
+    if (bitmap.width == 0 || bitmap.height == 0) {
+        return &(_glyphs[codepoint] = info);
+    }
+    if (bitmap.coverage.size() < size_t(bitmap.width) * bitmap.height) {
+        LOG_ERROR("GlyphAtlas", "Rasterizer returned a bitmap smaller than its size");
+        return &(_glyphs[codepoint] = info);
+    }
+
+    const uint32_t spread = _config.spread;
+    const std::vector<uint8_t> field = generateDistanceField(bitmap.coverage.data(), bitmap.width, bitmap.height, spread);
+    auto region = _atlas.add(field.data(), bitmap.width + 2 * spread, bitmap.height + 2 * spread);
+    if (!region) {
+        LOG_WARNING("GlyphAtlas", "Glyph atlas is full");
+        return nullptr;
+    }
+
+    info.region = *region;
+    info.offsetX = bitmap.bearingX - static_cast<float>(spread);
+    info.offsetY = bitmap.bearingY + static_cast<float>(spread);
+    info.hasInk = true;
+    return &(_glyphs[codepoint] = info);
+}
+
+} // namespace pers
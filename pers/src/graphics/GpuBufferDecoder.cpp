@@ -0,0 +1,245 @@
+#include "pers/graphics/GpuBufferDecoder.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <span>
+
+namespace pers {
+
+namespace {
+
+// Mirrors decodeBufferPayload; header words are read straight from the payload
+const char* DECODE_SHADER = R"(
+const HEADER_WORDS: u32 = 8u;
+const BLOCK_SIZE: u32 = 64u;
+
+@group(0) @binding(0) var<storage, read> payload: array<u32>;
+@group(0) @binding(1) var<storage, read_write> decoded: array<u32>;
+
+fn readBits(wordOffset: u32, bitPos: u32, bits: u32) -> u32 {
+    let index = wordOffset + (bitPos >> 5u);
+    let shift = bitPos & 31u;
+    var value = payload[index] >> shift;
+    if (shift + bits > 32u) {
+        value = value | (payload[index + 1u] << (32u - shift));
+    }
+    if (bits < 32u) {
+        value = value & ((1u << bits) - 1u);
+    }
+    return value;
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>, @builtin(num_workgroups) groups: vec3<u32>) {
+    let elementCount = payload[2];
+    let channelCount = payload[3];
+    let blockCount = payload[4];
+    let dataOffset = payload[5];
+
+    let stream = id.y * groups.x * 64u + id.x;
+    if (stream >= blockCount * channelCount) {
+        return;
+    }
+
+    let block = stream / channelCount;
+    let channel = stream % channelCount;
+    let entry = payload[HEADER_WORDS + stream * 2u];
+    let wordOffset = dataOffset + (entry >> 6u);
+    let bits = entry & 63u;
+    let first = block * BLOCK_SIZE;
+    let count = min(BLOCK_SIZE, elementCount - first);
+
+    var value = payload[HEADER_WORDS + stream * 2u + 1u];
+    decoded[first * channelCount + channel] = value;
+    for (var j = 1u; j < count; j = j + 1u) {
+        if (bits > 0u) {
+            let zigzag = readBits(wordOffset, (j - 1u) * bits, bits);
+            value = value + ((zigzag >> 1u) ^ (0u - (zigzag & 1u)));
+        }
+        decoded[(first + j) * channelCount + channel] = value;
+    }
+}
+)";
+
+} // anonymous namespace
+
+GpuBufferDecoder::GpuBufferDecoder(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("GpuBufferDecoder", "Resource factory is null");
+        return;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = DECODE_SHADER;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.debugName = "BufferDecode";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create decode shader");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "BufferDecode";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "BufferDecode";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create pipeline layout");
+        return;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "BufferDecode";
+    _pipeline = factory->createComputePipeline(pipelineDesc);
+    if (!_pipeline) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create decode pipeline");
+    }
+}
+
+bool GpuBufferDecoder::record(ICommandEncoder& encoder,
+                              const std::shared_ptr<IBuffer>& payload,
+                              const std::shared_ptr<IBuffer>& output,
+                              const BufferPayloadInfo& info) const {
+    auto factory = _factory.lock();
+    if (!factory || !isValid()) {
+        LOG_ERROR("GpuBufferDecoder", "Cannot record on invalid decoder");
+        return false;
+    }
+
+    if (!payload || !output) {
+        LOG_ERROR("GpuBufferDecoder", "Payload and output buffers are required");
+        return false;
+    }
+
+    if (payload->getSize() < info.payloadSize || output->getSize() < info.decodedSize) {
+        LOG_ERROR("GpuBufferDecoder", "Buffers are smaller than the payload describes");
+        return false;
+    }
+
+    const uint32_t streamCount = info.getStreamCount();
+    if (streamCount == 0) {
+        return true;
+    }
+
+    BindGroupDesc desc;
+    desc.layout = _bindGroupLayout;
+    desc.debugName = "BufferDecode";
+    desc.entries.resize(2);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = payload;
+    desc.entries[0].size = info.payloadSize;
+    desc.entries[1].binding = 1;
+    desc.entries[1].buffer = output;
+    desc.entries[1].size = info.decodedSize;
+    auto bindGroup = factory->createBindGroup(desc);
+    if (!bindGroup) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create decode bind group");
+        return false;
+    }
+
+    ComputePassDesc passDesc;
+    passDesc.label = "BufferDecode";
+    auto pass = encoder.beginComputePass(passDesc);
+    if (!pass) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to begin compute pass");
+        return false;
+    }
+
+    // Large meshes exceed the per-dimension limit, spill into Y
+    const uint32_t groups = (streamCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+    const uint32_t groupsX = std::min(groups, MAX_WORKGROUPS_PER_DIMENSION);
+    const uint32_t groupsY = (groups + groupsX - 1) / groupsX;
+
+    pass->setPipeline(_pipeline);
+    pass->setBindGroup(0, bindGroup);
+    pass->dispatch(groupsX, groupsY);
+    pass->end();
+    return true;
+}
+
+std::shared_ptr<DeviceBuffer> GpuBufferDecoder::decodeToDeviceBuffer(const std::shared_ptr<ILogicalDevice>& device,
+                                                                     const void* payload,
+                                                                     size_t payloadSize,
+                                                                     DeviceBufferUsage usage,
+                                                                     const std::string& debugName) const {
+    if (!device) {
+        LOG_ERROR("GpuBufferDecoder", "Device is null");
+        return nullptr;
+    }
+
+    BufferPayloadInfo info;
+    if (!readBufferPayloadInfo(payload, payloadSize, info)) {
+        return nullptr;
+    }
+
+    auto queue = device->getQueue();
+    if (!queue) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to get queue from device");
+        return nullptr;
+    }
+
+    auto payloadBuffer = std::make_shared<DeviceBuffer>();
+    if (!payloadBuffer->create(info.payloadSize, DeviceBufferUsage::Storage, device, debugName + "Payload")) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create payload buffer");
+        return nullptr;
+    }
+
+    auto output = std::make_shared<DeviceBuffer>();
+    if (!output->create(info.decodedSize, usage | DeviceBufferUsage::Storage, device, debugName)) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to create decoded buffer");
+        return nullptr;
+    }
+
+    std::span<const std::byte> bytes(static_cast<const std::byte*>(payload), payloadSize);
+    if (!queue->writeBuffer(payloadBuffer, 0, bytes)) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to upload payload");
+        return nullptr;
+    }
+
+    auto encoder = device->createCommandEncoder();
+    if (!encoder || !record(*encoder, payloadBuffer, output, info)) {
+        return nullptr;
+    }
+
+    SubmissionFence fence = queue->submit(encoder->finish());
+    if (!fence.isValid()) {
+        LOG_ERROR("GpuBufferDecoder", "Failed to submit decode pass");
+        return nullptr;
+    }
+
+    if (const auto& deletionQueue = device->getDeletionQueue()) {
+        deletionQueue->retire(std::move(payloadBuffer), fence);
+    }
+
+    LOG_DEBUG_FMT("GpuBufferDecoder", "Decoding '{}': {} -> {} bytes", debugName, info.payloadSize, info.decodedSize);
+    return output;
+}
+
+} // namespace pers
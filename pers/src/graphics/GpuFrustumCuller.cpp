@@ -0,0 +1,167 @@
+#include "pers/graphics/GpuFrustumCuller.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+namespace {
+
+constexpr char CULL_SHADER[] = R"(
+struct Uniforms {
+    planes: array<vec4<f32>, 6>,
+    objectCount: u32,
+};
+
+struct DrawArgs {
+    indexCount: u32,
+    instanceCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+};
+
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+@group(0) @binding(1) var<storage, read> bounds: array<vec4<f32>>;
+@group(0) @binding(2) var<storage, read> templates: array<DrawArgs>;
+@group(0) @binding(3) var<storage, read_write> drawArgs: array<DrawArgs>;
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= uniforms.objectCount) {
+        return;
+    }
+
+    let sphere = bounds[i];
+    var visible = true;
+    for (var p = 0u; p < 6u; p = p + 1u) {
+        let plane = uniforms.planes[p];
+        if (dot(plane.xyz, sphere.xyz) + plane.w < -sphere.w) {
+            visible = false;
+        }
+    }
+
+    var args = templates[i];
+    if (!visible) {
+        args.instanceCount = 0u;
+    }
+    drawArgs[i] = args;
+}
+)";
+
+using CullUniformsLayout = GpuStruct<GpuLayout::Std140, GpuArray<GpuVec4f, 6>, GpuU32>;
+static_assert(CullUniformsLayout::matchesWgsl(CULL_SHADER, "Uniforms"), "Uniforms no longer match the culling shader");
+static_assert(CullUniformsLayout::SIZE == sizeof(FrustumCullUniforms) &&
+              CullUniformsLayout::offsetOf<1>() == offsetof(FrustumCullUniforms, objectCount),
+              "FrustumCullUniforms must match the WGSL layout");
+
+using DrawArgsLayout = GpuStruct<GpuLayout::Std430, GpuU32, GpuU32, GpuU32, GpuI32, GpuU32>;
+static_assert(DrawArgsLayout::matchesWgsl(CULL_SHADER, "DrawArgs"), "DrawArgs no longer match the culling shader");
+static_assert(DrawArgsLayout::SIZE == sizeof(DrawIndexedIndirectArgs), "DrawIndexedIndirectArgs must match the WGSL layout");
+
+} // anonymous namespace
+
+GpuFrustumCuller::GpuFrustumCuller(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("GpuFrustumCuller", "Resource factory is null");
+        return;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = CULL_SHADER;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.debugName = "FrustumCull";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("GpuFrustumCuller", "Failed to create culling shader");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "FrustumCull";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(FrustumCullUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("GpuFrustumCuller", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "FrustumCull";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("GpuFrustumCuller", "Failed to create pipeline layout");
+        return;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "FrustumCull";
+    _pipeline = factory->createComputePipeline(pipelineDesc);
+    if (!_pipeline) {
+        LOG_ERROR("GpuFrustumCuller", "Failed to create culling pipeline");
+    }
+}
+
+std::shared_ptr<IBindGroup> GpuFrustumCuller::createBindGroup(const Buffers& buffers) const {
+    auto factory = _factory.lock();
+    if (!factory || !isValid()) {
+        LOG_ERROR("GpuFrustumCuller", "Cannot create bind group on invalid culler");
+        return nullptr;
+    }
+
+    if (!buffers.uniforms || !buffers.bounds || !buffers.drawTemplates || !buffers.drawArgs) {
+        LOG_ERROR("GpuFrustumCuller", "All culling buffers are required");
+        return nullptr;
+    }
+
+    BindGroupDesc desc;
+    desc.layout = _bindGroupLayout;
+    desc.debugName = "FrustumCull";
+    desc.entries.resize(4);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = buffers.uniforms;
+    desc.entries[0].size = sizeof(FrustumCullUniforms);
+    desc.entries[1].binding = 1;
+    desc.entries[1].buffer = buffers.bounds;
+    desc.entries[2].binding = 2;
+    desc.entries[2].buffer = buffers.drawTemplates;
+    desc.entries[3].binding = 3;
+    desc.entries[3].buffer = buffers.drawArgs;
+    return factory->createBindGroup(desc);
+}
+
+void GpuFrustumCuller::encode(IComputePassEncoder& pass, const std::shared_ptr<IBindGroup>& bindGroup,
+                              uint32_t objectCount) const {
+    if (!isValid() || !bindGroup) {
+        LOG_ERROR("GpuFrustumCuller", "Cannot encode culling without pipeline and bind group");
+        return;
+    }
+
+    if (objectCount == 0) {
+        return;
+    }
+
+    pass.setPipeline(_pipeline);
+    pass.setBindGroup(0, bindGroup);
+    pass.dispatch((objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+}
+
+} // namespace pers
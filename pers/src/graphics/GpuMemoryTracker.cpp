@@ -0,0 +1,250 @@
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace pers {
+
+namespace {
+
+// Set while this thread runs eviction callbacks, so their allocations skip eviction
+thread_local bool t_evicting = false;
+
+void atomicMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+void GpuMemoryAllocation::reset() {
+    if (_size > 0) {
+        GpuMemoryTracker::instance().release(_category, _size);
+        _size = 0;
+    }
+}
+
+GpuMemoryTracker& GpuMemoryTracker::instance() {
+    // Leaked so allocations released during static destruction stay valid
+    static GpuMemoryTracker* tracker = new GpuMemoryTracker();
+    return *tracker;
+}
+
+GpuMemoryTracker::EvictionCallbackId GpuMemoryTracker::addEvictionCallback(const std::string& name,
+                                                                           EvictionCallback callback,
+                                                                           int priority) {
+    if (!callback) {
+        LOG_ERROR("GpuMemoryTracker", "Eviction callback is null");
+        return 0;
+    }
+
+    auto entry = std::make_shared<CallbackEntry>();
+    entry->name = name;
+    entry->priority = priority;
+    entry->callback = std::move(callback);
+
+    auto guard = makeLockGuard(_callbackMutex, PERS_SOURCE_LOC);
+    entry->id = _nextCallbackId++;
+    auto position = std::upper_bound(_callbacks.begin(), _callbacks.end(), priority,
+        [](int value, const std::shared_ptr<CallbackEntry>& other) { return value < other->priority; });
+    _callbacks.insert(position, entry);
+    return entry->id;
+}
+
+void GpuMemoryTracker::removeEvictionCallback(EvictionCallbackId id) {
+    std::shared_ptr<CallbackEntry> removed;
+    {
+        auto guard = makeLockGuard(_callbackMutex, PERS_SOURCE_LOC);
+        auto it = std::find_if(_callbacks.begin(), _callbacks.end(),
+            [id](const std::shared_ptr<CallbackEntry>& entry) { return entry->id == id; });
+        if (it == _callbacks.end()) {
+            return;
+        }
+        removed = std::move(*it);
+        _callbacks.erase(it);
+    }
+
+    // Wait out an invocation in progress so the owner can be destroyed after this returns
+    if (!t_evicting) {
+        auto guard = makeLockGuard(removed->running, PERS_SOURCE_LOC);
+        removed->callback = nullptr;
+    }
+}
+
+GpuMemoryAllocation GpuMemoryTracker::allocate(GpuMemoryCategory category, uint64_t size, const std::string& debugName) {
+    if (size == 0) {
+        return {};
+    }
+
+    const uint64_t budget = getBudget();
+    if (budget > 0 && !t_evicting) {
+        const uint64_t usage = getUsage();
+        if (usage + size > budget) {
+            evict(usage + size - budget);
+            if (getUsage() + size > budget) {
+                _overBudgetAllocations.fetch_add(1, std::memory_order_relaxed);
+                LOG_WARNING_FMT("GpuMemoryTracker", "Allocating {} bytes for '{}' exceeds the {} byte budget",
+                                size, debugName, budget);
+            }
+        }
+    }
+
+    const size_t index = static_cast<size_t>(category);
+    _bytes[index].fetch_add(size, std::memory_order_relaxed);
+    _allocations[index].fetch_add(1, std::memory_order_relaxed);
+    atomicMax(_peakBytes, _totalBytes.fetch_add(size, std::memory_order_relaxed) + size);
+    return GpuMemoryAllocation(category, size);
+}
+
+void GpuMemoryTracker::release(GpuMemoryCategory category, uint64_t size) {
+    const size_t index = static_cast<size_t>(category);
+    _bytes[index].fetch_sub(size, std::memory_order_relaxed);
+    _allocations[index].fetch_sub(1, std::memory_order_relaxed);
+    _totalBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+uint64_t GpuMemoryTracker::evict(uint64_t bytes) {
+    if (bytes == 0 || t_evicting) {
+        return 0;
+    }
+
+    std::vector<std::shared_ptr<CallbackEntry>> callbacks;
+    {
+        auto guard = makeLockGuard(_callbackMutex, PERS_SOURCE_LOC);
+        callbacks = _callbacks;
+    }
+    if (callbacks.empty()) {
+        return 0;
+    }
+
+    _evictionRuns.fetch_add(1, std::memory_order_relaxed);
+    t_evicting = true;
+    uint64_t freed = 0;
+    for (const auto& entry : callbacks) {
+        if (freed >= bytes) {
+            break;
+        }
+        auto guard = makeLockGuard(entry->running, PERS_SOURCE_LOC);
+        if (!entry->callback) {
+            continue;  // Removed after the snapshot
+        }
+        uint64_t released = entry->callback(bytes - freed);
+        LOG_DEBUG_FMT("GpuMemoryTracker", "Eviction callback '{}' released {} bytes", entry->name, released);
+        freed += released;
+    }
+    t_evicting = false;
+
+    _evictedBytes.fetch_add(freed, std::memory_order_relaxed);
+    return freed;
+}
+
+uint64_t GpuMemoryTracker::getUsage(GpuMemoryCategory category) const {
+    return _bytes[static_cast<size_t>(category)].load(std::memory_order_relaxed);
+}
+
+uint64_t GpuMemoryTracker::getOverBudgetBytes() const {
+    const uint64_t budget = getBudget();
+    const uint64_t usage = getUsage();
+    return budget > 0 && usage > budget ? usage - budget : 0;
+}
+
+GpuMemoryTracker::Stats GpuMemoryTracker::getStats() const {
+    Stats stats;
+    for (size_t i = 0; i < stats.bytes.size(); ++i) {
+        stats.bytes[i] = _bytes[i].load(std::memory_order_relaxed);
+        stats.allocations[i] = _allocations[i].load(std::memory_order_relaxed);
+    }
+    stats.totalBytes = getUsage();
+    stats.peakBytes = _peakBytes.load(std::memory_order_relaxed);
+    stats.budget = getBudget();
+    stats.evictionRuns = _evictionRuns.load(std::memory_order_relaxed);
+    stats.evictedBytes = _evictedBytes.load(std::memory_order_relaxed);
+    stats.overBudgetAllocations = _overBudgetAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string GpuMemoryTracker::formatReport() const {
+    const Stats stats = getStats();
+    std::ostringstream out;
+    out << std::left << std::setw(16) << "Category" << std::right << std::setw(12) << "Count"
+        << std::setw(14) << "MiB" << '\n';
+    out << std::fixed << std::setprecision(2);
+    for (size_t i = 0; i < stats.bytes.size(); ++i) {
+        out << std::left << std::setw(16) << getCategoryName(static_cast<GpuMemoryCategory>(i))
+            << std::right << std::setw(12) << stats.allocations[i]
+            << std::setw(14) << stats.bytes[i] / (1024.0 * 1024.0) << '\n';
+    }
+    out << std::left << std::setw(28) << "Total" << std::right << std::setw(14)
+        << stats.totalBytes / (1024.0 * 1024.0) << '\n';
+    out << std::left << std::setw(28) << "Peak" << std::right << std::setw(14)
+        << stats.peakBytes / (1024.0 * 1024.0) << '\n';
+    if (stats.budget > 0) {
+        out << std::left << std::setw(28) << "Budget" << std::right << std::setw(14)
+            << stats.budget / (1024.0 * 1024.0) << '\n';
+    }
+    return out.str();
+}
+
+const char* GpuMemoryTracker::getCategoryName(GpuMemoryCategory category) {
+    switch (category) {
+        case GpuMemoryCategory::Vertex: return "Vertex";
+        case GpuMemoryCategory::Index: return "Index";
+        case GpuMemoryCategory::Uniform: return "Uniform";
+        case GpuMemoryCategory::Storage: return "Storage";
+        case GpuMemoryCategory::Staging: return "Staging";
+        case GpuMemoryCategory::Texture: return "Texture";
+        case GpuMemoryCategory::RenderTarget: return "RenderTarget";
+        case GpuMemoryCategory::Other: return "Other";
+        default: return "Unknown";
+    }
+}
+
+GpuMemoryCategory GpuMemoryTracker::categorize(BufferUsage usage) {
+    auto has = [usage](BufferUsage flag) { return (usage & flag) != BufferUsage::None; };
+    if (has(BufferUsage::MapRead) || has(BufferUsage::MapWrite)) {
+        return GpuMemoryCategory::Staging;
+    }
+    if (has(BufferUsage::Vertex)) {
+        return GpuMemoryCategory::Vertex;
+    }
+    if (has(BufferUsage::Index)) {
+        return GpuMemoryCategory::Index;
+    }
+    if (has(BufferUsage::Uniform)) {
+        return GpuMemoryCategory::Uniform;
+    }
+    if (has(BufferUsage::Storage) || has(BufferUsage::Indirect)) {
+        return GpuMemoryCategory::Storage;
+    }
+    return GpuMemoryCategory::Other;
+}
+
+GpuMemoryCategory GpuMemoryTracker::categorize(TextureUsage usage) {
+    return (usage & TextureUsage::RenderAttachment) != TextureUsage::None
+         ? GpuMemoryCategory::RenderTarget : GpuMemoryCategory::Texture;
+}
+
+uint64_t GpuMemoryTracker::estimateTextureSize(const TextureDesc& desc) {
+    TextureFormatBlockInfo block = getTextureFormatBlockInfo(desc.format);
+    if (block.blockBytes == 0) {
+        block = {4, 1, 1};  // Depth24Plus and other formats without a copy footprint
+    }
+
+    const bool volume = desc.dimension == TextureDimension::D3;
+    const uint32_t mipLevels = std::max(desc.mipLevelCount, 1u);
+    uint64_t total = 0;
+    for (uint32_t mip = 0; mip < mipLevels; ++mip) {
+        const uint64_t width = std::max(desc.width >> mip, 1u);
+        const uint64_t height = std::max(desc.height >> mip, 1u);
+        const uint64_t depth = volume ? std::max(desc.depthOrArrayLayers >> mip, 1u) : desc.depthOrArrayLayers;
+        const uint64_t blocksX = (width + block.blockWidth - 1) / block.blockWidth;
+        const uint64_t blocksY = (height + block.blockHeight - 1) / block.blockHeight;
+        total += blocksX * blocksY * depth * block.blockBytes;
+    }
+    return total * std::max(desc.sampleCount, 1u);
+}
+
+} // namespace pers
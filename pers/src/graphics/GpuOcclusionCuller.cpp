@@ -0,0 +1,230 @@
+#include "pers/graphics/GpuOcclusionCuller.h"
+#include "pers/graphics/HiZPyramid.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+namespace {
+
+constexpr char CULL_SHADER[] = R"(
+struct Uniforms {
+    planes: array<vec4<f32>, 6>,
+    viewProjection: mat4x4<f32>,
+    pyramidScale: vec2<f32>,
+    mipCount: u32,
+    objectCount: u32,
+};
+
+struct DrawArgs {
+    indexCount: u32,
+    instanceCount: u32,
+    firstIndex: u32,
+    baseVertex: i32,
+    firstInstance: u32,
+};
+
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+@group(0) @binding(1) var<storage, read> bounds: array<vec4<f32>>;
+@group(0) @binding(2) var<storage, read> templates: array<DrawArgs>;
+@group(0) @binding(3) var<storage, read_write> drawArgs: array<DrawArgs>;
+@group(0) @binding(4) var hiZ: texture_2d<f32>;
+
+fn isOccluded(sphere: vec4<f32>) -> bool {
+    var minUv = vec2<f32>(1.0, 1.0);
+    var maxUv = vec2<f32>(0.0, 0.0);
+    var nearest = 1.0;
+    for (var c = 0u; c < 8u; c = c + 1u) {
+        let corner = vec3<f32>(select(-1.0, 1.0, (c & 1u) != 0u),
+                               select(-1.0, 1.0, (c & 2u) != 0u),
+                               select(-1.0, 1.0, (c & 4u) != 0u));
+        let clip = uniforms.viewProjection * vec4<f32>(sphere.xyz + corner * sphere.w, 1.0);
+        if (clip.w <= 1e-5) {
+            return false;  // Crosses the near plane
+        }
+        let ndc = clip.xyz / clip.w;
+        let uv = vec2<f32>(ndc.x * 0.5 + 0.5, 0.5 - ndc.y * 0.5);
+        minUv = min(minUv, uv);
+        maxUv = max(maxUv, uv);
+        nearest = min(nearest, ndc.z);
+    }
+
+    // Level where the box spans at most two texels in each direction
+    let texelMin = clamp(minUv, vec2<f32>(0.0), vec2<f32>(1.0)) * uniforms.pyramidScale;
+    let texelMax = clamp(maxUv, vec2<f32>(0.0), vec2<f32>(1.0)) * uniforms.pyramidScale;
+    let extent = max(texelMax.x - texelMin.x, texelMax.y - texelMin.y);
+    let mip = min(u32(ceil(log2(max(extent, 1.0)))), uniforms.mipCount - 1u);
+
+    let maxCoord = vec2<i32>(textureDimensions(hiZ, mip)) - 1;
+    let scale = 1.0 / f32(1u << mip);
+    let a = min(vec2<i32>(texelMin * scale), maxCoord);
+    let b = min(vec2<i32>(texelMax * scale), maxCoord);
+    let farthest = max(max(textureLoad(hiZ, a, mip).r, textureLoad(hiZ, vec2<i32>(b.x, a.y), mip).r),
+                       max(textureLoad(hiZ, vec2<i32>(a.x, b.y), mip).r, textureLoad(hiZ, b, mip).r));
+    return nearest > farthest;
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= uniforms.objectCount) {
+        return;
+    }
+
+    let sphere = bounds[i];
+    var visible = true;
+    for (var p = 0u; p < 6u; p = p + 1u) {
+        let plane = uniforms.planes[p];
+        if (dot(plane.xyz, sphere.xyz) + plane.w < -sphere.w) {
+            visible = false;
+        }
+    }
+    if (visible && uniforms.mipCount > 0u) {
+        visible = !isOccluded(sphere);
+    }
+
+    var args = templates[i];
+    if (!visible) {
+        args.instanceCount = 0u;
+    }
+    drawArgs[i] = args;
+}
+)";
+
+using CullUniformsLayout = GpuStruct<GpuLayout::Std140, GpuArray<GpuVec4f, 6>, GpuMat4x4f, GpuVec2f, GpuU32, GpuU32>;
+static_assert(CullUniformsLayout::matchesWgsl(CULL_SHADER, "Uniforms"), "Uniforms no longer match the culling shader");
+static_assert(CullUniformsLayout::SIZE == sizeof(OcclusionCullUniforms) &&
+              CullUniformsLayout::offsetOf<1>() == offsetof(OcclusionCullUniforms, viewProjection) &&
+              CullUniformsLayout::offsetOf<2>() == offsetof(OcclusionCullUniforms, pyramidScale) &&
+              CullUniformsLayout::offsetOf<3>() == offsetof(OcclusionCullUniforms, mipCount) &&
+              CullUniformsLayout::offsetOf<4>() == offsetof(OcclusionCullUniforms, objectCount),
+              "OcclusionCullUniforms must match the WGSL layout");
+
+using DrawArgsLayout = GpuStruct<GpuLayout::Std430, GpuU32, GpuU32, GpuU32, GpuI32, GpuU32>;
+static_assert(DrawArgsLayout::matchesWgsl(CULL_SHADER, "DrawArgs"), "DrawArgs no longer match the culling shader");
+static_assert(DrawArgsLayout::SIZE == sizeof(DrawIndexedIndirectArgs), "DrawIndexedIndirectArgs must match the WGSL layout");
+
+} // anonymous namespace
+
+GpuOcclusionCuller::GpuOcclusionCuller(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("GpuOcclusionCuller", "Resource factory is null");
+        return;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = CULL_SHADER;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.debugName = "OcclusionCull";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("GpuOcclusionCuller", "Failed to create culling shader");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "OcclusionCull";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(OcclusionCullUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 4, .visibility = ShaderStage::Compute, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::UnfilterableFloat},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("GpuOcclusionCuller", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "OcclusionCull";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("GpuOcclusionCuller", "Failed to create pipeline layout");
+        return;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "OcclusionCull";
+    _pipeline = factory->createComputePipeline(pipelineDesc);
+    if (!_pipeline) {
+        LOG_ERROR("GpuOcclusionCuller", "Failed to create culling pipeline");
+    }
+}
+
+void GpuOcclusionCuller::setPyramid(OcclusionCullUniforms& uniforms, const HiZPyramid& pyramid,
+                                    const float viewProjection[16]) {
+    std::copy(viewProjection, viewProjection + 16, uniforms.viewProjection.begin());
+    // Level 0 texels cover 2x2 depth pixels
+    uniforms.pyramidScale = {pyramid.getDepthWidth() * 0.5f, pyramid.getDepthHeight() * 0.5f};
+    uniforms.mipCount = pyramid.getView() ? pyramid.getMipLevelCount() : 0;
+}
+
+std::shared_ptr<IBindGroup> GpuOcclusionCuller::createBindGroup(const Buffers& buffers, const HiZPyramid& pyramid) const {
+    auto factory = _factory.lock();
+    if (!factory || !isValid()) {
+        LOG_ERROR("GpuOcclusionCuller", "Cannot create bind group on invalid culler");
+        return nullptr;
+    }
+
+    if (!buffers.uniforms || !buffers.bounds || !buffers.drawTemplates || !buffers.drawArgs) {
+        LOG_ERROR("GpuOcclusionCuller", "All culling buffers are required");
+        return nullptr;
+    }
+
+    if (!pyramid.getView()) {
+        LOG_ERROR("GpuOcclusionCuller", "Pyramid has not been built");
+        return nullptr;
+    }
+
+    BindGroupDesc desc;
+    desc.layout = _bindGroupLayout;
+    desc.debugName = "OcclusionCull";
+    desc.entries.resize(5);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = buffers.uniforms;
+    desc.entries[0].size = sizeof(OcclusionCullUniforms);
+    desc.entries[1].binding = 1;
+    desc.entries[1].buffer = buffers.bounds;
+    desc.entries[2].binding = 2;
+    desc.entries[2].buffer = buffers.drawTemplates;
+    desc.entries[3].binding = 3;
+    desc.entries[3].buffer = buffers.drawArgs;
+    desc.entries[4].binding = 4;
+    desc.entries[4].textureView = pyramid.getView();
+    return factory->createBindGroup(desc);
+}
+
+void GpuOcclusionCuller::encode(IComputePassEncoder& pass, const std::shared_ptr<IBindGroup>& bindGroup,
+                                uint32_t objectCount) const {
+    if (!isValid() || !bindGroup) {
+        LOG_ERROR("GpuOcclusionCuller", "Cannot encode culling without pipeline and bind group");
+        return;
+    }
+
+    if (objectCount == 0) {
+        return;
+    }
+
+    pass.setPipeline(_pipeline);
+    pass.setBindGroup(0, bindGroup);
+    pass.dispatch((objectCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+}
+
+} // namespace pers
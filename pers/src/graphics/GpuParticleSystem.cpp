@@ -0,0 +1,659 @@
+#include "pers/graphics/GpuParticleSystem.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct EmitterUniforms {
+    float position[3];
+    float radius;
+    float velocity[3];
+    float velocitySpread;
+    float gravity[3];
+    float drag;
+    float lifetimeMin;
+    float lifetimeMax;
+    float sizeStart;
+    float sizeEnd;
+    uint32_t colorStart;
+    uint32_t colorEnd;
+    float deltaTime;
+    uint32_t emitCount;
+    uint32_t capacity;
+    uint32_t parity;
+    uint32_t seed;
+    uint32_t padding;
+};
+
+struct ViewUniforms {
+    float viewProjection[16];
+    float cameraRight[3];
+    float alphaCutoff;
+    float cameraUp[3];
+    float padding;
+};
+
+struct Particle {
+    float position[3];
+    float age;
+    float velocity[3];
+    float lifetime;
+};
+
+constexpr char TYPES_WGSL[] = R"(
+struct Emitter {
+    position: vec3<f32>,
+    radius: f32,
+    velocity: vec3<f32>,
+    velocitySpread: f32,
+    gravity: vec3<f32>,
+    drag: f32,
+    lifetimeMin: f32,
+    lifetimeMax: f32,
+    sizeStart: f32,
+    sizeEnd: f32,
+    colorStart: u32,
+    colorEnd: u32,
+    deltaTime: f32,
+    emitCount: u32,
+    capacity: u32,
+    parity: u32,
+    seed: u32,
+    padding: u32,
+};
+
+struct Particle {
+    position: vec3<f32>,
+    age: f32,
+    velocity: vec3<f32>,
+    lifetime: f32,
+};
+
+struct View {
+    viewProjection: mat4x4<f32>,
+    cameraRight: vec3<f32>,
+    alphaCutoff: f32,
+    cameraUp: vec3<f32>,
+    padding: f32,
+};
+
+struct DispatchArgs {
+    x: u32,
+    y: u32,
+    z: u32,
+};
+
+struct DrawArgs {
+    vertexCount: u32,
+    instanceCount: u32,
+    firstVertex: u32,
+    firstInstance: u32,
+};
+
+// Alive counts are indexed by parity: the list simulated this frame and the one it fills
+struct Counters {
+    alive: array<atomic<u32>, 2>,
+    dead: atomic<u32>,
+    emitted: atomic<u32>,
+};
+)";
+
+using EmitterLayout = GpuStruct<GpuLayout::Std140, GpuVec3f, GpuF32, GpuVec3f, GpuF32, GpuVec3f, GpuF32, GpuF32, GpuF32,
+                                GpuF32, GpuF32, GpuU32, GpuU32, GpuF32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(EmitterLayout::matchesWgsl(TYPES_WGSL, "Emitter"), "Emitter no longer matches the particle shaders");
+static_assert(EmitterLayout::SIZE == sizeof(EmitterUniforms) &&
+              EmitterLayout::offsetOf<10>() == offsetof(EmitterUniforms, colorStart) &&
+              EmitterLayout::offsetOf<14>() == offsetof(EmitterUniforms, capacity),
+              "EmitterUniforms must match the WGSL layout");
+
+using ViewLayout = GpuStruct<GpuLayout::Std140, GpuMat4x4f, GpuVec3f, GpuF32, GpuVec3f, GpuF32>;
+static_assert(ViewLayout::matchesWgsl(TYPES_WGSL, "View"), "View no longer matches the particle shaders");
+static_assert(ViewLayout::SIZE == sizeof(ViewUniforms) &&
+              ViewLayout::offsetOf<3>() == offsetof(ViewUniforms, cameraUp),
+              "ViewUniforms must match the WGSL layout");
+
+using ParticleLayout = GpuStruct<GpuLayout::Std430, GpuVec3f, GpuF32, GpuVec3f, GpuF32>;
+static_assert(ParticleLayout::matchesWgsl(TYPES_WGSL, "Particle"), "Particle no longer matches the particle shaders");
+static_assert(ParticleLayout::SIZE == sizeof(Particle), "Particle must match the WGSL layout");
+
+using DispatchArgsLayout = GpuStruct<GpuLayout::Std430, GpuU32, GpuU32, GpuU32>;
+static_assert(DispatchArgsLayout::matchesWgsl(TYPES_WGSL, "DispatchArgs") &&
+              DispatchArgsLayout::SIZE == sizeof(DispatchIndirectArgs),
+              "DispatchIndirectArgs must match the WGSL layout");
+
+using DrawArgsLayout = GpuStruct<GpuLayout::Std430, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(DrawArgsLayout::matchesWgsl(TYPES_WGSL, "DrawArgs") && DrawArgsLayout::SIZE == sizeof(DrawIndirectArgs),
+              "DrawIndirectArgs must match the WGSL layout");
+
+constexpr uint32_t COUNTERS_SIZE = 4 * sizeof(uint32_t);
+
+constexpr char SIMULATE_BINDINGS[] = R"(
+@group(0) @binding(0) var<uniform> emitter: Emitter;
+@group(0) @binding(1) var<storage, read_write> particles: array<Particle>;
+@group(0) @binding(2) var<storage, read_write> aliveList: array<u32>;
+@group(0) @binding(3) var<storage, read_write> deadList: array<u32>;
+@group(0) @binding(4) var<storage, read_write> counters: Counters;
+)";
+
+// Kept out of the simulate layout: a buffer may not be indirect and writable in one dispatch
+constexpr char ARGS_BINDINGS[] = R"(
+@group(1) @binding(0) var<storage, read_write> dispatchArgs: DispatchArgs;
+@group(1) @binding(1) var<storage, read_write> drawArgs: DrawArgs;
+)";
+
+constexpr char BEGIN_MAIN[] = R"(
+@compute @workgroup_size(1)
+fn main() {
+    atomicStore(&counters.emitted, min(emitter.emitCount, atomicLoad(&counters.dead)));
+    atomicStore(&counters.alive[1u - emitter.parity], 0u);
+}
+)";
+
+constexpr char EMIT_MAIN[] = R"(
+fn pcg(value: u32) -> u32 {
+    let state = value * 747796405u + 2891336453u;
+    let word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    return (word >> 22u) ^ word;
+}
+
+fn random(state: ptr<function, u32>) -> f32 {
+    *state = pcg(*state);
+    return f32(*state >> 8u) / 16777216.0;
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= atomicLoad(&counters.emitted)) {
+        return;
+    }
+
+    // Slots are popped from the top of the free list, which begin clamped emitted to
+    let index = deadList[atomicLoad(&counters.dead) - 1u - i];
+    var state = pcg(emitter.seed ^ pcg(i));
+
+    // Uniform point in the spawn sphere
+    let z = random(&state) * 2.0 - 1.0;
+    let phi = random(&state) * 6.28318530718;
+    let direction = vec3<f32>(sqrt(1.0 - z * z) * vec2<f32>(cos(phi), sin(phi)), z);
+    let spawnDistance = emitter.radius * pow(random(&state), 1.0 / 3.0);
+
+    var particle: Particle;
+    particle.position = emitter.position + direction * spawnDistance;
+    particle.velocity = emitter.velocity +
+        (vec3<f32>(random(&state), random(&state), random(&state)) * 2.0 - 1.0) * emitter.velocitySpread;
+    particle.age = 0.0;
+    particle.lifetime = mix(emitter.lifetimeMin, emitter.lifetimeMax, random(&state));
+    particles[index] = particle;
+
+    let slot = atomicAdd(&counters.alive[emitter.parity], 1u);
+    aliveList[emitter.parity * emitter.capacity + slot] = index;
+}
+)";
+
+constexpr char PREPARE_MAIN[] = R"(
+@compute @workgroup_size(1)
+fn main() {
+    atomicSub(&counters.dead, atomicLoad(&counters.emitted));
+    dispatchArgs.x = (atomicLoad(&counters.alive[emitter.parity]) + 63u) / 64u;
+    dispatchArgs.y = 1u;
+    dispatchArgs.z = 1u;
+}
+)";
+
+constexpr char SIMULATE_MAIN[] = R"(
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= atomicLoad(&counters.alive[emitter.parity])) {
+        return;
+    }
+
+    let index = aliveList[emitter.parity * emitter.capacity + i];
+    var particle = particles[index];
+    particle.age += emitter.deltaTime;
+    if (particle.age >= particle.lifetime) {
+        deadList[atomicAdd(&counters.dead, 1u)] = index;
+        return;
+    }
+
+    let dt = emitter.deltaTime;
+    particle.velocity = (particle.velocity + emitter.gravity * dt) * max(1.0 - emitter.drag * dt, 0.0);
+    particle.position += particle.velocity * dt;
+    particles[index] = particle;
+
+    // Survivors are appended densely, compacting the next frame's list
+    let next = 1u - emitter.parity;
+    aliveList[next * emitter.capacity + atomicAdd(&counters.alive[next], 1u)] = index;
+}
+)";
+
+constexpr char FINALIZE_MAIN[] = R"(
+@compute @workgroup_size(1)
+fn main() {
+    drawArgs.vertexCount = 6u;
+    drawArgs.instanceCount = atomicLoad(&counters.alive[1u - emitter.parity]);
+    drawArgs.firstVertex = 0u;
+    drawArgs.firstInstance = 0u;
+}
+)";
+
+constexpr char VERTEX_MAIN[] = R"(
+@group(0) @binding(0) var<uniform> emitter: Emitter;
+@group(0) @binding(1) var<uniform> view: View;
+@group(0) @binding(2) var<storage, read> particles: array<Particle>;
+@group(0) @binding(3) var<storage, read> aliveList: array<u32>;
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) color: vec4<f32>,
+    @location(1) offset: vec2<f32>,
+};
+
+@vertex
+fn main(@builtin(vertex_index) vertexIndex: u32, @builtin(instance_index) instanceIndex: u32) -> VertexOutput {
+    // The last update() filled the list after the one it simulated
+    let particle = particles[aliveList[(1u - emitter.parity) * emitter.capacity + instanceIndex]];
+    let t = clamp(particle.age / particle.lifetime, 0.0, 1.0);
+    let size = mix(emitter.sizeStart, emitter.sizeEnd, t);
+    let corner = vec2<f32>(f32((0x32u >> vertexIndex) & 1u), f32((0x2Cu >> vertexIndex) & 1u)) * 2.0 - 1.0;
+    let world = particle.position + (view.cameraRight * corner.x + view.cameraUp * corner.y) * (0.5 * size);
+
+    var output: VertexOutput;
+    output.position = view.viewProjection * vec4<f32>(world, 1.0);
+    output.color = mix(unpack4x8unorm(emitter.colorStart), unpack4x8unorm(emitter.colorEnd), t);
+    output.offset = corner;
+    return output;
+}
+)";
+
+constexpr char FRAGMENT_MAIN[] = R"(
+@group(0) @binding(1) var<uniform> view: View;
+
+@fragment
+fn main(@location(0) color: vec4<f32>, @location(1) offset: vec2<f32>) -> @location(0) vec4<f32> {
+    let alpha = color.a * clamp(1.0 - length(offset), 0.0, 1.0) * 2.0;
+    if (alpha < view.alphaCutoff) {
+        discard;
+    }
+    return vec4<f32>(color.rgb, min(alpha, 1.0));
+}
+)";
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create particle shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+std::shared_ptr<IComputePipeline> createComputePipeline(IResourceFactory& factory, const std::string& code,
+                                                        const std::shared_ptr<IPipelineLayout>& layout,
+                                                        const char* name) {
+    auto shader = createShader(factory, code, ShaderStage::Compute, name);
+    if (!shader) {
+        return nullptr;
+    }
+
+    ComputePipelineDesc desc;
+    desc.compute = shader;
+    desc.layout = layout;
+    desc.debugName = name;
+    auto pipeline = factory.createComputePipeline(desc);
+    if (!pipeline) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create particle pipeline");
+    }
+    return pipeline;
+}
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           DeviceBufferUsage usage, const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, device, name)) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create particle buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+template <typename T>
+std::span<const std::byte> asBytes(const T& value) {
+    return std::span<const std::byte>(reinterpret_cast<const std::byte*>(&value), sizeof(T));
+}
+
+} // anonymous namespace
+
+GpuParticleSystem::GpuParticleSystem(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _capacity(std::clamp(config.capacity, 1u, MAX_CAPACITY)) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("GpuParticleSystem", "Device or resource factory is null");
+        return;
+    }
+    if (_capacity != config.capacity) {
+        LOG_WARNING("GpuParticleSystem", "Particle capacity clamped to " + std::to_string(_capacity));
+    }
+
+    const uint64_t capacity = _capacity;
+    _emitterBuffer = createBuffer(device, sizeof(EmitterUniforms), DeviceBufferUsage::Uniform, "ParticleEmitter");
+    _viewBuffer = createBuffer(device, sizeof(ViewUniforms), DeviceBufferUsage::Uniform, "ParticleView");
+    _particles = createBuffer(device, capacity * sizeof(Particle), DeviceBufferUsage::Storage, "Particles");
+    _aliveList = createBuffer(device, 2 * capacity * sizeof(uint32_t), DeviceBufferUsage::Storage, "ParticleAliveList");
+    _deadList = createBuffer(device, capacity * sizeof(uint32_t), DeviceBufferUsage::Storage, "ParticleDeadList");
+    _counters = createBuffer(device, COUNTERS_SIZE, DeviceBufferUsage::Storage, "ParticleCounters");
+    _dispatchArgs = createBuffer(device, sizeof(DispatchIndirectArgs),
+                                 DeviceBufferUsage::Storage | DeviceBufferUsage::Indirect, "ParticleDispatchArgs");
+    _drawArgs = createBuffer(device, sizeof(DrawIndirectArgs),
+                             DeviceBufferUsage::Storage | DeviceBufferUsage::Indirect, "ParticleDrawArgs");
+    if (!_emitterBuffer || !_viewBuffer || !_particles || !_aliveList || !_deadList || !_counters || !_dispatchArgs ||
+        !_drawArgs || !reset()) {
+        return;
+    }
+
+    BindGroupLayoutDesc simulateLayoutDesc;
+    simulateLayoutDesc.debugName = "ParticleSimulate";
+    simulateLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(EmitterUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 4, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    BindGroupLayoutDesc argsLayoutDesc;
+    argsLayoutDesc.debugName = "ParticleArgs";
+    argsLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    BindGroupLayoutDesc renderLayoutDesc;
+    renderLayoutDesc.debugName = "ParticleRender";
+    renderLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(EmitterUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Vertex | ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ViewUniforms)},
+        {.binding = 2, .visibility = ShaderStage::Vertex, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Vertex, .type = BindingType::ReadOnlyStorageBuffer},
+    };
+    auto simulateLayout = factory->createBindGroupLayout(simulateLayoutDesc);
+    auto argsLayout = factory->createBindGroupLayout(argsLayoutDesc);
+    auto renderLayout = factory->createBindGroupLayout(renderLayoutDesc);
+    if (!simulateLayout || !argsLayout || !renderLayout) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create bind group layouts");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {simulateLayout};
+    pipelineLayoutDesc.debugName = "ParticleSimulate";
+    auto simulatePipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    pipelineLayoutDesc.bindGroupLayouts = {simulateLayout, argsLayout};
+    pipelineLayoutDesc.debugName = "ParticleArgs";
+    auto argsPipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    pipelineLayoutDesc.bindGroupLayouts = {renderLayout};
+    pipelineLayoutDesc.debugName = "ParticleRender";
+    _renderLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!simulatePipelineLayout || !argsPipelineLayout || !_renderLayout) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create pipeline layouts");
+        return;
+    }
+
+    const std::string simulatePrefix = std::string(TYPES_WGSL) + SIMULATE_BINDINGS;
+    const std::string argsPrefix = simulatePrefix + ARGS_BINDINGS;
+    _beginPipeline = createComputePipeline(*factory, simulatePrefix + BEGIN_MAIN, simulatePipelineLayout,
+                                           "ParticleBegin");
+    _emitPipeline = createComputePipeline(*factory, simulatePrefix + EMIT_MAIN, simulatePipelineLayout,
+                                          "ParticleEmit");
+    _preparePipeline = createComputePipeline(*factory, argsPrefix + PREPARE_MAIN, argsPipelineLayout,
+                                             "ParticlePrepare");
+    _simulatePipeline = createComputePipeline(*factory, simulatePrefix + SIMULATE_MAIN, simulatePipelineLayout,
+                                              "ParticleSimulate");
+    _finalizePipeline = createComputePipeline(*factory, argsPrefix + FINALIZE_MAIN, argsPipelineLayout,
+                                              "ParticleFinalize");
+    _vertexShader = createShader(*factory, std::string(TYPES_WGSL) + VERTEX_MAIN, ShaderStage::Vertex,
+                                 "ParticleVertex");
+    _fragmentShader = createShader(*factory, std::string(TYPES_WGSL) + FRAGMENT_MAIN, ShaderStage::Fragment,
+                                   "ParticleFragment");
+    if (!_beginPipeline || !_emitPipeline || !_preparePipeline || !_simulatePipeline || !_finalizePipeline ||
+        !_vertexShader || !_fragmentShader) {
+        return;
+    }
+
+    BindGroupDesc simulateDesc;
+    simulateDesc.layout = simulateLayout;
+    simulateDesc.debugName = "ParticleSimulate";
+    simulateDesc.entries.resize(5);
+    simulateDesc.entries[0].binding = 0;
+    simulateDesc.entries[0].buffer = _emitterBuffer;
+    simulateDesc.entries[0].size = sizeof(EmitterUniforms);
+    simulateDesc.entries[1].binding = 1;
+    simulateDesc.entries[1].buffer = _particles;
+    simulateDesc.entries[2].binding = 2;
+    simulateDesc.entries[2].buffer = _aliveList;
+    simulateDesc.entries[3].binding = 3;
+    simulateDesc.entries[3].buffer = _deadList;
+    simulateDesc.entries[4].binding = 4;
+    simulateDesc.entries[4].buffer = _counters;
+    _simulateBindGroup = factory->createBindGroup(simulateDesc);
+
+    BindGroupDesc argsDesc;
+    argsDesc.layout = argsLayout;
+    argsDesc.debugName = "ParticleArgs";
+    argsDesc.entries.resize(2);
+    argsDesc.entries[0].binding = 0;
+    argsDesc.entries[0].buffer = _dispatchArgs;
+    argsDesc.entries[1].binding = 1;
+    argsDesc.entries[1].buffer = _drawArgs;
+    _argsBindGroup = factory->createBindGroup(argsDesc);
+
+    BindGroupDesc renderDesc;
+    renderDesc.layout = renderLayout;
+    renderDesc.debugName = "ParticleRender";
+    renderDesc.entries.resize(4);
+    renderDesc.entries[0].binding = 0;
+    renderDesc.entries[0].buffer = _emitterBuffer;
+    renderDesc.entries[0].size = sizeof(EmitterUniforms);
+    renderDesc.entries[1].binding = 1;
+    renderDesc.entries[1].buffer = _viewBuffer;
+    renderDesc.entries[1].size = sizeof(ViewUniforms);
+    renderDesc.entries[2].binding = 2;
+    renderDesc.entries[2].buffer = _particles;
+    renderDesc.entries[3].binding = 3;
+    renderDesc.entries[3].buffer = _aliveList;
+
+    // Created last, isValid() means every stage is usable
+    if (_simulateBindGroup && _argsBindGroup) {
+        _renderBindGroup = factory->createBindGroup(renderDesc);
+    }
+    if (!_renderBindGroup) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create particle bind groups");
+    }
+}
+
+GpuParticleSystem::~GpuParticleSystem() = default;
+
+bool GpuParticleSystem::update(IComputePassEncoder& pass, float deltaTime, uint32_t emitCount) {
+    PERS_PROFILE_SCOPE("GpuParticleSystem::update");
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("GpuParticleSystem", "Cannot update invalid particle system");
+        return false;
+    }
+
+    EmitterUniforms uniforms = {};
+    std::copy(_emitter.position.begin(), _emitter.position.end(), uniforms.position);
+    uniforms.radius = _emitter.radius;
+    std::copy(_emitter.velocity.begin(), _emitter.velocity.end(), uniforms.velocity);
+    uniforms.velocitySpread = _emitter.velocitySpread;
+    std::copy(_emitter.gravity.begin(), _emitter.gravity.end(), uniforms.gravity);
+    uniforms.drag = _emitter.drag;
+    uniforms.lifetimeMin = _emitter.lifetimeMin;
+    uniforms.lifetimeMax = std::max(_emitter.lifetimeMin, _emitter.lifetimeMax);
+    uniforms.sizeStart = _emitter.sizeStart;
+    uniforms.sizeEnd = _emitter.sizeEnd;
+    uniforms.colorStart = _emitter.colorStart;
+    uniforms.colorEnd = _emitter.colorEnd;
+    uniforms.deltaTime = std::max(deltaTime, 0.0f);
+    uniforms.emitCount = std::min(emitCount, _capacity);
+    uniforms.capacity = _capacity;
+    uniforms.parity = _parity;
+    uniforms.seed = _frame++ * 0x9E3779B9u;
+    if (!queue->writeBuffer(_emitterBuffer, 0, asBytes(uniforms))) {
+        LOG_ERROR("GpuParticleSystem", "Failed to write emitter uniforms");
+        return false;
+    }
+
+    pass.setPipeline(_beginPipeline);
+    pass.setBindGroup(0, _simulateBindGroup);
+    pass.dispatch(1);
+    if (uniforms.emitCount > 0) {
+        pass.setPipeline(_emitPipeline);
+        pass.dispatch((uniforms.emitCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE);
+    }
+    pass.setPipeline(_preparePipeline);
+    pass.setBindGroup(1, _argsBindGroup);
+    pass.dispatch(1);
+    pass.setPipeline(_simulatePipeline);
+    pass.dispatchIndirect(_dispatchArgs);
+    pass.setPipeline(_finalizePipeline);
+    pass.dispatch(1);
+
+    _parity ^= 1;
+    return true;
+}
+
+bool GpuParticleSystem::render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                               const Vec3& cameraRight, const Vec3& cameraUp) {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("GpuParticleSystem", "Cannot render invalid particle system");
+        return false;
+    }
+
+    auto pipeline = getPipeline(target);
+    if (!pipeline) {
+        return false;
+    }
+
+    // Alpha-to-coverage fades exactly; single-sampled targets cut at half coverage
+    ViewUniforms view = {};
+    std::copy(viewProjection.begin(), viewProjection.end(), view.viewProjection);
+    std::copy(cameraRight.begin(), cameraRight.end(), view.cameraRight);
+    std::copy(cameraUp.begin(), cameraUp.end(), view.cameraUp);
+    view.alphaCutoff = target.sampleCount > 1 ? 1.0f / 255.0f : 0.5f;
+    if (!queue->writeBuffer(_viewBuffer, 0, asBytes(view))) {
+        LOG_ERROR("GpuParticleSystem", "Failed to write view uniforms");
+        return false;
+    }
+
+    pass.setPipeline(pipeline);
+    pass.setBindGroup(0, _renderBindGroup);
+    pass.drawIndirect(_drawArgs);
+    return true;
+}
+
+bool GpuParticleSystem::reset() {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !_deadList || !_counters || !_drawArgs) {
+        return false;
+    }
+
+    // Every slot free, no list alive and nothing to draw
+    std::vector<uint32_t> freeSlots(_capacity);
+    std::iota(freeSlots.begin(), freeSlots.end(), 0u);
+    const uint32_t counters[4] = {0, 0, _capacity, 0};
+    const bool written =
+        queue->writeBuffer(_deadList, 0, std::as_bytes(std::span<const uint32_t>(freeSlots))) &&
+        queue->writeBuffer(_counters, 0, asBytes(counters)) &&
+        queue->writeBuffer(_drawArgs, 0, asBytes(DrawIndirectArgs{6, 0, 0, 0}));
+    if (!written) {
+        LOG_ERROR("GpuParticleSystem", "Failed to reset particle buffers");
+        return false;
+    }
+    _parity = 0;
+    return true;
+}
+
+std::shared_ptr<IBuffer> GpuParticleSystem::getParticles() const {
+    return _particles;
+}
+
+std::shared_ptr<IBuffer> GpuParticleSystem::getAliveList() const {
+    return _aliveList;
+}
+
+std::shared_ptr<IBuffer> GpuParticleSystem::getDrawArgs() const {
+    return _drawArgs;
+}
+
+std::shared_ptr<IRenderPipeline> GpuParticleSystem::getPipeline(const Target& target) {
+    for (const PipelineEntry& entry : _pipelines) {
+        if (entry.target == target) {
+            return entry.pipeline;
+        }
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _renderLayout;
+    desc.primitive.topology = PrimitiveTopology::TriangleList;
+
+    // Sprites are cut out, so they can write depth like opaque geometry
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = true;
+    desc.depthStencil.depthCompare = CompareFunction::LessEqual;
+    desc.multisample.count = target.sampleCount;
+    desc.multisample.alphaToCoverageEnabled = target.sampleCount > 1;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+    desc.debugName = "GpuParticleSystem";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("GpuParticleSystem", "Failed to create particle pipeline");
+        return nullptr;
+    }
+
+    _pipelines.push_back({target, pipeline});
+    return pipeline;
+}
+
+} // namespace pers
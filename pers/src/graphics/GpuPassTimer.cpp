@@ -0,0 +1,162 @@
+#include "pers/graphics/GpuPassTimer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace pers {
+
+GpuPassTimer::GpuPassTimer(const std::shared_ptr<ILogicalDevice>& device, uint32_t maxPasses)
+    : _maxPasses(maxPasses) {
+    if (!device || maxPasses == 0) {
+        LOG_ERROR("GpuPassTimer", "Created with null device or zero passes");
+        return;
+    }
+
+    QuerySetDesc querySetDesc;
+    querySetDesc.type = QueryType::Timestamp;
+    querySetDesc.count = maxPasses * 2;
+    querySetDesc.label = "GpuPassTimer";
+    _querySet = device->getResourceFactory()->createQuerySet(querySetDesc);
+    if (!_querySet) {
+        LOG_INFO("GpuPassTimer", "Timestamp queries unavailable, GPU pass timing disabled");
+        return;
+    }
+
+    const uint64_t resultSize = static_cast<uint64_t>(querySetDesc.count) * QUERY_RESULT_SIZE;
+    _resolveBuffer = std::make_shared<DeviceBuffer>();
+    if (!_resolveBuffer->create(resultSize, DeviceBufferUsage::QueryResolve | DeviceBufferUsage::CopySrc,
+                                device, "GpuPassTimer Resolve")) {
+        LOG_ERROR("GpuPassTimer", "Failed to create query resolve buffer");
+        _querySet.reset();
+        _resolveBuffer.reset();
+        return;
+    }
+
+    auto readback = std::make_unique<ReadbackRing>(device, resultSize, ReadbackRing::DEFAULT_SLOT_COUNT,
+                                                   "GpuPassTimer Readback");
+    if (readback->getSlotCount() == 0) {
+        _querySet.reset();
+        _resolveBuffer.reset();
+        return;
+    }
+    _readback = std::move(readback);
+    _frameNames.reserve(maxPasses);
+}
+
+GpuPassTimer::~GpuPassTimer() = default;
+
+void GpuPassTimer::beginFrame() {
+    ++_frameIndex;
+    _frameNames.clear();
+}
+
+PassTimestampWrites GpuPassTimer::timestampWrites(const std::string& name) {
+    if (!isActive()) {
+        return {};
+    }
+
+    if (_frameNames.size() >= _maxPasses) {
+        LOG_WARNING_FMT("GpuPassTimer", "More than {} timed passes this frame, '{}' not timed", _maxPasses, name);
+        return {};
+    }
+
+    const uint32_t index = static_cast<uint32_t>(_frameNames.size());
+    _frameNames.push_back(name);
+
+    PassTimestampWrites writes;
+    writes.querySet = _querySet;
+    writes.beginIndex = index * 2;
+    writes.endIndex = index * 2 + 1;
+    return writes;
+}
+
+bool GpuPassTimer::resolve(const std::shared_ptr<ICommandEncoder>& encoder) {
+    if (!isActive() || _frameNames.empty()) {
+        return false;
+    }
+
+    const uint32_t queryCount = static_cast<uint32_t>(_frameNames.size()) * 2;
+    if (!encoder || !encoder->resolveQuerySet(_querySet, 0, queryCount, _resolveBuffer)) {
+        _frameNames.clear();
+        return false;
+    }
+
+    // A dropped readback loses this frame's timings only
+    BufferCopyDesc copy;
+    copy.size = static_cast<uint64_t>(queryCount) * QUERY_RESULT_SIZE;
+    uint64_t ticket = _readback->enqueue(encoder, _resolveBuffer, copy);
+    if (ticket == 0) {
+        _frameNames.clear();
+        return false;
+    }
+
+    PendingFrame frame;
+    frame.ticket = ticket;
+    frame.frameIndex = _frameIndex;
+    frame.names = std::move(_frameNames);
+    _pending.push_back(std::move(frame));
+    _frameNames.clear();
+    return true;
+}
+
+void GpuPassTimer::submitted() {
+    if (_readback) {
+        _readback->submitted();
+    }
+}
+
+size_t GpuPassTimer::collect() {
+    if (!_readback) {
+        return 0;
+    }
+
+    return _readback->harvest([this](uint64_t ticket, const void* data, uint64_t size) {
+        // Tickets arrive in order; failed maps leave older frames behind
+        while (!_pending.empty() && _pending.front().ticket < ticket) {
+            _pending.pop_front();
+        }
+        if (_pending.empty() || _pending.front().ticket != ticket) {
+            return;
+        }
+
+        PendingFrame frame = std::move(_pending.front());
+        _pending.pop_front();
+
+        const uint64_t* timestamps = static_cast<const uint64_t*>(data);
+        const size_t passCount = std::min<size_t>(frame.names.size(), size / (2 * QUERY_RESULT_SIZE));
+
+        GpuFrameTiming report;
+        report.frameIndex = frame.frameIndex;
+        report.passes.reserve(passCount);
+        for (size_t i = 0; i < passCount; ++i) {
+            const uint64_t begin = timestamps[i * 2];
+            const uint64_t end = timestamps[i * 2 + 1];
+            GpuPassTiming pass;
+            pass.name = std::move(frame.names[i]);
+            // Timestamps are nanoseconds; a pass the GPU did not run or a clock reset reads as 0
+            pass.milliseconds = end > begin ? (end - begin) / 1e6 : 0.0;
+            report.totalMilliseconds += pass.milliseconds;
+            report.passes.push_back(std::move(pass));
+        }
+        _lastReport = std::move(report);
+    });
+}
+
+std::string GpuPassTimer::formatReport() const {
+    std::ostringstream out;
+    out << std::left << std::setw(32) << "Pass" << std::right << std::setw(12) << "GPU ms" << '\n';
+    out << std::fixed << std::setprecision(3);
+    for (const GpuPassTiming& pass : _lastReport.passes) {
+        out << std::left << std::setw(32) << pass.name << std::right << std::setw(12) << pass.milliseconds << '\n';
+    }
+    out << std::left << std::setw(32) << "Total" << std::right << std::setw(12) << _lastReport.totalMilliseconds << '\n';
+    return out.str();
+}
+
+} // namespace pers
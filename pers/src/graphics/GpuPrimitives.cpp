@@ -0,0 +1,753 @@
+#include "pers/graphics/GpuPrimitives.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+enum : uint32_t {
+    MODE_INCLUSIVE = 0,
+    MODE_EXCLUSIVE = 1,
+    MODE_CARRY = 2,       // Combination of everything before an element, its own head ignored
+};
+
+enum : uint32_t {
+    FLAG_SEGMENTED = 1,
+    FLAG_PREDICATE = 2,   // Inputs count as 1 when non-zero
+};
+
+// Radix ranking keeps RADIX 16-bit counters per invocation in workgroup memory
+constexpr uint32_t SHARED_BYTES_PER_INVOCATION = GpuPrimitives::RADIX * 2;
+constexpr uint32_t MIN_WORKGROUP_SIZE = GpuPrimitives::RADIX;
+constexpr uint32_t MAX_WORKGROUP_SIZE = 1024;  // Ranks are counted in 16 bits
+
+constexpr char COMMON_WGSL[] = R"(
+const MODE_INCLUSIVE: u32 = 0u;
+const MODE_EXCLUSIVE: u32 = 1u;
+const MODE_CARRY: u32 = 2u;
+const FLAG_SEGMENTED: u32 = 1u;
+const FLAG_PREDICATE: u32 = 2u;
+
+struct PrimitiveParams {
+    count: u32,
+    mode: u32,
+    shift: u32,
+    flags: u32,
+};
+
+@group(0) @binding(0) var<uniform> params: PrimitiveParams;
+)";
+
+using ParamsLayout = GpuStruct<GpuLayout::Std140, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(ParamsLayout::matchesWgsl(COMMON_WGSL, "PrimitiveParams"),
+              "PrimitiveParams no longer match the primitive shaders");
+
+constexpr char SCAN_BLOCKS[] = R"(
+@group(1) @binding(0) var<storage, read> scanInput: array<u32>;
+@group(1) @binding(1) var<storage, read> scanHeads: array<u32>;
+@group(1) @binding(2) var<storage, read_write> scanOutput: array<u32>;
+@group(1) @binding(3) var<storage, read_write> scanBlockSums: array<u32>;
+@group(1) @binding(4) var<storage, read_write> scanBlockHeads: array<u32>;
+
+var<workgroup> sharedValues: array<u32, WG>;
+var<workgroup> sharedHeads: array<u32, WG>;
+
+@compute @workgroup_size(WG)
+fn main(@builtin(workgroup_id) groupId: vec3<u32>, @builtin(local_invocation_index) localIndex: u32) {
+    let index = groupId.x * WG + localIndex;
+    let inRange = index < params.count;
+    var value = 0u;
+    var head = 0u;
+    if (inRange) {
+        value = scanInput[index];
+        if ((params.flags & FLAG_PREDICATE) != 0u) {
+            value = select(0u, 1u, value != 0u);
+        }
+        if ((params.flags & FLAG_SEGMENTED) != 0u) {
+            head = select(0u, 1u, scanHeads[index] != 0u);
+        }
+    }
+    sharedValues[localIndex] = value;
+    sharedHeads[localIndex] = head;
+    workgroupBarrier();
+
+    // Inclusive scan of (head, value) pairs; a head stops the sum from earlier elements
+    for (var offset = 1u; offset < WG; offset = offset << 1u) {
+        var v = sharedValues[localIndex];
+        var h = sharedHeads[localIndex];
+        if (localIndex >= offset) {
+            v = select(sharedValues[localIndex - offset] + v, v, h != 0u);
+            h = h | sharedHeads[localIndex - offset];
+        }
+        workgroupBarrier();
+        sharedValues[localIndex] = v;
+        sharedHeads[localIndex] = h;
+        workgroupBarrier();
+    }
+
+    var before = 0u;
+    if (localIndex > 0u) {
+        before = sharedValues[localIndex - 1u];
+    }
+    if (inRange) {
+        if (params.mode == MODE_INCLUSIVE) {
+            scanOutput[index] = sharedValues[localIndex];
+        } else if (params.mode == MODE_EXCLUSIVE) {
+            scanOutput[index] = select(before, 0u, head != 0u);
+        } else {
+            scanOutput[index] = before;
+        }
+    }
+    if (localIndex == WG - 1u) {
+        scanBlockSums[groupId.x] = sharedValues[localIndex];
+        scanBlockHeads[groupId.x] = sharedHeads[localIndex];
+    }
+}
+)";
+
+constexpr char ADD_CARRY[] = R"(
+@group(1) @binding(0) var<storage, read> carryHeads: array<u32>;
+@group(1) @binding(1) var<storage, read> carryValues: array<u32>;
+@group(1) @binding(2) var<storage, read_write> carryOutput: array<u32>;
+
+var<workgroup> sharedHeads: array<u32, WG>;
+
+@compute @workgroup_size(WG)
+fn main(@builtin(workgroup_id) groupId: vec3<u32>, @builtin(local_invocation_index) localIndex: u32) {
+    let index = groupId.x * WG + localIndex;
+    var head = 0u;
+    if ((params.flags & FLAG_SEGMENTED) != 0u && index < params.count) {
+        head = select(0u, 1u, carryHeads[index] != 0u);
+    }
+    sharedHeads[localIndex] = head;
+    workgroupBarrier();
+    for (var offset = 1u; offset < WG; offset = offset << 1u) {
+        var h = sharedHeads[localIndex];
+        if (localIndex >= offset) {
+            h = h | sharedHeads[localIndex - offset];
+        }
+        workgroupBarrier();
+        sharedHeads[localIndex] = h;
+        workgroupBarrier();
+    }
+
+    // The block's carry reaches an element unless a head lies between the block start and it
+    var blocked = sharedHeads[localIndex];
+    if (params.mode == MODE_CARRY) {
+        blocked = 0u;
+        if (localIndex > 0u) {
+            blocked = sharedHeads[localIndex - 1u];
+        }
+    }
+    if (index < params.count && blocked == 0u) {
+        carryOutput[index] = carryOutput[index] + carryValues[groupId.x];
+    }
+}
+)";
+
+constexpr char COMPACT_SCATTER[] = R"(
+@group(1) @binding(0) var<storage, read> compactInput: array<u32>;
+@group(1) @binding(1) var<storage, read> compactPredicates: array<u32>;
+@group(1) @binding(2) var<storage, read> compactIndices: array<u32>;
+@group(1) @binding(3) var<storage, read_write> compactOutput: array<u32>;
+@group(1) @binding(4) var<storage, read_write> compactCount: array<u32>;
+
+@compute @workgroup_size(WG)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let index = id.x;
+    if (params.count == 0u) {
+        if (index == 0u) {
+            compactCount[0] = 0u;
+        }
+        return;
+    }
+    if (index >= params.count) {
+        return;
+    }
+    let selected = compactPredicates[index] != 0u;
+    if (selected) {
+        compactOutput[compactIndices[index]] = compactInput[index];
+    }
+    if (index == params.count - 1u) {
+        compactCount[0] = compactIndices[index] + select(0u, 1u, selected);
+    }
+}
+)";
+
+constexpr char RADIX_HISTOGRAM[] = R"(
+@group(1) @binding(0) var<storage, read> sortKeys: array<u32>;
+@group(1) @binding(1) var<storage, read_write> sortHistogram: array<u32>;
+
+var<workgroup> sharedCounts: array<atomic<u32>, 16>;
+
+@compute @workgroup_size(WG)
+fn main(@builtin(workgroup_id) groupId: vec3<u32>, @builtin(num_workgroups) groupCount: vec3<u32>,
+        @builtin(local_invocation_index) localIndex: u32) {
+    if (localIndex < 16u) {
+        atomicStore(&sharedCounts[localIndex], 0u);
+    }
+    workgroupBarrier();
+    let index = groupId.x * WG + localIndex;
+    if (index < params.count) {
+        atomicAdd(&sharedCounts[(sortKeys[index] >> params.shift) & 15u], 1u);
+    }
+    workgroupBarrier();
+
+    // Digit-major, so one exclusive scan yields every block's base per digit
+    if (localIndex < 16u) {
+        sortHistogram[localIndex * groupCount.x + groupId.x] = atomicLoad(&sharedCounts[localIndex]);
+    }
+}
+)";
+
+constexpr char RADIX_SCATTER[] = R"(
+@group(1) @binding(0) var<storage, read> sortKeysIn: array<u32>;
+@group(1) @binding(1) var<storage, read> sortValuesIn: array<u32>;
+@group(1) @binding(2) var<storage, read> sortOffsets: array<u32>;
+@group(1) @binding(3) var<storage, read_write> sortKeysOut: array<u32>;
+@group(1) @binding(4) var<storage, read_write> sortValuesOut: array<u32>;
+
+// Sixteen 16-bit counters per invocation, two digits per component
+var<workgroup> sharedLow: array<vec4<u32>, WG>;
+var<workgroup> sharedHigh: array<vec4<u32>, WG>;
+
+@compute @workgroup_size(WG)
+fn main(@builtin(workgroup_id) groupId: vec3<u32>, @builtin(num_workgroups) groupCount: vec3<u32>,
+        @builtin(local_invocation_index) localIndex: u32) {
+    let index = groupId.x * WG + localIndex;
+    let inRange = index < params.count;
+    var key = 0u;
+    var digit = 0u;
+    var low = vec4<u32>(0u);
+    var high = vec4<u32>(0u);
+    if (inRange) {
+        key = sortKeysIn[index];
+        digit = (key >> params.shift) & 15u;
+        let bit = 1u << ((digit & 1u) * 16u);
+        if (digit < 8u) {
+            low[(digit >> 1u) & 3u] = bit;
+        } else {
+            high[(digit >> 1u) & 3u] = bit;
+        }
+    }
+    sharedLow[localIndex] = low;
+    sharedHigh[localIndex] = high;
+    workgroupBarrier();
+
+    // Inclusive scan of the one-hot counters ranks each key among equal digits before it
+    for (var offset = 1u; offset < WG; offset = offset << 1u) {
+        var l = sharedLow[localIndex];
+        var h = sharedHigh[localIndex];
+        if (localIndex >= offset) {
+            l = l + sharedLow[localIndex - offset];
+            h = h + sharedHigh[localIndex - offset];
+        }
+        workgroupBarrier();
+        sharedLow[localIndex] = l;
+        sharedHigh[localIndex] = h;
+        workgroupBarrier();
+    }
+
+    if (inRange) {
+        var counters = sharedLow[localIndex];
+        if (digit >= 8u) {
+            counters = sharedHigh[localIndex];
+        }
+        let rank = ((counters[(digit >> 1u) & 3u] >> ((digit & 1u) * 16u)) & 0xffffu) - 1u;
+        let destination = sortOffsets[digit * groupCount.x + groupId.x] + rank;
+        sortKeysOut[destination] = key;
+        if (params.flags != 0u) {
+            sortValuesOut[destination] = sortValuesIn[index];
+        }
+    }
+}
+)";
+
+constexpr char REDUCE_BLOCKS[] = R"(
+@group(1) @binding(0) var<storage, read> reduceInput: array<u32>;
+@group(1) @binding(1) var<storage, read_write> reduceOutput: array<u32>;
+
+var<workgroup> sharedValues: array<u32, WG>;
+
+// mode is the GpuReduceOp, flags the GpuScalarType; values travel as raw bits
+fn reduceIdentity() -> u32 {
+    if (params.mode == 1u) {
+        return select(select(0xffffffffu, 0x7fffffffu, params.flags == 1u), 0x7f800000u, params.flags == 2u);
+    }
+    if (params.mode == 2u) {
+        return select(select(0u, 0x80000000u, params.flags == 1u), 0xff800000u, params.flags == 2u);
+    }
+    return 0u;
+}
+
+fn reduceCombine(a: u32, b: u32) -> u32 {
+    if (params.flags == 1u) {
+        let x = bitcast<i32>(a);
+        let y = bitcast<i32>(b);
+        if (params.mode == 1u) {
+            return bitcast<u32>(min(x, y));
+        }
+        if (params.mode == 2u) {
+            return bitcast<u32>(max(x, y));
+        }
+        return bitcast<u32>(x + y);
+    }
+    if (params.flags == 2u) {
+        let x = bitcast<f32>(a);
+        let y = bitcast<f32>(b);
+        if (params.mode == 1u) {
+            return bitcast<u32>(min(x, y));
+        }
+        if (params.mode == 2u) {
+            return bitcast<u32>(max(x, y));
+        }
+        return bitcast<u32>(x + y);
+    }
+    if (params.mode == 1u) {
+        return min(a, b);
+    }
+    if (params.mode == 2u) {
+        return max(a, b);
+    }
+    return a + b;
+}
+
+@compute @workgroup_size(WG)
+fn main(@builtin(workgroup_id) groupId: vec3<u32>, @builtin(local_invocation_index) localIndex: u32) {
+    let index = groupId.x * WG + localIndex;
+    var value = reduceIdentity();
+    if (index < params.count) {
+        value = reduceInput[index];
+    }
+    sharedValues[localIndex] = value;
+    workgroupBarrier();
+    for (var stride = WG / 2u; stride > 0u; stride = stride >> 1u) {
+        if (localIndex < stride) {
+            sharedValues[localIndex] = reduceCombine(sharedValues[localIndex], sharedValues[localIndex + stride]);
+        }
+        workgroupBarrier();
+    }
+    if (localIndex == 0u) {
+        reduceOutput[groupId.x] = sharedValues[0];
+    }
+}
+)";
+
+struct KernelSource {
+    const char* code;
+    const char* bindings;  // 'r' read-only storage, 'w' read-write storage, per binding
+    const char* name;
+};
+
+constexpr KernelSource KERNELS[] = {
+    {SCAN_BLOCKS, "rrwww", "GpuPrimitives::ScanBlocks"},
+    {ADD_CARRY, "rrw", "GpuPrimitives::AddCarry"},
+    {COMPACT_SCATTER, "rrrww", "GpuPrimitives::CompactScatter"},
+    {RADIX_HISTOGRAM, "rw", "GpuPrimitives::RadixHistogram"},
+    {RADIX_SCATTER, "rrrww", "GpuPrimitives::RadixScatter"},
+    {REDUCE_BLOCKS, "rw", "GpuPrimitives::ReduceBlocks"},
+};
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(std::max<uint64_t>(size, 16), DeviceBufferUsage::Storage, device, name)) {
+        LOG_ERROR("GpuPrimitives", "Failed to create scratch buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+// A limit of 0 is unspecified and does not constrain
+uint32_t limitTo(uint32_t value, uint32_t limit) {
+    return limit > 0 ? std::min(value, limit) : value;
+}
+
+} // anonymous namespace
+
+GpuPrimitives::GpuPrimitives(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device) {
+    static_assert(std::size(KERNELS) == KernelCount, "Every kernel needs a source");
+    static_assert(ParamsLayout::SIZE == sizeof(Params) && ParamsLayout::offsetOf<3>() == offsetof(Params, flags),
+                  "Params must match the WGSL layout");
+
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("GpuPrimitives", "Device or resource factory is null");
+        return;
+    }
+
+    const DeviceLimits limits = device->getLimits();
+    uint32_t workgroupSize = std::min(config.maxWorkgroupSize, MAX_WORKGROUP_SIZE);
+    workgroupSize = limitTo(workgroupSize, limits.maxComputeInvocationsPerWorkgroup);
+    workgroupSize = limitTo(workgroupSize, limits.maxComputeWorkgroupSizeX);
+    workgroupSize = limitTo(workgroupSize, limits.maxComputeWorkgroupStorageSize / SHARED_BYTES_PER_INVOCATION);
+    _workgroupSize = std::bit_floor(workgroupSize);
+    if (_workgroupSize < MIN_WORKGROUP_SIZE) {
+        LOG_ERROR("GpuPrimitives", "Device limits allow no workgroup of at least 16 invocations");
+        return;
+    }
+
+    // Level 0 and every radix pass dispatch one workgroup per block of elements
+    uint64_t maxElements = std::max(config.maxElements, 1u);
+    if (limits.maxComputeWorkgroupsPerDimension > 0) {
+        maxElements = std::min<uint64_t>(maxElements, uint64_t(limits.maxComputeWorkgroupsPerDimension) * _workgroupSize);
+    }
+    if (limits.maxStorageBufferBindingSize > 0) {
+        maxElements = std::min<uint64_t>(maxElements, limits.maxStorageBufferBindingSize / sizeof(uint32_t));
+    }
+    if (maxElements < config.maxElements) {
+        LOG_WARNING("GpuPrimitives", "Config::maxElements exceeds the device limits and was lowered");
+    }
+    _maxElements = static_cast<uint32_t>(maxElements);
+    _scanCapacity = std::max(_maxElements, RADIX * blocks(_maxElements));
+
+    _parameters = std::make_unique<DynamicBuffer>();
+    if (!_parameters->create(config.parameterBufferSize, BufferUsage::Uniform, device, config.frameCount,
+                             "GpuPrimitives::Parameters")) {
+        LOG_ERROR("GpuPrimitives", "Failed to create parameter buffer");
+        return;
+    }
+
+    for (uint32_t size = blocks(_scanCapacity);; size = blocks(size)) {
+        Level level;
+        level.sums = createBuffer(device, uint64_t(size) * sizeof(uint32_t), "GpuPrimitives::BlockSums");
+        level.heads = createBuffer(device, uint64_t(size) * sizeof(uint32_t), "GpuPrimitives::BlockHeads");
+        level.carries = createBuffer(device, uint64_t(size) * sizeof(uint32_t), "GpuPrimitives::BlockCarries");
+        if (!level.sums || !level.heads || !level.carries) {
+            return;
+        }
+        _levels.push_back(std::move(level));
+        if (size <= 1) {
+            break;
+        }
+    }
+
+    const uint64_t elementBytes = uint64_t(_maxElements) * sizeof(uint32_t);
+    const uint64_t histogramBytes = uint64_t(RADIX) * blocks(_maxElements) * sizeof(uint32_t);
+    _indices = createBuffer(device, elementBytes, "GpuPrimitives::Indices");
+    _histogram = createBuffer(device, histogramBytes, "GpuPrimitives::Histogram");
+    _offsets = createBuffer(device, histogramBytes, "GpuPrimitives::Offsets");
+    _sortKeys = createBuffer(device, elementBytes, "GpuPrimitives::SortKeys");
+    _sortValues = createBuffer(device, elementBytes, "GpuPrimitives::SortValues");
+    _dummyRead = createBuffer(device, 16, "GpuPrimitives::Unused");
+    _dummyWrite = createBuffer(device, 16, "GpuPrimitives::Unused");
+    if (!_indices || !_histogram || !_offsets || !_sortKeys || !_sortValues || !_dummyRead || !_dummyWrite) {
+        return;
+    }
+
+    BindGroupLayoutDesc parameterLayoutDesc;
+    parameterLayoutDesc.debugName = "GpuPrimitives::Parameters";
+    parameterLayoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .hasDynamicOffset = true, .minBindingSize = sizeof(Params)},
+    };
+    _parameterLayout = factory->createBindGroupLayout(parameterLayoutDesc);
+    if (!_parameterLayout) {
+        LOG_ERROR("GpuPrimitives", "Failed to create parameter bind group layout");
+        return;
+    }
+
+    const std::string header = "const WG: u32 = " + std::to_string(_workgroupSize) + "u;\n" + COMMON_WGSL;
+    for (uint32_t kernel = 0; kernel < KernelCount; ++kernel) {
+        const KernelSource& source = KERNELS[kernel];
+
+        BindGroupLayoutDesc layoutDesc;
+        layoutDesc.debugName = source.name;
+        for (uint32_t binding = 0; source.bindings[binding] != '\0'; ++binding) {
+            layoutDesc.entries.push_back({.binding = binding, .visibility = ShaderStage::Compute,
+                                          .type = source.bindings[binding] == 'r' ? BindingType::ReadOnlyStorageBuffer
+                                                                                  : BindingType::StorageBuffer});
+        }
+        _layouts[kernel] = factory->createBindGroupLayout(layoutDesc);
+        if (!_layouts[kernel]) {
+            LOG_ERROR("GpuPrimitives", "Failed to create kernel bind group layout");
+            return;
+        }
+
+        ShaderModuleDesc shaderDesc;
+        shaderDesc.code = header + source.code;
+        shaderDesc.stage = ShaderStage::Compute;
+        shaderDesc.entryPoint = "main";
+        shaderDesc.debugName = source.name;
+        auto shader = factory->createShaderModule(shaderDesc);
+        if (!shader || !shader->isValid()) {
+            LOG_ERROR("GpuPrimitives", "Failed to create primitive shader");
+            return;
+        }
+
+        PipelineLayoutDesc pipelineLayoutDesc;
+        pipelineLayoutDesc.bindGroupLayouts = {_parameterLayout, _layouts[kernel]};
+        pipelineLayoutDesc.debugName = source.name;
+        auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+        if (!pipelineLayout) {
+            LOG_ERROR("GpuPrimitives", "Failed to create pipeline layout");
+            return;
+        }
+
+        ComputePipelineDesc pipelineDesc;
+        pipelineDesc.compute = shader;
+        pipelineDesc.layout = pipelineLayout;
+        pipelineDesc.debugName = source.name;
+        _pipelines[kernel] = factory->createComputePipeline(pipelineDesc);
+        if (!_pipelines[kernel]) {
+            LOG_ERROR("GpuPrimitives", "Failed to create primitive pipeline");
+            return;
+        }
+    }
+
+    _valid = true;
+}
+
+GpuPrimitives::~GpuPrimitives() = default;
+
+bool GpuPrimitives::exclusiveScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                                  const std::shared_ptr<IBuffer>& output, uint32_t count) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::exclusiveScan");
+    return checkCount(count, _maxElements) && scan(pass, input, nullptr, output, count, MODE_EXCLUSIVE, 0);
+}
+
+bool GpuPrimitives::inclusiveScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                                  const std::shared_ptr<IBuffer>& output, uint32_t count) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::inclusiveScan");
+    return checkCount(count, _maxElements) && scan(pass, input, nullptr, output, count, MODE_INCLUSIVE, 0);
+}
+
+bool GpuPrimitives::segmentedScan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                                  const std::shared_ptr<IBuffer>& heads, const std::shared_ptr<IBuffer>& output,
+                                  uint32_t count, bool inclusive) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::segmentedScan");
+    if (!heads) {
+        LOG_ERROR("GpuPrimitives", "Segmented scan needs a head flag buffer");
+        return false;
+    }
+    return checkCount(count, _maxElements) &&
+           scan(pass, input, heads, output, count, inclusive ? MODE_INCLUSIVE : MODE_EXCLUSIVE, FLAG_SEGMENTED);
+}
+
+bool GpuPrimitives::compact(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                            const std::shared_ptr<IBuffer>& predicates, const std::shared_ptr<IBuffer>& output,
+                            const std::shared_ptr<IBuffer>& selectedCount, uint32_t count) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::compact");
+    if (!checkCount(count, _maxElements)) {
+        return false;
+    }
+    if (count > 0 && !scan(pass, predicates, nullptr, _indices, count, MODE_EXCLUSIVE, FLAG_PREDICATE)) {
+        return false;
+    }
+    return dispatch(pass, CompactScatter, {count, 0, 0, 0}, {input, predicates, _indices, output, selectedCount},
+                    std::max(blocks(count), 1u));
+}
+
+bool GpuPrimitives::sortPairs(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& keys,
+                              const std::shared_ptr<IBuffer>& values, uint32_t count, uint32_t keyBits) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::sortPairs");
+    if (!checkCount(count, _maxElements)) {
+        return false;
+    }
+    if (count <= 1) {
+        return true;
+    }
+
+    // An even number of passes leaves the result back in the caller's buffers
+    const uint32_t digits = (std::clamp(keyBits, 1u, 32u) + RADIX_BITS - 1) / RADIX_BITS;
+    const uint32_t passes = (digits + 1) & ~1u;
+    const uint32_t groupCount = blocks(count);
+    const uint32_t valueFlag = values ? 1u : 0u;
+    for (uint32_t i = 0; i < passes; ++i) {
+        const bool forward = i % 2 == 0;
+        const std::shared_ptr<IBuffer> keysIn = forward ? keys : _sortKeys;
+        const std::shared_ptr<IBuffer> keysOut = forward ? _sortKeys : keys;
+        std::shared_ptr<IBuffer> valuesIn = _dummyRead;
+        std::shared_ptr<IBuffer> valuesOut = _dummyWrite;
+        if (values) {
+            valuesIn = forward ? values : _sortValues;
+            valuesOut = forward ? _sortValues : values;
+        }
+
+        const uint32_t shift = i * RADIX_BITS;
+        if (!dispatch(pass, RadixHistogram, {count, 0, shift, 0}, {keysIn, _histogram}, groupCount) ||
+            !scan(pass, _histogram, nullptr, _offsets, RADIX * groupCount, MODE_EXCLUSIVE, 0) ||
+            !dispatch(pass, RadixScatter, {count, 0, shift, valueFlag}, {keysIn, valuesIn, _offsets, keysOut, valuesOut},
+                      groupCount)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GpuPrimitives::reduce(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                           const std::shared_ptr<IBuffer>& output, uint32_t count, GpuReduceOp op,
+                           GpuScalarType type) {
+    PERS_PROFILE_SCOPE("GpuPrimitives::reduce");
+    if (!checkCount(count, _maxElements)) {
+        return false;
+    }
+
+    // Partials shrink by a workgroup per level until one block writes the result
+    const uint32_t mode = static_cast<uint32_t>(op);
+    const uint32_t flags = static_cast<uint32_t>(type);
+    std::shared_ptr<IBuffer> source = input;
+    uint32_t size = count;
+    for (size_t level = 0;; ++level) {
+        const uint32_t groupCount = std::max(blocks(size), 1u);
+        const std::shared_ptr<IBuffer> destination = groupCount == 1 ? output : _levels[level].sums;
+        if (!dispatch(pass, ReduceBlocks, {size, mode, 0, flags}, {source, destination}, groupCount)) {
+            return false;
+        }
+        if (groupCount == 1) {
+            return true;
+        }
+        source = destination;
+        size = groupCount;
+    }
+}
+
+bool GpuPrimitives::flush() {
+    return _parameters && _parameters->flush();
+}
+
+void GpuPrimitives::nextFrame() {
+    if (_parameters) {
+        _parameters->nextFrame();
+    }
+}
+
+bool GpuPrimitives::scan(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& input,
+                         const std::shared_ptr<IBuffer>& heads, const std::shared_ptr<IBuffer>& output,
+                         uint32_t count, uint32_t mode, uint32_t flags) {
+    if (!checkCount(count, _scanCapacity)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    const uint32_t segmented = flags & FLAG_SEGMENTED;
+    std::vector<uint32_t> sizes;  // Block totals at each level
+    for (uint32_t size = blocks(count);; size = blocks(size)) {
+        sizes.push_back(size);
+        if (size <= 1) {
+            break;
+        }
+    }
+
+    // Up-sweep: scan each block, then the block totals of the level below
+    if (!dispatch(pass, ScanBlocks, {count, mode, 0, flags},
+                  {input, segmented ? heads : _dummyRead, output, _levels[0].sums, _levels[0].heads}, sizes[0])) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < sizes.size(); ++i) {
+        const Level& level = _levels[i];
+        const Level& next = _levels[i + 1];
+        if (!dispatch(pass, ScanBlocks, {sizes[i], MODE_CARRY, 0, segmented},
+                      {level.sums, segmented ? level.heads : _dummyRead, level.carries, next.sums, next.heads},
+                      sizes[i + 1])) {
+            return false;
+        }
+    }
+
+    // Down-sweep: each level's prefixes are complete once the level above has been added
+    for (size_t i = sizes.size() - 1; i-- > 1;) {
+        const Level& level = _levels[i - 1];
+        if (!dispatch(pass, AddCarry, {sizes[i - 1], MODE_CARRY, 0, segmented},
+                      {segmented ? level.heads : _dummyRead, _levels[i].carries, level.carries}, sizes[i])) {
+            return false;
+        }
+    }
+    if (sizes.size() > 1) {
+        return dispatch(pass, AddCarry, {count, mode, 0, segmented},
+                        {segmented ? heads : _dummyRead, _levels[0].carries, output}, sizes[0]);
+    }
+    return true;
+}
+
+bool GpuPrimitives::dispatch(IComputePassEncoder& pass, Kernel kernel, const Params& params,
+                             const std::vector<std::shared_ptr<IBuffer>>& buffers, uint32_t workgroups) {
+    if (!isValid()) {
+        LOG_ERROR("GpuPrimitives", "Cannot record with invalid GPU primitives");
+        return false;
+    }
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("GpuPrimitives", "Device or resource factory is null");
+        return false;
+    }
+    for (const auto& buffer : buffers) {
+        if (!buffer) {
+            LOG_ERROR("GpuPrimitives", "Buffer is null");
+            return false;
+        }
+    }
+
+    const uint64_t parameterOffset = _parameters->write(params);
+    if (parameterOffset == BufferCopyDesc::WHOLE_SIZE) {
+        LOG_ERROR("GpuPrimitives", "Parameter buffer is full, dispatch dropped");
+        return false;
+    }
+
+    // Both groups come from the factory's cache, so repeated calls reuse them
+    BindGroupDesc parameterDesc;
+    parameterDesc.layout = _parameterLayout;
+    parameterDesc.debugName = "GpuPrimitives::Parameters";
+    parameterDesc.entries.resize(1);
+    parameterDesc.entries[0].binding = 0;
+    parameterDesc.entries[0].buffer = _parameters->getCurrentFrameBuffer();
+    parameterDesc.entries[0].size = sizeof(Params);
+
+    BindGroupDesc bufferDesc;
+    bufferDesc.layout = _layouts[kernel];
+    bufferDesc.debugName = KERNELS[kernel].name;
+    bufferDesc.entries.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        bufferDesc.entries[i].binding = static_cast<uint32_t>(i);
+        bufferDesc.entries[i].buffer = buffers[i];
+    }
+
+    auto parameterGroup = factory->createBindGroup(parameterDesc);
+    auto bufferGroup = factory->createBindGroup(bufferDesc);
+    if (!parameterGroup || !bufferGroup) {
+        LOG_ERROR("GpuPrimitives", "Failed to create bind groups");
+        return false;
+    }
+
+    const uint32_t dynamicOffset = static_cast<uint32_t>(parameterOffset);
+    pass.setPipeline(_pipelines[kernel]);
+    pass.setBindGroup(0, parameterGroup, {&dynamicOffset, 1});
+    pass.setBindGroup(1, bufferGroup);
+    pass.dispatch(workgroups);
+    return true;
+}
+
+bool GpuPrimitives::checkCount(uint32_t count, uint32_t capacity) const {
+    if (!isValid()) {
+        LOG_ERROR("GpuPrimitives", "Cannot record with invalid GPU primitives");
+        return false;
+    }
+    if (count > capacity) {
+        LOG_ERROR("GpuPrimitives", "Element count exceeds getMaxElements()");
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
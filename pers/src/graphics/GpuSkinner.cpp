@@ -0,0 +1,266 @@
+#include "pers/graphics/GpuSkinner.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+struct PaletteHeader {
+    uint32_t vertexCount;
+    uint32_t jointCount;
+    uint32_t padding[2];
+};
+
+constexpr char SKINNING_SHADER[] = R"(
+struct PaletteHeader {
+    vertexCount: u32,
+    jointCount: u32,
+    padding0: u32,
+    padding1: u32,
+};
+
+struct Palette {
+    header: PaletteHeader,
+    joints: array<mat4x4<f32>>,
+};
+
+// Vertices are read and written as words: vec3 members would pad the records to 16 bytes
+@group(0) @binding(0) var<storage, read> palette: Palette;
+@group(0) @binding(1) var<storage, read> bindPose: array<u32>;
+@group(0) @binding(2) var<storage, read_write> skinned: array<f32>;
+
+fn readVec3(base: u32) -> vec3<f32> {
+    return bitcast<vec3<f32>>(vec3<u32>(bindPose[base], bindPose[base + 1u], bindPose[base + 2u]));
+}
+
+@compute @workgroup_size(64)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let i = id.x;
+    if (i >= palette.header.vertexCount) {
+        return;
+    }
+
+    let source = i * 10u;
+    let joints = bindPose[source + 8u];
+    var weights = unpack4x8unorm(bindPose[source + 9u]);
+    weights /= max(dot(weights, vec4<f32>(1.0)), 1e-5);
+
+    let last = palette.header.jointCount - 1u;
+    let skin = palette.joints[min(joints & 0xFFu, last)] * weights.x +
+               palette.joints[min((joints >> 8u) & 0xFFu, last)] * weights.y +
+               palette.joints[min((joints >> 16u) & 0xFFu, last)] * weights.z +
+               palette.joints[min(joints >> 24u, last)] * weights.w;
+
+    let position = (skin * vec4<f32>(readVec3(source), 1.0)).xyz;
+    let normal = normalize((skin * vec4<f32>(readVec3(source + 3u), 0.0)).xyz);
+
+    let destination = i * 8u;
+    skinned[destination] = position.x;
+    skinned[destination + 1u] = position.y;
+    skinned[destination + 2u] = position.z;
+    skinned[destination + 3u] = normal.x;
+    skinned[destination + 4u] = normal.y;
+    skinned[destination + 5u] = normal.z;
+    skinned[destination + 6u] = bitcast<f32>(bindPose[source + 6u]);
+    skinned[destination + 7u] = bitcast<f32>(bindPose[source + 7u]);
+}
+)";
+
+using HeaderLayout = GpuStruct<GpuLayout::Std430, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(HeaderLayout::matchesWgsl(SKINNING_SHADER, "PaletteHeader"),
+              "PaletteHeader no longer matches the skinning shader");
+static_assert(HeaderLayout::SIZE == sizeof(PaletteHeader), "PaletteHeader must match the WGSL layout");
+static_assert(sizeof(SkinningVertex) == 10 * sizeof(uint32_t) && sizeof(SkinnedVertex) == 8 * sizeof(float),
+              "Vertex word counts must match the skinning shader");
+
+constexpr uint64_t JOINT_SIZE = 16 * sizeof(float);
+
+} // anonymous namespace
+
+GpuSkinner::GpuSkinner(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config)
+    , _paletteBindingSize(sizeof(PaletteHeader) + uint64_t(std::max(config.maxJoints, 1u)) * JOINT_SIZE) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("GpuSkinner", "Device or resource factory is null");
+        return;
+    }
+
+    if (config.paletteBufferSize < _paletteBindingSize) {
+        LOG_ERROR("GpuSkinner", "Palette buffer is smaller than one palette binding");
+        return;
+    }
+
+    _palettes = std::make_unique<DynamicBuffer>();
+    if (!_palettes->create(config.paletteBufferSize, BufferUsage::Storage, device, config.frameCount,
+                           "SkinningPalettes")) {
+        LOG_ERROR("GpuSkinner", "Failed to create palette buffer");
+        return;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = SKINNING_SHADER;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.entryPoint = "main";
+    shaderDesc.debugName = "Skinning";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("GpuSkinner", "Failed to create skinning shader");
+        return;
+    }
+
+    // The palette binds at a dynamic offset into the ring, so one bind group per mesh and slot
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "Skinning";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer,
+         .hasDynamicOffset = true, .minBindingSize = sizeof(PaletteHeader) + JOINT_SIZE},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("GpuSkinner", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "Skinning";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("GpuSkinner", "Failed to create pipeline layout");
+        return;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "Skinning";
+    _pipeline = factory->createComputePipeline(pipelineDesc);
+    if (!_pipeline) {
+        LOG_ERROR("GpuSkinner", "Failed to create skinning pipeline");
+    }
+}
+
+GpuSkinner::~GpuSkinner() = default;
+
+bool GpuSkinner::skin(IComputePassEncoder& pass, const std::shared_ptr<IBuffer>& bindPose,
+                      const std::shared_ptr<IBuffer>& output, uint32_t vertexCount, std::span<const Mat4> palette) {
+    PERS_PROFILE_SCOPE("GpuSkinner::skin");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !isValid()) {
+        LOG_ERROR("GpuSkinner", "Cannot skin with an invalid skinner");
+        return false;
+    }
+
+    if (vertexCount == 0) {
+        return true;
+    }
+
+    if (!bindPose || !output || palette.empty()) {
+        LOG_ERROR("GpuSkinner", "Bind pose, output and palette are required");
+        return false;
+    }
+
+    if (palette.size() > _config.maxJoints) {
+        LOG_ERROR("GpuSkinner", "Palette has more joints than Config::maxJoints");
+        return false;
+    }
+
+    if (bindPose->getSize() < uint64_t(vertexCount) * sizeof(SkinningVertex) ||
+        output->getSize() < uint64_t(vertexCount) * sizeof(SkinnedVertex)) {
+        LOG_ERROR("GpuSkinner", "Bind pose or output buffer is smaller than the vertex count");
+        return false;
+    }
+
+    if (!hasFlag(output->getUsage(), BufferUsage::Storage)) {
+        LOG_ERROR("GpuSkinner", "Output buffer needs Storage usage");
+        return false;
+    }
+
+    const uint64_t workgroups = (uint64_t(vertexCount) + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE;
+    if (workgroups > 65535) {
+        LOG_ERROR("GpuSkinner", "Mesh exceeds one dispatch dimension");
+        return false;
+    }
+
+    // The binding always spans maxJoints, so the slice must leave that much room in the slot
+    const uint64_t paletteBytes = sizeof(PaletteHeader) + palette.size() * JOINT_SIZE;
+    auto frameBuffer = _palettes->getCurrentFrameBuffer();
+    auto slice = _palettes->allocate(paletteBytes);
+    if (!slice.data || !frameBuffer || slice.offset + _paletteBindingSize > frameBuffer->getSize()) {
+        LOG_WARNING("GpuSkinner", "Palette buffer is full, mesh not skinned");
+        return false;
+    }
+
+    const PaletteHeader header = {vertexCount, static_cast<uint32_t>(palette.size()), {}};
+    std::memcpy(slice.data, &header, sizeof(header));
+    std::memcpy(static_cast<std::byte*>(slice.data) + sizeof(header), palette.data(), palette.size() * JOINT_SIZE);
+
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _bindGroupLayout;
+    bindGroupDesc.debugName = "Skinning";
+    bindGroupDesc.entries.resize(3);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = frameBuffer;
+    bindGroupDesc.entries[0].size = _paletteBindingSize;
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].buffer = bindPose;
+    bindGroupDesc.entries[1].size = uint64_t(vertexCount) * sizeof(SkinningVertex);
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].buffer = output;
+    bindGroupDesc.entries[2].size = uint64_t(vertexCount) * sizeof(SkinnedVertex);
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("GpuSkinner", "Failed to create skinning bind group");
+        return false;
+    }
+
+    const uint32_t dynamicOffset = static_cast<uint32_t>(slice.offset);
+    pass.setPipeline(_pipeline);
+    pass.setBindGroup(0, bindGroup, {&dynamicOffset, 1});
+    pass.dispatch(static_cast<uint32_t>(workgroups));
+    ++_dispatchCount;
+    return true;
+}
+
+bool GpuSkinner::flush() {
+    return _palettes && _palettes->flush();
+}
+
+void GpuSkinner::nextFrame() {
+    if (_palettes) {
+        _palettes->nextFrame();
+    }
+    _dispatchCount = 0;
+}
+
+VertexBufferLayout GpuSkinner::getVertexLayout() {
+    return {
+        .arrayStride = sizeof(SkinnedVertex),
+        .stepMode = VertexStepMode::Vertex,
+        .attributes = {
+            {VertexFormat::Float32x3, offsetof(SkinnedVertex, position), 0},
+            {VertexFormat::Float32x3, offsetof(SkinnedVertex, normal), 1},
+            {VertexFormat::Float32x2, offsetof(SkinnedVertex, uv), 2},
+        },
+    };
+}
+
+} // namespace pers
@@ -56,6 +56,60 @@ std::string GraphicsEnumStrings::toString(TextureFormat format) {
         case TextureFormat::Depth24PlusStencil8: return "Depth24PlusStencil8";
         case TextureFormat::Depth32Float: return "Depth32Float";
         
+        // Compressed formats
+        case TextureFormat::BC1RGBAUnorm: return "BC1RGBAUnorm";
+        case TextureFormat::BC1RGBAUnormSrgb: return "BC1RGBAUnormSrgb";
+        case TextureFormat::BC2RGBAUnorm: return "BC2RGBAUnorm";
+        case TextureFormat::BC2RGBAUnormSrgb: return "BC2RGBAUnormSrgb";
+        case TextureFormat::BC3RGBAUnorm: return "BC3RGBAUnorm";
+        case TextureFormat::BC3RGBAUnormSrgb: return "BC3RGBAUnormSrgb";
+        case TextureFormat::BC4RUnorm: return "BC4RUnorm";
+        case TextureFormat::BC4RSnorm: return "BC4RSnorm";
+        case TextureFormat::BC5RGUnorm: return "BC5RGUnorm";
+        case TextureFormat::BC5RGSnorm: return "BC5RGSnorm";
+        case TextureFormat::BC6HRGBUfloat: return "BC6HRGBUfloat";
+        case TextureFormat::BC6HRGBFloat: return "BC6HRGBFloat";
+        case TextureFormat::BC7RGBAUnorm: return "BC7RGBAUnorm";
+        case TextureFormat::BC7RGBAUnormSrgb: return "BC7RGBAUnormSrgb";
+        case TextureFormat::ETC2RGB8Unorm: return "ETC2RGB8Unorm";
+        case TextureFormat::ETC2RGB8UnormSrgb: return "ETC2RGB8UnormSrgb";
+        case TextureFormat::ETC2RGB8A1Unorm: return "ETC2RGB8A1Unorm";
+        case TextureFormat::ETC2RGB8A1UnormSrgb: return "ETC2RGB8A1UnormSrgb";
+        case TextureFormat::ETC2RGBA8Unorm: return "ETC2RGBA8Unorm";
+        case TextureFormat::ETC2RGBA8UnormSrgb: return "ETC2RGBA8UnormSrgb";
+        case TextureFormat::EACR11Unorm: return "EACR11Unorm";
+        case TextureFormat::EACR11Snorm: return "EACR11Snorm";
+        case TextureFormat::EACRG11Unorm: return "EACRG11Unorm";
+        case TextureFormat::EACRG11Snorm: return "EACRG11Snorm";
+        case TextureFormat::ASTC4x4Unorm: return "ASTC4x4Unorm";
+        case TextureFormat::ASTC4x4UnormSrgb: return "ASTC4x4UnormSrgb";
+        case TextureFormat::ASTC5x4Unorm: return "ASTC5x4Unorm";
+        case TextureFormat::ASTC5x4UnormSrgb: return "ASTC5x4UnormSrgb";
+        case TextureFormat::ASTC5x5Unorm: return "ASTC5x5Unorm";
+        case TextureFormat::ASTC5x5UnormSrgb: return "ASTC5x5UnormSrgb";
+        case TextureFormat::ASTC6x5Unorm: return "ASTC6x5Unorm";
+        case TextureFormat::ASTC6x5UnormSrgb: return "ASTC6x5UnormSrgb";
+        case TextureFormat::ASTC6x6Unorm: return "ASTC6x6Unorm";
+        case TextureFormat::ASTC6x6UnormSrgb: return "ASTC6x6UnormSrgb";
+        case TextureFormat::ASTC8x5Unorm: return "ASTC8x5Unorm";
+        case TextureFormat::ASTC8x5UnormSrgb: return "ASTC8x5UnormSrgb";
+        case TextureFormat::ASTC8x6Unorm: return "ASTC8x6Unorm";
+        case TextureFormat::ASTC8x6UnormSrgb: return "ASTC8x6UnormSrgb";
+        case TextureFormat::ASTC8x8Unorm: return "ASTC8x8Unorm";
+        case TextureFormat::ASTC8x8UnormSrgb: return "ASTC8x8UnormSrgb";
+        case TextureFormat::ASTC10x5Unorm: return "ASTC10x5Unorm";
+        case TextureFormat::ASTC10x5UnormSrgb: return "ASTC10x5UnormSrgb";
+        case TextureFormat::ASTC10x6Unorm: return "ASTC10x6Unorm";
+        case TextureFormat::ASTC10x6UnormSrgb: return "ASTC10x6UnormSrgb";
+        case TextureFormat::ASTC10x8Unorm: return "ASTC10x8Unorm";
+        case TextureFormat::ASTC10x8UnormSrgb: return "ASTC10x8UnormSrgb";
+        case TextureFormat::ASTC10x10Unorm: return "ASTC10x10Unorm";
+        case TextureFormat::ASTC10x10UnormSrgb: return "ASTC10x10UnormSrgb";
+        case TextureFormat::ASTC12x10Unorm: return "ASTC12x10Unorm";
+        case TextureFormat::ASTC12x10UnormSrgb: return "ASTC12x10UnormSrgb";
+        case TextureFormat::ASTC12x12Unorm: return "ASTC12x12Unorm";
+        case TextureFormat::ASTC12x12UnormSrgb: return "ASTC12x12UnormSrgb";
+        
         default: return "Unknown(" + std::to_string(static_cast<int>(format)) + ")";
     }
 }
@@ -94,6 +148,14 @@ std::string GraphicsEnumStrings::toString(DeviceFeature feature) {
         case DeviceFeature::RG11B10UfloatRenderable: return "RG11B10UfloatRenderable";
         case DeviceFeature::BGRA8UnormStorage: return "BGRA8UnormStorage";
         case DeviceFeature::Float32Filterable: return "Float32Filterable";
+        case DeviceFeature::MultiDrawIndirect: return "MultiDrawIndirect";
+        case DeviceFeature::TextureBindingArray: return "TextureBindingArray";
+        case DeviceFeature::BufferBindingArray: return "BufferBindingArray";
+        case DeviceFeature::NonUniformIndexing: return "NonUniformIndexing";
+        case DeviceFeature::PartiallyBoundBindingArray: return "PartiallyBoundBindingArray";
+        case DeviceFeature::MappablePrimaryBuffers: return "MappablePrimaryBuffers";
+        case DeviceFeature::PushConstants: return "PushConstants";
+        case DeviceFeature::MultiDrawIndirectCount: return "MultiDrawIndirectCount";
         default: return "Unknown(" + std::to_string(static_cast<int>(feature)) + ")";
     }
 }
@@ -0,0 +1,283 @@
+#include "pers/graphics/HiZPyramid.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <bit>
+
+namespace pers {
+
+namespace {
+
+// Level 0 rounds up, odd depth edges clamp so the last row/column is read twice
+constexpr char SEED_SHADER[] = R"(
+@group(0) @binding(0) var depthTexture: texture_depth_2d;
+@group(0) @binding(1) var destination: texture_storage_2d<r32float, write>;
+
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+
+    let maxCoord = vec2<i32>(textureDimensions(depthTexture)) - 1;
+    let base = vec2<i32>(id.xy) * 2;
+    let a = textureLoad(depthTexture, min(base, maxCoord), 0);
+    let b = textureLoad(depthTexture, min(base + vec2<i32>(1, 0), maxCoord), 0);
+    let c = textureLoad(depthTexture, min(base + vec2<i32>(0, 1), maxCoord), 0);
+    let d = textureLoad(depthTexture, min(base + vec2<i32>(1, 1), maxCoord), 0);
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(max(max(a, b), max(c, d)), 0.0, 0.0, 1.0));
+}
+)";
+
+constexpr char REDUCE_SHADER[] = R"(
+@group(0) @binding(0) var source: texture_2d<f32>;
+@group(0) @binding(1) var destination: texture_storage_2d<r32float, write>;
+
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+
+    // Mip sizes round down, so an odd source leaves a third row/column for the last texel
+    let sourceSize = vec2<i32>(textureDimensions(source));
+    var extent = vec2<i32>(2, 2);
+    if (id.x == size.x - 1u && (sourceSize.x & 1) == 1) {
+        extent.x = 3;
+    }
+    if (id.y == size.y - 1u && (sourceSize.y & 1) == 1) {
+        extent.y = 3;
+    }
+
+    let maxCoord = sourceSize - 1;
+    let base = vec2<i32>(id.xy) * 2;
+    var farthest = 0.0;
+    for (var y = 0; y < extent.y; y = y + 1) {
+        for (var x = 0; x < extent.x; x = x + 1) {
+            farthest = max(farthest, textureLoad(source, min(base + vec2<i32>(x, y), maxCoord), 0).r);
+        }
+    }
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(farthest, 0.0, 0.0, 1.0));
+}
+)";
+
+std::shared_ptr<IComputePipeline> createReducePipeline(IResourceFactory& factory, const char* code,
+                                                       TextureSampleType sourceType, const char* name,
+                                                       std::shared_ptr<IBindGroupLayout>& layout) {
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = code;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.debugName = name;
+    auto shader = factory.createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("HiZPyramid", "Failed to create pyramid shader");
+        return nullptr;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = name;
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::SampledTexture,
+         .sampleType = sourceType},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::StorageTexture,
+         .storageTextureFormat = TextureFormat::R32Float},
+    };
+    layout = factory.createBindGroupLayout(layoutDesc);
+    if (!layout) {
+        LOG_ERROR("HiZPyramid", "Failed to create bind group layout");
+        return nullptr;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {layout};
+    pipelineLayoutDesc.debugName = name;
+    auto pipelineLayout = factory.createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("HiZPyramid", "Failed to create pipeline layout");
+        return nullptr;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = name;
+    auto pipeline = factory.createComputePipeline(pipelineDesc);
+    if (!pipeline) {
+        LOG_ERROR("HiZPyramid", "Failed to create pyramid pipeline");
+    }
+    return pipeline;
+}
+
+std::shared_ptr<IBindGroup> createLevelBindGroup(IResourceFactory& factory,
+                                                 const std::shared_ptr<IBindGroupLayout>& layout,
+                                                 const std::shared_ptr<ITextureView>& source,
+                                                 const std::shared_ptr<ITextureView>& destination) {
+    BindGroupDesc desc;
+    desc.layout = layout;
+    desc.debugName = "HiZPyramid";
+    desc.entries.resize(2);
+    desc.entries[0].binding = 0;
+    desc.entries[0].textureView = source;
+    desc.entries[1].binding = 1;
+    desc.entries[1].textureView = destination;
+    return factory.createBindGroup(desc);
+}
+
+uint32_t dispatchCount(uint32_t size) {
+    return (size + HiZPyramid::WORKGROUP_SIZE - 1) / HiZPyramid::WORKGROUP_SIZE;
+}
+
+} // anonymous namespace
+
+HiZPyramid::HiZPyramid(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("HiZPyramid", "Resource factory is null");
+        return;
+    }
+
+    _seedPipeline = createReducePipeline(*factory, SEED_SHADER, TextureSampleType::Depth, "HiZPyramid::Seed",
+                                         _seedLayout);
+    if (!_seedPipeline) {
+        return;
+    }
+    _reducePipeline = createReducePipeline(*factory, REDUCE_SHADER, TextureSampleType::UnfilterableFloat,
+                                           "HiZPyramid::Reduce", _reduceLayout);
+}
+
+HiZPyramid::~HiZPyramid() = default;
+
+bool HiZPyramid::resize(uint32_t depthWidth, uint32_t depthHeight) {
+    auto factory = _factory.lock();
+    if (!factory) {
+        return false;
+    }
+
+    _texture.reset();
+    _view.reset();
+    _levelViews.clear();
+    _reduceBindGroups.clear();
+    _seedDepthView.reset();
+    _seedBindGroup.reset();
+    _depthWidth = depthWidth;
+    _depthHeight = depthHeight;
+    _width = (depthWidth + 1) / 2;
+    _height = (depthHeight + 1) / 2;
+
+    const uint32_t mipCount = static_cast<uint32_t>(std::bit_width(std::max(_width, _height)));
+
+    TextureDesc textureDesc;
+    textureDesc.width = _width;
+    textureDesc.height = _height;
+    textureDesc.mipLevelCount = mipCount;
+    textureDesc.format = TextureFormat::R32Float;
+    textureDesc.usage = TextureUsage::TextureBinding | TextureUsage::StorageBinding;
+    textureDesc.label = "HiZPyramid";
+    _texture = factory->createTexture(textureDesc);
+    if (!_texture) {
+        LOG_ERROR("HiZPyramid", "Failed to create pyramid texture");
+        return false;
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = TextureFormat::R32Float;
+    viewDesc.mipLevelCount = mipCount;
+    viewDesc.label = "HiZPyramid";
+    _view = factory->createTextureView(_texture, viewDesc);
+
+    viewDesc.mipLevelCount = 1;
+    viewDesc.label = "HiZPyramid::Level";
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+        viewDesc.baseMipLevel = mip;
+        auto levelView = factory->createTextureView(_texture, viewDesc);
+        if (!levelView) {
+            LOG_ERROR("HiZPyramid", "Failed to create pyramid level view");
+            _levelViews.clear();
+            return false;
+        }
+        _levelViews.push_back(std::move(levelView));
+    }
+
+    for (uint32_t mip = 1; mip < mipCount; ++mip) {
+        auto bindGroup = createLevelBindGroup(*factory, _reduceLayout, _levelViews[mip - 1], _levelViews[mip]);
+        if (!bindGroup) {
+            LOG_ERROR("HiZPyramid", "Failed to create reduce bind group");
+            _levelViews.clear();
+            _reduceBindGroups.clear();
+            return false;
+        }
+        _reduceBindGroups.push_back(std::move(bindGroup));
+    }
+    return _view != nullptr;
+}
+
+bool HiZPyramid::build(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& depthView) {
+    auto factory = _factory.lock();
+    if (!factory || !isValid()) {
+        LOG_ERROR("HiZPyramid", "Cannot build pyramid with invalid pyramid");
+        return false;
+    }
+
+    if (!depthView) {
+        LOG_ERROR("HiZPyramid", "Depth view is null");
+        return false;
+    }
+
+    uint32_t depthWidth = 0;
+    uint32_t depthHeight = 0;
+    depthView->getDimensions(depthWidth, depthHeight);
+    if (depthWidth == 0 || depthHeight == 0) {
+        return false;
+    }
+
+    if ((depthWidth != _depthWidth || depthHeight != _depthHeight || _levelViews.empty()) &&
+        !resize(depthWidth, depthHeight)) {
+        return false;
+    }
+
+    if (_seedDepthView.lock() != depthView) {
+        _seedBindGroup = createLevelBindGroup(*factory, _seedLayout, depthView, _levelViews[0]);
+        _seedDepthView = depthView;
+        if (!_seedBindGroup) {
+            LOG_ERROR("HiZPyramid", "Failed to create seed bind group");
+            return false;
+        }
+    }
+
+    ComputePassDesc passDesc;
+    passDesc.label = "HiZPyramid";
+    auto pass = encoder.beginComputePass(passDesc);
+    if (!pass) {
+        LOG_ERROR("HiZPyramid", "Failed to begin pyramid pass");
+        return false;
+    }
+
+    uint32_t width = _width;
+    uint32_t height = _height;
+    pass->setPipeline(_seedPipeline);
+    pass->setBindGroup(0, _seedBindGroup);
+    pass->dispatch(dispatchCount(width), dispatchCount(height));
+
+    pass->setPipeline(_reducePipeline);
+    for (const auto& bindGroup : _reduceBindGroups) {
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        pass->setBindGroup(0, bindGroup);
+        pass->dispatch(dispatchCount(width), dispatchCount(height));
+    }
+    pass->end();
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,588 @@
+#include "pers/graphics/Impostor.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/MipmapGenerator.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <span>
+
+namespace pers {
+
+namespace {
+
+using Vec3 = std::array<float, 3>;
+
+struct ViewUniforms {
+    float viewProjection[16];
+    float cameraPosition[3];
+    float radius;
+    float center[3];
+    uint32_t framesPerSide;
+    uint32_t hemisphere;
+    float alphaCutoff;
+    float frameInset;
+    uint32_t padding;
+};
+
+// Atlases larger than this exceed the guaranteed maxTextureDimension2D
+constexpr uint32_t MAX_ATLAS_SIZE = 8192;
+constexpr uint32_t MIN_FRAME_SIZE = 4;
+
+constexpr char TYPES_WGSL[] = R"(
+struct View {
+    viewProjection: mat4x4<f32>,
+    cameraPosition: vec3<f32>,
+    radius: f32,
+    center: vec3<f32>,
+    framesPerSide: u32,
+    hemisphere: u32,
+    alphaCutoff: f32,
+    frameInset: f32,
+    padding: u32,
+};
+
+struct Instance {
+    position: vec3<f32>,
+    scale: f32,
+    yaw: f32,
+    padding0: f32,
+    padding1: f32,
+    padding2: f32,
+};
+
+@group(0) @binding(0) var<uniform> view: View;
+@group(0) @binding(1) var<storage, read> instances: array<Instance>;
+@group(0) @binding(2) var atlas: texture_2d<f32>;
+@group(0) @binding(3) var atlasSampler: sampler;
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) uv0: vec2<f32>,
+    @location(1) uv1: vec2<f32>,
+    @location(2) uv2: vec2<f32>,
+    @location(3) @interpolate(flat) frame0: vec2<f32>,
+    @location(4) @interpolate(flat) frame1: vec2<f32>,
+    @location(5) @interpolate(flat) frame2: vec2<f32>,
+    @location(6) @interpolate(flat) weights: vec3<f32>,
+};
+)";
+
+constexpr char VERTEX_MAIN[] = R"(
+fn octahedralEncode(direction: vec3<f32>) -> vec2<f32> {
+    if (view.hemisphere != 0u) {
+        // Views from below the horizon use the horizon frames
+        let above = vec3<f32>(direction.x, max(direction.y, 0.0), direction.z);
+        let n = above / max(abs(above.x) + above.y + abs(above.z), 1e-6);
+        return vec2<f32>(n.x + n.z, n.z - n.x) * 0.5 + 0.5;
+    }
+    let n = direction / (abs(direction.x) + abs(direction.y) + abs(direction.z));
+    var xz = n.xz;
+    if (n.y < 0.0) {
+        xz = (1.0 - abs(n.zx)) * select(vec2<f32>(-1.0), vec2<f32>(1.0), n.xz >= vec2<f32>(0.0));
+    }
+    return xz * 0.5 + 0.5;
+}
+
+fn octahedralDecode(uv: vec2<f32>) -> vec3<f32> {
+    let g = uv * 2.0 - 1.0;
+    if (view.hemisphere != 0u) {
+        let xz = vec2<f32>(g.x - g.y, g.x + g.y) * 0.5;
+        return normalize(vec3<f32>(xz.x, 1.0 - abs(xz.x) - abs(xz.y), xz.y));
+    }
+    let y = 1.0 - abs(g.x) - abs(g.y);
+    var xz = g;
+    if (y < 0.0) {
+        xz = (1.0 - abs(g.yx)) * select(vec2<f32>(-1.0), vec2<f32>(1.0), g >= vec2<f32>(0.0));
+    }
+    return normalize(vec3<f32>(xz.x, y, xz.y));
+}
+
+// Same basis as ImpostorBaker::getViewProjection()
+fn frameRight(direction: vec3<f32>) -> vec3<f32> {
+    let up = select(vec3<f32>(0.0, 1.0, 0.0), vec3<f32>(0.0, 0.0, 1.0), abs(direction.y) > 0.999);
+    return normalize(cross(up, direction));
+}
+
+// Where the view ray through p crosses the plane of a frame, in atlas frame uv
+fn frameUv(p: vec3<f32>, viewDirection: vec3<f32>, frame: vec2<f32>) -> vec2<f32> {
+    let direction = octahedralDecode(frame / f32(view.framesPerSide - 1u));
+    let right = frameRight(direction);
+    let up = cross(direction, right);
+    let q = p - viewDirection * (dot(p, direction) / max(dot(viewDirection, direction), 0.1));
+    return vec2<f32>(0.5 + 0.5 * dot(q, right), 0.5 - 0.5 * dot(q, up));
+}
+
+@vertex
+fn main(@builtin(vertex_index) vertexIndex: u32, @builtin(instance_index) instanceIndex: u32) -> VertexOutput {
+    let instance = instances[instanceIndex];
+    let c = cos(instance.yaw);
+    let s = sin(instance.yaw);
+    let offset = view.center * instance.scale;
+    let center = instance.position + vec3<f32>(c * offset.x + s * offset.z, offset.y, c * offset.z - s * offset.x);
+
+    // The view direction in object space picks the frames, the quad faces the camera
+    let toCamera = normalize(view.cameraPosition - center);
+    let direction = vec3<f32>(c * toCamera.x - s * toCamera.z, toCamera.y, s * toCamera.x + c * toCamera.z);
+    let right = frameRight(direction);
+    let up = cross(direction, right);
+    let corner = vec2<f32>(f32((0x32u >> vertexIndex) & 1u), f32((0x2Cu >> vertexIndex) & 1u)) * 2.0 - 1.0;
+    let p = right * corner.x + up * corner.y;  // In bounding radii
+
+    // Blend the three frames of the grid triangle around the view direction
+    let last = f32(view.framesPerSide - 1u);
+    let grid = clamp(octahedralEncode(direction) * last, vec2<f32>(0.0), vec2<f32>(last));
+    let cell = min(floor(grid), vec2<f32>(last - 1.0));
+    let f = grid - cell;
+    var output: VertexOutput;
+    if (f.x + f.y < 1.0) {
+        output.frame0 = cell;
+        output.frame1 = cell + vec2<f32>(1.0, 0.0);
+        output.frame2 = cell + vec2<f32>(0.0, 1.0);
+        output.weights = vec3<f32>(1.0 - f.x - f.y, f.x, f.y);
+    } else {
+        output.frame0 = cell + vec2<f32>(1.0, 1.0);
+        output.frame1 = cell + vec2<f32>(0.0, 1.0);
+        output.frame2 = cell + vec2<f32>(1.0, 0.0);
+        output.weights = vec3<f32>(f.x + f.y - 1.0, 1.0 - f.x, 1.0 - f.y);
+    }
+    output.uv0 = frameUv(p, direction, output.frame0);
+    output.uv1 = frameUv(p, direction, output.frame1);
+    output.uv2 = frameUv(p, direction, output.frame2);
+
+    let local = p * view.radius * instance.scale;
+    let world = center + vec3<f32>(c * local.x + s * local.z, local.y, c * local.z - s * local.x);
+    output.position = view.viewProjection * vec4<f32>(world, 1.0);
+    return output;
+}
+)";
+
+constexpr char FRAGMENT_MAIN[] = R"(
+fn sampleFrame(frame: vec2<f32>, uv: vec2<f32>) -> vec4<f32> {
+    let inside = clamp(uv, vec2<f32>(view.frameInset), vec2<f32>(1.0 - view.frameInset));
+    return textureSample(atlas, atlasSampler, (frame + inside) / f32(view.framesPerSide));
+}
+
+@fragment
+fn main(input: VertexOutput) -> @location(0) vec4<f32> {
+    // Frames are premultiplied, so the blend fades the silhouettes into each other
+    let color = sampleFrame(input.frame0, input.uv0) * input.weights.x +
+                sampleFrame(input.frame1, input.uv1) * input.weights.y +
+                sampleFrame(input.frame2, input.uv2) * input.weights.z;
+    if (color.a < view.alphaCutoff) {
+        discard;
+    }
+    return vec4<f32>(color.rgb / color.a, color.a);
+}
+)";
+
+using ViewLayout = GpuStruct<GpuLayout::Std140, GpuMat4x4f, GpuVec3f, GpuF32, GpuVec3f, GpuU32, GpuU32, GpuF32, GpuF32,
+                             GpuU32>;
+static_assert(ViewLayout::matchesWgsl(TYPES_WGSL, "View"), "View no longer matches the impostor shaders");
+static_assert(ViewLayout::SIZE == sizeof(ViewUniforms) &&
+              ViewLayout::offsetOf<3>() == offsetof(ViewUniforms, center) &&
+              ViewLayout::offsetOf<5>() == offsetof(ViewUniforms, hemisphere),
+              "ViewUniforms must match the WGSL layout");
+
+using InstanceLayout = GpuStruct<GpuLayout::Std430, GpuVec3f, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32>;
+static_assert(InstanceLayout::matchesWgsl(TYPES_WGSL, "Instance"), "Instance no longer matches the impostor shaders");
+static_assert(InstanceLayout::SIZE == 32, "Instance must match the WGSL layout");
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create impostor shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+std::shared_ptr<DeviceBuffer> createBuffer(const std::shared_ptr<ILogicalDevice>& device, uint64_t size,
+                                           DeviceBufferUsage usage, const char* name) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, device, name)) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create impostor buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+template <typename T>
+std::span<const std::byte> asBytes(const T& value) {
+    return std::span<const std::byte>(reinterpret_cast<const std::byte*>(&value), sizeof(T));
+}
+
+float dot(const Vec3& a, const Vec3& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vec3 cross(const Vec3& a, const Vec3& b) {
+    return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+}
+
+Vec3 normalize(const Vec3& v) {
+    const float length = std::sqrt(dot(v, v));
+    return length > 0.0f ? Vec3{v[0] / length, v[1] / length, v[2] / length} : Vec3{0.0f, 1.0f, 0.0f};
+}
+
+} // anonymous namespace
+
+ImpostorBaker::ImpostorBaker(const std::shared_ptr<ILogicalDevice>& device)
+    : _device(device) {
+    if (!device) {
+        LOG_ERROR("ImpostorBaker", "Created with null device");
+    }
+}
+
+ImpostorBaker::~ImpostorBaker() = default;
+
+bool ImpostorBaker::bake(ICommandEncoder& encoder, const Config& config, const Vec3& center, float radius,
+                         const RecordFunction& record, ImpostorAtlas& atlas) {
+    PERS_PROFILE_SCOPE("ImpostorBaker::bake");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("ImpostorBaker", "Device or resource factory is null");
+        return false;
+    }
+    if (!record || !(radius > 0.0f) || config.framesPerSide < 2 || config.frameSize < MIN_FRAME_SIZE ||
+        !std::has_single_bit(config.frameSize)) {
+        LOG_ERROR("ImpostorBaker", "Baking needs a record function, a positive radius, at least 2x2 frames "
+                  "and a power-of-two frame size of at least 4");
+        return false;
+    }
+    const uint64_t atlasSize = uint64_t(config.framesPerSide) * config.frameSize;
+    if (atlasSize > MAX_ATLAS_SIZE) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ImpostorBaker", PERS_SOURCE_LOC,
+            "Atlas of %u frames of %u texels exceeds %u texels per side",
+            config.framesPerSide, config.frameSize, MAX_ATLAS_SIZE);
+        return false;
+    }
+
+    if (!_framebuffer || _framebuffer->getWidth() != config.frameSize ||
+        _framebuffer->getColorFormat(0) != config.colorFormat || _framebuffer->getDepthFormat() != config.depthFormat) {
+        OffscreenFramebufferConfig framebufferConfig;
+        framebufferConfig.width = config.frameSize;
+        framebufferConfig.height = config.frameSize;
+        framebufferConfig.colorFormats = {config.colorFormat};
+        framebufferConfig.depthFormat = config.depthFormat;
+        framebufferConfig.colorUsage = TextureUsage::RenderAttachment | TextureUsage::CopySrc;
+        auto framebuffer = std::make_unique<OffscreenFramebuffer>(factory, framebufferConfig);
+        if (!framebuffer->getColorAttachment(0)) {
+            LOG_ERROR("ImpostorBaker", "Failed to create bake target");
+            return false;
+        }
+        _framebuffer = std::move(framebuffer);
+    }
+
+    // Mips stop at 4 texels per frame, below that the frames bleed into each other
+    bool mipmaps = config.mipmaps && config.frameSize > MIN_FRAME_SIZE;
+    if (mipmaps && !MipmapGenerator::supportsFormat(config.colorFormat)) {
+        LOG_WARNING("ImpostorBaker", "Atlas format does not support generated mips, baking without");
+        mipmaps = false;
+    }
+    if (mipmaps && !_mipmapGenerator) {
+        _mipmapGenerator = std::make_unique<MipmapGenerator>(factory);
+    }
+
+    TextureDesc textureDesc;
+    textureDesc.width = static_cast<uint32_t>(atlasSize);
+    textureDesc.height = static_cast<uint32_t>(atlasSize);
+    textureDesc.format = config.colorFormat;
+    textureDesc.mipLevelCount = mipmaps ? std::countr_zero(config.frameSize) - 1 : 1;
+    textureDesc.usage = TextureUsage::TextureBinding | TextureUsage::CopyDst | TextureUsage::RenderAttachment;
+    textureDesc.label = config.label + "Atlas";
+    auto texture = factory->createTexture(textureDesc);
+    if (!texture) {
+        LOG_ERROR("ImpostorBaker", "Failed to create impostor atlas");
+        return false;
+    }
+
+    // One render pass per frame, each copied out before the next reuses the target
+    auto colorTexture = _framebuffer->getColorTexture(0);
+    for (uint32_t y = 0; y < config.framesPerSide; ++y) {
+        for (uint32_t x = 0; x < config.framesPerSide; ++x) {
+            View view;
+            view.index = y * config.framesPerSide + x;
+            view.frameX = x;
+            view.frameY = y;
+            view.direction = getFrameDirection(x, y, config.framesPerSide, config.hemisphere);
+            view.viewProjection = getViewProjection(view.direction, center, radius);
+            if (!record(encoder, *_framebuffer, view)) {
+                Logger::Instance().LogFormat(LogLevel::Error, "ImpostorBaker", PERS_SOURCE_LOC,
+                    "Recording impostor frame %u failed", view.index);
+                return false;
+            }
+
+            TextureCopyDesc copy;
+            copy.dstX = x * config.frameSize;
+            copy.dstY = y * config.frameSize;
+            copy.width = config.frameSize;
+            copy.height = config.frameSize;
+            if (!encoder.copyTextureToTexture(colorTexture, texture, copy)) {
+                LOG_ERROR("ImpostorBaker", "Failed to copy frame into the atlas");
+                return false;
+            }
+        }
+    }
+    if (mipmaps && !_mipmapGenerator->generate(encoder, texture)) {
+        LOG_ERROR("ImpostorBaker", "Failed to generate atlas mips");
+        return false;
+    }
+
+    atlas.texture = texture;
+    atlas.framesPerSide = config.framesPerSide;
+    atlas.frameSize = config.frameSize;
+    atlas.hemisphere = config.hemisphere;
+    atlas.center = center;
+    atlas.radius = radius;
+    return true;
+}
+
+ImpostorBaker::Vec3 ImpostorBaker::getFrameDirection(uint32_t x, uint32_t y, uint32_t framesPerSide, bool hemisphere) {
+    const float last = static_cast<float>(std::max(framesPerSide, 2u) - 1);
+    const float gx = static_cast<float>(x) / last * 2.0f - 1.0f;
+    const float gy = static_cast<float>(y) / last * 2.0f - 1.0f;
+    if (hemisphere) {
+        const float dx = (gx - gy) * 0.5f;
+        const float dz = (gx + gy) * 0.5f;
+        return normalize({dx, 1.0f - std::abs(dx) - std::abs(dz), dz});
+    }
+    const float dy = 1.0f - std::abs(gx) - std::abs(gy);
+    if (dy >= 0.0f) {
+        return normalize({gx, dy, gy});
+    }
+    return normalize({std::copysign(1.0f - std::abs(gy), gx), dy, std::copysign(1.0f - std::abs(gx), gy)});
+}
+
+ImpostorBaker::Mat4 ImpostorBaker::getViewProjection(const Vec3& direction, const Vec3& center, float radius) {
+    const Vec3 d = normalize(direction);
+    const Vec3 up0 = std::abs(d[1]) > 0.999f ? Vec3{0.0f, 0.0f, 1.0f} : Vec3{0.0f, 1.0f, 0.0f};
+    const Vec3 right = normalize(cross(up0, d));
+    const Vec3 up = cross(d, right);
+    const float invRadius = 1.0f / radius;
+    const float invDepth = 0.5f / radius;
+
+    // Rows x = right, y = up over the sphere; depth 0 at the side facing the viewer
+    Mat4 m{};
+    for (int i = 0; i < 3; ++i) {
+        m[i * 4 + 0] = right[i] * invRadius;
+        m[i * 4 + 1] = up[i] * invRadius;
+        m[i * 4 + 2] = -d[i] * invDepth;
+    }
+    m[12] = -dot(right, center) * invRadius;
+    m[13] = -dot(up, center) * invRadius;
+    m[14] = 0.5f + dot(d, center) * invDepth;
+    m[15] = 1.0f;
+    return m;
+}
+
+ImpostorRenderer::ImpostorRenderer(const std::shared_ptr<ILogicalDevice>& device, const ImpostorAtlas& atlas)
+    : ImpostorRenderer(device, atlas, Config{}) {
+}
+
+ImpostorRenderer::ImpostorRenderer(const std::shared_ptr<ILogicalDevice>& device, const ImpostorAtlas& atlas,
+                                   const Config& config)
+    : _device(device)
+    , _atlas(atlas)
+    , _config(config) {
+    _config.maxInstances = std::max(config.maxInstances, 1u);
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("ImpostorRenderer", "Device or resource factory is null");
+        return;
+    }
+    if (!atlas.texture || atlas.framesPerSide < 2 || atlas.frameSize == 0 || !(atlas.radius > 0.0f)) {
+        LOG_ERROR("ImpostorRenderer", "Impostor atlas is empty, bake it first");
+        return;
+    }
+
+    _viewBuffer = createBuffer(device, sizeof(ViewUniforms), DeviceBufferUsage::Uniform, "ImpostorView");
+    _instanceBuffer = createBuffer(device, uint64_t(_config.maxInstances) * sizeof(Instance),
+                                   DeviceBufferUsage::Storage, "ImpostorInstances");
+    if (!_viewBuffer || !_instanceBuffer) {
+        return;
+    }
+    _instances.reserve(std::min(_config.maxInstances, 4096u));
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = atlas.texture->getFormat();
+    viewDesc.mipLevelCount = atlas.texture->getMipLevelCount();
+    auto atlasView = factory->createTextureView(atlas.texture, viewDesc);
+    SamplerDesc samplerDesc;
+    samplerDesc.label = "ImpostorAtlas";
+    auto sampler = factory->createSampler(samplerDesc);
+    if (!atlasView || !sampler) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create atlas view or sampler");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "Impostor";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex | ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(ViewUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Vertex, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 3, .visibility = ShaderStage::Fragment, .type = BindingType::Sampler},
+    };
+    auto bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {bindGroupLayout};
+    pipelineLayoutDesc.debugName = "Impostor";
+    _layout = bindGroupLayout ? factory->createPipelineLayout(pipelineLayoutDesc) : nullptr;
+    if (!_layout) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create impostor layouts");
+        return;
+    }
+
+    _vertexShader = createShader(*factory, std::string(TYPES_WGSL) + VERTEX_MAIN, ShaderStage::Vertex,
+                                 "ImpostorVertex");
+    _fragmentShader = createShader(*factory, std::string(TYPES_WGSL) + FRAGMENT_MAIN, ShaderStage::Fragment,
+                                   "ImpostorFragment");
+    if (!_vertexShader || !_fragmentShader) {
+        return;
+    }
+
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = bindGroupLayout;
+    bindGroupDesc.debugName = "Impostor";
+    bindGroupDesc.entries.resize(4);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = _viewBuffer;
+    bindGroupDesc.entries[0].size = sizeof(ViewUniforms);
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].buffer = _instanceBuffer;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].textureView = atlasView;
+    bindGroupDesc.entries[3].binding = 3;
+    bindGroupDesc.entries[3].sampler = sampler;
+
+    // Created last, isValid() means everything is usable
+    _bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!_bindGroup) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create impostor bind group");
+    }
+}
+
+ImpostorRenderer::~ImpostorRenderer() = default;
+
+bool ImpostorRenderer::isDistant(const Vec3& position, float scale, const Vec3& cameraPosition) const {
+    const Vec3 offset{position[0] - cameraPosition[0], position[1] - cameraPosition[1],
+                      position[2] - cameraPosition[2]};
+    const float distance = _config.switchDistance * _atlas.radius * scale;
+    return dot(offset, offset) >= distance * distance;
+}
+
+bool ImpostorRenderer::add(const Vec3& position, float scale, float yaw) {
+    if (_instances.size() >= _config.maxInstances) {
+        return false;
+    }
+    Instance instance{};
+    instance.position[0] = position[0];
+    instance.position[1] = position[1];
+    instance.position[2] = position[2];
+    instance.scale = scale;
+    instance.yaw = yaw;
+    _instances.push_back(instance);
+    return true;
+}
+
+bool ImpostorRenderer::render(IRenderPassEncoder& pass, const Target& target, const Mat4& viewProjection,
+                              const Vec3& cameraPosition) {
+    PERS_PROFILE_SCOPE("ImpostorRenderer::render");
+    if (!isValid()) {
+        LOG_ERROR("ImpostorRenderer", "Cannot render invalid impostors");
+        return false;
+    }
+    if (_instances.empty()) {
+        return true;
+    }
+
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    auto pipeline = getPipeline(target);
+    if (!queue || !pipeline) {
+        return false;
+    }
+
+    ViewUniforms uniforms{};
+    std::copy(viewProjection.begin(), viewProjection.end(), uniforms.viewProjection);
+    std::copy(cameraPosition.begin(), cameraPosition.end(), uniforms.cameraPosition);
+    uniforms.radius = _atlas.radius;
+    std::copy(_atlas.center.begin(), _atlas.center.end(), uniforms.center);
+    uniforms.framesPerSide = _atlas.framesPerSide;
+    uniforms.hemisphere = _atlas.hemisphere ? 1u : 0u;
+    // Multisampled targets keep the soft edge as coverage
+    uniforms.alphaCutoff = target.sampleCount > 1 ? 1.0f / 255.0f : 0.5f;
+    uniforms.frameInset = 0.5f / static_cast<float>(_atlas.frameSize);
+    if (!queue->writeBuffer(_viewBuffer, 0, asBytes(uniforms)) ||
+        !queue->writeBuffer(_instanceBuffer, 0, std::as_bytes(std::span<const Instance>(_instances)))) {
+        LOG_ERROR("ImpostorRenderer", "Failed to write impostor instances");
+        return false;
+    }
+
+    pass.setPipeline(pipeline);
+    pass.setBindGroup(0, _bindGroup);
+    pass.draw(6, static_cast<uint32_t>(_instances.size()));
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> ImpostorRenderer::getPipeline(const Target& target) {
+    for (const PipelineEntry& entry : _pipelines) {
+        if (entry.target == target) {
+            return entry.pipeline;
+        }
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _layout;
+    desc.primitive.topology = PrimitiveTopology::TriangleList;
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = true;
+    desc.depthStencil.depthCompare = CompareFunction::Less;
+    desc.multisample.count = target.sampleCount;
+    desc.multisample.alphaToCoverageEnabled = target.sampleCount > 1;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+    desc.debugName = "Impostor";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("ImpostorRenderer", "Failed to create impostor pipeline");
+        return nullptr;
+    }
+
+    _pipelines.push_back({target, pipeline});
+    return pipeline;
+}
+
+} // namespace pers
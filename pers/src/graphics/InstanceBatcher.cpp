@@ -0,0 +1,185 @@
+#include "pers/graphics/InstanceBatcher.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+bool InstanceBatcher::GroupKey::operator==(const GroupKey& other) const {
+    return pipeline == other.pipeline && vertexBuffer == other.vertexBuffer &&
+           indexBuffer == other.indexBuffer && material == other.material &&
+           indexFormat == other.indexFormat && vertexSlot == other.vertexSlot &&
+           indexCount == other.indexCount && firstIndex == other.firstIndex &&
+           baseVertex == other.baseVertex;
+}
+
+size_t InstanceBatcher::GroupKeyHash::operator()(const GroupKey& key) const {
+    Fnv1aHasher hasher;
+    hasher.add(key.pipeline);
+    hasher.add(key.vertexBuffer);
+    hasher.add(key.indexBuffer);
+    hasher.add(key.material);
+    hasher.add(key.indexFormat);
+    hasher.add(key.vertexSlot);
+    hasher.add(key.indexCount);
+    hasher.add(key.firstIndex);
+    hasher.add(key.baseVertex);
+    return static_cast<size_t>(hasher.get());
+}
+
+InstanceBatcher::GroupKey InstanceBatcher::makeKey(const IRenderPipeline* pipeline,
+                                                   const InstanceMesh& mesh,
+                                                   const IBindGroup* material) {
+    GroupKey key;
+    key.pipeline = pipeline;
+    key.vertexBuffer = mesh.vertexBuffer.get();
+    key.indexBuffer = mesh.indexBuffer.get();
+    key.material = material;
+    key.indexFormat = mesh.indexFormat;
+    key.vertexSlot = mesh.vertexSlot;
+    key.indexCount = mesh.indexCount;
+    key.firstIndex = mesh.firstIndex;
+    key.baseVertex = mesh.baseVertex;
+    return key;
+}
+
+InstanceBatcher::InstanceBatcher(const std::shared_ptr<DynamicBuffer>& instanceBuffer,
+                                 uint32_t instanceStride,
+                                 uint32_t instanceSlot,
+                                 uint32_t materialGroupIndex)
+    : _instanceBuffer(instanceBuffer)
+    , _instanceStride(instanceStride)
+    , _instanceSlot(instanceSlot)
+    , _materialGroupIndex(materialGroupIndex) {
+    if (!instanceBuffer) {
+        LOG_ERROR("InstanceBatcher", "Instance buffer is null");
+    }
+    if (instanceStride == 0 || instanceStride % BufferAlignment::VERTEX_BUFFER_OFFSET != 0) {
+        LOG_ERROR("InstanceBatcher", "Instance stride must be a non-zero multiple of 4");
+    }
+}
+
+void InstanceBatcher::add(const std::shared_ptr<IRenderPipeline>& pipeline,
+                          const InstanceMesh& mesh,
+                          const std::shared_ptr<IBindGroup>& material,
+                          const void* instanceData) {
+    if (!pipeline || !mesh.vertexBuffer || !mesh.indexBuffer || !instanceData) {
+        LOG_ERROR("InstanceBatcher", "Draw needs a pipeline, vertex and index buffers and instance data");
+        return;
+    }
+
+    auto [it, inserted] = _groupIndex.try_emplace(makeKey(pipeline.get(), mesh, material.get()), _groups.size());
+    if (inserted) {
+        Group group;
+        group.pipeline = pipeline;
+        group.mesh = mesh;
+        group.material = material;
+        _groups.push_back(std::move(group));
+    }
+
+    Group& group = _groups[it->second];
+    const size_t offset = group.instanceData.size();
+    group.instanceData.resize(offset + _instanceStride);
+    std::memcpy(group.instanceData.data() + offset, instanceData, _instanceStride);
+    ++group.instanceCount;
+}
+
+uint32_t InstanceBatcher::record(IRenderPassEncoder& pass) {
+    _stats = {};
+    if (!_instanceBuffer || !_instanceBuffer->isValid()) {
+        LOG_ERROR("InstanceBatcher", "Instance buffer is not valid");
+        clear();
+        return 0;
+    }
+
+    // Group by pipeline, then material, so state changes only where they must
+    _drawOrder.clear();
+    for (size_t i = 0; i < _groups.size(); ++i) {
+        if (_groups[i].instanceCount > 0) {
+            _drawOrder.push_back(i);
+        }
+    }
+    std::sort(_drawOrder.begin(), _drawOrder.end(), [this](size_t a, size_t b) {
+        const Group& ga = _groups[a];
+        const Group& gb = _groups[b];
+        if (ga.pipeline != gb.pipeline) {
+            return ga.pipeline < gb.pipeline;
+        }
+        if (ga.material != gb.material) {
+            return ga.material < gb.material;
+        }
+        return ga.mesh.vertexBuffer < gb.mesh.vertexBuffer;
+    });
+
+    const auto frameBuffer = _instanceBuffer->getCurrentFrameBuffer();
+    const IRenderPipeline* boundPipeline = nullptr;
+    const IBindGroup* boundMaterial = nullptr;
+    const IBuffer* boundVertexBuffer = nullptr;
+    const IBuffer* boundIndexBuffer = nullptr;
+
+    for (size_t index : _drawOrder) {
+        Group& group = _groups[index];
+        _stats.instances += group.instanceCount;
+
+        auto slice = _instanceBuffer->allocate(group.instanceData.size(), BufferAlignment::VERTEX_BUFFER_OFFSET);
+        if (!slice.data) {
+            _stats.droppedInstances += group.instanceCount;
+            continue;
+        }
+        std::memcpy(slice.data, group.instanceData.data(), group.instanceData.size());
+
+        if (group.pipeline.get() != boundPipeline) {
+            pass.setPipeline(group.pipeline);
+            boundPipeline = group.pipeline.get();
+            boundMaterial = nullptr;
+        }
+        if (group.material && group.material.get() != boundMaterial) {
+            pass.setBindGroup(_materialGroupIndex, group.material);
+            boundMaterial = group.material.get();
+        }
+        if (group.mesh.vertexBuffer.get() != boundVertexBuffer) {
+            pass.setVertexBuffer(group.mesh.vertexSlot, group.mesh.vertexBuffer);
+            boundVertexBuffer = group.mesh.vertexBuffer.get();
+        }
+        if (group.mesh.indexBuffer.get() != boundIndexBuffer) {
+            pass.setIndexBuffer(group.mesh.indexBuffer, group.mesh.indexFormat);
+            boundIndexBuffer = group.mesh.indexBuffer.get();
+        }
+        pass.setVertexBuffer(_instanceSlot, frameBuffer, slice.offset, group.instanceData.size());
+        pass.drawIndexed(group.mesh.indexCount, group.instanceCount, group.mesh.firstIndex, group.mesh.baseVertex, 0);
+        ++_stats.draws;
+    }
+
+    if (_stats.droppedInstances > 0) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "InstanceBatcher", PERS_SOURCE_LOC,
+            "Instance buffer full, dropped %u instances", _stats.droppedInstances);
+    }
+
+    // Groups nobody drew this frame are gone from the scene, drop their references
+    if (_drawOrder.size() < _groups.size()) {
+        std::erase_if(_groups, [](const Group& group) { return group.instanceCount == 0; });
+        _groupIndex.clear();
+        for (size_t i = 0; i < _groups.size(); ++i) {
+            const Group& group = _groups[i];
+            _groupIndex.emplace(makeKey(group.pipeline.get(), group.mesh, group.material.get()), i);
+        }
+    }
+
+    clear();
+    return _stats.draws;
+}
+
+void InstanceBatcher::clear() {
+    // Keep groups and their capacity, steady scenes refill the same ones every frame
+    for (Group& group : _groups) {
+        group.instanceData.clear();
+        group.instanceCount = 0;
+    }
+}
+
+} // namespace pers
@@ -0,0 +1,242 @@
+#include "pers/graphics/MipmapGenerator.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+namespace {
+
+const char* FULLSCREEN_VERTEX_SHADER = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    // Single triangle covering the viewport
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+const char* DOWNSAMPLE_FRAGMENT_SHADER = R"(
+@group(0) @binding(0) var source: texture_2d<f32>;
+
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    // Odd source edges clamp, the last row/column is weighted slightly more
+    let maxCoord = vec2<i32>(textureDimensions(source)) - 1;
+    let base = vec2<i32>(position.xy) * 2;
+    let a = textureLoad(source, min(base, maxCoord), 0);
+    let b = textureLoad(source, min(base + vec2<i32>(1, 0), maxCoord), 0);
+    let c = textureLoad(source, min(base + vec2<i32>(0, 1), maxCoord), 0);
+    let d = textureLoad(source, min(base + vec2<i32>(1, 1), maxCoord), 0);
+    return (a + b + c + d) * 0.25;
+}
+)";
+
+} // anonymous namespace
+
+MipmapGenerator::MipmapGenerator(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("MipmapGenerator", "Resource factory is null");
+        return;
+    }
+
+    ShaderModuleDesc vertexDesc;
+    vertexDesc.code = FULLSCREEN_VERTEX_SHADER;
+    vertexDesc.stage = ShaderStage::Vertex;
+    vertexDesc.debugName = "MipmapGenerator::Vertex";
+    _vertexShader = factory->createShaderModule(vertexDesc);
+
+    ShaderModuleDesc fragmentDesc;
+    fragmentDesc.code = DOWNSAMPLE_FRAGMENT_SHADER;
+    fragmentDesc.stage = ShaderStage::Fragment;
+    fragmentDesc.debugName = "MipmapGenerator::Fragment";
+    _fragmentShader = factory->createShaderModule(fragmentDesc);
+
+    if (!_vertexShader || !_vertexShader->isValid() || !_fragmentShader || !_fragmentShader->isValid()) {
+        LOG_ERROR("MipmapGenerator", "Failed to create downsample shaders");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "MipmapGenerator";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::UnfilterableFloat},
+    };
+    auto bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!bindGroupLayout) {
+        LOG_ERROR("MipmapGenerator", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {bindGroupLayout};
+    pipelineLayoutDesc.debugName = "MipmapGenerator";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!_pipelineLayout) {
+        LOG_ERROR("MipmapGenerator", "Failed to create pipeline layout");
+        return;
+    }
+
+    _bindGroupLayout = bindGroupLayout;
+}
+
+MipmapGenerator::~MipmapGenerator() = default;
+
+bool MipmapGenerator::supportsFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::R8Unorm:
+        case TextureFormat::R16Float:
+        case TextureFormat::R16Unorm:
+        case TextureFormat::RG8Unorm:
+        case TextureFormat::R32Float:
+        case TextureFormat::RG16Float:
+        case TextureFormat::RG16Unorm:
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::RGB10A2Unorm:
+        case TextureFormat::RG11B10Ufloat:
+        case TextureFormat::RG32Float:
+        case TextureFormat::RGBA16Float:
+        case TextureFormat::RGBA16Unorm:
+        case TextureFormat::RGBA32Float:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MipmapGenerator::generate(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& texture, uint32_t baseMipLevel) {
+    auto factory = _factory.lock();
+    if (!factory || !isValid()) {
+        LOG_ERROR("MipmapGenerator", "Cannot generate mips with invalid generator");
+        return false;
+    }
+
+    if (!texture) {
+        LOG_ERROR("MipmapGenerator", "Texture is null");
+        return false;
+    }
+
+    const uint32_t mipCount = texture->getMipLevelCount();
+    if (baseMipLevel + 1 >= mipCount) {
+        return true;
+    }
+
+    if (texture->getDimension() != TextureDimension::D2 || texture->getSampleCount() != 1) {
+        LOG_ERROR("MipmapGenerator", "Only single-sampled 2D textures are supported");
+        return false;
+    }
+
+    const TextureFormat format = texture->getFormat();
+    if (!supportsFormat(format)) {
+        LOG_ERROR("MipmapGenerator", "Texture format does not support mip generation");
+        return false;
+    }
+
+    const TextureUsage required = TextureUsage::TextureBinding | TextureUsage::RenderAttachment;
+    if ((texture->getUsage() & required) != required) {
+        LOG_ERROR("MipmapGenerator", "Texture needs TextureBinding and RenderAttachment usage");
+        return false;
+    }
+
+    auto pipeline = getPipeline(format);
+    if (!pipeline) {
+        return false;
+    }
+
+    for (uint32_t layer = 0; layer < texture->getDepthOrArrayLayers(); ++layer) {
+        TextureViewDesc viewDesc;
+        viewDesc.format = format;
+        viewDesc.baseMipLevel = baseMipLevel;
+        viewDesc.baseArrayLayer = layer;
+        viewDesc.label = "MipmapGenerator::Level";
+        auto sourceView = factory->createTextureView(texture, viewDesc);
+
+        for (uint32_t mip = baseMipLevel + 1; mip < mipCount; ++mip) {
+            viewDesc.baseMipLevel = mip;
+            auto targetView = factory->createTextureView(texture, viewDesc);
+            if (!sourceView || !targetView) {
+                LOG_ERROR("MipmapGenerator", "Failed to create mip level view");
+                return false;
+            }
+
+            BindGroupDesc bindGroupDesc;
+            bindGroupDesc.layout = _bindGroupLayout;
+            bindGroupDesc.debugName = "MipmapGenerator";
+            bindGroupDesc.entries.resize(1);
+            bindGroupDesc.entries[0].binding = 0;
+            bindGroupDesc.entries[0].textureView = sourceView;
+            auto bindGroup = factory->createBindGroup(bindGroupDesc);
+            if (!bindGroup) {
+                LOG_ERROR("MipmapGenerator", "Failed to create bind group");
+                return false;
+            }
+
+            // Every texel is overwritten, nothing to load
+            RenderPassDesc passDesc;
+            passDesc.label = "MipmapGenerator";
+            RenderPassColorAttachment attachment;
+            attachment.view = targetView;
+            attachment.loadOp = LoadOp::Clear;
+            attachment.storeOp = StoreOp::Store;
+            passDesc.colorAttachments.push_back(attachment);
+
+            auto pass = encoder.beginRenderPass(passDesc);
+            if (!pass) {
+                LOG_ERROR("MipmapGenerator", "Failed to begin downsample pass");
+                return false;
+            }
+            pass->setPipeline(pipeline);
+            pass->setBindGroup(0, bindGroup);
+            pass->draw(3);
+            pass->end();
+
+            sourceView = targetView;
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> MipmapGenerator::getPipeline(TextureFormat format) {
+    auto it = _pipelines.find(format);
+    if (it != _pipelines.end()) {
+        return it->second;
+    }
+
+    auto factory = _factory.lock();
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _pipelineLayout;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = format;
+    desc.debugName = "MipmapGenerator";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("MipmapGenerator", "Failed to create downsample pipeline");
+        return nullptr;
+    }
+
+    _pipelines.emplace(format, pipeline);
+    return pipeline;
+}
+
+} // namespace pers
@@ -0,0 +1,132 @@
+#include "pers/graphics/ObjectDataBuffer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/utils/Logger.h"
+#include <cstring>
+
+namespace pers {
+
+ObjectDataBuffer::ObjectDataBuffer(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("ObjectDataBuffer", "Device or resource factory is null");
+        return;
+    }
+
+    if (config.capacity == 0 || config.objectSize == 0 || config.objectSize % 16 != 0) {
+        LOG_ERROR("ObjectDataBuffer", "Capacity must be non-zero and objectSize a multiple of 16");
+        return;
+    }
+
+    const uint64_t bytes = static_cast<uint64_t>(config.capacity) * config.objectSize;
+    if (!_buffer.create(bytes, DeviceBufferUsage::Storage, device, config.granularity,
+                        ShadowedDeviceBuffer::DEFAULT_MERGE_GAP, config.debugName)) {
+        LOG_ERROR("ObjectDataBuffer", "Failed to create object buffer");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = config.debugName;
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = config.visibility, .type = BindingType::ReadOnlyStorageBuffer,
+         .minBindingSize = config.objectSize},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+    if (!_layout) {
+        LOG_ERROR("ObjectDataBuffer", "Failed to create bind group layout");
+        return;
+    }
+
+    // The buffer never moves, so one bind group serves every draw
+    BindGroupDesc desc;
+    desc.layout = _layout;
+    desc.debugName = config.debugName;
+    desc.entries.resize(1);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = _buffer.getDeviceBuffer();
+    _bindGroup = factory->createBindGroup(desc);
+    if (!_bindGroup) {
+        LOG_ERROR("ObjectDataBuffer", "Failed to create bind group");
+    }
+}
+
+ObjectDataBuffer::~ObjectDataBuffer() = default;
+
+uint32_t ObjectDataBuffer::allocate(std::span<const std::byte> data) {
+    if (!isValid()) {
+        LOG_ERROR("ObjectDataBuffer", "Cannot allocate from an invalid object buffer");
+        return INVALID_INDEX;
+    }
+
+    if (data.size() > _config.objectSize) {
+        LOG_ERROR("ObjectDataBuffer", "Object data is larger than objectSize");
+        return INVALID_INDEX;
+    }
+
+    uint32_t id = INVALID_INDEX;
+    if (!_freeSlots.empty()) {
+        id = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else if (_live.size() < _config.capacity) {
+        id = static_cast<uint32_t>(_live.size());
+        _live.push_back(false);
+    } else {
+        LOG_WARNING("ObjectDataBuffer", "Object buffer is full");
+        return INVALID_INDEX;
+    }
+
+    // Zero the tail so a reused slot never shows the previous object's data
+    const uint64_t offset = static_cast<uint64_t>(id) * _config.objectSize;
+    uint8_t* record = _buffer.data() + offset;
+    if (!data.empty()) {
+        std::memcpy(record, data.data(), data.size());
+    }
+    std::memset(record + data.size(), 0, _config.objectSize - data.size());
+    _buffer.markDirty(offset, _config.objectSize);
+
+    _live[id] = true;
+    ++_objectCount;
+    return id;
+}
+
+bool ObjectDataBuffer::update(uint32_t id, std::span<const std::byte> data) {
+    if (!isLive(id)) {
+        LOG_ERROR("ObjectDataBuffer", "Object id is not allocated");
+        return false;
+    }
+
+    if (data.size() > _config.objectSize) {
+        LOG_ERROR("ObjectDataBuffer", "Object data is larger than objectSize");
+        return false;
+    }
+
+    return _buffer.write(static_cast<uint64_t>(id) * _config.objectSize, data.data(), data.size());
+}
+
+void ObjectDataBuffer::remove(uint32_t id) {
+    if (!isLive(id)) {
+        return;
+    }
+    _live[id] = false;
+    _freeSlots.push_back(id);
+    --_objectCount;
+}
+
+bool ObjectDataBuffer::upload() {
+    return isValid() && _buffer.upload();
+}
+
+bool ObjectDataBuffer::upload(UploadBatcher& batcher) {
+    return isValid() && _buffer.upload(batcher);
+}
+
+std::string ObjectDataBuffer::getShaderDeclarations(uint32_t group, const std::string& objectType) const {
+    return "@group(" + std::to_string(group) + ") @binding(0) var<storage, read> objects: array<" + objectType + ">;\n";
+}
+
+} // namespace pers
@@ -0,0 +1,220 @@
+#include "pers/graphics/ObjectPicker.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+uint32_t PickResult::getClosestId() const {
+    if (ids.empty()) {
+        return ObjectPicker::NO_OBJECT;
+    }
+
+    // Ties keep the first hit in row order, so repeated picks are stable
+    uint32_t closest = ObjectPicker::NO_OBJECT;
+    uint64_t closestDistance = UINT64_MAX;
+    for (uint32_t row = 0; row < height; ++row) {
+        for (uint32_t column = 0; column < width; ++column) {
+            const uint32_t id = ids[row * width + column];
+            if (id == ObjectPicker::NO_OBJECT) {
+                continue;
+            }
+            const int64_t dx = int64_t(x + column) - centerX;
+            const int64_t dy = int64_t(y + row) - centerY;
+            const uint64_t distance = uint64_t(dx * dx + dy * dy);
+            if (distance < closestDistance) {
+                closest = id;
+                closestDistance = distance;
+            }
+        }
+    }
+    return closest;
+}
+
+ObjectPicker::ObjectPicker(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("ObjectPicker", "Device or resource factory is null");
+        return;
+    }
+    if (config.maxRegionSize == 0) {
+        LOG_ERROR("ObjectPicker", "Maximum pick region must be non-zero");
+        return;
+    }
+
+    OffscreenFramebufferConfig framebufferConfig;
+    framebufferConfig.width = std::max(config.width, 1u);
+    framebufferConfig.height = std::max(config.height, 1u);
+    framebufferConfig.colorFormats = {ID_FORMAT};
+    framebufferConfig.depthFormat = config.depthFormat;
+    framebufferConfig.colorUsage = TextureUsage::RenderAttachment | TextureUsage::CopySrc;
+    _framebuffer = std::make_shared<OffscreenFramebuffer>(factory, framebufferConfig);
+    if (!_framebuffer->getColorAttachment(0)) {
+        LOG_ERROR("ObjectPicker", "Failed to create ID buffer");
+        return;
+    }
+
+    const uint64_t slotSize = uint64_t(getTextureReadbackRowPitch(ID_FORMAT, config.maxRegionSize)) *
+                              config.maxRegionSize;
+    auto readback = std::make_unique<ReadbackRing>(device, slotSize, std::max(config.slotCount, 1u),
+                                                   "ObjectPicker Readback");
+    if (readback->getSlotCount() > 0) {
+        _readback = std::move(readback);
+    }
+}
+
+ObjectPicker::~ObjectPicker() = default;
+
+bool ObjectPicker::resize(uint32_t width, uint32_t height) {
+    if (!isValid()) {
+        return false;
+    }
+    _config.width = std::max(width, 1u);
+    _config.height = std::max(height, 1u);
+    return _framebuffer->resize(_config.width, _config.height);
+}
+
+std::shared_ptr<IRenderPassEncoder> ObjectPicker::beginPass(ICommandEncoder& encoder) {
+    if (!isValid()) {
+        LOG_ERROR("ObjectPicker", "Cannot begin ID pass on invalid picker");
+        return nullptr;
+    }
+
+    RenderPassDesc passDesc;
+    passDesc.label = "ObjectPicker";
+    RenderPassColorAttachment attachment;
+    attachment.view = _framebuffer->getColorAttachment(0);
+    attachment.loadOp = LoadOp::Clear;
+    attachment.storeOp = StoreOp::Store;
+    attachment.clearColor = {static_cast<float>(NO_OBJECT), 0.0f, 0.0f, 0.0f};
+    passDesc.colorAttachments.push_back(attachment);
+
+    if (_framebuffer->hasDepthStencilAttachment()) {
+        auto depth = std::make_shared<RenderPassDepthStencilAttachment>();
+        depth->view = _framebuffer->getDepthStencilAttachment();
+        depth->depthLoadOp = LoadOp::Clear;
+        depth->depthStoreOp = StoreOp::Discard;
+        depth->depthClearValue = 1.0f;
+        passDesc.depthStencilAttachment = depth;
+    }
+
+    auto pass = encoder.beginRenderPass(passDesc);
+    if (!pass) {
+        LOG_ERROR("ObjectPicker", "Failed to begin ID pass");
+    }
+    return pass;
+}
+
+uint64_t ObjectPicker::pick(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y,
+                            uint32_t radius) {
+    const uint32_t side = std::min(radius * 2 + 1, _config.maxRegionSize);
+    const uint32_t half = side / 2;
+    const uint32_t left = x > half ? x - half : 0;
+    const uint32_t top = y > half ? y - half : 0;
+    return enqueue(encoder, left, top, side, side, x, y);
+}
+
+uint64_t ObjectPicker::pickRegion(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y,
+                                  uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return 0;
+    }
+    if (width > _config.maxRegionSize || height > _config.maxRegionSize) {
+        LOG_WARNING("ObjectPicker", "Pick region larger than Config::maxRegionSize was clipped");
+    }
+    return enqueue(encoder, x, y, width, height, x + width / 2, y + height / 2);
+}
+
+uint64_t ObjectPicker::enqueue(const std::shared_ptr<ICommandEncoder>& encoder, uint32_t x, uint32_t y,
+                               uint32_t width, uint32_t height, uint32_t centerX, uint32_t centerY) {
+    PERS_PROFILE_SCOPE("ObjectPicker::pick");
+    if (!isValid() || !encoder) {
+        return 0;
+    }
+
+    const uint32_t targetWidth = _framebuffer->getWidth();
+    const uint32_t targetHeight = _framebuffer->getHeight();
+    if (x >= targetWidth || y >= targetHeight) {
+        return 0;
+    }
+
+    PendingPick pending;
+    pending.result.x = x;
+    pending.result.y = y;
+    pending.result.width = std::min({width, _config.maxRegionSize, targetWidth - x});
+    pending.result.height = std::min({height, _config.maxRegionSize, targetHeight - y});
+    pending.result.centerX = centerX;
+    pending.result.centerY = centerY;
+    pending.bytesPerRow = getTextureReadbackRowPitch(ID_FORMAT, pending.result.width);
+
+    TextureReadbackDesc desc;
+    desc.originX = pending.result.x;
+    desc.originY = pending.result.y;
+    desc.width = pending.result.width;
+    desc.height = pending.result.height;
+    desc.bytesPerRow = pending.bytesPerRow;
+    pending.ticket = _readback->enqueueTexture(encoder, _framebuffer->getColorTexture(0), desc);
+    if (pending.ticket == 0) {
+        return 0;
+    }
+
+    pending.result.request = _nextRequest++;
+    _pending.push_back(std::move(pending));
+    return _pending.back().result.request;
+}
+
+void ObjectPicker::submitted() {
+    if (_readback) {
+        _readback->submitted();
+    }
+}
+
+size_t ObjectPicker::collect(const ResultCallback& callback) {
+    if (!_readback) {
+        return 0;
+    }
+
+    size_t delivered = 0;
+    _readback->harvest([&](uint64_t ticket, const void* data, uint64_t size) {
+        // Tickets arrive in order; failed maps leave older picks behind
+        while (!_pending.empty() && _pending.front().ticket < ticket) {
+            _pending.pop_front();
+        }
+        if (_pending.empty() || _pending.front().ticket != ticket) {
+            return;
+        }
+
+        PendingPick pending = std::move(_pending.front());
+        _pending.pop_front();
+
+        PickResult& result = pending.result;
+        const uint64_t rowBytes = uint64_t(result.width) * sizeof(uint32_t);
+        if (size < uint64_t(pending.bytesPerRow) * (result.height - 1) + rowBytes) {
+            return;
+        }
+        result.ids.resize(size_t(result.width) * result.height);
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (uint32_t row = 0; row < result.height; ++row) {
+            std::memcpy(result.ids.data() + size_t(row) * result.width, bytes + uint64_t(row) * pending.bytesPerRow,
+                        rowBytes);
+        }
+        if (callback) {
+            callback(result);
+        }
+        ++delivered;
+    });
+    return delivered;
+}
+
+uint64_t ObjectPicker::getDroppedCount() const {
+    return _readback ? _readback->getDroppedCount() : 0;
+}
+
+} // namespace pers
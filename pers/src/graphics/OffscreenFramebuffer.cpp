@@ -5,8 +5,10 @@ namespace pers {
 
 OffscreenFramebuffer::OffscreenFramebuffer(
     const std::shared_ptr<IResourceFactory>& factory,
-    const OffscreenFramebufferConfig& config)
+    const OffscreenFramebufferConfig& config,
+    const std::shared_ptr<TransientTexturePool>& texturePool)
     : _factory(factory)
+    , _texturePool(texturePool)
     , _config(config) {
     
     if (!factory) {
@@ -47,28 +49,15 @@ void OffscreenFramebuffer::createTextures() {
         textureDesc.sampleCount = _config.sampleCount;
         textureDesc.label = "OffscreenColorTexture" + std::to_string(i);
         
-        auto texture = _factory->createTexture(textureDesc);
-        if (!texture) {
+        PooledTexture color = acquireTexture(textureDesc, "OffscreenColorView" + std::to_string(i));
+        if (!color) {
             LOG_ERROR("OffscreenFramebuffer", 
                 "Failed to create color texture " + std::to_string(i));
             releaseTextures();
             return;
         }
-        _colorTextures.push_back(texture);
-        
-        // Create texture view
-        TextureViewDesc viewDesc;
-        viewDesc.format = _config.colorFormats[i];
-        viewDesc.label = "OffscreenColorView" + std::to_string(i);
-        
-        auto view = _factory->createTextureView(texture, viewDesc);
-        if (!view) {
-            LOG_ERROR("OffscreenFramebuffer", 
-                "Failed to create color texture view " + std::to_string(i));
-            releaseTextures();
-            return;
-        }
-        _colorViews.push_back(view);
+        _colorTextures.push_back(color.texture);
+        _colorViews.push_back(color.view);
     }
     
     // Create depth/stencil attachment if requested
@@ -81,24 +70,14 @@ void OffscreenFramebuffer::createTextures() {
         textureDesc.sampleCount = _config.sampleCount;
         textureDesc.label = "OffscreenDepthTexture";
         
-        _depthTexture = _factory->createTexture(textureDesc);
-        if (!_depthTexture) {
+        PooledTexture depth = acquireTexture(textureDesc, "OffscreenDepthView");
+        if (!depth) {
             LOG_ERROR("OffscreenFramebuffer", "Failed to create depth texture");
             releaseTextures();
             return;
         }
-        
-        // Create depth texture view
-        TextureViewDesc viewDesc;
-        viewDesc.format = _config.depthFormat;
-        viewDesc.label = "OffscreenDepthView";
-        
-        _depthView = _factory->createTextureView(_depthTexture, viewDesc);
-        if (!_depthView) {
-            LOG_ERROR("OffscreenFramebuffer", "Failed to create depth texture view");
-            releaseTextures();
-            return;
-        }
+        _depthTexture = depth.texture;
+        _depthView = depth.view;
     }
     
     LOG_DEBUG("OffscreenFramebuffer", 
@@ -107,7 +86,34 @@ void OffscreenFramebuffer::createTextures() {
         " color attachments, sampleCount=" + std::to_string(_config.sampleCount));
 }
 
+PooledTexture OffscreenFramebuffer::acquireTexture(const TextureDesc& desc, const std::string& viewLabel) {
+    if (_texturePool) {
+        return _texturePool->acquire(desc);
+    }
+    
+    PooledTexture result;
+    result.texture = _factory->createTexture(desc);
+    if (!result.texture) {
+        return {};
+    }
+    
+    TextureViewDesc viewDesc;
+    viewDesc.format = desc.format;
+    viewDesc.label = viewLabel;
+    result.view = _factory->createTextureView(result.texture, viewDesc);
+    return result;
+}
+
 void OffscreenFramebuffer::releaseTextures() {
+    if (_texturePool) {
+        for (size_t i = 0; i < _colorTextures.size() && i < _colorViews.size(); ++i) {
+            _texturePool->release(PooledTexture{_colorTextures[i], _colorViews[i]});
+        }
+        if (_depthTexture && _depthView) {
+            _texturePool->release(PooledTexture{_depthTexture, _depthView});
+        }
+    }
+    
     _colorTextures.clear();
     _colorViews.clear();
     _depthTexture.reset();
@@ -121,6 +127,13 @@ std::shared_ptr<ITextureView> OffscreenFramebuffer::getColorAttachment(uint32_t
     return _colorViews[index];
 }
 
+std::shared_ptr<ITexture> OffscreenFramebuffer::getColorTexture(uint32_t index) const {
+    if (index >= _colorTextures.size()) {
+        return nullptr;
+    }
+    return _colorTextures[index];
+}
+
 std::shared_ptr<ITextureView> OffscreenFramebuffer::getDepthStencilAttachment() const {
     return _depthView;
 }
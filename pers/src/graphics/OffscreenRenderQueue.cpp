@@ -0,0 +1,281 @@
+#include "pers/graphics/OffscreenRenderQueue.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+OffscreenRenderQueue::OffscreenRenderQueue(const std::shared_ptr<ILogicalDevice>& device,
+                                           uint32_t maxInFlight,
+                                           const std::shared_ptr<TransientTexturePool>& texturePool)
+    : _device(device)
+    , _texturePool(texturePool)
+    , _signal(std::make_shared<Signal>()) {
+    if (!device) {
+        LOG_ERROR("OffscreenRenderQueue", "Created with null device");
+        return;
+    }
+
+    _slots.reserve(std::max(1u, maxInFlight));
+    for (uint32_t i = 0; i < std::max(1u, maxInFlight); ++i) {
+        _slots.push_back(std::make_shared<Slot>());
+    }
+}
+
+OffscreenRenderQueue::~OffscreenRenderQueue() {
+    // Drop results nobody will collect; pending maps keep their slot alive
+    for (auto& slot : _slots) {
+        SlotState state = slot->state.load(std::memory_order_acquire);
+        if (state == SlotState::Ready || state == SlotState::Failed) {
+            recycle(*slot);
+        }
+    }
+}
+
+uint64_t OffscreenRenderQueue::submit(const OffscreenRenderJobDesc& desc,
+                                      const RecordFunction& record,
+                                      CompletionFunction onComplete) {
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("OffscreenRenderQueue", "Device expired");
+        return 0;
+    }
+
+    if (desc.width == 0 || desc.height == 0 || !record) {
+        LOG_ERROR("OffscreenRenderQueue", "Job needs a non-zero size and a record function");
+        return 0;
+    }
+
+    if (getTextureReadbackRowPitch(desc.colorFormat, desc.width) == 0) {
+        LOG_ERROR("OffscreenRenderQueue", "Color format cannot be read back");
+        return 0;
+    }
+
+    std::shared_ptr<Slot> slot = acquireSlot();
+    if (!slot) {
+        ++_stats.stalls;
+        if (!waitForSlot(DEFAULT_WAIT_TIMEOUT, false)) {
+            LOG_ERROR("OffscreenRenderQueue", "Timed out waiting for a free slot");
+            return 0;
+        }
+        poll();
+        slot = acquireSlot();
+        if (!slot) {
+            return 0;
+        }
+    }
+
+    if (!prepareSlot(*slot, desc)) {
+        return 0;
+    }
+
+    auto encoder = device->createCommandEncoder();
+    if (!encoder) {
+        LOG_ERROR("OffscreenRenderQueue", "Failed to create command encoder");
+        return 0;
+    }
+
+    if (!record(*encoder, *slot->framebuffer)) {
+        LOG_WARNING("OffscreenRenderQueue", "Record function aborted the job");
+        return 0;
+    }
+
+    TextureReadbackDesc readbackDesc;
+    readbackDesc.bytesPerRow = slot->bytesPerRow;
+    if (!encoder->downloadFromTexture(slot->framebuffer->getColorTexture(0), slot->readback, readbackDesc)) {
+        LOG_ERROR("OffscreenRenderQueue", "Failed to record color readback");
+        return 0;
+    }
+
+    auto commandBuffer = encoder->finish();
+    auto queue = device->getQueue();
+    if (!commandBuffer || !queue || !queue->submit(commandBuffer)) {
+        LOG_ERROR("OffscreenRenderQueue", "Failed to submit job");
+        return 0;
+    }
+
+    slot->jobId = ++_nextJobId;
+    slot->onComplete = std::move(onComplete);
+    slot->state.store(SlotState::MapPending, std::memory_order_release);
+    ++_stats.submitted;
+
+    // Capture the slot and signal, not the queue, so completion after destruction is safe
+    std::shared_ptr<Signal> signal = _signal;
+    bool started = slot->readback->mapAsync(MapMode::Read, {0, slot->readbackSize}, [slot, signal](MappedData mapped) {
+        {
+            std::lock_guard<std::mutex> lock(signal->mutex);
+            if (mapped.data()) {
+                slot->mapping = std::move(mapped);
+                slot->state.store(SlotState::Ready, std::memory_order_release);
+            } else {
+                slot->state.store(SlotState::Failed, std::memory_order_release);
+            }
+        }
+        signal->cv.notify_all();
+    });
+
+    if (!started) {
+        LOG_ERROR("OffscreenRenderQueue", "Failed to start readback map");
+        slot->state.store(SlotState::Failed, std::memory_order_release);
+    }
+
+    // Deliver whatever finished meanwhile so callbacks keep pace with submission
+    poll();
+    return slot->jobId;
+}
+
+size_t OffscreenRenderQueue::poll() {
+    // Oldest first so results arrive roughly in submission order
+    std::vector<Slot*> finished;
+    for (auto& slot : _slots) {
+        SlotState state = slot->state.load(std::memory_order_acquire);
+        if (state == SlotState::Ready || state == SlotState::Failed) {
+            finished.push_back(slot.get());
+        }
+    }
+    std::sort(finished.begin(), finished.end(),
+        [](const Slot* a, const Slot* b) { return a->jobId < b->jobId; });
+
+    size_t delivered = 0;
+    for (Slot* slot : finished) {
+        if (slot->state.load(std::memory_order_acquire) == SlotState::Ready) {
+            if (slot->onComplete) {
+                OffscreenImage image;
+                image.jobId = slot->jobId;
+                image.width = slot->desc.width;
+                image.height = slot->desc.height;
+                image.format = slot->desc.colorFormat;
+                image.bytesPerRow = slot->bytesPerRow;
+                image.data = slot->mapping.data();
+                image.size = slot->readbackSize;
+                slot->onComplete(image);
+            }
+            ++_stats.completed;
+            ++delivered;
+        } else {
+            Logger::Instance().LogFormat(LogLevel::Warning, "OffscreenRenderQueue", PERS_SOURCE_LOC,
+                "Job %llu failed to read back", static_cast<unsigned long long>(slot->jobId));
+            ++_stats.failed;
+        }
+        recycle(*slot);
+    }
+
+    return delivered;
+}
+
+bool OffscreenRenderQueue::waitIdle(std::chrono::milliseconds timeout) {
+    bool idle = waitForSlot(timeout, true);
+    poll();
+    return idle;
+}
+
+uint32_t OffscreenRenderQueue::getInFlightCount() const {
+    uint32_t count = 0;
+    for (const auto& slot : _slots) {
+        if (slot->state.load(std::memory_order_acquire) != SlotState::Free) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+std::shared_ptr<OffscreenRenderQueue::Slot> OffscreenRenderQueue::acquireSlot() {
+    for (auto& slot : _slots) {
+        if (slot->state.load(std::memory_order_acquire) == SlotState::Free) {
+            return slot;
+        }
+    }
+    return nullptr;
+}
+
+bool OffscreenRenderQueue::prepareSlot(Slot& slot, const OffscreenRenderJobDesc& desc) {
+    auto device = _device.lock();
+    const auto& factory = device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("OffscreenRenderQueue", "Failed to get resource factory");
+        return false;
+    }
+
+    // Keep the framebuffer when only the size changed, rebuild it for new formats
+    if (slot.framebuffer &&
+        (slot.framebuffer->getColorFormat(0) != desc.colorFormat ||
+         slot.framebuffer->getDepthFormat() != desc.depthFormat)) {
+        slot.framebuffer.reset();
+    }
+
+    if (!slot.framebuffer) {
+        OffscreenFramebufferConfig config;
+        config.width = desc.width;
+        config.height = desc.height;
+        config.colorFormats = {desc.colorFormat};
+        config.depthFormat = desc.depthFormat;
+        config.colorUsage = TextureUsage::RenderAttachment | TextureUsage::CopySrc;
+        slot.framebuffer = std::make_shared<OffscreenFramebuffer>(factory, config, _texturePool);
+    } else if (!slot.framebuffer->resize(desc.width, desc.height)) {
+        slot.framebuffer.reset();
+        LOG_ERROR("OffscreenRenderQueue", "Failed to resize job framebuffer");
+        return false;
+    }
+
+    if (!slot.framebuffer->getColorTexture(0)) {
+        slot.framebuffer.reset();
+        LOG_ERROR("OffscreenRenderQueue", "Failed to create job framebuffer");
+        return false;
+    }
+
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(desc.colorFormat);
+    slot.bytesPerRow = getTextureReadbackRowPitch(desc.colorFormat, desc.width);
+    slot.readbackSize = static_cast<uint64_t>(slot.bytesPerRow) * (desc.height - 1) +
+                        static_cast<uint64_t>(desc.width) * block.blockBytes;
+    // Buffer sizes must stay 4-byte aligned
+    slot.readbackSize = (slot.readbackSize + 3) & ~uint64_t(3);
+
+    if (!slot.readback || slot.readback->getSize() < slot.readbackSize) {
+        slot.readback = std::make_shared<DeferredStagingBuffer>();
+        std::string name = desc.label.empty() ? "OffscreenRenderQueue::Readback" : desc.label + "::Readback";
+        if (!slot.readback->create(slot.readbackSize, MapMode::Read, device, name)) {
+            slot.readback.reset();
+            LOG_ERROR("OffscreenRenderQueue", "Failed to create readback buffer");
+            return false;
+        }
+    }
+
+    slot.desc = desc;
+    return true;
+}
+
+bool OffscreenRenderQueue::waitForSlot(std::chrono::milliseconds timeout, bool all) {
+    auto done = [this, all]() {
+        uint32_t finished = 0;
+        uint32_t pending = 0;
+        for (const auto& slot : _slots) {
+            SlotState state = slot->state.load(std::memory_order_acquire);
+            if (state == SlotState::MapPending) {
+                ++pending;
+            } else {
+                ++finished;
+            }
+        }
+        return all ? pending == 0 : finished > 0;
+    };
+
+    std::unique_lock<std::mutex> lock(_signal->mutex);
+    return _signal->cv.wait_for(lock, timeout, done);
+}
+
+void OffscreenRenderQueue::recycle(Slot& slot) {
+    slot.mapping = MappedData{nullptr, 0, nullptr};
+    if (slot.readback && slot.readback->isMapped()) {
+        slot.readback->unmap();
+    }
+    slot.onComplete = nullptr;
+    slot.jobId = 0;
+    slot.state.store(SlotState::Free, std::memory_order_release);
+}
+
+} // namespace pers
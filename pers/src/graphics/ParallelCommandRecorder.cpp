@@ -0,0 +1,162 @@
+#include "pers/graphics/ParallelCommandRecorder.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+ParallelCommandRecorder::ParallelCommandRecorder(const std::shared_ptr<ILogicalDevice>& device, uint32_t workerCount)
+    : _device(device) {
+    if (!device) {
+        LOG_ERROR("ParallelCommandRecorder", "Created with null device");
+    }
+
+    if (workerCount == 0) {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    _workers.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        _workers.emplace_back(&ParallelCommandRecorder::workerLoop, this);
+    }
+}
+
+ParallelCommandRecorder::~ParallelCommandRecorder() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void ParallelCommandRecorder::drainBatch(const std::function<void(uint32_t)>& task, uint32_t count) {
+    uint32_t index;
+    while ((index = _nextIndex.fetch_add(1, std::memory_order_relaxed)) < count) {
+        task(index);
+    }
+}
+
+void ParallelCommandRecorder::workerLoop() {
+    uint64_t seenBatch = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [&] { return _stopping || (_task && _batchId != seenBatch); });
+        if (_stopping) {
+            return;
+        }
+        seenBatch = _batchId;
+
+        // Registered under the lock so the batch owner waits for us before clearing _task
+        const auto* task = _task;
+        const uint32_t count = _taskCount;
+        ++_activeWorkers;
+        lock.unlock();
+
+        drainBatch(*task, count);
+
+        lock.lock();
+        if (--_activeWorkers == 0) {
+            _done.notify_all();
+        }
+    }
+}
+
+void ParallelCommandRecorder::runParallel(uint32_t count, const std::function<void(uint32_t)>& task) {
+    std::lock_guard<std::mutex> batchLock(_batchMutex);
+
+    if (_workers.empty() || count <= 1) {
+        for (uint32_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _taskCount = count;
+        _nextIndex.store(0, std::memory_order_relaxed);
+        ++_batchId;
+    }
+    _wake.notify_all();
+
+    drainBatch(task, count);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _done.wait(lock, [&] { return _activeWorkers == 0; });
+    _task = nullptr;
+    _taskCount = 0;
+}
+
+std::vector<std::shared_ptr<ICommandBuffer>> ParallelCommandRecorder::record(std::span<const EncoderJob> jobs) {
+    std::vector<std::shared_ptr<ICommandBuffer>> results(jobs.size());
+
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("ParallelCommandRecorder", "Device is no longer available");
+        return results;
+    }
+
+    runParallel(static_cast<uint32_t>(jobs.size()), [&](uint32_t index) {
+        auto encoder = device->createCommandEncoder();
+        if (!encoder) {
+            return;
+        }
+        if (jobs[index]) {
+            jobs[index](*encoder, index);
+        }
+        results[index] = encoder->finish();
+    });
+    return results;
+}
+
+SubmissionFence ParallelCommandRecorder::recordAndSubmit(std::span<const EncoderJob> jobs) {
+    auto commandBuffers = record(jobs);
+
+    const auto failed = std::count(commandBuffers.begin(), commandBuffers.end(), nullptr);
+    if (failed > 0) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ParallelCommandRecorder", PERS_SOURCE_LOC,
+            "%d of %zu jobs failed to encode, nothing submitted", static_cast<int>(failed), commandBuffers.size());
+        return {};
+    }
+
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        LOG_ERROR("ParallelCommandRecorder", "No queue to submit to");
+        return {};
+    }
+    return queue->submit(commandBuffers);
+}
+
+std::vector<std::shared_ptr<IRenderBundle>> ParallelCommandRecorder::recordBundles(const RenderBundleEncoderDesc& desc,
+                                                                                   std::span<const BundleJob> jobs) {
+    std::vector<std::shared_ptr<IRenderBundle>> results(jobs.size());
+
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("ParallelCommandRecorder", "Device is no longer available");
+        return results;
+    }
+
+    runParallel(static_cast<uint32_t>(jobs.size()), [&](uint32_t index) {
+        auto encoder = device->createRenderBundleEncoder(desc);
+        if (!encoder) {
+            return;
+        }
+        if (jobs[index]) {
+            jobs[index](*encoder, index);
+        }
+        results[index] = encoder->finish();
+    });
+    return results;
+}
+
+} // namespace pers
@@ -0,0 +1,198 @@
+#include "pers/graphics/PerformanceHud.h"
+#include "pers/graphics/BindGroupCache.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/PipelineCache.h"
+#include "pers/graphics/SamplerCache.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace pers {
+
+namespace {
+
+constexpr float LINE_HEIGHT = 9.0f;  // DebugDraw font line advance, in font texels
+constexpr uint32_t TEXT_COLOR = DebugDraw::rgba(255, 255, 255);
+constexpr uint32_t CPU_COLOR = DebugDraw::rgba(80, 220, 80);
+constexpr uint32_t GPU_COLOR = DebugDraw::rgba(240, 170, 40);
+constexpr uint32_t FRAME_COLOR = DebugDraw::rgba(128, 128, 128);
+constexpr uint32_t TARGET_COLOR = DebugDraw::rgba(200, 60, 60);
+
+double hitRate(uint64_t hits, uint64_t misses) {
+    const uint64_t lookups = hits + misses;
+    return lookups > 0 ? 100.0 * static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+}
+
+double toMiB(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // anonymous namespace
+
+PerformanceHud::PerformanceHud(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _debugDraw(device, DebugDraw::Config{})
+    , _config(config)
+    , _drawCounter(Metrics::counter("pers_draw_calls_total"))
+    , _submitCounter(Metrics::counter("pers_queue_submits_total"))
+    , _writeBytesCounter(Metrics::counter("pers_buffer_write_bytes_total"))
+    , _stagingBytesCounter(Metrics::counter("pers_staging_upload_bytes_total")) {
+    _counterTotals.draws = _drawCounter.value();
+    _counterTotals.submits = _submitCounter.value();
+    _counterTotals.uploadBytes = _writeBytesCounter.value() + _stagingBytesCounter.value();
+}
+
+void PerformanceHud::addFrame(const PerformanceHudFrame& frame) {
+    CounterSample totals;
+    totals.draws = _drawCounter.value();
+    totals.submits = _submitCounter.value();
+    totals.uploadBytes = _writeBytesCounter.value() + _stagingBytesCounter.value();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _lastCounters.draws = totals.draws - _counterTotals.draws;
+    _lastCounters.submits = totals.submits - _counterTotals.submits;
+    _lastCounters.uploadBytes = totals.uploadBytes - _counterTotals.uploadBytes;
+    _counterTotals = totals;
+
+    _history[_historyIndex] = {frame.frameMs, _gpuTiming.totalMilliseconds};
+    _historyIndex = (_historyIndex + 1) % HISTORY_SIZE;
+    _historyCount = std::min(_historyCount + 1, HISTORY_SIZE);
+    _lastFrame = frame;
+}
+
+void PerformanceHud::setGpuTiming(const GpuFrameTiming& timing) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _gpuTiming = timing;
+}
+
+void PerformanceHud::setCaches(const PipelineCache* pipelines, const BindGroupCache* bindGroups,
+                               const SamplerCache* samplers) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _pipelineCache = pipelines;
+    _bindGroupCache = bindGroups;
+    _samplerCache = samplers;
+}
+
+void PerformanceHud::graph(float x, float y, size_t count, size_t newest, bool gpu, uint32_t color) {
+    if (count < 2) {
+        return;
+    }
+
+    const float step = _config.graphWidth / static_cast<float>(HISTORY_SIZE - 1);
+    const float bottom = y + _config.graphHeight;
+    const float scale = _config.graphHeight / static_cast<float>(_config.graphRangeMs);
+
+    // Oldest sample on the left, clamped to the top edge when over range
+    auto point = [&](size_t age) -> DebugDraw::Vec3 {
+        const FrameRecord& record = _history[(newest + HISTORY_SIZE - age) % HISTORY_SIZE];
+        const double ms = gpu ? record.gpuMs : record.frameMs;
+        const float height = std::min(static_cast<float>(ms) * scale, _config.graphHeight);
+        return {x + _config.graphWidth - static_cast<float>(age) * step, bottom - height, 0.0f};
+    };
+
+    DebugDraw::Vec3 previous = point(count - 1);
+    for (size_t age = count - 1; age-- > 0;) {
+        const DebugDraw::Vec3 current = point(age);
+        _debugDraw.line(previous, current, color, false);
+        previous = current;
+    }
+}
+
+uint32_t PerformanceHud::render(IRenderPassEncoder& pass, const DebugDraw::Target& target,
+                                uint32_t viewportWidth, uint32_t viewportHeight) {
+    PERS_PROFILE_SCOPE("PerformanceHud::render");
+    if (!isValid() || viewportWidth == 0 || viewportHeight == 0) {
+        return 0;
+    }
+
+    const float lineHeight = LINE_HEIGHT * _config.textScale;
+    float x = _config.x;
+    float y = _config.y;
+    char line[160];
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        std::snprintf(line, sizeof(line), "frame %6.2f ms  cpu %6.2f ms  gpu %6.2f ms  latency %6.2f ms",
+                      _lastFrame.frameMs, _lastFrame.cpuMs, _gpuTiming.totalMilliseconds,
+                      _lastFrame.gpuLatencyMs);
+        _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+        y += lineHeight * 1.5f;
+
+        // Frame (green) and GPU (orange) time, with the 60 Hz budget as reference
+        const float graphTop = y;
+        const float bottom = graphTop + _config.graphHeight;
+        const float right = x + _config.graphWidth;
+        _debugDraw.line({x, graphTop, 0.0f}, {right, graphTop, 0.0f}, FRAME_COLOR, false);
+        _debugDraw.line({x, bottom, 0.0f}, {right, bottom, 0.0f}, FRAME_COLOR, false);
+        _debugDraw.line({x, graphTop, 0.0f}, {x, bottom, 0.0f}, FRAME_COLOR, false);
+        _debugDraw.line({right, graphTop, 0.0f}, {right, bottom, 0.0f}, FRAME_COLOR, false);
+        const double targetMs = 1000.0 / 60.0;
+        if (targetMs < _config.graphRangeMs) {
+            const float targetY = bottom - static_cast<float>(targetMs / _config.graphRangeMs) * _config.graphHeight;
+            _debugDraw.line({x, targetY, 0.0f}, {right, targetY, 0.0f}, TARGET_COLOR, false);
+        }
+        const size_t newest = (_historyIndex + HISTORY_SIZE - 1) % HISTORY_SIZE;
+        graph(x, graphTop, _historyCount, newest, false, CPU_COLOR);
+        graph(x, graphTop, _historyCount, newest, true, GPU_COLOR);
+        y = bottom + lineHeight * 0.5f;
+
+        for (const GpuPassTiming& timing : _gpuTiming.passes) {
+            std::snprintf(line, sizeof(line), "  %-20.20s %6.2f ms", timing.name.c_str(), timing.milliseconds);
+            _debugDraw.text(x, y, line, GPU_COLOR, _config.textScale);
+            y += lineHeight;
+        }
+
+        std::snprintf(line, sizeof(line), "draws %lld  submits %lld  upload %.2f MiB",
+                      static_cast<long long>(_lastCounters.draws), static_cast<long long>(_lastCounters.submits),
+                      toMiB(static_cast<uint64_t>(std::max<int64_t>(_lastCounters.uploadBytes, 0))));
+        _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+        y += lineHeight;
+
+        const GpuMemoryTracker::Stats memory = GpuMemoryTracker::instance().getStats();
+        if (memory.budget > 0) {
+            std::snprintf(line, sizeof(line), "gpu memory %.1f / %.1f MiB (%.0f%%)  peak %.1f MiB",
+                          toMiB(memory.totalBytes), toMiB(memory.budget),
+                          100.0 * static_cast<double>(memory.totalBytes) / static_cast<double>(memory.budget),
+                          toMiB(memory.peakBytes));
+        } else {
+            std::snprintf(line, sizeof(line), "gpu memory %.1f MiB  peak %.1f MiB",
+                          toMiB(memory.totalBytes), toMiB(memory.peakBytes));
+        }
+        _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+        y += lineHeight;
+
+        if (_pipelineCache) {
+            const PipelineCache::Stats stats = _pipelineCache->getStats();
+            std::snprintf(line, sizeof(line), "pipelines %zu  hit %.1f%%", stats.entries,
+                          hitRate(stats.hits, stats.misses));
+            _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+            y += lineHeight;
+        }
+        if (_bindGroupCache) {
+            const BindGroupCache::Stats stats = _bindGroupCache->getStats();
+            std::snprintf(line, sizeof(line), "bind groups %zu  hit %.1f%%", stats.bindGroups,
+                          hitRate(stats.bindGroupHits, stats.bindGroupMisses));
+            _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+            y += lineHeight;
+        }
+        if (_samplerCache) {
+            const SamplerCache::Stats stats = _samplerCache->getStats();
+            std::snprintf(line, sizeof(line), "samplers %zu  hit %.1f%%", stats.entries,
+                          hitRate(stats.hits, stats.misses));
+            _debugDraw.text(x, y, line, TEXT_COLOR, _config.textScale);
+        }
+    }
+
+    // Pixels from the top-left corner to clip space
+    DebugDraw::Mat4 screen = {};
+    screen[0] = 2.0f / static_cast<float>(viewportWidth);
+    screen[5] = -2.0f / static_cast<float>(viewportHeight);
+    screen[10] = 1.0f;
+    screen[12] = -1.0f;
+    screen[13] = 1.0f;
+    screen[15] = 1.0f;
+    return _debugDraw.render(pass, target, screen, viewportWidth, viewportHeight);
+}
+
+} // namespace pers
@@ -0,0 +1,203 @@
+#include "pers/graphics/PipelineCache.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+namespace {
+
+bool isEquivalent(const VertexAttribute& a, const VertexAttribute& b) {
+    return a.format == b.format &&
+           a.offset == b.offset &&
+           a.shaderLocation == b.shaderLocation;
+}
+
+bool isEquivalent(const VertexBufferLayout& a, const VertexBufferLayout& b) {
+    return a.arrayStride == b.arrayStride &&
+           a.stepMode == b.stepMode &&
+           std::equal(a.attributes.begin(), a.attributes.end(),
+                      b.attributes.begin(), b.attributes.end(),
+                      [](const VertexAttribute& x, const VertexAttribute& y) { return isEquivalent(x, y); });
+}
+
+bool isEquivalent(const StencilFaceState& a, const StencilFaceState& b) {
+    return a.compare == b.compare && a.failOp == b.failOp && a.depthFailOp == b.depthFailOp && a.passOp == b.passOp;
+}
+
+bool isEquivalent(const BlendComponent& a, const BlendComponent& b) {
+    return a.operation == b.operation && a.srcFactor == b.srcFactor && a.dstFactor == b.dstFactor;
+}
+
+bool isEquivalent(const ColorTargetState& a, const ColorTargetState& b) {
+    // The blend equation is ignored while blending is off
+    return a.format == b.format && a.writeMask == b.writeMask && a.blendEnabled == b.blendEnabled &&
+           (!a.blendEnabled || (isEquivalent(a.blend.color, b.blend.color) && isEquivalent(a.blend.alpha, b.blend.alpha)));
+}
+
+} // anonymous namespace
+
+uint64_t PipelineCache::computeHash(const RenderPipelineDesc& desc) {
+    // Fed field by field so padding never reaches the hash
+    Fnv1aHasher hasher;
+
+    hasher.add(desc.vertex.get());
+    hasher.add(desc.fragment.get());
+    hasher.add(desc.layout.get());
+
+    for (const auto* constants : {&desc.vertexConstants, &desc.fragmentConstants}) {
+        hasher.add(constants->size());
+        for (const auto& constant : *constants) {
+            hasher.addString(constant.key);
+            hasher.add(constant.value == 0.0 ? 0.0 : constant.value);  // -0.0 compares equal
+        }
+    }
+
+    hasher.add(desc.vertexLayouts.size());
+    for (const auto& layout : desc.vertexLayouts) {
+        hasher.add(layout.arrayStride);
+        hasher.add(layout.stepMode);
+        hasher.add(layout.attributes.size());
+        for (const auto& attribute : layout.attributes) {
+            hasher.add(attribute.format);
+            hasher.add(attribute.offset);
+            hasher.add(attribute.shaderLocation);
+        }
+    }
+
+    hasher.add(desc.primitive.topology);
+    hasher.add(desc.primitive.stripIndexFormat);
+    hasher.add(desc.primitive.frontFace);
+    hasher.add(desc.primitive.cullMode);
+
+    hasher.add(desc.depthStencil.format);
+    hasher.add(desc.depthStencil.depthWriteEnabled);
+    hasher.add(desc.depthStencil.depthCompare);
+    for (const StencilFaceState* face : {&desc.depthStencil.stencilFront, &desc.depthStencil.stencilBack}) {
+        hasher.add(face->compare);
+        hasher.add(face->failOp);
+        hasher.add(face->depthFailOp);
+        hasher.add(face->passOp);
+    }
+    hasher.add(desc.depthStencil.stencilReadMask);
+    hasher.add(desc.depthStencil.stencilWriteMask);
+
+    hasher.add(desc.multisample.count);
+    hasher.add(desc.multisample.mask);
+    hasher.add(desc.multisample.alphaToCoverageEnabled);
+
+    hasher.add(desc.colorTargets.size());
+    for (const auto& target : desc.colorTargets) {
+        hasher.add(target.format);
+        hasher.add(target.writeMask);
+        hasher.add(target.blendEnabled);
+        if (target.blendEnabled) {
+            for (const BlendComponent* component : {&target.blend.color, &target.blend.alpha}) {
+                hasher.add(component->operation);
+                hasher.add(component->srcFactor);
+                hasher.add(component->dstFactor);
+            }
+        }
+    }
+
+    return hasher.get();
+}
+
+bool PipelineCache::isEquivalent(const RenderPipelineDesc& a, const RenderPipelineDesc& b) {
+    return a.vertex == b.vertex &&
+           a.fragment == b.fragment &&
+           a.layout == b.layout &&
+           a.vertexConstants == b.vertexConstants &&
+           a.fragmentConstants == b.fragmentConstants &&
+           std::equal(a.vertexLayouts.begin(), a.vertexLayouts.end(),
+                      b.vertexLayouts.begin(), b.vertexLayouts.end(),
+                      [](const VertexBufferLayout& x, const VertexBufferLayout& y) { return pers::isEquivalent(x, y); }) &&
+           a.primitive.topology == b.primitive.topology &&
+           a.primitive.stripIndexFormat == b.primitive.stripIndexFormat &&
+           a.primitive.frontFace == b.primitive.frontFace &&
+           a.primitive.cullMode == b.primitive.cullMode &&
+           a.depthStencil.format == b.depthStencil.format &&
+           a.depthStencil.depthWriteEnabled == b.depthStencil.depthWriteEnabled &&
+           a.depthStencil.depthCompare == b.depthStencil.depthCompare &&
+           pers::isEquivalent(a.depthStencil.stencilFront, b.depthStencil.stencilFront) &&
+           pers::isEquivalent(a.depthStencil.stencilBack, b.depthStencil.stencilBack) &&
+           a.depthStencil.stencilReadMask == b.depthStencil.stencilReadMask &&
+           a.depthStencil.stencilWriteMask == b.depthStencil.stencilWriteMask &&
+           a.multisample.count == b.multisample.count &&
+           a.multisample.mask == b.multisample.mask &&
+           a.multisample.alphaToCoverageEnabled == b.multisample.alphaToCoverageEnabled &&
+           std::equal(a.colorTargets.begin(), a.colorTargets.end(),
+                      b.colorTargets.begin(), b.colorTargets.end(),
+                      [](const ColorTargetState& x, const ColorTargetState& y) { return pers::isEquivalent(x, y); });
+}
+
+std::shared_ptr<IRenderPipeline> PipelineCache::find(uint64_t hash, const RenderPipelineDesc& desc) const {
+    std::shared_ptr<IRenderPipeline> pipeline;
+    _entries.visit(hash, [&](const Entry& entry) {
+        if (!isEquivalent(entry.desc, desc)) {
+            return false;
+        }
+        pipeline = entry.pipeline;
+        return true;
+    });
+    return pipeline;
+}
+
+std::shared_ptr<IRenderPipeline> PipelineCache::getOrCreate(const RenderPipelineDesc& desc,
+                                                            const CreateFunction& create) {
+    if (auto pipeline = find(computeHash(desc), desc)) {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return pipeline;
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    if (!create) {
+        LOG_ERROR("PipelineCache", "Create function is null");
+        return nullptr;
+    }
+
+    // Compile outside the lock; pipeline creation is the slow part
+    auto pipeline = create(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        return pipeline;
+    }
+
+    return insert(desc, pipeline);
+}
+
+std::shared_ptr<IRenderPipeline> PipelineCache::lookup(const RenderPipelineDesc& desc) {
+    auto pipeline = find(computeHash(desc), desc);
+    (pipeline ? _hits : _misses).fetch_add(1, std::memory_order_relaxed);
+    return pipeline;
+}
+
+std::shared_ptr<IRenderPipeline> PipelineCache::insert(const RenderPipelineDesc& desc,
+                                                       const std::shared_ptr<IRenderPipeline>& pipeline) {
+    if (!pipeline || !pipeline->isValid()) {
+        return pipeline;
+    }
+
+    // Another thread may have compiled the same desc meanwhile, keep the first one
+    bool existed = false;
+    auto cached = _entries.insert(computeHash(desc), Entry{desc, pipeline}, [&](const Entry& entry) {
+        return existed = isEquivalent(entry.desc, desc);
+    });
+    if (!existed) {
+        _entryCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    return cached.pipeline;
+}
+
+void PipelineCache::clear() {
+    _entryCount.fetch_sub(_entries.clear(), std::memory_order_relaxed);
+}
+
+PipelineCache::Stats PipelineCache::getStats() const {
+    Stats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.entries = _entryCount.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace pers
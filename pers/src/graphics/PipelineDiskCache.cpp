@@ -0,0 +1,528 @@
+#include "pers/graphics/PipelineDiskCache.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/PipelineCache.h"
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <bit>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace pers {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'P', 'E', 'R', 'S', 'P', 'S', 'O', 'C'};
+
+class CacheWriter {
+public:
+    explicit CacheWriter(std::ostream& stream) : _stream(stream) {}
+
+    void u32(uint32_t value) { _stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void u64(uint64_t value) { _stream.write(reinterpret_cast<const char*>(&value), sizeof(value)); }
+    void str(const std::string& value) {
+        u32(static_cast<uint32_t>(value.size()));
+        _stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void words(const std::vector<uint32_t>& values) {
+        u32(static_cast<uint32_t>(values.size()));
+        _stream.write(reinterpret_cast<const char*>(values.data()),
+                      static_cast<std::streamsize>(values.size() * sizeof(uint32_t)));
+    }
+
+    template<typename E>
+    void enumValue(E value) { u32(static_cast<uint32_t>(value)); }
+
+private:
+    std::ostream& _stream;
+};
+
+class CacheReader {
+public:
+    explicit CacheReader(std::istream& stream) : _stream(stream) {}
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        _stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+    uint64_t u64() {
+        uint64_t value = 0;
+        _stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    }
+    std::string str() {
+        uint32_t size = u32();
+        if (!_stream || size > MAX_STRING_SIZE) {
+            _stream.setstate(std::ios::failbit);
+            return {};
+        }
+        std::string value(size, '\0');
+        _stream.read(value.data(), size);
+        return value;
+    }
+
+    std::vector<uint32_t> words() {
+        uint32_t count = u32();
+        if (!_stream || count > MAX_STRING_SIZE / sizeof(uint32_t)) {
+            _stream.setstate(std::ios::failbit);
+            return {};
+        }
+        std::vector<uint32_t> values(count);
+        _stream.read(reinterpret_cast<char*>(values.data()), count * sizeof(uint32_t));
+        return values;
+    }
+
+    template<typename E>
+    E enumValue() { return static_cast<E>(u32()); }
+
+    bool ok() const { return static_cast<bool>(_stream); }
+
+private:
+    static constexpr uint32_t MAX_STRING_SIZE = 64u * 1024 * 1024;
+
+    std::istream& _stream;
+};
+
+void writeConstants(CacheWriter& writer, const std::vector<PipelineConstant>& constants) {
+    writer.u32(static_cast<uint32_t>(constants.size()));
+    for (const auto& constant : constants) {
+        writer.str(constant.key);
+        writer.u64(std::bit_cast<uint64_t>(constant.value));
+    }
+}
+
+void writePipelineState(CacheWriter& writer, const RenderPipelineDesc& desc) {
+    writer.u32(static_cast<uint32_t>(desc.vertexLayouts.size()));
+    for (const auto& layout : desc.vertexLayouts) {
+        writer.u64(layout.arrayStride);
+        writer.enumValue(layout.stepMode);
+        writer.u32(static_cast<uint32_t>(layout.attributes.size()));
+        for (const auto& attribute : layout.attributes) {
+            writer.enumValue(attribute.format);
+            writer.u64(attribute.offset);
+            writer.u32(attribute.shaderLocation);
+        }
+    }
+
+    writer.enumValue(desc.primitive.topology);
+    writer.enumValue(desc.primitive.stripIndexFormat);
+    writer.enumValue(desc.primitive.frontFace);
+    writer.enumValue(desc.primitive.cullMode);
+
+    writer.enumValue(desc.depthStencil.format);
+    writer.u32(desc.depthStencil.depthWriteEnabled ? 1 : 0);
+    writer.enumValue(desc.depthStencil.depthCompare);
+    for (const StencilFaceState* face : {&desc.depthStencil.stencilFront, &desc.depthStencil.stencilBack}) {
+        writer.enumValue(face->compare);
+        writer.enumValue(face->failOp);
+        writer.enumValue(face->depthFailOp);
+        writer.enumValue(face->passOp);
+    }
+    writer.u32(desc.depthStencil.stencilReadMask);
+    writer.u32(desc.depthStencil.stencilWriteMask);
+
+    writer.u32(desc.multisample.count);
+    writer.u32(desc.multisample.mask);
+    writer.u32(desc.multisample.alphaToCoverageEnabled ? 1 : 0);
+
+    writer.u32(static_cast<uint32_t>(desc.colorTargets.size()));
+    for (const auto& target : desc.colorTargets) {
+        writer.enumValue(target.format);
+        writer.enumValue(target.writeMask);
+        writer.u32(target.blendEnabled ? 1 : 0);
+        for (const BlendComponent* component : {&target.blend.color, &target.blend.alpha}) {
+            writer.enumValue(component->operation);
+            writer.enumValue(component->srcFactor);
+            writer.enumValue(component->dstFactor);
+        }
+    }
+
+    writeConstants(writer, desc.vertexConstants);
+    writeConstants(writer, desc.fragmentConstants);
+
+    writer.str(desc.debugName);
+}
+
+void readConstants(CacheReader& reader, std::vector<PipelineConstant>& constants) {
+    uint32_t count = reader.u32();
+    for (uint32_t i = 0; i < count && reader.ok(); ++i) {
+        PipelineConstant constant;
+        constant.key = reader.str();
+        constant.value = std::bit_cast<double>(reader.u64());
+        constants.push_back(std::move(constant));
+    }
+}
+
+bool readPipelineState(CacheReader& reader, RenderPipelineDesc& desc) {
+    uint32_t layoutCount = reader.u32();
+    for (uint32_t i = 0; i < layoutCount && reader.ok(); ++i) {
+        VertexBufferLayout layout;
+        layout.arrayStride = reader.u64();
+        layout.stepMode = reader.enumValue<VertexStepMode>();
+        uint32_t attributeCount = reader.u32();
+        for (uint32_t j = 0; j < attributeCount && reader.ok(); ++j) {
+            VertexAttribute attribute;
+            attribute.format = reader.enumValue<VertexFormat>();
+            attribute.offset = reader.u64();
+            attribute.shaderLocation = reader.u32();
+            layout.attributes.push_back(attribute);
+        }
+        desc.vertexLayouts.push_back(std::move(layout));
+    }
+
+    desc.primitive.topology = reader.enumValue<PrimitiveTopology>();
+    desc.primitive.stripIndexFormat = reader.enumValue<IndexFormat>();
+    desc.primitive.frontFace = reader.enumValue<FrontFace>();
+    desc.primitive.cullMode = reader.enumValue<CullMode>();
+
+    desc.depthStencil.format = reader.enumValue<TextureFormat>();
+    desc.depthStencil.depthWriteEnabled = reader.u32() != 0;
+    desc.depthStencil.depthCompare = reader.enumValue<CompareFunction>();
+    for (StencilFaceState* face : {&desc.depthStencil.stencilFront, &desc.depthStencil.stencilBack}) {
+        face->compare = reader.enumValue<CompareFunction>();
+        face->failOp = reader.enumValue<StencilOperation>();
+        face->depthFailOp = reader.enumValue<StencilOperation>();
+        face->passOp = reader.enumValue<StencilOperation>();
+    }
+    desc.depthStencil.stencilReadMask = reader.u32();
+    desc.depthStencil.stencilWriteMask = reader.u32();
+
+    desc.multisample.count = reader.u32();
+    desc.multisample.mask = reader.u32();
+    desc.multisample.alphaToCoverageEnabled = reader.u32() != 0;
+
+    uint32_t targetCount = reader.u32();
+    for (uint32_t i = 0; i < targetCount && reader.ok(); ++i) {
+        ColorTargetState target;
+        target.format = reader.enumValue<TextureFormat>();
+        target.writeMask = reader.enumValue<ColorWriteMask>();
+        target.blendEnabled = reader.u32() != 0;
+        for (BlendComponent* component : {&target.blend.color, &target.blend.alpha}) {
+            component->operation = reader.enumValue<BlendOperation>();
+            component->srcFactor = reader.enumValue<BlendFactor>();
+            component->dstFactor = reader.enumValue<BlendFactor>();
+        }
+        desc.colorTargets.push_back(target);
+    }
+
+    readConstants(reader, desc.vertexConstants);
+    readConstants(reader, desc.fragmentConstants);
+
+    desc.debugName = reader.str();
+    return reader.ok();
+}
+
+} // anonymous namespace
+
+PipelineDiskCache::PipelineDiskCache(const std::string& path, const PhysicalDeviceCapabilities& capabilities)
+    : _path(path)
+    , _fingerprint(makeDeviceFingerprint(capabilities)) {
+}
+
+std::string PipelineDiskCache::makeDeviceFingerprint(const PhysicalDeviceCapabilities& capabilities) {
+    std::stringstream ss;
+    ss << capabilities.vendorName << "|" << capabilities.architecture << "|"
+       << capabilities.deviceName << "|" << capabilities.driverInfo << "|"
+       << std::hex << capabilities.vendorId << ":" << capabilities.deviceId;
+    return ss.str();
+}
+
+uint64_t PipelineDiskCache::computeShaderKey(const ShaderModuleDesc& desc) {
+    Fnv1aHasher hasher;
+    hasher.addString(desc.code);
+    hasher.addBytes(desc.spirv.data(), desc.spirv.size() * sizeof(uint32_t));
+    hasher.addString(desc.entryPoint);
+    hasher.add(desc.stage);
+    return hasher.get();
+}
+
+uint64_t PipelineDiskCache::computePipelineKey(const PipelineRecord& record) {
+    Fnv1aHasher hasher;
+    hasher.add(record.vertexKey);
+    hasher.add(record.fragmentKey);
+    hasher.add(PipelineCache::computeHash(record.desc));
+    return hasher.get();
+}
+
+bool PipelineDiskCache::load() {
+    PERS_PROFILE_SCOPE("PipelineDiskCache::load");
+    std::ifstream file(_path, std::ios::binary);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Info, "PipelineDiskCache", PERS_SOURCE_LOC,
+            "No pipeline cache at %s", _path.c_str());
+        return false;
+    }
+
+    CacheReader reader(file);
+
+    char magic[sizeof(FILE_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || std::string(magic, sizeof(magic)) != std::string(FILE_MAGIC, sizeof(FILE_MAGIC))) {
+        LOG_WARNING("PipelineDiskCache", "Pipeline cache file has an invalid header, ignoring");
+        return false;
+    }
+
+    if (reader.u32() != FORMAT_VERSION) {
+        LOG_INFO("PipelineDiskCache", "Pipeline cache format version changed, ignoring");
+        return false;
+    }
+
+    if (reader.str() != _fingerprint) {
+        LOG_INFO("PipelineDiskCache", "Pipeline cache was recorded on another adapter or driver, ignoring");
+        return false;
+    }
+
+    std::map<uint64_t, ShaderModuleDesc> shaders;
+    uint32_t shaderCount = reader.u32();
+    for (uint32_t i = 0; i < shaderCount && reader.ok(); ++i) {
+        uint64_t key = reader.u64();
+        ShaderModuleDesc desc;
+        desc.stage = reader.enumValue<ShaderStage>();
+        desc.entryPoint = reader.str();
+        desc.debugName = reader.str();
+        desc.code = reader.str();
+        desc.spirv = reader.words();
+        // Bundled SPIR-V has no code to reflect, so its reflection travels along
+        const std::string reflection = reader.str();
+        if (!reflection.empty()) {
+            auto decoded = ShaderReflection::deserialize(reinterpret_cast<const uint8_t*>(reflection.data()),
+                                                         reflection.size());
+            if (decoded.isValid()) {
+                desc.reflection = std::make_shared<const ShaderReflection>(std::move(decoded));
+            }
+        }
+        if (reader.ok() && computeShaderKey(desc) == key) {
+            shaders.emplace(key, std::move(desc));
+        }
+    }
+
+    std::vector<PipelineRecord> pipelines;
+    uint32_t pipelineCount = reader.u32();
+    for (uint32_t i = 0; i < pipelineCount && reader.ok(); ++i) {
+        PipelineRecord record;
+        record.vertexKey = reader.u64();
+        record.fragmentKey = reader.u64();
+        if (readPipelineState(reader, record.desc)) {
+            pipelines.push_back(std::move(record));
+        }
+    }
+
+    if (!reader.ok()) {
+        LOG_WARNING("PipelineDiskCache", "Pipeline cache file is truncated, ignoring");
+        return false;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _shaders.merge(shaders);
+    for (auto& record : pipelines) {
+        if (_pipelineKeys.insert(computePipelineKey(record)).second) {
+            _pipelines.push_back(std::move(record));
+        }
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "PipelineDiskCache", PERS_SOURCE_LOC,
+        "Loaded %zu shaders and %zu pipelines from %s", _shaders.size(), _pipelines.size(), _path.c_str());
+    return true;
+}
+
+bool PipelineDiskCache::save() const {
+    std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "PipelineDiskCache", PERS_SOURCE_LOC,
+            "Failed to open %s for writing", _path.c_str());
+        return false;
+    }
+
+    CacheWriter writer(file);
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    writer.u32(FORMAT_VERSION);
+    writer.str(_fingerprint);
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    writer.u32(static_cast<uint32_t>(_shaders.size()));
+    for (const auto& [key, desc] : _shaders) {
+        writer.u64(key);
+        writer.enumValue(desc.stage);
+        writer.str(desc.entryPoint);
+        writer.str(desc.debugName);
+        writer.str(desc.code);
+        writer.words(desc.spirv);
+        std::vector<uint8_t> reflection;
+        if (desc.reflection) {
+            desc.reflection->serialize(reflection);
+        }
+        writer.str(std::string(reflection.begin(), reflection.end()));
+    }
+
+    // Skip pipelines whose shaders are no longer recorded
+    std::vector<const PipelineRecord*> pipelines;
+    for (const auto& record : _pipelines) {
+        if (_shaders.count(record.vertexKey) &&
+            (record.fragmentKey == 0 || _shaders.count(record.fragmentKey))) {
+            pipelines.push_back(&record);
+        }
+    }
+
+    writer.u32(static_cast<uint32_t>(pipelines.size()));
+    for (const PipelineRecord* record : pipelines) {
+        writer.u64(record->vertexKey);
+        writer.u64(record->fragmentKey);
+        writePipelineState(writer, record->desc);
+    }
+
+    if (!file) {
+        Logger::Instance().LogFormat(LogLevel::Error, "PipelineDiskCache", PERS_SOURCE_LOC,
+            "Failed to write pipeline cache to %s", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+size_t PipelineDiskCache::prewarm(const std::shared_ptr<IResourceFactory>& factory) {
+    PERS_PROFILE_SCOPE("PipelineDiskCache::prewarm");
+    if (!factory) {
+        LOG_ERROR("PipelineDiskCache", "Resource factory is null");
+        return 0;
+    }
+
+    std::vector<ShaderModuleDesc> shaders;
+    std::vector<PipelineRecord> pipelines;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        for (const auto& [key, desc] : _shaders) {
+            if (!_modules.count(key)) {
+                shaders.push_back(desc);
+            }
+        }
+        pipelines = _pipelines;
+    }
+
+    for (const auto& desc : shaders) {
+        createShaderModule(factory, desc);
+    }
+
+    size_t created = 0;
+    for (auto& record : pipelines) {
+        {
+            auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+            auto vertex = _modules.find(record.vertexKey);
+            if (vertex == _modules.end()) {
+                continue;
+            }
+            record.desc.vertex = vertex->second;
+
+            if (record.fragmentKey != 0) {
+                auto fragment = _modules.find(record.fragmentKey);
+                if (fragment == _modules.end()) {
+                    continue;
+                }
+                record.desc.fragment = fragment->second;
+            }
+        }
+
+        auto pipeline = factory->createRenderPipeline(record.desc);
+        if (pipeline && pipeline->isValid()) {
+            ++created;
+        }
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "PipelineDiskCache", PERS_SOURCE_LOC,
+        "Prewarmed %zu shaders and %zu of %zu pipelines", shaders.size(), created, pipelines.size());
+    return created;
+}
+
+std::shared_ptr<IShaderModule> PipelineDiskCache::createShaderModule(const std::shared_ptr<IResourceFactory>& factory,
+                                                                     const ShaderModuleDesc& desc) {
+    const uint64_t key = computeShaderKey(desc);
+
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _modules.find(key);
+        if (it != _modules.end()) {
+            return it->second;
+        }
+    }
+
+    if (!factory) {
+        LOG_ERROR("PipelineDiskCache", "Resource factory is null");
+        return nullptr;
+    }
+
+    auto module = factory->createShaderModule(desc);
+    if (!module || !module->isValid()) {
+        return module;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    auto [it, inserted] = _modules.emplace(key, module);
+    if (inserted) {
+        _moduleKeys[module.get()] = key;
+        _shaders.emplace(key, desc);
+    }
+    return it->second;
+}
+
+std::shared_ptr<IRenderPipeline> PipelineDiskCache::createRenderPipeline(const std::shared_ptr<IResourceFactory>& factory,
+                                                                         const RenderPipelineDesc& desc) {
+    if (!factory) {
+        LOG_ERROR("PipelineDiskCache", "Resource factory is null");
+        return nullptr;
+    }
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (pipeline && pipeline->isValid()) {
+        recordPipeline(desc);
+    }
+    return pipeline;
+}
+
+bool PipelineDiskCache::recordPipeline(const RenderPipelineDesc& desc) {
+    // Explicit layouts are runtime objects and cannot be replayed from disk
+    if (desc.layout) {
+        return false;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    PipelineRecord record;
+    auto vertex = _moduleKeys.find(desc.vertex.get());
+    if (vertex == _moduleKeys.end()) {
+        return false;
+    }
+    record.vertexKey = vertex->second;
+
+    if (desc.fragment) {
+        auto fragment = _moduleKeys.find(desc.fragment.get());
+        if (fragment == _moduleKeys.end()) {
+            return false;
+        }
+        record.fragmentKey = fragment->second;
+    }
+
+    record.desc = desc;
+    record.desc.vertex.reset();
+    record.desc.fragment.reset();
+
+    if (!_pipelineKeys.insert(computePipelineKey(record)).second) {
+        return false;
+    }
+    _pipelines.push_back(std::move(record));
+    return true;
+}
+
+size_t PipelineDiskCache::getShaderCount() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _shaders.size();
+}
+
+size_t PipelineDiskCache::getPipelineCount() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _pipelines.size();
+}
+
+} // namespace pers
@@ -0,0 +1,723 @@
+#include "pers/graphics/PostProcessChain.h"
+#include "pers/graphics/AutoExposure.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/TransientTexturePool.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct SettingsUniforms {
+    float threshold;
+    float knee;
+    float bloomIntensity;
+    float bloomRadius;
+    float exposure;
+    float contrast;
+    float saturation;
+    uint32_t tonemapper;
+    float lift[4];
+    float gamma[4];
+    float gain[4];
+    uint32_t fxaa;
+    uint32_t encodeOutput;
+    uint32_t padding[2];
+};
+
+constexpr char SETTINGS_WGSL[] = R"(
+struct Settings {
+    threshold: f32,
+    knee: f32,
+    bloomIntensity: f32,
+    bloomRadius: f32,
+    exposure: f32,
+    contrast: f32,
+    saturation: f32,
+    tonemapper: u32,
+    lift: vec4<f32>,
+    gamma: vec4<f32>,
+    gain: vec4<f32>,
+    fxaa: u32,
+    encodeOutput: u32,
+    padding0: u32,
+    padding1: u32,
+};
+@group(0) @binding(0) var<uniform> settings: Settings;
+@group(0) @binding(1) var source: texture_2d<f32>;
+@group(0) @binding(2) var linearSampler: sampler;
+)";
+
+using SettingsLayout = GpuStruct<GpuLayout::Std140, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuF32, GpuU32,
+                                 GpuVec4f, GpuVec4f, GpuVec4f, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(SettingsLayout::matchesWgsl(SETTINGS_WGSL, "Settings"), "Settings no longer match the post shaders");
+static_assert(SettingsLayout::SIZE == sizeof(SettingsUniforms) &&
+              SettingsLayout::offsetOf<8>() == offsetof(SettingsUniforms, lift) &&
+              SettingsLayout::offsetOf<11>() == offsetof(SettingsUniforms, fxaa),
+              "SettingsUniforms must match the WGSL layout");
+
+// 13 bilinear taps weighted as five overlapping 2x2 boxes (Jimenez, "Next Generation Post Processing in Call of Duty")
+constexpr char DOWNSAMPLE_FUNCTIONS[] = R"(
+@group(0) @binding(3) var addend: texture_2d<f32>;
+@group(0) @binding(4) var destination: texture_storage_2d<rgba16float, write>;
+
+fn tap(uv: vec2<f32>, texel: vec2<f32>, x: f32, y: f32) -> vec3<f32> {
+    return textureSampleLevel(source, linearSampler, uv + texel * vec2<f32>(x, y), 0.0).rgb;
+}
+
+fn downsample(uv: vec2<f32>) -> vec3<f32> {
+    let texel = 1.0 / vec2<f32>(textureDimensions(source));
+    let a = tap(uv, texel, -2.0, -2.0);
+    let b = tap(uv, texel, 0.0, -2.0);
+    let c = tap(uv, texel, 2.0, -2.0);
+    let d = tap(uv, texel, -1.0, -1.0);
+    let e = tap(uv, texel, 1.0, -1.0);
+    let f = tap(uv, texel, -2.0, 0.0);
+    let g = tap(uv, texel, 0.0, 0.0);
+    let h = tap(uv, texel, 2.0, 0.0);
+    let i = tap(uv, texel, -1.0, 1.0);
+    let j = tap(uv, texel, 1.0, 1.0);
+    let k = tap(uv, texel, -2.0, 2.0);
+    let l = tap(uv, texel, 0.0, 2.0);
+    let m = tap(uv, texel, 2.0, 2.0);
+    return (d + e + i + j) * 0.125 + (a + b + f + g + b + c + g + h + f + g + k + l + g + h + l + m) * 0.03125;
+}
+)";
+
+constexpr char PREFILTER_MAIN[] = R"(
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+
+    // Soft-knee threshold on the brightest channel keeps hue and avoids a hard cut
+    let color = downsample((vec2<f32>(id.xy) + 0.5) / vec2<f32>(size));
+    let brightness = max(color.r, max(color.g, color.b));
+    let soft = clamp(brightness - settings.threshold + settings.knee, 0.0, 2.0 * settings.knee);
+    let curve = soft * soft / (4.0 * settings.knee + 1e-5);
+    let contribution = max(curve, brightness - settings.threshold) / max(brightness, 1e-5);
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(min(color * contribution, vec3<f32>(65000.0)), 1.0));
+}
+)";
+
+constexpr char DOWNSAMPLE_MAIN[] = R"(
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(downsample((vec2<f32>(id.xy) + 0.5) / vec2<f32>(size)), 1.0));
+}
+)";
+
+// 3x3 tent over the smaller level, added to the matching downsample level
+constexpr char UPSAMPLE_MAIN[] = R"(
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+
+    let uv = (vec2<f32>(id.xy) + 0.5) / vec2<f32>(size);
+    let texel = settings.bloomRadius / vec2<f32>(textureDimensions(source));
+    var sum = tap(uv, texel, 0.0, 0.0) * 4.0;
+    sum += (tap(uv, texel, 0.0, -1.0) + tap(uv, texel, -1.0, 0.0) + tap(uv, texel, 1.0, 0.0) + tap(uv, texel, 0.0, 1.0)) * 2.0;
+    sum += tap(uv, texel, -1.0, -1.0) + tap(uv, texel, 1.0, -1.0) + tap(uv, texel, -1.0, 1.0) + tap(uv, texel, 1.0, 1.0);
+    let color = sum / 16.0 + textureLoad(addend, vec2<i32>(id.xy), 0).rgb;
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(color, 1.0));
+}
+)";
+
+constexpr char COMPOSITE_MAIN[] = R"(
+struct ExposureState {
+    averageLuminance: f32,
+    exposure: f32,
+    targetLuminance: f32,
+    sampleCount: u32,
+};
+
+@group(0) @binding(3) var bloom: texture_2d<f32>;
+@group(0) @binding(4) var destination: texture_storage_2d<rgba8unorm, write>;
+@group(0) @binding(5) var<storage, read> exposureState: ExposureState;
+
+fn tonemap(color: vec3<f32>) -> vec3<f32> {
+    if (settings.tonemapper == 1u) {
+        return color / (1.0 + color);
+    }
+    if (settings.tonemapper == 2u) {
+        return clamp((color * (2.51 * color + 0.03)) / (color * (2.43 * color + 0.59) + 0.14), vec3<f32>(0.0), vec3<f32>(1.0));
+    }
+    return clamp(color, vec3<f32>(0.0), vec3<f32>(1.0));
+}
+
+fn encodeSrgb(color: vec3<f32>) -> vec3<f32> {
+    let low = color * 12.92;
+    let high = 1.055 * pow(color, vec3<f32>(1.0 / 2.4)) - 0.055;
+    return select(high, low, color <= vec3<f32>(0.0031308));
+}
+
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    let size = textureDimensions(destination);
+    if (id.x >= size.x || id.y >= size.y) {
+        return;
+    }
+
+    let uv = (vec2<f32>(id.xy) + 0.5) / vec2<f32>(size);
+    let scene = textureLoad(source, vec2<i32>(id.xy), 0).rgb;
+    let glow = textureSampleLevel(bloom, linearSampler, uv, 0.0).rgb;
+    var color = tonemap((scene + glow * settings.bloomIntensity) * settings.exposure * exposureState.exposure);
+
+    // Lift, gamma and gain, then saturation and contrast around mid grey
+    color = settings.gain.rgb * (color + settings.lift.rgb * (1.0 - color));
+    color = pow(max(color, vec3<f32>(0.0)), 1.0 / max(settings.gamma.rgb, vec3<f32>(1e-3)));
+    let luminance = dot(color, vec3<f32>(0.2126, 0.7152, 0.0722));
+    color = mix(vec3<f32>(luminance), color, settings.saturation);
+    color = clamp((color - 0.5) * settings.contrast + 0.5, vec3<f32>(0.0), vec3<f32>(1.0));
+
+    // FXAA works on perceptual values and reads luma from alpha
+    let encoded = encodeSrgb(color);
+    textureStore(destination, vec2<i32>(id.xy), vec4<f32>(encoded, dot(encoded, vec3<f32>(0.299, 0.587, 0.114))));
+}
+)";
+
+constexpr char OUTPUT_VERTEX_SHADER[] = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    // Single triangle covering the viewport
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+// FXAA after Lottes' reference, luma precomputed in alpha by the composite
+constexpr char OUTPUT_FRAGMENT_MAIN[] = R"(
+fn decodeSrgb(color: vec3<f32>) -> vec3<f32> {
+    let low = color / 12.92;
+    let high = pow((color + 0.055) / 1.055, vec3<f32>(2.4));
+    return select(high, low, color <= vec3<f32>(0.04045));
+}
+
+fn fxaa(uv: vec2<f32>, texel: vec2<f32>) -> vec3<f32> {
+    let center = textureSampleLevel(source, linearSampler, uv, 0.0);
+    let lumaNW = textureSampleLevel(source, linearSampler, uv + texel * vec2<f32>(-1.0, -1.0), 0.0).a;
+    let lumaNE = textureSampleLevel(source, linearSampler, uv + texel * vec2<f32>(1.0, -1.0), 0.0).a;
+    let lumaSW = textureSampleLevel(source, linearSampler, uv + texel * vec2<f32>(-1.0, 1.0), 0.0).a;
+    let lumaSE = textureSampleLevel(source, linearSampler, uv + texel * vec2<f32>(1.0, 1.0), 0.0).a;
+    let lumaMin = min(center.a, min(min(lumaNW, lumaNE), min(lumaSW, lumaSE)));
+    let lumaMax = max(center.a, max(max(lumaNW, lumaNE), max(lumaSW, lumaSE)));
+    if (lumaMax - lumaMin < max(0.0312, lumaMax * 0.125)) {
+        return center.rgb;
+    }
+
+    var direction = vec2<f32>(-((lumaNW + lumaNE) - (lumaSW + lumaSE)), (lumaNW + lumaSW) - (lumaNE + lumaSE));
+    let reduce = max((lumaNW + lumaNE + lumaSW + lumaSE) * 0.03125, 1.0 / 128.0);
+    let scale = 1.0 / (min(abs(direction.x), abs(direction.y)) + reduce);
+    direction = clamp(direction * scale, vec2<f32>(-8.0), vec2<f32>(8.0)) * texel;
+
+    let near = 0.5 * (textureSampleLevel(source, linearSampler, uv + direction * (1.0 / 3.0 - 0.5), 0.0).rgb +
+                      textureSampleLevel(source, linearSampler, uv + direction * (2.0 / 3.0 - 0.5), 0.0).rgb);
+    let far = near * 0.5 + 0.25 * (textureSampleLevel(source, linearSampler, uv - direction * 0.5, 0.0).rgb +
+                                   textureSampleLevel(source, linearSampler, uv + direction * 0.5, 0.0).rgb);
+    let lumaFar = dot(far, vec3<f32>(0.299, 0.587, 0.114));
+    return select(far, near, lumaFar < lumaMin || lumaFar > lumaMax);
+}
+
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    let size = vec2<f32>(textureDimensions(source));
+    let uv = position.xy / size;
+    var color = textureSampleLevel(source, linearSampler, uv, 0.0).rgb;
+    if (settings.fxaa != 0u) {
+        color = fxaa(uv, 1.0 / size);
+    }
+    if (settings.encodeOutput == 0u) {
+        color = decodeSrgb(color);
+    }
+    return vec4<f32>(color, 1.0);
+}
+)";
+
+// Unorm targets without hardware sRGB encoding take the encoded values directly
+bool storesEncoded(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::RGB10A2Unorm:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint32_t dispatchCount(uint32_t size) {
+    return (size + PostProcessChain::WORKGROUP_SIZE - 1) / PostProcessChain::WORKGROUP_SIZE;
+}
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("PostProcessChain", "Failed to create post-processing shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+using ExposureLayout = GpuStruct<GpuLayout::Std430, GpuF32, GpuF32, GpuF32, GpuU32>;
+static_assert(ExposureLayout::matchesWgsl(COMPOSITE_MAIN, "ExposureState") &&
+              ExposureLayout::SIZE == sizeof(AutoExposureState),
+              "ExposureState must match AutoExposureState");
+
+std::shared_ptr<IBindGroupLayout> createLayout(IResourceFactory& factory, ShaderStage stage,
+                                               TextureFormat storageFormat, const char* name,
+                                               bool exposure = false) {
+    BindGroupLayoutDesc desc;
+    desc.debugName = name;
+    desc.entries = {
+        {.binding = 0, .visibility = stage, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(SettingsUniforms)},
+        {.binding = 1, .visibility = stage, .type = BindingType::SampledTexture},
+        {.binding = 2, .visibility = stage, .type = BindingType::Sampler},
+    };
+    if (storageFormat != TextureFormat::Undefined) {
+        desc.entries.push_back({.binding = 3, .visibility = stage, .type = BindingType::SampledTexture});
+        desc.entries.push_back({.binding = 4, .visibility = stage, .type = BindingType::StorageTexture,
+                                .storageTextureFormat = storageFormat});
+    }
+    if (exposure) {
+        desc.entries.push_back({.binding = 5, .visibility = stage, .type = BindingType::ReadOnlyStorageBuffer,
+                                .minBindingSize = sizeof(AutoExposureState)});
+    }
+    return factory.createBindGroupLayout(desc);
+}
+
+std::shared_ptr<IComputePipeline> createComputePipeline(IResourceFactory& factory, const std::string& code,
+                                                        const std::shared_ptr<IBindGroupLayout>& layout,
+                                                        const char* name) {
+    auto shader = createShader(factory, code, ShaderStage::Compute, name);
+    if (!shader || !layout) {
+        return nullptr;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {layout};
+    pipelineLayoutDesc.debugName = name;
+
+    ComputePipelineDesc desc;
+    desc.compute = shader;
+    desc.layout = factory.createPipelineLayout(pipelineLayoutDesc);
+    desc.debugName = name;
+    auto pipeline = desc.layout ? factory.createComputePipeline(desc) : nullptr;
+    if (!pipeline) {
+        LOG_ERROR("PostProcessChain", "Failed to create post-processing pipeline");
+    }
+    return pipeline;
+}
+
+std::shared_ptr<IBindGroup> createBindGroup(IResourceFactory& factory, const std::shared_ptr<IBindGroupLayout>& layout,
+                                            const std::shared_ptr<IBuffer>& settings,
+                                            const std::shared_ptr<ISampler>& sampler,
+                                            const std::shared_ptr<ITextureView>& source,
+                                            const std::shared_ptr<ITextureView>& second = nullptr,
+                                            const std::shared_ptr<ITextureView>& destination = nullptr,
+                                            const std::shared_ptr<IBuffer>& exposure = nullptr) {
+    BindGroupDesc desc;
+    desc.layout = layout;
+    desc.debugName = "PostProcessChain";
+    desc.entries.resize(exposure ? 6 : destination ? 5 : 3);
+    desc.entries[0].binding = 0;
+    desc.entries[0].buffer = settings;
+    desc.entries[0].size = sizeof(SettingsUniforms);
+    desc.entries[1].binding = 1;
+    desc.entries[1].textureView = source;
+    desc.entries[2].binding = 2;
+    desc.entries[2].sampler = sampler;
+    if (destination) {
+        desc.entries[3].binding = 3;
+        desc.entries[3].textureView = second;
+        desc.entries[4].binding = 4;
+        desc.entries[4].textureView = destination;
+    }
+    if (exposure) {
+        desc.entries[5].binding = 5;
+        desc.entries[5].buffer = exposure;
+    }
+    return factory.createBindGroup(desc);
+}
+
+} // anonymous namespace
+
+PostProcessChain::PostProcessChain(const std::shared_ptr<ILogicalDevice>& device,
+                                   const std::shared_ptr<TransientTexturePool>& texturePool)
+    : _device(device)
+    , _texturePool(texturePool) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("PostProcessChain", "Device or resource factory is null");
+        return;
+    }
+
+    if (!_texturePool) {
+        _texturePool = std::make_shared<TransientTexturePool>(factory);
+    }
+
+    _settingsBuffer = std::make_shared<DeviceBuffer>();
+    if (!_settingsBuffer->create(sizeof(SettingsUniforms), DeviceBufferUsage::Uniform, device, "PostProcessSettings")) {
+        LOG_ERROR("PostProcessChain", "Failed to create settings buffer");
+        return;
+    }
+
+    // Exposure 1 stands in until setExposureBuffer() provides an adapted one
+    const AutoExposureState neutralExposure;
+    _neutralExposureBuffer = std::make_shared<DeviceBuffer>();
+    auto queue = device->getQueue();
+    if (!queue ||
+        !_neutralExposureBuffer->create(sizeof(AutoExposureState), DeviceBufferUsage::Storage, device,
+                                        "PostProcessNeutralExposure") ||
+        !queue->writeBuffer(_neutralExposureBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&neutralExposure),
+                                                       sizeof(neutralExposure)))) {
+        LOG_ERROR("PostProcessChain", "Failed to create exposure buffer");
+        return;
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.label = "PostProcessChain";
+    _sampler = factory->createSampler(samplerDesc);
+    if (!_sampler) {
+        LOG_ERROR("PostProcessChain", "Failed to create sampler");
+        return;
+    }
+
+    _bloomLayout = createLayout(*factory, ShaderStage::Compute, TextureFormat::RGBA16Float, "PostProcessChain::Bloom");
+    _compositeLayout = createLayout(*factory, ShaderStage::Compute, TextureFormat::RGBA8Unorm,
+                                    "PostProcessChain::Composite", true);
+    _outputLayout = createLayout(*factory, ShaderStage::Fragment, TextureFormat::Undefined, "PostProcessChain::Output");
+    if (!_bloomLayout || !_compositeLayout || !_outputLayout) {
+        LOG_ERROR("PostProcessChain", "Failed to create bind group layouts");
+        return;
+    }
+
+    const std::string bloomPrefix = std::string(SETTINGS_WGSL) + DOWNSAMPLE_FUNCTIONS;
+    _prefilterPipeline = createComputePipeline(*factory, bloomPrefix + PREFILTER_MAIN, _bloomLayout,
+                                               "PostProcessChain::Prefilter");
+    _downsamplePipeline = createComputePipeline(*factory, bloomPrefix + DOWNSAMPLE_MAIN, _bloomLayout,
+                                                "PostProcessChain::Downsample");
+    _upsamplePipeline = createComputePipeline(*factory, bloomPrefix + UPSAMPLE_MAIN, _bloomLayout,
+                                              "PostProcessChain::Upsample");
+
+    _outputVertexShader = createShader(*factory, OUTPUT_VERTEX_SHADER, ShaderStage::Vertex,
+                                       "PostProcessChain::OutputVertex");
+    _outputFragmentShader = createShader(*factory, std::string(SETTINGS_WGSL) + OUTPUT_FRAGMENT_MAIN,
+                                         ShaderStage::Fragment, "PostProcessChain::OutputFragment");
+    PipelineLayoutDesc outputLayoutDesc;
+    outputLayoutDesc.bindGroupLayouts = {_outputLayout};
+    outputLayoutDesc.debugName = "PostProcessChain::Output";
+    _outputPipelineLayout = factory->createPipelineLayout(outputLayoutDesc);
+
+    if (!_prefilterPipeline || !_downsamplePipeline || !_upsamplePipeline || !_outputVertexShader ||
+        !_outputFragmentShader || !_outputPipelineLayout) {
+        return;
+    }
+
+    // Created last, isValid() means every stage is usable
+    _compositePipeline = createComputePipeline(*factory, std::string(SETTINGS_WGSL) + COMPOSITE_MAIN, _compositeLayout,
+                                               "PostProcessChain::Composite");
+}
+
+PostProcessChain::~PostProcessChain() = default;
+
+void PostProcessChain::setExposureBuffer(const std::shared_ptr<DeviceBuffer>& buffer) {
+    _exposureBuffer = buffer;
+}
+
+bool PostProcessChain::execute(ICommandEncoder& encoder, const std::shared_ptr<ITextureView>& sceneView,
+                               const std::shared_ptr<ITextureView>& destination,
+                               const PostProcessSettings& settings) {
+    PERS_PROFILE_SCOPE("PostProcessChain::execute");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue || !isValid()) {
+        LOG_ERROR("PostProcessChain", "Cannot execute invalid post-processing chain");
+        return false;
+    }
+
+    if (!sceneView || !destination) {
+        LOG_ERROR("PostProcessChain", "Scene or destination view is null");
+        return false;
+    }
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t destinationWidth = 0;
+    uint32_t destinationHeight = 0;
+    sceneView->getDimensions(width, height);
+    destination->getDimensions(destinationWidth, destinationHeight);
+    if (width == 0 || height == 0 || width != destinationWidth || height != destinationHeight) {
+        LOG_ERROR("PostProcessChain", "Scene and destination must have the same non-zero size");
+        return false;
+    }
+
+    auto outputPipeline = getOutputPipeline(destination->getFormat());
+    if (!outputPipeline) {
+        return false;
+    }
+
+    SettingsUniforms uniforms = {};
+    uniforms.threshold = settings.bloomThreshold;
+    uniforms.knee = std::max(settings.bloomKnee, 0.0f);
+    uniforms.bloomIntensity = settings.bloom ? settings.bloomIntensity : 0.0f;
+    uniforms.bloomRadius = settings.bloomRadius;
+    uniforms.exposure = settings.exposure;
+    uniforms.contrast = settings.contrast;
+    uniforms.saturation = settings.saturation;
+    uniforms.tonemapper = static_cast<uint32_t>(settings.tonemapper);
+    std::copy(settings.lift.begin(), settings.lift.end(), uniforms.lift);
+    std::copy(settings.gamma.begin(), settings.gamma.end(), uniforms.gamma);
+    std::copy(settings.gain.begin(), settings.gain.end(), uniforms.gain);
+    uniforms.fxaa = settings.fxaa ? 1 : 0;
+    uniforms.encodeOutput = storesEncoded(destination->getFormat()) ? 1 : 0;
+    if (!queue->writeBuffer(_settingsBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&uniforms), sizeof(uniforms)))) {
+        LOG_ERROR("PostProcessChain", "Failed to write post-processing settings");
+        return false;
+    }
+
+    TextureDesc ldrDesc;
+    ldrDesc.width = width;
+    ldrDesc.height = height;
+    ldrDesc.format = TextureFormat::RGBA8Unorm;
+    ldrDesc.usage = TextureUsage::TextureBinding | TextureUsage::StorageBinding;
+    ldrDesc.label = "PostProcessChain::Ldr";
+    PooledTexture ldr = _texturePool->acquire(ldrDesc);
+
+    // Bloom starts at half resolution and stops before a level would vanish
+    const uint32_t bloomWidth = std::max(1u, width / 2);
+    const uint32_t bloomHeight = std::max(1u, height / 2);
+    const uint32_t levels = settings.bloom && settings.bloomIntensity > 0.0f
+        ? std::clamp(settings.bloomLevels, 1u, static_cast<uint32_t>(std::bit_width(std::min(bloomWidth, bloomHeight))))
+        : 0;
+
+    PooledTexture down;
+    PooledTexture up;
+    if (levels > 0) {
+        TextureDesc bloomDesc;
+        bloomDesc.width = bloomWidth;
+        bloomDesc.height = bloomHeight;
+        bloomDesc.mipLevelCount = levels;
+        bloomDesc.format = TextureFormat::RGBA16Float;
+        bloomDesc.usage = TextureUsage::TextureBinding | TextureUsage::StorageBinding;
+        bloomDesc.label = "PostProcessChain::Bloom";
+        down = _texturePool->acquire(bloomDesc);
+        if (levels > 1) {
+            up = _texturePool->acquire(bloomDesc);
+        }
+    }
+
+    auto releaseTargets = [&]() {
+        for (LevelViews& entry : _levelViews) {
+            entry.used = entry.used && !entry.texture.expired();
+        }
+        std::erase_if(_levelViews, [](const LevelViews& entry) { return !entry.used; });
+        for (PooledTexture* texture : {&ldr, &down, &up}) {
+            if (*texture) {
+                _texturePool->release(std::move(*texture));
+            }
+        }
+    };
+
+    for (LevelViews& entry : _levelViews) {
+        entry.used = false;
+    }
+
+    if (!ldr || (levels > 0 && !down) || (levels > 1 && !up)) {
+        LOG_ERROR("PostProcessChain", "Failed to acquire post-processing targets");
+        releaseTargets();
+        return false;
+    }
+
+    // Record every bind group first so a failure leaves the encoder untouched
+    const auto settingsBuffer = std::static_pointer_cast<IBuffer>(_settingsBuffer);
+    std::vector<std::pair<std::shared_ptr<IComputePipeline>, std::shared_ptr<IBindGroup>>> dispatches;
+    std::vector<std::pair<uint32_t, uint32_t>> sizes;
+    std::shared_ptr<ITextureView> bloomResult = sceneView;  // Bound with zero intensity when bloom is off
+    if (levels > 0) {
+        const auto downViews = getLevelViews(down.texture, levels);
+        const auto upViews = levels > 1 ? getLevelViews(up.texture, levels - 1)
+                                        : std::vector<std::shared_ptr<ITextureView>>{};
+        if (downViews.size() != levels || upViews.size() != levels - 1) {
+            releaseTargets();
+            return false;
+        }
+
+        auto levelSize = [&](uint32_t level) {
+            return std::make_pair(std::max(1u, bloomWidth >> level), std::max(1u, bloomHeight >> level));
+        };
+
+        dispatches.emplace_back(_prefilterPipeline,
+                                createBindGroup(*factory, _bloomLayout, settingsBuffer, _sampler, sceneView, sceneView,
+                                                downViews[0]));
+        sizes.push_back(levelSize(0));
+        for (uint32_t level = 1; level < levels; ++level) {
+            dispatches.emplace_back(_downsamplePipeline,
+                                    createBindGroup(*factory, _bloomLayout, settingsBuffer, _sampler,
+                                                    downViews[level - 1], downViews[level - 1], downViews[level]));
+            sizes.push_back(levelSize(level));
+        }
+        for (uint32_t level = levels - 1; level-- > 0;) {
+            const auto& smaller = level + 1 == levels - 1 ? downViews[level + 1] : upViews[level + 1];
+            dispatches.emplace_back(_upsamplePipeline,
+                                    createBindGroup(*factory, _bloomLayout, settingsBuffer, _sampler, smaller,
+                                                    downViews[level], upViews[level]));
+            sizes.push_back(levelSize(level));
+        }
+        bloomResult = levels > 1 ? upViews[0] : downViews[0];
+    }
+    dispatches.emplace_back(_compositePipeline,
+                            createBindGroup(*factory, _compositeLayout, settingsBuffer, _sampler, sceneView,
+                                            bloomResult, ldr.view,
+                                            _exposureBuffer ? _exposureBuffer : _neutralExposureBuffer));
+    sizes.emplace_back(width, height);
+    auto outputBindGroup = createBindGroup(*factory, _outputLayout, settingsBuffer, _sampler, ldr.view);
+
+    const bool complete = outputBindGroup && std::all_of(dispatches.begin(), dispatches.end(),
+                                                         [](const auto& dispatch) { return dispatch.second != nullptr; });
+    if (!complete) {
+        LOG_ERROR("PostProcessChain", "Failed to create post-processing bind groups");
+        releaseTargets();
+        return false;
+    }
+
+    ComputePassDesc computeDesc;
+    computeDesc.label = "PostProcessChain";
+    auto computePass = encoder.beginComputePass(computeDesc);
+    if (!computePass) {
+        LOG_ERROR("PostProcessChain", "Failed to begin post-processing compute pass");
+        releaseTargets();
+        return false;
+    }
+    for (size_t i = 0; i < dispatches.size(); ++i) {
+        computePass->setPipeline(dispatches[i].first);
+        computePass->setBindGroup(0, dispatches[i].second);
+        computePass->dispatch(dispatchCount(sizes[i].first), dispatchCount(sizes[i].second));
+    }
+    computePass->end();
+    _dispatchCount = static_cast<uint32_t>(dispatches.size());
+
+    // Every texel is overwritten, nothing to load
+    RenderPassDesc passDesc;
+    passDesc.label = "PostProcessChain::Output";
+    RenderPassColorAttachment attachment;
+    attachment.view = destination;
+    attachment.loadOp = LoadOp::Clear;
+    attachment.storeOp = StoreOp::Store;
+    passDesc.colorAttachments.push_back(attachment);
+
+    auto renderPass = encoder.beginRenderPass(passDesc);
+    if (!renderPass) {
+        LOG_ERROR("PostProcessChain", "Failed to begin post-processing output pass");
+        releaseTargets();
+        return false;
+    }
+    renderPass->setPipeline(outputPipeline);
+    renderPass->setBindGroup(0, outputBindGroup);
+    renderPass->draw(3);
+    renderPass->end();
+
+    releaseTargets();
+    return true;
+}
+
+const std::vector<std::shared_ptr<ITextureView>>& PostProcessChain::getLevelViews(
+    const std::shared_ptr<ITexture>& texture, uint32_t mipCount) {
+    // The pool usually hands back last frame's textures, whose views keep their bind groups cached
+    for (LevelViews& entry : _levelViews) {
+        if (entry.texture.lock() == texture && entry.views.size() == mipCount) {
+            entry.used = true;
+            return entry.views;
+        }
+    }
+
+    LevelViews entry;
+    entry.texture = texture;
+    entry.used = true;
+    if (auto factory = _device.lock() ? _device.lock()->getResourceFactory() : nullptr) {
+        TextureViewDesc viewDesc;
+        viewDesc.format = texture->getFormat();
+        viewDesc.label = "PostProcessChain::BloomLevel";
+        for (uint32_t mip = 0; mip < mipCount; ++mip) {
+            viewDesc.baseMipLevel = mip;
+            auto view = factory->createTextureView(texture, viewDesc);
+            if (!view) {
+                LOG_ERROR("PostProcessChain", "Failed to create bloom level view");
+                entry.views.clear();
+                break;
+            }
+            entry.views.push_back(std::move(view));
+        }
+    }
+    _levelViews.push_back(std::move(entry));
+    return _levelViews.back().views;
+}
+
+std::shared_ptr<IRenderPipeline> PostProcessChain::getOutputPipeline(TextureFormat format) {
+    auto it = _outputPipelines.find(format);
+    if (it != _outputPipelines.end()) {
+        return it->second;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _outputVertexShader;
+    desc.fragment = _outputFragmentShader;
+    desc.layout = _outputPipelineLayout;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = format;
+    desc.debugName = "PostProcessChain::Output";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("PostProcessChain", "Failed to create post-processing output pipeline");
+        return nullptr;
+    }
+
+    _outputPipelines.emplace(format, pipeline);
+    return pipeline;
+}
+
+} // namespace pers
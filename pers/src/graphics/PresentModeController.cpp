@@ -0,0 +1,131 @@
+#include "pers/graphics/PresentModeController.h"
+#include "pers/graphics/GraphicsEnumStrings.h"
+#include "pers/graphics/ISwapChain.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+PresentModeController::PresentModeController(const std::shared_ptr<ISwapChain>& swapChain, const Config& config)
+    : _swapChain(swapChain)
+    , _config(config) {
+    if (!swapChain) {
+        LOG_ERROR("PresentModeController", "Swap chain is null");
+        return;
+    }
+
+    _supportedModes = swapChain->querySurfaceCapabilities().presentModes;
+    _pendingMode = swapChain->getPresentMode();
+}
+
+PresentModeController::PresentModeController(const std::shared_ptr<ISwapChain>& swapChain)
+    : PresentModeController(swapChain, Config{}) {
+}
+
+void PresentModeController::setPolicy(LatencyPolicy policy) {
+    _config.policy = policy;
+    _pendingFrames = 0;
+}
+
+void PresentModeController::setInteractive(bool interactive) {
+    _interactive = interactive;
+    _pendingFrames = 0;
+}
+
+PresentMode PresentModeController::firstSupported(std::initializer_list<PresentMode> preferences) const {
+    for (PresentMode mode : preferences) {
+        if (std::find(_supportedModes.begin(), _supportedModes.end(), mode) != _supportedModes.end()) {
+            return mode;
+        }
+    }
+    // Fifo is the one mode every surface has to support
+    return PresentMode::Fifo;
+}
+
+PresentMode PresentModeController::chooseMode(PresentMode current) const {
+    if (!_interactive) {
+        return PresentMode::Fifo;
+    }
+
+    switch (_config.policy) {
+        case LatencyPolicy::PowerSaving:
+            return PresentMode::Fifo;
+        case LatencyPolicy::LowLatency:
+            return firstSupported({PresentMode::Mailbox, PresentMode::Immediate});
+        case LatencyPolicy::Balanced:
+        default: {
+            // Under Fifo the measured time includes the vsync wait and sits at the interval,
+            // so leave only on clear overruns and come back with headroom
+            const double interval = static_cast<double>(_config.targetFrameInterval.count());
+            const PresentMode fast = firstSupported({PresentMode::Mailbox, PresentMode::FifoRelaxed, PresentMode::Immediate});
+            if (current == PresentMode::Fifo) {
+                return _averageFrameTimeUs > interval * OVERRUN_RATIO ? fast : PresentMode::Fifo;
+            }
+            return _averageFrameTimeUs < interval * FIT_RATIO ? PresentMode::Fifo : fast;
+        }
+    }
+}
+
+void PresentModeController::recordFrame(std::chrono::microseconds frameTime) {
+    auto swapChain = _swapChain.lock();
+    if (!swapChain) {
+        return;
+    }
+
+    const double sample = static_cast<double>(frameTime.count());
+    _averageFrameTimeUs = _averageFrameTimeUs == 0.0
+        ? sample
+        : _averageFrameTimeUs + _config.smoothing * (sample - _averageFrameTimeUs);
+
+    const PresentMode current = swapChain->getPresentMode();
+    const PresentMode desired = chooseMode(current);
+    if (desired == current) {
+        _pendingFrames = 0;
+        return;
+    }
+
+    if (desired != _pendingMode) {
+        _pendingMode = desired;
+        _pendingFrames = 0;
+    }
+    if (++_pendingFrames < _config.switchHoldFrames) {
+        return;
+    }
+
+    _pendingFrames = 0;
+    if (swapChain->setPresentMode(desired)) {
+        ++_switches;
+        LOG_DEBUG("PresentModeController", 
+            "Present mode " + GraphicsEnumStrings::toString(current) + " -> " +
+            GraphicsEnumStrings::toString(desired) + " at " +
+            std::to_string(_averageFrameTimeUs / 1000.0) + " ms/frame");
+    } else {
+        // Don't retry every hold period, forget the mode until restarted
+        _supportedModes.erase(std::remove(_supportedModes.begin(), _supportedModes.end(), desired),
+                              _supportedModes.end());
+    }
+}
+
+void PresentModeController::recordFrame() {
+    const auto now = std::chrono::steady_clock::now();
+    if (_lastFrame.time_since_epoch().count() == 0) {
+        _lastFrame = now;
+        return;
+    }
+
+    auto frameTime = std::chrono::duration_cast<std::chrono::microseconds>(now - _lastFrame);
+    _lastFrame = now;
+    recordFrame(frameTime);
+}
+
+PresentModeController::Stats PresentModeController::getStats() const {
+    Stats stats;
+    if (auto swapChain = _swapChain.lock()) {
+        stats.currentMode = swapChain->getPresentMode();
+    }
+    stats.averageFrameTimeMs = _averageFrameTimeUs / 1000.0;
+    stats.switches = _switches;
+    return stats;
+}
+
+} // namespace pers
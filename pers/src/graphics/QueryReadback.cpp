@@ -0,0 +1,83 @@
+#include "pers/graphics/QueryReadback.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+QueryReadback::QueryReadback(const std::shared_ptr<ILogicalDevice>& device,
+                             const std::shared_ptr<IQuerySet>& querySet,
+                             uint32_t slotCount)
+    : _querySet(querySet) {
+    if (!device || !querySet || !querySet->isValid()) {
+        LOG_ERROR("QueryReadback", "Created with null device or invalid query set");
+        return;
+    }
+
+    _valuesPerQuery = getQueryValueCount(querySet->getDesc());
+    const uint64_t resultSize = static_cast<uint64_t>(querySet->getCount()) * _valuesPerQuery * QUERY_RESULT_SIZE;
+    _resolveBuffer = std::make_shared<DeviceBuffer>();
+    if (!_resolveBuffer->create(resultSize, DeviceBufferUsage::QueryResolve | DeviceBufferUsage::CopySrc,
+                                device, querySet->getDesc().label + " Resolve")) {
+        LOG_ERROR("QueryReadback", "Failed to create query resolve buffer");
+        _resolveBuffer.reset();
+        return;
+    }
+
+    auto readback = std::make_unique<ReadbackRing>(device, resultSize, slotCount,
+                                                   querySet->getDesc().label + " Readback");
+    if (readback->getSlotCount() == 0) {
+        _resolveBuffer.reset();
+        return;
+    }
+    _readback = std::move(readback);
+}
+
+QueryReadback::~QueryReadback() = default;
+
+uint64_t QueryReadback::resolve(const std::shared_ptr<ICommandEncoder>& encoder,
+                                uint32_t firstQuery,
+                                uint32_t queryCount) {
+    if (!_readback || !encoder) {
+        return 0;
+    }
+
+    if (firstQuery >= _querySet->getCount()) {
+        LOG_ERROR("QueryReadback", "First query is out of range");
+        return 0;
+    }
+    if (queryCount == 0) {
+        queryCount = _querySet->getCount() - firstQuery;
+    }
+
+    // Resolved values start at offset 0; the resolve offset must be 256-byte aligned
+    if (!encoder->resolveQuerySet(_querySet, firstQuery, queryCount, _resolveBuffer)) {
+        return 0;
+    }
+
+    BufferCopyDesc copy;
+    copy.size = static_cast<uint64_t>(queryCount) * _valuesPerQuery * QUERY_RESULT_SIZE;
+    return _readback->enqueue(encoder, _resolveBuffer, copy);
+}
+
+void QueryReadback::submitted() {
+    if (_readback) {
+        _readback->submitted();
+    }
+}
+
+size_t QueryReadback::collect(const ResultCallback& callback) {
+    if (!_readback) {
+        return 0;
+    }
+
+    return _readback->harvest([&callback](uint64_t ticket, const void* data, uint64_t size) {
+        if (callback) {
+            callback(ticket, std::span<const uint64_t>(static_cast<const uint64_t*>(data),
+                                                      static_cast<size_t>(size / QUERY_RESULT_SIZE)));
+        }
+    });
+}
+
+} // namespace pers
@@ -0,0 +1,627 @@
+#include "pers/graphics/RenderGraph.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+namespace {
+
+bool isSameTexture(const RenderGraphTextureDesc& a, const RenderGraphTextureDesc& b) {
+    return a.width == b.width &&
+           a.height == b.height &&
+           a.format == b.format &&
+           a.sampleCount == b.sampleCount &&
+           a.usage == b.usage;
+}
+
+bool hasStencil(TextureFormat format) {
+    return format == TextureFormat::Depth24PlusStencil8 ||
+           format == TextureFormat::Depth32FloatStencil8 ||
+           format == TextureFormat::Stencil8;
+}
+
+} // anonymous namespace
+
+void RenderGraphBuilder::writeColor(RenderGraphTexture texture, std::optional<Color> clearColor) {
+    _colorWrites.push_back(ColorWrite{texture, clearColor});
+}
+
+void RenderGraphBuilder::writeDepth(RenderGraphTexture texture, std::optional<float> clearDepth) {
+    _depth = DepthAccess{texture, clearDepth, false};
+}
+
+void RenderGraphBuilder::readDepth(RenderGraphTexture texture) {
+    _depth = DepthAccess{texture, std::nullopt, true};
+}
+
+void RenderGraphBuilder::read(RenderGraphTexture texture) {
+    _textureReads.push_back(texture);
+}
+
+void RenderGraphBuilder::read(RenderGraphBuffer buffer) {
+    _bufferReads.push_back(buffer);
+}
+
+void RenderGraphBuilder::write(RenderGraphBuffer buffer) {
+    _bufferWrites.push_back(buffer);
+}
+
+void RenderGraphBuilder::setSideEffect() {
+    _sideEffect = true;
+}
+
+std::shared_ptr<ITexture> RenderGraphContext::getTexture(RenderGraphTexture texture) const {
+    if (!_graph.isValidTexture(texture)) {
+        return nullptr;
+    }
+    const auto& resource = _graph._textures[texture.index];
+    if (resource.imported || resource.physical < 0) {
+        return nullptr;
+    }
+    return _graph._physicalTextures[resource.physical].texture;
+}
+
+std::shared_ptr<ITextureView> RenderGraphContext::getTextureView(RenderGraphTexture texture) const {
+    return _graph.resolveView(texture);
+}
+
+std::shared_ptr<IBuffer> RenderGraphContext::getBuffer(RenderGraphBuffer buffer) const {
+    if (buffer.index >= _graph._buffers.size()) {
+        return nullptr;
+    }
+    return _graph._buffers[buffer.index].buffer;
+}
+
+RenderGraph::RenderGraph(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("RenderGraph", "Resource factory is null");
+    }
+}
+
+RenderGraph::~RenderGraph() = default;
+
+RenderGraphTexture RenderGraph::createTexture(const RenderGraphTextureDesc& desc) {
+    if (desc.width == 0 || desc.height == 0 || desc.format == TextureFormat::Undefined) {
+        Logger::Instance().LogFormat(LogLevel::Error, "RenderGraph", PERS_SOURCE_LOC,
+            "Invalid transient texture '%s': %ux%u", desc.label.c_str(), desc.width, desc.height);
+        return {};
+    }
+
+    TextureResource resource;
+    resource.desc = desc;
+    _textures.push_back(std::move(resource));
+    _compiled = false;
+    return RenderGraphTexture{static_cast<uint32_t>(_textures.size() - 1)};
+}
+
+RenderGraphTexture RenderGraph::importTexture(const std::shared_ptr<ITextureView>& view,
+                                              const RenderGraphTextureDesc& desc) {
+    if (!view) {
+        LOG_ERROR("RenderGraph", "Cannot import null texture view");
+        return {};
+    }
+
+    TextureResource resource;
+    resource.desc = desc;
+    resource.importedView = view;
+    resource.imported = true;
+    _textures.push_back(std::move(resource));
+    _compiled = false;
+    return RenderGraphTexture{static_cast<uint32_t>(_textures.size() - 1)};
+}
+
+RenderGraphBuffer RenderGraph::importBuffer(const std::shared_ptr<IBuffer>& buffer) {
+    if (!buffer) {
+        LOG_ERROR("RenderGraph", "Cannot import null buffer");
+        return {};
+    }
+
+    _buffers.push_back(BufferResource{buffer});
+    _compiled = false;
+    return RenderGraphBuffer{static_cast<uint32_t>(_buffers.size() - 1)};
+}
+
+void RenderGraph::addPass(const std::string& name, const SetupFunction& setup, ExecuteFunction execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    if (setup) {
+        setup(pass.builder);
+    }
+    _passes.push_back(std::move(pass));
+    _compiled = false;
+}
+
+bool RenderGraph::isValidTexture(RenderGraphTexture texture) const {
+    return texture.index < _textures.size();
+}
+
+std::shared_ptr<ITextureView> RenderGraph::resolveView(RenderGraphTexture texture) const {
+    if (!isValidTexture(texture)) {
+        return nullptr;
+    }
+    const auto& resource = _textures[texture.index];
+    if (resource.imported) {
+        return resource.importedView;
+    }
+    return resource.physical >= 0 ? _physicalTextures[resource.physical].view : nullptr;
+}
+
+bool RenderGraph::compile() {
+    _stats = {};
+    _stats.declaredPasses = static_cast<uint32_t>(_passes.size());
+
+    // Reject dangling handles up front so later stages can index freely
+    for (const auto& pass : _passes) {
+        const auto& builder = pass.builder;
+        bool valid = std::all_of(builder._colorWrites.begin(), builder._colorWrites.end(),
+                                 [this](const auto& write) { return isValidTexture(write.texture); }) &&
+                     std::all_of(builder._textureReads.begin(), builder._textureReads.end(),
+                                 [this](RenderGraphTexture texture) { return isValidTexture(texture); }) &&
+                     (!builder._depth || isValidTexture(builder._depth->texture)) &&
+                     std::all_of(builder._bufferReads.begin(), builder._bufferReads.end(),
+                                 [this](RenderGraphBuffer buffer) { return buffer.index < _buffers.size(); }) &&
+                     std::all_of(builder._bufferWrites.begin(), builder._bufferWrites.end(),
+                                 [this](RenderGraphBuffer buffer) { return buffer.index < _buffers.size(); });
+        if (!valid) {
+            Logger::Instance().LogFormat(LogLevel::Error, "RenderGraph", PERS_SOURCE_LOC,
+                "Pass '%s' uses an invalid resource handle", pass.name.c_str());
+            return false;
+        }
+    }
+
+    cullPasses();
+    if (!assignPhysicalTextures()) {
+        return false;
+    }
+    buildRenderPassDescs();
+    mergeRenderPasses();
+
+    _compiled = true;
+    return true;
+}
+
+void RenderGraph::cullPasses() {
+    // Backward liveness: a pass lives if a later consumer needs something it writes.
+    // Imported resources are needed after the frame; a clear ends the need for older contents.
+    std::vector<bool> textureNeeded(_textures.size());
+    std::vector<bool> bufferNeeded(_buffers.size());
+    for (size_t i = 0; i < _textures.size(); ++i) {
+        textureNeeded[i] = _textures[i].imported;
+    }
+    for (size_t i = 0; i < _buffers.size(); ++i) {
+        bufferNeeded[i] = true;
+    }
+
+    for (auto it = _passes.rbegin(); it != _passes.rend(); ++it) {
+        Pass& pass = *it;
+        const auto& builder = pass.builder;
+
+        bool live = builder._sideEffect;
+        for (const auto& write : builder._colorWrites) {
+            live = live || textureNeeded[write.texture.index];
+        }
+        if (builder._depth && !builder._depth->readOnly) {
+            live = live || textureNeeded[builder._depth->texture.index];
+        }
+        for (RenderGraphBuffer buffer : builder._bufferWrites) {
+            live = live || bufferNeeded[buffer.index];
+        }
+
+        pass.culled = !live;
+        if (pass.culled) {
+            ++_stats.culledPasses;
+            continue;
+        }
+
+        for (const auto& write : builder._colorWrites) {
+            if (write.clearColor) {
+                textureNeeded[write.texture.index] = false;
+            }
+        }
+        if (builder._depth && !builder._depth->readOnly && builder._depth->clearDepth) {
+            textureNeeded[builder._depth->texture.index] = false;
+        }
+
+        // Writes without a clear load what earlier passes left
+        for (const auto& write : builder._colorWrites) {
+            if (!write.clearColor) {
+                textureNeeded[write.texture.index] = true;
+            }
+        }
+        if (builder._depth && !builder._depth->clearDepth) {
+            textureNeeded[builder._depth->texture.index] = true;
+        }
+        for (RenderGraphTexture texture : builder._textureReads) {
+            textureNeeded[texture.index] = true;
+        }
+        for (RenderGraphBuffer buffer : builder._bufferReads) {
+            bufferNeeded[buffer.index] = true;
+        }
+    }
+}
+
+int32_t RenderGraph::acquirePhysical(const RenderGraphTextureDesc& desc, uint32_t firstPass) {
+    for (size_t i = 0; i < _physicalTextures.size(); ++i) {
+        PhysicalTexture& slot = _physicalTextures[i];
+        bool free = !slot.assigned || slot.availableAfter < firstPass;
+        if (free && isSameTexture(slot.desc, desc)) {
+            slot.assigned = true;
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("RenderGraph", "Cannot allocate transient texture without factory");
+        return -1;
+    }
+
+    TextureDesc textureDesc;
+    textureDesc.width = desc.width;
+    textureDesc.height = desc.height;
+    textureDesc.format = desc.format;
+    textureDesc.sampleCount = desc.sampleCount;
+    textureDesc.usage = desc.usage;
+    textureDesc.label = desc.label.empty() ? "RenderGraphTransient" : desc.label;
+
+    PhysicalTexture slot;
+    slot.desc = desc;
+    slot.texture = factory->createTexture(textureDesc);
+    if (!slot.texture) {
+        Logger::Instance().LogFormat(LogLevel::Error, "RenderGraph", PERS_SOURCE_LOC,
+            "Failed to create transient texture '%s'", textureDesc.label.c_str());
+        return -1;
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = desc.format;
+    viewDesc.label = textureDesc.label;
+    slot.view = factory->createTextureView(slot.texture, viewDesc);
+    if (!slot.view) {
+        Logger::Instance().LogFormat(LogLevel::Error, "RenderGraph", PERS_SOURCE_LOC,
+            "Failed to create view for transient texture '%s'", textureDesc.label.c_str());
+        return -1;
+    }
+
+    slot.assigned = true;
+    _physicalTextures.push_back(std::move(slot));
+    ++_stats.texturesCreated;
+    return static_cast<int32_t>(_physicalTextures.size() - 1);
+}
+
+bool RenderGraph::assignPhysicalTextures() {
+    // Lifetimes over live passes, plus the usages the declarations imply
+    for (auto& texture : _textures) {
+        texture.firstPass = std::numeric_limits<uint32_t>::max();
+        texture.lastPass = 0;
+        texture.physical = -1;
+    }
+
+    for (uint32_t passIndex = 0; passIndex < _passes.size(); ++passIndex) {
+        const Pass& pass = _passes[passIndex];
+        if (pass.culled) {
+            continue;
+        }
+
+        auto touch = [&](RenderGraphTexture handle, TextureUsage usage) {
+            TextureResource& texture = _textures[handle.index];
+            texture.firstPass = std::min(texture.firstPass, passIndex);
+            texture.lastPass = std::max(texture.lastPass, passIndex);
+            texture.desc.usage = texture.desc.usage | usage;
+        };
+        for (const auto& write : pass.builder._colorWrites) {
+            touch(write.texture, TextureUsage::RenderAttachment);
+        }
+        if (pass.builder._depth) {
+            touch(pass.builder._depth->texture, TextureUsage::RenderAttachment);
+        }
+        for (RenderGraphTexture texture : pass.builder._textureReads) {
+            touch(texture, TextureUsage::TextureBinding);
+        }
+    }
+
+    // Slots nobody wanted for a while go first so they are not handed out again
+    _physicalTextures.erase(
+        std::remove_if(_physicalTextures.begin(), _physicalTextures.end(),
+                       [](const PhysicalTexture& slot) { return slot.idleFrames >= MAX_IDLE_FRAMES; }),
+        _physicalTextures.end());
+    for (auto& slot : _physicalTextures) {
+        slot.assigned = false;
+        slot.availableAfter = 0;
+    }
+
+    // Allocate in order of first use, a slot is reusable once its occupant's last pass ran
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < _textures.size(); ++i) {
+        if (!_textures[i].imported && _textures[i].firstPass != std::numeric_limits<uint32_t>::max()) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return _textures[a].firstPass < _textures[b].firstPass;
+    });
+
+    for (uint32_t index : order) {
+        TextureResource& texture = _textures[index];
+        texture.physical = acquirePhysical(texture.desc, texture.firstPass);
+        if (texture.physical < 0) {
+            return false;
+        }
+        _physicalTextures[texture.physical].availableAfter = texture.lastPass;
+    }
+
+    for (auto& slot : _physicalTextures) {
+        slot.idleFrames = slot.assigned ? 0 : slot.idleFrames + 1;
+        if (slot.assigned) {
+            ++_stats.physicalTextures;
+        }
+    }
+    _stats.transientTextures = static_cast<uint32_t>(order.size());
+    return true;
+}
+
+void RenderGraph::buildRenderPassDescs() {
+    std::vector<bool> written(_textures.size());
+
+    for (uint32_t passIndex = 0; passIndex < _passes.size(); ++passIndex) {
+        Pass& pass = _passes[passIndex];
+        pass.renderPassDesc = RenderPassDesc{};
+        if (pass.culled) {
+            continue;
+        }
+
+        // Contents survive the pass only if a later live pass or the caller uses them
+        auto chooseStore = [&](RenderGraphTexture handle) {
+            const TextureResource& texture = _textures[handle.index];
+            if (texture.imported || texture.lastPass > passIndex) {
+                return StoreOp::Store;
+            }
+            ++_stats.discardedStores;
+            return StoreOp::Discard;
+        };
+
+        // Undefined contents need no load, clearing is free on tiled GPUs
+        auto chooseLoad = [&](RenderGraphTexture handle, bool hasClear) {
+            bool firstWrite = !written[handle.index];
+            written[handle.index] = true;
+            if (hasClear || (firstWrite && !_textures[handle.index].imported)) {
+                return LoadOp::Clear;
+            }
+            return LoadOp::Load;
+        };
+
+        RenderPassDesc& desc = pass.renderPassDesc;
+        desc.label = pass.name;
+
+        for (const auto& write : pass.builder._colorWrites) {
+            RenderPassColorAttachment attachment;
+            attachment.view = resolveView(write.texture);
+            attachment.loadOp = chooseLoad(write.texture, write.clearColor.has_value());
+            attachment.clearColor = write.clearColor.value_or(Color{0.0f, 0.0f, 0.0f, 1.0f});
+            attachment.storeOp = chooseStore(write.texture);
+            desc.colorAttachments.push_back(attachment);
+        }
+
+        if (pass.builder._depth) {
+            const auto& depth = *pass.builder._depth;
+            auto attachment = std::make_shared<RenderPassDepthStencilAttachment>();
+            attachment->view = resolveView(depth.texture);
+            if (depth.readOnly) {
+                attachment->depthReadOnly = true;
+                attachment->stencilReadOnly = true;
+                attachment->depthLoadOp = LoadOp::Undefined;
+                attachment->stencilLoadOp = LoadOp::Undefined;
+            } else {
+                attachment->depthLoadOp = chooseLoad(depth.texture, depth.clearDepth.has_value());
+                attachment->depthClearValue = depth.clearDepth.value_or(1.0f);
+                attachment->depthStoreOp = chooseStore(depth.texture);
+                if (hasStencil(_textures[depth.texture.index].desc.format)) {
+                    attachment->stencilLoadOp = attachment->depthLoadOp;
+                    attachment->stencilStoreOp = attachment->depthStoreOp;
+                } else {
+                    attachment->stencilLoadOp = LoadOp::Undefined;
+                    attachment->stencilStoreOp = StoreOp::Discard;
+                }
+            }
+            desc.depthStencilAttachment = attachment;
+        }
+    }
+}
+
+bool RenderGraph::canMerge(uint32_t groupStart, uint32_t passIndex) const {
+    const auto& head = _passes[groupStart].builder;
+    const auto& next = _passes[passIndex].builder;
+    if (next._colorWrites.empty() && !next._depth) {
+        return false;
+    }
+
+    // Same attachments in the same order, none cleared again
+    if (next._colorWrites.size() != head._colorWrites.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < next._colorWrites.size(); ++i) {
+        if (next._colorWrites[i].texture.index != head._colorWrites[i].texture.index ||
+            next._colorWrites[i].clearColor) {
+            return false;
+        }
+    }
+    if (head._depth.has_value() != next._depth.has_value()) {
+        return false;
+    }
+    if (next._depth) {
+        // A read-only pass can follow a writing one, not the other way round
+        if (next._depth->texture.index != head._depth->texture.index ||
+            (head._depth->readOnly && !next._depth->readOnly) ||
+            (!next._depth->readOnly && next._depth->clearDepth)) {
+            return false;
+        }
+    }
+
+    // The state reset needs the attachment extent; imports may leave it undeclared
+    const RenderGraphTexture sizing = head._colorWrites.empty() ? head._depth->texture : head._colorWrites[0].texture;
+    const auto& sizingDesc = _textures[sizing.index].desc;
+    if (sizingDesc.width == 0 || sizingDesc.height == 0) {
+        return false;
+    }
+
+    // An attachment cannot be sampled inside its own pass
+    auto isAttachment = [&](RenderGraphTexture texture) {
+        return std::any_of(head._colorWrites.begin(), head._colorWrites.end(),
+                           [&](const auto& write) { return write.texture.index == texture.index; }) ||
+               (head._depth && head._depth->texture.index == texture.index);
+    };
+    if (std::any_of(next._textureReads.begin(), next._textureReads.end(), isAttachment)) {
+        return false;
+    }
+
+    // One render pass is one usage scope: a buffer written anywhere in it cannot also be read
+    auto contains = [](const std::vector<RenderGraphBuffer>& buffers, RenderGraphBuffer buffer) {
+        return std::any_of(buffers.begin(), buffers.end(),
+                           [&](RenderGraphBuffer other) { return other.index == buffer.index; });
+    };
+    for (uint32_t i = groupStart; i < passIndex; ++i) {
+        const Pass& pass = _passes[i];
+        if (pass.culled) {
+            continue;
+        }
+        for (RenderGraphBuffer buffer : next._bufferReads) {
+            if (contains(pass.builder._bufferWrites, buffer)) {
+                return false;
+            }
+        }
+        for (RenderGraphBuffer buffer : next._bufferWrites) {
+            if (contains(pass.builder._bufferWrites, buffer) || contains(pass.builder._bufferReads, buffer)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void RenderGraph::mergeRenderPasses() {
+    uint32_t groupStart = std::numeric_limits<uint32_t>::max();
+    for (uint32_t passIndex = 0; passIndex < _passes.size(); ++passIndex) {
+        Pass& pass = _passes[passIndex];
+        pass.continuesPrevious = false;
+        if (pass.culled) {
+            continue;
+        }
+
+        if (groupStart == std::numeric_limits<uint32_t>::max() || !canMerge(groupStart, passIndex)) {
+            const bool isRenderPass = !pass.builder._colorWrites.empty() || pass.builder._depth;
+            groupStart = isRenderPass ? passIndex : std::numeric_limits<uint32_t>::max();
+            continue;
+        }
+
+        // The head keeps its load ops and takes the stores of the pass that now ends the group
+        RenderPassDesc& head = _passes[groupStart].renderPassDesc;
+        const RenderPassDesc& next = pass.renderPassDesc;
+        for (size_t i = 0; i < head.colorAttachments.size(); ++i) {
+            head.colorAttachments[i].storeOp = next.colorAttachments[i].storeOp;
+        }
+        if (head.depthStencilAttachment && !head.depthStencilAttachment->depthReadOnly) {
+            auto& attachment = *head.depthStencilAttachment;
+            if (!next.depthStencilAttachment->depthReadOnly) {
+                attachment.depthStoreOp = next.depthStencilAttachment->depthStoreOp;
+                attachment.stencilStoreOp = next.depthStencilAttachment->stencilStoreOp;
+            } else {
+                // Read-only passes chose no store; decide as if the group ended here
+                const TextureResource& texture = _textures[pass.builder._depth->texture.index];
+                if (!texture.imported && texture.lastPass <= passIndex && attachment.depthStoreOp == StoreOp::Store) {
+                    attachment.depthStoreOp = StoreOp::Discard;
+                    attachment.stencilStoreOp = StoreOp::Discard;
+                    ++_stats.discardedStores;
+                }
+            }
+        }
+        head.label += "+" + pass.name;
+
+        pass.continuesPrevious = true;
+        ++_stats.mergedPasses;
+    }
+}
+
+bool RenderGraph::execute(ICommandEncoder& encoder) {
+    if (!_compiled) {
+        LOG_ERROR("RenderGraph", "Execute called before compile");
+        return false;
+    }
+
+    RenderGraphContext context(*this, encoder);
+    std::shared_ptr<IRenderPassEncoder> renderPass;
+    for (Pass& pass : _passes) {
+        if (pass.culled) {
+            continue;
+        }
+
+        if (pass.continuesPrevious && renderPass) {
+            // Give the merged pass the state a pass of its own would start with
+            const auto& builder = pass.builder;
+            const RenderGraphTexture sizing = builder._colorWrites.empty() ? builder._depth->texture
+                                                                           : builder._colorWrites[0].texture;
+            const auto& sizingDesc = _textures[sizing.index].desc;
+            renderPass->setViewport(0.0f, 0.0f, static_cast<float>(sizingDesc.width),
+                                    static_cast<float>(sizingDesc.height));
+            renderPass->setScissorRect(0, 0, sizingDesc.width, sizingDesc.height);
+            renderPass->setStencilReference(0);
+            renderPass->setBlendConstant(Color{0.0f, 0.0f, 0.0f, 0.0f});
+        } else {
+            if (renderPass) {
+                renderPass->end();
+                renderPass.reset();
+            }
+
+            const RenderPassDesc& desc = pass.renderPassDesc;
+            if (desc.colorAttachments.empty() && !desc.depthStencilAttachment) {
+                context._renderPass = nullptr;
+                if (pass.execute) {
+                    pass.execute(context);
+                }
+                continue;
+            }
+
+            renderPass = encoder.beginRenderPass(desc);
+            if (!renderPass) {
+                Logger::Instance().LogFormat(LogLevel::Error, "RenderGraph", PERS_SOURCE_LOC,
+                    "Failed to begin render pass '%s'", pass.name.c_str());
+                return false;
+            }
+        }
+
+        context._renderPass = renderPass.get();
+        if (pass.execute) {
+            pass.execute(context);
+        }
+    }
+    if (renderPass) {
+        renderPass->end();
+    }
+    context._renderPass = nullptr;
+    return true;
+}
+
+void RenderGraph::reset() {
+    _passes.clear();
+    _textures.clear();
+    _buffers.clear();
+    _compiled = false;
+}
+
+void RenderGraph::releaseUnusedTextures() {
+    _physicalTextures.erase(
+        std::remove_if(_physicalTextures.begin(), _physicalTextures.end(),
+                       [](const PhysicalTexture& slot) { return !slot.assigned; }),
+        _physicalTextures.end());
+    // Slot indices moved, the textures' assignments are stale
+    _compiled = false;
+}
+
+} // namespace pers
@@ -0,0 +1,326 @@
+#include "pers/graphics/RenderJobService.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/ThreadAffinity.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace pers {
+
+std::unique_ptr<RenderJobService> RenderJobService::create(std::unique_ptr<DevicePool> pool, const Config& config,
+                                                           const RendererFactory& factory) {
+    if (!pool || pool->getDeviceCount() == 0 || !factory) {
+        LOG_ERROR("RenderJobService", "Needs a device pool and a renderer factory");
+        return nullptr;
+    }
+
+    std::unique_ptr<RenderJobService> service(new RenderJobService());
+    service->_config = config;
+    service->_config.maxBatchSize = std::max(1u, config.maxBatchSize);
+    service->_config.maxScenesPerDevice = std::max(1u, config.maxScenesPerDevice);
+
+    for (uint32_t i = 0; i < pool->getDeviceCount(); ++i) {
+        auto renderer = factory(i, pool->getDevice(i));
+        if (!renderer) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "RenderJobService", PERS_SOURCE_LOC,
+                "Skipping device '%s', no renderer", pool->getDeviceName(i).c_str());
+            continue;
+        }
+        auto device = std::make_unique<Device>();
+        device->index = i;
+        device->renderer = std::move(renderer);
+        device->stats.deviceName = pool->getDeviceName(i);
+        service->_devices.push_back(std::move(device));
+    }
+    if (service->_devices.empty()) {
+        LOG_ERROR("RenderJobService", "No device has a renderer");
+        return nullptr;
+    }
+
+    service->_pool = std::move(pool);
+    for (auto& device : service->_devices) {
+        Device* raw = device.get();
+        device->thread = std::thread([service = service.get(), raw] { service->deviceLoop(*raw); });
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "RenderJobService", PERS_SOURCE_LOC,
+        "Serving render jobs on %zu device(s)", service->_devices.size());
+    return service;
+}
+
+RenderJobService::~RenderJobService() {
+    std::vector<std::pair<Device*, QueuedJob>> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        for (auto& device : _devices) {
+            for (auto& job : device->jobs) {
+                cancelled.emplace_back(device.get(), std::move(job));
+            }
+            device->inFlight += static_cast<uint32_t>(device->jobs.size());
+            device->jobs.clear();
+            device->cv.notify_all();
+        }
+    }
+    _idleCv.notify_all();
+
+    for (auto& [device, job] : cancelled) {
+        RenderJobResult result;
+        result.jobId = job.id;
+        result.deviceIndex = device->index;
+        result.error = "Service stopped";
+        finish(*device, job, result);
+    }
+
+    // Threads drain their OffscreenRenderQueue before they exit; renderers
+    // go before the pool that owns their devices
+    for (auto& device : _devices) {
+        device->thread.join();
+    }
+    _devices.clear();
+}
+
+uint64_t RenderJobService::submit(const RenderJob& job, CompletionFunction onComplete) {
+    if (job.width == 0 || job.height == 0) {
+        LOG_ERROR("RenderJobService", "Job has no size");
+        return 0;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_stopping) {
+        return 0;
+    }
+    Device* device = _devices[pickDevice(job.scene)].get();
+    if (_config.maxQueuedJobs != 0) {
+        _idleCv.wait(lock, [&] { return _stopping || device->jobs.size() < _config.maxQueuedJobs; });
+        if (_stopping) {
+            return 0;
+        }
+    }
+
+    QueuedJob queued;
+    queued.id = _nextJobId.fetch_add(1, std::memory_order_relaxed);
+    queued.job = job;
+    queued.onComplete = std::move(onComplete);
+    const uint64_t id = queued.id;
+    device->jobs.push_back(std::move(queued));
+    device->lastRoutedScene = job.scene;
+    ++_pending;
+    device->cv.notify_one();
+    return id;
+}
+
+bool RenderJobService::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _idleCv.wait_for(lock, timeout, [this] { return _pending == 0; });
+}
+
+std::vector<RenderJobService::DeviceStats> RenderJobService::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<DeviceStats> stats;
+    stats.reserve(_devices.size());
+    for (const auto& device : _devices) {
+        DeviceStats deviceStats = device->stats;
+        deviceStats.queued = static_cast<uint32_t>(device->jobs.size());
+        deviceStats.residentScenes = static_cast<uint32_t>(device->scenes.size());
+        stats.push_back(deviceStats);
+    }
+    return stats;
+}
+
+void RenderJobService::deviceLoop(Device& device) {
+    Profiler::setThreadName("Render Job Device " + std::to_string(device.index));
+    ThreadAffinity::applyCurrentThread(ThreadRole::Render, device.index);
+
+    OffscreenRenderQueue& queue = *_pool->getQueue(device.index);
+    IRenderJobRenderer& renderer = *device.renderer;
+
+    // Jobs handed to the queue; the queue reports failed readbacks only as
+    // a count, so whatever is left here after a drain has failed
+    std::unordered_map<uint64_t, QueuedJob> outstanding;
+    uint64_t failedReadbacks = queue.getStats().failed;
+
+    auto completeOutstanding = [&](uint64_t id, const OffscreenImage* image, const char* error) {
+        auto found = outstanding.find(id);
+        if (found == outstanding.end()) {
+            return;
+        }
+        RenderJobResult result;
+        result.jobId = id;
+        result.deviceIndex = device.index;
+        result.image = image;
+        if (error) {
+            result.error = error;
+        }
+        finish(device, found->second, result);
+        outstanding.erase(found);
+    };
+
+    auto drain = [&] {
+        if (!queue.waitIdle()) {
+            LOG_WARNING("RenderJobService", "Timed out waiting for readbacks");
+        }
+        failedReadbacks = queue.getStats().failed;
+        while (!outstanding.empty()) {
+            completeOutstanding(outstanding.begin()->first, nullptr, "Readback failed");
+        }
+    };
+
+    while (true) {
+        bool hasJobs = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            hasJobs = !device.jobs.empty();
+        }
+        if (!hasJobs && !outstanding.empty()) {
+            // Nothing to overlap the readbacks with, deliver them now
+            drain();
+            continue;
+        }
+
+        std::vector<QueuedJob> batch = takeBatch(device);
+        if (batch.empty()) {
+            break;
+        }
+
+        const std::string scene = batch.front().job.scene;
+        if (!makeResident(device, scene)) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "RenderJobService", PERS_SOURCE_LOC,
+                "Scene '%s' could not be prepared, failing %zu job(s)", scene.c_str(), batch.size());
+            for (const auto& job : batch) {
+                RenderJobResult result;
+                result.jobId = job.id;
+                result.deviceIndex = device.index;
+                result.error = "Scene could not be prepared";
+                finish(device, job, result);
+            }
+            continue;
+        }
+
+        for (auto& job : batch) {
+            const uint64_t id = job.id;
+            const QueuedJob& entry = outstanding.emplace(id, std::move(job)).first->second;
+
+            OffscreenRenderJobDesc desc;
+            desc.width = entry.job.width;
+            desc.height = entry.job.height;
+            desc.colorFormat = entry.job.format;
+            desc.depthFormat = entry.job.depthFormat;
+            desc.label = "Render Job " + std::to_string(id);
+
+            const uint64_t queueJob = queue.submit(desc,
+                [&renderer, &entry](ICommandEncoder& encoder, const IFramebuffer& target) {
+                    return renderer.record(entry.job, encoder, target);
+                },
+                [&completeOutstanding, id](const OffscreenImage& image) {
+                    completeOutstanding(id, &image, nullptr);
+                });
+            if (queueJob == 0) {
+                completeOutstanding(id, nullptr, "Recording or submission failed");
+            }
+            if (queue.getStats().failed != failedReadbacks) {
+                drain();
+            }
+        }
+    }
+
+    drain();
+}
+
+std::vector<RenderJobService::QueuedJob> RenderJobService::takeBatch(Device& device) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    device.cv.wait(lock, [&] { return !device.jobs.empty() || _stopping; });
+    if (device.jobs.empty()) {
+        return {};
+    }
+
+    // The oldest job picks the scene; later jobs of that scene jump ahead
+    // of other scenes so the batch shares one prepareScene()
+    std::vector<QueuedJob> batch;
+    const std::string scene = device.jobs.front().job.scene;
+    for (auto it = device.jobs.begin(); it != device.jobs.end() && batch.size() < _config.maxBatchSize;) {
+        if (it->job.scene == scene) {
+            batch.push_back(std::move(*it));
+            it = device.jobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    device.inFlight += static_cast<uint32_t>(batch.size());
+    ++device.stats.batches;
+    _idleCv.notify_all();
+    return batch;
+}
+
+bool RenderJobService::makeResident(Device& device, const std::string& scene) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto found = std::find(device.scenes.begin(), device.scenes.end(), scene);
+        if (found != device.scenes.end()) {
+            device.scenes.splice(device.scenes.begin(), device.scenes, found);
+            return true;
+        }
+    }
+
+    if (!device.renderer->prepareScene(scene)) {
+        return false;
+    }
+
+    std::string evicted;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++device.stats.scenesPrepared;
+        device.scenes.push_front(scene);
+        if (device.scenes.size() > _config.maxScenesPerDevice) {
+            evicted = std::move(device.scenes.back());
+            device.scenes.pop_back();
+        }
+    }
+    // Submitted work keeps the GPU objects it uses alive, so jobs of the
+    // evicted scene still in flight are unaffected
+    if (!evicted.empty()) {
+        device.renderer->releaseScene(evicted);
+    }
+    return true;
+}
+
+uint32_t RenderJobService::pickDevice(const std::string& scene) const {
+    // Least loaded device, unless one that has the scene is within the slack
+    auto load = [](const Device& device) { return device.jobs.size() + device.inFlight; };
+
+    uint32_t least = 0;
+    uint32_t affine = UINT32_MAX;
+    for (uint32_t i = 0; i < _devices.size(); ++i) {
+        const Device& device = *_devices[i];
+        if (load(device) < load(*_devices[least])) {
+            least = i;
+        }
+        const bool hasScene = device.lastRoutedScene == scene ||
+            std::find(device.scenes.begin(), device.scenes.end(), scene) != device.scenes.end();
+        if (hasScene && (affine == UINT32_MAX || load(device) < load(*_devices[affine]))) {
+            affine = i;
+        }
+    }
+    if (affine != UINT32_MAX && load(*_devices[affine]) <= load(*_devices[least]) + _config.sceneAffinitySlack) {
+        return affine;
+    }
+    return least;
+}
+
+void RenderJobService::finish(Device& device, const QueuedJob& job, const RenderJobResult& result) {
+    if (job.onComplete) {
+        job.onComplete(job.job, result);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (result.image) {
+        ++device.stats.completed;
+    } else {
+        ++device.stats.failed;
+    }
+    --device.inFlight;
+    --_pending;
+    _idleCv.notify_all();
+}
+
+} // namespace pers
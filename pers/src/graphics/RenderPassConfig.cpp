@@ -47,6 +47,10 @@ RenderPassDesc RenderPassConfig::makeDescriptor(const std::shared_ptr<IFramebuff
         colorAttachment.loadOp = _colorConfigs[i].loadOp;
         colorAttachment.storeOp = _colorConfigs[i].storeOp;
         colorAttachment.clearColor = _colorConfigs[i].clearColor;
+        colorAttachment.resolveTarget = framebuffer->getResolveTarget(i);
+        if (colorAttachment.resolveTarget && !_colorConfigs[i].keepMultisampled) {
+            colorAttachment.storeOp = StoreOp::Discard;
+        }
         desc.colorAttachments.push_back(colorAttachment);
     }
     
@@ -71,4 +75,24 @@ RenderPassDesc RenderPassConfig::makeDescriptor(const std::shared_ptr<IFramebuff
     return desc;
 }
 
+bool RenderPassConfig::retarget(IPreparedRenderPass& pass, const std::shared_ptr<IFramebuffer>& framebuffer) const {
+    if (!framebuffer) {
+        LOG_ERROR("RenderPassConfig", "Cannot retarget to a null framebuffer");
+        return false;
+    }
+    
+    const auto& desc = pass.getDesc();
+    for (uint32_t i = 0; i < desc.colorAttachments.size(); ++i) {
+        if (!pass.setColorView(i, framebuffer->getColorAttachment(i))) {
+            return false;
+        }
+        pass.setResolveTarget(i, framebuffer->getResolveTarget(i));
+    }
+    
+    if (desc.depthStencilAttachment) {
+        return pass.setDepthStencilView(framebuffer->getDepthStencilAttachment());
+    }
+    return true;
+}
+
 } // namespace pers
\ No newline at end of file
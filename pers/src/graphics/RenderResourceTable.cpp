@@ -0,0 +1,201 @@
+#include "pers/graphics/RenderResourceTable.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+template<typename Entry, typename Object>
+template<typename Handle>
+Handle RenderResourceTable::SlotArray<Entry, Object>::insert(std::shared_ptr<Object> owner, const Entry& entry) {
+    uint32_t index;
+    if (!freeList.empty()) {
+        index = freeList.back();
+        freeList.pop_back();
+    } else {
+        if (generations.size() > Handle::MAX_INDEX) {
+            LOG_ERROR("RenderResourceTable", "Slot limit reached, cannot add resource");
+            return {};
+        }
+        index = static_cast<uint32_t>(generations.size());
+        generations.push_back(0);
+        entries.emplace_back();
+        owners.emplace_back();
+    }
+
+    generations[index] = Handle::nextGeneration(generations[index]);
+    entries[index] = entry;
+    owners[index] = std::move(owner);
+    ++liveCount;
+    return Handle{index, generations[index]};
+}
+
+template<typename Entry, typename Object>
+template<typename Handle>
+bool RenderResourceTable::SlotArray<Entry, Object>::erase(Handle handle) {
+    if (!find(handle)) {
+        return false;
+    }
+
+    generations[handle.index] = Handle::nextGeneration(generations[handle.index]);
+    entries[handle.index] = Entry{};
+    owners[handle.index].reset();
+    freeList.push_back(handle.index);
+    --liveCount;
+    return true;
+}
+
+template<typename Entry, typename Object>
+void RenderResourceTable::SlotArray<Entry, Object>::clear() {
+    // Keep generations so handles issued before clear() stay stale
+    freeList.clear();
+    for (uint32_t i = 0; i < generations.size(); ++i) {
+        if (generations[i] & 1u) {
+            generations[i] = BufferHandle::nextGeneration(generations[i]);
+        }
+        entries[i] = Entry{};
+        owners[i].reset();
+        freeList.push_back(i);
+    }
+    liveCount = 0;
+}
+
+void RenderResourceTable::reportStaleHandle(uint32_t index, uint32_t generation) {
+    Logger::Instance().LogFormat(LogLevel::Warning, "RenderResourceTable", PERS_SOURCE_LOC,
+        "Stale handle (index %u, generation %u) resolved to null", index, generation);
+}
+
+PipelineHandle RenderResourceTable::add(const std::shared_ptr<IRenderPipeline>& pipeline) {
+    if (!pipeline) {
+        LOG_ERROR("RenderResourceTable", "Cannot add null pipeline");
+        return {};
+    }
+
+    PipelineEntry entry;
+    entry.pipeline = pipeline.get();
+    // Async handles switch from fallback to compiled pipeline, resolve those per call
+    if (!dynamic_cast<const AsyncRenderPipeline*>(pipeline.get())) {
+        entry.native = pipeline->getNativePipelineHandle();
+    }
+    return _pipelines.insert<PipelineHandle>(pipeline, entry);
+}
+
+BufferHandle RenderResourceTable::add(const std::shared_ptr<IBuffer>& buffer) {
+    if (!buffer) {
+        LOG_ERROR("RenderResourceTable", "Cannot add null buffer");
+        return {};
+    }
+
+    BufferEntry entry;
+    entry.buffer = buffer.get();
+    entry.size = buffer->getSize();
+    return _buffers.insert<BufferHandle>(buffer, entry);
+}
+
+BindGroupHandle RenderResourceTable::add(const std::shared_ptr<IBindGroup>& bindGroup) {
+    if (!bindGroup) {
+        LOG_ERROR("RenderResourceTable", "Cannot add null bind group");
+        return {};
+    }
+
+    return _bindGroups.insert<BindGroupHandle>(bindGroup, bindGroup->getNativeBindGroupHandle());
+}
+
+TextureViewHandle RenderResourceTable::add(const std::shared_ptr<ITextureView>& view) {
+    if (!view) {
+        LOG_ERROR("RenderResourceTable", "Cannot add null texture view");
+        return {};
+    }
+
+    return _textureViews.insert<TextureViewHandle>(view, view->getNativeTextureViewHandle());
+}
+
+SamplerHandle RenderResourceTable::add(const std::shared_ptr<ISampler>& sampler) {
+    if (!sampler) {
+        LOG_ERROR("RenderResourceTable", "Cannot add null sampler");
+        return {};
+    }
+
+    return _samplers.insert<SamplerHandle>(sampler, sampler->getNativeSamplerHandle());
+}
+
+bool RenderResourceTable::remove(PipelineHandle handle) {
+    return _pipelines.erase(handle);
+}
+
+bool RenderResourceTable::remove(BufferHandle handle) {
+    return _buffers.erase(handle);
+}
+
+bool RenderResourceTable::remove(BindGroupHandle handle) {
+    return _bindGroups.erase(handle);
+}
+
+bool RenderResourceTable::remove(TextureViewHandle handle) {
+    return _textureViews.erase(handle);
+}
+
+bool RenderResourceTable::remove(SamplerHandle handle) {
+    return _samplers.erase(handle);
+}
+
+NativePipelineHandle RenderResourceTable::resolve(PipelineHandle handle) const {
+    const PipelineEntry* entry = _pipelines.find(handle);
+    if (!entry) {
+        return nullptr;
+    }
+    return entry->native ? entry->native : entry->pipeline->getNativePipelineHandle();
+}
+
+const RenderResourceTable::BufferEntry* RenderResourceTable::resolve(BufferHandle handle) const {
+    return _buffers.find(handle);
+}
+
+NativeBindGroupHandle RenderResourceTable::resolve(BindGroupHandle handle) const {
+    const NativeBindGroupHandle* entry = _bindGroups.find(handle);
+    return entry ? *entry : nullptr;
+}
+
+NativeTextureViewHandle RenderResourceTable::resolve(TextureViewHandle handle) const {
+    const NativeTextureViewHandle* entry = _textureViews.find(handle);
+    return entry ? *entry : nullptr;
+}
+
+NativeSamplerHandle RenderResourceTable::resolve(SamplerHandle handle) const {
+    const NativeSamplerHandle* entry = _samplers.find(handle);
+    return entry ? *entry : nullptr;
+}
+
+std::shared_ptr<IRenderPipeline> RenderResourceTable::getObject(PipelineHandle handle) const {
+    return _pipelines.findOwner(handle);
+}
+
+std::shared_ptr<IBuffer> RenderResourceTable::getObject(BufferHandle handle) const {
+    return _buffers.findOwner(handle);
+}
+
+std::shared_ptr<IBindGroup> RenderResourceTable::getObject(BindGroupHandle handle) const {
+    return _bindGroups.findOwner(handle);
+}
+
+std::shared_ptr<ITextureView> RenderResourceTable::getObject(TextureViewHandle handle) const {
+    return _textureViews.findOwner(handle);
+}
+
+std::shared_ptr<ISampler> RenderResourceTable::getObject(SamplerHandle handle) const {
+    return _samplers.findOwner(handle);
+}
+
+void RenderResourceTable::clear() {
+    _pipelines.clear();
+    _buffers.clear();
+    _bindGroups.clear();
+    _textureViews.clear();
+    _samplers.clear();
+}
+
+} // namespace pers
@@ -0,0 +1,101 @@
+#include "pers/graphics/SamplerCache.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+uint64_t SamplerCache::computeHash(const SamplerDesc& desc) {
+    Fnv1aHasher hasher;
+    hasher.add(desc.magFilter);
+    hasher.add(desc.minFilter);
+    hasher.add(desc.mipmapFilter);
+    hasher.add(desc.addressModeU);
+    hasher.add(desc.addressModeV);
+    hasher.add(desc.addressModeW);
+    hasher.add(desc.lodMinClamp);
+    hasher.add(desc.lodMaxClamp);
+    hasher.add(desc.compare);
+    hasher.add(desc.maxAnisotropy);
+    return hasher.get();
+}
+
+bool SamplerCache::isEquivalent(const SamplerDesc& a, const SamplerDesc& b) {
+    return a.magFilter == b.magFilter &&
+           a.minFilter == b.minFilter &&
+           a.mipmapFilter == b.mipmapFilter &&
+           a.addressModeU == b.addressModeU &&
+           a.addressModeV == b.addressModeV &&
+           a.addressModeW == b.addressModeW &&
+           a.lodMinClamp == b.lodMinClamp &&
+           a.lodMaxClamp == b.lodMaxClamp &&
+           a.compare == b.compare &&
+           a.maxAnisotropy == b.maxAnisotropy;
+}
+
+std::shared_ptr<ISampler> SamplerCache::find(uint64_t hash, const SamplerDesc& desc) const {
+    std::shared_ptr<ISampler> sampler;
+    _entries.visit(hash, [&](const Entry& entry) {
+        if (!isEquivalent(entry.desc, desc)) {
+            return false;
+        }
+        sampler = entry.sampler;
+        return true;
+    });
+    return sampler;
+}
+
+std::shared_ptr<ISampler> SamplerCache::getOrCreate(const SamplerDesc& desc, const CreateFunction& create) {
+    const uint64_t hash = computeHash(desc);
+    if (auto existing = find(hash, desc)) {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return existing;
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    if (!create) {
+        LOG_ERROR("SamplerCache", "Sampler create function is null");
+        return nullptr;
+    }
+
+    auto sampler = create(desc);
+    if (!sampler || !sampler->isValid()) {
+        return nullptr;
+    }
+
+    // Another thread may have created the same desc meanwhile, keep the first one
+    bool existed = false;
+    auto cached = _entries.insert(hash, Entry{desc, sampler}, [&](const Entry& entry) {
+        return existed = isEquivalent(entry.desc, desc);
+    });
+    if (existed) {
+        return cached.sampler;
+    }
+
+    const size_t count = _count.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (count > WARN_SAMPLER_COUNT && !_warned.exchange(true, std::memory_order_relaxed)) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "SamplerCache", PERS_SOURCE_LOC,
+            "%zu unique samplers alive, backends may run out of sampler slots", count);
+    }
+    return sampler;
+}
+
+size_t SamplerCache::trim() {
+    const size_t released = _entries.removeIf([](const Entry& entry) { return entry.sampler.use_count() <= 1; });
+    _count.fetch_sub(released, std::memory_order_relaxed);
+    return released;
+}
+
+void SamplerCache::clear() {
+    _count.fetch_sub(_entries.clear(), std::memory_order_relaxed);
+}
+
+SamplerCache::Stats SamplerCache::getStats() const {
+    Stats stats;
+    stats.hits = _hits.load(std::memory_order_relaxed);
+    stats.misses = _misses.load(std::memory_order_relaxed);
+    stats.entries = _count.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace pers
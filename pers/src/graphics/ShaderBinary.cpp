@@ -0,0 +1,70 @@
+#include "pers/graphics/ShaderBinary.h"
+#include <fstream>
+#include <utility>
+
+namespace pers {
+
+namespace {
+
+// Magic, version, generator, bound and schema
+constexpr size_t SPIRV_HEADER_WORDS = 5;
+
+void setError(std::string* error, std::string message) {
+    if (error) {
+        *error = std::move(message);
+    }
+}
+
+} // anonymous namespace
+
+bool isSpirvBinary(std::span<const uint32_t> words) {
+    return words.size() >= SPIRV_HEADER_WORDS && words[0] == SPIRV_MAGIC;
+}
+
+bool loadSpirvFile(const std::string& path, std::vector<uint32_t>& words, std::string* error) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        setError(error, "cannot open " + path);
+        return false;
+    }
+
+    const std::streamsize size = file.tellg();
+    if (size <= 0 || size % sizeof(uint32_t) != 0) {
+        setError(error, path + " is not a whole number of SPIR-V words");
+        return false;
+    }
+
+    words.resize(static_cast<size_t>(size) / sizeof(uint32_t));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(words.data()), size)) {
+        setError(error, "failed to read " + path);
+        words.clear();
+        return false;
+    }
+
+    if (!isSpirvBinary(words)) {
+        // A byte-swapped magic means a binary cooked for the other endianness
+        setError(error, path + " does not start with a native-endian SPIR-V header");
+        words.clear();
+        return false;
+    }
+    return true;
+}
+
+bool saveSpirvFile(const std::string& path, std::span<const uint32_t> words, std::string* error) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        setError(error, "cannot open " + path + " for writing");
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(words.data()),
+               static_cast<std::streamsize>(words.size_bytes()));
+    if (!file) {
+        setError(error, "failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,364 @@
+#include "pers/graphics/ShaderBundle.h"
+#include "pers/graphics/ShaderBinary.h"
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace pers {
+
+namespace {
+
+constexpr char BUNDLE_MAGIC[8] = {'P', 'E', 'R', 'S', 'S', 'H', 'D', 'B'};
+
+// Header, permutation table, blob table, strings, then blob data, each 8-byte
+// aligned so the tables can be read in place from the mapping
+struct BundleHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t permutationCount;
+    uint32_t blobCount;
+    uint32_t reserved;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+struct PermutationRecord {
+    uint64_t key;
+    uint32_t nameOffset;     // Into the string area
+    uint32_t nameSize;
+    uint32_t definesOffset;
+    uint32_t definesSize;
+    uint32_t spirvBlob;      // Into the blob table
+    uint32_t reflectionBlob;
+};
+
+struct BlobRecord {
+    uint64_t offset;  // From the start of the file
+    uint64_t size;
+};
+
+static_assert(sizeof(BundleHeader) % 8 == 0 && sizeof(PermutationRecord) % 8 == 0 && sizeof(BlobRecord) % 8 == 0);
+
+constexpr uint64_t alignUp(uint64_t value) {
+    return (value + 7) & ~uint64_t(7);
+}
+
+const BundleHeader& header(const MappedFile& file) {
+    return *reinterpret_cast<const BundleHeader*>(file.data());
+}
+
+const PermutationRecord* permutations(const MappedFile& file) {
+    return reinterpret_cast<const PermutationRecord*>(file.data() + sizeof(BundleHeader));
+}
+
+const BlobRecord* blobs(const MappedFile& file) {
+    return reinterpret_cast<const BlobRecord*>(
+        file.data() + sizeof(BundleHeader) + header(file).permutationCount * sizeof(PermutationRecord));
+}
+
+std::string_view string(const MappedFile& file, uint32_t offset, uint32_t size) {
+    return std::string_view(reinterpret_cast<const char*>(file.data() + header(file).stringsOffset + offset), size);
+}
+
+void setError(std::string* error, std::string message) {
+    if (error) {
+        *error = std::move(message);
+    }
+}
+
+} // anonymous namespace
+
+uint64_t ShaderBundle::computeKey(std::string_view name, std::string_view canonicalDefines) {
+    Fnv1aHasher hasher;
+    hasher.addString(name);
+    hasher.addString(canonicalDefines);
+    return hasher.get();
+}
+
+std::string ShaderBundle::canonicalDefines(const ShaderDefines& defines) {
+    std::string result;
+    for (const auto& [name, value] : defines) {
+        result += name;
+        result += '=';
+        result += value;
+        result += '\n';
+    }
+    return result;
+}
+
+std::shared_ptr<ShaderBundle> ShaderBundle::open(const std::string& path) {
+    std::shared_ptr<ShaderBundle> bundle(new ShaderBundle());
+    bundle->_path = path;
+    MappedFile& file = bundle->_file;
+    if (!file.open(path)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "Failed to map shader bundle %s", path.c_str());
+        return nullptr;
+    }
+
+    if (file.size() < sizeof(BundleHeader) ||
+        std::memcmp(header(file).magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "%s is not a shader bundle", path.c_str());
+        return nullptr;
+    }
+
+    const BundleHeader& head = header(file);
+    if (head.version != FORMAT_VERSION) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "%s has bundle format %u, expected %u; re-cook it", path.c_str(), head.version, FORMAT_VERSION);
+        return nullptr;
+    }
+
+    // Validate every table entry once, so lookups can trust them
+    const uint64_t tablesEnd = sizeof(BundleHeader) +
+        uint64_t(head.permutationCount) * sizeof(PermutationRecord) +
+        uint64_t(head.blobCount) * sizeof(BlobRecord);
+    bool valid = tablesEnd <= head.stringsOffset && head.stringsOffset <= file.size() &&
+                 head.stringsSize <= file.size() - head.stringsOffset;
+    for (uint32_t i = 0; valid && i < head.blobCount; ++i) {
+        const BlobRecord& blob = blobs(file)[i];
+        valid = blob.offset % 8 == 0 && blob.offset <= file.size() && blob.size <= file.size() - blob.offset;
+    }
+    for (uint32_t i = 0; valid && i < head.permutationCount; ++i) {
+        const PermutationRecord& record = permutations(file)[i];
+        valid = uint64_t(record.nameOffset) + record.nameSize <= head.stringsSize &&
+                uint64_t(record.definesOffset) + record.definesSize <= head.stringsSize &&
+                record.spirvBlob < head.blobCount && record.reflectionBlob < head.blobCount &&
+                (i == 0 || permutations(file)[i - 1].key <= record.key);
+    }
+    if (!valid) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "Shader bundle %s is truncated or corrupt", path.c_str());
+        return nullptr;
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "ShaderBundle", PERS_SOURCE_LOC,
+        "Mapped %u shader permutations from %s", head.permutationCount, path.c_str());
+    return bundle;
+}
+
+const void* ShaderBundle::findPermutation(std::string_view name, const ShaderDefines& defines) const {
+    const std::string canonical = canonicalDefines(defines);
+    const uint64_t key = computeKey(name, canonical);
+
+    const PermutationRecord* begin = permutations(_file);
+    const PermutationRecord* end = begin + header(_file).permutationCount;
+    auto it = std::lower_bound(begin, end, key,
+        [](const PermutationRecord& record, uint64_t value) { return record.key < value; });
+    // Equal keys are adjacent, compare the strings to rule out collisions
+    for (; it != end && it->key == key; ++it) {
+        if (string(_file, it->nameOffset, it->nameSize) == name &&
+            string(_file, it->definesOffset, it->definesSize) == canonical) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const ShaderReflection> ShaderBundle::getReflection(uint32_t blob) const {
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _reflections.find(blob);
+        if (it != _reflections.end()) {
+            return it->second;
+        }
+    }
+
+    // Decode outside the lock, a racing thread just decodes the same blob
+    const BlobRecord& record = blobs(_file)[blob];
+    auto reflection = std::make_shared<const ShaderReflection>(
+        ShaderReflection::deserialize(_file.data() + record.offset, static_cast<size_t>(record.size)));
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _reflections.emplace(blob, std::move(reflection)).first->second;
+}
+
+bool ShaderBundle::getModuleDesc(std::string_view name, std::string_view entryPoint,
+                                 const ShaderDefines& defines, ShaderModuleDesc& desc) const {
+    const auto* record = static_cast<const PermutationRecord*>(findPermutation(name, defines));
+    if (!record) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "Shader %.*s with defines {%s} is not in %s", static_cast<int>(name.size()), name.data(),
+            canonicalDefines(defines).c_str(), _path.c_str());
+        return false;
+    }
+
+    auto reflection = getReflection(record->reflectionBlob);
+    const ShaderEntryPoint* entry = reflection->isValid() ? reflection->findEntryPoint(entryPoint) : nullptr;
+    if (!entry) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderBundle", PERS_SOURCE_LOC,
+            "Shader %.*s has no entry point %.*s in %s", static_cast<int>(name.size()), name.data(),
+            static_cast<int>(entryPoint.size()), entryPoint.data(), _path.c_str());
+        return false;
+    }
+
+    const BlobRecord& spirv = blobs(_file)[record->spirvBlob];
+    const auto* words = reinterpret_cast<const uint32_t*>(_file.data() + spirv.offset);
+    desc = ShaderModuleDesc{};
+    desc.spirv.assign(words, words + spirv.size / sizeof(uint32_t));
+    desc.reflection = std::move(reflection);
+    desc.stage = entry->stage;
+    desc.entryPoint = std::string(entryPoint);
+    desc.debugName = std::string(name) + ":" + desc.entryPoint;
+    return true;
+}
+
+std::shared_ptr<IShaderModule> ShaderBundle::getModule(ShaderLibrary& library, std::string_view name,
+                                                       std::string_view entryPoint,
+                                                       const ShaderDefines& defines) const {
+    ShaderModuleDesc desc;
+    if (!getModuleDesc(name, entryPoint, defines, desc)) {
+        return nullptr;
+    }
+    return library.getModule(desc);
+}
+
+bool ShaderBundle::contains(std::string_view name, const ShaderDefines& defines) const {
+    return findPermutation(name, defines) != nullptr;
+}
+
+size_t ShaderBundle::getPermutationCount() const {
+    return header(_file).permutationCount;
+}
+
+ShaderBundle::PermutationInfo ShaderBundle::getPermutation(size_t index) const {
+    PermutationInfo info;
+    if (index >= getPermutationCount()) {
+        return info;
+    }
+    const PermutationRecord& record = permutations(_file)[index];
+    info.name = string(_file, record.nameOffset, record.nameSize);
+    info.defines = string(_file, record.definesOffset, record.definesSize);
+    info.spirvBytes = blobs(_file)[record.spirvBlob].size;
+    return info;
+}
+
+bool ShaderBundleWriter::add(const std::string& name, const ShaderDefines& defines, std::vector<uint32_t> spirv,
+                             const ShaderReflection& reflection, std::string* error) {
+    if (!isSpirvBinary(spirv)) {
+        setError(error, name + " is not SPIR-V");
+        return false;
+    }
+    if (!reflection.isValid()) {
+        setError(error, name + " has no valid reflection");
+        return false;
+    }
+
+    Permutation permutation;
+    permutation.name = name;
+    permutation.defines = ShaderBundle::canonicalDefines(defines);
+    permutation.key = ShaderBundle::computeKey(permutation.name, permutation.defines);
+    for (const auto& existing : _permutations) {
+        if (existing.key == permutation.key && existing.name == permutation.name &&
+            existing.defines == permutation.defines) {
+            setError(error, name + " was already added with the same defines");
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> spirvBytes(spirv.size() * sizeof(uint32_t));
+    std::memcpy(spirvBytes.data(), spirv.data(), spirvBytes.size());
+    std::vector<uint8_t> reflectionBytes;
+    reflection.serialize(reflectionBytes);
+
+    permutation.spirvBlob = addBlob(std::move(spirvBytes));
+    permutation.reflectionBlob = addBlob(std::move(reflectionBytes));
+    _permutations.push_back(std::move(permutation));
+    return true;
+}
+
+uint32_t ShaderBundleWriter::addBlob(std::vector<uint8_t> bytes) {
+    Fnv1aHasher hasher;
+    hasher.addBytes(bytes.data(), bytes.size());
+    auto& candidates = _blobsByHash[hasher.get()];
+    for (uint32_t index : candidates) {
+        if (_blobs[index] == bytes) {
+            return index;
+        }
+    }
+    const auto index = static_cast<uint32_t>(_blobs.size());
+    _blobs.push_back(std::move(bytes));
+    candidates.push_back(index);
+    return index;
+}
+
+bool ShaderBundleWriter::save(const std::string& path, std::string* error) const {
+    // Lookups binary-search by key; ties keep insertion order
+    std::vector<const Permutation*> sorted;
+    sorted.reserve(_permutations.size());
+    for (const auto& permutation : _permutations) {
+        sorted.push_back(&permutation);
+    }
+    std::stable_sort(sorted.begin(), sorted.end(),
+        [](const Permutation* a, const Permutation* b) { return a->key < b->key; });
+
+    std::string strings;
+    std::vector<PermutationRecord> records;
+    records.reserve(sorted.size());
+    for (const Permutation* permutation : sorted) {
+        PermutationRecord record = {};
+        record.key = permutation->key;
+        record.nameOffset = static_cast<uint32_t>(strings.size());
+        record.nameSize = static_cast<uint32_t>(permutation->name.size());
+        strings += permutation->name;
+        record.definesOffset = static_cast<uint32_t>(strings.size());
+        record.definesSize = static_cast<uint32_t>(permutation->defines.size());
+        strings += permutation->defines;
+        record.spirvBlob = permutation->spirvBlob;
+        record.reflectionBlob = permutation->reflectionBlob;
+        records.push_back(record);
+    }
+
+    BundleHeader head = {};
+    std::memcpy(head.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+    head.version = ShaderBundle::FORMAT_VERSION;
+    head.permutationCount = static_cast<uint32_t>(records.size());
+    head.blobCount = static_cast<uint32_t>(_blobs.size());
+    head.stringsOffset = sizeof(BundleHeader) + records.size() * sizeof(PermutationRecord) +
+                         _blobs.size() * sizeof(BlobRecord);
+    head.stringsSize = strings.size();
+
+    std::vector<BlobRecord> blobRecords(_blobs.size());
+    uint64_t offset = alignUp(head.stringsOffset + head.stringsSize);
+    for (size_t i = 0; i < _blobs.size(); ++i) {
+        blobRecords[i].offset = offset;
+        blobRecords[i].size = _blobs[i].size();
+        offset = alignUp(offset + _blobs[i].size());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        setError(error, "cannot open " + path + " for writing");
+        return false;
+    }
+
+    const char padding[8] = {};
+    auto pad = [&]() {
+        const auto position = static_cast<uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(alignUp(position) - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<std::streamsize>(records.size() * sizeof(PermutationRecord)));
+    file.write(reinterpret_cast<const char*>(blobRecords.data()),
+               static_cast<std::streamsize>(blobRecords.size() * sizeof(BlobRecord)));
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    pad();
+    for (const auto& blob : _blobs) {
+        file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+        pad();
+    }
+
+    if (!file) {
+        setError(error, "failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,251 @@
+#include "pers/graphics/ShaderHotReloader.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace pers {
+
+ShaderHotReloader::ShaderHotReloader(const std::shared_ptr<IResourceFactory>& factory,
+                                     std::chrono::milliseconds pollInterval)
+    : _factory(factory)
+    , _library(factory)
+    , _pollInterval(pollInterval) {
+}
+
+ShaderHotReloader::~ShaderHotReloader() = default;
+
+bool ShaderHotReloader::readFile(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    contents = stream.str();
+    return true;
+}
+
+std::shared_ptr<IShaderModule> ShaderHotReloader::loadModule(const std::string& path, const ShaderModuleDesc& desc,
+                                                             const ShaderDefines& defines) {
+    std::error_code error;
+    const auto lastWrite = std::filesystem::last_write_time(path, error);
+    ShaderModuleDesc moduleDesc = desc;
+    if (error || !readFile(path, moduleDesc.code)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderHotReloader", PERS_SOURCE_LOC,
+            "Failed to read shader file '%s'", path.c_str());
+        return nullptr;
+    }
+    if (moduleDesc.debugName.empty()) {
+        moduleDesc.debugName = path;
+    }
+
+    auto module = _library.getModule(moduleDesc, defines);
+    if (!module) {
+        return nullptr;
+    }
+
+    moduleDesc.code.clear();  // Re-read on every reload
+    _modules.push_back({path, std::move(moduleDesc), defines, module});
+    auto [file, inserted] = _files.try_emplace(path);
+    if (inserted) {
+        file->second.lastWrite = lastWrite;
+    }
+    file->second.modules.push_back(_modules.size() - 1);
+    return module;
+}
+
+std::shared_ptr<AsyncRenderPipeline> ShaderHotReloader::createRenderPipeline(const RenderPipelineDesc& desc) {
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("ShaderHotReloader", "Resource factory was destroyed");
+        return nullptr;
+    }
+    auto handle = factory->createRenderPipelineAsync(desc);
+    if (!handle) {
+        return nullptr;
+    }
+
+    const size_t index = _pipelines.size();
+    _pipelines.push_back({handle, desc});
+    for (const auto* module : {desc.vertex.get(), desc.fragment.get()}) {
+        if (module) {
+            _dependents[module].push_back(index);
+        }
+    }
+    return handle;
+}
+
+size_t ShaderHotReloader::poll() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - _lastPoll < _pollInterval) {
+        return 0;
+    }
+    _lastPoll = now;
+
+    size_t reloaded = 0;
+    ModuleReplacements replaced;
+    for (auto& [path, file] : _files) {
+        std::error_code error;
+        const auto lastWrite = std::filesystem::last_write_time(path, error);
+        if (error || lastWrite == file.lastWrite) {
+            // A missing file is usually an editor mid-save, check again next poll
+            continue;
+        }
+        file.lastWrite = lastWrite;
+        if (reloadFile(path, file, replaced)) {
+            ++reloaded;
+        }
+    }
+    rebuildDependents(replaced);
+    return reloaded;
+}
+
+bool ShaderHotReloader::reload(const std::string& path) {
+    auto it = _files.find(path);
+    if (it == _files.end()) {
+        return false;
+    }
+    std::error_code error;
+    const auto lastWrite = std::filesystem::last_write_time(path, error);
+    if (!error) {
+        it->second.lastWrite = lastWrite;
+    }
+
+    ModuleReplacements replaced;
+    const bool reloaded = reloadFile(path, it->second, replaced);
+    rebuildDependents(replaced);
+    return reloaded;
+}
+
+bool ShaderHotReloader::reloadFile(const std::string& path, FileRecord& file, ModuleReplacements& replaced) {
+    std::string code;
+    if (!readFile(path, code)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderHotReloader", PERS_SOURCE_LOC,
+            "Failed to read shader file '%s'", path.c_str());
+        ++_stats.failedFiles;
+        return false;
+    }
+
+    // Compile every module of the file before replacing any, so a broken
+    // save never leaves pipelines mixing old and new stages
+    std::vector<std::shared_ptr<IShaderModule>> modules;
+    modules.reserve(file.modules.size());
+    for (size_t index : file.modules) {
+        const ModuleRecord& record = _modules[index];
+        ShaderModuleDesc desc = record.desc;
+        desc.code = code;
+        auto module = _library.getModule(desc, record.defines);
+        if (!module) {
+            Logger::Instance().LogFormat(LogLevel::Error, "ShaderHotReloader", PERS_SOURCE_LOC,
+                "Failed to recompile '%s' (%s), keeping the previous shader",
+                path.c_str(), record.desc.entryPoint.c_str());
+            ++_stats.failedFiles;
+            return false;
+        }
+        modules.push_back(std::move(module));
+    }
+
+    for (size_t i = 0; i < file.modules.size(); ++i) {
+        ModuleRecord& record = _modules[file.modules[i]];
+        // The library returns the same module when the preprocessed source is
+        // unchanged, so saves that only touch the file rebuild nothing
+        if (modules[i] != record.module) {
+            replaced[record.module.get()] = modules[i];
+            record.module = std::move(modules[i]);
+        }
+    }
+
+    LOG_INFO("ShaderHotReloader", "Reloaded " + path);
+    ++_stats.reloadedFiles;
+    return true;
+}
+
+void ShaderHotReloader::rebuildDependents(const ModuleReplacements& replaced) {
+    if (replaced.empty()) {
+        return;
+    }
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("ShaderHotReloader", "Resource factory was destroyed");
+        return;
+    }
+
+    std::vector<size_t> affected;
+    for (const auto& [oldModule, newModule] : replaced) {
+        auto it = _dependents.find(oldModule);
+        if (it == _dependents.end()) {
+            continue;
+        }
+        std::vector<size_t> pipelines = std::move(it->second);
+        _dependents.erase(it);
+        affected.insert(affected.end(), pipelines.begin(), pipelines.end());
+        auto& target = _dependents[newModule.get()];
+        target.insert(target.end(), pipelines.begin(), pipelines.end());
+    }
+    std::sort(affected.begin(), affected.end());
+    affected.erase(std::unique(affected.begin(), affected.end()), affected.end());
+
+    for (size_t index : affected) {
+        PipelineRecord& record = _pipelines[index];
+        if (record.handle.expired()) {
+            continue;
+        }
+        for (auto* stage : {&record.desc.vertex, &record.desc.fragment}) {
+            auto it = *stage ? replaced.find(stage->get()) : replaced.end();
+            if (it != replaced.end()) {
+                *stage = it->second;
+            }
+        }
+
+        auto build = factory->createRenderPipelineAsync(record.desc);
+        if (!build) {
+            ++_stats.failedPipelines;
+            continue;
+        }
+        // A newer save supersedes a rebuild that has not been applied yet
+        auto pending = std::find_if(_pending.begin(), _pending.end(),
+                                    [&](const PendingRebuild& rebuild) { return rebuild.pipeline == index; });
+        if (pending != _pending.end()) {
+            pending->build = std::move(build);
+        } else {
+            _pending.push_back({index, std::move(build)});
+        }
+    }
+}
+
+size_t ShaderHotReloader::applyReloads() {
+    size_t swapped = 0;
+    auto it = _pending.begin();
+    while (it != _pending.end()) {
+        const auto state = it->build->getState();
+        if (state == AsyncRenderPipeline::State::Pending) {
+            ++it;
+            continue;
+        }
+
+        auto handle = _pipelines[it->pipeline].handle.lock();
+        if (state == AsyncRenderPipeline::State::Failed) {
+            LOG_ERROR("ShaderHotReloader", "Failed to rebuild pipeline " +
+                      (handle ? handle->getDebugName() : std::string("<released>")) + ", keeping the previous one");
+            ++_stats.failedPipelines;
+        } else if (handle && handle->replace(it->build->getPipeline())) {
+            ++_stats.rebuiltPipelines;
+            ++swapped;
+        }
+        it = _pending.erase(it);
+    }
+    return swapped;
+}
+
+ShaderHotReloader::Stats ShaderHotReloader::getStats() const {
+    Stats stats = _stats;
+    stats.watchedFiles = _files.size();
+    stats.trackedPipelines = static_cast<size_t>(std::count_if(_pipelines.begin(), _pipelines.end(),
+        [](const PipelineRecord& record) { return !record.handle.expired(); }));
+    return stats;
+}
+
+} // namespace pers
@@ -0,0 +1,311 @@
+#include "pers/graphics/ShaderLibrary.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <cctype>
+#include <sstream>
+#include <vector>
+
+namespace pers {
+
+namespace {
+
+bool isIdentifierStart(char c) {
+    return std::isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+std::string_view trimWhitespace(std::string_view text) {
+    size_t begin = 0;
+    while (begin < text.size() && std::isspace(static_cast<unsigned char>(text[begin]))) {
+        ++begin;
+    }
+    size_t end = text.size();
+    while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) {
+        --end;
+    }
+    return text.substr(begin, end - begin);
+}
+
+// Replace whole identifiers that name a valued define
+void substituteDefines(std::string_view line, const ShaderDefines& defines, std::string& output) {
+    size_t i = 0;
+    while (i < line.size()) {
+        if (!isIdentifierStart(line[i])) {
+            output.push_back(line[i++]);
+            continue;
+        }
+
+        size_t start = i;
+        while (i < line.size() && isIdentifierChar(line[i])) {
+            ++i;
+        }
+        std::string identifier(line.substr(start, i - start));
+
+        auto it = defines.find(identifier);
+        if (it != defines.end() && !it->second.empty()) {
+            output += it->second;
+        } else {
+            output += identifier;
+        }
+    }
+}
+
+struct ConditionalBlock {
+    bool parentActive;
+    bool active;
+    bool seenElse;
+};
+
+uint64_t computeRequestKey(const ShaderModuleDesc& desc, const ShaderDefines& defines) {
+    Fnv1aHasher hasher;
+    hasher.addString(desc.code);
+    hasher.addBytes(desc.spirv.data(), desc.spirv.size() * sizeof(uint32_t));
+    hasher.addString(desc.entryPoint);
+    hasher.add(desc.stage);
+    hasher.add(static_cast<uint64_t>(defines.size()));
+    for (const auto& [name, value] : defines) {
+        hasher.addString(name);
+        hasher.addString(value);
+    }
+    return hasher.get();
+}
+
+uint64_t computeSourceKey(const std::string& source, const ShaderModuleDesc& desc) {
+    Fnv1aHasher hasher;
+    hasher.addString(source);
+    hasher.addBytes(desc.spirv.data(), desc.spirv.size() * sizeof(uint32_t));
+    hasher.addString(desc.entryPoint);
+    hasher.add(desc.stage);
+    return hasher.get();
+}
+
+} // anonymous namespace
+
+ShaderLibrary::ShaderLibrary(const std::shared_ptr<IResourceFactory>& factory)
+    : _factory(factory) {
+    if (!factory) {
+        LOG_ERROR("ShaderLibrary", "Created with null resource factory");
+    }
+}
+
+bool ShaderLibrary::preprocess(const std::string& source, const ShaderDefines& defines,
+                               std::string& output, std::string* error) {
+    ShaderDefines active = defines;
+    std::vector<ConditionalBlock> blocks;
+
+    output.clear();
+    output.reserve(source.size());
+
+    auto fail = [&](size_t lineNumber, const std::string& message) {
+        if (error) {
+            std::stringstream ss;
+            ss << "line " << lineNumber << ": " << message;
+            *error = ss.str();
+        }
+        return false;
+    };
+
+    size_t lineNumber = 0;
+    size_t position = 0;
+    while (position <= source.size()) {
+        size_t end = source.find('\n', position);
+        if (end == std::string::npos) {
+            end = source.size();
+        }
+        std::string_view line(source.data() + position, end - position);
+        ++lineNumber;
+
+        const bool emitting = blocks.empty() || blocks.back().active;
+        std::string_view trimmed = trimWhitespace(line);
+
+        if (!trimmed.empty() && trimmed.front() == '#') {
+            std::string_view directive = trimWhitespace(trimmed.substr(1));
+            size_t split = 0;
+            while (split < directive.size() && isIdentifierChar(directive[split])) {
+                ++split;
+            }
+            std::string_view keyword = directive.substr(0, split);
+            std::string_view argument = trimWhitespace(directive.substr(split));
+
+            size_t nameLength = 0;
+            while (nameLength < argument.size() && isIdentifierChar(argument[nameLength])) {
+                ++nameLength;
+            }
+            std::string name(argument.substr(0, nameLength));
+
+            if (keyword == "ifdef" || keyword == "ifndef" || keyword == "if") {
+                if (name.empty()) {
+                    return fail(lineNumber, "#" + std::string(keyword) + " requires a name");
+                }
+                bool condition = false;
+                auto it = active.find(name);
+                if (keyword == "ifdef") {
+                    condition = it != active.end();
+                } else if (keyword == "ifndef") {
+                    condition = it == active.end();
+                } else if (std::isdigit(static_cast<unsigned char>(name.front()))) {
+                    condition = name != "0";
+                } else {
+                    condition = it != active.end() && it->second != "0";
+                }
+                blocks.push_back(ConditionalBlock{emitting, emitting && condition, false});
+            } else if (keyword == "else") {
+                if (blocks.empty() || blocks.back().seenElse) {
+                    return fail(lineNumber, "Unexpected #else");
+                }
+                auto& block = blocks.back();
+                block.active = block.parentActive && !block.active;
+                block.seenElse = true;
+            } else if (keyword == "endif") {
+                if (blocks.empty()) {
+                    return fail(lineNumber, "Unexpected #endif");
+                }
+                blocks.pop_back();
+            } else if (keyword == "define") {
+                if (name.empty()) {
+                    return fail(lineNumber, "#define requires a name");
+                }
+                if (emitting) {
+                    active[name] = std::string(trimWhitespace(argument.substr(nameLength)));
+                }
+            } else if (keyword == "undef") {
+                if (name.empty()) {
+                    return fail(lineNumber, "#undef requires a name");
+                }
+                if (emitting) {
+                    active.erase(name);
+                }
+            } else {
+                return fail(lineNumber, "Unknown directive #" + std::string(keyword));
+            }
+        } else if (emitting) {
+            substituteDefines(line, active, output);
+        }
+
+        // Keep line count identical for compiler diagnostics
+        if (end < source.size()) {
+            output.push_back('\n');
+        }
+        position = end + 1;
+    }
+
+    if (!blocks.empty()) {
+        return fail(lineNumber, "Missing #endif");
+    }
+    return true;
+}
+
+std::shared_ptr<IShaderModule> ShaderLibrary::getModule(const ShaderModuleDesc& desc, const ShaderDefines& defines) {
+    const uint64_t requestKey = computeRequestKey(desc, defines);
+
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _permutations.find(requestKey);
+        if (it != _permutations.end()) {
+            ++_permutationHits;
+            return it->second;
+        }
+    }
+
+    // Cooked binaries were preprocessed offline, their defines are baked in
+    if (!desc.spirv.empty() && !defines.empty()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderLibrary", PERS_SOURCE_LOC,
+            "Defines cannot be applied to SPIR-V shader %s, cook the permutation instead",
+            desc.debugName.c_str());
+        return nullptr;
+    }
+
+    ShaderModuleDesc permutationDesc = desc;
+    std::string error;
+    if (!preprocess(desc.code, defines, permutationDesc.code, &error)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShaderLibrary", PERS_SOURCE_LOC,
+            "Failed to preprocess shader %s: %s", desc.debugName.c_str(), error.c_str());
+        return nullptr;
+    }
+
+    const uint64_t sourceKey = computeSourceKey(permutationDesc.code, desc);
+
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _modules.find(sourceKey);
+        if (it != _modules.end()) {
+            ++_sourceHits;
+            _permutations.emplace(requestKey, it->second);
+            return it->second;
+        }
+    }
+
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("ShaderLibrary", "Resource factory is no longer available");
+        return nullptr;
+    }
+
+    // Compile outside the lock
+    auto module = factory->createShaderModule(permutationDesc);
+    if (!module || !module->isValid()) {
+        return nullptr;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    // Another thread may have compiled the same source meanwhile, keep the first one
+    auto [it, inserted] = _modules.emplace(sourceKey, module);
+    if (inserted) {
+        ++_compiled;
+    }
+    _permutations.emplace(requestKey, it->second);
+    return it->second;
+}
+
+size_t ShaderLibrary::trim() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    // Permutation entries add references too, drop those first
+    std::unordered_map<const IShaderModule*, long> libraryRefs;
+    for (const auto& [key, module] : _permutations) {
+        ++libraryRefs[module.get()];
+    }
+
+    size_t released = 0;
+    for (auto it = _modules.begin(); it != _modules.end();) {
+        const long external = it->second.use_count() - 1 - libraryRefs[it->second.get()];
+        if (external <= 0) {
+            const IShaderModule* module = it->second.get();
+            for (auto perm = _permutations.begin(); perm != _permutations.end();) {
+                if (perm->second.get() == module) {
+                    perm = _permutations.erase(perm);
+                } else {
+                    ++perm;
+                }
+            }
+            it = _modules.erase(it);
+            ++released;
+        } else {
+            ++it;
+        }
+    }
+    return released;
+}
+
+void ShaderLibrary::clear() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _permutations.clear();
+    _modules.clear();
+}
+
+ShaderLibrary::Stats ShaderLibrary::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    Stats stats;
+    stats.permutationHits = _permutationHits;
+    stats.sourceHits = _sourceHits;
+    stats.compiled = _compiled;
+    stats.permutations = _permutations.size();
+    stats.modules = _modules.size();
+    return stats;
+}
+
+} // namespace pers
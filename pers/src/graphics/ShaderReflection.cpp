@@ -0,0 +1,977 @@
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace pers {
+
+namespace {
+
+struct Token {
+    enum class Kind { Identifier, Number, Symbol, End };
+    Kind kind = Kind::End;
+    std::string_view text;
+};
+
+struct Attribute {
+    std::string_view name;
+    std::vector<std::vector<Token>> arguments;  // Tokens of each comma-separated argument
+};
+
+// Parsed type expression, e.g. array<vec4<f32>, 6>
+struct TypeNode {
+    std::string_view name;      // Identifier, or the literal for numeric template arguments
+    bool isNumber = false;
+    std::vector<TypeNode> arguments;
+};
+
+struct StructMember {
+    std::vector<Attribute> attributes;
+    std::string_view name;
+    TypeNode type;
+};
+
+struct FunctionInfo {
+    std::vector<Attribute> attributes;
+    std::vector<StructMember> parameters;
+    std::unordered_set<std::string_view> identifiers;  // Everything the body names
+};
+
+bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool isIdentifierChar(char c) {
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+std::vector<Token> tokenize(std::string_view source) {
+    std::vector<Token> tokens;
+    size_t pos = 0;
+    while (pos < source.size()) {
+        const char c = source[pos];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            ++pos;
+        } else if (source.substr(pos, 2) == "//") {
+            while (pos < source.size() && source[pos] != '\n') {
+                ++pos;
+            }
+        } else if (source.substr(pos, 2) == "/*") {
+            // Block comments nest in WGSL
+            int depth = 0;
+            do {
+                if (source.substr(pos, 2) == "/*") {
+                    ++depth;
+                    pos += 2;
+                } else if (source.substr(pos, 2) == "*/") {
+                    --depth;
+                    pos += 2;
+                } else {
+                    ++pos;
+                }
+            } while (depth > 0 && pos < source.size());
+        } else if (isIdentifierChar(c)) {
+            // Numbers share the identifier scan so suffixes (1u, 0.5f, 0x10) stay one token
+            const size_t start = pos;
+            while (pos < source.size() && (isIdentifierChar(source[pos]) || (!isIdentifierStart(c) && source[pos] == '.'))) {
+                ++pos;
+            }
+            tokens.push_back({isIdentifierStart(c) ? Token::Kind::Identifier : Token::Kind::Number,
+                              source.substr(start, pos - start)});
+        } else if (source.substr(pos, 2) == "->") {
+            tokens.push_back({Token::Kind::Symbol, source.substr(pos, 2)});
+            pos += 2;
+        } else {
+            tokens.push_back({Token::Kind::Symbol, source.substr(pos, 1)});
+            ++pos;
+        }
+    }
+    tokens.push_back({Token::Kind::End, {}});
+    return tokens;
+}
+
+// Integer literal value, false for anything with a fractional part or an expression
+bool parseInteger(std::string_view text, uint32_t& value) {
+    uint32_t base = 10;
+    size_t pos = 0;
+    if (text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X')) {
+        base = 16;
+        pos = 2;
+    }
+    if (!text.empty() && (text.back() == 'u' || text.back() == 'i')) {
+        text.remove_suffix(1);
+    }
+    if (pos >= text.size()) {
+        return false;
+    }
+    uint64_t result = 0;
+    for (; pos < text.size(); ++pos) {
+        const char c = text[pos];
+        uint32_t digit = 0;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if (base == 16 && c >= 'a' && c <= 'f') {
+            digit = static_cast<uint32_t>(c - 'a' + 10);
+        } else if (base == 16 && c >= 'A' && c <= 'F') {
+            digit = static_cast<uint32_t>(c - 'A' + 10);
+        } else {
+            return false;
+        }
+        result = result * base + digit;
+        if (result > UINT32_MAX) {
+            return false;
+        }
+    }
+    value = static_cast<uint32_t>(result);
+    return true;
+}
+
+const Attribute* findAttribute(const std::vector<Attribute>& attributes, std::string_view name) {
+    for (const auto& attribute : attributes) {
+        if (attribute.name == name) {
+            return &attribute;
+        }
+    }
+    return nullptr;
+}
+
+bool readAttributeInteger(const std::vector<Attribute>& attributes, std::string_view name, uint32_t& value) {
+    const Attribute* attribute = findAttribute(attributes, name);
+    return attribute && attribute->arguments.size() == 1 && attribute->arguments[0].size() == 1 &&
+           parseInteger(attribute->arguments[0][0].text, value);
+}
+
+} // anonymous namespace
+
+/**
+ * Single pass over the token stream filling a ShaderReflection
+ */
+class WgslReflector {
+public:
+    explicit WgslReflector(std::string_view source) : _tokens(tokenize(source)) {}
+
+    bool run(ShaderReflection& reflection) {
+        struct PendingBinding {
+            ShaderBindingInfo info;
+            bool derivable = true;
+        };
+        std::vector<PendingBinding> bindings;
+
+        while (peek().kind != Token::Kind::End) {
+            std::vector<Attribute> attributes;
+            if (!readAttributes(attributes)) {
+                return false;
+            }
+
+            const Token keyword = next();
+            if (keyword.kind != Token::Kind::Identifier) {
+                if (keyword.text == ";") {
+                    continue;
+                }
+                return false;
+            }
+
+            if (keyword.text == "struct") {
+                if (!readStruct()) {
+                    return false;
+                }
+            } else if (keyword.text == "fn") {
+                if (!readFunction(std::move(attributes))) {
+                    return false;
+                }
+            } else if (keyword.text == "var") {
+                PendingBinding binding;
+                bool isResource = false;
+                if (!readVariable(attributes, binding.info, isResource, binding.derivable)) {
+                    return false;
+                }
+                if (isResource) {
+                    bindings.push_back(std::move(binding));
+                } else if (!binding.derivable) {
+                    reflection._layoutDerivable = false;
+                }
+            } else if (keyword.text == "alias") {
+                const Token name = next();
+                TypeNode type;
+                if (name.kind != Token::Kind::Identifier || !expect("=") || !readType(type) || !expect(";")) {
+                    return false;
+                }
+                _aliases[name.text] = std::move(type);
+            } else if (!skipStatement()) {
+                // const, override, enable, requires, diagnostic, const_assert
+                return false;
+            }
+        }
+
+        for (const auto& binding : bindings) {
+            reflection._bindings.push_back(binding.info);
+            reflection._layoutDerivable = reflection._layoutDerivable && binding.derivable;
+        }
+
+        for (const auto& [name, function] : _functions) {
+            ShaderEntryPoint entry;
+            entry.name = std::string(name);
+            if (findAttribute(function.attributes, "vertex")) {
+                entry.stage = ShaderStage::Vertex;
+                entry.vertexInputs = collectVertexInputs(function);
+            } else if (findAttribute(function.attributes, "fragment")) {
+                entry.stage = ShaderStage::Fragment;
+            } else if (findAttribute(function.attributes, "compute")) {
+                entry.stage = ShaderStage::Compute;
+                readWorkgroupSize(function.attributes, entry.workgroupSize);
+            } else {
+                continue;
+            }
+
+            const auto reachable = collectReachable(name);
+            for (size_t i = 0; i < reflection._bindings.size(); ++i) {
+                if (reachable.count(reflection._bindings[i].name)) {
+                    entry.bindings.push_back(static_cast<uint32_t>(i));
+                }
+            }
+            reflection._entryPoints.push_back(std::move(entry));
+        }
+
+        // Declaration order, not hash order, so results are stable
+        std::sort(reflection._entryPoints.begin(), reflection._entryPoints.end(),
+            [this](const ShaderEntryPoint& a, const ShaderEntryPoint& b) {
+                return _functionOrder.at(a.name) < _functionOrder.at(b.name);
+            });
+        return true;
+    }
+
+private:
+    const Token& peek(size_t offset = 0) const {
+        return _tokens[std::min(_pos + offset, _tokens.size() - 1)];
+    }
+
+    Token next() {
+        const Token token = peek();
+        if (_pos < _tokens.size() - 1) {
+            ++_pos;
+        }
+        return token;
+    }
+
+    bool accept(std::string_view symbol) {
+        if (peek().kind == Token::Kind::Symbol && peek().text == symbol) {
+            ++_pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool expect(std::string_view symbol) { return accept(symbol); }
+
+    bool readAttributes(std::vector<Attribute>& attributes) {
+        while (accept("@")) {
+            Attribute attribute;
+            const Token name = next();
+            if (name.kind != Token::Kind::Identifier) {
+                return false;
+            }
+            attribute.name = name.text;
+            if (accept("(")) {
+                int depth = 0;
+                attribute.arguments.emplace_back();
+                while (true) {
+                    const Token token = next();
+                    if (token.kind == Token::Kind::End) {
+                        return false;
+                    }
+                    if (token.text == "(") {
+                        ++depth;
+                    } else if (token.text == ")") {
+                        if (depth-- == 0) {
+                            break;
+                        }
+                    } else if (token.text == "," && depth == 0) {
+                        attribute.arguments.emplace_back();
+                        continue;
+                    }
+                    attribute.arguments.back().push_back(token);
+                }
+                // Trailing comma
+                if (attribute.arguments.back().empty()) {
+                    attribute.arguments.pop_back();
+                }
+            }
+            attributes.push_back(std::move(attribute));
+        }
+        return true;
+    }
+
+    bool readType(TypeNode& type) {
+        const Token name = next();
+        if (name.kind == Token::Kind::Number) {
+            type.name = name.text;
+            type.isNumber = true;
+            return true;
+        }
+        if (name.kind != Token::Kind::Identifier) {
+            return false;
+        }
+        type.name = name.text;
+        if (accept("<")) {
+            do {
+                if (peek().text == ">") {
+                    break;  // Trailing comma
+                }
+                TypeNode argument;
+                const size_t start = _pos;
+                if (!readType(argument) || (peek().text != "," && peek().text != ">")) {
+                    // Expression argument (array<f32, N * 2>), kept as an unnamed node
+                    _pos = start;
+                    argument = TypeNode();
+                    if (!skipTemplateExpression()) {
+                        return false;
+                    }
+                }
+                type.arguments.push_back(std::move(argument));
+            } while (accept(","));
+            return expect(">");
+        }
+        return true;
+    }
+
+    // Up to the ',' or '>' closing a template argument
+    bool skipTemplateExpression() {
+        int depth = 0;
+        while (true) {
+            const Token& token = peek();
+            if (token.kind == Token::Kind::End) {
+                return false;
+            }
+            if (depth == 0 && (token.text == "," || token.text == ">")) {
+                return true;
+            }
+            if (token.text == "(") {
+                ++depth;
+            } else if (token.text == ")") {
+                --depth;
+            }
+            next();
+        }
+    }
+
+    bool readMember(StructMember& member) {
+        if (!readAttributes(member.attributes)) {
+            return false;
+        }
+        const Token name = next();
+        if (name.kind != Token::Kind::Identifier || !expect(":")) {
+            return false;
+        }
+        member.name = name.text;
+        return readType(member.type);
+    }
+
+    bool readStruct() {
+        const Token name = next();
+        if (name.kind != Token::Kind::Identifier || !expect("{")) {
+            return false;
+        }
+        std::vector<StructMember> members;
+        while (!accept("}")) {
+            StructMember member;
+            if (!readMember(member)) {
+                return false;
+            }
+            members.push_back(std::move(member));
+            if (!accept(",") && peek().text != "}") {
+                return false;
+            }
+        }
+        accept(";");
+        _structs[name.text] = std::move(members);
+        return true;
+    }
+
+    bool readFunction(std::vector<Attribute> attributes) {
+        const Token name = next();
+        if (name.kind != Token::Kind::Identifier || !expect("(")) {
+            return false;
+        }
+        FunctionInfo function;
+        function.attributes = std::move(attributes);
+        while (!accept(")")) {
+            StructMember parameter;
+            if (!readMember(parameter)) {
+                return false;
+            }
+            function.parameters.push_back(std::move(parameter));
+            if (!accept(",") && peek().text != ")") {
+                return false;
+            }
+        }
+        if (accept("->")) {
+            std::vector<Attribute> returnAttributes;
+            TypeNode returnType;
+            if (!readAttributes(returnAttributes) || !readType(returnType)) {
+                return false;
+            }
+        }
+        if (!expect("{")) {
+            return false;
+        }
+        int depth = 1;
+        while (depth > 0) {
+            const Token token = next();
+            if (token.kind == Token::Kind::End) {
+                return false;
+            }
+            if (token.text == "{") {
+                ++depth;
+            } else if (token.text == "}") {
+                --depth;
+            } else if (token.kind == Token::Kind::Identifier) {
+                function.identifiers.insert(token.text);
+            }
+        }
+        _functionOrder.emplace(std::string(name.text), _functionOrder.size());
+        _functions[name.text] = std::move(function);
+        return true;
+    }
+
+    bool readVariable(const std::vector<Attribute>& attributes, ShaderBindingInfo& info,
+                      bool& isResource, bool& derivable) {
+        std::string_view addressSpace;
+        std::string_view access;
+        if (accept("<")) {
+            addressSpace = next().text;
+            if (accept(",")) {
+                access = next().text;
+            }
+            if (!expect(">")) {
+                return false;
+            }
+        }
+        const Token name = next();
+        if (name.kind != Token::Kind::Identifier) {
+            return false;
+        }
+        TypeNode type;
+        if (accept(":") && !readType(type)) {
+            return false;
+        }
+        if (!skipStatement()) {
+            return false;
+        }
+
+        isResource = readAttributeInteger(attributes, "group", info.group) &&
+                     readAttributeInteger(attributes, "binding", info.binding);
+        if (!isResource) {
+            // Derived layouts carry no push constant ranges, the pipeline needs an explicit layout
+            derivable = addressSpace != "push_constant";
+            return true;
+        }
+        info.name = std::string(name.text);
+
+        if (addressSpace == "uniform") {
+            info.type = BindingType::UniformBuffer;
+        } else if (addressSpace == "storage") {
+            info.type = access == "read_write" ? BindingType::StorageBuffer : BindingType::ReadOnlyStorageBuffer;
+        } else {
+            derivable = readHandleType(resolveAlias(type), info);
+        }
+        return true;
+    }
+
+    // Textures, samplers and binding arrays of them
+    bool readHandleType(const TypeNode& type, ShaderBindingInfo& info) {
+        if (type.name == "binding_array") {
+            uint32_t count = 0;
+            if (type.arguments.size() != 2 || !type.arguments[1].isNumber ||
+                !parseInteger(type.arguments[1].name, count)) {
+                return false;  // Runtime-sized or override-sized
+            }
+            info.count = count;
+            return readHandleType(resolveAlias(type.arguments[0]), info);
+        }
+        if (type.name == "sampler") {
+            info.type = BindingType::Sampler;
+            return true;
+        }
+        if (type.name == "sampler_comparison") {
+            info.type = BindingType::ComparisonSampler;
+            return true;
+        }
+
+        struct TextureKind {
+            std::string_view name;
+            TextureViewDimension dimension;
+            bool depth;
+            bool multisampled;
+        };
+        static constexpr TextureKind TEXTURE_KINDS[] = {
+            {"texture_1d", TextureViewDimension::D1, false, false},
+            {"texture_2d", TextureViewDimension::D2, false, false},
+            {"texture_2d_array", TextureViewDimension::D2Array, false, false},
+            {"texture_3d", TextureViewDimension::D3, false, false},
+            {"texture_cube", TextureViewDimension::Cube, false, false},
+            {"texture_cube_array", TextureViewDimension::CubeArray, false, false},
+            {"texture_multisampled_2d", TextureViewDimension::D2, false, true},
+            {"texture_depth_2d", TextureViewDimension::D2, true, false},
+            {"texture_depth_2d_array", TextureViewDimension::D2Array, true, false},
+            {"texture_depth_cube", TextureViewDimension::Cube, true, false},
+            {"texture_depth_cube_array", TextureViewDimension::CubeArray, true, false},
+            {"texture_depth_multisampled_2d", TextureViewDimension::D2, true, true},
+        };
+        for (const auto& kind : TEXTURE_KINDS) {
+            if (type.name != kind.name) {
+                continue;
+            }
+            info.type = BindingType::SampledTexture;
+            info.viewDimension = kind.dimension;
+            info.multisampled = kind.multisampled;
+            if (kind.depth) {
+                info.sampleType = TextureSampleType::Depth;
+                return true;
+            }
+            if (type.arguments.size() != 1) {
+                return false;
+            }
+            const std::string_view scalar = type.arguments[0].name;
+            info.sampleType = scalar == "i32" ? TextureSampleType::Sint
+                            : scalar == "u32" ? TextureSampleType::Uint
+                            : TextureSampleType::Float;
+            return true;
+        }
+
+        // texture_storage_* needs its texel format mapped, texture_external has no
+        // BindGroupLayoutEntry equivalent yet; both leave the layout to the caller
+        return false;
+    }
+
+    const TypeNode& resolveAlias(const TypeNode& type) const {
+        const TypeNode* current = &type;
+        for (int depth = 0; depth < 8; ++depth) {
+            auto it = _aliases.find(current->name);
+            if (it == _aliases.end()) {
+                break;
+            }
+            current = &it->second;
+        }
+        return *current;
+    }
+
+    // Skip to the end of a top-level statement, past any nested brackets
+    bool skipStatement() {
+        int depth = 0;
+        while (true) {
+            const Token token = next();
+            if (token.kind == Token::Kind::End) {
+                return false;
+            }
+            if (token.text == "(" || token.text == "{" || token.text == "[") {
+                ++depth;
+            } else if (token.text == ")" || token.text == "}" || token.text == "]") {
+                --depth;
+            } else if (token.text == ";" && depth <= 0) {
+                return true;
+            }
+        }
+    }
+
+    static bool readVertexFormat(const TypeNode& type, VertexFormat& format) {
+        struct FormatName {
+            std::string_view name;
+            std::string_view scalar;  // Template argument for vecN<T>, empty for the shorthand
+            VertexFormat format;
+        };
+        static constexpr FormatName FORMATS[] = {
+            {"f32", "", VertexFormat::Float32},
+            {"i32", "", VertexFormat::Sint32},
+            {"u32", "", VertexFormat::Uint32},
+            {"vec2f", "", VertexFormat::Float32x2}, {"vec2", "f32", VertexFormat::Float32x2},
+            {"vec3f", "", VertexFormat::Float32x3}, {"vec3", "f32", VertexFormat::Float32x3},
+            {"vec4f", "", VertexFormat::Float32x4}, {"vec4", "f32", VertexFormat::Float32x4},
+            {"vec2i", "", VertexFormat::Sint32x2}, {"vec2", "i32", VertexFormat::Sint32x2},
+            {"vec3i", "", VertexFormat::Sint32x3}, {"vec3", "i32", VertexFormat::Sint32x3},
+            {"vec4i", "", VertexFormat::Sint32x4}, {"vec4", "i32", VertexFormat::Sint32x4},
+            {"vec2u", "", VertexFormat::Uint32x2}, {"vec2", "u32", VertexFormat::Uint32x2},
+            {"vec3u", "", VertexFormat::Uint32x3}, {"vec3", "u32", VertexFormat::Uint32x3},
+            {"vec4u", "", VertexFormat::Uint32x4}, {"vec4", "u32", VertexFormat::Uint32x4},
+            {"vec2h", "", VertexFormat::Float16x2}, {"vec2", "f16", VertexFormat::Float16x2},
+            {"vec4h", "", VertexFormat::Float16x4}, {"vec4", "f16", VertexFormat::Float16x4},
+        };
+        const std::string_view scalar = type.arguments.size() == 1 ? type.arguments[0].name : std::string_view();
+        for (const auto& entry : FORMATS) {
+            if (entry.name == type.name && entry.scalar == scalar) {
+                format = entry.format;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void addVertexInput(const StructMember& member, std::vector<ShaderVertexInput>& inputs) const {
+        ShaderVertexInput input;
+        if (!readAttributeInteger(member.attributes, "location", input.location)) {
+            return;
+        }
+        input.name = std::string(member.name);
+        if (!readVertexFormat(resolveAlias(member.type), input.format)) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "ShaderReflection", PERS_SOURCE_LOC,
+                "Vertex input '%s' has no matching vertex format", input.name.c_str());
+            return;
+        }
+        inputs.push_back(std::move(input));
+    }
+
+    std::vector<ShaderVertexInput> collectVertexInputs(const FunctionInfo& function) const {
+        std::vector<ShaderVertexInput> inputs;
+        for (const auto& parameter : function.parameters) {
+            auto it = _structs.find(resolveAlias(parameter.type).name);
+            if (it != _structs.end()) {
+                for (const auto& member : it->second) {
+                    addVertexInput(member, inputs);
+                }
+            } else {
+                addVertexInput(parameter, inputs);
+            }
+        }
+        std::sort(inputs.begin(), inputs.end(),
+            [](const ShaderVertexInput& a, const ShaderVertexInput& b) { return a.location < b.location; });
+        return inputs;
+    }
+
+    static void readWorkgroupSize(const std::vector<Attribute>& attributes, std::array<uint32_t, 3>& size) {
+        const Attribute* attribute = findAttribute(attributes, "workgroup_size");
+        if (!attribute) {
+            return;
+        }
+        for (size_t i = 0; i < attribute->arguments.size() && i < size.size(); ++i) {
+            const auto& argument = attribute->arguments[i];
+            if (argument.size() != 1 || !parseInteger(argument[0].text, size[i])) {
+                size[i] = 0;
+            }
+        }
+    }
+
+    // Identifiers named by a function and everything it calls
+    std::unordered_set<std::string_view> collectReachable(std::string_view entry) const {
+        std::unordered_set<std::string_view> reachable;
+        std::unordered_set<std::string_view> visited{entry};
+        std::vector<std::string_view> pending{entry};
+        while (!pending.empty()) {
+            const auto it = _functions.find(pending.back());
+            pending.pop_back();
+            if (it == _functions.end()) {
+                continue;
+            }
+            for (std::string_view identifier : it->second.identifiers) {
+                reachable.insert(identifier);
+                if (_functions.count(identifier) && visited.insert(identifier).second) {
+                    pending.push_back(identifier);
+                }
+            }
+        }
+        return reachable;
+    }
+
+    std::vector<Token> _tokens;
+    size_t _pos = 0;
+    std::unordered_map<std::string_view, std::vector<StructMember>> _structs;
+    std::unordered_map<std::string_view, TypeNode> _aliases;
+    std::unordered_map<std::string_view, FunctionInfo> _functions;
+    std::unordered_map<std::string, size_t> _functionOrder;
+};
+
+ShaderReflection ShaderReflection::reflect(std::string_view source) {
+    ShaderReflection reflection;
+    WgslReflector reflector(source);
+    if (!reflector.run(reflection)) {
+        return ShaderReflection();
+    }
+    reflection._valid = true;
+    return reflection;
+}
+
+namespace {
+
+// Bumped whenever a reflected field is added, stale blobs then read as invalid
+constexpr uint32_t SERIALIZED_VERSION = 1;
+
+class BlobWriter {
+public:
+    explicit BlobWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    void u32(uint32_t value) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+        _out.insert(_out.end(), bytes, bytes + sizeof(value));
+    }
+    void str(std::string_view value) {
+        u32(static_cast<uint32_t>(value.size()));
+        _out.insert(_out.end(), value.begin(), value.end());
+    }
+
+private:
+    std::vector<uint8_t>& _out;
+};
+
+class BlobReader {
+public:
+    BlobReader(const uint8_t* data, size_t size) : _data(data), _size(size) {}
+
+    uint32_t u32() {
+        uint32_t value = 0;
+        if (take(sizeof(value))) {
+            std::memcpy(&value, _data + _offset - sizeof(value), sizeof(value));
+        }
+        return value;
+    }
+    std::string str() {
+        const uint32_t size = u32();
+        if (!take(size)) {
+            return {};
+        }
+        return std::string(reinterpret_cast<const char*>(_data + _offset - size), size);
+    }
+    // Counts come from the blob, reject ones the remaining bytes cannot hold
+    uint32_t count() {
+        const uint32_t value = u32();
+        if (value > _size - _offset) {
+            _ok = false;
+            return 0;
+        }
+        return value;
+    }
+
+    bool ok() const { return _ok; }
+
+private:
+    bool take(size_t size) {
+        if (!_ok || size > _size - _offset) {
+            _ok = false;
+            return false;
+        }
+        _offset += size;
+        return true;
+    }
+
+    const uint8_t* _data;
+    size_t _size;
+    size_t _offset = 0;
+    bool _ok = true;
+};
+
+} // anonymous namespace
+
+void ShaderReflection::serialize(std::vector<uint8_t>& out) const {
+    if (!_valid) {
+        return;
+    }
+
+    BlobWriter writer(out);
+    writer.u32(SERIALIZED_VERSION);
+    writer.u32(_layoutDerivable ? 1 : 0);
+
+    writer.u32(static_cast<uint32_t>(_bindings.size()));
+    for (const auto& binding : _bindings) {
+        writer.u32(binding.group);
+        writer.u32(binding.binding);
+        writer.str(binding.name);
+        writer.u32(static_cast<uint32_t>(binding.type));
+        writer.u32(static_cast<uint32_t>(binding.sampleType));
+        writer.u32(static_cast<uint32_t>(binding.viewDimension));
+        writer.u32(binding.multisampled ? 1 : 0);
+        writer.u32(binding.count);
+    }
+
+    writer.u32(static_cast<uint32_t>(_entryPoints.size()));
+    for (const auto& entry : _entryPoints) {
+        writer.str(entry.name);
+        writer.u32(static_cast<uint32_t>(entry.stage));
+        for (uint32_t size : entry.workgroupSize) {
+            writer.u32(size);
+        }
+        writer.u32(static_cast<uint32_t>(entry.vertexInputs.size()));
+        for (const auto& input : entry.vertexInputs) {
+            writer.u32(input.location);
+            writer.str(input.name);
+            writer.u32(static_cast<uint32_t>(input.format));
+        }
+        writer.u32(static_cast<uint32_t>(entry.bindings.size()));
+        for (uint32_t index : entry.bindings) {
+            writer.u32(index);
+        }
+    }
+}
+
+ShaderReflection ShaderReflection::deserialize(const uint8_t* data, size_t size) {
+    if (!data || size == 0) {
+        return ShaderReflection();
+    }
+
+    BlobReader reader(data, size);
+    if (reader.u32() != SERIALIZED_VERSION) {
+        return ShaderReflection();
+    }
+
+    ShaderReflection reflection;
+    reflection._layoutDerivable = reader.u32() != 0;
+
+    reflection._bindings.resize(reader.count());
+    for (auto& binding : reflection._bindings) {
+        binding.group = reader.u32();
+        binding.binding = reader.u32();
+        binding.name = reader.str();
+        binding.type = static_cast<BindingType>(reader.u32());
+        binding.sampleType = static_cast<TextureSampleType>(reader.u32());
+        binding.viewDimension = static_cast<TextureViewDimension>(reader.u32());
+        binding.multisampled = reader.u32() != 0;
+        binding.count = reader.u32();
+    }
+
+    reflection._entryPoints.resize(reader.count());
+    for (auto& entry : reflection._entryPoints) {
+        entry.name = reader.str();
+        entry.stage = static_cast<ShaderStage>(reader.u32());
+        for (uint32_t& workgroupSize : entry.workgroupSize) {
+            workgroupSize = reader.u32();
+        }
+        entry.vertexInputs.resize(reader.count());
+        for (auto& input : entry.vertexInputs) {
+            input.location = reader.u32();
+            input.name = reader.str();
+            input.format = static_cast<VertexFormat>(reader.u32());
+        }
+        entry.bindings.resize(reader.count());
+        for (uint32_t& index : entry.bindings) {
+            index = reader.u32();
+            if (index >= reflection._bindings.size()) {
+                return ShaderReflection();
+            }
+        }
+    }
+
+    if (!reader.ok()) {
+        return ShaderReflection();
+    }
+    reflection._valid = true;
+    return reflection;
+}
+
+const ShaderEntryPoint* ShaderReflection::findEntryPoint(std::string_view name) const {
+    for (const auto& entry : _entryPoints) {
+        if (entry.name == name) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+ShaderStage ShaderReflection::detectStage(std::string_view entryPoint) const {
+    if (const ShaderEntryPoint* entry = findEntryPoint(entryPoint)) {
+        return entry->stage;
+    }
+    for (ShaderStage stage : {ShaderStage::Vertex, ShaderStage::Fragment, ShaderStage::Compute}) {
+        for (const auto& entry : _entryPoints) {
+            if (entry.stage == stage) {
+                return stage;
+            }
+        }
+    }
+    return ShaderStage::None;
+}
+
+bool ShaderReflection::deriveBindGroupLayouts(const std::vector<std::shared_ptr<IShaderModule>>& modules,
+                                              std::vector<BindGroupLayoutDesc>& layouts) {
+    layouts.clear();
+    for (const auto& module : modules) {
+        if (!module) {
+            continue;
+        }
+        const ShaderReflection& reflection = module->getReflection();
+        const ShaderEntryPoint* entry = reflection.findEntryPoint(module->getEntryPoint());
+        if (!reflection.isLayoutDerivable() || !entry) {
+            return false;
+        }
+
+        for (uint32_t index : entry->bindings) {
+            const ShaderBindingInfo& binding = reflection._bindings[index];
+            if (binding.group >= layouts.size()) {
+                layouts.resize(binding.group + 1);
+            }
+            auto& entries = layouts[binding.group].entries;
+            auto existing = std::find_if(entries.begin(), entries.end(),
+                [&](const BindGroupLayoutEntry& e) { return e.binding == binding.binding; });
+            if (existing != entries.end()) {
+                if (existing->type != binding.type || existing->sampleType != binding.sampleType ||
+                    existing->viewDimension != binding.viewDimension ||
+                    existing->multisampled != binding.multisampled || existing->count != binding.count) {
+                    Logger::Instance().LogFormat(LogLevel::Error, "ShaderReflection", PERS_SOURCE_LOC,
+                        "Stages disagree on @group(%u) @binding(%u)", binding.group, binding.binding);
+                    return false;
+                }
+                existing->visibility = existing->visibility | entry->stage;
+                continue;
+            }
+
+            BindGroupLayoutEntry layoutEntry;
+            layoutEntry.binding = binding.binding;
+            layoutEntry.visibility = entry->stage;
+            layoutEntry.type = binding.type;
+            layoutEntry.sampleType = binding.sampleType;
+            layoutEntry.viewDimension = binding.viewDimension;
+            layoutEntry.multisampled = binding.multisampled;
+            layoutEntry.count = binding.count;
+            entries.push_back(layoutEntry);
+        }
+    }
+
+    // Binding order does not matter to the backend, but it does to the layout cache
+    for (auto& layout : layouts) {
+        std::sort(layout.entries.begin(), layout.entries.end(),
+            [](const BindGroupLayoutEntry& a, const BindGroupLayoutEntry& b) { return a.binding < b.binding; });
+    }
+    return true;
+}
+
+std::shared_ptr<IPipelineLayout> ShaderReflection::derivePipelineLayout(
+    const IResourceFactory& factory,
+    const std::vector<std::shared_ptr<IShaderModule>>& modules,
+    const std::string& debugName) {
+    std::vector<BindGroupLayoutDesc> groups;
+    if (!deriveBindGroupLayouts(modules, groups)) {
+        return nullptr;
+    }
+
+    PipelineLayoutDesc layoutDesc;
+    layoutDesc.debugName = debugName;
+    for (auto& group : groups) {
+        group.debugName = debugName;
+        auto layout = factory.createBindGroupLayout(group);
+        if (!layout) {
+            LOG_ERROR("ShaderReflection", "Failed to create derived bind group layout");
+            return nullptr;
+        }
+        layoutDesc.bindGroupLayouts.push_back(std::move(layout));
+    }
+    return factory.createPipelineLayout(layoutDesc);
+}
+
+bool ShaderReflection::deriveVertexLayout(const IShaderModule& vertex, VertexBufferLayout& layout) {
+    const ShaderEntryPoint* entry = vertex.getReflection().findEntryPoint(vertex.getEntryPoint());
+    if (!entry || entry->stage != ShaderStage::Vertex || entry->vertexInputs.empty()) {
+        return false;
+    }
+
+    layout = VertexBufferLayout();
+    for (const auto& input : entry->vertexInputs) {
+        VertexAttribute attribute;
+        attribute.format = input.format;
+        attribute.offset = layout.arrayStride;
+        attribute.shaderLocation = input.location;
+        layout.attributes.push_back(attribute);
+        layout.arrayStride += getVertexFormatSize(input.format);
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,327 @@
+#include "pers/graphics/StaticBatcher.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+namespace pers {
+
+namespace {
+
+using Vec3 = std::array<float, 3>;
+
+Vec3 readVec3(const uint8_t* data) {
+    Vec3 value;
+    std::memcpy(value.data(), data, sizeof(value));
+    return value;
+}
+
+void writeVec3(uint8_t* data, const Vec3& value) {
+    std::memcpy(data, value.data(), sizeof(value));
+}
+
+Vec3 transformPoint(const std::array<float, 16>& m, const Vec3& p) {
+    return {m[0] * p[0] + m[4] * p[1] + m[8] * p[2] + m[12],
+            m[1] * p[0] + m[5] * p[1] + m[9] * p[2] + m[13],
+            m[2] * p[0] + m[6] * p[1] + m[10] * p[2] + m[14]};
+}
+
+// Cofactor matrix of the upper 3x3, det * inverse transpose; scaled out by normalizing
+std::array<float, 9> normalMatrix(const std::array<float, 16>& m) {
+    const float a = m[0], b = m[4], c = m[8];
+    const float d = m[1], e = m[5], f = m[9];
+    const float g = m[2], h = m[6], i = m[10];
+    std::array<float, 9> n = {e * i - f * h, c * h - b * i, b * f - c * e,
+                              f * g - d * i, a * i - c * g, c * d - a * f,
+                              d * h - e * g, b * g - a * h, a * e - b * d};
+    // The rows above form the adjugate, transpose it into the cofactor matrix
+    std::swap(n[1], n[3]);
+    std::swap(n[2], n[6]);
+    std::swap(n[5], n[7]);
+    const float det = a * n[0] + b * n[1] + c * n[2];
+    if (det < 0.0f) {
+        for (float& value : n) {
+            value = -value;
+        }
+    }
+    return n;
+}
+
+Vec3 transformNormal(const std::array<float, 9>& n, const Vec3& v) {
+    Vec3 result = {n[0] * v[0] + n[1] * v[1] + n[2] * v[2],
+                   n[3] * v[0] + n[4] * v[1] + n[5] * v[2],
+                   n[6] * v[0] + n[7] * v[1] + n[8] * v[2]};
+    const float length = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]);
+    if (length > 0.0f) {
+        for (float& value : result) {
+            value /= length;
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+bool StaticBatcher::GroupKey::operator==(const GroupKey& other) const {
+    return pipeline == other.pipeline && material == other.material && vertexStride == other.vertexStride;
+}
+
+size_t StaticBatcher::GroupKeyHash::operator()(const GroupKey& key) const {
+    Fnv1aHasher hasher;
+    hasher.add(key.pipeline);
+    hasher.add(key.material);
+    hasher.add(key.vertexStride);
+    return static_cast<size_t>(hasher.get());
+}
+
+StaticBatcher::StaticBatcher(const std::shared_ptr<DeviceBufferHeap>& heap,
+                             const std::shared_ptr<IQueue>& queue,
+                             uint32_t maxBatchVertices,
+                             uint32_t vertexSlot,
+                             uint32_t materialGroupIndex)
+    : _heap(heap)
+    , _queue(queue)
+    , _maxBatchVertices(maxBatchVertices)
+    , _vertexSlot(vertexSlot)
+    , _materialGroupIndex(materialGroupIndex) {
+    if (!heap || !queue) {
+        LOG_ERROR("StaticBatcher", "Heap or queue is null");
+        return;
+    }
+
+    const BufferUsage required = BufferUsage::Vertex | BufferUsage::Index;
+    if ((heap->getUsage() & required) != required) {
+        LOG_ERROR("StaticBatcher", "Heap needs Vertex and Index usage");
+    }
+}
+
+StaticBatcher::Group& StaticBatcher::groupFor(const StaticMesh& mesh) {
+    GroupKey key;
+    key.pipeline = mesh.pipeline.get();
+    key.material = mesh.material.get();
+    key.vertexStride = mesh.vertexStride;
+
+    auto it = _openGroups.find(key);
+    if (it != _openGroups.end() &&
+        _groups[it->second].vertexCount + mesh.vertexCount <= _maxBatchVertices) {
+        return _groups[it->second];
+    }
+
+    Group& group = _groups.emplace_back();
+    group.pipeline = mesh.pipeline;
+    group.material = mesh.material;
+    _openGroups[key] = _groups.size() - 1;
+    return group;
+}
+
+bool StaticBatcher::add(const StaticMesh& mesh) {
+    if (!mesh.vertices || mesh.vertexCount == 0 || !mesh.indices || mesh.indexCount == 0) {
+        LOG_ERROR("StaticBatcher", "Mesh needs vertices and indices");
+        return false;
+    }
+
+    const uint32_t stride = mesh.vertexStride;
+    const bool hasNormal = mesh.normalOffset != StaticMesh::NO_ATTRIBUTE;
+    if (stride == 0 || stride % 4 != 0 || mesh.positionOffset + sizeof(Vec3) > stride ||
+        (hasNormal && mesh.normalOffset + sizeof(Vec3) > stride)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "StaticBatcher", PERS_SOURCE_LOC,
+            "Vertex stride %u does not hold the position and normal attributes", stride);
+        return false;
+    }
+
+    if (mesh.vertexCount > _maxBatchVertices) {
+        Logger::Instance().LogFormat(LogLevel::Error, "StaticBatcher", PERS_SOURCE_LOC,
+            "Mesh of %u vertices exceeds the batch limit of %u", mesh.vertexCount, _maxBatchVertices);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < mesh.indexCount; ++i) {
+        if (mesh.indices[i] >= mesh.vertexCount) {
+            LOG_ERROR("StaticBatcher", "Mesh index out of range");
+            return false;
+        }
+    }
+
+    Group& group = groupFor(mesh);
+    const uint32_t baseVertex = group.vertexCount;
+    const size_t byteOffset = group.vertices.size();
+    group.vertices.resize(byteOffset + static_cast<size_t>(mesh.vertexCount) * stride);
+    uint8_t* vertices = group.vertices.data() + byteOffset;
+    std::memcpy(vertices, mesh.vertices, static_cast<size_t>(mesh.vertexCount) * stride);
+
+    StaticSubmesh submesh;
+    submesh.firstIndex = static_cast<uint32_t>(group.indices.size());
+    submesh.indexCount = mesh.indexCount;
+    submesh.sourceIndex = _meshCount;
+    submesh.boundsMin.fill(std::numeric_limits<float>::max());
+    submesh.boundsMax.fill(std::numeric_limits<float>::lowest());
+
+    const std::array<float, 9> normals = normalMatrix(mesh.transform);
+    for (uint32_t v = 0; v < mesh.vertexCount; ++v) {
+        uint8_t* vertex = vertices + static_cast<size_t>(v) * stride;
+        const Vec3 position = transformPoint(mesh.transform, readVec3(vertex + mesh.positionOffset));
+        writeVec3(vertex + mesh.positionOffset, position);
+        if (hasNormal) {
+            writeVec3(vertex + mesh.normalOffset, transformNormal(normals, readVec3(vertex + mesh.normalOffset)));
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            submesh.boundsMin[axis] = std::min(submesh.boundsMin[axis], position[axis]);
+            submesh.boundsMax[axis] = std::max(submesh.boundsMax[axis], position[axis]);
+        }
+    }
+
+    // Sphere around the box center, radius from the vertices rather than the corners
+    float radiusSquared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        submesh.sphere[axis] = 0.5f * (submesh.boundsMin[axis] + submesh.boundsMax[axis]);
+    }
+    for (uint32_t v = 0; v < mesh.vertexCount; ++v) {
+        const Vec3 position = readVec3(vertices + static_cast<size_t>(v) * stride + mesh.positionOffset);
+        float distanceSquared = 0.0f;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float delta = position[axis] - submesh.sphere[axis];
+            distanceSquared += delta * delta;
+        }
+        radiusSquared = std::max(radiusSquared, distanceSquared);
+    }
+    submesh.sphere[3] = std::sqrt(radiusSquared);
+
+    group.indices.reserve(group.indices.size() + mesh.indexCount);
+    for (uint32_t i = 0; i < mesh.indexCount; ++i) {
+        group.indices.push_back(mesh.indices[i] + baseVertex);
+    }
+    group.submeshes.push_back(submesh);
+    group.vertexCount += mesh.vertexCount;
+    ++_meshCount;
+    return true;
+}
+
+bool StaticBatcher::upload(const Group& group, StaticBatch& batch) const {
+    batch.vertexBuffer = _heap->allocate(group.vertices.size());
+    if (!batch.vertexBuffer ||
+        !_queue->writeBuffer(batch.vertexBuffer, 0, std::as_bytes(std::span(group.vertices)))) {
+        LOG_ERROR("StaticBatcher", "Failed to upload batch vertices");
+        return false;
+    }
+
+    // Queue writes need a size multiple of 4, odd Uint16 counts get a padding index
+    if (group.vertexCount <= std::numeric_limits<uint16_t>::max()) {
+        std::vector<uint16_t> indices(group.indices.begin(), group.indices.end());
+        if (indices.size() % 2 != 0) {
+            indices.push_back(0);
+        }
+        batch.indexFormat = IndexFormat::Uint16;
+        batch.indexBuffer = _heap->allocate(indices.size() * sizeof(uint16_t));
+        if (!batch.indexBuffer ||
+            !_queue->writeBuffer(batch.indexBuffer, 0, std::as_bytes(std::span(indices)))) {
+            LOG_ERROR("StaticBatcher", "Failed to upload batch indices");
+            return false;
+        }
+    } else {
+        batch.indexFormat = IndexFormat::Uint32;
+        batch.indexBuffer = _heap->allocate(group.indices.size() * sizeof(uint32_t));
+        if (!batch.indexBuffer ||
+            !_queue->writeBuffer(batch.indexBuffer, 0, std::as_bytes(std::span(group.indices)))) {
+            LOG_ERROR("StaticBatcher", "Failed to upload batch indices");
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<StaticBatch> StaticBatcher::build() {
+    std::vector<StaticBatch> batches;
+    _stats = Stats();
+    if (!_heap || !_queue) {
+        LOG_ERROR("StaticBatcher", "Heap or queue is null");
+        return batches;
+    }
+
+    batches.reserve(_groups.size());
+    for (Group& group : _groups) {
+        StaticBatch batch;
+        batch.pipeline = group.pipeline;
+        batch.material = group.material;
+        batch.vertexCount = group.vertexCount;
+        batch.indexCount = static_cast<uint32_t>(group.indices.size());
+        if (!upload(group, batch)) {
+            continue;
+        }
+
+        batch.submeshes = std::move(group.submeshes);
+        _stats.meshes += static_cast<uint32_t>(batch.submeshes.size());
+        _stats.vertexBytes += batch.vertexBuffer->getSize();
+        _stats.indexBytes += batch.indexBuffer->getSize();
+        batches.push_back(std::move(batch));
+    }
+    _stats.batches = static_cast<uint32_t>(batches.size());
+
+    Logger::Instance().LogFormat(LogLevel::Debug, "StaticBatcher", PERS_SOURCE_LOC,
+        "Merged %u meshes into %u batches (%llu vertex bytes, %llu index bytes)",
+        _stats.meshes, _stats.batches, static_cast<unsigned long long>(_stats.vertexBytes),
+        static_cast<unsigned long long>(_stats.indexBytes));
+
+    _groups.clear();
+    _openGroups.clear();
+    _meshCount = 0;
+    return batches;
+}
+
+void StaticBatcher::bind(IRenderPassEncoder& pass, const StaticBatch& batch) const {
+    pass.setPipeline(batch.pipeline);
+    if (batch.material) {
+        pass.setBindGroup(_materialGroupIndex, batch.material);
+    }
+    pass.setVertexBuffer(_vertexSlot, batch.vertexBuffer);
+    pass.setIndexBuffer(batch.indexBuffer, batch.indexFormat);
+}
+
+void StaticBatcher::record(IRenderPassEncoder& pass, const StaticBatch& batch) const {
+    bind(pass, batch);
+    pass.drawIndexed(batch.indexCount, 1, 0, 0, 0);
+}
+
+uint32_t StaticBatcher::recordVisible(IRenderPassEncoder& pass,
+                                      const StaticBatch& batch,
+                                      std::span<const uint8_t> visible) const {
+    if (visible.size() != batch.submeshes.size()) {
+        LOG_ERROR("StaticBatcher", "Visibility must have one entry per submesh");
+        return 0;
+    }
+
+    uint32_t draws = 0;
+    bool bound = false;
+    size_t i = 0;
+    while (i < visible.size()) {
+        if (!visible[i]) {
+            ++i;
+            continue;
+        }
+
+        // Submeshes are laid out back to back, a visible run is one index range
+        const uint32_t firstIndex = batch.submeshes[i].firstIndex;
+        uint32_t indexCount = 0;
+        while (i < visible.size() && visible[i]) {
+            indexCount += batch.submeshes[i].indexCount;
+            ++i;
+        }
+
+        if (!bound) {
+            bind(pass, batch);
+            bound = true;
+        }
+        pass.drawIndexed(indexCount, 1, firstIndex, 0, 0);
+        ++draws;
+    }
+    return draws;
+}
+
+} // namespace pers
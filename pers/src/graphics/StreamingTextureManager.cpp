@@ -0,0 +1,354 @@
+#include "pers/graphics/StreamingTextureManager.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+
+namespace pers {
+
+StreamingTextureManager::StreamingTextureManager(const std::shared_ptr<ILogicalDevice>& device)
+    : StreamingTextureManager(device, Config{}) {
+}
+
+StreamingTextureManager::StreamingTextureManager(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    if (!device) {
+        LOG_ERROR("StreamingTextureManager", "Created with null device");
+    }
+}
+
+StreamingTextureManager::~StreamingTextureManager() = default;
+
+StreamingTextureHandle StreamingTextureManager::add(const StreamingTextureDesc& desc) {
+    if (desc.width == 0 || desc.height == 0 || !desc.loader) {
+        LOG_ERROR("StreamingTextureManager", "Texture needs a size and a mip loader");
+        return {};
+    }
+
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(desc.format);
+    if (block.blockBytes == 0) {
+        LOG_ERROR("StreamingTextureManager", "Texture format cannot be uploaded");
+        return {};
+    }
+
+    Entry entry;
+    entry.desc = desc;
+    uint32_t fullChain = static_cast<uint32_t>(std::floor(std::log2(std::max(desc.width, desc.height)))) + 1;
+    entry.desc.mipLevelCount = desc.mipLevelCount ? std::min(desc.mipLevelCount, fullChain) : fullChain;
+
+    // Block-compressed textures must keep block-aligned top dimensions
+    uint32_t lastTop = 0;
+    for (uint32_t mip = 1; mip < entry.desc.mipLevelCount; ++mip) {
+        uint32_t w = desc.width >> mip;
+        uint32_t h = desc.height >> mip;
+        if (w == 0 || h == 0 || w % block.blockWidth != 0 || h % block.blockHeight != 0) {
+            break;
+        }
+        lastTop = mip;
+    }
+
+    // Coarsest level that still reaches initialResidentSize, or the block limit
+    uint32_t initialTop = 0;
+    while (initialTop < lastTop &&
+           std::max(desc.width >> initialTop, desc.height >> initialTop) > _config.initialResidentSize) {
+        ++initialTop;
+    }
+    entry.coarsestTopMip = initialTop;
+
+    if (_freeList.empty() && _slots.size() > StreamingTextureHandle::MAX_INDEX) {
+        LOG_ERROR("StreamingTextureManager", "Slot limit reached, cannot add streaming texture");
+        return {};
+    }
+
+    if (!rebuild(entry, initialTop)) {
+        LOG_ERROR("StreamingTextureManager", "Failed to create streaming texture");
+        return {};
+    }
+    entry.lastReportFrame = _frame;
+
+    uint32_t index;
+    if (!_freeList.empty()) {
+        index = _freeList.back();
+        _freeList.pop_back();
+    } else {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    Slot& slot = _slots[index];
+    slot.generation = StreamingTextureHandle::nextGeneration(slot.generation);
+    slot.entry = std::move(entry);
+    ++_stats.textureCount;
+    return StreamingTextureHandle{index, slot.generation};
+}
+
+bool StreamingTextureManager::remove(StreamingTextureHandle handle) {
+    Entry* entry = find(handle);
+    if (!entry) {
+        return false;
+    }
+
+    _residentBytes -= entry->residentBytes;
+    retire(*entry);
+    Slot& slot = _slots[handle.index];
+    slot.generation = StreamingTextureHandle::nextGeneration(slot.generation);
+    slot.entry = Entry{};
+    _freeList.push_back(handle.index);
+    --_stats.textureCount;
+    return true;
+}
+
+void StreamingTextureManager::reportUsage(StreamingTextureHandle handle, float screenSize) {
+    Entry* entry = find(handle);
+    if (!entry) {
+        return;
+    }
+    entry->demand = std::max(entry->demand, screenSize);
+    entry->lastReportFrame = _frame;
+}
+
+void StreamingTextureManager::update() {
+    ++_frame;
+    _stats.uploadedBytes = 0;
+    _stats.raised = 0;
+    _stats.lowered = 0;
+    _stats.pending = 0;
+
+    // Give memory back when the process-wide GPU budget is exceeded
+    const uint64_t overBudget = GpuMemoryTracker::instance().getOverBudgetBytes();
+    const uint64_t memoryBudget = std::min(_config.memoryBudget,
+                                           _residentBytes > overBudget ? _residentBytes - overBudget : 0);
+
+    // Collect demand; textures not reported for a while fall back to their tail
+    struct Candidate {
+        Entry* entry;
+        uint32_t wanted;
+        float priority;
+    };
+    std::vector<Candidate> raise;
+    std::vector<Candidate> lower;
+
+    for (Slot& slot : _slots) {
+        if (!(slot.generation & 1u)) {
+            continue;
+        }
+        Entry& entry = slot.entry;
+        if (entry.demand > 0.0f) {
+            entry.lastDemand = entry.demand;
+        } else if (_frame - entry.lastReportFrame > _config.demandTimeoutFrames) {
+            entry.lastDemand = 0.0f;
+        }
+        entry.demand = 0.0f;
+
+        uint32_t wanted = wantedMip(entry);
+        if (wanted < entry.residentMip) {
+            // Larger screen size and bigger detail gap first
+            raise.push_back({&entry, wanted, entry.lastDemand * static_cast<float>(entry.residentMip - wanted)});
+        } else if (wanted > entry.residentMip) {
+            // Least needed detail goes first
+            lower.push_back({&entry, wanted, entry.lastDemand});
+        }
+    }
+
+    std::sort(raise.begin(), raise.end(), [](const Candidate& a, const Candidate& b) { return a.priority > b.priority; });
+    std::sort(lower.begin(), lower.end(), [](const Candidate& a, const Candidate& b) { return a.priority < b.priority; });
+
+    size_t nextLower = 0;
+    for (const Candidate& candidate : raise) {
+        Entry& entry = *candidate.entry;
+
+        // Go straight to the wanted level if it fits this update, else one level
+        uint32_t target = candidate.wanted;
+        uint64_t uploadBytes = bytesFrom(entry, target);
+        uint64_t remaining = _config.uploadBudgetPerUpdate > _stats.uploadedBytes
+                           ? _config.uploadBudgetPerUpdate - _stats.uploadedBytes : 0;
+        if (uploadBytes > remaining) {
+            target = entry.residentMip - 1;
+            uploadBytes = bytesFrom(entry, target);
+            // Always let one texture through so large mips are never starved
+            if (uploadBytes > remaining && _stats.uploadedBytes > 0) {
+                ++_stats.pending;
+                continue;
+            }
+        }
+
+        // Make room by lowering textures that have more detail than they need
+        uint64_t growth = uploadBytes - entry.residentBytes;
+        while (_residentBytes + growth > memoryBudget && nextLower < lower.size()) {
+            Candidate& victim = lower[nextLower++];
+            if (rebuild(*victim.entry, victim.wanted)) {
+                _stats.uploadedBytes += victim.entry->residentBytes;
+                ++_stats.lowered;
+            }
+        }
+
+        if (_residentBytes + growth > memoryBudget) {
+            ++_stats.pending;
+            continue;
+        }
+
+        if (rebuild(entry, target)) {
+            _stats.uploadedBytes += entry.residentBytes;
+            ++_stats.raised;
+            if (target != candidate.wanted) {
+                ++_stats.pending;
+            }
+        }
+    }
+
+    // Over budget without upgrades (budget lowered, textures added): evict the rest
+    while (_residentBytes > memoryBudget && nextLower < lower.size()) {
+        Candidate& victim = lower[nextLower++];
+        if (rebuild(*victim.entry, victim.wanted)) {
+            _stats.uploadedBytes += victim.entry->residentBytes;
+            ++_stats.lowered;
+        }
+    }
+
+    _stats.residentBytes = _residentBytes;
+}
+
+std::shared_ptr<ITextureView> StreamingTextureManager::getView(StreamingTextureHandle handle) const {
+    const Entry* entry = find(handle);
+    return entry ? entry->view : nullptr;
+}
+
+std::shared_ptr<ITexture> StreamingTextureManager::getTexture(StreamingTextureHandle handle) const {
+    const Entry* entry = find(handle);
+    return entry ? entry->texture : nullptr;
+}
+
+uint64_t StreamingTextureManager::getVersion(StreamingTextureHandle handle) const {
+    const Entry* entry = find(handle);
+    return entry ? entry->version : 0;
+}
+
+uint32_t StreamingTextureManager::getResidentMip(StreamingTextureHandle handle) const {
+    const Entry* entry = find(handle);
+    return entry ? entry->residentMip : 0;
+}
+
+StreamingTextureManager::Entry* StreamingTextureManager::find(StreamingTextureHandle handle) {
+    return const_cast<Entry*>(static_cast<const StreamingTextureManager*>(this)->find(handle));
+}
+
+const StreamingTextureManager::Entry* StreamingTextureManager::find(StreamingTextureHandle handle) const {
+    if (handle.index >= _slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = _slots[handle.index];
+    return slot.generation == handle.generation && (slot.generation & 1u) ? &slot.entry : nullptr;
+}
+
+uint32_t StreamingTextureManager::wantedMip(const Entry& entry) const {
+    if (entry.lastDemand <= 0.0f) {
+        return entry.coarsestTopMip;
+    }
+
+    // One texel per covered pixel along the longest edge
+    float longestEdge = static_cast<float>(std::max(entry.desc.width, entry.desc.height));
+    float ratio = longestEdge / std::max(entry.lastDemand, 1.0f);
+    uint32_t mip = ratio > 1.0f ? static_cast<uint32_t>(std::floor(std::log2(ratio))) : 0;
+    return std::min(mip, entry.coarsestTopMip);
+}
+
+uint64_t StreamingTextureManager::bytesFrom(const Entry& entry, uint32_t topMip) const {
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(entry.desc.format);
+    uint64_t bytes = 0;
+    for (uint32_t mip = topMip; mip < entry.desc.mipLevelCount; ++mip) {
+        uint32_t w = std::max(1u, entry.desc.width >> mip);
+        uint32_t h = std::max(1u, entry.desc.height >> mip);
+        uint64_t blocksWide = (w + block.blockWidth - 1) / block.blockWidth;
+        uint64_t blocksHigh = (h + block.blockHeight - 1) / block.blockHeight;
+        bytes += blocksWide * blocksHigh * block.blockBytes;
+    }
+    return bytes;
+}
+
+bool StreamingTextureManager::rebuild(Entry& entry, uint32_t topMip) {
+    auto device = _device.lock();
+    if (!device) {
+        LOG_ERROR("StreamingTextureManager", "Device expired");
+        return false;
+    }
+
+    const auto& factory = device->getResourceFactory();
+    auto queue = device->getQueue();
+    if (!factory || !queue) {
+        LOG_ERROR("StreamingTextureManager", "Device has no resource factory or queue");
+        return false;
+    }
+
+    TextureDesc textureDesc;
+    textureDesc.width = std::max(1u, entry.desc.width >> topMip);
+    textureDesc.height = std::max(1u, entry.desc.height >> topMip);
+    textureDesc.mipLevelCount = entry.desc.mipLevelCount - topMip;
+    textureDesc.format = entry.desc.format;
+    textureDesc.usage = entry.desc.usage | TextureUsage::CopyDst;
+    textureDesc.label = entry.desc.label;
+
+    auto texture = factory->createTexture(textureDesc);
+    if (!texture) {
+        LOG_ERROR("StreamingTextureManager", "Failed to create texture");
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    for (uint32_t mip = topMip; mip < entry.desc.mipLevelCount; ++mip) {
+        data.clear();
+        if (!entry.desc.loader(mip, data) || data.empty()) {
+            Logger::Instance().LogFormat(LogLevel::Error, "StreamingTextureManager", PERS_SOURCE_LOC,
+                "Loader failed for '%s' mip %u", entry.desc.label.c_str(), mip);
+            return false;
+        }
+
+        TextureWriteDesc write;
+        write.texture = texture;
+        write.mipLevel = mip - topMip;
+        write.data = data.data();
+        write.dataSize = data.size();
+        if (!queue->writeTexture(write)) {
+            return false;
+        }
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = entry.desc.format;
+    viewDesc.mipLevelCount = textureDesc.mipLevelCount;
+    viewDesc.label = entry.desc.label;
+    auto view = factory->createTextureView(texture, viewDesc);
+    if (!view) {
+        LOG_ERROR("StreamingTextureManager", "Failed to create texture view");
+        return false;
+    }
+
+    uint64_t bytes = bytesFrom(entry, topMip);
+    _residentBytes = _residentBytes - entry.residentBytes + bytes;
+    retire(entry);
+    entry.texture = std::move(texture);
+    entry.view = std::move(view);
+    entry.residentMip = topMip;
+    entry.residentBytes = bytes;
+    ++entry.version;
+    return true;
+}
+
+void StreamingTextureManager::retire(Entry& entry) {
+    // Frames in flight may still sample the old texture
+    auto device = _device.lock();
+    if (device && device->getDeletionQueue()) {
+        device->getDeletionQueue()->retire(std::move(entry.view));
+        device->getDeletionQueue()->retire(std::move(entry.texture));
+    }
+    entry.view.reset();
+    entry.texture.reset();
+}
+
+} // namespace pers
@@ -0,0 +1,157 @@
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+// SubmissionTimeline
+
+SubmissionTimeline::SubmissionTimeline(PollFunction poll)
+    : _poll(std::move(poll)) {
+}
+
+uint64_t SubmissionTimeline::signal() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return ++_submittedValue;
+}
+
+void SubmissionTimeline::complete(uint64_t value, bool success) {
+    std::vector<PendingCallback> ready;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (value <= _completedValue) {
+            return;
+        }
+
+        _completedValue = value;
+        if (success) {
+            _lastSuccessValue = value;
+        }
+
+        auto split = std::stable_partition(_callbacks.begin(), _callbacks.end(),
+            [value](const PendingCallback& pending) { return pending.value > value; });
+        ready.assign(std::make_move_iterator(split), std::make_move_iterator(_callbacks.end()));
+        _callbacks.erase(split, _callbacks.end());
+    }
+    _cv.notify_all();
+
+    // Continuations run outside the lock so they may submit or register more
+    for (auto& pending : ready) {
+        pending.callback(success);
+    }
+}
+
+void SubmissionTimeline::setPollFunction(PollFunction poll) {
+    std::lock_guard<std::mutex> lock(_pollMutex);
+    _poll = std::move(poll);
+}
+
+void SubmissionTimeline::setFlushFunction(FlushFunction flush) {
+    std::lock_guard<std::mutex> lock(_pollMutex);
+    _flush = std::move(flush);
+}
+
+void SubmissionTimeline::poll() {
+    std::lock_guard<std::mutex> lock(_pollMutex);
+    if (_poll) {
+        _poll();
+    }
+}
+
+uint64_t SubmissionTimeline::getCompletedValue() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _completedValue;
+}
+
+uint64_t SubmissionTimeline::getLastSubmittedValue() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _submittedValue;
+}
+
+bool SubmissionTimeline::isComplete(uint64_t value) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return value <= _completedValue;
+}
+
+bool SubmissionTimeline::wait(uint64_t value, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    // A value still held in a submission batch would never complete
+    {
+        std::lock_guard<std::mutex> lock(_pollMutex);
+        if (_flush) {
+            _flush(value);
+        }
+    }
+
+    while (true) {
+        poll();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (value <= _completedValue) {
+            return value <= _lastSuccessValue;
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "SubmissionTimeline", PERS_SOURCE_LOC,
+                "Timed out waiting for submission %llu (completed %llu)",
+                static_cast<unsigned long long>(value), static_cast<unsigned long long>(_completedValue));
+            return false;
+        }
+
+        // Short sleep between polls; completion from another thread wakes us early
+        _cv.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+void SubmissionTimeline::then(uint64_t value, QueueWorkDoneCallback callback) {
+    if (!callback) {
+        return;
+    }
+
+    bool success = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (value > _completedValue) {
+            _callbacks.push_back(PendingCallback{value, std::move(callback)});
+            return;
+        }
+        success = value <= _lastSuccessValue;
+    }
+
+    callback(success);
+}
+
+// SubmissionFence
+
+SubmissionFence::SubmissionFence(std::shared_ptr<SubmissionTimeline> timeline, uint64_t value)
+    : _timeline(std::move(timeline))
+    , _value(value) {
+}
+
+bool SubmissionFence::isComplete() const {
+    return _timeline && _timeline->isComplete(_value);
+}
+
+bool SubmissionFence::wait(std::chrono::milliseconds timeout) const {
+    if (!_timeline) {
+        LOG_ERROR("SubmissionFence", "Cannot wait on invalid fence");
+        return false;
+    }
+    return _timeline->wait(_value, timeout);
+}
+
+void SubmissionFence::then(QueueWorkDoneCallback callback) const {
+    if (!callback) {
+        return;
+    }
+
+    if (!_timeline) {
+        callback(false);
+        return;
+    }
+
+    _timeline->then(_value, std::move(callback));
+}
+
+} // namespace pers
@@ -0,0 +1,148 @@
+#include "pers/graphics/SubmissionScheduler.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+SubmissionScheduler::SubmissionScheduler(const std::shared_ptr<ILogicalDevice>& device) {
+    if (!device) {
+        LOG_ERROR("SubmissionScheduler", "Device is null");
+        return;
+    }
+
+    _graphicsQueue = device->getQueue();
+    _computeQueue = device->getComputeQueue();
+    if (!_computeQueue) {
+        _computeQueue = _graphicsQueue;
+    }
+}
+
+bool SubmissionScheduler::enqueue(const std::shared_ptr<ICommandBuffer>& commandBuffer, SubmissionKind kind) {
+    if (!commandBuffer) {
+        LOG_ERROR("SubmissionScheduler", "Cannot enqueue null command buffer");
+        return false;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _pending.push_back(Pending{commandBuffer, kind});
+    return true;
+}
+
+std::vector<std::shared_ptr<ICommandBuffer>> SubmissionScheduler::interleave(const std::vector<Pending>& pending,
+                                                                             bool includeIndependent) {
+    std::vector<std::shared_ptr<ICommandBuffer>> ordered;
+    std::vector<std::shared_ptr<ICommandBuffer>> independent;
+    size_t renderCount = 0;
+    for (const auto& entry : pending) {
+        if (entry.kind == SubmissionKind::IndependentCompute) {
+            if (includeIndependent) {
+                independent.push_back(entry.commandBuffer);
+            }
+        } else if (entry.kind == SubmissionKind::Render) {
+            ++renderCount;
+        }
+    }
+    ordered.reserve(pending.size());
+
+    // Nothing to hide behind, keep submission order
+    if (renderCount == 0) {
+        for (const auto& entry : pending) {
+            if (entry.kind != SubmissionKind::IndependentCompute || includeIndependent) {
+                ordered.push_back(entry.commandBuffer);
+            }
+        }
+        return ordered;
+    }
+
+    // Spread independent work over the gaps between render buffers; with a single
+    // render buffer it all follows it rather than delaying the start of the frame
+    const size_t gaps = renderCount > 1 ? renderCount - 1 : 1;
+    size_t nextIndependent = 0;
+    size_t renderSeen = 0;
+    for (const auto& entry : pending) {
+        if (entry.kind == SubmissionKind::IndependentCompute) {
+            continue;
+        }
+
+        ordered.push_back(entry.commandBuffer);
+        if (entry.kind != SubmissionKind::Render) {
+            continue;
+        }
+
+        ++renderSeen;
+        const size_t gap = std::min(renderSeen, gaps);
+        const size_t target = independent.size() * gap / gaps;
+        while (nextIndependent < target) {
+            ordered.push_back(independent[nextIndependent++]);
+        }
+    }
+
+    while (nextIndependent < independent.size()) {
+        ordered.push_back(independent[nextIndependent++]);
+    }
+    return ordered;
+}
+
+SubmissionScheduler::ScheduledSubmission SubmissionScheduler::flush() {
+    std::vector<Pending> pending;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        pending.swap(_pending);
+    }
+
+    ScheduledSubmission result;
+    if (!_graphicsQueue) {
+        LOG_ERROR("SubmissionScheduler", "Cannot flush without a queue");
+        return result;
+    }
+
+    uint64_t render = 0;
+    uint64_t dependent = 0;
+    std::vector<std::shared_ptr<ICommandBuffer>> asyncCompute;
+    for (const auto& entry : pending) {
+        switch (entry.kind) {
+            case SubmissionKind::Render:
+                ++render;
+                break;
+            case SubmissionKind::DependentCompute:
+                ++dependent;
+                break;
+            case SubmissionKind::IndependentCompute:
+                if (hasAsyncComputeQueue()) {
+                    asyncCompute.push_back(entry.commandBuffer);
+                }
+                break;
+        }
+    }
+    const uint64_t independent = pending.size() - render - dependent;
+
+    // Async work goes first so it starts while graphics is still being submitted
+    if (!asyncCompute.empty()) {
+        result.compute = _computeQueue->submit(asyncCompute);
+    }
+
+    result.graphics = _graphicsQueue->submit(interleave(pending, !hasAsyncComputeQueue()));
+    if (asyncCompute.empty()) {
+        result.compute = result.graphics;
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    ++_stats.flushes;
+    _stats.renderBuffers += render;
+    _stats.dependentComputeBuffers += dependent;
+    _stats.independentComputeBuffers += independent;
+    if (!asyncCompute.empty()) {
+        ++_stats.asyncQueueSubmits;
+    }
+    return result;
+}
+
+SubmissionScheduler::Stats SubmissionScheduler::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _stats;
+}
+
+} // namespace pers
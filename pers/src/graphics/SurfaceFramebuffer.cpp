@@ -1,6 +1,7 @@
 #include "pers/graphics/SurfaceFramebuffer.h"
 #include "pers/graphics/OffscreenFramebuffer.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
 
 namespace pers {
 
@@ -10,7 +11,11 @@ SurfaceFramebuffer::SurfaceFramebuffer(const std::shared_ptr<ILogicalDevice>& de
     , _height(0)
     , _format(TextureFormat::Undefined)
     , _depthFormat(TextureFormat::Undefined)
-    , _acquired(false) {
+    , _sampleCount(1)
+    , _acquired(false)
+    , _pendingWidth(0)
+    , _pendingHeight(0)
+    , _resizePending(false) {
     
     if (!device) {
         LOG_ERROR("SurfaceFramebuffer", "Invalid device provided");
@@ -23,6 +28,7 @@ SurfaceFramebuffer::~SurfaceFramebuffer() {
 
 bool SurfaceFramebuffer::create(const NativeSurfaceHandle& surface, const SwapChainDesc& desc, 
                                 TextureFormat depthFormat) {
+    PERS_PROFILE_SCOPE("SurfaceFramebuffer::create");
     if (!_device) {
         LOG_ERROR("SurfaceFramebuffer", "Device not set");
         return false;
@@ -36,6 +42,8 @@ bool SurfaceFramebuffer::create(const NativeSurfaceHandle& surface, const SwapCh
     _height = desc.height;
     _format = desc.format;
     _depthFormat = depthFormat;
+    _sampleCount = static_cast<uint32_t>(desc.msaaLevel);
+    _resizePending = false;
     
     // Create swap chain through device
     _swapChain = _device->createSwapChain(surface, desc);
@@ -48,16 +56,28 @@ bool SurfaceFramebuffer::create(const NativeSurfaceHandle& surface, const SwapCh
     // Query and store surface capabilities
     _surfaceCapabilities = _swapChain->querySurfaceCapabilities();
     
+    // Multisampled color target resolving into the swap chain image
+    if (_sampleCount > 1) {
+        createMultisampleBuffer();
+    }
+    
     // Create depth buffer if needed
     if (_depthFormat != TextureFormat::Undefined) {
         createDepthBuffer();
     }
     
+    if (desc.presentThread) {
+        startPresentThread();
+    }
+    
     LOG_INFO("SurfaceFramebuffer", "Created swap chain");
     return true;
 }
 
 void SurfaceFramebuffer::destroy() {
+    // Lets a handed-off frame present, then drops a prefetched image
+    stopPresentThread();
+    
     // Clean up acquired state first
     if (_acquired) {
         LOG_WARNING("SurfaceFramebuffer", "Destroying while image is acquired");
@@ -66,9 +86,12 @@ void SurfaceFramebuffer::destroy() {
     }
     
     // Destroy in exact reverse order of creation
-    // 3. Destroy depth buffer (created last in create())
+    // 4. Destroy depth buffer (created last in create())
     _depthFramebuffer.reset();
     
+    // 3. Destroy multisampled color buffer
+    _msaaFramebuffer.reset();
+    
     // 2. Destroy swap chain (created second in create())
     _swapChain.reset();
     
@@ -92,7 +115,7 @@ void SurfaceFramebuffer::createDepthBuffer() {
     config.height = _height;
     config.depthFormat = _depthFormat;
     config.depthUsage = TextureUsage::RenderAttachment;
-    config.sampleCount = 1;
+    config.sampleCount = _sampleCount;
     
     _depthFramebuffer = std::make_shared<OffscreenFramebuffer>(factory, config);
     
@@ -101,6 +124,30 @@ void SurfaceFramebuffer::createDepthBuffer() {
     }
 }
 
+void SurfaceFramebuffer::createMultisampleBuffer() {
+    const auto& factory = _device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("SurfaceFramebuffer", "Failed to get resource factory");
+        return;
+    }
+    
+    // Render-only usage: never sampled or copied, its samples are discarded after the resolve
+    OffscreenFramebufferConfig config;
+    config.width = _width;
+    config.height = _height;
+    config.colorFormats = {_format};
+    config.colorUsage = TextureUsage::RenderAttachment;
+    config.sampleCount = _sampleCount;
+    
+    _msaaFramebuffer = std::make_shared<OffscreenFramebuffer>(factory, config);
+    
+    if (!_msaaFramebuffer->getColorAttachment(0)) {
+        LOG_WARNING("SurfaceFramebuffer", "Failed to create multisampled color buffer, MSAA disabled");
+        _msaaFramebuffer.reset();
+        _sampleCount = 1;
+    }
+}
+
 std::shared_ptr<ITextureView> SurfaceFramebuffer::getColorAttachment(uint32_t index) const {
     if (index != 0) {
         return nullptr;
@@ -111,6 +158,16 @@ std::shared_ptr<ITextureView> SurfaceFramebuffer::getColorAttachment(uint32_t in
         return nullptr;
     }
     
+    if (_msaaFramebuffer) {
+        return _msaaFramebuffer->getColorAttachment(0);
+    }
+    return _currentColorView;
+}
+
+std::shared_ptr<ITextureView> SurfaceFramebuffer::getResolveTarget(uint32_t index) const {
+    if (index != 0 || !_msaaFramebuffer || !_acquired) {
+        return nullptr;
+    }
     return _currentColorView;
 }
 
@@ -130,7 +187,7 @@ uint32_t SurfaceFramebuffer::getHeight() const {
 }
 
 uint32_t SurfaceFramebuffer::getSampleCount() const {
-    return 1;
+    return _sampleCount;
 }
 
 TextureFormat SurfaceFramebuffer::getColorFormat(uint32_t index) const {
@@ -153,20 +210,41 @@ bool SurfaceFramebuffer::hasDepthStencilAttachment() const {
 }
 
 bool SurfaceFramebuffer::resize(uint32_t width, uint32_t height) {
-    if (_width == width && _height == height) {
-        return true;
+    // Coalesce: only the last request before the next acquire is applied
+    std::lock_guard<std::mutex> lock(_resizeMutex);
+    _pendingWidth = width;
+    _pendingHeight = height;
+    _resizePending = (_width != width || _height != height);
+    return true;
+}
+
+bool SurfaceFramebuffer::applyPendingResize() {
+    {
+        std::lock_guard<std::mutex> lock(_resizeMutex);
+        if (!_resizePending) {
+            return true;
+        }
+        
+        // Minimized window, keep the request until there is something to render to
+        if (_pendingWidth == 0 || _pendingHeight == 0) {
+            return false;
+        }
+        
+        _width = _pendingWidth;
+        _height = _pendingHeight;
+        _resizePending = false;
     }
     
-    _width = width;
-    _height = height;
-    
     // Resize swap chain
-    if (_swapChain) {
-        _swapChain->resize(width, height);
-    }
+    _swapChain->resize(_width, _height);
     
-    // Recreate depth buffer with new size
-    createDepthBuffer();
+    // Recreate multisampled color and depth buffers with new size
+    if (_msaaFramebuffer) {
+        createMultisampleBuffer();
+    }
+    if (_depthFormat != TextureFormat::Undefined) {
+        createDepthBuffer();
+    }
     
     return true;
 }
@@ -183,10 +261,22 @@ bool SurfaceFramebuffer::acquireNextImage() {
         return false;
     }
     
-    _currentColorView = _swapChain->getCurrentTextureView();
+    if (_presentThread.joinable()) {
+        PERS_PROFILE_SCOPE("SurfaceFramebuffer::waitForImage");
+        std::unique_lock<std::mutex> lock(_presentMutex);
+        // Prefetched after the last present; otherwise the last acquire failed, retry
+        if (!_imageReady && !_acquireRequested && !_presentPending) {
+            _acquireRequested = true;
+            _presentCv.notify_one();
+        }
+        _readyCv.wait(lock, [this] { return _imageReady; });
+        _imageReady = false;
+        _currentColorView = std::move(_nextColorView);
+    } else {
+        _currentColorView = acquireFromSwapChain();
+    }
     
     if (!_currentColorView) {
-        LOG_ERROR("SurfaceFramebuffer", "Failed to acquire next image");
         return false;
     }
     
@@ -194,24 +284,116 @@ bool SurfaceFramebuffer::acquireNextImage() {
     return true;
 }
 
+std::shared_ptr<ITextureView> SurfaceFramebuffer::acquireFromSwapChain() {
+    if (!applyPendingResize()) {
+        return nullptr;
+    }
+    
+    auto view = _swapChain->getCurrentTextureView();
+    if (!view) {
+        LOG_ERROR("SurfaceFramebuffer", "Failed to acquire next image");
+    }
+    return view;
+}
+
 void SurfaceFramebuffer::present() {
     if (!_acquired) {
         LOG_WARNING("SurfaceFramebuffer", "No image to present");
         return;
     }
     
+    _currentColorView.reset();
+    _acquired = false;
+    
+    if (_presentThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(_presentMutex);
+            _presentPending = true;
+        }
+        _presentCv.notify_one();
+        return;
+    }
+    
     if (_swapChain) {
         _swapChain->present();
     }
+}
+
+void SurfaceFramebuffer::startPresentThread() {
+    {
+        std::lock_guard<std::mutex> lock(_presentMutex);
+        _presentPending = false;
+        _imageReady = false;
+        _stopPresent = false;
+        _acquireRequested = true;  // First image is fetched right away
+    }
+    _presentThread = std::thread([this] { runPresentThread(); });
+}
+
+void SurfaceFramebuffer::stopPresentThread() {
+    if (!_presentThread.joinable()) {
+        return;
+    }
     
-    _currentColorView.reset();
-    _acquired = false;
+    {
+        std::lock_guard<std::mutex> lock(_presentMutex);
+        _stopPresent = true;
+    }
+    _presentCv.notify_one();
+    _presentThread.join();
+    
+    _nextColorView.reset();
+    _imageReady = false;
+    _acquireRequested = false;
+}
+
+void SurfaceFramebuffer::runPresentThread() {
+    std::unique_lock<std::mutex> lock(_presentMutex);
+    while (true) {
+        _presentCv.wait(lock, [this] { return _stopPresent || _presentPending || _acquireRequested; });
+        
+        if (_presentPending) {
+            lock.unlock();
+            {
+                PERS_PROFILE_SCOPE("SurfaceFramebuffer::present");
+                _swapChain->present();
+            }
+            lock.lock();
+            _presentPending = false;
+            // Prefetch while the caller prepares the next frame
+            _acquireRequested = true;
+            continue;
+        }
+        
+        if (_stopPresent) {
+            break;
+        }
+        
+        lock.unlock();
+        std::shared_ptr<ITextureView> view;
+        {
+            PERS_PROFILE_SCOPE("SurfaceFramebuffer::acquire");
+            view = acquireFromSwapChain();
+        }
+        lock.lock();
+        _acquireRequested = false;
+        _nextColorView = std::move(view);
+        _imageReady = true;
+        _readyCv.notify_one();
+    }
 }
 
 bool SurfaceFramebuffer::isReady() const {
     return _acquired;
 }
 
+std::shared_ptr<ITexture> SurfaceFramebuffer::getCurrentTexture() const {
+    if (!_acquired || !_swapChain) {
+        return nullptr;
+    }
+    return _swapChain->getCurrentTexture();
+}
+
 void SurfaceFramebuffer::setDepthFramebuffer(const std::shared_ptr<IFramebuffer>& depthFramebuffer) {
     _depthFramebuffer = depthFramebuffer;
     
@@ -0,0 +1,83 @@
+#include "pers/graphics/SurfacePresentGroup.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/ISurfaceFramebuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+
+namespace pers {
+
+SurfacePresentGroup::SurfacePresentGroup(const std::shared_ptr<IQueue>& queue)
+    : _queue(queue) {
+    if (!queue) {
+        LOG_ERROR("SurfacePresentGroup", "Queue is null");
+    }
+}
+
+uint32_t SurfacePresentGroup::addSurface(const std::shared_ptr<ISurfaceFramebuffer>& surface) {
+    Slot slot;
+    slot.surface = surface;
+    _slots.push_back(std::move(slot));
+    return static_cast<uint32_t>(_slots.size() - 1);
+}
+
+void SurfacePresentGroup::removeSurface(const std::shared_ptr<ISurfaceFramebuffer>& surface) {
+    std::erase_if(_slots, [&](const Slot& slot) { return slot.surface == surface; });
+}
+
+uint32_t SurfacePresentGroup::acquireAll() {
+    PERS_PROFILE_SCOPE("SurfacePresentGroup::acquireAll");
+    uint32_t acquired = 0;
+    for (auto& slot : _slots) {
+        slot.commandBuffer.reset();
+        slot.acquired = slot.surface && slot.surface->acquireNextImage();
+        acquired += slot.acquired ? 1 : 0;
+    }
+    return acquired;
+}
+
+void SurfacePresentGroup::setCommandBuffer(uint32_t index, const std::shared_ptr<ICommandBuffer>& commandBuffer) {
+    if (index >= _slots.size() || !_slots[index].acquired) {
+        LOG_WARNING("SurfacePresentGroup", "Command buffer for a surface that is not acquired is dropped");
+        return;
+    }
+    _slots[index].commandBuffer = commandBuffer;
+}
+
+void SurfacePresentGroup::addSharedCommandBuffer(const std::shared_ptr<ICommandBuffer>& commandBuffer) {
+    if (commandBuffer) {
+        _sharedCommandBuffers.push_back(commandBuffer);
+    }
+}
+
+SubmissionFence SurfacePresentGroup::submitAndPresent() {
+    PERS_PROFILE_SCOPE("SurfacePresentGroup::submitAndPresent");
+    _submission.clear();
+    _submission.insert(_submission.end(), _sharedCommandBuffers.begin(), _sharedCommandBuffers.end());
+    for (auto& slot : _slots) {
+        if (slot.commandBuffer) {
+            _submission.push_back(std::move(slot.commandBuffer));
+        }
+    }
+    _sharedCommandBuffers.clear();
+
+    SubmissionFence fence;
+    if (!_submission.empty() && _queue) {
+        fence = _queue->submit(_submission);
+        if (!fence) {
+            LOG_ERROR("SurfacePresentGroup", "Failed to submit viewport command buffers");
+        }
+    }
+    _submission.clear();
+
+    // Acquired images have to go back to their swap chains even if the submit failed
+    for (auto& slot : _slots) {
+        if (slot.acquired) {
+            slot.surface->present();
+            slot.acquired = false;
+        }
+    }
+    return fence;
+}
+
+} // namespace pers
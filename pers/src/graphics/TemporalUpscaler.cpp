@@ -0,0 +1,370 @@
+#include "pers/graphics/TemporalUpscaler.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IFramebuffer.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <span>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct TemporalUniforms {
+    float renderSize[2];      // Rendered region in texels
+    float invTextureSize[2];  // Reciprocal of the allocated scene size
+    float jitter[2];          // Render pixels
+    float outputSize[2];
+    float feedback;
+    uint32_t historyValid;
+    uint32_t padding[2];
+};
+
+constexpr char TEMPORAL_WGSL[] = R"(
+struct Temporal {
+    renderSize: vec2<f32>,
+    invTextureSize: vec2<f32>,
+    jitter: vec2<f32>,
+    outputSize: vec2<f32>,
+    feedback: f32,
+    historyValid: u32,
+    padding0: u32,
+    padding1: u32,
+};
+@group(0) @binding(0) var<uniform> temporal: Temporal;
+@group(0) @binding(1) var color: texture_2d<f32>;
+@group(0) @binding(2) var motion: texture_2d<f32>;
+@group(0) @binding(3) var history: texture_2d<f32>;
+@group(0) @binding(4) var linearSampler: sampler;
+)";
+
+using TemporalLayout = GpuStruct<GpuLayout::Std140, GpuVec2f, GpuVec2f, GpuVec2f, GpuVec2f,
+                                 GpuF32, GpuU32, GpuU32, GpuU32>;
+static_assert(TemporalLayout::matchesWgsl(TEMPORAL_WGSL, "Temporal"), "Temporal no longer matches the resolve shader");
+static_assert(TemporalLayout::SIZE == sizeof(TemporalUniforms) &&
+              TemporalLayout::offsetOf<4>() == offsetof(TemporalUniforms, feedback),
+              "TemporalUniforms must match the WGSL layout");
+
+constexpr char VERTEX_SHADER[] = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    // Single triangle covering the viewport
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+constexpr char FRAGMENT_MAIN[] = R"(
+struct Output {
+    @location(0) color: vec4<f32>,
+    @location(1) history: vec4<f32>,
+};
+
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> Output {
+    let uv = position.xy / temporal.outputSize;
+    // Where this pixel's content landed in the jittered frame
+    let renderPosition = uv * temporal.renderSize + temporal.jitter;
+    let maxTexel = vec2<i32>(temporal.renderSize) - vec2<i32>(1);
+    let center = clamp(vec2<i32>(floor(renderPosition)), vec2<i32>(0), maxTexel);
+
+    var low = vec3<f32>(3.0e38);
+    var high = vec3<f32>(-3.0e38);
+    for (var y = -1; y <= 1; y++) {
+        for (var x = -1; x <= 1; x++) {
+            let neighbour = textureLoad(color, clamp(center + vec2<i32>(x, y), vec2<i32>(0), maxTexel), 0).rgb;
+            low = min(low, neighbour);
+            high = max(high, neighbour);
+        }
+    }
+
+    let sampleUv = clamp(renderPosition, vec2<f32>(0.5), temporal.renderSize - 0.5) * temporal.invTextureSize;
+    let current = textureSampleLevel(color, linearSampler, sampleUv, 0.0);
+    let historyUv = uv + textureLoad(motion, center, 0).xy;
+
+    var result = current.rgb;
+    if (temporal.historyValid != 0u && all(historyUv >= vec2<f32>(0.0)) && all(historyUv <= vec2<f32>(1.0))) {
+        let previous = clamp(textureSampleLevel(history, linearSampler, historyUv, 0.0).rgb, low, high);
+        result = mix(current.rgb, previous, temporal.feedback);
+    }
+
+    var output: Output;
+    output.color = vec4<f32>(result, current.a);
+    output.history = vec4<f32>(result, 1.0);
+    return output;
+}
+)";
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("TemporalUpscaler", "Failed to create temporal resolve shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+float halton(uint32_t index, uint32_t base) {
+    float fraction = 1.0f;
+    float result = 0.0f;
+    while (index > 0) {
+        fraction /= static_cast<float>(base);
+        result += fraction * static_cast<float>(index % base);
+        index /= base;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+TemporalUpscaler::TemporalUpscaler(const std::shared_ptr<ILogicalDevice>& device,
+                                   const TemporalUpscalerConfig& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("TemporalUpscaler", "Device or resource factory is null");
+        return;
+    }
+
+    _uniformBuffer = std::make_shared<DeviceBuffer>();
+    if (!_uniformBuffer->create(sizeof(TemporalUniforms), DeviceBufferUsage::Uniform, device, "TemporalUpscaler")) {
+        LOG_ERROR("TemporalUpscaler", "Failed to create temporal uniform buffer");
+        return;
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.label = "TemporalUpscaler";
+    _sampler = factory->createSampler(samplerDesc);
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "TemporalUpscaler::Resolve";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(TemporalUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 3, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 4, .visibility = ShaderStage::Fragment, .type = BindingType::Sampler},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+
+    _vertexShader = createShader(*factory, VERTEX_SHADER, ShaderStage::Vertex, "TemporalUpscaler::ResolveVertex");
+    _fragmentShader = createShader(*factory, std::string(TEMPORAL_WGSL) + FRAGMENT_MAIN, ShaderStage::Fragment,
+                                   "TemporalUpscaler::ResolveFragment");
+    if (!_sampler || !_layout || !_vertexShader || !_fragmentShader) {
+        LOG_ERROR("TemporalUpscaler", "Failed to create temporal resolve resources");
+        return;
+    }
+
+    // Created last, isValid() means the resolve is usable
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_layout};
+    pipelineLayoutDesc.debugName = "TemporalUpscaler::Resolve";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+}
+
+TemporalUpscaler::~TemporalUpscaler() = default;
+
+OffscreenFramebufferConfig TemporalUpscaler::createSceneConfig(uint32_t width, uint32_t height,
+                                                               TextureFormat colorFormat, TextureFormat depthFormat) {
+    OffscreenFramebufferConfig config;
+    config.width = width;
+    config.height = height;
+    config.colorFormats = {colorFormat, MOTION_VECTOR_FORMAT};
+    config.depthFormat = depthFormat;
+    return config;
+}
+
+void TemporalUpscaler::beginFrame() {
+    // Halton skips index 0, whose point sits on the pixel corner
+    _phase = _phase % std::max(_config.jitterPhases, 1u) + 1;
+    _jitter = {halton(_phase, 2) - 0.5f, halton(_phase, 3) - 0.5f};
+}
+
+std::array<float, 2> TemporalUpscaler::getClipJitter(uint32_t renderWidth, uint32_t renderHeight) const {
+    if (renderWidth == 0 || renderHeight == 0) {
+        return {0.0f, 0.0f};
+    }
+    // Clip y points up, pixel y down
+    return {2.0f * _jitter[0] / static_cast<float>(renderWidth), -2.0f * _jitter[1] / static_cast<float>(renderHeight)};
+}
+
+bool TemporalUpscaler::prepareHistory(uint32_t width, uint32_t height) {
+    if (_history[0] && _history[0]->getWidth() == width && _history[0]->getHeight() == height) {
+        return true;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return false;
+    }
+
+    OffscreenFramebufferConfig config;
+    config.width = width;
+    config.height = height;
+    config.colorFormats = {HISTORY_FORMAT};
+    for (auto& history : _history) {
+        history = std::make_unique<OffscreenFramebuffer>(factory, config);
+        if (!history->getColorAttachment(0)) {
+            LOG_ERROR("TemporalUpscaler", "Failed to create history targets");
+            _history = {};
+            return false;
+        }
+    }
+    _historyValid = false;
+    return true;
+}
+
+bool TemporalUpscaler::resolve(ICommandEncoder& encoder, const OffscreenFramebuffer& scene,
+                               uint32_t renderWidth, uint32_t renderHeight, const IFramebuffer& destination) {
+    PERS_PROFILE_SCOPE("TemporalUpscaler::resolve");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue || !isValid()) {
+        LOG_ERROR("TemporalUpscaler", "Cannot resolve with an invalid temporal upscaler");
+        return false;
+    }
+
+    auto colorView = scene.getColorAttachment(0);
+    auto motionView = scene.getColorAttachment(MOTION_VECTOR_ATTACHMENT);
+    auto destinationView = destination.getColorAttachment(0);
+    if (!colorView || !motionView || !destinationView || scene.getSampleCount() != 1) {
+        LOG_ERROR("TemporalUpscaler", "Resolve needs a single-sampled scene with color and motion vectors");
+        return false;
+    }
+
+    const uint32_t width = destination.getWidth();
+    const uint32_t height = destination.getHeight();
+    if (renderWidth == 0 || renderHeight == 0 || renderWidth > scene.getWidth() || renderHeight > scene.getHeight() ||
+        width == 0 || height == 0) {
+        LOG_ERROR("TemporalUpscaler", "Render size must be non-zero and fit the scene target");
+        return false;
+    }
+
+    auto pipeline = getPipeline(destination.getColorFormat(0));
+    if (!pipeline || !prepareHistory(width, height)) {
+        return false;
+    }
+
+    const auto& previous = *_history[_historyIndex ^ 1];
+    const auto& next = *_history[_historyIndex];
+
+    TemporalUniforms uniforms = {};
+    uniforms.renderSize[0] = static_cast<float>(renderWidth);
+    uniforms.renderSize[1] = static_cast<float>(renderHeight);
+    uniforms.invTextureSize[0] = 1.0f / static_cast<float>(scene.getWidth());
+    uniforms.invTextureSize[1] = 1.0f / static_cast<float>(scene.getHeight());
+    uniforms.jitter[0] = _jitter[0];
+    uniforms.jitter[1] = _jitter[1];
+    uniforms.outputSize[0] = static_cast<float>(width);
+    uniforms.outputSize[1] = static_cast<float>(height);
+    uniforms.feedback = std::clamp(_config.feedback, 0.0f, 1.0f);
+    uniforms.historyValid = _historyValid ? 1 : 0;
+    if (!queue->writeBuffer(_uniformBuffer, 0,
+                            std::span<const std::byte>(reinterpret_cast<const std::byte*>(&uniforms), sizeof(uniforms)))) {
+        LOG_ERROR("TemporalUpscaler", "Failed to write temporal uniforms");
+        return false;
+    }
+
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _layout;
+    bindGroupDesc.debugName = "TemporalUpscaler::Resolve";
+    bindGroupDesc.entries.resize(5);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = _uniformBuffer;
+    bindGroupDesc.entries[0].size = sizeof(TemporalUniforms);
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].textureView = colorView;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].textureView = motionView;
+    bindGroupDesc.entries[3].binding = 3;
+    bindGroupDesc.entries[3].textureView = previous.getColorAttachment(0);
+    bindGroupDesc.entries[4].binding = 4;
+    bindGroupDesc.entries[4].sampler = _sampler;
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("TemporalUpscaler", "Failed to create temporal resolve bind group");
+        return false;
+    }
+
+    // Every texel of both targets is overwritten, nothing to load
+    RenderPassDesc passDesc;
+    passDesc.label = "TemporalUpscaler::Resolve";
+    for (const auto& view : {destinationView, next.getColorAttachment(0)}) {
+        RenderPassColorAttachment attachment;
+        attachment.view = view;
+        attachment.loadOp = LoadOp::Clear;
+        attachment.storeOp = StoreOp::Store;
+        passDesc.colorAttachments.push_back(attachment);
+    }
+
+    auto renderPass = encoder.beginRenderPass(passDesc);
+    if (!renderPass) {
+        LOG_ERROR("TemporalUpscaler", "Failed to begin temporal resolve pass");
+        return false;
+    }
+    renderPass->setPipeline(pipeline);
+    renderPass->setBindGroup(0, bindGroup);
+    renderPass->draw(3);
+    renderPass->end();
+
+    _historyIndex ^= 1;
+    _historyValid = true;
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> TemporalUpscaler::getPipeline(TextureFormat format) {
+    auto it = _pipelines.find(format);
+    if (it != _pipelines.end()) {
+        return it->second;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _pipelineLayout;
+    desc.colorTargets.resize(2);
+    desc.colorTargets[0].format = format;
+    desc.colorTargets[1].format = HISTORY_FORMAT;
+    desc.debugName = "TemporalUpscaler::Resolve";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("TemporalUpscaler", "Failed to create temporal resolve pipeline");
+        return nullptr;
+    }
+
+    _pipelines.emplace(format, pipeline);
+    return pipeline;
+}
+
+} // namespace pers
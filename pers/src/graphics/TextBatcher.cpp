@@ -0,0 +1,399 @@
+#include "pers/graphics/TextBatcher.h"
+#include "pers/graphics/GlyphAtlas.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+struct TextUniforms {
+    float viewport[4];  // width, height, 1/width, 1/height
+    float alphaCutoff;
+    float padding[3];
+};
+
+const char* TEXT_VERTEX_SHADER = R"(
+struct Uniforms {
+    viewport: vec4<f32>,
+    alphaCutoff: f32,
+};
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+
+struct Output {
+    @builtin(position) position: vec4<f32>,
+    @location(0) uv: vec2<f32>,
+    @location(1) @interpolate(flat) page: u32,
+    @location(2) color: vec4<f32>,
+    @location(3) @interpolate(flat) distanceRange: f32,
+};
+
+@vertex
+fn main(@builtin(vertex_index) index: u32,
+        @location(0) rect: vec4<f32>,
+        @location(1) uvRect: vec4<f32>,
+        @location(2) page: u32,
+        @location(3) color: vec4<f32>,
+        @location(4) distanceRange: f32) -> Output {
+    // Two triangles: corners (0,0) (1,0) (0,1), (0,1) (1,0) (1,1)
+    let corner = vec2<f32>(f32((0x32u >> index) & 1u), f32((0x2Cu >> index) & 1u));
+    let pixel = mix(rect.xy, rect.zw, corner);
+
+    var output: Output;
+    output.position = vec4<f32>(pixel.x * uniforms.viewport.z * 2.0 - 1.0,
+                                1.0 - pixel.y * uniforms.viewport.w * 2.0, 0.0, 1.0);
+    output.uv = mix(uvRect.xy, uvRect.zw, corner);
+    output.page = page;
+    output.color = color;
+    output.distanceRange = distanceRange;
+    return output;
+}
+)";
+
+const char* TEXT_FRAGMENT_SHADER = R"(
+struct Uniforms {
+    viewport: vec4<f32>,
+    alphaCutoff: f32,
+};
+@group(0) @binding(0) var<uniform> uniforms: Uniforms;
+@group(0) @binding(1) var atlas: texture_2d_array<f32>;
+@group(0) @binding(2) var atlasSampler: sampler;
+
+struct Input {
+    @builtin(position) position: vec4<f32>,
+    @location(0) uv: vec2<f32>,
+    @location(1) @interpolate(flat) page: u32,
+    @location(2) color: vec4<f32>,
+    @location(3) @interpolate(flat) distanceRange: f32,
+};
+
+@fragment
+fn main(input: Input) -> @location(0) vec4<f32> {
+    // Field value to signed screen-pixel distance, covering one pixel across the outline
+    let field = textureSample(atlas, atlasSampler, input.uv, input.page).r;
+    let alpha = clamp((field - 0.5) * input.distanceRange + 0.5, 0.0, 1.0);
+    if (alpha < uniforms.alphaCutoff) {
+        discard;
+    }
+    return vec4<f32>(input.color.rgb, input.color.a * alpha);
+}
+)";
+
+// Decodes one codepoint and advances index; malformed sequences yield U+FFFD
+uint32_t decodeUtf8(std::string_view text, size_t& index) {
+    const uint8_t lead = static_cast<uint8_t>(text[index++]);
+    if (lead < 0x80) {
+        return lead;
+    }
+
+    uint32_t length = 0;
+    uint32_t codepoint = 0;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 1;
+        codepoint = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 2;
+        codepoint = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 3;
+        codepoint = lead & 0x07;
+    } else {
+        return 0xFFFD;
+    }
+
+    for (uint32_t i = 0; i < length; ++i) {
+        if (index >= text.size() || (static_cast<uint8_t>(text[index]) & 0xC0) != 0x80) {
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (static_cast<uint8_t>(text[index++]) & 0x3F);
+    }
+    return codepoint <= 0x10FFFF ? codepoint : 0xFFFD;
+}
+
+} // anonymous namespace
+
+TextBatcher::TextBatcher(const std::shared_ptr<ILogicalDevice>& device, const std::shared_ptr<GlyphAtlas>& atlas,
+                         const Config& config)
+    : _device(device)
+    , _atlas(atlas) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !atlas) {
+        LOG_ERROR("TextBatcher", "Device, resource factory or glyph atlas is null");
+        return;
+    }
+
+    _buffer = std::make_unique<DynamicBuffer>();
+    if (!_buffer->create(config.bufferSize, BufferUsage::Vertex | BufferUsage::Uniform, device,
+                         config.frameCount, "TextBatcher")) {
+        LOG_ERROR("TextBatcher", "Failed to create glyph buffer");
+        return;
+    }
+
+    ShaderModuleDesc vertexDesc;
+    vertexDesc.code = TEXT_VERTEX_SHADER;
+    vertexDesc.stage = ShaderStage::Vertex;
+    vertexDesc.entryPoint = "main";
+    vertexDesc.debugName = "TextBatcher::Vertex";
+    _vertexShader = factory->createShaderModule(vertexDesc);
+
+    ShaderModuleDesc fragmentDesc;
+    fragmentDesc.code = TEXT_FRAGMENT_SHADER;
+    fragmentDesc.stage = ShaderStage::Fragment;
+    fragmentDesc.entryPoint = "main";
+    fragmentDesc.debugName = "TextBatcher::Fragment";
+    _fragmentShader = factory->createShaderModule(fragmentDesc);
+
+    if (!_vertexShader || !_vertexShader->isValid() || !_fragmentShader || !_fragmentShader->isValid()) {
+        LOG_ERROR("TextBatcher", "Failed to create text shaders");
+        return;
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.label = "TextBatcher";
+    _sampler = factory->createSampler(samplerDesc);
+    if (!_sampler) {
+        LOG_ERROR("TextBatcher", "Failed to create atlas sampler");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "TextBatcher";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex | ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .hasDynamicOffset = true, .minBindingSize = sizeof(TextUniforms)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::Float, .viewDimension = TextureViewDimension::D2Array},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::Sampler},
+    };
+    _bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!_bindGroupLayout) {
+        LOG_ERROR("TextBatcher", "Failed to create bind group layout");
+        return;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_bindGroupLayout};
+    pipelineLayoutDesc.debugName = "TextBatcher";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!_pipelineLayout) {
+        LOG_ERROR("TextBatcher", "Failed to create pipeline layout");
+    }
+}
+
+TextBatcher::~TextBatcher() = default;
+
+std::array<float, 2> TextBatcher::addText(float x, float y, std::string_view utf8, const TextStyle& style) {
+    return layout(x, y, utf8, style, true);
+}
+
+std::array<float, 2> TextBatcher::measure(std::string_view utf8, const TextStyle& style) {
+    return layout(0.0f, 0.0f, utf8, style, false);
+}
+
+bool TextBatcher::prepare(ICommandEncoder& encoder) {
+    return _atlas && _atlas->flush(encoder);
+}
+
+bool TextBatcher::render(IRenderPassEncoder& pass, const Target& target, uint32_t viewportWidth,
+                         uint32_t viewportHeight) {
+    PERS_PROFILE_SCOPE("TextBatcher::render");
+    if (!isValid() || _quads.empty() || viewportWidth == 0 || viewportHeight == 0) {
+        return false;
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto pipeline = factory ? getPipeline(target) : nullptr;
+    const auto& view = _atlas->getAtlas().getView();
+    if (!pipeline || !view) {
+        return false;
+    }
+
+    TextUniforms uniforms = {};
+    uniforms.viewport[0] = static_cast<float>(viewportWidth);
+    uniforms.viewport[1] = static_cast<float>(viewportHeight);
+    uniforms.viewport[2] = 1.0f / uniforms.viewport[0];
+    uniforms.viewport[3] = 1.0f / uniforms.viewport[1];
+    // Alpha-to-coverage takes the edge ramp; without it only the outline test is left
+    uniforms.alphaCutoff = target.sampleCount > 1 ? 1.0f / 255.0f : 0.5f;
+    const uint64_t uniformOffset = _buffer->write(uniforms);
+
+    // Draw what fits; the slice offset is aligned up by at most 3 bytes
+    const uint64_t remaining = uniformOffset != BufferCopyDesc::WHOLE_SIZE ? _buffer->getRemainingBytes() : 0;
+    const size_t fit = std::min<size_t>(_quads.size(), remaining > 3 ? (remaining - 3) / sizeof(GlyphQuad) : 0);
+    _droppedCount += _quads.size() - fit;
+    if (fit == 0) {
+        LOG_WARNING("TextBatcher", "Frame buffer is full, text dropped");
+        return false;
+    }
+
+    auto slice = _buffer->allocate(fit * sizeof(GlyphQuad), BufferAlignment::VERTEX_BUFFER_OFFSET);
+    if (!slice.data) {
+        _droppedCount += fit;
+        return false;
+    }
+    std::memcpy(slice.data, _quads.data(), fit * sizeof(GlyphQuad));
+
+    // Shared through the factory's cache until the ring slot or the atlas view changes
+    const auto frameBuffer = _buffer->getCurrentFrameBuffer();
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _bindGroupLayout;
+    bindGroupDesc.debugName = "TextBatcher";
+    bindGroupDesc.entries.resize(3);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = frameBuffer;
+    bindGroupDesc.entries[0].size = sizeof(TextUniforms);
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].textureView = view;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].sampler = _sampler;
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("TextBatcher", "Failed to create bind group");
+        return false;
+    }
+
+    const uint32_t dynamicOffset = static_cast<uint32_t>(uniformOffset);
+    pass.setPipeline(pipeline);
+    pass.setBindGroup(0, bindGroup, {&dynamicOffset, 1});
+    pass.setVertexBuffer(0, frameBuffer, slice.offset, slice.size);
+    pass.draw(6, static_cast<uint32_t>(fit));
+    return true;
+}
+
+bool TextBatcher::flush() {
+    return _buffer && _buffer->flush();
+}
+
+void TextBatcher::nextFrame() {
+    if (_buffer) {
+        _buffer->nextFrame();
+    }
+    clear();
+}
+
+std::array<float, 2> TextBatcher::layout(float x, float y, std::string_view utf8, const TextStyle& style, bool emit) {
+    if (!_atlas || !_atlas->isValid() || utf8.empty()) {
+        return {0.0f, 0.0f};
+    }
+
+    const GlyphAtlas::Config& atlasConfig = _atlas->getConfig();
+    const FontMetrics& metrics = _atlas->getMetrics();
+    const float scale = style.size / atlasConfig.pixelSize;
+    const float lineAdvance = metrics.lineHeight * scale * style.lineSpacing;
+    const float distanceRange = 2.0f * static_cast<float>(atlasConfig.spread) * scale;
+
+    float pen = x;
+    float baseline = y + metrics.ascent * scale;
+    float width = 0.0f;
+    uint32_t lines = 1;
+    uint32_t previous = 0;
+
+    size_t index = 0;
+    while (index < utf8.size()) {
+        const uint32_t codepoint = decodeUtf8(utf8, index);
+        if (codepoint == '\n') {
+            width = std::max(width, pen - x);
+            pen = x;
+            baseline += lineAdvance;
+            ++lines;
+            previous = 0;
+            continue;
+        }
+
+        const GlyphInfo* glyph = _atlas->getGlyph(codepoint);
+        if (!glyph) {
+            _droppedCount += emit ? 1 : 0;
+            previous = 0;
+            continue;
+        }
+        if (previous) {
+            pen += _atlas->getKerning(previous, codepoint) * scale;
+        }
+
+        if (emit && glyph->hasInk) {
+            GlyphQuad quad;
+            quad.rect[0] = pen + glyph->offsetX * scale;
+            quad.rect[1] = baseline - glyph->offsetY * scale;
+            quad.rect[2] = quad.rect[0] + static_cast<float>(glyph->region.width) * scale;
+            quad.rect[3] = quad.rect[1] + static_cast<float>(glyph->region.height) * scale;
+            std::copy(glyph->region.uvRect.begin(), glyph->region.uvRect.end(), quad.uvRect);
+            quad.page = glyph->region.page;
+            quad.color = style.color;
+            quad.distanceRange = distanceRange;
+            _quads.push_back(quad);
+        }
+
+        pen += glyph->advance * scale;
+        previous = codepoint;
+    }
+
+    width = std::max(width, pen - x);
+    const float height = (metrics.ascent + metrics.descent) * scale + lineAdvance * static_cast<float>(lines - 1);
+    return {width, height};
+}
+
+std::shared_ptr<IRenderPipeline> TextBatcher::getPipeline(const Target& target) {
+    for (const PipelineEntry& entry : _pipelines) {
+        if (entry.target == target) {
+            return entry.pipeline;
+        }
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = _fragmentShader;
+    desc.layout = _pipelineLayout;
+    desc.vertexLayouts = {{
+        .arrayStride = sizeof(GlyphQuad),
+        .stepMode = VertexStepMode::Instance,
+        .attributes = {
+            {VertexFormat::Float32x4, offsetof(GlyphQuad, rect), 0},
+            {VertexFormat::Float32x4, offsetof(GlyphQuad, uvRect), 1},
+            {VertexFormat::Uint32, offsetof(GlyphQuad, page), 2},
+            {VertexFormat::Unorm8x4, offsetof(GlyphQuad, color), 3},
+            {VertexFormat::Float32, offsetof(GlyphQuad, distanceRange), 4},
+        },
+    }};
+    desc.primitive.topology = PrimitiveTopology::TriangleList;
+
+    // Text overlays the scene: depth is neither tested nor written
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = false;
+    desc.depthStencil.depthCompare = CompareFunction::Always;
+    desc.multisample.count = target.sampleCount;
+    desc.multisample.alphaToCoverageEnabled = target.sampleCount > 1;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+    desc.debugName = "TextBatcher";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("TextBatcher", "Failed to create text pipeline");
+        return nullptr;
+    }
+
+    _pipelines.push_back({target, pipeline});
+    return pipeline;
+}
+
+} // namespace pers
@@ -0,0 +1,399 @@
+#include "pers/graphics/TextureAtlas.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace pers {
+
+SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+    : _width(width)
+    , _height(height) {
+    reset();
+}
+
+void SkylinePacker::reset() {
+    _skyline.clear();
+    _skyline.push_back({0, 0, _width});
+    _usedArea = 0;
+}
+
+float SkylinePacker::getOccupancy() const {
+    const uint64_t area = static_cast<uint64_t>(_width) * _height;
+    return area ? static_cast<float>(_usedArea) / static_cast<float>(area) : 0.0f;
+}
+
+bool SkylinePacker::fits(size_t index, uint32_t width, uint32_t height, uint32_t& y) const {
+    if (_skyline[index].x + width > _width) {
+        return false;
+    }
+
+    y = _skyline[index].y;
+    uint32_t remaining = width;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, _skyline[i].y);
+        if (y + height > _height) {
+            return false;
+        }
+        remaining -= std::min(remaining, _skyline[i].width);
+    }
+    return true;
+}
+
+bool SkylinePacker::pack(uint32_t width, uint32_t height, uint32_t& x, uint32_t& y) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+
+    size_t bestIndex = _skyline.size();
+    uint32_t bestTop = UINT32_MAX;
+    uint32_t bestWidth = UINT32_MAX;
+    uint32_t bestY = 0;
+    for (size_t i = 0; i < _skyline.size(); ++i) {
+        uint32_t restY = 0;
+        if (!fits(i, width, height, restY)) {
+            continue;
+        }
+        const uint32_t top = restY + height;
+        if (top < bestTop || (top == bestTop && _skyline[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestWidth = _skyline[i].width;
+            bestY = restY;
+        }
+    }
+
+    if (bestIndex == _skyline.size()) {
+        return false;
+    }
+
+    x = _skyline[bestIndex].x;
+    y = bestY;
+    _skyline.insert(_skyline.begin() + static_cast<ptrdiff_t>(bestIndex), Segment{x, y + height, width});
+
+    // Trim the segments now covered by the new one
+    for (size_t i = bestIndex + 1; i < _skyline.size();) {
+        const Segment& previous = _skyline[i - 1];
+        const uint32_t previousEnd = previous.x + previous.width;
+        if (_skyline[i].x >= previousEnd) {
+            break;
+        }
+        const uint32_t overlap = previousEnd - _skyline[i].x;
+        if (_skyline[i].width <= overlap) {
+            _skyline.erase(_skyline.begin() + static_cast<ptrdiff_t>(i));
+            continue;
+        }
+        _skyline[i].x += overlap;
+        _skyline[i].width -= overlap;
+        break;
+    }
+
+    // Merge neighbours of equal height
+    for (size_t i = 0; i + 1 < _skyline.size();) {
+        if (_skyline[i].y == _skyline[i + 1].y) {
+            _skyline[i].width += _skyline[i + 1].width;
+            _skyline.erase(_skyline.begin() + static_cast<ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+
+    _usedArea += static_cast<uint64_t>(width) * height;
+    return true;
+}
+
+TextureAtlas::TextureAtlas(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    if (!device) {
+        LOG_ERROR("TextureAtlas", "Device is null");
+        return;
+    }
+
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(config.format);
+    if (block.blockBytes == 0 || block.blockWidth != 1 || block.blockHeight != 1) {
+        LOG_ERROR("TextureAtlas", "Atlas format must be uncompressed");
+        return;
+    }
+    _texelBytes = block.blockBytes;
+
+    const DeviceLimits limits = device->getLimits();
+    if (limits.maxTextureDimension2D && _config.pageSize > limits.maxTextureDimension2D) {
+        LOG_WARNING("TextureAtlas", "Page size exceeds the device limit, clamping");
+        _config.pageSize = limits.maxTextureDimension2D;
+    }
+    if (limits.maxTextureArrayLayers) {
+        _config.maxPages = std::min(_config.maxPages, limits.maxTextureArrayLayers);
+    }
+    _config.maxPages = std::max(_config.maxPages, 1u);
+    _config.initialPages = std::clamp(_config.initialPages, 1u, _config.maxPages);
+
+    for (uint32_t i = 0; i < _config.initialPages; ++i) {
+        _pages.emplace_back(_config.pageSize, _config.pageSize);
+    }
+    createTexture(_config.initialPages);
+}
+
+TextureAtlas::~TextureAtlas() {
+    if (_staging) {
+        _staging->destroy();
+    }
+}
+
+std::optional<AtlasRegion> TextureAtlas::add(const void* pixels, uint32_t width, uint32_t height, uint32_t bytesPerRow) {
+    if (!isValid() || !pixels || width == 0 || height == 0) {
+        return std::nullopt;
+    }
+
+    const uint32_t padding = _config.padding;
+    const uint32_t paddedWidth = width + 2 * padding;
+    const uint32_t paddedHeight = height + 2 * padding;
+    if (paddedWidth > _config.pageSize || paddedHeight > _config.pageSize) {
+        LOG_ERROR("TextureAtlas", "Image is larger than an atlas page");
+        return std::nullopt;
+    }
+
+    uint32_t page = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    while (page < _pages.size() && !_pages[page].pack(paddedWidth, paddedHeight, x, y)) {
+        ++page;
+    }
+
+    if (page == _pages.size()) {
+        if (_pages.size() >= _config.maxPages) {
+            LOG_WARNING("TextureAtlas", "Atlas is full");
+            return std::nullopt;
+        }
+        _pages.emplace_back(_config.pageSize, _config.pageSize);
+        _pages.back().pack(paddedWidth, paddedHeight, x, y);
+
+        if (_pages.size() > _texture->getDepthOrArrayLayers()) {
+            // Keep the oldest texture with content; an intermediate one was never written
+            if (!_retiredTexture) {
+                _retiredTexture = _texture;
+                _retiredLayers = _texture->getDepthOrArrayLayers();
+            }
+            const uint32_t layers = std::min(_config.maxPages, _texture->getDepthOrArrayLayers() * 2);
+            if (!createTexture(layers)) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    // Copy with the edge texels replicated into the padding
+    const size_t sourcePitch = bytesPerRow ? bytesPerRow : static_cast<size_t>(width) * _texelBytes;
+    const size_t rowBytes = static_cast<size_t>(paddedWidth) * _texelBytes;
+    const uint64_t dataOffset = _pendingData.size();
+    _pendingData.resize(_pendingData.size() + rowBytes * paddedHeight);
+    const auto* src = static_cast<const uint8_t*>(pixels);
+    for (uint32_t row = 0; row < paddedHeight; ++row) {
+        const uint32_t sourceRow = std::min(std::max(row, padding) - padding, height - 1);
+        const uint8_t* srcRow = src + sourceRow * sourcePitch;
+        uint8_t* dstRow = _pendingData.data() + dataOffset + row * rowBytes;
+        for (uint32_t i = 0; i < padding; ++i) {
+            std::memcpy(dstRow + i * _texelBytes, srcRow, _texelBytes);
+            std::memcpy(dstRow + (padding + width + i) * _texelBytes, srcRow + (width - 1) * _texelBytes, _texelBytes);
+        }
+        std::memcpy(dstRow + padding * _texelBytes, srcRow, static_cast<size_t>(width) * _texelBytes);
+    }
+    _pending.push_back({page, x, y, paddedWidth, paddedHeight, dataOffset});
+
+    AtlasRegion region;
+    region.page = page;
+    region.x = x + padding;
+    region.y = y + padding;
+    region.width = width;
+    region.height = height;
+    const float scale = 1.0f / static_cast<float>(_config.pageSize);
+    region.uvRect = {region.x * scale, region.y * scale,
+                     (region.x + width) * scale, (region.y + height) * scale};
+    return region;
+}
+
+bool TextureAtlas::flush(ICommandEncoder& encoder) {
+    PERS_PROFILE_SCOPE("TextureAtlas::flush");
+    auto device = _device.lock();
+    if (!device || !isValid()) {
+        return false;
+    }
+
+    // The previous batch's encoder has been submitted by now
+    if (_staging) {
+        _staging->destroy();
+        _staging.reset();
+    }
+
+    if (!recordGrowth(encoder)) {
+        return false;
+    }
+
+    if (_pending.empty()) {
+        return true;
+    }
+
+    uint64_t stagingSize = 0;
+    for (const PendingUpload& upload : _pending) {
+        stagingSize += static_cast<uint64_t>(getTextureReadbackRowPitch(_config.format, upload.width)) * upload.height;
+    }
+
+    auto staging = std::make_shared<ImmediateStagingBuffer>();
+    if (!staging->create(stagingSize, device->getStagingBufferPool(), _config.label + "Staging")) {
+        LOG_ERROR("TextureAtlas", "Failed to create staging buffer");
+        return false;
+    }
+
+    // Texture copies need 256-byte row pitches; pending rows are tightly packed
+    uint64_t offset = 0;
+    std::vector<TextureUploadDesc> uploads;
+    uploads.reserve(_pending.size());
+    for (const PendingUpload& upload : _pending) {
+        const uint32_t pitch = getTextureReadbackRowPitch(_config.format, upload.width);
+        const size_t rowBytes = static_cast<size_t>(upload.width) * _texelBytes;
+        for (uint32_t row = 0; row < upload.height; ++row) {
+            staging->writeBytes(_pendingData.data() + upload.dataOffset + row * rowBytes, rowBytes,
+                                offset + static_cast<uint64_t>(row) * pitch);
+        }
+
+        TextureUploadDesc desc;
+        desc.originX = upload.x;
+        desc.originY = upload.y;
+        desc.arrayLayer = upload.page;
+        desc.width = upload.width;
+        desc.height = upload.height;
+        desc.bufferOffset = offset;
+        desc.bytesPerRow = pitch;
+        uploads.push_back(desc);
+        offset += static_cast<uint64_t>(pitch) * upload.height;
+    }
+    staging->finalize();
+
+    bool recorded = true;
+    for (const TextureUploadDesc& desc : uploads) {
+        recorded = encoder.uploadToTexture(staging, _texture, desc) && recorded;
+    }
+
+    _staging = std::move(staging);
+    _pending.clear();
+    _pendingData.clear();
+    return recorded;
+}
+
+bool TextureAtlas::flush() {
+    PERS_PROFILE_SCOPE("TextureAtlas::flush");
+    auto device = _device.lock();
+    if (!device || !isValid()) {
+        return false;
+    }
+
+    auto queue = device->getQueue();
+    if (_retiredTexture) {
+        auto encoder = device->createCommandEncoder();
+        if (!encoder || !recordGrowth(*encoder)) {
+            return false;
+        }
+        queue->submit(encoder->finish());
+    }
+
+    bool written = true;
+    for (const PendingUpload& upload : _pending) {
+        TextureWriteDesc desc;
+        desc.texture = _texture;
+        desc.originX = upload.x;
+        desc.originY = upload.y;
+        desc.originZ = upload.page;
+        desc.width = upload.width;
+        desc.height = upload.height;
+        desc.depthOrArrayLayers = 1;
+        desc.data = _pendingData.data() + upload.dataOffset;
+        desc.dataSize = static_cast<uint64_t>(upload.width) * upload.height * _texelBytes;
+        written = queue->writeTexture(desc) && written;
+    }
+
+    _pending.clear();
+    _pendingData.clear();
+    return written;
+}
+
+void TextureAtlas::clear() {
+    for (SkylinePacker& page : _pages) {
+        page.reset();
+    }
+    _pending.clear();
+    _pendingData.clear();
+}
+
+bool TextureAtlas::createTexture(uint32_t layers) {
+    auto device = _device.lock();
+    if (!device) {
+        return false;
+    }
+    const auto& factory = device->getResourceFactory();
+
+    TextureDesc desc;
+    desc.width = _config.pageSize;
+    desc.height = _config.pageSize;
+    desc.depthOrArrayLayers = layers;
+    desc.format = _config.format;
+    desc.usage = TextureUsage::TextureBinding | TextureUsage::CopyDst | TextureUsage::CopySrc;
+    desc.label = _config.label;
+    auto texture = factory->createTexture(desc);
+    if (!texture) {
+        LOG_ERROR("TextureAtlas", "Failed to create atlas texture");
+        return false;
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = _config.format;
+    viewDesc.dimension = TextureViewDimension::D2Array;
+    viewDesc.arrayLayerCount = layers;
+    viewDesc.label = _config.label;
+    auto view = factory->createTextureView(texture, viewDesc);
+    if (!view) {
+        LOG_ERROR("TextureAtlas", "Failed to create atlas view");
+        return false;
+    }
+
+    // Frames in flight may still sample an intermediate texture's view
+    if (_view && device->getDeletionQueue()) {
+        device->getDeletionQueue()->retire(std::move(_view));
+    }
+    _texture = std::move(texture);
+    _view = std::move(view);
+    ++_version;
+    return true;
+}
+
+bool TextureAtlas::recordGrowth(ICommandEncoder& encoder) {
+    if (!_retiredTexture) {
+        return true;
+    }
+
+    for (uint32_t layer = 0; layer < _retiredLayers; ++layer) {
+        TextureCopyDesc copy;
+        copy.srcArrayLayer = layer;
+        copy.dstArrayLayer = layer;
+        if (!encoder.copyTextureToTexture(_retiredTexture, _texture, copy)) {
+            LOG_ERROR("TextureAtlas", "Failed to copy pages into the grown atlas");
+            return false;
+        }
+    }
+
+    auto device = _device.lock();
+    if (device && device->getDeletionQueue()) {
+        device->getDeletionQueue()->retire(std::move(_retiredTexture));
+    }
+    _retiredTexture.reset();
+    _retiredLayers = 0;
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,850 @@
+#include "pers/graphics/TextureCompressor.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+struct CompressParams {
+    uint32_t mipLevel;
+    uint32_t width;           // Of the level, in texels
+    uint32_t height;
+    uint32_t blocksWide;
+    uint32_t blockRowOffset;  // First block row of this band
+    uint32_t blockRows;
+    uint32_t rowWords;        // Scratch row pitch in u32
+    uint32_t encodeSrgb;
+};
+
+constexpr uint32_t WORKGROUP_BLOCKS = 8;  // 8x8 blocks per workgroup
+
+constexpr char COMMON_WGSL[] = R"(
+struct CompressParams {
+    mipLevel: u32,
+    width: u32,
+    height: u32,
+    blocksWide: u32,
+    blockRowOffset: u32,
+    blockRows: u32,
+    rowWords: u32,
+    encodeSrgb: u32,
+};
+
+@group(0) @binding(0) var<uniform> params: CompressParams;
+@group(0) @binding(1) var sourceTexture: texture_2d<f32>;
+@group(0) @binding(2) var<storage, read_write> blocks: array<u32>;
+
+// Texels of the block in row-major order, 0-255 per channel
+var<private> texels: array<vec4<f32>, 16>;
+
+fn encodeSrgb(color: vec3<f32>) -> vec3<f32> {
+    let low = color * 12.92;
+    let high = 1.055 * pow(color, vec3<f32>(1.0 / 2.4)) - 0.055;
+    return select(high, low, color <= vec3<f32>(0.0031308));
+}
+
+fn loadBlock(block: vec2<u32>) {
+    // Blocks past the edge of small levels repeat the last row and column
+    let last = vec2<i32>(i32(params.width) - 1, i32(params.height) - 1);
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        let texel = min(vec2<i32>(block * 4u + vec2<u32>(i % 4u, i / 4u)), last);
+        var color = clamp(textureLoad(sourceTexture, texel, i32(params.mipLevel)), vec4<f32>(0.0), vec4<f32>(1.0));
+        if (params.encodeSrgb != 0u) {
+            color = vec4<f32>(encodeSrgb(color.rgb), color.a);
+        }
+        texels[i] = round(color * 255.0);
+    }
+}
+
+// Or count bits of value into a little-endian 128-bit block at a bit position
+fn setBits(words: vec4<u32>, position: u32, count: u32, value: u32) -> vec4<u32> {
+    var result = words;
+    let index = position / 32u;
+    let shift = position % 32u;
+    result[index] = result[index] | (value << shift);
+    if (shift + count > 32u) {
+        result[index + 1u] = result[index + 1u] | (value >> (32u - shift));
+    }
+    return result;
+}
+
+struct Diagonal {
+    start: vec4<f32>,
+    end: vec4<f32>,
+};
+
+// Diagonal of the block's bounding box the texels follow: channels that fall
+// while the widest channel rises run from high to low
+fn boxDiagonal(low: vec4<f32>, high: vec4<f32>) -> Diagonal {
+    let extent = high - low;
+    var axis = 0u;
+    for (var channel = 1u; channel < 4u; channel = channel + 1u) {
+        if (extent[channel] > extent[axis]) {
+            axis = channel;
+        }
+    }
+    let center = (low + high) * 0.5;
+    var covariance = vec4<f32>(0.0);
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        let d = texels[i] - center;
+        covariance = covariance + d * d[axis];
+    }
+    let falling = covariance < vec4<f32>(0.0);
+    return Diagonal(select(low, high, falling), select(high, low, falling));
+}
+
+@compute @workgroup_size(8, 8)
+fn main(@builtin(global_invocation_id) id: vec3<u32>) {
+    if (id.x >= params.blocksWide || id.y >= params.blockRows) {
+        return;
+    }
+    loadBlock(vec2<u32>(id.x, id.y + params.blockRowOffset));
+    let words = encodeBlock();
+    let base = id.y * params.rowWords + id.x * BLOCK_WORDS;
+    for (var i = 0u; i < BLOCK_WORDS; i = i + 1u) {
+        blocks[base + i] = words[i];
+    }
+}
+)";
+
+using ParamsLayout = GpuStruct<GpuLayout::Std140, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32, GpuU32>;
+static_assert(ParamsLayout::matchesWgsl(COMMON_WGSL, "CompressParams"),
+              "CompressParams no longer match the compression shaders");
+static_assert(ParamsLayout::SIZE == sizeof(CompressParams) &&
+              ParamsLayout::offsetOf<7>() == offsetof(CompressParams, encodeSrgb),
+              "CompressParams must match the WGSL layout");
+
+constexpr char BC_COLOR_WGSL[] = R"(
+fn to565(color: vec3<f32>) -> u32 {
+    let q = vec3<u32>(round(color * vec3<f32>(31.0, 63.0, 31.0) / 255.0));
+    return (q.r << 11u) | (q.g << 5u) | q.b;
+}
+
+fn from565(packed: u32) -> vec3<f32> {
+    let r = (packed >> 11u) & 31u;
+    let g = (packed >> 5u) & 63u;
+    let b = packed & 31u;
+    return vec3<f32>(f32((r << 3u) | (r >> 2u)), f32((g << 2u) | (g >> 4u)), f32((b << 3u) | (b >> 2u)));
+}
+
+// Four-colour BC1 block of the RGB texels, endpoints in x and indices in y
+fn encodeColor() -> vec2<u32> {
+    var low = vec3<f32>(255.0);
+    var high = vec3<f32>(0.0);
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        low = min(low, texels[i].rgb);
+        high = max(high, texels[i].rgb);
+    }
+
+    // Texels rarely sit on the box corners; insetting them lowers the average error
+    let diagonal = boxDiagonal(vec4<f32>(low, 0.0), vec4<f32>(high, 0.0));
+    let inset = (diagonal.end.rgb - diagonal.start.rgb) / 16.0;
+    var color0 = to565(diagonal.end.rgb - inset);
+    var color1 = to565(diagonal.start.rgb + inset);
+    if (color0 == color1) {
+        return vec2<u32>(color0 | (color1 << 16u), 0u);
+    }
+    // color0 > color1 selects the four-colour mode
+    if (color0 < color1) {
+        let swapped = color0;
+        color0 = color1;
+        color1 = swapped;
+    }
+
+    let end0 = from565(color0);
+    let end1 = from565(color1);
+    var palette = array<vec3<f32>, 4>(end0, end1, (2.0 * end0 + end1) / 3.0, (end0 + 2.0 * end1) / 3.0);
+    var indices = 0u;
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        var best = 0u;
+        var bestError = 1e30;
+        for (var k = 0u; k < 4u; k = k + 1u) {
+            let d = palette[k] - texels[i].rgb;
+            let error = dot(d, d);
+            if (error < bestError) {
+                best = k;
+                bestError = error;
+            }
+        }
+        indices = indices | (best << (2u * i));
+    }
+    return vec2<u32>(color0 | (color1 << 16u), indices);
+}
+)";
+
+constexpr char BC1_MAIN[] = R"(
+const BLOCK_WORDS: u32 = 2u;
+
+fn encodeBlock() -> vec4<u32> {
+    return vec4<u32>(encodeColor(), 0u, 0u);
+}
+)";
+
+constexpr char BC3_MAIN[] = R"(
+const BLOCK_WORDS: u32 = 4u;
+
+fn encodeBlock() -> vec4<u32> {
+    var low = 255.0;
+    var high = 0.0;
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        low = min(low, texels[i].a);
+        high = max(high, texels[i].a);
+    }
+
+    // Eight-value mode: indices 0 and 1 are the ends, 2-7 step from alpha0 to alpha1
+    var words = vec4<u32>(u32(high) | (u32(low) << 8u), 0u, encodeColor());
+    if (high > low) {
+        for (var i = 0u; i < 16u; i = i + 1u) {
+            let rank = u32(round((high - texels[i].a) / (high - low) * 7.0));
+            let index = select(select(rank + 1u, 1u, rank == 7u), 0u, rank == 0u);
+            words = setBits(words, 16u + 3u * i, 3u, index);
+        }
+    }
+    return words;
+}
+)";
+
+constexpr char BC7_MAIN[] = R"(
+const BLOCK_WORDS: u32 = 4u;
+
+var<private> weights: array<f32, 16> = array<f32, 16>(
+    0.0, 4.0, 9.0, 13.0, 17.0, 21.0, 26.0, 30.0, 34.0, 38.0, 43.0, 47.0, 51.0, 55.0, 60.0, 64.0);
+
+struct Endpoint {
+    bits: vec4<u32>,  // 7 bits per channel
+    pbit: u32,        // Shared lowest bit
+};
+
+fn quantizeEndpoint(value: vec4<f32>) -> Endpoint {
+    var best = Endpoint(vec4<u32>(0u), 0u);
+    var bestError = 1e30;
+    for (var pbit = 0u; pbit < 2u; pbit = pbit + 1u) {
+        let bits = vec4<u32>(clamp(round((value - f32(pbit)) / 2.0), vec4<f32>(0.0), vec4<f32>(127.0)));
+        let d = vec4<f32>(bits * 2u + pbit) - value;
+        let error = dot(d, d);
+        if (error < bestError) {
+            best = Endpoint(bits, pbit);
+            bestError = error;
+        }
+    }
+    return best;
+}
+
+// Mode 6: one subset, RGBA endpoints with p-bits and 4-bit indices
+fn encodeBlock() -> vec4<u32> {
+    var low = vec4<f32>(255.0);
+    var high = vec4<f32>(0.0);
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        low = min(low, texels[i]);
+        high = max(high, texels[i]);
+    }
+
+    let diagonal = boxDiagonal(low, high);
+    var end0 = quantizeEndpoint(diagonal.start);
+    var end1 = quantizeEndpoint(diagonal.end);
+    let color0 = vec4<f32>(end0.bits * 2u + end0.pbit);
+    let color1 = vec4<f32>(end1.bits * 2u + end1.pbit);
+
+    var indices: array<u32, 16>;
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        var best = 0u;
+        var bestError = 1e30;
+        for (var k = 0u; k < 16u; k = k + 1u) {
+            let color = floor(((64.0 - weights[k]) * color0 + weights[k] * color1 + 32.0) / 64.0);
+            let d = color - texels[i];
+            let error = dot(d, d);
+            if (error < bestError) {
+                best = k;
+                bestError = error;
+            }
+        }
+        indices[i] = best;
+    }
+
+    // The anchor index drops its top bit, so swap the ends when it is set
+    if (indices[0] >= 8u) {
+        let swapped = end0;
+        end0 = end1;
+        end1 = swapped;
+        for (var i = 0u; i < 16u; i = i + 1u) {
+            indices[i] = 15u - indices[i];
+        }
+    }
+
+    var words = vec4<u32>(1u << 6u, 0u, 0u, 0u);
+    for (var channel = 0u; channel < 4u; channel = channel + 1u) {
+        words = setBits(words, 7u + 14u * channel, 7u, end0.bits[channel]);
+        words = setBits(words, 14u + 14u * channel, 7u, end1.bits[channel]);
+    }
+    words = setBits(words, 63u, 1u, end0.pbit);
+    words = setBits(words, 64u, 1u, end1.pbit);
+    words = setBits(words, 65u, 3u, indices[0]);
+    for (var i = 1u; i < 16u; i = i + 1u) {
+        words = setBits(words, 64u + 4u * i, 4u, indices[i]);
+    }
+    return words;
+}
+)";
+
+constexpr char ETC_COLOR_WGSL[] = R"(
+// Intensity modifier pairs (small, large) of the ETC1 codeword tables
+var<private> etcModifiers: array<vec2<f32>, 8> = array<vec2<f32>, 8>(
+    vec2<f32>(2.0, 8.0), vec2<f32>(5.0, 17.0), vec2<f32>(9.0, 29.0), vec2<f32>(13.0, 42.0),
+    vec2<f32>(18.0, 60.0), vec2<f32>(24.0, 80.0), vec2<f32>(33.0, 106.0), vec2<f32>(47.0, 183.0));
+
+// ETC blocks are big-endian 64-bit words
+fn swapBytes(value: u32) -> u32 {
+    return (value >> 24u) | ((value >> 8u) & 0xff00u) | ((value << 8u) & 0xff0000u) | (value << 24u);
+}
+
+// Flip 0 splits the block into 2x4 halves side by side, flip 1 into 4x2 halves stacked
+fn inSubblock(i: u32, flip: u32, subblock: u32) -> bool {
+    return select(i % 4u, i / 4u, flip == 1u) / 2u == subblock;
+}
+
+fn averageSubblock(flip: u32, subblock: u32) -> vec3<f32> {
+    var sum = vec3<f32>(0.0);
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        if (inSubblock(i, flip, subblock)) {
+            sum = sum + texels[i].rgb;
+        }
+    }
+    return sum / 8.0;
+}
+
+struct SubblockFit {
+    table: u32,
+    error: f32,
+    indices: u32,  // Index MSBs in the high half, LSBs in the low half, bit x * 4 + y
+};
+
+fn fitSubblock(base: vec3<f32>, flip: u32, subblock: u32) -> SubblockFit {
+    var fit = SubblockFit(0u, 1e30, 0u);
+    for (var table = 0u; table < 8u; table = table + 1u) {
+        // Index order: +small, +large, -small, -large
+        let modifier = etcModifiers[table];
+        let offsets = vec4<f32>(modifier.x, modifier.y, -modifier.x, -modifier.y);
+        var error = 0.0;
+        var indices = 0u;
+        for (var i = 0u; i < 16u; i = i + 1u) {
+            if (!inSubblock(i, flip, subblock)) {
+                continue;
+            }
+            var best = 0u;
+            var bestError = 1e30;
+            for (var k = 0u; k < 4u; k = k + 1u) {
+                let d = clamp(base + offsets[k], vec3<f32>(0.0), vec3<f32>(255.0)) - texels[i].rgb;
+                let candidate = dot(d, d);
+                if (candidate < bestError) {
+                    best = k;
+                    bestError = candidate;
+                }
+            }
+            let pixel = (i % 4u) * 4u + i / 4u;
+            indices = indices | ((best >> 1u) << (16u + pixel)) | ((best & 1u) << pixel);
+            error = error + bestError;
+        }
+        if (error < fit.error) {
+            fit = SubblockFit(table, error, indices);
+        }
+    }
+    return fit;
+}
+
+// ETC1 individual or differential block, readable by every ETC2 decoder; (high, low) word
+fn encodeEtcColor() -> vec2<u32> {
+    var bestError = 1e30;
+    var result = vec2<u32>(0u);
+    for (var flip = 0u; flip < 2u; flip = flip + 1u) {
+        let average0 = averageSubblock(flip, 0u);
+        let average1 = averageSubblock(flip, 1u);
+
+        // Differential mode keeps 5-bit bases while they lie within [-4, 3] of each
+        // other; both stay in range, so the block never decodes as T, H or planar
+        let q0 = vec3<i32>(round(average0 * 31.0 / 255.0));
+        let q1 = vec3<i32>(round(average1 * 31.0 / 255.0));
+        let delta = q1 - q0;
+        var base0: vec3<f32>;
+        var base1: vec3<f32>;
+        var header: u32;
+        if (all(delta >= vec3<i32>(-4)) && all(delta <= vec3<i32>(3))) {
+            let u0 = vec3<u32>(q0);
+            let u1 = vec3<u32>(q1);
+            let d = vec3<u32>(delta) & vec3<u32>(7u);
+            base0 = vec3<f32>((u0 << vec3<u32>(3u)) | (u0 >> vec3<u32>(2u)));
+            base1 = vec3<f32>((u1 << vec3<u32>(3u)) | (u1 >> vec3<u32>(2u)));
+            header = (u0.r << 27u) | (d.r << 24u) | (u0.g << 19u) | (d.g << 16u) | (u0.b << 11u) | (d.b << 8u) | 2u;
+        } else {
+            let u0 = vec3<u32>(round(average0 * 15.0 / 255.0));
+            let u1 = vec3<u32>(round(average1 * 15.0 / 255.0));
+            base0 = vec3<f32>(u0 * 17u);
+            base1 = vec3<f32>(u1 * 17u);
+            header = (u0.r << 28u) | (u1.r << 24u) | (u0.g << 20u) | (u1.g << 16u) | (u0.b << 12u) | (u1.b << 8u);
+        }
+
+        let fit0 = fitSubblock(base0, flip, 0u);
+        let fit1 = fitSubblock(base1, flip, 1u);
+        if (fit0.error + fit1.error < bestError) {
+            bestError = fit0.error + fit1.error;
+            result = vec2<u32>(header | (fit0.table << 5u) | (fit1.table << 2u) | flip, fit0.indices | fit1.indices);
+        }
+    }
+    return result;
+}
+)";
+
+constexpr char ETC2_RGB_MAIN[] = R"(
+const BLOCK_WORDS: u32 = 2u;
+
+fn encodeBlock() -> vec4<u32> {
+    let color = encodeEtcColor();
+    return vec4<u32>(swapBytes(color.x), swapBytes(color.y), 0u, 0u);
+}
+)";
+
+constexpr char ETC2_RGBA_MAIN[] = R"(
+const BLOCK_WORDS: u32 = 4u;
+
+// EAC modifier tables, negative then positive half of each row
+var<private> eacModifiers: array<vec4<f32>, 32> = array<vec4<f32>, 32>(
+    vec4<f32>(-3.0, -6.0, -9.0, -15.0), vec4<f32>(2.0, 5.0, 8.0, 14.0),
+    vec4<f32>(-3.0, -7.0, -10.0, -13.0), vec4<f32>(2.0, 6.0, 9.0, 12.0),
+    vec4<f32>(-2.0, -5.0, -8.0, -13.0), vec4<f32>(1.0, 4.0, 7.0, 12.0),
+    vec4<f32>(-2.0, -4.0, -6.0, -13.0), vec4<f32>(1.0, 3.0, 5.0, 12.0),
+    vec4<f32>(-3.0, -6.0, -8.0, -12.0), vec4<f32>(2.0, 5.0, 7.0, 11.0),
+    vec4<f32>(-3.0, -7.0, -9.0, -11.0), vec4<f32>(2.0, 6.0, 8.0, 10.0),
+    vec4<f32>(-4.0, -7.0, -8.0, -11.0), vec4<f32>(3.0, 6.0, 7.0, 10.0),
+    vec4<f32>(-3.0, -5.0, -8.0, -11.0), vec4<f32>(2.0, 4.0, 7.0, 10.0),
+    vec4<f32>(-2.0, -6.0, -8.0, -10.0), vec4<f32>(1.0, 5.0, 7.0, 9.0),
+    vec4<f32>(-2.0, -5.0, -8.0, -10.0), vec4<f32>(1.0, 4.0, 7.0, 9.0),
+    vec4<f32>(-2.0, -4.0, -8.0, -10.0), vec4<f32>(1.0, 3.0, 7.0, 9.0),
+    vec4<f32>(-2.0, -5.0, -7.0, -10.0), vec4<f32>(1.0, 4.0, 6.0, 9.0),
+    vec4<f32>(-3.0, -4.0, -7.0, -10.0), vec4<f32>(2.0, 3.0, 6.0, 9.0),
+    vec4<f32>(-1.0, -2.0, -3.0, -10.0), vec4<f32>(0.0, 1.0, 2.0, 9.0),
+    vec4<f32>(-4.0, -6.0, -8.0, -9.0), vec4<f32>(3.0, 5.0, 7.0, 8.0),
+    vec4<f32>(-3.0, -5.0, -7.0, -9.0), vec4<f32>(2.0, 4.0, 6.0, 8.0));
+
+fn encodeBlock() -> vec4<u32> {
+    var low = 255.0;
+    var high = 0.0;
+    for (var i = 0u; i < 16u; i = i + 1u) {
+        low = min(low, texels[i].a);
+        high = max(high, texels[i].a);
+    }
+
+    var bestError = 1e30;
+    var alpha = vec2<u32>(0u);  // (low, high) word of the 64-bit block
+    for (var table = 0u; table < 16u; table = table + 1u) {
+        // Stretch the row's extremes over the block's range, centred on it
+        let negative = eacModifiers[2u * table];
+        let positive = eacModifiers[2u * table + 1u];
+        let multiplier = clamp(round((high - low) / (positive.w - negative.w)), 1.0, 15.0);
+        let base = clamp(round((high + low - (positive.w + negative.w) * multiplier) * 0.5), 0.0, 255.0);
+
+        var error = 0.0;
+        var bits = vec4<u32>(0u);
+        for (var i = 0u; i < 16u; i = i + 1u) {
+            var best = 0u;
+            var bestDifference = 1e30;
+            for (var k = 0u; k < 8u; k = k + 1u) {
+                let modifier = select(positive, negative, k < 4u)[k % 4u];
+                let difference = abs(clamp(base + modifier * multiplier, 0.0, 255.0) - texels[i].a);
+                if (difference < bestDifference) {
+                    best = k;
+                    bestDifference = difference;
+                }
+            }
+            let pixel = (i % 4u) * 4u + i / 4u;
+            bits = setBits(bits, 45u - 3u * pixel, 3u, best);
+            error = error + bestDifference * bestDifference;
+        }
+        if (error < bestError) {
+            bestError = error;
+            alpha = vec2<u32>(bits.x, bits.y | (u32(base) << 24u) | (u32(multiplier) << 20u) | (table << 16u));
+        }
+    }
+
+    let color = encodeEtcColor();
+    return vec4<u32>(swapBytes(alpha.y), swapBytes(alpha.x), swapBytes(color.x), swapBytes(color.y));
+}
+)";
+
+struct EncoderSource {
+    const char* name;
+    const char* shared;
+    const char* main;
+};
+
+constexpr EncoderSource ENCODERS[] = {
+    {"TextureCompressor::BC1", BC_COLOR_WGSL, BC1_MAIN},
+    {"TextureCompressor::BC3", BC_COLOR_WGSL, BC3_MAIN},
+    {"TextureCompressor::BC7", "", BC7_MAIN},
+    {"TextureCompressor::ETC2RGB", ETC_COLOR_WGSL, ETC2_RGB_MAIN},
+    {"TextureCompressor::ETC2RGBA", ETC_COLOR_WGSL, ETC2_RGBA_MAIN},
+};
+
+bool isSrgbFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::BC1RGBAUnormSrgb:
+        case TextureFormat::BC3RGBAUnormSrgb:
+        case TextureFormat::BC7RGBAUnormSrgb:
+        case TextureFormat::ETC2RGB8UnormSrgb:
+        case TextureFormat::ETC2RGBA8UnormSrgb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // anonymous namespace
+
+TextureCompressor::TextureCompressor(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("TextureCompressor", "Device or resource factory is null");
+        return;
+    }
+
+    _parameters = std::make_unique<DynamicBuffer>();
+    if (!_parameters->create(config.parameterBufferSize, BufferUsage::Uniform, device, config.frameCount,
+                             "TextureCompressor::Parameters")) {
+        LOG_ERROR("TextureCompressor", "Failed to create parameter buffer");
+        return;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "TextureCompressor";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer,
+         .hasDynamicOffset = true, .minBindingSize = sizeof(CompressParams)},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::SampledTexture},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+    if (!_layout) {
+        LOG_ERROR("TextureCompressor", "Failed to create bind group layout");
+        return;
+    }
+
+    // A limit of 0 is unspecified and does not constrain
+    uint64_t scratchSize = std::max<uint64_t>(config.scratchSize, TEXTURE_READBACK_ROW_ALIGNMENT);
+    const DeviceLimits limits = device->getLimits();
+    if (limits.maxStorageBufferBindingSize > 0 && scratchSize > limits.maxStorageBufferBindingSize) {
+        LOG_WARNING("TextureCompressor", "Config::scratchSize exceeds the storage binding limit and was lowered");
+        scratchSize = limits.maxStorageBufferBindingSize;
+    }
+
+    // Created last, isValid() means compression can be recorded
+    auto blocks = std::make_shared<DeviceBuffer>();
+    if (!blocks->create(scratchSize, DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc, device,
+                        "TextureCompressor::Blocks")) {
+        LOG_ERROR("TextureCompressor", "Failed to create block scratch buffer");
+        return;
+    }
+    _blocks = std::move(blocks);
+}
+
+TextureCompressor::~TextureCompressor() = default;
+
+bool TextureCompressor::supportsFormat(TextureFormat format) {
+    switch (format) {
+        case TextureFormat::BC1RGBAUnorm:
+        case TextureFormat::BC1RGBAUnormSrgb:
+        case TextureFormat::BC3RGBAUnorm:
+        case TextureFormat::BC3RGBAUnormSrgb:
+        case TextureFormat::BC7RGBAUnorm:
+        case TextureFormat::BC7RGBAUnormSrgb:
+        case TextureFormat::ETC2RGB8Unorm:
+        case TextureFormat::ETC2RGB8UnormSrgb:
+        case TextureFormat::ETC2RGBA8Unorm:
+        case TextureFormat::ETC2RGBA8UnormSrgb:
+            return true;
+        default:
+            return false;
+    }
+}
+
+TextureFormat TextureCompressor::selectFormat(bool alpha, bool srgb) const {
+    auto device = _device.lock();
+    if (!device) {
+        return TextureFormat::Undefined;
+    }
+    if (device->hasFeature(DeviceFeature::TextureCompressionBC)) {
+        if (alpha) {
+            return srgb ? TextureFormat::BC7RGBAUnormSrgb : TextureFormat::BC7RGBAUnorm;
+        }
+        return srgb ? TextureFormat::BC1RGBAUnormSrgb : TextureFormat::BC1RGBAUnorm;
+    }
+    if (device->hasFeature(DeviceFeature::TextureCompressionETC2)) {
+        if (alpha) {
+            return srgb ? TextureFormat::ETC2RGBA8UnormSrgb : TextureFormat::ETC2RGBA8Unorm;
+        }
+        return srgb ? TextureFormat::ETC2RGB8UnormSrgb : TextureFormat::ETC2RGB8Unorm;
+    }
+    return TextureFormat::Undefined;
+}
+
+std::shared_ptr<ITexture> TextureCompressor::compress(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& source,
+                                                      TextureFormat format, TextureUsage usage) {
+    PERS_PROFILE_SCOPE("TextureCompressor::compress");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !isValid()) {
+        LOG_ERROR("TextureCompressor", "Cannot compress with invalid compressor");
+        return nullptr;
+    }
+    if (!source) {
+        LOG_ERROR("TextureCompressor", "Source texture is null");
+        return nullptr;
+    }
+    if (!supportsFormat(format)) {
+        LOG_ERROR("TextureCompressor", "No encoder for the target format");
+        return nullptr;
+    }
+
+    const DeviceFeature feature = getTextureCompressionFamily(format) == TextureCompressionFamily::BC
+                                      ? DeviceFeature::TextureCompressionBC
+                                      : DeviceFeature::TextureCompressionETC2;
+    if (!device->hasFeature(feature)) {
+        LOG_ERROR("TextureCompressor", "Device did not enable the target format's compression feature");
+        return nullptr;
+    }
+
+    // Compressed textures are created in whole blocks; smaller mips are padded by the copy
+    if (source->getWidth() % BLOCK_SIZE != 0 || source->getHeight() % BLOCK_SIZE != 0) {
+        LOG_ERROR("TextureCompressor", "Source size must be a multiple of 4 texels");
+        return nullptr;
+    }
+
+    TextureDesc desc;
+    desc.width = source->getWidth();
+    desc.height = source->getHeight();
+    desc.mipLevelCount = source->getMipLevelCount();
+    desc.format = format;
+    desc.usage = usage | TextureUsage::CopyDst;
+    desc.label = "TextureCompressor";
+    auto target = factory->createTexture(desc);
+    if (!target) {
+        LOG_ERROR("TextureCompressor", "Failed to create compressed texture");
+        return nullptr;
+    }
+
+    for (uint32_t mip = 0; mip < desc.mipLevelCount; ++mip) {
+        if (!compressLevel(encoder, source, mip, target, mip)) {
+            return nullptr;
+        }
+    }
+    return target;
+}
+
+bool TextureCompressor::compressLevel(ICommandEncoder& encoder, const std::shared_ptr<ITexture>& source,
+                                      uint32_t sourceMip, const std::shared_ptr<ITexture>& target, uint32_t targetMip) {
+    PERS_PROFILE_SCOPE("TextureCompressor::compressLevel");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !isValid()) {
+        LOG_ERROR("TextureCompressor", "Cannot compress with invalid compressor");
+        return false;
+    }
+    if (!source || !target) {
+        LOG_ERROR("TextureCompressor", "Source or target texture is null");
+        return false;
+    }
+
+    const TextureFormat format = target->getFormat();
+    Encoder kind = EncoderCount;
+    switch (format) {
+        case TextureFormat::BC1RGBAUnorm:
+        case TextureFormat::BC1RGBAUnormSrgb: kind = Bc1; break;
+        case TextureFormat::BC3RGBAUnorm:
+        case TextureFormat::BC3RGBAUnormSrgb: kind = Bc3; break;
+        case TextureFormat::BC7RGBAUnorm:
+        case TextureFormat::BC7RGBAUnormSrgb: kind = Bc7; break;
+        case TextureFormat::ETC2RGB8Unorm:
+        case TextureFormat::ETC2RGB8UnormSrgb: kind = Etc2Rgb; break;
+        case TextureFormat::ETC2RGBA8Unorm:
+        case TextureFormat::ETC2RGBA8UnormSrgb: kind = Etc2Rgba; break;
+        default:
+            LOG_ERROR("TextureCompressor", "No encoder for the target format");
+            return false;
+    }
+
+    if (source->getDimension() != TextureDimension::D2 || source->getSampleCount() != 1 ||
+        isCompressedFormat(source->getFormat())) {
+        LOG_ERROR("TextureCompressor", "Source must be an uncompressed single-sampled 2D texture");
+        return false;
+    }
+    if ((source->getUsage() & TextureUsage::TextureBinding) == TextureUsage::None) {
+        LOG_ERROR("TextureCompressor", "Source texture needs TextureBinding usage");
+        return false;
+    }
+    if (sourceMip >= source->getMipLevelCount() || targetMip >= target->getMipLevelCount()) {
+        LOG_ERROR("TextureCompressor", "Mip level out of range");
+        return false;
+    }
+
+    const uint32_t width = std::max(1u, source->getWidth() >> sourceMip);
+    const uint32_t height = std::max(1u, source->getHeight() >> sourceMip);
+    if (width != std::max(1u, target->getWidth() >> targetMip) ||
+        height != std::max(1u, target->getHeight() >> targetMip)) {
+        LOG_ERROR("TextureCompressor", "Source and target levels differ in size");
+        return false;
+    }
+
+    const uint32_t rowPitch = getTextureReadbackRowPitch(format, width);
+    const uint32_t blocksWide = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const uint32_t blocksHigh = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const uint32_t bandRows = static_cast<uint32_t>(std::min<uint64_t>(blocksHigh, _blocks->getSize() / rowPitch));
+    if (bandRows == 0) {
+        LOG_ERROR("TextureCompressor", "A block row of the level exceeds Config::scratchSize");
+        return false;
+    }
+
+    auto pipeline = getPipeline(kind);
+    if (!pipeline) {
+        return false;
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.mipLevelCount = source->getMipLevelCount();
+    viewDesc.label = "TextureCompressor::Source";
+    auto sourceView = factory->createTextureView(source, viewDesc);
+    if (!sourceView) {
+        LOG_ERROR("TextureCompressor", "Failed to create source view");
+        return false;
+    }
+
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _layout;
+    bindGroupDesc.debugName = "TextureCompressor";
+    bindGroupDesc.entries.resize(3);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = _parameters->getCurrentFrameBuffer();
+    bindGroupDesc.entries[0].size = sizeof(CompressParams);
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].textureView = sourceView;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].buffer = _blocks;
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("TextureCompressor", "Failed to create bind group");
+        return false;
+    }
+
+    // Each band is encoded into the scratch buffer, then copied out before the next reuses it
+    for (uint32_t firstRow = 0; firstRow < blocksHigh; firstRow += bandRows) {
+        const uint32_t rows = std::min(bandRows, blocksHigh - firstRow);
+
+        CompressParams params = {};
+        params.mipLevel = sourceMip;
+        params.width = width;
+        params.height = height;
+        params.blocksWide = blocksWide;
+        params.blockRowOffset = firstRow;
+        params.blockRows = rows;
+        params.rowWords = rowPitch / sizeof(uint32_t);
+        params.encodeSrgb = isSrgbFormat(source->getFormat()) ? 1 : 0;
+        const uint64_t parameterOffset = _parameters->write(params);
+        if (parameterOffset == BufferCopyDesc::WHOLE_SIZE) {
+            LOG_ERROR("TextureCompressor", "Parameter buffer is full, compression dropped");
+            return false;
+        }
+
+        ComputePassDesc passDesc;
+        passDesc.label = "TextureCompressor";
+        auto pass = encoder.beginComputePass(passDesc);
+        if (!pass) {
+            LOG_ERROR("TextureCompressor", "Failed to begin compression pass");
+            return false;
+        }
+        const uint32_t dynamicOffset = static_cast<uint32_t>(parameterOffset);
+        pass->setPipeline(pipeline);
+        pass->setBindGroup(0, bindGroup, {&dynamicOffset, 1});
+        pass->dispatch((blocksWide + WORKGROUP_BLOCKS - 1) / WORKGROUP_BLOCKS,
+                       (rows + WORKGROUP_BLOCKS - 1) / WORKGROUP_BLOCKS);
+        pass->end();
+
+        TextureUploadDesc upload;
+        upload.mipLevel = targetMip;
+        upload.originY = firstRow * BLOCK_SIZE;
+        upload.width = width;
+        upload.height = std::min(rows * BLOCK_SIZE, height - upload.originY);
+        upload.bytesPerRow = rowPitch;
+        if (!encoder.copyBufferToTexture(_blocks, target, upload)) {
+            LOG_ERROR("TextureCompressor", "Failed to copy compressed blocks");
+            return false;
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<IComputePipeline> TextureCompressor::getPipeline(Encoder encoder) {
+    if (_pipelines[encoder]) {
+        return _pipelines[encoder];
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    const EncoderSource& source = ENCODERS[encoder];
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = std::string(COMMON_WGSL) + source.shared + source.main;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.entryPoint = "main";
+    shaderDesc.debugName = source.name;
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("TextureCompressor", "Failed to create compression shader");
+        return nullptr;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_layout};
+    pipelineLayoutDesc.debugName = source.name;
+
+    ComputePipelineDesc desc;
+    desc.compute = shader;
+    desc.layout = factory->createPipelineLayout(pipelineLayoutDesc);
+    desc.debugName = source.name;
+    _pipelines[encoder] = desc.layout ? factory->createComputePipeline(desc) : nullptr;
+    if (!_pipelines[encoder]) {
+        LOG_ERROR("TextureCompressor", "Failed to create compression pipeline");
+    }
+    return _pipelines[encoder];
+}
+
+bool TextureCompressor::flush() {
+    return _parameters && _parameters->flush();
+}
+
+void TextureCompressor::nextFrame() {
+    if (_parameters) {
+        _parameters->nextFrame();
+    }
+}
+
+} // namespace pers
@@ -0,0 +1,126 @@
+#include "pers/graphics/TextureFormatSelector.h"
+
+namespace pers {
+
+TextureFormatSelector::TextureFormatSelector(const PhysicalDeviceCapabilities& capabilities)
+    : _bc(capabilities.supportsTextureCompressionBC)
+    , _etc2(capabilities.supportsTextureCompressionETC2)
+    , _astc(capabilities.supportsTextureCompressionASTC) {
+}
+
+TextureFormat TextureFormatSelector::select(TextureContent content, bool srgb) const {
+    TextureFormat format = selectCompressed(content, srgb);
+    return format != TextureFormat::Undefined ? format : getUncompressedFormat(content, srgb);
+}
+
+TextureFormat TextureFormatSelector::selectCompressed(TextureContent content, bool srgb) const {
+    static constexpr TextureCompressionFamily ORDER[] = {
+        TextureCompressionFamily::BC,
+        TextureCompressionFamily::ASTC,
+        TextureCompressionFamily::ETC2
+    };
+
+    for (TextureCompressionFamily family : ORDER) {
+        if (!isFamilySupported(family)) {
+            continue;
+        }
+        TextureFormat format = getCompressedFormat(family, content, srgb);
+        if (format != TextureFormat::Undefined) {
+            return format;
+        }
+    }
+    return TextureFormat::Undefined;
+}
+
+bool TextureFormatSelector::isSupported(TextureFormat format) const {
+    return isFamilySupported(getTextureCompressionFamily(format));
+}
+
+bool TextureFormatSelector::isFamilySupported(TextureCompressionFamily family) const {
+    switch (family) {
+        case TextureCompressionFamily::None: return true;
+        case TextureCompressionFamily::BC: return _bc;
+        case TextureCompressionFamily::ETC2: return _etc2;
+        case TextureCompressionFamily::ASTC: return _astc;
+    }
+    return false;
+}
+
+std::vector<DeviceFeature> TextureFormatSelector::getCompressionFeatures() const {
+    std::vector<DeviceFeature> features;
+    if (_bc) {
+        features.push_back(DeviceFeature::TextureCompressionBC);
+    }
+    if (_etc2) {
+        features.push_back(DeviceFeature::TextureCompressionETC2);
+    }
+    if (_astc) {
+        features.push_back(DeviceFeature::TextureCompressionASTC);
+    }
+    return features;
+}
+
+TextureFormat TextureFormatSelector::getUncompressedFormat(TextureContent content, bool srgb) {
+    switch (content) {
+        case TextureContent::Color:
+        case TextureContent::ColorAlpha:
+            return srgb ? TextureFormat::RGBA8UnormSrgb : TextureFormat::RGBA8Unorm;
+        case TextureContent::NormalMap:
+            return TextureFormat::RG8Unorm;
+        case TextureContent::SingleChannel:
+            return TextureFormat::R8Unorm;
+        case TextureContent::HDR:
+            return TextureFormat::RGBA16Float;
+    }
+    return TextureFormat::RGBA8Unorm;
+}
+
+TextureFormat TextureFormatSelector::getCompressedFormat(TextureCompressionFamily family, TextureContent content, bool srgb) {
+    switch (family) {
+        case TextureCompressionFamily::BC:
+            switch (content) {
+                case TextureContent::Color:
+                    return srgb ? TextureFormat::BC1RGBAUnormSrgb : TextureFormat::BC1RGBAUnorm;
+                case TextureContent::ColorAlpha:
+                    return srgb ? TextureFormat::BC7RGBAUnormSrgb : TextureFormat::BC7RGBAUnorm;
+                case TextureContent::NormalMap:
+                    return TextureFormat::BC5RGUnorm;
+                case TextureContent::SingleChannel:
+                    return TextureFormat::BC4RUnorm;
+                case TextureContent::HDR:
+                    return TextureFormat::BC6HRGBUfloat;
+            }
+            break;
+
+        case TextureCompressionFamily::ETC2:
+            switch (content) {
+                case TextureContent::Color:
+                    return srgb ? TextureFormat::ETC2RGB8UnormSrgb : TextureFormat::ETC2RGB8Unorm;
+                case TextureContent::ColorAlpha:
+                    return srgb ? TextureFormat::ETC2RGBA8UnormSrgb : TextureFormat::ETC2RGBA8Unorm;
+                case TextureContent::NormalMap:
+                    return TextureFormat::EACRG11Unorm;
+                case TextureContent::SingleChannel:
+                    return TextureFormat::EACR11Unorm;
+                case TextureContent::HDR:
+                    return TextureFormat::Undefined;
+            }
+            break;
+
+        case TextureCompressionFamily::ASTC:
+            // WebGPU exposes the LDR profile only, HDR stays uncompressed
+            if (content == TextureContent::HDR) {
+                return TextureFormat::Undefined;
+            }
+            if (content == TextureContent::Color || content == TextureContent::ColorAlpha) {
+                return srgb ? TextureFormat::ASTC4x4UnormSrgb : TextureFormat::ASTC4x4Unorm;
+            }
+            return TextureFormat::ASTC4x4Unorm;
+
+        case TextureCompressionFamily::None:
+            break;
+    }
+    return TextureFormat::Undefined;
+}
+
+} // namespace pers
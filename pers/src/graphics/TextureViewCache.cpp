@@ -0,0 +1,62 @@
+#include "pers/graphics/TextureViewCache.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+bool TextureViewCache::isEquivalent(const TextureViewDesc& a, const TextureViewDesc& b) {
+    return a.format == b.format &&
+           a.dimension == b.dimension &&
+           a.baseMipLevel == b.baseMipLevel &&
+           a.mipLevelCount == b.mipLevelCount &&
+           a.baseArrayLayer == b.baseArrayLayer &&
+           a.arrayLayerCount == b.arrayLayerCount &&
+           a.aspect == b.aspect;
+}
+
+std::shared_ptr<ITextureView> TextureViewCache::find(const TextureViewDesc& desc) const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (const Entry& entry : _entries) {
+        if (isEquivalent(entry.desc, desc)) {
+            return entry.view;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<ITextureView> TextureViewCache::getOrCreate(const TextureViewDesc& desc, const CreateFunction& create) {
+    if (auto existing = find(desc)) {
+        return existing;
+    }
+
+    if (!create) {
+        LOG_ERROR("TextureViewCache", "Texture view create function is null");
+        return nullptr;
+    }
+
+    auto view = create(desc);
+    if (!view) {
+        return nullptr;
+    }
+
+    // Another thread may have created the same desc meanwhile, keep the first one
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (const Entry& entry : _entries) {
+        if (isEquivalent(entry.desc, desc)) {
+            return entry.view;
+        }
+    }
+    _entries.push_back(Entry{desc, view});
+    return view;
+}
+
+void TextureViewCache::clear() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _entries.clear();
+}
+
+size_t TextureViewCache::size() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _entries.size();
+}
+
+} // namespace pers
@@ -0,0 +1,608 @@
+#include "pers/graphics/TiledRender.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/OffscreenRenderQueue.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace pers {
+
+namespace {
+
+// Every message is a header and size bytes of payload, in host byte order
+// (all targets are little-endian)
+constexpr uint32_t MESSAGE_MAGIC = 0x4E525450;  // "PTRN"
+constexpr uint32_t PROTOCOL_VERSION = 1;
+constexpr uint32_t TILE_FLUSH = 1u << 0;         // No further tile until the results are back
+constexpr size_t SCENE_CHUNK_SIZE = 1u << 20;
+
+enum class MessageType : uint32_t {
+    Hello,       // Node -> coordinator: HelloMessage
+    Job,         // Coordinator -> node: JobMessage, then the scene bytes
+    Tile,        // Coordinator -> node: TileMessage
+    TileResult,  // Node -> coordinator: tile index, then tightly packed pixels
+    Done         // Coordinator -> node: no more tiles
+};
+
+struct MessageHeader {
+    uint32_t magic = MESSAGE_MAGIC;
+    MessageType type = MessageType::Hello;
+    uint64_t size = 0;
+};
+
+struct HelloMessage {
+    uint32_t version = PROTOCOL_VERSION;
+    uint32_t reserved = 0;
+};
+
+struct JobMessage {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t tileWidth = 0;
+    uint32_t tileHeight = 0;
+    uint32_t format = 0;
+    uint32_t tilesInFlight = 0;
+};
+
+struct TileMessage {
+    uint32_t index = 0;
+    uint32_t flags = 0;
+};
+
+static_assert(sizeof(MessageHeader) == 16 && sizeof(JobMessage) == 24 && sizeof(TileMessage) == 8);
+
+bool sendMessage(TcpSocket& socket, MessageType type, const void* payload, size_t size, uint64_t extraSize = 0) {
+    MessageHeader header;
+    header.type = type;
+    header.size = size + extraSize;
+    return socket.sendAll(&header, sizeof(header)) && (size == 0 || socket.sendAll(payload, size));
+}
+
+bool receiveHeader(TcpSocket& socket, MessageHeader& header) {
+    return socket.receiveAll(&header, sizeof(header)) && header.magic == MESSAGE_MAGIC;
+}
+
+uint32_t getBytesPerPixel(TextureFormat format) {
+    const TextureFormatBlockInfo info = getTextureFormatBlockInfo(format);
+    return info.blockWidth == 1 && info.blockHeight == 1 ? info.blockBytes : 0;
+}
+
+void setError(std::string* error, const std::string& message) {
+    LOG_ERROR("TiledRender", message);
+    if (error) {
+        *error = message;
+    }
+}
+
+} // anonymous namespace
+
+// TileGrid
+
+TileGrid::TileGrid(uint32_t width, uint32_t height, uint32_t tileWidth, uint32_t tileHeight)
+    : _width(width)
+    , _height(height)
+    , _tileWidth(std::max(1u, tileWidth))
+    , _tileHeight(std::max(1u, tileHeight)) {
+    _columns = (_width + _tileWidth - 1) / _tileWidth;
+    _rows = (_height + _tileHeight - 1) / _tileHeight;
+}
+
+TileRect TileGrid::getTile(uint32_t index) const {
+    TileRect tile;
+    if (index >= getTileCount()) {
+        return tile;
+    }
+    tile.index = index;
+    tile.x = (index % _columns) * _tileWidth;
+    tile.y = (index / _columns) * _tileHeight;
+    tile.width = std::min(_tileWidth, _width - tile.x);
+    tile.height = std::min(_tileHeight, _height - tile.y);
+    return tile;
+}
+
+glm::mat4 TileGrid::getTileProjection(const TileRect& tile) const {
+    glm::mat4 result(1.0f);
+    if (tile.width == 0 || tile.height == 0) {
+        return result;
+    }
+
+    // The tile covers [x0, x1] x [y1, y0] of the image's NDC (y up, rows
+    // down); scale and shift that range onto [-1, 1]. Applied in clip
+    // space, so the offset is scaled by w.
+    const float width = static_cast<float>(_width);
+    const float height = static_cast<float>(_height);
+    const float x0 = -1.0f + 2.0f * static_cast<float>(tile.x) / width;
+    const float x1 = -1.0f + 2.0f * static_cast<float>(tile.x + tile.width) / width;
+    const float y0 = 1.0f - 2.0f * static_cast<float>(tile.y) / height;
+    const float y1 = 1.0f - 2.0f * static_cast<float>(tile.y + tile.height) / height;
+
+    result[0][0] = 2.0f / (x1 - x0);
+    result[1][1] = 2.0f / (y0 - y1);
+    result[3][0] = -(x0 + x1) / (x1 - x0);
+    result[3][1] = -(y0 + y1) / (y0 - y1);
+    return result;
+}
+
+// TiledRenderCoordinator
+
+TiledRenderCoordinator::TiledRenderCoordinator(const Desc& desc)
+    : _desc(desc)
+    , _grid(desc.width, desc.height, desc.tileWidth, desc.tileHeight)
+    , _bytesPerPixel(getBytesPerPixel(desc.format)) {
+    _desc.tilesInFlight = std::max(1u, _desc.tilesInFlight);
+}
+
+TiledRenderCoordinator::~TiledRenderCoordinator() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        _rendering = false;
+    }
+    _cv.notify_all();
+
+    if (_acceptThread.joinable()) {
+        // Shutting down a listener does not wake accept() everywhere; a
+        // connection of our own does
+        TcpSocket wake = TcpSocket::connect(_desc.address.empty() ? "127.0.0.1" : _desc.address, getPort());
+        if (!wake.isValid()) {
+            _listener.shutdown();
+        }
+        _acceptThread.join();
+    }
+    stopNodes();
+}
+
+bool TiledRenderCoordinator::listen() {
+    if (_listener.isValid()) {
+        return true;
+    }
+    _listener = TcpSocket::listen(_desc.port, _desc.address);
+    if (!_listener.isValid()) {
+        return false;
+    }
+    _acceptThread = std::thread([this] { acceptLoop(); });
+    LOG_INFO_FMT("TiledRenderCoordinator", "Waiting for render nodes on port {}", getPort());
+    return true;
+}
+
+bool TiledRenderCoordinator::render(std::span<const uint8_t> scene, std::vector<uint8_t>& image,
+                                    std::chrono::milliseconds timeout, std::string* error) {
+    if (_grid.getTileCount() == 0 || _bytesPerPixel == 0) {
+        setError(error, "Render needs a non-empty image in an uncompressed format");
+        return false;
+    }
+    if (!listen()) {
+        setError(error, "Cannot open the coordinator port");
+        return false;
+    }
+
+    image.assign(static_cast<size_t>(_desc.width) * _desc.height * _bytesPerPixel, 0);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _scene = scene;
+    _image = &image;
+    _queue.clear();
+    for (uint32_t i = 0; i < _grid.getTileCount(); ++i) {
+        _queue.push_back(i);
+    }
+    _tileDone.assign(_grid.getTileCount(), 0);
+    _remaining = _grid.getTileCount();
+    _cancelled = false;
+    _rendering = true;
+    _cv.notify_all();
+
+    const auto start = std::chrono::steady_clock::now();
+    _cv.wait_for(lock, timeout, [this] { return _remaining == 0 || _cancelled || _stopping; });
+    const bool complete = _remaining == 0;
+
+    // Nodes still working are cut off; they return their tiles and exit
+    _rendering = false;
+    if (!complete) {
+        for (auto& connection : _connections) {
+            if (!connection->finished) {
+                connection->socket.shutdown();
+            }
+        }
+    }
+    _cv.notify_all();
+    _cv.wait(lock, [this] { return _activeNodes == 0; });
+
+    // Join the nodes of this render; nodes waiting for the next one stay
+    std::vector<std::unique_ptr<Connection>> finished;
+    auto split = std::stable_partition(_connections.begin(), _connections.end(),
+        [](const auto& connection) { return !connection->finished; });
+    std::move(split, _connections.end(), std::back_inserter(finished));
+    _connections.erase(split, _connections.end());
+    _image = nullptr;
+    _scene = {};
+    const uint32_t remaining = _remaining;
+    const bool cancelled = _cancelled;
+    lock.unlock();
+
+    for (auto& connection : finished) {
+        connection->thread.join();
+    }
+
+    if (!complete) {
+        setError(error, cancelled ? "Render cancelled" :
+            "Render timed out with " + std::to_string(remaining) + " tiles missing");
+        return false;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    Stats stats = getStats();
+    LOG_INFO_FMT("TiledRenderCoordinator", "Rendered {} tiles on {} nodes in {} ms",
+                 _grid.getTileCount(), stats.nodes, elapsed.count());
+    return true;
+}
+
+void TiledRenderCoordinator::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cancelled = true;
+    }
+    _cv.notify_all();
+}
+
+TiledRenderCoordinator::Stats TiledRenderCoordinator::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+void TiledRenderCoordinator::acceptLoop() {
+    Profiler::setThreadName("TiledRenderAccept");
+    while (true) {
+        TcpSocket socket = _listener.accept();
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stopping || !socket.isValid()) {
+            break;
+        }
+        auto connection = std::make_unique<Connection>();
+        connection->socket = std::move(socket);
+        Connection* raw = connection.get();
+        connection->thread = std::thread([this, raw] { serveNode(*raw); });
+        _connections.push_back(std::move(connection));
+    }
+}
+
+void TiledRenderCoordinator::serveNode(Connection& connection) {
+    Profiler::setThreadName("TiledRenderNode");
+    const std::string peer = connection.socket.getPeerName();
+
+    MessageHeader header;
+    HelloMessage hello;
+    if (!receiveHeader(connection.socket, header) || header.type != MessageType::Hello ||
+        header.size != sizeof(hello) || !connection.socket.receiveAll(&hello, sizeof(hello)) ||
+        hello.version != PROTOCOL_VERSION) {
+        LOG_WARNING("TiledRenderCoordinator", "Dropped " + peer + ": not a render node of this version");
+        std::lock_guard<std::mutex> lock(_mutex);
+        connection.finished = true;
+        return;
+    }
+
+    std::span<const uint8_t> scene;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this] { return _rendering || _stopping; });
+        if (_stopping) {
+            connection.finished = true;
+            return;
+        }
+        scene = _scene;
+        ++_activeNodes;
+        ++_stats.nodes;
+    }
+    LOG_INFO("TiledRenderCoordinator", "Render node " + peer + " joined");
+
+    JobMessage job;
+    job.width = _desc.width;
+    job.height = _desc.height;
+    job.tileWidth = _desc.tileWidth;
+    job.tileHeight = _desc.tileHeight;
+    job.format = static_cast<uint32_t>(_desc.format);
+    job.tilesInFlight = _desc.tilesInFlight;
+    bool connected = sendMessage(connection.socket, MessageType::Job, &job, sizeof(job), scene.size()) &&
+                     connection.socket.sendAll(scene.data(), scene.size());
+
+    std::vector<uint32_t> batch;
+    while (connected) {
+        // Keep tilesInFlight tiles at the node; only wait for the queue
+        // when the node has nothing left to return
+        batch.clear();
+        uint32_t tile = 0;
+        while (connection.pending.size() + batch.size() < _desc.tilesInFlight &&
+               takeTile(tile, connection.pending.empty() && batch.empty())) {
+            batch.push_back(tile);
+        }
+        size_t sent = 0;
+        for (; sent < batch.size() && connected; ++sent) {
+            TileMessage message;
+            message.index = batch[sent];
+            message.flags = sent + 1 == batch.size() ? TILE_FLUSH : 0;
+            connection.pending.push_back(batch[sent]);
+            connected = sendMessage(connection.socket, MessageType::Tile, &message, sizeof(message));
+        }
+        // Tiles taken but never sent go back with the pending ones
+        connection.pending.insert(connection.pending.end(), batch.begin() + sent, batch.end());
+
+        if (!connected) {
+            break;
+        }
+        if (connection.pending.empty()) {
+            // Queue empty and nothing outstanding: done, or the render ended
+            bool done = false;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                done = _remaining == 0;
+            }
+            if (done) {
+                sendMessage(connection.socket, MessageType::Done, nullptr, 0);
+            }
+            break;
+        }
+        connected = receiveTile(connection);
+    }
+
+    if (!connection.pending.empty()) {
+        LOG_WARNING("TiledRenderCoordinator", "Lost render node " + peer);
+    }
+    returnTiles(connection);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_activeNodes;
+    connection.finished = true;
+    _cv.notify_all();
+}
+
+bool TiledRenderCoordinator::receiveTile(Connection& connection) {
+    MessageHeader header;
+    uint32_t index = 0;
+    if (!receiveHeader(connection.socket, header) || header.type != MessageType::TileResult ||
+        header.size < sizeof(index) || !connection.socket.receiveAll(&index, sizeof(index))) {
+        return false;
+    }
+
+    auto pending = std::find(connection.pending.begin(), connection.pending.end(), index);
+    if (pending == connection.pending.end()) {
+        LOG_WARNING("TiledRenderCoordinator", "Node returned a tile it was not assigned");
+        return false;
+    }
+    const TileRect tile = _grid.getTile(index);
+    const size_t rowSize = static_cast<size_t>(tile.width) * _bytesPerPixel;
+    if (header.size != sizeof(index) + rowSize * tile.height) {
+        LOG_WARNING("TiledRenderCoordinator", "Tile result has the wrong size");
+        return false;
+    }
+
+    // Rows land straight in the image; tiles never overlap and render()
+    // joins every node before it returns the image
+    uint8_t* target = _image->data() + (static_cast<size_t>(tile.y) * _desc.width + tile.x) * _bytesPerPixel;
+    const size_t imagePitch = static_cast<size_t>(_desc.width) * _bytesPerPixel;
+    for (uint32_t row = 0; row < tile.height; ++row) {
+        if (!connection.socket.receiveAll(target + row * imagePitch, rowSize)) {
+            return false;
+        }
+    }
+    connection.pending.erase(pending);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.bytesReceived += header.size;
+    if (!_tileDone[index]) {
+        _tileDone[index] = 1;
+        ++_stats.tilesRendered;
+        if (--_remaining == 0) {
+            _cv.notify_all();
+        }
+    }
+    return true;
+}
+
+bool TiledRenderCoordinator::takeTile(uint32_t& tile, bool wait) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (wait) {
+        // A lost node may still hand tiles back while others are working
+        _cv.wait(lock, [this] { return !_queue.empty() || _remaining == 0 || !_rendering; });
+    }
+    if (_queue.empty() || !_rendering) {
+        return false;
+    }
+    tile = _queue.front();
+    _queue.pop_front();
+    return true;
+}
+
+void TiledRenderCoordinator::returnTiles(Connection& connection) {
+    if (connection.pending.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (uint32_t tile : connection.pending) {
+        _queue.push_front(tile);
+    }
+    _stats.tilesReassigned += static_cast<uint32_t>(connection.pending.size());
+    connection.pending.clear();
+    _cv.notify_all();
+}
+
+void TiledRenderCoordinator::stopNodes() {
+    std::vector<std::unique_ptr<Connection>> connections;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        connections.swap(_connections);
+    }
+    for (auto& connection : connections) {
+        connection->socket.shutdown();
+    }
+    for (auto& connection : connections) {
+        connection->thread.join();
+    }
+}
+
+// TiledRenderNode
+
+TiledRenderNode::TiledRenderNode(const std::shared_ptr<ILogicalDevice>& device)
+    : TiledRenderNode(device, Desc()) {
+}
+
+TiledRenderNode::TiledRenderNode(const std::shared_ptr<ILogicalDevice>& device, const Desc& desc)
+    : _device(device)
+    , _desc(desc) {
+}
+
+bool TiledRenderNode::run(const std::string& host, uint16_t port,
+                          const SetupFunction& setup, const RecordFunction& record) {
+    if (!_device || !record) {
+        LOG_ERROR("TiledRenderNode", "Run needs a device and a record function");
+        return false;
+    }
+
+    {
+        TcpSocket socket = TcpSocket::connect(host, port);
+        std::lock_guard<std::mutex> lock(_socketMutex);
+        _socket = std::move(socket);
+    }
+    if (!_socket.isValid()) {
+        return false;
+    }
+
+    HelloMessage hello;
+    MessageHeader header;
+    JobMessage message;
+    if (!sendMessage(_socket, MessageType::Hello, &hello, sizeof(hello)) ||
+        !receiveHeader(_socket, header) || header.type != MessageType::Job ||
+        header.size < sizeof(message) || !_socket.receiveAll(&message, sizeof(message))) {
+        LOG_ERROR("TiledRenderNode", "Coordinator did not send a job");
+        return false;
+    }
+
+    TiledRenderJob job;
+    job.width = message.width;
+    job.height = message.height;
+    job.tileWidth = message.tileWidth;
+    job.tileHeight = message.tileHeight;
+    job.format = static_cast<TextureFormat>(message.format);
+    const uint32_t bytesPerPixel = getBytesPerPixel(job.format);
+    if (job.width == 0 || job.height == 0 || bytesPerPixel == 0) {
+        LOG_ERROR("TiledRenderNode", "Coordinator sent an invalid job");
+        return false;
+    }
+
+    // Stream the scene to disk so SceneFile and friends can map it
+    job.scenePath = _desc.sceneCachePath;
+    if (job.scenePath.empty()) {
+        std::error_code ec;
+        job.scenePath = (std::filesystem::temp_directory_path(ec) /
+                         ("pers_tiled_scene_" + std::to_string(port) + ".bin")).string();
+    }
+    {
+        std::ofstream file(job.scenePath, std::ios::binary | std::ios::trunc);
+        std::vector<char> chunk(SCENE_CHUNK_SIZE);
+        uint64_t left = header.size - sizeof(message);
+        while (left > 0) {
+            const size_t size = static_cast<size_t>(std::min<uint64_t>(left, chunk.size()));
+            if (!_socket.receiveAll(chunk.data(), size)) {
+                LOG_ERROR("TiledRenderNode", "Connection lost while receiving the scene");
+                return false;
+            }
+            file.write(chunk.data(), static_cast<std::streamsize>(size));
+            left -= size;
+        }
+        if (!file) {
+            LOG_ERROR("TiledRenderNode", "Cannot write scene to " + job.scenePath);
+            return false;
+        }
+    }
+    if (setup && !setup(job)) {
+        LOG_ERROR("TiledRenderNode", "Setup function rejected the job");
+        return false;
+    }
+
+    const TileGrid grid(job.width, job.height, job.tileWidth, job.tileHeight);
+    OffscreenRenderQueue queue(_device, std::max(1u, message.tilesInFlight));
+    std::vector<uint8_t> result;
+    bool connected = true;
+
+    // Pack the padded readback rows and send the tile back
+    auto sendTile = [&](uint32_t index, const OffscreenImage& image) {
+        const size_t rowSize = static_cast<size_t>(image.width) * bytesPerPixel;
+        result.resize(sizeof(index) + rowSize * image.height);
+        std::memcpy(result.data(), &index, sizeof(index));
+        const auto* source = static_cast<const uint8_t*>(image.data);
+        for (uint32_t row = 0; row < image.height; ++row) {
+            std::memcpy(result.data() + sizeof(index) + row * rowSize,
+                        source + static_cast<size_t>(row) * image.bytesPerRow, rowSize);
+        }
+        if (connected && sendMessage(_socket, MessageType::TileResult, result.data(), result.size())) {
+            _tilesRendered.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            connected = false;
+        }
+    };
+
+    bool done = false;
+    while (connected && !done) {
+        TileMessage tileMessage;
+        if (!receiveHeader(_socket, header)) {
+            break;
+        }
+        if (header.type == MessageType::Done) {
+            done = true;
+            break;
+        }
+        if (header.type != MessageType::Tile || header.size != sizeof(tileMessage) ||
+            !_socket.receiveAll(&tileMessage, sizeof(tileMessage)) || tileMessage.index >= grid.getTileCount()) {
+            break;
+        }
+
+        Tile tile;
+        tile.rect = grid.getTile(tileMessage.index);
+        tile.projection = grid.getTileProjection(tile.rect);
+
+        OffscreenRenderJobDesc desc;
+        desc.width = tile.rect.width;
+        desc.height = tile.rect.height;
+        desc.colorFormat = job.format;
+        desc.depthFormat = _desc.depthFormat;
+        desc.label = "Tile " + std::to_string(tile.rect.index);
+
+        // A tile that fails to render drops the node; the coordinator
+        // hands its tiles to the others
+        const uint64_t failed = queue.getStats().failed;
+        const uint32_t index = tile.rect.index;
+        if (queue.submit(desc,
+                [&record, tile](ICommandEncoder& encoder, const IFramebuffer& target) {
+                    return record(encoder, target, tile);
+                },
+                [&sendTile, index](const OffscreenImage& image) { sendTile(index, image); }) == 0) {
+            break;
+        }
+        if ((tileMessage.flags & TILE_FLUSH) && !queue.waitIdle()) {
+            break;
+        }
+        if (queue.getStats().failed != failed) {
+            break;
+        }
+    }
+    queue.waitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(_socketMutex);
+        _socket.close();
+    }
+    if (!done) {
+        LOG_WARNING("TiledRenderNode", "Left the render before the coordinator finished");
+    }
+    return done;
+}
+
+void TiledRenderNode::stop() {
+    std::lock_guard<std::mutex> lock(_socketMutex);
+    _socket.shutdown();
+}
+
+} // namespace pers
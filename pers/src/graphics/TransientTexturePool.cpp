@@ -0,0 +1,139 @@
+#include "pers/graphics/TransientTexturePool.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+TransientTexturePool::TransientTexturePool(const std::shared_ptr<IResourceFactory>& factory,
+                                           uint32_t maxIdleFrames)
+    : _factory(factory)
+    , _maxIdleFrames(maxIdleFrames) {
+    if (!factory) {
+        LOG_ERROR("TransientTexturePool", "Resource factory is null");
+    }
+
+    // Free transient targets are the cheapest memory to give back
+    _evictionCallback = GpuMemoryTracker::instance().addEvictionCallback(
+        "TransientTexturePool", [this](uint64_t bytes) { return evict(bytes); }, -10);
+}
+
+TransientTexturePool::~TransientTexturePool() {
+    GpuMemoryTracker::instance().removeEvictionCallback(_evictionCallback);
+}
+
+bool TransientTexturePool::isCompatible(const TextureDesc& a, const TextureDesc& b) {
+    return a.dimension == b.dimension &&
+           a.width == b.width &&
+           a.height == b.height &&
+           a.depthOrArrayLayers == b.depthOrArrayLayers &&
+           a.mipLevelCount == b.mipLevelCount &&
+           a.sampleCount == b.sampleCount &&
+           a.format == b.format &&
+           a.usage == b.usage;
+}
+
+PooledTexture TransientTexturePool::acquire(const TextureDesc& desc) {
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = std::find_if(_free.begin(), _free.end(),
+            [&desc](const Entry& entry) { return isCompatible(entry.desc, desc); });
+        if (it != _free.end()) {
+            PooledTexture texture = std::move(it->texture);
+            _free.erase(it);
+            ++_stats.reuses;
+            return texture;
+        }
+    }
+
+    auto factory = _factory.lock();
+    if (!factory) {
+        LOG_ERROR("TransientTexturePool", "Cannot allocate texture without factory");
+        return {};
+    }
+
+    PooledTexture result;
+    result.texture = factory->createTexture(desc);
+    if (!result.texture) {
+        Logger::Instance().LogFormat(LogLevel::Error, "TransientTexturePool", PERS_SOURCE_LOC,
+            "Failed to create texture '%s' %ux%u", desc.label.c_str(), desc.width, desc.height);
+        return {};
+    }
+
+    TextureViewDesc viewDesc;
+    viewDesc.format = desc.format;
+    viewDesc.label = desc.label;
+    result.view = factory->createTextureView(result.texture, viewDesc);
+    if (!result.view) {
+        Logger::Instance().LogFormat(LogLevel::Error, "TransientTexturePool", PERS_SOURCE_LOC,
+            "Failed to create view for texture '%s'", desc.label.c_str());
+        return {};
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    ++_stats.allocations;
+    return result;
+}
+
+void TransientTexturePool::release(PooledTexture texture) {
+    if (!texture) {
+        return;
+    }
+
+    TextureDesc desc;
+    desc.dimension = texture.texture->getDimension();
+    desc.width = texture.texture->getWidth();
+    desc.height = texture.texture->getHeight();
+    desc.depthOrArrayLayers = texture.texture->getDepthOrArrayLayers();
+    desc.mipLevelCount = texture.texture->getMipLevelCount();
+    desc.sampleCount = texture.texture->getSampleCount();
+    desc.format = texture.texture->getFormat();
+    desc.usage = texture.texture->getUsage();
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _free.push_back(Entry{desc, std::move(texture), 0});
+}
+
+void TransientTexturePool::endFrame() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (auto& entry : _free) {
+        ++entry.idleFrames;
+    }
+    _free.erase(std::remove_if(_free.begin(), _free.end(),
+                               [this](const Entry& entry) { return entry.idleFrames > _maxIdleFrames; }),
+                _free.end());
+}
+
+void TransientTexturePool::trim() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _free.clear();
+}
+
+uint64_t TransientTexturePool::evict(uint64_t bytes) {
+    std::vector<Entry> evicted;
+    uint64_t freed = 0;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        std::stable_sort(_free.begin(), _free.end(),
+                         [](const Entry& a, const Entry& b) { return a.idleFrames > b.idleFrames; });
+        size_t count = 0;
+        while (count < _free.size() && freed < bytes) {
+            freed += GpuMemoryTracker::estimateTextureSize(_free[count].desc);
+            ++count;
+        }
+        evicted.assign(std::make_move_iterator(_free.begin()), std::make_move_iterator(_free.begin() + count));
+        _free.erase(_free.begin(), _free.begin() + count);
+    }
+    // Textures are released here, outside the pool lock
+    return freed;
+}
+
+TransientTexturePool::Stats TransientTexturePool::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    Stats stats = _stats;
+    stats.freeTextures = static_cast<uint32_t>(_free.size());
+    return stats;
+}
+
+} // namespace pers
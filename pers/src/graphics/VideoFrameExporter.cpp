@@ -0,0 +1,149 @@
+#include "pers/graphics/VideoFrameExporter.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+
+namespace pers {
+
+VideoFrameExporter::VideoFrameExporter(const std::shared_ptr<ILogicalDevice>& device, JobSystem& jobs,
+                                       const std::shared_ptr<IVideoFrameSink>& sink,
+                                       const VideoFrameExporterDesc& desc)
+    : _device(device)
+    , _sink(sink)
+    , _desc(desc) {
+    if (!device || !sink) {
+        LOG_ERROR("VideoFrameExporter", "Device or sink is null");
+        return;
+    }
+
+    if (!desc.forceReadback && sink->acceptsNativeTextures(*device)) {
+        _slots.reserve(desc.slotCount);
+        for (uint32_t i = 0; i < desc.slotCount; ++i) {
+            _slots.push_back(std::make_unique<Slot>());
+        }
+        LOG_INFO("VideoFrameExporter", "Exporting frames as native textures");
+        return;
+    }
+
+    FrameGrabberDesc grabberDesc;
+    grabberDesc.maxWidth = desc.width;
+    grabberDesc.maxHeight = desc.height;
+    grabberDesc.format = desc.format;
+    grabberDesc.slotCount = desc.slotCount;
+    grabberDesc.encoding = FrameEncoding::Raw;
+    grabberDesc.onFrame = [sink](const CapturedFrame& frame) { sink->onCpuFrame(frame); };
+    _grabber = std::make_unique<FrameGrabber>(device, jobs, std::move(grabberDesc));
+    LOG_INFO("VideoFrameExporter", "Sink cannot read native textures, exporting through readback");
+}
+
+VideoFrameExporter::~VideoFrameExporter() = default;
+
+bool VideoFrameExporter::isValid() const {
+    return _grabber ? _grabber->isValid() : !_slots.empty();
+}
+
+bool VideoFrameExporter::exportFrame(const std::shared_ptr<ICommandEncoder>& encoder,
+                                     const OffscreenFramebuffer& framebuffer,
+                                     uint64_t frameIndex, uint32_t colorIndex) {
+    PERS_PROFILE_SCOPE("VideoFrameExporter::exportFrame");
+    auto source = framebuffer.getColorTexture(colorIndex);
+    if (!encoder || !source) {
+        LOG_ERROR("VideoFrameExporter", "Encoder or color attachment is missing");
+        return false;
+    }
+
+    if (_grabber) {
+        return _grabber->capture(encoder, source, frameIndex);
+    }
+
+    if (_slots.empty()) {
+        return false;
+    }
+
+    // Rotate from the last used slot; the sink may release them out of order
+    const uint32_t slotCount = static_cast<uint32_t>(_slots.size());
+    uint32_t index = _nextSlot;
+    while (_slots[index]->held.load(std::memory_order_acquire)) {
+        index = (index + 1) % slotCount;
+        if (index == _nextSlot) {
+            ++_droppedCount;
+            LOG_DEBUG("VideoFrameExporter", "Encoder holds every slot, dropping frame");
+            return false;
+        }
+    }
+
+    Slot& slot = *_slots[index];
+    auto texture = slotTexture(slot, source->getWidth(), source->getHeight(), source->getFormat());
+    if (!texture || !encoder->copyTextureToTexture(source, texture, {})) {
+        LOG_ERROR("VideoFrameExporter", "Failed to record export copy");
+        return false;
+    }
+
+    slot.held.store(true, std::memory_order_release);
+    _pending.push_back({index, frameIndex});
+    _nextSlot = (index + 1) % slotCount;
+    return true;
+}
+
+void VideoFrameExporter::submitted(const SubmissionFence& fence) {
+    if (_grabber) {
+        _grabber->submitted();
+        return;
+    }
+
+    for (const PendingExport& pending : _pending) {
+        const Slot& slot = *_slots[pending.slot];
+        ExportedVideoFrame frame;
+        frame.frameIndex = pending.frameIndex;
+        frame.slot = pending.slot;
+        frame.width = slot.texture->getWidth();
+        frame.height = slot.texture->getHeight();
+        frame.format = slot.texture->getFormat();
+        frame.device = _device->getNativeDeviceHandle();
+        frame.texture = slot.texture->getNativeTextureHandle();
+        frame.ready = fence;
+        _sink->onGpuFrame(frame);
+    }
+    _pending.clear();
+}
+
+void VideoFrameExporter::poll() {
+    if (_grabber) {
+        _grabber->poll();
+    }
+}
+
+void VideoFrameExporter::releaseFrame(uint32_t slot) {
+    if (slot >= _slots.size()) {
+        LOG_WARNING("VideoFrameExporter", "Released slot out of range");
+        return;
+    }
+    _slots[slot]->held.store(false, std::memory_order_release);
+}
+
+uint64_t VideoFrameExporter::getDroppedCount() const {
+    return _grabber ? _grabber->getDroppedCount() : _droppedCount;
+}
+
+std::shared_ptr<ITexture> VideoFrameExporter::slotTexture(Slot& slot, uint32_t width, uint32_t height,
+                                                          TextureFormat format) {
+    if (slot.texture && slot.texture->getWidth() == width && slot.texture->getHeight() == height &&
+        slot.texture->getFormat() == format) {
+        return slot.texture;
+    }
+
+    TextureDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = format;
+    desc.usage = TextureUsage::CopySrc | TextureUsage::CopyDst | TextureUsage::TextureBinding;
+    desc.label = "VideoExportTexture";
+    slot.texture = _device->getResourceFactory()->createTexture(desc);
+    return slot.texture;
+}
+
+} // namespace pers
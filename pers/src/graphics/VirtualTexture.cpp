@@ -0,0 +1,615 @@
+#include "pers/graphics/VirtualTexture.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/GpuStruct.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <bit>
+#include <cmath>
+#include <span>
+
+namespace pers {
+
+namespace {
+
+struct VirtualTextureInfo {
+    uint32_t levelOffsets[16];  // Page table index of each level's first page
+    uint32_t pagesWide;
+    uint32_t pagesHigh;
+    uint32_t mipCount;
+    float pageSize;
+    float border;
+    float feedbackBias;         // log2 of viewport pixels per feedback pixel
+    float physicalSize[2];      // Cache texture size in texels
+};
+
+static_assert(VirtualTexture::MAX_MIP_COUNT <= 16, "Level offsets are stored as four vec4<u32>");
+
+constexpr char TYPES_WGSL[] = R"(
+struct VirtualTextureInfo {
+    levelOffsets: array<vec4<u32>, 4>,
+    pagesWide: u32,
+    pagesHigh: u32,
+    mipCount: u32,
+    pageSize: f32,
+    border: f32,
+    feedbackBias: f32,
+    physicalSize: vec2<f32>,
+};
+)";
+
+using InfoLayout = GpuStruct<GpuLayout::Std140, GpuArray<GpuVec4u, 4>, GpuU32, GpuU32, GpuU32, GpuF32, GpuF32, GpuF32,
+                             GpuVec2f>;
+static_assert(InfoLayout::matchesWgsl(TYPES_WGSL, "VirtualTextureInfo"),
+              "VirtualTextureInfo no longer matches the virtual texture shaders");
+static_assert(InfoLayout::SIZE == sizeof(VirtualTextureInfo) &&
+              InfoLayout::offsetOf<7>() == offsetof(VirtualTextureInfo, physicalSize),
+              "VirtualTextureInfo must match the WGSL layout");
+
+constexpr char SHADING_FUNCTIONS[] = R"(
+fn virtualTextureLevelPages(mip: u32) -> vec2<u32> {
+    return max(vec2<u32>(virtualTexture.pagesWide, virtualTexture.pagesHigh) >> vec2<u32>(mip), vec2<u32>(1u));
+}
+
+// Unclamped level of detail of uv, log2 of virtual texels per pixel
+fn virtualTextureLod(uv: vec2<f32>) -> f32 {
+    let size = vec2<f32>(f32(virtualTexture.pagesWide), f32(virtualTexture.pagesHigh)) * virtualTexture.pageSize;
+    let dx = dpdx(uv * size);
+    let dy = dpdy(uv * size);
+    return 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-8));
+}
+
+fn virtualTexturePage(uv: vec2<f32>, mip: u32) -> vec2<u32> {
+    let pages = virtualTextureLevelPages(mip);
+    return min(vec2<u32>(clamp(uv, vec2<f32>(0.0), vec2<f32>(1.0)) * vec2<f32>(pages)), pages - 1u);
+}
+
+// Value for the feedback target: the page uv needs, never 0
+fn virtualTextureFeedback(uv: vec2<f32>) -> u32 {
+    // The feedback target is smaller, so its derivatives overstate the level by the bias
+    let lod = virtualTextureLod(uv) - virtualTexture.feedbackBias;
+    let mip = u32(clamp(lod, 0.0, f32(virtualTexture.mipCount - 1u)));
+    let page = virtualTexturePage(uv, mip);
+    return 0x80000000u | (mip << 24u) | (page.y << 12u) | page.x;
+}
+
+// Cache coordinates of uv in the finest resident page at or above lod
+fn virtualTextureCacheUv(uv: vec2<f32>, lod: f32) -> vec2<f32> {
+    let mip = u32(clamp(lod, 0.0, f32(virtualTexture.mipCount - 1u)));
+    let page = virtualTexturePage(uv, mip);
+    let levelOffset = virtualTexture.levelOffsets[mip / 4u][mip % 4u];
+    let entry = virtualPageTable[levelOffset + page.y * virtualTextureLevelPages(mip).x + page.x];
+
+    // The entry names the level its tile holds, coarser than mip while the page is missing
+    let sourcePages = vec2<f32>(virtualTextureLevelPages((entry >> 24u) & 31u));
+    let position = clamp(uv, vec2<f32>(0.0), vec2<f32>(1.0)) * sourcePages;
+    let inPage = position - min(floor(position), sourcePages - 1.0);
+    let tile = vec2<f32>(f32(entry & 0xfffu), f32((entry >> 12u) & 0xfffu));
+    let tileSize = virtualTexture.pageSize + 2.0 * virtualTexture.border;
+    return (tile * tileSize + virtualTexture.border + inPage * virtualTexture.pageSize) / virtualTexture.physicalSize;
+}
+
+fn virtualTextureSample(uv: vec2<f32>) -> vec4<f32> {
+    let cacheUv = virtualTextureCacheUv(uv, virtualTextureLod(uv));
+    return textureSampleLevel(virtualCache, virtualCacheSampler, cacheUv, 0.0);
+}
+)";
+
+constexpr uint32_t FEEDBACK_VALID = 0x80000000u;
+constexpr uint32_t MAX_PAGES_PER_SIDE = 1u << (VirtualTexture::MAX_MIP_COUNT - 1);  // 12-bit page coordinates
+
+uint32_t packEntry(uint32_t tileX, uint32_t tileY, uint32_t mip) {
+    return tileX | (tileY << 12) | (mip << 24);
+}
+
+} // anonymous namespace
+
+VirtualTexture::VirtualTexture(const std::shared_ptr<ILogicalDevice>& device, const Config& config)
+    : _device(device)
+    , _config(config) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!factory || !queue) {
+        LOG_ERROR("VirtualTexture", "Device, queue or resource factory is null");
+        return;
+    }
+    if (!config.loader) {
+        LOG_ERROR("VirtualTexture", "Config::loader is required");
+        return;
+    }
+    if (!std::has_single_bit(config.pagesWide) || !std::has_single_bit(config.pagesHigh) ||
+        config.pagesWide > MAX_PAGES_PER_SIDE || config.pagesHigh > MAX_PAGES_PER_SIDE) {
+        LOG_ERROR("VirtualTexture", "Page counts must be powers of two up to 4096");
+        return;
+    }
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(config.format);
+    if (config.pageSize == 0 || block.blockBytes == 0 || isCompressedFormat(config.format)) {
+        LOG_ERROR("VirtualTexture", "Pages need a non-zero size and an uncompressed, copyable format");
+        return;
+    }
+
+    _mipCount = static_cast<uint32_t>(std::bit_width(std::max(config.pagesWide, config.pagesHigh)));
+    _tileSize = config.pageSize + 2 * config.border;
+    _texelBytes = block.blockBytes;
+
+    uint32_t entryCount = 0;
+    for (uint32_t mip = 0; mip < _mipCount; ++mip) {
+        _levelOffsets.push_back(entryCount);
+        entryCount += getPagesWide(mip) * getPagesHigh(mip);
+    }
+
+    // A limit of 0 is unspecified and does not constrain
+    const DeviceLimits limits = device->getLimits();
+    uint32_t maxTiles = MAX_PAGES_PER_SIDE;
+    if (limits.maxTextureDimension2D > 0) {
+        maxTiles = std::min(maxTiles, limits.maxTextureDimension2D / _tileSize);
+    }
+    if (config.cachePagesX > maxTiles || config.cachePagesY > maxTiles) {
+        LOG_WARNING("VirtualTexture", "Page cache exceeds the texture size limit and was lowered");
+    }
+    _config.cachePagesX = std::clamp(config.cachePagesX, 1u, std::max(maxTiles, 1u));
+    _config.cachePagesY = std::clamp(config.cachePagesY, 1u, std::max(maxTiles, 1u));
+
+    TextureDesc textureDesc;
+    textureDesc.width = _config.cachePagesX * _tileSize;
+    textureDesc.height = _config.cachePagesY * _tileSize;
+    textureDesc.format = config.format;
+    textureDesc.usage = TextureUsage::TextureBinding | TextureUsage::CopyDst;
+    textureDesc.label = config.label + "Cache";
+    _physicalTexture = factory->createTexture(textureDesc);
+    if (!_physicalTexture) {
+        LOG_ERROR("VirtualTexture", "Failed to create page cache texture");
+        return;
+    }
+
+    _infoBuffer = std::make_shared<DeviceBuffer>();
+    _pageTableBuffer = std::make_shared<DeviceBuffer>();
+    if (!_infoBuffer->create(sizeof(VirtualTextureInfo), DeviceBufferUsage::Uniform, device, config.label + "Info") ||
+        !_pageTableBuffer->create(uint64_t(entryCount) * sizeof(uint32_t), DeviceBufferUsage::Storage, device,
+                                  config.label + "PageTable")) {
+        LOG_ERROR("VirtualTexture", "Failed to create page table buffers");
+        return;
+    }
+
+    // Every entry starts at tile 0 of level 0, matching the zeroed buffer
+    _pageTable.assign(entryCount, 0);
+    _pageTiles.assign(entryCount, NO_TILE);
+    _tiles.resize(size_t(_config.cachePagesX) * _config.cachePagesY);
+    for (uint32_t tile = static_cast<uint32_t>(_tiles.size()); tile > 0; --tile) {
+        _freeTiles.push_back(tile - 1);
+    }
+
+    SamplerDesc samplerDesc;
+    samplerDesc.mipmapFilter = FilterMode::Nearest;
+    samplerDesc.label = config.label + "Sampler";
+    auto sampler = factory->createSampler(samplerDesc);
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = config.label;
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Vertex | ShaderStage::Fragment, .type = BindingType::UniformBuffer,
+         .minBindingSize = sizeof(VirtualTextureInfo)},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture},
+        {.binding = 3, .visibility = ShaderStage::Fragment, .type = BindingType::Sampler},
+    };
+    _layout = factory->createBindGroupLayout(layoutDesc);
+    auto cacheView = factory->createTextureView(_physicalTexture, TextureViewDesc{});
+    if (!_layout || !sampler || !cacheView || !writeInfo()) {
+        LOG_ERROR("VirtualTexture", "Failed to create shading resources");
+        return;
+    }
+
+    // The root page is what every lookup falls back to
+    request({_mipCount - 1, 0, 0});
+
+    // Created last, isValid() means the group can be bound and pages streamed
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = _layout;
+    bindGroupDesc.debugName = config.label;
+    bindGroupDesc.entries.resize(4);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].buffer = _infoBuffer;
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].buffer = _pageTableBuffer;
+    bindGroupDesc.entries[2].binding = 2;
+    bindGroupDesc.entries[2].textureView = cacheView;
+    bindGroupDesc.entries[3].binding = 3;
+    bindGroupDesc.entries[3].sampler = sampler;
+    _bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!_bindGroup) {
+        LOG_ERROR("VirtualTexture", "Failed to create bind group");
+    }
+}
+
+VirtualTexture::~VirtualTexture() = default;
+
+bool VirtualTexture::writeInfo() {
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue) {
+        return false;
+    }
+
+    VirtualTextureInfo info = {};
+    for (uint32_t mip = 0; mip < _mipCount; ++mip) {
+        info.levelOffsets[mip] = _levelOffsets[mip];
+    }
+    info.pagesWide = _config.pagesWide;
+    info.pagesHigh = _config.pagesHigh;
+    info.mipCount = _mipCount;
+    info.pageSize = static_cast<float>(_config.pageSize);
+    info.border = static_cast<float>(_config.border);
+    info.feedbackBias = _feedbackBias;
+    info.physicalSize[0] = static_cast<float>(_physicalTexture->getWidth());
+    info.physicalSize[1] = static_cast<float>(_physicalTexture->getHeight());
+    return queue->writeBuffer(_infoBuffer, 0,
+                              std::span<const std::byte>(reinterpret_cast<const std::byte*>(&info), sizeof(info)));
+}
+
+bool VirtualTexture::resize(uint32_t viewportWidth, uint32_t viewportHeight) {
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !isValid()) {
+        return false;
+    }
+
+    const uint32_t scale = std::max(_config.feedbackScale, 1u);
+    const uint32_t width = std::max((viewportWidth + scale - 1) / scale, 1u);
+    const uint32_t height = std::max((viewportHeight + scale - 1) / scale, 1u);
+    if (!_feedback) {
+        OffscreenFramebufferConfig framebufferConfig;
+        framebufferConfig.width = width;
+        framebufferConfig.height = height;
+        framebufferConfig.colorFormats = {FEEDBACK_FORMAT};
+        framebufferConfig.depthFormat = TextureFormat::Depth32Float;
+        framebufferConfig.colorUsage = TextureUsage::RenderAttachment | TextureUsage::CopySrc;
+        auto feedback = std::make_shared<OffscreenFramebuffer>(factory, framebufferConfig);
+        if (!feedback->getColorAttachment(0)) {
+            LOG_ERROR("VirtualTexture", "Failed to create feedback target");
+            return false;
+        }
+        _feedback = std::move(feedback);
+    } else if (!_feedback->resize(width, height)) {
+        return false;
+    }
+
+    // Slots are sized for the whole target, so a new size needs a new ring
+    _feedbackPitch = getTextureReadbackRowPitch(FEEDBACK_FORMAT, width);
+    _readback.reset();
+    auto readback = std::make_unique<ReadbackRing>(device, uint64_t(_feedbackPitch) * height,
+                                                   std::max(_config.readbackSlots, 1u), _config.label + "Feedback");
+    if (readback->getSlotCount() == 0) {
+        LOG_ERROR("VirtualTexture", "Failed to create feedback readback");
+        return false;
+    }
+    _readback = std::move(readback);
+
+    _feedbackBias = std::log2(static_cast<float>(std::max(viewportWidth, 1u)) / static_cast<float>(width));
+    return writeInfo();
+}
+
+std::shared_ptr<IRenderPassEncoder> VirtualTexture::beginFeedbackPass(ICommandEncoder& encoder) {
+    if (!_feedback) {
+        LOG_ERROR("VirtualTexture", "Call resize() before the first feedback pass");
+        return nullptr;
+    }
+
+    RenderPassDesc passDesc;
+    passDesc.label = _config.label + "Feedback";
+    RenderPassColorAttachment attachment;
+    attachment.view = _feedback->getColorAttachment(0);
+    attachment.loadOp = LoadOp::Clear;
+    attachment.storeOp = StoreOp::Store;
+    attachment.clearColor = {0.0f, 0.0f, 0.0f, 0.0f};
+    passDesc.colorAttachments.push_back(attachment);
+
+    auto depth = std::make_shared<RenderPassDepthStencilAttachment>();
+    depth->view = _feedback->getDepthStencilAttachment();
+    depth->depthLoadOp = LoadOp::Clear;
+    depth->depthStoreOp = StoreOp::Discard;
+    depth->depthClearValue = 1.0f;
+    passDesc.depthStencilAttachment = depth;
+
+    auto pass = encoder.beginRenderPass(passDesc);
+    if (!pass) {
+        LOG_ERROR("VirtualTexture", "Failed to begin feedback pass");
+    }
+    return pass;
+}
+
+bool VirtualTexture::readbackFeedback(const std::shared_ptr<ICommandEncoder>& encoder) {
+    if (!_readback || !encoder) {
+        return false;
+    }
+    TextureReadbackDesc desc;
+    desc.width = _feedback->getWidth();
+    desc.height = _feedback->getHeight();
+    desc.bytesPerRow = _feedbackPitch;
+    return _readback->enqueueTexture(encoder, _feedback->getColorTexture(0), desc) != 0;
+}
+
+void VirtualTexture::submitted() {
+    if (_readback) {
+        _readback->submitted();
+    }
+}
+
+void VirtualTexture::request(const VirtualPage& page) {
+    if (page.mip < _mipCount && page.x < getPagesWide(page.mip) && page.y < getPagesHigh(page.mip)) {
+        ++_requests[pageIndex(page)];
+    }
+}
+
+bool VirtualTexture::isResident(const VirtualPage& page) const {
+    if (page.mip >= _mipCount || page.x >= getPagesWide(page.mip) || page.y >= getPagesHigh(page.mip)) {
+        return false;
+    }
+    return _pageTiles[pageIndex(page)] != NO_TILE;
+}
+
+uint32_t VirtualTexture::pageIndex(const VirtualPage& page) const {
+    return _levelOffsets[page.mip] + page.y * getPagesWide(page.mip) + page.x;
+}
+
+VirtualPage VirtualTexture::pageAt(uint32_t index) const {
+    uint32_t mip = _mipCount - 1;
+    while (mip > 0 && index < _levelOffsets[mip]) {
+        --mip;
+    }
+    const uint32_t local = index - _levelOffsets[mip];
+    return {mip, local % getPagesWide(mip), local / getPagesWide(mip)};
+}
+
+void VirtualTexture::harvestFeedback() {
+    if (!_readback) {
+        return;
+    }
+    const uint32_t width = _feedback->getWidth();
+    const uint32_t height = _feedback->getHeight();
+    _readback->harvest([&](uint64_t, const void* data, uint64_t size) {
+        if (size < uint64_t(_feedbackPitch) * (height - 1) + uint64_t(width) * sizeof(uint32_t)) {
+            return;
+        }
+        // Neighbouring pixels mostly want the same page, so count runs before hashing
+        uint32_t runValue = 0;
+        uint32_t runLength = 0;
+        auto flushRun = [&]() {
+            if ((runValue & FEEDBACK_VALID) == 0) {
+                return;
+            }
+            const VirtualPage page = {(runValue >> 24) & 0x7f, runValue & 0xfff, (runValue >> 12) & 0xfff};
+            if (page.mip < _mipCount && page.x < getPagesWide(page.mip) && page.y < getPagesHigh(page.mip)) {
+                _requests[pageIndex(page)] += runLength;
+            }
+        };
+        for (uint32_t row = 0; row < height; ++row) {
+            const auto* values = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(data) +
+                                                                   uint64_t(row) * _feedbackPitch);
+            for (uint32_t column = 0; column < width; ++column) {
+                if (values[column] == runValue) {
+                    ++runLength;
+                    continue;
+                }
+                flushRun();
+                runValue = values[column];
+                runLength = 1;
+            }
+        }
+        flushRun();
+    });
+}
+
+void VirtualTexture::touch(uint32_t index) {
+    if (_pageTiles[index] != NO_TILE) {
+        _tiles[_pageTiles[index]].lastUsed = _updateCount;
+    }
+}
+
+uint32_t VirtualTexture::allocateTile() {
+    if (!_freeTiles.empty()) {
+        const uint32_t tile = _freeTiles.back();
+        _freeTiles.pop_back();
+        return tile;
+    }
+
+    // Least recently requested tile not wanted by this update; the root stays resident
+    const uint32_t root = _levelOffsets[_mipCount - 1];
+    uint32_t victim = NO_TILE;
+    for (uint32_t tile = 0; tile < _tiles.size(); ++tile) {
+        if (_tiles[tile].page == root || _tiles[tile].lastUsed >= _updateCount) {
+            continue;
+        }
+        if (victim == NO_TILE || _tiles[tile].lastUsed < _tiles[victim].lastUsed) {
+            victim = tile;
+        }
+    }
+    if (victim == NO_TILE) {
+        return NO_TILE;
+    }
+
+    const uint32_t evicted = _tiles[victim].page;
+    _tiles[victim].page = NO_TILE;
+    _pageTiles[evicted] = NO_TILE;
+    refreshEntries(pageAt(evicted));
+    ++_stats.evictedPages;
+    return victim;
+}
+
+void VirtualTexture::refreshEntries(const VirtualPage& page) {
+    // Walk the page and its descendants coarse to fine, so parents are current when read
+    for (uint32_t mip = page.mip + 1; mip-- > 0;) {
+        const uint32_t shift = page.mip - mip;
+        const uint32_t pagesWide = getPagesWide(mip);
+        const uint32_t pagesHigh = getPagesHigh(mip);
+        const uint32_t x0 = std::min(page.x << shift, pagesWide - 1);
+        const uint32_t y0 = std::min(page.y << shift, pagesHigh - 1);
+        const uint32_t x1 = std::min((page.x + 1) << shift, pagesWide);
+        const uint32_t y1 = std::min((page.y + 1) << shift, pagesHigh);
+        for (uint32_t y = y0; y < y1; ++y) {
+            for (uint32_t x = x0; x < x1; ++x) {
+                const uint32_t index = _levelOffsets[mip] + y * pagesWide + x;
+                uint32_t entry = 0;
+                if (_pageTiles[index] != NO_TILE) {
+                    const uint32_t tile = _pageTiles[index];
+                    entry = packEntry(tile % _config.cachePagesX, tile / _config.cachePagesX, mip);
+                } else if (mip + 1 < _mipCount) {
+                    entry = _pageTable[pageIndex({mip + 1, std::min(x >> 1, getPagesWide(mip + 1) - 1),
+                                                  std::min(y >> 1, getPagesHigh(mip + 1) - 1)})];
+                }
+                _pageTable[index] = entry;
+                _dirtyBegin = std::min(_dirtyBegin, index);
+                _dirtyEnd = std::max(_dirtyEnd, index + 1);
+            }
+        }
+    }
+}
+
+bool VirtualTexture::update(ICommandEncoder& encoder) {
+    PERS_PROFILE_SCOPE("VirtualTexture::update");
+    auto device = _device.lock();
+    auto queue = device ? device->getQueue() : nullptr;
+    if (!queue || !isValid()) {
+        LOG_ERROR("VirtualTexture", "Cannot update invalid virtual texture");
+        return false;
+    }
+
+    // The previous update's encoder has been submitted by now
+    if (_staging) {
+        _staging->destroy();
+        _staging.reset();
+    }
+
+    ++_updateCount;
+    _stats = {};
+    harvestFeedback();
+    _stats.requestedPages = static_cast<uint32_t>(_requests.size());
+    request({_mipCount - 1, 0, 0});
+
+    // Requested pages and the ancestors they fall back to count as used
+    struct Missing {
+        uint32_t index;
+        uint32_t mip;
+        uint32_t pixels;
+    };
+    std::vector<Missing> missing;
+    for (const auto& [index, pixels] : _requests) {
+        VirtualPage page = pageAt(index);
+        if (_pageTiles[index] == NO_TILE) {
+            missing.push_back({index, page.mip, pixels});
+        }
+        for (;; ++page.mip, page.x >>= 1, page.y >>= 1) {
+            touch(pageIndex({page.mip, std::min(page.x, getPagesWide(page.mip) - 1),
+                             std::min(page.y, getPagesHigh(page.mip) - 1)}));
+            if (page.mip + 1 >= _mipCount) {
+                break;
+            }
+        }
+    }
+    _requests.clear();
+
+    // Coarse pages first: they cover the most screen and back the finer ones
+    std::sort(missing.begin(), missing.end(), [](const Missing& a, const Missing& b) {
+        return a.mip != b.mip ? a.mip > b.mip : a.pixels > b.pixels;
+    });
+
+    const uint64_t tileBytes = uint64_t(_tileSize) * _tileSize * _texelBytes;
+    std::vector<uint32_t> uploadTiles;
+    _uploadData.clear();
+    for (const Missing& page : missing) {
+        if (uploadTiles.size() >= _config.maxUploadsPerUpdate) {
+            break;
+        }
+        const VirtualPage virtualPage = pageAt(page.index);
+        _loadData.clear();
+        if (!_config.loader(virtualPage, _loadData)) {
+            continue;
+        }
+        if (_loadData.size() < tileBytes) {
+            LOG_WARNING("VirtualTexture", "Loader returned less than one tile of data, page skipped");
+            continue;
+        }
+
+        const uint32_t tile = allocateTile();
+        if (tile == NO_TILE) {
+            break;  // Every tile holds a page wanted this update
+        }
+        _tiles[tile].page = page.index;
+        _tiles[tile].lastUsed = _updateCount;
+        _pageTiles[page.index] = tile;
+        refreshEntries(virtualPage);
+        _uploadData.insert(_uploadData.end(), _loadData.begin(), _loadData.begin() + tileBytes);
+        uploadTiles.push_back(tile);
+    }
+    _stats.uploadedPages = static_cast<uint32_t>(uploadTiles.size());
+    _stats.missingPages = static_cast<uint32_t>(missing.size() - uploadTiles.size());
+    _stats.residentPages = static_cast<uint32_t>(_tiles.size() - _freeTiles.size());
+
+    bool recorded = true;
+    if (!uploadTiles.empty()) {
+        // Texture copies need 256-byte row pitches; loaded rows are tightly packed
+        const uint32_t pitch = getTextureReadbackRowPitch(_config.format, _tileSize);
+        const uint64_t stagedTileBytes = uint64_t(pitch) * _tileSize;
+        const uint64_t rowBytes = uint64_t(_tileSize) * _texelBytes;
+        auto staging = std::make_shared<ImmediateStagingBuffer>();
+        if (!staging->create(stagedTileBytes * uploadTiles.size(), device->getStagingBufferPool(),
+                             _config.label + "Staging")) {
+            LOG_ERROR("VirtualTexture", "Failed to create staging buffer");
+            return false;
+        }
+        for (size_t i = 0; i < uploadTiles.size(); ++i) {
+            for (uint32_t row = 0; row < _tileSize; ++row) {
+                staging->writeBytes(_uploadData.data() + i * tileBytes + row * rowBytes, rowBytes,
+                                    i * stagedTileBytes + uint64_t(row) * pitch);
+            }
+        }
+        staging->finalize();
+
+        for (size_t i = 0; i < uploadTiles.size(); ++i) {
+            TextureUploadDesc desc;
+            desc.originX = (uploadTiles[i] % _config.cachePagesX) * _tileSize;
+            desc.originY = (uploadTiles[i] / _config.cachePagesX) * _tileSize;
+            desc.width = _tileSize;
+            desc.height = _tileSize;
+            desc.bufferOffset = i * stagedTileBytes;
+            desc.bytesPerRow = pitch;
+            recorded = encoder.uploadToTexture(staging, _physicalTexture, desc) && recorded;
+        }
+        _staging = std::move(staging);
+    }
+
+    if (_dirtyBegin < _dirtyEnd) {
+        const auto* entries = reinterpret_cast<const std::byte*>(_pageTable.data() + _dirtyBegin);
+        if (!queue->writeBuffer(_pageTableBuffer, uint64_t(_dirtyBegin) * sizeof(uint32_t),
+                                std::span<const std::byte>(entries, (_dirtyEnd - _dirtyBegin) * sizeof(uint32_t)))) {
+            LOG_ERROR("VirtualTexture", "Failed to write page table");
+            recorded = false;
+        }
+        _dirtyBegin = UINT32_MAX;
+        _dirtyEnd = 0;
+    }
+    return recorded;
+}
+
+std::string VirtualTexture::getShaderDeclarations(uint32_t group) const {
+    const std::string prefix = "@group(" + std::to_string(group) + ") ";
+    return std::string(TYPES_WGSL) +
+           prefix + "@binding(0) var<uniform> virtualTexture: VirtualTextureInfo;\n" +
+           prefix + "@binding(1) var<storage, read> virtualPageTable: array<u32>;\n" +
+           prefix + "@binding(2) var virtualCache: texture_2d<f32>;\n" +
+           prefix + "@binding(3) var virtualCacheSampler: sampler;\n" +
+           SHADING_FUNCTIONS;
+}
+
+} // namespace pers
@@ -0,0 +1,312 @@
+#include "pers/graphics/WeightedBlendedOit.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <utility>
+
+namespace pers {
+
+namespace {
+
+// Equation 10 of the paper, with view depth in scene units
+constexpr char TRANSPARENT_DECLARATIONS[] = R"(
+struct OitOutput {
+    @location(0) accumulation: vec4<f32>,
+    @location(1) revealage: f32,
+};
+
+fn oitWeight(viewDepth: f32, alpha: f32) -> f32 {
+    let z = abs(viewDepth);
+    return alpha * clamp(10.0 / (1e-5 + pow(z / 5.0, 2.0) + pow(z / 200.0, 6.0)), 1e-2, 3e3);
+}
+
+// color is premultiplied by its alpha
+fn oitOutput(color: vec4<f32>, viewDepth: f32) -> OitOutput {
+    var output: OitOutput;
+    output.accumulation = color * oitWeight(viewDepth, color.a);
+    output.revealage = color.a;
+    return output;
+}
+)";
+
+constexpr char COMPOSITE_VERTEX_SHADER[] = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    // Single triangle covering the viewport
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.0, 1.0);
+}
+)";
+
+constexpr char COMPOSITE_BINDINGS[] = R"(
+@group(0) @binding(0) var accumulation: texture_2d<f32>;
+@group(0) @binding(1) var revealage: texture_2d<f32>;
+
+fn loadAccumulation(texel: vec2<i32>, sampleIndex: u32) -> vec4<f32> {
+    return textureLoad(accumulation, texel, 0);
+}
+
+fn loadRevealage(texel: vec2<i32>, sampleIndex: u32) -> f32 {
+    return textureLoad(revealage, texel, 0).r;
+}
+)";
+
+constexpr char MULTISAMPLED_COMPOSITE_BINDINGS[] = R"(
+@group(0) @binding(0) var accumulation: texture_multisampled_2d<f32>;
+@group(0) @binding(1) var revealage: texture_multisampled_2d<f32>;
+
+fn loadAccumulation(texel: vec2<i32>, sampleIndex: u32) -> vec4<f32> {
+    return textureLoad(accumulation, texel, sampleIndex);
+}
+
+fn loadRevealage(texel: vec2<i32>, sampleIndex: u32) -> f32 {
+    return textureLoad(revealage, texel, sampleIndex).r;
+}
+)";
+
+// Blended with SrcAlpha / OneMinusSrcAlpha, so the scene keeps the revealed fraction
+constexpr char COMPOSITE_FRAGMENT_MAIN[] = R"(
+@fragment
+fn main(@builtin(position) position: vec4<f32>, @builtin(sample_index) sampleIndex: u32) -> @location(0) vec4<f32> {
+    let texel = vec2<i32>(position.xy);
+    let revealed = loadRevealage(texel, sampleIndex);
+    if (revealed >= 0.9999) {
+        discard;
+    }
+
+    // Half floats overflow to infinity under many bright near layers
+    let sum = min(loadAccumulation(texel, sampleIndex), vec4<f32>(65504.0));
+    return vec4<f32>(sum.rgb / max(sum.a, 1e-5), 1.0 - revealed);
+}
+)";
+
+std::shared_ptr<IShaderModule> createShader(IResourceFactory& factory, const std::string& code, ShaderStage stage,
+                                            const char* name) {
+    ShaderModuleDesc desc;
+    desc.code = code;
+    desc.stage = stage;
+    desc.entryPoint = "main";
+    desc.debugName = name;
+    auto shader = factory.createShaderModule(desc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("WeightedBlendedOit", "Failed to create composite shader");
+        return nullptr;
+    }
+    return shader;
+}
+
+std::shared_ptr<IBindGroupLayout> createLayout(IResourceFactory& factory, bool multisampled) {
+    // Read with textureLoad; multisampled float textures cannot be filterable
+    BindGroupLayoutDesc desc;
+    desc.debugName = "WeightedBlendedOit";
+    desc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::UnfilterableFloat, .multisampled = multisampled},
+        {.binding = 1, .visibility = ShaderStage::Fragment, .type = BindingType::SampledTexture,
+         .sampleType = TextureSampleType::UnfilterableFloat, .multisampled = multisampled},
+    };
+    auto layout = factory.createBindGroupLayout(desc);
+    if (!layout) {
+        LOG_ERROR("WeightedBlendedOit", "Failed to create bind group layout");
+    }
+    return layout;
+}
+
+std::shared_ptr<IPipelineLayout> createPipelineLayout(IResourceFactory& factory,
+                                                      const std::shared_ptr<IBindGroupLayout>& layout) {
+    if (!layout) {
+        return nullptr;
+    }
+    PipelineLayoutDesc desc;
+    desc.bindGroupLayouts = {layout};
+    desc.debugName = "WeightedBlendedOit";
+    auto pipelineLayout = factory.createPipelineLayout(desc);
+    if (!pipelineLayout) {
+        LOG_ERROR("WeightedBlendedOit", "Failed to create pipeline layout");
+    }
+    return pipelineLayout;
+}
+
+} // anonymous namespace
+
+WeightedBlendedOit::WeightedBlendedOit(const std::shared_ptr<ILogicalDevice>& device)
+    : _device(device) {
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        LOG_ERROR("WeightedBlendedOit", "Device or resource factory is null");
+        return;
+    }
+
+    _vertexShader = createShader(*factory, COMPOSITE_VERTEX_SHADER, ShaderStage::Vertex, "OitComposite");
+    _fragmentShader = createShader(*factory, std::string(COMPOSITE_BINDINGS) + COMPOSITE_FRAGMENT_MAIN,
+                                   ShaderStage::Fragment, "OitComposite");
+    _multisampledFragmentShader = createShader(*factory,
+                                               std::string(MULTISAMPLED_COMPOSITE_BINDINGS) + COMPOSITE_FRAGMENT_MAIN,
+                                               ShaderStage::Fragment, "OitCompositeMultisampled");
+    if (!_vertexShader || !_fragmentShader || !_multisampledFragmentShader) {
+        return;
+    }
+
+    auto layout = createLayout(*factory, false);
+    _multisampledLayout = createLayout(*factory, true);
+    _pipelineLayout = createPipelineLayout(*factory, layout);
+    _multisampledPipelineLayout = createPipelineLayout(*factory, _multisampledLayout);
+    if (_pipelineLayout && _multisampledPipelineLayout) {
+        _compositeLayout = std::move(layout);
+    }
+}
+
+WeightedBlendedOit::~WeightedBlendedOit() = default;
+
+void WeightedBlendedOit::configureTransparentPipeline(RenderPipelineDesc& desc, const Target& target) {
+    desc.colorTargets.resize(2);
+
+    // Sum of weighted premultiplied color and of weighted alpha
+    ColorTargetState& accumulation = desc.colorTargets[0];
+    accumulation.format = ACCUMULATION_FORMAT;
+    accumulation.writeMask = ColorWriteMask::All;
+    accumulation.blendEnabled = true;
+    accumulation.blend.color = {BlendOperation::Add, BlendFactor::One, BlendFactor::One};
+    accumulation.blend.alpha = {BlendOperation::Add, BlendFactor::One, BlendFactor::One};
+
+    // Product of (1 - alpha), cleared to 1
+    ColorTargetState& revealage = desc.colorTargets[1];
+    revealage.format = REVEALAGE_FORMAT;
+    revealage.writeMask = ColorWriteMask::Red;
+    revealage.blendEnabled = true;
+    revealage.blend.color = {BlendOperation::Add, BlendFactor::Zero, BlendFactor::OneMinusSrc};
+    revealage.blend.alpha = {BlendOperation::Add, BlendFactor::Zero, BlendFactor::OneMinusSrc};
+
+    desc.depthStencil.format = target.depthFormat;
+    desc.depthStencil.depthWriteEnabled = false;
+    desc.multisample.count = target.sampleCount;
+    desc.multisample.alphaToCoverageEnabled = false;
+}
+
+std::string WeightedBlendedOit::getShaderDeclarations() {
+    return TRANSPARENT_DECLARATIONS;
+}
+
+void WeightedBlendedOit::addToGraph(RenderGraph& graph, RenderGraphTexture color, RenderGraphTexture depth,
+                                    const Target& target, uint32_t width, uint32_t height, DrawFunction draw) {
+    const auto accumulation = graph.createTexture({.width = width, .height = height,
+                                                   .format = ACCUMULATION_FORMAT, .sampleCount = target.sampleCount,
+                                                   .usage = TextureUsage::TextureBinding,
+                                                   .label = "OitAccumulation"});
+    const auto revealage = graph.createTexture({.width = width, .height = height,
+                                                .format = REVEALAGE_FORMAT, .sampleCount = target.sampleCount,
+                                                .usage = TextureUsage::TextureBinding,
+                                                .label = "OitRevealage"});
+
+    graph.addPass("OIT::Transparent", [=](RenderGraphBuilder& builder) {
+        builder.writeColor(accumulation, Color{0.0f, 0.0f, 0.0f, 0.0f});
+        builder.writeColor(revealage, Color{1.0f, 1.0f, 1.0f, 1.0f});
+        if (depth) {
+            builder.readDepth(depth);
+        }
+    }, [draw = std::move(draw)](RenderGraphContext& context) {
+        if (draw) {
+            draw(*context.getRenderPass());
+        }
+    });
+
+    graph.addPass("OIT::Composite", [=](RenderGraphBuilder& builder) {
+        builder.read(accumulation);
+        builder.read(revealage);
+        builder.writeColor(color);
+    }, [this, target, accumulation, revealage](RenderGraphContext& context) {
+        composite(*context.getRenderPass(), target, context.getTextureView(accumulation),
+                  context.getTextureView(revealage));
+    });
+}
+
+bool WeightedBlendedOit::composite(IRenderPassEncoder& pass, const Target& target,
+                                   const std::shared_ptr<ITextureView>& accumulation,
+                                   const std::shared_ptr<ITextureView>& revealage) {
+    PERS_PROFILE_SCOPE("WeightedBlendedOit::composite");
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory || !isValid()) {
+        LOG_ERROR("WeightedBlendedOit", "Cannot composite with an invalid OIT resolver");
+        return false;
+    }
+
+    if (!accumulation || !revealage) {
+        LOG_ERROR("WeightedBlendedOit", "Accumulation and revealage views are required");
+        return false;
+    }
+
+    auto pipeline = getCompositePipeline(target);
+    if (!pipeline) {
+        return false;
+    }
+
+    // Shared through the factory's cache while the graph keeps handing out the same textures
+    BindGroupDesc bindGroupDesc;
+    bindGroupDesc.layout = target.sampleCount > 1 ? _multisampledLayout : _compositeLayout;
+    bindGroupDesc.debugName = "WeightedBlendedOit";
+    bindGroupDesc.entries.resize(2);
+    bindGroupDesc.entries[0].binding = 0;
+    bindGroupDesc.entries[0].textureView = accumulation;
+    bindGroupDesc.entries[1].binding = 1;
+    bindGroupDesc.entries[1].textureView = revealage;
+    auto bindGroup = factory->createBindGroup(bindGroupDesc);
+    if (!bindGroup) {
+        LOG_ERROR("WeightedBlendedOit", "Failed to create composite bind group");
+        return false;
+    }
+
+    pass.setPipeline(pipeline);
+    pass.setBindGroup(0, bindGroup);
+    pass.draw(3);
+    return true;
+}
+
+std::shared_ptr<IRenderPipeline> WeightedBlendedOit::getCompositePipeline(const Target& target) {
+    for (const PipelineEntry& entry : _pipelines) {
+        if (entry.target == target) {
+            return entry.pipeline;
+        }
+    }
+
+    auto device = _device.lock();
+    auto factory = device ? device->getResourceFactory() : nullptr;
+    if (!factory) {
+        return nullptr;
+    }
+
+    const bool multisampled = target.sampleCount > 1;
+    RenderPipelineDesc desc;
+    desc.vertex = _vertexShader;
+    desc.fragment = multisampled ? _multisampledFragmentShader : _fragmentShader;
+    desc.layout = multisampled ? _multisampledPipelineLayout : _pipelineLayout;
+    desc.primitive.topology = PrimitiveTopology::TriangleList;
+
+    // The composite pass binds only the scene color
+    desc.depthStencil.format = TextureFormat::Undefined;
+    desc.multisample.count = target.sampleCount;
+    desc.colorTargets.resize(1);
+    desc.colorTargets[0].format = target.colorFormat;
+    desc.colorTargets[0].blendEnabled = true;
+    desc.colorTargets[0].blend.color = {BlendOperation::Add, BlendFactor::SrcAlpha, BlendFactor::OneMinusSrcAlpha};
+    desc.colorTargets[0].blend.alpha = {BlendOperation::Add, BlendFactor::Zero, BlendFactor::One};
+    desc.debugName = "WeightedBlendedOit::Composite";
+
+    auto pipeline = factory->createRenderPipeline(desc);
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("WeightedBlendedOit", "Failed to create composite pipeline");
+        return nullptr;
+    }
+
+    _pipelines.push_back({target, pipeline});
+    return pipeline;
+}
+
+} // namespace pers
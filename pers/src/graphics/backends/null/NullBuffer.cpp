@@ -0,0 +1,129 @@
+#include "pers/graphics/backends/null/NullBuffer.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+NullBuffer::NullBuffer(const BufferDesc& desc)
+    : _desc(desc) {
+    
+    if (!desc.isValid()) {
+        LOG_ERROR("NullBuffer", "Invalid buffer description");
+        return;
+    }
+    
+    _allocation = GpuMemoryTracker::instance().allocate(GpuMemoryTracker::categorize(_desc.usage),
+                                                        _desc.size, _desc.debugName);
+    _valid = true;
+}
+
+NativeBufferHandle NullBuffer::getNativeHandle() const {
+    return _valid ? makeNullHandle<NativeBufferHandle>(this) : NativeBufferHandle::fromBackend(nullptr);
+}
+
+BufferState NullBuffer::getState() const {
+    return _valid ? BufferState::Ready : BufferState::Uninitialized;
+}
+
+NullMappableBuffer::NullMappableBuffer(const BufferDesc& desc)
+    : _desc(desc) {
+    
+    if (!desc.isValid()) {
+        LOG_ERROR("NullMappableBuffer", "Invalid buffer description");
+        return;
+    }
+    
+    _allocation = GpuMemoryTracker::instance().allocate(GpuMemoryTracker::categorize(_desc.usage),
+                                                        _desc.size, _desc.debugName);
+    _storage.reset(new uint8_t[_desc.size]);
+    
+    if (_desc.mappedAtCreation) {
+        _isMapped = true;
+        _mappedOffset = 0;
+        _mappedSize = _desc.size;
+    }
+}
+
+void* NullMappableBuffer::getMappedData() {
+    return _isMapped ? _storage.get() + _mappedOffset : nullptr;
+}
+
+const void* NullMappableBuffer::getMappedData() const {
+    return _isMapped ? _storage.get() + _mappedOffset : nullptr;
+}
+
+MappedData NullMappableBuffer::map(const BufferMapRange& range) {
+    if (!_storage) {
+        return MappedData{nullptr, 0, nullptr};
+    }
+    
+    if (_isMapped) {
+        LOG_WARNING("NullMappableBuffer", "Buffer is already mapped");
+        return MappedData{_storage.get() + _mappedOffset, _mappedSize, nullptr};
+    }
+    
+    uint64_t offset = range.offset;
+    uint64_t size = range.size;
+    if (offset > _desc.size) {
+        LOG_ERROR("NullMappableBuffer", "Map offset exceeds buffer size");
+        return MappedData{nullptr, 0, nullptr};
+    }
+    
+    if (size == BufferMapRange::WHOLE_BUFFER) {
+        size = _desc.size - offset;
+    }
+    
+    if (size > _desc.size - offset) {
+        LOG_ERROR("NullMappableBuffer", "Map range exceeds buffer size");
+        return MappedData{nullptr, 0, nullptr};
+    }
+    
+    _mappedOffset = offset;
+    _mappedSize = size;
+    _isMapped = true;
+    return MappedData{_storage.get() + offset, size, nullptr};
+}
+
+std::future<MappedData> NullMappableBuffer::mapAsync(MapMode mode, const BufferMapRange& range) {
+    std::promise<MappedData> promise;
+    promise.set_value(map(range));
+    return promise.get_future();
+}
+
+bool NullMappableBuffer::mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) {
+    if (!callback) {
+        LOG_ERROR("NullMappableBuffer", "Map callback is null");
+        return false;
+    }
+    
+    MappedData mapped = map(range);
+    const bool success = mapped.data() != nullptr;
+    callback(std::move(mapped));
+    return success;
+}
+
+void NullMappableBuffer::unmap() {
+    // Use atomic exchange to ensure unmap is only called once
+    if (!_isMapped.exchange(false)) {
+        return;
+    }
+    
+    _mappedOffset = 0;
+    _mappedSize = 0;
+}
+
+NativeBufferHandle NullMappableBuffer::getNativeHandle() const {
+    return _storage ? makeNullHandle<NativeBufferHandle>(this) : NativeBufferHandle::fromBackend(nullptr);
+}
+
+BufferState NullMappableBuffer::getState() const {
+    if (!_storage) {
+        return BufferState::Uninitialized;
+    }
+    if (_isMapped) {
+        return BufferState::Mapped;
+    }
+    return BufferState::Ready;
+}
+
+} // namespace pers
@@ -0,0 +1,520 @@
+#include "pers/graphics/backends/null/NullCommandEncoder.h"
+#include "pers/graphics/backends/null/NullRenderPassEncoder.h"
+#include "pers/graphics/backends/null/NullComputePassEncoder.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/IQuerySet.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/PoolAllocator.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+
+namespace pers {
+
+NullCommandEncoder::NullCommandEncoder(bool multiDrawIndirect, bool multiDrawIndirectCount)
+    : _multiDrawIndirect(multiDrawIndirect)
+    , _multiDrawIndirectCount(multiDrawIndirectCount) {
+}
+
+bool NullCommandEncoder::canEncode(const char* operation) const {
+    if (_finished) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on finished encoder", operation);
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<IRenderPassEncoder> NullCommandEncoder::beginRenderPass(const RenderPassDesc& desc) {
+    PERS_PROFILE_SCOPE("NullCommandEncoder::beginRenderPass");
+    if (!canEncode("begin render pass")) {
+        return nullptr;
+    }
+    
+    for (const auto& attachment : desc.colorAttachments) {
+        if (!attachment.view) {
+            LOG_ERROR("NullCommandEncoder", "Color attachment has null view");
+            return nullptr;
+        }
+    }
+    
+    if (desc.occlusionQuerySet && desc.occlusionQuerySet->getType() != QueryType::Occlusion) {
+        LOG_WARNING("NullCommandEncoder", "Render pass occlusionQuerySet is not an occlusion query set, ignored");
+    }
+    
+    return makePooledShared<NullRenderPassEncoder>(desc.resourceTable, _multiDrawIndirect, _multiDrawIndirectCount);
+}
+
+std::shared_ptr<IRenderPassEncoder> NullCommandEncoder::beginRenderPass(const IPreparedRenderPass& pass) {
+    PERS_PROFILE_SCOPE("NullCommandEncoder::beginRenderPass");
+    if (!canEncode("begin render pass")) {
+        return nullptr;
+    }
+    
+    // Prepared passes only come from NullResourceFactory on this backend
+    const auto& prepared = static_cast<const NullPreparedRenderPass&>(pass);
+    if (!prepared.isComplete()) {
+        LOG_ERROR("NullCommandEncoder", "Prepared render pass has a color attachment without a view");
+        return nullptr;
+    }
+    
+    return makePooledShared<NullRenderPassEncoder>(prepared.getDesc().resourceTable,
+                                                   _multiDrawIndirect, _multiDrawIndirectCount);
+}
+
+std::shared_ptr<IComputePassEncoder> NullCommandEncoder::beginComputePass(const ComputePassDesc& desc) {
+    if (!canEncode("begin compute pass")) {
+        return nullptr;
+    }
+    return makePooledShared<NullComputePassEncoder>();
+}
+
+bool NullCommandEncoder::uploadToDeviceBuffer(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                                              const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                                              const BufferCopyDesc& copyDesc) {
+    if (!stagingBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Staging buffer is null");
+        return false;
+    }
+    
+    if (!deviceBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Device buffer is null");
+        return false;
+    }
+    
+    if (!stagingBuffer->isFinalized()) {
+        LOG_WARNING("NullCommandEncoder", "Staging buffer not finalized, finalizing now");
+        stagingBuffer->finalize();
+    }
+    
+    if (!copyBufferToBuffer(stagingBuffer, deviceBuffer, copyDesc)) {
+        return false;
+    }
+    
+    static MetricCounter& uploadBytes = Metrics::counter("pers_staging_upload_bytes_total",
+                                                         "Bytes copied from staging to device buffers");
+    uploadBytes.add(static_cast<int64_t>(copyDesc.size != BufferCopyDesc::WHOLE_SIZE
+        ? copyDesc.size
+        : std::min(stagingBuffer->getSize() - copyDesc.srcOffset, deviceBuffer->getSize() - copyDesc.dstOffset)));
+    return true;
+}
+
+bool NullCommandEncoder::downloadFromDeviceBuffer(const std::shared_ptr<DeviceBuffer>& deviceBuffer,
+                                                  const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                                  const BufferCopyDesc& copyDesc) {
+    if (!deviceBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Device buffer is null");
+        return false;
+    }
+    
+    if (!readbackBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Readback buffer is null");
+        return false;
+    }
+    
+    if (readbackBuffer->isMapped()) {
+        LOG_WARNING("NullCommandEncoder", "Readback buffer is mapped, unmapping now");
+        readbackBuffer->unmap();
+    }
+    
+    return copyBufferToBuffer(deviceBuffer, readbackBuffer, copyDesc);
+}
+
+bool NullCommandEncoder::downloadFromDeviceBuffer(const std::shared_ptr<ImmediateDeviceBuffer>& deviceBuffer,
+                                                  const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                                  const BufferCopyDesc& copyDesc) {
+    if (!deviceBuffer) {
+        LOG_ERROR("NullCommandEncoder", "ImmediateDevice buffer is null");
+        return false;
+    }
+    
+    if (!readbackBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Readback buffer is null");
+        return false;
+    }
+    
+    if (readbackBuffer->isMapped()) {
+        LOG_WARNING("NullCommandEncoder", "Readback buffer is mapped, unmapping now");
+        readbackBuffer->unmap();
+    }
+    
+    return copyBufferToBuffer(deviceBuffer, readbackBuffer, copyDesc);
+}
+
+bool NullCommandEncoder::uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                                         const std::shared_ptr<ITexture>& texture,
+                                         const TextureUploadDesc& desc) {
+    if (!stagingBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Staging buffer is null");
+        return false;
+    }
+    
+    if (!stagingBuffer->isFinalized()) {
+        LOG_WARNING("NullCommandEncoder", "Staging buffer not finalized, finalizing now");
+        stagingBuffer->finalize();
+    }
+    
+    return validateBufferTextureCopy(*stagingBuffer, texture, TextureUsage::CopyDst, desc.mipLevel,
+                                     desc.originX, desc.originY, desc.width, desc.height,
+                                     desc.bytesPerRow, desc.bufferOffset, "Texture upload");
+}
+
+bool NullCommandEncoder::copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                                             const std::shared_ptr<ITexture>& texture,
+                                             const TextureUploadDesc& desc) {
+    if (!source) {
+        LOG_ERROR("NullCommandEncoder", "Source device buffer is null");
+        return false;
+    }
+    
+    if (!hasFlag(source->getUsage(), BufferUsage::CopySrc)) {
+        LOG_ERROR("NullCommandEncoder", "Source device buffer lacks CopySrc usage");
+        return false;
+    }
+    
+    return validateBufferTextureCopy(*source, texture, TextureUsage::CopyDst, desc.mipLevel,
+                                     desc.originX, desc.originY, desc.width, desc.height,
+                                     desc.bytesPerRow, desc.bufferOffset, "Texture upload");
+}
+
+bool NullCommandEncoder::downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                                             const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                             const TextureReadbackDesc& desc) {
+    if (!readbackBuffer) {
+        LOG_ERROR("NullCommandEncoder", "Readback buffer is null");
+        return false;
+    }
+    
+    if (readbackBuffer->isMapped()) {
+        LOG_WARNING("NullCommandEncoder", "Readback buffer is mapped, unmapping now");
+        readbackBuffer->unmap();
+    }
+    
+    return validateBufferTextureCopy(*readbackBuffer, texture, TextureUsage::CopySrc, desc.mipLevel,
+                                     desc.originX, desc.originY, desc.width, desc.height,
+                                     desc.bytesPerRow, desc.bufferOffset, "Texture readback");
+}
+
+bool NullCommandEncoder::copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                                             const std::shared_ptr<DeviceBuffer>& destination,
+                                             const TextureReadbackDesc& desc) {
+    if (!destination) {
+        LOG_ERROR("NullCommandEncoder", "Destination device buffer is null");
+        return false;
+    }
+    
+    if (!hasFlag(destination->getUsage(), BufferUsage::CopyDst)) {
+        LOG_ERROR("NullCommandEncoder", "Destination device buffer lacks CopyDst usage");
+        return false;
+    }
+    
+    return validateBufferTextureCopy(*destination, texture, TextureUsage::CopySrc, desc.mipLevel,
+                                     desc.originX, desc.originY, desc.width, desc.height,
+                                     desc.bytesPerRow, desc.bufferOffset, "Texture readback");
+}
+
+bool NullCommandEncoder::validateBufferTextureCopy(const IBuffer& buffer,
+                                                   const std::shared_ptr<ITexture>& texture,
+                                                   TextureUsage requiredUsage,
+                                                   uint32_t mipLevel, uint32_t originX, uint32_t originY,
+                                                   uint32_t width, uint32_t height,
+                                                   uint32_t bytesPerRow, uint64_t bufferOffset,
+                                                   const char* operation) {
+    if (!canEncode("copy texture")) {
+        return false;
+    }
+    
+    if (!texture) {
+        LOG_ERROR("NullCommandEncoder", "Texture is null");
+        return false;
+    }
+    
+    if ((texture->getUsage() & requiredUsage) == TextureUsage::None) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s texture lacks %s usage", operation, requiredUsage == TextureUsage::CopyDst ? "CopyDst" : "CopySrc");
+        return false;
+    }
+    
+    if (mipLevel >= texture->getMipLevelCount()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s mip level out of range", operation);
+        return false;
+    }
+    
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(texture->getFormat());
+    if (block.blockBytes == 0) {
+        LOG_ERROR("NullCommandEncoder", "Texture format cannot be copied to or from a buffer");
+        return false;
+    }
+    
+    uint32_t mipWidth = std::max(1u, texture->getWidth() >> mipLevel);
+    uint32_t mipHeight = std::max(1u, texture->getHeight() >> mipLevel);
+    if (originX >= mipWidth || originY >= mipHeight) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s origin outside of mip level", operation);
+        return false;
+    }
+    
+    uint32_t extentWidth = width ? width : mipWidth - originX;
+    uint32_t extentHeight = height ? height : mipHeight - originY;
+    if (originX + extentWidth > mipWidth || originY + extentHeight > mipHeight) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s region exceeds mip level", operation);
+        return false;
+    }
+    
+    uint32_t blocksWide = (extentWidth + block.blockWidth - 1) / block.blockWidth;
+    uint32_t blocksHigh = (extentHeight + block.blockHeight - 1) / block.blockHeight;
+    uint32_t rowBytes = blocksWide * block.blockBytes;
+    uint32_t rowPitch = bytesPerRow ? bytesPerRow : getTextureReadbackRowPitch(texture->getFormat(), extentWidth);
+    
+    if (rowPitch % TEXTURE_READBACK_ROW_ALIGNMENT != 0 || rowPitch < rowBytes) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s bytesPerRow must cover a row and be 256-byte aligned, got %u", operation, rowPitch);
+        return false;
+    }
+    
+    uint64_t requiredBytes = static_cast<uint64_t>(rowPitch) * (blocksHigh - 1) + rowBytes;
+    if (bufferOffset + requiredBytes > buffer.getSize()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullCommandEncoder", PERS_SOURCE_LOC,
+            "%s exceeds buffer size", operation);
+        return false;
+    }
+    return true;
+}
+
+bool NullCommandEncoder::copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                                              const std::shared_ptr<ITexture>& destination,
+                                              const TextureCopyDesc& desc) {
+    if (!canEncode("copy texture")) {
+        return false;
+    }
+    
+    if (!source || !destination) {
+        LOG_ERROR("NullCommandEncoder", "Source or destination texture is null");
+        return false;
+    }
+    
+    if ((source->getUsage() & TextureUsage::CopySrc) == TextureUsage::None) {
+        LOG_ERROR("NullCommandEncoder", "Source texture lacks CopySrc usage");
+        return false;
+    }
+    
+    if ((destination->getUsage() & TextureUsage::CopyDst) == TextureUsage::None) {
+        LOG_ERROR("NullCommandEncoder", "Destination texture lacks CopyDst usage");
+        return false;
+    }
+    
+    if (source->getFormat() != destination->getFormat() ||
+        source->getSampleCount() != destination->getSampleCount()) {
+        LOG_ERROR("NullCommandEncoder", "Texture copy needs matching formats and sample counts");
+        return false;
+    }
+    
+    if (desc.srcMipLevel >= source->getMipLevelCount() || desc.dstMipLevel >= destination->getMipLevelCount()) {
+        LOG_ERROR("NullCommandEncoder", "Texture copy mip level out of range");
+        return false;
+    }
+    
+    uint32_t srcWidth = std::max(1u, source->getWidth() >> desc.srcMipLevel);
+    uint32_t srcHeight = std::max(1u, source->getHeight() >> desc.srcMipLevel);
+    uint32_t dstWidth = std::max(1u, destination->getWidth() >> desc.dstMipLevel);
+    uint32_t dstHeight = std::max(1u, destination->getHeight() >> desc.dstMipLevel);
+    if (desc.srcX >= srcWidth || desc.srcY >= srcHeight) {
+        LOG_ERROR("NullCommandEncoder", "Texture copy origin outside of source mip level");
+        return false;
+    }
+    
+    uint32_t width = desc.width ? desc.width : srcWidth - desc.srcX;
+    uint32_t height = desc.height ? desc.height : srcHeight - desc.srcY;
+    if (desc.srcX + width > srcWidth || desc.srcY + height > srcHeight ||
+        desc.dstX + width > dstWidth || desc.dstY + height > dstHeight) {
+        LOG_ERROR("NullCommandEncoder", "Texture copy region exceeds a mip level");
+        return false;
+    }
+    return true;
+}
+
+bool NullCommandEncoder::copyDeviceToDevice(const std::shared_ptr<DeviceBuffer>& source,
+                                            const std::shared_ptr<DeviceBuffer>& destination,
+                                            const BufferCopyDesc& copyDesc) {
+    if (!source) {
+        LOG_ERROR("NullCommandEncoder", "Source device buffer is null");
+        return false;
+    }
+    
+    if (!destination) {
+        LOG_ERROR("NullCommandEncoder", "Destination device buffer is null");
+        return false;
+    }
+    
+    return copyBufferToBuffer(source, destination, copyDesc);
+}
+
+bool NullCommandEncoder::clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer,
+                                     uint64_t offset,
+                                     uint64_t size) {
+    if (!canEncode("clear buffer")) {
+        return false;
+    }
+    
+    if (!buffer) {
+        LOG_ERROR("NullCommandEncoder", "Buffer to clear is null");
+        return false;
+    }
+    
+    if (!hasFlag(buffer->getUsage(), BufferUsage::CopyDst)) {
+        LOG_ERROR("NullCommandEncoder", "Buffer to clear lacks CopyDst usage");
+        return false;
+    }
+    
+    if (offset > buffer->getSize()) {
+        LOG_ERROR("NullCommandEncoder", "Clear offset exceeds buffer size");
+        return false;
+    }
+    
+    if (size == BufferCopyDesc::WHOLE_SIZE) {
+        size = buffer->getSize() - offset;
+    }
+    
+    if (offset % 4 != 0 || size % 4 != 0 || offset + size > buffer->getSize()) {
+        LOG_ERROR("NullCommandEncoder", "Clear range must be 4-byte aligned and inside the buffer");
+        return false;
+    }
+    return true;
+}
+
+bool NullCommandEncoder::resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet,
+                                         uint32_t firstQuery,
+                                         uint32_t queryCount,
+                                         const std::shared_ptr<DeviceBuffer>& destination,
+                                         uint64_t destinationOffset) {
+    if (!canEncode("resolve queries")) {
+        return false;
+    }
+    
+    if (!querySet || !querySet->isValid()) {
+        LOG_ERROR("NullCommandEncoder", "Query set is null or invalid");
+        return false;
+    }
+    
+    if (!destination || !destination->isValid()) {
+        LOG_ERROR("NullCommandEncoder", "Query resolve destination is null or invalid");
+        return false;
+    }
+    
+    if (static_cast<uint64_t>(firstQuery) + queryCount > querySet->getCount()) {
+        LOG_ERROR("NullCommandEncoder", "Query resolve range exceeds query set count");
+        return false;
+    }
+    
+    const uint64_t QUERY_RESOLVE_ALIGNMENT = 256;
+    if (destinationOffset % QUERY_RESOLVE_ALIGNMENT != 0) {
+        LOG_ERROR_FMT("NullCommandEncoder",
+                      "Query resolve offset must be 256-byte aligned. offset={}", destinationOffset);
+        return false;
+    }
+    
+    const uint64_t resultSize = static_cast<uint64_t>(queryCount) * getQueryValueCount(querySet->getDesc()) * QUERY_RESULT_SIZE;
+    if (destinationOffset + resultSize > destination->getSize()) {
+        LOG_ERROR("NullCommandEncoder", "Query resolve range exceeds destination buffer size");
+        return false;
+    }
+    
+    if ((destination->getUsage() & BufferUsage::QueryResolve) == BufferUsage::None) {
+        LOG_ERROR("NullCommandEncoder", "Query resolve destination needs QueryResolve usage");
+        return false;
+    }
+    return true;
+}
+
+bool NullCommandEncoder::copyBufferToBuffer(const std::shared_ptr<IBuffer>& source,
+                                            const std::shared_ptr<IBuffer>& destination,
+                                            const BufferCopyDesc& copyDesc) {
+    if (!canEncode("copy buffers")) {
+        return false;
+    }
+    
+    if (!source) {
+        LOG_ERROR("NullCommandEncoder", "Source buffer is null");
+        return false;
+    }
+    
+    if (!destination) {
+        LOG_ERROR("NullCommandEncoder", "Destination buffer is null");
+        return false;
+    }
+    
+    if (!source->getNativeHandle().isValid()) {
+        LOG_ERROR("NullCommandEncoder", "Invalid source buffer handle");
+        return false;
+    }
+    
+    if (!destination->getNativeHandle().isValid()) {
+        LOG_ERROR("NullCommandEncoder", "Invalid destination buffer handle");
+        return false;
+    }
+    
+    uint64_t size = copyDesc.size;
+    if (size == BufferCopyDesc::WHOLE_SIZE) {
+        size = std::min(source->getSize() - copyDesc.srcOffset,
+                        destination->getSize() - copyDesc.dstOffset);
+    }
+    
+    if (copyDesc.srcOffset + size > source->getSize()) {
+        LOG_ERROR("NullCommandEncoder", "Copy source range exceeds buffer size");
+        return false;
+    }
+    
+    if (copyDesc.dstOffset + size > destination->getSize()) {
+        LOG_ERROR("NullCommandEncoder", "Copy destination range exceeds buffer size");
+        return false;
+    }
+    
+    // Same COPY_BUFFER_ALIGNMENT rules as the WebGPU backend
+    const uint64_t COPY_BUFFER_ALIGNMENT = 4;
+    if (copyDesc.srcOffset % COPY_BUFFER_ALIGNMENT != 0 || copyDesc.dstOffset % COPY_BUFFER_ALIGNMENT != 0) {
+        LOG_ERROR("NullCommandEncoder", "Copy offsets must be 4-byte aligned");
+        return false;
+    }
+    
+    uint64_t alignedSize = (size + COPY_BUFFER_ALIGNMENT - 1) / COPY_BUFFER_ALIGNMENT * COPY_BUFFER_ALIGNMENT;
+    if (alignedSize != size) {
+        if (copyDesc.srcOffset + alignedSize > source->getSize() ||
+            copyDesc.dstOffset + alignedSize > destination->getSize()) {
+            LOG_ERROR("NullCommandEncoder",
+                      "Cannot align copy size to " + std::to_string(alignedSize) +
+                      " bytes - would exceed buffer bounds");
+            return false;
+        }
+        
+        LOG_WARNING("NullCommandEncoder",
+                    "Aligned copy size from " + std::to_string(size) +
+                    " to " + std::to_string(alignedSize) + " bytes for 4-byte alignment");
+    }
+    return true;
+}
+
+std::shared_ptr<ICommandBuffer> NullCommandEncoder::finish() {
+    PERS_PROFILE_SCOPE("NullCommandEncoder::finish");
+    if (_finished) {
+        LOG_ERROR("NullCommandEncoder", "Encoder already finished");
+        return nullptr;
+    }
+    
+    _finished = true;
+    return makePooledShared<NullCommandBuffer>();
+}
+
+NativeEncoderHandle NullCommandEncoder::getNativeEncoderHandle() const {
+    return makeNullHandle<NativeEncoderHandle>(this);
+}
+
+} // namespace pers
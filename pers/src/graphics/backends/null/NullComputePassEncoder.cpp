@@ -0,0 +1,154 @@
+#include "pers/graphics/backends/null/NullComputePassEncoder.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IQuerySet.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+
+namespace pers {
+
+NullComputePassEncoder::~NullComputePassEncoder() {
+    if (!_ended) {
+        LOG_WARNING("NullComputePassEncoder", "Compute pass encoder destroyed without calling end()");
+        end();
+    }
+}
+
+void NullComputePassEncoder::setPipeline(const std::shared_ptr<IComputePipeline>& pipeline) {
+    if (!canEncode("set pipeline")) {
+        return;
+    }
+    
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("NullComputePassEncoder", "Invalid compute pipeline");
+        return;
+    }
+    
+    _hasPipeline = true;
+}
+
+void NullComputePassEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                          std::span<const uint32_t> dynamicOffsets) {
+    if (!canEncode("set bind group")) {
+        return;
+    }
+    
+    if (!bindGroup) {
+        LOG_ERROR("NullComputePassEncoder", "Bind group is null");
+    }
+}
+
+void NullComputePassEncoder::setPushConstants(uint32_t offset, std::span<const std::byte> data) {
+    if (!canEncode("set push constants")) {
+        return;
+    }
+    
+    if (data.empty() || offset % 4 != 0 || data.size() % 4 != 0) {
+        LOG_ERROR("NullComputePassEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+    }
+}
+
+void NullComputePassEncoder::dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY,
+                                      uint32_t workgroupCountZ) {
+    if (!canEncode("dispatch")) {
+        return;
+    }
+    
+    if (!_hasPipeline) {
+        LOG_ERROR("NullComputePassEncoder", "Cannot dispatch without a pipeline");
+        return;
+    }
+    
+    ++_dispatches;
+}
+
+void NullComputePassEncoder::dispatchIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!canEncode("dispatch indirect")) {
+        return;
+    }
+    
+    if (!_hasPipeline) {
+        LOG_ERROR("NullComputePassEncoder", "Cannot dispatch without a pipeline");
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("NullComputePassEncoder", "Invalid indirect buffer - native handle is null");
+        return;
+    }
+    
+    if (indirectOffset % 4 != 0 || indirectOffset + sizeof(DispatchIndirectArgs) > indirectBuffer->getSize()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullComputePassEncoder", PERS_SOURCE_LOC,
+            "Indirect offset %llu exceeds buffer %s or is misaligned",
+            static_cast<unsigned long long>(indirectOffset), indirectBuffer->getDebugName().c_str());
+        return;
+    }
+    
+    ++_dispatches;
+}
+
+void NullComputePassEncoder::beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet,
+                                                          uint32_t queryIndex) {
+    if (!canEncode("begin pipeline statistics query")) {
+        return;
+    }
+    
+    if (!querySet || querySet->getType() != QueryType::PipelineStatistics) {
+        LOG_ERROR("NullComputePassEncoder", "Query set is null or not a pipeline statistics query set");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("NullComputePassEncoder", "Pipeline statistics queries cannot nest");
+        return;
+    }
+    _statisticsQueryOpen = true;
+}
+
+void NullComputePassEncoder::endPipelineStatisticsQuery() {
+    if (!canEncode("end pipeline statistics query")) {
+        return;
+    }
+    
+    if (!_statisticsQueryOpen) {
+        LOG_ERROR("NullComputePassEncoder", "No pipeline statistics query to end");
+        return;
+    }
+    _statisticsQueryOpen = false;
+}
+
+void NullComputePassEncoder::end() {
+    if (_ended) {
+        LOG_WARNING("NullComputePassEncoder", "Compute pass already ended");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("NullComputePassEncoder", "Compute pass ended with a query still open");
+    }
+    _ended = true;
+    
+    static MetricCounter& dispatches = Metrics::counter("pers_dispatches_total", "Compute dispatches recorded");
+    dispatches.add(_dispatches);
+    
+    Logger::Instance().LogFormat(LogLevel::Debug, "NullComputePassEncoder", PERS_SOURCE_LOC,
+        "Pass ended: %u dispatches", _dispatches);
+}
+
+NativeComputePassEncoderHandle NullComputePassEncoder::getNativeComputePassEncoderHandle() const {
+    return makeNullHandle<NativeComputePassEncoderHandle>(this);
+}
+
+bool NullComputePassEncoder::canEncode(const char* operation) const {
+    if (_ended) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullComputePassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on ended compute pass", operation);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,34 @@
+#include "pers/graphics/backends/null/NullInstance.h"
+#include "pers/graphics/backends/null/NullPhysicalDevice.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+bool NullInstance::initialize(const InstanceDesc& desc) {
+    _desc = desc;
+    _physicalDevice = std::make_shared<NullPhysicalDevice>();
+    LOG_INFO("NullInstance", "Null instance created");
+    return true;
+}
+
+std::shared_ptr<IPhysicalDevice> NullInstance::requestPhysicalDevice(
+    const PhysicalDeviceOptions& options) {
+    return _physicalDevice;
+}
+
+std::vector<std::shared_ptr<IPhysicalDevice>> NullInstance::enumeratePhysicalDevices() {
+    if (!_physicalDevice) {
+        return {};
+    }
+    return {_physicalDevice};
+}
+
+NativeSurfaceHandle NullInstance::createSurface(void* windowHandle) {
+    LOG_ERROR("NullInstance", "The null backend cannot create surfaces");
+    return NativeSurfaceHandle::fromBackend(nullptr);
+}
+
+void NullInstance::processEvents() {
+}
+
+} // namespace pers
@@ -0,0 +1,26 @@
+#include "pers/graphics/backends/null/NullInstanceFactory.h"
+#include "pers/graphics/backends/null/NullInstance.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+std::shared_ptr<IInstance> NullInstanceFactory::createInstance(
+    const InstanceDesc& desc) {
+    
+    LOG_INFO("NullInstanceFactory", "Creating null instance...");
+    
+    auto instance = std::make_shared<NullInstance>();
+    if (!instance->initialize(desc)) {
+        LOG_ERROR("NullInstanceFactory", "Failed to initialize null instance");
+        return nullptr;
+    }
+    
+    return instance;
+}
+
+const std::string& NullInstanceFactory::getBackendName() const {
+    static const std::string name = "Null";
+    return name;
+}
+
+} // namespace pers
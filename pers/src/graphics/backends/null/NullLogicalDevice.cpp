@@ -0,0 +1,103 @@
+#include "pers/graphics/backends/null/NullLogicalDevice.h"
+#include "pers/graphics/backends/null/NullQueue.h"
+#include "pers/graphics/backends/null/NullCommandEncoder.h"
+#include "pers/graphics/backends/null/NullRenderBundleEncoder.h"
+#include "pers/graphics/backends/null/NullResourceFactory.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/PoolAllocator.h"
+
+namespace pers {
+
+NullLogicalDevice::NullLogicalDevice(const std::shared_ptr<IPhysicalDevice>& physicalDevice,
+                                     const DeviceLimits& limits,
+                                     const std::vector<DeviceFeature>& features)
+    : _physicalDevice(physicalDevice)
+    , _limits(limits)
+    , _defaultQueue(std::make_shared<NullQueue>()) {
+    
+    for (DeviceFeature feature : features) {
+        _features |= 1u << static_cast<uint32_t>(feature);
+    }
+    _deletionQueue = std::make_shared<DeferredDeletionQueue>(_defaultQueue);
+}
+
+NullLogicalDevice::~NullLogicalDevice() {
+    if (_deletionQueue) {
+        _deletionQueue->flush();
+        _deletionQueue.reset();
+    }
+    _stagingBufferPool.reset();
+    _defaultQueue.reset();
+}
+
+std::shared_ptr<IQueue> NullLogicalDevice::getQueue() const {
+    return _defaultQueue;
+}
+
+const std::shared_ptr<IResourceFactory>& NullLogicalDevice::getResourceFactory() const {
+    std::call_once(_resourceFactoryOnce, [this]() {
+        auto sharedThis = const_cast<NullLogicalDevice*>(this)->shared_from_this();
+        _resourceFactory = std::make_shared<NullResourceFactory>(sharedThis);
+    });
+    
+    return _resourceFactory;
+}
+
+const std::shared_ptr<StagingBufferPool>& NullLogicalDevice::getStagingBufferPool() const {
+    std::call_once(_stagingBufferPoolOnce, [this]() {
+        _stagingBufferPool = std::make_shared<StagingBufferPool>(getResourceFactory(), _defaultQueue);
+    });
+    
+    return _stagingBufferPool;
+}
+
+const std::shared_ptr<DeferredDeletionQueue>& NullLogicalDevice::getDeletionQueue() const {
+    return _deletionQueue;
+}
+
+std::shared_ptr<ICommandEncoder> NullLogicalDevice::createCommandEncoder() {
+    return makePooledShared<NullCommandEncoder>(hasFeature(DeviceFeature::MultiDrawIndirect),
+                                                hasFeature(DeviceFeature::MultiDrawIndirectCount));
+}
+
+std::shared_ptr<IRenderBundleEncoder> NullLogicalDevice::createRenderBundleEncoder(const RenderBundleEncoderDesc& desc) {
+    return std::make_shared<NullRenderBundleEncoder>(desc.label);
+}
+
+std::shared_ptr<ISwapChain> NullLogicalDevice::createSwapChain(
+    const NativeSurfaceHandle& surface,
+    const SwapChainDesc& desc) {
+    LOG_ERROR("NullLogicalDevice", "The null backend cannot create swap chains");
+    return nullptr;
+}
+
+void NullLogicalDevice::waitIdle() {
+    if (_defaultQueue) {
+        _defaultQueue->waitIdle();
+    }
+    
+    if (_deletionQueue) {
+        _deletionQueue->collect();
+    }
+}
+
+NativeDeviceHandle NullLogicalDevice::getNativeDeviceHandle() const {
+    return makeNullHandle<NativeDeviceHandle>(this);
+}
+
+DeviceLimits NullLogicalDevice::getLimits() const {
+    return _limits;
+}
+
+bool NullLogicalDevice::hasFeature(DeviceFeature feature) const {
+    return (_features & (1u << static_cast<uint32_t>(feature))) != 0;
+}
+
+std::shared_ptr<IPhysicalDevice> NullLogicalDevice::getPhysicalDevice() const {
+    return _physicalDevice.lock();
+}
+
+} // namespace pers
@@ -0,0 +1,142 @@
+#include "pers/graphics/backends/null/NullPhysicalDevice.h"
+#include "pers/graphics/backends/null/NullLogicalDevice.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+namespace {
+
+bool limitsWithin(const DeviceLimits& requested, const DeviceLimits& available) {
+    return requested.maxTextureDimension1D <= available.maxTextureDimension1D &&
+        requested.maxTextureDimension2D <= available.maxTextureDimension2D &&
+        requested.maxTextureDimension3D <= available.maxTextureDimension3D &&
+        requested.maxTextureArrayLayers <= available.maxTextureArrayLayers &&
+        requested.maxBindGroups <= available.maxBindGroups &&
+        requested.maxBindingsPerBindGroup <= available.maxBindingsPerBindGroup &&
+        requested.maxDynamicUniformBuffersPerPipelineLayout <= available.maxDynamicUniformBuffersPerPipelineLayout &&
+        requested.maxDynamicStorageBuffersPerPipelineLayout <= available.maxDynamicStorageBuffersPerPipelineLayout &&
+        requested.maxSampledTexturesPerShaderStage <= available.maxSampledTexturesPerShaderStage &&
+        requested.maxSamplersPerShaderStage <= available.maxSamplersPerShaderStage &&
+        requested.maxStorageBuffersPerShaderStage <= available.maxStorageBuffersPerShaderStage &&
+        requested.maxStorageTexturesPerShaderStage <= available.maxStorageTexturesPerShaderStage &&
+        requested.maxUniformBuffersPerShaderStage <= available.maxUniformBuffersPerShaderStage &&
+        requested.maxUniformBufferBindingSize <= available.maxUniformBufferBindingSize &&
+        requested.maxStorageBufferBindingSize <= available.maxStorageBufferBindingSize &&
+        requested.maxBufferSize <= available.maxBufferSize &&
+        requested.maxVertexBuffers <= available.maxVertexBuffers &&
+        requested.maxVertexAttributes <= available.maxVertexAttributes &&
+        requested.maxVertexBufferArrayStride <= available.maxVertexBufferArrayStride &&
+        requested.maxInterStageShaderVariables <= available.maxInterStageShaderVariables &&
+        requested.maxComputeWorkgroupStorageSize <= available.maxComputeWorkgroupStorageSize &&
+        requested.maxComputeInvocationsPerWorkgroup <= available.maxComputeInvocationsPerWorkgroup &&
+        requested.maxComputeWorkgroupSizeX <= available.maxComputeWorkgroupSizeX &&
+        requested.maxComputeWorkgroupSizeY <= available.maxComputeWorkgroupSizeY &&
+        requested.maxComputeWorkgroupSizeZ <= available.maxComputeWorkgroupSizeZ &&
+        requested.maxComputeWorkgroupsPerDimension <= available.maxComputeWorkgroupsPerDimension &&
+        requested.maxPushConstantSize <= available.maxPushConstantSize;
+}
+
+} // namespace
+
+NullPhysicalDevice::NullPhysicalDevice() {
+    // WebGPU spec defaults, what a conservative adapter grants without negotiation
+    _limits.maxTextureDimension1D = 8192;
+    _limits.maxTextureDimension2D = 8192;
+    _limits.maxTextureDimension3D = 2048;
+    _limits.maxTextureArrayLayers = 256;
+    _limits.maxBindGroups = 4;
+    _limits.maxBindingsPerBindGroup = 1000;
+    _limits.maxDynamicUniformBuffersPerPipelineLayout = 8;
+    _limits.maxDynamicStorageBuffersPerPipelineLayout = 4;
+    _limits.maxSampledTexturesPerShaderStage = 16;
+    _limits.maxSamplersPerShaderStage = 16;
+    _limits.maxStorageBuffersPerShaderStage = 8;
+    _limits.maxStorageTexturesPerShaderStage = 4;
+    _limits.maxUniformBuffersPerShaderStage = 12;
+    _limits.maxUniformBufferBindingSize = 65536;
+    _limits.maxStorageBufferBindingSize = 134217728;
+    _limits.maxBufferSize = 268435456;
+    _limits.maxVertexBuffers = 8;
+    _limits.maxVertexAttributes = 16;
+    _limits.maxVertexBufferArrayStride = 2048;
+    _limits.maxInterStageShaderVariables = 16;
+    _limits.maxComputeWorkgroupStorageSize = 16384;
+    _limits.maxComputeInvocationsPerWorkgroup = 256;
+    _limits.maxComputeWorkgroupSizeX = 256;
+    _limits.maxComputeWorkgroupSizeY = 256;
+    _limits.maxComputeWorkgroupSizeZ = 64;
+    _limits.maxComputeWorkgroupsPerDimension = 65535;
+    _limits.maxPushConstantSize = 128;
+    
+    _capabilities.deviceName = "Null Device";
+    _capabilities.driverInfo = "pers null backend";
+    _capabilities.vendorName = "pers";
+    _capabilities.architecture = "null";
+    _capabilities.supportsCompute = true;
+    _capabilities.supportsShaderF16 = true;
+    _capabilities.supportsTextureCompressionBC = true;
+    _capabilities.supportsTextureCompressionETC2 = true;
+    _capabilities.supportsTextureCompressionASTC = true;
+    _capabilities.supportsDepth32FloatStencil8 = true;
+    _capabilities.supportsDepthClipControl = true;
+    _capabilities.supportsRG11B10UfloatRenderable = true;
+    _capabilities.supportsBGRA8UnormStorage = true;
+    _capabilities.supportsFloat32Filterable = true;
+    _capabilities.supportsTimestampQuery = true;
+    _capabilities.supportsPipelineStatisticsQuery = true;
+    _capabilities.supportsIndirectFirstInstance = true;
+    _capabilities.supportsMultiDrawIndirect = true;
+    _capabilities.supportsMultiDrawIndirectCount = true;
+    _capabilities.supportsTextureBindingArray = true;
+    _capabilities.supportsBufferBindingArray = true;
+    _capabilities.supportsNonUniformIndexing = true;
+    _capabilities.isUnifiedMemory = true;
+    _capabilities.supportsMappablePrimaryBuffers = true;
+    _capabilities.supportsPushConstants = true;
+    _capabilities.maxPushConstantSize = _limits.maxPushConstantSize;
+    _capabilities.maxTextureSize2D = _limits.maxTextureDimension2D;
+    _capabilities.maxTextureSize3D = _limits.maxTextureDimension3D;
+    _capabilities.maxTextureLayers = _limits.maxTextureArrayLayers;
+}
+
+PhysicalDeviceCapabilities NullPhysicalDevice::getCapabilities() const {
+    return _capabilities;
+}
+
+std::vector<QueueFamily> NullPhysicalDevice::getQueueFamilies() const {
+    QueueFamily family;
+    family.index = 0;
+    family.queueCount = 1;
+    family.supportsGraphics = true;
+    family.supportsCompute = true;
+    family.supportsTransfer = true;
+    family.supportsSparse = false;
+    return {family};
+}
+
+bool NullPhysicalDevice::supportsSurface(const NativeSurfaceHandle& surface) const {
+    return false;
+}
+
+std::shared_ptr<ILogicalDevice> NullPhysicalDevice::createLogicalDevice(
+    const LogicalDeviceDesc& desc) {
+    
+    if (desc.requiredLimits && !limitsWithin(*desc.requiredLimits, _limits)) {
+        LOG_ERROR("NullPhysicalDevice", "Required limits exceed the null adapter limits");
+        return nullptr;
+    }
+    
+    std::vector<DeviceFeature> features = desc.requiredFeatures;
+    features.insert(features.end(), desc.preferredFeatures.begin(), desc.preferredFeatures.end());
+    
+    auto device = std::make_shared<NullLogicalDevice>(shared_from_this(), _limits, features);
+    LOG_INFO("NullPhysicalDevice", "Null logical device created");
+    return device;
+}
+
+NativeAdapterHandle NullPhysicalDevice::getNativeAdapterHandle() const {
+    return makeNullHandle<NativeAdapterHandle>(this);
+}
+
+} // namespace pers
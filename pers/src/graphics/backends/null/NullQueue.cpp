@@ -0,0 +1,333 @@
+#include "pers/graphics/backends/null/NullQueue.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+
+namespace pers {
+
+namespace {
+
+// Same series as WebGPUQueue so dashboards compare the backends directly
+struct QueueMetrics {
+    MetricCounter& submits = Metrics::counter("pers_queue_submits_total", "Queue submissions");
+    MetricCounter& commandBuffers = Metrics::counter("pers_command_buffers_submitted_total", "Command buffers submitted");
+    MetricCounter& writeBytes = Metrics::counter("pers_buffer_write_bytes_total", "Bytes uploaded with queue writeBuffer");
+};
+
+QueueMetrics& queueMetrics() {
+    static QueueMetrics metrics;
+    return metrics;
+}
+
+bool validateBufferWrite(const BufferWriteDesc& write) {
+    if (!write.buffer || !write.data || write.size == 0) {
+        LOG_ERROR("NullQueue", "Invalid buffer write parameters");
+        return false;
+    }
+    
+    if (!write.buffer->getNativeHandle().isValid()) {
+        LOG_ERROR("NullQueue", "Invalid buffer handle");
+        return false;
+    }
+    
+    if (write.offset > write.buffer->getSize() || write.size > write.buffer->getSize() - write.offset) {
+        LOG_ERROR("NullQueue", "Buffer write exceeds buffer size");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+NullQueue::NullQueue()
+    : _timeline(std::make_shared<SubmissionTimeline>()) {
+    _timeline->setFlushFunction([this](uint64_t value) {
+        uint64_t batchValue = 0;
+        {
+            auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+            batchValue = _batchValue;
+        }
+        if (batchValue != 0 && value >= batchValue) {
+            flushSubmissions();
+        }
+    });
+}
+
+NullQueue::~NullQueue() {
+    _timeline->setFlushFunction(nullptr);
+    if (_batchValue != 0) {
+        LOG_WARNING("NullQueue", "Destroyed with an open submission batch, submitting it");
+        flushSubmissions();
+    }
+}
+
+SubmissionFence NullQueue::submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) {
+    PERS_PROFILE_SCOPE("NullQueue::submit");
+    if (!commandBuffer) {
+        LOG_ERROR("NullQueue", "Cannot submit null command buffer");
+        return {};
+    }
+    
+    if (!commandBuffer->getNativeCommandBufferHandle().isValid()) {
+        LOG_ERROR("NullQueue", "Command buffer has invalid native handle");
+        return {};
+    }
+    return dispatch(1);
+}
+
+SubmissionFence NullQueue::submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) {
+    PERS_PROFILE_SCOPE("NullQueue::submit");
+    if (commandBuffers.empty()) {
+        // Empty batch is OK, nothing new to wait for
+        return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+    }
+    
+    for (size_t i = 0; i < commandBuffers.size(); ++i) {
+        if (!commandBuffers[i]) {
+            Logger::Instance().LogFormat(LogLevel::Error, "NullQueue", PERS_SOURCE_LOC, "Null command buffer at index %zu", i);
+            return {};
+        }
+        
+        if (!commandBuffers[i]->getNativeCommandBufferHandle().isValid()) {
+            Logger::Instance().LogFormat(LogLevel::Error, "NullQueue", PERS_SOURCE_LOC, "Invalid native handle at index %zu", i);
+            return {};
+        }
+    }
+    return dispatch(commandBuffers.size());
+}
+
+SubmissionFence NullQueue::submit(std::span<const NativeCommandBufferHandle> commandBuffers) {
+    PERS_PROFILE_SCOPE("NullQueue::submit");
+    if (commandBuffers.empty()) {
+        return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+    }
+    
+    for (size_t i = 0; i < commandBuffers.size(); ++i) {
+        if (!commandBuffers[i].isValid()) {
+            Logger::Instance().LogFormat(LogLevel::Error, "NullQueue", PERS_SOURCE_LOC, "Invalid native handle at index %zu", i);
+            return {};
+        }
+    }
+    return dispatch(commandBuffers.size());
+}
+
+SubmissionFence NullQueue::submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) {
+    return submit(commandBuffers);
+}
+
+void NullQueue::beginSubmissionBatch() {
+    auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+    ++_batchDepth;
+}
+
+SubmissionFence NullQueue::endSubmissionBatch() {
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchDepth == 0) {
+            LOG_WARNING("NullQueue", "endSubmissionBatch called without beginSubmissionBatch");
+            return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+        }
+        if (--_batchDepth > 0) {
+            return SubmissionFence(_timeline, _batchValue != 0 ? _batchValue : _timeline->getLastSubmittedValue());
+        }
+    }
+    return flushSubmissions();
+}
+
+SubmissionFence NullQueue::flushSubmissions() {
+    uint64_t value = 0;
+    size_t count = 0;
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchValue == 0) {
+            return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+        }
+        value = _batchValue;
+        count = _batchedCount;
+        _batchValue = 0;
+        _batchedCount = 0;
+    }
+    
+    // Outside the lock: completion callbacks may submit again
+    queueMetrics().submits.increment();
+    queueMetrics().commandBuffers.add(static_cast<int64_t>(count));
+    _timeline->complete(value, true);
+    return SubmissionFence(_timeline, value);
+}
+
+SubmissionFence NullQueue::dispatch(size_t count) {
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchDepth > 0) {
+            if (_batchValue == 0) {
+                _batchValue = _timeline->signal();
+            }
+            _batchedCount += count;
+            return SubmissionFence(_timeline, _batchValue);
+        }
+    }
+    
+    queueMetrics().submits.increment();
+    queueMetrics().commandBuffers.add(static_cast<int64_t>(count));
+    uint64_t value = _timeline->signal();
+    _timeline->complete(value, true);
+    return SubmissionFence(_timeline, value);
+}
+
+bool NullQueue::writeBuffer(const BufferWriteDesc& desc) {
+    if (!validateBufferWrite(desc)) {
+        return false;
+    }
+    
+    queueMetrics().writeBytes.add(static_cast<int64_t>(desc.size));
+    return true;
+}
+
+bool NullQueue::writeBuffer(const std::shared_ptr<IBuffer>& buffer,
+                            uint64_t offset,
+                            std::span<const std::byte> data) {
+    BufferWriteDesc desc;
+    desc.buffer = buffer;
+    desc.offset = offset;
+    desc.data = data.data();
+    desc.size = data.size();
+    return writeBuffer(desc);
+}
+
+bool NullQueue::writeBuffers(std::span<const BufferWriteDesc> writes) {
+    bool success = true;
+    for (const auto& write : writes) {
+        if (!validateBufferWrite(write)) {
+            success = false;
+            continue;
+        }
+        queueMetrics().writeBytes.add(static_cast<int64_t>(write.size));
+    }
+    return success;
+}
+
+bool NullQueue::writeTexture(const std::shared_ptr<ITexture>& texture,
+                             const void* data,
+                             uint64_t dataSize,
+                             uint32_t mipLevel) {
+    TextureWriteDesc desc;
+    desc.texture = texture;
+    desc.mipLevel = mipLevel;
+    desc.data = data;
+    desc.dataSize = dataSize;
+    return writeTexture(desc);
+}
+
+bool NullQueue::writeTexture(const TextureWriteDesc& desc) {
+    if (!desc.texture || !desc.data || desc.dataSize == 0) {
+        LOG_ERROR("NullQueue", "Invalid texture write parameters");
+        return false;
+    }
+    
+    if (!desc.texture->getNativeTextureHandle().isValid()) {
+        LOG_ERROR("NullQueue", "Invalid texture handle");
+        return false;
+    }
+    
+    if (desc.mipLevel >= desc.texture->getMipLevelCount()) {
+        LOG_ERROR("NullQueue", "Texture write mip level out of range");
+        return false;
+    }
+    
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(desc.texture->getFormat());
+    if (block.blockBytes == 0) {
+        LOG_ERROR("NullQueue", "Texture format cannot be written from memory");
+        return false;
+    }
+    
+    uint32_t mipWidth = std::max(1u, desc.texture->getWidth() >> desc.mipLevel);
+    uint32_t mipHeight = std::max(1u, desc.texture->getHeight() >> desc.mipLevel);
+    uint32_t mipDepth = desc.texture->getDimension() == TextureDimension::D3
+        ? std::max(1u, desc.texture->getDepthOrArrayLayers() >> desc.mipLevel)
+        : desc.texture->getDepthOrArrayLayers();
+    
+    if (desc.originX >= mipWidth || desc.originY >= mipHeight || desc.originZ >= mipDepth) {
+        LOG_ERROR("NullQueue", "Texture write origin outside of mip level");
+        return false;
+    }
+    
+    uint32_t width = desc.width ? desc.width : mipWidth - desc.originX;
+    uint32_t height = desc.height ? desc.height : mipHeight - desc.originY;
+    uint32_t depth = desc.depthOrArrayLayers ? desc.depthOrArrayLayers : mipDepth - desc.originZ;
+    
+    if (desc.originX + width > mipWidth || desc.originY + height > mipHeight || desc.originZ + depth > mipDepth) {
+        LOG_ERROR("NullQueue", "Texture write region exceeds mip level");
+        return false;
+    }
+    
+    if (desc.originX % block.blockWidth != 0 || desc.originY % block.blockHeight != 0 ||
+        (width % block.blockWidth != 0 && desc.originX + width != mipWidth) ||
+        (height % block.blockHeight != 0 && desc.originY + height != mipHeight)) {
+        LOG_ERROR("NullQueue", "Texture write region is not block aligned");
+        return false;
+    }
+    
+    uint32_t blocksWide = (width + block.blockWidth - 1) / block.blockWidth;
+    uint32_t blocksHigh = (height + block.blockHeight - 1) / block.blockHeight;
+    uint64_t rowBytes = static_cast<uint64_t>(blocksWide) * block.blockBytes;
+    uint64_t bytesPerRow = desc.bytesPerRow ? desc.bytesPerRow : rowBytes;
+    uint64_t rowsPerImage = desc.rowsPerImage ? desc.rowsPerImage : blocksHigh;
+    
+    if (bytesPerRow < rowBytes || rowsPerImage < blocksHigh) {
+        LOG_ERROR("NullQueue", "Texture write bytesPerRow or rowsPerImage too small for region");
+        return false;
+    }
+    
+    uint64_t requiredBytes = bytesPerRow * rowsPerImage * (depth - 1) + bytesPerRow * (blocksHigh - 1) + rowBytes;
+    if (desc.dataOffset > desc.dataSize || requiredBytes > desc.dataSize - desc.dataOffset) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullQueue", PERS_SOURCE_LOC,
+            "Texture write data too small: need %llu bytes after offset %llu, have %llu",
+            static_cast<unsigned long long>(requiredBytes), static_cast<unsigned long long>(desc.dataOffset),
+            static_cast<unsigned long long>(desc.dataSize));
+        return false;
+    }
+    return true;
+}
+
+bool NullQueue::waitIdle() {
+    flushSubmissions();
+    return true;
+}
+
+bool NullQueue::onSubmittedWorkDone(QueueWorkDoneCallback callback) {
+    if (!callback) {
+        LOG_ERROR("NullQueue", "Work done callback is empty");
+        return false;
+    }
+    
+    {
+        // Collected work counts as submitted, fire once the batch completes
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchValue != 0) {
+            _timeline->then(_batchValue, std::move(callback));
+            return true;
+        }
+    }
+    
+    // Everything submitted has already completed
+    callback(true);
+    return true;
+}
+
+bool NullQueue::pollSubmittedWork(bool wait) {
+    if (wait) {
+        flushSubmissions();
+    }
+    return true;
+}
+
+NativeQueueHandle NullQueue::getNativeQueueHandle() const {
+    return makeNullHandle<NativeQueueHandle>(this);
+}
+
+} // namespace pers
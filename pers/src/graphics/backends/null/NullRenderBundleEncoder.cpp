@@ -0,0 +1,150 @@
+#include "pers/graphics/backends/null/NullRenderBundleEncoder.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+NullRenderBundleEncoder::NullRenderBundleEncoder(const std::string& label)
+    : _label(label) {
+}
+
+bool NullRenderBundleEncoder::canRecord(const char* operation) const {
+    if (_finished) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderBundleEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on finished bundle encoder", operation);
+        return false;
+    }
+    return true;
+}
+
+bool NullRenderBundleEncoder::validateBuffer(const std::shared_ptr<IBuffer>& buffer, const char* message) {
+    NativeBufferHandle nativeHandle = buffer ? buffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("NullRenderBundleEncoder", message);
+        _failed = true;
+        return false;
+    }
+    return true;
+}
+
+void NullRenderBundleEncoder::setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+    if (!canRecord("set pipeline")) {
+        return;
+    }
+    
+    NativePipelineHandle nativePipeline = pipeline ? pipeline->getNativePipelineHandle() : nullptr;
+    if (!nativePipeline) {
+        LOG_ERROR("NullRenderBundleEncoder", "Pipeline is null or not compiled yet");
+        _failed = true;
+    }
+}
+
+void NullRenderBundleEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                           std::span<const uint32_t> dynamicOffsets) {
+    if (!canRecord("set bind group")) {
+        return;
+    }
+    
+    if (!bindGroup) {
+        LOG_ERROR("NullRenderBundleEncoder", "Cannot set null bind group");
+        _failed = true;
+    }
+}
+
+void NullRenderBundleEncoder::setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                                              uint64_t offset, uint64_t size) {
+    if (!canRecord("set vertex buffer")) {
+        return;
+    }
+    
+    validateBuffer(buffer, "Invalid buffer - native handle is null");
+}
+
+void NullRenderBundleEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                                             IndexFormat indexFormat,
+                                             uint64_t offset, uint64_t size) {
+    if (!canRecord("set index buffer")) {
+        return;
+    }
+    
+    if (!validateBuffer(buffer, "Invalid buffer - native handle is null")) {
+        return;
+    }
+    
+    if (indexFormat == IndexFormat::Undefined) {
+        LOG_ERROR("NullRenderBundleEncoder", "Invalid index format");
+        _failed = true;
+    }
+}
+
+void NullRenderBundleEncoder::setPushConstants(ShaderStage stages, uint32_t offset,
+                                               std::span<const std::byte> data) {
+    if (!canRecord("set push constants")) {
+        return;
+    }
+    
+    if (data.empty() || offset % 4 != 0 || data.size() % 4 != 0) {
+        LOG_ERROR("NullRenderBundleEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+        _failed = true;
+    }
+}
+
+void NullRenderBundleEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
+                                   uint32_t firstVertex, uint32_t firstInstance) {
+    if (!canRecord("draw")) {
+        return;
+    }
+    
+    ++_drawCount;
+}
+
+void NullRenderBundleEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount,
+                                          uint32_t firstIndex, int32_t baseVertex,
+                                          uint32_t firstInstance) {
+    if (!canRecord("draw indexed")) {
+        return;
+    }
+    
+    ++_drawCount;
+}
+
+void NullRenderBundleEncoder::drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!canRecord("draw indirect")) {
+        return;
+    }
+    
+    if (validateBuffer(indirectBuffer, "Invalid indirect buffer - native handle is null")) {
+        ++_drawCount;
+    }
+}
+
+void NullRenderBundleEncoder::drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                  uint64_t indirectOffset) {
+    if (!canRecord("draw indexed indirect")) {
+        return;
+    }
+    
+    if (validateBuffer(indirectBuffer, "Invalid indirect buffer - native handle is null")) {
+        ++_drawCount;
+    }
+}
+
+std::shared_ptr<IRenderBundle> NullRenderBundleEncoder::finish() {
+    if (!canRecord("finish")) {
+        return nullptr;
+    }
+    _finished = true;
+    
+    if (_failed) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderBundleEncoder", PERS_SOURCE_LOC,
+            "Discarding bundle %s, some commands failed to record", _label.c_str());
+        return nullptr;
+    }
+    
+    return std::make_shared<NullRenderBundle>(_drawCount);
+}
+
+} // namespace pers
@@ -0,0 +1,503 @@
+#include "pers/graphics/backends/null/NullRenderPassEncoder.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IRenderBundle.h"
+#include "pers/graphics/IQuerySet.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Validation.h"
+#include <algorithm>
+
+namespace pers {
+
+NullRenderPassEncoder::NullRenderPassEncoder(const RenderResourceTable* resourceTable,
+                                             bool multiDrawIndirect,
+                                             bool multiDrawIndirectCount)
+    : _resourceTable(resourceTable)
+    , _multiDrawIndirect(multiDrawIndirect)
+    , _multiDrawIndirectCount(multiDrawIndirectCount) {
+}
+
+NullRenderPassEncoder::~NullRenderPassEncoder() {
+    if (!_ended) {
+        LOG_WARNING("NullRenderPassEncoder", "Render pass encoder destroyed without calling end()");
+        end();
+    }
+}
+
+void NullRenderPassEncoder::setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+    if (!canRecord("set pipeline")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(!pipeline)) {
+        LOG_ERROR("NullRenderPassEncoder", "Cannot set null pipeline");
+        return;
+    }
+    
+    NativePipelineHandle nativePipeline = pipeline->getNativePipelineHandle();
+    if (!nativePipeline) {
+        LOG_DEBUG("NullRenderPassEncoder", "Pipeline has nothing to bind yet, skipping");
+        return;
+    }
+    
+    bindPipeline(nativePipeline.getRaw());
+}
+
+void NullRenderPassEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                         std::span<const uint32_t> dynamicOffsets) {
+    if (!canRecord("set bind group")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(!bindGroup)) {
+        LOG_ERROR("NullRenderPassEncoder", "Cannot set null bind group");
+        return;
+    }
+    
+    bindBindGroup(index, bindGroup->getNativeBindGroupHandle().getRaw(), dynamicOffsets);
+}
+
+void NullRenderPassEncoder::setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                                            uint64_t offset, uint64_t size) {
+    if (!canRecord("set vertex buffer")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = buffer ? buffer->getNativeHandle() : nullptr;
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
+        LOG_ERROR("NullRenderPassEncoder", "Invalid buffer - native handle is null");
+        return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : buffer->getSize() - offset;
+    bindVertexBuffer(slot, nativeHandle.getRaw(), buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void NullRenderPassEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                                           IndexFormat indexFormat,
+                                           uint64_t offset, uint64_t size) {
+    if (!canRecord("set index buffer")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = buffer ? buffer->getNativeHandle() : nullptr;
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
+        LOG_ERROR("NullRenderPassEncoder", "Invalid buffer - native handle is null");
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(indexFormat == IndexFormat::Undefined)) {
+        LOG_ERROR("NullRenderPassEncoder", "Invalid index format");
+        return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : buffer->getSize() - offset;
+    bindIndexBuffer(nativeHandle.getRaw(), indexFormat, buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void NullRenderPassEncoder::setPipeline(PipelineHandle pipeline) {
+    if (!canEncode("set pipeline")) {
+        return;
+    }
+    
+    NativePipelineHandle nativePipeline = _resourceTable->resolve(pipeline);
+    if (!nativePipeline) {
+        LOG_DEBUG("NullRenderPassEncoder", "Pipeline handle did not resolve, skipping");
+        return;
+    }
+    
+    bindPipeline(nativePipeline.getRaw());
+}
+
+void NullRenderPassEncoder::setBindGroup(uint32_t index, BindGroupHandle bindGroup,
+                                         std::span<const uint32_t> dynamicOffsets) {
+    if (!canEncode("set bind group")) {
+        return;
+    }
+    
+    NativeBindGroupHandle nativeBindGroup = _resourceTable->resolve(bindGroup);
+    if (!nativeBindGroup) {
+        LOG_ERROR("NullRenderPassEncoder", "Bind group handle is null or stale");
+        return;
+    }
+    
+    bindBindGroup(index, nativeBindGroup.getRaw(), dynamicOffsets);
+}
+
+void NullRenderPassEncoder::setVertexBuffer(uint32_t slot, BufferHandle buffer,
+                                            uint64_t offset, uint64_t size) {
+    if (!canEncode("set vertex buffer")) {
+        return;
+    }
+    
+    const RenderResourceTable::BufferEntry* entry = _resourceTable->resolve(buffer);
+    if (!entry) {
+        LOG_ERROR("NullRenderPassEncoder", "Vertex buffer handle is null or stale");
+        return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : entry->size - offset;
+    bindVertexBuffer(slot, entry->buffer->getNativeHandle().getRaw(),
+                     entry->buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void NullRenderPassEncoder::setIndexBuffer(BufferHandle buffer, IndexFormat indexFormat,
+                                           uint64_t offset, uint64_t size) {
+    if (!canEncode("set index buffer")) {
+        return;
+    }
+    
+    const RenderResourceTable::BufferEntry* entry = _resourceTable->resolve(buffer);
+    if (!entry) {
+        LOG_ERROR("NullRenderPassEncoder", "Index buffer handle is null or stale");
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(indexFormat == IndexFormat::Undefined)) {
+        LOG_ERROR("NullRenderPassEncoder", "Invalid index format");
+        return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : entry->size - offset;
+    bindIndexBuffer(entry->buffer->getNativeHandle().getRaw(), indexFormat,
+                    entry->buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void NullRenderPassEncoder::setViewport(float x, float y, float width, float height,
+                                        float minDepth, float maxDepth) {
+    if (!canEncode("set viewport")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(width < 0.0f || height < 0.0f || minDepth < 0.0f || maxDepth > 1.0f ||
+                          minDepth > maxDepth)) {
+        LOG_ERROR("NullRenderPassEncoder", "Viewport size must be non-negative and 0 <= minDepth <= maxDepth <= 1");
+    }
+}
+
+void NullRenderPassEncoder::setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    canEncode("set scissor rect");
+}
+
+void NullRenderPassEncoder::setStencilReference(uint32_t reference) {
+    canEncode("set stencil reference");
+}
+
+void NullRenderPassEncoder::setBlendConstant(const Color& color) {
+    canEncode("set blend constant");
+}
+
+void NullRenderPassEncoder::setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) {
+    if (!canRecord("set push constants")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(data.empty() || offset % 4 != 0 || data.size() % 4 != 0)) {
+        LOG_ERROR("NullRenderPassEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+        return;
+    }
+    
+    ++_stats.pushConstantSets;
+}
+
+void NullRenderPassEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
+                                 uint32_t firstVertex, uint32_t firstInstance) {
+    if (!canRecord("draw")) {
+        return;
+    }
+    
+    ++_stats.draws;
+}
+
+void NullRenderPassEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount,
+                                        uint32_t firstIndex, int32_t baseVertex,
+                                        uint32_t firstInstance) {
+    if (!canRecord("draw indexed")) {
+        return;
+    }
+    
+    ++_stats.draws;
+}
+
+bool NullRenderPassEncoder::validateIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                             uint64_t recordSize, uint32_t drawCount) const {
+    if (!canRecord("draw indirect")) {
+        return false;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
+        LOG_ERROR("NullRenderPassEncoder", "Invalid indirect buffer - native handle is null");
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(indirectOffset % 4 != 0 ||
+                          indirectOffset + recordSize * drawCount > indirectBuffer->getSize())) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderPassEncoder", PERS_SOURCE_LOC,
+            "Indirect range offset %llu, %u records exceeds buffer %s or is misaligned",
+            static_cast<unsigned long long>(indirectOffset), drawCount, indirectBuffer->getDebugName().c_str());
+        return false;
+    }
+    return true;
+}
+
+void NullRenderPassEncoder::drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), 1)) {
+        return;
+    }
+    
+    ++_stats.indirectDraws;
+}
+
+void NullRenderPassEncoder::drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), 1)) {
+        return;
+    }
+    
+    ++_stats.indirectDraws;
+}
+
+void NullRenderPassEncoder::multiDrawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                              uint64_t indirectOffset, uint32_t drawCount) {
+    if (drawCount == 0 || !validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), drawCount)) {
+        return;
+    }
+    
+    _stats.indirectDraws += drawCount;
+}
+
+void NullRenderPassEncoder::multiDrawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                     uint64_t indirectOffset, uint32_t drawCount) {
+    if (drawCount == 0 ||
+        !validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), drawCount)) {
+        return;
+    }
+    
+    _stats.indirectDraws += drawCount;
+}
+
+void NullRenderPassEncoder::multiDrawIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                   uint64_t indirectOffset,
+                                                   const std::shared_ptr<IBuffer>& countBuffer,
+                                                   uint64_t countOffset, uint32_t maxDrawCount) {
+    if (!_multiDrawIndirectCount) {
+        multiDrawIndirect(indirectBuffer, indirectOffset, maxDrawCount);
+        return;
+    }
+    
+    if (maxDrawCount == 0 ||
+        !validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), maxDrawCount) ||
+        !validateIndirect(countBuffer, countOffset, sizeof(uint32_t), 1)) {
+        return;
+    }
+    
+    _stats.indirectDraws += maxDrawCount;
+}
+
+void NullRenderPassEncoder::multiDrawIndexedIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                          uint64_t indirectOffset,
+                                                          const std::shared_ptr<IBuffer>& countBuffer,
+                                                          uint64_t countOffset, uint32_t maxDrawCount) {
+    if (!_multiDrawIndirectCount) {
+        multiDrawIndexedIndirect(indirectBuffer, indirectOffset, maxDrawCount);
+        return;
+    }
+    
+    if (maxDrawCount == 0 ||
+        !validateIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), maxDrawCount) ||
+        !validateIndirect(countBuffer, countOffset, sizeof(uint32_t), 1)) {
+        return;
+    }
+    
+    _stats.indirectDraws += maxDrawCount;
+}
+
+void NullRenderPassEncoder::executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) {
+    if (!canRecord("execute bundles")) {
+        return;
+    }
+    
+    for (const auto& bundle : bundles) {
+        if (PERS_CHECK_FAILED(!bundle)) {
+            LOG_ERROR("NullRenderPassEncoder", "Skipping null render bundle");
+            continue;
+        }
+        _stats.bundleDraws += bundle->getDrawCount();
+        ++_stats.bundlesExecuted;
+    }
+    
+    resetBoundState();
+}
+
+void NullRenderPassEncoder::end() {
+    if (_ended) {
+        LOG_WARNING("NullRenderPassEncoder", "Render pass already ended");
+        return;
+    }
+    
+    if (_occlusionQueryOpen || _statisticsQueryOpen) {
+        LOG_ERROR("NullRenderPassEncoder", "Render pass ended with a query still open");
+    }
+    _ended = true;
+    
+    static MetricCounter& renderPasses = Metrics::counter("pers_render_passes_total", "Render passes recorded");
+    static MetricCounter& drawCalls = Metrics::counter("pers_draw_calls_total",
+                                                       "Draws recorded, including indirect and bundle draws");
+    static MetricCounter& pipelineBinds = Metrics::counter("pers_pipeline_binds_total",
+                                                           "Render pipelines bound after redundant-set elision");
+    renderPasses.increment();
+    drawCalls.add(static_cast<int64_t>(_stats.draws) + _stats.indirectDraws + _stats.bundleDraws);
+    pipelineBinds.add(static_cast<int64_t>(_stats.pipelineSets) - _stats.pipelinesElided);
+    
+    Logger::Instance().LogFormat(LogLevel::Debug, "NullRenderPassEncoder", PERS_SOURCE_LOC,
+        "Pass ended: %u draws (+%u indirect, +%u in %u bundles), elided %u/%u pipeline, %u/%u bind group, %u/%u vertex buffer, %u/%u index buffer sets",
+        _stats.draws, _stats.indirectDraws, _stats.bundleDraws, _stats.bundlesExecuted,
+        _stats.pipelinesElided, _stats.pipelineSets,
+        _stats.bindGroupsElided, _stats.bindGroupSets,
+        _stats.vertexBuffersElided, _stats.vertexBufferSets,
+        _stats.indexBuffersElided, _stats.indexBufferSets);
+}
+
+void NullRenderPassEncoder::beginOcclusionQuery(uint32_t queryIndex) {
+    if (!canRecord("begin occlusion query")) {
+        return;
+    }
+    
+    if (_occlusionQueryOpen) {
+        LOG_ERROR("NullRenderPassEncoder", "Occlusion queries cannot nest");
+        return;
+    }
+    _occlusionQueryOpen = true;
+}
+
+void NullRenderPassEncoder::endOcclusionQuery() {
+    if (!canRecord("end occlusion query")) {
+        return;
+    }
+    
+    if (!_occlusionQueryOpen) {
+        LOG_ERROR("NullRenderPassEncoder", "No occlusion query to end");
+        return;
+    }
+    _occlusionQueryOpen = false;
+}
+
+void NullRenderPassEncoder::beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet,
+                                                         uint32_t queryIndex) {
+    if (!canRecord("begin pipeline statistics query")) {
+        return;
+    }
+    
+    if (!querySet || querySet->getType() != QueryType::PipelineStatistics) {
+        LOG_ERROR("NullRenderPassEncoder", "Query set is null or not a pipeline statistics query set");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("NullRenderPassEncoder", "Pipeline statistics queries cannot nest");
+        return;
+    }
+    _statisticsQueryOpen = true;
+}
+
+void NullRenderPassEncoder::endPipelineStatisticsQuery() {
+    if (!canRecord("end pipeline statistics query")) {
+        return;
+    }
+    
+    if (!_statisticsQueryOpen) {
+        LOG_ERROR("NullRenderPassEncoder", "No pipeline statistics query to end");
+        return;
+    }
+    _statisticsQueryOpen = false;
+}
+
+bool NullRenderPassEncoder::canRecord(const char* operation) const {
+    if (PERS_CHECK_FAILED(_ended)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderPassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on ended render pass", operation);
+        return false;
+    }
+    return true;
+}
+
+bool NullRenderPassEncoder::canEncode(const char* operation) const {
+    if (!canRecord(operation)) {
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(!_resourceTable)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderPassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s by handle, RenderPassDesc::resourceTable was not set", operation);
+        return false;
+    }
+    return true;
+}
+
+void NullRenderPassEncoder::resetBoundState() {
+    _boundPipeline = nullptr;
+    _boundVertexBuffers = {};
+    _boundIndexBuffer = {};
+    _boundIndexFormat = IndexFormat::Undefined;
+    for (auto& bound : _boundBindGroups) {
+        bound.bindGroup = nullptr;
+        bound.dynamicOffsets.clear();
+    }
+}
+
+void NullRenderPassEncoder::bindPipeline(const void* pipeline) {
+    ++_stats.pipelineSets;
+    if (pipeline == _boundPipeline) {
+        ++_stats.pipelinesElided;
+        return;
+    }
+    _boundPipeline = pipeline;
+}
+
+void NullRenderPassEncoder::bindBindGroup(uint32_t index, const void* bindGroup,
+                                          std::span<const uint32_t> dynamicOffsets) {
+    ++_stats.bindGroupSets;
+    if (index < MAX_TRACKED_BIND_GROUPS) {
+        auto& bound = _boundBindGroups[index];
+        if (bound.bindGroup == bindGroup &&
+            std::equal(bound.dynamicOffsets.begin(), bound.dynamicOffsets.end(),
+                       dynamicOffsets.begin(), dynamicOffsets.end())) {
+            ++_stats.bindGroupsElided;
+            return;
+        }
+        bound.bindGroup = bindGroup;
+        bound.dynamicOffsets.assign(dynamicOffsets.begin(), dynamicOffsets.end());
+    }
+}
+
+void NullRenderPassEncoder::bindVertexBuffer(uint32_t slot, const void* buffer, uint64_t offset, uint64_t size) {
+    ++_stats.vertexBufferSets;
+    BufferBinding binding{buffer, offset, size};
+    if (slot < MAX_TRACKED_VERTEX_BUFFERS) {
+        if (_boundVertexBuffers[slot] == binding) {
+            ++_stats.vertexBuffersElided;
+            return;
+        }
+        _boundVertexBuffers[slot] = binding;
+    }
+}
+
+void NullRenderPassEncoder::bindIndexBuffer(const void* buffer, IndexFormat format, uint64_t offset, uint64_t size) {
+    ++_stats.indexBufferSets;
+    BufferBinding binding{buffer, offset, size};
+    if (binding == _boundIndexBuffer && format == _boundIndexFormat) {
+        ++_stats.indexBuffersElided;
+        return;
+    }
+    _boundIndexBuffer = binding;
+    _boundIndexFormat = format;
+}
+
+NativeRenderPassEncoderHandle NullRenderPassEncoder::getNativeRenderPassEncoderHandle() const {
+    return makeNullHandle<NativeRenderPassEncoderHandle>(this);
+}
+
+} // namespace pers
@@ -0,0 +1,309 @@
+#include "pers/graphics/backends/null/NullResourceFactory.h"
+#include "pers/graphics/backends/null/NullBuffer.h"
+#include "pers/graphics/backends/null/NullLogicalDevice.h"
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/PoolAllocator.h"
+#include "pers/utils/Profiler.h"
+
+namespace pers {
+
+NullResourceFactory::NullResourceFactory(const std::shared_ptr<NullLogicalDevice>& logicalDevice)
+    : _logicalDevice(logicalDevice) {
+}
+
+std::shared_ptr<INativeBuffer> NullResourceFactory::createBuffer(const BufferDesc& desc) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createBuffer");
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create buffer without device");
+        return nullptr;
+    }
+    
+    // Same rule as WebGPU so both backends reject the same descs
+    if (desc.size == 0) {
+        LOG_WARNING("NullResourceFactory", "Cannot create buffer with size 0 - WebGPU requires size > 0");
+        return nullptr;
+    }
+    
+    return std::make_shared<NullBuffer>(desc);
+}
+
+std::shared_ptr<INativeBuffer> NullResourceFactory::createInitializableDeviceBuffer(
+    const BufferDesc& desc,
+    const void* initialData,
+    size_t dataSize) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createInitializableDeviceBuffer");
+    
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create buffer without device");
+        return nullptr;
+    }
+    
+    if (!initialData || dataSize == 0) {
+        LOG_ERROR("NullResourceFactory", "Invalid initial data or size");
+        return nullptr;
+    }
+    
+    if (dataSize > desc.size) {
+        LOG_ERROR("NullResourceFactory", "Data size exceeds buffer size");
+        return nullptr;
+    }
+    
+    // The data has nowhere to go, keep the desc the WebGPU backend would create
+    BufferDesc syncDesc = desc;
+    syncDesc.usage |= BufferUsage::CopySrc;
+    auto buffer = std::make_shared<NullBuffer>(syncDesc);
+    if (!buffer->isValid()) {
+        LOG_ERROR("NullResourceFactory", "Failed to create buffer");
+        return nullptr;
+    }
+    return buffer;
+}
+
+std::shared_ptr<ITexture> NullResourceFactory::createTexture(const TextureDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create texture without device");
+        return nullptr;
+    }
+    
+    GpuMemoryAllocation allocation = GpuMemoryTracker::instance().allocate(
+        GpuMemoryTracker::categorize(desc.usage), GpuMemoryTracker::estimateTextureSize(desc), desc.label);
+    return std::make_shared<NullTexture>(desc, std::move(allocation));
+}
+
+std::shared_ptr<ITextureView> NullResourceFactory::createTextureView(
+    const std::shared_ptr<ITexture>& texture,
+    const TextureViewDesc& desc) const {
+    if (!texture) {
+        LOG_ERROR("NullResourceFactory", "Cannot create texture view from null texture");
+        return nullptr;
+    }
+    
+    auto nullTexture = std::dynamic_pointer_cast<NullTexture>(texture);
+    if (!nullTexture) {
+        LOG_ERROR("NullResourceFactory", "Texture is not a null backend texture");
+        return nullptr;
+    }
+    
+    return nullTexture->getViewCache().getOrCreate(desc, [&nullTexture](const TextureViewDesc&) {
+        return std::static_pointer_cast<ITextureView>(makePooledShared<NullTextureView>(
+            nullTexture->getWidth(),
+            nullTexture->getHeight(),
+            nullTexture->getFormat()));
+    });
+}
+
+std::shared_ptr<ISampler> NullResourceFactory::createSampler(const SamplerDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create sampler without device");
+        return nullptr;
+    }
+    
+    return _samplerCache.getOrCreate(desc, [](const SamplerDesc& samplerDesc) {
+        return std::static_pointer_cast<ISampler>(std::make_shared<NullSampler>(samplerDesc));
+    });
+}
+
+std::shared_ptr<IShaderModule> NullResourceFactory::createShaderModule(const ShaderModuleDesc& desc) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createShaderModule");
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create shader module without device");
+        return nullptr;
+    }
+    
+    auto shader = std::make_shared<NullShaderModule>(desc);
+    if (!shader->isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullResourceFactory",
+            PERS_SOURCE_LOC, "Failed to create shader module: %s", desc.debugName.c_str());
+        return nullptr;
+    }
+    
+    return shader;
+}
+
+std::shared_ptr<IRenderPipeline> NullResourceFactory::createRenderPipeline(const RenderPipelineDesc& desc) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createRenderPipeline");
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create render pipeline without device");
+        return nullptr;
+    }
+    
+    RenderPipelineDesc derived;
+    const RenderPipelineDesc& resolved = deriveLayouts(desc, derived) ? derived : desc;
+    
+    return _pipelineCache.getOrCreate(resolved, [](const RenderPipelineDesc& pipelineDesc) {
+        return std::static_pointer_cast<IRenderPipeline>(std::make_shared<NullRenderPipeline>(pipelineDesc));
+    });
+}
+
+std::shared_ptr<IComputePipeline> NullResourceFactory::createComputePipeline(const ComputePipelineDesc& desc) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createComputePipeline");
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create compute pipeline without device");
+        return nullptr;
+    }
+    
+    ComputePipelineDesc derived;
+    const ComputePipelineDesc& resolved = deriveLayouts(desc, derived) ? derived : desc;
+    
+    auto pipeline = std::make_shared<NullComputePipeline>(resolved);
+    if (!pipeline->isValid()) {
+        return nullptr;
+    }
+    return pipeline;
+}
+
+std::shared_ptr<AsyncRenderPipeline> NullResourceFactory::createRenderPipelineAsync(
+    const RenderPipelineDesc& requested,
+    const std::shared_ptr<IRenderPipeline>& fallback) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create render pipeline without device");
+        return nullptr;
+    }
+    
+    RenderPipelineDesc derived;
+    const RenderPipelineDesc& desc = deriveLayouts(requested, derived) ? derived : requested;
+    
+    auto handle = std::make_shared<AsyncRenderPipeline>(desc.debugName, fallback);
+    if (auto cached = _pipelineCache.lookup(desc)) {
+        handle->resolve(cached);
+        return handle;
+    }
+    
+    // Nothing to compile, resolve right away so callers see the ready path
+    std::shared_ptr<IRenderPipeline> result = std::make_shared<NullRenderPipeline>(desc);
+    if (!result->isValid()) {
+        result = nullptr;
+    } else {
+        result = _pipelineCache.insert(desc, result);
+    }
+    handle->resolve(result);
+    return handle;
+}
+
+std::shared_ptr<INativeMappableBuffer> NullResourceFactory::createMappableBuffer(const BufferDesc& desc) const {
+    PERS_PROFILE_SCOPE("NullResourceFactory::createMappableBuffer");
+    
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create mappable buffer without device");
+        return nullptr;
+    }
+    
+    if (desc.size == 0) {
+        LOG_WARNING("NullResourceFactory", "Cannot create mappable buffer with size 0 - WebGPU requires size > 0");
+        return nullptr;
+    }
+    
+    return std::make_shared<NullMappableBuffer>(desc);
+}
+
+std::shared_ptr<IBindGroupLayout> NullResourceFactory::createBindGroupLayout(const BindGroupLayoutDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create bind group layout without device");
+        return nullptr;
+    }
+    
+    return _bindGroupCache.getOrCreateLayout(desc, [](const BindGroupLayoutDesc& layoutDesc) {
+        return std::static_pointer_cast<IBindGroupLayout>(std::make_shared<NullBindGroupLayout>(layoutDesc));
+    });
+}
+
+std::shared_ptr<IBindGroup> NullResourceFactory::createBindGroup(const BindGroupDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create bind group without device");
+        return nullptr;
+    }
+    
+    return _bindGroupCache.getOrCreateBindGroup(desc, [](const BindGroupDesc& groupDesc) {
+        auto bindGroup = std::make_shared<NullBindGroup>(groupDesc);
+        return bindGroup->isValid() ? std::static_pointer_cast<IBindGroup>(bindGroup) : nullptr;
+    });
+}
+
+std::shared_ptr<IPipelineLayout> NullResourceFactory::createPipelineLayout(const PipelineLayoutDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create pipeline layout without device");
+        return nullptr;
+    }
+    
+    return _bindGroupCache.getOrCreatePipelineLayout(desc, [](const PipelineLayoutDesc& layoutDesc) {
+        return std::static_pointer_cast<IPipelineLayout>(std::make_shared<NullPipelineLayout>(layoutDesc));
+    });
+}
+
+bool NullResourceFactory::deriveLayouts(const RenderPipelineDesc& desc, RenderPipelineDesc& derived) const {
+    const bool needsLayout = !desc.layout;
+    const bool needsVertexLayout = desc.vertexLayouts.empty() && desc.vertex;
+    if (!needsLayout && !needsVertexLayout) {
+        return false;
+    }
+    
+    bool changed = false;
+    derived = desc;
+    if (needsLayout) {
+        derived.layout = ShaderReflection::derivePipelineLayout(*this, {desc.vertex, desc.fragment}, desc.debugName.str());
+        changed = derived.layout != nullptr;
+    }
+    VertexBufferLayout vertexLayout;
+    if (needsVertexLayout && ShaderReflection::deriveVertexLayout(*desc.vertex, vertexLayout)) {
+        derived.vertexLayouts.push_back(std::move(vertexLayout));
+        changed = true;
+    }
+    return changed;
+}
+
+bool NullResourceFactory::deriveLayouts(const ComputePipelineDesc& desc, ComputePipelineDesc& derived) const {
+    if (desc.layout || !desc.compute) {
+        return false;
+    }
+    
+    derived = desc;
+    derived.layout = ShaderReflection::derivePipelineLayout(*this, {desc.compute}, desc.debugName);
+    return derived.layout != nullptr;
+}
+
+std::shared_ptr<IQuerySet> NullResourceFactory::createQuerySet(const QuerySetDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("NullResourceFactory", "Cannot create query set without device");
+        return nullptr;
+    }
+    
+    if (desc.type == QueryType::Timestamp && !device->hasFeature(DeviceFeature::TimestampQuery)) {
+        LOG_WARNING("NullResourceFactory",
+            "Timestamp queries need DeviceFeature::TimestampQuery in requiredFeatures");
+        return nullptr;
+    }
+    
+    if (desc.type == QueryType::PipelineStatistics && !device->hasFeature(DeviceFeature::PipelineStatisticsQuery)) {
+        LOG_WARNING("NullResourceFactory",
+            "Pipeline statistics queries need DeviceFeature::PipelineStatisticsQuery in requiredFeatures");
+        return nullptr;
+    }
+    
+    auto querySet = std::make_shared<NullQuerySet>(desc);
+    if (!querySet->isValid()) {
+        return nullptr;
+    }
+    return querySet;
+}
+
+std::shared_ptr<IPreparedRenderPass> NullResourceFactory::createPreparedRenderPass(const RenderPassDesc& desc) const {
+    return std::make_shared<NullPreparedRenderPass>(desc);
+}
+
+} // namespace pers
@@ -0,0 +1,224 @@
+#include "pers/graphics/backends/null/NullResources.h"
+#include "pers/graphics/ShaderBinary.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+NullTexture::NullTexture(const TextureDesc& desc, GpuMemoryAllocation allocation)
+    : _desc(desc)
+    , _allocation(std::move(allocation)) {
+}
+
+NativeTextureHandle NullTexture::getNativeTextureHandle() const {
+    return makeNullHandle<NativeTextureHandle>(this);
+}
+
+NullTextureView::NullTextureView(uint32_t width, uint32_t height, TextureFormat format)
+    : _width(width)
+    , _height(height)
+    , _format(format) {
+}
+
+NativeTextureViewHandle NullTextureView::getNativeTextureViewHandle() const {
+    return makeNullHandle<NativeTextureViewHandle>(this);
+}
+
+void NullTextureView::getDimensions(uint32_t& width, uint32_t& height) const {
+    width = _width;
+    height = _height;
+}
+
+NullSampler::NullSampler(const SamplerDesc& desc)
+    : _desc(desc) {
+}
+
+NativeSamplerHandle NullSampler::getNativeSamplerHandle() const {
+    return makeNullHandle<NativeSamplerHandle>(this);
+}
+
+NullShaderModule::NullShaderModule(const ShaderModuleDesc& desc)
+    : _stage(desc.stage)
+    , _entryPoint(desc.entryPoint)
+    , _debugName(desc.debugName)
+    , _code(desc.code)
+    , _spirv(desc.spirv)
+    , _reflection(desc.reflection ? *desc.reflection
+                  : desc.code.empty() ? ShaderReflection() : ShaderReflection::reflect(desc.code)) {
+
+    if (_stage == ShaderStage::None && _reflection.isValid()) {
+        _stage = _reflection.detectStage(_entryPoint);
+    }
+    if (_stage == ShaderStage::None) {
+        LOG_ERROR("NullShaderModule", "Failed to detect shader stage, set ShaderModuleDesc::stage");
+        return;
+    }
+
+    if (_debugName.empty()) {
+        switch (_stage) {
+            case ShaderStage::Vertex:
+                _debugName = "VertexShader";
+                break;
+            case ShaderStage::Fragment:
+                _debugName = "FragmentShader";
+                break;
+            case ShaderStage::Compute:
+                _debugName = "ComputeShader";
+                break;
+            default:
+                _debugName = "UnknownShader";
+        }
+    }
+
+    if (!_spirv.empty()) {
+        if (!isSpirvBinary(_spirv)) {
+            Logger::Instance().LogFormat(LogLevel::Error, "NullShaderModule",
+                PERS_SOURCE_LOC, "%s does not hold a SPIR-V module", _debugName.c_str());
+            return;
+        }
+    } else if (_code.empty()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullShaderModule",
+            PERS_SOURCE_LOC, "%s has neither WGSL nor SPIR-V", _debugName.c_str());
+        return;
+    }
+    _valid = true;
+}
+
+NullRenderPipeline::NullRenderPipeline(const RenderPipelineDesc& desc)
+    : _desc(desc) {
+    if (!_desc.vertex || !_desc.vertex->isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderPipeline", PERS_SOURCE_LOC,
+            "%s needs a valid vertex shader", _desc.debugName.c_str());
+        return;
+    }
+
+    if (_desc.fragment && !_desc.fragment->isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullRenderPipeline", PERS_SOURCE_LOC,
+            "%s has an invalid fragment shader", _desc.debugName.c_str());
+        return;
+    }
+    _valid = true;
+}
+
+NativePipelineHandle NullRenderPipeline::getNativePipelineHandle() const {
+    return _valid ? makeNullHandle<NativePipelineHandle>(this) : NativePipelineHandle();
+}
+
+NullComputePipeline::NullComputePipeline(const ComputePipelineDesc& desc)
+    : _desc(desc) {
+    if (!_desc.compute || !_desc.compute->isValid() || _desc.compute->getStage() != ShaderStage::Compute) {
+        Logger::Instance().LogFormat(LogLevel::Error, "NullComputePipeline", PERS_SOURCE_LOC,
+            "%s needs a valid compute shader", _desc.debugName.c_str());
+        return;
+    }
+    _valid = true;
+}
+
+NativePipelineHandle NullComputePipeline::getNativePipelineHandle() const {
+    return _valid ? makeNullHandle<NativePipelineHandle>(this) : NativePipelineHandle();
+}
+
+NativeBindGroupLayoutHandle NullBindGroupLayout::getNativeBindGroupLayoutHandle() const {
+    return makeNullHandle<NativeBindGroupLayoutHandle>(this);
+}
+
+NullBindGroup::NullBindGroup(const BindGroupDesc& desc)
+    : _desc(desc) {
+    if (!_desc.layout) {
+        LOG_ERROR("NullBindGroup", "Cannot create bind group without layout");
+        return;
+    }
+    _valid = true;
+}
+
+NativeBindGroupHandle NullBindGroup::getNativeBindGroupHandle() const {
+    return makeNullHandle<NativeBindGroupHandle>(this);
+}
+
+NativePipelineLayoutHandle NullPipelineLayout::getNativePipelineLayoutHandle() const {
+    return makeNullHandle<NativePipelineLayoutHandle>(this);
+}
+
+NullQuerySet::NullQuerySet(const QuerySetDesc& desc)
+    : _desc(desc) {
+    if (_desc.count == 0) {
+        LOG_ERROR("NullQuerySet", "Query set count must be non-zero");
+        return;
+    }
+
+    if (_desc.type == QueryType::PipelineStatistics && _desc.pipelineStatistics.empty()) {
+        LOG_ERROR("NullQuerySet", "Pipeline statistics query set needs at least one statistic");
+        return;
+    }
+    _valid = true;
+}
+
+NativeQuerySetHandle NullQuerySet::getNativeQuerySetHandle() const {
+    return makeNullHandle<NativeQuerySetHandle>(this);
+}
+
+NullPreparedRenderPass::NullPreparedRenderPass(const RenderPassDesc& desc)
+    : _desc(desc) {
+    // Own the depth attachment so retargeting never writes through a caller's pointer
+    if (_desc.depthStencilAttachment) {
+        _desc.depthStencilAttachment = std::make_shared<RenderPassDepthStencilAttachment>(*desc.depthStencilAttachment);
+    }
+}
+
+bool NullPreparedRenderPass::setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) {
+    if (index >= _desc.colorAttachments.size() || !view) {
+        LOG_ERROR("NullPreparedRenderPass", "Color attachment index out of range or null view");
+        return false;
+    }
+
+    _desc.colorAttachments[index].view = view;
+    return true;
+}
+
+bool NullPreparedRenderPass::setResolveTarget(uint32_t index, const std::shared_ptr<ITextureView>& view) {
+    if (index >= _desc.colorAttachments.size()) {
+        LOG_ERROR("NullPreparedRenderPass", "Color attachment index out of range");
+        return false;
+    }
+
+    _desc.colorAttachments[index].resolveTarget = view;
+    return true;
+}
+
+bool NullPreparedRenderPass::setClearColor(uint32_t index, const Color& color) {
+    if (index >= _desc.colorAttachments.size()) {
+        LOG_ERROR("NullPreparedRenderPass", "Color attachment index out of range");
+        return false;
+    }
+
+    _desc.colorAttachments[index].clearColor = color;
+    return true;
+}
+
+bool NullPreparedRenderPass::setDepthStencilView(const std::shared_ptr<ITextureView>& view) {
+    if (!_desc.depthStencilAttachment || !view) {
+        LOG_ERROR("NullPreparedRenderPass", "Pass has no depth stencil attachment or view is null");
+        return false;
+    }
+
+    _desc.depthStencilAttachment->view = view;
+    return true;
+}
+
+bool NullPreparedRenderPass::isComplete() const {
+    for (const auto& attachment : _desc.colorAttachments) {
+        if (!attachment.view) {
+            return false;
+        }
+    }
+    return true;
+}
+
+NativeCommandBufferHandle NullCommandBuffer::getNativeCommandBufferHandle() const {
+    return makeNullHandle<NativeCommandBufferHandle>(this);
+}
+
+NativeRenderBundleHandle NullRenderBundle::getNativeRenderBundleHandle() const {
+    return makeNullHandle<NativeRenderBundleHandle>(this);
+}
+
+} // namespace pers
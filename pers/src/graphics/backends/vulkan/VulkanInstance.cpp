@@ -0,0 +1,281 @@
+#include "pers/graphics/backends/vulkan/VulkanInstance.h"
+#include "pers/graphics/backends/vulkan/VulkanPhysicalDevice.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Validation.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pers {
+
+namespace {
+
+constexpr const char* VALIDATION_LAYER = "VK_LAYER_KHRONOS_validation";
+
+bool hasLayer(const std::vector<VkLayerProperties>& layers, const char* name) {
+    return std::any_of(layers.begin(), layers.end(), [name](const VkLayerProperties& layer) {
+        return std::strcmp(layer.layerName, name) == 0;
+    });
+}
+
+bool hasExtension(const std::vector<VkExtensionProperties>& extensions, const char* name) {
+    return std::any_of(extensions.begin(), extensions.end(), [name](const VkExtensionProperties& extension) {
+        return std::strcmp(extension.extensionName, name) == 0;
+    });
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL debugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+                                             VkDebugUtilsMessageTypeFlagsEXT,
+                                             const VkDebugUtilsMessengerCallbackDataEXT* data,
+                                             void*) {
+    LogLevel level = LogLevel::Debug;
+    if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+        level = LogLevel::Error;
+    } else if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT) {
+        level = LogLevel::Warning;
+    } else if (severity & VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT) {
+        level = LogLevel::Info;
+    }
+    Logger::Instance().LogFormat(level, "Vulkan", PERS_SOURCE_LOC, "%s",
+                                 data && data->pMessage ? data->pMessage : "");
+    return VK_FALSE;
+}
+
+// Higher is better; negative excludes the device
+int scorePhysicalDevice(VkPhysicalDeviceType type, bool preferLowPower, bool allowSoftware) {
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU:
+            return preferLowPower ? 2 : 4;
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU:
+            return preferLowPower ? 4 : 2;
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU:
+            return 1;
+        case VK_PHYSICAL_DEVICE_TYPE_CPU:
+            return allowSoftware ? 0 : -1;
+        default:
+            return -1;
+    }
+}
+
+} // anonymous namespace
+
+VulkanInstance::VulkanInstance() = default;
+
+VulkanInstance::~VulkanInstance() {
+    if (_messenger != VK_NULL_HANDLE) {
+        auto destroyMessenger = reinterpret_cast<PFN_vkDestroyDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(_instance, "vkDestroyDebugUtilsMessengerEXT"));
+        if (destroyMessenger) {
+            destroyMessenger(_instance, _messenger, nullptr);
+        }
+        _messenger = VK_NULL_HANDLE;
+    }
+    if (_instance != VK_NULL_HANDLE) {
+        vkDestroyInstance(_instance, nullptr);
+        _instance = VK_NULL_HANDLE;
+    }
+}
+
+bool VulkanInstance::initialize(const InstanceDesc& desc) {
+    if (_instance != VK_NULL_HANDLE) {
+        LOG_WARNING("VulkanInstance", "Already initialized");
+        return true;
+    }
+    _desc = desc;
+    
+    // Timeline semaphores and the 1.2 feature structs are what this backend is for
+    uint32_t loaderVersion = VK_API_VERSION_1_0;
+    if (vkEnumerateInstanceVersion(&loaderVersion) != VK_SUCCESS || loaderVersion < VK_API_VERSION_1_2) {
+        Logger::Instance().LogFormat(LogLevel::Error, "VulkanInstance", PERS_SOURCE_LOC,
+            "Vulkan loader reports %u.%u, 1.2 is required",
+            VK_API_VERSION_MAJOR(loaderVersion), VK_API_VERSION_MINOR(loaderVersion));
+        return false;
+    }
+    _apiVersion = std::min(loaderVersion, VK_API_VERSION_1_3);
+    if (desc.apiVersionMajor == 1 && desc.apiVersionMinor >= 2) {  // Hint, clamped to the loader
+        _apiVersion = std::min(loaderVersion, VK_MAKE_API_VERSION(0, 1, desc.apiVersionMinor, 0));
+    }
+    
+    uint32_t layerCount = 0;
+    vkEnumerateInstanceLayerProperties(&layerCount, nullptr);
+    std::vector<VkLayerProperties> availableLayers(layerCount);
+    vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
+    
+    uint32_t extensionCount = 0;
+    vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, availableExtensions.data());
+    
+    // Unchecked builds skip the validation layer too, whatever the desc asks for
+    const bool validation = desc.enableValidation && PERS_VALIDATION;
+    std::vector<const char*> layers;
+    if (validation) {
+        if (hasLayer(availableLayers, VALIDATION_LAYER)) {
+            layers.push_back(VALIDATION_LAYER);
+        } else {
+            LOG_WARNING("VulkanInstance", "Validation requested but VK_LAYER_KHRONOS_validation is not installed");
+        }
+    }
+    
+    std::vector<const char*> extensions;
+    for (const auto& name : desc.requiredExtensions) {
+        if (!hasExtension(availableExtensions, name.c_str())) {
+            Logger::Instance().LogFormat(LogLevel::Error, "VulkanInstance", PERS_SOURCE_LOC,
+                "Required instance extension %s is not available", name.c_str());
+            return false;
+        }
+        extensions.push_back(name.c_str());
+    }
+    for (const auto& name : desc.optionalExtensions) {
+        if (hasExtension(availableExtensions, name.c_str())) {
+            extensions.push_back(name.c_str());
+        }
+    }
+    
+    const bool debugMessages = validation && desc.enableDebugMessages &&
+                               hasExtension(availableExtensions, VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    if (debugMessages) {
+        extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+    }
+    
+    VkInstanceCreateFlags flags = 0;
+#ifdef VK_KHR_portability_enumeration
+    // MoltenVK only enumerates with this, harmless elsewhere
+    if (hasExtension(availableExtensions, VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME)) {
+        extensions.push_back(VK_KHR_PORTABILITY_ENUMERATION_EXTENSION_NAME);
+        flags |= VK_INSTANCE_CREATE_ENUMERATE_PORTABILITY_BIT_KHR;
+    }
+#endif
+    
+    VkApplicationInfo appInfo = {};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.pApplicationName = desc.applicationName.c_str();
+    appInfo.applicationVersion = desc.applicationVersion;
+    appInfo.pEngineName = desc.engineName.c_str();
+    appInfo.engineVersion = desc.engineVersion;
+    appInfo.apiVersion = _apiVersion;
+    
+    VkDebugUtilsMessengerCreateInfoEXT messengerInfo = {};
+    messengerInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    messengerInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT |
+                                    VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+    messengerInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+                                VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT |
+                                VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    messengerInfo.pfnUserCallback = debugCallback;
+    
+    // Opt-in layer checks, both are expensive
+    std::vector<VkValidationFeatureEnableEXT> validationFeatures;
+    if (!layers.empty() && desc.enableGPUBasedValidation) {
+        validationFeatures.push_back(VK_VALIDATION_FEATURE_ENABLE_GPU_ASSISTED_EXT);
+    }
+    if (!layers.empty() && desc.enableSynchronizationValidation) {
+        validationFeatures.push_back(VK_VALIDATION_FEATURE_ENABLE_SYNCHRONIZATION_VALIDATION_EXT);
+    }
+    VkValidationFeaturesEXT validationInfo = {};
+    validationInfo.sType = VK_STRUCTURE_TYPE_VALIDATION_FEATURES_EXT;
+    validationInfo.pNext = debugMessages ? &messengerInfo : nullptr;  // Also covers vkCreateInstance itself
+    validationInfo.enabledValidationFeatureCount = static_cast<uint32_t>(validationFeatures.size());
+    validationInfo.pEnabledValidationFeatures = validationFeatures.data();
+    
+    VkInstanceCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    createInfo.pNext = validationFeatures.empty() ? validationInfo.pNext : &validationInfo;
+    createInfo.flags = flags;
+    createInfo.pApplicationInfo = &appInfo;
+    createInfo.enabledLayerCount = static_cast<uint32_t>(layers.size());
+    createInfo.ppEnabledLayerNames = layers.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
+    
+    const VkResult result = vkCreateInstance(&createInfo, nullptr, &_instance);
+    if (result != VK_SUCCESS) {
+        Logger::Instance().LogFormat(LogLevel::Error, "VulkanInstance", PERS_SOURCE_LOC,
+            "vkCreateInstance failed (%d)", static_cast<int>(result));
+        _instance = VK_NULL_HANDLE;
+        return false;
+    }
+    
+    if (debugMessages) {
+        auto createMessenger = reinterpret_cast<PFN_vkCreateDebugUtilsMessengerEXT>(
+            vkGetInstanceProcAddr(_instance, "vkCreateDebugUtilsMessengerEXT"));
+        if (!createMessenger || createMessenger(_instance, &messengerInfo, nullptr, &_messenger) != VK_SUCCESS) {
+            LOG_WARNING("VulkanInstance", "Failed to create the debug messenger");
+            _messenger = VK_NULL_HANDLE;
+        }
+    }
+    
+    Logger::Instance().LogFormat(LogLevel::Info, "VulkanInstance", PERS_SOURCE_LOC,
+        "Vulkan %u.%u instance created (%zu layers, %zu extensions)",
+        VK_API_VERSION_MAJOR(_apiVersion), VK_API_VERSION_MINOR(_apiVersion),
+        layers.size(), extensions.size());
+    return true;
+}
+
+std::vector<std::shared_ptr<IPhysicalDevice>> VulkanInstance::enumeratePhysicalDevices() {
+    std::vector<std::shared_ptr<IPhysicalDevice>> devices;
+    if (_instance == VK_NULL_HANDLE) {
+        LOG_ERROR("VulkanInstance", "Instance not initialized");
+        return devices;
+    }
+    
+    uint32_t count = 0;
+    vkEnumeratePhysicalDevices(_instance, &count, nullptr);
+    std::vector<VkPhysicalDevice> handles(count);
+    vkEnumeratePhysicalDevices(_instance, &count, handles.data());
+    
+    const std::shared_ptr<const VulkanInstance> self = shared_from_this();
+    devices.reserve(count);
+    for (VkPhysicalDevice handle : handles) {
+        devices.push_back(std::make_shared<VulkanPhysicalDevice>(handle, self));
+    }
+    return devices;
+}
+
+std::shared_ptr<IPhysicalDevice> VulkanInstance::requestPhysicalDevice(
+    const PhysicalDeviceOptions& options) {
+    
+    if (options.compatibleSurface) {
+        LOG_ERROR("VulkanInstance", "Surfaces are not supported by the Vulkan backend yet");
+        return nullptr;
+    }
+    
+    const bool preferLowPower = options.powerPreference == PowerPreference::LowPower ||
+        (options.powerPreference == PowerPreference::Default && !_desc.preferHighPerformanceGPU);
+    const bool allowSoftware = options.forceFallbackAdapter || _desc.allowSoftwareRenderer;
+    
+    std::shared_ptr<VulkanPhysicalDevice> best;
+    int bestScore = -1;
+    for (auto& device : enumeratePhysicalDevices()) {
+        auto vulkanDevice = std::static_pointer_cast<VulkanPhysicalDevice>(device);
+        int score = scorePhysicalDevice(vulkanDevice->getDeviceType(), preferLowPower, allowSoftware);
+        if (options.forceFallbackAdapter && score >= 0) {
+            score = vulkanDevice->getDeviceType() == VK_PHYSICAL_DEVICE_TYPE_CPU ? 8 : -1;
+        }
+        if (score > bestScore) {
+            best = std::move(vulkanDevice);
+            bestScore = score;
+        }
+    }
+    
+    if (!best) {
+        LOG_ERROR("VulkanInstance", "No suitable Vulkan physical device");
+        return nullptr;
+    }
+    
+    Logger::Instance().LogFormat(LogLevel::Info, "VulkanInstance", PERS_SOURCE_LOC,
+        "Selected %s", best->getCapabilities().deviceName.c_str());
+    return best;
+}
+
+NativeSurfaceHandle VulkanInstance::createSurface(void* windowHandle) {
+    (void)windowHandle;
+    LOG_ERROR("VulkanInstance", "Surfaces are not supported by the Vulkan backend yet");
+    return NativeSurfaceHandle();
+}
+
+void VulkanInstance::processEvents() {
+}
+
+} // namespace pers
@@ -0,0 +1,26 @@
+#include "pers/graphics/backends/vulkan/VulkanInstanceFactory.h"
+#include "pers/graphics/backends/vulkan/VulkanInstance.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+std::shared_ptr<IInstance> VulkanInstanceFactory::createInstance(
+    const InstanceDesc& desc) {
+    
+    LOG_INFO("VulkanInstanceFactory", "Creating Vulkan instance...");
+    
+    auto instance = std::make_shared<VulkanInstance>();
+    if (!instance->initialize(desc)) {
+        LOG_ERROR("VulkanInstanceFactory", "Failed to initialize Vulkan instance");
+        return nullptr;
+    }
+    
+    return instance;
+}
+
+const std::string& VulkanInstanceFactory::getBackendName() const {
+    static const std::string name = "Vulkan";
+    return name;
+}
+
+} // namespace pers
@@ -0,0 +1,226 @@
+#include "pers/graphics/backends/vulkan/VulkanPhysicalDevice.h"
+#include "pers/graphics/backends/vulkan/VulkanInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+const char* vendorName(uint32_t vendorId) {
+    switch (vendorId) {
+        case 0x1002: return "AMD";
+        case 0x10DE: return "NVIDIA";
+        case 0x8086: return "Intel";
+        case 0x13B5: return "ARM";
+        case 0x5143: return "Qualcomm";
+        case 0x106B: return "Apple";
+        case 0x10005: return "Mesa";
+        default: return "Unknown";
+    }
+}
+
+const char* deviceTypeName(VkPhysicalDeviceType type) {
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "Discrete GPU";
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "Integrated GPU";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "Virtual GPU";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "CPU";
+        default: return "Other";
+    }
+}
+
+} // anonymous namespace
+
+VulkanPhysicalDevice::VulkanPhysicalDevice(VkPhysicalDevice physicalDevice,
+                                           const std::shared_ptr<const VulkanInstance>& instance)
+    : _physicalDevice(physicalDevice)
+    , _instance(instance) {
+    queryCapabilities();
+}
+
+void VulkanPhysicalDevice::queryCapabilities() {
+    vkGetPhysicalDeviceProperties(_physicalDevice, &_properties);
+    vkGetPhysicalDeviceMemoryProperties(_physicalDevice, &_memory);
+    
+    // 1.2 feature and driver structs, the instance guarantees a 1.2 loader but not a 1.2 driver
+    const bool vulkan12 = _properties.apiVersion >= VK_API_VERSION_1_2;
+    
+    VkPhysicalDeviceVulkan12Features features12 = {};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = vulkan12 ? &features12 : nullptr;
+    vkGetPhysicalDeviceFeatures2(_physicalDevice, &features);
+    
+    VkPhysicalDeviceDriverProperties driver = {};
+    driver.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DRIVER_PROPERTIES;
+    VkPhysicalDeviceProperties2 properties = {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = vulkan12 ? &driver : nullptr;
+    vkGetPhysicalDeviceProperties2(_physicalDevice, &properties);
+    
+    const VkPhysicalDeviceFeatures& core = features.features;
+    const VkPhysicalDeviceLimits& limits = _properties.limits;
+    
+    _timelineSemaphores = vulkan12 && features12.timelineSemaphore;
+    
+    PhysicalDeviceCapabilities& caps = _capabilities;
+    caps.deviceName = _properties.deviceName;
+    caps.driverInfo = vulkan12 ? std::string(driver.driverName) + " " + driver.driverInfo
+                               : std::to_string(_properties.driverVersion);
+    caps.vendorName = vendorName(_properties.vendorID);
+    caps.architecture = deviceTypeName(_properties.deviceType);
+    caps.vendorId = _properties.vendorID;
+    caps.deviceId = _properties.deviceID;
+    
+    for (uint32_t i = 0; i < _memory.memoryHeapCount; ++i) {
+        const VkMemoryHeap& heap = _memory.memoryHeaps[i];
+        if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) {
+            caps.dedicatedVideoMemory += heap.size;
+        } else {
+            caps.sharedSystemMemory += heap.size;
+        }
+    }
+    caps.isUnifiedMemory = _properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU ||
+                           _properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU;
+    
+    caps.supportsCompute = true;  // Every Vulkan implementation has a compute-capable family
+    caps.supportsTessellation = core.tessellationShader;
+    caps.supportsShaderF16 = vulkan12 && features12.shaderFloat16;
+    
+    caps.supportsTextureCompressionBC = core.textureCompressionBC;
+    caps.supportsTextureCompressionETC2 = core.textureCompressionETC2;
+    caps.supportsTextureCompressionASTC = core.textureCompressionASTC_LDR;
+    
+    caps.supportsDepth32FloatStencil8 = supportsFormat(VK_FORMAT_D32_SFLOAT_S8_UINT,
+                                                       VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    caps.supportsDepthClipControl = core.depthClamp;
+    caps.supportsRG11B10UfloatRenderable = supportsFormat(VK_FORMAT_B10G11R11_UFLOAT_PACK32,
+                                                          VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT);
+    caps.supportsBGRA8UnormStorage = supportsFormat(VK_FORMAT_B8G8R8A8_UNORM,
+                                                    VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
+    caps.supportsFloat32Filterable = supportsFormat(VK_FORMAT_R32_SFLOAT,
+                                                    VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT);
+    
+    caps.supportsTimestampQuery = limits.timestampComputeAndGraphics;
+    caps.supportsPipelineStatisticsQuery = core.pipelineStatisticsQuery;
+    caps.supportsIndirectFirstInstance = core.drawIndirectFirstInstance;
+    caps.supportsMultiDrawIndirect = core.multiDrawIndirect;
+    caps.supportsMultiDrawIndirectCount = vulkan12 && features12.drawIndirectCount;
+    
+    caps.supportsTextureBindingArray = vulkan12 && features12.runtimeDescriptorArray;
+    caps.supportsBufferBindingArray = vulkan12 && features12.runtimeDescriptorArray;
+    caps.supportsNonUniformIndexing = vulkan12 && features12.shaderSampledImageArrayNonUniformIndexing &&
+                                      features12.shaderStorageBufferArrayNonUniformIndexing;
+    
+    // Host-visible device-local memory makes primary buffers mappable (ReBAR, UMA)
+    for (uint32_t i = 0; i < _memory.memoryTypeCount; ++i) {
+        const VkMemoryPropertyFlags flags = _memory.memoryTypes[i].propertyFlags;
+        if ((flags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) && (flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) {
+            caps.supportsMappablePrimaryBuffers = true;
+            break;
+        }
+    }
+    
+    caps.supportsPushConstants = limits.maxPushConstantsSize > 0;
+    caps.maxPushConstantSize = limits.maxPushConstantsSize;
+    
+    caps.maxTextureSize2D = limits.maxImageDimension2D;
+    caps.maxTextureSize3D = limits.maxImageDimension3D;
+    caps.maxTextureLayers = limits.maxImageArrayLayers;
+    
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(_physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(_physicalDevice, &familyCount, families.data());
+    
+    _queueFamilies.reserve(familyCount);
+    for (uint32_t i = 0; i < familyCount; ++i) {
+        const VkQueueFlags flags = families[i].queueFlags;
+        QueueFamily family;
+        family.index = i;
+        family.queueCount = families[i].queueCount;
+        family.supportsGraphics = flags & VK_QUEUE_GRAPHICS_BIT;
+        family.supportsCompute = flags & VK_QUEUE_COMPUTE_BIT;
+        // Graphics and compute queues implicitly support transfer
+        family.supportsTransfer = flags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+        family.supportsSparse = flags & VK_QUEUE_SPARSE_BINDING_BIT;
+        _queueFamilies.push_back(family);
+    }
+}
+
+bool VulkanPhysicalDevice::supportsFormat(VkFormat format, VkFormatFeatureFlags features) const {
+    VkFormatProperties properties = {};
+    vkGetPhysicalDeviceFormatProperties(_physicalDevice, format, &properties);
+    return (properties.optimalTilingFeatures & features) == features;
+}
+
+PhysicalDeviceCapabilities VulkanPhysicalDevice::getCapabilities() const {
+    return _capabilities;
+}
+
+std::vector<QueueFamily> VulkanPhysicalDevice::getQueueFamilies() const {
+    return _queueFamilies;
+}
+
+DeviceLimits VulkanPhysicalDevice::getLimits() const {
+    const VkPhysicalDeviceLimits& limits = _properties.limits;
+    
+    DeviceLimits result;
+    result.maxTextureDimension1D = limits.maxImageDimension1D;
+    result.maxTextureDimension2D = limits.maxImageDimension2D;
+    result.maxTextureDimension3D = limits.maxImageDimension3D;
+    result.maxTextureArrayLayers = limits.maxImageArrayLayers;
+    result.maxBindGroups = limits.maxBoundDescriptorSets;
+    result.maxBindingsPerBindGroup = limits.maxPerStageResources;
+    result.maxDynamicUniformBuffersPerPipelineLayout = limits.maxDescriptorSetUniformBuffersDynamic;
+    result.maxDynamicStorageBuffersPerPipelineLayout = limits.maxDescriptorSetStorageBuffersDynamic;
+    result.maxSampledTexturesPerShaderStage = limits.maxPerStageDescriptorSampledImages;
+    result.maxSamplersPerShaderStage = limits.maxPerStageDescriptorSamplers;
+    result.maxStorageBuffersPerShaderStage = limits.maxPerStageDescriptorStorageBuffers;
+    result.maxStorageTexturesPerShaderStage = limits.maxPerStageDescriptorStorageImages;
+    result.maxUniformBuffersPerShaderStage = limits.maxPerStageDescriptorUniformBuffers;
+    result.maxUniformBufferBindingSize = limits.maxUniformBufferRange;
+    result.maxStorageBufferBindingSize = limits.maxStorageBufferRange;
+    // maxMemoryAllocationSize needs VkPhysicalDeviceMaintenance3Properties; the largest heap bounds it
+    for (uint32_t i = 0; i < _memory.memoryHeapCount; ++i) {
+        result.maxBufferSize = std::max<uint64_t>(result.maxBufferSize, _memory.memoryHeaps[i].size);
+    }
+    result.maxVertexBuffers = limits.maxVertexInputBindings;
+    result.maxVertexAttributes = limits.maxVertexInputAttributes;
+    result.maxVertexBufferArrayStride = limits.maxVertexInputBindingStride;
+    result.maxInterStageShaderVariables = limits.maxVertexOutputComponents / 4;
+    result.maxComputeWorkgroupStorageSize = limits.maxComputeSharedMemorySize;
+    result.maxComputeInvocationsPerWorkgroup = limits.maxComputeWorkGroupInvocations;
+    result.maxComputeWorkgroupSizeX = limits.maxComputeWorkGroupSize[0];
+    result.maxComputeWorkgroupSizeY = limits.maxComputeWorkGroupSize[1];
+    result.maxComputeWorkgroupSizeZ = limits.maxComputeWorkGroupSize[2];
+    result.maxComputeWorkgroupsPerDimension = std::min({limits.maxComputeWorkGroupCount[0],
+                                                        limits.maxComputeWorkGroupCount[1],
+                                                        limits.maxComputeWorkGroupCount[2]});
+    result.maxPushConstantSize = limits.maxPushConstantsSize;
+    return result;
+}
+
+bool VulkanPhysicalDevice::supportsSurface(const NativeSurfaceHandle& surface) const {
+    (void)surface;
+    return false;
+}
+
+std::shared_ptr<ILogicalDevice> VulkanPhysicalDevice::createLogicalDevice(
+    const LogicalDeviceDesc& desc) {
+    (void)desc;
+    Logger::Instance().LogFormat(LogLevel::Error, "VulkanPhysicalDevice", PERS_SOURCE_LOC,
+        "Logical devices are not implemented by the Vulkan backend yet (%s)",
+        _capabilities.deviceName.c_str());
+    return nullptr;
+}
+
+NativeAdapterHandle VulkanPhysicalDevice::getNativeAdapterHandle() const {
+    return NativeAdapterHandle::fromBackend(_physicalDevice);
+}
+
+} // namespace pers
@@ -0,0 +1,146 @@
+#include "pers/graphics/backends/webgpu/WebGPUBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ISampler.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include <webgpu/wgpu.h>  // For binding arrays
+#include <vector>
+
+namespace pers {
+
+static MetricCounter& liveBindGroups() {
+    static MetricCounter& gauge = Metrics::gauge("pers_bind_groups_live", "Live WebGPU bind groups");
+    return gauge;
+}
+
+WebGPUBindGroup::WebGPUBindGroup(const BindGroupDesc& desc, WGPUDevice device)
+    : _desc(desc) {
+    if (!device) {
+        LOG_ERROR("WebGPUBindGroup",
+            "Cannot create bind group without device");
+        return;
+    }
+    
+    if (!desc.layout) {
+        LOG_ERROR("WebGPUBindGroup",
+            "Cannot create bind group without layout");
+        return;
+    }
+    
+    std::vector<WGPUBindGroupEntry> entries;
+    entries.reserve(desc.entries.size());
+    // Native arrays for binding-array entries, reserved up front so entries can point into them
+    std::vector<WGPUBindGroupEntryExtras> arrayExtras;
+    arrayExtras.reserve(desc.entries.size());
+    std::vector<std::vector<WGPUBuffer>> arrayBuffers;
+    std::vector<std::vector<WGPUSampler>> arraySamplers;
+    std::vector<std::vector<WGPUTextureView>> arrayTextureViews;
+    arrayBuffers.reserve(desc.entries.size());
+    arraySamplers.reserve(desc.entries.size());
+    arrayTextureViews.reserve(desc.entries.size());
+    for (const auto& entry : desc.entries) {
+        WGPUBindGroupEntry native = {};
+        native.binding = entry.binding;
+        
+        if (!entry.buffers.empty() || !entry.textureViews.empty() || !entry.samplers.empty()) {
+            WGPUBindGroupEntryExtras& extras = arrayExtras.emplace_back();
+            extras.chain.sType = static_cast<WGPUSType>(WGPUSType_BindGroupEntryExtras);
+            
+            auto& buffers = arrayBuffers.emplace_back();
+            for (const auto& buffer : entry.buffers) {
+                if (!buffer || buffer->getNativeOffset() != 0) {
+                    // Array elements are bound whole, a sub-allocation would expose its neighbours
+                    Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroup",
+                        PERS_SOURCE_LOC, "Binding %u has a null or sub-allocated buffer in its array", entry.binding);
+                    return;
+                }
+                buffers.push_back(buffer->getNativeHandle().as<WGPUBuffer>());
+            }
+            auto& samplers = arraySamplers.emplace_back();
+            for (const auto& sampler : entry.samplers) {
+                if (!sampler) {
+                    Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroup",
+                        PERS_SOURCE_LOC, "Binding %u has a null sampler in its array", entry.binding);
+                    return;
+                }
+                samplers.push_back(sampler->getNativeSamplerHandle().as<WGPUSampler>());
+            }
+            auto& textureViews = arrayTextureViews.emplace_back();
+            for (const auto& textureView : entry.textureViews) {
+                if (!textureView) {
+                    Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroup",
+                        PERS_SOURCE_LOC, "Binding %u has a null texture view in its array", entry.binding);
+                    return;
+                }
+                textureViews.push_back(textureView->getNativeTextureViewHandle().as<WGPUTextureView>());
+            }
+            
+            extras.buffers = buffers.data();
+            extras.bufferCount = buffers.size();
+            extras.samplers = samplers.data();
+            extras.samplerCount = samplers.size();
+            extras.textureViews = textureViews.data();
+            extras.textureViewCount = textureViews.size();
+            native.nextInChain = &extras.chain;
+        } else if (entry.buffer) {
+            native.buffer = entry.buffer->getNativeHandle().as<WGPUBuffer>();
+            // Sub-allocated buffers live at an offset inside the native buffer
+            native.offset = entry.buffer->getNativeOffset() + entry.offset;
+            if (entry.size != BufferCopyDesc::WHOLE_SIZE) {
+                native.size = entry.size;
+            } else if (entry.buffer->getNativeOffset() != 0) {
+                // WGPU_WHOLE_SIZE would run past the view into the parent allocation
+                native.size = entry.buffer->getSize() - entry.offset;
+            } else {
+                native.size = WGPU_WHOLE_SIZE;
+            }
+        } else if (entry.textureView) {
+            native.textureView = entry.textureView->getNativeTextureViewHandle().as<WGPUTextureView>();
+        } else if (entry.sampler) {
+            native.sampler = entry.sampler->getNativeSamplerHandle().as<WGPUSampler>();
+        } else {
+            Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroup",
+                PERS_SOURCE_LOC, "Binding %u has no resource", entry.binding);
+            return;
+        }
+        entries.push_back(native);
+    }
+    
+    WGPUBindGroupDescriptor groupDesc = {};
+    groupDesc.label = WGPUStringView{_desc.debugName.data(), _desc.debugName.length()};
+    groupDesc.layout = desc.layout->getNativeBindGroupLayoutHandle().as<WGPUBindGroupLayout>();
+    groupDesc.entryCount = entries.size();
+    groupDesc.entries = entries.data();
+    
+    _bindGroup = wgpuDeviceCreateBindGroup(device, &groupDesc);
+    if (!_bindGroup) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroup",
+            PERS_SOURCE_LOC, "Failed to create bind group: %s", _desc.debugName.c_str());
+    } else {
+        liveBindGroups().increment();
+    }
+}
+
+WebGPUBindGroup::~WebGPUBindGroup() {
+    if (_bindGroup) {
+        wgpuBindGroupRelease(_bindGroup);
+        _bindGroup = nullptr;
+        liveBindGroups().decrement();
+    }
+}
+
+const std::shared_ptr<IBindGroupLayout>& WebGPUBindGroup::getLayout() const {
+    return _desc.layout;
+}
+
+const BindGroupDesc& WebGPUBindGroup::getDesc() const {
+    return _desc;
+}
+
+NativeBindGroupHandle WebGPUBindGroup::getNativeBindGroupHandle() const {
+    return NativeBindGroupHandle::fromBackend(_bindGroup);
+}
+
+} // namespace pers
@@ -0,0 +1,93 @@
+#include "pers/graphics/backends/webgpu/WebGPUBindGroupLayout.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>  // For binding array counts
+#include <vector>
+
+namespace pers {
+
+WebGPUBindGroupLayout::WebGPUBindGroupLayout(const BindGroupLayoutDesc& desc, WGPUDevice device)
+    : _desc(desc) {
+    if (!device) {
+        LOG_ERROR("WebGPUBindGroupLayout",
+            "Cannot create bind group layout without device");
+        return;
+    }
+    
+    std::vector<WGPUBindGroupLayoutEntry> entries;
+    entries.reserve(desc.entries.size());
+    // Reserved up front, entries point into it
+    std::vector<WGPUBindGroupLayoutEntryExtras> arrayExtras;
+    arrayExtras.reserve(desc.entries.size());
+    for (const auto& entry : desc.entries) {
+        WGPUBindGroupLayoutEntry native = {};
+        native.binding = entry.binding;
+        native.visibility = WebGPUConverters::convertShaderStage(entry.visibility);
+        
+        switch (entry.type) {
+            case BindingType::UniformBuffer:
+            case BindingType::StorageBuffer:
+            case BindingType::ReadOnlyStorageBuffer:
+                native.buffer.type = entry.type == BindingType::UniformBuffer ? WGPUBufferBindingType_Uniform
+                                   : entry.type == BindingType::StorageBuffer ? WGPUBufferBindingType_Storage
+                                   : WGPUBufferBindingType_ReadOnlyStorage;
+                native.buffer.hasDynamicOffset = entry.hasDynamicOffset;
+                native.buffer.minBindingSize = entry.minBindingSize;
+                break;
+            case BindingType::SampledTexture:
+                native.texture.sampleType = WebGPUConverters::convertTextureSampleType(entry.sampleType);
+                native.texture.viewDimension = WebGPUConverters::convertTextureViewDimension(entry.viewDimension);
+                native.texture.multisampled = entry.multisampled;
+                break;
+            case BindingType::Sampler:
+                native.sampler.type = WGPUSamplerBindingType_Filtering;
+                break;
+            case BindingType::NonFilteringSampler:
+                native.sampler.type = WGPUSamplerBindingType_NonFiltering;
+                break;
+            case BindingType::ComparisonSampler:
+                native.sampler.type = WGPUSamplerBindingType_Comparison;
+                break;
+            case BindingType::StorageTexture:
+                native.storageTexture.access = WGPUStorageTextureAccess_WriteOnly;
+                native.storageTexture.format = WebGPUConverters::convertTextureFormat(entry.storageTextureFormat);
+                native.storageTexture.viewDimension = WebGPUConverters::convertTextureViewDimension(entry.viewDimension);
+                break;
+        }
+        if (entry.count > 0) {
+            WGPUBindGroupLayoutEntryExtras& extras = arrayExtras.emplace_back();
+            extras.chain.sType = static_cast<WGPUSType>(WGPUSType_BindGroupLayoutEntryExtras);
+            extras.count = entry.count;
+            native.nextInChain = &extras.chain;
+        }
+        entries.push_back(native);
+    }
+    
+    WGPUBindGroupLayoutDescriptor layoutDesc = {};
+    layoutDesc.label = WGPUStringView{_desc.debugName.data(), _desc.debugName.length()};
+    layoutDesc.entryCount = entries.size();
+    layoutDesc.entries = entries.data();
+    
+    _layout = wgpuDeviceCreateBindGroupLayout(device, &layoutDesc);
+    if (!_layout) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUBindGroupLayout",
+            PERS_SOURCE_LOC, "Failed to create bind group layout: %s", _desc.debugName.c_str());
+    }
+}
+
+WebGPUBindGroupLayout::~WebGPUBindGroupLayout() {
+    if (_layout) {
+        wgpuBindGroupLayoutRelease(_layout);
+        _layout = nullptr;
+    }
+}
+
+const BindGroupLayoutDesc& WebGPUBindGroupLayout::getDesc() const {
+    return _desc;
+}
+
+NativeBindGroupLayoutHandle WebGPUBindGroupLayout::getNativeBindGroupLayoutHandle() const {
+    return NativeBindGroupLayoutHandle::fromBackend(_layout);
+}
+
+} // namespace pers
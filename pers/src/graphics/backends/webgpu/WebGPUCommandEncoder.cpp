@@ -1,20 +1,31 @@
 #include "pers/graphics/backends/webgpu/WebGPUCommandEncoder.h"
 #include "pers/graphics/backends/webgpu/WebGPUCommandBuffer.h"
 #include "pers/graphics/backends/webgpu/WebGPURenderPassEncoder.h"
-#include "pers/graphics/backends/webgpu/WebGPUTextureView.h"
+#include "pers/graphics/backends/webgpu/WebGPUComputePassEncoder.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/backends/webgpu/WebGPUPreparedRenderPass.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/IQuerySet.h"
 #include "pers/graphics/buffers/IBuffer.h"
 #include "pers/graphics/buffers/DeviceBuffer.h"
 #include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
 #include "pers/graphics/buffers/ImmediateStagingBuffer.h"
 #include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/utils/FrameArena.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/PoolAllocator.h"
+#include "pers/utils/Profiler.h"
 #include <algorithm>
-#include <sstream>
 
 namespace pers {
 
-WebGPUCommandEncoder::WebGPUCommandEncoder(WGPUCommandEncoder encoder)
-    : _encoder(encoder) {
+WebGPUCommandEncoder::WebGPUCommandEncoder(WGPUCommandEncoder encoder, bool multiDrawIndirect,
+                                           bool multiDrawIndirectCount)
+    : _encoder(encoder)
+    , _multiDrawIndirect(multiDrawIndirect)
+    , _multiDrawIndirectCount(multiDrawIndirectCount) {
     if (!_encoder) {
         LOG_ERROR("WebGPUCommandEncoder", 
                               "Created with null encoder handle");
@@ -29,6 +40,7 @@ WebGPUCommandEncoder::~WebGPUCommandEncoder() {
 }
 
 std::shared_ptr<IRenderPassEncoder> WebGPUCommandEncoder::beginRenderPass(const RenderPassDesc& desc) {
+    PERS_PROFILE_SCOPE("WebGPUCommandEncoder::beginRenderPass");
     if (!_encoder) {
         LOG_ERROR("WebGPUCommandEncoder", 
                               "Cannot begin render pass with null encoder");
@@ -49,60 +61,18 @@ std::shared_ptr<IRenderPassEncoder> WebGPUCommandEncoder::beginRenderPass(const
         renderPassDesc.label = WGPUStringView{.data = "Render Pass", .length = 11};
     }
     
-    // Setup color attachments
-    std::vector<WGPURenderPassColorAttachment> colorAttachments;
-    for (const auto& attachment : desc.colorAttachments) {
+    // Setup color attachments in frame scratch, consumed by wgpuCommandEncoderBeginRenderPass
+    FrameArena::ScratchScope scratch;
+    auto colorAttachments = scratch.allocateArray<WGPURenderPassColorAttachment>(desc.colorAttachments.size());
+    for (size_t i = 0; i < desc.colorAttachments.size(); ++i) {
+        const auto& attachment = desc.colorAttachments[i];
         if (!attachment.view) {
             LOG_ERROR("WebGPUCommandEncoder", 
                                   "Color attachment has null view");
             return nullptr;
         }
         
-        auto webgpuTextureView = std::dynamic_pointer_cast<WebGPUTextureView>(attachment.view);
-        if (!webgpuTextureView) {
-            LOG_ERROR("WebGPUCommandEncoder", 
-                                  "Invalid color attachment type");
-            return nullptr;
-        }
-        
-        WGPURenderPassColorAttachment wgpuAttachment = {};
-        wgpuAttachment.view = webgpuTextureView->getNativeTextureViewHandle().as<WGPUTextureView>();
-        wgpuAttachment.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
-        
-        // Convert LoadOp
-        switch (attachment.loadOp) {
-            case LoadOp::Clear:
-                wgpuAttachment.loadOp = WGPULoadOp_Clear;
-                wgpuAttachment.clearValue = WGPUColor{
-                    attachment.clearColor.r,
-                    attachment.clearColor.g,
-                    attachment.clearColor.b,
-                    attachment.clearColor.a
-                };
-                break;
-            case LoadOp::Load:
-                wgpuAttachment.loadOp = WGPULoadOp_Load;
-                break;
-            case LoadOp::Undefined:
-            default:
-                wgpuAttachment.loadOp = WGPULoadOp_Undefined;
-                break;
-        }
-        
-        // Convert StoreOp
-        switch (attachment.storeOp) {
-            case StoreOp::Store:
-                wgpuAttachment.storeOp = WGPUStoreOp_Store;
-                break;
-            case StoreOp::Discard:
-                wgpuAttachment.storeOp = WGPUStoreOp_Discard;
-                break;
-            default:
-                wgpuAttachment.storeOp = WGPUStoreOp_Store;
-                break;
-        }
-        
-        colorAttachments.push_back(wgpuAttachment);
+        colorAttachments[i] = WebGPUConverters::convertColorAttachment(attachment);
     }
     
     renderPassDesc.colorAttachmentCount = colorAttachments.size();
@@ -111,79 +81,25 @@ std::shared_ptr<IRenderPassEncoder> WebGPUCommandEncoder::beginRenderPass(const
     // Setup depth stencil attachment if provided
     WGPURenderPassDepthStencilAttachment wgpuDepthStencilAttachment = {};
     if (desc.depthStencilAttachment && desc.depthStencilAttachment->view) {
-        auto webgpuTextureView = std::dynamic_pointer_cast<WebGPUTextureView>(desc.depthStencilAttachment->view);
-        if (!webgpuTextureView) {
-            LOG_ERROR("WebGPUCommandEncoder", 
-                                  "Invalid depth stencil attachment type");
-            return nullptr;
-        }
-        
-        wgpuDepthStencilAttachment.view = webgpuTextureView->getNativeTextureViewHandle().as<WGPUTextureView>();
-        
-        // Convert depth LoadOp
-        switch (desc.depthStencilAttachment->depthLoadOp) {
-            case LoadOp::Clear:
-                wgpuDepthStencilAttachment.depthLoadOp = WGPULoadOp_Clear;
-                wgpuDepthStencilAttachment.depthClearValue = desc.depthStencilAttachment->depthClearValue;
-                break;
-            case LoadOp::Load:
-                wgpuDepthStencilAttachment.depthLoadOp = WGPULoadOp_Load;
-                break;
-            case LoadOp::Undefined:
-            default:
-                wgpuDepthStencilAttachment.depthLoadOp = WGPULoadOp_Undefined;
-                break;
-        }
-        
-        // Convert depth StoreOp
-        switch (desc.depthStencilAttachment->depthStoreOp) {
-            case StoreOp::Store:
-                wgpuDepthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
-                break;
-            case StoreOp::Discard:
-                wgpuDepthStencilAttachment.depthStoreOp = WGPUStoreOp_Discard;
-                break;
-            default:
-                wgpuDepthStencilAttachment.depthStoreOp = WGPUStoreOp_Store;
-                break;
-        }
-        
-        // Convert stencil LoadOp
-        switch (desc.depthStencilAttachment->stencilLoadOp) {
-            case LoadOp::Clear:
-                wgpuDepthStencilAttachment.stencilLoadOp = WGPULoadOp_Clear;
-                wgpuDepthStencilAttachment.stencilClearValue = desc.depthStencilAttachment->stencilClearValue;
-                break;
-            case LoadOp::Load:
-                wgpuDepthStencilAttachment.stencilLoadOp = WGPULoadOp_Load;
-                break;
-            case LoadOp::Undefined:
-            default:
-                wgpuDepthStencilAttachment.stencilLoadOp = WGPULoadOp_Undefined;
-                break;
-        }
-        
-        // Convert stencil StoreOp
-        switch (desc.depthStencilAttachment->stencilStoreOp) {
-            case StoreOp::Store:
-                wgpuDepthStencilAttachment.stencilStoreOp = WGPUStoreOp_Store;
-                break;
-            case StoreOp::Discard:
-                wgpuDepthStencilAttachment.stencilStoreOp = WGPUStoreOp_Discard;
-                break;
-            default:
-                wgpuDepthStencilAttachment.stencilStoreOp = WGPUStoreOp_Store;
-                break;
-        }
-        
-        wgpuDepthStencilAttachment.depthReadOnly = desc.depthStencilAttachment->depthReadOnly;
-        wgpuDepthStencilAttachment.stencilReadOnly = desc.depthStencilAttachment->stencilReadOnly;
-        
+        wgpuDepthStencilAttachment = WebGPUConverters::convertDepthStencilAttachment(*desc.depthStencilAttachment);
         renderPassDesc.depthStencilAttachment = &wgpuDepthStencilAttachment;
     } else {
         renderPassDesc.depthStencilAttachment = nullptr;
     }
     
+    WGPURenderPassTimestampWrites timestampWrites = {};
+    if (WebGPUConverters::convertTimestampWrites(desc.timestampWrites, timestampWrites)) {
+        renderPassDesc.timestampWrites = &timestampWrites;
+    }
+    
+    if (desc.occlusionQuerySet) {
+        if (desc.occlusionQuerySet->getType() == QueryType::Occlusion) {
+            renderPassDesc.occlusionQuerySet = desc.occlusionQuerySet->getNativeQuerySetHandle().as<WGPUQuerySet>();
+        } else {
+            LOG_WARNING("WebGPUCommandEncoder", "Render pass occlusionQuerySet is not an occlusion query set, ignored");
+        }
+    }
+    
     // Begin render pass
     WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(_encoder, &renderPassDesc);
     if (!renderPassEncoder) {
@@ -192,7 +108,76 @@ std::shared_ptr<IRenderPassEncoder> WebGPUCommandEncoder::beginRenderPass(const
         return nullptr;
     }
     
-    return std::make_shared<WebGPURenderPassEncoder>(renderPassEncoder);
+    return makePooledShared<WebGPURenderPassEncoder>(renderPassEncoder, desc.resourceTable, _multiDrawIndirect,
+                                                     _multiDrawIndirectCount);
+}
+
+std::shared_ptr<IRenderPassEncoder> WebGPUCommandEncoder::beginRenderPass(const IPreparedRenderPass& pass) {
+    PERS_PROFILE_SCOPE("WebGPUCommandEncoder::beginRenderPass");
+    if (!_encoder) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Cannot begin render pass with null encoder");
+        return nullptr;
+    }
+    
+    if (_finished) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Cannot begin render pass on finished encoder");
+        return nullptr;
+    }
+    
+    // Prepared passes only come from WebGPUResourceFactory on this backend
+    const auto& prepared = static_cast<const WebGPUPreparedRenderPass&>(pass);
+    if (!prepared.isComplete()) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Prepared render pass has a color attachment without a view");
+        return nullptr;
+    }
+    
+    WGPURenderPassEncoder renderPassEncoder = wgpuCommandEncoderBeginRenderPass(_encoder, &prepared.getNativeDescriptor());
+    if (!renderPassEncoder) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Failed to begin render pass");
+        return nullptr;
+    }
+    
+    return makePooledShared<WebGPURenderPassEncoder>(renderPassEncoder, prepared.getDesc().resourceTable,
+                                                     _multiDrawIndirect, _multiDrawIndirectCount);
+}
+
+std::shared_ptr<IComputePassEncoder> WebGPUCommandEncoder::beginComputePass(const ComputePassDesc& desc) {
+    if (!_encoder) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Cannot begin compute pass with null encoder");
+        return nullptr;
+    }
+    
+    if (_finished) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Cannot begin compute pass on finished encoder");
+        return nullptr;
+    }
+    
+    WGPUComputePassDescriptor computePassDesc = {};
+    if (!desc.label.empty()) {
+        computePassDesc.label = WGPUStringView{.data = desc.label.c_str(), .length = desc.label.length()};
+    } else {
+        computePassDesc.label = WGPUStringView{.data = "Compute Pass", .length = 12};
+    }
+    
+    WGPUComputePassTimestampWrites timestampWrites = {};
+    if (WebGPUConverters::convertTimestampWrites(desc.timestampWrites, timestampWrites)) {
+        computePassDesc.timestampWrites = &timestampWrites;
+    }
+    
+    WGPUComputePassEncoder computePassEncoder = wgpuCommandEncoderBeginComputePass(_encoder, &computePassDesc);
+    if (!computePassEncoder) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                              "Failed to begin compute pass");
+        return nullptr;
+    }
+    
+    return makePooledShared<WebGPUComputePassEncoder>(computePassEncoder);
 }
 
 bool WebGPUCommandEncoder::uploadToDeviceBuffer(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
@@ -214,7 +199,16 @@ bool WebGPUCommandEncoder::uploadToDeviceBuffer(const std::shared_ptr<ImmediateS
         const_cast<ImmediateStagingBuffer*>(stagingBuffer.get())->finalize();
     }
     
-    return copyBufferToBuffer(stagingBuffer, deviceBuffer, copyDesc);
+    if (!copyBufferToBuffer(stagingBuffer, deviceBuffer, copyDesc)) {
+        return false;
+    }
+    
+    static MetricCounter& uploadBytes = Metrics::counter("pers_staging_upload_bytes_total",
+                                                         "Bytes copied from staging to device buffers");
+    uploadBytes.add(static_cast<int64_t>(copyDesc.size != BufferCopyDesc::WHOLE_SIZE
+        ? copyDesc.size
+        : std::min(stagingBuffer->getSize() - copyDesc.srcOffset, deviceBuffer->getSize() - copyDesc.dstOffset)));
+    return true;
 }
 
 bool WebGPUCommandEncoder::downloadFromDeviceBuffer(const std::shared_ptr<DeviceBuffer>& deviceBuffer,
@@ -266,6 +260,305 @@ bool WebGPUCommandEncoder::downloadFromDeviceBuffer(const std::shared_ptr<Immedi
                              copyDesc);
 }
 
+bool WebGPUCommandEncoder::uploadToTexture(const std::shared_ptr<ImmediateStagingBuffer>& stagingBuffer,
+                                           const std::shared_ptr<ITexture>& texture,
+                                           const TextureUploadDesc& desc) {
+    if (!stagingBuffer) {
+        LOG_ERROR("WebGPUCommandEncoder", "Staging buffer is null");
+        return false;
+    }
+    
+    // Staging buffer must be finalized before upload
+    if (!stagingBuffer->isFinalized()) {
+        LOG_WARNING("WebGPUCommandEncoder", "Staging buffer not finalized, finalizing now");
+        stagingBuffer->finalize();
+    }
+    
+    return encodeBufferToTexture(*stagingBuffer, texture, desc);
+}
+
+bool WebGPUCommandEncoder::copyBufferToTexture(const std::shared_ptr<DeviceBuffer>& source,
+                                               const std::shared_ptr<ITexture>& texture,
+                                               const TextureUploadDesc& desc) {
+    if (!source) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source device buffer is null");
+        return false;
+    }
+    
+    if (!hasFlag(source->getUsage(), BufferUsage::CopySrc)) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source device buffer lacks CopySrc usage");
+        return false;
+    }
+    
+    return encodeBufferToTexture(*source, texture, desc);
+}
+
+bool WebGPUCommandEncoder::encodeBufferToTexture(const IBuffer& buffer,
+                                                 const std::shared_ptr<ITexture>& texture,
+                                                 const TextureUploadDesc& desc) {
+    if (!_encoder || _finished) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot copy texture on null or finished encoder");
+        return false;
+    }
+    
+    if (!texture) {
+        LOG_ERROR("WebGPUCommandEncoder", "Destination texture is null");
+        return false;
+    }
+    
+    if ((texture->getUsage() & TextureUsage::CopyDst) == TextureUsage::None) {
+        LOG_ERROR("WebGPUCommandEncoder", "Destination texture lacks CopyDst usage");
+        return false;
+    }
+    
+    if (desc.mipLevel >= texture->getMipLevelCount()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture upload mip level out of range");
+        return false;
+    }
+    
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(texture->getFormat());
+    if (block.blockBytes == 0) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture format cannot be copied from a buffer");
+        return false;
+    }
+    
+    uint32_t mipWidth = std::max(1u, texture->getWidth() >> desc.mipLevel);
+    uint32_t mipHeight = std::max(1u, texture->getHeight() >> desc.mipLevel);
+    if (desc.originX >= mipWidth || desc.originY >= mipHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture upload origin outside of mip level");
+        return false;
+    }
+    
+    WGPUExtent3D extent = {};
+    extent.width = desc.width ? desc.width : mipWidth - desc.originX;
+    extent.height = desc.height ? desc.height : mipHeight - desc.originY;
+    extent.depthOrArrayLayers = 1;
+    
+    if (desc.originX + extent.width > mipWidth || desc.originY + extent.height > mipHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture upload region exceeds mip level");
+        return false;
+    }
+    
+    // Copies of block-compressed levels cover whole blocks, even past the edge
+    // of small mips; WebGPU expects the extent rounded up to the block size
+    extent.width = (extent.width + block.blockWidth - 1) / block.blockWidth * block.blockWidth;
+    extent.height = (extent.height + block.blockHeight - 1) / block.blockHeight * block.blockHeight;
+    
+    uint32_t blocksWide = extent.width / block.blockWidth;
+    uint32_t blocksHigh = extent.height / block.blockHeight;
+    uint32_t rowBytes = blocksWide * block.blockBytes;
+    uint32_t bytesPerRow = desc.bytesPerRow ? desc.bytesPerRow : getTextureReadbackRowPitch(texture->getFormat(), extent.width);
+    
+    if (bytesPerRow % TEXTURE_READBACK_ROW_ALIGNMENT != 0 || bytesPerRow < rowBytes) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                  "Texture upload bytesPerRow must cover a row and be 256-byte aligned, got " + std::to_string(bytesPerRow));
+        return false;
+    }
+    
+    uint64_t requiredBytes = static_cast<uint64_t>(bytesPerRow) * (blocksHigh - 1) + rowBytes;
+    if (desc.bufferOffset + requiredBytes > buffer.getSize()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture upload exceeds source buffer size");
+        return false;
+    }
+    
+    WGPUTexelCopyBufferInfo source = {};
+    source.buffer = buffer.getNativeHandle().as<WGPUBuffer>();
+    source.layout.offset = buffer.getNativeOffset() + desc.bufferOffset;
+    source.layout.bytesPerRow = bytesPerRow;
+    source.layout.rowsPerImage = blocksHigh;
+    
+    WGPUTexelCopyTextureInfo destination = {};
+    destination.texture = texture->getNativeTextureHandle().as<WGPUTexture>();
+    destination.mipLevel = desc.mipLevel;
+    destination.origin = {desc.originX, desc.originY, desc.arrayLayer};
+    destination.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
+    
+    wgpuCommandEncoderCopyBufferToTexture(_encoder, &source, &destination, &extent);
+    return true;
+}
+
+bool WebGPUCommandEncoder::downloadFromTexture(const std::shared_ptr<ITexture>& texture,
+                                               const std::shared_ptr<DeferredStagingBuffer>& readbackBuffer,
+                                               const TextureReadbackDesc& desc) {
+    if (!readbackBuffer) {
+        LOG_ERROR("WebGPUCommandEncoder", "Readback buffer is null");
+        return false;
+    }
+    
+    // Readback buffer must be unmapped before transfer
+    if (readbackBuffer->isMapped()) {
+        LOG_WARNING("WebGPUCommandEncoder", "Readback buffer is mapped, unmapping now");
+        readbackBuffer->unmap();
+    }
+    
+    return encodeTextureToBuffer(texture, *readbackBuffer, desc);
+}
+
+bool WebGPUCommandEncoder::copyTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                                               const std::shared_ptr<DeviceBuffer>& destination,
+                                               const TextureReadbackDesc& desc) {
+    if (!destination) {
+        LOG_ERROR("WebGPUCommandEncoder", "Destination device buffer is null");
+        return false;
+    }
+    
+    if (!hasFlag(destination->getUsage(), BufferUsage::CopyDst)) {
+        LOG_ERROR("WebGPUCommandEncoder", "Destination device buffer lacks CopyDst usage");
+        return false;
+    }
+    
+    return encodeTextureToBuffer(texture, *destination, desc);
+}
+
+bool WebGPUCommandEncoder::encodeTextureToBuffer(const std::shared_ptr<ITexture>& texture,
+                                                 const IBuffer& buffer,
+                                                 const TextureReadbackDesc& desc) {
+    if (!_encoder || _finished) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot copy texture on null or finished encoder");
+        return false;
+    }
+    
+    if (!texture) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source texture is null");
+        return false;
+    }
+    
+    if ((texture->getUsage() & TextureUsage::CopySrc) == TextureUsage::None) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source texture lacks CopySrc usage");
+        return false;
+    }
+    
+    if (desc.mipLevel >= texture->getMipLevelCount()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture readback mip level out of range");
+        return false;
+    }
+    
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(texture->getFormat());
+    if (block.blockBytes == 0) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture format cannot be copied to a buffer");
+        return false;
+    }
+    
+    uint32_t mipWidth = std::max(1u, texture->getWidth() >> desc.mipLevel);
+    uint32_t mipHeight = std::max(1u, texture->getHeight() >> desc.mipLevel);
+    if (desc.originX >= mipWidth || desc.originY >= mipHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture readback origin outside of mip level");
+        return false;
+    }
+    
+    WGPUExtent3D extent = {};
+    extent.width = desc.width ? desc.width : mipWidth - desc.originX;
+    extent.height = desc.height ? desc.height : mipHeight - desc.originY;
+    extent.depthOrArrayLayers = 1;
+    
+    if (desc.originX + extent.width > mipWidth || desc.originY + extent.height > mipHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture readback region exceeds mip level");
+        return false;
+    }
+    
+    uint32_t blocksWide = (extent.width + block.blockWidth - 1) / block.blockWidth;
+    uint32_t blocksHigh = (extent.height + block.blockHeight - 1) / block.blockHeight;
+    uint32_t rowBytes = blocksWide * block.blockBytes;
+    uint32_t bytesPerRow = desc.bytesPerRow ? desc.bytesPerRow : getTextureReadbackRowPitch(texture->getFormat(), extent.width);
+    
+    if (bytesPerRow % TEXTURE_READBACK_ROW_ALIGNMENT != 0 || bytesPerRow < rowBytes) {
+        LOG_ERROR("WebGPUCommandEncoder", 
+                  "Texture readback bytesPerRow must cover a row and be 256-byte aligned, got " + std::to_string(bytesPerRow));
+        return false;
+    }
+    
+    uint64_t requiredBytes = static_cast<uint64_t>(bytesPerRow) * (blocksHigh - 1) + rowBytes;
+    if (desc.bufferOffset + requiredBytes > buffer.getSize()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture readback exceeds destination buffer size");
+        return false;
+    }
+    
+    WGPUTexelCopyTextureInfo source = {};
+    source.texture = texture->getNativeTextureHandle().as<WGPUTexture>();
+    source.mipLevel = desc.mipLevel;
+    source.origin = {desc.originX, desc.originY, desc.arrayLayer};
+    source.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
+    
+    WGPUTexelCopyBufferInfo destination = {};
+    destination.buffer = buffer.getNativeHandle().as<WGPUBuffer>();
+    destination.layout.offset = buffer.getNativeOffset() + desc.bufferOffset;
+    destination.layout.bytesPerRow = bytesPerRow;
+    destination.layout.rowsPerImage = blocksHigh;
+    
+    wgpuCommandEncoderCopyTextureToBuffer(_encoder, &source, &destination, &extent);
+    return true;
+}
+
+bool WebGPUCommandEncoder::copyTextureToTexture(const std::shared_ptr<ITexture>& source,
+                                                const std::shared_ptr<ITexture>& destination,
+                                                const TextureCopyDesc& desc) {
+    if (!_encoder || _finished) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot copy texture on null or finished encoder");
+        return false;
+    }
+    
+    if (!source || !destination) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source or destination texture is null");
+        return false;
+    }
+    
+    if ((source->getUsage() & TextureUsage::CopySrc) == TextureUsage::None) {
+        LOG_ERROR("WebGPUCommandEncoder", "Source texture lacks CopySrc usage");
+        return false;
+    }
+    
+    if ((destination->getUsage() & TextureUsage::CopyDst) == TextureUsage::None) {
+        LOG_ERROR("WebGPUCommandEncoder", "Destination texture lacks CopyDst usage");
+        return false;
+    }
+    
+    if (source->getFormat() != destination->getFormat() ||
+        source->getSampleCount() != destination->getSampleCount()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture copy needs matching formats and sample counts");
+        return false;
+    }
+    
+    if (desc.srcMipLevel >= source->getMipLevelCount() || desc.dstMipLevel >= destination->getMipLevelCount()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture copy mip level out of range");
+        return false;
+    }
+    
+    uint32_t srcWidth = std::max(1u, source->getWidth() >> desc.srcMipLevel);
+    uint32_t srcHeight = std::max(1u, source->getHeight() >> desc.srcMipLevel);
+    uint32_t dstWidth = std::max(1u, destination->getWidth() >> desc.dstMipLevel);
+    uint32_t dstHeight = std::max(1u, destination->getHeight() >> desc.dstMipLevel);
+    if (desc.srcX >= srcWidth || desc.srcY >= srcHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture copy origin outside of source mip level");
+        return false;
+    }
+    
+    WGPUExtent3D extent = {};
+    extent.width = desc.width ? desc.width : srcWidth - desc.srcX;
+    extent.height = desc.height ? desc.height : srcHeight - desc.srcY;
+    extent.depthOrArrayLayers = 1;
+    
+    if (desc.srcX + extent.width > srcWidth || desc.srcY + extent.height > srcHeight ||
+        desc.dstX + extent.width > dstWidth || desc.dstY + extent.height > dstHeight) {
+        LOG_ERROR("WebGPUCommandEncoder", "Texture copy region exceeds a mip level");
+        return false;
+    }
+    
+    WGPUTexelCopyTextureInfo src = {};
+    src.texture = source->getNativeTextureHandle().as<WGPUTexture>();
+    src.mipLevel = desc.srcMipLevel;
+    src.origin = {desc.srcX, desc.srcY, desc.srcArrayLayer};
+    src.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
+    
+    WGPUTexelCopyTextureInfo dst = {};
+    dst.texture = destination->getNativeTextureHandle().as<WGPUTexture>();
+    dst.mipLevel = desc.dstMipLevel;
+    dst.origin = {desc.dstX, desc.dstY, desc.dstArrayLayer};
+    dst.aspect = src.aspect;
+    
+    wgpuCommandEncoderCopyTextureToTexture(_encoder, &src, &dst, &extent);
+    return true;
+}
+
 bool WebGPUCommandEncoder::copyDeviceToDevice(const std::shared_ptr<DeviceBuffer>& source,
                                               const std::shared_ptr<DeviceBuffer>& destination,
                                               const BufferCopyDesc& copyDesc) {
@@ -282,6 +575,101 @@ bool WebGPUCommandEncoder::copyDeviceToDevice(const std::shared_ptr<DeviceBuffer
     return copyBufferToBuffer(source, destination, copyDesc);
 }
 
+bool WebGPUCommandEncoder::clearBuffer(const std::shared_ptr<DeviceBuffer>& buffer,
+                                       uint64_t offset,
+                                       uint64_t size) {
+    if (!_encoder || _finished) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot clear buffer on null or finished encoder");
+        return false;
+    }
+    
+    if (!buffer) {
+        LOG_ERROR("WebGPUCommandEncoder", "Buffer to clear is null");
+        return false;
+    }
+    
+    if (!hasFlag(buffer->getUsage(), BufferUsage::CopyDst)) {
+        LOG_ERROR("WebGPUCommandEncoder", "Buffer to clear lacks CopyDst usage");
+        return false;
+    }
+    
+    if (offset > buffer->getSize()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Clear offset exceeds buffer size");
+        return false;
+    }
+    
+    if (size == BufferCopyDesc::WHOLE_SIZE) {
+        size = buffer->getSize() - offset;
+    }
+    
+    // Same 4-byte rule as buffer copies
+    if (offset % 4 != 0 || size % 4 != 0 || offset + size > buffer->getSize()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Clear range must be 4-byte aligned and inside the buffer");
+        return false;
+    }
+    
+    wgpuCommandEncoderClearBuffer(_encoder, buffer->getNativeHandle().as<WGPUBuffer>(),
+                                  buffer->getNativeOffset() + offset, size);
+    return true;
+}
+
+bool WebGPUCommandEncoder::resolveQuerySet(const std::shared_ptr<IQuerySet>& querySet,
+                                           uint32_t firstQuery,
+                                           uint32_t queryCount,
+                                           const std::shared_ptr<DeviceBuffer>& destination,
+                                           uint64_t destinationOffset) {
+    if (!_encoder) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot resolve queries with null encoder");
+        return false;
+    }
+    
+    if (_finished) {
+        LOG_ERROR("WebGPUCommandEncoder", "Cannot resolve queries on finished encoder");
+        return false;
+    }
+    
+    if (!querySet || !querySet->isValid()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Query set is null or invalid");
+        return false;
+    }
+    
+    if (!destination || !destination->isValid()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Query resolve destination is null or invalid");
+        return false;
+    }
+    
+    if (static_cast<uint64_t>(firstQuery) + queryCount > querySet->getCount()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Query resolve range exceeds query set count");
+        return false;
+    }
+    
+    // WebGPU requires query resolve offsets aligned to 256 bytes
+    const uint64_t QUERY_RESOLVE_ALIGNMENT = 256;
+    if (destinationOffset % QUERY_RESOLVE_ALIGNMENT != 0) {
+        LOG_ERROR_FMT("WebGPUCommandEncoder",
+                      "Query resolve offset must be 256-byte aligned. offset={}", destinationOffset);
+        return false;
+    }
+    
+    const uint64_t resultSize = static_cast<uint64_t>(queryCount) * getQueryValueCount(querySet->getDesc()) * QUERY_RESULT_SIZE;
+    if (destinationOffset + resultSize > destination->getSize()) {
+        LOG_ERROR("WebGPUCommandEncoder", "Query resolve range exceeds destination buffer size");
+        return false;
+    }
+    
+    if ((destination->getUsage() & BufferUsage::QueryResolve) == BufferUsage::None) {
+        LOG_ERROR("WebGPUCommandEncoder", "Query resolve destination needs QueryResolve usage");
+        return false;
+    }
+    
+    wgpuCommandEncoderResolveQuerySet(_encoder,
+                                      querySet->getNativeQuerySetHandle().as<WGPUQuerySet>(),
+                                      firstQuery, queryCount,
+                                      destination->getNativeHandle().as<WGPUBuffer>(),
+                                      destinationOffset);
+    return true;
+}
+
 bool WebGPUCommandEncoder::copyBufferToBuffer(const std::shared_ptr<IBuffer>& source,
                                               const std::shared_ptr<IBuffer>& destination,
                                               const BufferCopyDesc& copyDesc) {
@@ -377,20 +765,20 @@ bool WebGPUCommandEncoder::copyBufferToBuffer(const std::shared_ptr<IBuffer>& so
     wgpuCommandEncoderCopyBufferToBuffer(
         _encoder,
         srcHandle.as<WGPUBuffer>(),
-        copyDesc.srcOffset,
+        source->getNativeOffset() + copyDesc.srcOffset,
         dstHandle.as<WGPUBuffer>(),
-        copyDesc.dstOffset,
+        destination->getNativeOffset() + copyDesc.dstOffset,
         alignedSize
     );
     
-    std::stringstream ss;
-    ss << "Copied " << alignedSize << " bytes from offset " << copyDesc.srcOffset << " to offset " << copyDesc.dstOffset;
-    LOG_DEBUG("WebGPUCommandEncoder", ss.str());
+    LOG_DEBUG_FMT("WebGPUCommandEncoder", "Copied {} bytes from offset {} to offset {}",
+                  alignedSize, copyDesc.srcOffset, copyDesc.dstOffset);
     
     return true;
 }
 
 std::shared_ptr<ICommandBuffer> WebGPUCommandEncoder::finish() {
+    PERS_PROFILE_SCOPE("WebGPUCommandEncoder::finish");
     if (!_encoder) {
         LOG_ERROR("WebGPUCommandEncoder", 
                               "Cannot finish null encoder");
@@ -416,7 +804,7 @@ std::shared_ptr<ICommandBuffer> WebGPUCommandEncoder::finish() {
     
     _finished = true;
     
-    return std::make_shared<WebGPUCommandBuffer>(commandBuffer);
+    return makePooledShared<WebGPUCommandBuffer>(commandBuffer);
 }
 
 NativeEncoderHandle WebGPUCommandEncoder::getNativeEncoderHandle() const {
@@ -0,0 +1,203 @@
+#include "pers/graphics/backends/webgpu/WebGPUComputePassEncoder.h"
+#include "pers/graphics/IComputePipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include <webgpu/wgpu.h>  // For pipeline statistics queries and push constants
+
+namespace pers {
+
+WebGPUComputePassEncoder::WebGPUComputePassEncoder(WGPUComputePassEncoder encoder)
+    : _encoder(encoder) {
+    if (!_encoder) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Created with null encoder handle");
+    }
+}
+
+WebGPUComputePassEncoder::~WebGPUComputePassEncoder() {
+    if (_encoder) {
+        if (!_ended) {
+            LOG_WARNING("WebGPUComputePassEncoder", 
+                                  "Compute pass encoder destroyed without calling end()");
+            end();
+        }
+        wgpuComputePassEncoderRelease(_encoder);
+        _encoder = nullptr;
+    }
+}
+
+void WebGPUComputePassEncoder::setPipeline(const std::shared_ptr<IComputePipeline>& pipeline) {
+    if (!canEncode("set pipeline")) {
+        return;
+    }
+    
+    if (!pipeline || !pipeline->isValid()) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Invalid compute pipeline");
+        return;
+    }
+    
+    wgpuComputePassEncoderSetPipeline(_encoder, pipeline->getNativePipelineHandle().as<WGPUComputePipeline>());
+    _hasPipeline = true;
+}
+
+void WebGPUComputePassEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                            std::span<const uint32_t> dynamicOffsets) {
+    if (!canEncode("set bind group")) {
+        return;
+    }
+    
+    if (!bindGroup) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Bind group is null");
+        return;
+    }
+    
+    wgpuComputePassEncoderSetBindGroup(_encoder, index,
+                                       bindGroup->getNativeBindGroupHandle().as<WGPUBindGroup>(),
+                                       dynamicOffsets.size(), dynamicOffsets.data());
+}
+
+void WebGPUComputePassEncoder::setPushConstants(uint32_t offset, std::span<const std::byte> data) {
+    if (!canEncode("set push constants")) {
+        return;
+    }
+    
+    if (data.empty() || offset % 4 != 0 || data.size() % 4 != 0) {
+        LOG_ERROR("WebGPUComputePassEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+        return;
+    }
+    
+    wgpuComputePassEncoderSetPushConstants(_encoder, offset, static_cast<uint32_t>(data.size()), data.data());
+}
+
+void WebGPUComputePassEncoder::dispatch(uint32_t workgroupCountX, uint32_t workgroupCountY,
+                                        uint32_t workgroupCountZ) {
+    if (!canEncode("dispatch")) {
+        return;
+    }
+    
+    if (!_hasPipeline) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Cannot dispatch without a pipeline");
+        return;
+    }
+    
+    ++_dispatches;
+    wgpuComputePassEncoderDispatchWorkgroups(_encoder, workgroupCountX, workgroupCountY, workgroupCountZ);
+}
+
+void WebGPUComputePassEncoder::dispatchIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!canEncode("dispatch indirect")) {
+        return;
+    }
+    
+    if (!_hasPipeline) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Cannot dispatch without a pipeline");
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Invalid indirect buffer - native handle is null");
+        return;
+    }
+    
+    if (indirectOffset % 4 != 0 || indirectOffset + sizeof(DispatchIndirectArgs) > indirectBuffer->getSize()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUComputePassEncoder", PERS_SOURCE_LOC,
+            "Indirect offset %llu exceeds buffer %s or is misaligned",
+            static_cast<unsigned long long>(indirectOffset), indirectBuffer->getDebugName().c_str());
+        return;
+    }
+    
+    ++_dispatches;
+    wgpuComputePassEncoderDispatchWorkgroupsIndirect(_encoder, nativeHandle.as<WGPUBuffer>(),
+                                                     indirectBuffer->getNativeOffset() + indirectOffset);
+}
+
+void WebGPUComputePassEncoder::beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet,
+                                                            uint32_t queryIndex) {
+    if (!canEncode("begin pipeline statistics query")) {
+        return;
+    }
+    
+    if (!querySet || querySet->getType() != QueryType::PipelineStatistics) {
+        LOG_ERROR("WebGPUComputePassEncoder", "Query set is null or not a pipeline statistics query set");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("WebGPUComputePassEncoder", "Pipeline statistics queries cannot nest");
+        return;
+    }
+    
+    wgpuComputePassEncoderBeginPipelineStatisticsQuery(
+        _encoder, querySet->getNativeQuerySetHandle().as<WGPUQuerySet>(), queryIndex);
+    _statisticsQueryOpen = true;
+}
+
+void WebGPUComputePassEncoder::endPipelineStatisticsQuery() {
+    if (!canEncode("end pipeline statistics query")) {
+        return;
+    }
+    
+    if (!_statisticsQueryOpen) {
+        LOG_ERROR("WebGPUComputePassEncoder", "No pipeline statistics query to end");
+        return;
+    }
+    
+    wgpuComputePassEncoderEndPipelineStatisticsQuery(_encoder);
+    _statisticsQueryOpen = false;
+}
+
+void WebGPUComputePassEncoder::end() {
+    if (!_encoder) {
+        LOG_ERROR("WebGPUComputePassEncoder", 
+                              "Cannot end null encoder");
+        return;
+    }
+    
+    if (_ended) {
+        LOG_WARNING("WebGPUComputePassEncoder", 
+                              "Compute pass already ended");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("WebGPUComputePassEncoder", "Compute pass ended with a query still open");
+    }
+    
+    wgpuComputePassEncoderEnd(_encoder);
+    _ended = true;
+    
+    static MetricCounter& dispatches = Metrics::counter("pers_dispatches_total", "Compute dispatches recorded");
+    dispatches.add(_dispatches);
+    
+    Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUComputePassEncoder", PERS_SOURCE_LOC,
+        "Pass ended: %u dispatches", _dispatches);
+}
+
+NativeComputePassEncoderHandle WebGPUComputePassEncoder::getNativeComputePassEncoderHandle() const {
+    return NativeComputePassEncoderHandle::fromBackend(_encoder);
+}
+
+bool WebGPUComputePassEncoder::canEncode(const char* operation) const {
+    if (!_encoder) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUComputePassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s with null encoder", operation);
+        return false;
+    }
+    
+    if (_ended) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUComputePassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on ended compute pass", operation);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,60 @@
+#include "pers/graphics/backends/webgpu/WebGPUComputePipeline.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/backends/webgpu/WebGPUShaderModule.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/utils/Logger.h"
+#include <vector>
+
+namespace pers {
+
+WebGPUComputePipeline::WebGPUComputePipeline(const ComputePipelineDesc& desc, WGPUDevice device)
+    : _debugName(desc.debugName) {
+    if (!device) {
+        LOG_ERROR("WebGPUComputePipeline", "Device is null");
+        return;
+    }
+    
+    if (!desc.compute) {
+        LOG_ERROR("WebGPUComputePipeline", "Compute shader is required");
+        return;
+    }
+    
+    auto computeModule = static_cast<WebGPUShaderModule*>(desc.compute.get());
+    const std::string& entryPoint = computeModule->getEntryPoint();
+    
+    WGPUComputePipelineDescriptor descriptor = {};
+    if (!_debugName.empty()) {
+        descriptor.label = WGPUStringView{_debugName.data(), _debugName.length()};
+    }
+    descriptor.layout = desc.layout
+        ? desc.layout->getNativePipelineLayoutHandle().as<WGPUPipelineLayout>()
+        : nullptr;  // Auto layout
+    descriptor.compute.module = computeModule->getNativeHandle();
+    descriptor.compute.entryPoint = WGPUStringView{entryPoint.data(), entryPoint.length()};
+    
+    std::vector<WGPUConstantEntry> constants;
+    constants.reserve(desc.constants.size());
+    for (const PipelineConstant& constant : desc.constants) {
+        constants.push_back(WebGPUConverters::convertPipelineConstant(constant));
+    }
+    descriptor.compute.constantCount = constants.size();
+    descriptor.compute.constants = constants.empty() ? nullptr : constants.data();
+    
+    _pipeline = wgpuDeviceCreateComputePipeline(device, &descriptor);
+    if (!_pipeline) {
+        LOG_ERROR("WebGPUComputePipeline", "Failed to create compute pipeline");
+    }
+}
+
+WebGPUComputePipeline::~WebGPUComputePipeline() {
+    if (_pipeline) {
+        wgpuComputePipelineRelease(_pipeline);
+        _pipeline = nullptr;
+    }
+}
+
+NativePipelineHandle WebGPUComputePipeline::getNativePipelineHandle() const {
+    return NativePipelineHandle::fromBackend(_pipeline);
+}
+
+} // namespace pers
@@ -1,371 +1,790 @@
 #include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/utils/EnumTable.h"
 #include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>  // For native feature names
+#include <algorithm>
+#include <cstdint>
 
 namespace pers {
 
+namespace {
+
+// Every table below is built at compile time and static_asserted to map each
+// enumerator exactly once, so a new enum value without a WebGPU translation
+// fails the build instead of falling through a switch default at runtime.
+
+template<typename E>
+constexpr size_t enumCount(E last) {
+    return static_cast<size_t>(last) + 1;
+}
+
+// Warns about values outside the enum, as the old switch defaults did
+template<typename Table, typename E>
+auto lookup(const Table& table, E value, const char* enumName) {
+    if (!table.contains(value)) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "WebGPUConverters", PERS_SOURCE_LOC,
+            "Unknown %s value: %d", enumName, static_cast<int>(value));
+    }
+    return table[value];
+}
+
+// Texture formats. Substitutes for formats wgpu-native lacks come last so the
+// reverse table resolves their native format to the exact match.
+constexpr size_t TEXTURE_FORMAT_COUNT = enumCount(TextureFormat::Undefined);
+constexpr size_t WGPU_TEXTURE_FORMAT_COUNT = static_cast<size_t>(WGPUTextureFormat_ASTC12x12UnormSrgb) + 1;
+
+constexpr EnumMapping<TextureFormat, WGPUTextureFormat> TEXTURE_FORMATS[] = {
+    {TextureFormat::R8Unorm, WGPUTextureFormat_R8Unorm},
+    {TextureFormat::R8Snorm, WGPUTextureFormat_R8Snorm},
+    {TextureFormat::R8Uint, WGPUTextureFormat_R8Uint},
+    {TextureFormat::R8Sint, WGPUTextureFormat_R8Sint},
+    {TextureFormat::R16Uint, WGPUTextureFormat_R16Uint},
+    {TextureFormat::R16Sint, WGPUTextureFormat_R16Sint},
+    {TextureFormat::R16Float, WGPUTextureFormat_R16Float},
+    {TextureFormat::RG8Unorm, WGPUTextureFormat_RG8Unorm},
+    {TextureFormat::RG8Snorm, WGPUTextureFormat_RG8Snorm},
+    {TextureFormat::RG8Uint, WGPUTextureFormat_RG8Uint},
+    {TextureFormat::RG8Sint, WGPUTextureFormat_RG8Sint},
+    {TextureFormat::R32Uint, WGPUTextureFormat_R32Uint},
+    {TextureFormat::R32Sint, WGPUTextureFormat_R32Sint},
+    {TextureFormat::R32Float, WGPUTextureFormat_R32Float},
+    {TextureFormat::RG16Uint, WGPUTextureFormat_RG16Uint},
+    {TextureFormat::RG16Sint, WGPUTextureFormat_RG16Sint},
+    {TextureFormat::RG16Float, WGPUTextureFormat_RG16Float},
+    {TextureFormat::RGBA8Unorm, WGPUTextureFormat_RGBA8Unorm},
+    {TextureFormat::RGBA8UnormSrgb, WGPUTextureFormat_RGBA8UnormSrgb},
+    {TextureFormat::RGBA8Snorm, WGPUTextureFormat_RGBA8Snorm},
+    {TextureFormat::RGBA8Uint, WGPUTextureFormat_RGBA8Uint},
+    {TextureFormat::RGBA8Sint, WGPUTextureFormat_RGBA8Sint},
+    {TextureFormat::BGRA8Unorm, WGPUTextureFormat_BGRA8Unorm},
+    {TextureFormat::BGRA8UnormSrgb, WGPUTextureFormat_BGRA8UnormSrgb},
+    {TextureFormat::RGB9E5Ufloat, WGPUTextureFormat_RGB9E5Ufloat},
+    {TextureFormat::RGB10A2Unorm, WGPUTextureFormat_RGB10A2Unorm},
+    {TextureFormat::RG11B10Ufloat, WGPUTextureFormat_RG11B10Ufloat},
+    {TextureFormat::RG32Uint, WGPUTextureFormat_RG32Uint},
+    {TextureFormat::RG32Sint, WGPUTextureFormat_RG32Sint},
+    {TextureFormat::RG32Float, WGPUTextureFormat_RG32Float},
+    {TextureFormat::RGBA16Uint, WGPUTextureFormat_RGBA16Uint},
+    {TextureFormat::RGBA16Sint, WGPUTextureFormat_RGBA16Sint},
+    {TextureFormat::RGBA16Float, WGPUTextureFormat_RGBA16Float},
+    {TextureFormat::RGBA32Uint, WGPUTextureFormat_RGBA32Uint},
+    {TextureFormat::RGBA32Sint, WGPUTextureFormat_RGBA32Sint},
+    {TextureFormat::RGBA32Float, WGPUTextureFormat_RGBA32Float},
+    {TextureFormat::Depth16Unorm, WGPUTextureFormat_Depth16Unorm},
+    {TextureFormat::Depth24Plus, WGPUTextureFormat_Depth24Plus},
+    {TextureFormat::Depth24PlusStencil8, WGPUTextureFormat_Depth24PlusStencil8},
+    {TextureFormat::Depth32Float, WGPUTextureFormat_Depth32Float},
+    {TextureFormat::Depth32FloatStencil8, WGPUTextureFormat_Depth32FloatStencil8},
+    {TextureFormat::Stencil8, WGPUTextureFormat_Stencil8},
+    {TextureFormat::BC1RGBAUnorm, WGPUTextureFormat_BC1RGBAUnorm},
+    {TextureFormat::BC1RGBAUnormSrgb, WGPUTextureFormat_BC1RGBAUnormSrgb},
+    {TextureFormat::BC2RGBAUnorm, WGPUTextureFormat_BC2RGBAUnorm},
+    {TextureFormat::BC2RGBAUnormSrgb, WGPUTextureFormat_BC2RGBAUnormSrgb},
+    {TextureFormat::BC3RGBAUnorm, WGPUTextureFormat_BC3RGBAUnorm},
+    {TextureFormat::BC3RGBAUnormSrgb, WGPUTextureFormat_BC3RGBAUnormSrgb},
+    {TextureFormat::BC4RUnorm, WGPUTextureFormat_BC4RUnorm},
+    {TextureFormat::BC4RSnorm, WGPUTextureFormat_BC4RSnorm},
+    {TextureFormat::BC5RGUnorm, WGPUTextureFormat_BC5RGUnorm},
+    {TextureFormat::BC5RGSnorm, WGPUTextureFormat_BC5RGSnorm},
+    {TextureFormat::BC6HRGBUfloat, WGPUTextureFormat_BC6HRGBUfloat},
+    {TextureFormat::BC6HRGBFloat, WGPUTextureFormat_BC6HRGBFloat},
+    {TextureFormat::BC7RGBAUnorm, WGPUTextureFormat_BC7RGBAUnorm},
+    {TextureFormat::BC7RGBAUnormSrgb, WGPUTextureFormat_BC7RGBAUnormSrgb},
+    {TextureFormat::ETC2RGB8Unorm, WGPUTextureFormat_ETC2RGB8Unorm},
+    {TextureFormat::ETC2RGB8UnormSrgb, WGPUTextureFormat_ETC2RGB8UnormSrgb},
+    {TextureFormat::ETC2RGB8A1Unorm, WGPUTextureFormat_ETC2RGB8A1Unorm},
+    {TextureFormat::ETC2RGB8A1UnormSrgb, WGPUTextureFormat_ETC2RGB8A1UnormSrgb},
+    {TextureFormat::ETC2RGBA8Unorm, WGPUTextureFormat_ETC2RGBA8Unorm},
+    {TextureFormat::ETC2RGBA8UnormSrgb, WGPUTextureFormat_ETC2RGBA8UnormSrgb},
+    {TextureFormat::EACR11Unorm, WGPUTextureFormat_EACR11Unorm},
+    {TextureFormat::EACR11Snorm, WGPUTextureFormat_EACR11Snorm},
+    {TextureFormat::EACRG11Unorm, WGPUTextureFormat_EACRG11Unorm},
+    {TextureFormat::EACRG11Snorm, WGPUTextureFormat_EACRG11Snorm},
+    {TextureFormat::ASTC4x4Unorm, WGPUTextureFormat_ASTC4x4Unorm},
+    {TextureFormat::ASTC4x4UnormSrgb, WGPUTextureFormat_ASTC4x4UnormSrgb},
+    {TextureFormat::ASTC5x4Unorm, WGPUTextureFormat_ASTC5x4Unorm},
+    {TextureFormat::ASTC5x4UnormSrgb, WGPUTextureFormat_ASTC5x4UnormSrgb},
+    {TextureFormat::ASTC5x5Unorm, WGPUTextureFormat_ASTC5x5Unorm},
+    {TextureFormat::ASTC5x5UnormSrgb, WGPUTextureFormat_ASTC5x5UnormSrgb},
+    {TextureFormat::ASTC6x5Unorm, WGPUTextureFormat_ASTC6x5Unorm},
+    {TextureFormat::ASTC6x5UnormSrgb, WGPUTextureFormat_ASTC6x5UnormSrgb},
+    {TextureFormat::ASTC6x6Unorm, WGPUTextureFormat_ASTC6x6Unorm},
+    {TextureFormat::ASTC6x6UnormSrgb, WGPUTextureFormat_ASTC6x6UnormSrgb},
+    {TextureFormat::ASTC8x5Unorm, WGPUTextureFormat_ASTC8x5Unorm},
+    {TextureFormat::ASTC8x5UnormSrgb, WGPUTextureFormat_ASTC8x5UnormSrgb},
+    {TextureFormat::ASTC8x6Unorm, WGPUTextureFormat_ASTC8x6Unorm},
+    {TextureFormat::ASTC8x6UnormSrgb, WGPUTextureFormat_ASTC8x6UnormSrgb},
+    {TextureFormat::ASTC8x8Unorm, WGPUTextureFormat_ASTC8x8Unorm},
+    {TextureFormat::ASTC8x8UnormSrgb, WGPUTextureFormat_ASTC8x8UnormSrgb},
+    {TextureFormat::ASTC10x5Unorm, WGPUTextureFormat_ASTC10x5Unorm},
+    {TextureFormat::ASTC10x5UnormSrgb, WGPUTextureFormat_ASTC10x5UnormSrgb},
+    {TextureFormat::ASTC10x6Unorm, WGPUTextureFormat_ASTC10x6Unorm},
+    {TextureFormat::ASTC10x6UnormSrgb, WGPUTextureFormat_ASTC10x6UnormSrgb},
+    {TextureFormat::ASTC10x8Unorm, WGPUTextureFormat_ASTC10x8Unorm},
+    {TextureFormat::ASTC10x8UnormSrgb, WGPUTextureFormat_ASTC10x8UnormSrgb},
+    {TextureFormat::ASTC10x10Unorm, WGPUTextureFormat_ASTC10x10Unorm},
+    {TextureFormat::ASTC10x10UnormSrgb, WGPUTextureFormat_ASTC10x10UnormSrgb},
+    {TextureFormat::ASTC12x10Unorm, WGPUTextureFormat_ASTC12x10Unorm},
+    {TextureFormat::ASTC12x10UnormSrgb, WGPUTextureFormat_ASTC12x10UnormSrgb},
+    {TextureFormat::ASTC12x12Unorm, WGPUTextureFormat_ASTC12x12Unorm},
+    {TextureFormat::ASTC12x12UnormSrgb, WGPUTextureFormat_ASTC12x12UnormSrgb},
+    {TextureFormat::Undefined, WGPUTextureFormat_Undefined},
+    
+    // 16-bit normalized formats are not supported in wgpu-native yet
+    {TextureFormat::R16Unorm, WGPUTextureFormat_R16Float},
+    {TextureFormat::R16Snorm, WGPUTextureFormat_R16Float},
+    {TextureFormat::RG16Unorm, WGPUTextureFormat_RG16Float},
+    {TextureFormat::RG16Snorm, WGPUTextureFormat_RG16Float},
+    {TextureFormat::RGBA16Unorm, WGPUTextureFormat_RGBA16Float},
+    {TextureFormat::RGBA16Snorm, WGPUTextureFormat_RGBA16Float},
+};
+static_assert(coversEnum<TEXTURE_FORMAT_COUNT>(TEXTURE_FORMATS), "TextureFormat mapping is incomplete");
+
+constexpr EnumMapping<TextureFormat, bool> SUBSTITUTED_TEXTURE_FORMATS[] = {
+    {TextureFormat::R16Unorm, true},
+    {TextureFormat::R16Snorm, true},
+    {TextureFormat::RG16Unorm, true},
+    {TextureFormat::RG16Snorm, true},
+    {TextureFormat::RGBA16Unorm, true},
+    {TextureFormat::RGBA16Snorm, true},
+};
+
+constexpr EnumTable<TextureFormat, WGPUTextureFormat, TEXTURE_FORMAT_COUNT> TEXTURE_FORMAT_TABLE(
+    TEXTURE_FORMATS, WGPUTextureFormat_Undefined);
+constexpr EnumTable<TextureFormat, bool, TEXTURE_FORMAT_COUNT> SUBSTITUTED_TEXTURE_FORMAT_TABLE(
+    SUBSTITUTED_TEXTURE_FORMATS, false);
+constexpr ReverseEnumTable<WGPUTextureFormat, TextureFormat, WGPU_TEXTURE_FORMAT_COUNT> WGPU_TEXTURE_FORMAT_TABLE(
+    TEXTURE_FORMATS, TextureFormat::Undefined);
+
+static_assert(TEXTURE_FORMAT_TABLE[TextureFormat::RGBA8Unorm] == WGPUTextureFormat_RGBA8Unorm);
+static_assert(WGPU_TEXTURE_FORMAT_TABLE[WGPUTextureFormat_R16Float] == TextureFormat::R16Float);
+
+// Vertex formats
+constexpr EnumMapping<VertexFormat, WGPUVertexFormat> VERTEX_FORMATS[] = {
+    {VertexFormat::Uint8x2, WGPUVertexFormat_Uint8x2},
+    {VertexFormat::Uint8x4, WGPUVertexFormat_Uint8x4},
+    {VertexFormat::Sint8x2, WGPUVertexFormat_Sint8x2},
+    {VertexFormat::Sint8x4, WGPUVertexFormat_Sint8x4},
+    {VertexFormat::Unorm8x2, WGPUVertexFormat_Unorm8x2},
+    {VertexFormat::Unorm8x4, WGPUVertexFormat_Unorm8x4},
+    {VertexFormat::Snorm8x2, WGPUVertexFormat_Snorm8x2},
+    {VertexFormat::Snorm8x4, WGPUVertexFormat_Snorm8x4},
+    {VertexFormat::Uint16x2, WGPUVertexFormat_Uint16x2},
+    {VertexFormat::Uint16x4, WGPUVertexFormat_Uint16x4},
+    {VertexFormat::Sint16x2, WGPUVertexFormat_Sint16x2},
+    {VertexFormat::Sint16x4, WGPUVertexFormat_Sint16x4},
+    {VertexFormat::Unorm16x2, WGPUVertexFormat_Unorm16x2},
+    {VertexFormat::Unorm16x4, WGPUVertexFormat_Unorm16x4},
+    {VertexFormat::Snorm16x2, WGPUVertexFormat_Snorm16x2},
+    {VertexFormat::Snorm16x4, WGPUVertexFormat_Snorm16x4},
+    {VertexFormat::Float16x2, WGPUVertexFormat_Float16x2},
+    {VertexFormat::Float16x4, WGPUVertexFormat_Float16x4},
+    {VertexFormat::Float32, WGPUVertexFormat_Float32},
+    {VertexFormat::Float32x2, WGPUVertexFormat_Float32x2},
+    {VertexFormat::Float32x3, WGPUVertexFormat_Float32x3},
+    {VertexFormat::Float32x4, WGPUVertexFormat_Float32x4},
+    {VertexFormat::Uint32, WGPUVertexFormat_Uint32},
+    {VertexFormat::Uint32x2, WGPUVertexFormat_Uint32x2},
+    {VertexFormat::Uint32x3, WGPUVertexFormat_Uint32x3},
+    {VertexFormat::Uint32x4, WGPUVertexFormat_Uint32x4},
+    {VertexFormat::Sint32, WGPUVertexFormat_Sint32},
+    {VertexFormat::Sint32x2, WGPUVertexFormat_Sint32x2},
+    {VertexFormat::Sint32x3, WGPUVertexFormat_Sint32x3},
+    {VertexFormat::Sint32x4, WGPUVertexFormat_Sint32x4},
+    {VertexFormat::Uint8, WGPUVertexFormat_Uint8},
+    {VertexFormat::Sint8, WGPUVertexFormat_Sint8},
+    {VertexFormat::Unorm8, WGPUVertexFormat_Unorm8},
+    {VertexFormat::Snorm8, WGPUVertexFormat_Snorm8},
+    {VertexFormat::Uint16, WGPUVertexFormat_Uint16},
+    {VertexFormat::Sint16, WGPUVertexFormat_Sint16},
+    {VertexFormat::Unorm16, WGPUVertexFormat_Unorm16},
+    {VertexFormat::Snorm16, WGPUVertexFormat_Snorm16},
+    {VertexFormat::Float16, WGPUVertexFormat_Float16},
+    {VertexFormat::Unorm10_10_10_2, WGPUVertexFormat_Unorm10_10_10_2},
+    {VertexFormat::Unorm8x4BGRA, WGPUVertexFormat_Unorm8x4BGRA},
+};
+static_assert(coversEnum<enumCount(VertexFormat::Unorm8x4BGRA)>(VERTEX_FORMATS), "VertexFormat mapping is incomplete");
+constexpr EnumTable<VertexFormat, WGPUVertexFormat, enumCount(VertexFormat::Unorm8x4BGRA)> VERTEX_FORMAT_TABLE(
+    VERTEX_FORMATS, WGPUVertexFormat_Float32x3);
+
+constexpr EnumMapping<VertexStepMode, WGPUVertexStepMode> STEP_MODES[] = {
+    {VertexStepMode::Vertex, WGPUVertexStepMode_Vertex},
+    {VertexStepMode::Instance, WGPUVertexStepMode_Instance},
+};
+static_assert(coversEnum<enumCount(VertexStepMode::Instance)>(STEP_MODES), "VertexStepMode mapping is incomplete");
+constexpr EnumTable<VertexStepMode, WGPUVertexStepMode, enumCount(VertexStepMode::Instance)> STEP_MODE_TABLE(
+    STEP_MODES, WGPUVertexStepMode_Vertex);
+
+constexpr EnumMapping<IndexFormat, WGPUIndexFormat> INDEX_FORMATS[] = {
+    {IndexFormat::Undefined, WGPUIndexFormat_Undefined},
+    {IndexFormat::Uint16, WGPUIndexFormat_Uint16},
+    {IndexFormat::Uint32, WGPUIndexFormat_Uint32},
+};
+static_assert(coversEnum<enumCount(IndexFormat::Uint32)>(INDEX_FORMATS), "IndexFormat mapping is incomplete");
+constexpr EnumTable<IndexFormat, WGPUIndexFormat, enumCount(IndexFormat::Uint32)> INDEX_FORMAT_TABLE(
+    INDEX_FORMATS, WGPUIndexFormat_Undefined);
+
+// Primitive state
+constexpr EnumMapping<PrimitiveTopology, WGPUPrimitiveTopology> TOPOLOGIES[] = {
+    {PrimitiveTopology::PointList, WGPUPrimitiveTopology_PointList},
+    {PrimitiveTopology::LineList, WGPUPrimitiveTopology_LineList},
+    {PrimitiveTopology::LineStrip, WGPUPrimitiveTopology_LineStrip},
+    {PrimitiveTopology::TriangleList, WGPUPrimitiveTopology_TriangleList},
+    {PrimitiveTopology::TriangleStrip, WGPUPrimitiveTopology_TriangleStrip},
+};
+static_assert(coversEnum<enumCount(PrimitiveTopology::TriangleStrip)>(TOPOLOGIES), "PrimitiveTopology mapping is incomplete");
+constexpr EnumTable<PrimitiveTopology, WGPUPrimitiveTopology, enumCount(PrimitiveTopology::TriangleStrip)> TOPOLOGY_TABLE(
+    TOPOLOGIES, WGPUPrimitiveTopology_TriangleList);
+
+constexpr EnumMapping<CullMode, WGPUCullMode> CULL_MODES[] = {
+    {CullMode::None, WGPUCullMode_None},
+    {CullMode::Front, WGPUCullMode_Front},
+    {CullMode::Back, WGPUCullMode_Back},
+};
+static_assert(coversEnum<enumCount(CullMode::Back)>(CULL_MODES), "CullMode mapping is incomplete");
+constexpr EnumTable<CullMode, WGPUCullMode, enumCount(CullMode::Back)> CULL_MODE_TABLE(CULL_MODES, WGPUCullMode_None);
+
+constexpr EnumMapping<FrontFace, WGPUFrontFace> FRONT_FACES[] = {
+    {FrontFace::CCW, WGPUFrontFace_CCW},
+    {FrontFace::CW, WGPUFrontFace_CW},
+};
+static_assert(coversEnum<enumCount(FrontFace::CW)>(FRONT_FACES), "FrontFace mapping is incomplete");
+constexpr EnumTable<FrontFace, WGPUFrontFace, enumCount(FrontFace::CW)> FRONT_FACE_TABLE(FRONT_FACES, WGPUFrontFace_CCW);
+
+constexpr EnumMapping<CompareFunction, WGPUCompareFunction> COMPARE_FUNCTIONS[] = {
+    {CompareFunction::Undefined, WGPUCompareFunction_Undefined},
+    {CompareFunction::Never, WGPUCompareFunction_Never},
+    {CompareFunction::Less, WGPUCompareFunction_Less},
+    {CompareFunction::Equal, WGPUCompareFunction_Equal},
+    {CompareFunction::LessEqual, WGPUCompareFunction_LessEqual},
+    {CompareFunction::Greater, WGPUCompareFunction_Greater},
+    {CompareFunction::NotEqual, WGPUCompareFunction_NotEqual},
+    {CompareFunction::GreaterEqual, WGPUCompareFunction_GreaterEqual},
+    {CompareFunction::Always, WGPUCompareFunction_Always},
+};
+static_assert(coversEnum<enumCount(CompareFunction::Always)>(COMPARE_FUNCTIONS), "CompareFunction mapping is incomplete");
+constexpr EnumTable<CompareFunction, WGPUCompareFunction, enumCount(CompareFunction::Always)> COMPARE_FUNCTION_TABLE(
+    COMPARE_FUNCTIONS, WGPUCompareFunction_Always);
+
+constexpr EnumMapping<StencilOperation, WGPUStencilOperation> STENCIL_OPERATIONS[] = {
+    {StencilOperation::Keep, WGPUStencilOperation_Keep},
+    {StencilOperation::Zero, WGPUStencilOperation_Zero},
+    {StencilOperation::Replace, WGPUStencilOperation_Replace},
+    {StencilOperation::Invert, WGPUStencilOperation_Invert},
+    {StencilOperation::IncrementClamp, WGPUStencilOperation_IncrementClamp},
+    {StencilOperation::DecrementClamp, WGPUStencilOperation_DecrementClamp},
+    {StencilOperation::IncrementWrap, WGPUStencilOperation_IncrementWrap},
+    {StencilOperation::DecrementWrap, WGPUStencilOperation_DecrementWrap},
+};
+static_assert(coversEnum<enumCount(StencilOperation::DecrementWrap)>(STENCIL_OPERATIONS),
+              "StencilOperation mapping is incomplete");
+constexpr EnumTable<StencilOperation, WGPUStencilOperation, enumCount(StencilOperation::DecrementWrap)>
+    STENCIL_OPERATION_TABLE(STENCIL_OPERATIONS, WGPUStencilOperation_Keep);
+
+constexpr EnumMapping<BlendOperation, WGPUBlendOperation> BLEND_OPERATIONS[] = {
+    {BlendOperation::Add, WGPUBlendOperation_Add},
+    {BlendOperation::Subtract, WGPUBlendOperation_Subtract},
+    {BlendOperation::ReverseSubtract, WGPUBlendOperation_ReverseSubtract},
+    {BlendOperation::Min, WGPUBlendOperation_Min},
+    {BlendOperation::Max, WGPUBlendOperation_Max},
+};
+static_assert(coversEnum<enumCount(BlendOperation::Max)>(BLEND_OPERATIONS), "BlendOperation mapping is incomplete");
+constexpr EnumTable<BlendOperation, WGPUBlendOperation, enumCount(BlendOperation::Max)> BLEND_OPERATION_TABLE(
+    BLEND_OPERATIONS, WGPUBlendOperation_Add);
+
+constexpr EnumMapping<BlendFactor, WGPUBlendFactor> BLEND_FACTORS[] = {
+    {BlendFactor::Zero, WGPUBlendFactor_Zero},
+    {BlendFactor::One, WGPUBlendFactor_One},
+    {BlendFactor::Src, WGPUBlendFactor_Src},
+    {BlendFactor::OneMinusSrc, WGPUBlendFactor_OneMinusSrc},
+    {BlendFactor::SrcAlpha, WGPUBlendFactor_SrcAlpha},
+    {BlendFactor::OneMinusSrcAlpha, WGPUBlendFactor_OneMinusSrcAlpha},
+    {BlendFactor::Dst, WGPUBlendFactor_Dst},
+    {BlendFactor::OneMinusDst, WGPUBlendFactor_OneMinusDst},
+    {BlendFactor::DstAlpha, WGPUBlendFactor_DstAlpha},
+    {BlendFactor::OneMinusDstAlpha, WGPUBlendFactor_OneMinusDstAlpha},
+    {BlendFactor::SrcAlphaSaturated, WGPUBlendFactor_SrcAlphaSaturated},
+    {BlendFactor::Constant, WGPUBlendFactor_Constant},
+    {BlendFactor::OneMinusConstant, WGPUBlendFactor_OneMinusConstant},
+};
+static_assert(coversEnum<enumCount(BlendFactor::OneMinusConstant)>(BLEND_FACTORS), "BlendFactor mapping is incomplete");
+constexpr EnumTable<BlendFactor, WGPUBlendFactor, enumCount(BlendFactor::OneMinusConstant)> BLEND_FACTOR_TABLE(
+    BLEND_FACTORS, WGPUBlendFactor_One);
+
+// Presentation. PostMultiplied precedes Unpremultiplied so the native
+// Unpremultiplied mode reads back as PostMultiplied, as it always has.
+constexpr EnumMapping<PresentMode, WGPUPresentMode> PRESENT_MODES[] = {
+    {PresentMode::Fifo, WGPUPresentMode_Fifo},
+    {PresentMode::Immediate, WGPUPresentMode_Immediate},
+    {PresentMode::Mailbox, WGPUPresentMode_Mailbox},
+    {PresentMode::FifoRelaxed, WGPUPresentMode_FifoRelaxed},
+};
+static_assert(coversEnum<enumCount(PresentMode::FifoRelaxed)>(PRESENT_MODES), "PresentMode mapping is incomplete");
+constexpr EnumTable<PresentMode, WGPUPresentMode, enumCount(PresentMode::FifoRelaxed)> PRESENT_MODE_TABLE(
+    PRESENT_MODES, WGPUPresentMode_Fifo);
+constexpr ReverseEnumTable<WGPUPresentMode, PresentMode, enumCount(WGPUPresentMode_Mailbox)> WGPU_PRESENT_MODE_TABLE(
+    PRESENT_MODES, PresentMode::Fifo);
+
+constexpr EnumMapping<CompositeAlphaMode, WGPUCompositeAlphaMode> ALPHA_MODES[] = {
+    {CompositeAlphaMode::Auto, WGPUCompositeAlphaMode_Auto},
+    {CompositeAlphaMode::Opaque, WGPUCompositeAlphaMode_Opaque},
+    {CompositeAlphaMode::Premultiplied, WGPUCompositeAlphaMode_Premultiplied},
+    {CompositeAlphaMode::PostMultiplied, WGPUCompositeAlphaMode_Unpremultiplied},
+    {CompositeAlphaMode::Unpremultiplied, WGPUCompositeAlphaMode_Unpremultiplied},
+    {CompositeAlphaMode::Inherit, WGPUCompositeAlphaMode_Inherit},
+};
+static_assert(coversEnum<enumCount(CompositeAlphaMode::PostMultiplied)>(ALPHA_MODES), "CompositeAlphaMode mapping is incomplete");
+constexpr EnumTable<CompositeAlphaMode, WGPUCompositeAlphaMode, enumCount(CompositeAlphaMode::PostMultiplied)> ALPHA_MODE_TABLE(
+    ALPHA_MODES, WGPUCompositeAlphaMode_Auto);
+constexpr ReverseEnumTable<WGPUCompositeAlphaMode, CompositeAlphaMode, enumCount(WGPUCompositeAlphaMode_Inherit)> WGPU_ALPHA_MODE_TABLE(
+    ALPHA_MODES, CompositeAlphaMode::Auto);
+
+// Render pass operations
+constexpr EnumMapping<LoadOp, WGPULoadOp> LOAD_OPS[] = {
+    {LoadOp::Clear, WGPULoadOp_Clear},
+    {LoadOp::Load, WGPULoadOp_Load},
+    {LoadOp::Undefined, WGPULoadOp_Undefined},
+};
+static_assert(coversEnum<enumCount(LoadOp::Undefined)>(LOAD_OPS), "LoadOp mapping is incomplete");
+constexpr EnumTable<LoadOp, WGPULoadOp, enumCount(LoadOp::Undefined)> LOAD_OP_TABLE(LOAD_OPS, WGPULoadOp_Undefined);
+
+constexpr EnumMapping<StoreOp, WGPUStoreOp> STORE_OPS[] = {
+    {StoreOp::Store, WGPUStoreOp_Store},
+    {StoreOp::Discard, WGPUStoreOp_Discard},
+};
+static_assert(coversEnum<enumCount(StoreOp::Discard)>(STORE_OPS), "StoreOp mapping is incomplete");
+constexpr EnumTable<StoreOp, WGPUStoreOp, enumCount(StoreOp::Discard)> STORE_OP_TABLE(STORE_OPS, WGPUStoreOp_Store);
+
+// Textures and samplers
+constexpr EnumMapping<TextureDimension, WGPUTextureDimension> TEXTURE_DIMENSIONS[] = {
+    {TextureDimension::D1, WGPUTextureDimension_1D},
+    {TextureDimension::D2, WGPUTextureDimension_2D},
+    {TextureDimension::D3, WGPUTextureDimension_3D},
+};
+static_assert(coversEnum<enumCount(TextureDimension::D3)>(TEXTURE_DIMENSIONS), "TextureDimension mapping is incomplete");
+constexpr EnumTable<TextureDimension, WGPUTextureDimension, enumCount(TextureDimension::D3)> TEXTURE_DIMENSION_TABLE(
+    TEXTURE_DIMENSIONS, WGPUTextureDimension_2D);
+
+constexpr EnumMapping<TextureViewDimension, WGPUTextureViewDimension> VIEW_DIMENSIONS[] = {
+    {TextureViewDimension::Undefined, WGPUTextureViewDimension_Undefined},
+    {TextureViewDimension::D1, WGPUTextureViewDimension_1D},
+    {TextureViewDimension::D2, WGPUTextureViewDimension_2D},
+    {TextureViewDimension::D2Array, WGPUTextureViewDimension_2DArray},
+    {TextureViewDimension::Cube, WGPUTextureViewDimension_Cube},
+    {TextureViewDimension::CubeArray, WGPUTextureViewDimension_CubeArray},
+    {TextureViewDimension::D3, WGPUTextureViewDimension_3D},
+};
+static_assert(coversEnum<enumCount(TextureViewDimension::D3)>(VIEW_DIMENSIONS), "TextureViewDimension mapping is incomplete");
+constexpr EnumTable<TextureViewDimension, WGPUTextureViewDimension, enumCount(TextureViewDimension::D3)> VIEW_DIMENSION_TABLE(
+    VIEW_DIMENSIONS, WGPUTextureViewDimension_2D);
+
+constexpr EnumMapping<TextureAspect, WGPUTextureAspect> TEXTURE_ASPECTS[] = {
+    {TextureAspect::All, WGPUTextureAspect_All},
+    {TextureAspect::StencilOnly, WGPUTextureAspect_StencilOnly},
+    {TextureAspect::DepthOnly, WGPUTextureAspect_DepthOnly},
+};
+static_assert(coversEnum<enumCount(TextureAspect::DepthOnly)>(TEXTURE_ASPECTS), "TextureAspect mapping is incomplete");
+constexpr EnumTable<TextureAspect, WGPUTextureAspect, enumCount(TextureAspect::DepthOnly)> TEXTURE_ASPECT_TABLE(
+    TEXTURE_ASPECTS, WGPUTextureAspect_All);
+
+constexpr EnumMapping<TextureSampleType, WGPUTextureSampleType> SAMPLE_TYPES[] = {
+    {TextureSampleType::Float, WGPUTextureSampleType_Float},
+    {TextureSampleType::UnfilterableFloat, WGPUTextureSampleType_UnfilterableFloat},
+    {TextureSampleType::Depth, WGPUTextureSampleType_Depth},
+    {TextureSampleType::Sint, WGPUTextureSampleType_Sint},
+    {TextureSampleType::Uint, WGPUTextureSampleType_Uint},
+};
+static_assert(coversEnum<enumCount(TextureSampleType::Uint)>(SAMPLE_TYPES), "TextureSampleType mapping is incomplete");
+constexpr EnumTable<TextureSampleType, WGPUTextureSampleType, enumCount(TextureSampleType::Uint)> SAMPLE_TYPE_TABLE(
+    SAMPLE_TYPES, WGPUTextureSampleType_Float);
+
+constexpr EnumMapping<FilterMode, WGPUFilterMode> FILTER_MODES[] = {
+    {FilterMode::Nearest, WGPUFilterMode_Nearest},
+    {FilterMode::Linear, WGPUFilterMode_Linear},
+};
+static_assert(coversEnum<enumCount(FilterMode::Linear)>(FILTER_MODES), "FilterMode mapping is incomplete");
+constexpr EnumTable<FilterMode, WGPUFilterMode, enumCount(FilterMode::Linear)> FILTER_MODE_TABLE(
+    FILTER_MODES, WGPUFilterMode_Linear);
+
+constexpr EnumMapping<FilterMode, WGPUMipmapFilterMode> MIPMAP_FILTER_MODES[] = {
+    {FilterMode::Nearest, WGPUMipmapFilterMode_Nearest},
+    {FilterMode::Linear, WGPUMipmapFilterMode_Linear},
+};
+static_assert(coversEnum<enumCount(FilterMode::Linear)>(MIPMAP_FILTER_MODES), "Mipmap FilterMode mapping is incomplete");
+constexpr EnumTable<FilterMode, WGPUMipmapFilterMode, enumCount(FilterMode::Linear)> MIPMAP_FILTER_MODE_TABLE(
+    MIPMAP_FILTER_MODES, WGPUMipmapFilterMode_Linear);
+
+// WebGPU has no border color, ClampToBorder degrades to ClampToEdge
+constexpr EnumMapping<AddressMode, WGPUAddressMode> ADDRESS_MODES[] = {
+    {AddressMode::Repeat, WGPUAddressMode_Repeat},
+    {AddressMode::MirrorRepeat, WGPUAddressMode_MirrorRepeat},
+    {AddressMode::ClampToEdge, WGPUAddressMode_ClampToEdge},
+    {AddressMode::ClampToBorder, WGPUAddressMode_ClampToEdge},
+};
+static_assert(coversEnum<enumCount(AddressMode::ClampToBorder)>(ADDRESS_MODES), "AddressMode mapping is incomplete");
+constexpr EnumTable<AddressMode, WGPUAddressMode, enumCount(AddressMode::ClampToBorder)> ADDRESS_MODE_TABLE(
+    ADDRESS_MODES, WGPUAddressMode_ClampToEdge);
+
+constexpr EnumMapping<DeviceFeature, WGPUFeatureName> DEVICE_FEATURES[] = {
+    {DeviceFeature::DepthClipControl, WGPUFeatureName_DepthClipControl},
+    {DeviceFeature::Depth32FloatStencil8, WGPUFeatureName_Depth32FloatStencil8},
+    {DeviceFeature::TimestampQuery, WGPUFeatureName_TimestampQuery},
+    {DeviceFeature::PipelineStatisticsQuery, static_cast<WGPUFeatureName>(WGPUNativeFeature_PipelineStatisticsQuery)},
+    {DeviceFeature::TextureCompressionBC, WGPUFeatureName_TextureCompressionBC},
+    {DeviceFeature::TextureCompressionETC2, WGPUFeatureName_TextureCompressionETC2},
+    {DeviceFeature::TextureCompressionASTC, WGPUFeatureName_TextureCompressionASTC},
+    {DeviceFeature::IndirectFirstInstance, WGPUFeatureName_IndirectFirstInstance},
+    {DeviceFeature::ShaderF16, WGPUFeatureName_ShaderF16},
+    {DeviceFeature::RG11B10UfloatRenderable, WGPUFeatureName_RG11B10UfloatRenderable},
+    {DeviceFeature::BGRA8UnormStorage, WGPUFeatureName_BGRA8UnormStorage},
+    {DeviceFeature::Float32Filterable, WGPUFeatureName_Float32Filterable},
+    {DeviceFeature::MultiDrawIndirect, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirect)},
+    {DeviceFeature::TextureBindingArray, static_cast<WGPUFeatureName>(WGPUNativeFeature_TextureBindingArray)},
+    {DeviceFeature::BufferBindingArray, static_cast<WGPUFeatureName>(WGPUNativeFeature_BufferBindingArray)},
+    {DeviceFeature::NonUniformIndexing,
+     static_cast<WGPUFeatureName>(WGPUNativeFeature_SampledTextureAndStorageBufferArrayNonUniformIndexing)},
+    {DeviceFeature::PartiallyBoundBindingArray, static_cast<WGPUFeatureName>(WGPUNativeFeature_PartiallyBoundBindingArray)},
+    {DeviceFeature::MappablePrimaryBuffers, static_cast<WGPUFeatureName>(WGPUNativeFeature_MappablePrimaryBuffers)},
+    {DeviceFeature::PushConstants, static_cast<WGPUFeatureName>(WGPUNativeFeature_PushConstants)},
+    {DeviceFeature::MultiDrawIndirectCount, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirectCount)},
+};
+static_assert(coversEnum<enumCount(DeviceFeature::MultiDrawIndirectCount)>(DEVICE_FEATURES),
+              "DeviceFeature mapping is incomplete");
+constexpr EnumTable<DeviceFeature, WGPUFeatureName, enumCount(DeviceFeature::MultiDrawIndirectCount)> DEVICE_FEATURE_TABLE(
+    DEVICE_FEATURES, WGPUFeatureName_Force32);
+
+// Flag sets, translated bit by bit
+constexpr EnumMapping<TextureUsage, WGPUTextureUsage> TEXTURE_USAGE_BITS[] = {
+    {TextureUsage::CopySrc, WGPUTextureUsage_CopySrc},
+    {TextureUsage::CopyDst, WGPUTextureUsage_CopyDst},
+    {TextureUsage::TextureBinding, WGPUTextureUsage_TextureBinding},
+    {TextureUsage::StorageBinding, WGPUTextureUsage_StorageBinding},
+    {TextureUsage::RenderAttachment, WGPUTextureUsage_RenderAttachment},
+};
+
+constexpr EnumMapping<BufferUsage, WGPUBufferUsage> BUFFER_USAGE_BITS[] = {
+    {BufferUsage::MapRead, WGPUBufferUsage_MapRead},
+    {BufferUsage::MapWrite, WGPUBufferUsage_MapWrite},
+    {BufferUsage::CopySrc, WGPUBufferUsage_CopySrc},
+    {BufferUsage::CopyDst, WGPUBufferUsage_CopyDst},
+    {BufferUsage::Index, WGPUBufferUsage_Index},
+    {BufferUsage::Vertex, WGPUBufferUsage_Vertex},
+    {BufferUsage::Uniform, WGPUBufferUsage_Uniform},
+    {BufferUsage::Storage, WGPUBufferUsage_Storage},
+    {BufferUsage::Indirect, WGPUBufferUsage_Indirect},
+    {BufferUsage::QueryResolve, WGPUBufferUsage_QueryResolve},
+};
+
+constexpr EnumMapping<ColorWriteMask, WGPUColorWriteMask> COLOR_WRITE_BITS[] = {
+    {ColorWriteMask::Red, WGPUColorWriteMask_Red},
+    {ColorWriteMask::Green, WGPUColorWriteMask_Green},
+    {ColorWriteMask::Blue, WGPUColorWriteMask_Blue},
+    {ColorWriteMask::Alpha, WGPUColorWriteMask_Alpha},
+};
+
+constexpr EnumMapping<ShaderStage, WGPUShaderStage> SHADER_STAGE_BITS[] = {
+    {ShaderStage::Vertex, WGPUShaderStage_Vertex},
+    {ShaderStage::Fragment, WGPUShaderStage_Fragment},
+    {ShaderStage::Compute, WGPUShaderStage_Compute},
+};
+
+static_assert(translateFlags(BufferUsage::All, BUFFER_USAGE_BITS) ==
+              (WGPUBufferUsage_MapRead | WGPUBufferUsage_MapWrite | WGPUBufferUsage_CopySrc |
+               WGPUBufferUsage_CopyDst | WGPUBufferUsage_Index | WGPUBufferUsage_Vertex |
+               WGPUBufferUsage_Uniform | WGPUBufferUsage_Storage | WGPUBufferUsage_Indirect |
+               WGPUBufferUsage_QueryResolve));
+static_assert(translateFlags(ColorWriteMask::All, COLOR_WRITE_BITS) == WGPUColorWriteMask_All);
+
+// Render and compute pass timestamp writes share one layout
+template<typename TimestampWrites>
+bool fillTimestampWrites(const PassTimestampWrites& writes, TimestampWrites& out) {
+    if (!writes.querySet) {
+        return false;
+    }
+    
+    if (writes.querySet->getType() != QueryType::Timestamp) {
+        LOG_WARNING("WebGPUConverters", "Pass timestamp writes need a timestamp query set, ignored");
+        return false;
+    }
+    
+    out.querySet = writes.querySet->getNativeQuerySetHandle().as<WGPUQuerySet>();
+    out.beginningOfPassWriteIndex = writes.beginIndex == QUERY_INDEX_UNUSED
+                                  ? WGPU_QUERY_SET_INDEX_UNDEFINED : writes.beginIndex;
+    out.endOfPassWriteIndex = writes.endIndex == QUERY_INDEX_UNUSED
+                            ? WGPU_QUERY_SET_INDEX_UNDEFINED : writes.endIndex;
+    return true;
+}
+
+} // anonymous namespace
+
 WGPUTextureFormat WebGPUConverters::convertTextureFormat(TextureFormat format) {
-    switch (format) {
-        // 8-bit formats
-        case TextureFormat::R8Unorm: return WGPUTextureFormat_R8Unorm;
-        case TextureFormat::R8Snorm: return WGPUTextureFormat_R8Snorm;
-        case TextureFormat::R8Uint: return WGPUTextureFormat_R8Uint;
-        case TextureFormat::R8Sint: return WGPUTextureFormat_R8Sint;
-        
-        // 16-bit formats
-        case TextureFormat::R16Uint: return WGPUTextureFormat_R16Uint;
-        case TextureFormat::R16Sint: return WGPUTextureFormat_R16Sint;
-        case TextureFormat::R16Float: return WGPUTextureFormat_R16Float;
-        // R16Unorm, R16Snorm not supported in wgpu-native yet
-        case TextureFormat::R16Unorm:
-        case TextureFormat::R16Snorm:
-            LOG_WARNING("WebGPUConverters", 
-                "R16Unorm/R16Snorm not yet supported in wgpu-native, using R16Float");
-            return WGPUTextureFormat_R16Float;
-        case TextureFormat::RG8Unorm: return WGPUTextureFormat_RG8Unorm;
-        case TextureFormat::RG8Snorm: return WGPUTextureFormat_RG8Snorm;
-        case TextureFormat::RG8Uint: return WGPUTextureFormat_RG8Uint;
-        case TextureFormat::RG8Sint: return WGPUTextureFormat_RG8Sint;
-        
-        // 32-bit formats
-        case TextureFormat::R32Float: return WGPUTextureFormat_R32Float;
-        case TextureFormat::R32Uint: return WGPUTextureFormat_R32Uint;
-        case TextureFormat::R32Sint: return WGPUTextureFormat_R32Sint;
-        case TextureFormat::RG16Uint: return WGPUTextureFormat_RG16Uint;
-        case TextureFormat::RG16Sint: return WGPUTextureFormat_RG16Sint;
-        case TextureFormat::RG16Float: return WGPUTextureFormat_RG16Float;
-        // RG16Unorm, RG16Snorm not supported in wgpu-native yet
-        case TextureFormat::RG16Unorm:
-        case TextureFormat::RG16Snorm:
-            LOG_WARNING("WebGPUConverters", 
-                "RG16Unorm/RG16Snorm not yet supported in wgpu-native, using RG16Float");
-            return WGPUTextureFormat_RG16Float;
-        case TextureFormat::RGBA8Unorm: return WGPUTextureFormat_RGBA8Unorm;
-        case TextureFormat::RGBA8UnormSrgb: return WGPUTextureFormat_RGBA8UnormSrgb;
-        case TextureFormat::RGBA8Snorm: return WGPUTextureFormat_RGBA8Snorm;
-        case TextureFormat::RGBA8Uint: return WGPUTextureFormat_RGBA8Uint;
-        case TextureFormat::RGBA8Sint: return WGPUTextureFormat_RGBA8Sint;
-        case TextureFormat::BGRA8Unorm: return WGPUTextureFormat_BGRA8Unorm;
-        case TextureFormat::BGRA8UnormSrgb: return WGPUTextureFormat_BGRA8UnormSrgb;
-        case TextureFormat::RGB10A2Unorm: return WGPUTextureFormat_RGB10A2Unorm;
-        case TextureFormat::RGB9E5Ufloat: return WGPUTextureFormat_RGB9E5Ufloat;
-        case TextureFormat::RG11B10Ufloat: return WGPUTextureFormat_RG11B10Ufloat;
-        
-        // 64-bit formats
-        case TextureFormat::RG32Float: return WGPUTextureFormat_RG32Float;
-        case TextureFormat::RG32Uint: return WGPUTextureFormat_RG32Uint;
-        case TextureFormat::RG32Sint: return WGPUTextureFormat_RG32Sint;
-        case TextureFormat::RGBA16Uint: return WGPUTextureFormat_RGBA16Uint;
-        case TextureFormat::RGBA16Sint: return WGPUTextureFormat_RGBA16Sint;
-        case TextureFormat::RGBA16Float: return WGPUTextureFormat_RGBA16Float;
-        // RGBA16Unorm, RGBA16Snorm not supported in wgpu-native yet
-        case TextureFormat::RGBA16Unorm:
-        case TextureFormat::RGBA16Snorm:
-            LOG_WARNING("WebGPUConverters", 
-                "RGBA16Unorm/RGBA16Snorm not yet supported in wgpu-native, using RGBA16Float");
-            return WGPUTextureFormat_RGBA16Float;
-        
-        // 128-bit formats
-        case TextureFormat::RGBA32Float: return WGPUTextureFormat_RGBA32Float;
-        case TextureFormat::RGBA32Uint: return WGPUTextureFormat_RGBA32Uint;
-        case TextureFormat::RGBA32Sint: return WGPUTextureFormat_RGBA32Sint;
-        
-        // Depth/Stencil formats
-        case TextureFormat::Depth16Unorm: return WGPUTextureFormat_Depth16Unorm;
-        case TextureFormat::Depth24Plus: return WGPUTextureFormat_Depth24Plus;
-        case TextureFormat::Depth24PlusStencil8: return WGPUTextureFormat_Depth24PlusStencil8;
-        case TextureFormat::Depth32Float: return WGPUTextureFormat_Depth32Float;
-        case TextureFormat::Depth32FloatStencil8: return WGPUTextureFormat_Depth32FloatStencil8;
-        case TextureFormat::Stencil8: return WGPUTextureFormat_Stencil8;
-        
-        // BC compressed formats (Desktop only)
-        case TextureFormat::BC1RGBAUnorm: return WGPUTextureFormat_BC1RGBAUnorm;
-        case TextureFormat::BC1RGBAUnormSrgb: return WGPUTextureFormat_BC1RGBAUnormSrgb;
-        case TextureFormat::BC2RGBAUnorm: return WGPUTextureFormat_BC2RGBAUnorm;
-        case TextureFormat::BC2RGBAUnormSrgb: return WGPUTextureFormat_BC2RGBAUnormSrgb;
-        case TextureFormat::BC3RGBAUnorm: return WGPUTextureFormat_BC3RGBAUnorm;
-        case TextureFormat::BC3RGBAUnormSrgb: return WGPUTextureFormat_BC3RGBAUnormSrgb;
-        case TextureFormat::BC4RUnorm: return WGPUTextureFormat_BC4RUnorm;
-        case TextureFormat::BC4RSnorm: return WGPUTextureFormat_BC4RSnorm;
-        case TextureFormat::BC5RGUnorm: return WGPUTextureFormat_BC5RGUnorm;
-        case TextureFormat::BC5RGSnorm: return WGPUTextureFormat_BC5RGSnorm;
-        case TextureFormat::BC6HRGBUfloat: return WGPUTextureFormat_BC6HRGBUfloat;
-        case TextureFormat::BC6HRGBFloat: return WGPUTextureFormat_BC6HRGBFloat;
-        case TextureFormat::BC7RGBAUnorm: return WGPUTextureFormat_BC7RGBAUnorm;
-        case TextureFormat::BC7RGBAUnormSrgb: return WGPUTextureFormat_BC7RGBAUnormSrgb;
-        
-        case TextureFormat::Undefined:
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown texture format: " + std::to_string(static_cast<int>(format)));
-            return WGPUTextureFormat_Undefined;
+    if (SUBSTITUTED_TEXTURE_FORMAT_TABLE[format]) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "WebGPUConverters", PERS_SOURCE_LOC,
+            "Texture format %d is not yet supported in wgpu-native, using its float equivalent",
+            static_cast<int>(format));
     }
+    return lookup(TEXTURE_FORMAT_TABLE, format, "TextureFormat");
 }
 
 TextureFormat WebGPUConverters::convertFromWGPUTextureFormat(WGPUTextureFormat format) {
-    switch (format) {
-        // 8-bit formats
-        case WGPUTextureFormat_R8Unorm: return TextureFormat::R8Unorm;
-        case WGPUTextureFormat_R8Snorm: return TextureFormat::R8Snorm;
-        case WGPUTextureFormat_R8Uint: return TextureFormat::R8Uint;
-        case WGPUTextureFormat_R8Sint: return TextureFormat::R8Sint;
-        
-        // 16-bit formats
-        case WGPUTextureFormat_R16Uint: return TextureFormat::R16Uint;
-        case WGPUTextureFormat_R16Sint: return TextureFormat::R16Sint;
-        case WGPUTextureFormat_R16Float: return TextureFormat::R16Float;
-        // R16Unorm, R16Snorm not supported in wgpu-native yet
-        case WGPUTextureFormat_RG8Unorm: return TextureFormat::RG8Unorm;
-        case WGPUTextureFormat_RG8Snorm: return TextureFormat::RG8Snorm;
-        case WGPUTextureFormat_RG8Uint: return TextureFormat::RG8Uint;
-        case WGPUTextureFormat_RG8Sint: return TextureFormat::RG8Sint;
-        
-        // 32-bit formats
-        case WGPUTextureFormat_R32Float: return TextureFormat::R32Float;
-        case WGPUTextureFormat_R32Uint: return TextureFormat::R32Uint;
-        case WGPUTextureFormat_R32Sint: return TextureFormat::R32Sint;
-        case WGPUTextureFormat_RG16Uint: return TextureFormat::RG16Uint;
-        case WGPUTextureFormat_RG16Sint: return TextureFormat::RG16Sint;
-        case WGPUTextureFormat_RG16Float: return TextureFormat::RG16Float;
-        // RG16Unorm, RG16Snorm not supported in wgpu-native yet
-        case WGPUTextureFormat_RGBA8Unorm: return TextureFormat::RGBA8Unorm;
-        case WGPUTextureFormat_RGBA8UnormSrgb: return TextureFormat::RGBA8UnormSrgb;
-        case WGPUTextureFormat_RGBA8Snorm: return TextureFormat::RGBA8Snorm;
-        case WGPUTextureFormat_RGBA8Uint: return TextureFormat::RGBA8Uint;
-        case WGPUTextureFormat_RGBA8Sint: return TextureFormat::RGBA8Sint;
-        case WGPUTextureFormat_BGRA8Unorm: return TextureFormat::BGRA8Unorm;
-        case WGPUTextureFormat_BGRA8UnormSrgb: return TextureFormat::BGRA8UnormSrgb;
-        case WGPUTextureFormat_RGB10A2Unorm: return TextureFormat::RGB10A2Unorm;
-        case WGPUTextureFormat_RGB9E5Ufloat: return TextureFormat::RGB9E5Ufloat;
-        case WGPUTextureFormat_RG11B10Ufloat: return TextureFormat::RG11B10Ufloat;
-        
-        // 64-bit formats
-        case WGPUTextureFormat_RG32Float: return TextureFormat::RG32Float;
-        case WGPUTextureFormat_RG32Uint: return TextureFormat::RG32Uint;
-        case WGPUTextureFormat_RG32Sint: return TextureFormat::RG32Sint;
-        case WGPUTextureFormat_RGBA16Uint: return TextureFormat::RGBA16Uint;
-        case WGPUTextureFormat_RGBA16Sint: return TextureFormat::RGBA16Sint;
-        case WGPUTextureFormat_RGBA16Float: return TextureFormat::RGBA16Float;
-        // RGBA16Unorm, RGBA16Snorm not supported in wgpu-native yet
-        
-        // 128-bit formats
-        case WGPUTextureFormat_RGBA32Float: return TextureFormat::RGBA32Float;
-        case WGPUTextureFormat_RGBA32Uint: return TextureFormat::RGBA32Uint;
-        case WGPUTextureFormat_RGBA32Sint: return TextureFormat::RGBA32Sint;
-        
-        // Depth/Stencil formats
-        case WGPUTextureFormat_Depth16Unorm: return TextureFormat::Depth16Unorm;
-        case WGPUTextureFormat_Depth24Plus: return TextureFormat::Depth24Plus;
-        case WGPUTextureFormat_Depth24PlusStencil8: return TextureFormat::Depth24PlusStencil8;
-        case WGPUTextureFormat_Depth32Float: return TextureFormat::Depth32Float;
-        case WGPUTextureFormat_Depth32FloatStencil8: return TextureFormat::Depth32FloatStencil8;
-        case WGPUTextureFormat_Stencil8: return TextureFormat::Stencil8;
-        
-        // BC compressed formats (Desktop only)
-        case WGPUTextureFormat_BC1RGBAUnorm: return TextureFormat::BC1RGBAUnorm;
-        case WGPUTextureFormat_BC1RGBAUnormSrgb: return TextureFormat::BC1RGBAUnormSrgb;
-        case WGPUTextureFormat_BC2RGBAUnorm: return TextureFormat::BC2RGBAUnorm;
-        case WGPUTextureFormat_BC2RGBAUnormSrgb: return TextureFormat::BC2RGBAUnormSrgb;
-        case WGPUTextureFormat_BC3RGBAUnorm: return TextureFormat::BC3RGBAUnorm;
-        case WGPUTextureFormat_BC3RGBAUnormSrgb: return TextureFormat::BC3RGBAUnormSrgb;
-        case WGPUTextureFormat_BC4RUnorm: return TextureFormat::BC4RUnorm;
-        case WGPUTextureFormat_BC4RSnorm: return TextureFormat::BC4RSnorm;
-        case WGPUTextureFormat_BC5RGUnorm: return TextureFormat::BC5RGUnorm;
-        case WGPUTextureFormat_BC5RGSnorm: return TextureFormat::BC5RGSnorm;
-        case WGPUTextureFormat_BC6HRGBUfloat: return TextureFormat::BC6HRGBUfloat;
-        case WGPUTextureFormat_BC6HRGBFloat: return TextureFormat::BC6HRGBFloat;
-        case WGPUTextureFormat_BC7RGBAUnorm: return TextureFormat::BC7RGBAUnorm;
-        case WGPUTextureFormat_BC7RGBAUnormSrgb: return TextureFormat::BC7RGBAUnormSrgb;
-        
-        case WGPUTextureFormat_Undefined:
-        default:
-            return TextureFormat::Undefined;
-    }
+    return WGPU_TEXTURE_FORMAT_TABLE[format];
+}
+
+WGPUVertexFormat WebGPUConverters::convertVertexFormat(VertexFormat format) {
+    return lookup(VERTEX_FORMAT_TABLE, format, "VertexFormat");
+}
+
+WGPUVertexStepMode WebGPUConverters::convertVertexStepMode(VertexStepMode mode) {
+    return lookup(STEP_MODE_TABLE, mode, "VertexStepMode");
+}
+
+WGPUIndexFormat WebGPUConverters::convertIndexFormat(IndexFormat format) {
+    return lookup(INDEX_FORMAT_TABLE, format, "IndexFormat");
+}
+
+WGPUPrimitiveTopology WebGPUConverters::convertPrimitiveTopology(PrimitiveTopology topology) {
+    return lookup(TOPOLOGY_TABLE, topology, "PrimitiveTopology");
+}
+
+WGPUCullMode WebGPUConverters::convertCullMode(CullMode mode) {
+    return lookup(CULL_MODE_TABLE, mode, "CullMode");
+}
+
+WGPUFrontFace WebGPUConverters::convertFrontFace(FrontFace face) {
+    return lookup(FRONT_FACE_TABLE, face, "FrontFace");
+}
+
+WGPUColorWriteMask WebGPUConverters::convertColorWriteMask(ColorWriteMask mask) {
+    return translateFlags(mask, COLOR_WRITE_BITS);
+}
+
+WGPUBlendOperation WebGPUConverters::convertBlendOperation(BlendOperation operation) {
+    return lookup(BLEND_OPERATION_TABLE, operation, "BlendOperation");
+}
+
+WGPUBlendFactor WebGPUConverters::convertBlendFactor(BlendFactor factor) {
+    return lookup(BLEND_FACTOR_TABLE, factor, "BlendFactor");
+}
+
+WGPUConstantEntry WebGPUConverters::convertPipelineConstant(const PipelineConstant& constant) {
+    WGPUConstantEntry entry = {};
+    entry.key = WGPUStringView{constant.key.data(), constant.key.length()};
+    entry.value = constant.value;
+    return entry;
 }
 
 WGPUPresentMode WebGPUConverters::convertPresentMode(PresentMode mode) {
-    switch (mode) {
-        case PresentMode::Immediate: return WGPUPresentMode_Immediate;
-        case PresentMode::Mailbox: return WGPUPresentMode_Mailbox;
-        case PresentMode::Fifo: return WGPUPresentMode_Fifo;
-        case PresentMode::FifoRelaxed: return WGPUPresentMode_FifoRelaxed;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown present mode, defaulting to Fifo");
-            return WGPUPresentMode_Fifo;
-    }
+    return lookup(PRESENT_MODE_TABLE, mode, "PresentMode");
 }
 
 PresentMode WebGPUConverters::convertFromWGPUPresentMode(WGPUPresentMode mode) {
-    switch (mode) {
-        case WGPUPresentMode_Immediate: return PresentMode::Immediate;
-        case WGPUPresentMode_Mailbox: return PresentMode::Mailbox;
-        case WGPUPresentMode_Fifo: return PresentMode::Fifo;
-        case WGPUPresentMode_FifoRelaxed: return PresentMode::FifoRelaxed;
-        default:
-            return PresentMode::Fifo;
-    }
+    return WGPU_PRESENT_MODE_TABLE[mode];
 }
 
 WGPUCompositeAlphaMode WebGPUConverters::convertCompositeAlphaMode(CompositeAlphaMode mode) {
-    switch (mode) {
-        case CompositeAlphaMode::Auto: return WGPUCompositeAlphaMode_Auto;
-        case CompositeAlphaMode::Opaque: return WGPUCompositeAlphaMode_Opaque;
-        case CompositeAlphaMode::PreMultiplied: return WGPUCompositeAlphaMode_Premultiplied;
-        case CompositeAlphaMode::PostMultiplied: return WGPUCompositeAlphaMode_Unpremultiplied;
-        case CompositeAlphaMode::Inherit: return WGPUCompositeAlphaMode_Inherit;
-        default:
-            return WGPUCompositeAlphaMode_Auto;
-    }
+    return lookup(ALPHA_MODE_TABLE, mode, "CompositeAlphaMode");
 }
 
 CompositeAlphaMode WebGPUConverters::convertFromWGPUCompositeAlphaMode(WGPUCompositeAlphaMode mode) {
-    switch (mode) {
-        case WGPUCompositeAlphaMode_Auto: return CompositeAlphaMode::Auto;
-        case WGPUCompositeAlphaMode_Opaque: return CompositeAlphaMode::Opaque;
-        case WGPUCompositeAlphaMode_Premultiplied: return CompositeAlphaMode::PreMultiplied;
-        case WGPUCompositeAlphaMode_Unpremultiplied: return CompositeAlphaMode::PostMultiplied;
-        case WGPUCompositeAlphaMode_Inherit: return CompositeAlphaMode::Inherit;
-        default:
-            return CompositeAlphaMode::Auto;
-    }
+    return WGPU_ALPHA_MODE_TABLE[mode];
 }
 
 WGPULoadOp WebGPUConverters::convertLoadOp(LoadOp op) {
-    switch (op) {
-        case LoadOp::Load: return WGPULoadOp_Load;
-        case LoadOp::Clear: return WGPULoadOp_Clear;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown load op, defaulting to Clear");
-            return WGPULoadOp_Clear;
-    }
+    return lookup(LOAD_OP_TABLE, op, "LoadOp");
 }
 
 WGPUStoreOp WebGPUConverters::convertStoreOp(StoreOp op) {
-    switch (op) {
-        case StoreOp::Store: return WGPUStoreOp_Store;
-        case StoreOp::Discard: return WGPUStoreOp_Discard;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown store op, defaulting to Store");
-            return WGPUStoreOp_Store;
-    }
+    return lookup(STORE_OP_TABLE, op, "StoreOp");
 }
 
-WGPUCompareFunction WebGPUConverters::convertCompareFunction(CompareFunction func) {
-    switch (func) {
-        case CompareFunction::Never: return WGPUCompareFunction_Never;
-        case CompareFunction::Less: return WGPUCompareFunction_Less;
-        case CompareFunction::Equal: return WGPUCompareFunction_Equal;
-        case CompareFunction::LessEqual: return WGPUCompareFunction_LessEqual;
-        case CompareFunction::Greater: return WGPUCompareFunction_Greater;
-        case CompareFunction::NotEqual: return WGPUCompareFunction_NotEqual;
-        case CompareFunction::GreaterEqual: return WGPUCompareFunction_GreaterEqual;
-        case CompareFunction::Always: return WGPUCompareFunction_Always;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown compare function, defaulting to Always");
-            return WGPUCompareFunction_Always;
+WGPURenderPassColorAttachment WebGPUConverters::convertColorAttachment(const RenderPassColorAttachment& attachment) {
+    WGPURenderPassColorAttachment out = {};
+    if (attachment.view) {
+        out.view = attachment.view->getNativeTextureViewHandle().as<WGPUTextureView>();
+    }
+    out.depthSlice = WGPU_DEPTH_SLICE_UNDEFINED;
+    if (attachment.resolveTarget) {
+        out.resolveTarget = attachment.resolveTarget->getNativeTextureViewHandle().as<WGPUTextureView>();
     }
-}
-
-WGPUTextureUsage WebGPUConverters::convertTextureUsage(TextureUsage usage) {
-    WGPUTextureUsage flags = WGPUTextureUsage_None;
     
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(TextureUsage::CopySrc)) {
-        flags |= WGPUTextureUsage_CopySrc;
+    out.loadOp = convertLoadOp(attachment.loadOp);
+    out.storeOp = convertStoreOp(attachment.storeOp);
+    if (attachment.loadOp == LoadOp::Clear) {
+        out.clearValue = WGPUColor{
+            attachment.clearColor.r,
+            attachment.clearColor.g,
+            attachment.clearColor.b,
+            attachment.clearColor.a
+        };
     }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(TextureUsage::CopyDst)) {
-        flags |= WGPUTextureUsage_CopyDst;
+    return out;
+}
+
+WGPURenderPassDepthStencilAttachment WebGPUConverters::convertDepthStencilAttachment(
+    const RenderPassDepthStencilAttachment& attachment) {
+    WGPURenderPassDepthStencilAttachment out = {};
+    if (attachment.view) {
+        out.view = attachment.view->getNativeTextureViewHandle().as<WGPUTextureView>();
     }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(TextureUsage::TextureBinding)) {
-        flags |= WGPUTextureUsage_TextureBinding;
+    
+    out.depthReadOnly = attachment.depthReadOnly;
+    out.stencilReadOnly = attachment.stencilReadOnly;
+    
+    // Read-only aspects must not specify load/store operations
+    if (!attachment.depthReadOnly) {
+        out.depthLoadOp = convertLoadOp(attachment.depthLoadOp);
+        out.depthStoreOp = convertStoreOp(attachment.depthStoreOp);
+        if (attachment.depthLoadOp == LoadOp::Clear) {
+            out.depthClearValue = attachment.depthClearValue;
+        }
     }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(TextureUsage::StorageBinding)) {
-        flags |= WGPUTextureUsage_StorageBinding;
+    if (!attachment.stencilReadOnly) {
+        out.stencilLoadOp = convertLoadOp(attachment.stencilLoadOp);
+        out.stencilStoreOp = convertStoreOp(attachment.stencilStoreOp);
+        if (attachment.stencilLoadOp == LoadOp::Clear) {
+            out.stencilClearValue = attachment.stencilClearValue;
+        }
     }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(TextureUsage::RenderAttachment)) {
-        flags |= WGPUTextureUsage_RenderAttachment;
+    return out;
+}
+
+bool WebGPUConverters::convertTimestampWrites(const PassTimestampWrites& writes, WGPURenderPassTimestampWrites& out) {
+    return fillTimestampWrites(writes, out);
+}
+
+bool WebGPUConverters::convertTimestampWrites(const PassTimestampWrites& writes, WGPUComputePassTimestampWrites& out) {
+    return fillTimestampWrites(writes, out);
+}
+
+WGPUCompareFunction WebGPUConverters::convertCompareFunction(CompareFunction func) {
+    return lookup(COMPARE_FUNCTION_TABLE, func, "CompareFunction");
+}
+
+WGPUStencilOperation WebGPUConverters::convertStencilOperation(StencilOperation operation) {
+    return lookup(STENCIL_OPERATION_TABLE, operation, "StencilOperation");
+}
+
+WGPUTextureUsage WebGPUConverters::convertTextureUsage(TextureUsage usage) {
+    return translateFlags(usage, TEXTURE_USAGE_BITS);
+}
+
+TextureUsage WebGPUConverters::convertFromWGPUTextureUsage(WGPUTextureUsage usage) {
+    TextureUsage result = TextureUsage::None;
+    for (const auto& mapping : TEXTURE_USAGE_BITS) {
+        if ((usage & mapping.to) != 0) {
+            result |= mapping.from;
+        }
     }
-    
-    return flags;
+    return result;
 }
 
 WGPUBufferUsage WebGPUConverters::convertBufferUsage(BufferUsage usage) {
-    WGPUBufferUsage flags = WGPUBufferUsage_None;
-    
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::MapRead)) {
-        flags |= WGPUBufferUsage_MapRead;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::MapWrite)) {
-        flags |= WGPUBufferUsage_MapWrite;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::CopySrc)) {
-        flags |= WGPUBufferUsage_CopySrc;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::CopyDst)) {
-        flags |= WGPUBufferUsage_CopyDst;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Index)) {
-        flags |= WGPUBufferUsage_Index;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Vertex)) {
-        flags |= WGPUBufferUsage_Vertex;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Uniform)) {
-        flags |= WGPUBufferUsage_Uniform;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Storage)) {
-        flags |= WGPUBufferUsage_Storage;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::Indirect)) {
-        flags |= WGPUBufferUsage_Indirect;
-    }
-    if (static_cast<uint32_t>(usage) & static_cast<uint32_t>(BufferUsage::QueryResolve)) {
-        flags |= WGPUBufferUsage_QueryResolve;
-    }
-    
-    return flags;
+    return translateFlags(usage, BUFFER_USAGE_BITS);
+}
+
+WGPUShaderStage WebGPUConverters::convertShaderStage(ShaderStage stages) {
+    return translateFlags(stages, SHADER_STAGE_BITS);
 }
 
 WGPUTextureDimension WebGPUConverters::convertTextureDimension(TextureDimension dimension) {
-    switch (dimension) {
-        case TextureDimension::D1: return WGPUTextureDimension_1D;
-        case TextureDimension::D2: return WGPUTextureDimension_2D;
-        case TextureDimension::D3: return WGPUTextureDimension_3D;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown texture dimension, defaulting to 2D");
-            return WGPUTextureDimension_2D;
-    }
+    return lookup(TEXTURE_DIMENSION_TABLE, dimension, "TextureDimension");
 }
 
 WGPUTextureViewDimension WebGPUConverters::convertTextureViewDimension(TextureViewDimension dimension) {
-    switch (dimension) {
-        case TextureViewDimension::Undefined: return WGPUTextureViewDimension_Undefined;
-        case TextureViewDimension::D1: return WGPUTextureViewDimension_1D;
-        case TextureViewDimension::D2: return WGPUTextureViewDimension_2D;
-        case TextureViewDimension::D2Array: return WGPUTextureViewDimension_2DArray;
-        case TextureViewDimension::Cube: return WGPUTextureViewDimension_Cube;
-        case TextureViewDimension::CubeArray: return WGPUTextureViewDimension_CubeArray;
-        case TextureViewDimension::D3: return WGPUTextureViewDimension_3D;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown texture view dimension, defaulting to 2D");
-            return WGPUTextureViewDimension_2D;
-    }
+    return lookup(VIEW_DIMENSION_TABLE, dimension, "TextureViewDimension");
 }
 
 WGPUTextureAspect WebGPUConverters::convertTextureAspect(TextureAspect aspect) {
-    switch (aspect) {
-        case TextureAspect::All: return WGPUTextureAspect_All;
-        case TextureAspect::StencilOnly: return WGPUTextureAspect_StencilOnly;
-        case TextureAspect::DepthOnly: return WGPUTextureAspect_DepthOnly;
-        default:
-            LOG_WARNING("WebGPUConverters", 
-                "Unknown texture aspect, defaulting to All");
-            return WGPUTextureAspect_All;
+    return lookup(TEXTURE_ASPECT_TABLE, aspect, "TextureAspect");
+}
+
+WGPUTextureSampleType WebGPUConverters::convertTextureSampleType(TextureSampleType type) {
+    return lookup(SAMPLE_TYPE_TABLE, type, "TextureSampleType");
+}
+
+WGPUFilterMode WebGPUConverters::convertFilterMode(FilterMode mode) {
+    return lookup(FILTER_MODE_TABLE, mode, "FilterMode");
+}
+
+WGPUMipmapFilterMode WebGPUConverters::convertMipmapFilterMode(FilterMode mode) {
+    return lookup(MIPMAP_FILTER_MODE_TABLE, mode, "FilterMode");
+}
+
+WGPUAddressMode WebGPUConverters::convertAddressMode(AddressMode mode) {
+    if (mode == AddressMode::ClampToBorder) {
+        LOG_WARNING("WebGPUConverters",
+            "ClampToBorder is not supported by WebGPU, using ClampToEdge");
     }
+    return lookup(ADDRESS_MODE_TABLE, mode, "AddressMode");
+}
+
+WGPUFeatureName WebGPUConverters::convertDeviceFeature(DeviceFeature feature) {
+    return lookup(DEVICE_FEATURE_TABLE, feature, "DeviceFeature");
+}
+
+WGPULimits WebGPUConverters::convertToWGPULimits(const DeviceLimits& limits) {
+    WGPULimits wgpuLimits = {};
+    wgpuLimits.maxTextureDimension1D = limits.maxTextureDimension1D;
+    wgpuLimits.maxTextureDimension2D = limits.maxTextureDimension2D;
+    wgpuLimits.maxTextureDimension3D = limits.maxTextureDimension3D;
+    wgpuLimits.maxTextureArrayLayers = limits.maxTextureArrayLayers;
+    wgpuLimits.maxBindGroups = limits.maxBindGroups;
+    wgpuLimits.maxBindingsPerBindGroup = limits.maxBindingsPerBindGroup;
+    wgpuLimits.maxDynamicUniformBuffersPerPipelineLayout = limits.maxDynamicUniformBuffersPerPipelineLayout;
+    wgpuLimits.maxDynamicStorageBuffersPerPipelineLayout = limits.maxDynamicStorageBuffersPerPipelineLayout;
+    wgpuLimits.maxSampledTexturesPerShaderStage = limits.maxSampledTexturesPerShaderStage;
+    wgpuLimits.maxSamplersPerShaderStage = limits.maxSamplersPerShaderStage;
+    wgpuLimits.maxStorageBuffersPerShaderStage = limits.maxStorageBuffersPerShaderStage;
+    wgpuLimits.maxStorageTexturesPerShaderStage = limits.maxStorageTexturesPerShaderStage;
+    wgpuLimits.maxUniformBuffersPerShaderStage = limits.maxUniformBuffersPerShaderStage;
+    wgpuLimits.maxUniformBufferBindingSize = limits.maxUniformBufferBindingSize;
+    wgpuLimits.maxStorageBufferBindingSize = limits.maxStorageBufferBindingSize;
+    wgpuLimits.maxBufferSize = limits.maxBufferSize;
+    wgpuLimits.maxVertexBuffers = limits.maxVertexBuffers;
+    wgpuLimits.maxVertexAttributes = limits.maxVertexAttributes;
+    wgpuLimits.maxVertexBufferArrayStride = limits.maxVertexBufferArrayStride;
+    wgpuLimits.maxInterStageShaderVariables = limits.maxInterStageShaderVariables;
+    wgpuLimits.maxComputeWorkgroupStorageSize = limits.maxComputeWorkgroupStorageSize;
+    wgpuLimits.maxComputeInvocationsPerWorkgroup = limits.maxComputeInvocationsPerWorkgroup;
+    wgpuLimits.maxComputeWorkgroupSizeX = limits.maxComputeWorkgroupSizeX;
+    wgpuLimits.maxComputeWorkgroupSizeY = limits.maxComputeWorkgroupSizeY;
+    wgpuLimits.maxComputeWorkgroupSizeZ = limits.maxComputeWorkgroupSizeZ;
+    wgpuLimits.maxComputeWorkgroupsPerDimension = limits.maxComputeWorkgroupsPerDimension;
+    return wgpuLimits;
+}
+
+DeviceLimits WebGPUConverters::convertFromWGPULimits(const WGPULimits& wgpuLimits) {
+    DeviceLimits limits;
+    limits.maxTextureDimension1D = wgpuLimits.maxTextureDimension1D;
+    limits.maxTextureDimension2D = wgpuLimits.maxTextureDimension2D;
+    limits.maxTextureDimension3D = wgpuLimits.maxTextureDimension3D;
+    limits.maxTextureArrayLayers = wgpuLimits.maxTextureArrayLayers;
+    limits.maxBindGroups = wgpuLimits.maxBindGroups;
+    limits.maxBindingsPerBindGroup = wgpuLimits.maxBindingsPerBindGroup;
+    limits.maxDynamicUniformBuffersPerPipelineLayout = wgpuLimits.maxDynamicUniformBuffersPerPipelineLayout;
+    limits.maxDynamicStorageBuffersPerPipelineLayout = wgpuLimits.maxDynamicStorageBuffersPerPipelineLayout;
+    limits.maxSampledTexturesPerShaderStage = wgpuLimits.maxSampledTexturesPerShaderStage;
+    limits.maxSamplersPerShaderStage = wgpuLimits.maxSamplersPerShaderStage;
+    limits.maxStorageBuffersPerShaderStage = wgpuLimits.maxStorageBuffersPerShaderStage;
+    limits.maxStorageTexturesPerShaderStage = wgpuLimits.maxStorageTexturesPerShaderStage;
+    limits.maxUniformBuffersPerShaderStage = wgpuLimits.maxUniformBuffersPerShaderStage;
+    // Uniform bindings never approach 4 GiB, clamp instead of widening the public field
+    limits.maxUniformBufferBindingSize = static_cast<uint32_t>(
+        std::min<uint64_t>(wgpuLimits.maxUniformBufferBindingSize, UINT32_MAX));
+    limits.maxStorageBufferBindingSize = wgpuLimits.maxStorageBufferBindingSize;
+    limits.maxBufferSize = wgpuLimits.maxBufferSize;
+    limits.maxVertexBuffers = wgpuLimits.maxVertexBuffers;
+    limits.maxVertexAttributes = wgpuLimits.maxVertexAttributes;
+    limits.maxVertexBufferArrayStride = wgpuLimits.maxVertexBufferArrayStride;
+    limits.maxInterStageShaderVariables = wgpuLimits.maxInterStageShaderVariables;
+    limits.maxComputeWorkgroupStorageSize = wgpuLimits.maxComputeWorkgroupStorageSize;
+    limits.maxComputeInvocationsPerWorkgroup = wgpuLimits.maxComputeInvocationsPerWorkgroup;
+    limits.maxComputeWorkgroupSizeX = wgpuLimits.maxComputeWorkgroupSizeX;
+    limits.maxComputeWorkgroupSizeY = wgpuLimits.maxComputeWorkgroupSizeY;
+    limits.maxComputeWorkgroupSizeZ = wgpuLimits.maxComputeWorkgroupSizeZ;
+    limits.maxComputeWorkgroupsPerDimension = wgpuLimits.maxComputeWorkgroupsPerDimension;
+    return limits;
 }
 
-} // namespace pers
\ No newline at end of file
+} // namespace pers
@@ -0,0 +1,133 @@
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
+#include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>  // For wgpuDevicePoll
+#include <algorithm>
+
+namespace pers {
+
+WebGPUEventPump::WebGPUEventPump(WGPUInstance instance)
+    : _instance(instance) {
+    if (_instance) {
+        wgpuInstanceAddRef(_instance);
+    } else {
+        LOG_ERROR("WebGPUEventPump", "Created with null instance");
+    }
+
+    _thread = std::thread([this]() { run(); });
+}
+
+WebGPUEventPump::~WebGPUEventPump() {
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _stop = true;
+    }
+    _wakeCv.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_deviceMutex);
+        for (WGPUDevice device : _devices) {
+            wgpuDeviceRelease(device);
+        }
+        _devices.clear();
+    }
+
+    if (_instance) {
+        wgpuInstanceRelease(_instance);
+        _instance = nullptr;
+    }
+}
+
+void WebGPUEventPump::addDevice(WGPUDevice device) {
+    if (!device) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_deviceMutex);
+    wgpuDeviceAddRef(device);
+    _devices.push_back(device);
+}
+
+void WebGPUEventPump::removeDevice(WGPUDevice device) {
+    std::lock_guard<std::mutex> lock(_deviceMutex);
+    auto it = std::find(_devices.begin(), _devices.end(), device);
+    if (it != _devices.end()) {
+        wgpuDeviceRelease(*it);
+        _devices.erase(it);
+    }
+}
+
+void WebGPUEventPump::beginAsync() {
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        ++_pending;
+    }
+    _wakeCv.notify_one();
+}
+
+void WebGPUEventPump::endAsync() {
+    uint32_t previous = _pending.load();
+    while (previous > 0 && !_pending.compare_exchange_weak(previous, previous - 1)) {
+    }
+    if (previous == 0) {
+        LOG_WARNING("WebGPUEventPump", "endAsync called without matching beginAsync");
+        return;
+    }
+    ++_completed;
+}
+
+void WebGPUEventPump::pumpOnce() {
+    if (_instance) {
+        wgpuInstanceProcessEvents(_instance);
+    }
+
+    // Device polling runs outside the lock; callbacks may register new work
+    std::vector<WGPUDevice> devices;
+    {
+        std::lock_guard<std::mutex> lock(_deviceMutex);
+        devices = _devices;
+        for (WGPUDevice device : devices) {
+            wgpuDeviceAddRef(device);
+        }
+    }
+
+    for (WGPUDevice device : devices) {
+        wgpuDevicePoll(device, false, nullptr);
+        wgpuDeviceRelease(device);
+    }
+}
+
+void WebGPUEventPump::run() {
+    auto backoff = MIN_BACKOFF;
+    uint64_t lastCompleted = _completed.load();
+
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    while (!_stop) {
+        if (_pending.load() == 0) {
+            // Idle: sleep until someone starts an async operation
+            _wakeCv.wait(lock, [this]() { return _stop || _pending.load() > 0; });
+            backoff = MIN_BACKOFF;
+            continue;
+        }
+
+        lock.unlock();
+        pumpOnce();
+        lock.lock();
+
+        uint64_t completed = _completed.load();
+        if (completed != lastCompleted) {
+            // Progress was made, more completions are likely soon
+            lastCompleted = completed;
+            backoff = MIN_BACKOFF;
+        } else {
+            backoff = std::min(backoff * 2, MAX_BACKOFF);
+        }
+
+        _wakeCv.wait_for(lock, backoff);
+    }
+}
+
+} // namespace pers
@@ -1,16 +1,21 @@
 #include "pers/graphics/backends/webgpu/WebGPUInstance.h"
 #include "pers/graphics/backends/webgpu/WebGPUPhysicalDevice.h"
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
 #include "pers/graphics/backends/IGraphicsInstanceFactory.h"
+#include "pers/graphics/AdapterBenchmark.h"
+#include "pers/utils/EnumTable.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/Validation.h"
 #include "pers/core/platform/NativeWindowHandle.h"
 #include <webgpu/webgpu.h>
 #include <webgpu/wgpu.h>  // For wgpu-native specific extensions
 #include <cstring>  // For strlen
+#include <string>
+#include <utility>
 #include <chrono>
-#include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <atomic>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -22,9 +27,59 @@
 
 namespace pers {
 
+namespace {
+
+constexpr EnumMapping<InstanceBackend, WGPUInstanceBackend> INSTANCE_BACKENDS[] = {
+    {InstanceBackend::Vulkan, WGPUInstanceBackend_Vulkan},
+    {InstanceBackend::GL, WGPUInstanceBackend_GL},
+    {InstanceBackend::Metal, WGPUInstanceBackend_Metal},
+    {InstanceBackend::DX12, WGPUInstanceBackend_DX12},
+    {InstanceBackend::DX11, WGPUInstanceBackend_DX11},
+    {InstanceBackend::BrowserWebGPU, WGPUInstanceBackend_BrowserWebGPU},
+};
+
+WGPUInstanceBackend convertBackends(const InstanceDesc& desc) {
+    if (desc.backends == InstanceBackend::Auto) {
+        // Software fallbacks live in the secondary backends
+        return desc.allowSoftwareRenderer ? WGPUInstanceBackend_All : WGPUInstanceBackend_Primary;
+    }
+    return translateFlags<WGPUInstanceBackend>(desc.backends, INSTANCE_BACKENDS);
+}
+
+std::string describeBackends(WGPUInstanceBackend backends) {
+    if (backends == WGPUInstanceBackend_All) {
+        return "All";
+    }
+    
+    static constexpr std::pair<WGPUInstanceBackend, const char*> NAMES[] = {
+        {WGPUInstanceBackend_Vulkan, "Vulkan"},
+        {WGPUInstanceBackend_GL, "GL"},
+        {WGPUInstanceBackend_Metal, "Metal"},
+        {WGPUInstanceBackend_DX12, "DX12"},
+        {WGPUInstanceBackend_DX11, "DX11"},
+        {WGPUInstanceBackend_BrowserWebGPU, "BrowserWebGPU"},
+    };
+    
+    std::string result;
+    for (const auto& [backend, name] : NAMES) {
+        if ((backends & backend) != 0) {
+            if (!result.empty()) {
+                result += ", ";
+            }
+            result += name;
+        }
+    }
+    return result;
+}
+
+} // anonymous namespace
+
 WebGPUInstance::WebGPUInstance() = default;
 
 WebGPUInstance::~WebGPUInstance() {
+    // Stop the pump thread before the instance goes away
+    _eventPump.reset();
+    
     if (_instance) {
         wgpuInstanceRelease(_instance);
         _instance = nullptr;
@@ -32,6 +87,7 @@ WebGPUInstance::~WebGPUInstance() {
 }
 
 bool WebGPUInstance::initialize(const InstanceDesc& desc) {
+    PERS_PROFILE_SCOPE("WebGPUInstance::initialize");
     Logger::Instance().LogFormat(LogLevel::Info, "WebGPUInstance", PERS_SOURCE_LOC,
         "Initializing for: %s", desc.applicationName.c_str());
     Logger::Instance().LogFormat(LogLevel::Info, "WebGPUInstance", PERS_SOURCE_LOC,
@@ -46,30 +102,36 @@ bool WebGPUInstance::initialize(const InstanceDesc& desc) {
     extras.chain.next = nullptr;
     
     // Configure backend selection based on preferences
-    if (desc.allowSoftwareRenderer) {
-        // Allow all backends including software fallbacks
-        extras.backends = WGPUInstanceBackend_All;
-        LOG_INFO("WebGPUInstance",
-            "Software renderer allowed, using all backends");
-    } else {
-        // Only use primary hardware-accelerated backends
-        extras.backends = WGPUInstanceBackend_Primary;
-        LOG_INFO("WebGPUInstance",
-            "Using primary hardware backends only (Vulkan, Metal, DX12, BrowserWebGPU)");
-    }
+    extras.backends = convertBackends(desc);
+    Logger::Instance().LogFormat(LogLevel::Info, "WebGPUInstance", PERS_SOURCE_LOC,
+        "Backends: %s", describeBackends(extras.backends).c_str());
     
     // Configure instance flags based on InstanceDesc
     extras.flags = WGPUInstanceFlag_Default;
     
-    if (desc.enableValidation) {
+    // Unchecked builds skip native validation too, whatever the desc asks for
+    if (desc.enableValidation && !PERS_VALIDATION) {
+        LOG_INFO("WebGPUInstance",
+            "Validation requested but compiled out (PERS_UNCHECKED_RELEASE)");
+    }
+    
+    if (desc.enableValidation && PERS_VALIDATION) {
         extras.flags |= WGPUInstanceFlag_Validation;
         LOG_INFO("WebGPUInstance",
             "Validation enabled");
         
         // Debug flag provides more detailed error messages when validation is enabled
-        extras.flags |= WGPUInstanceFlag_Debug;
+        if (desc.enableDebugMessages) {
+            extras.flags |= WGPUInstanceFlag_Debug;
+            LOG_INFO("WebGPUInstance",
+                "Debug mode enabled for detailed validation messages");
+        }
+    }
+    
+    if (desc.discardBackendLabels) {
+        extras.flags |= WGPUInstanceFlag_DiscardHalLabels;
         LOG_INFO("WebGPUInstance",
-            "Debug mode enabled for detailed validation messages");
+            "Debug labels are not forwarded to the native API");
     }
     
     // Configure DX12 compiler preference (Windows only)
@@ -104,6 +166,9 @@ bool WebGPUInstance::initialize(const InstanceDesc& desc) {
     LOG_INFO("WebGPUInstance",
         "Created successfully with configured settings");
     
+    // Drives adapter, device, map and work-done callbacks from a background thread
+    _eventPump = std::make_shared<WebGPUEventPump>(_instance);
+    
     // Log actual configuration used
     if (desc.enableGPUBasedValidation) {
         LOG_INFO("WebGPUInstance",
@@ -119,6 +184,7 @@ bool WebGPUInstance::initialize(const InstanceDesc& desc) {
 
 std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDevice(
     const PhysicalDeviceOptions& options) {
+    PERS_PROFILE_SCOPE("WebGPUInstance::requestPhysicalDevice");
     
     if (!_instance) {
         LOG_ERROR("WebGPUInstance", 
@@ -126,6 +192,14 @@ std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDevice(
         return nullptr;
     }
     
+    if (options.selectByBenchmark && !options.forceFallbackAdapter) {
+        if (auto physicalDevice = requestPhysicalDeviceByBenchmark(options)) {
+            return physicalDevice;
+        }
+        LOG_WARNING("WebGPUInstance",
+            "No adapter could be benchmarked, falling back to power preference");
+    }
+    
     // Setup adapter options
     WGPURequestAdapterOptions adapterOptions = {};
     
@@ -198,40 +272,20 @@ std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDevice(
     };
     callbackInfo.userdata1 = &callbackData;
     
-    // Request adapter
+    // Request adapter, the event pump fires the callback while we wait
+    _eventPump->beginAsync();
     wgpuInstanceRequestAdapter(_instance, &adapterOptions, callbackInfo);
     
     // Wait for callback with timeout using condition variable
-    std::unique_lock<std::mutex> lock(callbackData.mutex);
-    
-    // Process events in a separate thread to ensure callback is triggered
-    std::atomic<bool> stopProcessing{false};
-    std::thread eventThread([this, &callbackData, &stopProcessing]() {
-        while (!stopProcessing.load()) {
-            wgpuInstanceProcessEvents(_instance);
-
-            // Check if received (with lock)
-            {
-                std::lock_guard<std::mutex> lock(callbackData.mutex);
-                if (callbackData.received) {
-                    break;
-                }
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(0));
-        }
-    }
-    );
-    
     const auto timeout = std::chrono::seconds(5);
-    bool success = callbackData.cv.wait_for(lock, timeout, [&callbackData]() {
-        return callbackData.received;
-    });
-    
-    // Signal event thread to stop and wait for it
-    stopProcessing.store(true);
-    if (eventThread.joinable()) {
-        eventThread.join();
+    bool success = false;
+    {
+        std::unique_lock<std::mutex> lock(callbackData.mutex);
+        success = callbackData.cv.wait_for(lock, timeout, [&callbackData]() {
+            return callbackData.received;
+        });
     }
+    _eventPump->endAsync();
     
     if (!success) {
         LOG_ERROR("WebGPUInstance", 
@@ -280,7 +334,7 @@ std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDevice(
     wgpuAdapterInfoFreeMembers(adapterInfo);
     
     // Create and return physical device
-    auto physicalDevice = std::make_shared<WebGPUPhysicalDevice>(callbackData.adapter);
+    auto physicalDevice = std::make_shared<WebGPUPhysicalDevice>(callbackData.adapter, _eventPump);
     
     // We can release our reference as WebGPUPhysicalDevice will add its own
     wgpuAdapterRelease(callbackData.adapter);
@@ -291,6 +345,78 @@ std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDevice(
     return physicalDevice;
 }
 
+std::shared_ptr<IPhysicalDevice> WebGPUInstance::requestPhysicalDeviceByBenchmark(
+    const PhysicalDeviceOptions& options) {
+    
+    std::vector<std::shared_ptr<IPhysicalDevice>> candidates;
+    for (auto& physicalDevice : enumeratePhysicalDevices()) {
+        if (!options.compatibleSurface.isValid() || physicalDevice->supportsSurface(options.compatibleSurface)) {
+            candidates.push_back(std::move(physicalDevice));
+        }
+    }
+    
+    if (candidates.empty()) {
+        return nullptr;
+    }
+    
+    AdapterBenchmark benchmark(options.benchmarkCachePath);
+    benchmark.load();
+    
+    const size_t cachedBefore = benchmark.getCachedCount();
+    auto best = benchmark.selectBest(candidates);
+    if (benchmark.getCachedCount() != cachedBefore) {
+        benchmark.save();
+    }
+    return best;
+}
+
+std::vector<std::shared_ptr<IPhysicalDevice>> WebGPUInstance::enumeratePhysicalDevices() {
+    std::vector<std::shared_ptr<IPhysicalDevice>> physicalDevices;
+    
+    if (!_instance) {
+        LOG_ERROR("WebGPUInstance", 
+            "Cannot enumerate physical devices: instance is null");
+        return physicalDevices;
+    }
+    
+    // Only ask the backends the instance was created with
+    WGPUInstanceEnumerateAdapterOptions enumerateOptions = {};
+    enumerateOptions.backends = convertBackends(_desc);
+    
+    // First call counts, second call fills
+    size_t count = wgpuInstanceEnumerateAdapters(_instance, &enumerateOptions, nullptr);
+    std::vector<WGPUAdapter> adapters(count, nullptr);
+    if (count > 0) {
+        count = wgpuInstanceEnumerateAdapters(_instance, &enumerateOptions, adapters.data());
+        adapters.resize(count);
+    }
+    
+    for (WGPUAdapter adapter : adapters) {
+        WGPUAdapterInfo adapterInfo = {};
+        wgpuAdapterGetInfo(adapter, &adapterInfo);
+        
+        bool isSoftware = (adapterInfo.adapterType == WGPUAdapterType_CPU);
+        if (adapterInfo.device.data && adapterInfo.device.length > 0) {
+            Logger::Instance().LogFormat(LogLevel::Info, "WebGPUInstance", PERS_SOURCE_LOC,
+                "Enumerated adapter: %.*s%s", static_cast<int>(adapterInfo.device.length),
+                adapterInfo.device.data, isSoftware ? " (software)" : "");
+        }
+        wgpuAdapterInfoFreeMembers(adapterInfo);
+        
+        if (!isSoftware || _desc.allowSoftwareRenderer) {
+            physicalDevices.push_back(std::make_shared<WebGPUPhysicalDevice>(adapter, _eventPump));
+        }
+        
+        // WebGPUPhysicalDevice holds its own reference
+        wgpuAdapterRelease(adapter);
+    }
+    
+    Logger::Instance().LogFormat(LogLevel::Info, "WebGPUInstance", PERS_SOURCE_LOC,
+        "Enumerated %zu usable adapter(s)", physicalDevices.size());
+    
+    return physicalDevices;
+}
+
 NativeSurfaceHandle WebGPUInstance::createSurface(void* windowHandle) {
     if (!_instance) {
         LOG_ERROR("WebGPUInstance",
@@ -422,9 +548,15 @@ NativeSurfaceHandle WebGPUInstance::createSurface(void* windowHandle) {
 }
 
 void WebGPUInstance::processEvents() {
-    if (_instance) {
+    if (_eventPump) {
+        _eventPump->pumpOnce();
+    } else if (_instance) {
         wgpuInstanceProcessEvents(_instance);
     }
 }
 
+const std::shared_ptr<WebGPUEventPump>& WebGPUInstance::getEventPump() const {
+    return _eventPump;
+}
+
 } // namespace pers
@@ -1,23 +1,42 @@
 #include "pers/graphics/backends/webgpu/WebGPULogicalDevice.h"
 #include "pers/graphics/backends/webgpu/WebGPUQueue.h"
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
 #include "pers/graphics/backends/webgpu/WebGPUSwapChain.h"
 #include "pers/graphics/backends/webgpu/WebGPUCommandEncoder.h"
+#include "pers/graphics/backends/webgpu/WebGPURenderBundleEncoder.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
 #include "pers/graphics/backends/webgpu/WebGPUResourceFactory.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
 #include "pers/graphics/SwapChainDescBuilder.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/PoolAllocator.h"
+#include "pers/utils/Profiler.h"
 #include <webgpu/webgpu.h>
+#include <webgpu/wgpu.h>  // For wgpuDevicePoll
 #include <iostream>
 
 namespace pers {
 
 WebGPULogicalDevice::WebGPULogicalDevice(WGPUDevice device,
-                                       const std::shared_ptr<IPhysicalDevice>& physicalDevice)
-    : _device(device), _physicalDevice(physicalDevice) {
+                                       const std::shared_ptr<IPhysicalDevice>& physicalDevice,
+                                       const std::shared_ptr<WebGPUEventPump>& eventPump,
+                                       const std::shared_ptr<WebGPUDeviceLostState>& lostState)
+    : _device(device), _physicalDevice(physicalDevice), _eventPump(eventPump), _lostState(lostState) {
     
     if (_device) {
         wgpuDeviceAddRef(_device);
         LOG_INFO("WebGPULogicalDevice", "Created with device");
         
+        _multiDrawIndirect = wgpuDeviceHasFeature(
+            _device, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirect));
+        _multiDrawIndirectCount = wgpuDeviceHasFeature(
+            _device, static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirectCount));
+        
+        if (_eventPump) {
+            _eventPump->addDevice(_device);
+        }
+        
         // Create default queue immediately
         if (!createDefaultQueue()) {
             LOG_ERROR("WebGPULogicalDevice", "Failed to create default queue");
@@ -30,9 +49,18 @@ WebGPULogicalDevice::WebGPULogicalDevice(WGPUDevice device,
 }
 
 WebGPULogicalDevice::~WebGPULogicalDevice() {
+    // Retired resources may still be referenced by submitted work
+    if (_deletionQueue) {
+        _deletionQueue->flush();
+        _deletionQueue.reset();
+    }
+    _stagingBufferPool.reset();
     _defaultQueue.reset();
     
     if (_device) {
+        if (_eventPump) {
+            _eventPump->removeDevice(_device);
+        }
         wgpuDeviceRelease(_device);
         _device = nullptr;
     }
@@ -46,7 +74,8 @@ bool WebGPULogicalDevice::createDefaultQueue() {
     // WebGPU devices have a default queue
     WGPUQueue queue = wgpuDeviceGetQueue(_device);
     if (queue) {
-        _defaultQueue = std::make_shared<WebGPUQueue>(queue);
+        _defaultQueue = std::make_shared<WebGPUQueue>(queue, _device, _eventPump);
+        _deletionQueue = std::make_shared<DeferredDeletionQueue>(_defaultQueue);
         LOG_INFO("WebGPULogicalDevice", "Default queue created");
         return true;
     } else {
@@ -67,18 +96,42 @@ const std::shared_ptr<IResourceFactory>& WebGPULogicalDevice::getResourceFactory
     }
     
     // Create and cache resource factory on first access
-    if (!_resourceFactory) {
+    std::call_once(_resourceFactoryOnce, [this]() {
         // Use const_cast to get non-const shared_ptr from const method
         auto sharedThis = const_cast<WebGPULogicalDevice*>(this)->shared_from_this();
         
         _resourceFactory = std::make_shared<WebGPUResourceFactory>(sharedThis);
         LOG_DEBUG("WebGPULogicalDevice",
             "Created and cached resource factory");
-    }
+    });
     
     return _resourceFactory;
 }
 
+const std::shared_ptr<StagingBufferPool>& WebGPULogicalDevice::getStagingBufferPool() const {
+    std::call_once(_stagingBufferPoolOnce, [this]() {
+        const auto& resourceFactory = getResourceFactory();
+        if (!resourceFactory || !_defaultQueue) {
+            LOG_ERROR("WebGPULogicalDevice",
+                "Cannot create staging buffer pool without resource factory and queue");
+            return;
+        }
+        
+        _stagingBufferPool = std::make_shared<StagingBufferPool>(resourceFactory, _defaultQueue);
+        if (auto webgpuQueue = std::dynamic_pointer_cast<WebGPUQueue>(_defaultQueue)) {
+            webgpuQueue->setStagingBufferPool(_stagingBufferPool);
+        }
+        LOG_DEBUG("WebGPULogicalDevice",
+            "Created staging buffer pool");
+    });
+    
+    return _stagingBufferPool;
+}
+
+const std::shared_ptr<DeferredDeletionQueue>& WebGPULogicalDevice::getDeletionQueue() const {
+    return _deletionQueue;
+}
+
 std::shared_ptr<ICommandEncoder> WebGPULogicalDevice::createCommandEncoder() {
     if (!_device) {
         LOG_ERROR("WebGPULogicalDevice", 
@@ -98,12 +151,47 @@ std::shared_ptr<ICommandEncoder> WebGPULogicalDevice::createCommandEncoder() {
         return nullptr;
     }
     
-    return std::make_shared<WebGPUCommandEncoder>(encoder);
+    return makePooledShared<WebGPUCommandEncoder>(encoder, _multiDrawIndirect, _multiDrawIndirectCount);
+}
+
+std::shared_ptr<IRenderBundleEncoder> WebGPULogicalDevice::createRenderBundleEncoder(const RenderBundleEncoderDesc& desc) {
+    if (!_device) {
+        LOG_ERROR("WebGPULogicalDevice", 
+                              "Cannot create render bundle encoder with null device");
+        return nullptr;
+    }
+    
+    std::vector<WGPUTextureFormat> colorFormats;
+    colorFormats.reserve(desc.colorFormats.size());
+    for (TextureFormat format : desc.colorFormats) {
+        colorFormats.push_back(WebGPUConverters::convertTextureFormat(format));
+    }
+    
+    WGPURenderBundleEncoderDescriptor encoderDesc = {};
+    encoderDesc.label = WGPUStringView{desc.label.data(), desc.label.length()};
+    encoderDesc.colorFormatCount = colorFormats.size();
+    encoderDesc.colorFormats = colorFormats.empty() ? nullptr : colorFormats.data();
+    encoderDesc.depthStencilFormat = desc.depthStencilFormat == TextureFormat::Undefined
+        ? WGPUTextureFormat_Undefined
+        : WebGPUConverters::convertTextureFormat(desc.depthStencilFormat);
+    encoderDesc.sampleCount = desc.sampleCount;
+    encoderDesc.depthReadOnly = desc.depthReadOnly;
+    encoderDesc.stencilReadOnly = desc.stencilReadOnly;
+    
+    WGPURenderBundleEncoder encoder = wgpuDeviceCreateRenderBundleEncoder(_device, &encoderDesc);
+    if (!encoder) {
+        LOG_ERROR("WebGPULogicalDevice", 
+                              "Failed to create render bundle encoder");
+        return nullptr;
+    }
+    
+    return std::make_shared<WebGPURenderBundleEncoder>(encoder, desc.label);
 }
 
 std::shared_ptr<ISwapChain> WebGPULogicalDevice::createSwapChain(
     const NativeSurfaceHandle& surface,
     const SwapChainDesc& desc) {
+    PERS_PROFILE_SCOPE("WebGPULogicalDevice::createSwapChain");
     
     if (!_device) {
         LOG_ERROR("WebGPULogicalDevice", 
@@ -142,27 +230,56 @@ void WebGPULogicalDevice::waitIdle() {
     }
     
     // WebGPU doesn't have a direct waitIdle equivalent like Vulkan's vkDeviceWaitIdle
-    // We need to poll the device to process callbacks and wait for queue completion
-    
-    // Process any pending callbacks
-    // Note: wgpuDevicePoll is the standard WebGPU way to process callbacks
-    // but wgpu-native uses a different approach
-    
-    // For wgpu-native, we wait for the queue to complete all work
+    // Wait for the queue, then block in wgpuDevicePoll so map and work-done
+    // callbacks for this device have fired before returning
     if (_defaultQueue) {
         _defaultQueue->waitIdle();
     }
     
-    TODO_OR_DIE("WebGPULogicalDevice::waitIdle", 
-                   "Investigate if wgpu-native has a device poll mechanism. Standard WebGPU would use: wgpuDevicePoll(_device, true, nullptr)");
+    wgpuDevicePoll(_device, true, nullptr);
+    
+    if (_deletionQueue) {
+        _deletionQueue->collect();
+    }
+}
+
+const std::shared_ptr<WebGPUEventPump>& WebGPULogicalDevice::getEventPump() const {
+    return _eventPump;
 }
 
 NativeDeviceHandle WebGPULogicalDevice::getNativeDeviceHandle() const {
     return NativeDeviceHandle::fromBackend(_device);
 }
 
+DeviceLimits WebGPULogicalDevice::getLimits() const {
+    if (!_device) {
+        return {};
+    }
+    
+    WGPUNativeLimits nativeLimits = {};
+    nativeLimits.chain.sType = static_cast<WGPUSType>(WGPUSType_NativeLimits);
+    WGPULimits limits = {};
+    limits.nextInChain = &nativeLimits.chain;
+    if (wgpuDeviceGetLimits(_device, &limits) != WGPUStatus_Success) {
+        LOG_ERROR("WebGPULogicalDevice",
+            "Failed to query device limits");
+        return {};
+    }
+    DeviceLimits result = WebGPUConverters::convertFromWGPULimits(limits);
+    result.maxPushConstantSize = nativeLimits.maxPushConstantSize;
+    return result;
+}
+
+bool WebGPULogicalDevice::hasFeature(DeviceFeature feature) const {
+    return _device && wgpuDeviceHasFeature(_device, WebGPUConverters::convertDeviceFeature(feature));
+}
+
 std::shared_ptr<IPhysicalDevice> WebGPULogicalDevice::getPhysicalDevice() const {
     return _physicalDevice.lock();
 }
 
+bool WebGPULogicalDevice::isLost() const {
+    return _lostState && _lostState->lost.load(std::memory_order_acquire);
+}
+
 } // namespace pers
\ No newline at end of file
@@ -1,13 +1,19 @@
 #include "pers/graphics/backends/webgpu/WebGPUPhysicalDevice.h"
 #include "pers/graphics/backends/webgpu/WebGPULogicalDevice.h"
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
+#include "pers/graphics/backends/webgpu/WebGPUSwapChain.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
 #include <webgpu/webgpu.h>
+#include <webgpu/wgpu.h>  // For native feature names
+#include <algorithm>
+#include <cstring>
 #include <vector>
 #include <thread>
 #include <chrono>
 #include <mutex>
 #include <condition_variable>
-#include <unordered_map>
 #include <unordered_set>
 
 namespace pers {
@@ -33,55 +39,79 @@ struct SupportedFeaturesGuard {
     SupportedFeaturesGuard& operator=(SupportedFeaturesGuard&&) = delete;
 };
 
-// Static feature mapping table
-static const std::unordered_map<DeviceFeature, WGPUFeatureName> g_featureMap = {
-    {DeviceFeature::DepthClipControl, WGPUFeatureName_DepthClipControl},
-    {DeviceFeature::Depth32FloatStencil8, WGPUFeatureName_Depth32FloatStencil8},
-    {DeviceFeature::TimestampQuery, WGPUFeatureName_TimestampQuery},
-    // PipelineStatisticsQuery is not available in current WebGPU spec
-    {DeviceFeature::TextureCompressionBC, WGPUFeatureName_TextureCompressionBC},
-    {DeviceFeature::TextureCompressionETC2, WGPUFeatureName_TextureCompressionETC2},
-    {DeviceFeature::TextureCompressionASTC, WGPUFeatureName_TextureCompressionASTC},
-    {DeviceFeature::IndirectFirstInstance, WGPUFeatureName_IndirectFirstInstance},
-    {DeviceFeature::ShaderF16, WGPUFeatureName_ShaderF16},
-    {DeviceFeature::RG11B10UfloatRenderable, WGPUFeatureName_RG11B10UfloatRenderable},
-    {DeviceFeature::BGRA8UnormStorage, WGPUFeatureName_BGRA8UnormStorage},
-    {DeviceFeature::Float32Filterable, WGPUFeatureName_Float32Filterable}
-};
+// Requires each requested limit and grants each preferred one up to what the adapter has
+template<typename T>
+static bool negotiateLimit(const char* name, T required, T preferred, T available, T& out) {
+    if (required > available) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
+            "Required limit %s = %llu exceeds adapter maximum %llu", name,
+            static_cast<unsigned long long>(required), static_cast<unsigned long long>(available));
+        return false;
+    }
+    
+    const T granted = std::max(required, std::min(preferred, available));
+    if (granted > 0) {
+        out = granted;
+    }
+    return true;
+}
 
-// Helper function to convert DeviceLimits to WGPULimits
-static WGPULimits convertToWGPULimits(const DeviceLimits& limits) {
-    WGPULimits wgpuLimits = {};
-    wgpuLimits.maxTextureDimension1D = limits.maxTextureDimension1D;
-    wgpuLimits.maxTextureDimension2D = limits.maxTextureDimension2D;
-    wgpuLimits.maxTextureDimension3D = limits.maxTextureDimension3D;
-    wgpuLimits.maxTextureArrayLayers = limits.maxTextureArrayLayers;
-    wgpuLimits.maxBindGroups = limits.maxBindGroups;
-    wgpuLimits.maxBindingsPerBindGroup = limits.maxBindingsPerBindGroup;
-    wgpuLimits.maxDynamicUniformBuffersPerPipelineLayout = limits.maxDynamicUniformBuffersPerPipelineLayout;
-    wgpuLimits.maxDynamicStorageBuffersPerPipelineLayout = limits.maxDynamicStorageBuffersPerPipelineLayout;
-    wgpuLimits.maxSampledTexturesPerShaderStage = limits.maxSampledTexturesPerShaderStage;
-    wgpuLimits.maxSamplersPerShaderStage = limits.maxSamplersPerShaderStage;
-    wgpuLimits.maxStorageBuffersPerShaderStage = limits.maxStorageBuffersPerShaderStage;
-    wgpuLimits.maxStorageTexturesPerShaderStage = limits.maxStorageTexturesPerShaderStage;
-    wgpuLimits.maxUniformBuffersPerShaderStage = limits.maxUniformBuffersPerShaderStage;
-    wgpuLimits.maxUniformBufferBindingSize = limits.maxUniformBufferBindingSize;
-    wgpuLimits.maxStorageBufferBindingSize = limits.maxStorageBufferBindingSize;
-    wgpuLimits.maxVertexBuffers = limits.maxVertexBuffers;
-    wgpuLimits.maxVertexAttributes = limits.maxVertexAttributes;
-    wgpuLimits.maxVertexBufferArrayStride = limits.maxVertexBufferArrayStride;
-    wgpuLimits.maxInterStageShaderVariables = limits.maxInterStageShaderVariables;
-    wgpuLimits.maxComputeWorkgroupStorageSize = limits.maxComputeWorkgroupStorageSize;
-    wgpuLimits.maxComputeInvocationsPerWorkgroup = limits.maxComputeInvocationsPerWorkgroup;
-    wgpuLimits.maxComputeWorkgroupSizeX = limits.maxComputeWorkgroupSizeX;
-    wgpuLimits.maxComputeWorkgroupSizeY = limits.maxComputeWorkgroupSizeY;
-    wgpuLimits.maxComputeWorkgroupSizeZ = limits.maxComputeWorkgroupSizeZ;
-    wgpuLimits.maxComputeWorkgroupsPerDimension = limits.maxComputeWorkgroupsPerDimension;
-    return wgpuLimits;
+static bool negotiateLimits(const LogicalDeviceDesc& desc, const WGPULimits& available, WGPULimits& out) {
+    // All-ones is WGPU_LIMIT_U32_UNDEFINED / WGPU_LIMIT_U64_UNDEFINED: keep the WebGPU default
+    std::memset(&out, 0xFF, sizeof(out));
+    out.nextInChain = nullptr;
+    
+    const DeviceLimits none;
+    const DeviceLimits& required = desc.requiredLimits ? *desc.requiredLimits : none;
+    const DeviceLimits& preferred = desc.preferredLimits ? *desc.preferredLimits : none;
+    
+    // Request values are widened to the native field type
+    bool ok = true;
+#define PERS_NEGOTIATE_LIMIT(field) \
+    ok &= negotiateLimit(#field, decltype(available.field)(required.field), \
+                         decltype(available.field)(preferred.field), available.field, out.field)
+    PERS_NEGOTIATE_LIMIT(maxTextureDimension1D);
+    PERS_NEGOTIATE_LIMIT(maxTextureDimension2D);
+    PERS_NEGOTIATE_LIMIT(maxTextureDimension3D);
+    PERS_NEGOTIATE_LIMIT(maxTextureArrayLayers);
+    PERS_NEGOTIATE_LIMIT(maxBindGroups);
+    PERS_NEGOTIATE_LIMIT(maxBindingsPerBindGroup);
+    PERS_NEGOTIATE_LIMIT(maxDynamicUniformBuffersPerPipelineLayout);
+    PERS_NEGOTIATE_LIMIT(maxDynamicStorageBuffersPerPipelineLayout);
+    PERS_NEGOTIATE_LIMIT(maxSampledTexturesPerShaderStage);
+    PERS_NEGOTIATE_LIMIT(maxSamplersPerShaderStage);
+    PERS_NEGOTIATE_LIMIT(maxStorageBuffersPerShaderStage);
+    PERS_NEGOTIATE_LIMIT(maxStorageTexturesPerShaderStage);
+    PERS_NEGOTIATE_LIMIT(maxUniformBuffersPerShaderStage);
+    PERS_NEGOTIATE_LIMIT(maxUniformBufferBindingSize);
+    PERS_NEGOTIATE_LIMIT(maxStorageBufferBindingSize);
+    PERS_NEGOTIATE_LIMIT(maxBufferSize);
+    PERS_NEGOTIATE_LIMIT(maxVertexBuffers);
+    PERS_NEGOTIATE_LIMIT(maxVertexAttributes);
+    PERS_NEGOTIATE_LIMIT(maxVertexBufferArrayStride);
+    PERS_NEGOTIATE_LIMIT(maxInterStageShaderVariables);
+    PERS_NEGOTIATE_LIMIT(maxComputeWorkgroupStorageSize);
+    PERS_NEGOTIATE_LIMIT(maxComputeInvocationsPerWorkgroup);
+    PERS_NEGOTIATE_LIMIT(maxComputeWorkgroupSizeX);
+    PERS_NEGOTIATE_LIMIT(maxComputeWorkgroupSizeY);
+    PERS_NEGOTIATE_LIMIT(maxComputeWorkgroupSizeZ);
+    PERS_NEGOTIATE_LIMIT(maxComputeWorkgroupsPerDimension);
+#undef PERS_NEGOTIATE_LIMIT
+    
+    // A binding cannot be larger than the buffer behind it, raise the buffer size along
+    constexpr uint64_t DEFAULT_MAX_BUFFER_SIZE = 256ull * 1024 * 1024;
+    const uint64_t maxBufferSize = out.maxBufferSize != WGPU_LIMIT_U64_UNDEFINED ? out.maxBufferSize : DEFAULT_MAX_BUFFER_SIZE;
+    if (ok && out.maxStorageBufferBindingSize != WGPU_LIMIT_U64_UNDEFINED &&
+        out.maxStorageBufferBindingSize > maxBufferSize) {
+        out.maxBufferSize = std::min(out.maxStorageBufferBindingSize, available.maxBufferSize);
+    }
+    return ok;
 }
 
-WebGPUPhysicalDevice::WebGPUPhysicalDevice(WGPUAdapter adapter)
-    : _adapter(adapter) {
+WebGPUPhysicalDevice::WebGPUPhysicalDevice(WGPUAdapter adapter,
+                                           const std::shared_ptr<WebGPUEventPump>& eventPump)
+    : _adapter(adapter)
+    , _eventPump(eventPump) {
     
     if (_adapter) {
         wgpuAdapterAddRef(_adapter);
@@ -93,6 +123,8 @@ WebGPUPhysicalDevice::WebGPUPhysicalDevice(WGPUAdapter adapter)
 
 WebGPUPhysicalDevice::~WebGPUPhysicalDevice() {
     if (_adapter) {
+        // The adapter handle may be reused once released
+        WebGPUSwapChain::invalidateSurfaceCapabilities(nullptr, _adapter);
         // Only free adapter info if it was successfully queried
         if (_adapterInfoValid) {
             wgpuAdapterInfoFreeMembers(_adapterInfo);
@@ -128,11 +160,46 @@ PhysicalDeviceCapabilities WebGPUPhysicalDevice::getCapabilities() const {
     }
     
     // Query and cache capabilities
-    _cachedCapabilities = queryCapabilities();
+    _cachedCapabilities = queryCapabilities(getAdapterQuery());
     return *_cachedCapabilities;
 }
 
-PhysicalDeviceCapabilities WebGPUPhysicalDevice::queryCapabilities() const {
+void WebGPUPhysicalDevice::invalidateCapabilities() {
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cachedAdapterQuery.reset();
+        _cachedCapabilities.reset();
+    }
+    WebGPUSwapChain::invalidateSurfaceCapabilities(nullptr, _adapter);
+}
+
+const WebGPUPhysicalDevice::AdapterQuery& WebGPUPhysicalDevice::getAdapterQuery() const {
+    if (_cachedAdapterQuery.has_value()) {
+        return *_cachedAdapterQuery;
+    }
+    
+    AdapterQuery query;
+    if (_adapter) {
+        WGPUNativeLimits nativeLimits = {};
+        nativeLimits.chain.sType = static_cast<WGPUSType>(WGPUSType_NativeLimits);
+        query.limits.nextInChain = &nativeLimits.chain;
+        query.limitsValid = wgpuAdapterGetLimits(_adapter, &query.limits) == WGPUStatus_Success;
+        query.limits.nextInChain = nullptr;  // Copied into device descriptors later
+        query.maxPushConstantSize = query.limitsValid ? nativeLimits.maxPushConstantSize : 0;
+        
+        SupportedFeaturesGuard featuresGuard;
+        wgpuAdapterGetFeatures(_adapter, &featuresGuard.features);
+        if (featuresGuard.features.features) {
+            query.features.assign(featuresGuard.features.features,
+                                  featuresGuard.features.features + featuresGuard.features.featureCount);
+        }
+    }
+    
+    _cachedAdapterQuery = std::move(query);
+    return *_cachedAdapterQuery;
+}
+
+PhysicalDeviceCapabilities WebGPUPhysicalDevice::queryCapabilities(const AdapterQuery& query) const {
     PhysicalDeviceCapabilities caps = {};
     
     if (!_adapter) {
@@ -148,79 +215,102 @@ PhysicalDeviceCapabilities WebGPUPhysicalDevice::queryCapabilities() const {
         if (_adapterInfo.description.data) {
             caps.driverInfo = std::string(_adapterInfo.description.data, _adapterInfo.description.length);
         }
+        if (_adapterInfo.vendor.data) {
+            caps.vendorName = std::string(_adapterInfo.vendor.data, _adapterInfo.vendor.length);
+        }
+        if (_adapterInfo.architecture.data) {
+            caps.architecture = std::string(_adapterInfo.architecture.data, _adapterInfo.architecture.length);
+        }
+        caps.vendorId = _adapterInfo.vendorID;
+        caps.deviceId = _adapterInfo.deviceID;
+        
+        // Integrated GPUs and software rasterizers read buffers from host memory
+        caps.isUnifiedMemory = _adapterInfo.adapterType == WGPUAdapterType_IntegratedGPU ||
+                               _adapterInfo.adapterType == WGPUAdapterType_CPU;
     }
     
-    // Query limits
-    WGPULimits limits = {};
-    WGPUStatus status = wgpuAdapterGetLimits(_adapter, &limits);
-    if (status == WGPUStatus_Success) {
-        caps.maxTextureSize2D = limits.maxTextureDimension2D;
-        caps.maxTextureSize3D = limits.maxTextureDimension3D;
-        caps.maxTextureLayers = limits.maxTextureArrayLayers;
+    if (query.limitsValid) {
+        caps.maxTextureSize2D = query.limits.maxTextureDimension2D;
+        caps.maxTextureSize3D = query.limits.maxTextureDimension3D;
+        caps.maxTextureLayers = query.limits.maxTextureArrayLayers;
     }
     
-    // Query features using RAII wrapper
-    SupportedFeaturesGuard featuresGuard;
-    wgpuAdapterGetFeatures(_adapter, &featuresGuard.features);
-    
     // WebGPU always supports compute
     caps.supportsCompute = true;
     
     // Features not supported in WebGPU (keeping for API compatibility)
     caps.supportsRayTracing = false;     // WebGPU doesn't have ray tracing support
     caps.supportsTessellation = false;   // WebGPU doesn't have tessellation support
-    caps.supportsPipelineStatisticsQuery = false; // Not in current WebGPU spec
     
-    if (featuresGuard.features.featureCount > 0 && featuresGuard.features.features) {
-        for (size_t i = 0; i < featuresGuard.features.featureCount; ++i) {
-            WGPUFeatureName feature = featuresGuard.features.features[i];
-            
-            // Map WebGPU features to capabilities
-            switch (feature) {
-                case WGPUFeatureName_ShaderF16:
-                    caps.supportsShaderF16 = true;
-                    break;
-                case WGPUFeatureName_DepthClipControl:
-                    caps.supportsDepthClipControl = true;
-                    break;
-                case WGPUFeatureName_Depth32FloatStencil8:
-                    caps.supportsDepth32FloatStencil8 = true;
-                    break;
-                case WGPUFeatureName_TimestampQuery:
-                    caps.supportsTimestampQuery = true;
-                    break;
-                case WGPUFeatureName_TextureCompressionBC:
-                    caps.supportsTextureCompressionBC = true;
-                    break;
-                case WGPUFeatureName_TextureCompressionETC2:
-                    caps.supportsTextureCompressionETC2 = true;
-                    break;
-                case WGPUFeatureName_TextureCompressionASTC:
-                    caps.supportsTextureCompressionASTC = true;
-                    break;
-                case WGPUFeatureName_IndirectFirstInstance:
-                    caps.supportsIndirectFirstInstance = true;
-                    break;
-                case WGPUFeatureName_RG11B10UfloatRenderable:
-                    caps.supportsRG11B10UfloatRenderable = true;
-                    break;
-                case WGPUFeatureName_BGRA8UnormStorage:
-                    caps.supportsBGRA8UnormStorage = true;
-                    break;
-                case WGPUFeatureName_Float32Filterable:
-                    caps.supportsFloat32Filterable = true;
-                    break;
-                default:
-                    // Unknown or unsupported feature - log for debugging
-                    Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
-                        "Unknown or unmapped feature detected: %d", static_cast<int>(feature));
-                    break;
-            }
+    for (WGPUFeatureName feature : query.features) {
+        // Map WebGPU features to capabilities
+        switch (feature) {
+            case WGPUFeatureName_ShaderF16:
+                caps.supportsShaderF16 = true;
+                break;
+            case WGPUFeatureName_DepthClipControl:
+                caps.supportsDepthClipControl = true;
+                break;
+            case WGPUFeatureName_Depth32FloatStencil8:
+                caps.supportsDepth32FloatStencil8 = true;
+                break;
+            case WGPUFeatureName_TimestampQuery:
+                caps.supportsTimestampQuery = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_PipelineStatisticsQuery):
+                caps.supportsPipelineStatisticsQuery = true;
+                break;
+            case WGPUFeatureName_TextureCompressionBC:
+                caps.supportsTextureCompressionBC = true;
+                break;
+            case WGPUFeatureName_TextureCompressionETC2:
+                caps.supportsTextureCompressionETC2 = true;
+                break;
+            case WGPUFeatureName_TextureCompressionASTC:
+                caps.supportsTextureCompressionASTC = true;
+                break;
+            case WGPUFeatureName_IndirectFirstInstance:
+                caps.supportsIndirectFirstInstance = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirect):
+                caps.supportsMultiDrawIndirect = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_MultiDrawIndirectCount):
+                caps.supportsMultiDrawIndirectCount = true;
+                break;
+            case WGPUFeatureName_RG11B10UfloatRenderable:
+                caps.supportsRG11B10UfloatRenderable = true;
+                break;
+            case WGPUFeatureName_BGRA8UnormStorage:
+                caps.supportsBGRA8UnormStorage = true;
+                break;
+            case WGPUFeatureName_Float32Filterable:
+                caps.supportsFloat32Filterable = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_TextureBindingArray):
+                caps.supportsTextureBindingArray = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_BufferBindingArray):
+                caps.supportsBufferBindingArray = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_SampledTextureAndStorageBufferArrayNonUniformIndexing):
+                caps.supportsNonUniformIndexing = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_MappablePrimaryBuffers):
+                caps.supportsMappablePrimaryBuffers = true;
+                break;
+            case static_cast<WGPUFeatureName>(WGPUNativeFeature_PushConstants):
+                caps.supportsPushConstants = true;
+                caps.maxPushConstantSize = query.maxPushConstantSize;
+                break;
+            default:
+                // Unknown or unsupported feature - log for debugging
+                Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
+                    "Unknown or unmapped feature detected: %d", static_cast<int>(feature));
+                break;
         }
     }
     
-    // RAII wrapper automatically cleans up features
-    
     // WebGPU doesn't directly expose memory info
     // These would need platform-specific queries
     
@@ -267,22 +357,15 @@ bool WebGPUPhysicalDevice::supportsSurface(const NativeSurfaceHandle& surface) c
         return false;
     }
     
-    // Try to get surface capabilities to properly check support
-    WGPUSurfaceCapabilities capabilities = {};
-    wgpuSurfaceGetCapabilities(wgpuSurface, _adapter, &capabilities);
+    // Cached per (surface, adapter), so repeated checks during negotiation are free
+    SurfaceCapabilities capabilities = WebGPUSwapChain::querySurfaceCapabilities(_adapter, wgpuSurface);
     
-    // Check if we got valid capabilities
-    bool isSupported = false;
-    if (capabilities.formatCount > 0 && capabilities.formats != nullptr) {
-        // Surface is supported if we have at least one compatible format
-        isSupported = true;
-        
+    // Surface is supported if we have at least one compatible format
+    bool isSupported = !capabilities.formats.empty();
+    if (isSupported) {
         Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
             "Surface supported with %zu formats, %zu present modes", 
-            capabilities.formatCount, capabilities.presentModeCount);
-        
-        // Free the allocated arrays
-        wgpuSurfaceCapabilitiesFreeMembers(capabilities);
+            capabilities.formats.size(), capabilities.presentModes.size());
     } else {
         // No formats available means surface is not compatible
         LOG_WARNING("WebGPUPhysicalDevice",
@@ -294,6 +377,7 @@ bool WebGPUPhysicalDevice::supportsSurface(const NativeSurfaceHandle& surface) c
 
 std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
     const LogicalDeviceDesc& desc) {
+    PERS_PROFILE_SCOPE("WebGPUPhysicalDevice::createLogicalDevice");
     
     if (!_adapter) {
         LOG_ERROR("WebGPUPhysicalDevice", 
@@ -322,6 +406,11 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
         deviceDesc.label.length = labelCopy.length();
     }
     
+    // Optional features the adapter has are enabled as well
+    if (!desc.preferredFeatures.empty()) {
+        addSupportedFeatures(desc.preferredFeatures, requiredFeatures);
+    }
+    
     // Set required features
     if (!requiredFeatures.empty()) {
         deviceDesc.requiredFeatures = requiredFeatures.data();
@@ -329,15 +418,30 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
     }
     
     // Setup required limits - always start with adapter defaults
-    WGPULimits requiredLimits = {};
-    WGPUStatus status = wgpuAdapterGetLimits(_adapter, &requiredLimits);
-    if (status != WGPUStatus_Success) {
-        LOG_ERROR("WebGPUPhysicalDevice",
-            "Failed to query adapter limits");
-        return nullptr;
+    WGPULimits adapterLimits = {};
+    uint32_t adapterPushConstantSize = 0;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        const AdapterQuery& query = getAdapterQuery();
+        if (!query.limitsValid) {
+            LOG_ERROR("WebGPUPhysicalDevice",
+                "Failed to query adapter limits");
+            return nullptr;
+        }
+        adapterLimits = query.limits;
+        adapterPushConstantSize = query.maxPushConstantSize;
     }
+    WGPULimits requiredLimits = adapterLimits;
     
-    if (desc.requiredLimits) {
+    if (desc.negotiateLimits) {
+        if (!negotiateLimits(desc, adapterLimits, requiredLimits)) {
+            LOG_ERROR("WebGPUPhysicalDevice",
+                "Adapter does not meet the required limits");
+            return nullptr;
+        }
+        LOG_INFO("WebGPUPhysicalDevice",
+            "Using negotiated limits, WebGPU defaults for unspecified fields");
+    } else if (desc.requiredLimits) {
         // Override specific limits with user-specified values
         // Only override non-zero values to keep adapter defaults for unspecified fields
         if (desc.requiredLimits->maxTextureDimension1D > 0) 
@@ -370,6 +474,8 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
             requiredLimits.maxUniformBufferBindingSize = desc.requiredLimits->maxUniformBufferBindingSize;
         if (desc.requiredLimits->maxStorageBufferBindingSize > 0) 
             requiredLimits.maxStorageBufferBindingSize = desc.requiredLimits->maxStorageBufferBindingSize;
+        if (desc.requiredLimits->maxBufferSize > 0) 
+            requiredLimits.maxBufferSize = desc.requiredLimits->maxBufferSize;
         if (desc.requiredLimits->maxVertexBuffers > 0) 
             requiredLimits.maxVertexBuffers = desc.requiredLimits->maxVertexBuffers;
         if (desc.requiredLimits->maxVertexAttributes > 0) 
@@ -398,6 +504,24 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
             "Using adapter's default limits");
     }
     
+    // Push constants are unusable at the default limit of 0, so an enabled feature
+    // gets the adapter maximum unless the descriptor asks for a size
+    WGPUNativeLimits requiredNativeLimits = {};
+    const auto pushConstants = static_cast<WGPUFeatureName>(WGPUNativeFeature_PushConstants);
+    if (std::find(requiredFeatures.begin(), requiredFeatures.end(), pushConstants) != requiredFeatures.end()) {
+        const uint32_t required = desc.requiredLimits ? desc.requiredLimits->maxPushConstantSize : 0;
+        const uint32_t preferred = desc.preferredLimits ? desc.preferredLimits->maxPushConstantSize : 0;
+        if (required > adapterPushConstantSize) {
+            Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
+                "maxPushConstantSize %u exceeds the adapter maximum %u", required, adapterPushConstantSize);
+            return nullptr;
+        }
+        requiredNativeLimits.chain.sType = static_cast<WGPUSType>(WGPUSType_NativeLimits);
+        requiredNativeLimits.maxPushConstantSize = required ? required
+            : preferred ? std::min(preferred, adapterPushConstantSize) : adapterPushConstantSize;
+        requiredLimits.nextInChain = &requiredNativeLimits.chain;
+    }
+    
     deviceDesc.requiredLimits = &requiredLimits;
     
     // Setup uncaptured error callback
@@ -428,10 +552,14 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
             errorTypeStr, message.data ? message.data : "No message");
     };
     
-    // Setup device lost callback
+    // Setup device lost callback; the state outlives the device, see WebGPULogicalDevice
+    auto lostState = std::make_shared<WebGPUDeviceLostState>();
     deviceDesc.deviceLostCallbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    deviceDesc.deviceLostCallbackInfo.userdata1 = lostState.get();
     deviceDesc.deviceLostCallbackInfo.callback = [](WGPUDevice const * device, WGPUDeviceLostReason reason, 
                                                     WGPUStringView message, void* userdata1, void* userdata2) {
+        static_cast<WebGPUDeviceLostState*>(userdata1)->lost.store(true, std::memory_order_release);
+        
         const char* reasonStr = "Unknown";
         switch (reason) {
             case WGPUDeviceLostReason_Unknown:
@@ -498,7 +626,10 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
     };
     callbackInfo.userdata1 = &callbackData;
     
-    // Request device
+    // Request device, the event pump fires the callback while we wait
+    if (_eventPump) {
+        _eventPump->beginAsync();
+    }
     wgpuAdapterRequestDevice(_adapter, &deviceDesc, callbackInfo);
     
     // Wait for callback with user-specified timeout
@@ -507,6 +638,10 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
     bool success = callbackData.cv.wait_for(lock, desc.timeout, 
         [&callbackData] { return callbackData.received; });
     
+    if (_eventPump) {
+        _eventPump->endAsync();
+    }
+    
     if (!success) {
         Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
             "Timeout waiting for device (timeout: %lld ms)", desc.timeout.count());
@@ -530,7 +665,7 @@ std::shared_ptr<ILogicalDevice> WebGPUPhysicalDevice::createLogicalDevice(
     }
     
     // Create and return logical device with shared_from_this()
-    auto logicalDevice = std::make_shared<WebGPULogicalDevice>(callbackData.device, shared_from_this());
+    auto logicalDevice = std::make_shared<WebGPULogicalDevice>(callbackData.device, shared_from_this(), _eventPump, lostState);
     
     // Release our reference as WebGPULogicalDevice will add its own
     wgpuDeviceRelease(callbackData.device);
@@ -589,29 +724,24 @@ bool WebGPUPhysicalDevice::checkFeatureSupport(
         return false;
     }
     
-    // Query supported features
-    SupportedFeaturesGuard supportedGuard;
-    wgpuAdapterGetFeatures(_adapter, &supportedGuard.features);
-    
     // Build set of supported features for fast lookup
     std::unordered_set<WGPUFeatureName> supportedSet;
-    if (supportedGuard.features.features) {
-        for (size_t i = 0; i < supportedGuard.features.featureCount; ++i) {
-            supportedSet.insert(supportedGuard.features.features[i]);
-        }
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        const AdapterQuery& query = getAdapterQuery();
+        supportedSet.insert(query.features.begin(), query.features.end());
     }
     
     // Check each required feature
     outWGPUFeatures.clear();
     for (const auto& feature : requiredFeatures) {
-        auto it = g_featureMap.find(feature);
-        if (it == g_featureMap.end()) {
+        WGPUFeatureName wgpuFeature = WebGPUConverters::convertDeviceFeature(feature);
+        if (wgpuFeature == WGPUFeatureName_Force32) {
             Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
                 "Unknown device feature requested: %d", static_cast<int>(feature));
             return false;
         }
         
-        WGPUFeatureName wgpuFeature = it->second;
         if (supportedSet.find(wgpuFeature) == supportedSet.end()) {
             Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
                 "Feature not supported by adapter: %d", static_cast<int>(feature));
@@ -624,4 +754,28 @@ bool WebGPUPhysicalDevice::checkFeatureSupport(
     return true;
 }
 
-} // namespace pers
\ No newline at end of file
+void WebGPUPhysicalDevice::addSupportedFeatures(
+    const std::vector<DeviceFeature>& preferredFeatures,
+    std::vector<WGPUFeatureName>& inOutWGPUFeatures) const {
+    
+    std::unordered_set<WGPUFeatureName> supportedSet;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        const AdapterQuery& query = getAdapterQuery();
+        supportedSet.insert(query.features.begin(), query.features.end());
+    }
+    
+    for (const auto& feature : preferredFeatures) {
+        WGPUFeatureName wgpuFeature = WebGPUConverters::convertDeviceFeature(feature);
+        if (supportedSet.count(wgpuFeature) == 0) {
+            Logger::Instance().LogFormat(LogLevel::Info, "WebGPUPhysicalDevice", PERS_SOURCE_LOC,
+                "Preferred feature not supported by adapter, skipping: %d", static_cast<int>(feature));
+            continue;
+        }
+        if (std::find(inOutWGPUFeatures.begin(), inOutWGPUFeatures.end(), wgpuFeature) == inOutWGPUFeatures.end()) {
+            inOutWGPUFeatures.push_back(wgpuFeature);
+        }
+    }
+}
+
+} // namespace pers
@@ -0,0 +1,70 @@
+#include "pers/graphics/backends/webgpu/WebGPUPipelineLayout.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>
+#include <vector>
+
+namespace pers {
+
+WebGPUPipelineLayout::WebGPUPipelineLayout(const PipelineLayoutDesc& desc, WGPUDevice device)
+    : _desc(desc) {
+    if (!device) {
+        LOG_ERROR("WebGPUPipelineLayout",
+            "Cannot create pipeline layout without device");
+        return;
+    }
+    
+    std::vector<WGPUBindGroupLayout> groupLayouts;
+    groupLayouts.reserve(desc.bindGroupLayouts.size());
+    for (const auto& groupLayout : desc.bindGroupLayouts) {
+        if (!groupLayout) {
+            LOG_ERROR("WebGPUPipelineLayout",
+                "Pipeline layout contains a null bind group layout");
+            return;
+        }
+        groupLayouts.push_back(groupLayout->getNativeBindGroupLayoutHandle().as<WGPUBindGroupLayout>());
+    }
+    
+    WGPUPipelineLayoutDescriptor layoutDesc = {};
+    layoutDesc.label = WGPUStringView{_desc.debugName.data(), _desc.debugName.length()};
+    layoutDesc.bindGroupLayoutCount = groupLayouts.size();
+    layoutDesc.bindGroupLayouts = groupLayouts.data();
+    
+    std::vector<WGPUPushConstantRange> pushConstantRanges;
+    pushConstantRanges.reserve(desc.pushConstantRanges.size());
+    for (const auto& range : desc.pushConstantRanges) {
+        pushConstantRanges.push_back({WebGPUConverters::convertShaderStage(range.stages),
+                                      range.offset, range.offset + range.size});
+    }
+    WGPUPipelineLayoutExtras extras = {};
+    if (!pushConstantRanges.empty()) {
+        extras.chain.sType = static_cast<WGPUSType>(WGPUSType_PipelineLayoutExtras);
+        extras.pushConstantRangeCount = pushConstantRanges.size();
+        extras.pushConstantRanges = pushConstantRanges.data();
+        layoutDesc.nextInChain = &extras.chain;
+    }
+    
+    _layout = wgpuDeviceCreatePipelineLayout(device, &layoutDesc);
+    if (!_layout) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUPipelineLayout",
+            PERS_SOURCE_LOC, "Failed to create pipeline layout: %s", _desc.debugName.c_str());
+    }
+}
+
+WebGPUPipelineLayout::~WebGPUPipelineLayout() {
+    if (_layout) {
+        wgpuPipelineLayoutRelease(_layout);
+        _layout = nullptr;
+    }
+}
+
+const PipelineLayoutDesc& WebGPUPipelineLayout::getDesc() const {
+    return _desc;
+}
+
+NativePipelineLayoutHandle WebGPUPipelineLayout::getNativePipelineLayoutHandle() const {
+    return NativePipelineLayoutHandle::fromBackend(_layout);
+}
+
+} // namespace pers
@@ -0,0 +1,108 @@
+#include "pers/graphics/backends/webgpu/WebGPUPreparedRenderPass.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/ITextureView.h"
+#include "pers/graphics/IQuerySet.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+WebGPUPreparedRenderPass::WebGPUPreparedRenderPass(const RenderPassDesc& desc)
+    : _desc(desc) {
+    // Own the depth attachment so retargeting never writes through a caller's pointer
+    if (_desc.depthStencilAttachment) {
+        _desc.depthStencilAttachment = std::make_shared<RenderPassDepthStencilAttachment>(*desc.depthStencilAttachment);
+    }
+    
+    if (!_desc.label.empty()) {
+        _native.label = WGPUStringView{.data = _desc.label.c_str(), .length = _desc.label.length()};
+    } else {
+        _native.label = WGPUStringView{.data = "Render Pass", .length = 11};
+    }
+    
+    _colorAttachments.reserve(_desc.colorAttachments.size());
+    for (const auto& attachment : _desc.colorAttachments) {
+        _colorAttachments.push_back(WebGPUConverters::convertColorAttachment(attachment));
+    }
+    _native.colorAttachmentCount = _colorAttachments.size();
+    _native.colorAttachments = _colorAttachments.empty() ? nullptr : _colorAttachments.data();
+    
+    if (_desc.depthStencilAttachment && _desc.depthStencilAttachment->view) {
+        _depthStencilAttachment = WebGPUConverters::convertDepthStencilAttachment(*_desc.depthStencilAttachment);
+        _native.depthStencilAttachment = &_depthStencilAttachment;
+    }
+    
+    if (WebGPUConverters::convertTimestampWrites(_desc.timestampWrites, _timestampWrites)) {
+        _native.timestampWrites = &_timestampWrites;
+    }
+    
+    if (_desc.occlusionQuerySet) {
+        if (_desc.occlusionQuerySet->getType() == QueryType::Occlusion) {
+            _native.occlusionQuerySet = _desc.occlusionQuerySet->getNativeQuerySetHandle().as<WGPUQuerySet>();
+        } else {
+            LOG_WARNING("WebGPUPreparedRenderPass", "Render pass occlusionQuerySet is not an occlusion query set, ignored");
+        }
+    }
+}
+
+bool WebGPUPreparedRenderPass::setColorView(uint32_t index, const std::shared_ptr<ITextureView>& view) {
+    if (index >= _colorAttachments.size() || !view) {
+        LOG_ERROR("WebGPUPreparedRenderPass", "Color attachment index out of range or null view");
+        return false;
+    }
+    
+    _desc.colorAttachments[index].view = view;
+    _colorAttachments[index].view = view->getNativeTextureViewHandle().as<WGPUTextureView>();
+    return true;
+}
+
+bool WebGPUPreparedRenderPass::setResolveTarget(uint32_t index, const std::shared_ptr<ITextureView>& view) {
+    if (index >= _colorAttachments.size()) {
+        LOG_ERROR("WebGPUPreparedRenderPass", "Color attachment index out of range");
+        return false;
+    }
+    
+    _desc.colorAttachments[index].resolveTarget = view;
+    _colorAttachments[index].resolveTarget = view ? view->getNativeTextureViewHandle().as<WGPUTextureView>() : nullptr;
+    return true;
+}
+
+bool WebGPUPreparedRenderPass::setClearColor(uint32_t index, const Color& color) {
+    if (index >= _colorAttachments.size()) {
+        LOG_ERROR("WebGPUPreparedRenderPass", "Color attachment index out of range");
+        return false;
+    }
+    
+    _desc.colorAttachments[index].clearColor = color;
+    if (_desc.colorAttachments[index].loadOp == LoadOp::Clear) {
+        _colorAttachments[index].clearValue = WGPUColor{color.r, color.g, color.b, color.a};
+    }
+    return true;
+}
+
+bool WebGPUPreparedRenderPass::setDepthStencilView(const std::shared_ptr<ITextureView>& view) {
+    if (!_desc.depthStencilAttachment || !view) {
+        LOG_ERROR("WebGPUPreparedRenderPass", "Pass has no depth stencil attachment or view is null");
+        return false;
+    }
+    
+    _desc.depthStencilAttachment->view = view;
+    if (_native.depthStencilAttachment) {
+        _depthStencilAttachment.view = view->getNativeTextureViewHandle().as<WGPUTextureView>();
+    } else {
+        // Prepared before its view existed
+        _depthStencilAttachment = WebGPUConverters::convertDepthStencilAttachment(*_desc.depthStencilAttachment);
+        _native.depthStencilAttachment = &_depthStencilAttachment;
+    }
+    return true;
+}
+
+bool WebGPUPreparedRenderPass::isComplete() const {
+    for (const auto& attachment : _colorAttachments) {
+        if (!attachment.view) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,67 @@
+#include "pers/graphics/backends/webgpu/WebGPUQuerySet.h"
+#include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>  // For pipeline statistics queries
+#include <vector>
+
+namespace pers {
+
+WebGPUQuerySet::WebGPUQuerySet(const QuerySetDesc& desc, WGPUDevice device)
+    : _desc(desc) {
+    if (!device) {
+        LOG_ERROR("WebGPUQuerySet", "Cannot create query set without device");
+        return;
+    }
+    
+    if (desc.count == 0) {
+        LOG_ERROR("WebGPUQuerySet", "Query set count must be non-zero");
+        return;
+    }
+    
+    WGPUQuerySetDescriptor querySetDesc = {};
+    querySetDesc.label = WGPUStringView{_desc.label.data(), _desc.label.length()};
+    querySetDesc.count = desc.count;
+    
+    WGPUQuerySetDescriptorExtras extras = {};
+    std::vector<WGPUPipelineStatisticName> statistics;
+    switch (desc.type) {
+        case QueryType::Occlusion:
+            querySetDesc.type = WGPUQueryType_Occlusion;
+            break;
+        case QueryType::Timestamp:
+            querySetDesc.type = WGPUQueryType_Timestamp;
+            break;
+        case QueryType::PipelineStatistics:
+            if (desc.pipelineStatistics.empty()) {
+                LOG_ERROR("WebGPUQuerySet", "Pipeline statistics query set needs at least one statistic");
+                return;
+            }
+            statistics.reserve(desc.pipelineStatistics.size());
+            for (PipelineStatistic statistic : desc.pipelineStatistics) {
+                statistics.push_back(static_cast<WGPUPipelineStatisticName>(statistic));
+            }
+            extras.chain.sType = static_cast<WGPUSType>(WGPUSType_QuerySetDescriptorExtras);
+            extras.pipelineStatistics = statistics.data();
+            extras.pipelineStatisticCount = statistics.size();
+            querySetDesc.nextInChain = &extras.chain;
+            querySetDesc.type = static_cast<WGPUQueryType>(WGPUNativeQueryType_PipelineStatistics);
+            break;
+    }
+    
+    _querySet = wgpuDeviceCreateQuerySet(device, &querySetDesc);
+    if (!_querySet) {
+        LOG_ERROR_FMT("WebGPUQuerySet", "Failed to create query set: {}", _desc.label);
+    }
+}
+
+WebGPUQuerySet::~WebGPUQuerySet() {
+    if (_querySet) {
+        wgpuQuerySetRelease(_querySet);
+        _querySet = nullptr;
+    }
+}
+
+NativeQuerySetHandle WebGPUQuerySet::getNativeQuerySetHandle() const {
+    return NativeQuerySetHandle(_querySet);
+}
+
+} // namespace pers
@@ -2,18 +2,93 @@
 #include "pers/graphics/ICommandBuffer.h"
 #include "pers/graphics/buffers/IBuffer.h"
 #include "pers/graphics/ITexture.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include "pers/utils/FrameArena.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Profiler.h"
+#include "pers/utils/Validation.h"
 #include <webgpu/webgpu.h>
+#include <webgpu/wgpu.h>  // For wgpuDevicePoll
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <optional>
+#include <sstream>
 
 namespace pers {
 
-WebGPUQueue::WebGPUQueue(WGPUQueue queue)
-    : _queue(queue) {
+namespace {
+
+struct QueueMetrics {
+    MetricCounter& submits = Metrics::counter("pers_queue_submits_total", "Queue submissions");
+    MetricCounter& commandBuffers = Metrics::counter("pers_command_buffers_submitted_total", "Command buffers submitted");
+    MetricCounter& writeBytes = Metrics::counter("pers_buffer_write_bytes_total", "Bytes uploaded with queue writeBuffer");
+};
+
+QueueMetrics& queueMetrics() {
+    static QueueMetrics metrics;
+    return metrics;
+}
+
+} // namespace
+
+// Intrusively counted so a work-done callback only costs a reference, not an allocation
+struct WebGPUQueue::CompletionTarget {
+    std::shared_ptr<SubmissionTimeline> timeline;
+    std::shared_ptr<WebGPUEventPump> eventPump;
+    std::atomic<uint32_t> references{1};
+    
+    void retain() { references.fetch_add(1, std::memory_order_relaxed); }
+    void release() {
+        if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+};
+
+// The timeline value travels in the callback's second userdata pointer
+static_assert(sizeof(void*) >= sizeof(uint64_t), "Timeline values must fit callback userdata");
+
+WebGPUQueue::WebGPUQueue(WGPUQueue queue,
+                         WGPUDevice device,
+                         const std::shared_ptr<WebGPUEventPump>& eventPump)
+    : _queue(queue)
+    , _device(device)
+    , _eventPump(eventPump) {
+    
+    if (_device) {
+        wgpuDeviceAddRef(_device);
+    }
+    
+    WGPUDevice pollDevice = _device;
+    _timeline = std::make_shared<SubmissionTimeline>(pollDevice ? SubmissionTimeline::PollFunction([pollDevice]() {
+        wgpuDevicePoll(pollDevice, false, nullptr);
+    }) : SubmissionTimeline::PollFunction());
+    _timeline->setFlushFunction([this](uint64_t value) {
+        uint64_t batchValue = 0;
+        {
+            auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+            batchValue = _batchValue;
+        }
+        if (batchValue != 0 && value >= batchValue) {
+            flushSubmissions();
+        }
+    });
+    
+    _completion = new CompletionTarget{_timeline, _eventPump};
+    _batchedBuffers.reserve(INLINE_SUBMIT_CAPACITY);
+    _batchedOwners.reserve(INLINE_SUBMIT_CAPACITY);
     
     if (_queue) {
         wgpuQueueAddRef(_queue);
@@ -24,124 +99,556 @@ WebGPUQueue::WebGPUQueue(WGPUQueue queue)
 }
 
 WebGPUQueue::~WebGPUQueue() {
+    // Fences may outlive the queue, stop them from polling a released device
+    if (_timeline) {
+        _timeline->setFlushFunction(nullptr);
+        _timeline->setPollFunction(nullptr);
+    }
+    
+    if (_queue && !_batchedBuffers.empty()) {
+        LOG_WARNING("WebGPUQueue", "Destroyed with an open submission batch, submitting it");
+        flushSubmissions();
+    }
+    
     if (_queue) {
         wgpuQueueRelease(_queue);
         _queue = nullptr;
     }
+    
+    // Pending callbacks keep the target until they fire
+    _completion->release();
+    _completion = nullptr;
+    
+    if (_device) {
+        wgpuDeviceRelease(_device);
+        _device = nullptr;
+    }
 }
 
-bool WebGPUQueue::submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) {
-    if (!_queue) {
+SubmissionFence WebGPUQueue::submit(const std::shared_ptr<ICommandBuffer>& commandBuffer) {
+    PERS_PROFILE_SCOPE("WebGPUQueue::submit");
+    if (PERS_CHECK_FAILED(!_queue)) {
         LOG_ERROR("WebGPUQueue", "Cannot submit: queue is null");
-        return false;
+        return {};
     }
     
-    if (!commandBuffer) {
+    if (PERS_CHECK_FAILED(!commandBuffer)) {
         LOG_ERROR("WebGPUQueue", "Cannot submit null command buffer");
-        return false;
+        return {};
     }
     
     // Get native command buffer handle
     NativeCommandBufferHandle nativeHandle = commandBuffer->getNativeCommandBufferHandle();
-    if (!nativeHandle.isValid()) {
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
         LOG_ERROR("WebGPUQueue", "Command buffer has invalid native handle");
-        return false;
+        return {};
     }
     
     // Convert to WebGPU command buffer
     WGPUCommandBuffer wgpuCmdBuffer = nativeHandle.as<WGPUCommandBuffer>();
     
-    // Submit to queue
-    wgpuQueueSubmit(_queue, 1, &wgpuCmdBuffer);
-    
-    // Command buffer submitted successfully
-    return true;
+    return dispatch(&wgpuCmdBuffer, 1, &commandBuffer);
 }
 
-bool WebGPUQueue::submit(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) {
-    if (!_queue) {
+SubmissionFence WebGPUQueue::submit(std::span<const std::shared_ptr<ICommandBuffer>> commandBuffers) {
+    PERS_PROFILE_SCOPE("WebGPUQueue::submit");
+    if (PERS_CHECK_FAILED(!_queue)) {
         LOG_ERROR("WebGPUQueue", "Cannot submit: queue is null");
-        return false;
+        return {};
     }
     
     if (commandBuffers.empty()) {
-        return true; // Empty batch is OK
+        // Empty batch is OK, nothing new to wait for
+        return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
     }
     
-    // Collect native handles
-    std::vector<WGPUCommandBuffer> wgpuBuffers;
-    wgpuBuffers.reserve(commandBuffers.size());
+    // Collect native handles inline, or in frame scratch for larger submits; wgpuQueueSubmit consumes them
+    std::array<WGPUCommandBuffer, INLINE_SUBMIT_CAPACITY> inlineBuffers;
+    std::optional<FrameArena::ScratchScope> scratch;
+    std::span<WGPUCommandBuffer> wgpuBuffers(inlineBuffers.data(), commandBuffers.size());
+    if (commandBuffers.size() > INLINE_SUBMIT_CAPACITY) {
+        wgpuBuffers = scratch.emplace().allocateArray<WGPUCommandBuffer>(commandBuffers.size());
+    }
     
     for (size_t i = 0; i < commandBuffers.size(); ++i) {
-        if (!commandBuffers[i]) {
+        if (PERS_CHECK_FAILED(!commandBuffers[i])) {
             Logger::Instance().LogFormat(LogLevel::Error, "WebGPUQueue", PERS_SOURCE_LOC, "Null command buffer at index %zu", i);
-            return false;
+            return {};
         }
         
         NativeCommandBufferHandle nativeHandle = commandBuffers[i]->getNativeCommandBufferHandle();
-        if (!nativeHandle.isValid()) {
+        if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
             Logger::Instance().LogFormat(LogLevel::Error, "WebGPUQueue", PERS_SOURCE_LOC, "Invalid native handle at index %zu", i);
-            return false;
+            return {};
         }
         
-        wgpuBuffers.push_back(nativeHandle.as<WGPUCommandBuffer>());
+        wgpuBuffers[i] = nativeHandle.as<WGPUCommandBuffer>();
+    }
+    
+    return dispatch(wgpuBuffers.data(), wgpuBuffers.size(), commandBuffers.data());
+}
+
+SubmissionFence WebGPUQueue::submit(std::span<const NativeCommandBufferHandle> commandBuffers) {
+    PERS_PROFILE_SCOPE("WebGPUQueue::submit");
+    if (PERS_CHECK_FAILED(!_queue)) {
+        LOG_ERROR("WebGPUQueue", "Cannot submit: queue is null");
+        return {};
+    }
+    
+    if (commandBuffers.empty()) {
+        return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
     }
     
-    // Submit batch to queue
-    wgpuQueueSubmit(_queue, static_cast<uint32_t>(wgpuBuffers.size()), wgpuBuffers.data());
+    std::array<WGPUCommandBuffer, INLINE_SUBMIT_CAPACITY> inlineBuffers;
+    std::optional<FrameArena::ScratchScope> scratch;
+    std::span<WGPUCommandBuffer> wgpuBuffers(inlineBuffers.data(), commandBuffers.size());
+    if (commandBuffers.size() > INLINE_SUBMIT_CAPACITY) {
+        wgpuBuffers = scratch.emplace().allocateArray<WGPUCommandBuffer>(commandBuffers.size());
+    }
     
-    // Command buffers submitted successfully
-    return true;
+    for (size_t i = 0; i < commandBuffers.size(); ++i) {
+        if (PERS_CHECK_FAILED(!commandBuffers[i].isValid())) {
+            Logger::Instance().LogFormat(LogLevel::Error, "WebGPUQueue", PERS_SOURCE_LOC, "Invalid native handle at index %zu", i);
+            return {};
+        }
+        wgpuBuffers[i] = commandBuffers[i].as<WGPUCommandBuffer>();
+    }
+    
+    return dispatch(wgpuBuffers.data(), wgpuBuffers.size(), nullptr);
 }
 
-bool WebGPUQueue::submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) {
+SubmissionFence WebGPUQueue::submitBatch(const std::vector<std::shared_ptr<ICommandBuffer>>& commandBuffers) {
     // Just delegate to submit
     return submit(commandBuffers);
 }
 
+void WebGPUQueue::beginSubmissionBatch() {
+    auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+    ++_batchDepth;
+}
+
+SubmissionFence WebGPUQueue::endSubmissionBatch() {
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchDepth == 0) {
+            LOG_WARNING("WebGPUQueue", "endSubmissionBatch called without beginSubmissionBatch");
+            return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+        }
+        if (--_batchDepth > 0) {
+            return SubmissionFence(_timeline, _batchValue != 0 ? _batchValue : _timeline->getLastSubmittedValue());
+        }
+    }
+    return flushSubmissions();
+}
+
+SubmissionFence WebGPUQueue::flushSubmissions() {
+    // Typical batches move out into inline storage, so the batch vectors keep their
+    // capacity; only oversized ones take the vectors along
+    std::array<WGPUCommandBuffer, INLINE_SUBMIT_CAPACITY> inlineBuffers;
+    std::array<std::shared_ptr<ICommandBuffer>, INLINE_SUBMIT_CAPACITY> inlineOwners;
+    std::vector<WGPUCommandBuffer> overflowBuffers;
+    std::vector<std::shared_ptr<ICommandBuffer>> overflowOwners;
+    std::span<const WGPUCommandBuffer> buffers;
+    uint64_t value = 0;
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchValue == 0) {
+            return SubmissionFence(_timeline, _timeline->getLastSubmittedValue());
+        }
+        const size_t count = _batchedBuffers.size();
+        if (count <= INLINE_SUBMIT_CAPACITY) {
+            std::copy(_batchedBuffers.begin(), _batchedBuffers.end(), inlineBuffers.begin());
+            std::move(_batchedOwners.begin(), _batchedOwners.end(), inlineOwners.begin());
+            _batchedBuffers.clear();
+            _batchedOwners.clear();
+            buffers = std::span<const WGPUCommandBuffer>(inlineBuffers.data(), count);
+        } else {
+            overflowBuffers.swap(_batchedBuffers);
+            overflowOwners.swap(_batchedOwners);
+            _batchedBuffers.reserve(INLINE_SUBMIT_CAPACITY);
+            _batchedOwners.reserve(INLINE_SUBMIT_CAPACITY);
+            buffers = overflowBuffers;
+        }
+        value = _batchValue;
+        _batchValue = 0;
+    }
+    
+    // Outside the lock: completion callbacks may fire inside the submit and submit again
+    PERS_PROFILE_SCOPE("WebGPUQueue::flushSubmissions");
+    wgpuQueueSubmit(_queue, static_cast<uint32_t>(buffers.size()), buffers.data());
+    queueMetrics().submits.increment();
+    queueMetrics().commandBuffers.add(static_cast<int64_t>(buffers.size()));
+    registerCompletion(value);
+    return SubmissionFence(_timeline, value);
+}
+
+SubmissionFence WebGPUQueue::dispatch(const WGPUCommandBuffer* commandBuffers, size_t count,
+                                      const std::shared_ptr<ICommandBuffer>* owners) {
+    {
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchDepth > 0) {
+            // The whole batch shares one value, it completes with its single submit
+            if (_batchValue == 0) {
+                _batchValue = _timeline->signal();
+            }
+            _batchedBuffers.insert(_batchedBuffers.end(), commandBuffers, commandBuffers + count);
+            if (owners) {
+                _batchedOwners.insert(_batchedOwners.end(), owners, owners + count);
+            } else {
+                _batchedOwners.resize(_batchedOwners.size() + count);
+            }
+            return SubmissionFence(_timeline, _batchValue);
+        }
+    }
+    
+    wgpuQueueSubmit(_queue, static_cast<uint32_t>(count), commandBuffers);
+    queueMetrics().submits.increment();
+    queueMetrics().commandBuffers.add(static_cast<int64_t>(count));
+    return signalSubmission();
+}
+
+SubmissionFence WebGPUQueue::signalSubmission() {
+    uint64_t value = _timeline->signal();
+    registerCompletion(value);
+    return SubmissionFence(_timeline, value);
+}
+
+void WebGPUQueue::registerCompletion(uint64_t value) {
+    // One work-done callback per submit completes the timeline up to its value
+    WGPUQueueWorkDoneCallbackInfo callbackInfo = {};
+    callbackInfo.nextInChain = nullptr;
+    callbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    callbackInfo.callback = [](WGPUQueueWorkDoneStatus status, void* userdata1, void* userdata2) {
+        auto* target = static_cast<CompletionTarget*>(userdata1);
+        if (!target) {
+            return;
+        }
+        
+        bool success = (status == WGPUQueueWorkDoneStatus_Success);
+        if (!success) {
+            LOG_WARNING("WebGPUQueue", "Submission completed with non-success status");
+        }
+        
+        target->timeline->complete(static_cast<uint64_t>(reinterpret_cast<uintptr_t>(userdata2)), success);
+        if (target->eventPump) {
+            target->eventPump->endAsync();
+        }
+        target->release();
+    };
+    _completion->retain();
+    callbackInfo.userdata1 = _completion;
+    callbackInfo.userdata2 = reinterpret_cast<void*>(static_cast<uintptr_t>(value));
+    
+    if (_eventPump) {
+        _eventPump->beginAsync();
+    }
+    
+    wgpuQueueOnSubmittedWorkDone(_queue, callbackInfo);
+}
+
 bool WebGPUQueue::writeBuffer(const BufferWriteDesc& desc) {
-    if (!_queue) {
+    if (PERS_CHECK_FAILED(!_queue)) {
         LOG_ERROR("WebGPUQueue", "Cannot write buffer: queue is null");
         return false;
     }
     
-    if (!desc.buffer || !desc.data || desc.size == 0) {
+    if (PERS_CHECK_FAILED(!desc.buffer || !desc.data || desc.size == 0)) {
         LOG_ERROR("WebGPUQueue", "Invalid buffer write parameters");
         return false;
     }
     
     // Get native buffer handle
     NativeBufferHandle nativeHandle = desc.buffer->getNativeHandle();
-    if (!nativeHandle.isValid()) {
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
         LOG_ERROR("WebGPUQueue", "Invalid buffer handle");
         return false;
     }
     
     WGPUBuffer wgpuBuffer = nativeHandle.as<WGPUBuffer>();
-    wgpuQueueWriteBuffer(_queue, wgpuBuffer, desc.offset, desc.data, desc.size);
+    wgpuQueueWriteBuffer(_queue, wgpuBuffer, desc.buffer->getNativeOffset() + desc.offset, desc.data, desc.size);
+    queueMetrics().writeBytes.add(static_cast<int64_t>(desc.size));
     
     return true;
 }
 
+bool WebGPUQueue::writeBuffer(const std::shared_ptr<IBuffer>& buffer,
+                              uint64_t offset,
+                              std::span<const std::byte> data) {
+    BufferWriteDesc desc;
+    desc.buffer = buffer;
+    desc.offset = offset;
+    desc.data = data.data();
+    desc.size = data.size();
+    return writeBuffer(desc);
+}
+
+bool WebGPUQueue::writeBuffers(std::span<const BufferWriteDesc> writes) {
+    if (PERS_CHECK_FAILED(!_queue)) {
+        LOG_ERROR("WebGPUQueue", "Cannot write buffers: queue is null");
+        return false;
+    }
+    
+    bool success = true;
+    
+    // Pending run, flushed whenever the next write cannot be merged into it
+    const IBuffer* currentBuffer = nullptr;
+    WGPUBuffer wgpuBuffer = nullptr;
+    uint64_t baseOffset = 0;
+    uint64_t runOffset = 0;
+    const uint8_t* runData = nullptr;
+    uint64_t runSize = 0;
+    
+    auto flushRun = [&]() {
+        if (runSize > 0) {
+            wgpuQueueWriteBuffer(_queue, wgpuBuffer, baseOffset + runOffset, runData, runSize);
+            queueMetrics().writeBytes.add(static_cast<int64_t>(runSize));
+            runSize = 0;
+        }
+    };
+    
+    for (const auto& write : writes) {
+        if (PERS_CHECK_FAILED(!write.buffer || !write.data || write.size == 0)) {
+            LOG_ERROR("WebGPUQueue", "Invalid buffer write parameters");
+            success = false;
+            continue;
+        }
+        
+        if (write.buffer.get() != currentBuffer) {
+            flushRun();
+            
+            NativeBufferHandle nativeHandle = write.buffer->getNativeHandle();
+            if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
+                LOG_ERROR("WebGPUQueue", "Invalid buffer handle");
+                currentBuffer = nullptr;
+                success = false;
+                continue;
+            }
+            
+            currentBuffer = write.buffer.get();
+            wgpuBuffer = nativeHandle.as<WGPUBuffer>();
+            baseOffset = write.buffer->getNativeOffset();
+        }
+        
+        const uint8_t* data = static_cast<const uint8_t*>(write.data);
+        if (runSize > 0 && runOffset + runSize == write.offset && runData + runSize == data) {
+            runSize += write.size;
+            continue;
+        }
+        
+        flushRun();
+        runOffset = write.offset;
+        runData = data;
+        runSize = write.size;
+    }
+    
+    flushRun();
+    return success;
+}
+
 bool WebGPUQueue::writeTexture(const std::shared_ptr<ITexture>& texture, 
                                const void* data, 
                                uint64_t dataSize,
                                uint32_t mipLevel) {
+    TextureWriteDesc desc;
+    desc.texture = texture;
+    desc.mipLevel = mipLevel;
+    desc.data = data;
+    desc.dataSize = dataSize;
+    return writeTexture(desc);
+}
+
+bool WebGPUQueue::writeTexture(const TextureWriteDesc& desc) {
     if (!_queue) {
         LOG_ERROR("WebGPUQueue", "Cannot write texture: queue is null");
         return false;
     }
     
-    TODO_OR_DIE(
-        "WebGPUQueue::writeTexture",
-        "Implement texture data upload via queue. Steps: "
-        "1. Get native texture handle from ITexture, "
-        "2. Set up WGPUImageCopyTexture descriptor, "
-        "3. Set up WGPUTextureDataLayout, "
-        "4. Call wgpuQueueWriteTexture"
-    );
+    if (!desc.texture || !desc.data || desc.dataSize == 0) {
+        LOG_ERROR("WebGPUQueue", "Invalid texture write parameters");
+        return false;
+    }
+    
+    WGPUTexture wgpuTexture = desc.texture->getNativeTextureHandle().as<WGPUTexture>();
+    if (!wgpuTexture) {
+        LOG_ERROR("WebGPUQueue", "Invalid texture handle");
+        return false;
+    }
+    
+    if (desc.mipLevel >= desc.texture->getMipLevelCount()) {
+        LOG_ERROR("WebGPUQueue", "Texture write mip level out of range");
+        return false;
+    }
+    
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(desc.texture->getFormat());
+    if (block.blockBytes == 0) {
+        LOG_ERROR("WebGPUQueue", "Texture format cannot be written from memory");
+        return false;
+    }
+    
+    // Size of the target mip level
+    uint32_t mipWidth = std::max(1u, desc.texture->getWidth() >> desc.mipLevel);
+    uint32_t mipHeight = std::max(1u, desc.texture->getHeight() >> desc.mipLevel);
+    uint32_t mipDepth = desc.texture->getDimension() == TextureDimension::D3
+        ? std::max(1u, desc.texture->getDepthOrArrayLayers() >> desc.mipLevel)
+        : desc.texture->getDepthOrArrayLayers();
+    
+    if (desc.originX >= mipWidth || desc.originY >= mipHeight || desc.originZ >= mipDepth) {
+        LOG_ERROR("WebGPUQueue", "Texture write origin outside of mip level");
+        return false;
+    }
+    
+    WGPUExtent3D extent = {};
+    extent.width = desc.width ? desc.width : mipWidth - desc.originX;
+    extent.height = desc.height ? desc.height : mipHeight - desc.originY;
+    extent.depthOrArrayLayers = desc.depthOrArrayLayers ? desc.depthOrArrayLayers : mipDepth - desc.originZ;
+    
+    if (desc.originX + extent.width > mipWidth ||
+        desc.originY + extent.height > mipHeight ||
+        desc.originZ + extent.depthOrArrayLayers > mipDepth) {
+        LOG_ERROR("WebGPUQueue", "Texture write region exceeds mip level");
+        return false;
+    }
+    
+    // Compressed regions must cover whole blocks unless they stop at the mip edge
+    if (desc.originX % block.blockWidth != 0 || desc.originY % block.blockHeight != 0 ||
+        (extent.width % block.blockWidth != 0 && desc.originX + extent.width != mipWidth) ||
+        (extent.height % block.blockHeight != 0 && desc.originY + extent.height != mipHeight)) {
+        LOG_ERROR("WebGPUQueue", "Texture write region is not block aligned");
+        return false;
+    }
+    
+    uint32_t blocksWide = (extent.width + block.blockWidth - 1) / block.blockWidth;
+    uint32_t blocksHigh = (extent.height + block.blockHeight - 1) / block.blockHeight;
+    uint64_t rowBytes = static_cast<uint64_t>(blocksWide) * block.blockBytes;
+    
+    WGPUTexelCopyBufferLayout layout = {};
+    layout.offset = 0;
+    layout.bytesPerRow = desc.bytesPerRow ? desc.bytesPerRow : static_cast<uint32_t>(rowBytes);
+    layout.rowsPerImage = desc.rowsPerImage ? desc.rowsPerImage : blocksHigh;
+    
+    if (layout.bytesPerRow < rowBytes || layout.rowsPerImage < blocksHigh) {
+        LOG_ERROR("WebGPUQueue", "Texture write bytesPerRow or rowsPerImage too small for region");
+        return false;
+    }
+    
+    uint64_t imageBytes = static_cast<uint64_t>(layout.bytesPerRow) * layout.rowsPerImage;
+    uint64_t requiredBytes = imageBytes * (extent.depthOrArrayLayers - 1) +
+                             static_cast<uint64_t>(layout.bytesPerRow) * (blocksHigh - 1) + rowBytes;
+    if (desc.dataOffset > desc.dataSize || requiredBytes > desc.dataSize - desc.dataOffset) {
+        std::stringstream ss;
+        ss << "Texture write data too small: need " << requiredBytes << " bytes after offset "
+           << desc.dataOffset << ", have " << desc.dataSize;
+        LOG_ERROR("WebGPUQueue", ss.str().c_str());
+        return false;
+    }
+    
+    WGPUTexelCopyTextureInfo destination = {};
+    destination.texture = wgpuTexture;
+    destination.mipLevel = desc.mipLevel;
+    destination.origin = {desc.originX, desc.originY, desc.originZ};
+    destination.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
+    
+    const uint8_t* data = static_cast<const uint8_t*>(desc.data) + desc.dataOffset;
+    
+    uint64_t regionBytes = rowBytes * blocksHigh * extent.depthOrArrayLayers;
+    if (regionBytes > TILED_TEXTURE_UPLOAD_THRESHOLD && _device) {
+        if (auto pool = _stagingBufferPool.lock()) {
+            return writeTextureTiled(pool, destination, data, layout, extent, block.blockHeight, rowBytes);
+        }
+    }
+    
+    wgpuQueueWriteTexture(_queue, &destination, data, static_cast<size_t>(requiredBytes), &layout, &extent);
+    return true;
+}
+
+bool WebGPUQueue::writeTextureTiled(const std::shared_ptr<StagingBufferPool>& pool,
+                                    const WGPUTexelCopyTextureInfo& destination,
+                                    const uint8_t* data,
+                                    const WGPUTexelCopyBufferLayout& layout,
+                                    const WGPUExtent3D& extent,
+                                    uint32_t blockHeight,
+                                    uint64_t rowBytes) {
+    // Buffer-to-texture copies need a 256-byte aligned row pitch
+    const uint64_t ROW_PITCH_ALIGNMENT = 256;
+    uint64_t stagingPitch = (rowBytes + ROW_PITCH_ALIGNMENT - 1) & ~(ROW_PITCH_ALIGNMENT - 1);
+    uint32_t blocksHigh = (extent.height + blockHeight - 1) / blockHeight;
+    uint32_t bandRows = static_cast<uint32_t>(std::max<uint64_t>(1, TEXTURE_UPLOAD_TILE_SIZE / stagingPitch));
+    uint64_t imageBytes = static_cast<uint64_t>(layout.bytesPerRow) * layout.rowsPerImage;
+    
+    uint32_t bandCount = 0;
+    for (uint32_t image = 0; image < extent.depthOrArrayLayers; ++image) {
+        for (uint32_t row = 0; row < blocksHigh; row += bandRows) {
+            uint32_t rows = std::min(bandRows, blocksHigh - row);
+            
+            auto staging = pool->acquire(stagingPitch * rows);
+            if (!staging) {
+                LOG_ERROR("WebGPUQueue", "Failed to acquire staging buffer for texture band");
+                return false;
+            }
+            
+            uint8_t* dst = static_cast<uint8_t*>(staging->getMappedData());
+            const uint8_t* src = data + imageBytes * image + static_cast<uint64_t>(layout.bytesPerRow) * row;
+            // Tightly packed bands go in one streaming copy instead of per row
+            if (layout.bytesPerRow == stagingPitch && rowBytes == stagingPitch) {
+                copyToMappedMemory(dst, src, static_cast<size_t>(stagingPitch * rows));
+            } else {
+                for (uint32_t r = 0; r < rows; ++r) {
+                    copyToMappedMemory(dst + stagingPitch * r, src + static_cast<uint64_t>(layout.bytesPerRow) * r,
+                                       static_cast<size_t>(rowBytes));
+                }
+            }
+            staging->unmap();
+            
+            WGPUTexelCopyBufferInfo source = {};
+            source.buffer = staging->getNativeHandle().as<WGPUBuffer>();
+            source.layout.offset = 0;
+            source.layout.bytesPerRow = static_cast<uint32_t>(stagingPitch);
+            source.layout.rowsPerImage = rows;
+            
+            WGPUTexelCopyTextureInfo bandDestination = destination;
+            bandDestination.origin.y += row * blockHeight;
+            bandDestination.origin.z += image;
+            
+            WGPUExtent3D bandExtent = {};
+            bandExtent.width = extent.width;
+            bandExtent.height = std::min(rows * blockHeight, extent.height - row * blockHeight);
+            bandExtent.depthOrArrayLayers = 1;
+            
+            WGPUCommandEncoderDescriptor encoderDesc = {};
+            encoderDesc.label = WGPUStringView{.data = "Texture Upload Encoder", .length = 22};
+            WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(_device, &encoderDesc);
+            if (!encoder) {
+                LOG_ERROR("WebGPUQueue", "Failed to create texture upload encoder");
+                return false;
+            }
+            
+            wgpuCommandEncoderCopyBufferToTexture(encoder, &source, &bandDestination, &bandExtent);
+            
+            WGPUCommandBufferDescriptor commandBufferDesc = {};
+            WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(encoder, &commandBufferDesc);
+            wgpuCommandEncoderRelease(encoder);
+            if (!commandBuffer) {
+                LOG_ERROR("WebGPUQueue", "Failed to finish texture upload command buffer");
+                return false;
+            }
+            
+            wgpuQueueSubmit(_queue, 1, &commandBuffer);
+            wgpuCommandBufferRelease(commandBuffer);
+            
+            // Recycled once the GPU has consumed the band
+            pool->release(staging);
+            ++bandCount;
+        }
+    }
     
-    return false;
+    Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUQueue", PERS_SOURCE_LOC,
+        "Uploaded %ux%ux%u texture region in %u bands",
+        extent.width, extent.height, extent.depthOrArrayLayers, bandCount);
+    return true;
+}
+
+void WebGPUQueue::setStagingBufferPool(const std::weak_ptr<StagingBufferPool>& pool) {
+    _stagingBufferPool = pool;
 }
 
 bool WebGPUQueue::waitIdle() {
@@ -149,6 +656,8 @@ bool WebGPUQueue::waitIdle() {
         return false;
     }
     
+    flushSubmissions();
+    
     // Use condition variable for proper synchronization
     struct CallbackData {
         bool isComplete = false;
@@ -200,23 +709,92 @@ bool WebGPUQueue::waitIdle() {
     return true;
 }
 
+bool WebGPUQueue::onSubmittedWorkDone(QueueWorkDoneCallback callback) {
+    if (!_queue) {
+        LOG_ERROR("WebGPUQueue", "Cannot register work done callback: queue is null");
+        return false;
+    }
+    
+    if (!callback) {
+        LOG_ERROR("WebGPUQueue", "Work done callback is empty");
+        return false;
+    }
+    
+    {
+        // Collected work counts as submitted, fire once the batch completes
+        auto guard = makeLockGuard(_batchMutex, PERS_SOURCE_LOC);
+        if (_batchValue != 0) {
+            _timeline->then(_batchValue, std::move(callback));
+            return true;
+        }
+    }
+    
+    // Context is owned by the callback and freed once it fires
+    struct WorkDoneContext {
+        QueueWorkDoneCallback callback;
+        std::shared_ptr<WebGPUEventPump> eventPump;
+    };
+    
+    WGPUQueueWorkDoneCallbackInfo callbackInfo = {};
+    callbackInfo.nextInChain = nullptr;
+    callbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    callbackInfo.callback = [](WGPUQueueWorkDoneStatus status, void* userdata1, void* userdata2) {
+        auto* context = static_cast<WorkDoneContext*>(userdata1);
+        if (!context) {
+            return;
+        }
+        
+        bool success = (status == WGPUQueueWorkDoneStatus_Success);
+        if (!success) {
+            LOG_WARNING("WebGPUQueue", "Queue work done with non-success status");
+        }
+        
+        context->callback(success);
+        if (context->eventPump) {
+            context->eventPump->endAsync();
+        }
+        delete context;
+    };
+    callbackInfo.userdata1 = new WorkDoneContext{std::move(callback), _eventPump};
+    callbackInfo.userdata2 = nullptr;
+    
+    if (_eventPump) {
+        _eventPump->beginAsync();
+    }
+    
+    wgpuQueueOnSubmittedWorkDone(_queue, callbackInfo);
+    return true;
+}
+
+bool WebGPUQueue::pollSubmittedWork(bool wait) {
+    if (!_device) {
+        // Without a device we cannot drive callbacks, report work as outstanding
+        return false;
+    }
+    
+    if (wait) {
+        flushSubmissions();
+    }
+    return wgpuDevicePoll(_device, wait, nullptr);
+}
+
 NativeQueueHandle WebGPUQueue::getNativeQueueHandle() const {
     return NativeQueueHandle::fromBackend(_queue);
 }
 
 void WebGPUQueue::writeBuffer(WGPUBuffer buffer, uint64_t offset, const void* data, uint64_t size) {
-    if (!_queue) {
+    if (PERS_CHECK_FAILED(!_queue)) {
         LOG_ERROR("WebGPUQueue", "Cannot write buffer: queue is null");
         return;
     }
     
-    if (!buffer || !data || size == 0) {
+    if (PERS_CHECK_FAILED(!buffer || !data || size == 0)) {
         LOG_ERROR("WebGPUQueue", "Invalid buffer write parameters");
         return;
     }
     
     wgpuQueueWriteBuffer(_queue, buffer, offset, data, size);
-    // Buffer write completed
+    queueMetrics().writeBytes.add(static_cast<int64_t>(size));
 }
 
 } // namespace pers
\ No newline at end of file
@@ -0,0 +1,21 @@
+#include "pers/graphics/backends/webgpu/WebGPURenderBundle.h"
+
+namespace pers {
+
+WebGPURenderBundle::WebGPURenderBundle(WGPURenderBundle bundle, uint32_t drawCount)
+    : _bundle(bundle)
+    , _drawCount(drawCount) {
+}
+
+WebGPURenderBundle::~WebGPURenderBundle() {
+    if (_bundle) {
+        wgpuRenderBundleRelease(_bundle);
+        _bundle = nullptr;
+    }
+}
+
+NativeRenderBundleHandle WebGPURenderBundle::getNativeRenderBundleHandle() const {
+    return NativeRenderBundleHandle::fromBackend(_bundle);
+}
+
+} // namespace pers
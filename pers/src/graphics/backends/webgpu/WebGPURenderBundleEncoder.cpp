@@ -0,0 +1,232 @@
+#include "pers/graphics/backends/webgpu/WebGPURenderBundleEncoder.h"
+#include "pers/graphics/backends/webgpu/WebGPURenderBundle.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/buffers/IBuffer.h"
+#include "pers/utils/Logger.h"
+#include <webgpu/wgpu.h>  // For push constants
+
+namespace pers {
+
+WebGPURenderBundleEncoder::WebGPURenderBundleEncoder(WGPURenderBundleEncoder encoder, const std::string& label)
+    : _encoder(encoder)
+    , _label(label) {
+    if (!_encoder) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Created with null encoder handle");
+    }
+}
+
+WebGPURenderBundleEncoder::~WebGPURenderBundleEncoder() {
+    if (_encoder) {
+        wgpuRenderBundleEncoderRelease(_encoder);
+        _encoder = nullptr;
+    }
+}
+
+bool WebGPURenderBundleEncoder::canRecord(const char* operation) const {
+    if (!_encoder) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderBundleEncoder", PERS_SOURCE_LOC,
+            "Cannot %s with null encoder", operation);
+        return false;
+    }
+    
+    if (_finished) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderBundleEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on finished bundle encoder", operation);
+        return false;
+    }
+    return true;
+}
+
+void WebGPURenderBundleEncoder::setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
+    if (!canRecord("set pipeline")) {
+        return;
+    }
+    
+    // A bundle replays what it recorded, a fallback would be baked in for good
+    NativePipelineHandle nativePipeline = pipeline ? pipeline->getNativePipelineHandle() : nullptr;
+    if (!nativePipeline) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Pipeline is null or not compiled yet");
+        _failed = true;
+        return;
+    }
+    
+    wgpuRenderBundleEncoderSetPipeline(_encoder, nativePipeline.as<WGPURenderPipeline>());
+}
+
+void WebGPURenderBundleEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                             std::span<const uint32_t> dynamicOffsets) {
+    if (!canRecord("set bind group")) {
+        return;
+    }
+    
+    if (!bindGroup) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Cannot set null bind group");
+        _failed = true;
+        return;
+    }
+    
+    wgpuRenderBundleEncoderSetBindGroup(_encoder, index,
+                                        bindGroup->getNativeBindGroupHandle().as<WGPUBindGroup>(),
+                                        dynamicOffsets.size(), dynamicOffsets.data());
+}
+
+void WebGPURenderBundleEncoder::setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer,
+                                                uint64_t offset, uint64_t size) {
+    if (!canRecord("set vertex buffer")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = buffer ? buffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Invalid buffer - native handle is null");
+        _failed = true;
+        return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : buffer->getSize() - offset;
+    wgpuRenderBundleEncoderSetVertexBuffer(_encoder, slot, nativeHandle.as<WGPUBuffer>(),
+                                           buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void WebGPURenderBundleEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buffer,
+                                               IndexFormat indexFormat,
+                                               uint64_t offset, uint64_t size) {
+    if (!canRecord("set index buffer")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = buffer ? buffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Invalid buffer - native handle is null");
+        _failed = true;
+        return;
+    }
+    
+    WGPUIndexFormat wgpuFormat = WGPUIndexFormat_Undefined;
+    switch (indexFormat) {
+        case IndexFormat::Uint16:
+            wgpuFormat = WGPUIndexFormat_Uint16;
+            break;
+        case IndexFormat::Uint32:
+            wgpuFormat = WGPUIndexFormat_Uint32;
+            break;
+        default:
+            LOG_ERROR("WebGPURenderBundleEncoder", "Invalid index format");
+            _failed = true;
+            return;
+    }
+    
+    uint64_t bufferSize = size != 0 ? size : buffer->getSize() - offset;
+    wgpuRenderBundleEncoderSetIndexBuffer(_encoder, nativeHandle.as<WGPUBuffer>(), wgpuFormat,
+                                          buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void WebGPURenderBundleEncoder::setPushConstants(ShaderStage stages, uint32_t offset,
+                                                 std::span<const std::byte> data) {
+    if (!canRecord("set push constants")) {
+        return;
+    }
+    
+    if (data.empty() || offset % 4 != 0 || data.size() % 4 != 0) {
+        LOG_ERROR("WebGPURenderBundleEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+        _failed = true;
+        return;
+    }
+    
+    wgpuRenderBundleEncoderSetPushConstants(_encoder, WebGPUConverters::convertShaderStage(stages), offset,
+                                            static_cast<uint32_t>(data.size()), data.data());
+}
+
+void WebGPURenderBundleEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
+                                     uint32_t firstVertex, uint32_t firstInstance) {
+    if (!canRecord("draw")) {
+        return;
+    }
+    
+    wgpuRenderBundleEncoderDraw(_encoder, vertexCount, instanceCount, firstVertex, firstInstance);
+    ++_drawCount;
+}
+
+void WebGPURenderBundleEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount,
+                                            uint32_t firstIndex, int32_t baseVertex,
+                                            uint32_t firstInstance) {
+    if (!canRecord("draw indexed")) {
+        return;
+    }
+    
+    wgpuRenderBundleEncoderDrawIndexed(_encoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
+    ++_drawCount;
+}
+
+void WebGPURenderBundleEncoder::drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!canRecord("draw indirect")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Invalid indirect buffer - native handle is null");
+        _failed = true;
+        return;
+    }
+    
+    wgpuRenderBundleEncoderDrawIndirect(_encoder, nativeHandle.as<WGPUBuffer>(),
+                                        indirectBuffer->getNativeOffset() + indirectOffset);
+    ++_drawCount;
+}
+
+void WebGPURenderBundleEncoder::drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    if (!canRecord("draw indexed indirect")) {
+        return;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (!nativeHandle.isValid()) {
+        LOG_ERROR("WebGPURenderBundleEncoder",
+            "Invalid indirect buffer - native handle is null");
+        _failed = true;
+        return;
+    }
+    
+    wgpuRenderBundleEncoderDrawIndexedIndirect(_encoder, nativeHandle.as<WGPUBuffer>(),
+                                               indirectBuffer->getNativeOffset() + indirectOffset);
+    ++_drawCount;
+}
+
+std::shared_ptr<IRenderBundle> WebGPURenderBundleEncoder::finish() {
+    if (!canRecord("finish")) {
+        return nullptr;
+    }
+    _finished = true;
+    
+    WGPURenderBundleDescriptor bundleDesc = {};
+    bundleDesc.label = WGPUStringView{_label.data(), _label.length()};
+    WGPURenderBundle bundle = wgpuRenderBundleEncoderFinish(_encoder, &bundleDesc);
+    
+    if (_failed) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderBundleEncoder", PERS_SOURCE_LOC,
+            "Discarding bundle %s, some commands failed to record", _label.c_str());
+        if (bundle) {
+            wgpuRenderBundleRelease(bundle);
+        }
+        return nullptr;
+    }
+    
+    if (!bundle) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderBundleEncoder", PERS_SOURCE_LOC,
+            "Failed to finish render bundle %s", _label.c_str());
+        return nullptr;
+    }
+    
+    return std::make_shared<WebGPURenderBundle>(bundle, _drawCount);
+}
+
+} // namespace pers
@@ -1,13 +1,26 @@
 #include "pers/graphics/buffers/IBuffer.h"
 #include "pers/graphics/backends/webgpu/WebGPURenderPassEncoder.h"
-#include "pers/graphics/backends/webgpu/WebGPURenderPipeline.h"
-#include "pers/graphics/backends/webgpu/buffers/WebGPUBuffer.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IRenderBundle.h"
+#include "pers/graphics/IQuerySet.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Validation.h"
+#include <webgpu/wgpu.h>  // For multi-draw-indirect(-count) and push constants
+#include <algorithm>
 
 namespace pers {
 
-WebGPURenderPassEncoder::WebGPURenderPassEncoder(WGPURenderPassEncoder encoder)
-    : _encoder(encoder) {
+WebGPURenderPassEncoder::WebGPURenderPassEncoder(WGPURenderPassEncoder encoder,
+                                                 const RenderResourceTable* resourceTable,
+                                                 bool multiDrawIndirect,
+                                                 bool multiDrawIndirectCount)
+    : _encoder(encoder)
+    , _resourceTable(resourceTable)
+    , _multiDrawIndirect(multiDrawIndirect)
+    , _multiDrawIndirectCount(multiDrawIndirectCount) {
     if (!_encoder) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Created with null encoder handle");
@@ -27,56 +40,67 @@ WebGPURenderPassEncoder::~WebGPURenderPassEncoder() {
 }
 
 void WebGPURenderPassEncoder::setPipeline(const std::shared_ptr<IRenderPipeline>& pipeline) {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set pipeline with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set pipeline on ended render pass");
         return;
     }
     
-    // Cast to WebGPU implementation
-    auto webgpuPipeline = std::dynamic_pointer_cast<WebGPURenderPipeline>(pipeline);
-    if (!webgpuPipeline) {
+    if (PERS_CHECK_FAILED(!pipeline)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
-                              "Invalid pipeline type - not a WebGPURenderPipeline");
+                              "Cannot set null pipeline");
+        return;
+    }
+    
+    // Async handles report their compiled pipeline, or the fallback until it is ready
+    NativePipelineHandle nativePipeline = pipeline->getNativePipelineHandle();
+    if (!nativePipeline) {
+        LOG_DEBUG("WebGPURenderPassEncoder", 
+                              "Pipeline has nothing to bind yet, skipping");
         return;
     }
     
-    // Set the pipeline
-    wgpuRenderPassEncoderSetPipeline(_encoder, webgpuPipeline->getNativeHandle());
+    bindPipeline(nativePipeline.as<WGPURenderPipeline>());
 }
 
-void WebGPURenderPassEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup) {
-    if (!_encoder) {
+void WebGPURenderPassEncoder::setBindGroup(uint32_t index, const std::shared_ptr<IBindGroup>& bindGroup,
+                                           std::span<const uint32_t> dynamicOffsets) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set bind group with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set bind group on ended render pass");
         return;
     }
     
-    TODO_OR_DIE("WebGPURenderPassEncoder::setBindGroup", 
-                   "Cast bindGroup to WebGPUBindGroup and call wgpuRenderPassEncoderSetBindGroup");
+    if (PERS_CHECK_FAILED(!bindGroup)) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Cannot set null bind group");
+        return;
+    }
+    
+    bindBindGroup(index, bindGroup->getNativeBindGroupHandle().as<WGPUBindGroup>(), dynamicOffsets);
 }
 
 void WebGPURenderPassEncoder::setVertexBuffer(uint32_t slot, const std::shared_ptr<IBuffer>& buffer, 
                                              uint64_t offset, uint64_t size) {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set vertex buffer with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set vertex buffer on ended render pass");
         return;
@@ -84,7 +108,7 @@ void WebGPURenderPassEncoder::setVertexBuffer(uint32_t slot, const std::shared_p
     
     // Get the native handle directly from the buffer
     NativeBufferHandle nativeHandle = buffer->getNativeHandle();
-    if (!nativeHandle.isValid()) {
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Invalid buffer - native handle is null");
         return;
@@ -96,21 +120,19 @@ void WebGPURenderPassEncoder::setVertexBuffer(uint32_t slot, const std::shared_p
         bufferSize = buffer->getSize() - offset;
     }
     
-    // Set the vertex buffer
-    WGPUBuffer wgpuBuffer = nativeHandle.as<WGPUBuffer>();
-    wgpuRenderPassEncoderSetVertexBuffer(_encoder, slot, wgpuBuffer, offset, bufferSize);
+    bindVertexBuffer(slot, nativeHandle.as<WGPUBuffer>(), buffer->getNativeOffset() + offset, bufferSize);
 }
 
 void WebGPURenderPassEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buffer, 
                                             IndexFormat indexFormat,
                                             uint64_t offset, uint64_t size) {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set index buffer with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot set index buffer on ended render pass");
         return;
@@ -118,7 +140,7 @@ void WebGPURenderPassEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buf
       
     // Get the native handle directly from the buffer
     NativeBufferHandle nativeHandle = buffer->getNativeHandle();
-    if (!nativeHandle.isValid()) {
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Invalid buffer - native handle is null");
         return;
@@ -130,39 +152,161 @@ void WebGPURenderPassEncoder::setIndexBuffer(const std::shared_ptr<IBuffer>& buf
         bufferSize = buffer->getSize() - offset;
     }
     
-    // Convert index format to WebGPU format
-    WGPUIndexFormat wgpuFormat = WGPUIndexFormat_Undefined;
-    switch (indexFormat) {
-        case IndexFormat::Uint16:
-            wgpuFormat = WGPUIndexFormat_Uint16;
-            break;
-        case IndexFormat::Uint32:
-            wgpuFormat = WGPUIndexFormat_Uint32;
-            break;
-        default:
-            LOG_ERROR("WebGPURenderPassEncoder", "Invalid index format");
-            return;
+    WGPUIndexFormat wgpuFormat = WebGPUConverters::convertIndexFormat(indexFormat);
+    if (PERS_CHECK_FAILED(wgpuFormat == WGPUIndexFormat_Undefined)) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Invalid index format");
+        return;
+    }
+    
+    bindIndexBuffer(nativeHandle.as<WGPUBuffer>(), wgpuFormat, buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void WebGPURenderPassEncoder::setPipeline(PipelineHandle pipeline) {
+    if (!canEncode("set pipeline")) {
+        return;
+    }
+    
+    NativePipelineHandle nativePipeline = _resourceTable->resolve(pipeline);
+    if (!nativePipeline) {
+        // Stale handle, or an async pipeline with nothing to bind yet
+        LOG_DEBUG("WebGPURenderPassEncoder", 
+                              "Pipeline handle did not resolve, skipping");
+        return;
+    }
+    
+    bindPipeline(nativePipeline.as<WGPURenderPipeline>());
+}
+
+void WebGPURenderPassEncoder::setBindGroup(uint32_t index, BindGroupHandle bindGroup,
+                                           std::span<const uint32_t> dynamicOffsets) {
+    if (!canEncode("set bind group")) {
+        return;
     }
     
-    // Set the index buffer
-    WGPUBuffer wgpuBuffer = nativeHandle.as<WGPUBuffer>();
-    wgpuRenderPassEncoderSetIndexBuffer(_encoder, wgpuBuffer, wgpuFormat, offset, bufferSize);
+    NativeBindGroupHandle nativeBindGroup = _resourceTable->resolve(bindGroup);
+    if (!nativeBindGroup) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Bind group handle is null or stale");
+        return;
+    }
+    
+    bindBindGroup(index, nativeBindGroup.as<WGPUBindGroup>(), dynamicOffsets);
+}
+
+void WebGPURenderPassEncoder::setVertexBuffer(uint32_t slot, BufferHandle buffer,
+                                             uint64_t offset, uint64_t size) {
+    if (!canEncode("set vertex buffer")) {
+        return;
+    }
+    
+    const RenderResourceTable::BufferEntry* entry = _resourceTable->resolve(buffer);
+    if (!entry) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Vertex buffer handle is null or stale");
+        return;
+    }
+    
+    // Resolved per call, DynamicBuffer switches native buffers every frame
+    WGPUBuffer wgpuBuffer = entry->buffer->getNativeHandle().as<WGPUBuffer>();
+    uint64_t bufferSize = size != 0 ? size : entry->size - offset;
+    bindVertexBuffer(slot, wgpuBuffer, entry->buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void WebGPURenderPassEncoder::setIndexBuffer(BufferHandle buffer, IndexFormat indexFormat,
+                                            uint64_t offset, uint64_t size) {
+    if (!canEncode("set index buffer")) {
+        return;
+    }
+    
+    const RenderResourceTable::BufferEntry* entry = _resourceTable->resolve(buffer);
+    if (!entry) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Index buffer handle is null or stale");
+        return;
+    }
+    
+    WGPUIndexFormat wgpuFormat = WebGPUConverters::convertIndexFormat(indexFormat);
+    if (PERS_CHECK_FAILED(wgpuFormat == WGPUIndexFormat_Undefined)) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Invalid index format");
+        return;
+    }
+    
+    WGPUBuffer wgpuBuffer = entry->buffer->getNativeHandle().as<WGPUBuffer>();
+    uint64_t bufferSize = size != 0 ? size : entry->size - offset;
+    bindIndexBuffer(wgpuBuffer, wgpuFormat, entry->buffer->getNativeOffset() + offset, bufferSize);
+}
+
+void WebGPURenderPassEncoder::setViewport(float x, float y, float width, float height,
+                                          float minDepth, float maxDepth) {
+    if (!canEncode("set viewport")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(width < 0.0f || height < 0.0f || minDepth < 0.0f || maxDepth > 1.0f ||
+                          minDepth > maxDepth)) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Viewport size must be non-negative and 0 <= minDepth <= maxDepth <= 1");
+        return;
+    }
+    
+    wgpuRenderPassEncoderSetViewport(_encoder, x, y, width, height, minDepth, maxDepth);
+}
+
+void WebGPURenderPassEncoder::setScissorRect(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if (!canEncode("set scissor rect")) {
+        return;
+    }
+    
+    wgpuRenderPassEncoderSetScissorRect(_encoder, x, y, width, height);
+}
+
+void WebGPURenderPassEncoder::setStencilReference(uint32_t reference) {
+    if (!canEncode("set stencil reference")) {
+        return;
+    }
+    
+    wgpuRenderPassEncoderSetStencilReference(_encoder, reference);
+}
+
+void WebGPURenderPassEncoder::setBlendConstant(const Color& color) {
+    if (!canEncode("set blend constant")) {
+        return;
+    }
+    
+    const WGPUColor wgpuColor = {color.r, color.g, color.b, color.a};
+    wgpuRenderPassEncoderSetBlendConstant(_encoder, &wgpuColor);
+}
+
+void WebGPURenderPassEncoder::setPushConstants(ShaderStage stages, uint32_t offset, std::span<const std::byte> data) {
+    if (!canRecord("set push constants")) {
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(data.empty() || offset % 4 != 0 || data.size() % 4 != 0)) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Push constant offset and size must be multiples of 4, size non-zero");
+        return;
+    }
+    
+    wgpuRenderPassEncoderSetPushConstants(_encoder, WebGPUConverters::convertShaderStage(stages), offset,
+                                          static_cast<uint32_t>(data.size()), data.data());
+    ++_stats.pushConstantSets;
 }
 
 void WebGPURenderPassEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
                                   uint32_t firstVertex, uint32_t firstInstance) {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot draw with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot draw on ended render pass");
         return;
     }
     
+    ++_stats.draws;
+    
     // Call WebGPU draw
     wgpuRenderPassEncoderDraw(_encoder, vertexCount, instanceCount, firstVertex, firstInstance);
 }
@@ -170,24 +314,201 @@ void WebGPURenderPassEncoder::draw(uint32_t vertexCount, uint32_t instanceCount,
 void WebGPURenderPassEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount,
                                          uint32_t firstIndex, int32_t baseVertex,
                                          uint32_t firstInstance) {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot draw indexed with null encoder");
         return;
     }
     
-    if (_ended) {
+    if (PERS_CHECK_FAILED(_ended)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot draw indexed on ended render pass");
         return;
     }
     
+    ++_stats.draws;
+    
     // Call WebGPU draw indexed
     wgpuRenderPassEncoderDrawIndexed(_encoder, indexCount, instanceCount, firstIndex, baseVertex, firstInstance);
 }
 
+bool WebGPURenderPassEncoder::resolveIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset,
+                                              uint64_t recordSize, uint32_t drawCount,
+                                              WGPUBuffer& buffer, uint64_t& offset) const {
+    if (PERS_CHECK_FAILED(!_encoder)) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Cannot draw indirect with null encoder");
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(_ended)) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Cannot draw indirect on ended render pass");
+        return false;
+    }
+    
+    NativeBufferHandle nativeHandle = indirectBuffer ? indirectBuffer->getNativeHandle() : nullptr;
+    if (PERS_CHECK_FAILED(!nativeHandle.isValid())) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Invalid indirect buffer - native handle is null");
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(indirectOffset % 4 != 0 ||
+                          indirectOffset + recordSize * drawCount > indirectBuffer->getSize())) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderPassEncoder", PERS_SOURCE_LOC,
+            "Indirect range offset %llu, %u records exceeds buffer %s or is misaligned",
+            static_cast<unsigned long long>(indirectOffset), drawCount, indirectBuffer->getDebugName().c_str());
+        return false;
+    }
+    
+    buffer = nativeHandle.as<WGPUBuffer>();
+    offset = indirectBuffer->getNativeOffset() + indirectOffset;
+    return true;
+}
+
+void WebGPURenderPassEncoder::drawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    if (!resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), 1, buffer, offset)) {
+        return;
+    }
+    
+    ++_stats.indirectDraws;
+    wgpuRenderPassEncoderDrawIndirect(_encoder, buffer, offset);
+}
+
+void WebGPURenderPassEncoder::drawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer, uint64_t indirectOffset) {
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    if (!resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), 1, buffer, offset)) {
+        return;
+    }
+    
+    ++_stats.indirectDraws;
+    wgpuRenderPassEncoderDrawIndexedIndirect(_encoder, buffer, offset);
+}
+
+void WebGPURenderPassEncoder::multiDrawIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                uint64_t indirectOffset, uint32_t drawCount) {
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    if (drawCount == 0 ||
+        !resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), drawCount, buffer, offset)) {
+        return;
+    }
+    
+    _stats.indirectDraws += drawCount;
+    if (_multiDrawIndirect) {
+        wgpuRenderPassEncoderMultiDrawIndirect(_encoder, buffer, offset, drawCount);
+        return;
+    }
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        wgpuRenderPassEncoderDrawIndirect(_encoder, buffer, offset + i * sizeof(DrawIndirectArgs));
+    }
+}
+
+void WebGPURenderPassEncoder::multiDrawIndexedIndirect(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                       uint64_t indirectOffset, uint32_t drawCount) {
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    if (drawCount == 0 ||
+        !resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), drawCount, buffer, offset)) {
+        return;
+    }
+    
+    _stats.indirectDraws += drawCount;
+    if (_multiDrawIndirect) {
+        wgpuRenderPassEncoderMultiDrawIndexedIndirect(_encoder, buffer, offset, drawCount);
+        return;
+    }
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        wgpuRenderPassEncoderDrawIndexedIndirect(_encoder, buffer, offset + i * sizeof(DrawIndexedIndirectArgs));
+    }
+}
+
+void WebGPURenderPassEncoder::multiDrawIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                     uint64_t indirectOffset,
+                                                     const std::shared_ptr<IBuffer>& countBuffer,
+                                                     uint64_t countOffset, uint32_t maxDrawCount) {
+    if (!_multiDrawIndirectCount) {
+        multiDrawIndirect(indirectBuffer, indirectOffset, maxDrawCount);
+        return;
+    }
+    
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    WGPUBuffer count = nullptr;
+    uint64_t countNativeOffset = 0;
+    if (maxDrawCount == 0 ||
+        !resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndirectArgs), maxDrawCount, buffer, offset) ||
+        !resolveIndirect(countBuffer, countOffset, sizeof(uint32_t), 1, count, countNativeOffset)) {
+        return;
+    }
+    
+    // Upper bound, the GPU may draw fewer
+    _stats.indirectDraws += maxDrawCount;
+    wgpuRenderPassEncoderMultiDrawIndirectCount(_encoder, buffer, offset, count, countNativeOffset, maxDrawCount);
+}
+
+void WebGPURenderPassEncoder::multiDrawIndexedIndirectCount(const std::shared_ptr<IBuffer>& indirectBuffer,
+                                                            uint64_t indirectOffset,
+                                                            const std::shared_ptr<IBuffer>& countBuffer,
+                                                            uint64_t countOffset, uint32_t maxDrawCount) {
+    if (!_multiDrawIndirectCount) {
+        multiDrawIndexedIndirect(indirectBuffer, indirectOffset, maxDrawCount);
+        return;
+    }
+    
+    WGPUBuffer buffer = nullptr;
+    uint64_t offset = 0;
+    WGPUBuffer count = nullptr;
+    uint64_t countNativeOffset = 0;
+    if (maxDrawCount == 0 ||
+        !resolveIndirect(indirectBuffer, indirectOffset, sizeof(DrawIndexedIndirectArgs), maxDrawCount, buffer, offset) ||
+        !resolveIndirect(countBuffer, countOffset, sizeof(uint32_t), 1, count, countNativeOffset)) {
+        return;
+    }
+    
+    _stats.indirectDraws += maxDrawCount;
+    wgpuRenderPassEncoderMultiDrawIndexedIndirectCount(_encoder, buffer, offset, count, countNativeOffset,
+                                                       maxDrawCount);
+}
+
+void WebGPURenderPassEncoder::executeBundles(std::span<const std::shared_ptr<IRenderBundle>> bundles) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Cannot execute bundles with null encoder");
+        return;
+    }
+    
+    if (PERS_CHECK_FAILED(_ended)) {
+        LOG_ERROR("WebGPURenderPassEncoder", 
+                              "Cannot execute bundles on ended render pass");
+        return;
+    }
+    
+    std::vector<WGPURenderBundle> nativeBundles;
+    nativeBundles.reserve(bundles.size());
+    for (const auto& bundle : bundles) {
+        if (PERS_CHECK_FAILED(!bundle)) {
+            LOG_ERROR("WebGPURenderPassEncoder", 
+                                  "Skipping null render bundle");
+            continue;
+        }
+        nativeBundles.push_back(bundle->getNativeRenderBundleHandle().as<WGPURenderBundle>());
+        _stats.bundleDraws += bundle->getDrawCount();
+    }
+    
+    wgpuRenderPassEncoderExecuteBundles(_encoder, nativeBundles.size(), nativeBundles.data());
+    _stats.bundlesExecuted += static_cast<uint32_t>(nativeBundles.size());
+    
+    // Executing bundles clears the pass state, the next setters must reach wgpu
+    resetBoundState();
+}
+
 void WebGPURenderPassEncoder::end() {
-    if (!_encoder) {
+    if (PERS_CHECK_FAILED(!_encoder)) {
         LOG_ERROR("WebGPURenderPassEncoder", 
                               "Cannot end null encoder");
         return;
@@ -199,8 +520,189 @@ void WebGPURenderPassEncoder::end() {
         return;
     }
     
+    if (_occlusionQueryOpen || _statisticsQueryOpen) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Render pass ended with a query still open");
+    }
+    
     wgpuRenderPassEncoderEnd(_encoder);
     _ended = true;
+    
+    // Published once per pass rather than per draw
+    static MetricCounter& renderPasses = Metrics::counter("pers_render_passes_total", "Render passes recorded");
+    static MetricCounter& drawCalls = Metrics::counter("pers_draw_calls_total",
+                                                       "Draws recorded, including indirect and bundle draws");
+    static MetricCounter& pipelineBinds = Metrics::counter("pers_pipeline_binds_total",
+                                                           "Render pipelines bound after redundant-set elision");
+    renderPasses.increment();
+    drawCalls.add(static_cast<int64_t>(_stats.draws) + _stats.indirectDraws + _stats.bundleDraws);
+    pipelineBinds.add(static_cast<int64_t>(_stats.pipelineSets) - _stats.pipelinesElided);
+    
+    Logger::Instance().LogFormat(LogLevel::Debug, "WebGPURenderPassEncoder", PERS_SOURCE_LOC,
+        "Pass ended: %u draws (+%u indirect, +%u in %u bundles), elided %u/%u pipeline, %u/%u bind group, %u/%u vertex buffer, %u/%u index buffer sets",
+        _stats.draws, _stats.indirectDraws, _stats.bundleDraws, _stats.bundlesExecuted,
+        _stats.pipelinesElided, _stats.pipelineSets,
+        _stats.bindGroupsElided, _stats.bindGroupSets,
+        _stats.vertexBuffersElided, _stats.vertexBufferSets,
+        _stats.indexBuffersElided, _stats.indexBufferSets);
+}
+
+void WebGPURenderPassEncoder::beginOcclusionQuery(uint32_t queryIndex) {
+    if (!canRecord("begin occlusion query")) {
+        return;
+    }
+    
+    if (_occlusionQueryOpen) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Occlusion queries cannot nest");
+        return;
+    }
+    
+    wgpuRenderPassEncoderBeginOcclusionQuery(_encoder, queryIndex);
+    _occlusionQueryOpen = true;
+}
+
+void WebGPURenderPassEncoder::endOcclusionQuery() {
+    if (!canRecord("end occlusion query")) {
+        return;
+    }
+    
+    if (!_occlusionQueryOpen) {
+        LOG_ERROR("WebGPURenderPassEncoder", "No occlusion query to end");
+        return;
+    }
+    
+    wgpuRenderPassEncoderEndOcclusionQuery(_encoder);
+    _occlusionQueryOpen = false;
+}
+
+void WebGPURenderPassEncoder::beginPipelineStatisticsQuery(const std::shared_ptr<IQuerySet>& querySet,
+                                                           uint32_t queryIndex) {
+    if (!canRecord("begin pipeline statistics query")) {
+        return;
+    }
+    
+    if (!querySet || querySet->getType() != QueryType::PipelineStatistics) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Query set is null or not a pipeline statistics query set");
+        return;
+    }
+    
+    if (_statisticsQueryOpen) {
+        LOG_ERROR("WebGPURenderPassEncoder", "Pipeline statistics queries cannot nest");
+        return;
+    }
+    
+    wgpuRenderPassEncoderBeginPipelineStatisticsQuery(
+        _encoder, querySet->getNativeQuerySetHandle().as<WGPUQuerySet>(), queryIndex);
+    _statisticsQueryOpen = true;
+}
+
+void WebGPURenderPassEncoder::endPipelineStatisticsQuery() {
+    if (!canRecord("end pipeline statistics query")) {
+        return;
+    }
+    
+    if (!_statisticsQueryOpen) {
+        LOG_ERROR("WebGPURenderPassEncoder", "No pipeline statistics query to end");
+        return;
+    }
+    
+    wgpuRenderPassEncoderEndPipelineStatisticsQuery(_encoder);
+    _statisticsQueryOpen = false;
+}
+
+bool WebGPURenderPassEncoder::canRecord(const char* operation) const {
+    if (PERS_CHECK_FAILED(!_encoder)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderPassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s with null encoder", operation);
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(_ended)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderPassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s on ended render pass", operation);
+        return false;
+    }
+    return true;
+}
+
+bool WebGPURenderPassEncoder::canEncode(const char* operation) const {
+    if (!canRecord(operation)) {
+        return false;
+    }
+    
+    if (PERS_CHECK_FAILED(!_resourceTable)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPURenderPassEncoder", PERS_SOURCE_LOC,
+            "Cannot %s by handle, RenderPassDesc::resourceTable was not set", operation);
+        return false;
+    }
+    return true;
+}
+
+void WebGPURenderPassEncoder::resetBoundState() {
+    _boundPipeline = nullptr;
+    _boundVertexBuffers = {};
+    _boundIndexBuffer = {};
+    _boundIndexFormat = WGPUIndexFormat_Undefined;
+    for (auto& bound : _boundBindGroups) {
+        bound.bindGroup = nullptr;
+        bound.dynamicOffsets.clear();
+    }
+}
+
+void WebGPURenderPassEncoder::bindPipeline(WGPURenderPipeline pipeline) {
+    ++_stats.pipelineSets;
+    if (pipeline == _boundPipeline) {
+        ++_stats.pipelinesElided;
+        return;
+    }
+    
+    wgpuRenderPassEncoderSetPipeline(_encoder, pipeline);
+    _boundPipeline = pipeline;
+}
+
+void WebGPURenderPassEncoder::bindBindGroup(uint32_t index, WGPUBindGroup bindGroup,
+                                            std::span<const uint32_t> dynamicOffsets) {
+    ++_stats.bindGroupSets;
+    if (index < MAX_TRACKED_BIND_GROUPS) {
+        auto& bound = _boundBindGroups[index];
+        if (bound.bindGroup == bindGroup &&
+            std::equal(bound.dynamicOffsets.begin(), bound.dynamicOffsets.end(),
+                       dynamicOffsets.begin(), dynamicOffsets.end())) {
+            ++_stats.bindGroupsElided;
+            return;
+        }
+        bound.bindGroup = bindGroup;
+        bound.dynamicOffsets.assign(dynamicOffsets.begin(), dynamicOffsets.end());
+    }
+    
+    wgpuRenderPassEncoderSetBindGroup(_encoder, index, bindGroup,
+                                      dynamicOffsets.size(), dynamicOffsets.data());
+}
+
+void WebGPURenderPassEncoder::bindVertexBuffer(uint32_t slot, WGPUBuffer buffer, uint64_t offset, uint64_t size) {
+    ++_stats.vertexBufferSets;
+    BufferBinding binding{buffer, offset, size};
+    if (slot < MAX_TRACKED_VERTEX_BUFFERS) {
+        if (_boundVertexBuffers[slot] == binding) {
+            ++_stats.vertexBuffersElided;
+            return;
+        }
+        _boundVertexBuffers[slot] = binding;
+    }
+    
+    wgpuRenderPassEncoderSetVertexBuffer(_encoder, slot, buffer, offset, size);
+}
+
+void WebGPURenderPassEncoder::bindIndexBuffer(WGPUBuffer buffer, WGPUIndexFormat format, uint64_t offset, uint64_t size) {
+    ++_stats.indexBufferSets;
+    BufferBinding binding{buffer, offset, size};
+    if (binding == _boundIndexBuffer && format == _boundIndexFormat) {
+        ++_stats.indexBuffersElided;
+        return;
+    }
+    _boundIndexBuffer = binding;
+    _boundIndexFormat = format;
+    
+    wgpuRenderPassEncoderSetIndexBuffer(_encoder, buffer, format, offset, size);
 }
 
 NativeRenderPassEncoderHandle WebGPURenderPassEncoder::getNativeRenderPassEncoderHandle() const {
@@ -3,12 +3,26 @@
 #include "pers/graphics/backends/webgpu/WebGPUTexture.h"
 #include "pers/graphics/backends/webgpu/buffers/WebGPUMappableBuffer.h"
 #include "pers/graphics/backends/webgpu/WebGPUTextureView.h"
+#include "pers/graphics/backends/webgpu/WebGPUSampler.h"
+#include "pers/graphics/backends/webgpu/WebGPUQuerySet.h"
 #include "pers/graphics/backends/webgpu/WebGPUShaderModule.h"
 #include "pers/graphics/backends/webgpu/WebGPURenderPipeline.h"
+#include "pers/graphics/backends/webgpu/WebGPUComputePipeline.h"
 #include "pers/graphics/backends/webgpu/WebGPULogicalDevice.h"
+#include "pers/graphics/backends/webgpu/WebGPUBindGroupLayout.h"
+#include "pers/graphics/backends/webgpu/WebGPUBindGroup.h"
+#include "pers/graphics/backends/webgpu/WebGPUPipelineLayout.h"
+#include "pers/graphics/backends/webgpu/WebGPUPreparedRenderPass.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/ShaderReflection.h"
 #include "pers/graphics/backends/webgpu/WebGPUConverters.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
+#include "pers/utils/PoolAllocator.h"
+#include "pers/utils/Profiler.h"
 #include <webgpu/webgpu.h>
+#include <webgpu/wgpu.h>  // For native query features
 #include <cstring>  // for memcpy
 
 namespace pers {
@@ -26,6 +40,7 @@ WebGPUResourceFactory::~WebGPUResourceFactory() {
 }
 
 std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createBuffer(const BufferDesc& desc) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createBuffer");
     auto device = _logicalDevice.lock();
     if (!device) {
         LOG_ERROR("WebGPUResourceFactory",
@@ -33,6 +48,10 @@ std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createBuffer(const BufferD
         return nullptr;
     }
     
+    return createBuffer(device->getNativeDeviceHandle().as<WGPUDevice>(), desc);
+}
+
+std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createBuffer(WGPUDevice wgpuDevice, const BufferDesc& desc) const {
     // Validate buffer size - WebGPU requires size > 0
     if (desc.size == 0) {
         LOG_WARNING("WebGPUResourceFactory",
@@ -40,10 +59,26 @@ std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createBuffer(const BufferD
         return nullptr;
     }
     
-    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
     return std::make_shared<WebGPUBuffer>(wgpuDevice, desc);
 }
 
+std::vector<std::shared_ptr<INativeBuffer>> WebGPUResourceFactory::createBuffers(std::span<const BufferDesc> descs) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createBuffers");
+    std::vector<std::shared_ptr<INativeBuffer>> buffers(descs.size());
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create buffers without device");
+        return buffers;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    for (size_t i = 0; i < descs.size(); ++i) {
+        buffers[i] = createBuffer(wgpuDevice, descs[i]);
+    }
+    return buffers;
+}
+
 std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(const TextureDesc& desc) const {
     auto device = _logicalDevice.lock();
     if (!device) {
@@ -51,8 +86,26 @@ std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(const TextureDesc
         return nullptr;
     }
     
-    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    return createTexture(device->getNativeDeviceHandle().as<WGPUDevice>(), desc);
+}
+
+std::vector<std::shared_ptr<ITexture>> WebGPUResourceFactory::createTextures(std::span<const TextureDesc> descs) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createTextures");
+    std::vector<std::shared_ptr<ITexture>> textures(descs.size());
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory", "Cannot create textures without device");
+        return textures;
+    }
     
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    for (size_t i = 0; i < descs.size(); ++i) {
+        textures[i] = createTexture(wgpuDevice, descs[i]);
+    }
+    return textures;
+}
+
+std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(WGPUDevice wgpuDevice, const TextureDesc& desc) const {
     // Convert texture descriptor
     WGPUTextureDescriptor textureDesc = {};
     textureDesc.label = WGPUStringView{desc.label.data(), desc.label.length()};
@@ -65,6 +118,10 @@ std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(const TextureDesc
     textureDesc.format = WebGPUConverters::convertTextureFormat(desc.format);
     textureDesc.usage = WebGPUConverters::convertTextureUsage(desc.usage);
     
+    // Accounted first so an over-budget allocation can evict before it lands
+    GpuMemoryAllocation allocation = GpuMemoryTracker::instance().allocate(
+        GpuMemoryTracker::categorize(desc.usage), GpuMemoryTracker::estimateTextureSize(desc), desc.label);
+    
     // Create the texture
     WGPUTexture wgpuTexture = wgpuDeviceCreateTexture(wgpuDevice, &textureDesc);
     if (!wgpuTexture) {
@@ -72,7 +129,7 @@ std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(const TextureDesc
         return nullptr;
     }
     
-    return std::make_shared<WebGPUTexture>(
+    auto texture = std::make_shared<WebGPUTexture>(
         wgpuTexture,
         desc.width,
         desc.height,
@@ -81,6 +138,8 @@ std::shared_ptr<ITexture> WebGPUResourceFactory::createTexture(const TextureDesc
         desc.usage,
         desc.dimension
     );
+    texture->setMemoryAllocation(std::move(allocation));
+    return texture;
 }
 
 std::shared_ptr<ITextureView> WebGPUResourceFactory::createTextureView(
@@ -97,43 +156,56 @@ std::shared_ptr<ITextureView> WebGPUResourceFactory::createTextureView(
         return nullptr;
     }
     
-    WGPUTexture wgpuTexture = webgpuTexture->getWGPUTexture();
-    
-    // Create texture view descriptor
-    WGPUTextureViewDescriptor viewDesc = {};
-    viewDesc.label = WGPUStringView{desc.label.data(), desc.label.length()};
-    viewDesc.format = WebGPUConverters::convertTextureFormat(desc.format);
-    viewDesc.dimension = WebGPUConverters::convertTextureViewDimension(desc.dimension);
-    viewDesc.baseMipLevel = desc.baseMipLevel;
-    viewDesc.mipLevelCount = desc.mipLevelCount;
-    viewDesc.baseArrayLayer = desc.baseArrayLayer;
-    viewDesc.arrayLayerCount = desc.arrayLayerCount;
-    viewDesc.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
-    
-    // Create the texture view
-    WGPUTextureView wgpuView = wgpuTextureCreateView(wgpuTexture, &viewDesc);
-    if (!wgpuView) {
-        LOG_ERROR("WebGPUResourceFactory", "Failed to create texture view: " + desc.label);
-        return nullptr;
-    }
-    
-    // Use the texture's actual dimensions for the view
-    return std::make_shared<WebGPUTextureView>(
-        wgpuView,
-        webgpuTexture->getWidth(),
-        webgpuTexture->getHeight(),
-        webgpuTexture->getFormat(),
-        false  // Not a swap chain texture
-    );
+    // Repeated requests for the same view return the one already created
+    return webgpuTexture->getViewCache().getOrCreate(desc, [&webgpuTexture](const TextureViewDesc& desc)
+        -> std::shared_ptr<ITextureView> {
+        WGPUTexture wgpuTexture = webgpuTexture->getWGPUTexture();
+        
+        // Create texture view descriptor
+        WGPUTextureViewDescriptor viewDesc = {};
+        viewDesc.label = WGPUStringView{desc.label.data(), desc.label.length()};
+        viewDesc.format = WebGPUConverters::convertTextureFormat(desc.format);
+        viewDesc.dimension = WebGPUConverters::convertTextureViewDimension(desc.dimension);
+        viewDesc.baseMipLevel = desc.baseMipLevel;
+        viewDesc.mipLevelCount = desc.mipLevelCount;
+        viewDesc.baseArrayLayer = desc.baseArrayLayer;
+        viewDesc.arrayLayerCount = desc.arrayLayerCount;
+        viewDesc.aspect = WebGPUConverters::convertTextureAspect(desc.aspect);
+        
+        // Create the texture view
+        WGPUTextureView wgpuView = wgpuTextureCreateView(wgpuTexture, &viewDesc);
+        if (!wgpuView) {
+            LOG_ERROR("WebGPUResourceFactory", "Failed to create texture view: " + desc.label);
+            return nullptr;
+        }
+        
+        // Use the texture's actual dimensions for the view
+        return makePooledShared<WebGPUTextureView>(
+            wgpuView,
+            webgpuTexture->getWidth(),
+            webgpuTexture->getHeight(),
+            webgpuTexture->getFormat(),
+            false  // Not a swap chain texture
+        );
+    });
 }
 
 std::shared_ptr<ISampler> WebGPUResourceFactory::createSampler(const SamplerDesc& desc) const {
-    TODO_OR_DIE("WebGPUResourceFactory::createSampler", 
-                   "Implement WebGPUSampler");
-    return nullptr;
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory", "Cannot create sampler without device");
+        return nullptr;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    return _samplerCache.getOrCreate(desc, [wgpuDevice](const SamplerDesc& samplerDesc) {
+        return std::static_pointer_cast<ISampler>(
+            std::make_shared<WebGPUSampler>(samplerDesc, wgpuDevice));
+    });
 }
 
 std::shared_ptr<IShaderModule> WebGPUResourceFactory::createShaderModule(const ShaderModuleDesc& desc) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createShaderModule");
     auto device = _logicalDevice.lock();
     if (!device) {
         LOG_ERROR("WebGPUResourceFactory",
@@ -157,6 +229,7 @@ std::shared_ptr<IShaderModule> WebGPUResourceFactory::createShaderModule(const S
 }
 
 std::shared_ptr<IRenderPipeline> WebGPUResourceFactory::createRenderPipeline(const RenderPipelineDesc& desc) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createRenderPipeline");
     auto device = _logicalDevice.lock();
     if (!device) {
         LOG_ERROR("WebGPUResourceFactory",
@@ -164,14 +237,89 @@ std::shared_ptr<IRenderPipeline> WebGPUResourceFactory::createRenderPipeline(con
         return nullptr;
     }
     
+    RenderPipelineDesc derived;
+    const RenderPipelineDesc& resolved = deriveLayouts(desc, derived) ? derived : desc;
+    
     WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
-    return std::make_shared<WebGPURenderPipeline>(desc, wgpuDevice);
+    return _pipelineCache.getOrCreate(resolved, [wgpuDevice](const RenderPipelineDesc& pipelineDesc) {
+        // Cache miss only
+        PERS_PROFILE_SCOPE("WebGPURenderPipeline::create");
+        return std::static_pointer_cast<IRenderPipeline>(
+            std::make_shared<WebGPURenderPipeline>(pipelineDesc, wgpuDevice));
+    });
+}
+
+std::shared_ptr<IComputePipeline> WebGPUResourceFactory::createComputePipeline(const ComputePipelineDesc& desc) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createComputePipeline");
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create compute pipeline without device");
+        return nullptr;
+    }
+    
+    ComputePipelineDesc derived;
+    const ComputePipelineDesc& resolved = deriveLayouts(desc, derived) ? derived : desc;
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    auto pipeline = std::make_shared<WebGPUComputePipeline>(resolved, wgpuDevice);
+    if (!pipeline->isValid()) {
+        return nullptr;
+    }
+    return pipeline;
+}
+
+std::shared_ptr<AsyncRenderPipeline> WebGPUResourceFactory::createRenderPipelineAsync(
+    const RenderPipelineDesc& requested,
+    const std::shared_ptr<IRenderPipeline>& fallback) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create render pipeline without device");
+        return nullptr;
+    }
+    
+    RenderPipelineDesc derived;
+    const RenderPipelineDesc& desc = deriveLayouts(requested, derived) ? derived : requested;
+    
+    auto handle = std::make_shared<AsyncRenderPipeline>(desc.debugName, fallback);
+    
+    // Identical desc already compiled, hand it out ready
+    if (auto cached = _pipelineCache.lookup(desc)) {
+        handle->resolve(cached);
+        return handle;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    
+    // The callback holds the handle weakly so dropping it before completion is fine
+    std::weak_ptr<AsyncRenderPipeline> weakHandle = handle;
+    PipelineCache* cache = &_pipelineCache;
+    std::weak_ptr<WebGPULogicalDevice> weakDevice = _logicalDevice;
+    RenderPipelineDesc cacheDesc = desc;
+    bool started = WebGPURenderPipeline::createAsync(desc, wgpuDevice, device->getEventPump(),
+        [weakHandle, weakDevice, cache, cacheDesc](std::shared_ptr<WebGPURenderPipeline> pipeline) {
+            std::shared_ptr<IRenderPipeline> result = pipeline;
+            // The factory lives as long as its device, only touch the cache while it does
+            if (auto owner = weakDevice.lock(); owner && result) {
+                result = cache->insert(cacheDesc, result);
+            }
+            if (auto asyncHandle = weakHandle.lock()) {
+                asyncHandle->resolve(result);
+            }
+        });
+    
+    if (!started) {
+        return nullptr;
+    }
+    return handle;
 }
 
 std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createInitializableDeviceBuffer(
     const BufferDesc& desc,
     const void* initialData,
     size_t dataSize) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createInitializableDeviceBuffer");
     
     auto device = _logicalDevice.lock();
     if (!device) {
@@ -209,7 +357,7 @@ std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createInitializableDeviceB
     // Write data synchronously using mapped memory
     void* mappedData = buffer->getMappedDataAtCreation();
     if (mappedData) {
-        memcpy(mappedData, initialData, dataSize);
+        copyToMappedMemory(mappedData, initialData, dataSize);
         buffer->unmapAtCreation();
     } else {
         LOG_ERROR("WebGPUResourceFactory",
@@ -220,7 +368,122 @@ std::shared_ptr<INativeBuffer> WebGPUResourceFactory::createInitializableDeviceB
     return buffer;
 }
 
+std::vector<std::shared_ptr<INativeBuffer>> WebGPUResourceFactory::createInitializableDeviceBuffers(
+    std::span<const BufferInitDesc> buffers) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createInitializableDeviceBuffers");
+    
+    std::vector<std::shared_ptr<INativeBuffer>> created(buffers.size());
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create buffers without device");
+        return created;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    
+    // Lay out one staging buffer; copies need 4 byte aligned offsets and sizes
+    constexpr uint64_t copyAlignment = 4;
+    std::vector<uint64_t> stagingOffsets(buffers.size(), 0);
+    std::vector<uint64_t> copySizes(buffers.size(), 0);
+    uint64_t stagingSize = 0;
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        const BufferInitDesc& buffer = buffers[i];
+        if (!buffer.initialData || buffer.dataSize == 0 || buffer.dataSize > buffer.desc.size) {
+            Logger::Instance().LogFormat(LogLevel::Error, "WebGPUResourceFactory", PERS_SOURCE_LOC,
+                "Invalid initial data or size for %s", buffer.desc.debugName.c_str());
+            continue;
+        }
+        
+        const uint64_t copySize = (buffer.dataSize + copyAlignment - 1) & ~(copyAlignment - 1);
+        if (copySize > buffer.desc.size) {
+            // Padded copy would overrun an unaligned buffer, write it at creation instead
+            created[i] = createInitializableDeviceBuffer(buffer.desc, buffer.initialData, buffer.dataSize);
+            continue;
+        }
+        
+        BufferDesc targetDesc = buffer.desc;
+        targetDesc.usage |= BufferUsage::CopyDst;
+        auto target = createBuffer(wgpuDevice, targetDesc);
+        if (!target || !target->isValid()) {
+            continue;
+        }
+        
+        created[i] = std::move(target);
+        stagingOffsets[i] = stagingSize;
+        copySizes[i] = copySize;
+        stagingSize += copySize;
+    }
+    
+    if (stagingSize == 0) {
+        return created;
+    }
+    
+    // Discards every staged buffer, none of them received its data
+    auto fail = [&](const char* message) {
+        LOG_ERROR("WebGPUResourceFactory", message);
+        for (size_t i = 0; i < created.size(); ++i) {
+            if (copySizes[i] != 0) {
+                created[i].reset();
+            }
+        }
+        return created;
+    };
+    
+    BufferDesc stagingDesc;
+    stagingDesc.size = stagingSize;
+    stagingDesc.usage = BufferUsage::CopySrc;
+    stagingDesc.mappedAtCreation = true;
+    stagingDesc.debugName = "Batch Upload Staging";
+    WebGPUBuffer staging(wgpuDevice, stagingDesc);
+    uint8_t* mappedData = static_cast<uint8_t*>(staging.getMappedDataAtCreation());
+    if (!mappedData) {
+        return fail("Failed to map batch staging buffer");
+    }
+    
+    // Padding stays zero, mappedAtCreation memory starts cleared
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        if (copySizes[i] != 0) {
+            copyToMappedMemory(mappedData + stagingOffsets[i], buffers[i].initialData, buffers[i].dataSize);
+        }
+    }
+    staging.unmapAtCreation();
+    
+    WGPUCommandEncoderDescriptor encoderDesc = {};
+    encoderDesc.label = WGPUStringView{.data = "Batch Upload Encoder", .length = 20};
+    WGPUCommandEncoder encoder = wgpuDeviceCreateCommandEncoder(wgpuDevice, &encoderDesc);
+    if (!encoder) {
+        return fail("Failed to create batch upload encoder");
+    }
+    
+    WGPUBuffer stagingBuffer = staging.getNativeHandle().as<WGPUBuffer>();
+    for (size_t i = 0; i < created.size(); ++i) {
+        if (copySizes[i] != 0) {
+            wgpuCommandEncoderCopyBufferToBuffer(encoder, stagingBuffer, stagingOffsets[i],
+                created[i]->getNativeHandle().as<WGPUBuffer>(), 0, copySizes[i]);
+        }
+    }
+    
+    WGPUCommandBufferDescriptor commandBufferDesc = {};
+    WGPUCommandBuffer commandBuffer = wgpuCommandEncoderFinish(encoder, &commandBufferDesc);
+    wgpuCommandEncoderRelease(encoder);
+    if (!commandBuffer) {
+        return fail("Failed to finish batch upload command buffer");
+    }
+    
+    // wgpu keeps the staging buffer alive until the copies retire
+    WGPUQueue queue = device->getQueue()->getNativeQueueHandle().as<WGPUQueue>();
+    wgpuQueueSubmit(queue, 1, &commandBuffer);
+    wgpuCommandBufferRelease(commandBuffer);
+    
+    Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUResourceFactory", PERS_SOURCE_LOC,
+        "Uploaded %zu buffers through one %llu byte staging buffer",
+        buffers.size(), static_cast<unsigned long long>(stagingSize));
+    return created;
+}
+
 std::shared_ptr<INativeMappableBuffer> WebGPUResourceFactory::createMappableBuffer(const BufferDesc& desc) const {
+    PERS_PROFILE_SCOPE("WebGPUResourceFactory::createMappableBuffer");
 
     auto device = _logicalDevice.lock();
     if (!device) {
@@ -237,7 +500,116 @@ std::shared_ptr<INativeMappableBuffer> WebGPUResourceFactory::createMappableBuff
     }
     
     WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
-    return std::make_shared<WebGPUMappableBuffer>(wgpuDevice, desc);
+    return std::make_shared<WebGPUMappableBuffer>(wgpuDevice, desc, device->getEventPump());
+}
+
+std::shared_ptr<IBindGroupLayout> WebGPUResourceFactory::createBindGroupLayout(const BindGroupLayoutDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create bind group layout without device");
+        return nullptr;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    return _bindGroupCache.getOrCreateLayout(desc, [wgpuDevice](const BindGroupLayoutDesc& layoutDesc) {
+        auto layout = std::make_shared<WebGPUBindGroupLayout>(layoutDesc, wgpuDevice);
+        return layout->isValid() ? std::static_pointer_cast<IBindGroupLayout>(layout) : nullptr;
+    });
+}
+
+std::shared_ptr<IBindGroup> WebGPUResourceFactory::createBindGroup(const BindGroupDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create bind group without device");
+        return nullptr;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    return _bindGroupCache.getOrCreateBindGroup(desc, [wgpuDevice](const BindGroupDesc& groupDesc) {
+        auto bindGroup = std::make_shared<WebGPUBindGroup>(groupDesc, wgpuDevice);
+        return bindGroup->isValid() ? std::static_pointer_cast<IBindGroup>(bindGroup) : nullptr;
+    });
+}
+
+std::shared_ptr<IPipelineLayout> WebGPUResourceFactory::createPipelineLayout(const PipelineLayoutDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory",
+            "Cannot create pipeline layout without device");
+        return nullptr;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    return _bindGroupCache.getOrCreatePipelineLayout(desc, [wgpuDevice](const PipelineLayoutDesc& layoutDesc) {
+        auto layout = std::make_shared<WebGPUPipelineLayout>(layoutDesc, wgpuDevice);
+        return layout->isValid() ? std::static_pointer_cast<IPipelineLayout>(layout) : nullptr;
+    });
+}
+
+bool WebGPUResourceFactory::deriveLayouts(const RenderPipelineDesc& desc, RenderPipelineDesc& derived) const {
+    const bool needsLayout = !desc.layout;
+    const bool needsVertexLayout = desc.vertexLayouts.empty() && desc.vertex;
+    if (!needsLayout && !needsVertexLayout) {
+        return false;
+    }
+    
+    bool changed = false;
+    derived = desc;
+    if (needsLayout) {
+        // Reflected layouts are shared between pipelines; the backend's implicit ones never are
+        derived.layout = ShaderReflection::derivePipelineLayout(*this, {desc.vertex, desc.fragment}, desc.debugName.str());
+        changed = derived.layout != nullptr;
+    }
+    VertexBufferLayout vertexLayout;
+    if (needsVertexLayout && ShaderReflection::deriveVertexLayout(*desc.vertex, vertexLayout)) {
+        derived.vertexLayouts.push_back(std::move(vertexLayout));
+        changed = true;
+    }
+    return changed;
+}
+
+bool WebGPUResourceFactory::deriveLayouts(const ComputePipelineDesc& desc, ComputePipelineDesc& derived) const {
+    if (desc.layout || !desc.compute) {
+        return false;
+    }
+    
+    derived = desc;
+    derived.layout = ShaderReflection::derivePipelineLayout(*this, {desc.compute}, desc.debugName);
+    return derived.layout != nullptr;
+}
+
+std::shared_ptr<IQuerySet> WebGPUResourceFactory::createQuerySet(const QuerySetDesc& desc) const {
+    auto device = _logicalDevice.lock();
+    if (!device) {
+        LOG_ERROR("WebGPUResourceFactory", "Cannot create query set without device");
+        return nullptr;
+    }
+    
+    WGPUDevice wgpuDevice = device->getNativeDeviceHandle().as<WGPUDevice>();
+    if (desc.type == QueryType::Timestamp && !wgpuDeviceHasFeature(wgpuDevice, WGPUFeatureName_TimestampQuery)) {
+        LOG_WARNING("WebGPUResourceFactory",
+            "Timestamp queries need DeviceFeature::TimestampQuery in requiredFeatures");
+        return nullptr;
+    }
+    
+    if (desc.type == QueryType::PipelineStatistics &&
+        !wgpuDeviceHasFeature(wgpuDevice, static_cast<WGPUFeatureName>(WGPUNativeFeature_PipelineStatisticsQuery))) {
+        LOG_WARNING("WebGPUResourceFactory",
+            "Pipeline statistics queries need DeviceFeature::PipelineStatisticsQuery in requiredFeatures");
+        return nullptr;
+    }
+    
+    auto querySet = std::make_shared<WebGPUQuerySet>(desc, wgpuDevice);
+    if (!querySet->isValid()) {
+        return nullptr;
+    }
+    return querySet;
+}
+
+std::shared_ptr<IPreparedRenderPass> WebGPUResourceFactory::createPreparedRenderPass(const RenderPassDesc& desc) const {
+    return std::make_shared<WebGPUPreparedRenderPass>(desc);
 }
 
 } // namespace pers
@@ -0,0 +1,53 @@
+#include "pers/graphics/backends/webgpu/WebGPUSampler.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
+#include "pers/utils/Logger.h"
+
+namespace pers {
+
+WebGPUSampler::WebGPUSampler(const SamplerDesc& desc, WGPUDevice device)
+    : _desc(desc) {
+    if (!device) {
+        LOG_ERROR("WebGPUSampler", "Cannot create sampler without device");
+        return;
+    }
+    
+    WGPUSamplerDescriptor samplerDesc = {};
+    samplerDesc.label = WGPUStringView{_desc.label.data(), _desc.label.length()};
+    samplerDesc.addressModeU = WebGPUConverters::convertAddressMode(desc.addressModeU);
+    samplerDesc.addressModeV = WebGPUConverters::convertAddressMode(desc.addressModeV);
+    samplerDesc.addressModeW = WebGPUConverters::convertAddressMode(desc.addressModeW);
+    samplerDesc.magFilter = WebGPUConverters::convertFilterMode(desc.magFilter);
+    samplerDesc.minFilter = WebGPUConverters::convertFilterMode(desc.minFilter);
+    samplerDesc.mipmapFilter = WebGPUConverters::convertMipmapFilterMode(desc.mipmapFilter);
+    samplerDesc.lodMinClamp = desc.lodMinClamp;
+    samplerDesc.lodMaxClamp = desc.lodMaxClamp;
+    samplerDesc.compare = WebGPUConverters::convertCompareFunction(desc.compare);
+    samplerDesc.maxAnisotropy = desc.maxAnisotropy;
+    
+    // Anisotropy requires linear filtering everywhere
+    if (desc.maxAnisotropy > 1 &&
+        (desc.magFilter != FilterMode::Linear || desc.minFilter != FilterMode::Linear ||
+         desc.mipmapFilter != FilterMode::Linear)) {
+        LOG_WARNING("WebGPUSampler", "Anisotropic sampler needs linear filters, anisotropy disabled");
+        samplerDesc.maxAnisotropy = 1;
+    }
+    
+    _sampler = wgpuDeviceCreateSampler(device, &samplerDesc);
+    if (!_sampler) {
+        Logger::Instance().LogFormat(LogLevel::Error, "WebGPUSampler",
+            PERS_SOURCE_LOC, "Failed to create sampler: %s", _desc.label.c_str());
+    }
+}
+
+WebGPUSampler::~WebGPUSampler() {
+    if (_sampler) {
+        wgpuSamplerRelease(_sampler);
+        _sampler = nullptr;
+    }
+}
+
+NativeSamplerHandle WebGPUSampler::getNativeSamplerHandle() const {
+    return NativeSamplerHandle(_sampler);
+}
+
+} // namespace pers
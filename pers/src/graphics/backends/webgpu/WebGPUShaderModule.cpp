@@ -1,18 +1,35 @@
 #include "pers/graphics/backends/webgpu/WebGPUShaderModule.h"
+#include "pers/graphics/ShaderBinary.h"
 #include "pers/utils/Logger.h"
 #include <webgpu/webgpu.h>
+#include <string_view>
 
 namespace pers {
 
-// Auto-detect shader stage from WGSL code
+// Stage detection for sources reflection could not parse
+// Single pass over '@' attributes; @vertex wins over @fragment over @compute
 static ShaderStage detectShaderStage(const std::string& code) {
-    if (code.find("@vertex") != std::string::npos) {
-        return ShaderStage::Vertex;
+    bool hasFragment = false;
+    bool hasCompute = false;
+    
+    size_t pos = code.find('@');
+    while (pos != std::string::npos) {
+        std::string_view attribute(code.data() + pos + 1, code.size() - pos - 1);
+        if (attribute.substr(0, 6) == "vertex") {
+            return ShaderStage::Vertex;
+        }
+        if (attribute.substr(0, 8) == "fragment") {
+            hasFragment = true;
+        } else if (attribute.substr(0, 7) == "compute") {
+            hasCompute = true;
+        }
+        pos = code.find('@', pos + 1);
     }
-    if (code.find("@fragment") != std::string::npos) {
+    
+    if (hasFragment) {
         return ShaderStage::Fragment;
     }
-    if (code.find("@compute") != std::string::npos) {
+    if (hasCompute) {
         return ShaderStage::Compute;
     }
     return ShaderStage::None;
@@ -23,14 +40,18 @@ WebGPUShaderModule::WebGPUShaderModule(const ShaderModuleDesc& desc)
     , _entryPoint(desc.entryPoint)
     , _debugName(desc.debugName)
     , _code(desc.code)
+    , _spirv(desc.spirv)
+    , _reflection(desc.reflection ? *desc.reflection
+                  : desc.code.empty() ? ShaderReflection() : ShaderReflection::reflect(desc.code))
     , _shaderModule(nullptr) {
     
-    // Auto-detect stage if not specified
+    // Auto-detect stage if not specified, preferring the named entry point
     if (_stage == ShaderStage::None) {
-        _stage = detectShaderStage(_code);
+        _stage = _reflection.isValid() ? _reflection.detectStage(_entryPoint) : detectShaderStage(_code);
         if (_stage == ShaderStage::None) {
             LOG_ERROR("WebGPUShaderModule",
-                "Failed to detect shader stage from code");
+                _code.empty() ? "SPIR-V modules without WGSL or reflection need an explicit stage"
+                              : "Failed to detect shader stage from code");
             return;
         }
     }
@@ -51,6 +72,14 @@ WebGPUShaderModule::WebGPUShaderModule(const ShaderModuleDesc& desc)
                 _debugName = "UnknownShader";
         }
     }
+    
+    if (_code.empty() && !_reflection.isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Debug, "WebGPUShaderModule", PERS_SOURCE_LOC,
+            "%s is SPIR-V without WGSL or reflection, layouts will not be derived from it", _debugName.c_str());
+    } else if (!_reflection.isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "WebGPUShaderModule", PERS_SOURCE_LOC,
+            "Could not reflect %s, layouts will not be derived from it", _debugName.c_str());
+    }
 }
 
 WebGPUShaderModule::~WebGPUShaderModule() {
@@ -75,6 +104,18 @@ bool WebGPUShaderModule::isValid() const {
     return _shaderModule != nullptr;
 }
 
+const std::string& WebGPUShaderModule::getCode() const {
+    return _code;
+}
+
+const std::vector<uint32_t>& WebGPUShaderModule::getSpirv() const {
+    return _spirv;
+}
+
+const ShaderReflection& WebGPUShaderModule::getReflection() const {
+    return _reflection;
+}
+
 WGPUShaderModule WebGPUShaderModule::getNativeHandle() const {
     return _shaderModule;
 }
@@ -84,15 +125,30 @@ void WebGPUShaderModule::createShaderModule(WGPUDevice device) {
         return;
     }
     
-    WGPUShaderSourceWGSL wgslSource = {};
-    wgslSource.chain.next = nullptr;
-    wgslSource.chain.sType = WGPUSType_ShaderSourceWGSL;
-    wgslSource.code = WGPUStringView{_code.data(), _code.length()};
-    
     WGPUShaderModuleDescriptor desc = {};
-    desc.nextInChain = &wgslSource.chain;
     desc.label = WGPUStringView{_debugName.c_str(), _debugName.length()};
     
+    // SPIR-V goes straight to the backend's IR, skipping the WGSL front end
+    WGPUShaderSourceSPIRV spirvSource = {};
+    WGPUShaderSourceWGSL wgslSource = {};
+    if (!_spirv.empty()) {
+        if (!isSpirvBinary(_spirv)) {
+            Logger::Instance().LogFormat(LogLevel::Error, "WebGPUShaderModule",
+                PERS_SOURCE_LOC, "%s does not hold a SPIR-V module", _debugName.c_str());
+            return;
+        }
+        spirvSource.chain.next = nullptr;
+        spirvSource.chain.sType = WGPUSType_ShaderSourceSPIRV;
+        spirvSource.codeSize = static_cast<uint32_t>(_spirv.size());
+        spirvSource.code = _spirv.data();
+        desc.nextInChain = &spirvSource.chain;
+    } else {
+        wgslSource.chain.next = nullptr;
+        wgslSource.chain.sType = WGPUSType_ShaderSourceWGSL;
+        wgslSource.code = WGPUStringView{_code.data(), _code.length()};
+        desc.nextInChain = &wgslSource.chain;
+    }
+    
     _shaderModule = wgpuDeviceCreateShaderModule(device, &desc);
     
     if (!_shaderModule) {
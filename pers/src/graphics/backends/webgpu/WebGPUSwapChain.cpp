@@ -1,10 +1,18 @@
 #include "pers/graphics/backends/webgpu/WebGPUSwapChain.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
 #include "pers/graphics/backends/webgpu/WebGPULogicalDevice.h"
+#include "pers/graphics/backends/webgpu/WebGPUTexture.h"
 #include "pers/graphics/backends/webgpu/WebGPUTextureView.h"
 #include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/GraphicsEnumStrings.h"
+#include "pers/utils/FrameArena.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/PoolAllocator.h"
 #include <algorithm>
+#include <mutex>
 #include <stdexcept>
+#include <vector>
 
 namespace pers {
 
@@ -14,6 +22,28 @@ constexpr uint32_t getDefaultMaxTextureDimension() {
     return 8192;
 }
 
+namespace {
+
+// Surface capabilities by (surface, adapter). A process has a handful of
+// surfaces and adapters, so a flat list beats a hash map here.
+struct SurfaceCapabilitiesCache {
+    struct Entry {
+        WGPUSurface surface = nullptr;
+        WGPUAdapter adapter = nullptr;
+        SurfaceCapabilities capabilities;
+    };
+    
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    
+    static SurfaceCapabilitiesCache& instance() {
+        static SurfaceCapabilitiesCache cache;
+        return cache;
+    }
+};
+
+} // anonymous namespace
+
 WebGPUSwapChain::WebGPUSwapChain(const std::shared_ptr<WebGPULogicalDevice>& device,
                                  WGPUSurface surface,
                                  const SwapChainDesc& desc)
@@ -39,6 +69,7 @@ WebGPUSwapChain::WebGPUSwapChain(const std::shared_ptr<WebGPULogicalDevice>& dev
 
 WebGPUSwapChain::~WebGPUSwapChain() {
     releaseCurrentTexture();
+    clearViewCache();
     
     // Surface is not owned by SwapChain, so we don't release it
     
@@ -52,25 +83,37 @@ void WebGPUSwapChain::configureSurface() {
         return;
     }
     
+    // Surface textures are replaced by the reconfigure
+    clearViewCache();
+    
     // Configure surface with the new Surface API
     _surfaceConfig = {};
     _surfaceConfig.device = device->getNativeDeviceHandle().as<WGPUDevice>();
     _surfaceConfig.format = convertToWGPUFormat(_desc.format);
-    _surfaceConfig.usage = WGPUTextureUsage_RenderAttachment;
+    // Extra usages such as CopySrc (screenshots) only where the surface offers them
+    TextureUsage usage = static_cast<TextureUsage>(_desc.usage) | TextureUsage::RenderAttachment;
+    const SurfaceCapabilities caps = querySurfaceCapabilities();
+    if (caps.usages != 0) {
+        const TextureUsage supported = static_cast<TextureUsage>(caps.usages) | TextureUsage::RenderAttachment;
+        if ((usage & supported) != usage) {
+            LOG_WARNING("WebGPUSwapChain", "Surface does not support every requested usage, dropping the rest");
+            usage = usage & supported;
+        }
+    }
+    _surfaceConfig.usage = WebGPUConverters::convertTextureUsage(usage);
     _surfaceConfig.width = _desc.width;
     _surfaceConfig.height = _desc.height;
-    _surfaceConfig.presentMode = convertToWGPUPresentMode(_desc.presentMode);
-    _surfaceConfig.alphaMode = convertToWGPUAlphaMode(_desc.alphaMode);
+    _surfaceConfig.presentMode = WebGPUConverters::convertPresentMode(_desc.presentMode);
+    _surfaceConfig.alphaMode = WebGPUConverters::convertCompositeAlphaMode(_desc.alphaMode);
     
     // Configure the surface
     wgpuSurfaceConfigure(_surface, &_surfaceConfig);
+    _configurePending = false;
 }
 
 void WebGPUSwapChain::releaseCurrentTexture() {
-    if (_currentTextureView) {
-        wgpuTextureViewRelease(_currentTextureView);
-        _currentTextureView = nullptr;
-    }
+    // View is owned by the cache
+    _currentTextureView = nullptr;
     
     if (_currentSurfaceTexture.texture) {
         wgpuTextureRelease(_currentSurfaceTexture.texture);
@@ -78,16 +121,50 @@ void WebGPUSwapChain::releaseCurrentTexture() {
     }
     
     _currentTextureViewWrapper.reset();
+    _currentTextureWrapper.reset();
     _hasCurrentTexture = false;
 }
 
+void WebGPUSwapChain::releaseCachedView(CachedView& entry) {
+    entry.wrapper.reset();
+    entry.textureWrapper.reset();
+    if (entry.view) {
+        wgpuTextureViewRelease(entry.view);
+    }
+    if (entry.texture) {
+        wgpuTextureRelease(entry.texture);
+    }
+    entry = CachedView{};
+}
+
+void WebGPUSwapChain::clearViewCache() {
+    for (auto& entry : _viewCache) {
+        releaseCachedView(entry);
+    }
+}
+
 std::shared_ptr<ITextureView> WebGPUSwapChain::getCurrentTextureView() {
     // Release previous texture if any
     releaseCurrentTexture();
     
+    // Apply the latest resize before acquiring
+    if (_configurePending) {
+        configureSurface();
+    }
+    
     // Get current texture from surface
     wgpuSurfaceGetCurrentTexture(_surface, &_currentSurfaceTexture);
     
+    // Surface changed under us (e.g. resized before the window event arrived), reconfigure once
+    if (_currentSurfaceTexture.status == WGPUSurfaceGetCurrentTextureStatus_Outdated) {
+        if (_currentSurfaceTexture.texture) {
+            wgpuTextureRelease(_currentSurfaceTexture.texture);
+            _currentSurfaceTexture.texture = nullptr;
+        }
+        configureSurface();
+        wgpuSurfaceGetCurrentTexture(_surface, &_currentSurfaceTexture);
+    }
+    
     if (_currentSurfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessOptimal && 
         _currentSurfaceTexture.status != WGPUSurfaceGetCurrentTextureStatus_SuccessSuboptimal) {
         LOG_ERROR("WebGPUSwapChain", 
@@ -102,6 +179,26 @@ std::shared_ptr<ITextureView> WebGPUSwapChain::getCurrentTextureView() {
                               "Surface is suboptimal, may need reconfiguration");
     }
     
+    // Reuse the view created the last time this image came around
+    ++_acquireCount;
+    CachedView* slot = &_viewCache[0];
+    for (auto& entry : _viewCache) {
+        if (entry.texture == _currentSurfaceTexture.texture) {
+            entry.lastUsed = _acquireCount;
+            _currentTextureView = entry.view;
+            _currentTextureViewWrapper = entry.wrapper;
+            _currentTextureWrapper = entry.textureWrapper;
+            _hasCurrentTexture = true;
+            return _currentTextureViewWrapper;
+        }
+        if (entry.lastUsed < slot->lastUsed) {
+            slot = &entry;
+        }
+    }
+    
+    // Miss: evict the least recently used entry
+    releaseCachedView(*slot);
+    
     // Create texture view from the surface texture  
     WGPUTextureViewDescriptor viewDesc = {};
     viewDesc.format = convertToWGPUFormat(_desc.format);
@@ -120,7 +217,7 @@ std::shared_ptr<ITextureView> WebGPUSwapChain::getCurrentTextureView() {
     }
     
     // Create wrapper for the texture view (mark as SwapChain texture)
-    _currentTextureViewWrapper = std::make_shared<WebGPUTextureView>(
+    _currentTextureViewWrapper = makePooledShared<WebGPUTextureView>(
         _currentTextureView,
         _desc.width,
         _desc.height,
@@ -128,11 +225,34 @@ std::shared_ptr<ITextureView> WebGPUSwapChain::getCurrentTextureView() {
         true  // isSwapChainTexture
     );
     
+    // The texture wrapper holds its own reference, released with the cache entry
+    wgpuTextureAddRef(_currentSurfaceTexture.texture);
+    _currentTextureWrapper = std::make_shared<WebGPUTexture>(
+        _currentSurfaceTexture.texture,
+        _desc.width,
+        _desc.height,
+        1,
+        _desc.format,
+        WebGPUConverters::convertFromWGPUTextureUsage(_surfaceConfig.usage),
+        TextureDimension::D2
+    );
+    
+    wgpuTextureAddRef(_currentSurfaceTexture.texture);
+    slot->texture = _currentSurfaceTexture.texture;
+    slot->view = _currentTextureView;
+    slot->wrapper = _currentTextureViewWrapper;
+    slot->textureWrapper = _currentTextureWrapper;
+    slot->lastUsed = _acquireCount;
+    
     _hasCurrentTexture = true;
     
     return _currentTextureViewWrapper;
 }
 
+std::shared_ptr<ITexture> WebGPUSwapChain::getCurrentTexture() const {
+    return _hasCurrentTexture ? _currentTextureWrapper : nullptr;
+}
+
 void WebGPUSwapChain::present() {
     if (!_hasCurrentTexture) {
         LOG_WARNING("WebGPUSwapChain", 
@@ -145,6 +265,16 @@ void WebGPUSwapChain::present() {
     
     // After present, the current texture is no longer valid
     releaseCurrentTexture();
+    
+    // Frame boundary: per-thread scratch from this frame can be reused
+    FrameArena::beginFrame();
+    
+    // and resources retired by completed frames can go
+    if (auto device = _device.lock()) {
+        if (const auto& deletionQueue = device->getDeletionQueue()) {
+            deletionQueue->collect();
+        }
+    }
 }
 
 void WebGPUSwapChain::resize(uint32_t width, uint32_t height) {
@@ -152,19 +282,41 @@ void WebGPUSwapChain::resize(uint32_t width, uint32_t height) {
         return; // No change needed
     }
     
-    LOG_INFO("WebGPUSwapChain", 
+    LOG_DEBUG("WebGPUSwapChain", 
                           "Resizing from " + std::to_string(_desc.width) + "x" + std::to_string(_desc.height) + 
                           " to " + std::to_string(width) + "x" + std::to_string(height));
     
     // Release current texture if any
     releaseCurrentTexture();
     
-    // Update descriptor
+    // Update descriptor, the surface is reconfigured at the next acquire
     _desc.width = width;
     _desc.height = height;
+    _configurePending = true;
+}
+
+bool WebGPUSwapChain::setPresentMode(PresentMode mode) {
+    if (mode == _desc.presentMode) {
+        return true;
+    }
+    
+    SurfaceCapabilities caps = querySurfaceCapabilities();
+    if (std::find(caps.presentModes.begin(), caps.presentModes.end(), mode) == caps.presentModes.end()) {
+        LOG_WARNING("WebGPUSwapChain", 
+                              "Present mode " + GraphicsEnumStrings::toString(mode) + " not supported by surface");
+        return false;
+    }
+    
+    LOG_INFO("WebGPUSwapChain", 
+                          "Switching present mode from " + GraphicsEnumStrings::toString(_desc.presentMode) + 
+                          " to " + GraphicsEnumStrings::toString(mode));
     
-    // Reconfigure surface with new size
+    // Reconfiguring invalidates the acquired texture
+    releaseCurrentTexture();
+    
+    _desc.presentMode = mode;
     configureSurface();
+    return true;
 }
 
 uint32_t WebGPUSwapChain::getWidth() const {
@@ -206,6 +358,45 @@ SurfaceCapabilities WebGPUSwapChain::querySurfaceCapabilities(
     WGPUAdapter adapter,
     WGPUSurface surface) {
     
+    if (!adapter || !surface) {
+        return SurfaceCapabilities{};
+    }
+    
+    auto& cache = SurfaceCapabilitiesCache::instance();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (const auto& entry : cache.entries) {
+            if (entry.surface == surface && entry.adapter == adapter) {
+                return entry.capabilities;
+            }
+        }
+    }
+    
+    // Query outside the lock, a concurrent miss for the same pair stores an identical result
+    SurfaceCapabilities caps = fetchSurfaceCapabilities(adapter, surface);
+    
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = std::find_if(cache.entries.begin(), cache.entries.end(), [&](const auto& entry) {
+        return entry.surface == surface && entry.adapter == adapter;
+    });
+    if (it == cache.entries.end()) {
+        cache.entries.push_back({surface, adapter, caps});
+    }
+    return caps;
+}
+
+void WebGPUSwapChain::invalidateSurfaceCapabilities(WGPUSurface surface, WGPUAdapter adapter) {
+    auto& cache = SurfaceCapabilitiesCache::instance();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    std::erase_if(cache.entries, [&](const auto& entry) {
+        return (!surface || entry.surface == surface) && (!adapter || entry.adapter == adapter);
+    });
+}
+
+SurfaceCapabilities WebGPUSwapChain::fetchSurfaceCapabilities(
+    WGPUAdapter adapter,
+    WGPUSurface surface) {
+    
     WGPUSurfaceCapabilities wgpuCaps = {};
     wgpuSurfaceGetCapabilities(surface, adapter, &wgpuCaps);
     
@@ -224,16 +415,18 @@ SurfaceCapabilities WebGPUSwapChain::querySurfaceCapabilities(
     caps.presentModes.reserve(wgpuCaps.presentModeCount);
     for (size_t i = 0; i < wgpuCaps.presentModeCount; ++i) {
         caps.presentModes.push_back(
-            convertFromWGPUPresentMode(wgpuCaps.presentModes[i]));
+            WebGPUConverters::convertFromWGPUPresentMode(wgpuCaps.presentModes[i]));
     }
     
     // Convert alpha modes
     caps.alphaModes.reserve(wgpuCaps.alphaModeCount);
     for (size_t i = 0; i < wgpuCaps.alphaModeCount; ++i) {
         caps.alphaModes.push_back(
-            convertFromWGPUAlphaMode(wgpuCaps.alphaModes[i]));
+            WebGPUConverters::convertFromWGPUCompositeAlphaMode(wgpuCaps.alphaModes[i]));
     }
     
+    caps.usages = static_cast<TextureUsageFlags>(WebGPUConverters::convertFromWGPUTextureUsage(wgpuCaps.usages));
+    
     // Use default texture limits with runtime notification
     caps.maxWidth = getDefaultMaxTextureDimension();
     caps.maxHeight = getDefaultMaxTextureDimension();
@@ -265,72 +458,32 @@ SurfaceCapabilities WebGPUSwapChain::querySurfaceCapabilities(
     return caps;
 }
 
-// Format conversion functions
-WGPUTextureFormat WebGPUSwapChain::convertToWGPUFormat(TextureFormat format) {
+// Swap chains only accept a handful of formats; the mapping itself is shared
+static bool isSwapChainFormat(TextureFormat format) {
     switch (format) {
-        case TextureFormat::BGRA8Unorm: return WGPUTextureFormat_BGRA8Unorm;
-        case TextureFormat::BGRA8UnormSrgb: return WGPUTextureFormat_BGRA8UnormSrgb;
-        case TextureFormat::RGBA8Unorm: return WGPUTextureFormat_RGBA8Unorm;
-        case TextureFormat::RGBA8UnormSrgb: return WGPUTextureFormat_RGBA8UnormSrgb;
-        case TextureFormat::RGBA16Float: return WGPUTextureFormat_RGBA16Float;
+        case TextureFormat::BGRA8Unorm:
+        case TextureFormat::BGRA8UnormSrgb:
+        case TextureFormat::RGBA8Unorm:
+        case TextureFormat::RGBA8UnormSrgb:
+        case TextureFormat::RGBA16Float:
+            return true;
         default:
-            LOG_ERROR("WebGPUSwapChain", 
-                                  "Unsupported swap chain format");
-            return WGPUTextureFormat_BGRA8Unorm; // Default fallback
-    }
-}
-
-TextureFormat WebGPUSwapChain::convertFromWGPUFormat(WGPUTextureFormat format) {
-    switch (format) {
-        case WGPUTextureFormat_BGRA8Unorm: return TextureFormat::BGRA8Unorm;
-        case WGPUTextureFormat_BGRA8UnormSrgb: return TextureFormat::BGRA8UnormSrgb;
-        case WGPUTextureFormat_RGBA8Unorm: return TextureFormat::RGBA8Unorm;
-        case WGPUTextureFormat_RGBA8UnormSrgb: return TextureFormat::RGBA8UnormSrgb;
-        case WGPUTextureFormat_RGBA16Float: return TextureFormat::RGBA16Float;
-        default: return TextureFormat::Undefined;
+            return false;
     }
 }
 
-WGPUPresentMode WebGPUSwapChain::convertToWGPUPresentMode(PresentMode mode) {
-    switch (mode) {
-        case PresentMode::Fifo: return WGPUPresentMode_Fifo;
-        case PresentMode::Immediate: return WGPUPresentMode_Immediate;
-        case PresentMode::Mailbox: return WGPUPresentMode_Mailbox;
-        case PresentMode::FifoRelaxed: return WGPUPresentMode_FifoRelaxed;
-        default: return WGPUPresentMode_Fifo;
-    }
-}
-
-PresentMode WebGPUSwapChain::convertFromWGPUPresentMode(WGPUPresentMode mode) {
-    switch (mode) {
-        case WGPUPresentMode_Fifo: return PresentMode::Fifo;
-        case WGPUPresentMode_Immediate: return PresentMode::Immediate;
-        case WGPUPresentMode_Mailbox: return PresentMode::Mailbox;
-        case WGPUPresentMode_FifoRelaxed: return PresentMode::FifoRelaxed;
-        default: return PresentMode::Fifo;
-    }
-}
-
-WGPUCompositeAlphaMode WebGPUSwapChain::convertToWGPUAlphaMode(CompositeAlphaMode mode) {
-    switch (mode) {
-        case CompositeAlphaMode::Auto: return WGPUCompositeAlphaMode_Auto;
-        case CompositeAlphaMode::Opaque: return WGPUCompositeAlphaMode_Opaque;
-        case CompositeAlphaMode::PreMultiplied: return WGPUCompositeAlphaMode_Premultiplied;
-        case CompositeAlphaMode::PostMultiplied: return WGPUCompositeAlphaMode_Unpremultiplied;
-        case CompositeAlphaMode::Inherit: return WGPUCompositeAlphaMode_Inherit;
-        default: return WGPUCompositeAlphaMode_Auto;
+WGPUTextureFormat WebGPUSwapChain::convertToWGPUFormat(TextureFormat format) {
+    if (!isSwapChainFormat(format)) {
+        LOG_ERROR("WebGPUSwapChain", 
+                              "Unsupported swap chain format");
+        return WGPUTextureFormat_BGRA8Unorm; // Default fallback
     }
+    return WebGPUConverters::convertTextureFormat(format);
 }
 
-CompositeAlphaMode WebGPUSwapChain::convertFromWGPUAlphaMode(WGPUCompositeAlphaMode mode) {
-    switch (mode) {
-        case WGPUCompositeAlphaMode_Auto: return CompositeAlphaMode::Auto;
-        case WGPUCompositeAlphaMode_Opaque: return CompositeAlphaMode::Opaque;
-        case WGPUCompositeAlphaMode_Premultiplied: return CompositeAlphaMode::PreMultiplied;
-        case WGPUCompositeAlphaMode_Unpremultiplied: return CompositeAlphaMode::PostMultiplied;
-        case WGPUCompositeAlphaMode_Inherit: return CompositeAlphaMode::Inherit;
-        default: return CompositeAlphaMode::Auto;
-    }
+TextureFormat WebGPUSwapChain::convertFromWGPUFormat(WGPUTextureFormat format) {
+    const TextureFormat result = WebGPUConverters::convertFromWGPUTextureFormat(format);
+    return isSwapChainFormat(result) ? result : TextureFormat::Undefined;
 }
 
 
@@ -1,8 +1,18 @@
 #include "pers/graphics/backends/webgpu/WebGPUTexture.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
 
 namespace pers {
 
+namespace {
+
+MetricCounter& liveTextures() {
+    static MetricCounter& gauge = Metrics::gauge("pers_textures_live", "Live WebGPU textures, swap chain images included");
+    return gauge;
+}
+
+} // namespace
+
 WebGPUTexture::WebGPUTexture(WGPUTexture texture,
                              uint32_t width,
                              uint32_t height,
@@ -22,6 +32,8 @@ WebGPUTexture::WebGPUTexture(WGPUTexture texture,
     
     if (!_texture) {
         LOG_ERROR("WebGPUTexture", "Invalid texture handle");
+    } else {
+        liveTextures().increment();
     }
 }
 
@@ -29,6 +41,7 @@ WebGPUTexture::~WebGPUTexture() {
     if (_texture) {
         wgpuTextureRelease(_texture);
         _texture = nullptr;
+        liveTextures().decrement();
     }
 }
 
@@ -1,49 +1,26 @@
 #include "pers/graphics/backends/webgpu/buffers/WebGPUBuffer.h"
+#include "pers/graphics/backends/webgpu/WebGPUConverters.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
 #include <webgpu/webgpu.h>
-#include <sstream>
 
 namespace pers {
 
-static uint32_t convertBufferUsage(BufferUsage usage) {
-    uint32_t result = 0;
-    
-    uint32_t u = static_cast<uint32_t>(usage);
-    
-    if (u & static_cast<uint32_t>(BufferUsage::MapRead)) {
-        result = result | WGPUBufferUsage_MapRead;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::MapWrite)) {
-        result = result | WGPUBufferUsage_MapWrite;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::CopySrc)) {
-        result = result | WGPUBufferUsage_CopySrc;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::CopyDst)) {
-        result = result | WGPUBufferUsage_CopyDst;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::Index)) {
-        result = result | WGPUBufferUsage_Index;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::Vertex)) {
-        result = result | WGPUBufferUsage_Vertex;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::Uniform)) {
-        result = result | WGPUBufferUsage_Uniform;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::Storage)) {
-        result = result | WGPUBufferUsage_Storage;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::Indirect)) {
-        result = result | WGPUBufferUsage_Indirect;
-    }
-    if (u & static_cast<uint32_t>(BufferUsage::QueryResolve)) {
-        result = result | WGPUBufferUsage_QueryResolve;
-    }
-    
-    return result;
+namespace {
+
+// Live native buffers, counting mappable buffers through their WebGPUBuffer
+struct BufferMetrics {
+    MetricCounter& count = Metrics::gauge("pers_buffers_live", "Live WebGPU buffers");
+    MetricCounter& bytes = Metrics::gauge("pers_buffer_bytes_live", "Bytes held by live WebGPU buffers");
+};
+
+BufferMetrics& bufferMetrics() {
+    static BufferMetrics metrics;
+    return metrics;
 }
 
+} // namespace
+
 WebGPUBuffer::WebGPUBuffer(WGPUDevice device, const BufferDesc& desc)
     : _device(device)
     , _buffer(nullptr)
@@ -76,16 +53,22 @@ WebGPUBuffer::WebGPUBuffer(WGPUDevice device, const BufferDesc& desc)
     bufferDesc.nextInChain = nullptr;
     WGPUStringView labelView = {_desc.debugName.c_str(), _desc.debugName.length()};
     bufferDesc.label = labelView;
-    bufferDesc.usage = convertBufferUsage(_desc.usage);
+    bufferDesc.usage = WebGPUConverters::convertBufferUsage(_desc.usage);
     bufferDesc.size = alignedSize;
     bufferDesc.mappedAtCreation = _desc.mappedAtCreation;
     
+    // Accounted first so an over-budget allocation can evict before it lands
+    _allocation = GpuMemoryTracker::instance().allocate(GpuMemoryTracker::categorize(_desc.usage),
+                                                        alignedSize, _desc.debugName);
     _buffer = wgpuDeviceCreateBuffer(_device, &bufferDesc);
     
     if (!_buffer) {
         LOG_ERROR("WebGPUBuffer", "Failed to create WebGPU buffer");
+        _allocation.reset();
         return;
     }
+    bufferMetrics().count.increment();
+    bufferMetrics().bytes.add(static_cast<int64_t>(_desc.size));
     
     if (_desc.mappedAtCreation) {
         _mappedData = wgpuBufferGetMappedRange(_buffer, 0, alignedSize);
@@ -94,10 +77,8 @@ WebGPUBuffer::WebGPUBuffer(WGPUDevice device, const BufferDesc& desc)
         }
     }
     
-    std::stringstream ss;
-    ss << "Created WebGPU buffer '" << _desc.debugName << "' size=" << _desc.size 
-       << " usage=0x" << std::hex << bufferDesc.usage;
-    LOG_DEBUG("WebGPUBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("WebGPUBuffer", "Created WebGPU buffer '{}' size={} usage=0x{:x}",
+                  _desc.debugName, _desc.size, static_cast<uint64_t>(bufferDesc.usage));
 }
 
 WebGPUBuffer::~WebGPUBuffer() {
@@ -105,6 +86,8 @@ WebGPUBuffer::~WebGPUBuffer() {
         wgpuBufferDestroy(_buffer);
         wgpuBufferRelease(_buffer);
         _buffer = nullptr;
+        bufferMetrics().count.decrement();
+        bufferMetrics().bytes.add(-static_cast<int64_t>(_desc.size));
     }
 }
 
@@ -112,7 +95,8 @@ WebGPUBuffer::WebGPUBuffer(WebGPUBuffer&& other) noexcept
     : _device(other._device)
     , _buffer(other._buffer)
     , _desc(std::move(other._desc))
-    , _mappedData(other._mappedData) {
+    , _mappedData(other._mappedData)
+    , _allocation(std::move(other._allocation)) {
     
     other._device = nullptr;
     other._buffer = nullptr;
@@ -127,12 +111,15 @@ WebGPUBuffer& WebGPUBuffer::operator=(WebGPUBuffer&& other) noexcept {
             }
             wgpuBufferDestroy(_buffer);
             wgpuBufferRelease(_buffer);
+            bufferMetrics().count.decrement();
+            bufferMetrics().bytes.add(-static_cast<int64_t>(_desc.size));
         }
         
         _device = other._device;
         _buffer = other._buffer;
         _desc = std::move(other._desc);
         _mappedData = other._mappedData;
+        _allocation = std::move(other._allocation);
         
         other._device = nullptr;
         other._buffer = nullptr;
@@ -1,16 +1,21 @@
 #include "pers/graphics/backends/webgpu/buffers/WebGPUMappableBuffer.h"
+#include "pers/graphics/backends/webgpu/WebGPUEventPump.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Mutex.h"
 #include <webgpu/webgpu.h>
-#include <sstream>
 #include <cstring>
 
 namespace pers {
 
-WebGPUMappableBuffer::WebGPUMappableBuffer(WGPUDevice device, const BufferDesc& desc)
+WebGPUMappableBuffer::WebGPUMappableBuffer(WGPUDevice device,
+                                           const BufferDesc& desc,
+                                           const std::shared_ptr<WebGPUEventPump>& eventPump)
     : _impl(std::make_unique<WebGPUBuffer>(device, desc))
     , _mappedData(nullptr)
     , _isMapped(false)
-    , _mappedRange{0, 0} {
+    , _mappedRange{0, 0}
+    , _eventPump(eventPump) {
     
     if (!_impl || !_impl->isValid()) {
         LOG_ERROR("WebGPUMappableBuffer", "Failed to create underlying WebGPU buffer");
@@ -26,12 +31,8 @@ WebGPUMappableBuffer::WebGPUMappableBuffer(WGPUDevice device, const BufferDesc&
         }
     }
     
-    std::stringstream ss;
-    ss << "Created WebGPU mappable buffer '" << desc.debugName << "' size=" << desc.size;
-    if (_isMapped) {
-        ss << " (mapped at creation)";
-    }
-    LOG_DEBUG("WebGPUMappableBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("WebGPUMappableBuffer", "Created WebGPU mappable buffer '{}' size={}{}",
+                  desc.debugName, desc.size, _isMapped ? " (mapped at creation)" : "");
 }
 
 WebGPUMappableBuffer::~WebGPUMappableBuffer() {
@@ -44,7 +45,8 @@ WebGPUMappableBuffer::WebGPUMappableBuffer(WebGPUMappableBuffer&& other) noexcep
     : _impl(std::move(other._impl))
     , _mappedData(other._mappedData)
     , _isMapped(other._isMapped.load())
-    , _mappedRange(other._mappedRange) {
+    , _mappedRange(other._mappedRange)
+    , _eventPump(std::move(other._eventPump)) {
     
     other._mappedData = nullptr;
     other._isMapped = false;
@@ -58,6 +60,7 @@ WebGPUMappableBuffer& WebGPUMappableBuffer::operator=(WebGPUMappableBuffer&& oth
         }
         
         _impl = std::move(other._impl);
+        _eventPump = std::move(other._eventPump);
         _mappedData = other._mappedData;
         _isMapped = other._isMapped.load();
         _mappedRange = other._mappedRange;
@@ -77,8 +80,35 @@ const void* WebGPUMappableBuffer::getMappedData() const {
     return _mappedData;
 }
 
+// Resolve a finished map into MappedData and update the buffer's mapping state
+static MetricCounter& pendingMapsGauge() {
+    static MetricCounter& pendingMaps = Metrics::gauge("pers_buffer_maps_pending", "Buffer map operations in flight");
+    return pendingMaps;
+}
+
+static MappedData completeMap(WGPUMapAsyncStatus status, WebGPUMappableBuffer* buffer,
+                              uint64_t offset, uint64_t size) {
+    if (status != WGPUMapAsyncStatus_Success) {
+        LOG_ERROR_FMT("WebGPUMappableBuffer", "Map async failed with status: {}", static_cast<int>(status));
+        return MappedData{nullptr, 0, nullptr};
+    }
+    
+    auto wgpuBuffer = buffer->getNativeHandle().as<WGPUBuffer>();
+    void* data = wgpuBufferGetMappedRange(wgpuBuffer, offset, size);
+    if (!data) {
+        LOG_ERROR("WebGPUMappableBuffer", "Failed to get mapped range after successful map");
+        return MappedData{nullptr, 0, nullptr};
+    }
+    
+    buffer->_mappedData = data;
+    buffer->_isMapped = true;
+    buffer->_mappedRange = {offset, size};
+    return MappedData{data, size, nullptr};
+}
+
 struct MapAsyncContext {
     std::promise<MappedData> promise;
+    std::shared_ptr<WebGPUEventPump> eventPump;
     WebGPUMappableBuffer* buffer;
     uint64_t offset;
     uint64_t size;
@@ -86,28 +116,88 @@ struct MapAsyncContext {
 
 static void mapAsyncCallback(WGPUMapAsyncStatus status, WGPUStringView message, void* userdata1, void* userdata2) {
     auto* context = static_cast<MapAsyncContext*>(userdata1);
+    pendingMapsGauge().decrement();
     
-    if (status == WGPUMapAsyncStatus_Success) {
-        auto wgpuBuffer = context->buffer->getNativeHandle().as<WGPUBuffer>();
-        void* data = wgpuBufferGetMappedRange(wgpuBuffer, context->offset, context->size);
-        
-        if (data) {
-            context->buffer->_mappedData = data;
-            context->buffer->_isMapped = true;
-            context->buffer->_mappedRange = {context->offset, context->size};
-            context->promise.set_value(MappedData{data, context->size, nullptr});
-        } else {
-            LOG_ERROR("WebGPUMappableBuffer", "Failed to get mapped range after successful map");
-            context->promise.set_value(MappedData{nullptr, 0, nullptr});
+    context->promise.set_value(completeMap(status, context->buffer, context->offset, context->size));
+    
+    if (context->eventPump) {
+        context->eventPump->endAsync();
+    }
+    delete context;
+}
+
+/**
+ * Context for callback-based maps, recycled through a process-wide freelist
+ * so steady-state per-frame readbacks do not hit the allocator
+ */
+struct MapCallbackContext {
+    MapCallback callback;
+    std::shared_ptr<WebGPUEventPump> eventPump;
+    WebGPUMappableBuffer* buffer = nullptr;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    MapCallbackContext* next = nullptr;
+};
+
+class MapCallbackContextPool {
+public:
+    ~MapCallbackContextPool() {
+        while (_free) {
+            MapCallbackContext* next = _free->next;
+            delete _free;
+            _free = next;
         }
-    } else {
-        std::stringstream ss;
-        ss << "Map async failed with status: " << status;
-        LOG_ERROR("WebGPUMappableBuffer", ss.str().c_str());
-        context->promise.set_value(MappedData{nullptr, 0, nullptr});
     }
     
-    delete context;
+    MapCallbackContext* acquire() {
+        {
+            auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+            if (_free) {
+                MapCallbackContext* context = _free;
+                _free = context->next;
+                context->next = nullptr;
+                return context;
+            }
+        }
+        return new MapCallbackContext();
+    }
+    
+    void release(MapCallbackContext* context) {
+        context->callback = nullptr;
+        context->eventPump.reset();
+        context->buffer = nullptr;
+        
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        context->next = _free;
+        _free = context;
+    }
+    
+private:
+    Mutex<false> _mutex;
+    MapCallbackContext* _free = nullptr;
+};
+
+static MapCallbackContextPool& getMapCallbackContextPool() {
+    static MapCallbackContextPool pool;
+    return pool;
+}
+
+static void mapCallbackTrampoline(WGPUMapAsyncStatus status, WGPUStringView message, void* userdata1, void* userdata2) {
+    auto* context = static_cast<MapCallbackContext*>(userdata1);
+    pendingMapsGauge().decrement();
+    
+    MappedData mapped = completeMap(status, context->buffer, context->offset, context->size);
+    
+    // Return the context before running user code, which may start another map
+    MapCallback callback = std::move(context->callback);
+    std::shared_ptr<WebGPUEventPump> eventPump = std::move(context->eventPump);
+    getMapCallbackContextPool().release(context);
+    
+    callback(std::move(mapped));
+    
+    if (eventPump) {
+        eventPump->endAsync();
+    }
 }
 
 std::future<MappedData> WebGPUMappableBuffer::mapAsync(MapMode mode, const BufferMapRange& range) {
@@ -146,6 +236,7 @@ std::future<MappedData> WebGPUMappableBuffer::mapAsync(MapMode mode, const Buffe
     }
     
     auto* context = new MapAsyncContext();
+    context->eventPump = _eventPump;
     context->buffer = this;
     context->offset = offset;
     context->size = size;
@@ -161,11 +252,75 @@ std::future<MappedData> WebGPUMappableBuffer::mapAsync(MapMode mode, const Buffe
     callbackInfo.userdata1 = context;
     callbackInfo.userdata2 = nullptr;
     
+    if (_eventPump) {
+        _eventPump->beginAsync();
+    }
+    pendingMapsGauge().increment();
     wgpuBufferMapAsync(wgpuBuffer, mapMode, offset, size, callbackInfo);
     
     return future;
 }
 
+bool WebGPUMappableBuffer::mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) {
+    if (!callback) {
+        LOG_ERROR("WebGPUMappableBuffer", "Map callback is null");
+        return false;
+    }
+    
+    if (!_impl || !_impl->isValid()) {
+        callback(MappedData{nullptr, 0, nullptr});
+        return false;
+    }
+    
+    if (_isMapped) {
+        LOG_WARNING("WebGPUMappableBuffer", "Buffer is already mapped");
+        callback(MappedData{_mappedData, _mappedRange.size, nullptr});
+        return true;
+    }
+    
+    auto wgpuBuffer = _impl->getNativeHandle().as<WGPUBuffer>();
+    if (!wgpuBuffer) {
+        callback(MappedData{nullptr, 0, nullptr});
+        return false;
+    }
+    
+    WGPUMapMode mapMode = WGPUMapMode_None;
+    if (mode == MapMode::Read) {
+        mapMode = WGPUMapMode_Read;
+    } else if (mode == MapMode::Write) {
+        mapMode = WGPUMapMode_Write;
+    }
+    
+    uint64_t offset = range.offset;
+    uint64_t size = range.size;
+    
+    if (size == BufferMapRange::WHOLE_BUFFER) {
+        size = _impl->getSize() - offset;
+    }
+    
+    MapCallbackContext* context = getMapCallbackContextPool().acquire();
+    context->callback = std::move(callback);
+    context->eventPump = _eventPump;
+    context->buffer = this;
+    context->offset = offset;
+    context->size = size;
+    
+    WGPUBufferMapCallbackInfo callbackInfo{};
+    callbackInfo.nextInChain = nullptr;
+    callbackInfo.mode = WGPUCallbackMode_AllowSpontaneous;
+    callbackInfo.callback = mapCallbackTrampoline;
+    callbackInfo.userdata1 = context;
+    callbackInfo.userdata2 = nullptr;
+    
+    if (_eventPump) {
+        _eventPump->beginAsync();
+    }
+    pendingMapsGauge().increment();
+    wgpuBufferMapAsync(wgpuBuffer, mapMode, offset, size, callbackInfo);
+    
+    return true;
+}
+
 void WebGPUMappableBuffer::unmap() {
     // Use atomic exchange to ensure unmap is only called once
     bool wasMapped = _isMapped.exchange(false);
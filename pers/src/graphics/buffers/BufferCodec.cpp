@@ -0,0 +1,203 @@
+#include "pers/graphics/buffers/BufferCodec.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+// Word offsets share the directory word with a 6-bit width
+constexpr uint64_t MAX_DATA_WORDS = 1ull << 26;
+
+uint32_t zigzag(uint32_t delta) {
+    return (delta << 1) ^ static_cast<uint32_t>(static_cast<int32_t>(delta) >> 31);
+}
+
+uint32_t unzigzag(uint32_t value) {
+    return (value >> 1) ^ (0u - (value & 1u));
+}
+
+uint32_t packedWords(uint32_t count, uint32_t bits) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(count) * bits + 31) / 32);
+}
+
+} // anonymous namespace
+
+std::vector<uint32_t> encodeBufferPayload(const void* data, size_t size, uint32_t stride) {
+    if (!data || size == 0 || stride == 0 || stride % 4 != 0 || size % stride != 0) {
+        Logger::Instance().LogFormat(LogLevel::Error, "BufferCodec", PERS_SOURCE_LOC,
+            "Cannot encode %zu bytes with stride %u, stride must be a multiple of 4 dividing the size",
+            size, stride);
+        return {};
+    }
+
+    const uint32_t channelCount = stride / 4;
+    const uint64_t elementCount = size / stride;
+    if (elementCount > UINT32_MAX) {
+        LOG_ERROR("BufferCodec", "Too many elements for one payload");
+        return {};
+    }
+
+    const uint32_t blockCount = static_cast<uint32_t>(
+        (elementCount + BUFFER_CODEC_BLOCK_SIZE - 1) / BUFFER_CODEC_BLOCK_SIZE);
+    const uint32_t dataOffset = BUFFER_CODEC_HEADER_WORDS + 2 * blockCount * channelCount;
+
+    // Source may be unaligned, read words through memcpy
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    auto word = [bytes, stride](uint64_t element, uint32_t channel) {
+        uint32_t value;
+        std::memcpy(&value, bytes + element * stride + channel * 4ull, sizeof(value));
+        return value;
+    };
+
+    std::vector<uint32_t> payload(dataOffset, 0);
+    payload[0] = BUFFER_CODEC_MAGIC;
+    payload[1] = BUFFER_CODEC_VERSION;
+    payload[2] = static_cast<uint32_t>(elementCount);
+    payload[3] = channelCount;
+    payload[4] = blockCount;
+    payload[5] = dataOffset;
+
+    std::vector<uint32_t> deltas(BUFFER_CODEC_BLOCK_SIZE);
+    for (uint32_t block = 0; block < blockCount; ++block) {
+        const uint64_t first = static_cast<uint64_t>(block) * BUFFER_CODEC_BLOCK_SIZE;
+        const uint32_t count = static_cast<uint32_t>(std::min<uint64_t>(BUFFER_CODEC_BLOCK_SIZE, elementCount - first));
+
+        for (uint32_t channel = 0; channel < channelCount; ++channel) {
+            uint32_t previous = word(first, channel);
+            uint32_t widest = 0;
+            for (uint32_t j = 1; j < count; ++j) {
+                uint32_t value = word(first + j, channel);
+                deltas[j - 1] = zigzag(value - previous);
+                widest |= deltas[j - 1];
+                previous = value;
+            }
+
+            const uint32_t bits = static_cast<uint32_t>(std::bit_width(widest));
+            const uint64_t wordOffset = payload.size() - dataOffset;
+            if (wordOffset >= MAX_DATA_WORDS) {
+                LOG_ERROR("BufferCodec", "Payload exceeds the 256 MB data limit");
+                return {};
+            }
+
+            const uint32_t stream = block * channelCount + channel;
+            payload[BUFFER_CODEC_HEADER_WORDS + stream * 2] = static_cast<uint32_t>(wordOffset << 6) | bits;
+            payload[BUFFER_CODEC_HEADER_WORDS + stream * 2 + 1] = word(first, channel);
+
+            const size_t streamBegin = payload.size();
+            payload.resize(streamBegin + packedWords(count - 1, bits), 0);
+            uint64_t bitPos = 0;
+            for (uint32_t j = 0; j + 1 < count && bits > 0; ++j, bitPos += bits) {
+                const size_t index = streamBegin + static_cast<size_t>(bitPos >> 5);
+                const uint32_t shift = static_cast<uint32_t>(bitPos & 31);
+                payload[index] |= deltas[j] << shift;
+                if (shift + bits > 32) {
+                    payload[index + 1] |= deltas[j] >> (32 - shift);
+                }
+            }
+        }
+    }
+
+    return payload;
+}
+
+bool readBufferPayloadInfo(const void* payload, size_t size, BufferPayloadInfo& outInfo) {
+    if (!payload || size < BUFFER_CODEC_HEADER_WORDS * 4 || size % 4 != 0) {
+        LOG_ERROR("BufferCodec", "Payload is too small or not word sized");
+        return false;
+    }
+
+    const size_t wordCount = size / 4;
+    auto word = [payload](size_t index) {
+        uint32_t value;
+        std::memcpy(&value, static_cast<const uint8_t*>(payload) + index * 4, sizeof(value));
+        return value;
+    };
+
+    if (word(0) != BUFFER_CODEC_MAGIC || word(1) != BUFFER_CODEC_VERSION) {
+        LOG_ERROR("BufferCodec", "Unknown payload magic or version");
+        return false;
+    }
+
+    BufferPayloadInfo info;
+    info.elementCount = word(2);
+    info.channelCount = word(3);
+    info.blockCount = word(4);
+    info.dataOffset = word(5);
+    info.payloadSize = size;
+    info.decodedSize = static_cast<uint64_t>(info.elementCount) * info.channelCount * 4;
+
+    const uint64_t expectedBlocks = (static_cast<uint64_t>(info.elementCount) + BUFFER_CODEC_BLOCK_SIZE - 1) /
+                                    BUFFER_CODEC_BLOCK_SIZE;
+    const uint64_t streamCount = static_cast<uint64_t>(info.blockCount) * info.channelCount;
+    if (info.channelCount == 0 || info.blockCount != expectedBlocks ||
+        info.dataOffset != BUFFER_CODEC_HEADER_WORDS + 2 * streamCount || info.dataOffset > wordCount) {
+        LOG_ERROR("BufferCodec", "Corrupt payload header");
+        return false;
+    }
+
+    // Every stream must lie inside the payload, the GPU decoder trusts the directory
+    for (uint64_t stream = 0; stream < streamCount; ++stream) {
+        const uint32_t entry = word(BUFFER_CODEC_HEADER_WORDS + stream * 2);
+        const uint32_t block = static_cast<uint32_t>(stream / info.channelCount);
+        const uint32_t count = std::min(BUFFER_CODEC_BLOCK_SIZE, info.elementCount - block * BUFFER_CODEC_BLOCK_SIZE);
+        const uint32_t bits = entry & 63;
+        const uint64_t end = static_cast<uint64_t>(info.dataOffset) + (entry >> 6) + packedWords(count - 1, bits);
+        if (bits > 32 || end > wordCount) {
+            Logger::Instance().LogFormat(LogLevel::Error, "BufferCodec", PERS_SOURCE_LOC,
+                "Payload stream %llu is out of bounds", static_cast<unsigned long long>(stream));
+            return false;
+        }
+    }
+
+    outInfo = info;
+    return true;
+}
+
+bool decodeBufferPayload(const void* payload, size_t size, void* output) {
+    BufferPayloadInfo info;
+    if (!output || !readBufferPayloadInfo(payload, size, info)) {
+        return false;
+    }
+
+    std::vector<uint32_t> words(size / 4);
+    std::memcpy(words.data(), payload, size);
+    auto* out = static_cast<uint8_t*>(output);
+
+    for (uint32_t stream = 0; stream < info.getStreamCount(); ++stream) {
+        const uint32_t block = stream / info.channelCount;
+        const uint32_t channel = stream % info.channelCount;
+        const uint32_t entry = words[BUFFER_CODEC_HEADER_WORDS + stream * 2];
+        const uint32_t bits = entry & 63;
+        const size_t streamBegin = info.dataOffset + (entry >> 6);
+        const uint64_t first = static_cast<uint64_t>(block) * BUFFER_CODEC_BLOCK_SIZE;
+        const uint32_t count = std::min<uint32_t>(BUFFER_CODEC_BLOCK_SIZE, info.elementCount - static_cast<uint32_t>(first));
+
+        uint32_t value = words[BUFFER_CODEC_HEADER_WORDS + stream * 2 + 1];
+        auto store = [&](uint64_t element) {
+            std::memcpy(out + (element * info.channelCount + channel) * 4, &value, sizeof(value));
+        };
+        store(first);
+
+        uint64_t bitPos = 0;
+        for (uint32_t j = 1; j < count; ++j, bitPos += bits) {
+            if (bits > 0) {
+                const size_t index = streamBegin + static_cast<size_t>(bitPos >> 5);
+                const uint32_t shift = static_cast<uint32_t>(bitPos & 31);
+                uint64_t raw = words[index] >> shift;
+                if (shift + bits > 32) {
+                    raw |= static_cast<uint64_t>(words[index + 1]) << (32 - shift);
+                }
+                const uint32_t mask = bits == 32 ? 0xFFFFFFFFu : ((1u << bits) - 1);
+                value += unzigzag(static_cast<uint32_t>(raw) & mask);
+            }
+            store(first + j);
+        }
+    }
+
+    return true;
+}
+
+} // namespace pers
@@ -6,6 +6,7 @@
 #include "pers/graphics/IResourceFactory.h"
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
 #include <cstring>
 #include <sstream>
 #include <future>
@@ -83,9 +84,7 @@ bool DeferredStagingBuffer::create(uint64_t size,
     _created = true;
     _mappingPending = false;
     
-    std::stringstream ss;
-    ss << "Created deferred staging buffer '" << _debugName << "' size=" << _size;
-    LOG_DEBUG("DeferredStagingBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("DeferredStagingBuffer", "Created deferred staging buffer '{}' size={}", _debugName, _size);
     
     return true;
 }
@@ -138,11 +137,9 @@ bool DeferredStagingBuffer::writeBytes(const void* data, uint64_t size, uint64_t
     }
     
     uint8_t* dst = static_cast<uint8_t*>(_currentMapping.data()) + offset;
-    std::memcpy(dst, data, size);
+    copyToMappedMemory(dst, data, static_cast<size_t>(size));
     
-    std::stringstream ss;
-    ss << "Wrote " << size << " bytes at offset " << offset << " to buffer '" << _debugName << "'";
-    LOG_DEBUG("DeferredStagingBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("DeferredStagingBuffer", "Wrote {} bytes at offset {} to buffer '{}'", size, offset, _debugName);
     
     return true;
 }
@@ -172,11 +169,9 @@ bool DeferredStagingBuffer::readBytes(void* data, uint64_t size, uint64_t offset
     }
     
     const uint8_t* src = static_cast<const uint8_t*>(_currentMapping.data()) + offset;
-    std::memcpy(data, src, size);
+    copyFromMappedMemory(data, src, static_cast<size_t>(size));
     
-    std::stringstream ss;
-    ss << "Read " << size << " bytes at offset " << offset << " from buffer '" << _debugName << "'";
-    LOG_DEBUG("DeferredStagingBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("DeferredStagingBuffer", "Read {} bytes at offset {} from buffer '{}'", size, offset, _debugName);
     
     return true;
 }
@@ -192,7 +187,7 @@ BufferUsage DeferredStagingBuffer::getUsage() const {
 
 const std::string& DeferredStagingBuffer::getDebugName() const {
     static const std::string empty;
-    return _created ? _debugName : empty;
+    return _created ? _debugName.str() : empty;
 }
 
 NativeBufferHandle DeferredStagingBuffer::getNativeHandle() const {
@@ -241,6 +236,17 @@ std::future<MappedData> DeferredStagingBuffer::mapAsync(MapMode mode, const Buff
     return _buffer->mapAsync(mode, range);
 }
 
+bool DeferredStagingBuffer::mapAsync(MapMode mode, const BufferMapRange& range, MapCallback callback) {
+    if (!_created || !_buffer) {
+        if (callback) {
+            callback(MappedData{nullptr, 0, nullptr});
+        }
+        return false;
+    }
+    
+    return _buffer->mapAsync(mode, range, std::move(callback));
+}
+
 void DeferredStagingBuffer::unmap() {
     if (_created && _buffer) {
         _buffer->unmap();
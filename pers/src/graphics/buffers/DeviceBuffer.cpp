@@ -6,7 +6,6 @@
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/utils/Logger.h"
 #include <algorithm>
-#include <sstream>
 
 namespace pers {
 
@@ -71,10 +70,8 @@ bool DeviceBuffer::create(uint64_t size, DeviceBufferUsage usage, const std::sha
     _totalBytesTransferred = 0;
     _transferCount = 0;
     
-    std::stringstream ss;
-    ss << "Created device buffer '" << _debugName << "' size=" << _size 
-       << " usage=0x" << std::hex << static_cast<uint32_t>(_usage);
-    LOG_DEBUG("DeviceBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("DeviceBuffer", "Created device buffer '{}' size={} usage=0x{:x}",
+                  _debugName, _size, static_cast<uint32_t>(_usage));
     
     return true;
 }
@@ -85,11 +82,8 @@ void DeviceBuffer::destroy() {
     }
     
     if (_transferCount > 0) {
-        std::stringstream ss;
-        ss << "Destroyed device buffer '" << _debugName 
-           << "' - total transfers: " << _transferCount 
-           << ", bytes: " << _totalBytesTransferred;
-        LOG_DEBUG("DeviceBuffer", ss.str().c_str());
+        LOG_DEBUG_FMT("DeviceBuffer", "Destroyed device buffer '{}' - total transfers: {}, bytes: {}",
+                      _debugName, _transferCount, _totalBytesTransferred);
     }
     
     _buffer.reset();
@@ -114,7 +108,7 @@ BufferUsage DeviceBuffer::getUsage() const {
 
 const std::string& DeviceBuffer::getDebugName() const {
     static const std::string empty;
-    return _created ? _debugName : empty;
+    return _created ? _debugName.str() : empty;
 }
 
 NativeBufferHandle DeviceBuffer::getNativeHandle() const {
@@ -0,0 +1,249 @@
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/graphics/buffers/INativeBuffer.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+
+namespace pers {
+
+// DeviceBufferView
+
+DeviceBufferView::DeviceBufferView(const std::weak_ptr<DeviceBufferHeap>& heap,
+                                   const std::shared_ptr<INativeBuffer>& page,
+                                   uint32_t pageIndex,
+                                   uint64_t offset,
+                                   uint64_t size,
+                                   uint32_t order)
+    : _heap(heap)
+    , _page(page)
+    , _pageIndex(pageIndex)
+    , _offset(offset)
+    , _size(size)
+    , _order(order) {
+}
+
+DeviceBufferView::~DeviceBufferView() {
+    if (auto heap = _heap.lock()) {
+        heap->free(_pageIndex, _offset, _order);
+    }
+}
+
+uint64_t DeviceBufferView::getSize() const {
+    return _size;
+}
+
+BufferUsage DeviceBufferView::getUsage() const {
+    return _page->getUsage();
+}
+
+const std::string& DeviceBufferView::getDebugName() const {
+    return _page->getDebugName();
+}
+
+NativeBufferHandle DeviceBufferView::getNativeHandle() const {
+    return _page->getNativeHandle();
+}
+
+bool DeviceBufferView::isValid() const {
+    return _page->isValid();
+}
+
+BufferState DeviceBufferView::getState() const {
+    return _page->getState();
+}
+
+MemoryLocation DeviceBufferView::getMemoryLocation() const {
+    return _page->getMemoryLocation();
+}
+
+AccessPattern DeviceBufferView::getAccessPattern() const {
+    return _page->getAccessPattern();
+}
+
+uint64_t DeviceBufferView::getNativeOffset() const {
+    return _offset;
+}
+
+// DeviceBufferHeap
+
+DeviceBufferHeap::DeviceBufferHeap(const std::shared_ptr<IResourceFactory>& resourceFactory,
+                                   BufferUsage usage,
+                                   uint64_t pageSize,
+                                   const std::string& debugName)
+    : _resourceFactory(resourceFactory)
+    , _usage(usage | BufferUsage::CopyDst)
+    , _pageOrder(getOrder(std::max(pageSize, MIN_BLOCK_SIZE)))
+    , _debugName(debugName.empty() ? "DeviceBufferHeap" : debugName) {
+    if (!_resourceFactory) {
+        LOG_ERROR("DeviceBufferHeap", "Created with null resource factory");
+    }
+}
+
+DeviceBufferHeap::~DeviceBufferHeap() {
+    // Live views keep their page alive and simply stop returning ranges
+}
+
+uint32_t DeviceBufferHeap::getOrder(uint64_t size) {
+    uint32_t order = 0;
+    while (getBlockSize(order) < size) {
+        ++order;
+    }
+    return order;
+}
+
+bool DeviceBufferHeap::addPage(uint32_t maxOrder) {
+    BufferDesc pageDesc;
+    pageDesc.size = getBlockSize(maxOrder);
+    pageDesc.usage = _usage;
+    pageDesc.memoryLocation = MemoryLocation::DeviceLocal;
+    pageDesc.accessPattern = AccessPattern::Static;
+    pageDesc.mappedAtCreation = false;
+    pageDesc.debugName = _debugName + "[" + std::to_string(_pages.size()) + "]";
+
+    auto buffer = _resourceFactory->createBuffer(pageDesc);
+    if (!buffer) {
+        Logger::Instance().LogFormat(LogLevel::Error, "DeviceBufferHeap", PERS_SOURCE_LOC,
+            "Failed to create heap page of %llu bytes", static_cast<unsigned long long>(pageDesc.size));
+        return false;
+    }
+
+    Page page;
+    page.buffer = buffer;
+    page.maxOrder = maxOrder;
+    page.freeBlocks.resize(maxOrder + 1);
+    page.freeBlocks[maxOrder].insert(0);
+
+    // Reuse a trimmed slot if there is one
+    auto slot = std::find_if(_pages.begin(), _pages.end(),
+                             [](const Page& p) { return !p.buffer; });
+    if (slot != _pages.end()) {
+        *slot = std::move(page);
+    } else {
+        _pages.push_back(std::move(page));
+    }
+
+    ++_stats.pageCount;
+    _stats.reservedBytes += pageDesc.size;
+    return true;
+}
+
+std::shared_ptr<DeviceBufferView> DeviceBufferHeap::allocate(uint64_t size, uint64_t alignment) {
+    if (size == 0) {
+        LOG_ERROR("DeviceBufferHeap", "Invalid allocation size (0)");
+        return nullptr;
+    }
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        LOG_ERROR("DeviceBufferHeap", "Alignment must be a power of two");
+        return nullptr;
+    }
+
+    if (size > (1ull << 40)) {
+        LOG_ERROR("DeviceBufferHeap", "Allocation size is too large");
+        return nullptr;
+    }
+
+    if (!_resourceFactory) {
+        LOG_ERROR("DeviceBufferHeap", "Resource factory is null");
+        return nullptr;
+    }
+
+    // Blocks are aligned to their own size, so alignment only affects the order
+    uint32_t order = getOrder(std::max(size, alignment));
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        for (uint32_t pageIndex = 0; pageIndex < _pages.size(); ++pageIndex) {
+            Page& page = _pages[pageIndex];
+            if (!page.buffer || order > page.maxOrder) {
+                continue;
+            }
+
+            uint32_t found = order;
+            while (found <= page.maxOrder && page.freeBlocks[found].empty()) {
+                ++found;
+            }
+            if (found > page.maxOrder) {
+                continue;
+            }
+
+            uint64_t offset = *page.freeBlocks[found].begin();
+            page.freeBlocks[found].erase(page.freeBlocks[found].begin());
+
+            // Split down to the requested order, keeping the upper halves free
+            while (found > order) {
+                --found;
+                page.freeBlocks[found].insert(offset + getBlockSize(found));
+            }
+
+            page.allocatedBytes += getBlockSize(order);
+            ++_stats.allocationCount;
+            _stats.allocatedBytes += getBlockSize(order);
+
+            return std::make_shared<DeviceBufferView>(weak_from_this(), page.buffer,
+                                                      pageIndex, offset, size, order);
+        }
+
+        if (attempt == 0 && !addPage(std::max(order, _pageOrder))) {
+            return nullptr;
+        }
+    }
+
+    LOG_ERROR("DeviceBufferHeap", "Failed to allocate from new heap page");
+    return nullptr;
+}
+
+void DeviceBufferHeap::free(uint32_t pageIndex, uint64_t offset, uint32_t order) {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    if (pageIndex >= _pages.size() || !_pages[pageIndex].buffer) {
+        return;
+    }
+
+    Page& page = _pages[pageIndex];
+    page.allocatedBytes -= getBlockSize(order);
+    --_stats.allocationCount;
+    _stats.allocatedBytes -= getBlockSize(order);
+
+    // Merge with free buddies as far up as possible
+    while (order < page.maxOrder) {
+        uint64_t buddy = offset ^ getBlockSize(order);
+        auto it = page.freeBlocks[order].find(buddy);
+        if (it == page.freeBlocks[order].end()) {
+            break;
+        }
+        page.freeBlocks[order].erase(it);
+        offset = std::min(offset, buddy);
+        ++order;
+    }
+
+    page.freeBlocks[order].insert(offset);
+}
+
+void DeviceBufferHeap::trim() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (auto& page : _pages) {
+        if (page.buffer && page.allocatedBytes == 0) {
+            _stats.reservedBytes -= page.buffer->getSize();
+            --_stats.pageCount;
+            page = Page{};
+        }
+    }
+}
+
+DeviceBufferHeap::Stats DeviceBufferHeap::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    Stats stats = _stats;
+    for (const auto& page : _pages) {
+        for (uint32_t order = 0; order < page.freeBlocks.size(); ++order) {
+            if (!page.freeBlocks[order].empty()) {
+                stats.freeBlockCount += page.freeBlocks[order].size();
+                stats.largestFreeBlock = std::max(stats.largestFreeBlock, getBlockSize(order));
+            }
+        }
+    }
+    return stats;
+}
+
+} // namespace pers
@@ -1,28 +1,175 @@
 #include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/graphics/buffers/INativeBuffer.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IQueue.h"
 #include "pers/utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
 
 namespace pers {
 
-DynamicBuffer::DynamicBuffer() 
+namespace {
+
+// Align value up to a power-of-two boundary
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * IBuffer view over a single frame slot so it can be bound like any other buffer
+ */
+class DynamicFrameBuffer final : public IBuffer {
+public:
+    explicit DynamicFrameBuffer(const std::shared_ptr<INativeBuffer>& buffer)
+        : _buffer(buffer) {
+    }
+
+    uint64_t getSize() const override { return _buffer->getSize(); }
+    BufferUsage getUsage() const override { return _buffer->getUsage(); }
+    const std::string& getDebugName() const override { return _buffer->getDebugName(); }
+    NativeBufferHandle getNativeHandle() const override { return _buffer->getNativeHandle(); }
+    bool isValid() const override { return _buffer->isValid(); }
+    BufferState getState() const override { return _buffer->getState(); }
+    MemoryLocation getMemoryLocation() const override { return _buffer->getMemoryLocation(); }
+    AccessPattern getAccessPattern() const override { return _buffer->getAccessPattern(); }
+
+private:
+    std::shared_ptr<INativeBuffer> _buffer;
+};
+
+} // anonymous namespace
+
+/**
+ * Completion signal for one frame slot
+ * Shared with the queue callback so it outlives a destroyed DynamicBuffer
+ */
+struct DynamicBuffer::FrameFence {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool pending = false;
+};
+
+DynamicBuffer::DynamicBuffer()
     : _size(0)
     , _usage(BufferUsage::None)
     , _debugName()
     , _currentFrame(0)
+    , _frameOffset(0)
+    , _dirtyBegin(0)
+    , _dirtyEnd(0)
+    , _stallCount(0)
     , _frameCount(0)
     , _created(false) {
 }
 
 DynamicBuffer::~DynamicBuffer() {
-    TODO_OR_DIE("DynamicBuffer", "Implement destructor");
+    destroy();
 }
 
 bool DynamicBuffer::create(uint64_t size, BufferUsage usage, const std::shared_ptr<ILogicalDevice>& device, uint32_t frameCount, const std::string& debugName) {
-    TODO_OR_DIE("DynamicBuffer", "Implement create method");
-    return false;
+    if (_created) {
+        LOG_ERROR("DynamicBuffer", "Buffer already created");
+        return false;
+    }
+
+    if (size == 0) {
+        LOG_ERROR("DynamicBuffer", "Invalid buffer size (0)");
+        return false;
+    }
+
+    if (frameCount == 0) {
+        LOG_ERROR("DynamicBuffer", "Frame count must be at least 1");
+        return false;
+    }
+
+    if (!device) {
+        LOG_ERROR("DynamicBuffer", "Device is null");
+        return false;
+    }
+
+    const auto& resourceFactory = device->getResourceFactory();
+    if (!resourceFactory) {
+        LOG_ERROR("DynamicBuffer", "Failed to get resource factory from device");
+        return false;
+    }
+
+    _queue = device->getQueue();
+    if (!_queue) {
+        LOG_ERROR("DynamicBuffer", "Failed to get queue from device");
+        return false;
+    }
+
+    // Every slice offset is aligned to DYNAMIC_OFFSET, so the frame size is too
+    _size = alignUp(size, BufferAlignment::DYNAMIC_OFFSET);
+    _usage = usage | BufferUsage::CopyDst;
+    _debugName = debugName;
+    _frameCount = frameCount;
+
+    _buffers.reserve(frameCount);
+    _frameViews.reserve(frameCount);
+    for (uint32_t i = 0; i < frameCount; ++i) {
+        BufferDesc frameDesc;
+        frameDesc.size = _size;
+        frameDesc.usage = _usage;
+        frameDesc.memoryLocation = MemoryLocation::DeviceLocal;
+        frameDesc.accessPattern = AccessPattern::Stream;
+        frameDesc.mappedAtCreation = false;
+        frameDesc.debugName = debugName.empty() ? debugName : debugName + "[" + std::to_string(i) + "]";
+
+        auto buffer = resourceFactory->createBuffer(frameDesc);
+        if (!buffer) {
+            Logger::Instance().LogFormat(LogLevel::Error, "DynamicBuffer", PERS_SOURCE_LOC,
+                "Failed to create frame buffer %u of %u", i, frameCount);
+            _buffers.clear();
+            _frameViews.clear();
+            _fences.clear();
+            _queue.reset();
+            return false;
+        }
+
+        _buffers.push_back(buffer);
+        _frameViews.push_back(std::make_shared<DynamicFrameBuffer>(buffer));
+        _fences.push_back(std::make_shared<FrameFence>());
+    }
+
+    _shadow.assign(static_cast<size_t>(_size), 0);
+    _mapped.assign(frameCount, false);
+    _currentFrame = 0;
+    _frameOffset = 0;
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+    _stallCount = 0;
+    _created = true;
+
+    LOG_DEBUG_FMT("DynamicBuffer", "Created dynamic buffer '{}' size={} frames={} usage=0x{:x}",
+                  _debugName, _size, _frameCount, static_cast<uint32_t>(_usage));
+
+    return true;
 }
 
 void DynamicBuffer::destroy() {
-    TODO_OR_DIE("DynamicBuffer", "Implement destroy method");
+    if (!_created) {
+        return;
+    }
+
+    // In-flight callbacks keep their fence alive, nothing to wait for here
+    _fences.clear();
+    _frameViews.clear();
+    _buffers.clear();
+    _queue.reset();
+    _shadow.clear();
+    _shadow.shrink_to_fit();
+    _mapped.clear();
+    _currentFrame = 0;
+    _frameOffset = 0;
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+    _frameCount = 0;
+    _created = false;
 }
 
 DynamicBuffer::DynamicBuffer(DynamicBuffer&& other) noexcept
@@ -30,14 +177,26 @@ DynamicBuffer::DynamicBuffer(DynamicBuffer&& other) noexcept
     , _usage(other._usage)
     , _debugName(std::move(other._debugName))
     , _buffers(std::move(other._buffers))
+    , _frameViews(std::move(other._frameViews))
+    , _queue(std::move(other._queue))
+    , _shadow(std::move(other._shadow))
     , _currentFrame(other._currentFrame.load())
-    , _frameCount(other._frameCount)
     , _mapped(std::move(other._mapped))
+    , _fences(std::move(other._fences))
+    , _frameOffset(other._frameOffset)
+    , _dirtyBegin(other._dirtyBegin)
+    , _dirtyEnd(other._dirtyEnd)
+    , _stallCount(other._stallCount)
+    , _frameCount(other._frameCount)
     , _created(other._created) {
     other._created = false;
     other._size = 0;
     other._usage = BufferUsage::None;
     other._debugName.clear();
+    other._frameOffset = 0;
+    other._dirtyBegin = 0;
+    other._dirtyEnd = 0;
+    other._frameCount = 0;
 }
 
 DynamicBuffer& DynamicBuffer::operator=(DynamicBuffer&& other) noexcept {
@@ -47,38 +206,265 @@ DynamicBuffer& DynamicBuffer::operator=(DynamicBuffer&& other) noexcept {
         _usage = other._usage;
         _debugName = std::move(other._debugName);
         _buffers = std::move(other._buffers);
+        _frameViews = std::move(other._frameViews);
+        _queue = std::move(other._queue);
+        _shadow = std::move(other._shadow);
         _currentFrame = other._currentFrame.load();
-        _frameCount = other._frameCount;
         _mapped = std::move(other._mapped);
+        _fences = std::move(other._fences);
+        _frameOffset = other._frameOffset;
+        _dirtyBegin = other._dirtyBegin;
+        _dirtyEnd = other._dirtyEnd;
+        _stallCount = other._stallCount;
+        _frameCount = other._frameCount;
         _created = other._created;
         other._created = false;
         other._size = 0;
         other._usage = BufferUsage::None;
         other._debugName.clear();
+        other._frameOffset = 0;
+        other._dirtyBegin = 0;
+        other._dirtyEnd = 0;
+        other._frameCount = 0;
     }
     return *this;
 }
 
 DynamicBuffer::UpdateHandle DynamicBuffer::beginUpdate() {
-    TODO_OR_DIE("DynamicBuffer", "Implement beginUpdate");
-    return UpdateHandle{nullptr, 0, 0};
+    if (!_created) {
+        LOG_ERROR("DynamicBuffer", "Buffer not created");
+        return UpdateHandle{nullptr, 0, 0};
+    }
+
+    uint32_t frame = _currentFrame.load();
+    if (_mapped[frame]) {
+        LOG_WARNING("DynamicBuffer", "beginUpdate called while an update is already open");
+    }
+    _mapped[frame] = true;
+
+    // Whole-frame update: the caller owns the full slot until endUpdate
+    _frameOffset = _size;
+    return UpdateHandle{_shadow.data(), _size, frame, 0};
 }
 
 void DynamicBuffer::endUpdate(const UpdateHandle& handle) {
-    TODO_OR_DIE("DynamicBuffer", "Implement endUpdate");
+    if (!_created) {
+        LOG_ERROR("DynamicBuffer", "Buffer not created");
+        return;
+    }
+
+    if (handle.frameIndex != _currentFrame.load()) {
+        LOG_ERROR("DynamicBuffer", "Update handle belongs to a different frame");
+        return;
+    }
+
+    if (handle.offset + handle.size > _size) {
+        LOG_ERROR("DynamicBuffer", "Update handle range exceeds buffer size");
+        return;
+    }
+
+    _mapped[handle.frameIndex] = false;
+
+    if (handle.size == 0) {
+        return;
+    }
+
+    if (_dirtyBegin == _dirtyEnd) {
+        _dirtyBegin = handle.offset;
+        _dirtyEnd = handle.offset + handle.size;
+    } else {
+        _dirtyBegin = std::min(_dirtyBegin, handle.offset);
+        _dirtyEnd = std::max(_dirtyEnd, handle.offset + handle.size);
+    }
+}
+
+DynamicBuffer::UpdateHandle DynamicBuffer::allocate(uint64_t size, uint64_t alignment) {
+    if (!_created) {
+        LOG_ERROR("DynamicBuffer", "Buffer not created");
+        return UpdateHandle{nullptr, 0, 0};
+    }
+
+    if (size == 0) {
+        return UpdateHandle{nullptr, 0, _currentFrame.load()};
+    }
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        LOG_ERROR("DynamicBuffer", "Alignment must be a power of two");
+        return UpdateHandle{nullptr, 0, _currentFrame.load()};
+    }
+
+    uint64_t offset = alignUp(_frameOffset, alignment);
+    if (offset + size > _size) {
+        Logger::Instance().LogFormat(LogLevel::Error, "DynamicBuffer", PERS_SOURCE_LOC,
+            "Frame slot exhausted: requested %llu bytes at offset %llu, capacity %llu",
+            static_cast<unsigned long long>(size),
+            static_cast<unsigned long long>(offset),
+            static_cast<unsigned long long>(_size));
+        return UpdateHandle{nullptr, 0, _currentFrame.load()};
+    }
+
+    _frameOffset = offset + size;
+
+    // Slices are handed out in order, so the dirty range only grows forward
+    if (_dirtyBegin == _dirtyEnd) {
+        _dirtyBegin = offset;
+    }
+    _dirtyEnd = std::max(_dirtyEnd, offset + size);
+
+    return UpdateHandle{_shadow.data() + offset, size, _currentFrame.load(), offset};
+}
+
+uint64_t DynamicBuffer::write(const void* data, uint64_t size, uint64_t alignment) {
+    if (!data) {
+        LOG_ERROR("DynamicBuffer", "Write data is null");
+        return BufferCopyDesc::WHOLE_SIZE;
+    }
+
+    UpdateHandle handle = allocate(size, alignment);
+    if (!handle.data) {
+        return BufferCopyDesc::WHOLE_SIZE;
+    }
+
+    std::memcpy(handle.data, data, static_cast<size_t>(size));
+    return handle.offset;
+}
+
+bool DynamicBuffer::flush() {
+    if (!_created) {
+        LOG_ERROR("DynamicBuffer", "Buffer not created");
+        return false;
+    }
+
+    if (_dirtyBegin == _dirtyEnd) {
+        return true;
+    }
+
+    // Queue writes must be 4-byte aligned in both offset and size
+    uint64_t begin = _dirtyBegin & ~(BufferAlignment::COPY_BUFFER_OFFSET - 1);
+    uint64_t end = std::min(alignUp(_dirtyEnd, BufferAlignment::COPY_BUFFER_OFFSET), _size);
+
+    BufferWriteDesc writeDesc;
+    writeDesc.buffer = _frameViews[_currentFrame.load()];
+    writeDesc.offset = begin;
+    writeDesc.data = _shadow.data() + begin;
+    writeDesc.size = end - begin;
+
+    if (!_queue->writeBuffer(writeDesc)) {
+        LOG_ERROR("DynamicBuffer", "Failed to upload dirty range");
+        return false;
+    }
+
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+    return true;
 }
 
 std::shared_ptr<IBuffer> DynamicBuffer::getCurrentFrameBuffer() const {
-    TODO_OR_DIE("DynamicBuffer", "Implement getCurrentFrameBuffer");
-    return nullptr;
+    if (!_created) {
+        return nullptr;
+    }
+    return _frameViews[_currentFrame.load()];
 }
 
 uint32_t DynamicBuffer::getCurrentFrameIndex() const {
     return _currentFrame.load();
 }
 
+uint32_t DynamicBuffer::getFrameCount() const {
+    return _frameCount;
+}
+
+uint64_t DynamicBuffer::getUsedBytes() const {
+    return _frameOffset;
+}
+
+uint64_t DynamicBuffer::getRemainingBytes() const {
+    return _size - _frameOffset;
+}
+
 void DynamicBuffer::nextFrame() {
-    _currentFrame = (_currentFrame + 1) % _frameCount;
+    if (!_created) {
+        return;
+    }
+
+    if (_dirtyBegin != _dirtyEnd) {
+        LOG_WARNING("DynamicBuffer", "nextFrame called with unflushed writes, flushing now");
+        flush();
+    }
+
+    // Fence the slot we are leaving; the callback fires once the GPU is done
+    // with everything submitted so far, which includes this frame's reads
+    uint32_t retiring = _currentFrame.load();
+    std::shared_ptr<FrameFence> fence = _fences[retiring];
+    {
+        std::lock_guard<std::mutex> lock(fence->mutex);
+        fence->pending = true;
+    }
+    
+    bool registered = _queue->onSubmittedWorkDone([fence](bool success) {
+        {
+            std::lock_guard<std::mutex> lock(fence->mutex);
+            fence->pending = false;
+        }
+        fence->cv.notify_all();
+    });
+    
+    if (!registered) {
+        LOG_WARNING("DynamicBuffer", "Failed to fence frame slot, reuse is unsynchronized");
+        std::lock_guard<std::mutex> lock(fence->mutex);
+        fence->pending = false;
+    }
+    
+    uint32_t next = (retiring + 1) % _frameCount;
+    if (!isFrameRetired(next)) {
+        ++_stallCount;
+        waitForFrame(next);
+    }
+    
+    _currentFrame = next;
+    _frameOffset = 0;
+}
+
+bool DynamicBuffer::isFrameRetired(uint32_t frameIndex) const {
+    if (!_created || frameIndex >= _fences.size()) {
+        return true;
+    }
+    
+    const auto& fence = _fences[frameIndex];
+    std::lock_guard<std::mutex> lock(fence->mutex);
+    return !fence->pending;
+}
+
+uint64_t DynamicBuffer::getStallCount() const {
+    return _stallCount;
+}
+
+bool DynamicBuffer::waitForFrame(uint32_t frameIndex) {
+    const auto& fence = _fences[frameIndex];
+    const auto timeout = std::chrono::seconds(30); // Same bound as WebGPUQueue::waitIdle
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    
+    std::unique_lock<std::mutex> lock(fence->mutex);
+    while (fence->pending) {
+        // Callbacks are delivered while the device is polled, so drive it ourselves
+        lock.unlock();
+        _queue->pollSubmittedWork(false);
+        lock.lock();
+        
+        if (!fence->pending) {
+            break;
+        }
+        
+        if (std::chrono::steady_clock::now() >= deadline) {
+            Logger::Instance().LogFormat(LogLevel::Error, "DynamicBuffer", PERS_SOURCE_LOC,
+                "Timeout waiting for GPU to retire frame slot %u", frameIndex);
+            return false;
+        }
+        
+        fence->cv.wait_for(lock, std::chrono::milliseconds(1));
+    }
+    
+    return true;
 }
 
 uint64_t DynamicBuffer::getSize() const {
@@ -94,8 +480,10 @@ const std::string& DynamicBuffer::getDebugName() const {
 }
 
 NativeBufferHandle DynamicBuffer::getNativeHandle() const {
-    TODO_OR_DIE("DynamicBuffer", "Implement getNativeHandle");
-    return NativeBufferHandle{};
+    if (!_created) {
+        return NativeBufferHandle{};
+    }
+    return _buffers[_currentFrame.load()]->getNativeHandle();
 }
 
 bool DynamicBuffer::isValid() const {
@@ -112,11 +500,11 @@ BufferState DynamicBuffer::getState() const {
 }
 
 MemoryLocation DynamicBuffer::getMemoryLocation() const {
-    return MemoryLocation::HostVisible;
+    return _created && !_buffers.empty() ? _buffers[0]->getMemoryLocation() : MemoryLocation::Auto;
 }
 
 AccessPattern DynamicBuffer::getAccessPattern() const {
-    return AccessPattern::Dynamic;
+    return AccessPattern::Stream;
 }
 
 } // namespace pers
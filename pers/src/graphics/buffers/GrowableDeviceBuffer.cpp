@@ -0,0 +1,283 @@
+#include "pers/graphics/buffers/GrowableDeviceBuffer.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+namespace pers {
+
+namespace {
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+GrowableDeviceBuffer::GrowableDeviceBuffer()
+    : _usage(DeviceBufferUsage::None)
+    , _used(0)
+    , _capacity(0)
+    , _growthFactor(DEFAULT_GROWTH_FACTOR)
+    , _generation(0)
+    , _debugName()
+    , _created(false) {
+}
+
+GrowableDeviceBuffer::~GrowableDeviceBuffer() {
+    destroy();
+}
+
+bool GrowableDeviceBuffer::create(uint64_t initialCapacity,
+                                  DeviceBufferUsage usage,
+                                  const std::shared_ptr<ILogicalDevice>& device,
+                                  uint32_t growthFactor,
+                                  const std::string& debugName) {
+    if (_created) {
+        LOG_ERROR("GrowableDeviceBuffer", "Buffer already created");
+        return false;
+    }
+
+    if (initialCapacity == 0) {
+        LOG_ERROR("GrowableDeviceBuffer", "Invalid initial capacity (0)");
+        return false;
+    }
+
+    if (growthFactor < 2) {
+        LOG_ERROR("GrowableDeviceBuffer", "Growth factor must be at least 2");
+        return false;
+    }
+
+    if (!device) {
+        LOG_ERROR("GrowableDeviceBuffer", "Device is null");
+        return false;
+    }
+
+    _queue = device->getQueue();
+    if (!_queue) {
+        LOG_ERROR("GrowableDeviceBuffer", "Failed to get queue from device");
+        return false;
+    }
+
+    // Relocation reads the old buffer as a copy source
+    _usage = usage | DeviceBufferUsage::CopySrc;
+    _capacity = alignUp(initialCapacity, BufferAlignment::COPY_BUFFER_OFFSET);
+
+    _buffer = std::make_shared<DeviceBuffer>();
+    if (!_buffer->create(_capacity, _usage, device, debugName)) {
+        LOG_ERROR("GrowableDeviceBuffer", "Failed to create device buffer");
+        _buffer.reset();
+        _queue.reset();
+        _capacity = 0;
+        return false;
+    }
+
+    _device = device;
+    _growthFactor = growthFactor;
+    _debugName = debugName;
+    _used = 0;
+    _generation = 0;
+    _stats = Stats();
+    _created = true;
+
+    LOG_DEBUG_FMT("GrowableDeviceBuffer", "Created '{}' capacity={} growthFactor={}",
+                  _debugName, _capacity, _growthFactor);
+    return true;
+}
+
+void GrowableDeviceBuffer::destroy() {
+    if (!_created) {
+        return;
+    }
+
+    if (_stats.growCount > 0) {
+        LOG_DEBUG_FMT("GrowableDeviceBuffer", "Destroyed '{}' - grown: {}, relocated bytes: {}, capacity: {}",
+                      _debugName, _stats.growCount, _stats.relocatedBytes, _capacity);
+    }
+
+    // Retired like a grown-out buffer, submitted work may still read it
+    const auto& deletionQueue = _device->getDeletionQueue();
+    if (deletionQueue) {
+        deletionQueue->retire(std::move(_buffer));
+    }
+    _buffer.reset();
+    _queue.reset();
+    _device.reset();
+    _used = 0;
+    _capacity = 0;
+    _created = false;
+}
+
+uint64_t GrowableDeviceBuffer::append(const void* data, uint64_t size) {
+    if (!_created) {
+        LOG_ERROR("GrowableDeviceBuffer", "Buffer not created");
+        return INVALID_OFFSET;
+    }
+
+    const uint64_t offset = alignUp(_used, BufferAlignment::COPY_BUFFER_OFFSET);
+    if (size == 0) {
+        return offset;
+    }
+
+    if (!data) {
+        LOG_ERROR("GrowableDeviceBuffer", "Append data is null");
+        return INVALID_OFFSET;
+    }
+
+    const uint64_t end = offset + alignUp(size, BufferAlignment::COPY_BUFFER_OFFSET);
+    if (end > _capacity && !grow(std::max(end, _capacity * _growthFactor))) {
+        return INVALID_OFFSET;
+    }
+
+    // Queue writes need aligned sizes, the tail goes through a padded word
+    const auto* bytes = static_cast<const std::byte*>(data);
+    const uint64_t body = size & ~(BufferAlignment::COPY_BUFFER_OFFSET - 1);
+    if (body > 0 && !_queue->writeBuffer(_buffer, offset, std::span<const std::byte>(bytes, body))) {
+        LOG_ERROR("GrowableDeviceBuffer", "Failed to write appended data");
+        return INVALID_OFFSET;
+    }
+
+    if (size > body) {
+        std::byte tail[BufferAlignment::COPY_BUFFER_OFFSET] = {};
+        std::memcpy(tail, bytes + body, static_cast<size_t>(size - body));
+        if (!_queue->writeBuffer(_buffer, offset + body, std::span<const std::byte>(tail))) {
+            LOG_ERROR("GrowableDeviceBuffer", "Failed to write appended data");
+            return INVALID_OFFSET;
+        }
+    }
+
+    _used = offset + size;
+    _stats.appendedBytes += size;
+    return offset;
+}
+
+bool GrowableDeviceBuffer::reserve(uint64_t capacity) {
+    if (!_created) {
+        LOG_ERROR("GrowableDeviceBuffer", "Buffer not created");
+        return false;
+    }
+
+    if (capacity <= _capacity) {
+        return true;
+    }
+    return grow(capacity);
+}
+
+void GrowableDeviceBuffer::clear() {
+    _used = 0;
+}
+
+bool GrowableDeviceBuffer::grow(uint64_t capacity) {
+    capacity = alignUp(capacity, BufferAlignment::COPY_BUFFER_OFFSET);
+
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(capacity, _usage, _device, _debugName)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "GrowableDeviceBuffer", PERS_SOURCE_LOC,
+            "Failed to grow '%s' to %llu bytes", _debugName.c_str(),
+            static_cast<unsigned long long>(capacity));
+        return false;
+    }
+
+    // Queue writes to the old buffer land before this submit, so the copy sees them
+    const uint64_t copySize = alignUp(_used, BufferAlignment::COPY_BUFFER_OFFSET);
+    if (copySize > 0) {
+        auto encoder = _device->createCommandEncoder();
+        if (!encoder) {
+            LOG_ERROR("GrowableDeviceBuffer", "Failed to create command encoder");
+            return false;
+        }
+
+        BufferCopyDesc copy;
+        copy.size = copySize;
+        if (!encoder->copyDeviceToDevice(_buffer, buffer, copy)) {
+            LOG_ERROR("GrowableDeviceBuffer", "Failed to encode relocation copy");
+            return false;
+        }
+
+        auto commandBuffer = encoder->finish();
+        if (!commandBuffer || !_queue->submit(commandBuffer)) {
+            LOG_ERROR("GrowableDeviceBuffer", "Failed to submit relocation copy");
+            return false;
+        }
+        _stats.relocatedBytes += copySize;
+    }
+
+    // Held until the relocation copy and earlier frames reading it have completed
+    const auto& deletionQueue = _device->getDeletionQueue();
+    if (deletionQueue) {
+        deletionQueue->retire(std::move(_buffer));
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Debug, "GrowableDeviceBuffer", PERS_SOURCE_LOC,
+        "Grew '%s' from %llu to %llu bytes, relocated %llu", _debugName.c_str(),
+        static_cast<unsigned long long>(_capacity), static_cast<unsigned long long>(capacity),
+        static_cast<unsigned long long>(copySize));
+
+    _buffer = std::move(buffer);
+    _capacity = capacity;
+    ++_generation;
+    ++_stats.growCount;
+    return true;
+}
+
+uint64_t GrowableDeviceBuffer::getUsedSize() const {
+    return _used;
+}
+
+uint64_t GrowableDeviceBuffer::getCapacity() const {
+    return _capacity;
+}
+
+uint32_t GrowableDeviceBuffer::getGeneration() const {
+    return _generation;
+}
+
+GrowableDeviceBuffer::Stats GrowableDeviceBuffer::getStats() const {
+    return _stats;
+}
+
+const std::shared_ptr<DeviceBuffer>& GrowableDeviceBuffer::getDeviceBuffer() const {
+    return _buffer;
+}
+
+uint64_t GrowableDeviceBuffer::getSize() const {
+    return _capacity;
+}
+
+BufferUsage GrowableDeviceBuffer::getUsage() const {
+    return _buffer ? _buffer->getUsage() : BufferUsage::None;
+}
+
+const std::string& GrowableDeviceBuffer::getDebugName() const {
+    return _debugName;
+}
+
+NativeBufferHandle GrowableDeviceBuffer::getNativeHandle() const {
+    return _buffer ? _buffer->getNativeHandle() : NativeBufferHandle();
+}
+
+bool GrowableDeviceBuffer::isValid() const {
+    return _created && _buffer && _buffer->isValid();
+}
+
+BufferState GrowableDeviceBuffer::getState() const {
+    return _buffer ? _buffer->getState() : BufferState::Uninitialized;
+}
+
+MemoryLocation GrowableDeviceBuffer::getMemoryLocation() const {
+    return MemoryLocation::DeviceLocal;
+}
+
+AccessPattern GrowableDeviceBuffer::getAccessPattern() const {
+    return AccessPattern::Dynamic;
+}
+
+} // namespace pers
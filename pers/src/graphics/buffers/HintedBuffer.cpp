@@ -0,0 +1,391 @@
+#include "pers/graphics/buffers/HintedBuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include "pers/graphics/buffers/ShadowedDeviceBuffer.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <string>
+
+namespace pers {
+
+namespace {
+
+// Backends add CopyDst themselves and never take mapping flags
+DeviceBufferUsage toDeviceBufferUsage(BufferUsage usage) {
+    const uint32_t excluded = static_cast<uint32_t>(BufferUsage::CopyDst | BufferUsage::MapRead | BufferUsage::MapWrite);
+    return static_cast<DeviceBufferUsage>(static_cast<uint32_t>(usage) & ~excluded);
+}
+
+// Mappable vertex/uniform buffers only avoid a copy when the GPU reads host memory
+bool supportsUnifiedMapping(const ILogicalDevice& device) {
+    auto physicalDevice = device.getPhysicalDevice();
+    return physicalDevice && physicalDevice->getCapabilities().isUnifiedMemory &&
+           device.hasFeature(DeviceFeature::MappablePrimaryBuffers);
+}
+
+/**
+ * IBuffer view over a UnifiedMapped slot so it can be bound like any other buffer
+ */
+class UnifiedSlotBuffer final : public IBuffer {
+public:
+    explicit UnifiedSlotBuffer(const std::shared_ptr<INativeMappableBuffer>& buffer)
+        : _buffer(buffer) {
+    }
+
+    uint64_t getSize() const override { return _buffer->getSize(); }
+    BufferUsage getUsage() const override { return _buffer->getUsage(); }
+    const std::string& getDebugName() const override { return _buffer->getDebugName(); }
+    NativeBufferHandle getNativeHandle() const override { return _buffer->getNativeHandle(); }
+    bool isValid() const override { return _buffer->isValid(); }
+    BufferState getState() const override { return _buffer->getState(); }
+    MemoryLocation getMemoryLocation() const override { return _buffer->getMemoryLocation(); }
+    AccessPattern getAccessPattern() const override { return _buffer->getAccessPattern(); }
+
+private:
+    std::shared_ptr<INativeMappableBuffer> _buffer;
+};
+
+} // anonymous namespace
+
+/**
+ * One UnifiedMapped ring slot; pending holds the remap started by nextFrame()
+ */
+struct HintedBuffer::UnifiedSlot {
+    std::shared_ptr<INativeMappableBuffer> buffer;
+    std::shared_ptr<IBuffer> view;
+    std::future<MappedData> pending;
+};
+
+bool HintedBuffer::selectStrategy(const BufferDesc& desc, const ILogicalDevice& device, Strategy& strategy) {
+    if (desc.accessPattern == AccessPattern::Staging || desc.memoryLocation == MemoryLocation::HostCached) {
+        return false;
+    }
+
+    switch (desc.accessPattern) {
+        case AccessPattern::Dynamic:
+            strategy = Strategy::ShadowedDiff;
+            break;
+        case AccessPattern::Stream:
+            strategy = desc.memoryLocation == MemoryLocation::Unified && supportsUnifiedMapping(device)
+                           ? Strategy::UnifiedMapped
+                           : Strategy::FrameRing;
+            break;
+        default:
+            strategy = Strategy::MappedAtCreation;
+            break;
+    }
+    return true;
+}
+
+HintedBuffer::HintedBuffer() = default;
+
+HintedBuffer::~HintedBuffer() {
+    destroy();
+}
+
+bool HintedBuffer::create(const BufferDesc& desc,
+                          const std::shared_ptr<ILogicalDevice>& device,
+                          std::span<const std::byte> initialData,
+                          uint32_t frameCount) {
+    if (isValid()) {
+        LOG_ERROR("HintedBuffer", "Buffer already created");
+        return false;
+    }
+
+    if (!device || desc.size == 0 || initialData.size() > desc.size) {
+        LOG_ERROR("HintedBuffer", "Device is null, size is 0 or initial data exceeds the size");
+        return false;
+    }
+
+    if (!selectStrategy(desc, *device, _strategy)) {
+        LOG_ERROR("HintedBuffer", "Staging and readback buffers belong in StagingBufferPool or ReadbackRing");
+        return false;
+    }
+
+    _queue = device->getQueue();
+    if (!_queue) {
+        LOG_ERROR("HintedBuffer", "Failed to get queue from device");
+        return false;
+    }
+
+    const std::string debugName = desc.debugName.str();
+    bool created = false;
+    switch (_strategy) {
+        case Strategy::MappedAtCreation:
+            if (!initialData.empty()) {
+                // CopyDst keeps later writes possible
+                _static = std::make_shared<ImmediateDeviceBuffer>(device->getResourceFactory(), desc.size,
+                                                                  desc.usage | BufferUsage::CopyDst,
+                                                                  initialData.data(), initialData.size(), debugName);
+                created = _static->isValid();
+            } else {
+                auto buffer = std::make_shared<DeviceBuffer>();
+                created = buffer->create(desc.size, toDeviceBufferUsage(desc.usage), device, debugName);
+                _static = std::move(buffer);
+            }
+            break;
+        case Strategy::ShadowedDiff:
+            _shadowed = std::make_shared<ShadowedDeviceBuffer>();
+            created = _shadowed->create(desc.size, toDeviceBufferUsage(desc.usage), device,
+                                        ShadowedDeviceBuffer::DEFAULT_GRANULARITY,
+                                        ShadowedDeviceBuffer::DEFAULT_MERGE_GAP, debugName);
+            break;
+        case Strategy::FrameRing:
+            _ring = std::make_shared<DynamicBuffer>();
+            created = _ring->create(desc.size, toBufferUsage(toDeviceBufferUsage(desc.usage)),
+                                    device, frameCount, debugName);
+            break;
+        case Strategy::UnifiedMapped: {
+            // Slots start mapped, so the first frame writes without waiting
+            BufferDesc slotDesc = desc;
+            slotDesc.usage = toBufferUsage(toDeviceBufferUsage(desc.usage)) | BufferUsage::MapWrite;
+            slotDesc.mappedAtCreation = true;
+            auto factory = device->getResourceFactory();
+            const uint32_t slotCount = std::max(frameCount, 1u);
+            _slots.resize(slotCount);
+            created = factory != nullptr;
+            for (uint32_t i = 0; created && i < slotCount; ++i) {
+                slotDesc.debugName = debugName + "_Slot" + std::to_string(i);
+                _slots[i].buffer = factory->createMappableBuffer(slotDesc);
+                created = _slots[i].buffer && _slots[i].buffer->isValid() && _slots[i].buffer->isMapped();
+                if (created) {
+                    _slots[i].view = std::make_shared<UnifiedSlotBuffer>(_slots[i].buffer);
+                }
+            }
+            _currentSlot = 0;
+            break;
+        }
+    }
+
+    if (!created) {
+        LOG_ERROR("HintedBuffer", "Failed to create the backing buffer");
+        destroy();
+        return false;
+    }
+
+    _size = desc.size;
+    _accessPattern = desc.accessPattern;
+    if (_strategy != Strategy::MappedAtCreation && !initialData.empty()) {
+        return write(0, initialData.data(), initialData.size()) && upload();
+    }
+    return true;
+}
+
+void HintedBuffer::destroy() {
+    _static.reset();
+    _shadowed.reset();
+    _ring.reset();
+    for (auto& slot : _slots) {
+        // Let an in-flight remap land before the buffer is released
+        if (slot.pending.valid()) {
+            slot.pending.wait();
+        }
+    }
+    _slots.clear();
+    _currentSlot = 0;
+    _stallCount = 0;
+    _queue.reset();
+    _update = DynamicBuffer::UpdateHandle{nullptr, 0, 0};
+    _dirtyBegin = 0;
+    _dirtyEnd = 0;
+    _size = 0;
+}
+
+bool HintedBuffer::write(uint64_t offset, const void* data, uint64_t size) {
+    if (!isValid() || !data || offset > _size || size > _size - offset) {
+        LOG_ERROR("HintedBuffer", "Write is out of bounds or the buffer is not created");
+        return false;
+    }
+
+    switch (_strategy) {
+        case Strategy::MappedAtCreation:
+            return _queue->writeBuffer(_static, offset,
+                                       std::span<const std::byte>(static_cast<const std::byte*>(data), size));
+        case Strategy::ShadowedDiff:
+            return _shadowed->write(offset, data, size);
+        case Strategy::FrameRing:
+            // The slot stays open until upload(), so writes within a frame land in place
+            if (!_update.data) {
+                _update = _ring->beginUpdate();
+                if (!_update.data) {
+                    return false;
+                }
+                _dirtyBegin = offset;
+                _dirtyEnd = offset + size;
+            } else {
+                _dirtyBegin = std::min(_dirtyBegin, offset);
+                _dirtyEnd = std::max(_dirtyEnd, offset + size);
+            }
+            std::memcpy(static_cast<uint8_t*>(_update.data) + offset, data, static_cast<size_t>(size));
+            return true;
+        case Strategy::UnifiedMapped: {
+            if (!mapCurrentSlot()) {
+                return false;
+            }
+            void* mapped = _slots[_currentSlot].buffer->getMappedData();
+            std::memcpy(static_cast<uint8_t*>(mapped) + offset, data, static_cast<size_t>(size));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HintedBuffer::mapCurrentSlot() {
+    auto& slot = _slots[_currentSlot];
+    if (slot.pending.valid()) {
+        if (slot.pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++_stallCount;
+        }
+        MappedData mapped = slot.pending.get();
+        if (!mapped.data()) {
+            LOG_ERROR("HintedBuffer", "Failed to remap unified memory slot");
+            return false;
+        }
+    }
+    if (!slot.buffer->isMapped()) {
+        // Already unmapped by upload() this frame; the GPU may be reading it
+        LOG_ERROR("HintedBuffer", "Unified memory slot written after upload() in the same frame");
+        return false;
+    }
+    return true;
+}
+
+bool HintedBuffer::upload() {
+    if (!isValid()) {
+        return false;
+    }
+
+    switch (_strategy) {
+        case Strategy::MappedAtCreation:
+            return true;
+        case Strategy::ShadowedDiff:
+            return _shadowed->upload();
+        case Strategy::FrameRing:
+            if (_update.data) {
+                _ring->endUpdate(DynamicBuffer::UpdateHandle{
+                    _update.data, _dirtyEnd - _dirtyBegin, _update.frameIndex, _dirtyBegin});
+                _update = DynamicBuffer::UpdateHandle{nullptr, 0, 0};
+            }
+            return _ring->flush();
+        case Strategy::UnifiedMapped: {
+            // Unmapping publishes the writes; there is nothing to copy
+            auto& slot = _slots[_currentSlot];
+            if (slot.pending.valid() && !mapCurrentSlot()) {
+                return false;
+            }
+            if (slot.buffer->isMapped()) {
+                slot.buffer->unmap();
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HintedBuffer::upload(UploadBatcher& batcher) {
+    if (_strategy == Strategy::ShadowedDiff && _shadowed) {
+        return _shadowed->upload(batcher);
+    }
+    return upload();
+}
+
+void HintedBuffer::nextFrame() {
+    if (_strategy == Strategy::UnifiedMapped && !_slots.empty()) {
+        auto& slot = _slots[_currentSlot];
+        if (slot.buffer->isMapped() && !slot.pending.valid()) {
+            LOG_WARNING("HintedBuffer", "nextFrame called with staged writes, uploading now");
+            upload();
+        }
+        // mapAsync resolves once the GPU is done with the submitted frame
+        if (!slot.pending.valid() && !slot.buffer->isMapped()) {
+            slot.pending = slot.buffer->mapAsync(MapMode::Write);
+        }
+        _currentSlot = (_currentSlot + 1) % static_cast<uint32_t>(_slots.size());
+        return;
+    }
+    if (_strategy != Strategy::FrameRing || !_ring) {
+        return;
+    }
+    if (_update.data) {
+        LOG_WARNING("HintedBuffer", "nextFrame called with staged writes, uploading now");
+        upload();
+    }
+    _ring->nextFrame();
+}
+
+std::shared_ptr<IBuffer> HintedBuffer::getCurrentBuffer() const {
+    switch (_strategy) {
+        case Strategy::MappedAtCreation:
+            return _static;
+        case Strategy::ShadowedDiff:
+            return _shadowed;
+        case Strategy::FrameRing:
+            return _ring ? _ring->getCurrentFrameBuffer() : nullptr;
+        case Strategy::UnifiedMapped:
+            return _slots.empty() ? nullptr : _slots[_currentSlot].view;
+    }
+    return nullptr;
+}
+
+IBuffer* HintedBuffer::getBackend() const {
+    switch (_strategy) {
+        case Strategy::MappedAtCreation:
+            return _static.get();
+        case Strategy::ShadowedDiff:
+            return _shadowed.get();
+        case Strategy::FrameRing:
+            return _ring.get();
+        case Strategy::UnifiedMapped:
+            return _slots.empty() ? nullptr : _slots[_currentSlot].view.get();
+    }
+    return nullptr;
+}
+
+uint64_t HintedBuffer::getSize() const {
+    return _size;
+}
+
+BufferUsage HintedBuffer::getUsage() const {
+    const IBuffer* backend = getBackend();
+    return backend ? backend->getUsage() : BufferUsage::None;
+}
+
+const std::string& HintedBuffer::getDebugName() const {
+    const IBuffer* backend = getBackend();
+    return backend ? backend->getDebugName() : _emptyName;
+}
+
+NativeBufferHandle HintedBuffer::getNativeHandle() const {
+    // The rings forward their current slot
+    const IBuffer* backend = getBackend();
+    return backend ? backend->getNativeHandle() : NativeBufferHandle{};
+}
+
+bool HintedBuffer::isValid() const {
+    const IBuffer* backend = getBackend();
+    return backend && backend->isValid();
+}
+
+BufferState HintedBuffer::getState() const {
+    const IBuffer* backend = getBackend();
+    return backend ? backend->getState() : BufferState::Uninitialized;
+}
+
+MemoryLocation HintedBuffer::getMemoryLocation() const {
+    const IBuffer* backend = getBackend();
+    return backend ? backend->getMemoryLocation() : MemoryLocation::Auto;
+}
+
+AccessPattern HintedBuffer::getAccessPattern() const {
+    return _accessPattern;
+}
+
+} // namespace pers
@@ -1,11 +1,14 @@
 #include "pers/graphics/buffers/INativeMappableBuffer.h"
 #include "pers/graphics/buffers/ImmediateStagingBuffer.h"
 #include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
 #include "pers/graphics/ICommandEncoder.h"
 #include "pers/graphics/ILogicalDevice.h"
 #include "pers/graphics/IResourceFactory.h"
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
+#include "pers/utils/Validation.h"
 #include <cstring>
 #include <algorithm>
 #include <sstream>
@@ -91,9 +94,51 @@ bool ImmediateStagingBuffer::create(uint64_t size, const std::shared_ptr<ILogica
     _finalized = false;
     _bytesWritten = 0;
     
-    std::stringstream ss;
-    ss << "Created staging buffer '" << _debugName << "' size=" << _size << " mapped=true";
-    LOG_DEBUG("ImmediateStagingBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("ImmediateStagingBuffer", "Created staging buffer '{}' size={} mapped=true", _debugName, _size);
+    
+    return true;
+}
+
+bool ImmediateStagingBuffer::create(uint64_t size, const std::shared_ptr<StagingBufferPool>& pool, const std::string& debugName) {
+    if (_created) {
+        LOG_ERROR("ImmediateStagingBuffer", "Buffer already created");
+        return false;
+    }
+    
+    if (size == 0) {
+        LOG_ERROR("ImmediateStagingBuffer", "Invalid buffer size (0)");
+        return false;
+    }
+    
+    if (!pool) {
+        LOG_ERROR("ImmediateStagingBuffer", "Staging buffer pool is null");
+        return false;
+    }
+    
+    _buffer = pool->acquire(size);
+    if (!_buffer) {
+        LOG_ERROR("ImmediateStagingBuffer", "Failed to acquire buffer from pool");
+        return false;
+    }
+    
+    _mappedData = _buffer->getMappedData();
+    if (!_mappedData) {
+        LOG_ERROR("ImmediateStagingBuffer", "Pooled buffer is not mapped");
+        pool->release(_buffer);
+        _buffer.reset();
+        return false;
+    }
+    
+    _pool = pool;
+    _size = size;
+    _usage = _buffer->getUsage();
+    _debugName = debugName;
+    _created = true;
+    _finalized = false;
+    _bytesWritten = 0;
+    
+    LOG_DEBUG_FMT("ImmediateStagingBuffer", "Acquired pooled staging buffer '{}' size={} capacity={}",
+                  _debugName, _size, _buffer->getSize());
     
     return true;
 }
@@ -117,6 +162,11 @@ void ImmediateStagingBuffer::destroy() {
         }
     }
     
+    if (_pool) {
+        _pool->release(_buffer);
+        _pool.reset();
+    }
+    
     _buffer.reset();
     _mappedData = nullptr;
     _finalized = false;
@@ -131,6 +181,7 @@ void ImmediateStagingBuffer::destroy() {
 
 ImmediateStagingBuffer::ImmediateStagingBuffer(ImmediateStagingBuffer&& other) noexcept
     : _buffer(std::move(other._buffer))
+    , _pool(std::move(other._pool))
     , _size(other._size)
     , _usage(other._usage)
     , _debugName(std::move(other._debugName))
@@ -152,6 +203,7 @@ ImmediateStagingBuffer& ImmediateStagingBuffer::operator=(ImmediateStagingBuffer
         destroy();
         
         _buffer = std::move(other._buffer);
+        _pool = std::move(other._pool);
         _size = other._size;
         _usage = other._usage;
         _debugName = std::move(other._debugName);
@@ -176,14 +228,14 @@ uint64_t ImmediateStagingBuffer::writeBytes(const void* data, uint64_t size, uin
         return 0;
     }
     
-    if (offset + size > _size) {
+    if (PERS_CHECK_FAILED(offset + size > _size)) {
         std::stringstream ss;
         ss << "Write would exceed buffer size (offset=" << offset << ", size=" << size << ", buffer=" << _size << ")";
         LOG_ERROR("ImmediateStagingBuffer", ss.str().c_str());
         return 0;
     }
     
-    std::memcpy(static_cast<char*>(_mappedData) + offset, data, size);
+    copyToMappedMemory(static_cast<char*>(_mappedData) + offset, data, static_cast<size_t>(size));
     _bytesWritten = std::max(_bytesWritten, offset + size);
     return size;
 }
@@ -197,9 +249,7 @@ void ImmediateStagingBuffer::finalize() {
     _mappedData = nullptr;
     _finalized = true;
     
-    std::stringstream ss;
-    ss << "Finalized buffer '" << _debugName << "' with " << _bytesWritten << " bytes written";
-    LOG_DEBUG("ImmediateStagingBuffer", ss.str().c_str());
+    LOG_DEBUG_FMT("ImmediateStagingBuffer", "Finalized buffer '{}' with {} bytes written", _debugName, _bytesWritten);
 }
 
 bool ImmediateStagingBuffer::isFinalized() const {
@@ -211,7 +261,8 @@ uint64_t ImmediateStagingBuffer::getBytesWritten() const {
 }
 
 uint64_t ImmediateStagingBuffer::getSize() const {
-    return _created && _buffer ? _buffer->getSize() : 0;
+    // Pooled buffers may be larger than requested, report the usable size
+    return _created && _buffer ? std::min<uint64_t>(_buffer->getSize(), alignBufferSize(_size)) : 0;
 }
 
 BufferUsage ImmediateStagingBuffer::getUsage() const {
@@ -220,7 +271,7 @@ BufferUsage ImmediateStagingBuffer::getUsage() const {
 
 const std::string& ImmediateStagingBuffer::getDebugName() const {
     static const std::string empty;
-    return _created ? _debugName : empty;
+    return _created ? _debugName.str() : empty;
 }
 
 NativeBufferHandle ImmediateStagingBuffer::getNativeHandle() const {
@@ -2,42 +2,49 @@
 
 namespace pers {
 
-MappedData::MappedData(void* data, uint64_t size, std::function<void()> unmapCallback)
+MappedData::MappedData(void* data, uint64_t size, UnmapFn unmap, void* unmapContext)
     : _data(data)
     , _size(size)
-    , _unmapCallback(std::move(unmapCallback))
-    , _moved(false) {
+    , _unmap(unmap)
+    , _unmapContext(unmapContext) {
 }
 
 MappedData::~MappedData() {
-    if (!_moved && _unmapCallback) {
-        _unmapCallback();
-    }
+    release();
 }
 
 MappedData::MappedData(MappedData&& other) noexcept
     : _data(other._data)
     , _size(other._size)
-    , _unmapCallback(std::move(other._unmapCallback))
-    , _moved(false) {
-    other._moved = true;
+    , _unmap(other._unmap)
+    , _unmapContext(other._unmapContext) {
+    other._unmap = nullptr;
+    other._unmapContext = nullptr;
 }
 
 MappedData& MappedData::operator=(MappedData&& other) noexcept {
     if (this != &other) {
-        if (!_moved && _unmapCallback) {
-            _unmapCallback();
-        }
+        release();
         
         _data = other._data;
         _size = other._size;
-        _unmapCallback = std::move(other._unmapCallback);
-        _moved = false;
-        other._moved = true;
+        _unmap = other._unmap;
+        _unmapContext = other._unmapContext;
+        other._unmap = nullptr;
+        other._unmapContext = nullptr;
     }
     return *this;
 }
 
+void MappedData::release() {
+    // Clear first so a hook that re-enters cannot unmap twice
+    UnmapFn unmap = _unmap;
+    _unmap = nullptr;
+    if (unmap) {
+        unmap(_unmapContext);
+    }
+}
+
 void* MappedData::data() {
     return _data;
 }
@@ -54,4 +61,4 @@ uint64_t MappedData::count() const {
     return _size;
 }
 
-} // namespace pers
\ No newline at end of file
+} // namespace pers
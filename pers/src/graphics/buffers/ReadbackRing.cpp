@@ -0,0 +1,277 @@
+#include "pers/graphics/buffers/ReadbackRing.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/MemoryCopy.h"
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace pers {
+
+ReadbackRing::ReadbackRing(const std::shared_ptr<ILogicalDevice>& device,
+                           uint64_t slotSize,
+                           uint32_t slotCount,
+                           const std::string& debugName)
+    : _slotSize(slotSize)
+    , _writeIndex(0)
+    , _nextTicket(0)
+    , _droppedCount(0) {
+    if (!device) {
+        LOG_ERROR("ReadbackRing", "Created with null device");
+        return;
+    }
+
+    if (slotSize == 0 || slotCount == 0) {
+        LOG_ERROR("ReadbackRing", "Slot size and slot count must be non-zero");
+        return;
+    }
+
+    _slots.reserve(slotCount);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        auto slot = std::make_shared<Slot>();
+        slot->buffer = std::make_shared<DeferredStagingBuffer>();
+
+        std::stringstream name;
+        name << debugName << "[" << i << "]";
+        if (!slot->buffer->create(slotSize, MapMode::Read, device, name.str())) {
+            LOG_ERROR("ReadbackRing", "Failed to create readback slot");
+            _slots.clear();
+            return;
+        }
+        _slots.push_back(slot);
+    }
+}
+
+ReadbackRing::~ReadbackRing() {
+    // Pending maps keep their slot alive through the callback capture.
+    // Ready slots are unmapped here, in-flight ones are released when they resolve.
+    for (auto& slot : _slots) {
+        if (slot->state.load(std::memory_order_acquire) == SlotState::Ready) {
+            recycle(*slot);
+        }
+    }
+}
+
+uint64_t ReadbackRing::enqueue(const std::shared_ptr<ICommandEncoder>& encoder,
+                               const std::shared_ptr<DeviceBuffer>& source,
+                               const BufferCopyDesc& copyDesc) {
+    if (_slots.empty()) {
+        LOG_ERROR("ReadbackRing", "Ring has no slots");
+        return 0;
+    }
+
+    if (!encoder || !source) {
+        LOG_ERROR("ReadbackRing", "Encoder or source buffer is null");
+        return 0;
+    }
+
+    Slot* slot = findFreeSlot();
+    if (!slot) {
+        return 0;
+    }
+
+    BufferCopyDesc copy = copyDesc;
+    copy.dstOffset = 0;
+    if (copy.size == 0 || copy.size == BufferCopyDesc::WHOLE_SIZE) {
+        copy.size = std::min(_slotSize, source->getSize() - copy.srcOffset);
+    }
+
+    if (copy.size > _slotSize) {
+        std::stringstream ss;
+        ss << "Readback size " << copy.size << " exceeds slot size " << _slotSize;
+        LOG_ERROR("ReadbackRing", ss.str().c_str());
+        return 0;
+    }
+
+    if (!encoder->downloadFromDeviceBuffer(source, slot->buffer, copy)) {
+        LOG_ERROR("ReadbackRing", "Failed to record readback copy");
+        return 0;
+    }
+
+    return commit(*slot, copy.size);
+}
+
+uint64_t ReadbackRing::enqueueTexture(const std::shared_ptr<ICommandEncoder>& encoder,
+                                      const std::shared_ptr<ITexture>& source,
+                                      const TextureReadbackDesc& desc) {
+    if (_slots.empty()) {
+        LOG_ERROR("ReadbackRing", "Ring has no slots");
+        return 0;
+    }
+
+    if (!encoder || !source) {
+        LOG_ERROR("ReadbackRing", "Encoder or source texture is null");
+        return 0;
+    }
+
+    const uint32_t mipHeight = std::max(1u, source->getHeight() >> desc.mipLevel);
+    const uint32_t mipWidth = std::max(1u, source->getWidth() >> desc.mipLevel);
+    const uint32_t width = desc.width ? desc.width : mipWidth - std::min(desc.originX, mipWidth);
+    const uint32_t height = desc.height ? desc.height : mipHeight - std::min(desc.originY, mipHeight);
+    const TextureFormatBlockInfo block = getTextureFormatBlockInfo(source->getFormat());
+    const uint32_t bytesPerRow = desc.bytesPerRow ? desc.bytesPerRow
+                                                  : getTextureReadbackRowPitch(source->getFormat(), width);
+    const uint32_t rows = (height + block.blockHeight - 1) / block.blockHeight;
+    const uint64_t size = static_cast<uint64_t>(bytesPerRow) * rows;
+    if (bytesPerRow == 0 || size == 0) {
+        LOG_ERROR("ReadbackRing", "Texture format cannot be read back");
+        return 0;
+    }
+
+    if (size > _slotSize) {
+        std::stringstream ss;
+        ss << "Readback size " << size << " exceeds slot size " << _slotSize;
+        LOG_ERROR("ReadbackRing", ss.str().c_str());
+        return 0;
+    }
+
+    Slot* slot = findFreeSlot();
+    if (!slot) {
+        return 0;
+    }
+
+    TextureReadbackDesc copy = desc;
+    copy.bufferOffset = 0;
+    copy.bytesPerRow = bytesPerRow;
+    if (!encoder->downloadFromTexture(source, slot->buffer, copy)) {
+        LOG_ERROR("ReadbackRing", "Failed to record texture readback copy");
+        return 0;
+    }
+
+    return commit(*slot, size);
+}
+
+ReadbackRing::Slot* ReadbackRing::findFreeSlot() {
+    // Rotate from the last written slot; tryRead() can free slots out of order
+    const uint32_t slotCount = static_cast<uint32_t>(_slots.size());
+    uint32_t index = _writeIndex;
+    while (_slots[index]->state.load(std::memory_order_acquire) != SlotState::Free) {
+        index = (index + 1) % slotCount;
+        if (index == _writeIndex) {
+            // Every slot is still in flight; dropping beats stalling the frame
+            ++_droppedCount;
+            LOG_DEBUG("ReadbackRing", "All slots in flight, dropping readback");
+            return nullptr;
+        }
+    }
+    _writeIndex = index;
+    return _slots[index].get();
+}
+
+uint64_t ReadbackRing::commit(Slot& slot, uint64_t size) {
+    slot.ticket = ++_nextTicket;
+    slot.size = size;
+    slot.state.store(SlotState::Recorded, std::memory_order_release);
+    _writeIndex = (_writeIndex + 1) % static_cast<uint32_t>(_slots.size());
+    return slot.ticket;
+}
+
+void ReadbackRing::submitted() {
+    for (auto& slotPtr : _slots) {
+        if (slotPtr->state.load(std::memory_order_acquire) != SlotState::Recorded) {
+            continue;
+        }
+
+        slotPtr->state.store(SlotState::MapPending, std::memory_order_release);
+
+        // Capture the slot, not the ring, so completion after destruction is safe
+        std::shared_ptr<Slot> slot = slotPtr;
+        slot->buffer->mapAsync(MapMode::Read, {0, slot->size}, [slot](MappedData mapped) {
+            if (mapped.data()) {
+                slot->mapping = std::move(mapped);
+                slot->state.store(SlotState::Ready, std::memory_order_release);
+            } else {
+                slot->state.store(SlotState::Failed, std::memory_order_release);
+            }
+        });
+    }
+}
+
+size_t ReadbackRing::harvest(const HarvestCallback& callback) {
+    // Visit outstanding slots oldest first; tryRead() may have freed any of them
+    std::vector<Slot*> outstanding;
+    outstanding.reserve(_slots.size());
+    for (auto& slot : _slots) {
+        if (slot->state.load(std::memory_order_acquire) != SlotState::Free) {
+            outstanding.push_back(slot.get());
+        }
+    }
+    std::sort(outstanding.begin(), outstanding.end(),
+        [](const Slot* a, const Slot* b) { return a->ticket < b->ticket; });
+
+    size_t delivered = 0;
+    for (Slot* slot : outstanding) {
+        SlotState state = slot->state.load(std::memory_order_acquire);
+
+        if (state == SlotState::Ready) {
+            if (callback) {
+                callback(slot->ticket, slot->mapping.data(), slot->size);
+            }
+            ++delivered;
+        } else if (state == SlotState::Failed) {
+            Logger::Instance().LogFormat(LogLevel::Warning, "ReadbackRing", PERS_SOURCE_LOC,
+                "Readback %llu failed to map", static_cast<unsigned long long>(slot->ticket));
+        } else {
+            // Still in flight; everything after it is newer, stop to keep order
+            break;
+        }
+
+        recycle(*slot);
+    }
+
+    return delivered;
+}
+
+bool ReadbackRing::tryRead(uint64_t ticket, void* data, uint64_t size) {
+    if (ticket == 0 || !data) {
+        return false;
+    }
+
+    for (auto& slotPtr : _slots) {
+        Slot& slot = *slotPtr;
+        if (slot.ticket != ticket) {
+            continue;
+        }
+
+        SlotState state = slot.state.load(std::memory_order_acquire);
+        if (state == SlotState::Failed) {
+            recycle(slot);
+            return false;
+        }
+        if (state != SlotState::Ready) {
+            return false;
+        }
+
+        copyFromMappedMemory(data, slot.mapping.data(), static_cast<size_t>(std::min(size, slot.size)));
+        recycle(slot);
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t ReadbackRing::getInFlightCount() const {
+    uint32_t count = 0;
+    for (const auto& slot : _slots) {
+        if (slot->state.load(std::memory_order_acquire) != SlotState::Free) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void ReadbackRing::recycle(Slot& slot) {
+    slot.mapping = MappedData{nullptr, 0, nullptr};
+    if (slot.buffer->isMapped()) {
+        slot.buffer->unmap();
+    }
+    slot.ticket = 0;
+    slot.size = 0;
+    slot.state.store(SlotState::Free, std::memory_order_release);
+}
+
+} // namespace pers
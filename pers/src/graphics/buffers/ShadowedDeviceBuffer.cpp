@@ -0,0 +1,347 @@
+#include "pers/graphics/buffers/ShadowedDeviceBuffer.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/UploadBatcher.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+constexpr uint64_t BITS_PER_WORD = 64;
+
+uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // anonymous namespace
+
+ShadowedDeviceBuffer::ShadowedDeviceBuffer()
+    : _size(0)
+    , _granularity(DEFAULT_GRANULARITY)
+    , _granularityShift(0)
+    , _mergeGap(DEFAULT_MERGE_GAP)
+    , _dirtyGranules(0)
+    , _debugName()
+    , _created(false) {
+}
+
+ShadowedDeviceBuffer::~ShadowedDeviceBuffer() {
+    destroy();
+}
+
+bool ShadowedDeviceBuffer::create(uint64_t size,
+                                  DeviceBufferUsage usage,
+                                  const std::shared_ptr<ILogicalDevice>& device,
+                                  uint64_t granularity,
+                                  uint32_t mergeGap,
+                                  const std::string& debugName) {
+    if (_created) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Buffer already created");
+        return false;
+    }
+
+    if (size == 0) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Invalid buffer size (0)");
+        return false;
+    }
+
+    if (!std::has_single_bit(granularity) || granularity < BufferAlignment::COPY_BUFFER_OFFSET) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShadowedDeviceBuffer", PERS_SOURCE_LOC,
+            "Granularity %llu must be a power of two of at least %llu bytes",
+            static_cast<unsigned long long>(granularity),
+            static_cast<unsigned long long>(BufferAlignment::COPY_BUFFER_OFFSET));
+        return false;
+    }
+
+    if (!device) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Device is null");
+        return false;
+    }
+
+    _queue = device->getQueue();
+    if (!_queue) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Failed to get queue from device");
+        return false;
+    }
+
+    // Spans are granule aligned and clamped to the size, so keeping the size
+    // copy aligned keeps every write aligned
+    _size = alignUp(size, BufferAlignment::COPY_BUFFER_OFFSET);
+
+    _buffer = std::make_shared<DeviceBuffer>();
+    if (!_buffer->create(_size, usage, device, debugName)) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Failed to create device buffer");
+        _buffer.reset();
+        _queue.reset();
+        return false;
+    }
+
+    _granularity = granularity;
+    _granularityShift = static_cast<uint32_t>(std::countr_zero(granularity));
+    _mergeGap = mergeGap;
+    _debugName = debugName;
+
+    const uint64_t granuleCount = (_size + _granularity - 1) >> _granularityShift;
+    if (!_shadow.allocate(static_cast<size_t>(_size))) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Failed to allocate shadow copy");
+        _buffer.reset();
+        _queue.reset();
+        return false;
+    }
+    _dirtyBits.assign(static_cast<size_t>((granuleCount + BITS_PER_WORD - 1) / BITS_PER_WORD), 0);
+    _dirtyGranules = 0;
+    _stats = Stats();
+    _created = true;
+
+    LOG_DEBUG_FMT("ShadowedDeviceBuffer", "Created '{}' size={} granularity={} granules={} hugePages={}",
+                  _debugName, _size, _granularity, granuleCount, _shadow.isHugePageBacked());
+    return true;
+}
+
+void ShadowedDeviceBuffer::destroy() {
+    if (!_created) {
+        return;
+    }
+
+    if (_stats.uploadCount > 0) {
+        LOG_DEBUG_FMT("ShadowedDeviceBuffer", "Destroyed '{}' - uploads: {}, spans: {}, bytes: {}",
+                      _debugName, _stats.uploadCount, _stats.uploadedSpans, _stats.uploadedBytes);
+    }
+
+    _buffer.reset();
+    _queue.reset();
+    _shadow.release();
+    _dirtyBits.clear();
+    _dirtyGranules = 0;
+    _size = 0;
+    _created = false;
+}
+
+bool ShadowedDeviceBuffer::write(uint64_t offset, const void* data, uint64_t size) {
+    if (!_created) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Buffer not created");
+        return false;
+    }
+
+    if (size == 0) {
+        return true;
+    }
+
+    if (!data || offset > _size || size > _size - offset) {
+        Logger::Instance().LogFormat(LogLevel::Error, "ShadowedDeviceBuffer", PERS_SOURCE_LOC,
+            "Write of %llu bytes at offset %llu exceeds buffer size %llu",
+            static_cast<unsigned long long>(size), static_cast<unsigned long long>(offset),
+            static_cast<unsigned long long>(_size));
+        return false;
+    }
+
+    std::memcpy(_shadow.data() + offset, data, static_cast<size_t>(size));
+    markDirty(offset, size);
+    return true;
+}
+
+uint8_t* ShadowedDeviceBuffer::data() {
+    return _created ? _shadow.data() : nullptr;
+}
+
+const uint8_t* ShadowedDeviceBuffer::data() const {
+    return _created ? _shadow.data() : nullptr;
+}
+
+void ShadowedDeviceBuffer::markDirty(uint64_t offset, uint64_t size) {
+    if (!_created || size == 0 || offset >= _size) {
+        return;
+    }
+
+    const uint64_t end = std::min(offset + size, _size);
+    const uint64_t first = offset >> _granularityShift;
+    const uint64_t last = (end - 1) >> _granularityShift;
+
+    for (uint64_t granule = first; granule <= last; ++granule) {
+        uint64_t& word = _dirtyBits[granule / BITS_PER_WORD];
+        const uint64_t bit = 1ull << (granule % BITS_PER_WORD);
+        if (!(word & bit)) {
+            word |= bit;
+            ++_dirtyGranules;
+        }
+    }
+}
+
+void ShadowedDeviceBuffer::markAllDirty() {
+    markDirty(0, _size);
+}
+
+std::vector<ShadowedDeviceBuffer::Span> ShadowedDeviceBuffer::collectSpans() const {
+    std::vector<Span> spans;
+    if (_dirtyGranules == 0) {
+        return spans;
+    }
+
+    const uint64_t granuleCount = (_size + _granularity - 1) >> _granularityShift;
+    uint64_t runBegin = 0;
+    uint64_t runEnd = 0;  // Exclusive, in granules
+    bool inRun = false;
+
+    auto emit = [&]() {
+        const uint64_t begin = runBegin << _granularityShift;
+        const uint64_t end = std::min(runEnd << _granularityShift, _size);
+        spans.push_back({begin, end - begin});
+    };
+
+    // Walk set bits word by word so clean regions are skipped quickly
+    for (size_t wordIndex = 0; wordIndex < _dirtyBits.size(); ++wordIndex) {
+        uint64_t word = _dirtyBits[wordIndex];
+        while (word) {
+            const uint64_t granule = wordIndex * BITS_PER_WORD + std::countr_zero(word);
+            word &= word - 1;
+            if (granule >= granuleCount) {
+                break;
+            }
+
+            if (inRun && granule <= runEnd + _mergeGap) {
+                runEnd = granule + 1;
+                continue;
+            }
+            if (inRun) {
+                emit();
+            }
+            runBegin = granule;
+            runEnd = granule + 1;
+            inRun = true;
+        }
+    }
+    if (inRun) {
+        emit();
+    }
+    return spans;
+}
+
+void ShadowedDeviceBuffer::clearDirty() {
+    std::fill(_dirtyBits.begin(), _dirtyBits.end(), 0);
+    _dirtyGranules = 0;
+}
+
+void ShadowedDeviceBuffer::recordUpload(const std::vector<Span>& spans) {
+    ++_stats.uploadCount;
+    _stats.uploadedSpans += spans.size();
+    for (const Span& span : spans) {
+        _stats.uploadedBytes += span.size;
+    }
+}
+
+bool ShadowedDeviceBuffer::upload() {
+    if (!_created) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Buffer not created");
+        return false;
+    }
+
+    std::vector<Span> spans = collectSpans();
+    if (spans.empty()) {
+        return true;
+    }
+
+    std::vector<BufferWriteDesc> writes;
+    writes.reserve(spans.size());
+    for (const Span& span : spans) {
+        BufferWriteDesc write;
+        write.buffer = _buffer;
+        write.offset = span.offset;
+        write.data = _shadow.data() + span.offset;
+        write.size = span.size;
+        writes.push_back(write);
+    }
+
+    // Queue writes copy the data, so the shadow may be modified right after
+    if (!_queue->writeBuffers(writes)) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Failed to upload dirty spans");
+        return false;
+    }
+
+    recordUpload(spans);
+    clearDirty();
+    return true;
+}
+
+bool ShadowedDeviceBuffer::upload(UploadBatcher& batcher) {
+    if (!_created) {
+        LOG_ERROR("ShadowedDeviceBuffer", "Buffer not created");
+        return false;
+    }
+
+    std::vector<Span> spans = collectSpans();
+    if (spans.empty()) {
+        return true;
+    }
+
+    // enqueue() copies into the arena right away, same as a queue write
+    for (const Span& span : spans) {
+        if (!batcher.enqueue(_shadow.data() + span.offset, span.size, _buffer, span.offset)) {
+            LOG_ERROR("ShadowedDeviceBuffer", "Failed to queue dirty span on upload batcher");
+            return false;
+        }
+    }
+
+    recordUpload(spans);
+    clearDirty();
+    return true;
+}
+
+bool ShadowedDeviceBuffer::isDirty() const {
+    return _dirtyGranules > 0;
+}
+
+uint64_t ShadowedDeviceBuffer::getDirtyBytes() const {
+    return std::min(_dirtyGranules << _granularityShift, _size);
+}
+
+uint64_t ShadowedDeviceBuffer::getGranularity() const {
+    return _granularity;
+}
+
+ShadowedDeviceBuffer::Stats ShadowedDeviceBuffer::getStats() const {
+    return _stats;
+}
+
+const std::shared_ptr<DeviceBuffer>& ShadowedDeviceBuffer::getDeviceBuffer() const {
+    return _buffer;
+}
+
+uint64_t ShadowedDeviceBuffer::getSize() const {
+    return _size;
+}
+
+BufferUsage ShadowedDeviceBuffer::getUsage() const {
+    return _buffer ? _buffer->getUsage() : BufferUsage::None;
+}
+
+const std::string& ShadowedDeviceBuffer::getDebugName() const {
+    return _debugName;
+}
+
+NativeBufferHandle ShadowedDeviceBuffer::getNativeHandle() const {
+    return _buffer ? _buffer->getNativeHandle() : NativeBufferHandle();
+}
+
+bool ShadowedDeviceBuffer::isValid() const {
+    return _created && _buffer && _buffer->isValid();
+}
+
+BufferState ShadowedDeviceBuffer::getState() const {
+    return _buffer ? _buffer->getState() : BufferState::Uninitialized;
+}
+
+MemoryLocation ShadowedDeviceBuffer::getMemoryLocation() const {
+    return MemoryLocation::DeviceLocal;
+}
+
+AccessPattern ShadowedDeviceBuffer::getAccessPattern() const {
+    return AccessPattern::Dynamic;
+}
+
+} // namespace pers
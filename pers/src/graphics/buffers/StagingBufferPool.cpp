@@ -0,0 +1,208 @@
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include "pers/graphics/buffers/INativeMappableBuffer.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <chrono>
+#include <sstream>
+
+namespace pers {
+
+StagingBufferPool::StagingBufferPool(const std::shared_ptr<IResourceFactory>& resourceFactory,
+                                     const std::shared_ptr<IQueue>& queue)
+    : _resourceFactory(resourceFactory)
+    , _queue(queue)
+    , _maxPooledBytes(DEFAULT_MAX_POOLED_BYTES) {
+    if (!_resourceFactory) {
+        LOG_ERROR("StagingBufferPool", "Created with null resource factory");
+    }
+    if (!_queue) {
+        LOG_ERROR("StagingBufferPool", "Created with null queue");
+    }
+}
+
+StagingBufferPool::~StagingBufferPool() {
+    // Outstanding callbacks hold weak references and drop their buffer
+    trim();
+}
+
+uint32_t StagingBufferPool::getSizeClassIndex(uint64_t size) {
+    uint32_t shift = MIN_SIZE_CLASS_SHIFT;
+    while (shift < MAX_SIZE_CLASS_SHIFT && (1ull << shift) < size) {
+        ++shift;
+    }
+    return shift - MIN_SIZE_CLASS_SHIFT;
+}
+
+uint64_t StagingBufferPool::getSizeClassSize(uint64_t size) {
+    if (size == 0 || size > (1ull << MAX_SIZE_CLASS_SHIFT)) {
+        return 0;
+    }
+    return 1ull << (getSizeClassIndex(size) + MIN_SIZE_CLASS_SHIFT);
+}
+
+std::shared_ptr<INativeMappableBuffer> StagingBufferPool::acquire(uint64_t size) {
+    if (size == 0) {
+        LOG_ERROR("StagingBufferPool", "Invalid buffer size (0)");
+        return nullptr;
+    }
+
+    if (!_resourceFactory) {
+        LOG_ERROR("StagingBufferPool", "Resource factory is null");
+        return nullptr;
+    }
+
+    collect();
+
+    uint64_t classSize = getSizeClassSize(size);
+    if (classSize != 0) {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto& freeList = _freeLists[getSizeClassIndex(size)];
+        if (!freeList.empty()) {
+            auto buffer = std::move(freeList.back());
+            freeList.pop_back();
+            _stats.pooledBytes -= buffer->getSize();
+            ++_stats.reuses;
+            return buffer;
+        }
+    }
+
+    // Oversized requests get an exact, unpooled buffer
+    BufferDesc stagingDesc;
+    stagingDesc.size = classSize != 0 ? classSize : size;
+    stagingDesc.usage = BufferUsage::MapWrite | BufferUsage::CopySrc;
+    stagingDesc.memoryLocation = MemoryLocation::HostVisible;
+    stagingDesc.accessPattern = AccessPattern::Staging;
+    stagingDesc.mappedAtCreation = true;
+    stagingDesc.debugName = "PooledStagingBuffer";
+
+    auto buffer = _resourceFactory->createMappableBuffer(stagingDesc);
+    if (!buffer || !buffer->getMappedData()) {
+        LOG_ERROR("StagingBufferPool", "Failed to create staging buffer");
+        return nullptr;
+    }
+
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        ++_stats.allocations;
+    }
+
+    return buffer;
+}
+
+void StagingBufferPool::release(const std::shared_ptr<INativeMappableBuffer>& buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    if (getSizeClassSize(buffer->getSize()) != buffer->getSize()) {
+        // Not one of ours (or oversized), let it go
+        return;
+    }
+
+    if (!_queue) {
+        return;
+    }
+
+    // Unmap so the buffer is usable by the submitted copies
+    if (buffer->isMapped()) {
+        buffer->unmap();
+    }
+
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        ++_stats.inFlight;
+    }
+
+    // Registered without holding the lock, the callback may fire synchronously
+    std::weak_ptr<StagingBufferPool> weakPool = weak_from_this();
+    bool registered = _queue->onSubmittedWorkDone([weakPool, buffer](bool success) {
+        auto pool = weakPool.lock();
+        if (pool && success) {
+            pool->onRetired(buffer);
+        } else if (pool) {
+            auto guard = makeLockGuard(pool->_mutex, PERS_SOURCE_LOC);
+            --pool->_stats.inFlight;
+        }
+    });
+
+    if (!registered) {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        --_stats.inFlight;
+    }
+}
+
+void StagingBufferPool::onRetired(const std::shared_ptr<INativeMappableBuffer>& buffer) {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _retired.push_back(buffer);
+}
+
+void StagingBufferPool::collect() {
+    if (_queue) {
+        _queue->pollSubmittedWork(false);
+    }
+
+    std::vector<std::shared_ptr<INativeMappableBuffer>> retired;
+    {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        retired.swap(_retired);
+    }
+
+    // mapAsync is issued outside the lock; its callback may run synchronously
+    std::vector<PendingMap> newMaps;
+    newMaps.reserve(retired.size());
+    for (auto& buffer : retired) {
+        newMaps.push_back(PendingMap{buffer, buffer->mapAsync(MapMode::Write)});
+    }
+
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (auto& pending : newMaps) {
+        _pendingMaps.push_back(std::move(pending));
+    }
+
+    for (size_t i = 0; i < _pendingMaps.size();) {
+        auto& pending = _pendingMaps[i];
+        if (pending.future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++i;
+            continue;
+        }
+
+        MappedData mapped = pending.future.get();
+        auto buffer = std::move(pending.buffer);
+        _pendingMaps[i] = std::move(_pendingMaps.back());
+        _pendingMaps.pop_back();
+        --_stats.inFlight;
+
+        if (!mapped.data()) {
+            LOG_WARNING("StagingBufferPool", "Failed to re-map retired staging buffer, dropping it");
+            continue;
+        }
+
+        if (_stats.pooledBytes + buffer->getSize() > _maxPooledBytes) {
+            continue;
+        }
+
+        _stats.pooledBytes += buffer->getSize();
+        _freeLists[getSizeClassIndex(buffer->getSize())].push_back(std::move(buffer));
+    }
+}
+
+void StagingBufferPool::trim() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    for (auto& freeList : _freeLists) {
+        freeList.clear();
+    }
+    _stats.pooledBytes = 0;
+}
+
+void StagingBufferPool::setMaxPooledBytes(uint64_t maxBytes) {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    _maxPooledBytes = maxBytes;
+}
+
+StagingBufferPool::Stats StagingBufferPool::getStats() const {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    return _stats;
+}
+
+} // namespace pers
@@ -0,0 +1,208 @@
+#include "pers/graphics/buffers/UploadBatcher.h"
+#include "pers/graphics/buffers/BufferTypes.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <sstream>
+
+namespace pers {
+
+static uint64_t alignCopySize(uint64_t size) {
+    const uint64_t alignment = BufferAlignment::COPY_BUFFER_OFFSET;
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+UploadBatcher::UploadBatcher(const std::shared_ptr<ILogicalDevice>& device, uint64_t arenaSize)
+    : _device(device)
+    , _arenaSize(alignCopySize(arenaSize))
+    , _arenaOffset(0)
+    , _pendingBytes(0) {
+    if (!_device) {
+        LOG_ERROR("UploadBatcher", "Created with null device");
+    }
+}
+
+UploadBatcher::~UploadBatcher() {
+    if (!_copies.empty()) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "UploadBatcher", PERS_SOURCE_LOC,
+            "Destroyed with %zu unflushed uploads", _copies.size());
+    }
+    // Arenas were never submitted or were already submitted, either way safe to release
+    retire();
+    _arenas.clear();
+}
+
+bool UploadBatcher::beginArena(uint64_t minSize) {
+    const auto& pool = _device->getStagingBufferPool();
+
+    auto arena = std::make_shared<ImmediateStagingBuffer>();
+    uint64_t size = std::max(_arenaSize, minSize);
+    bool created = pool ? arena->create(size, pool, "UploadBatcherArena")
+                        : arena->create(size, _device, "UploadBatcherArena");
+    if (!created) {
+        LOG_ERROR("UploadBatcher", "Failed to create staging arena");
+        return false;
+    }
+
+    _arenas.push_back(arena);
+    _arenaOffset = 0;
+    return true;
+}
+
+bool UploadBatcher::enqueue(const void* data,
+                            uint64_t size,
+                            const std::shared_ptr<DeviceBuffer>& destination,
+                            uint64_t dstOffset) {
+    if (!_device) {
+        LOG_ERROR("UploadBatcher", "Device is null");
+        return false;
+    }
+
+    if (!data || size == 0) {
+        LOG_ERROR("UploadBatcher", "Invalid upload data");
+        return false;
+    }
+
+    if (!destination || !destination->isValid()) {
+        LOG_ERROR("UploadBatcher", "Destination buffer is invalid");
+        return false;
+    }
+
+    if (dstOffset % BufferAlignment::COPY_BUFFER_OFFSET != 0) {
+        LOG_ERROR("UploadBatcher", "Destination offset must be 4-byte aligned");
+        return false;
+    }
+
+    uint64_t alignedSize = alignCopySize(size);
+    if (dstOffset + alignedSize > destination->getSize()) {
+        std::stringstream ss;
+        ss << "Upload exceeds destination '" << destination->getDebugName() << "' (offset="
+           << dstOffset << ", size=" << alignedSize << ", buffer=" << destination->getSize() << ")";
+        LOG_ERROR("UploadBatcher", ss.str().c_str());
+        return false;
+    }
+
+    // Oversized uploads go into their own arena sized to fit
+    if (_arenas.empty() || _arenaOffset + alignedSize > _arenas.back()->getSize()) {
+        if (!beginArena(alignedSize)) {
+            return false;
+        }
+    }
+
+    size_t arenaIndex = _arenas.size() - 1;
+    uint64_t srcOffset = _arenaOffset;
+    if (_arenas.back()->writeBytes(data, size, srcOffset) != size) {
+        LOG_ERROR("UploadBatcher", "Failed to write upload data to arena");
+        return false;
+    }
+    _arenaOffset += alignedSize;
+    _pendingBytes += size;
+
+    // Merge with the previous copy if both ranges are contiguous
+    if (!_copies.empty()) {
+        PendingCopy& last = _copies.back();
+        if (last.arenaIndex == arenaIndex &&
+            last.destination == destination &&
+            last.size % BufferAlignment::COPY_BUFFER_OFFSET == 0 &&
+            last.srcOffset + last.size == srcOffset &&
+            last.dstOffset + last.size == dstOffset) {
+            last.size += size;
+            return true;
+        }
+    }
+
+    _copies.push_back(PendingCopy{arenaIndex, srcOffset, destination, dstOffset, size});
+    return true;
+}
+
+bool UploadBatcher::record(const std::shared_ptr<ICommandEncoder>& encoder) {
+    if (!encoder) {
+        LOG_ERROR("UploadBatcher", "Command encoder is null");
+        return false;
+    }
+
+    for (auto& arena : _arenas) {
+        arena->finalize();
+    }
+
+    bool success = true;
+    for (const auto& copy : _copies) {
+        BufferCopyDesc copyDesc;
+        copyDesc.srcOffset = copy.srcOffset;
+        copyDesc.dstOffset = copy.dstOffset;
+        copyDesc.size = copy.size;
+
+        if (!encoder->uploadToDeviceBuffer(_arenas[copy.arenaIndex], copy.destination, copyDesc)) {
+            LOG_ERROR("UploadBatcher", "Failed to record upload copy");
+            success = false;
+        }
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Debug, "UploadBatcher", PERS_SOURCE_LOC,
+        "Recorded %zu copies (%llu bytes) from %zu arenas",
+        _copies.size(), static_cast<unsigned long long>(_pendingBytes), _arenas.size());
+
+    _recordedArenas.insert(_recordedArenas.end(), _arenas.begin(), _arenas.end());
+    _arenas.clear();
+    _copies.clear();
+    _arenaOffset = 0;
+    _pendingBytes = 0;
+    return success;
+}
+
+void UploadBatcher::retire() {
+    // Destroying the arenas hands pooled buffers back for recycling
+    _recordedArenas.clear();
+}
+
+bool UploadBatcher::flush() {
+    if (_copies.empty()) {
+        return true;
+    }
+
+    if (!_device) {
+        LOG_ERROR("UploadBatcher", "Device is null");
+        return false;
+    }
+
+    auto encoder = _device->createCommandEncoder();
+    if (!encoder) {
+        LOG_ERROR("UploadBatcher", "Failed to create command encoder");
+        return false;
+    }
+
+    bool recorded = record(encoder);
+
+    auto commandBuffer = encoder->finish();
+    if (!commandBuffer) {
+        LOG_ERROR("UploadBatcher", "Failed to finish upload command buffer");
+        retire();
+        return false;
+    }
+
+    auto queue = _device->getQueue();
+    if (!queue || !queue->submit(commandBuffer)) {
+        LOG_ERROR("UploadBatcher", "Failed to submit upload command buffer");
+        retire();
+        return false;
+    }
+
+    retire();
+    return recorded;
+}
+
+uint64_t UploadBatcher::getPendingBytes() const {
+    return _pendingBytes;
+}
+
+size_t UploadBatcher::getPendingCopyCount() const {
+    return _copies.size();
+}
+
+} // namespace pers
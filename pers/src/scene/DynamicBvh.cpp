@@ -0,0 +1,320 @@
+#include "pers/scene/DynamicBvh.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <utility>
+
+namespace pers {
+
+namespace {
+
+struct Box {
+    float min[3];
+    float max[3];
+};
+
+template<typename A, typename B>
+Box unionOf(const A& a, const B& b) {
+    Box box;
+    for (int i = 0; i < 3; ++i) {
+        box.min[i] = std::min(a.min[i], b.min[i]);
+        box.max[i] = std::max(a.max[i], b.max[i]);
+    }
+    return box;
+}
+
+template<typename A>
+float surfaceArea(const A& box) {
+    const float x = box.max[0] - box.min[0];
+    const float y = box.max[1] - box.min[1];
+    const float z = box.max[2] - box.min[2];
+    return 2.0f * (x * y + y * z + z * x);
+}
+
+template<typename A>
+void assignBox(A& target, const Box& box) {
+    for (int i = 0; i < 3; ++i) {
+        target.min[i] = box.min[i];
+        target.max[i] = box.max[i];
+    }
+}
+
+} // anonymous namespace
+
+DynamicBvh::DynamicBvh(float margin) : _margin(margin) {
+}
+
+uint32_t DynamicBvh::allocateNode() {
+    if (_freeList == INVALID_PROXY) {
+        _nodes.emplace_back();
+        return static_cast<uint32_t>(_nodes.size() - 1);
+    }
+    const uint32_t index = _freeList;
+    _freeList = _nodes[index].parent;
+    _nodes[index] = Node{};
+    return index;
+}
+
+void DynamicBvh::freeNode(uint32_t index) {
+    _nodes[index].parent = _freeList;
+    _nodes[index].height = -1;
+    _freeList = index;
+}
+
+uint32_t DynamicBvh::insert(const float min[3], const float max[3], uint32_t userData) {
+    const uint32_t leaf = allocateNode();
+    Node& node = _nodes[leaf];
+    for (int i = 0; i < 3; ++i) {
+        node.min[i] = min[i] - _margin;
+        node.max[i] = max[i] + _margin;
+    }
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(leaf);
+    ++_leafCount;
+    return leaf;
+}
+
+void DynamicBvh::remove(uint32_t proxy) {
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --_leafCount;
+}
+
+bool DynamicBvh::move(uint32_t proxy, const float min[3], const float max[3]) {
+    Node& node = _nodes[proxy];
+    bool contained = true;
+    for (int i = 0; i < 3 && contained; ++i) {
+        contained = node.min[i] <= min[i] && max[i] <= node.max[i];
+    }
+    if (contained) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    for (int i = 0; i < 3; ++i) {
+        _nodes[proxy].min[i] = min[i] - _margin;
+        _nodes[proxy].max[i] = max[i] + _margin;
+    }
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicBvh::insertLeaf(uint32_t leaf) {
+    if (_root == INVALID_PROXY) {
+        _root = leaf;
+        _nodes[leaf].parent = INVALID_PROXY;
+        return;
+    }
+
+    // Descend while a child is cheaper than pairing with the current node
+    uint32_t index = _root;
+    while (!_nodes[index].isLeaf()) {
+        const Node& node = _nodes[index];
+        const Node& leafNode = _nodes[leaf];
+        const float area = surfaceArea(node);
+        const float combinedArea = surfaceArea(unionOf(node, leafNode));
+        const float cost = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](uint32_t child) {
+            const Node& childNode = _nodes[child];
+            const float combined = surfaceArea(unionOf(childNode, leafNode));
+            return (childNode.isLeaf() ? combined : combined - surfaceArea(childNode)) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const uint32_t sibling = index;
+    const uint32_t oldParent = _nodes[sibling].parent;
+    const uint32_t newParent = allocateNode();  // May reallocate _nodes
+    Node& parentNode = _nodes[newParent];
+    parentNode.parent = oldParent;
+    assignBox(parentNode, unionOf(_nodes[sibling], _nodes[leaf]));
+    parentNode.height = _nodes[sibling].height + 1;
+    parentNode.child1 = sibling;
+    parentNode.child2 = leaf;
+
+    if (oldParent != INVALID_PROXY) {
+        Node& old = _nodes[oldParent];
+        (old.child1 == sibling ? old.child1 : old.child2) = newParent;
+    } else {
+        _root = newParent;
+    }
+    _nodes[sibling].parent = newParent;
+    _nodes[leaf].parent = newParent;
+
+    for (index = _nodes[leaf].parent; index != INVALID_PROXY; index = _nodes[index].parent) {
+        index = balance(index);
+        refit(index);
+    }
+}
+
+void DynamicBvh::removeLeaf(uint32_t leaf) {
+    if (leaf == _root) {
+        _root = INVALID_PROXY;
+        return;
+    }
+
+    const uint32_t parent = _nodes[leaf].parent;
+    const uint32_t grandParent = _nodes[parent].parent;
+    const uint32_t sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    if (grandParent == INVALID_PROXY) {
+        _root = sibling;
+        _nodes[sibling].parent = INVALID_PROXY;
+        freeNode(parent);
+        return;
+    }
+
+    Node& grand = _nodes[grandParent];
+    (grand.child1 == parent ? grand.child1 : grand.child2) = sibling;
+    _nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    for (uint32_t index = grandParent; index != INVALID_PROXY; index = _nodes[index].parent) {
+        index = balance(index);
+        refit(index);
+    }
+}
+
+void DynamicBvh::refit(uint32_t index) {
+    Node& node = _nodes[index];
+    const Node& child1 = _nodes[node.child1];
+    const Node& child2 = _nodes[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    assignBox(node, unionOf(child1, child2));
+}
+
+// Rotate the taller grandchild up if the subtree at index is unbalanced;
+// returns the subtree's new root
+uint32_t DynamicBvh::balance(uint32_t iA) {
+    Node& a = _nodes[iA];
+    if (a.isLeaf() || a.height < 2) {
+        return iA;
+    }
+
+    const uint32_t iB = a.child1;
+    const uint32_t iC = a.child2;
+    const int32_t difference = _nodes[iC].height - _nodes[iB].height;
+    if (difference >= -1 && difference <= 1) {
+        return iA;
+    }
+
+    // up is the taller child, it takes A's place; A keeps the other child
+    const bool rotateC = difference > 1;
+    const uint32_t iUp = rotateC ? iC : iB;
+    const uint32_t iKeep = rotateC ? iB : iC;
+    Node& up = _nodes[iUp];
+    const uint32_t iF = up.child1;
+    const uint32_t iG = up.child2;
+
+    up.child1 = iA;
+    up.parent = a.parent;
+    a.parent = iUp;
+    if (up.parent != INVALID_PROXY) {
+        Node& parent = _nodes[up.parent];
+        (parent.child1 == iA ? parent.child1 : parent.child2) = iUp;
+    } else {
+        _root = iUp;
+    }
+
+    // The taller grandchild stays under up, the other moves to A
+    const bool fTaller = _nodes[iF].height > _nodes[iG].height;
+    const uint32_t iStay = fTaller ? iF : iG;
+    const uint32_t iMove = fTaller ? iG : iF;
+    up.child2 = iStay;
+    (rotateC ? a.child2 : a.child1) = iMove;
+    _nodes[iMove].parent = iA;
+
+    const Node& keep = _nodes[iKeep];
+    const Node& moved = _nodes[iMove];
+    assignBox(a, unionOf(keep, moved));
+    a.height = 1 + std::max(keep.height, moved.height);
+    const Node& stay = _nodes[iStay];
+    assignBox(up, unionOf(a, stay));
+    up.height = 1 + std::max(a.height, stay.height);
+    return iUp;
+}
+
+void DynamicBvh::collectLeaves(uint32_t index, std::vector<uint32_t>& userData, std::vector<uint32_t>& stack) const {
+    const size_t base = stack.size();
+    stack.push_back(index);
+    while (stack.size() > base) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (node.isLeaf()) {
+            userData.push_back(node.userData);
+        } else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicBvh::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& userData) const {
+    PERS_PROFILE_SCOPE("DynamicBvh::queryFrustum");
+    if (_root == INVALID_PROXY) {
+        return;
+    }
+
+    float absNormals[6][3];
+    for (int p = 0; p < 6; ++p) {
+        for (int i = 0; i < 3; ++i) {
+            absNormals[p][i] = std::fabs(frustum.planes[p][i]);
+        }
+    }
+
+    constexpr uint32_t ALL_PLANES = 0x3F;
+    std::vector<std::pair<uint32_t, uint32_t>> stack;  // Node, planes still straddled
+    std::vector<uint32_t> collectStack;
+    stack.reserve(64);
+    stack.emplace_back(_root, ALL_PLANES);
+
+    while (!stack.empty()) {
+        const auto [index, planeMask] = stack.back();
+        stack.pop_back();
+        const Node& node = _nodes[index];
+
+        const float center[3] = {(node.min[0] + node.max[0]) * 0.5f, (node.min[1] + node.max[1]) * 0.5f,
+                                 (node.min[2] + node.max[2]) * 0.5f};
+        const float extent[3] = {(node.max[0] - node.min[0]) * 0.5f, (node.max[1] - node.min[1]) * 0.5f,
+                                 (node.max[2] - node.min[2]) * 0.5f};
+
+        uint32_t mask = planeMask;
+        bool outside = false;
+        for (uint32_t bits = planeMask; bits && !outside; bits &= bits - 1) {
+            const int p = std::countr_zero(bits);
+            const auto& plane = frustum.planes[p];
+            const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+            const float reach = absNormals[p][0] * extent[0] + absNormals[p][1] * extent[1] +
+                                absNormals[p][2] * extent[2];
+            outside = distance < -reach;
+            if (distance >= reach) {
+                mask &= ~(1u << p);  // Fully inside this plane, children skip it
+            }
+        }
+        if (outside) {
+            continue;
+        }
+
+        if (node.isLeaf()) {
+            userData.push_back(node.userData);
+        } else if (mask == 0) {
+            collectLeaves(index, userData, collectStack);
+        } else {
+            stack.emplace_back(node.child1, mask);
+            stack.emplace_back(node.child2, mask);
+        }
+    }
+}
+
+} // namespace pers
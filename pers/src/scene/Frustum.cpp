@@ -0,0 +1,369 @@
+#include "pers/scene/Frustum.h"
+#include "pers/utils/CpuFeatures.h"
+#include "pers/utils/Profiler.h"
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PERS_CULL_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PERS_CULL_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only emit wider instructions inside functions that opt in
+#if defined(__GNUC__) || defined(__clang__)
+#define PERS_TARGET(features) __attribute__((target(features)))
+#else
+#define PERS_TARGET(features)
+#endif
+
+namespace pers {
+
+namespace {
+
+// Planes split into components, |normal| precomputed for the extent term
+struct PlaneSet {
+    float nx[6], ny[6], nz[6], d[6];
+    float ax[6], ay[6], az[6];
+
+    explicit PlaneSet(const Frustum& frustum) {
+        for (int i = 0; i < 6; ++i) {
+            nx[i] = frustum.planes[i][0];
+            ny[i] = frustum.planes[i][1];
+            nz[i] = frustum.planes[i][2];
+            d[i] = frustum.planes[i][3];
+            ax[i] = std::fabs(nx[i]);
+            ay[i] = std::fabs(ny[i]);
+            az[i] = std::fabs(nz[i]);
+        }
+    }
+};
+
+struct BoundsView {
+    const float* cx;
+    const float* cy;
+    const float* cz;
+    const float* ex;
+    const float* ey;
+    const float* ez;
+    const float* radius;
+};
+
+// Each kernel culls [begin, end) and returns the end of the written indices
+uint32_t* cullScalar(const PlaneSet& planes, const BoundsView& b, uint32_t begin, uint32_t end, uint32_t* out) {
+    for (uint32_t i = begin; i < end; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6 && inside; ++p) {
+            const float distance = planes.nx[p] * b.cx[i] + planes.ny[p] * b.cy[i] + planes.nz[p] * b.cz[i] + planes.d[p];
+            const float reach = b.radius[i] + planes.ax[p] * b.ex[i] + planes.ay[p] * b.ey[i] + planes.az[p] * b.ez[i];
+            inside = distance >= -reach;
+        }
+        if (inside) {
+            *out++ = i;
+        }
+    }
+    return out;
+}
+
+inline uint32_t* appendMask(uint32_t mask, uint32_t base, uint32_t* out) {
+    while (mask) {
+        *out++ = base + static_cast<uint32_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+#if PERS_CULL_X86
+
+// SSE2 is part of x86-64, no target attribute needed
+uint32_t* cullSSE2(const PlaneSet& planes, const BoundsView& b, uint32_t begin, uint32_t end, uint32_t* out) {
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 cx = _mm_loadu_ps(b.cx + i), cy = _mm_loadu_ps(b.cy + i), cz = _mm_loadu_ps(b.cz + i);
+        const __m128 ex = _mm_loadu_ps(b.ex + i), ey = _mm_loadu_ps(b.ey + i), ez = _mm_loadu_ps(b.ez + i);
+        const __m128 radius = _mm_loadu_ps(b.radius + i);
+
+        __m128 outside = _mm_setzero_ps();
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx), _mm_set1_ps(planes.d[p]));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz));
+            __m128 reach = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.ax[p]), ex));
+            reach = _mm_add_ps(reach, _mm_mul_ps(_mm_set1_ps(planes.ay[p]), ey));
+            reach = _mm_add_ps(reach, _mm_mul_ps(_mm_set1_ps(planes.az[p]), ez));
+            // distance + reach < 0  <=>  distance < -reach
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+        }
+        out = appendMask(static_cast<uint32_t>(~_mm_movemask_ps(outside)) & 0xF, i, out);
+    }
+    return cullScalar(planes, b, i, end, out);
+}
+
+PERS_TARGET("avx2")
+uint32_t* cullAVX2(const PlaneSet& planes, const BoundsView& b, uint32_t begin, uint32_t end, uint32_t* out) {
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(b.cx + i), cy = _mm256_loadu_ps(b.cy + i), cz = _mm256_loadu_ps(b.cz + i);
+        const __m256 ex = _mm256_loadu_ps(b.ex + i), ey = _mm256_loadu_ps(b.ey + i), ez = _mm256_loadu_ps(b.ez + i);
+        const __m256 radius = _mm256_loadu_ps(b.radius + i);
+
+        __m256 outside = _mm256_setzero_ps();
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx), _mm256_set1_ps(planes.d[p]));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz));
+            __m256 reach = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(planes.ax[p]), ex));
+            reach = _mm256_add_ps(reach, _mm256_mul_ps(_mm256_set1_ps(planes.ay[p]), ey));
+            reach = _mm256_add_ps(reach, _mm256_mul_ps(_mm256_set1_ps(planes.az[p]), ez));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        out = appendMask(static_cast<uint32_t>(~_mm256_movemask_ps(outside)) & 0xFF, i, out);
+    }
+    return cullSSE2(planes, b, i, end, out);
+}
+
+#endif // PERS_CULL_X86
+
+#if PERS_CULL_NEON
+
+uint32_t* cullNEON(const PlaneSet& planes, const BoundsView& b, uint32_t begin, uint32_t end, uint32_t* out) {
+    static const uint32_t LANE_BITS[4] = {1, 2, 4, 8};
+    const uint32x4_t laneBits = vld1q_u32(LANE_BITS);
+
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const float32x4_t cx = vld1q_f32(b.cx + i), cy = vld1q_f32(b.cy + i), cz = vld1q_f32(b.cz + i);
+        const float32x4_t ex = vld1q_f32(b.ex + i), ey = vld1q_f32(b.ey + i), ez = vld1q_f32(b.ez + i);
+        const float32x4_t radius = vld1q_f32(b.radius + i);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (int p = 0; p < 6; ++p) {
+            float32x4_t distance = vmlaq_n_f32(vdupq_n_f32(planes.d[p]), cx, planes.nx[p]);
+            distance = vmlaq_n_f32(distance, cy, planes.ny[p]);
+            distance = vmlaq_n_f32(distance, cz, planes.nz[p]);
+            float32x4_t reach = vmlaq_n_f32(radius, ex, planes.ax[p]);
+            reach = vmlaq_n_f32(reach, ey, planes.ay[p]);
+            reach = vmlaq_n_f32(reach, ez, planes.az[p]);
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(distance, reach), vdupq_n_f32(0.0f)));
+        }
+        const uint32_t mask = vaddvq_u32(vandq_u32(outside, laneBits));
+        out = appendMask(~mask & 0xF, i, out);
+    }
+    return cullScalar(planes, b, i, end, out);
+}
+
+#endif // PERS_CULL_NEON
+
+CullKernel detectBestKernel() {
+#if PERS_CULL_X86
+    return getCpuFeatures().avx2 ? CullKernel::AVX2 : CullKernel::SSE2;
+#elif PERS_CULL_NEON
+    return CullKernel::NEON;
+#else
+    return CullKernel::Scalar;
+#endif
+}
+
+std::atomic<CullKernel>& activeKernel() {
+    static std::atomic<CullKernel> kernel{detectBestKernel()};
+    return kernel;
+}
+
+bool isCullKernelSupported(CullKernel kernel) {
+    switch (kernel) {
+    case CullKernel::Scalar:
+        return true;
+#if PERS_CULL_X86
+    case CullKernel::SSE2:
+        return true;
+    case CullKernel::AVX2:
+        return getCpuFeatures().avx2;
+#elif PERS_CULL_NEON
+    case CullKernel::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+void normalizePlane(std::array<float, 4>& plane) {
+    const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+    if (length > 0.0f) {
+        for (float& value : plane) {
+            value /= length;
+        }
+    }
+}
+
+} // anonymous namespace
+
+Frustum Frustum::fromViewProjection(const float matrix[16]) {
+    // Row r of a column-major matrix is (m[r], m[4 + r], m[8 + r], m[12 + r])
+    auto row = [matrix](int r) {
+        return std::array<float, 4>{matrix[r], matrix[4 + r], matrix[8 + r], matrix[12 + r]};
+    };
+    const auto r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+    Frustum frustum;
+    for (int i = 0; i < 4; ++i) {
+        frustum.planes[0][i] = r3[i] + r0[i];  // Left
+        frustum.planes[1][i] = r3[i] - r0[i];  // Right
+        frustum.planes[2][i] = r3[i] + r1[i];  // Bottom
+        frustum.planes[3][i] = r3[i] - r1[i];  // Top
+        frustum.planes[4][i] = r2[i];          // Near, z >= 0
+        frustum.planes[5][i] = r3[i] - r2[i];  // Far, z <= w
+    }
+    for (auto& plane : frustum.planes) {
+        normalizePlane(plane);
+    }
+    return frustum;
+}
+
+Frustum::Result Frustum::testSphere(const float center[3], float radius) const {
+    Result result = Result::Inside;
+    for (const auto& plane : planes) {
+        const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+        if (distance < -radius) {
+            return Result::Outside;
+        }
+        if (distance < radius) {
+            result = Result::Intersects;
+        }
+    }
+    return result;
+}
+
+Frustum::Result Frustum::testBox(const float min[3], const float max[3]) const {
+    const float center[3] = {(min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f};
+    const float extent[3] = {(max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f};
+
+    Result result = Result::Inside;
+    for (const auto& plane : planes) {
+        const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+        const float reach = std::fabs(plane[0]) * extent[0] + std::fabs(plane[1]) * extent[1] +
+                            std::fabs(plane[2]) * extent[2];
+        if (distance < -reach) {
+            return Result::Outside;
+        }
+        if (distance < reach) {
+            result = Result::Intersects;
+        }
+    }
+    return result;
+}
+
+uint32_t BoundsList::addSphere(const float center[3], float radius) {
+    const uint32_t index = size();
+    _centerX.push_back(center[0]);
+    _centerY.push_back(center[1]);
+    _centerZ.push_back(center[2]);
+    _extentX.push_back(0.0f);
+    _extentY.push_back(0.0f);
+    _extentZ.push_back(0.0f);
+    _radius.push_back(radius);
+    return index;
+}
+
+uint32_t BoundsList::addBox(const float min[3], const float max[3]) {
+    const float zero[3] = {0.0f, 0.0f, 0.0f};
+    const uint32_t index = addSphere(zero, 0.0f);
+    setBox(index, min, max);
+    return index;
+}
+
+void BoundsList::setSphere(uint32_t index, const float center[3], float radius) {
+    _centerX[index] = center[0];
+    _centerY[index] = center[1];
+    _centerZ[index] = center[2];
+    _extentX[index] = 0.0f;
+    _extentY[index] = 0.0f;
+    _extentZ[index] = 0.0f;
+    _radius[index] = radius;
+}
+
+void BoundsList::setBox(uint32_t index, const float min[3], const float max[3]) {
+    _centerX[index] = (min[0] + max[0]) * 0.5f;
+    _centerY[index] = (min[1] + max[1]) * 0.5f;
+    _centerZ[index] = (min[2] + max[2]) * 0.5f;
+    _extentX[index] = (max[0] - min[0]) * 0.5f;
+    _extentY[index] = (max[1] - min[1]) * 0.5f;
+    _extentZ[index] = (max[2] - min[2]) * 0.5f;
+    _radius[index] = 0.0f;
+}
+
+void BoundsList::clear() {
+    for (auto* values : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ, &_radius}) {
+        values->clear();
+    }
+}
+
+void BoundsList::reserve(uint32_t count) {
+    for (auto* values : {&_centerX, &_centerY, &_centerZ, &_extentX, &_extentY, &_extentZ, &_radius}) {
+        values->reserve(count);
+    }
+}
+
+uint32_t cullBounds(const Frustum& frustum, const BoundsList& bounds, std::vector<uint32_t>& visible) {
+    PERS_PROFILE_SCOPE("cullBounds");
+
+    const uint32_t count = bounds.size();
+    const size_t start = visible.size();
+    visible.resize(start + count);
+
+    const PlaneSet planes(frustum);
+    const BoundsView view{bounds._centerX.data(), bounds._centerY.data(), bounds._centerZ.data(),
+                          bounds._extentX.data(), bounds._extentY.data(), bounds._extentZ.data(),
+                          bounds._radius.data()};
+    uint32_t* out = visible.data() + start;
+    uint32_t* end = out;
+
+    switch (activeKernel().load(std::memory_order_relaxed)) {
+#if PERS_CULL_X86
+    case CullKernel::AVX2:
+        end = cullAVX2(planes, view, 0, count, out);
+        break;
+    case CullKernel::SSE2:
+        end = cullSSE2(planes, view, 0, count, out);
+        break;
+#elif PERS_CULL_NEON
+    case CullKernel::NEON:
+        end = cullNEON(planes, view, 0, count, out);
+        break;
+#endif
+    default:
+        end = cullScalar(planes, view, 0, count, out);
+        break;
+    }
+
+    const uint32_t written = static_cast<uint32_t>(end - out);
+    visible.resize(start + written);
+    return written;
+}
+
+CullKernel getCullKernel() {
+    return activeKernel().load(std::memory_order_relaxed);
+}
+
+bool setCullKernel(CullKernel kernel) {
+    if (!isCullKernelSupported(kernel)) {
+        return false;
+    }
+    activeKernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+const char* getCullKernelName(CullKernel kernel) {
+    switch (kernel) {
+    case CullKernel::Scalar: return "scalar";
+    case CullKernel::SSE2:   return "SSE2";
+    case CullKernel::AVX2:   return "AVX2";
+    case CullKernel::NEON:   return "NEON";
+    }
+    return "unknown";
+}
+
+} // namespace pers
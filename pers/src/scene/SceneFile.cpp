@@ -0,0 +1,639 @@
+#include "pers/scene/SceneFile.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace pers {
+
+namespace {
+
+constexpr char SCENE_MAGIC[8] = {'P', 'E', 'R', 'S', 'S', 'C', 'N', 'E'};
+constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+enum Section : uint32_t {
+    SECTION_PARENTS,
+    SECTION_MESH_INDICES,
+    SECTION_MATERIAL_INDICES,
+    SECTION_NAMES,
+    SECTION_POSITIONS,
+    SECTION_ROTATIONS,
+    SECTION_SCALES,
+    SECTION_BOUNDS_MIN,
+    SECTION_BOUNDS_MAX,
+    SECTION_MESHES,
+    SECTION_MATERIALS,
+    SECTION_BVH_NODES,
+    SECTION_BVH_LEAVES,
+    SECTION_STRING_RECORDS,
+    SECTION_STRING_DATA,
+    SECTION_COUNT
+};
+
+// Header, section table, then every section 16-byte aligned so the arrays
+// can be used in place from the mapping
+struct SceneHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint32_t nodeCount;
+    uint32_t meshCount;
+    uint32_t materialCount;
+    uint32_t bvhNodeCount;
+    uint32_t bvhLeafCount;
+    uint32_t stringCount;
+    uint64_t reserved;
+};
+
+struct SectionRecord {
+    uint64_t offset;  // From the start of the file
+    uint64_t size;
+};
+
+struct StringRecord {
+    uint32_t offset;  // Into the string data section
+    uint32_t size;
+};
+
+static_assert(sizeof(SceneHeader) % SECTION_ALIGNMENT == 0 && sizeof(SectionRecord) == 16 && sizeof(StringRecord) == 8);
+static_assert(sizeof(std::array<float, 3>) == 12 && sizeof(std::array<float, 4>) == 16);
+
+constexpr uint64_t alignUp(uint64_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+// Byte size of each section for the counts in a header, the string data excepted
+uint64_t expectedSize(uint32_t section, const SceneHeader& head) {
+    const uint64_t nodes = head.nodeCount;
+    switch (section) {
+        case SECTION_PARENTS:
+        case SECTION_MESH_INDICES:
+        case SECTION_MATERIAL_INDICES:
+        case SECTION_NAMES: return nodes * sizeof(uint32_t);
+        case SECTION_POSITIONS:
+        case SECTION_SCALES:
+        case SECTION_BOUNDS_MIN:
+        case SECTION_BOUNDS_MAX: return nodes * sizeof(std::array<float, 3>);
+        case SECTION_ROTATIONS: return nodes * sizeof(std::array<float, 4>);
+        case SECTION_MESHES: return uint64_t(head.meshCount) * sizeof(SceneMeshRecord);
+        case SECTION_MATERIALS: return uint64_t(head.materialCount) * sizeof(SceneMaterialRecord);
+        case SECTION_BVH_NODES: return uint64_t(head.bvhNodeCount) * sizeof(SceneBvhNode);
+        case SECTION_BVH_LEAVES: return uint64_t(head.bvhLeafCount) * sizeof(uint32_t);
+        case SECTION_STRING_RECORDS: return uint64_t(head.stringCount) * sizeof(StringRecord);
+        default: return 0;
+    }
+}
+
+void setError(std::string* error, std::string message) {
+    if (error) {
+        *error = std::move(message);
+    }
+}
+
+// Column-major 4x4, as TransformHierarchy writes them
+using Matrix = std::array<float, 16>;
+
+Matrix composeLocal(const LocalTransform& local) {
+    const float x = local.rotation[0], y = local.rotation[1], z = local.rotation[2], w = local.rotation[3];
+    const float sx = local.scale[0], sy = local.scale[1], sz = local.scale[2];
+    Matrix m = {};
+    m[0] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+    m[1] = (2.0f * (x * y + z * w)) * sx;
+    m[2] = (2.0f * (x * z - y * w)) * sx;
+    m[4] = (2.0f * (x * y - z * w)) * sy;
+    m[5] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+    m[6] = (2.0f * (y * z + x * w)) * sy;
+    m[8] = (2.0f * (x * z + y * w)) * sz;
+    m[9] = (2.0f * (y * z - x * w)) * sz;
+    m[10] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+    m[12] = local.position[0];
+    m[13] = local.position[1];
+    m[14] = local.position[2];
+    m[15] = 1.0f;
+    return m;
+}
+
+Matrix multiply(const Matrix& a, const Matrix& b) {
+    Matrix result = {};
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                sum += a[k * 4 + row] * b[column * 4 + k];
+            }
+            result[column * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+struct Box {
+    float min[3] = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                    std::numeric_limits<float>::max()};
+    float max[3] = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                    std::numeric_limits<float>::lowest()};
+
+    void grow(const Box& other) {
+        for (int i = 0; i < 3; ++i) {
+            min[i] = std::min(min[i], other.min[i]);
+            max[i] = std::max(max[i], other.max[i]);
+        }
+    }
+};
+
+// World box of a local box: transformed center, extents through |M|
+Box transformBox(const Matrix& m, const float localMin[3], const float localMax[3]) {
+    float center[3];
+    float extent[3];
+    for (int i = 0; i < 3; ++i) {
+        center[i] = (localMin[i] + localMax[i]) * 0.5f;
+        extent[i] = (localMax[i] - localMin[i]) * 0.5f;
+    }
+    Box box;
+    for (int row = 0; row < 3; ++row) {
+        const float worldCenter = m[row] * center[0] + m[4 + row] * center[1] + m[8 + row] * center[2] + m[12 + row];
+        const float worldExtent = std::fabs(m[row]) * extent[0] + std::fabs(m[4 + row]) * extent[1] +
+                                  std::fabs(m[8 + row]) * extent[2];
+        box.min[row] = worldCenter - worldExtent;
+        box.max[row] = worldCenter + worldExtent;
+    }
+    return box;
+}
+
+struct BvhItem {
+    uint32_t node;
+    Box box;
+    float centroid[3];
+};
+
+// Median split on the widest centroid axis, nodes in depth-first order
+void buildBvh(std::vector<BvhItem>& items, uint32_t begin, uint32_t end, std::vector<SceneBvhNode>& nodes) {
+    Box bounds;
+    Box centroids;
+    for (uint32_t i = begin; i < end; ++i) {
+        bounds.grow(items[i].box);
+        Box point;
+        std::copy(items[i].centroid, items[i].centroid + 3, point.min);
+        std::copy(items[i].centroid, items[i].centroid + 3, point.max);
+        centroids.grow(point);
+    }
+
+    const auto index = static_cast<uint32_t>(nodes.size());
+    SceneBvhNode node = {};
+    std::copy(bounds.min, bounds.min + 3, node.min);
+    std::copy(bounds.max, bounds.max + 3, node.max);
+    nodes.push_back(node);
+
+    if (end - begin <= SceneFileWriter::BVH_LEAF_SIZE) {
+        nodes[index].first = begin;
+        nodes[index].count = end - begin;
+        return;
+    }
+
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (centroids.max[i] - centroids.min[i] > centroids.max[axis] - centroids.min[axis]) {
+            axis = i;
+        }
+    }
+    const uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end,
+        [axis](const BvhItem& a, const BvhItem& b) { return a.centroid[axis] < b.centroid[axis]; });
+
+    buildBvh(items, begin, middle, nodes);
+    nodes[index].first = static_cast<uint32_t>(nodes.size());
+    nodes[index].count = 0;
+    buildBvh(items, middle, end, nodes);
+}
+
+} // anonymous namespace
+
+// ---- SceneFile --------------------------------------------------------------
+
+std::shared_ptr<SceneFile> SceneFile::open(const std::string& path) {
+    PERS_PROFILE_SCOPE("SceneFile::open");
+    std::shared_ptr<SceneFile> scene(new SceneFile());
+    scene->_path = path;
+    MappedFile& file = scene->_file;
+    if (!file.open(path)) {
+        Logger::Instance().LogFormat(LogLevel::Error, "SceneFile", PERS_SOURCE_LOC,
+            "Failed to map scene %s", path.c_str());
+        return nullptr;
+    }
+
+    const uint64_t tableEnd = sizeof(SceneHeader) + SECTION_COUNT * sizeof(SectionRecord);
+    const auto* head = reinterpret_cast<const SceneHeader*>(file.data());
+    if (file.size() < tableEnd || std::memcmp(head->magic, SCENE_MAGIC, sizeof(SCENE_MAGIC)) != 0) {
+        Logger::Instance().LogFormat(LogLevel::Error, "SceneFile", PERS_SOURCE_LOC,
+            "%s is not a scene file", path.c_str());
+        return nullptr;
+    }
+    if (head->version != FORMAT_VERSION || head->sectionCount != SECTION_COUNT) {
+        Logger::Instance().LogFormat(LogLevel::Error, "SceneFile", PERS_SOURCE_LOC,
+            "%s has scene format %u, expected %u; re-cook it", path.c_str(), head->version, FORMAT_VERSION);
+        return nullptr;
+    }
+
+    // Shapes only: sizes must match the counts, so accessors never read past the file
+    const auto* sections = reinterpret_cast<const SectionRecord*>(file.data() + sizeof(SceneHeader));
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < SECTION_COUNT; ++i) {
+        const SectionRecord& record = sections[i];
+        valid = record.offset % SECTION_ALIGNMENT == 0 && record.offset >= tableEnd &&
+                record.offset <= file.size() && record.size <= file.size() - record.offset &&
+                (i == SECTION_STRING_DATA || record.size == expectedSize(i, *head));
+    }
+    if (!valid) {
+        Logger::Instance().LogFormat(LogLevel::Error, "SceneFile", PERS_SOURCE_LOC,
+            "Scene %s is truncated or corrupt", path.c_str());
+        return nullptr;
+    }
+
+    scene->_nodeCount = head->nodeCount;
+    scene->_meshCount = head->meshCount;
+    scene->_materialCount = head->materialCount;
+    scene->_bvhNodeCount = head->bvhNodeCount;
+    scene->_bvhLeafCount = head->bvhLeafCount;
+    scene->_stringCount = head->stringCount;
+    scene->_stringDataSize = sections[SECTION_STRING_DATA].size;
+    scene->_sections.resize(SECTION_COUNT);
+    for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+        scene->_sections[i] = sections[i].offset;
+    }
+
+    Logger::Instance().LogFormat(LogLevel::Info, "SceneFile", PERS_SOURCE_LOC,
+        "Mapped scene %s: %u nodes, %u meshes, %u materials", path.c_str(),
+        head->nodeCount, head->meshCount, head->materialCount);
+    return scene;
+}
+
+std::span<const uint32_t> SceneFile::getParents() const {
+    return section<uint32_t>(SECTION_PARENTS, _nodeCount);
+}
+
+std::span<const uint32_t> SceneFile::getMeshIndices() const {
+    return section<uint32_t>(SECTION_MESH_INDICES, _nodeCount);
+}
+
+std::span<const uint32_t> SceneFile::getMaterialIndices() const {
+    return section<uint32_t>(SECTION_MATERIAL_INDICES, _nodeCount);
+}
+
+std::span<const std::array<float, 3>> SceneFile::getPositions() const {
+    return section<std::array<float, 3>>(SECTION_POSITIONS, _nodeCount);
+}
+
+std::span<const std::array<float, 4>> SceneFile::getRotations() const {
+    return section<std::array<float, 4>>(SECTION_ROTATIONS, _nodeCount);
+}
+
+std::span<const std::array<float, 3>> SceneFile::getScales() const {
+    return section<std::array<float, 3>>(SECTION_SCALES, _nodeCount);
+}
+
+std::span<const std::array<float, 3>> SceneFile::getBoundsMin() const {
+    return section<std::array<float, 3>>(SECTION_BOUNDS_MIN, _nodeCount);
+}
+
+std::span<const std::array<float, 3>> SceneFile::getBoundsMax() const {
+    return section<std::array<float, 3>>(SECTION_BOUNDS_MAX, _nodeCount);
+}
+
+std::span<const SceneMeshRecord> SceneFile::getMeshes() const {
+    return section<SceneMeshRecord>(SECTION_MESHES, _meshCount);
+}
+
+std::span<const SceneMaterialRecord> SceneFile::getMaterials() const {
+    return section<SceneMaterialRecord>(SECTION_MATERIALS, _materialCount);
+}
+
+std::span<const SceneBvhNode> SceneFile::getBvhNodes() const {
+    return section<SceneBvhNode>(SECTION_BVH_NODES, _bvhNodeCount);
+}
+
+std::string_view SceneFile::getNodeName(uint32_t node) const {
+    return node < _nodeCount ? getString(section<uint32_t>(SECTION_NAMES, _nodeCount)[node]) : std::string_view();
+}
+
+std::string_view SceneFile::getString(uint32_t index) const {
+    if (index >= _stringCount) {
+        return {};
+    }
+    const StringRecord& record = section<StringRecord>(SECTION_STRING_RECORDS, _stringCount)[index];
+    if (uint64_t(record.offset) + record.size > _stringDataSize) {
+        return {};
+    }
+    return {reinterpret_cast<const char*>(_file.data() + _sections[SECTION_STRING_DATA] + record.offset), record.size};
+}
+
+LocalTransform SceneFile::getLocal(uint32_t node) const {
+    LocalTransform local;
+    const auto& position = getPositions()[node];
+    const auto& rotation = getRotations()[node];
+    const auto& scale = getScales()[node];
+    std::copy(position.begin(), position.end(), local.position);
+    std::copy(rotation.begin(), rotation.end(), local.rotation);
+    std::copy(scale.begin(), scale.end(), local.scale);
+    return local;
+}
+
+std::vector<TransformId> SceneFile::instantiate(TransformHierarchy& hierarchy) const {
+    PERS_PROFILE_SCOPE("SceneFile::instantiate");
+    const std::span<const uint32_t> parents = getParents();
+    std::vector<TransformId> ids(_nodeCount, INVALID_TRANSFORM);
+    for (uint32_t node = 0; node < _nodeCount; ++node) {
+        const uint32_t parent = parents[node];
+        // Parents precede children, a later index can only come from a corrupt file
+        const TransformId parentId = parent < node ? ids[parent] : INVALID_TRANSFORM;
+        ids[node] = hierarchy.create(parentId, getLocal(node));
+    }
+    return ids;
+}
+
+void SceneFile::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& nodes) const {
+    PERS_PROFILE_SCOPE("SceneFile::queryFrustum");
+    const std::span<const SceneBvhNode> bvh = getBvhNodes();
+    const std::span<const uint32_t> leaves = section<uint32_t>(SECTION_BVH_LEAVES, _bvhLeafCount);
+    if (bvh.empty()) {
+        return;
+    }
+
+    float absNormals[6][3];
+    for (int p = 0; p < 6; ++p) {
+        for (int i = 0; i < 3; ++i) {
+            absNormals[p][i] = std::fabs(frustum.planes[p][i]);
+        }
+    }
+
+    constexpr uint32_t ALL_PLANES = 0x3F;
+    std::vector<std::pair<uint32_t, uint32_t>> stack;  // Node, planes still straddled
+    stack.reserve(64);
+    stack.emplace_back(0, ALL_PLANES);
+
+    while (!stack.empty()) {
+        const auto [index, planeMask] = stack.back();
+        stack.pop_back();
+        if (index >= bvh.size()) {
+            continue;
+        }
+        const SceneBvhNode& node = bvh[index];
+
+        const float center[3] = {(node.min[0] + node.max[0]) * 0.5f, (node.min[1] + node.max[1]) * 0.5f,
+                                 (node.min[2] + node.max[2]) * 0.5f};
+        const float extent[3] = {(node.max[0] - node.min[0]) * 0.5f, (node.max[1] - node.min[1]) * 0.5f,
+                                 (node.max[2] - node.min[2]) * 0.5f};
+
+        uint32_t mask = planeMask;
+        bool outside = false;
+        for (uint32_t bits = planeMask; bits && !outside; bits &= bits - 1) {
+            const int p = std::countr_zero(bits);
+            const auto& plane = frustum.planes[p];
+            const float distance = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+            const float reach = absNormals[p][0] * extent[0] + absNormals[p][1] * extent[1] +
+                                absNormals[p][2] * extent[2];
+            outside = distance < -reach;
+            if (distance >= reach) {
+                mask &= ~(1u << p);  // Fully inside this plane, children skip it
+            }
+        }
+        if (outside) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            const uint64_t end = std::min<uint64_t>(uint64_t(node.first) + node.count, leaves.size());
+            for (uint64_t i = node.first; i < end; ++i) {
+                nodes.push_back(leaves[i]);
+            }
+        } else {
+            stack.emplace_back(node.first, mask);
+            stack.emplace_back(index + 1, mask);
+        }
+    }
+}
+
+bool SceneFile::validate(std::string* error) const {
+    const std::span<const uint32_t> parents = getParents();
+    const std::span<const uint32_t> meshes = getMeshIndices();
+    const std::span<const uint32_t> materials = getMaterialIndices();
+    const std::span<const uint32_t> names = section<uint32_t>(SECTION_NAMES, _nodeCount);
+    for (uint32_t node = 0; node < _nodeCount; ++node) {
+        if (parents[node] != SCENE_NONE && parents[node] >= node) {
+            setError(error, "node " + std::to_string(node) + " does not follow its parent");
+            return false;
+        }
+        if ((meshes[node] != SCENE_NONE && meshes[node] >= _meshCount) ||
+            (materials[node] != SCENE_NONE && materials[node] >= _materialCount) ||
+            (names[node] != SCENE_NONE && names[node] >= _stringCount)) {
+            setError(error, "node " + std::to_string(node) + " references a missing mesh, material or name");
+            return false;
+        }
+    }
+
+    const std::span<const StringRecord> strings = section<StringRecord>(SECTION_STRING_RECORDS, _stringCount);
+    for (const StringRecord& record : strings) {
+        if (uint64_t(record.offset) + record.size > _stringDataSize) {
+            setError(error, "string outside the string data");
+            return false;
+        }
+    }
+    for (const SceneMeshRecord& mesh : getMeshes()) {
+        if (mesh.path != SCENE_NONE && mesh.path >= _stringCount) {
+            setError(error, "mesh path outside the string table");
+            return false;
+        }
+    }
+
+    const std::span<const SceneBvhNode> bvh = getBvhNodes();
+    const std::span<const uint32_t> leaves = section<uint32_t>(SECTION_BVH_LEAVES, _bvhLeafCount);
+    for (uint32_t i = 0; i < bvh.size(); ++i) {
+        const SceneBvhNode& node = bvh[i];
+        const bool ok = node.count > 0 ? uint64_t(node.first) + node.count <= leaves.size()
+                                       : node.first > i + 1 && node.first < bvh.size();
+        if (!ok) {
+            setError(error, "BVH node " + std::to_string(i) + " points outside the tree");
+            return false;
+        }
+    }
+    for (uint32_t leaf : leaves) {
+        if (leaf >= _nodeCount) {
+            setError(error, "BVH leaf references a missing node");
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---- SceneFileWriter --------------------------------------------------------
+
+uint32_t SceneFileWriter::addString(const std::string& value) {
+    if (value.empty()) {
+        return SCENE_NONE;
+    }
+    auto [it, inserted] = _stringIndices.emplace(value, static_cast<uint32_t>(_strings.size()));
+    if (inserted) {
+        _strings.push_back(value);
+    }
+    return it->second;
+}
+
+uint32_t SceneFileWriter::addMesh(const std::string& path, uint32_t meshIndex,
+                                  const float boundsMin[3], const float boundsMax[3]) {
+    SceneMeshRecord record;
+    record.path = addString(path);
+    record.meshIndex = meshIndex;
+    std::copy(boundsMin, boundsMin + 3, record.boundsMin);
+    std::copy(boundsMax, boundsMax + 3, record.boundsMax);
+    _meshes.push_back(record);
+    return static_cast<uint32_t>(_meshes.size() - 1);
+}
+
+uint32_t SceneFileWriter::addMaterial(const MaterialDesc& material) {
+    SceneMaterialRecord record = material.values;
+    record.name = addString(material.name);
+    record.baseColorTexture = addString(material.baseColorTexture);
+    record.normalTexture = addString(material.normalTexture);
+    record.metallicRoughnessTexture = addString(material.metallicRoughnessTexture);
+    record.reserved = 0;
+    _materials.push_back(record);
+    return static_cast<uint32_t>(_materials.size() - 1);
+}
+
+uint32_t SceneFileWriter::addNode(uint32_t parent, const LocalTransform& local, uint32_t mesh,
+                                  uint32_t material, const std::string& name) {
+    if ((parent != SCENE_NONE && parent >= _parents.size()) ||
+        (mesh != SCENE_NONE && mesh >= _meshes.size()) ||
+        (material != SCENE_NONE && material >= _materials.size())) {
+        return SCENE_NONE;
+    }
+    _parents.push_back(parent);
+    _meshIndices.push_back(mesh);
+    _materialIndices.push_back(material);
+    _names.push_back(addString(name));
+    _locals.push_back(local);
+    return static_cast<uint32_t>(_parents.size() - 1);
+}
+
+bool SceneFileWriter::save(const std::string& path, std::string* error) const {
+    PERS_PROFILE_SCOPE("SceneFileWriter::save");
+    const auto nodeCount = static_cast<uint32_t>(_parents.size());
+
+    std::vector<std::array<float, 3>> positions(nodeCount);
+    std::vector<std::array<float, 4>> rotations(nodeCount);
+    std::vector<std::array<float, 3>> scales(nodeCount);
+    std::vector<std::array<float, 3>> boundsMin(nodeCount);
+    std::vector<std::array<float, 3>> boundsMax(nodeCount);
+    std::vector<Matrix> worlds(nodeCount);
+    std::vector<BvhItem> items;
+    for (uint32_t node = 0; node < nodeCount; ++node) {
+        const LocalTransform& local = _locals[node];
+        std::copy(local.position, local.position + 3, positions[node].begin());
+        std::copy(local.rotation, local.rotation + 4, rotations[node].begin());
+        std::copy(local.scale, local.scale + 3, scales[node].begin());
+
+        const Matrix localMatrix = composeLocal(local);
+        worlds[node] = _parents[node] == SCENE_NONE ? localMatrix : multiply(worlds[_parents[node]], localMatrix);
+
+        Box box;
+        if (_meshIndices[node] != SCENE_NONE) {
+            const SceneMeshRecord& mesh = _meshes[_meshIndices[node]];
+            box = transformBox(worlds[node], mesh.boundsMin, mesh.boundsMax);
+            BvhItem item;
+            item.node = node;
+            item.box = box;
+            for (int i = 0; i < 3; ++i) {
+                item.centroid[i] = (box.min[i] + box.max[i]) * 0.5f;
+            }
+            items.push_back(item);
+        }
+        std::copy(box.min, box.min + 3, boundsMin[node].begin());
+        std::copy(box.max, box.max + 3, boundsMax[node].begin());
+    }
+
+    std::vector<SceneBvhNode> bvh;
+    if (!items.empty()) {
+        bvh.reserve(items.size() * 2 / BVH_LEAF_SIZE + 1);
+        buildBvh(items, 0, static_cast<uint32_t>(items.size()), bvh);
+    }
+    std::vector<uint32_t> leaves(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        leaves[i] = items[i].node;
+    }
+
+    std::string stringData;
+    std::vector<StringRecord> stringRecords(_strings.size());
+    for (size_t i = 0; i < _strings.size(); ++i) {
+        stringRecords[i].offset = static_cast<uint32_t>(stringData.size());
+        stringRecords[i].size = static_cast<uint32_t>(_strings[i].size());
+        stringData += _strings[i];
+    }
+
+    SceneHeader head = {};
+    std::memcpy(head.magic, SCENE_MAGIC, sizeof(SCENE_MAGIC));
+    head.version = SceneFile::FORMAT_VERSION;
+    head.sectionCount = SECTION_COUNT;
+    head.nodeCount = nodeCount;
+    head.meshCount = static_cast<uint32_t>(_meshes.size());
+    head.materialCount = static_cast<uint32_t>(_materials.size());
+    head.bvhNodeCount = static_cast<uint32_t>(bvh.size());
+    head.bvhLeafCount = static_cast<uint32_t>(leaves.size());
+    head.stringCount = static_cast<uint32_t>(_strings.size());
+
+    const std::pair<const void*, uint64_t> data[SECTION_COUNT] = {
+        {_parents.data(), _parents.size() * sizeof(uint32_t)},
+        {_meshIndices.data(), _meshIndices.size() * sizeof(uint32_t)},
+        {_materialIndices.data(), _materialIndices.size() * sizeof(uint32_t)},
+        {_names.data(), _names.size() * sizeof(uint32_t)},
+        {positions.data(), positions.size() * sizeof(positions[0])},
+        {rotations.data(), rotations.size() * sizeof(rotations[0])},
+        {scales.data(), scales.size() * sizeof(scales[0])},
+        {boundsMin.data(), boundsMin.size() * sizeof(boundsMin[0])},
+        {boundsMax.data(), boundsMax.size() * sizeof(boundsMax[0])},
+        {_meshes.data(), _meshes.size() * sizeof(SceneMeshRecord)},
+        {_materials.data(), _materials.size() * sizeof(SceneMaterialRecord)},
+        {bvh.data(), bvh.size() * sizeof(SceneBvhNode)},
+        {leaves.data(), leaves.size() * sizeof(uint32_t)},
+        {stringRecords.data(), stringRecords.size() * sizeof(StringRecord)},
+        {stringData.data(), stringData.size()},
+    };
+
+    SectionRecord sections[SECTION_COUNT] = {};
+    uint64_t offset = alignUp(sizeof(SceneHeader) + sizeof(sections));
+    for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+        sections[i].offset = offset;
+        sections[i].size = data[i].second;
+        offset = alignUp(offset + data[i].second);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        setError(error, "cannot open " + path + " for writing");
+        return false;
+    }
+
+    const char padding[SECTION_ALIGNMENT] = {};
+    auto pad = [&]() {
+        const auto position = static_cast<uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(alignUp(position) - position));
+    };
+
+    file.write(reinterpret_cast<const char*>(&head), sizeof(head));
+    file.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+    pad();
+    for (const auto& [bytes, size] : data) {
+        file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        pad();
+    }
+
+    if (!file) {
+        setError(error, "failed to write " + path);
+        return false;
+    }
+    return true;
+}
+
+} // namespace pers
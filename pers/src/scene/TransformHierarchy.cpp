@@ -0,0 +1,506 @@
+#include "pers/scene/TransformHierarchy.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Profiler.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PERS_TRANSFORM_SSE 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PERS_TRANSFORM_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace pers {
+
+namespace {
+
+constexpr uint32_t SIMD_WIDTH = 4;
+
+// Local matrix of one transform, column-major 3x4 (the last row is 0 0 0 1)
+void composeScalar(const float t[3], const float q[4], const float s[3], float out[16]) {
+    const float xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+    const float xy = q[0] * q[1], xz = q[0] * q[2], yz = q[1] * q[2];
+    const float wx = q[3] * q[0], wy = q[3] * q[1], wz = q[3] * q[2];
+
+    out[0] = (1.0f - 2.0f * (yy + zz)) * s[0];
+    out[1] = 2.0f * (xy + wz) * s[0];
+    out[2] = 2.0f * (xz - wy) * s[0];
+    out[3] = 0.0f;
+    out[4] = 2.0f * (xy - wz) * s[1];
+    out[5] = (1.0f - 2.0f * (xx + zz)) * s[1];
+    out[6] = 2.0f * (yz + wx) * s[1];
+    out[7] = 0.0f;
+    out[8] = 2.0f * (xz + wy) * s[2];
+    out[9] = 2.0f * (yz - wx) * s[2];
+    out[10] = (1.0f - 2.0f * (xx + yy)) * s[2];
+    out[11] = 0.0f;
+    out[12] = t[0];
+    out[13] = t[1];
+    out[14] = t[2];
+    out[15] = 1.0f;
+}
+
+void multiplyScalar(const float* parent, const float* local, float* out) {
+    for (int column = 0; column < 4; ++column) {
+        for (int row = 0; row < 4; ++row) {
+            out[column * 4 + row] = parent[row] * local[column * 4] +
+                                    parent[4 + row] * local[column * 4 + 1] +
+                                    parent[8 + row] * local[column * 4 + 2] +
+                                    parent[12 + row] * local[column * 4 + 3];
+        }
+    }
+}
+
+#if PERS_TRANSFORM_SSE
+
+using Float4 = __m128;
+
+inline Float4 load(const float* p) { return _mm_loadu_ps(p); }
+inline Float4 splat(float v) { return _mm_set1_ps(v); }
+inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+inline void store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) { _MM_TRANSPOSE4_PS(a, b, c, d); }
+
+template<int Lane>
+inline Float4 broadcast(Float4 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(Lane, Lane, Lane, Lane)); }
+
+// Mapped memory is often write-combined; non-temporal stores fill whole lines
+inline void storeStream(float* p, Float4 v) { _mm_stream_ps(p, v); }
+inline void storeFence() { _mm_sfence(); }
+
+#elif PERS_TRANSFORM_NEON
+
+using Float4 = float32x4_t;
+
+inline Float4 load(const float* p) { return vld1q_f32(p); }
+inline Float4 splat(float v) { return vdupq_n_f32(v); }
+inline Float4 add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+inline Float4 sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+inline Float4 mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+inline void store(float* p, Float4 v) { vst1q_f32(p, v); }
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    const float32x4x2_t ab = vtrnq_f32(a, b);
+    const float32x4x2_t cd = vtrnq_f32(c, d);
+    a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+    b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+    c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+
+template<int Lane>
+inline Float4 broadcast(Float4 v) { return vdupq_laneq_f32(v, Lane); }
+
+inline void storeStream(float* p, Float4 v) { vst1q_f32(p, v); }
+inline void storeFence() {}
+
+#endif
+
+#if PERS_TRANSFORM_SSE || PERS_TRANSFORM_NEON
+
+// parent * column, the parent being four columns
+inline Float4 transformColumn(const Float4 parent[4], Float4 column) {
+    Float4 result = mul(parent[0], broadcast<0>(column));
+    result = add(result, mul(parent[1], broadcast<1>(column)));
+    result = add(result, mul(parent[2], broadcast<2>(column)));
+    return add(result, mul(parent[3], broadcast<3>(column)));
+}
+
+#endif
+
+} // anonymous namespace
+
+TransformId TransformHierarchy::create(TransformId parent, const LocalTransform& local) {
+    if (parent != INVALID_TRANSFORM && !isValid(parent)) {
+        LOG_ERROR("TransformHierarchy", "Parent transform is not valid");
+        return INVALID_TRANSFORM;
+    }
+
+    TransformId id;
+    if (!_freeIds.empty()) {
+        id = _freeIds.back();
+        _freeIds.pop_back();
+        _parentIds[id] = parent;
+        _childCounts[id] = 0;
+    } else {
+        id = static_cast<TransformId>(_parentIds.size());
+        _parentIds.push_back(parent);
+        _childCounts.push_back(0);
+        _slots.push_back(INVALID_SLOT);
+    }
+    if (parent != INVALID_TRANSFORM) {
+        ++_childCounts[parent];
+    }
+
+    appendSlot(id, local);
+    ++_liveCount;
+    _orderDirty = true;
+    return id;
+}
+
+void TransformHierarchy::appendSlot(TransformId id, const LocalTransform& local) {
+    static constexpr float IDENTITY[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    _slots[id] = static_cast<uint32_t>(_slotIds.size());
+    _slotIds.push_back(id);
+    _parentSlots.push_back(INVALID_SLOT);  // Resolved by sortByDepth()
+    _positionX.push_back(local.position[0]);
+    _positionY.push_back(local.position[1]);
+    _positionZ.push_back(local.position[2]);
+    _rotationX.push_back(local.rotation[0]);
+    _rotationY.push_back(local.rotation[1]);
+    _rotationZ.push_back(local.rotation[2]);
+    _rotationW.push_back(local.rotation[3]);
+    _scaleX.push_back(local.scale[0]);
+    _scaleY.push_back(local.scale[1]);
+    _scaleZ.push_back(local.scale[2]);
+    _world.insert(_world.end(), IDENTITY, IDENTITY + 16);
+}
+
+bool TransformHierarchy::destroy(TransformId id) {
+    if (!isValid(id)) {
+        return false;
+    }
+    if (_childCounts[id] > 0) {
+        LOG_WARNING("TransformHierarchy", "Cannot destroy a transform that still has children");
+        return false;
+    }
+
+    if (_parentIds[id] != INVALID_TRANSFORM) {
+        --_childCounts[_parentIds[id]];
+    }
+    // The slot is compacted away by the next sortByDepth()
+    _slotIds[_slots[id]] = INVALID_TRANSFORM;
+    _slots[id] = INVALID_SLOT;
+    _parentIds[id] = INVALID_TRANSFORM;
+    _freeIds.push_back(id);
+    --_liveCount;
+    _orderDirty = true;
+    return true;
+}
+
+bool TransformHierarchy::setParent(TransformId id, TransformId parent) {
+    if (!isValid(id) || (parent != INVALID_TRANSFORM && !isValid(parent))) {
+        return false;
+    }
+    for (TransformId ancestor = parent; ancestor != INVALID_TRANSFORM; ancestor = _parentIds[ancestor]) {
+        if (ancestor == id) {
+            LOG_WARNING("TransformHierarchy", "Reparenting would create a cycle");
+            return false;
+        }
+    }
+
+    const TransformId previous = _parentIds[id];
+    if (previous == parent) {
+        return true;
+    }
+    if (previous != INVALID_TRANSFORM) {
+        --_childCounts[previous];
+    }
+    if (parent != INVALID_TRANSFORM) {
+        ++_childCounts[parent];
+    }
+    _parentIds[id] = parent;
+    _orderDirty = true;
+    return true;
+}
+
+TransformId TransformHierarchy::getParent(TransformId id) const {
+    return isValid(id) ? _parentIds[id] : INVALID_TRANSFORM;
+}
+
+void TransformHierarchy::setLocal(TransformId id, const LocalTransform& local) {
+    setPosition(id, local.position[0], local.position[1], local.position[2]);
+    setRotation(id, local.rotation[0], local.rotation[1], local.rotation[2], local.rotation[3]);
+    setScale(id, local.scale[0], local.scale[1], local.scale[2]);
+}
+
+void TransformHierarchy::setPosition(TransformId id, float x, float y, float z) {
+    if (!isValid(id)) {
+        return;
+    }
+    const uint32_t slot = _slots[id];
+    _positionX[slot] = x;
+    _positionY[slot] = y;
+    _positionZ[slot] = z;
+}
+
+void TransformHierarchy::setRotation(TransformId id, float x, float y, float z, float w) {
+    if (!isValid(id)) {
+        return;
+    }
+    const uint32_t slot = _slots[id];
+    _rotationX[slot] = x;
+    _rotationY[slot] = y;
+    _rotationZ[slot] = z;
+    _rotationW[slot] = w;
+}
+
+void TransformHierarchy::setScale(TransformId id, float x, float y, float z) {
+    if (!isValid(id)) {
+        return;
+    }
+    const uint32_t slot = _slots[id];
+    _scaleX[slot] = x;
+    _scaleY[slot] = y;
+    _scaleZ[slot] = z;
+}
+
+LocalTransform TransformHierarchy::getLocal(TransformId id) const {
+    LocalTransform local;
+    if (!isValid(id)) {
+        return local;
+    }
+    const uint32_t slot = _slots[id];
+    local.position[0] = _positionX[slot];
+    local.position[1] = _positionY[slot];
+    local.position[2] = _positionZ[slot];
+    local.rotation[0] = _rotationX[slot];
+    local.rotation[1] = _rotationY[slot];
+    local.rotation[2] = _rotationZ[slot];
+    local.rotation[3] = _rotationW[slot];
+    local.scale[0] = _scaleX[slot];
+    local.scale[1] = _scaleY[slot];
+    local.scale[2] = _scaleZ[slot];
+    return local;
+}
+
+const float* TransformHierarchy::getWorldMatrix(TransformId id) const {
+    return isValid(id) ? &_world[static_cast<size_t>(_slots[id]) * 16] : nullptr;
+}
+
+bool TransformHierarchy::isValid(TransformId id) const {
+    return id < _slots.size() && _slots[id] != INVALID_SLOT;
+}
+
+void TransformHierarchy::sortByDepth() {
+    PERS_PROFILE_SCOPE("TransformHierarchy::sortByDepth");
+
+    // Depth per id; walks up to the first known ancestor, so each id is visited once
+    const uint32_t capacity = getCapacity();
+    std::vector<uint32_t> depths(capacity, INVALID_SLOT);
+    std::vector<TransformId> path;
+    uint32_t maxDepth = 0;
+    for (TransformId id = 0; id < capacity; ++id) {
+        if (_slots[id] == INVALID_SLOT || depths[id] != INVALID_SLOT) {
+            continue;
+        }
+        TransformId current = id;
+        while (current != INVALID_TRANSFORM && depths[current] == INVALID_SLOT) {
+            path.push_back(current);
+            current = _parentIds[current];
+        }
+        uint32_t depth = current == INVALID_TRANSFORM ? 0 : depths[current] + 1;
+        for (auto it = path.rbegin(); it != path.rend(); ++it, ++depth) {
+            depths[*it] = depth;
+        }
+        maxDepth = depth - 1 > maxDepth ? depth - 1 : maxDepth;
+        path.clear();
+    }
+
+    // Counting sort; keeps the previous relative order within a level
+    _levelStarts.assign(_liveCount > 0 ? maxDepth + 2 : 1, 0);
+    for (TransformId id : _slotIds) {
+        if (id != INVALID_TRANSFORM) {
+            ++_levelStarts[depths[id] + 1];
+        }
+    }
+    for (size_t level = 1; level < _levelStarts.size(); ++level) {
+        _levelStarts[level] += _levelStarts[level - 1];
+    }
+
+    std::vector<uint32_t> next(_levelStarts.begin(), _levelStarts.end() - 1);
+    std::vector<uint32_t> newSlots(capacity, INVALID_SLOT);
+    for (TransformId id : _slotIds) {
+        if (id != INVALID_TRANSFORM) {
+            newSlots[id] = next[depths[id]]++;
+        }
+    }
+
+    auto permute = [&](std::vector<float>& values) {
+        std::vector<float> sorted(_liveCount);
+        for (uint32_t slot = 0; slot < _slotIds.size(); ++slot) {
+            if (_slotIds[slot] != INVALID_TRANSFORM) {
+                sorted[newSlots[_slotIds[slot]]] = values[slot];
+            }
+        }
+        values.swap(sorted);
+    };
+    permute(_positionX);
+    permute(_positionY);
+    permute(_positionZ);
+    permute(_rotationX);
+    permute(_rotationY);
+    permute(_rotationZ);
+    permute(_rotationW);
+    permute(_scaleX);
+    permute(_scaleY);
+    permute(_scaleZ);
+
+    std::vector<TransformId> slotIds(_liveCount);
+    for (TransformId id : _slotIds) {
+        if (id != INVALID_TRANSFORM) {
+            slotIds[newSlots[id]] = id;
+        }
+    }
+    _slotIds.swap(slotIds);
+    _slots.swap(newSlots);
+
+    _parentSlots.resize(_liveCount);
+    for (uint32_t slot = 0; slot < _liveCount; ++slot) {
+        const TransformId parent = _parentIds[_slotIds[slot]];
+        _parentSlots[slot] = parent == INVALID_TRANSFORM ? INVALID_SLOT : _slots[parent];
+    }
+    // Recomputed by the update that sorts
+    _world.resize(static_cast<size_t>(_liveCount) * 16);
+    _orderDirty = false;
+}
+
+void TransformHierarchy::updateRange(uint32_t begin, uint32_t end, uint8_t* destination, uint32_t stride) {
+    uint32_t slot = begin;
+
+#if PERS_TRANSFORM_SSE || PERS_TRANSFORM_NEON
+    const bool streaming = destination && (reinterpret_cast<uintptr_t>(destination) & 63) == 0 && (stride & 63) == 0;
+    const Float4 one = splat(1.0f);
+    const Float4 two = splat(2.0f);
+
+    for (; slot + SIMD_WIDTH <= end; slot += SIMD_WIDTH) {
+        // Local matrices of four transforms, one component per register
+        const Float4 qx = load(&_rotationX[slot]), qy = load(&_rotationY[slot]);
+        const Float4 qz = load(&_rotationZ[slot]), qw = load(&_rotationW[slot]);
+        const Float4 sx = load(&_scaleX[slot]), sy = load(&_scaleY[slot]), sz = load(&_scaleZ[slot]);
+
+        const Float4 xx = mul(qx, qx), yy = mul(qy, qy), zz = mul(qz, qz);
+        const Float4 xy = mul(qx, qy), xz = mul(qx, qz), yz = mul(qy, qz);
+        const Float4 wx = mul(qw, qx), wy = mul(qw, qy), wz = mul(qw, qz);
+
+        Float4 c0x = mul(sub(one, mul(two, add(yy, zz))), sx);
+        Float4 c0y = mul(mul(two, add(xy, wz)), sx);
+        Float4 c0z = mul(mul(two, sub(xz, wy)), sx);
+        Float4 c0w = splat(0.0f);
+        Float4 c1x = mul(mul(two, sub(xy, wz)), sy);
+        Float4 c1y = mul(sub(one, mul(two, add(xx, zz))), sy);
+        Float4 c1z = mul(mul(two, add(yz, wx)), sy);
+        Float4 c1w = splat(0.0f);
+        Float4 c2x = mul(mul(two, add(xz, wy)), sz);
+        Float4 c2y = mul(mul(two, sub(yz, wx)), sz);
+        Float4 c2z = mul(sub(one, mul(two, add(xx, yy))), sz);
+        Float4 c2w = splat(0.0f);
+        Float4 c3x = load(&_positionX[slot]);
+        Float4 c3y = load(&_positionY[slot]);
+        Float4 c3z = load(&_positionZ[slot]);
+        Float4 c3w = one;
+
+        // After the transposes register k of a column holds that column of transform k
+        transpose(c0x, c0y, c0z, c0w);
+        transpose(c1x, c1y, c1z, c1w);
+        transpose(c2x, c2y, c2z, c2w);
+        transpose(c3x, c3y, c3z, c3w);
+        const Float4 locals[SIMD_WIDTH][4] = {
+            {c0x, c1x, c2x, c3x},
+            {c0y, c1y, c2y, c3y},
+            {c0z, c1z, c2z, c3z},
+            {c0w, c1w, c2w, c3w},
+        };
+
+        for (uint32_t lane = 0; lane < SIMD_WIDTH; ++lane) {
+            const uint32_t current = slot + lane;
+            const uint32_t parentSlot = _parentSlots[current];
+            Float4 world[4];
+            if (parentSlot == INVALID_SLOT) {
+                for (int column = 0; column < 4; ++column) {
+                    world[column] = locals[lane][column];
+                }
+            } else {
+                const float* parentMatrix = &_world[static_cast<size_t>(parentSlot) * 16];
+                const Float4 parent[4] = {load(parentMatrix), load(parentMatrix + 4),
+                                          load(parentMatrix + 8), load(parentMatrix + 12)};
+                for (int column = 0; column < 4; ++column) {
+                    world[column] = transformColumn(parent, locals[lane][column]);
+                }
+            }
+
+            float* cached = &_world[static_cast<size_t>(current) * 16];
+            for (int column = 0; column < 4; ++column) {
+                store(cached + column * 4, world[column]);
+            }
+            if (destination) {
+                auto* out = reinterpret_cast<float*>(destination + static_cast<size_t>(_slotIds[current]) * stride);
+                for (int column = 0; column < 4; ++column) {
+                    if (streaming) {
+                        storeStream(out + column * 4, world[column]);
+                    } else {
+                        store(out + column * 4, world[column]);
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    for (; slot < end; ++slot) {
+        const float t[3] = {_positionX[slot], _positionY[slot], _positionZ[slot]};
+        const float q[4] = {_rotationX[slot], _rotationY[slot], _rotationZ[slot], _rotationW[slot]};
+        const float s[3] = {_scaleX[slot], _scaleY[slot], _scaleZ[slot]};
+        float* cached = &_world[static_cast<size_t>(slot) * 16];
+        const uint32_t parentSlot = _parentSlots[slot];
+        if (parentSlot == INVALID_SLOT) {
+            composeScalar(t, q, s, cached);
+        } else {
+            float local[16];
+            composeScalar(t, q, s, local);
+            multiplyScalar(&_world[static_cast<size_t>(parentSlot) * 16], local, cached);
+        }
+        if (destination) {
+            std::memcpy(destination + static_cast<size_t>(_slotIds[slot]) * stride, cached, MATRIX_SIZE);
+        }
+    }
+
+#if PERS_TRANSFORM_SSE || PERS_TRANSFORM_NEON
+    if (streaming) {
+        // Non-temporal stores are only ordered by a fence on the thread that issued them
+        storeFence();
+    }
+#endif
+}
+
+void TransformHierarchy::update(void* destination, uint32_t stride) {
+    PERS_PROFILE_SCOPE("TransformHierarchy::update");
+    if (stride < MATRIX_SIZE) {
+        LOG_ERROR("TransformHierarchy", "Stride is smaller than a matrix");
+        return;
+    }
+    if (_orderDirty) {
+        sortByDepth();
+    }
+    updateRange(0, _liveCount, static_cast<uint8_t*>(destination), stride);
+}
+
+JobHandle TransformHierarchy::scheduleUpdate(JobSystem& jobs, void* destination, uint32_t stride,
+                                             std::span<const JobHandle> dependencies) {
+    if (stride < MATRIX_SIZE) {
+        LOG_ERROR("TransformHierarchy", "Stride is smaller than a matrix");
+        return jobs.schedule([] {}, dependencies);
+    }
+    if (_orderDirty) {
+        sortByDepth();
+    }
+
+    auto* bytes = static_cast<uint8_t*>(destination);
+    JobHandle previous = jobs.schedule([] {}, dependencies);
+    for (size_t level = 0; level + 1 < _levelStarts.size(); ++level) {
+        const uint32_t begin = _levelStarts[level];
+        const uint32_t count = _levelStarts[level + 1] - begin;
+        // Children read their parents' world matrices, so levels run one after another
+        previous = jobs.parallelFor(count, BATCH_SIZE, [this, begin, bytes, stride](uint32_t first, uint32_t last) {
+            PERS_PROFILE_SCOPE("TransformHierarchy::updateBatch");
+            updateRange(begin + first, begin + last, bytes, stride);
+        }, {previous});
+    }
+    return previous;
+}
+
+} // namespace pers
@@ -0,0 +1,322 @@
+#include "pers/utils/AllocationTracker.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif __has_include(<execinfo.h>)
+#include <execinfo.h>
+#define PERS_HAS_EXECINFO 1
+#endif
+
+namespace pers {
+
+namespace {
+
+constexpr size_t MAX_REPORTED_SITES = 4;  // Per allocating scope
+
+std::atomic<AllocationTracker::Mode> g_mode{AllocationTracker::Mode::Off};
+std::atomic<uint32_t> g_warmupFrames{AllocationTracker::DEFAULT_WARMUP_FRAMES};
+std::atomic<uint64_t> g_frames{0};
+std::atomic<bool> g_armed{false};
+
+std::atomic<uint64_t> g_allocatingFrames{0};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<uint64_t> g_droppedSites{0};
+
+// Fixed table; locking a std::mutex never allocates, so the hook can use it
+std::mutex g_siteMutex;
+AllocationTracker::Site g_sites[AllocationTracker::MAX_SITES];
+size_t g_siteCount = 0;
+
+// Trivial thread_locals only, they are touched from inside operator new
+thread_local uint32_t t_scopeDepth = 0;
+thread_local bool t_inHook = false;
+thread_local uint64_t t_scopeAllocations = 0;
+thread_local uint64_t t_scopeBytes = 0;
+thread_local size_t t_scopeSites[MAX_REPORTED_SITES];
+thread_local size_t t_scopeSiteCount = 0;
+
+uint32_t captureStack(const void** frames, uint32_t capacity) {
+    // Skip captureStack, recordAllocation and operator new where not inlined
+    constexpr uint32_t SKIP = 2;
+#if defined(_WIN32)
+    return CaptureStackBackTrace(SKIP, capacity, const_cast<void**>(frames), nullptr);
+#elif defined(PERS_HAS_EXECINFO)
+    void* buffer[SKIP + AllocationTracker::MAX_SITE_FRAMES];
+    int count = backtrace(buffer, static_cast<int>(SKIP + capacity));
+    uint32_t captured = count > static_cast<int>(SKIP) ? static_cast<uint32_t>(count) - SKIP : 0;
+    for (uint32_t i = 0; i < captured; ++i) {
+        frames[i] = buffer[SKIP + i];
+    }
+    return captured;
+#else
+    frames[0] = __builtin_return_address(0);
+    return capacity > 0 ? 1 : 0;
+#endif
+}
+
+void logSite(const AllocationTracker::Site& site) {
+    Logger::Instance().LogFormat(LogLevel::Warning, "AllocationTracker", PERS_SOURCE_LOC,
+        "  site: %llu allocation(s), %llu bytes", static_cast<unsigned long long>(site.count),
+        static_cast<unsigned long long>(site.bytes));
+#if defined(PERS_HAS_EXECINFO)
+    char** symbols = backtrace_symbols(const_cast<void* const*>(site.frames), static_cast<int>(site.frameCount));
+    for (uint32_t i = 0; i < site.frameCount; ++i) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AllocationTracker", PERS_SOURCE_LOC,
+            "    #%u %s", i, symbols ? symbols[i] : "?");
+    }
+    std::free(symbols);
+#else
+    // Resolve against the module map or with a debugger
+    for (uint32_t i = 0; i < site.frameCount; ++i) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "AllocationTracker", PERS_SOURCE_LOC,
+            "    #%u %p", i, site.frames[i]);
+    }
+#endif
+}
+
+} // anonymous namespace
+
+void AllocationTracker::setMode(Mode mode) {
+#if !PERS_ALLOCATION_TRACKING
+    if (mode != Mode::Off) {
+        LOG_WARNING("AllocationTracker", "Built without PERS_ALLOCATION_TRACKING, allocations are not tracked");
+    }
+#elif defined(PERS_HAS_EXECINFO)
+    // The first backtrace() loads the unwinder, which allocates
+    void* warm[1];
+    backtrace(warm, 1);
+#endif
+    g_mode.store(mode, std::memory_order_relaxed);
+}
+
+AllocationTracker::Mode AllocationTracker::getMode() {
+    return g_mode.load(std::memory_order_relaxed);
+}
+
+void AllocationTracker::setWarmupFrames(uint32_t frames) {
+    g_warmupFrames.store(frames, std::memory_order_relaxed);
+}
+
+void AllocationTracker::nextFrame() {
+    const uint64_t frames = g_frames.fetch_add(1, std::memory_order_relaxed) + 1;
+    const bool armed = g_mode.load(std::memory_order_relaxed) != Mode::Off
+        && frames > g_warmupFrames.load(std::memory_order_relaxed);
+    if (armed != g_armed.load(std::memory_order_relaxed)) {
+        g_armed.store(armed, std::memory_order_relaxed);
+        if (armed) {
+            Logger::Instance().LogFormat(LogLevel::Info, "AllocationTracker", PERS_SOURCE_LOC,
+                "Checking frames for heap allocations after %llu warmup frames",
+                static_cast<unsigned long long>(frames - 1));
+        }
+    }
+}
+
+void AllocationTracker::beginScope() {
+    if (t_scopeDepth++ == 0) {
+        t_scopeAllocations = 0;
+        t_scopeBytes = 0;
+        t_scopeSiteCount = 0;
+    }
+}
+
+void AllocationTracker::endScope() {
+    if (t_scopeDepth == 0 || --t_scopeDepth > 0 || t_scopeAllocations == 0) {
+        return;
+    }
+
+    // Reporting allocates; keep it out of the counts
+    t_inHook = true;
+    g_allocatingFrames.fetch_add(1, std::memory_order_relaxed);
+    Logger::Instance().LogFormat(LogLevel::Warning, "AllocationTracker", PERS_SOURCE_LOC,
+        "Frame %llu made %llu heap allocation(s), %llu bytes",
+        static_cast<unsigned long long>(g_frames.load(std::memory_order_relaxed)),
+        static_cast<unsigned long long>(t_scopeAllocations), static_cast<unsigned long long>(t_scopeBytes));
+
+    Site sites[MAX_REPORTED_SITES];
+    {
+        std::lock_guard<std::mutex> lock(g_siteMutex);
+        for (size_t i = 0; i < t_scopeSiteCount; ++i) {
+            sites[i] = g_sites[t_scopeSites[i]];
+        }
+    }
+    for (size_t i = 0; i < t_scopeSiteCount; ++i) {
+        logSite(sites[i]);
+    }
+    t_inHook = false;
+
+    if (g_mode.load(std::memory_order_relaxed) == Mode::Assert) {
+        LOG_CRITICAL("AllocationTracker", "Heap allocation inside an allocation-free frame");
+        std::abort();
+    }
+}
+
+void AllocationTracker::recordAllocation(size_t size) {
+    if (t_scopeDepth == 0 || t_inHook || !g_armed.load(std::memory_order_relaxed)) {
+        return;
+    }
+    t_inHook = true;
+
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    ++t_scopeAllocations;
+    t_scopeBytes += size;
+
+    Site site;
+    site.frameCount = captureStack(site.frames, MAX_SITE_FRAMES);
+
+    std::lock_guard<std::mutex> lock(g_siteMutex);
+    size_t index = 0;
+    while (index < g_siteCount && (g_sites[index].frameCount != site.frameCount
+           || std::memcmp(g_sites[index].frames, site.frames, site.frameCount * sizeof(void*)) != 0)) {
+        ++index;
+    }
+    if (index == g_siteCount) {
+        if (g_siteCount == MAX_SITES) {
+            g_droppedSites.fetch_add(1, std::memory_order_relaxed);
+            t_inHook = false;
+            return;
+        }
+        g_sites[g_siteCount++] = site;
+    }
+    ++g_sites[index].count;
+    g_sites[index].bytes += size;
+
+    if (t_scopeSiteCount < MAX_REPORTED_SITES
+        && std::find(t_scopeSites, t_scopeSites + t_scopeSiteCount, index) == t_scopeSites + t_scopeSiteCount) {
+        t_scopeSites[t_scopeSiteCount++] = index;
+    }
+    t_inHook = false;
+}
+
+AllocationTracker::Stats AllocationTracker::getStats() {
+    Stats stats;
+    stats.frames = g_frames.load(std::memory_order_relaxed);
+    stats.allocatingFrames = g_allocatingFrames.load(std::memory_order_relaxed);
+    stats.allocations = g_allocations.load(std::memory_order_relaxed);
+    stats.bytes = g_bytes.load(std::memory_order_relaxed);
+    stats.droppedSites = g_droppedSites.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::vector<AllocationTracker::Site> AllocationTracker::getSites() {
+    std::vector<Site> sites;
+    {
+        std::lock_guard<std::mutex> lock(g_siteMutex);
+        sites.assign(g_sites, g_sites + g_siteCount);
+    }
+    std::sort(sites.begin(), sites.end(), [](const Site& a, const Site& b) { return a.count > b.count; });
+    return sites;
+}
+
+void AllocationTracker::reset() {
+    std::lock_guard<std::mutex> lock(g_siteMutex);
+    g_siteCount = 0;
+    g_allocatingFrames.store(0, std::memory_order_relaxed);
+    g_allocations.store(0, std::memory_order_relaxed);
+    g_bytes.store(0, std::memory_order_relaxed);
+    g_droppedSites.store(0, std::memory_order_relaxed);
+}
+
+} // namespace pers
+
+#if PERS_ALLOCATION_TRACKING
+
+// Replacement global allocation functions; delete only has to match new's storage
+namespace {
+
+void* allocate(std::size_t size) {
+    pers::AllocationTracker::recordAllocation(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    pers::AllocationTracker::recordAllocation(size);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    void* pointer = nullptr;
+    return posix_memalign(&pointer, std::max(align, sizeof(void*)), size ? size : 1) == 0 ? pointer : nullptr;
+#endif
+}
+
+void freeAligned(void* pointer) noexcept {
+#if defined(_WIN32)
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+
+} // anonymous namespace
+
+void* operator new(std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* pointer = allocate(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    if (void* pointer = allocateAligned(size, alignment)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { freeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { freeAligned(pointer); }
+
+#endif // PERS_ALLOCATION_TRACKING
@@ -0,0 +1,382 @@
+#include "pers/utils/BinaryLogOutput.h"
+#include "pers/utils/Hash.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX  // Prevent Windows.h from defining min/max macros
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace pers {
+
+namespace {
+    // Sizes of the fixed part of each record, type byte included
+    constexpr uint64_t CATEGORY_RECORD_SIZE = 1 + 2 + 2;            // id, length
+    constexpr uint64_t SOURCE_RECORD_SIZE = 1 + 4 + 4 + 2 + 2;      // id, line, file length, function length
+    constexpr uint64_t THREAD_RECORD_SIZE = 1 + 2 + 8;              // id, native id hash
+    constexpr uint64_t ENTRY_RECORD_SIZE = 1 + 1 + 2 + 2 + 4 + 8 + 4;  // level, category, thread, source, ticks, message length
+
+    template<typename T>
+    uint8_t* put(uint8_t* dst, T value) {
+        std::memcpy(dst, &value, sizeof(T));
+        return dst + sizeof(T);
+    }
+
+    uint8_t* putBytes(uint8_t* dst, const void* src, size_t size) {
+        std::memcpy(dst, src, size);
+        return dst + size;
+    }
+
+    template<typename T>
+    bool get(const uint8_t*& src, const uint8_t* end, T& value) {
+        if (static_cast<size_t>(end - src) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, src, sizeof(T));
+        src += sizeof(T);
+        return true;
+    }
+
+    bool getString(const uint8_t*& src, const uint8_t* end, size_t size, std::string& value) {
+        if (static_cast<size_t>(end - src) < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(src), size);
+        src += size;
+        return true;
+    }
+
+    uint16_t clampLength(size_t length) {
+        return static_cast<uint16_t>(length < 0xFFFF ? length : 0xFFFF);
+    }
+}
+
+BinaryLogOutput::BinaryLogOutput(const std::string& filename, uint64_t growSize)
+    : _growSize(growSize > HEADER_SIZE ? growSize : DEFAULT_GROW_SIZE),
+      _mutex("BinaryLogOutput") {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Failed to open binary log file: " + filename);
+    }
+    _file = file;
+#else
+    _fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (_fd < 0) {
+        throw std::runtime_error("Failed to open binary log file: " + filename);
+    }
+#endif
+
+    if (!remap(_growSize)) {
+        close();
+        throw std::runtime_error("Failed to map binary log file: " + filename);
+    }
+
+    uint8_t* header = _data;
+    header = put(header, MAGIC);
+    header = put(header, VERSION);
+    header = put(header, static_cast<uint16_t>(HEADER_SIZE));
+    put(header, static_cast<uint64_t>(HEADER_SIZE));
+    _writePos = HEADER_SIZE;
+}
+
+BinaryLogOutput::~BinaryLogOutput() {
+    Flush();
+    close();
+}
+
+bool BinaryLogOutput::remap(uint64_t capacity) {
+#ifdef _WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        _data = nullptr;
+        _mapping = nullptr;
+    }
+    // Creating a larger mapping extends the file
+    HANDLE mapping = CreateFileMappingA(_file, nullptr, PAGE_READWRITE,
+                                        static_cast<DWORD>(capacity >> 32),
+                                        static_cast<DWORD>(capacity & 0xFFFFFFFF), nullptr);
+    if (!mapping) {
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return false;
+    }
+    _mapping = mapping;
+#else
+    if (_data) {
+        munmap(_data, static_cast<size_t>(_capacity));
+        _data = nullptr;
+    }
+    if (ftruncate(_fd, static_cast<off_t>(capacity)) != 0) {
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+#endif
+    _data = static_cast<uint8_t*>(view);
+    _capacity = capacity;
+    return true;
+}
+
+void BinaryLogOutput::close() {
+#ifdef _WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+    }
+    if (_file) {
+        // Drop the unused tail of the last growth step
+        LARGE_INTEGER size;
+        size.QuadPart = static_cast<LONGLONG>(_writePos);
+        if (SetFilePointerEx(_file, size, nullptr, FILE_BEGIN)) {
+            SetEndOfFile(_file);
+        }
+        CloseHandle(_file);
+    }
+    _mapping = nullptr;
+    _file = nullptr;
+#else
+    if (_data) {
+        munmap(_data, static_cast<size_t>(_capacity));
+    }
+    if (_fd >= 0) {
+        // Drop the unused tail of the last growth step
+        if (ftruncate(_fd, static_cast<off_t>(_writePos)) != 0) {
+            // The zero-filled tail reads as an end record, so the log stays readable
+        }
+        ::close(_fd);
+    }
+    _fd = -1;
+#endif
+    _data = nullptr;
+    _capacity = 0;
+}
+
+uint8_t* BinaryLogOutput::reserve(uint64_t size) {
+    if (!_data) {
+        return nullptr;
+    }
+    if (_writePos + size > _capacity) {
+        uint64_t capacity = _capacity;
+        while (_writePos + size > capacity) {
+            capacity += _growSize;
+        }
+        if (!remap(capacity)) {
+            return nullptr;
+        }
+    }
+    uint8_t* dst = _data + _writePos;
+    _writePos += size;
+    return dst;
+}
+
+uint16_t BinaryLogOutput::internCategory(const std::string& category) {
+    auto it = _categoryIds.find(category);
+    if (it != _categoryIds.end()) {
+        return it->second;
+    }
+
+    uint16_t id = static_cast<uint16_t>(_categoryIds.size());
+    uint16_t length = clampLength(category.size());
+    if (uint8_t* dst = reserve(CATEGORY_RECORD_SIZE + length)) {
+        dst = put(dst, RecordType::Category);
+        dst = put(dst, id);
+        dst = put(dst, length);
+        putBytes(dst, category.data(), length);
+    }
+    _categoryIds.emplace(category, id);
+    return id;
+}
+
+uint16_t BinaryLogOutput::internThread(std::thread::id threadId) {
+    auto it = _threadIds.find(threadId);
+    if (it != _threadIds.end()) {
+        return it->second;
+    }
+
+    uint16_t id = static_cast<uint16_t>(_threadIds.size());
+    if (uint8_t* dst = reserve(THREAD_RECORD_SIZE)) {
+        dst = put(dst, RecordType::Thread);
+        dst = put(dst, id);
+        put(dst, static_cast<uint64_t>(std::hash<std::thread::id>{}(threadId)));
+    }
+    _threadIds.emplace(threadId, id);
+    return id;
+}
+
+uint32_t BinaryLogOutput::internSource(const LogEntry& entry) {
+    Fnv1aHasher hasher;
+    hasher.addString(entry.file);
+    hasher.add(entry.line);
+    hasher.addString(entry.function);
+    uint64_t key = hasher.get();
+
+    auto it = _sourceIds.find(key);
+    if (it != _sourceIds.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(_sourceIds.size());
+    uint16_t fileLength = clampLength(entry.file.size());
+    uint16_t functionLength = clampLength(entry.function.size());
+    if (uint8_t* dst = reserve(SOURCE_RECORD_SIZE + fileLength + functionLength)) {
+        dst = put(dst, RecordType::Source);
+        dst = put(dst, id);
+        dst = put(dst, static_cast<uint32_t>(entry.line));
+        dst = put(dst, fileLength);
+        dst = put(dst, functionLength);
+        dst = putBytes(dst, entry.file.data(), fileLength);
+        putBytes(dst, entry.function.data(), functionLength);
+    }
+    _sourceIds.emplace(key, id);
+    return id;
+}
+
+void BinaryLogOutput::Write(const LogEntry& entry) {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+
+    uint16_t categoryId = internCategory(entry.category);
+    uint16_t threadId = internThread(entry.threadId);
+    uint32_t sourceId = internSource(entry);
+    uint64_t ticks = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(entry.timestamp.time_since_epoch()).count());
+    uint32_t messageLength = static_cast<uint32_t>(entry.message.size());
+
+    uint8_t* dst = reserve(ENTRY_RECORD_SIZE + messageLength);
+    if (!dst) {
+        return;
+    }
+    dst = put(dst, RecordType::Entry);
+    dst = put(dst, static_cast<uint8_t>(entry.level));
+    dst = put(dst, categoryId);
+    dst = put(dst, threadId);
+    dst = put(dst, sourceId);
+    dst = put(dst, ticks);
+    dst = put(dst, messageLength);
+    putBytes(dst, entry.message.data(), messageLength);
+}
+
+void BinaryLogOutput::Flush() {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    if (_data) {
+        put(_data + 8, _writePos);
+    }
+}
+
+bool BinaryLogReader::read(const std::string& filename, const EntryCallback& callback) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        return false;
+    }
+
+    const uint8_t* src = data.data();
+    const uint8_t* end = data.data() + data.size();
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t headerSize = 0;
+    uint64_t writtenBytes = 0;
+    if (!get(src, end, magic) || !get(src, end, version) || !get(src, end, headerSize) ||
+        !get(src, end, writtenBytes) || magic != BinaryLogOutput::MAGIC ||
+        version != BinaryLogOutput::VERSION || headerSize > data.size()) {
+        return false;
+    }
+    src = data.data() + headerSize;
+
+    struct Source {
+        std::string file;
+        std::string function;
+        int line = 0;
+    };
+    std::vector<std::string> categories;
+    std::vector<Source> sources;
+    static const Source unknownSource;
+    static const std::string unknownCategory;
+
+    LogEntry entry;
+    while (src < end) {
+        uint8_t type = 0;
+        get(src, end, type);
+
+        if (type == static_cast<uint8_t>(BinaryLogOutput::RecordType::Category)) {
+            uint16_t id = 0;
+            uint16_t length = 0;
+            std::string name;
+            if (!get(src, end, id) || !get(src, end, length) || !getString(src, end, length, name)) {
+                break;
+            }
+            if (id >= categories.size()) {
+                categories.resize(id + 1);
+            }
+            categories[id] = std::move(name);
+        } else if (type == static_cast<uint8_t>(BinaryLogOutput::RecordType::Source)) {
+            uint32_t id = 0;
+            uint32_t line = 0;
+            uint16_t fileLength = 0;
+            uint16_t functionLength = 0;
+            Source source;
+            if (!get(src, end, id) || !get(src, end, line) || !get(src, end, fileLength) ||
+                !get(src, end, functionLength) || !getString(src, end, fileLength, source.file) ||
+                !getString(src, end, functionLength, source.function)) {
+                break;
+            }
+            source.line = static_cast<int>(line);
+            if (id >= sources.size()) {
+                sources.resize(id + 1);
+            }
+            sources[id] = std::move(source);
+        } else if (type == static_cast<uint8_t>(BinaryLogOutput::RecordType::Thread)) {
+            uint16_t id = 0;
+            uint64_t nativeHash = 0;
+            if (!get(src, end, id) || !get(src, end, nativeHash)) {
+                break;
+            }
+        } else if (type == static_cast<uint8_t>(BinaryLogOutput::RecordType::Entry)) {
+            uint8_t level = 0;
+            uint16_t categoryId = 0;
+            uint16_t threadIndex = 0;
+            uint32_t sourceId = 0;
+            uint64_t ticks = 0;
+            uint32_t messageLength = 0;
+            if (!get(src, end, level) || !get(src, end, categoryId) || !get(src, end, threadIndex) ||
+                !get(src, end, sourceId) || !get(src, end, ticks) || !get(src, end, messageLength) ||
+                !getString(src, end, messageLength, entry.message)) {
+                break;
+            }
+            const Source& source = sourceId < sources.size() ? sources[sourceId] : unknownSource;
+            entry.level = static_cast<LogLevel>(level);
+            entry.timestamp = std::chrono::system_clock::time_point(
+                std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ticks)));
+            entry.category = categoryId < categories.size() ? categories[categoryId] : unknownCategory;
+            entry.file = source.file;
+            entry.line = source.line;
+            entry.function = source.function;
+            entry.threadId = std::thread::id();
+            callback(entry, threadIndex);
+        } else {
+            // End record or garbage past the last complete write
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace pers
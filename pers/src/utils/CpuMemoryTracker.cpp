@@ -0,0 +1,119 @@
+#include "pers/utils/CpuMemoryTracker.h"
+#include "pers/utils/Metrics.h"
+#include <atomic>
+#include <cstdio>
+
+namespace pers {
+
+namespace {
+
+constexpr size_t TAG_COUNT = static_cast<size_t>(MemoryTag::Count);
+
+// One cache line per tag, subsystems allocating on different threads do not share lines
+struct alignas(64) TagCounters {
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> peakBytes{0};
+    std::atomic<uint64_t> allocations{0};
+    MetricCounter* liveGauge = nullptr;
+    MetricCounter* peakGauge = nullptr;
+};
+
+std::string lowerName(const char* name) {
+    std::string lower(name);
+    for (char& c : lower) {
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return lower;
+}
+
+// Function-local so tagged containers built during static initialization are counted
+TagCounters* tagCounters() {
+    static TagCounters* counters = [] {
+        // Leaked like the metrics registry, tagged memory may be released during static destruction
+        auto* created = new TagCounters[TAG_COUNT];
+        for (size_t i = 0; i < TAG_COUNT; ++i) {
+            const char* name = CpuMemoryTracker::getTagName(static_cast<MemoryTag>(i));
+            const std::string suffix = lowerName(name);
+            created[i].liveGauge = &Metrics::gauge("pers_cpu_memory_bytes_" + suffix,
+                std::string("CPU heap bytes held by ") + name);
+            created[i].peakGauge = &Metrics::gauge("pers_cpu_memory_peak_bytes_" + suffix,
+                std::string("Peak CPU heap bytes held by ") + name);
+        }
+        return created;
+    }();
+    return counters;
+}
+
+} // anonymous namespace
+
+void CpuMemoryTracker::allocate(MemoryTag tag, size_t bytes) {
+    TagCounters& counters = tagCounters()[static_cast<size_t>(tag)];
+    const uint64_t live = counters.bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.liveGauge->add(static_cast<int64_t>(bytes));
+
+    uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (live > peak) {
+        if (counters.peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            counters.peakGauge->add(static_cast<int64_t>(live - peak));
+            break;
+        }
+    }
+}
+
+void CpuMemoryTracker::release(MemoryTag tag, size_t bytes) {
+    TagCounters& counters = tagCounters()[static_cast<size_t>(tag)];
+    counters.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+    counters.liveGauge->add(-static_cast<int64_t>(bytes));
+}
+
+uint64_t CpuMemoryTracker::getUsage(MemoryTag tag) {
+    return tagCounters()[static_cast<size_t>(tag)].bytes.load(std::memory_order_relaxed);
+}
+
+uint64_t CpuMemoryTracker::getPeakUsage(MemoryTag tag) {
+    return tagCounters()[static_cast<size_t>(tag)].peakBytes.load(std::memory_order_relaxed);
+}
+
+CpuMemoryTracker::Stats CpuMemoryTracker::getStats() {
+    Stats stats;
+    const TagCounters* counters = tagCounters();
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        stats.bytes[i] = counters[i].bytes.load(std::memory_order_relaxed);
+        stats.peakBytes[i] = counters[i].peakBytes.load(std::memory_order_relaxed);
+        stats.allocations[i] = counters[i].allocations.load(std::memory_order_relaxed);
+        stats.totalBytes += stats.bytes[i];
+    }
+    return stats;
+}
+
+std::string CpuMemoryTracker::formatReport() {
+    const Stats stats = getStats();
+    std::string report;
+    char line[160];
+    std::snprintf(line, sizeof(line), "CPU memory (tagged): %.2f MiB\n", stats.totalBytes / (1024.0 * 1024.0));
+    report += line;
+    for (size_t i = 0; i < TAG_COUNT; ++i) {
+        std::snprintf(line, sizeof(line), "  %-12s %10.2f KiB  peak %10.2f KiB  (%llu allocations)\n",
+                      getTagName(static_cast<MemoryTag>(i)), stats.bytes[i] / 1024.0, stats.peakBytes[i] / 1024.0,
+                      static_cast<unsigned long long>(stats.allocations[i]));
+        report += line;
+    }
+    return report;
+}
+
+const char* CpuMemoryTracker::getTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::General: return "General";
+        case MemoryTag::Descriptors: return "Descriptors";
+        case MemoryTag::Caches: return "Caches";
+        case MemoryTag::Logging: return "Logging";
+        case MemoryTag::Loaders: return "Loaders";
+        default: return "Unknown";
+    }
+}
+
+} // namespace pers
@@ -0,0 +1,62 @@
+#include "pers/utils/DebugLabel.h"
+#include "pers/utils/Mutex.h"
+#include <deque>
+#include <unordered_map>
+
+namespace pers {
+
+namespace {
+
+class DebugLabelTable {
+public:
+    static DebugLabelTable& instance() {
+        // Leaked so labels held by static resources stay valid during shutdown
+        static DebugLabelTable* table = new DebugLabelTable();
+        return *table;
+    }
+
+    const detail::DebugLabelEntry* intern(std::string_view text) {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        auto it = _lookup.find(text);
+        if (it != _lookup.end()) {
+            return it->second;
+        }
+
+        // Deque growth never moves entries, so keys and handed-out pointers stay valid
+        const uint32_t id = static_cast<uint32_t>(_entries.size()) + 1;
+        _entries.push_back({std::string(text), id});
+        const detail::DebugLabelEntry& entry = _entries.back();
+        _lookup.emplace(std::string_view(entry.text), &entry);
+        return &entry;
+    }
+
+    size_t size() {
+        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+        return _entries.size();
+    }
+
+private:
+    Mutex<false> _mutex;
+    std::deque<detail::DebugLabelEntry> _entries;
+    std::unordered_map<std::string_view, const detail::DebugLabelEntry*> _lookup;
+};
+
+} // anonymous namespace
+
+const detail::DebugLabelEntry* DebugLabel::intern(std::string_view text) {
+    if (text.empty()) {
+        return nullptr;
+    }
+    return DebugLabelTable::instance().intern(text);
+}
+
+const std::string& DebugLabel::emptyString() {
+    static const std::string empty;
+    return empty;
+}
+
+size_t DebugLabel::getInternedCount() {
+    return DebugLabelTable::instance().size();
+}
+
+} // namespace pers
@@ -0,0 +1,113 @@
+#include "pers/utils/FrameArena.h"
+#include <algorithm>
+
+namespace pers {
+
+std::atomic<uint64_t> FrameArena::s_frameEpoch{0};
+
+FrameArena::ScratchScope::ScratchScope()
+    : _arena(FrameArena::current())
+    , _marker(_arena.mark()) {
+    ++_arena._scopeDepth;
+}
+
+FrameArena::ScratchScope::~ScratchScope() {
+    --_arena._scopeDepth;
+    _arena.rewind(_marker);
+}
+
+FrameArena::FrameArena(size_t blockSize)
+    : _blockSize(std::max<size_t>(blockSize, 256)) {
+}
+
+FrameArena& FrameArena::current() {
+    thread_local FrameArena arena;
+    const uint64_t epoch = s_frameEpoch.load(std::memory_order_relaxed);
+    if (arena._epoch != epoch && arena._scopeDepth == 0) {
+        arena._epoch = epoch;
+        arena.reset();
+    }
+    return arena;
+}
+
+void FrameArena::beginFrame() {
+    s_frameEpoch.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+
+    while (true) {
+        if (_block < _blocks.size()) {
+            Block& block = _blocks[_block];
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.data());
+            const uintptr_t aligned = (base + _offset + alignment - 1) & ~(uintptr_t(alignment) - 1);
+            const size_t end = static_cast<size_t>(aligned - base) + size;
+            if (end <= block.size) {
+                _offset = end;
+                _peakBytes = std::max(_peakBytes, getUsedBytes());
+                return reinterpret_cast<void*>(aligned);
+            }
+            // Spill into the next block, reusing it if the last reset kept one
+            if (_block + 1 < _blocks.size() && _blocks[_block + 1].size >= size + alignment) {
+                ++_block;
+                _offset = 0;
+                continue;
+            }
+        }
+
+        Block block;
+        block.size = std::max(_blockSize, size + alignment);
+        allocateBlock(block);
+        // Blocks past the cursor were left over from an earlier frame and are too small
+        _blocks.resize(_blocks.empty() ? 0 : _block + 1);
+        _blocks.push_back(std::move(block));
+        _block = _blocks.size() - 1;
+        _offset = 0;
+    }
+}
+
+void FrameArena::rewind(const Marker& marker) {
+    _block = marker.block;
+    _offset = marker.offset;
+}
+
+void FrameArena::reset() {
+    if (_blocks.size() > 1) {
+        // One block big enough for the peak avoids spilling next frame
+        Block block;
+        block.size = std::max(_blockSize, _peakBytes);
+        allocateBlock(block);
+        _blocks.clear();
+        _blocks.push_back(std::move(block));
+    }
+    _block = 0;
+    _offset = 0;
+    _peakBytes = 0;
+}
+
+void FrameArena::allocateBlock(Block& block) {
+    if (!block.data.allocate(block.size)) {
+        throw std::bad_alloc();
+    }
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (const Block& block : _blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+size_t FrameArena::getUsedBytes() const {
+    size_t used = _offset;
+    for (size_t i = 0; i < _block && i < _blocks.size(); ++i) {
+        used += _blocks[i].size;
+    }
+    return used;
+}
+
+} // namespace pers
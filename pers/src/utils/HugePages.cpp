@@ -0,0 +1,245 @@
+#include "pers/utils/HugePages.h"
+#include "pers/utils/Logger.h"
+#include <atomic>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#if defined(__linux__)
+#include <fstream>
+#endif
+#endif
+
+namespace pers {
+
+namespace {
+
+std::atomic<HugePageMode> g_mode{HugePageMode::Transparent};
+std::atomic<bool> g_explicitFallbackLogged{false};
+
+constexpr size_t DEFAULT_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+size_t queryPageSize() {
+#if defined(_WIN32)
+    return static_cast<size_t>(GetLargePageMinimum());
+#elif defined(__linux__)
+    size_t size = 0;
+    std::ifstream file("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+    if (file >> size && size > 0 && (size & (size - 1)) == 0) {
+        return size;
+    }
+    return DEFAULT_HUGE_PAGE_SIZE;
+#else
+    return 0;
+#endif
+}
+
+void logExplicitFallback(size_t size) {
+    if (!g_explicitFallbackLogged.exchange(true, std::memory_order_relaxed)) {
+        Logger::Instance().LogFormat(LogLevel::Info, "HugePages", PERS_SOURCE_LOC,
+            "Explicit huge pages unavailable for %zu bytes, falling back", size);
+    }
+}
+
+#if defined(_WIN32)
+// MEM_LARGE_PAGE needs SeLockMemoryPrivilege enabled in the process token
+bool enableLockMemoryPrivilege() {
+    static const bool enabled = [] {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) {
+            return false;
+        }
+        TOKEN_PRIVILEGES privileges = {};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool result = LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+                      AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                      GetLastError() == ERROR_SUCCESS;
+        CloseHandle(token);
+        return result;
+    }();
+    return enabled;
+}
+#endif
+
+} // anonymous namespace
+
+void HugePages::setMode(HugePageMode mode) {
+    g_mode.store(mode, std::memory_order_relaxed);
+}
+
+HugePageMode HugePages::getMode() {
+    return g_mode.load(std::memory_order_relaxed);
+}
+
+size_t HugePages::getPageSize() {
+    static const size_t pageSize = queryPageSize();
+    return pageSize;
+}
+
+bool HugePages::adviseRange(const void* data, size_t size) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    const size_t pageSize = getPageSize();
+    if (getMode() == HugePageMode::Off || !data || pageSize == 0) {
+        return false;
+    }
+    // Only whole huge pages inside the range can be collapsed
+    const uintptr_t begin = roundUp(reinterpret_cast<uintptr_t>(data), pageSize);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(data) + size) & ~(uintptr_t(pageSize) - 1);
+    if (end <= begin) {
+        return false;
+    }
+    return madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0;
+#else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    return false;
+#endif
+}
+
+const char* HugePages::getModeName(HugePageMode mode) {
+    switch (mode) {
+        case HugePageMode::Off: return "Off";
+        case HugePageMode::Transparent: return "Transparent";
+        case HugePageMode::Explicit: return "Explicit";
+        default: return "Unknown";
+    }
+}
+
+HugePageBuffer::~HugePageBuffer() {
+    release();
+}
+
+HugePageBuffer::HugePageBuffer(HugePageBuffer&& other) noexcept {
+    *this = std::move(other);
+}
+
+HugePageBuffer& HugePageBuffer::operator=(HugePageBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+        _mappedSize = std::exchange(other._mappedSize, 0);
+        _backing = std::exchange(other._backing, Backing::None);
+    }
+    return *this;
+}
+
+bool HugePageBuffer::allocate(size_t size) {
+    release();
+    if (size == 0) {
+        return true;
+    }
+
+    const HugePageMode mode = HugePages::getMode();
+    const size_t pageSize = HugePages::getPageSize();
+    if (mode == HugePageMode::Off || pageSize == 0 || size < pageSize) {
+        _data = new (std::nothrow) uint8_t[size]();
+        if (!_data) {
+            return false;
+        }
+        _size = size;
+        _backing = Backing::Heap;
+        return true;
+    }
+
+    const size_t mappedSize = roundUp(size, pageSize);
+#if defined(_WIN32)
+    void* memory = nullptr;
+    Backing backing = Backing::Mapped;
+    if (mode == HugePageMode::Explicit) {
+        if (enableLockMemoryPrivilege()) {
+            memory = VirtualAlloc(nullptr, mappedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGE, PAGE_READWRITE);
+        }
+        if (memory) {
+            backing = Backing::Explicit;
+        } else {
+            logExplicitFallback(size);
+        }
+    }
+    // Windows has no transparent huge pages, regular committed pages it is
+    if (!memory) {
+        memory = VirtualAlloc(nullptr, mappedSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    }
+    if (!memory) {
+        return false;
+    }
+#else
+    void* memory = nullptr;
+    Backing backing = Backing::Mapped;
+#if defined(MAP_HUGETLB)
+    if (mode == HugePageMode::Explicit) {
+        memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory == MAP_FAILED) {
+            memory = nullptr;
+            logExplicitFallback(size);
+        } else {
+            backing = Backing::Explicit;
+        }
+    }
+#endif
+    if (!memory) {
+        // Over-map by one page and trim, THP only collapses aligned ranges
+        void* raw = mmap(nullptr, mappedSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return false;
+        }
+        const uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+        const uintptr_t aligned = roundUp(base, pageSize);
+        if (aligned > base) {
+            munmap(raw, aligned - base);
+        }
+        const size_t tail = (base + mappedSize + pageSize) - (aligned + mappedSize);
+        if (tail > 0) {
+            munmap(reinterpret_cast<void*>(aligned + mappedSize), tail);
+        }
+        memory = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+        if (madvise(memory, mappedSize, MADV_HUGEPAGE) == 0) {
+            backing = Backing::Advised;
+        }
+#endif
+    }
+#endif
+
+    _data = static_cast<uint8_t*>(memory);
+    _size = size;
+    _mappedSize = mappedSize;
+    _backing = backing;
+    return true;
+}
+
+void HugePageBuffer::release() {
+    switch (_backing) {
+        case Backing::None:
+            return;
+        case Backing::Heap:
+            delete[] _data;
+            break;
+        case Backing::Mapped:
+        case Backing::Advised:
+        case Backing::Explicit:
+#if defined(_WIN32)
+            VirtualFree(_data, 0, MEM_RELEASE);
+#else
+            munmap(_data, _mappedSize);
+#endif
+            break;
+    }
+    _data = nullptr;
+    _size = 0;
+    _mappedSize = 0;
+    _backing = Backing::None;
+}
+
+} // namespace pers
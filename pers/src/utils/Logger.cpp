@@ -1,11 +1,16 @@
 #include "pers/utils/Logger.h"
+#include "pers/utils/CpuMemoryTracker.h"
 #include "pers/utils/Mutex.h"
+#include "pers/utils/ThreadAffinity.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <ctime>
-#include <map>
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <string_view>
 
 // Platform detection check
 #if defined(__APPLE__)
@@ -68,11 +73,13 @@ void ConsoleOutput::Write(const LogEntry& entry) {
         out << "[" << filename << ":" << entry.line << "] ";
     }
     
-    out << entry.message << std::endl;
+    // Flushed by the logger, once per line in synchronous mode and once per batch in async mode
+    out << entry.message << '\n';
 }
 
 void ConsoleOutput::Flush() {
     std::cout.flush();
+    std::cerr.flush();
 }
 
 // FileOutput implementation
@@ -114,7 +121,7 @@ void FileOutput::Write(const LogEntry& entry) {
         _file << "[" << entry.category << "] ";
     }
     
-    _file << entry.message << std::endl;
+    _file << entry.message << '\n';
 }
 
 void FileOutput::Flush() {
@@ -122,19 +129,244 @@ void FileOutput::Flush() {
     _file.flush();
 }
 
+// Entries logged while async mode is on, drained by a single writer thread.
+// The ring is a bounded MPSC queue: producers claim a slot by advancing
+// _enqueuePos and publish it through the slot's sequence number.
+class Logger::AsyncWriter {
+public:
+    static constexpr size_t CATEGORY_CAPACITY = 48;
+    static constexpr size_t MESSAGE_CAPACITY = 256;   // Longer messages spill to the heap
+    static constexpr size_t BATCH_SIZE = 256;
+
+    AsyncWriter(Logger& logger, size_t capacity)
+        : _logger(logger) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        _slots = std::make_unique<Slot[]>(size);
+        _mask = size - 1;
+        CpuMemoryTracker::allocate(MemoryTag::Logging, size * sizeof(Slot));
+        for (size_t i = 0; i < size; ++i) {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~AsyncWriter() {
+        stop();
+        // Entries pushed after the writer stopped
+        while (drainBatch() > 0) {
+        }
+        CpuMemoryTracker::release(MemoryTag::Logging, (_mask + 1) * sizeof(Slot));
+    }
+
+    void start() {
+        if (_running.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+        _thread = std::thread([this] { run(); });
+    }
+
+    void stop() {
+        if (!_running.exchange(false, std::memory_order_acq_rel)) {
+            return;
+        }
+        wake();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+    }
+
+    // Returns false if the writer is stopped and the ring is full; the caller then writes synchronously
+    bool push(LogLevel level, std::string_view category, std::string_view message,
+              const LogSource& source, std::chrono::system_clock::time_point timestamp) {
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+        for (;;) {
+            slot = &_slots[pos & _mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                // Full, wait for the writer rather than drop the entry
+                if (!_running.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                wake();
+                std::this_thread::yield();
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        Record& record = slot->record;
+        record.level = level;
+        record.timestamp = timestamp;
+        record.threadId = std::this_thread::get_id();
+        record.file = source.file;
+        record.line = source.line;
+        record.function = source.function;
+        record.categoryLength = static_cast<uint8_t>(std::min(category.size(), CATEGORY_CAPACITY));
+        std::memcpy(record.category, category.data(), record.categoryLength);
+        if (message.size() <= MESSAGE_CAPACITY) {
+            record.messageLength = static_cast<uint16_t>(message.size());
+            std::memcpy(record.message, message.data(), message.size());
+            record.longMessage = nullptr;
+        } else {
+            record.messageLength = 0;
+            record.longMessage = new std::string(message);
+            CpuMemoryTracker::allocate(MemoryTag::Logging, sizeof(std::string) + message.size());
+        }
+        slot->sequence.store(pos + 1, std::memory_order_release);
+
+        if (_sleeping.load(std::memory_order_acquire)) {
+            wake();
+        }
+        return true;
+    }
+
+    // Wait until everything pushed before this call has been written
+    void waitUntilWritten() {
+        uint64_t target = _enqueuePos.load(std::memory_order_acquire);
+        while (_writtenCount.load(std::memory_order_acquire) < target) {
+            if (!_running.load(std::memory_order_acquire)) {
+                drainBatch();
+            } else {
+                wake();
+            }
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    struct Record {
+        LogLevel level = LogLevel::Info;
+        std::chrono::system_clock::time_point timestamp;
+        std::thread::id threadId;
+        const char* file = nullptr;       // Static strings from PERS_SOURCE_LOC
+        const char* function = nullptr;
+        int line = 0;
+        uint8_t categoryLength = 0;
+        uint16_t messageLength = 0;
+        std::string* longMessage = nullptr;
+        char category[CATEGORY_CAPACITY];
+        char message[MESSAGE_CAPACITY];
+    };
+
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        Record record;
+    };
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            _wakePending = true;
+        }
+        _wakeCondition.notify_one();
+    }
+
+    void run() {
+        ThreadAffinity::applyCurrentThread(ThreadRole::Logger);
+        while (_running.load(std::memory_order_acquire)) {
+            if (drainBatch() > 0) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_wakeMutex);
+            _sleeping.store(true, std::memory_order_release);
+            // Timed so a wake racing with _sleeping can only delay, never lose, an entry
+            _wakeCondition.wait_for(lock, std::chrono::milliseconds(10), [this] { return _wakePending; });
+            _wakePending = false;
+            _sleeping.store(false, std::memory_order_release);
+        }
+        while (drainBatch() > 0) {
+        }
+    }
+
+    // Single consumer: only the writer thread, or whoever holds the writer after it stopped
+    size_t drainBatch() {
+        std::lock_guard<std::mutex> drainLock(_drainMutex);
+        size_t count = 0;
+        auto guard = makeLockGuard(_logger._mutex, PERS_SOURCE_LOC);
+        while (count < BATCH_SIZE) {
+            Slot& slot = _slots[_dequeuePos & _mask];
+            if (slot.sequence.load(std::memory_order_acquire) != _dequeuePos + 1) {
+                break;
+            }
+
+            Record& record = slot.record;
+            _entry.level = record.level;
+            _entry.timestamp = record.timestamp;
+            _entry.threadId = record.threadId;
+            _entry.file = record.file ? record.file : "";
+            _entry.line = record.line;
+            _entry.function = record.function ? record.function : "";
+            _entry.category.assign(record.category, record.categoryLength);
+            if (record.longMessage) {
+                CpuMemoryTracker::release(MemoryTag::Logging, sizeof(std::string) + record.longMessage->size());
+                _entry.message = std::move(*record.longMessage);
+                delete record.longMessage;
+                record.longMessage = nullptr;
+            } else {
+                _entry.message.assign(record.message, record.messageLength);
+            }
+            slot.sequence.store(_dequeuePos + _mask + 1, std::memory_order_release);
+            ++_dequeuePos;
+
+            _logger.WriteToOutputs(_entry);
+            ++count;
+        }
+        if (count > 0) {
+            _logger.FlushOutputs();
+            _writtenCount.fetch_add(count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    Logger& _logger;
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask = 0;
+    alignas(64) std::atomic<size_t> _enqueuePos{0};
+    alignas(64) size_t _dequeuePos = 0;
+    std::atomic<uint64_t> _writtenCount{0};
+    LogEntry _entry;    // Reused across records to keep string capacity
+
+    std::thread _thread;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _sleeping{false};
+    std::mutex _wakeMutex;
+    std::condition_variable _wakeCondition;
+    bool _wakePending = false;
+    std::mutex _drainMutex;
+};
+
+namespace {
+    thread_local int t_callbackDepth = 0;
+}
+
 // Logger implementation
 Logger::Logger() 
     : _minLevel(LogLevel::Trace),
-      _mutex("Logger") {
+      _enabledLevels(0),
+      _activeLevels(0),
+      _callbackLevels(0),
+      _mutex("Logger"),
+      _activeWriter(nullptr),
+      _asyncMutex("LoggerAsync") {
     // Enable all log levels by default
-    for (int i = static_cast<int>(LogLevel::Trace); i <= static_cast<int>(LogLevel::Critical); ++i) {
-        _enabledLevels[static_cast<LogLevel>(i)] = true;
-    }
+    _enabledLevels.store((1u << LOG_LEVEL_COUNT) - 1, std::memory_order_relaxed);
+    _activeLevels.store((1u << LOG_LEVEL_COUNT) - 1, std::memory_order_relaxed);
     // Add basic ConsoleOutput
     AddOutput(std::make_shared<ConsoleOutput>(true));
 }
 
-Logger::~Logger() = default;
+Logger::~Logger() {
+    DisableAsync();
+}
 
 Logger& Logger::Instance() {
     static Logger instance;
@@ -143,17 +375,24 @@ Logger& Logger::Instance() {
 
 void Logger::setCallback(LogLevel level, const LogCallback& callback) {
     auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    _callbacks[level] = callback;
+    _callbacks[static_cast<size_t>(level)] = callback;
+    if (callback) {
+        _callbackLevels.fetch_or(LevelBit(level), std::memory_order_release);
+    } else {
+        _callbackLevels.fetch_and(~LevelBit(level), std::memory_order_release);
+    }
 }
 
 void Logger::clearCallback(LogLevel level) {
     auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    _callbacks.erase(level);
+    _callbacks[static_cast<size_t>(level)] = nullptr;
+    _callbackLevels.fetch_and(~LevelBit(level), std::memory_order_release);
 }
 
 void Logger::clearAllCallbacks() {
     auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    _callbacks.clear();
+    _callbacks.fill(nullptr);
+    _callbackLevels.store(0, std::memory_order_release);
 }
 
 void Logger::AddOutput(const std::shared_ptr<ILogOutput>& output) {
@@ -167,7 +406,9 @@ void Logger::RemoveAllOutputs() {
 }
 
 void Logger::SetMinLevel(LogLevel level) {
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
     _minLevel = level;
+    UpdateActiveLevels();
 }
 
 LogLevel Logger::GetMinLevel() const {
@@ -176,13 +417,22 @@ LogLevel Logger::GetMinLevel() const {
 
 void Logger::SetLogLevelEnabled(LogLevel level, bool enabled) {
     auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    _enabledLevels[level] = enabled;
+    if (enabled) {
+        _enabledLevels.fetch_or(LevelBit(level), std::memory_order_relaxed);
+    } else {
+        _enabledLevels.fetch_and(~LevelBit(level), std::memory_order_relaxed);
+    }
+    UpdateActiveLevels();
+}
+
+void Logger::UpdateActiveLevels() {
+    // Bits at and above the minimum level
+    uint32_t aboveMin = ((1u << LOG_LEVEL_COUNT) - 1) & ~(LevelBit(_minLevel.load()) - 1);
+    _activeLevels.store(_enabledLevels.load(std::memory_order_relaxed) & aboveMin, std::memory_order_relaxed);
 }
 
 bool Logger::IsLogLevelEnabled(LogLevel level) const {
-    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    auto it = _enabledLevels.find(level);
-    return it != _enabledLevels.end() ? it->second : true;
+    return (_enabledLevels.load(std::memory_order_relaxed) & LevelBit(level)) != 0;
 }
 
 void Logger::SetCategoryFilter(const std::string& pattern) {
@@ -190,38 +440,64 @@ void Logger::SetCategoryFilter(const std::string& pattern) {
     _categoryFilter = pattern;
 }
 
-void Logger::LogInternal(const LogEntry& entry, const LogSource& source) {
-    static thread_local int callbackDepth = 0;
-    
-    if (callbackDepth > 0) {
-        std::cerr << "[LOGGER] Recursive logging detected (depth=" << callbackDepth 
-                 << "): " << entry.message << std::endl;
+void Logger::EnableAsync(size_t capacity) {
+    auto guard = makeLockGuard(_asyncMutex, PERS_SOURCE_LOC);
+    if (!_asyncWriter) {
+        _asyncWriter = std::make_unique<AsyncWriter>(*this, capacity);
+    }
+    _asyncWriter->start();
+    _activeWriter.store(_asyncWriter.get(), std::memory_order_release);
+}
+
+void Logger::DisableAsync() {
+    auto guard = makeLockGuard(_asyncMutex, PERS_SOURCE_LOC);
+    if (!_asyncWriter) {
         return;
     }
-    
-    if (entry.level < _minLevel) {
+    _activeWriter.store(nullptr, std::memory_order_release);
+    // Stopping drains the ring; a producer that loaded the writer just before
+    // this still completes its push, and is written by the next Flush() or at shutdown
+    _asyncWriter->stop();
+}
+
+bool Logger::IsAsync() const {
+    return _activeWriter.load(std::memory_order_acquire) != nullptr;
+}
+
+void Logger::WriteToOutputs(const LogEntry& entry) {
+    // Category filter check
+    if (!_categoryFilter.empty() && entry.category.find(_categoryFilter) == std::string::npos) {
         return;
     }
     
-    // Check if this log level is enabled
-    {
-        auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-        auto it = _enabledLevels.find(entry.level);
-        if (it != _enabledLevels.end() && !it->second) {
-            return;
-        }
+    for (auto& output : _outputs) {
+        output->Write(entry);
+    }
+}
+
+void Logger::FlushOutputs() {
+    for (auto& output : _outputs) {
+        output->Flush();
+    }
+}
+
+void Logger::LogInternal(const LogEntry& entry, const LogSource& source) {
+    if (t_callbackDepth > 0) {
+        std::cerr << "[LOGGER] Recursive logging detected (depth=" << t_callbackDepth 
+                 << "): " << entry.message << std::endl;
+        return;
     }
     
     bool skipLogging = false;
     
     // Check for callback
-    {
+    if (_callbackLevels.load(std::memory_order_acquire) & LevelBit(entry.level)) {
         auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-        auto callbackIt = _callbacks.find(entry.level);
-        if (callbackIt != _callbacks.end() && callbackIt->second) {
-            ++callbackDepth;
-            callbackIt->second(entry.level, entry.category, entry.message, source, entry.timestamp, skipLogging);
-            --callbackDepth;
+        const LogCallback& callback = _callbacks[static_cast<size_t>(entry.level)];
+        if (callback) {
+            ++t_callbackDepth;
+            callback(entry.level, entry.category, entry.message, source, entry.timestamp, skipLogging);
+            --t_callbackDepth;
         }
     }
     
@@ -230,23 +506,34 @@ void Logger::LogInternal(const LogEntry& entry, const LogSource& source) {
         return;
     }
     
-    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-
-    // Category filter check
-    if (!_categoryFilter.empty() && entry.category.find(_categoryFilter) == std::string::npos) {
-        return;
+    if (AsyncWriter* writer = _activeWriter.load(std::memory_order_acquire)) {
+        if (writer->push(entry.level, entry.category, entry.message, source, entry.timestamp)) {
+            return;
+        }
     }
     
-    // Write to all outputs
-    for (auto& output : _outputs) {
-        output->Write(entry);
-    }
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    WriteToOutputs(entry);
+    FlushOutputs();
 }
 
 void Logger::Log(LogLevel level,
                  const std::string& category,
                  const std::string& message,
                  const LogSource& source) {
+    if (!ShouldLog(level)) {
+        return;
+    }
+    
+    // Async fast path: no LogEntry, no lock, one copy into the ring
+    AsyncWriter* writer = _activeWriter.load(std::memory_order_acquire);
+    if (writer && t_callbackDepth == 0 &&
+        !(_callbackLevels.load(std::memory_order_acquire) & LevelBit(level))) {
+        if (writer->push(level, category, message, source, std::chrono::system_clock::now())) {
+            return;
+        }
+    }
+    
     LogEntry entry;
     entry.level = level;
     entry.timestamp = std::chrono::system_clock::now();
@@ -261,10 +548,14 @@ void Logger::Log(LogLevel level,
 }
 
 void Logger::Flush() {
-    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
-    for (auto& output : _outputs) {
-        output->Flush();
+    {
+        auto asyncGuard = makeLockGuard(_asyncMutex, PERS_SOURCE_LOC);
+        if (_asyncWriter) {
+            _asyncWriter->waitUntilWritten();
+        }
     }
+    auto guard = makeLockGuard(_mutex, PERS_SOURCE_LOC);
+    FlushOutputs();
 }
 
 // LogStream implementation
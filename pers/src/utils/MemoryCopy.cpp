@@ -0,0 +1,314 @@
+#include "pers/utils/MemoryCopy.h"
+#include "pers/utils/CpuFeatures.h"
+#include <atomic>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define PERS_COPY_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PERS_COPY_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only emit wider instructions inside functions that opt in
+#if defined(__GNUC__) || defined(__clang__)
+#define PERS_TARGET(features) __attribute__((target(features)))
+#else
+#define PERS_TARGET(features)
+#endif
+
+namespace pers {
+
+namespace {
+
+// Copy up to the first aligned address of the pointer being streamed,
+// returns the number of bytes consumed
+inline size_t alignHead(uint8_t*& dst, const uint8_t*& src, size_t size, uintptr_t alignedPtr, size_t alignment) {
+    size_t head = (alignment - (alignedPtr & (alignment - 1))) & (alignment - 1);
+    head = head < size ? head : size;
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    return head;
+}
+
+#if PERS_COPY_X86
+
+// SSE2 is part of x86-64, no target attribute needed
+void streamStoreSSE2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(dst), 16);
+    for (; size >= 64; size -= 64, src += 64, dst += 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+    }
+    std::memcpy(dst, src, size);
+    _mm_sfence();
+}
+
+PERS_TARGET("avx2")
+void streamStoreAVX2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(dst), 32);
+    for (; size >= 128; size -= 128, src += 128, dst += 128) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 32));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 64));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst), a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 32), b);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 64), c);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(dst + 96), d);
+    }
+    std::memcpy(dst, src, size);
+    _mm_sfence();
+}
+
+PERS_TARGET("avx512f")
+void streamStoreAVX512(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(dst), 64);
+    for (; size >= 256; size -= 256, src += 256, dst += 256) {
+        __m512i a = _mm512_loadu_si512(src);
+        __m512i b = _mm512_loadu_si512(src + 64);
+        __m512i c = _mm512_loadu_si512(src + 128);
+        __m512i d = _mm512_loadu_si512(src + 192);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst), a);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 64), b);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 128), c);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dst + 192), d);
+    }
+    std::memcpy(dst, src, size);
+    _mm_sfence();
+}
+
+// Streaming loads (MOVNTDQA) only bypass the cache on write-combined memory;
+// on cached read-back memory they behave like ordinary aligned loads
+PERS_TARGET("sse4.1")
+void streamLoadSSE41(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(src), 16);
+    for (; size >= 64; size -= 64, src += 64, dst += 64) {
+        __m128i a = _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8_t*>(src)));
+        __m128i b = _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8_t*>(src + 16)));
+        __m128i c = _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8_t*>(src + 32)));
+        __m128i d = _mm_stream_load_si128(reinterpret_cast<__m128i*>(const_cast<uint8_t*>(src + 48)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 48), d);
+    }
+    std::memcpy(dst, src, size);
+}
+
+PERS_TARGET("avx2")
+void streamLoadAVX2(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(src), 32);
+    for (; size >= 128; size -= 128, src += 128, dst += 128) {
+        __m256i a = _mm256_stream_load_si256(reinterpret_cast<const __m256i*>(src));
+        __m256i b = _mm256_stream_load_si256(reinterpret_cast<const __m256i*>(src + 32));
+        __m256i c = _mm256_stream_load_si256(reinterpret_cast<const __m256i*>(src + 64));
+        __m256i d = _mm256_stream_load_si256(reinterpret_cast<const __m256i*>(src + 96));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), b);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 64), c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 96), d);
+    }
+    std::memcpy(dst, src, size);
+}
+
+PERS_TARGET("avx512f")
+void streamLoadAVX512(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(src), 64);
+    for (; size >= 256; size -= 256, src += 256, dst += 256) {
+        __m512i a = _mm512_stream_load_si512(const_cast<uint8_t*>(src));
+        __m512i b = _mm512_stream_load_si512(const_cast<uint8_t*>(src + 64));
+        __m512i c = _mm512_stream_load_si512(const_cast<uint8_t*>(src + 128));
+        __m512i d = _mm512_stream_load_si512(const_cast<uint8_t*>(src + 192));
+        _mm512_storeu_si512(dst, a);
+        _mm512_storeu_si512(dst + 64, b);
+        _mm512_storeu_si512(dst + 128, c);
+        _mm512_storeu_si512(dst + 192, d);
+    }
+    std::memcpy(dst, src, size);
+}
+
+#endif // PERS_COPY_X86
+
+#if PERS_COPY_NEON
+
+void streamStoreNEON(uint8_t* dst, const uint8_t* src, size_t size) {
+    size -= alignHead(dst, src, size, reinterpret_cast<uintptr_t>(dst), 64);
+    for (; size >= 64; size -= 64, src += 64, dst += 64) {
+#if defined(__GNUC__) || defined(__clang__)
+        // STNP hints that the line will not be re-read; there is no intrinsic for it
+        __asm__ volatile(
+            "ldp q0, q1, [%1]\n"
+            "ldp q2, q3, [%1, #32]\n"
+            "stnp q0, q1, [%0]\n"
+            "stnp q2, q3, [%0, #32]\n"
+            :
+            : "r"(dst), "r"(src)
+            : "v0", "v1", "v2", "v3", "memory");
+#else
+        vst1q_u8(dst, vld1q_u8(src));
+        vst1q_u8(dst + 16, vld1q_u8(src + 16));
+        vst1q_u8(dst + 32, vld1q_u8(src + 32));
+        vst1q_u8(dst + 48, vld1q_u8(src + 48));
+#endif
+    }
+    std::memcpy(dst, src, size);
+}
+
+void streamLoadNEON(uint8_t* dst, const uint8_t* src, size_t size) {
+    for (; size >= 64; size -= 64, src += 64, dst += 64) {
+        uint8x16_t a = vld1q_u8(src);
+        uint8x16_t b = vld1q_u8(src + 16);
+        uint8x16_t c = vld1q_u8(src + 32);
+        uint8x16_t d = vld1q_u8(src + 48);
+        vst1q_u8(dst, a);
+        vst1q_u8(dst + 16, b);
+        vst1q_u8(dst + 32, c);
+        vst1q_u8(dst + 48, d);
+    }
+    std::memcpy(dst, src, size);
+}
+
+#endif // PERS_COPY_NEON
+
+CopyKernel detectBestKernel() {
+#if PERS_COPY_X86
+    const CpuFeatures& features = getCpuFeatures();
+    if (features.avx512) {
+        return CopyKernel::AVX512;
+    }
+    if (features.avx2) {
+        return CopyKernel::AVX2;
+    }
+    return CopyKernel::SSE2;
+#elif PERS_COPY_NEON
+    return CopyKernel::NEON;
+#else
+    return CopyKernel::Memcpy;
+#endif
+}
+
+std::atomic<CopyKernel>& activeKernel() {
+    static std::atomic<CopyKernel> kernel{detectBestKernel()};
+    return kernel;
+}
+
+} // anonymous namespace
+
+void copyToMappedMemory(void* dst, const void* src, size_t size) {
+    auto* d = static_cast<uint8_t*>(dst);
+    const auto* s = static_cast<const uint8_t*>(src);
+    if (size < STREAMING_COPY_THRESHOLD) {
+        std::memcpy(d, s, size);
+        return;
+    }
+
+    switch (activeKernel().load(std::memory_order_relaxed)) {
+#if PERS_COPY_X86
+    case CopyKernel::AVX512:
+        streamStoreAVX512(d, s, size);
+        return;
+    case CopyKernel::AVX2:
+        streamStoreAVX2(d, s, size);
+        return;
+    case CopyKernel::SSE2:
+        streamStoreSSE2(d, s, size);
+        return;
+#elif PERS_COPY_NEON
+    case CopyKernel::NEON:
+        streamStoreNEON(d, s, size);
+        return;
+#endif
+    default:
+        std::memcpy(d, s, size);
+        return;
+    }
+}
+
+void copyFromMappedMemory(void* dst, const void* src, size_t size) {
+    auto* d = static_cast<uint8_t*>(dst);
+    const auto* s = static_cast<const uint8_t*>(src);
+    if (size < STREAMING_COPY_THRESHOLD) {
+        std::memcpy(d, s, size);
+        return;
+    }
+
+    switch (activeKernel().load(std::memory_order_relaxed)) {
+#if PERS_COPY_X86
+    case CopyKernel::AVX512:
+        streamLoadAVX512(d, s, size);
+        return;
+    case CopyKernel::AVX2:
+        streamLoadAVX2(d, s, size);
+        return;
+    case CopyKernel::SSE2:
+        // MOVNTDQA needs SSE4.1, which practically every x86-64 CPU has
+        if (getCpuFeatures().sse41) {
+            streamLoadSSE41(d, s, size);
+        } else {
+            std::memcpy(d, s, size);
+        }
+        return;
+#elif PERS_COPY_NEON
+    case CopyKernel::NEON:
+        streamLoadNEON(d, s, size);
+        return;
+#endif
+    default:
+        std::memcpy(d, s, size);
+        return;
+    }
+}
+
+CopyKernel getCopyKernel() {
+    return activeKernel().load(std::memory_order_relaxed);
+}
+
+bool setCopyKernel(CopyKernel kernel) {
+    if (!isCopyKernelSupported(kernel)) {
+        return false;
+    }
+    activeKernel().store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+bool isCopyKernelSupported(CopyKernel kernel) {
+    switch (kernel) {
+    case CopyKernel::Memcpy:
+        return true;
+#if PERS_COPY_X86
+    case CopyKernel::SSE2:
+        return true;
+    case CopyKernel::AVX2:
+        return getCpuFeatures().avx2;
+    case CopyKernel::AVX512:
+        return getCpuFeatures().avx512;
+#elif PERS_COPY_NEON
+    case CopyKernel::NEON:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* getCopyKernelName(CopyKernel kernel) {
+    switch (kernel) {
+    case CopyKernel::Memcpy: return "memcpy";
+    case CopyKernel::SSE2:   return "SSE2";
+    case CopyKernel::AVX2:   return "AVX2";
+    case CopyKernel::AVX512: return "AVX-512";
+    case CopyKernel::NEON:   return "NEON";
+    }
+    return "unknown";
+}
+
+} // namespace pers
@@ -0,0 +1,283 @@
+#include "pers/utils/Metrics.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace pers {
+
+namespace detail {
+
+// One thread's counter values; written by its thread, summed by readers
+struct ThreadCounterSlots {
+    std::atomic<int64_t> values[Metrics::MAX_COUNTERS + 1] = {};  // Last slot is the overflow
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance() {
+        // Leaked so metrics updated during static destruction stay valid
+        static MetricsRegistry* registry = new MetricsRegistry();
+        return *registry;
+    }
+
+    MetricCounter& counter(const std::string& name, const std::string& help, MetricType type);
+    MetricHistogram& histogram(const std::string& name, const std::vector<double>& bounds, const std::string& help);
+
+    ThreadCounterSlots* createSlots() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _slots.push_back(std::make_unique<ThreadCounterSlots>());
+        return _slots.back().get();
+    }
+
+    int64_t sum(uint32_t slot) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return sumLocked(slot);
+    }
+
+    std::vector<MetricSample> collect();
+
+private:
+    int64_t sumLocked(uint32_t slot) const {
+        int64_t total = 0;
+        for (const auto& slots : _slots) {
+            total += slots->values[slot].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<MetricCounter>> _counters;
+    std::vector<std::unique_ptr<MetricHistogram>> _histograms;
+    std::map<std::string, MetricCounter*> _countersByName;
+    std::map<std::string, MetricHistogram*> _histogramsByName;
+    std::unique_ptr<MetricCounter> _overflow;
+    // Kept after their thread exits so its totals stay in the sums
+    std::vector<std::unique_ptr<ThreadCounterSlots>> _slots;
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::MetricsRegistry;
+using detail::ThreadCounterSlots;
+
+ThreadCounterSlots& threadSlots() {
+    thread_local ThreadCounterSlots* slots = MetricsRegistry::instance().createSlots();
+    return *slots;
+}
+
+// Prometheus sample values; integers print exactly, +Inf as the spec spells it
+std::string formatValue(double value) {
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    char text[64];
+    std::snprintf(text, sizeof(text), "%.15g", value);
+    return text;
+}
+
+void writeHelp(std::ostringstream& out, const std::string& name, const std::string& help, const char* type) {
+    if (!help.empty()) {
+        out << "# HELP " << name << ' ';
+        for (char c : help) {
+            if (c == '\\') {
+                out << "\\\\";
+            } else if (c == '\n') {
+                out << "\\n";
+            } else {
+                out << c;
+            }
+        }
+        out << '\n';
+    }
+    out << "# TYPE " << name << ' ' << type << '\n';
+}
+
+} // namespace
+
+namespace detail {
+
+MetricCounter& MetricsRegistry::counter(const std::string& name, const std::string& help, MetricType type) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _countersByName.find(name);
+    if (it != _countersByName.end()) {
+        if (it->second->getType() != type) {
+            LOG_WARNING_FMT("Metrics", "Metric '{}' already registered with another type", name);
+        }
+        return *it->second;
+    }
+
+    if (_counters.size() >= Metrics::MAX_COUNTERS) {
+        LOG_WARNING_FMT("Metrics", "Counter limit reached, '{}' shares the overflow slot", name);
+        if (!_overflow) {
+            _overflow.reset(new MetricCounter(Metrics::MAX_COUNTERS, "pers_metrics_overflow",
+                                              "Updates to counters past Metrics::MAX_COUNTERS", MetricType::Gauge));
+        }
+        return *_overflow;
+    }
+
+    _counters.emplace_back(new MetricCounter(static_cast<uint32_t>(_counters.size()), name, help, type));
+    _countersByName[name] = _counters.back().get();
+    return *_counters.back();
+}
+
+MetricHistogram& MetricsRegistry::histogram(const std::string& name, const std::vector<double>& bounds,
+                                            const std::string& help) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _histogramsByName.find(name);
+    if (it != _histogramsByName.end()) {
+        return *it->second;
+    }
+
+    _histograms.emplace_back(new MetricHistogram(name, help, bounds));
+    _histogramsByName[name] = _histograms.back().get();
+    return *_histograms.back();
+}
+
+std::vector<MetricSample> MetricsRegistry::collect() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<MetricSample> samples;
+    samples.reserve(_countersByName.size() + _histogramsByName.size() + 1);
+
+    for (const auto& [name, counter] : _countersByName) {
+        MetricSample sample;
+        sample.name = name;
+        sample.help = counter->getHelp();
+        sample.type = counter->getType();
+        sample.value = sumLocked(counter->_slot);
+        samples.push_back(std::move(sample));
+    }
+    if (_overflow) {
+        MetricSample sample;
+        sample.name = _overflow->getName();
+        sample.help = _overflow->getHelp();
+        sample.type = MetricType::Gauge;
+        sample.value = sumLocked(Metrics::MAX_COUNTERS);
+        samples.push_back(std::move(sample));
+    }
+    for (const auto& [name, histogram] : _histogramsByName) {
+        MetricSample sample;
+        sample.name = name;
+        sample.help = histogram->getHelp();
+        sample.type = MetricType::Histogram;
+        sample.bounds = histogram->getBounds();
+        sample.bucketCounts = histogram->getBucketCounts();
+        sample.count = histogram->getCount();
+        sample.sum = histogram->getSum();
+        samples.push_back(std::move(sample));
+    }
+
+    std::sort(samples.begin(), samples.end(),
+              [](const MetricSample& a, const MetricSample& b) { return a.name < b.name; });
+    return samples;
+}
+
+} // namespace detail
+
+void MetricCounter::add(int64_t delta) {
+    // Only this thread writes its slot, so no read-modify-write is needed
+    std::atomic<int64_t>& value = threadSlots().values[_slot];
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+int64_t MetricCounter::value() const {
+    return MetricsRegistry::instance().sum(_slot);
+}
+
+MetricHistogram::MetricHistogram(std::string name, std::string help, std::vector<double> bounds)
+    : _name(std::move(name))
+    , _help(std::move(help))
+    , _bounds(std::move(bounds)) {
+    std::sort(_bounds.begin(), _bounds.end());
+    _bounds.erase(std::unique(_bounds.begin(), _bounds.end()), _bounds.end());
+    _buckets.reset(new std::atomic<uint64_t>[_bounds.size() + 1]);
+    for (size_t i = 0; i <= _bounds.size(); ++i) {
+        _buckets[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void MetricHistogram::observe(double value) {
+    const size_t bucket = std::lower_bound(_bounds.begin(), _bounds.end(), value) - _bounds.begin();
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(value, std::memory_order_relaxed);
+}
+
+std::vector<uint64_t> MetricHistogram::getBucketCounts() const {
+    std::vector<uint64_t> counts(_bounds.size() + 1);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        counts[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+MetricCounter& Metrics::counter(const std::string& name, const std::string& help) {
+    return MetricsRegistry::instance().counter(name, help, MetricType::Counter);
+}
+
+MetricCounter& Metrics::gauge(const std::string& name, const std::string& help) {
+    return MetricsRegistry::instance().counter(name, help, MetricType::Gauge);
+}
+
+MetricHistogram& Metrics::histogram(const std::string& name, const std::vector<double>& bounds,
+                                    const std::string& help) {
+    return MetricsRegistry::instance().histogram(name, bounds, help);
+}
+
+std::vector<MetricSample> Metrics::collect() {
+    return MetricsRegistry::instance().collect();
+}
+
+std::string Metrics::formatPrometheus() {
+    std::ostringstream out;
+    for (const MetricSample& sample : collect()) {
+        switch (sample.type) {
+            case MetricType::Counter:
+            case MetricType::Gauge:
+                writeHelp(out, sample.name, sample.help, sample.type == MetricType::Counter ? "counter" : "gauge");
+                out << sample.name << ' ' << sample.value << '\n';
+                break;
+            case MetricType::Histogram: {
+                writeHelp(out, sample.name, sample.help, "histogram");
+                // Prometheus buckets are cumulative
+                uint64_t cumulative = 0;
+                for (size_t i = 0; i < sample.bucketCounts.size(); ++i) {
+                    cumulative += sample.bucketCounts[i];
+                    double bound = i < sample.bounds.size() ? sample.bounds[i] : HUGE_VAL;
+                    out << sample.name << "_bucket{le=\"" << formatValue(bound) << "\"} " << cumulative << '\n';
+                }
+                out << sample.name << "_sum " << formatValue(sample.sum) << '\n';
+                out << sample.name << "_count " << sample.count << '\n';
+                break;
+            }
+        }
+    }
+    return out.str();
+}
+
+bool Metrics::writePrometheus(const std::string& filename) {
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::out | std::ios::trunc);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << formatPrometheus();
+        if (!out.good()) {
+            return false;
+        }
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows
+    std::remove(filename.c_str());
+#endif
+    return std::rename(temporary.c_str(), filename.c_str()) == 0;
+}
+
+} // namespace pers
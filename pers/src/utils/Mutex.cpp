@@ -1,8 +1,199 @@
 #include "pers/utils/Mutex.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <tuple>
 
 namespace pers {
 
 // Static member definition for debug mode Mutex specialization
 std::atomic<int> Mutex<true>::_globalLockId{0};
 
-} // namespace pers
\ No newline at end of file
+namespace detail {
+
+// One mutex name and call site in one thread's table. Counters are written by
+// the owning thread (hold time by whichever thread unlocks) and read by collect().
+struct MutexSite {
+    std::atomic<bool> used{false};
+    const char* name = nullptr;
+    const char* file = nullptr;
+    int line = 0;
+    std::atomic<uint64_t> lockCount{0};
+    std::atomic<uint64_t> contentionCount{0};
+    std::atomic<uint64_t> waitNanoseconds{0};
+    std::atomic<uint64_t> maxWaitNanoseconds{0};
+    std::atomic<uint64_t> holdNanoseconds{0};
+};
+
+} // namespace detail
+
+namespace {
+
+using detail::MutexSite;
+
+struct ThreadSiteTable {
+    static constexpr size_t CAPACITY = 512;  // Power of two
+    MutexSite sites[CAPACITY];
+    MutexSite overflow;   // Sites past CAPACITY share one row
+};
+
+class ProfilerRegistry {
+public:
+    static ProfilerRegistry& instance() {
+        // Leaked so threads exiting after static destruction can still record
+        static ProfilerRegistry* registry = new ProfilerRegistry();
+        return *registry;
+    }
+
+    ThreadSiteTable* createTable() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tables.push_back(std::make_unique<ThreadSiteTable>());
+        return _tables.back().get();
+    }
+
+    template<typename Function>
+    void forEachSite(Function&& function) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& table : _tables) {
+            for (MutexSite& site : table->sites) {
+                if (site.used.load(std::memory_order_acquire)) {
+                    function(site);
+                }
+            }
+            if (table->overflow.used.load(std::memory_order_acquire)) {
+                function(table->overflow);
+            }
+        }
+    }
+
+private:
+    // Plain std::mutex: a pers::Mutex here would profile itself
+    std::mutex _mutex;
+    // Kept after their thread exits so its totals stay in the report
+    std::vector<std::unique_ptr<ThreadSiteTable>> _tables;
+};
+
+ThreadSiteTable& threadTable() {
+    thread_local ThreadSiteTable* table = ProfilerRegistry::instance().createTable();
+    return *table;
+}
+
+void atomicMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+detail::MutexSite* MutexProfiler::site(const char* name, const LogSource& loc) {
+    ThreadSiteTable& table = threadTable();
+
+    // Names and files are string literals, so pointers identify them within a module
+    size_t hash = std::hash<const void*>{}(name) ^ (std::hash<const void*>{}(loc.file) * 31) ^
+                  (static_cast<size_t>(loc.line) * 2654435761u);
+    for (size_t probe = 0; probe < ThreadSiteTable::CAPACITY; ++probe) {
+        MutexSite& site = table.sites[(hash + probe) & (ThreadSiteTable::CAPACITY - 1)];
+        if (!site.used.load(std::memory_order_relaxed)) {
+            site.name = name;
+            site.file = loc.file;
+            site.line = loc.line;
+            site.used.store(true, std::memory_order_release);
+            return &site;
+        }
+        if (site.name == name && site.file == loc.file && site.line == loc.line) {
+            return &site;
+        }
+    }
+
+    if (!table.overflow.used.load(std::memory_order_relaxed)) {
+        table.overflow.name = "(other)";
+        table.overflow.used.store(true, std::memory_order_release);
+    }
+    return &table.overflow;
+}
+
+uint64_t MutexProfiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void MutexProfiler::recordLock(detail::MutexSite* site, uint64_t waitNanoseconds, bool contended) {
+    site->lockCount.fetch_add(1, std::memory_order_relaxed);
+    if (contended) {
+        site->contentionCount.fetch_add(1, std::memory_order_relaxed);
+        site->waitNanoseconds.fetch_add(waitNanoseconds, std::memory_order_relaxed);
+        atomicMax(site->maxWaitNanoseconds, waitNanoseconds);
+    }
+}
+
+void MutexProfiler::recordHold(detail::MutexSite* site, uint64_t holdNanoseconds) {
+    if (site) {
+        site->holdNanoseconds.fetch_add(holdNanoseconds, std::memory_order_relaxed);
+    }
+}
+
+std::vector<MutexSiteStats> MutexProfiler::collect() {
+    // Merge by content: the same literal may have several addresses across modules and threads
+    std::map<std::tuple<std::string, std::string, int>, MutexSiteStats> merged;
+    ProfilerRegistry::instance().forEachSite([&merged](const MutexSite& site) {
+        std::string name = site.name ? site.name : "unnamed";
+        std::string file = site.file ? detail::getFileName(site.file) : "";
+        MutexSiteStats& stats = merged[std::make_tuple(name, file, site.line)];
+        stats.name = name;
+        stats.file = file;
+        stats.line = site.line;
+        stats.lockCount += site.lockCount.load(std::memory_order_relaxed);
+        stats.contentionCount += site.contentionCount.load(std::memory_order_relaxed);
+        stats.waitNanoseconds += site.waitNanoseconds.load(std::memory_order_relaxed);
+        stats.maxWaitNanoseconds = std::max(stats.maxWaitNanoseconds,
+                                            site.maxWaitNanoseconds.load(std::memory_order_relaxed));
+        stats.holdNanoseconds += site.holdNanoseconds.load(std::memory_order_relaxed);
+    });
+
+    std::vector<MutexSiteStats> result;
+    result.reserve(merged.size());
+    for (auto& [key, stats] : merged) {
+        if (stats.lockCount > 0) {
+            result.push_back(std::move(stats));
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const MutexSiteStats& a, const MutexSiteStats& b) {
+        return a.waitNanoseconds != b.waitNanoseconds ? a.waitNanoseconds > b.waitNanoseconds
+                                                      : a.holdNanoseconds > b.holdNanoseconds;
+    });
+    return result;
+}
+
+std::string MutexProfiler::formatReport(size_t maxRows) {
+    std::vector<MutexSiteStats> stats = collect();
+    std::ostringstream out;
+    out << std::left << std::setw(20) << "Mutex" << std::setw(36) << "Site"
+        << std::right << std::setw(12) << "Locks" << std::setw(12) << "Contended"
+        << std::setw(12) << "Wait ms" << std::setw(12) << "Max wait us" << std::setw(12) << "Hold ms" << '\n';
+    out << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < stats.size() && i < maxRows; ++i) {
+        const MutexSiteStats& row = stats[i];
+        std::string site = row.file.empty() ? "(no source)" : row.file + ":" + std::to_string(row.line);
+        out << std::left << std::setw(20) << row.name << std::setw(36) << site
+            << std::right << std::setw(12) << row.lockCount << std::setw(12) << row.contentionCount
+            << std::setw(12) << row.waitNanoseconds / 1e6 << std::setw(12) << row.maxWaitNanoseconds / 1e3
+            << std::setw(12) << row.holdNanoseconds / 1e6 << '\n';
+    }
+    return out.str();
+}
+
+void MutexProfiler::reset() {
+    ProfilerRegistry::instance().forEachSite([](MutexSite& site) {
+        site.lockCount.store(0, std::memory_order_relaxed);
+        site.contentionCount.store(0, std::memory_order_relaxed);
+        site.waitNanoseconds.store(0, std::memory_order_relaxed);
+        site.maxWaitNanoseconds.store(0, std::memory_order_relaxed);
+        site.holdNanoseconds.store(0, std::memory_order_relaxed);
+    });
+}
+
+} // namespace pers
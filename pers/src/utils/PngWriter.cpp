@@ -0,0 +1,272 @@
+#include "pers/utils/PngWriter.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace pers {
+
+namespace {
+
+constexpr uint8_t PNG_SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+constexpr uint32_t WINDOW_SIZE = 32768;
+constexpr uint32_t MIN_MATCH = 3;
+constexpr uint32_t MAX_MATCH = 258;
+constexpr uint32_t HASH_BITS = 15;
+
+constexpr uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                      35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+constexpr uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+constexpr uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                        8193, 12289, 16385, 24577};
+constexpr uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+constexpr std::array<uint32_t, 256> makeCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+uint32_t reverseBits(uint32_t code, uint32_t length) {
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < length; ++i) {
+        result = (result << 1) | ((code >> i) & 1);
+    }
+    return result;
+}
+
+// Deflate emits Huffman codes most significant bit first into an LSB-first stream
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+    void put(uint32_t value, uint32_t count) {
+        _bits |= static_cast<uint64_t>(value) << _count;
+        _count += count;
+        while (_count >= 8) {
+            _out.push_back(static_cast<uint8_t>(_bits));
+            _bits >>= 8;
+            _count -= 8;
+        }
+    }
+
+    void putCode(uint32_t code, uint32_t length) { put(reverseBits(code, length), length); }
+
+    void flush() {
+        if (_count > 0) {
+            _out.push_back(static_cast<uint8_t>(_bits));
+        }
+        _bits = 0;
+        _count = 0;
+    }
+
+private:
+    std::vector<uint8_t>& _out;
+    uint64_t _bits = 0;
+    uint32_t _count = 0;
+};
+
+// Fixed Huffman table of RFC 1951 3.2.6
+void putLiteralLength(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144) {
+        writer.putCode(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.putCode(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        writer.putCode(symbol - 256, 7);
+    } else {
+        writer.putCode(0xC0 + symbol - 280, 8);
+    }
+}
+
+void putMatch(BitWriter& writer, uint32_t length, uint32_t distance) {
+    const uint32_t lengthCode = static_cast<uint32_t>(
+        std::upper_bound(std::begin(LENGTH_BASE), std::end(LENGTH_BASE), length) - std::begin(LENGTH_BASE) - 1);
+    putLiteralLength(writer, 257 + lengthCode);
+    writer.put(length - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode]);
+
+    const uint32_t distanceCode = static_cast<uint32_t>(
+        std::upper_bound(std::begin(DISTANCE_BASE), std::end(DISTANCE_BASE), distance) - std::begin(DISTANCE_BASE) - 1);
+    writer.putCode(distanceCode, 5);
+    writer.put(distance - DISTANCE_BASE[distanceCode], DISTANCE_EXTRA[distanceCode]);
+}
+
+uint32_t hash3(const uint8_t* p) {
+    const uint32_t v = p[0] | (p[1] << 8) | (p[2] << 16);
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+// zlib stream with a single fixed-Huffman block
+void deflate(const std::vector<uint8_t>& input, std::vector<uint8_t>& out) {
+    out.push_back(0x78);  // 32K window, deflate
+    out.push_back(0x01);  // Fastest, (0x78 << 8 | 0x01) % 31 == 0
+
+    BitWriter writer(out);
+    writer.put(1, 1);  // BFINAL
+    writer.put(1, 2);  // BTYPE fixed Huffman
+
+    const size_t size = input.size();
+    const uint8_t* data = input.data();
+    std::vector<int64_t> head(size_t(1) << HASH_BITS, -1);
+
+    size_t pos = 0;
+    while (pos < size) {
+        uint32_t bestLength = 0;
+        size_t bestDistance = 0;
+        if (pos + MIN_MATCH <= size) {
+            const uint32_t h = hash3(data + pos);
+            const int64_t candidate = head[h];
+            head[h] = static_cast<int64_t>(pos);
+            if (candidate >= 0 && pos - static_cast<size_t>(candidate) <= WINDOW_SIZE) {
+                const size_t limit = std::min<size_t>(MAX_MATCH, size - pos);
+                const uint8_t* a = data + candidate;
+                const uint8_t* b = data + pos;
+                uint32_t length = 0;
+                while (length < limit && a[length] == b[length]) {
+                    ++length;
+                }
+                if (length >= MIN_MATCH) {
+                    bestLength = length;
+                    bestDistance = pos - static_cast<size_t>(candidate);
+                }
+            }
+        }
+
+        if (bestLength == 0) {
+            putLiteralLength(writer, data[pos]);
+            ++pos;
+            continue;
+        }
+
+        putMatch(writer, bestLength, static_cast<uint32_t>(bestDistance));
+        // Index the match's tail as well so later data can refer into it
+        const size_t end = pos + bestLength;
+        for (++pos; pos < end && pos + MIN_MATCH <= size; ++pos) {
+            head[hash3(data + pos)] = static_cast<int64_t>(pos);
+        }
+        pos = end;
+    }
+
+    putLiteralLength(writer, 256);  // End of block
+    writer.flush();
+
+    const uint32_t adler = adler32(input.data(), input.size());
+    out.push_back(static_cast<uint8_t>(adler >> 24));
+    out.push_back(static_cast<uint8_t>(adler >> 16));
+    out.push_back(static_cast<uint8_t>(adler >> 8));
+    out.push_back(static_cast<uint8_t>(adler));
+}
+
+void putU32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+    putU32(out, static_cast<uint32_t>(size));
+    const size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    putU32(out, crc32(out.data() + typeOffset, size + 4));
+}
+
+} // anonymous namespace
+
+uint32_t crc32(const void* data, size_t size, uint32_t crc) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t adler32(const void* data, size_t size, uint32_t adler) {
+    constexpr uint32_t MOD = 65521;
+    constexpr size_t BLOCK = 5552;  // Largest run before the sums can overflow
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint32_t a = adler & 0xFFFF;
+    uint32_t b = adler >> 16;
+    while (size > 0) {
+        const size_t count = std::min(size, BLOCK);
+        for (size_t i = 0; i < count; ++i) {
+            a += bytes[i];
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+        bytes += count;
+        size -= count;
+    }
+    return (b << 16) | a;
+}
+
+bool encodePng(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t channels,
+               size_t rowPitch, std::vector<uint8_t>& out) {
+    static constexpr uint8_t COLOR_TYPES[5] = {0, 0, 4, 2, 6};
+    if (!pixels || width == 0 || height == 0 || channels == 0 || channels > 4) {
+        return false;
+    }
+
+    const size_t rowBytes = static_cast<size_t>(width) * channels;
+    if (rowPitch == 0) {
+        rowPitch = rowBytes;
+    }
+    if (rowPitch < rowBytes) {
+        return false;
+    }
+
+    // Sub filter: each byte minus the same channel of the pixel to its left
+    std::vector<uint8_t> filtered((rowBytes + 1) * height);
+    for (uint32_t y = 0; y < height; ++y) {
+        const uint8_t* src = pixels + y * rowPitch;
+        uint8_t* dst = filtered.data() + y * (rowBytes + 1);
+        dst[0] = 1;
+        std::memcpy(dst + 1, src, channels);
+        for (size_t x = channels; x < rowBytes; ++x) {
+            dst[1 + x] = static_cast<uint8_t>(src[x] - src[x - channels]);
+        }
+    }
+
+    std::vector<uint8_t> compressed;
+    compressed.reserve(filtered.size() / 2);
+    deflate(filtered, compressed);
+
+    uint8_t header[13];
+    header[0] = static_cast<uint8_t>(width >> 24);
+    header[1] = static_cast<uint8_t>(width >> 16);
+    header[2] = static_cast<uint8_t>(width >> 8);
+    header[3] = static_cast<uint8_t>(width);
+    header[4] = static_cast<uint8_t>(height >> 24);
+    header[5] = static_cast<uint8_t>(height >> 16);
+    header[6] = static_cast<uint8_t>(height >> 8);
+    header[7] = static_cast<uint8_t>(height);
+    header[8] = 8;  // Bit depth
+    header[9] = COLOR_TYPES[channels];
+    header[10] = 0;  // Deflate
+    header[11] = 0;  // Adaptive filtering
+    header[12] = 0;  // No interlace
+
+    out.clear();
+    out.reserve(compressed.size() + 64);
+    out.insert(out.end(), std::begin(PNG_SIGNATURE), std::end(PNG_SIGNATURE));
+    putChunk(out, "IHDR", header, sizeof(header));
+    putChunk(out, "IDAT", compressed.data(), compressed.size());
+    putChunk(out, "IEND", nullptr, 0);
+    return true;
+}
+
+} // namespace pers
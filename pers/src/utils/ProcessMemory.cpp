@@ -0,0 +1,53 @@
+#include "pers/utils/ProcessMemory.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <cstdio>
+#include <cstring>
+#endif
+
+namespace pers {
+
+ProcessMemoryInfo getProcessMemoryInfo() {
+    ProcessMemoryInfo info;
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters = {};
+    // The K32 entry point lives in kernel32, so no psapi import library is needed
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        info.residentBytes = counters.WorkingSetSize;
+        info.peakResidentBytes = counters.PeakWorkingSetSize;
+    }
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t taskInfo = {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                  reinterpret_cast<task_info_t>(&taskInfo), &count) == KERN_SUCCESS) {
+        info.residentBytes = taskInfo.resident_size;
+        info.peakResidentBytes = taskInfo.resident_size_max;
+    }
+#elif defined(__linux__)
+    // VmRSS and VmHWM are in kB
+    if (FILE* status = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), status)) {
+            unsigned long long kilobytes = 0;
+            if (std::sscanf(line, "VmRSS: %llu kB", &kilobytes) == 1) {
+                info.residentBytes = kilobytes * 1024;
+            } else if (std::sscanf(line, "VmHWM: %llu kB", &kilobytes) == 1) {
+                info.peakResidentBytes = kilobytes * 1024;
+            }
+        }
+        std::fclose(status);
+    }
+#endif
+    return info;
+}
+
+} // namespace pers
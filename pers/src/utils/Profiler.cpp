@@ -0,0 +1,258 @@
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pers {
+
+std::atomic<bool> Profiler::s_enabled{false};
+
+namespace {
+
+struct ZoneEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    uint32_t depth;
+};
+
+struct EventChunk {
+    ZoneEvent events[Profiler::EVENTS_PER_CHUNK];
+};
+
+// Written by its thread; chunks and readStart change only under the registry mutex
+struct ThreadBuffer {
+    uint32_t threadIndex = 0;
+    std::string threadName;
+    std::deque<std::unique_ptr<EventChunk>> chunks;
+    uint64_t firstEventIndex = 0;          // Index of chunks.front()->events[0]
+    uint64_t readStart = 0;                // Events below this were cleared
+    std::atomic<uint64_t> published{0};    // Events visible to readers
+
+    // Owning thread only
+    EventChunk* current = nullptr;
+    size_t currentCount = Profiler::EVENTS_PER_CHUNK;
+};
+
+class ProfilerRegistry {
+public:
+    static ProfilerRegistry& instance() {
+        // Leaked so threads exiting during static destruction can still record
+        static ProfilerRegistry* registry = new ProfilerRegistry();
+        return *registry;
+    }
+
+    ThreadBuffer* createBuffer() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _buffers.push_back(std::make_unique<ThreadBuffer>());
+        ThreadBuffer* buffer = _buffers.back().get();
+        buffer->threadIndex = static_cast<uint32_t>(_buffers.size());
+        buffer->threadName = "Thread " + std::to_string(buffer->threadIndex);
+        return buffer;
+    }
+
+    // Owning thread, when its current chunk is full
+    void nextChunk(ThreadBuffer& buffer) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        uint64_t end = buffer.published.load(std::memory_order_relaxed);
+
+        // Recycle the oldest chunk once it is cleared or past the per-thread limit
+        std::unique_ptr<EventChunk> chunk;
+        if (!buffer.chunks.empty()) {
+            uint64_t frontEnd = buffer.firstEventIndex + Profiler::EVENTS_PER_CHUNK;
+            bool overLimit = end - buffer.firstEventIndex >= Profiler::MAX_EVENTS_PER_THREAD;
+            if (frontEnd <= buffer.readStart || overLimit) {
+                chunk = std::move(buffer.chunks.front());
+                buffer.chunks.pop_front();
+                buffer.firstEventIndex = frontEnd;
+                buffer.readStart = std::max(buffer.readStart, frontEnd);
+            }
+        }
+        if (!chunk) {
+            chunk = std::make_unique<EventChunk>();
+        }
+        if (buffer.chunks.empty()) {
+            buffer.firstEventIndex = end;
+        }
+        buffer.current = chunk.get();
+        buffer.currentCount = 0;
+        buffer.chunks.push_back(std::move(chunk));
+    }
+
+    void setThreadName(ThreadBuffer& buffer, const std::string& name) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        buffer.threadName = name;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& buffer : _buffers) {
+            buffer->readStart = buffer->published.load(std::memory_order_acquire);
+        }
+    }
+
+    template<typename ThreadFunction, typename EventFunction>
+    void forEach(ThreadFunction&& onThread, EventFunction&& onEvent) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto& buffer : _buffers) {
+            uint64_t end = buffer->published.load(std::memory_order_acquire);
+            uint64_t begin = std::max(buffer->readStart, buffer->firstEventIndex);
+            onThread(*buffer);
+            for (uint64_t i = begin; i < end; ++i) {
+                uint64_t offset = i - buffer->firstEventIndex;
+                const EventChunk& chunk = *buffer->chunks[offset / Profiler::EVENTS_PER_CHUNK];
+                onEvent(*buffer, chunk.events[offset % Profiler::EVENTS_PER_CHUNK]);
+            }
+        }
+    }
+
+    // Events from each thread's cursor position on; advances the cursors
+    template<typename EventFunction>
+    void forEachSince(std::vector<uint64_t>& cursors, EventFunction&& onEvent) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        cursors.resize(_buffers.size(), 0);
+        for (size_t index = 0; index < _buffers.size(); ++index) {
+            const ThreadBuffer& buffer = *_buffers[index];
+            uint64_t end = buffer.published.load(std::memory_order_acquire);
+            uint64_t begin = std::max({cursors[index], buffer.readStart, buffer.firstEventIndex});
+            for (uint64_t i = begin; i < end; ++i) {
+                uint64_t offset = i - buffer.firstEventIndex;
+                const EventChunk& chunk = *buffer.chunks[offset / Profiler::EVENTS_PER_CHUNK];
+                onEvent(chunk.events[offset % Profiler::EVENTS_PER_CHUNK]);
+            }
+            cursors[index] = std::max(begin, end);
+        }
+    }
+
+private:
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+};
+
+ThreadBuffer& threadBuffer() {
+    thread_local ThreadBuffer* buffer = ProfilerRegistry::instance().createBuffer();
+    return *buffer;
+}
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+void writeJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*c));
+                    out << escaped;
+                } else {
+                    out << *c;
+                }
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+void Profiler::setEnabled(bool enabled) {
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ProfilerRegistry::instance().setThreadName(threadBuffer(), name);
+}
+
+void Profiler::clear() {
+    ProfilerRegistry::instance().clear();
+}
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - g_epoch).count());
+}
+
+void Profiler::recordZone(const char* name, uint64_t startNanoseconds, uint64_t endNanoseconds, uint32_t depth) {
+    ThreadBuffer& buffer = threadBuffer();
+    if (buffer.currentCount == EVENTS_PER_CHUNK) {
+        ProfilerRegistry::instance().nextChunk(buffer);
+    }
+    buffer.current->events[buffer.currentCount++] = ZoneEvent{name, startNanoseconds, endNanoseconds, depth};
+    buffer.published.store(buffer.published.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool Profiler::writeChromeTrace(const std::string& filename) {
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        return false;
+    }
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    char number[64];
+    ProfilerRegistry::instance().forEach(
+        [&](const ThreadBuffer& buffer) {
+            out << (first ? "\n" : ",\n");
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.threadIndex
+                << ",\"args\":{\"name\":";
+            writeJsonString(out, buffer.threadName.c_str());
+            out << "}}";
+        },
+        [&](const ThreadBuffer& buffer, const ZoneEvent& event) {
+            out << ",\n{\"name\":";
+            writeJsonString(out, event.name);
+            // Chrome trace timestamps are in microseconds
+            std::snprintf(number, sizeof(number), "%.3f", event.start / 1000.0);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadIndex << ",\"ts\":" << number;
+            std::snprintf(number, sizeof(number), "%.3f", (event.end - event.start) / 1000.0);
+            out << ",\"dur\":" << number << ",\"args\":{\"depth\":" << event.depth << "}}";
+        });
+    out << "\n]}\n";
+    return out.good();
+}
+
+std::vector<ProfileZoneTotal> Profiler::collectZoneTotals(ProfileCursor& cursor) {
+    // Keyed by the literal's address; equal names from different literals merge below
+    std::unordered_map<const char*, ProfileZoneTotal> byPointer;
+    ProfilerRegistry::instance().forEachSince(cursor._next, [&](const ZoneEvent& event) {
+        ProfileZoneTotal& total = byPointer[event.name];
+        total.name = event.name;
+        ++total.count;
+        total.totalNanoseconds += event.end - event.start;
+    });
+
+    std::vector<ProfileZoneTotal> totals;
+    totals.reserve(byPointer.size());
+    for (const auto& [name, total] : byPointer) {
+        totals.push_back(total);
+    }
+    std::sort(totals.begin(), totals.end(), [](const ProfileZoneTotal& a, const ProfileZoneTotal& b) {
+        return std::strcmp(a.name, b.name) < 0;
+    });
+
+    size_t merged = 0;
+    for (size_t i = 0; i < totals.size(); ++i) {
+        if (merged > 0 && std::strcmp(totals[merged - 1].name, totals[i].name) == 0) {
+            totals[merged - 1].count += totals[i].count;
+            totals[merged - 1].totalNanoseconds += totals[i].totalNanoseconds;
+        } else {
+            totals[merged++] = totals[i];
+        }
+    }
+    totals.resize(merged);
+    return totals;
+}
+
+} // namespace pers
@@ -0,0 +1,256 @@
+#include "pers/utils/TcpSocket.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace pers {
+
+namespace {
+
+#if defined(_WIN32)
+using NativeSocket = SOCKET;
+
+bool initializeSockets() {
+    static const bool initialized = [] {
+        WSADATA data = {};
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }();
+    return initialized;
+}
+
+void closeSocket(NativeSocket socket) {
+    closesocket(socket);
+}
+
+constexpr int SHUTDOWN_BOTH = SD_BOTH;
+#else
+using NativeSocket = int;
+
+bool initializeSockets() {
+    return true;
+}
+
+void closeSocket(NativeSocket socket) {
+    ::close(socket);
+}
+
+constexpr int SHUTDOWN_BOTH = SHUT_RDWR;
+#endif
+
+NativeSocket native(intptr_t handle) {
+    return static_cast<NativeSocket>(handle);
+}
+
+void disableNagle(NativeSocket socket) {
+    int enable = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enable), sizeof(enable));
+}
+
+#if defined(MSG_NOSIGNAL)
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;  // A closed peer fails the call instead of raising SIGPIPE
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+} // anonymous namespace
+
+TcpSocket::~TcpSocket() {
+    close();
+}
+
+TcpSocket::TcpSocket(TcpSocket&& other) noexcept {
+    *this = std::move(other);
+}
+
+TcpSocket& TcpSocket::operator=(TcpSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        _handle = std::exchange(other._handle, INVALID_HANDLE);
+    }
+    return *this;
+}
+
+TcpSocket TcpSocket::connect(const std::string& host, uint16_t port) {
+    if (!initializeSockets()) {
+        return {};
+    }
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    addrinfo* addresses = nullptr;
+    const std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        Logger::Instance().LogFormat(LogLevel::Error, "TcpSocket", PERS_SOURCE_LOC,
+            "Cannot resolve %s", host.c_str());
+        return {};
+    }
+
+    TcpSocket result;
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        NativeSocket socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket == native(INVALID_HANDLE)) {
+            continue;
+        }
+        if (::connect(socket, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) {
+            disableNagle(socket);
+            result = TcpSocket(static_cast<intptr_t>(socket));
+            break;
+        }
+        closeSocket(socket);
+    }
+    freeaddrinfo(addresses);
+
+    if (!result.isValid()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "TcpSocket", PERS_SOURCE_LOC,
+            "Cannot connect to %s:%u", host.c_str(), port);
+    }
+    return result;
+}
+
+TcpSocket TcpSocket::listen(uint16_t port, const std::string& address, int backlog) {
+    if (!initializeSockets()) {
+        return {};
+    }
+
+    NativeSocket socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (socket == native(INVALID_HANDLE)) {
+        return {};
+    }
+    int reuse = 1;
+    setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (!address.empty() && inet_pton(AF_INET, address.c_str(), &local.sin_addr) != 1) {
+        closeSocket(socket);
+        Logger::Instance().LogFormat(LogLevel::Error, "TcpSocket", PERS_SOURCE_LOC,
+            "Invalid listen address %s", address.c_str());
+        return {};
+    }
+    if (bind(socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0 ||
+        ::listen(socket, backlog) != 0) {
+        closeSocket(socket);
+        Logger::Instance().LogFormat(LogLevel::Error, "TcpSocket", PERS_SOURCE_LOC,
+            "Cannot listen on port %u", port);
+        return {};
+    }
+    return TcpSocket(static_cast<intptr_t>(socket));
+}
+
+TcpSocket TcpSocket::accept() const {
+    if (!isValid()) {
+        return {};
+    }
+    NativeSocket socket = ::accept(native(_handle), nullptr, nullptr);
+    if (socket == native(INVALID_HANDLE)) {
+        return {};
+    }
+    disableNagle(socket);
+    return TcpSocket(static_cast<intptr_t>(socket));
+}
+
+bool TcpSocket::sendAll(const void* data, size_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        // Windows takes int lengths
+        const int chunk = static_cast<int>(std::min<size_t>(size, 1u << 30));
+        const auto sent = ::send(native(_handle), bytes, chunk, SEND_FLAGS);
+        if (sent <= 0) {
+#if !defined(_WIN32)
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            return false;
+        }
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool TcpSocket::receiveAll(void* data, size_t size) {
+    auto* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        const int chunk = static_cast<int>(std::min<size_t>(size, 1u << 30));
+        const auto received = ::recv(native(_handle), bytes, chunk, 0);
+        if (received <= 0) {
+#if !defined(_WIN32)
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+#endif
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+void TcpSocket::shutdown() {
+    if (isValid()) {
+        ::shutdown(native(_handle), SHUTDOWN_BOTH);
+    }
+}
+
+void TcpSocket::close() {
+    if (isValid()) {
+        closeSocket(native(_handle));
+        _handle = INVALID_HANDLE;
+    }
+}
+
+uint16_t TcpSocket::getLocalPort() const {
+    sockaddr_storage local = {};
+    socklen_t length = sizeof(local);
+    if (!isValid() || getsockname(native(_handle), reinterpret_cast<sockaddr*>(&local), &length) != 0) {
+        return 0;
+    }
+    if (local.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6*>(&local)->sin6_port);
+    }
+    return ntohs(reinterpret_cast<const sockaddr_in*>(&local)->sin_port);
+}
+
+std::string TcpSocket::getPeerName() const {
+    sockaddr_storage peer = {};
+    socklen_t length = sizeof(peer);
+    if (!isValid() || getpeername(native(_handle), reinterpret_cast<sockaddr*>(&peer), &length) != 0) {
+        return {};
+    }
+    char host[INET6_ADDRSTRLEN] = {};
+    uint16_t port = 0;
+    if (peer.ss_family == AF_INET6) {
+        const auto* address = reinterpret_cast<const sockaddr_in6*>(&peer);
+        inet_ntop(AF_INET6, &address->sin6_addr, host, sizeof(host));
+        port = ntohs(address->sin6_port);
+    } else {
+        const auto* address = reinterpret_cast<const sockaddr_in*>(&peer);
+        inet_ntop(AF_INET, &address->sin_addr, host, sizeof(host));
+        port = ntohs(address->sin_port);
+    }
+    return std::string(host) + ":" + std::to_string(port);
+}
+
+} // namespace pers
@@ -0,0 +1,213 @@
+#include "pers/utils/TelemetryStream.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/ThreadAffinity.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace pers {
+
+namespace {
+
+void appendJsonString(std::string& out, const char* text) {
+    out += '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*c));
+                    out += escaped;
+                } else {
+                    out += *c;
+                }
+        }
+    }
+    out += '"';
+}
+
+// JSON has no infinities or NaN
+void appendJsonNumber(std::string& out, double value) {
+    char number[64];
+    std::snprintf(number, sizeof(number), "%.9g", std::isfinite(value) ? value : 0.0);
+    out += number;
+}
+
+} // anonymous namespace
+
+TelemetryStream::TelemetryStream(const TelemetryStreamDesc& desc)
+    : _desc(desc) {
+    if (_desc.sampleIntervalMs == 0) {
+        _desc.sampleIntervalMs = 1;
+    }
+    if (_desc.samplesPerWrite == 0) {
+        _desc.samplesPerWrite = 1;
+    }
+}
+
+TelemetryStream::~TelemetryStream() {
+    stop();
+}
+
+bool TelemetryStream::start() {
+    if (isRunning()) {
+        LOG_ERROR("TelemetryStream", "Stream already running");
+        return false;
+    }
+
+    _file.open(_desc.path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!_file.is_open()) {
+        Logger::Instance().LogFormat(LogLevel::Error, "TelemetryStream", PERS_SOURCE_LOC,
+            "Failed to open telemetry file '%s'", _desc.path.c_str());
+        return false;
+    }
+
+    const auto startedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::string session = "{\"type\":\"session\",\"startedMs\":" + std::to_string(startedMs)
+        + ",\"intervalMs\":" + std::to_string(_desc.sampleIntervalMs) + "}\n";
+    _fileBytes = 0;
+    if (!writeBatch(session)) {
+        _file.close();
+        return false;
+    }
+
+    // Zones recorded before the stream started are not part of it
+    _zoneCursor = ProfileCursor();
+    Profiler::collectZoneTotals(_zoneCursor);
+    _lastSampleNanoseconds = Profiler::now();
+    _sampleCount.store(0, std::memory_order_relaxed);
+    _stopping = false;
+    _thread = std::thread(&TelemetryStream::threadLoop, this);
+
+    Logger::Instance().LogFormat(LogLevel::Info, "TelemetryStream", PERS_SOURCE_LOC,
+        "Streaming telemetry to '%s' every %u ms", _desc.path.c_str(), _desc.sampleIntervalMs);
+    return true;
+}
+
+void TelemetryStream::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _wake.notify_one();
+    _thread.join();
+    _file.close();
+}
+
+void TelemetryStream::threadLoop() {
+    Profiler::setThreadName("Telemetry");
+    ThreadAffinity::applyCurrentThread(ThreadRole::Logger, 1);
+
+    std::string batch;
+    uint32_t batched = 0;
+    const auto interval = std::chrono::milliseconds(_desc.sampleIntervalMs);
+    auto next = std::chrono::steady_clock::now() + interval;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_wake.wait_until(lock, next, [this] { return _stopping; })) {
+        lock.unlock();
+        appendSample(batch);
+        if (++batched >= _desc.samplesPerWrite) {
+            writeBatch(batch);
+            batch.clear();
+            batched = 0;
+        }
+        // Fixed cadence; a sample that overran skips ahead instead of bursting
+        next += interval;
+        const auto now = std::chrono::steady_clock::now();
+        if (next < now) {
+            next = now + interval;
+        }
+        lock.lock();
+    }
+    lock.unlock();
+
+    // Final sample so the tail of the session is not lost
+    appendSample(batch);
+    writeBatch(batch);
+}
+
+void TelemetryStream::appendSample(std::string& batch) {
+    const uint64_t now = Profiler::now();
+    const uint64_t sequence = _sampleCount.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    batch += "{\"type\":\"sample\",\"seq\":";
+    batch += std::to_string(sequence);
+    batch += ",\"t\":";
+    appendJsonNumber(batch, now * 1e-9);
+    batch += ",\"dt\":";
+    appendJsonNumber(batch, (now - _lastSampleNanoseconds) * 1e-9);
+    _lastSampleNanoseconds = now;
+
+    std::string histograms;
+    batch += ",\"metrics\":{";
+    bool firstMetric = true;
+    for (const MetricSample& sample : Metrics::collect()) {
+        if (sample.type == MetricType::Histogram) {
+            histograms += histograms.empty() ? "" : ",";
+            appendJsonString(histograms, sample.name.c_str());
+            histograms += ":{\"count\":" + std::to_string(sample.count) + ",\"sum\":";
+            appendJsonNumber(histograms, sample.sum);
+            histograms += '}';
+            continue;
+        }
+        batch += firstMetric ? "" : ",";
+        firstMetric = false;
+        appendJsonString(batch, sample.name.c_str());
+        batch += ':';
+        batch += std::to_string(sample.value);
+    }
+    batch += "},\"histograms\":{";
+    batch += histograms;
+    batch += "},\"zones\":[";
+
+    if (_desc.includeZones) {
+        bool firstZone = true;
+        for (const ProfileZoneTotal& zone : Profiler::collectZoneTotals(_zoneCursor)) {
+            batch += firstZone ? "{\"name\":" : ",{\"name\":";
+            firstZone = false;
+            appendJsonString(batch, zone.name);
+            batch += ",\"count\":" + std::to_string(zone.count) + ",\"ms\":";
+            appendJsonNumber(batch, zone.totalNanoseconds * 1e-6);
+            batch += '}';
+        }
+    }
+    batch += "]}\n";
+}
+
+bool TelemetryStream::writeBatch(const std::string& batch) {
+    if (batch.empty()) {
+        return true;
+    }
+
+    if (_fileBytes > 0 && _fileBytes + batch.size() > _desc.maxFileBytes) {
+        _file.close();
+        const std::string previous = _desc.path + ".1";
+        std::remove(previous.c_str());
+        std::rename(_desc.path.c_str(), previous.c_str());
+        _file.open(_desc.path, std::ios::out | std::ios::trunc | std::ios::binary);
+        _fileBytes = 0;
+    }
+
+    _file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    _file.flush();
+    if (!_file.good()) {
+        LOG_ERROR("TelemetryStream", "Failed to write telemetry batch");
+        _file.clear();
+        return false;
+    }
+    _fileBytes += batch.size();
+    return true;
+}
+
+} // namespace pers
@@ -0,0 +1,457 @@
+#include "pers/utils/ThreadAffinity.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <bit>
+#include <mutex>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#include <pthread/qos.h>
+#include <unistd.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <fstream>
+#include <string>
+#endif
+
+namespace pers {
+
+namespace {
+
+#if defined(_WIN32)
+using NativeThread = HANDLE;
+#else
+using NativeThread = pthread_t;
+#endif
+
+#if defined(__linux__)
+
+// "0-3,8,10-11" as written to sysfs cpu and node lists
+std::vector<uint32_t> parseCpuList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    size_t position = 0;
+    while (position < list.size()) {
+        size_t end = list.find(',', position);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string range = list.substr(position, end - position);
+        const size_t dash = range.find('-');
+        try {
+            const uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+            const uint32_t last = dash == std::string::npos ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+            for (uint32_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (...) {
+            // Blank or malformed entry, nothing to add
+        }
+        position = end + 1;
+    }
+    return cpus;
+}
+
+bool readLine(const std::string& path, std::string& line) {
+    std::ifstream file(path);
+    return static_cast<bool>(std::getline(file, line));
+}
+
+uint64_t readNumber(const std::string& path) {
+    std::string line;
+    if (!readLine(path, line)) {
+        return 0;
+    }
+    try {
+        return std::stoull(line);
+    } catch (...) {
+        return 0;
+    }
+}
+
+CpuTopology detectTopology() {
+    CpuTopology topology;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return topology;
+    }
+
+    std::unordered_map<uint32_t, uint32_t> nodeOf;
+    uint32_t nodeCount = 0;
+    std::string nodes;
+    if (readLine("/sys/devices/system/node/online", nodes)) {
+        for (uint32_t node : parseCpuList(nodes)) {
+            std::string list;
+            if (readLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", list)) {
+                for (uint32_t cpu : parseCpuList(list)) {
+                    nodeOf[cpu] = node;
+                }
+                nodeCount = std::max(nodeCount, node + 1);
+            }
+        }
+    }
+
+    // Intel hybrids list their core types, ARM big.LITTLE reports a capacity
+    std::string coreList;
+    std::vector<uint32_t> performanceCpus;
+    if (readLine("/sys/devices/cpu_core/cpus", coreList)) {
+        performanceCpus = parseCpuList(coreList);
+    }
+
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &allowed)) {
+            continue;
+        }
+        CpuCore core;
+        core.cpu = cpu;
+        auto node = nodeOf.find(cpu);
+        core.numaNode = node != nodeOf.end() ? node->second : 0;
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        if (!performanceCpus.empty()) {
+            core.efficiencyClass = std::find(performanceCpus.begin(), performanceCpus.end(), cpu) != performanceCpus.end() ? 1 : 0;
+        } else if (uint64_t capacity = readNumber(base + "/cpu_capacity")) {
+            core.efficiencyClass = static_cast<uint32_t>(capacity);
+        } else {
+            core.efficiencyClass = static_cast<uint32_t>(readNumber(base + "/cpufreq/cpuinfo_max_freq") / 1000);
+        }
+        topology.cpus.push_back(core);
+    }
+    topology.numaNodeCount = std::max(nodeCount, 1u);
+    return topology;
+}
+
+#elif defined(_WIN32)
+
+CpuTopology detectTopology() {
+    CpuTopology topology;
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return topology;
+    }
+    std::vector<uint8_t> buffer(length);
+    auto* first = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationAll, first, &length)) {
+        return topology;
+    }
+
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+    USHORT processGroup = 0;
+    USHORT groupCount = 1;
+    GetProcessGroupAffinity(GetCurrentProcess(), &groupCount, &processGroup);
+    const bool singleGroup = groupCount <= 1;
+
+    std::unordered_map<uint32_t, uint32_t> nodeOf;  // group << 8 | cpu
+    uint32_t nodeCount = 0;
+    for (DWORD offset = 0; offset < length;) {
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        if (info->Relationship == RelationNumaNode) {
+            const GROUP_AFFINITY& mask = info->NumaNode.GroupMask;
+            for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+                if (mask.Mask & (KAFFINITY(1) << bit)) {
+                    nodeOf[(uint32_t(mask.Group) << 8) | bit] = info->NumaNode.NodeNumber;
+                }
+            }
+            nodeCount = std::max<uint32_t>(nodeCount, info->NumaNode.NodeNumber + 1);
+        }
+        offset += info->Size;
+    }
+
+    for (DWORD offset = 0; offset < length;) {
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+        if (info->Relationship == RelationProcessorCore) {
+            const GROUP_AFFINITY& mask = info->Processor.GroupMask[0];
+            for (uint32_t bit = 0; bit < sizeof(KAFFINITY) * 8; ++bit) {
+                if (!(mask.Mask & (KAFFINITY(1) << bit))) {
+                    continue;
+                }
+                // The process mask only describes its own group
+                if (singleGroup && (mask.Group != processGroup || !(processMask & (DWORD_PTR(1) << bit)))) {
+                    continue;
+                }
+                CpuCore core;
+                core.cpu = bit;
+                core.group = mask.Group;
+                core.efficiencyClass = info->Processor.EfficiencyClass;
+                auto node = nodeOf.find((uint32_t(mask.Group) << 8) | bit);
+                core.numaNode = node != nodeOf.end() ? node->second : 0;
+                topology.cpus.push_back(core);
+            }
+        }
+        offset += info->Size;
+    }
+    topology.numaNodeCount = std::max(nodeCount, 1u);
+    return topology;
+}
+
+#else
+
+CpuTopology detectTopology() {
+    CpuTopology topology;
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    for (long cpu = 0; cpu < count; ++cpu) {
+        CpuCore core;
+        core.cpu = static_cast<uint32_t>(cpu);
+        topology.cpus.push_back(core);
+    }
+    return topology;
+}
+
+#endif
+
+CpuTopology buildTopology() {
+    CpuTopology topology = detectTopology();
+    uint32_t fastest = 0;
+    uint32_t slowest = ~0u;
+    for (const CpuCore& core : topology.cpus) {
+        fastest = std::max(fastest, core.efficiencyClass);
+        slowest = std::min(slowest, core.efficiencyClass);
+    }
+    for (CpuCore& core : topology.cpus) {
+        core.performance = core.efficiencyClass == fastest;
+    }
+    topology.hybrid = !topology.cpus.empty() && fastest != slowest;
+    return topology;
+}
+
+bool setAffinity(NativeThread thread, const std::vector<CpuCore>& cpus) {
+#if defined(_WIN32)
+    // One group per thread; take the group holding most of the selection
+    std::unordered_map<uint16_t, KAFFINITY> masks;
+    for (const CpuCore& core : cpus) {
+        masks[core.group] |= KAFFINITY(1) << core.cpu;
+    }
+    auto best = std::max_element(masks.begin(), masks.end(), [](const auto& a, const auto& b) {
+        return std::popcount(a.second) < std::popcount(b.second);
+    });
+    if (best == masks.end()) {
+        return false;
+    }
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = best->first;
+    affinity.Mask = best->second;
+    return SetThreadGroupAffinity(thread, &affinity, nullptr) != 0;
+#elif defined(__APPLE__)
+    static_cast<void>(thread);
+    static_cast<void>(cpus);
+    return true;
+#else
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const CpuCore& core : cpus) {
+        CPU_SET(core.cpu, &set);
+    }
+    return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+#endif
+}
+
+#if defined(__APPLE__)
+// Apple silicon has no affinity, QoS steers threads between core types
+bool setQualityOfService(CoreClass cores) {
+    qos_class_t qos = QOS_CLASS_DEFAULT;
+    if (cores == CoreClass::Performance) {
+        qos = QOS_CLASS_USER_INTERACTIVE;
+    } else if (cores == CoreClass::Efficiency) {
+        qos = QOS_CLASS_BACKGROUND;
+    }
+    return pthread_set_qos_class_self_np(qos, 0) == 0;
+}
+#endif
+
+struct TrackedThread {
+    ThreadRole role = ThreadRole::Main;
+    uint32_t index = 0;
+    NativeThread handle{};
+};
+
+struct AffinityState {
+    std::mutex mutex;
+    ThreadAffinityConfig config;
+    std::unordered_map<uint64_t, TrackedThread> threads;
+    uint64_t nextId = 1;
+};
+
+// Leaked: threads may exit and unregister after static destruction began
+AffinityState& state() {
+    static AffinityState* instance = new AffinityState();
+    return *instance;
+}
+
+bool applyPolicy(const TrackedThread& thread, const ThreadAffinityPolicy& policy, bool self) {
+#if defined(__APPLE__)
+    return self ? setQualityOfService(policy.cores) : true;
+#else
+    static_cast<void>(self);
+    std::vector<CpuCore> cpus = ThreadAffinity::selectCpus(policy, thread.index);
+    if (cpus.empty()) {
+        // Default policy: every processor the process may use
+        cpus = getCpuTopology().cpus;
+    }
+    return setAffinity(thread.handle, cpus);
+#endif
+}
+
+// Forgets the calling thread when it exits
+struct Registration {
+    uint64_t id = 0;
+
+    ~Registration() {
+        if (id == 0) {
+            return;
+        }
+        AffinityState& affinity = state();
+        std::lock_guard<std::mutex> lock(affinity.mutex);
+        auto it = affinity.threads.find(id);
+        if (it != affinity.threads.end()) {
+#if defined(_WIN32)
+            CloseHandle(it->second.handle);
+#endif
+            affinity.threads.erase(it);
+        }
+    }
+};
+
+thread_local Registration t_registration;
+
+} // anonymous namespace
+
+const CpuTopology& getCpuTopology() {
+    static const CpuTopology topology = buildTopology();
+    return topology;
+}
+
+ThreadAffinityConfig ThreadAffinityConfig::latencyFocused() {
+    ThreadAffinityConfig config;
+    config[ThreadRole::Main].cores = CoreClass::Performance;
+    config[ThreadRole::Render].cores = CoreClass::Performance;
+    config[ThreadRole::Worker].spreadNumaNodes = true;
+    config[ThreadRole::IO].cores = CoreClass::Efficiency;
+    config[ThreadRole::Logger].cores = CoreClass::Efficiency;
+    return config;
+}
+
+void ThreadAffinity::configure(const ThreadAffinityConfig& config) {
+    AffinityState& affinity = state();
+    uint32_t failures = 0;
+    {
+        std::lock_guard<std::mutex> lock(affinity.mutex);
+        affinity.config = config;
+        for (const auto& [id, thread] : affinity.threads) {
+            const bool self = id == t_registration.id;
+            if (!applyPolicy(thread, config[thread.role], self)) {
+                ++failures;
+            }
+        }
+    }
+
+    const CpuTopology& topology = getCpuTopology();
+    Logger::Instance().LogFormat(LogLevel::Debug, "ThreadAffinity", PERS_SOURCE_LOC,
+        "Configured for %zu processors, %u NUMA nodes%s", topology.cpus.size(), topology.numaNodeCount,
+        topology.hybrid ? ", hybrid" : "");
+    if (failures > 0) {
+        Logger::Instance().LogFormat(LogLevel::Warning, "ThreadAffinity", PERS_SOURCE_LOC,
+            "Affinity of %u running threads could not be changed", failures);
+    }
+}
+
+ThreadAffinityConfig ThreadAffinity::getConfig() {
+    AffinityState& affinity = state();
+    std::lock_guard<std::mutex> lock(affinity.mutex);
+    return affinity.config;
+}
+
+bool ThreadAffinity::applyCurrentThread(ThreadRole role, uint32_t index) {
+    AffinityState& affinity = state();
+    std::lock_guard<std::mutex> lock(affinity.mutex);
+
+    if (t_registration.id == 0) {
+        TrackedThread thread;
+#if defined(_WIN32)
+        // GetCurrentThread() is a pseudo handle, valid on this thread only
+        DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &thread.handle,
+                        THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, 0);
+#else
+        thread.handle = pthread_self();
+#endif
+        t_registration.id = affinity.nextId++;
+        affinity.threads.emplace(t_registration.id, thread);
+    }
+
+    TrackedThread& thread = affinity.threads[t_registration.id];
+    thread.role = role;
+    thread.index = index;
+    const ThreadAffinityPolicy& policy = affinity.config[role];
+    // Nothing to undo for a thread that never had a policy
+    return policy.isDefault() || applyPolicy(thread, policy, true);
+}
+
+std::vector<CpuCore> ThreadAffinity::selectCpus(const ThreadAffinityPolicy& policy, uint32_t index) {
+    if (policy.isDefault()) {
+        return {};
+    }
+
+    const CpuTopology& topology = getCpuTopology();
+    const bool filterClass = topology.hybrid && policy.cores != CoreClass::Any;
+    auto classMatches = [&](const CpuCore& core) {
+        return !filterClass || core.performance == (policy.cores == CoreClass::Performance);
+    };
+
+    int32_t node = -1;
+    if (topology.numaNodeCount > 1) {
+        if (policy.spreadNumaNodes) {
+            // Only nodes that have processors of the requested class take threads
+            std::vector<uint32_t> nodes;
+            for (const CpuCore& core : topology.cpus) {
+                if (classMatches(core) && std::find(nodes.begin(), nodes.end(), core.numaNode) == nodes.end()) {
+                    nodes.push_back(core.numaNode);
+                }
+            }
+            std::sort(nodes.begin(), nodes.end());
+            if (!nodes.empty()) {
+                node = static_cast<int32_t>(nodes[index % nodes.size()]);
+            }
+        } else {
+            node = policy.numaNode;
+        }
+    }
+
+    std::vector<CpuCore> cpus;
+    for (const CpuCore& core : topology.cpus) {
+        if (classMatches(core) && (node < 0 || core.numaNode == static_cast<uint32_t>(node))) {
+            cpus.push_back(core);
+        }
+    }
+    if (cpus.empty() && node >= 0) {
+        for (const CpuCore& core : topology.cpus) {
+            if (classMatches(core)) {
+                cpus.push_back(core);
+            }
+        }
+    }
+    if (cpus.empty()) {
+        cpus = topology.cpus;
+    }
+    return cpus;
+}
+
+const char* ThreadAffinity::getRoleName(ThreadRole role) {
+    switch (role) {
+        case ThreadRole::Main: return "Main";
+        case ThreadRole::Render: return "Render";
+        case ThreadRole::Worker: return "Worker";
+        case ThreadRole::IO: return "IO";
+        case ThreadRole::Logger: return "Logger";
+        default: return "Unknown";
+    }
+}
+
+} // namespace pers
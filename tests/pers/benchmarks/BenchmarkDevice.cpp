@@ -0,0 +1,71 @@
+#include "BenchmarkDevice.h"
+#include "pers/graphics/backends/null/NullInstanceFactory.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/utils/Logger.h"
+
+namespace pers::benchmarks {
+
+BenchmarkDevice& BenchmarkDevice::instance(BenchmarkBackend backend) {
+    if (backend == BenchmarkBackend::Null) {
+        static BenchmarkDevice nullDevice(BenchmarkBackend::Null);
+        return nullDevice;
+    }
+    static BenchmarkDevice device(BenchmarkBackend::WebGPU);
+    return device;
+}
+
+BenchmarkDevice::BenchmarkDevice(BenchmarkBackend backend) {
+    std::shared_ptr<IGraphicsInstanceFactory> factory;
+    if (backend == BenchmarkBackend::Null) {
+        factory = std::make_shared<NullInstanceFactory>();
+    } else {
+        factory = std::make_shared<WebGPUInstanceFactory>();
+    }
+
+    InstanceDesc instanceDesc;
+    instanceDesc.applicationName = "Pers Benchmarks";
+    instanceDesc.enableValidation = false;
+    _instance = factory->createInstance(instanceDesc);
+    if (!_instance) {
+        LOG_ERROR("BenchmarkDevice", "Failed to create instance");
+        return;
+    }
+
+    PhysicalDeviceOptions options;
+    options.powerPreference = PowerPreference::HighPerformance;
+    _physicalDevice = _instance->requestPhysicalDevice(options);
+    if (!_physicalDevice) {
+        LOG_ERROR("BenchmarkDevice", "No suitable adapter");
+        return;
+    }
+
+    LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = false;
+    _logicalDevice = _physicalDevice->createLogicalDevice(deviceDesc);
+    if (!_logicalDevice) {
+        LOG_ERROR("BenchmarkDevice", "Failed to create logical device");
+        return;
+    }
+
+    _queue = _logicalDevice->getQueue();
+}
+
+bool BenchmarkDevice::submitAndWait() {
+    auto encoder = _logicalDevice->createCommandEncoder();
+    if (!encoder) {
+        return false;
+    }
+    return submitAndWait(encoder->finish());
+}
+
+bool BenchmarkDevice::submitAndWait(const std::shared_ptr<ICommandBuffer>& commandBuffer) {
+    if (!commandBuffer) {
+        return false;
+    }
+    SubmissionFence fence = _queue->submit(commandBuffer);
+    return fence && fence.wait();
+}
+
+} // namespace pers::benchmarks
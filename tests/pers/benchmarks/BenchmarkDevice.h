@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include <future>
+#include <memory>
+
+namespace pers::benchmarks {
+
+/**
+ * @brief Backend a benchmark device runs on
+ *
+ * Null validates and records like WebGPU but issues no GPU work, so the same
+ * benchmark on both splits engine overhead from driver and GPU cost.
+ */
+enum class BenchmarkBackend {
+    WebGPU,
+    Null
+};
+
+/**
+ * @brief Headless device shared by every benchmark in the process, one per backend
+ *
+ * Created on first use without a surface, so benchmarks run on machines
+ * without a display. Validation is off to keep it out of the measurements.
+ */
+class BenchmarkDevice {
+public:
+    static BenchmarkDevice& instance(BenchmarkBackend backend = BenchmarkBackend::WebGPU);
+
+    bool isValid() const { return _logicalDevice != nullptr; }
+    const std::shared_ptr<ILogicalDevice>& getDevice() const { return _logicalDevice; }
+    const std::shared_ptr<IQueue>& getQueue() const { return _queue; }
+
+    /**
+     * @brief Submit an empty command buffer and wait for it
+     * Pending queue writes are flushed with the submit, so on return every
+     * upload recorded before the call has reached the GPU.
+     */
+    bool submitAndWait();
+
+    /**
+     * @brief Submit a command buffer and wait for it
+     */
+    bool submitAndWait(const std::shared_ptr<ICommandBuffer>& commandBuffer);
+
+    /**
+     * @brief Process instance events until the future is ready
+     * @return false on timeout
+     */
+    template<typename T>
+    bool waitFor(std::future<T>& future);
+
+private:
+    explicit BenchmarkDevice(BenchmarkBackend backend);
+
+    std::shared_ptr<IInstance> _instance;
+    std::shared_ptr<IPhysicalDevice> _physicalDevice;
+    std::shared_ptr<ILogicalDevice> _logicalDevice;
+    std::shared_ptr<IQueue> _queue;
+};
+
+template<typename T>
+bool BenchmarkDevice::waitFor(std::future<T>& future) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        _instance->processEvents();
+    }
+    return true;
+}
+
+} // namespace pers::benchmarks
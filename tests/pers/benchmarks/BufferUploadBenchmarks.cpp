@@ -0,0 +1,401 @@
+#include "BenchmarkDevice.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/buffers/DeferredStagingBuffer.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include "pers/graphics/buffers/DynamicBuffer.h"
+#include "pers/graphics/buffers/INativeBuffer.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/ShadowedDeviceBuffer.h"
+#include "pers/utils/MemoryCopy.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pers::benchmarks {
+
+namespace {
+
+constexpr int64_t MIN_SIZE = 64;
+constexpr int64_t MAX_SIZE = 256ll * 1024 * 1024;
+
+// Three frame slots of this size are allocated, keep them within typical VRAM
+constexpr int64_t MAX_DYNAMIC_SIZE = 64ll * 1024 * 1024;
+
+// Source bytes shared by all benchmarks, grown on demand
+const uint8_t* sourceData(uint64_t size) {
+    static std::vector<uint8_t> data;
+    if (data.size() < size) {
+        size_t oldSize = data.size();
+        data.resize(size);
+        for (size_t i = oldSize; i < data.size(); ++i) {
+            data[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+    }
+    return data.data();
+}
+
+BenchmarkDevice* acquireDevice(benchmark::State& state,
+                               BenchmarkBackend backend = BenchmarkBackend::WebGPU) {
+    BenchmarkDevice& device = BenchmarkDevice::instance(backend);
+    if (!device.isValid()) {
+        state.SkipWithError("No device available");
+        return nullptr;
+    }
+    return &device;
+}
+
+std::shared_ptr<DeviceBuffer> createDeviceBuffer(BenchmarkDevice& bench, uint64_t size, DeviceBufferUsage usage) {
+    auto buffer = std::make_shared<DeviceBuffer>();
+    if (!buffer->create(size, usage, bench.getDevice(), "BenchmarkDeviceBuffer")) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+void setCounters(benchmark::State& state, uint64_t size) {
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+    state.counters["size"] = static_cast<double>(size);
+}
+
+// Write, copy and wait for the GPU; the staging buffer is created per iteration
+template<bool Pooled>
+void BM_ImmediateStagingUpload(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    const uint8_t* data = sourceData(size);
+    auto deviceBuffer = createDeviceBuffer(*bench, size, DeviceBufferUsage::Storage);
+    if (!deviceBuffer) {
+        state.SkipWithError("Failed to create device buffer");
+        return;
+    }
+
+    BufferCopyDesc copyDesc;
+    copyDesc.size = size;
+
+    for (auto _ : state) {
+        auto staging = std::make_shared<ImmediateStagingBuffer>();
+        bool created = Pooled ? staging->create(size, bench->getDevice()->getStagingBufferPool(), "BenchmarkStaging")
+                              : staging->create(size, bench->getDevice(), "BenchmarkStaging");
+        if (!created) {
+            state.SkipWithError("Failed to create staging buffer");
+            return;
+        }
+
+        staging->writeBytes(data, size, 0);
+        staging->finalize();
+
+        auto encoder = bench->getDevice()->createCommandEncoder();
+        if (!encoder || !encoder->uploadToDeviceBuffer(staging, deviceBuffer, copyDesc) ||
+            !bench->submitAndWait(encoder->finish())) {
+            state.SkipWithError("Upload failed");
+            return;
+        }
+
+        // Returns a pooled buffer for the next iteration
+        staging->destroy();
+    }
+
+    state.SetLabel(getCopyKernelName(getCopyKernel()));
+    setCounters(state, size);
+}
+
+// CPU side only: repeated writes into one mapped staging buffer with each copy kernel
+void BM_StagingWriteKernel(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const CopyKernel kernel = static_cast<CopyKernel>(state.range(0));
+    const CopyKernel previous = getCopyKernel();
+    if (!setCopyKernel(kernel)) {
+        state.SkipWithError("Copy kernel not supported on this CPU");
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(1));
+    const uint8_t* data = sourceData(size);
+    auto staging = std::make_shared<ImmediateStagingBuffer>();
+    if (!staging->create(size, bench->getDevice(), "BenchmarkKernelStaging")) {
+        setCopyKernel(previous);
+        state.SkipWithError("Failed to create staging buffer");
+        return;
+    }
+
+    for (auto _ : state) {
+        staging->writeBytes(data, size, 0);
+    }
+
+    setCopyKernel(previous);
+    state.SetLabel(getCopyKernelName(kernel));
+    setCounters(state, size);
+}
+
+// Creation with mappedAtCreation; the first use of the buffer is not measured.
+// The null backend drops the data, leaving the engine's cost per creation.
+template<BenchmarkBackend Backend>
+void BM_CreateInitializableDeviceBuffer(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state, Backend);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    const uint8_t* data = sourceData(size);
+    const auto& factory = bench->getDevice()->getResourceFactory();
+
+    BufferDesc desc;
+    desc.size = size;
+    desc.usage = BufferUsage::Storage | BufferUsage::CopyDst;
+    desc.debugName = "BenchmarkInitializable";
+
+    for (auto _ : state) {
+        auto buffer = factory->createInitializableDeviceBuffer(desc, data, static_cast<size_t>(size));
+        if (!buffer) {
+            state.SkipWithError("Failed to create initializable buffer");
+            return;
+        }
+        benchmark::DoNotOptimize(buffer.get());
+    }
+
+    setCounters(state, size);
+}
+
+// A scene load's worth of small initialized buffers, one call each or one batch
+template<bool Batched>
+void BM_CreateInitializableDeviceBuffers(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    constexpr uint64_t bufferSize = 4096;
+    const size_t count = static_cast<size_t>(state.range(0));
+    const uint8_t* data = sourceData(bufferSize);
+    const auto& factory = bench->getDevice()->getResourceFactory();
+
+    std::vector<BufferInitDesc> buffers(count);
+    for (auto& buffer : buffers) {
+        buffer.desc.size = bufferSize;
+        buffer.desc.usage = BufferUsage::Vertex | BufferUsage::CopyDst;
+        buffer.desc.debugName = "BenchmarkBatch";
+        buffer.initialData = data;
+        buffer.dataSize = static_cast<size_t>(bufferSize);
+    }
+
+    for (auto _ : state) {
+        std::vector<std::shared_ptr<INativeBuffer>> created;
+        if constexpr (Batched) {
+            created = factory->createInitializableDeviceBuffers(buffers);
+        } else {
+            created.reserve(count);
+            for (const auto& buffer : buffers) {
+                created.push_back(factory->createInitializableDeviceBuffer(buffer.desc, buffer.initialData, buffer.dataSize));
+            }
+        }
+        if (std::find(created.begin(), created.end(), nullptr) != created.end()) {
+            state.SkipWithError("Failed to create initializable buffers");
+            return;
+        }
+        if (!bench->submitAndWait()) {
+            state.SkipWithError("Failed to wait for the uploads");
+            return;
+        }
+        benchmark::DoNotOptimize(created.data());
+    }
+
+    setCounters(state, bufferSize * count);
+}
+
+// Queue write followed by a submit, timed until the GPU has consumed it
+void BM_QueueWriteBuffer(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    const uint8_t* data = sourceData(size);
+    auto deviceBuffer = createDeviceBuffer(*bench, size, DeviceBufferUsage::Storage);
+    if (!deviceBuffer) {
+        state.SkipWithError("Failed to create device buffer");
+        return;
+    }
+
+    std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(data), static_cast<size_t>(size));
+    for (auto _ : state) {
+        if (!bench->getQueue()->writeBuffer(deviceBuffer, 0, bytes) || !bench->submitAndWait()) {
+            state.SkipWithError("Queue write failed");
+            return;
+        }
+    }
+
+    setCounters(state, size);
+}
+
+// Copy to a read-back buffer, map it and touch the data
+void BM_DeferredStagingReadback(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    auto deviceBuffer = createDeviceBuffer(*bench, size, DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc);
+    auto staging = std::make_shared<DeferredStagingBuffer>();
+    if (!deviceBuffer || !staging->create(size, MapMode::Read, bench->getDevice(), "BenchmarkReadback")) {
+        state.SkipWithError("Failed to create buffers");
+        return;
+    }
+
+    std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(sourceData(size)), static_cast<size_t>(size));
+    if (!bench->getQueue()->writeBuffer(deviceBuffer, 0, bytes) || !bench->submitAndWait()) {
+        state.SkipWithError("Failed to fill device buffer");
+        return;
+    }
+
+    BufferCopyDesc copyDesc;
+    copyDesc.size = size;
+
+    for (auto _ : state) {
+        auto encoder = bench->getDevice()->createCommandEncoder();
+        if (!encoder || !encoder->downloadFromDeviceBuffer(deviceBuffer, staging, copyDesc) ||
+            !bench->submitAndWait(encoder->finish())) {
+            state.SkipWithError("Download failed");
+            return;
+        }
+
+        auto mapFuture = staging->mapAsync(MapMode::Read, {0, size});
+        if (!bench->waitFor(mapFuture)) {
+            state.SkipWithError("Timed out mapping read-back buffer");
+            return;
+        }
+
+        // Unmapped when the mapping goes out of scope
+        MappedData mapped = mapFuture.get();
+        if (!mapped.data()) {
+            state.SkipWithError("Failed to map read-back buffer");
+            return;
+        }
+        const uint8_t* readData = static_cast<const uint8_t*>(mapped.data());
+        benchmark::DoNotOptimize(readData[0] + readData[size - 1]);
+    }
+
+    setCounters(state, size);
+}
+
+// One frame: write, flush, submit and advance the ring. The ring throttles
+// the loop once the CPU is a full ring ahead, as it would in an application.
+void BM_DynamicBufferUpdate(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    const uint8_t* data = sourceData(size);
+    DynamicBuffer dynamic;
+    if (!dynamic.create(size, BufferUsage::Storage, bench->getDevice(), DynamicBuffer::DEFAULT_FRAME_COUNT,
+                        "BenchmarkDynamic")) {
+        state.SkipWithError("Failed to create dynamic buffer");
+        return;
+    }
+
+    for (auto _ : state) {
+        dynamic.write(data, size);
+        if (!dynamic.flush()) {
+            state.SkipWithError("Flush failed");
+            return;
+        }
+
+        auto encoder = bench->getDevice()->createCommandEncoder();
+        if (!encoder || !bench->getQueue()->submit(encoder->finish())) {
+            state.SkipWithError("Submit failed");
+            return;
+        }
+        dynamic.nextFrame();
+    }
+
+    // Drain the ring so the next benchmark starts from an idle queue
+    bench->submitAndWait();
+    state.counters["stalls"] = static_cast<double>(dynamic.getStallCount());
+    setCounters(state, size);
+}
+
+// Scattered 64-byte updates to 1 in 64 granules, uploaded as dirty spans
+void BM_ShadowedSparseUpload(benchmark::State& state) {
+    BenchmarkDevice* bench = acquireDevice(state);
+    if (!bench) {
+        return;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(state.range(0));
+    const uint64_t granularity = ShadowedDeviceBuffer::DEFAULT_GRANULARITY;
+    const uint64_t stride = granularity * 64;
+    const uint8_t* data = sourceData(64);
+
+    ShadowedDeviceBuffer shadowed;
+    if (!shadowed.create(size, DeviceBufferUsage::Storage, bench->getDevice(), granularity,
+                         ShadowedDeviceBuffer::DEFAULT_MERGE_GAP, "BenchmarkShadowed")) {
+        state.SkipWithError("Failed to create shadowed buffer");
+        return;
+    }
+
+    for (auto _ : state) {
+        for (uint64_t offset = 0; offset + 64 <= size; offset += stride) {
+            shadowed.write(offset, data, 64);
+        }
+        if (!shadowed.upload() || !bench->submitAndWait()) {
+            state.SkipWithError("Sparse upload failed");
+            return;
+        }
+    }
+
+    ShadowedDeviceBuffer::Stats stats = shadowed.getStats();
+    state.counters["uploaded_bytes_per_iter"] =
+        static_cast<double>(stats.uploadedBytes) / std::max<uint64_t>(stats.uploadCount, 1);
+    state.counters["spans_per_iter"] =
+        static_cast<double>(stats.uploadedSpans) / std::max<uint64_t>(stats.uploadCount, 1);
+    setCounters(state, size);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ImmediateStagingUpload, false)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ImmediateStagingUpload, true)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_StagingWriteKernel)
+    ->ArgsProduct({{static_cast<int64_t>(CopyKernel::Memcpy), static_cast<int64_t>(CopyKernel::SSE2),
+                    static_cast<int64_t>(CopyKernel::AVX2), static_cast<int64_t>(CopyKernel::AVX512),
+                    static_cast<int64_t>(CopyKernel::NEON)},
+                   {static_cast<int64_t>(STREAMING_COPY_THRESHOLD), 16ll * 1024 * 1024, MAX_SIZE}})
+    ->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CreateInitializableDeviceBuffer, BenchmarkBackend::WebGPU)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CreateInitializableDeviceBuffer, BenchmarkBackend::Null)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CreateInitializableDeviceBuffers, false)
+    ->RangeMultiplier(8)->Range(8, 4096)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CreateInitializableDeviceBuffers, true)
+    ->RangeMultiplier(8)->Range(8, 4096)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QueueWriteBuffer)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DeferredStagingReadback)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_DynamicBufferUpdate)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_DYNAMIC_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ShadowedSparseUpload)
+    ->RangeMultiplier(16)->Range(MIN_SIZE, MAX_SIZE)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace pers::benchmarks
@@ -0,0 +1,349 @@
+#include "BenchmarkDevice.h"
+#include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IRenderBundle.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/ParallelCommandRecorder.h"
+#include "pers/graphics/RenderPassTypes.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace pers::benchmarks {
+
+namespace {
+
+constexpr uint32_t TARGET_SIZE = 256;
+constexpr TextureFormat TARGET_FORMAT = TextureFormat::RGBA8Unorm;
+constexpr uint32_t PIPELINE_COUNT = 4;
+constexpr uint32_t VERTEX_BUFFER_COUNT = 2;
+
+const char* VERTEX_SHADER = R"(
+@vertex
+fn main(@location(0) position: vec2<f32>) -> @builtin(position) vec4<f32> {
+    return vec4<f32>(position, 0.0, 1.0);
+}
+)";
+
+const char* FRAGMENT_SHADER = R"(
+@fragment
+fn main() -> @location(0) vec4<f32> {
+    return vec4<f32>(1.0, 1.0, 1.0, 1.0);
+}
+)";
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Offscreen target plus a few pipelines and vertex buffers that differ only
+ * in state, so draws are cheap on the GPU and encoding dominates
+ */
+struct DrawScene {
+    std::shared_ptr<OffscreenFramebuffer> framebuffer;
+    std::array<std::shared_ptr<IRenderPipeline>, PIPELINE_COUNT> pipelines;
+    std::array<std::shared_ptr<IBuffer>, VERTEX_BUFFER_COUNT> vertexBuffers;
+    std::shared_ptr<IBuffer> indexBuffer;
+    bool valid = false;
+
+    explicit DrawScene(BenchmarkDevice& bench) {
+        const auto& factory = bench.getDevice()->getResourceFactory();
+
+        OffscreenFramebufferConfig targetConfig;
+        targetConfig.width = TARGET_SIZE;
+        targetConfig.height = TARGET_SIZE;
+        targetConfig.colorFormats = {TARGET_FORMAT};
+        framebuffer = std::make_shared<OffscreenFramebuffer>(factory, targetConfig);
+
+        ShaderModuleDesc vertexDesc;
+        vertexDesc.code = VERTEX_SHADER;
+        vertexDesc.stage = ShaderStage::Vertex;
+        vertexDesc.debugName = "BenchmarkDrawVertex";
+        ShaderModuleDesc fragmentDesc;
+        fragmentDesc.code = FRAGMENT_SHADER;
+        fragmentDesc.stage = ShaderStage::Fragment;
+        fragmentDesc.debugName = "BenchmarkDrawFragment";
+        auto vertexShader = factory->createShaderModule(vertexDesc);
+        auto fragmentShader = factory->createShaderModule(fragmentDesc);
+        if (!framebuffer->getColorAttachment(0) || !vertexShader || !fragmentShader) {
+            return;
+        }
+
+        VertexAttribute position;
+        position.format = VertexFormat::Float32x2;
+        position.offset = 0;
+        position.shaderLocation = 0;
+        VertexBufferLayout layout;
+        layout.arrayStride = 2 * sizeof(float);
+        layout.stepMode = VertexStepMode::Vertex;
+        layout.attributes.push_back(position);
+
+        // Distinct write masks give distinct pipeline objects with identical cost
+        const ColorWriteMask writeMasks[PIPELINE_COUNT] = {
+            ColorWriteMask::All, ColorWriteMask::Red, ColorWriteMask::Green, ColorWriteMask::Blue};
+        for (uint32_t i = 0; i < PIPELINE_COUNT; ++i) {
+            RenderPipelineDesc pipelineDesc;
+            pipelineDesc.vertex = vertexShader;
+            pipelineDesc.fragment = fragmentShader;
+            pipelineDesc.vertexLayouts.push_back(layout);
+            pipelineDesc.primitive.topology = PrimitiveTopology::TriangleList;
+            pipelineDesc.primitive.cullMode = CullMode::None;
+            ColorTargetState colorTarget;
+            colorTarget.format = TARGET_FORMAT;
+            colorTarget.writeMask = writeMasks[i];
+            pipelineDesc.colorTargets.push_back(colorTarget);
+            pipelineDesc.debugName = "BenchmarkDrawPipeline";
+            pipelines[i] = factory->createRenderPipeline(pipelineDesc);
+            if (!pipelines[i]) {
+                return;
+            }
+        }
+
+        // A triangle covering a handful of pixels
+        const float vertices[VERTEX_BUFFER_COUNT][6] = {
+            {-0.01f, -0.01f, 0.01f, -0.01f, 0.0f, 0.01f},
+            {-0.02f, -0.02f, 0.02f, -0.02f, 0.0f, 0.02f}};
+        for (uint32_t i = 0; i < VERTEX_BUFFER_COUNT; ++i) {
+            vertexBuffers[i] = std::make_shared<ImmediateDeviceBuffer>(
+                factory, sizeof(vertices[i]), BufferUsage::Vertex, vertices[i], sizeof(vertices[i]),
+                "BenchmarkDrawVertices");
+            if (!vertexBuffers[i]->isValid()) {
+                return;
+            }
+        }
+
+        const uint32_t indices[3] = {0, 1, 2};
+        indexBuffer = std::make_shared<ImmediateDeviceBuffer>(
+            factory, sizeof(indices), BufferUsage::Index, indices, sizeof(indices), "BenchmarkDrawIndices");
+        valid = indexBuffer->isValid();
+    }
+
+    RenderPassDesc passDesc(LoadOp loadOp) const {
+        RenderPassColorAttachment color;
+        color.view = framebuffer->getColorAttachment(0);
+        color.loadOp = loadOp;
+        color.storeOp = StoreOp::Store;
+        RenderPassDesc desc;
+        desc.colorAttachments.push_back(color);
+        desc.label = "BenchmarkDrawPass";
+        return desc;
+    }
+
+    // Works on IRenderPassEncoder and IRenderBundleEncoder alike
+    template<typename Encoder>
+    void recordDraws(Encoder& encoder, uint32_t count, bool redundant) const {
+        encoder.setIndexBuffer(indexBuffer, IndexFormat::Uint32);
+        for (uint32_t i = 0; i < count; ++i) {
+            // Redundant: the same state every draw, which the pass encoder elides
+            uint32_t variant = redundant ? 0 : i;
+            encoder.setPipeline(pipelines[variant % PIPELINE_COUNT]);
+            encoder.setVertexBuffer(0, vertexBuffers[variant % VERTEX_BUFFER_COUNT]);
+            encoder.drawIndexed(3);
+        }
+    }
+};
+
+// One scene per backend, pipelines and buffers belong to their device
+template<BenchmarkBackend Backend>
+DrawScene* acquireScene(benchmark::State& state) {
+    BenchmarkDevice& bench = BenchmarkDevice::instance(Backend);
+    if (!bench.isValid()) {
+        state.SkipWithError("No device available");
+        return nullptr;
+    }
+
+    static DrawScene scene(bench);
+    if (!scene.valid) {
+        state.SkipWithError("Failed to create draw scene");
+        return nullptr;
+    }
+    return &scene;
+}
+
+double nanoseconds(Clock::duration duration) {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+// CPU cost per draw and submit-to-completion latency, averaged over the run
+void setDrawCounters(benchmark::State& state, uint32_t draws, double encodeNs, double submitNs) {
+    const double iterations = static_cast<double>(std::max<benchmark::IterationCount>(state.iterations(), 1));
+    state.counters["draws"] = draws;
+    state.counters["encode_ns_per_draw"] = encodeNs / (iterations * draws);
+    state.counters["submit_us"] = submitNs / iterations / 1000.0;
+    state.SetItemsProcessed(state.iterations() * draws);
+}
+
+// N draws through one pass encoder, then finish and submit. On the null
+// backend encode_ns_per_draw is the engine's own cost per draw.
+template<BenchmarkBackend Backend, bool Redundant>
+void BM_EncodeDraws(benchmark::State& state) {
+    DrawScene* scene = acquireScene<Backend>(state);
+    if (!scene) {
+        return;
+    }
+    BenchmarkDevice& bench = BenchmarkDevice::instance(Backend);
+    const uint32_t draws = static_cast<uint32_t>(state.range(0));
+    const RenderPassDesc desc = scene->passDesc(LoadOp::Clear);
+
+    double encodeNs = 0.0;
+    double submitNs = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto encoder = bench.getDevice()->createCommandEncoder();
+        auto pass = encoder ? encoder->beginRenderPass(desc) : nullptr;
+        if (!pass) {
+            state.SkipWithError("Failed to begin render pass");
+            return;
+        }
+        scene->recordDraws(*pass, draws, Redundant);
+        pass->end();
+        auto commandBuffer = encoder->finish();
+        auto encoded = Clock::now();
+
+        if (!bench.submitAndWait(commandBuffer)) {
+            state.SkipWithError("Submit failed");
+            return;
+        }
+        encodeNs += nanoseconds(encoded - start);
+        submitNs += nanoseconds(Clock::now() - encoded);
+    }
+
+    setDrawCounters(state, draws, encodeNs, submitNs);
+}
+
+// N draws recorded once into a bundle; each iteration replays it in a new pass
+template<BenchmarkBackend Backend>
+void BM_BundleReplay(benchmark::State& state) {
+    DrawScene* scene = acquireScene<Backend>(state);
+    if (!scene) {
+        return;
+    }
+    BenchmarkDevice& bench = BenchmarkDevice::instance(Backend);
+    const uint32_t draws = static_cast<uint32_t>(state.range(0));
+
+    RenderBundleEncoderDesc bundleDesc;
+    bundleDesc.colorFormats = {TARGET_FORMAT};
+    bundleDesc.label = "BenchmarkDrawBundle";
+    auto recordStart = Clock::now();
+    auto bundleEncoder = bench.getDevice()->createRenderBundleEncoder(bundleDesc);
+    if (!bundleEncoder) {
+        state.SkipWithError("Failed to create render bundle encoder");
+        return;
+    }
+    scene->recordDraws(*bundleEncoder, draws, false);
+    std::shared_ptr<IRenderBundle> bundle = bundleEncoder->finish();
+    const double bundleRecordNs = nanoseconds(Clock::now() - recordStart);
+    if (!bundle) {
+        state.SkipWithError("Failed to finish render bundle");
+        return;
+    }
+
+    const RenderPassDesc desc = scene->passDesc(LoadOp::Clear);
+    const std::shared_ptr<IRenderBundle> bundles[] = {bundle};
+    double encodeNs = 0.0;
+    double submitNs = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto encoder = bench.getDevice()->createCommandEncoder();
+        auto pass = encoder ? encoder->beginRenderPass(desc) : nullptr;
+        if (!pass) {
+            state.SkipWithError("Failed to begin render pass");
+            return;
+        }
+        pass->executeBundles(bundles);
+        pass->end();
+        auto commandBuffer = encoder->finish();
+        auto encoded = Clock::now();
+
+        if (!bench.submitAndWait(commandBuffer)) {
+            state.SkipWithError("Submit failed");
+            return;
+        }
+        encodeNs += nanoseconds(encoded - start);
+        submitNs += nanoseconds(Clock::now() - encoded);
+    }
+
+    setDrawCounters(state, draws, encodeNs, submitNs);
+    state.counters["bundle_record_ns_per_draw"] = bundleRecordNs / draws;
+}
+
+// N draws split across jobs of a ParallelCommandRecorder, one pass per job
+template<BenchmarkBackend Backend>
+void BM_ParallelRecord(benchmark::State& state) {
+    DrawScene* scene = acquireScene<Backend>(state);
+    if (!scene) {
+        return;
+    }
+    BenchmarkDevice& bench = BenchmarkDevice::instance(Backend);
+    const uint32_t draws = static_cast<uint32_t>(state.range(0));
+    const uint32_t threads = static_cast<uint32_t>(state.range(1));
+
+    // One job per thread bounds parallelism; 0 workers would mean hardware concurrency
+    ParallelCommandRecorder recorder(bench.getDevice(), std::max(threads - 1, 1u));
+    const RenderPassDesc clearDesc = scene->passDesc(LoadOp::Clear);
+    const RenderPassDesc loadDesc = scene->passDesc(LoadOp::Load);
+
+    std::vector<ParallelCommandRecorder::EncoderJob> jobs;
+    for (uint32_t job = 0; job < threads; ++job) {
+        uint32_t first = draws * job / threads;
+        uint32_t count = draws * (job + 1) / threads - first;
+        jobs.push_back([scene, &clearDesc, &loadDesc, count](ICommandEncoder& encoder, uint32_t jobIndex) {
+            // Submitted in job order, so only the first pass clears
+            auto pass = encoder.beginRenderPass(jobIndex == 0 ? clearDesc : loadDesc);
+            if (!pass) {
+                return;
+            }
+            scene->recordDraws(*pass, count, false);
+            pass->end();
+        });
+    }
+
+    double encodeNs = 0.0;
+    double submitNs = 0.0;
+    for (auto _ : state) {
+        auto start = Clock::now();
+        auto commandBuffers = recorder.record(jobs);
+        auto encoded = Clock::now();
+
+        SubmissionFence fence = bench.getQueue()->submit(commandBuffers);
+        if (!fence || !fence.wait()) {
+            state.SkipWithError("Submit failed");
+            return;
+        }
+        encodeNs += nanoseconds(encoded - start);
+        submitNs += nanoseconds(Clock::now() - encoded);
+    }
+
+    setDrawCounters(state, draws, encodeNs, submitNs);
+    state.counters["threads"] = threads;
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_EncodeDraws, BenchmarkBackend::WebGPU, false)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_EncodeDraws, BenchmarkBackend::WebGPU, true)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BundleReplay, BenchmarkBackend::WebGPU)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ParallelRecord, BenchmarkBackend::WebGPU)
+    ->ArgsProduct({{16000}, {1, 2, 4, 8}})->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// Same benchmarks without a GPU, the difference to the above is driver cost
+BENCHMARK_TEMPLATE(BM_EncodeDraws, BenchmarkBackend::Null, false)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_EncodeDraws, BenchmarkBackend::Null, true)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_BundleReplay, BenchmarkBackend::Null)
+    ->Arg(1000)->Arg(4000)->Arg(16000)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_ParallelRecord, BenchmarkBackend::Null)
+    ->ArgsProduct({{16000}, {1, 2, 4, 8}})->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+} // namespace pers::benchmarks
@@ -0,0 +1,17 @@
+#include "pers/utils/Logger.h"
+#include <benchmark/benchmark.h>
+
+int main(int argc, char** argv) {
+    // Keep per-buffer creation logs out of the timings and the report
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Trace, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Debug, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Info, false);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,307 @@
+#include "AssetImportPipeline.h"
+#include "DownloadManager.h"
+#include "MeshSimplifier.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/buffers/DeviceBuffer.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include "pers/graphics/buffers/UploadBatcher.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+
+namespace {
+
+// Blocking queue with a fixed capacity; push() waits while full, pop() while empty.
+// close() wakes everyone, after which pop() drains what is left and then returns nullopt.
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : _capacity(std::max<size_t>(capacity, 1)) {}
+    
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notFull.wait(lock, [this] { return _items.size() < _capacity; });
+        _items.push_back(std::move(item));
+        _notEmpty.notify_one();
+    }
+    
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _notEmpty.wait(lock, [this] { return !_items.empty() || _closed; });
+        if (_items.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(_items.front());
+        _items.pop_front();
+        _notFull.notify_one();
+        return item;
+    }
+    
+    void close() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closed = true;
+        _notEmpty.notify_all();
+    }
+    
+private:
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+    std::deque<T> _items;
+    size_t _capacity;
+    bool _closed = false;
+};
+
+struct FileJob {
+    size_t index = 0;
+    std::vector<uint8_t> bytes;  // Empty if the read failed
+};
+
+struct MeshJob {
+    size_t index = 0;
+    MeshData mesh;
+    bool decoded = false;
+};
+
+bool readWholeFile(const std::string& path, std::vector<uint8_t>& outBytes) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    const std::streamsize size = file.tellg();
+    if (size <= 0) {
+        return false;
+    }
+    outBytes.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(outBytes.data()), size));
+}
+
+// Extension of a path or URL, without the dot; URL query and fragment are ignored
+std::string sourceExtension(const std::string& source) {
+    std::string path = source;
+    if (path.find("://") != std::string::npos) {
+        path = path.substr(0, path.find_first_of("?#"));
+    }
+    std::string extension = std::filesystem::path(path).extension().string();
+    if (!extension.empty() && extension.front() == '.') {
+        extension.erase(0, 1);
+    }
+    return extension;
+}
+
+} // anonymous namespace
+
+AssetImportPipeline::AssetImportPipeline(const std::shared_ptr<pers::ILogicalDevice>& device,
+                                         const AssetImportOptions& options)
+    : _device(device)
+    , _options(options) {
+    if (_options.ioThreadCount == 0) {
+        _options.ioThreadCount = 1;
+    }
+    if (_options.workerThreadCount == 0) {
+        const uint32_t hardware = std::thread::hardware_concurrency();
+        _options.workerThreadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+}
+
+std::vector<ImportedMesh> AssetImportPipeline::importMeshes(const std::vector<std::string>& paths) {
+    const uint32_t ioCount = std::min<uint32_t>(_options.ioThreadCount, static_cast<uint32_t>(paths.size()));
+    return run(paths, [&](const FileSink& sink) {
+        std::atomic<size_t> nextPath{0};
+        std::vector<std::thread> readers;
+        readers.reserve(ioCount);
+        for (uint32_t t = 0; t < ioCount; ++t) {
+            readers.emplace_back([&] {
+                for (size_t i = nextPath.fetch_add(1); i < paths.size(); i = nextPath.fetch_add(1)) {
+                    std::vector<uint8_t> bytes;
+                    if (!readWholeFile(paths[i], bytes)) {
+                        LOG_ERROR("AssetImportPipeline", "Failed to read: " + paths[i]);
+                        bytes.clear();
+                    }
+                    sink(i, std::move(bytes));
+                }
+            });
+        }
+        for (auto& reader : readers) {
+            reader.join();
+        }
+    });
+}
+
+std::vector<ImportedMesh> AssetImportPipeline::importUrls(const std::vector<std::string>& urls,
+                                                          DownloadManager& downloads) {
+    return run(urls, [&](const FileSink& sink) {
+        // One body per URL, filled on the transfer threads and handed over on completion
+        std::vector<std::vector<uint8_t>> bodies(urls.size());
+        std::vector<std::future<DownloadResult>> transfers;
+        transfers.reserve(urls.size());
+        for (size_t i = 0; i < urls.size(); ++i) {
+            auto onChunk = [&bodies, i](uint64_t offset, const uint8_t* data, size_t size) {
+                auto& body = bodies[i];
+                body.resize(static_cast<size_t>(offset));  // Drops a restarted body
+                body.insert(body.end(), data, data + size);
+            };
+            auto onComplete = [&bodies, &sink, i](const DownloadResult& result) {
+                std::vector<uint8_t> bytes = std::move(bodies[i]);
+                if (!result.ok || bytes.size() != result.size) {
+                    LOG_ERROR("AssetImportPipeline", "Failed to download: " + result.url);
+                    bytes.clear();
+                }
+                sink(i, std::move(bytes));
+            };
+            transfers.push_back(downloads.download(urls[i], onChunk, onComplete));
+        }
+        for (auto& transfer : transfers) {
+            transfer.wait();
+        }
+    });
+}
+
+std::vector<ImportedMesh> AssetImportPipeline::run(const std::vector<std::string>& sources,
+                                                   const std::function<void(const FileSink& sink)>& readSources) {
+    std::vector<ImportedMesh> results(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        results[i].path = sources[i];
+    }
+    
+    if (!_device) {
+        LOG_ERROR("AssetImportPipeline", "Invalid device");
+        return results;
+    }
+    if (sources.empty()) {
+        return results;
+    }
+    
+    BoundedQueue<FileJob> fileQueue(_options.maxQueuedFiles);
+    BoundedQueue<MeshJob> meshQueue(_options.maxQueuedMeshes);
+    
+    const uint32_t workerCount = std::min<uint32_t>(_options.workerThreadCount, static_cast<uint32_t>(sources.size()));
+    
+    // The last thread out of a stage closes that stage's output queue
+    std::atomic<uint32_t> workersRunning{workerCount};
+    
+    std::vector<std::thread> threads;
+    threads.reserve(1 + workerCount);
+    
+    threads.emplace_back([&] {
+        readSources([&](size_t index, std::vector<uint8_t> bytes) {
+            FileJob job;
+            job.index = index;
+            job.bytes = std::move(bytes);
+            fileQueue.push(std::move(job));
+        });
+        fileQueue.close();
+    });
+    
+    for (uint32_t t = 0; t < workerCount; ++t) {
+        threads.emplace_back([&] {
+            while (auto file = fileQueue.pop()) {
+                MeshJob job;
+                job.index = file->index;
+                if (!file->bytes.empty()) {
+                    job.decoded = ResourceLoader::loadMeshFromMemory(file->bytes.data(), file->bytes.size(),
+                                                                     sourceExtension(sources[job.index]), job.mesh);
+                    if (job.decoded && _options.generateLODs) {
+                        MeshSimplifier::generateLODs(job.mesh);
+                    }
+                }
+                // Release the file contents before blocking on a full upload queue
+                file.reset();
+                meshQueue.push(std::move(job));
+            }
+            if (workersRunning.fetch_sub(1) == 1) {
+                meshQueue.close();
+            }
+        });
+    }
+    
+    // Upload stage: the only place that touches the device
+    pers::UploadBatcher batcher(_device);
+    size_t loadedCount = 0;
+    while (auto job = meshQueue.pop()) {
+        ImportedMesh& result = results[job->index];
+        if (!job->decoded) {
+            continue;
+        }
+        if (!uploadMesh(job->mesh, result, batcher)) {
+            LOG_ERROR("AssetImportPipeline", "Failed to upload: " + result.path);
+            continue;
+        }
+        ++loadedCount;
+        if (batcher.getPendingBytes() >= _options.uploadFlushBytes && !batcher.flush()) {
+            LOG_ERROR("AssetImportPipeline", "Failed to submit mesh uploads");
+        }
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    if (!batcher.flush()) {
+        LOG_ERROR("AssetImportPipeline", "Failed to submit mesh uploads");
+    }
+    
+    LOG_INFO("AssetImportPipeline",
+        "Imported " + std::to_string(loadedCount) + " of " + std::to_string(sources.size()) + " meshes");
+    return results;
+}
+
+bool AssetImportPipeline::uploadMesh(MeshData& mesh, ImportedMesh& outMesh, pers::UploadBatcher& batcher) {
+    const uint64_t vertexBytes = mesh.vertices.size() * sizeof(float);
+    const uint64_t indexBytes = mesh.indices.size() * sizeof(uint32_t);
+    if (vertexBytes == 0) {
+        return false;
+    }
+    
+    if (_options.vertexHeap && _options.indexHeap) {
+        // The queue copies the data at write time, same as the batcher
+        const auto& queue = _device->getQueue();
+        auto vertexView = _options.vertexHeap->allocate(vertexBytes);
+        auto indexView = indexBytes > 0 ? _options.indexHeap->allocate(indexBytes) : nullptr;
+        if (!queue || !vertexView || (indexBytes > 0 && !indexView)) {
+            return false;
+        }
+        if (!queue->writeBuffer(vertexView, 0, std::as_bytes(std::span(mesh.vertices))) ||
+            (indexView && !queue->writeBuffer(indexView, 0, std::as_bytes(std::span(mesh.indices))))) {
+            return false;
+        }
+        outMesh.vertexBuffer = vertexView;
+        outMesh.indexBuffer = indexView;
+    } else {
+        auto vertexBuffer = std::make_shared<pers::DeviceBuffer>();
+        if (!vertexBuffer->create(vertexBytes, pers::DeviceBufferUsage::Vertex, _device, outMesh.path + ":Vertices") ||
+            !batcher.enqueue(mesh.vertices.data(), vertexBytes, vertexBuffer)) {
+            return false;
+        }
+        
+        std::shared_ptr<pers::DeviceBuffer> indexBuffer;
+        if (indexBytes > 0) {
+            indexBuffer = std::make_shared<pers::DeviceBuffer>();
+            if (!indexBuffer->create(indexBytes, pers::DeviceBufferUsage::Index, _device, outMesh.path + ":Indices") ||
+                !batcher.enqueue(mesh.indices.data(), indexBytes, indexBuffer)) {
+                return false;
+            }
+        }
+        outMesh.vertexBuffer = vertexBuffer;
+        outMesh.indexBuffer = indexBuffer;
+    }
+    
+    // The data has been copied out, keep only the layout
+    outMesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    outMesh.layout = std::move(mesh);
+    outMesh.layout.vertices = {};
+    outMesh.layout.indices = {};
+    outMesh.loaded = true;
+    return true;
+}
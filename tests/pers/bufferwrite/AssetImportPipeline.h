@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ResourceLoader.h"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+    class DeviceBufferHeap;
+    class IBuffer;
+    class ILogicalDevice;
+    class UploadBatcher;
+}
+
+class DownloadManager;
+
+struct ImportedMesh {
+    std::string path;
+    MeshData layout;  // Stride, offsets, bounds and submeshes; vertex and index arrays are released after upload
+    uint32_t indexCount = 0;
+    std::shared_ptr<pers::IBuffer> vertexBuffer;  // DeviceBuffer, or a DeviceBufferView with heaps set
+    std::shared_ptr<pers::IBuffer> indexBuffer;   // Holds every LOD, see layout.lods
+    bool loaded = false;
+};
+
+struct AssetImportOptions {
+    uint32_t ioThreadCount = 1;                    // Disk reads
+    uint32_t workerThreadCount = 0;                // Decode and normalize, 0 = hardware concurrency - 1
+    size_t maxQueuedFiles = 8;                     // Read files waiting for a worker
+    size_t maxQueuedMeshes = 8;                    // Decoded meshes waiting for upload
+    uint64_t uploadFlushBytes = 32ull * 1024 * 1024;  // Submit the batcher once this much is pending
+    bool generateLODs = true;                      // Simplified levels on the worker threads
+    
+    // Optional megabuffers; when set, meshes are sub-allocated from them and
+    // written through the queue instead of getting buffers of their own
+    std::shared_ptr<pers::DeviceBufferHeap> vertexHeap;
+    std::shared_ptr<pers::DeviceBufferHeap> indexHeap;
+};
+
+// Loads many meshes with disk reads, decoding and GPU upload overlapped.
+// IO threads read whole files, a worker pool decodes and normalizes them,
+// and the calling thread is the single upload stage, feeding an UploadBatcher.
+// The queues between stages are bounded, so a slow stage stalls the ones
+// before it instead of piling up file contents or decoded meshes in memory.
+class AssetImportPipeline {
+public:
+    explicit AssetImportPipeline(const std::shared_ptr<pers::ILogicalDevice>& device,
+                                 const AssetImportOptions& options = {});
+    ~AssetImportPipeline() = default;
+    
+    AssetImportPipeline(const AssetImportPipeline&) = delete;
+    AssetImportPipeline& operator=(const AssetImportPipeline&) = delete;
+    
+    // Import every path; results are in path order, failed entries have loaded = false.
+    // Returns once all uploads are submitted.
+    std::vector<ImportedMesh> importMeshes(const std::vector<std::string>& paths);
+    
+    // Same, with the disk reads replaced by downloads through the manager.
+    // Bodies are collected as they stream in and each mesh goes to the
+    // decoders the moment its transfer finishes, while the rest are still
+    // in flight. Results carry the URL as path.
+    std::vector<ImportedMesh> importUrls(const std::vector<std::string>& urls, DownloadManager& downloads);
+    
+private:
+    // Hands the bytes of one source to the decoders, empty if reading it failed; may block
+    using FileSink = std::function<void(size_t index, std::vector<uint8_t> bytes)>;
+    
+    // Runs the decode and upload stages over whatever readSources produces.
+    // readSources runs on its own thread, passes every index to the sink once and returns when done.
+    std::vector<ImportedMesh> run(const std::vector<std::string>& sources,
+                                  const std::function<void(const FileSink& sink)>& readSources);
+    
+    bool uploadMesh(MeshData& mesh, ImportedMesh& outMesh, pers::UploadBatcher& batcher);
+    
+    std::shared_ptr<pers::ILogicalDevice> _device;
+    AssetImportOptions _options;
+};
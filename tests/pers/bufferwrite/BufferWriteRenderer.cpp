@@ -14,6 +14,10 @@
 #include "pers/graphics/buffers/ImmediateStagingBuffer.h"
 #include "pers/graphics/buffers/DeviceBuffer.h"
 #include "ResourceLoader.h"
+#include "MeshSimplifier.h"
+#include "LODSelector.h"
+#include "MeshStreamer.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
 #include "pers/graphics/IShaderModule.h"
 #include "pers/graphics/IRenderPipeline.h"
 #include "pers/graphics/IRenderPassEncoder.h"
@@ -255,23 +259,54 @@ bool BufferWriteRenderer::createGraphicsResources() {
         return false;
     }
     
-    // 1. Load Stanford Bunny mesh
+    // 1. Stream the Stanford Bunny from its cooked file, cooking it first when no previous run did
+    const std::string cookedBunnyPath = "resources/bunny.pmesh";
+    _vertexHeap = std::make_shared<pers::DeviceBufferHeap>(factory, pers::BufferUsage::Vertex,
+        pers::DeviceBufferHeap::DEFAULT_PAGE_SIZE, "MeshVertexHeap");
+    _indexHeap = std::make_shared<pers::DeviceBufferHeap>(factory, pers::BufferUsage::Index,
+        pers::DeviceBufferHeap::DEFAULT_PAGE_SIZE, "MeshIndexHeap");
+    _meshStreamer = std::make_unique<MeshStreamer>(_device, _vertexHeap, _indexHeap);
+    _bunny = _meshStreamer->add(cookedBunnyPath);
+    
     MeshData bunnyMesh;
-    if (!ResourceLoader::loadStanfordBunny(bunnyMesh)) {
-        LOG_ERROR("BufferWriteRenderer",
-            "Failed to load Stanford Bunny mesh");
-        return false;
+    if (!_bunny) {
+        if (!ResourceLoader::loadStanfordBunny(bunnyMesh)) {
+            LOG_ERROR("BufferWriteRenderer",
+                "Failed to load Stanford Bunny mesh");
+            return false;
+        }
+        
+        // Coarser levels go after the full mesh in the same index buffer
+        MeshSimplifier::generateLODs(bunnyMesh);
+        
+        // Vertices quantized to half the size
+        MeshCookOptions cookOptions;
+        cookOptions.quantize = true;
+        if (ResourceLoader::cookMesh(bunnyMesh, cookedBunnyPath, cookOptions)) {
+            _bunny = _meshStreamer->add(cookedBunnyPath);
+        } else {
+            LOG_WARNING("BufferWriteRenderer", "Failed to cook bunny mesh, next launch imports again");
+        }
     }
     
-    // Create GPU buffers from mesh data
-    if (!ResourceLoader::createGPUBuffers(bunnyMesh, _device, _queue, _vertexBuffer, _indexBuffer)) {
-        LOG_ERROR("BufferWriteRenderer",
-            "Failed to create GPU buffers for bunny mesh");
-        return false;
+    if (_bunny) {
+        bunnyMesh = *_meshStreamer->getLayout(_bunny);
+        _indexCount = _meshStreamer->getDraw(_bunny).indexCount;
+    } else {
+        // Not streamable, upload every level at once
+        if (!ResourceLoader::createGPUBuffers(bunnyMesh, _device, _queue, _vertexBuffer, _indexBuffer)) {
+            LOG_ERROR("BufferWriteRenderer",
+                "Failed to create GPU buffers for bunny mesh");
+            return false;
+        }
+        _indexCount = static_cast<uint32_t>(bunnyMesh.indices.size());
     }
     
-    // Store index count for drawing
-    _indexCount = static_cast<uint32_t>(bunnyMesh.indices.size());
+    // Without generated levels the whole index buffer is LOD 0
+    _lods = bunnyMesh.lods;
+    if (_lods.empty()) {
+        _lods.push_back({0, _indexCount, 0.0f});
+    }
     
     LOG_INFO("BufferWriteRenderer",
         "Loaded Stanford Bunny with " + std::to_string(_indexCount) + " indices");
@@ -387,15 +422,15 @@ fn main(@location(0) color: vec4<f32>) -> @location(0) vec4<f32> {
     
     // Position attribute
     pers::VertexAttribute positionAttribute;
-    positionAttribute.format = pers::VertexFormat::Float32x3;
-    positionAttribute.offset = 0;
+    positionAttribute.format = bunnyMesh.positionFormat;
+    positionAttribute.offset = bunnyMesh.positionOffset;
     positionAttribute.shaderLocation = 0;
     vertexLayout.attributes.push_back(positionAttribute);
     
     // Add normal attribute if mesh has normals
     if (bunnyMesh.hasNormals) {
         pers::VertexAttribute normalAttribute;
-        normalAttribute.format = pers::VertexFormat::Float32x3;
+        normalAttribute.format = bunnyMesh.normalFormat;
         normalAttribute.offset = bunnyMesh.normalOffset;
         normalAttribute.shaderLocation = 1;
         vertexLayout.attributes.push_back(normalAttribute);
@@ -455,7 +490,7 @@ fn main(@location(0) color: vec4<f32>) -> @location(0) vec4<f32> {
 }
 
 void BufferWriteRenderer::renderFrame() {
-    if (!_surfaceFramebuffer || !_renderPipeline || !_vertexBuffer || !_queue) {
+    if (!_surfaceFramebuffer || !_renderPipeline || (!_vertexBuffer && !_bunny) || !_queue) {
         return;  // Not ready to render
     }
     
@@ -494,14 +529,41 @@ void BufferWriteRenderer::renderFrame() {
     // 4. Set pipeline
     renderPass->setPipeline(_renderPipeline);
     
-    // 5. Set vertex buffer
-    renderPass->setVertexBuffer(0, _vertexBuffer, 0);
+    // 5. Pick the level to draw
+    // Camera sits at (0.67, 1.0, 1.33) with a y scale of 1.0, see the vertex shader
+    LODSelectParams lodParams;
+    lodParams.distance = 1.794f;
+    lodParams.projectionScale = 1.0f;
+    lodParams.viewportHeight = static_cast<float>(_config.windowSize.y);
+    uint32_t lod = LODSelector::select(_lods, lodParams);
+    
+    // Streamed meshes draw whatever level is resident while finer ones upload
+    std::shared_ptr<pers::IBuffer> vertexBuffer = _vertexBuffer;
+    std::shared_ptr<pers::IBuffer> indexBuffer = _indexBuffer;
+    uint32_t firstIndex = _lods[lod].firstIndex;
+    uint32_t indexCount = _lods[lod].indexCount;
+    if (_bunny) {
+        _meshStreamer->requestLod(_bunny, lod);
+        _meshStreamer->update();
+        const StreamedMeshDraw draw = _meshStreamer->getDraw(_bunny);
+        vertexBuffer = draw.vertexBuffer;
+        indexBuffer = draw.indexBuffer;
+        firstIndex = 0;
+        indexCount = draw.indexCount;
+        lod = draw.lod;
+    }
+    if (lod != _currentLod) {
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Debug, "BufferWriteRenderer", PERS_SOURCE_LOC,
+            "Switched to LOD %u (%u triangles)", lod, indexCount / 3);
+        _currentLod = lod;
+    }
     
     // 6. Draw
-    if (_indexBuffer && _indexCount > 0) {
+    renderPass->setVertexBuffer(0, vertexBuffer, 0);
+    if (indexBuffer && indexCount > 0) {
         // Draw indexed bunny
-        renderPass->setIndexBuffer(_indexBuffer, pers::IndexFormat::Uint32, 0);
-        renderPass->drawIndexed(_indexCount, 1, 0, 0, _frameCounter);
+        renderPass->setIndexBuffer(indexBuffer, pers::IndexFormat::Uint32, 0);
+        renderPass->drawIndexed(indexCount, 1, firstIndex, 0, _frameCounter);
     } else {
         // Fallback to triangle
         renderPass->draw(3, 1, 0, 0);
@@ -542,7 +604,7 @@ void BufferWriteRenderer::onResize(int width, int height) {
     pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "BufferWriteRenderer", PERS_SOURCE_LOC,
         "Resized to: %dx%d", _config.windowSize.x, _config.windowSize.y);
     
-    // Resize surface framebuffer with new size
+    // Recorded only, the surface framebuffer applies it at the next acquireNextImage
     if (_surfaceFramebuffer) {
         _surfaceFramebuffer->resize(width, height);
     }
@@ -557,9 +619,13 @@ void BufferWriteRenderer::cleanup() {
     // 7. _renderPipeline (created in createGraphicsResources)
     _renderPipeline.reset();
     
-    // 6. _vertexBuffer and _indexBuffer (created in createGraphicsResources)
+    // 6. Mesh buffers (created in createGraphicsResources); the streamer retires its views into the heaps
     _vertexBuffer.reset();
     _indexBuffer.reset();
+    _bunny = {};
+    _meshStreamer.reset();
+    _indexHeap.reset();
+    _vertexHeap.reset();
     
     // 5. _surfaceFramebuffer (created in initializeGraphics)
     _surfaceFramebuffer.reset();
@@ -7,6 +7,8 @@
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/graphics/SurfaceFramebuffer.h"
 #include "pers/graphics/RenderPassConfig.h"
+#include "ResourceLoader.h"
+#include "MeshStreamer.h"
 
 namespace pers {
     class IGraphicsInstanceFactory;
@@ -94,9 +96,15 @@ private:
     // Rendering resources
     std::shared_ptr<pers::ISurfaceFramebuffer> _surfaceFramebuffer;  // Surface framebuffer interface
     // NO SEPARATE DEPTH BUFFER - SurfaceFramebuffer handles it internally (Review issue #1)
+    std::shared_ptr<pers::DeviceBufferHeap> _vertexHeap;
+    std::shared_ptr<pers::DeviceBufferHeap> _indexHeap;
+    std::unique_ptr<MeshStreamer> _meshStreamer;
+    StreamedMeshHandle _bunny;  // Null when the cooked file could not be written, then the buffers below are used
     std::shared_ptr<pers::IBuffer> _vertexBuffer;
     std::shared_ptr<pers::IBuffer> _indexBuffer;  // For indexed drawing
-    uint32_t _indexCount = 0;  // Number of indices to draw
+    uint32_t _indexCount = 0;  // Number of indices in the index buffer, all LODs; resident level when streamed
+    std::vector<MeshData::LOD> _lods;  // Index ranges per level of detail
+    uint32_t _currentLod = 0;
     std::shared_ptr<pers::IRenderPipeline> _renderPipeline;
     
     // Render pass configuration (created once, reused every frame)
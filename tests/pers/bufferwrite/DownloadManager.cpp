@@ -0,0 +1,470 @@
+#include "DownloadManager.h"
+#include "pers/utils/Hash.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+// What the cache holds for one URL
+struct CacheRef {
+    std::string etag;
+    std::string object;  // File name under objects/
+    uint64_t size = 0;
+};
+
+struct Response {
+    int status = 0;
+    std::string etag;
+};
+
+std::string toHex(uint64_t value) {
+    static constexpr char DIGITS[] = "0123456789abcdef";
+    std::string text(16, '0');
+    for (int i = 15; i >= 0; --i, value >>= 4) {
+        text[i] = DIGITS[value & 0xf];
+    }
+    return text;
+}
+
+// Strings in curl config files are double-quoted with backslash escapes
+std::string quoteConfig(const std::string& value) {
+    std::string quoted = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+bool hasControlCharacters(const std::string& value) {
+    return std::any_of(value.begin(), value.end(), [](char c) { return static_cast<unsigned char>(c) < 0x20; });
+}
+
+std::string readLine(const fs::path& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+bool readRef(const fs::path& refPath, const fs::path& objects, CacheRef& outRef) {
+    std::ifstream file(refPath);
+    if (!file || !std::getline(file, outRef.etag) || !std::getline(file, outRef.object) || !(file >> outRef.size)) {
+        return false;
+    }
+    std::error_code error;
+    return !outRef.object.empty() && fs::file_size(objects / outRef.object, error) == outRef.size && !error;
+}
+
+bool writeRef(const fs::path& refPath, const CacheRef& ref) {
+    // Written aside and renamed, so an interrupted write never leaves a bad ref
+    const fs::path temporary = fs::path(refPath).concat(".tmp");
+    {
+        std::ofstream file(temporary, std::ios::trunc);
+        file << ref.etag << '\n' << ref.object << '\n' << ref.size << '\n';
+        if (!file) {
+            return false;
+        }
+    }
+    std::error_code error;
+    fs::rename(temporary, refPath, error);
+    return !error;
+}
+
+// Feed a file through the hasher, passing bytes from skipBelow on to onChunk
+bool replayFile(const fs::path& path, uint64_t skipBelow, const DownloadManager::ChunkCallback& onChunk,
+                pers::Fnv1aHasher* hasher) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> buffer(CHUNK_SIZE);
+    uint64_t offset = 0;
+    while (file) {
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        const size_t count = static_cast<size_t>(file.gcount());
+        if (count == 0) {
+            break;
+        }
+        if (hasher) {
+            hasher->addBytes(buffer.data(), count);
+        }
+        if (onChunk && offset + count > skipBelow) {
+            const size_t skip = offset < skipBelow ? static_cast<size_t>(skipBelow - offset) : 0;
+            onChunk(offset + skip, buffer.data() + skip, count - skip);
+        }
+        offset += count;
+    }
+    return file.eof();
+}
+
+// Parse one header block; false if another block follows it (interim response or redirect)
+bool parseHeaderBlock(const std::string& block, Response& outResponse) {
+    size_t lineStart = 0;
+    bool first = true;
+    bool hasLocation = false;
+    bool tunnel = false;
+    while (lineStart < block.size()) {
+        size_t lineEnd = block.find('\n', lineStart);
+        if (lineEnd == std::string::npos) {
+            lineEnd = block.size();
+        }
+        std::string line = block.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if (first) {
+            // "HTTP/1.1 200 OK", "HTTP/2 304"
+            first = false;
+            const size_t space = line.find(' ');
+            outResponse.status = space != std::string::npos ? std::atoi(line.c_str() + space + 1) : 0;
+            outResponse.etag.clear();
+            tunnel = line.find("Connection established") != std::string::npos;
+            continue;
+        }
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+        const size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+        const std::string value = valueStart != std::string::npos ? line.substr(valueStart) : std::string();
+        if (name == "etag") {
+            outResponse.etag = value;
+        } else if (name == "location") {
+            hasLocation = true;
+        }
+    }
+
+    const int status = outResponse.status;
+    const bool interim = status >= 100 && status < 200;
+    const bool redirect = status >= 300 && status < 400 && status != 304 && hasLocation;
+    return !(interim || redirect || tunnel);
+}
+
+int closeProcess(FILE* process) {
+#ifdef _WIN32
+    return _pclose(process);
+#else
+    const int status = pclose(process);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+} // anonymous namespace
+
+DownloadManager::DownloadManager(const DownloadOptions& options)
+    : _options(options) {
+    const uint32_t threadCount = std::max(_options.maxConcurrent, 1u);
+    _threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        _threads.emplace_back([this] { workerLoop(); });
+    }
+}
+
+DownloadManager::~DownloadManager() {
+    std::deque<Transfer> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+        cancelled.swap(_queue);
+    }
+    _wake.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+
+    for (auto& transfer : cancelled) {
+        DownloadResult result;
+        result.url = transfer.url;
+        if (transfer.onComplete) {
+            transfer.onComplete(result);
+        }
+        transfer.promise.set_value(result);
+    }
+}
+
+std::future<DownloadResult> DownloadManager::download(const std::string& url, ChunkCallback onChunk,
+                                                      CompletionCallback onComplete) {
+    Transfer transfer;
+    transfer.url = url;
+    transfer.key = toHex(pers::hashString(url));
+    transfer.onChunk = std::move(onChunk);
+    transfer.onComplete = std::move(onComplete);
+    auto future = transfer.promise.get_future();
+
+    if (url.empty() || hasControlCharacters(url)) {
+        LOG_ERROR("DownloadManager", "Invalid URL: " + url);
+        DownloadResult result;
+        result.url = url;
+        if (transfer.onComplete) {
+            transfer.onComplete(result);
+        }
+        transfer.promise.set_value(result);
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push_back(std::move(transfer));
+    }
+    _wake.notify_one();
+    return future;
+}
+
+void DownloadManager::waitIdle() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return _queue.empty() && _activeKeys.empty(); });
+}
+
+void DownloadManager::workerLoop() {
+    for (;;) {
+        Transfer transfer;
+        {
+            // Oldest transfer whose URL is not already in flight, they share the partial file
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto next = _queue.end();
+            _wake.wait(lock, [&] {
+                next = std::find_if(_queue.begin(), _queue.end(),
+                                    [&](const Transfer& queued) { return !_activeKeys.contains(queued.key); });
+                return _stopping || next != _queue.end();
+            });
+            if (_stopping) {
+                return;
+            }
+            transfer = std::move(*next);
+            _queue.erase(next);
+            _activeKeys.insert(transfer.key);
+        }
+
+        DownloadResult result = run(transfer);
+        if (transfer.onComplete) {
+            transfer.onComplete(result);
+        }
+        transfer.promise.set_value(result);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _activeKeys.erase(transfer.key);
+        }
+        _wake.notify_all();
+        _idle.notify_all();
+    }
+}
+
+DownloadResult DownloadManager::run(Transfer& transfer) {
+    DownloadResult result;
+    result.url = transfer.url;
+
+    const fs::path directory = _options.cacheDirectory;
+    const fs::path objects = directory / "objects";
+    const fs::path refPath = directory / (transfer.key + ".ref");
+    const fs::path partPath = directory / (transfer.key + ".part");
+    const fs::path partEtagPath = directory / (transfer.key + ".partetag");
+    const fs::path configPath = directory / (transfer.key + ".curlrc");
+    std::error_code error;
+    fs::create_directories(objects, error);
+    if (error) {
+        LOG_ERROR("DownloadManager", "Cannot create cache directory: " + directory.string());
+        return result;
+    }
+
+    CacheRef cached;
+    const bool hasCached = readRef(refPath, objects, cached);
+    auto serveCached = [&] {
+        if (!replayFile(objects / cached.object, 0, transfer.onChunk, nullptr)) {
+            return false;
+        }
+        result.path = (objects / cached.object).string();
+        result.size = cached.size;
+        result.fromCache = true;
+        result.ok = true;
+        return true;
+    };
+    if (hasCached && !_options.revalidate && serveCached()) {
+        return result;
+    }
+
+    uint64_t delivered = 0;  // Bytes already passed to onChunk, kept across resumed attempts
+    for (uint32_t attempt = 0; attempt <= _options.retryCount; ++attempt) {
+        // A partial body without a validator could be spliced with a newer version, drop it
+        const std::string partEtag = fs::exists(partPath, error) ? readLine(partEtagPath) : std::string();
+        const uint64_t partSize = partEtag.empty() ? 0 : fs::file_size(partPath, error);
+        if (partEtag.empty() || error) {
+            fs::remove(partPath, error);
+        }
+
+        // Everything goes through a config file, so no value is ever parsed by a shell
+        {
+            std::ofstream config(configPath, std::ios::trunc);
+            config << "silent\nshow-error\nlocation\ndump-header = \"-\"\noutput = \"-\"\n";
+            config << "connect-timeout = " << _options.connectTimeoutSeconds << '\n';
+            config << "url = " << quoteConfig(transfer.url) << '\n';
+            if (hasCached && !hasControlCharacters(cached.etag) && !cached.etag.empty()) {
+                config << "header = " << quoteConfig("If-None-Match: " + cached.etag) << '\n';
+            }
+            if (partSize > 0 && !hasControlCharacters(partEtag)) {
+                config << "range = \"" << partSize << "-\"\n";
+                config << "header = " << quoteConfig("If-Range: " + partEtag) << '\n';
+            }
+        }
+
+        const std::string command = "curl -K \"" + configPath.string() + "\"";
+#ifdef _WIN32
+        FILE* process = _popen(command.c_str(), "rb");
+#else
+        FILE* process = popen(command.c_str(), "r");
+#endif
+        if (!process) {
+            LOG_ERROR("DownloadManager", "Failed to start curl");
+            break;
+        }
+
+        Response response;
+        std::string header;
+        bool inHeader = true;
+        bool notModified = false;
+        bool failedWrite = false;
+        std::ofstream body;
+        pers::Fnv1aHasher hasher;
+        uint64_t offset = 0;
+
+        auto beginBody = [&] {
+            if (response.status == 304 && hasCached) {
+                notModified = true;
+                return;
+            }
+            if (response.status == 206 && partSize > 0) {
+                // The part is the prefix of this body: hash it, forward what onChunk has not seen
+                if (!replayFile(partPath, delivered, transfer.onChunk, &hasher)) {
+                    failedWrite = true;
+                    return;
+                }
+                offset = partSize;
+                body.open(partPath, std::ios::binary | std::ios::app);
+            } else if (response.status == 200) {
+                offset = 0;
+                body.open(partPath, std::ios::binary | std::ios::trunc);
+                std::ofstream(partEtagPath, std::ios::trunc) << response.etag << '\n';
+            } else {
+                return;  // Error page, discarded
+            }
+            failedWrite = !body;
+        };
+        auto consumeBody = [&](const uint8_t* data, size_t size) {
+            if (!body.is_open() || failedWrite || size == 0) {
+                return;
+            }
+            body.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            hasher.addBytes(data, size);
+            if (transfer.onChunk) {
+                transfer.onChunk(offset, data, size);
+            }
+            offset += size;
+            delivered = offset;
+            failedWrite = !body;
+        };
+
+        std::vector<uint8_t> buffer(CHUNK_SIZE);
+        size_t count = 0;
+        while ((count = std::fread(buffer.data(), 1, buffer.size(), process)) > 0) {
+            if (!inHeader) {
+                consumeBody(buffer.data(), count);
+                continue;
+            }
+            // curl writes every response's header block before the final body
+            header.append(reinterpret_cast<const char*>(buffer.data()), count);
+            for (;;) {
+                size_t end = header.find("\r\n\r\n");
+                size_t separator = 4;
+                if (end == std::string::npos) {
+                    end = header.find("\n\n");
+                    separator = 2;
+                }
+                if (end == std::string::npos) {
+                    break;
+                }
+                const bool finalBlock = parseHeaderBlock(header.substr(0, end), response);
+                header.erase(0, end + separator);
+                if (finalBlock) {
+                    inHeader = false;
+                    beginBody();
+                    consumeBody(reinterpret_cast<const uint8_t*>(header.data()), header.size());
+                    header.clear();
+                    break;
+                }
+            }
+        }
+        const int exitCode = closeProcess(process);
+        fs::remove(configPath, error);
+        const bool bodyOpen = body.is_open();
+        body.close();
+        result.status = response.status;
+
+        if (notModified && serveCached()) {
+            return result;
+        }
+        if (failedWrite) {
+            LOG_ERROR("DownloadManager", "Failed to write cache file: " + partPath.string());
+            break;
+        }
+        if (bodyOpen && exitCode == 0) {
+            CacheRef ref;
+            ref.etag = response.etag;
+            ref.size = offset;
+            ref.object = toHex(hasher.get()) + "-" + std::to_string(offset);
+            const fs::path objectPath = objects / ref.object;
+            if (fs::file_size(objectPath, error) == offset && !error) {
+                fs::remove(partPath, error);  // Same bytes already cached under another URL or ETag
+            } else {
+                fs::rename(partPath, objectPath, error);
+            }
+            fs::remove(partEtagPath, error);
+            if (!fs::exists(objectPath) || !writeRef(refPath, ref)) {
+                LOG_ERROR("DownloadManager", "Failed to store download: " + transfer.url);
+                break;
+            }
+            result.path = objectPath.string();
+            result.size = offset;
+            result.ok = true;
+            return result;
+        }
+        if (response.status == 416) {
+            // The part no longer fits the file, start over
+            fs::remove(partPath, error);
+            fs::remove(partEtagPath, error);
+            continue;
+        }
+        if (response.status >= 400) {
+            LOG_ERROR("DownloadManager", "HTTP " + std::to_string(response.status) + " from: " + transfer.url);
+            break;
+        }
+        LOG_WARNING("DownloadManager", "Transfer interrupted, retrying: " + transfer.url);
+    }
+
+    // Offline or failing server: a stale copy beats none
+    if (hasCached && serveCached()) {
+        LOG_WARNING("DownloadManager", "Using cached copy of: " + transfer.url);
+        return result;
+    }
+    LOG_ERROR("DownloadManager", "Failed to download: " + transfer.url);
+    return result;
+}
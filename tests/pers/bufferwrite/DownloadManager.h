@@ -0,0 +1,88 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+struct DownloadResult {
+    std::string url;
+    std::string path;      // Cached copy, shared by every URL serving the same bytes
+    uint64_t size = 0;
+    int status = 0;        // Final HTTP status, 0 if no response arrived
+    bool fromCache = false;  // Not modified, or the server was unreachable and a cached copy existed
+    bool ok = false;
+};
+
+struct DownloadOptions {
+    std::string cacheDirectory = "resources/cache";
+    uint32_t maxConcurrent = 4;        // Transfers in flight at once
+    uint32_t retryCount = 2;           // Dropped connections resume from the partial file
+    uint32_t connectTimeoutSeconds = 15;
+    bool revalidate = true;            // false serves cached copies without asking the server
+};
+
+// Concurrent HTTP downloads into an on-disk cache.
+// Transfers run the curl executable (shipped with Windows 10 and every Unix
+// desktop), one process per transfer on a pool of maxConcurrent threads, and
+// stream its output back instead of waiting for a finished file. Completed
+// bodies are stored under their content hash, and each URL keeps the ETag of
+// the body it points at: cached URLs are revalidated with If-None-Match, and
+// a partial body is resumed with a range request guarded by If-Range, so a
+// changed file restarts instead of being spliced.
+//
+//     DownloadManager downloads;
+//     auto bunny = downloads.download(url, [&](uint64_t offset, const uint8_t* data, size_t size) {
+//         // Decode incrementally; offset 0 after data means the body restarted
+//     });
+//     if (bunny.get().ok) { ... }
+//
+// Requests for a URL already in flight wait for it and are then served by
+// revalidating the cached copy.
+class DownloadManager {
+public:
+    // Body bytes in order, on a transfer thread; bytes from the cache or a partial file come first
+    using ChunkCallback = std::function<void(uint64_t offset, const uint8_t* data, size_t size)>;
+    // On the transfer thread, before the future becomes ready
+    using CompletionCallback = std::function<void(const DownloadResult& result)>;
+
+    explicit DownloadManager(const DownloadOptions& options = {});
+    // Waits for active transfers; queued ones complete with ok = false
+    ~DownloadManager();
+
+    DownloadManager(const DownloadManager&) = delete;
+    DownloadManager& operator=(const DownloadManager&) = delete;
+
+    std::future<DownloadResult> download(const std::string& url, ChunkCallback onChunk = {},
+                                         CompletionCallback onComplete = {});
+
+    // Block until nothing is queued or in flight
+    void waitIdle();
+
+private:
+    struct Transfer {
+        std::string url;
+        std::string key;  // URL hash, names the ref and partial files
+        ChunkCallback onChunk;
+        CompletionCallback onComplete;
+        std::promise<DownloadResult> promise;
+    };
+
+    void workerLoop();
+    DownloadResult run(Transfer& transfer);
+
+    DownloadOptions _options;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    std::deque<Transfer> _queue;
+    std::unordered_set<std::string> _activeKeys;
+    std::vector<std::thread> _threads;
+    bool _stopping = false;
+};
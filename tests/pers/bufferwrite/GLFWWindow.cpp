@@ -85,6 +85,18 @@ void GLFWWindow::pollEvents() {
     glfwPollEvents();
 }
 
+void GLFWWindow::waitEvents(double timeoutSeconds) {
+    if (timeoutSeconds < 0.0) {
+        glfwWaitEvents();
+    } else {
+        glfwWaitEventsTimeout(timeoutSeconds);
+    }
+}
+
+void GLFWWindow::postEmptyEvent() {
+    glfwPostEmptyEvent();
+}
+
 void GLFWWindow::setResizeCallback(ResizeCallback callback) {
     _resizeCallback = callback;
 }
@@ -21,6 +21,8 @@ public:
     void setShouldClose(bool shouldClose) override;
     
     void pollEvents() override;
+    void waitEvents(double timeoutSeconds) override;
+    void postEmptyEvent() override;
     void setResizeCallback(ResizeCallback callback) override;
     void setKeyCallback(KeyCallback callback) override;
     void setRefreshCallback(RefreshCallback callback) override;
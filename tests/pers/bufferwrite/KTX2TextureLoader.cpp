@@ -0,0 +1,341 @@
+#include "KTX2TextureLoader.h"
+#include "MappedFile.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/ITexture.h"
+#include "pers/graphics/TextureFormatSelector.h"
+#include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+constexpr uint64_t KTX2_HEADER_SIZE = 80;  // Identifier, header and index, level index follows
+constexpr uint64_t KTX2_LEVEL_INDEX_ENTRY_SIZE = 24;
+
+// Supercompression schemes
+constexpr uint32_t KTX2_SUPERCOMPRESSION_NONE = 0;
+constexpr uint32_t KTX2_SUPERCOMPRESSION_BASISLZ = 1;
+
+// Data format descriptor values
+constexpr uint8_t KHR_DF_MODEL_ETC1S = 163;
+constexpr uint8_t KHR_DF_MODEL_UASTC = 166;
+constexpr uint8_t KHR_DF_TRANSFER_SRGB = 2;
+
+uint32_t readU32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint64_t readU64(const uint8_t* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+} // anonymous namespace
+
+bool KTX2TextureLoader::parse(const uint8_t* data, uint64_t size, KTX2Image& outImage) {
+    if (!data || size < KTX2_HEADER_SIZE || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0) {
+        LOG_ERROR("KTX2TextureLoader", "Not a KTX2 file");
+        return false;
+    }
+
+    KTX2Image image;
+    image.fileData = data;
+    image.fileSize = size;
+    image.vkFormat = readU32(data + 12);
+    image.width = readU32(data + 20);
+    image.height = std::max(1u, readU32(data + 24));
+    uint32_t depth = readU32(data + 28);
+    image.layerCount = std::max(1u, readU32(data + 32));
+    image.faceCount = readU32(data + 36);
+    image.levelCount = std::max(1u, readU32(data + 40));  // 0 asks the loader to generate mips
+    image.supercompressionScheme = readU32(data + 44);
+
+    if (image.width == 0 || depth > 1 || (image.faceCount != 1 && image.faceCount != 6)) {
+        LOG_ERROR("KTX2TextureLoader", "Only 2D, array and cube textures are supported");
+        return false;
+    }
+
+    if (KTX2_HEADER_SIZE + image.levelCount * KTX2_LEVEL_INDEX_ENTRY_SIZE > size) {
+        LOG_ERROR("KTX2TextureLoader", "Truncated level index");
+        return false;
+    }
+
+    image.levels.resize(image.levelCount);
+    for (uint32_t level = 0; level < image.levelCount; ++level) {
+        const uint8_t* entry = data + KTX2_HEADER_SIZE + level * KTX2_LEVEL_INDEX_ENTRY_SIZE;
+        KTX2Level& info = image.levels[level];
+        info.byteOffset = readU64(entry);
+        info.byteLength = readU64(entry + 8);
+        info.uncompressedByteLength = readU64(entry + 16);
+        if (info.byteOffset > size || info.byteLength > size - info.byteOffset) {
+            LOG_ERROR("KTX2TextureLoader", "Level data outside of file");
+            return false;
+        }
+    }
+
+    // Basic data format descriptor: color model and transfer function
+    uint32_t dfdOffset = readU32(data + 48);
+    uint32_t dfdLength = readU32(data + 52);
+    if (dfdLength >= 16 && static_cast<uint64_t>(dfdOffset) + dfdLength <= size) {
+        uint8_t colorModel = data[dfdOffset + 12];
+        image.srgb = data[dfdOffset + 14] == KHR_DF_TRANSFER_SRGB;
+        image.basis = colorModel == KHR_DF_MODEL_ETC1S || colorModel == KHR_DF_MODEL_UASTC;
+    }
+    image.basis = image.basis || image.supercompressionScheme == KTX2_SUPERCOMPRESSION_BASISLZ;
+
+    if (!image.basis) {
+        if (image.supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE) {
+            LOG_ERROR("KTX2TextureLoader", "Zstd/zlib supercompressed files are not supported");
+            return false;
+        }
+        image.format = convertVkFormat(image.vkFormat);
+        if (image.format == pers::TextureFormat::Undefined) {
+            LOG_ERROR("KTX2TextureLoader", "Unsupported vkFormat " + std::to_string(image.vkFormat));
+            return false;
+        }
+    }
+
+    outImage = std::move(image);
+    return true;
+}
+
+std::shared_ptr<pers::ITexture> KTX2TextureLoader::loadTexture(
+    const std::string& filepath,
+    const std::shared_ptr<pers::ILogicalDevice>& device,
+    const KTX2LoadOptions& options) {
+
+    if (!device) {
+        LOG_ERROR("KTX2TextureLoader", "Device is null");
+        return nullptr;
+    }
+
+    const auto& factory = device->getResourceFactory();
+    const auto& stagingPool = device->getStagingBufferPool();
+    auto queue = device->getQueue();
+    auto physicalDevice = device->getPhysicalDevice();
+    if (!factory || !stagingPool || !queue || !physicalDevice) {
+        LOG_ERROR("KTX2TextureLoader", "Device is missing its factory, staging pool or queue");
+        return nullptr;
+    }
+
+    MappedFile file;
+    if (!file.open(filepath)) {
+        LOG_ERROR("KTX2TextureLoader", "Failed to map file: " + filepath);
+        return nullptr;
+    }
+
+    KTX2Image image;
+    if (!parse(file.data(), file.size(), image)) {
+        LOG_ERROR("KTX2TextureLoader", "Failed to parse: " + filepath);
+        return nullptr;
+    }
+
+    pers::TextureFormatSelector selector(physicalDevice->getCapabilities());
+    pers::TextureFormat format = image.format;
+    if (image.basis) {
+        if (!options.transcoder) {
+            LOG_ERROR("KTX2TextureLoader", "Basis payload needs a transcoder: " + filepath);
+            return nullptr;
+        }
+        format = options.transcodeTarget != pers::TextureFormat::Undefined
+               ? options.transcodeTarget
+               : selector.select(pers::TextureContent::ColorAlpha, image.srgb);
+    }
+
+    if (!selector.isSupported(format)) {
+        LOG_ERROR("KTX2TextureLoader", "Adapter does not support the block format of: " + filepath);
+        return nullptr;
+    }
+
+    const pers::TextureFormatBlockInfo block = pers::getTextureFormatBlockInfo(format);
+    const uint32_t imageCount = image.layerCount * image.faceCount;
+
+    pers::TextureDesc textureDesc;
+    textureDesc.width = image.width;
+    textureDesc.height = image.height;
+    textureDesc.depthOrArrayLayers = imageCount;
+    textureDesc.mipLevelCount = image.levelCount;
+    textureDesc.format = format;
+    textureDesc.usage = pers::TextureUsage::TextureBinding | pers::TextureUsage::CopyDst;
+    textureDesc.label = filepath;
+
+    auto texture = factory->createTexture(textureDesc);
+    if (!texture) {
+        LOG_ERROR("KTX2TextureLoader", "Failed to create texture for: " + filepath);
+        return nullptr;
+    }
+
+    auto commandEncoder = device->createCommandEncoder();
+    if (!commandEncoder) {
+        LOG_ERROR("KTX2TextureLoader", "Failed to create command encoder for texture upload");
+        return nullptr;
+    }
+
+    // Staging buffers go back to the pool once the copies are submitted
+    std::vector<std::shared_ptr<pers::ImmediateStagingBuffer>> stagingBuffers;
+
+    for (uint32_t level = 0; level < image.levelCount; ++level) {
+        uint32_t width = std::max(1u, image.width >> level);
+        uint32_t height = std::max(1u, image.height >> level);
+        uint32_t blocksWide = (width + block.blockWidth - 1) / block.blockWidth;
+        uint32_t blocksHigh = (height + block.blockHeight - 1) / block.blockHeight;
+        uint64_t rowBytes = static_cast<uint64_t>(blocksWide) * block.blockBytes;
+        uint32_t rowPitch = pers::getTextureReadbackRowPitch(format, width);
+        uint64_t imagePitch = static_cast<uint64_t>(rowPitch) * blocksHigh;
+
+        auto stagingBuffer = std::make_shared<pers::ImmediateStagingBuffer>();
+        if (!stagingBuffer->create(imagePitch * imageCount, stagingPool, "KTX2LevelStagingBuffer")) {
+            LOG_ERROR("KTX2TextureLoader", "Failed to create level staging buffer");
+            return nullptr;
+        }
+
+        const KTX2Level& source = image.levels[level];
+        const uint8_t* levelData = image.fileData + source.byteOffset;
+
+        if (image.basis) {
+            auto* dst = static_cast<uint8_t*>(stagingBuffer->getMappedData());
+            if (!dst || !options.transcoder(image, level, format, dst, rowPitch, blocksHigh * imageCount)) {
+                LOG_ERROR("KTX2TextureLoader", "Basis transcoding failed for level " + std::to_string(level));
+                return nullptr;
+            }
+        } else {
+            if (source.byteLength < rowBytes * blocksHigh * imageCount) {
+                LOG_ERROR("KTX2TextureLoader", "Level " + std::to_string(level) + " is smaller than its extent");
+                return nullptr;
+            }
+
+            // KTX2 rows are tightly packed, texture copies need 256-byte row pitches
+            if (rowBytes == rowPitch) {
+                stagingBuffer->writeBytes(levelData, imagePitch * imageCount, 0);
+            } else {
+                for (uint64_t row = 0; row < static_cast<uint64_t>(blocksHigh) * imageCount; ++row) {
+                    stagingBuffer->writeBytes(levelData + row * rowBytes, rowBytes, row * rowPitch);
+                }
+            }
+        }
+        stagingBuffer->finalize();
+
+        for (uint32_t layer = 0; layer < imageCount; ++layer) {
+            pers::TextureUploadDesc uploadDesc;
+            uploadDesc.mipLevel = level;
+            uploadDesc.arrayLayer = layer;
+            uploadDesc.bufferOffset = imagePitch * layer;
+            uploadDesc.bytesPerRow = rowPitch;
+            if (!commandEncoder->uploadToTexture(stagingBuffer, texture, uploadDesc)) {
+                LOG_ERROR("KTX2TextureLoader", "Failed to record upload of level " + std::to_string(level));
+                return nullptr;
+            }
+        }
+
+        stagingBuffers.push_back(std::move(stagingBuffer));
+    }
+
+    auto commandBuffer = commandEncoder->finish();
+    if (!commandBuffer) {
+        LOG_ERROR("KTX2TextureLoader", "Failed to finish texture upload command");
+        return nullptr;
+    }
+
+    queue->submit(commandBuffer);
+
+    for (auto& stagingBuffer : stagingBuffers) {
+        stagingBuffer->destroy();
+    }
+
+    return texture;
+}
+
+pers::TextureFormat KTX2TextureLoader::convertVkFormat(uint32_t vkFormat) {
+    using pers::TextureFormat;
+    switch (vkFormat) {
+        case 9: return TextureFormat::R8Unorm;
+        case 10: return TextureFormat::R8Snorm;
+        case 16: return TextureFormat::RG8Unorm;
+        case 17: return TextureFormat::RG8Snorm;
+        case 37: return TextureFormat::RGBA8Unorm;
+        case 38: return TextureFormat::RGBA8Snorm;
+        case 43: return TextureFormat::RGBA8UnormSrgb;
+        case 44: return TextureFormat::BGRA8Unorm;
+        case 50: return TextureFormat::BGRA8UnormSrgb;
+        case 64: return TextureFormat::RGB10A2Unorm;          // A2B10G10R10_UNORM_PACK32
+        case 76: return TextureFormat::R16Float;
+        case 83: return TextureFormat::RG16Float;
+        case 97: return TextureFormat::RGBA16Float;
+        case 100: return TextureFormat::R32Float;
+        case 103: return TextureFormat::RG32Float;
+        case 109: return TextureFormat::RGBA32Float;
+        case 122: return TextureFormat::RG11B10Ufloat;        // B10G11R11_UFLOAT_PACK32
+        case 123: return TextureFormat::RGB9E5Ufloat;         // E5B9G9R9_UFLOAT_PACK32
+
+        // BC
+        case 133: return TextureFormat::BC1RGBAUnorm;
+        case 134: return TextureFormat::BC1RGBAUnormSrgb;
+        case 135: return TextureFormat::BC2RGBAUnorm;
+        case 136: return TextureFormat::BC2RGBAUnormSrgb;
+        case 137: return TextureFormat::BC3RGBAUnorm;
+        case 138: return TextureFormat::BC3RGBAUnormSrgb;
+        case 139: return TextureFormat::BC4RUnorm;
+        case 140: return TextureFormat::BC4RSnorm;
+        case 141: return TextureFormat::BC5RGUnorm;
+        case 142: return TextureFormat::BC5RGSnorm;
+        case 143: return TextureFormat::BC6HRGBUfloat;
+        case 144: return TextureFormat::BC6HRGBFloat;
+        case 145: return TextureFormat::BC7RGBAUnorm;
+        case 146: return TextureFormat::BC7RGBAUnormSrgb;
+
+        // ETC2/EAC
+        case 147: return TextureFormat::ETC2RGB8Unorm;
+        case 148: return TextureFormat::ETC2RGB8UnormSrgb;
+        case 149: return TextureFormat::ETC2RGB8A1Unorm;
+        case 150: return TextureFormat::ETC2RGB8A1UnormSrgb;
+        case 151: return TextureFormat::ETC2RGBA8Unorm;
+        case 152: return TextureFormat::ETC2RGBA8UnormSrgb;
+        case 153: return TextureFormat::EACR11Unorm;
+        case 154: return TextureFormat::EACR11Snorm;
+        case 155: return TextureFormat::EACRG11Unorm;
+        case 156: return TextureFormat::EACRG11Snorm;
+
+        // ASTC LDR, unorm/srgb pairs in footprint order
+        case 157: return TextureFormat::ASTC4x4Unorm;
+        case 158: return TextureFormat::ASTC4x4UnormSrgb;
+        case 159: return TextureFormat::ASTC5x4Unorm;
+        case 160: return TextureFormat::ASTC5x4UnormSrgb;
+        case 161: return TextureFormat::ASTC5x5Unorm;
+        case 162: return TextureFormat::ASTC5x5UnormSrgb;
+        case 163: return TextureFormat::ASTC6x5Unorm;
+        case 164: return TextureFormat::ASTC6x5UnormSrgb;
+        case 165: return TextureFormat::ASTC6x6Unorm;
+        case 166: return TextureFormat::ASTC6x6UnormSrgb;
+        case 167: return TextureFormat::ASTC8x5Unorm;
+        case 168: return TextureFormat::ASTC8x5UnormSrgb;
+        case 169: return TextureFormat::ASTC8x6Unorm;
+        case 170: return TextureFormat::ASTC8x6UnormSrgb;
+        case 171: return TextureFormat::ASTC8x8Unorm;
+        case 172: return TextureFormat::ASTC8x8UnormSrgb;
+        case 173: return TextureFormat::ASTC10x5Unorm;
+        case 174: return TextureFormat::ASTC10x5UnormSrgb;
+        case 175: return TextureFormat::ASTC10x6Unorm;
+        case 176: return TextureFormat::ASTC10x6UnormSrgb;
+        case 177: return TextureFormat::ASTC10x8Unorm;
+        case 178: return TextureFormat::ASTC10x8UnormSrgb;
+        case 179: return TextureFormat::ASTC10x10Unorm;
+        case 180: return TextureFormat::ASTC10x10UnormSrgb;
+        case 181: return TextureFormat::ASTC12x10Unorm;
+        case 182: return TextureFormat::ASTC12x10UnormSrgb;
+        case 183: return TextureFormat::ASTC12x12Unorm;
+        case 184: return TextureFormat::ASTC12x12UnormSrgb;
+
+        default: return TextureFormat::Undefined;
+    }
+}
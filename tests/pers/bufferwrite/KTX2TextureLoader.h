@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "pers/graphics/GraphicsFormats.h"
+
+namespace pers {
+    class ILogicalDevice;
+    class ITexture;
+}
+
+struct KTX2Level {
+    uint64_t byteOffset = 0;
+    uint64_t byteLength = 0;
+    uint64_t uncompressedByteLength = 0;
+};
+
+// Parsed KTX2 header; level data stays in the mapped file
+struct KTX2Image {
+    uint32_t vkFormat = 0;
+    pers::TextureFormat format = pers::TextureFormat::Undefined;  // Undefined for Basis payloads
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t layerCount = 1;    // Array layers, at least 1
+    uint32_t faceCount = 1;     // 6 for cube maps
+    uint32_t levelCount = 1;    // Levels stored in the file
+    uint32_t supercompressionScheme = 0;
+    bool srgb = false;          // Transfer function from the data format descriptor
+    bool basis = false;         // BasisLZ/ETC1S or UASTC, needs transcoding
+    std::vector<KTX2Level> levels;
+
+    const uint8_t* fileData = nullptr;
+    uint64_t fileSize = 0;
+};
+
+// Transcodes one Basis level (all layers and faces) straight into the staging buffer.
+// dst holds one image after another, each image rowCount rows of dstRowPitch bytes.
+using BasisTranscodeFunction = std::function<bool(const KTX2Image& image, uint32_t level,
+                                                  pers::TextureFormat target,
+                                                  uint8_t* dst, uint32_t dstRowPitch, uint32_t rowCount)>;
+
+struct KTX2LoadOptions {
+    // Basis payloads only; Undefined picks the best block format the adapter supports
+    pers::TextureFormat transcodeTarget = pers::TextureFormat::Undefined;
+    BasisTranscodeFunction transcoder;  // Required for Basis payloads, e.g. backed by basisu
+};
+
+class KTX2TextureLoader {
+public:
+    // Parse the header and level index of a mapped KTX2 file
+    static bool parse(const uint8_t* data, uint64_t size, KTX2Image& outImage);
+
+    // Map the file and upload every level through the device's staging pool.
+    // Level data is copied once, from the mapping into each staging buffer.
+    static std::shared_ptr<pers::ITexture> loadTexture(
+        const std::string& filepath,
+        const std::shared_ptr<pers::ILogicalDevice>& device,
+        const KTX2LoadOptions& options = {}
+    );
+
+    // Vulkan format of a KTX2 file to TextureFormat, Undefined if unsupported
+    static pers::TextureFormat convertVkFormat(uint32_t vkFormat);
+};
@@ -0,0 +1,18 @@
+#include "LODSelector.h"
+#include <algorithm>
+
+float LODSelector::projectError(float error, const LODSelectParams& params) {
+    // Objects at or behind the near plane get full detail
+    const float distance = std::max(params.distance, 1e-4f);
+    return error * params.worldScale / distance * params.projectionScale * params.viewportHeight * 0.5f;
+}
+
+uint32_t LODSelector::select(const std::vector<MeshData::LOD>& lods, const LODSelectParams& params) {
+    // Errors grow with the level, so scan from the coarsest end
+    for (size_t i = lods.size(); i-- > 1;) {
+        if (projectError(lods[i].error, params) <= params.maxPixelError) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    return 0;
+}
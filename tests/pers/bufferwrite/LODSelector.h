@@ -0,0 +1,23 @@
+#pragma once
+
+#include "ResourceLoader.h"
+#include <cstdint>
+#include <vector>
+
+struct LODSelectParams {
+    float distance = 1.0f;           // Camera to object, in world units
+    float worldScale = 1.0f;         // Mesh units to world units
+    float projectionScale = 1.0f;    // cot(fovY / 2), the projection's y scale
+    float viewportHeight = 600.0f;   // In pixels
+    float maxPixelError = 1.0f;      // Largest acceptable on-screen deviation
+};
+
+// Picks a level of detail per draw from the projected screen-space error
+class LODSelector {
+public:
+    // On-screen size in pixels of a mesh-space deviation at the given distance
+    static float projectError(float error, const LODSelectParams& params);
+    
+    // Coarsest LOD whose error stays within maxPixelError; 0 if lods is empty
+    static uint32_t select(const std::vector<MeshData::LOD>& lods, const LODSelectParams& params);
+};
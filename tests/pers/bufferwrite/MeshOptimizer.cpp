@@ -0,0 +1,390 @@
+#include "MeshOptimizer.h"
+#include "ResourceLoader.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+// Triangles using each vertex, as offsets into one flat array
+struct TriangleAdjacency {
+    std::vector<uint32_t> offsets;    // vertexCount + 1 entries
+    std::vector<uint32_t> triangles;
+    
+    TriangleAdjacency(const uint32_t* indices, size_t indexCount, size_t vertexCount)
+        : offsets(vertexCount + 1, 0)
+        , triangles(indexCount) {
+        for (size_t i = 0; i < indexCount; ++i) {
+            ++offsets[indices[i] + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < indexCount; ++i) {
+            triangles[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+};
+
+} // anonymous namespace
+
+void MeshOptimizer::optimize(MeshData& mesh, const MeshOptimizeOptions& options) {
+    if (mesh.indices.empty() || mesh.vertexStride == 0) {
+        return;
+    }
+    
+    const size_t vertexCount = mesh.vertices.size() * sizeof(float) / mesh.vertexStride;
+    const float acmrBefore = computeACMR(mesh.indices.data(), mesh.indices.size(), vertexCount, options.cacheSize);
+    
+    // Submeshes are drawn on their own, keep each one's triangles together
+    std::vector<MeshData::SubMesh> ranges = mesh.submeshes;
+    if (ranges.empty()) {
+        ranges.push_back({0, static_cast<uint32_t>(mesh.indices.size())});
+    }
+    
+    std::vector<uint32_t> clusterStarts;
+    for (const auto& range : ranges) {
+        uint32_t* indices = mesh.indices.data() + range.firstIndex;
+        optimizeVertexCache(indices, range.indexCount, vertexCount, options.cacheSize,
+                            options.reorderForOverdraw ? &clusterStarts : nullptr);
+        if (options.reorderForOverdraw) {
+            optimizeOverdraw(indices, range.indexCount, clusterStarts,
+                             mesh.vertices.data(), mesh.vertexStride, mesh.positionOffset);
+        }
+    }
+    
+    if (options.remapVertexFetch) {
+        optimizeVertexFetch(mesh);
+    }
+    
+    const size_t newVertexCount = mesh.vertices.size() * sizeof(float) / mesh.vertexStride;
+    const float acmrAfter = computeACMR(mesh.indices.data(), mesh.indices.size(), newVertexCount, options.cacheSize);
+    pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "MeshOptimizer", PERS_SOURCE_LOC,
+        "ACMR %.3f -> %.3f (cache size %u)", acmrBefore, acmrAfter, options.cacheSize);
+}
+
+void MeshOptimizer::optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                        uint32_t cacheSize, std::vector<uint32_t>* clusterStarts) {
+    if (clusterStarts) {
+        clusterStarts->clear();
+    }
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0 || vertexCount == 0) {
+        return;
+    }
+    
+    TriangleAdjacency adjacency(indices, indexCount, vertexCount);
+    
+    std::vector<uint32_t> liveTriangles(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        liveTriangles[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+    }
+    
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;  // Recently used vertices, candidates after a dead end
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> output;
+    output.reserve(indexCount);
+    
+    uint32_t timestamp = cacheSize + 1;
+    size_t scanCursor = 0;  // Next vertex to try when the dead-end stack runs dry
+    
+    // Fan from the first referenced vertex
+    int64_t fanning = -1;
+    for (size_t v = 0; v < vertexCount && fanning < 0; ++v) {
+        if (liveTriangles[v] > 0) {
+            fanning = static_cast<int64_t>(v);
+        }
+    }
+    if (clusterStarts) {
+        clusterStarts->push_back(0);
+    }
+    
+    while (fanning >= 0) {
+        candidates.clear();
+        const uint32_t f = static_cast<uint32_t>(fanning);
+        for (uint32_t a = adjacency.offsets[f]; a < adjacency.offsets[f + 1]; ++a) {
+            const uint32_t t = adjacency.triangles[a];
+            if (emitted[t]) {
+                continue;
+            }
+            for (uint32_t k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                output.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                --liveTriangles[v];
+                if (timestamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timestamp++;
+                }
+            }
+            emitted[t] = true;
+        }
+        
+        // Prefer the candidate that stays in cache while its remaining triangles are emitted
+        int64_t next = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = timestamp - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+        
+        if (next < 0) {
+            // Dead end: restart from a recent vertex, else scan for any live one
+            while (!deadEnd.empty() && next < 0) {
+                const uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveTriangles[v] > 0) {
+                    next = v;
+                }
+            }
+            while (next < 0 && scanCursor < vertexCount) {
+                if (liveTriangles[scanCursor] > 0) {
+                    next = static_cast<int64_t>(scanCursor);
+                }
+                ++scanCursor;
+            }
+            if (next >= 0 && clusterStarts) {
+                clusterStarts->push_back(static_cast<uint32_t>(output.size() / 3));
+            }
+        }
+        
+        fanning = next;
+    }
+    
+    std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+void MeshOptimizer::optimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<uint32_t>& clusterStarts,
+                                     const float* vertices, size_t vertexStride, size_t positionOffset) {
+    const size_t triangleCount = indexCount / 3;
+    if (clusterStarts.size() < 2 || triangleCount == 0) {
+        return;
+    }
+    
+    const size_t floatsPerVertex = vertexStride / sizeof(float);
+    const size_t positionIndex = positionOffset / sizeof(float);
+    auto position = [&](uint32_t v) { return vertices + v * floatsPerVertex + positionIndex; };
+    
+    struct Cluster {
+        uint32_t firstTriangle;
+        uint32_t triangleCount;
+        float centroid[3];
+        float normal[3];
+        float sortKey;
+    };
+    
+    std::vector<Cluster> clusters(clusterStarts.size());
+    float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+    
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        Cluster& cluster = clusters[c];
+        cluster.firstTriangle = clusterStarts[c];
+        const uint32_t end = c + 1 < clusters.size() ? clusterStarts[c + 1] : static_cast<uint32_t>(triangleCount);
+        cluster.triangleCount = end - cluster.firstTriangle;
+        
+        // Area-weighted centroid and normal
+        float area = 0.0f;
+        float centroid[3] = {0.0f, 0.0f, 0.0f};
+        float normal[3] = {0.0f, 0.0f, 0.0f};
+        for (uint32_t t = cluster.firstTriangle; t < end; ++t) {
+            const float* p0 = position(indices[t * 3 + 0]);
+            const float* p1 = position(indices[t * 3 + 1]);
+            const float* p2 = position(indices[t * 3 + 2]);
+            const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            const float n[3] = {e1[1] * e2[2] - e1[2] * e2[1],
+                                e1[2] * e2[0] - e1[0] * e2[2],
+                                e1[0] * e2[1] - e1[1] * e2[0]};
+            const float a = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                centroid[k] += (p0[k] + p1[k] + p2[k]) * (a / 3.0f);
+                normal[k] += n[k];
+            }
+            area += a;
+        }
+        
+        const float invArea = area > 0.0f ? 1.0f / area : 0.0f;
+        const float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        const float invNormal = normalLength > 0.0f ? 1.0f / normalLength : 0.0f;
+        for (int k = 0; k < 3; ++k) {
+            cluster.centroid[k] = centroid[k] * invArea;
+            cluster.normal[k] = normal[k] * invNormal;
+            meshCentroid[k] += centroid[k];
+        }
+        meshArea += area;
+    }
+    
+    if (meshArea <= 0.0f) {
+        return;
+    }
+    for (int k = 0; k < 3; ++k) {
+        meshCentroid[k] /= meshArea;
+    }
+    
+    for (Cluster& cluster : clusters) {
+        cluster.sortKey = (cluster.centroid[0] - meshCentroid[0]) * cluster.normal[0] +
+                          (cluster.centroid[1] - meshCentroid[1]) * cluster.normal[1] +
+                          (cluster.centroid[2] - meshCentroid[2]) * cluster.normal[2];
+    }
+    
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+    
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+    for (const Cluster& cluster : clusters) {
+        output.insert(output.end(), indices + cluster.firstTriangle * 3,
+                      indices + (cluster.firstTriangle + cluster.triangleCount) * 3);
+    }
+    std::memcpy(indices, output.data(), output.size() * sizeof(uint32_t));
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    const size_t floatsPerVertex = mesh.vertexStride / sizeof(float);
+    const size_t vertexCount = mesh.vertices.size() / floatsPerVertex;
+    
+    constexpr uint32_t UNUSED = ~0u;
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    std::vector<float> vertices;
+    vertices.reserve(mesh.vertices.size());
+    
+    uint32_t nextVertex = 0;
+    for (uint32_t& index : mesh.indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = nextVertex++;
+            const float* src = mesh.vertices.data() + index * floatsPerVertex;
+            vertices.insert(vertices.end(), src, src + floatsPerVertex);
+        }
+        index = remap[index];
+    }
+    
+    if (nextVertex < vertexCount) {
+        LOG_INFO("MeshOptimizer", "Dropped " + std::to_string(vertexCount - nextVertex) + " unreferenced vertices");
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+void MeshOptimizer::orderVerticesByLOD(MeshData& mesh) {
+    if (mesh.lods.empty() || mesh.vertexStride == 0) {
+        return;
+    }
+    const size_t floatsPerVertex = mesh.vertexStride / sizeof(float);
+    const size_t vertexCount = mesh.vertices.size() / floatsPerVertex;
+    
+    constexpr uint32_t UNUSED = ~0u;
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    std::vector<float> vertices;
+    vertices.reserve(mesh.vertices.size());
+    
+    // Levels are ordered fine to coarse; each finer level only adds vertices
+    uint32_t nextVertex = 0;
+    for (size_t lod = mesh.lods.size(); lod-- > 0;) {
+        const MeshData::LOD& level = mesh.lods[lod];
+        for (uint32_t i = level.firstIndex; i < level.firstIndex + level.indexCount; ++i) {
+            const uint32_t index = mesh.indices[i];
+            if (remap[index] == UNUSED) {
+                remap[index] = nextVertex++;
+                const float* src = mesh.vertices.data() + index * floatsPerVertex;
+                vertices.insert(vertices.end(), src, src + floatsPerVertex);
+            }
+        }
+        mesh.lods[lod].vertexCount = nextVertex;
+    }
+    
+    // Vertices no level references keep their place behind the last band
+    for (size_t index = 0; index < vertexCount; ++index) {
+        if (remap[index] == UNUSED) {
+            remap[index] = nextVertex++;
+            const float* src = mesh.vertices.data() + index * floatsPerVertex;
+            vertices.insert(vertices.end(), src, src + floatsPerVertex);
+        }
+    }
+    for (uint32_t& index : mesh.indices) {
+        index = remap[index];
+    }
+    mesh.vertices = std::move(vertices);
+}
+
+MeshletData MeshOptimizer::buildMeshlets(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                         uint32_t maxVertices, uint32_t maxTriangles) {
+    MeshletData result;
+    if (indexCount < 3 || maxVertices < 3 || maxTriangles == 0) {
+        return result;
+    }
+    // Local indices are bytes
+    maxVertices = std::min<uint32_t>(maxVertices, 256);
+    
+    std::vector<uint8_t> localIndex(vertexCount, 0);
+    std::vector<bool> localValid(vertexCount, false);
+    
+    Meshlet current;
+    auto finishMeshlet = [&]() {
+        if (current.triangleCount == 0) {
+            return;
+        }
+        for (uint32_t i = 0; i < current.vertexCount; ++i) {
+            localValid[result.vertices[current.vertexOffset + i]] = false;
+        }
+        result.meshlets.push_back(current);
+        current = Meshlet{};
+        current.vertexOffset = static_cast<uint32_t>(result.vertices.size());
+        current.triangleOffset = static_cast<uint32_t>(result.triangles.size());
+    };
+    
+    for (size_t t = 0; t + 2 < indexCount; t += 3) {
+        uint32_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            newVertices += localValid[indices[t + k]] ? 0 : 1;
+        }
+        if (current.vertexCount + newVertices > maxVertices || current.triangleCount + 1 > maxTriangles) {
+            finishMeshlet();
+        }
+        
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = indices[t + k];
+            if (!localValid[v]) {
+                localValid[v] = true;
+                localIndex[v] = static_cast<uint8_t>(current.vertexCount++);
+                result.vertices.push_back(v);
+            }
+            result.triangles.push_back(localIndex[v]);
+        }
+        ++current.triangleCount;
+    }
+    finishMeshlet();
+    
+    return result;
+}
+
+float MeshOptimizer::computeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return 0.0f;
+    }
+    
+    // FIFO cache: a vertex is resident if it entered within the last cacheSize misses
+    std::vector<uint32_t> enteredAt(vertexCount, 0);
+    uint32_t misses = 0;
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        const uint32_t v = indices[i];
+        if (enteredAt[v] == 0 || misses + 1 - enteredAt[v] > cacheSize) {
+            ++misses;
+            enteredAt[v] = misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct MeshData;
+
+struct Meshlet {
+    uint32_t vertexOffset = 0;    // Into MeshletData::vertices
+    uint32_t triangleOffset = 0;  // Into MeshletData::triangles, in bytes
+    uint32_t vertexCount = 0;
+    uint32_t triangleCount = 0;
+};
+
+struct MeshletData {
+    std::vector<Meshlet> meshlets;
+    std::vector<uint32_t> vertices;  // Mesh vertex index of each meshlet-local vertex
+    std::vector<uint8_t> triangles;  // Three meshlet-local vertex indices per triangle
+};
+
+struct MeshOptimizeOptions {
+    uint32_t cacheSize = 16;          // Post-transform cache size the ordering targets
+    bool reorderForOverdraw = true;   // Sort cache clusters outside-in after cache optimization
+    bool remapVertexFetch = true;     // Reorder vertices by first use, drops unreferenced vertices
+};
+
+// Index and vertex reordering so the GPU shades and fetches each vertex fewer times.
+// All passes are linear-time and keep triangles inside their submesh.
+class MeshOptimizer {
+public:
+    // Run the enabled passes on every submesh, then remap vertex fetch
+    static void optimize(MeshData& mesh, const MeshOptimizeOptions& options = {});
+    
+    // Tipsify (Sander et al. 2007). Reorders triangles in place for a FIFO cache.
+    // clusterStarts, when given, receives the first triangle of each run that began
+    // after a cache-miss restart; runs are the units optimizeOverdraw may reorder.
+    static void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                    uint32_t cacheSize, std::vector<uint32_t>* clusterStarts = nullptr);
+    
+    // Sort runs from optimizeVertexCache by how far they face away from the mesh
+    // center, so outer surfaces tend to draw first and occlude inner ones.
+    static void optimizeOverdraw(uint32_t* indices, size_t indexCount, const std::vector<uint32_t>& clusterStarts,
+                                 const float* vertices, size_t vertexStride, size_t positionOffset);
+    
+    // Renumber vertices in first-use order and compact the vertex array
+    static void optimizeVertexFetch(MeshData& mesh);
+    
+    // Renumber vertices coarsest LOD first, then the vertices each finer level adds,
+    // in first-use order within each band. Every level then draws from a prefix of
+    // the vertex array, recorded in MeshData::LOD::vertexCount, so it can be
+    // uploaded without the finer levels' vertices.
+    static void orderVerticesByLOD(MeshData& mesh);
+    
+    // Greedily split triangles into meshlets of bounded size
+    static MeshletData buildMeshlets(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                     uint32_t maxVertices = 64, uint32_t maxTriangles = 124);
+    
+    // Average post-transform cache misses per triangle for a FIFO of the given size
+    static float computeACMR(const uint32_t* indices, size_t indexCount, size_t vertexCount, uint32_t cacheSize);
+};
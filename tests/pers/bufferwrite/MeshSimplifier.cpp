@@ -0,0 +1,286 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include "ResourceLoader.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <queue>
+#include <unordered_map>
+
+namespace {
+
+// Symmetric 4x4 plane quadric with the total weight of planes summed into it
+struct Quadric {
+    double a00 = 0, a01 = 0, a02 = 0, a03 = 0;
+    double a11 = 0, a12 = 0, a13 = 0;
+    double a22 = 0, a23 = 0;
+    double a33 = 0;
+    double weight = 0;
+    
+    static Quadric fromPlane(double a, double b, double c, double d, double w) {
+        Quadric q;
+        q.a00 = w * a * a; q.a01 = w * a * b; q.a02 = w * a * c; q.a03 = w * a * d;
+        q.a11 = w * b * b; q.a12 = w * b * c; q.a13 = w * b * d;
+        q.a22 = w * c * c; q.a23 = w * c * d;
+        q.a33 = w * d * d;
+        q.weight = w;
+        return q;
+    }
+    
+    void add(const Quadric& q) {
+        a00 += q.a00; a01 += q.a01; a02 += q.a02; a03 += q.a03;
+        a11 += q.a11; a12 += q.a12; a13 += q.a13;
+        a22 += q.a22; a23 += q.a23;
+        a33 += q.a33;
+        weight += q.weight;
+    }
+    
+    // Weighted mean squared distance of p to the accumulated planes
+    double evaluate(const float* p) const {
+        const double x = p[0], y = p[1], z = p[2];
+        const double sum = a00 * x * x + 2 * a01 * x * y + 2 * a02 * x * z + 2 * a03 * x +
+                           a11 * y * y + 2 * a12 * y * z + 2 * a13 * y +
+                           a22 * z * z + 2 * a23 * z +
+                           a33;
+        return weight > 0 ? std::max(sum, 0.0) / weight : 0.0;
+    }
+};
+
+struct Collapse {
+    double cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromVersion;
+    uint32_t toVersion;
+    
+    bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+void cross(const float* a, const float* b, const float* c, float* out) {
+    const float e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const float e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+    out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+    out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+} // anonymous namespace
+
+MeshSimplifyResult MeshSimplifier::simplify(const uint32_t* indices, size_t indexCount,
+                                            const float* vertices, size_t vertexCount,
+                                            size_t vertexStride, size_t positionOffset,
+                                            size_t targetIndexCount, float maxError) {
+    MeshSimplifyResult result;
+    const size_t floatsPerVertex = vertexStride / sizeof(float);
+    const size_t positionIndex = positionOffset / sizeof(float);
+    auto position = [&](uint32_t v) { return vertices + v * floatsPerVertex + positionIndex; };
+    
+    std::vector<std::array<uint32_t, 3>> triangles(indexCount / 3);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        triangles[t] = {indices[t * 3 + 0], indices[t * 3 + 1], indices[t * 3 + 2]};
+    }
+    std::vector<bool> triangleAlive(triangles.size(), true);
+    size_t liveTriangles = triangles.size();
+    const size_t targetTriangles = targetIndexCount / 3;
+    
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    std::vector<Quadric> quadrics(vertexCount);
+    for (uint32_t t = 0; t < triangles.size(); ++t) {
+        const auto& tri = triangles[t];
+        float n[3];
+        cross(position(tri[0]), position(tri[1]), position(tri[2]), n);
+        const double length = std::sqrt(double(n[0]) * n[0] + double(n[1]) * n[1] + double(n[2]) * n[2]);
+        if (length > 0) {
+            const double a = n[0] / length, b = n[1] / length, c = n[2] / length;
+            const float* p = position(tri[0]);
+            const Quadric q = Quadric::fromPlane(a, b, c, -(a * p[0] + b * p[1] + c * p[2]), length * 0.5);
+            for (uint32_t v : tri) {
+                quadrics[v].add(q);
+            }
+        }
+        for (uint32_t v : tri) {
+            vertexTriangles[v].push_back(t);
+        }
+    }
+    
+    // Vertices on edges not shared by exactly two triangles never move
+    std::vector<bool> locked(vertexCount, false);
+    {
+        std::unordered_map<uint64_t, uint32_t> edgeUse;
+        edgeUse.reserve(triangles.size() * 3);
+        auto edgeKey = [](uint32_t a, uint32_t b) {
+            return (uint64_t(std::min(a, b)) << 32) | std::max(a, b);
+        };
+        for (const auto& tri : triangles) {
+            for (int k = 0; k < 3; ++k) {
+                ++edgeUse[edgeKey(tri[k], tri[(k + 1) % 3])];
+            }
+        }
+        for (const auto& [key, count] : edgeUse) {
+            if (count != 2) {
+                locked[key >> 32] = true;
+                locked[key & 0xFFFFFFFF] = true;
+            }
+        }
+    }
+    
+    std::vector<uint32_t> version(vertexCount, 0);
+    std::vector<bool> removed(vertexCount, false);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+    
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (locked[from]) {
+            return;
+        }
+        Quadric combined = quadrics[from];
+        combined.add(quadrics[to]);
+        queue.push({combined.evaluate(position(to)), from, to, version[from], version[to]});
+    };
+    
+    for (const auto& tri : triangles) {
+        for (int k = 0; k < 3; ++k) {
+            pushCollapse(tri[k], tri[(k + 1) % 3]);
+            pushCollapse(tri[(k + 1) % 3], tri[k]);
+        }
+    }
+    
+    const double maxCost = double(maxError) * double(maxError);
+    double appliedCost = 0;
+    std::vector<uint32_t> neighbors;
+    
+    while (liveTriangles > targetTriangles && !queue.empty()) {
+        const Collapse collapse = queue.top();
+        queue.pop();
+        
+        const uint32_t u = collapse.from;
+        const uint32_t v = collapse.to;
+        if (removed[u] || removed[v] || version[u] != collapse.fromVersion || version[v] != collapse.toVersion) {
+            continue;
+        }
+        if (collapse.cost > maxCost) {
+            break;
+        }
+        
+        // Reject collapses that flip a surviving triangle or leave u disconnected from v
+        bool sharesEdge = false;
+        bool flips = false;
+        for (uint32_t t : vertexTriangles[u]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+            const auto& tri = triangles[t];
+            if (tri[0] == v || tri[1] == v || tri[2] == v) {
+                sharesEdge = true;
+                continue;
+            }
+            const float* p[3];
+            const float* moved[3];
+            for (int k = 0; k < 3; ++k) {
+                p[k] = position(tri[k]);
+                moved[k] = tri[k] == u ? position(v) : p[k];
+            }
+            float before[3], after[3];
+            cross(p[0], p[1], p[2], before);
+            cross(moved[0], moved[1], moved[2], after);
+            if (before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0f) {
+                flips = true;
+                break;
+            }
+        }
+        if (!sharesEdge || flips) {
+            continue;
+        }
+        
+        for (uint32_t t : vertexTriangles[u]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+            auto& tri = triangles[t];
+            if (tri[0] == v || tri[1] == v || tri[2] == v) {
+                triangleAlive[t] = false;
+                --liveTriangles;
+                continue;
+            }
+            for (uint32_t& index : tri) {
+                if (index == u) {
+                    index = v;
+                }
+            }
+            vertexTriangles[v].push_back(t);
+        }
+        vertexTriangles[u].clear();
+        vertexTriangles[u].shrink_to_fit();
+        quadrics[v].add(quadrics[u]);
+        removed[u] = true;
+        ++version[v];
+        appliedCost = std::max(appliedCost, collapse.cost);
+        
+        // Only edges touching v changed cost; compact its triangle list while collecting neighbors
+        neighbors.clear();
+        auto& adjacent = vertexTriangles[v];
+        adjacent.erase(std::remove_if(adjacent.begin(), adjacent.end(),
+                                      [&](uint32_t t) { return !triangleAlive[t]; }),
+                       adjacent.end());
+        for (uint32_t t : adjacent) {
+            for (uint32_t n : triangles[t]) {
+                if (n != v) {
+                    neighbors.push_back(n);
+                }
+            }
+        }
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+        for (uint32_t n : neighbors) {
+            pushCollapse(v, n);
+            pushCollapse(n, v);
+        }
+    }
+    
+    result.indices.reserve(liveTriangles * 3);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        if (triangleAlive[t]) {
+            result.indices.insert(result.indices.end(), triangles[t].begin(), triangles[t].end());
+        }
+    }
+    result.error = static_cast<float>(std::sqrt(appliedCost));
+    return result;
+}
+
+void MeshSimplifier::generateLODs(MeshData& mesh, const float* ratios, size_t ratioCount, uint32_t cacheSize) {
+    mesh.lods.clear();
+    if (mesh.indices.empty() || mesh.vertexStride == 0) {
+        return;
+    }
+    
+    const size_t baseIndexCount = mesh.indices.size();
+    const size_t vertexCount = mesh.vertices.size() * sizeof(float) / mesh.vertexStride;
+    mesh.lods.push_back({0, static_cast<uint32_t>(baseIndexCount), 0.0f});
+    
+    std::vector<uint32_t> source(mesh.indices.begin(), mesh.indices.end());
+    float error = 0.0f;
+    for (size_t i = 0; i < ratioCount; ++i) {
+        const size_t target = static_cast<size_t>(baseIndexCount * ratios[i]) / 3 * 3;
+        MeshSimplifyResult lod = simplify(source.data(), source.size(), mesh.vertices.data(), vertexCount,
+                                          mesh.vertexStride, mesh.positionOffset, target);
+        
+        // Locked borders or the flip test can stall simplification
+        if (lod.indices.size() * 10 > source.size() * 9) {
+            break;
+        }
+        
+        MeshOptimizer::optimizeVertexCache(lod.indices.data(), lod.indices.size(), vertexCount, cacheSize);
+        
+        // Each level is measured against the previous one, the sum bounds the deviation from LOD 0
+        error += lod.error;
+        mesh.lods.push_back({static_cast<uint32_t>(mesh.indices.size()), static_cast<uint32_t>(lod.indices.size()), error});
+        mesh.indices.insert(mesh.indices.end(), lod.indices.begin(), lod.indices.end());
+        source = std::move(lod.indices);
+    }
+    
+    // Coarse levels then draw from a prefix of the vertices, see MeshStreamer
+    MeshOptimizer::orderVerticesByLOD(mesh);
+    
+    LOG_INFO("MeshSimplifier", "Generated " + std::to_string(mesh.lods.size()) + " LODs, coarsest " +
+        std::to_string(mesh.lods.back().indexCount / 3) + " triangles");
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct MeshData;
+
+struct MeshSimplifyResult {
+    std::vector<uint32_t> indices;
+    float error = 0.0f;  // Largest geometric deviation introduced, in mesh units
+};
+
+// Quadric error metric edge collapse (Garland & Heckbert 1997).
+// Vertices only ever collapse onto an existing neighbor, so every level of
+// detail indexes the original vertex buffer. Border and non-manifold
+// vertices stay locked to keep open edges and UV seams in place.
+class MeshSimplifier {
+public:
+    static constexpr float DEFAULT_LOD_RATIOS[] = {0.5f, 0.25f, 0.125f, 0.0625f};
+    
+    // Collapse edges until at most targetIndexCount indices remain or the next
+    // collapse would exceed maxError
+    static MeshSimplifyResult simplify(const uint32_t* indices, size_t indexCount,
+                                       const float* vertices, size_t vertexCount,
+                                       size_t vertexStride, size_t positionOffset,
+                                       size_t targetIndexCount, float maxError = 1e30f);
+    
+    // Append one LOD per ratio (of the full triangle count) to mesh.indices and
+    // record all levels in mesh.lods, LOD 0 being the full mesh. Each level is
+    // simplified from the previous one; generation stops early once a level no
+    // longer shrinks. Vertices are then ordered coarsest level first, see
+    // MeshOptimizer::orderVerticesByLOD. Expects float vertices, run before quantization.
+    static void generateLODs(MeshData& mesh, const float* ratios, size_t ratioCount,
+                             uint32_t cacheSize = 16);
+    
+    static void generateLODs(MeshData& mesh) {
+        generateLODs(mesh, DEFAULT_LOD_RATIOS, sizeof(DEFAULT_LOD_RATIOS) / sizeof(DEFAULT_LOD_RATIOS[0]));
+    }
+};
@@ -0,0 +1,304 @@
+#include "MeshStreamer.h"
+#include "MappedFile.h"
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <span>
+
+MeshStreamer::MeshStreamer(const std::shared_ptr<pers::ILogicalDevice>& device,
+                           const std::shared_ptr<pers::DeviceBufferHeap>& vertexHeap,
+                           const std::shared_ptr<pers::DeviceBufferHeap>& indexHeap)
+    : MeshStreamer(device, vertexHeap, indexHeap, Config{}) {
+}
+
+MeshStreamer::MeshStreamer(const std::shared_ptr<pers::ILogicalDevice>& device,
+                           const std::shared_ptr<pers::DeviceBufferHeap>& vertexHeap,
+                           const std::shared_ptr<pers::DeviceBufferHeap>& indexHeap,
+                           const Config& config)
+    : _device(device)
+    , _vertexHeap(vertexHeap)
+    , _indexHeap(indexHeap)
+    , _config(config) {
+    if (!device || !vertexHeap || !indexHeap) {
+        LOG_ERROR("MeshStreamer", "Created without device or heaps");
+    }
+}
+
+MeshStreamer::~MeshStreamer() {
+    for (Slot& slot : _slots) {
+        if (slot.generation & 1u) {
+            retire(slot.entry);
+        }
+    }
+}
+
+StreamedMeshHandle MeshStreamer::add(const std::string& cookedPath) {
+    Entry entry;
+    entry.path = cookedPath;
+    entry.file = std::make_unique<MappedFile>();
+    if (!ResourceLoader::mapCookedMesh(cookedPath, *entry.file, entry.layout, entry.blobs)) {
+        return {};
+    }
+
+    // Without generated levels the whole mesh is LOD 0
+    auto& lods = entry.layout.lods;
+    if (lods.empty()) {
+        lods.push_back({0, entry.blobs.indexCount, 0.0f, entry.blobs.vertexCount});
+    }
+    for (auto& lod : lods) {
+        if (lod.firstIndex + static_cast<uint64_t>(lod.indexCount) > entry.blobs.indexCount ||
+            lod.vertexCount > entry.blobs.vertexCount) {
+            LOG_WARNING("MeshStreamer", "Cooked mesh has an invalid LOD table: " + cookedPath);
+            return {};
+        }
+        if (lod.vertexCount == 0) {
+            lod.vertexCount = entry.blobs.vertexCount;  // Vertices not ordered by LOD
+        }
+    }
+    entry.coarsestLod = static_cast<uint32_t>(lods.size() - 1);
+    entry.residentLod = entry.coarsestLod;
+    entry.request = entry.coarsestLod;
+    entry.lastRequest = entry.coarsestLod;
+
+    if (_freeList.empty() && _slots.size() > StreamedMeshHandle::MAX_INDEX) {
+        LOG_ERROR("MeshStreamer", "Slot limit reached, cannot add streamed mesh");
+        return {};
+    }
+
+    if (!rebuild(entry, entry.coarsestLod)) {
+        LOG_ERROR("MeshStreamer", "Failed to upload coarsest LOD of: " + cookedPath);
+        return {};
+    }
+    entry.lastRequestFrame = _frame;
+
+    uint32_t index;
+    if (!_freeList.empty()) {
+        index = _freeList.back();
+        _freeList.pop_back();
+    } else {
+        index = static_cast<uint32_t>(_slots.size());
+        _slots.emplace_back();
+    }
+
+    Slot& slot = _slots[index];
+    slot.generation = StreamedMeshHandle::nextGeneration(slot.generation);
+    slot.entry = std::move(entry);
+    ++_stats.meshCount;
+    return StreamedMeshHandle{index, slot.generation};
+}
+
+bool MeshStreamer::remove(StreamedMeshHandle handle) {
+    Entry* entry = find(handle);
+    if (!entry) {
+        return false;
+    }
+
+    _residentBytes -= entry->residentBytes;
+    retire(*entry);
+    Slot& slot = _slots[handle.index];
+    slot.generation = StreamedMeshHandle::nextGeneration(slot.generation);
+    slot.entry = Entry{};
+    _freeList.push_back(handle.index);
+    --_stats.meshCount;
+    return true;
+}
+
+void MeshStreamer::requestLod(StreamedMeshHandle handle, uint32_t lod) {
+    Entry* entry = find(handle);
+    if (!entry) {
+        return;
+    }
+    entry->request = std::min({entry->request, lod, entry->coarsestLod});
+    entry->lastRequestFrame = _frame;
+}
+
+void MeshStreamer::update() {
+    ++_frame;
+    _stats.uploadedBytes = 0;
+    _stats.refined = 0;
+    _stats.coarsened = 0;
+    _stats.pending = 0;
+
+    struct Candidate {
+        Entry* entry;
+        uint32_t wanted;
+        uint32_t gap;  // Levels between resident and wanted
+    };
+    std::vector<Candidate> refine;
+    std::vector<Candidate> coarsen;
+
+    for (Slot& slot : _slots) {
+        if (!(slot.generation & 1u)) {
+            continue;
+        }
+        Entry& entry = slot.entry;
+        if (entry.lastRequestFrame == _frame - 1) {
+            entry.lastRequest = entry.request;
+        } else if (_frame - entry.lastRequestFrame > _config.demandTimeoutFrames) {
+            entry.lastRequest = entry.coarsestLod;
+        }
+        entry.request = entry.coarsestLod;
+
+        const uint32_t wanted = entry.lastRequest;
+        if (wanted < entry.residentLod) {
+            refine.push_back({&entry, wanted, entry.residentLod - wanted});
+        } else if (wanted > entry.residentLod) {
+            coarsen.push_back({&entry, wanted, wanted - entry.residentLod});
+        }
+    }
+
+    // Furthest from the request first, on both sides
+    auto byGap = [](const Candidate& a, const Candidate& b) { return a.gap > b.gap; };
+    std::sort(refine.begin(), refine.end(), byGap);
+    std::sort(coarsen.begin(), coarsen.end(), byGap);
+
+    size_t nextCoarsen = 0;
+    auto coarsenOne = [&] {
+        Candidate& victim = coarsen[nextCoarsen++];
+        if (rebuild(*victim.entry, victim.wanted)) {
+            _stats.uploadedBytes += victim.entry->residentBytes;
+            ++_stats.coarsened;
+        }
+    };
+
+    for (const Candidate& candidate : refine) {
+        Entry& entry = *candidate.entry;
+
+        // Go straight to the wanted level if it fits this update, else one level finer
+        uint32_t target = candidate.wanted;
+        uint64_t uploadBytes = bytesOf(entry, target);
+        const uint64_t remaining = _config.uploadBudgetPerUpdate > _stats.uploadedBytes
+                                 ? _config.uploadBudgetPerUpdate - _stats.uploadedBytes : 0;
+        if (uploadBytes > remaining) {
+            target = entry.residentLod - 1;
+            uploadBytes = bytesOf(entry, target);
+            // Always let one mesh through so large levels are never starved
+            if (uploadBytes > remaining && _stats.uploadedBytes > 0) {
+                ++_stats.pending;
+                continue;
+            }
+        }
+
+        // Make room by lowering meshes that have more detail than they need
+        const uint64_t growth = uploadBytes - entry.residentBytes;
+        while (_residentBytes + growth > _config.memoryBudget && nextCoarsen < coarsen.size()) {
+            coarsenOne();
+        }
+        if (_residentBytes + growth > _config.memoryBudget) {
+            ++_stats.pending;
+            continue;
+        }
+
+        if (rebuild(entry, target)) {
+            _stats.uploadedBytes += entry.residentBytes;
+            ++_stats.refined;
+            if (target != candidate.wanted) {
+                ++_stats.pending;
+            }
+        }
+    }
+
+    // Over budget without refinements (budget lowered, meshes added): evict the rest
+    while (_residentBytes > _config.memoryBudget && nextCoarsen < coarsen.size()) {
+        coarsenOne();
+    }
+
+    _stats.residentBytes = _residentBytes;
+}
+
+StreamedMeshDraw MeshStreamer::getDraw(StreamedMeshHandle handle) const {
+    StreamedMeshDraw draw;
+    const Entry* entry = find(handle);
+    if (!entry) {
+        return draw;
+    }
+    draw.vertexBuffer = entry->vertexView;
+    draw.indexBuffer = entry->indexView;
+    draw.indexCount = entry->layout.lods[entry->residentLod].indexCount;
+    draw.lod = entry->residentLod;
+    return draw;
+}
+
+const MeshData* MeshStreamer::getLayout(StreamedMeshHandle handle) const {
+    const Entry* entry = find(handle);
+    return entry ? &entry->layout : nullptr;
+}
+
+MeshStreamer::Entry* MeshStreamer::find(StreamedMeshHandle handle) {
+    return const_cast<Entry*>(static_cast<const MeshStreamer*>(this)->find(handle));
+}
+
+const MeshStreamer::Entry* MeshStreamer::find(StreamedMeshHandle handle) const {
+    if (handle.index >= _slots.size()) {
+        return nullptr;
+    }
+    const Slot& slot = _slots[handle.index];
+    return slot.generation == handle.generation && (slot.generation & 1u) ? &slot.entry : nullptr;
+}
+
+uint64_t MeshStreamer::bytesOf(const Entry& entry, uint32_t lod) const {
+    const MeshData::LOD& level = entry.layout.lods[lod];
+    return static_cast<uint64_t>(level.vertexCount) * entry.layout.vertexStride +
+           static_cast<uint64_t>(level.indexCount) * sizeof(uint32_t);
+}
+
+bool MeshStreamer::rebuild(Entry& entry, uint32_t lod) {
+    auto device = _device.lock();
+    if (!device || !_vertexHeap || !_indexHeap) {
+        LOG_ERROR("MeshStreamer", "Device expired or heaps missing");
+        return false;
+    }
+    auto queue = device->getQueue();
+    if (!queue) {
+        LOG_ERROR("MeshStreamer", "Device has no queue");
+        return false;
+    }
+
+    const MeshData::LOD& level = entry.layout.lods[lod];
+    const uint64_t vertexBytes = static_cast<uint64_t>(level.vertexCount) * entry.layout.vertexStride;
+    const uint64_t indexBytes = static_cast<uint64_t>(level.indexCount) * sizeof(uint32_t);
+    if (vertexBytes == 0 || indexBytes == 0) {
+        LOG_ERROR("MeshStreamer", "Empty LOD in: " + entry.path);
+        return false;
+    }
+
+    auto vertexView = _vertexHeap->allocate(vertexBytes);
+    auto indexView = _indexHeap->allocate(indexBytes);
+    if (!vertexView || !indexView) {
+        LOG_ERROR("MeshStreamer", "Heap allocation failed for: " + entry.path);
+        return false;
+    }
+
+    // The queue copies from the mapping at write time
+    const auto* vertices = reinterpret_cast<const std::byte*>(entry.blobs.vertices);
+    const auto* indices = reinterpret_cast<const std::byte*>(entry.blobs.indices + level.firstIndex);
+    if (!queue->writeBuffer(vertexView, 0, std::span(vertices, vertexBytes)) ||
+        !queue->writeBuffer(indexView, 0, std::span(indices, indexBytes))) {
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Error, "MeshStreamer", PERS_SOURCE_LOC,
+            "Failed to upload LOD %u of '%s'", lod, entry.path.c_str());
+        return false;
+    }
+
+    const uint64_t bytes = vertexBytes + indexBytes;
+    _residentBytes = _residentBytes - entry.residentBytes + bytes;
+    retire(entry);
+    entry.vertexView = std::move(vertexView);
+    entry.indexView = std::move(indexView);
+    entry.residentLod = lod;
+    entry.residentBytes = bytes;
+    return true;
+}
+
+void MeshStreamer::retire(Entry& entry) {
+    // Frames in flight may still draw the old level
+    auto device = _device.lock();
+    if (device && device->getDeletionQueue()) {
+        device->getDeletionQueue()->retire(std::move(entry.vertexView));
+        device->getDeletionQueue()->retire(std::move(entry.indexView));
+    }
+    entry.vertexView.reset();
+    entry.indexView.reset();
+}
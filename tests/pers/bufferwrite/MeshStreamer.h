@@ -0,0 +1,128 @@
+#pragma once
+
+#include "ResourceLoader.h"
+#include "pers/graphics/RenderResourceTable.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+    class DeviceBufferHeap;
+    class DeviceBufferView;
+}
+
+using StreamedMeshHandle = pers::ResourceHandle<struct StreamedMeshHandleTag>;
+
+// What to bind for the level of a streamed mesh that is resident right now
+struct StreamedMeshDraw {
+    std::shared_ptr<pers::IBuffer> vertexBuffer;  // Vertex prefix of the resident level
+    std::shared_ptr<pers::IBuffer> indexBuffer;   // That level's indices only, draw from index 0
+    uint32_t indexCount = 0;
+    uint32_t lod = 0;
+};
+
+// Streams the LODs of cooked meshes into device buffer heaps, coarse to fine.
+// add() maps the cooked file and uploads only its coarsest level, so the mesh
+// can be drawn right away. Each frame callers request the level they would
+// like to draw (see LODSelector); update() then refines the meshes furthest
+// from their request first, within a per-update upload budget, and coarsens
+// meshes that no longer need their detail when the memory budget is exceeded.
+// Meshes not requested for a while fall back to their coarsest level.
+//
+// MeshSimplifier orders vertices coarsest level first, so each level needs
+// only a prefix of the vertex blob (MeshData::LOD::vertexCount). A resident
+// level is one vertex view sized to that prefix plus one index view holding
+// just its indices; changing level allocates new views, writes them from the
+// mapping and retires the old ones through the device's DeferredDeletionQueue,
+// so frames in flight keep drawing the previous level. Meshes cooked without
+// ordered vertices still stream their indices, with the whole vertex blob.
+class MeshStreamer {
+public:
+    struct Config {
+        uint64_t memoryBudget = 256ull * 1024 * 1024;         // Resident vertex and index bytes, all meshes
+        uint64_t uploadBudgetPerUpdate = 8ull * 1024 * 1024;
+        uint32_t demandTimeoutFrames = 120;  // Updates without a request before a mesh drops to its coarsest level
+    };
+
+    struct Stats {
+        uint32_t meshCount = 0;
+        uint64_t residentBytes = 0;
+        uint64_t uploadedBytes = 0;  // During the last update()
+        uint32_t refined = 0;        // Meshes given a finer level in the last update()
+        uint32_t coarsened = 0;      // Meshes lowered to free memory in the last update()
+        uint32_t pending = 0;        // Meshes still coarser than requested
+    };
+
+    // Heaps need Vertex and Index usage respectively
+    MeshStreamer(const std::shared_ptr<pers::ILogicalDevice>& device,
+                 const std::shared_ptr<pers::DeviceBufferHeap>& vertexHeap,
+                 const std::shared_ptr<pers::DeviceBufferHeap>& indexHeap);
+    MeshStreamer(const std::shared_ptr<pers::ILogicalDevice>& device,
+                 const std::shared_ptr<pers::DeviceBufferHeap>& vertexHeap,
+                 const std::shared_ptr<pers::DeviceBufferHeap>& indexHeap,
+                 const Config& config);
+    ~MeshStreamer();
+
+    MeshStreamer(const MeshStreamer&) = delete;
+    MeshStreamer& operator=(const MeshStreamer&) = delete;
+
+    // Map a cooked mesh and upload its coarsest level; null handle on failure.
+    // The file stays mapped until remove() since every refinement reads from it.
+    StreamedMeshHandle add(const std::string& cookedPath);
+
+    bool remove(StreamedMeshHandle handle);
+
+    // Level the caller would like to draw this frame; the finest request per update wins
+    void requestLod(StreamedMeshHandle handle, uint32_t lod);
+
+    // Apply requests: upload finer levels and evict within the budgets
+    void update();
+
+    StreamedMeshDraw getDraw(StreamedMeshHandle handle) const;
+
+    // Stride, formats, bounds and the full LOD table; vertices and indices are empty
+    const MeshData* getLayout(StreamedMeshHandle handle) const;
+
+    const Config& getConfig() const { return _config; }
+    void setConfig(const Config& config) { _config = config; }
+    Stats getStats() const { return _stats; }
+
+private:
+    struct Entry {
+        std::string path;
+        std::unique_ptr<MappedFile> file;
+        MeshData layout;
+        CookedMeshBlobs blobs;
+        std::shared_ptr<pers::DeviceBufferView> vertexView;
+        std::shared_ptr<pers::DeviceBufferView> indexView;
+        uint32_t residentLod = 0;
+        uint32_t coarsestLod = 0;
+        uint64_t residentBytes = 0;
+        uint32_t request = 0;        // Finest level requested since the last update, coarsestLod if none
+        uint32_t lastRequest = 0;
+        uint64_t lastRequestFrame = 0;
+    };
+
+    struct Slot {
+        uint32_t generation = 0;  // Odd = live
+        Entry entry;
+    };
+
+    Entry* find(StreamedMeshHandle handle);
+    const Entry* find(StreamedMeshHandle handle) const;
+
+    uint64_t bytesOf(const Entry& entry, uint32_t lod) const;
+    bool rebuild(Entry& entry, uint32_t lod);
+    void retire(Entry& entry);
+
+    std::weak_ptr<pers::ILogicalDevice> _device;
+    std::shared_ptr<pers::DeviceBufferHeap> _vertexHeap;
+    std::shared_ptr<pers::DeviceBufferHeap> _indexHeap;
+    Config _config;
+    std::vector<Slot> _slots;
+    std::vector<uint32_t> _freeList;
+    uint64_t _frame = 0;
+    uint64_t _residentBytes = 0;
+    Stats _stats;
+};
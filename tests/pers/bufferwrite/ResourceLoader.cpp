@@ -1,12 +1,17 @@
 #include "ResourceLoader.h"
+#include "DownloadManager.h"
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
 #include "pers/graphics/ILogicalDevice.h"
 #include "pers/graphics/IResourceFactory.h"
 #include "pers/graphics/IQueue.h"
 #include "pers/graphics/ICommandEncoder.h"
 #include "pers/graphics/buffers/IBuffer.h"
 #include "pers/graphics/buffers/ImmediateStagingBuffer.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
 #include "pers/graphics/buffers/DeviceBuffer.h"
 #include "pers/graphics/buffers/DeviceBufferUsage.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
 #include "pers/utils/Logger.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -14,14 +19,159 @@
 #include <fstream>
 #include <filesystem>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 
-#ifdef _WIN32
-#define NOMINMAX  // Prevent Windows.h from defining min/max macros
-#include <windows.h>
-#include <urlmon.h>
-#pragma comment(lib, "urlmon.lib")
-#endif
+namespace {
+
+// Import options shared by file and memory imports
+constexpr unsigned int MESH_IMPORT_FLAGS =
+    aiProcess_Triangulate |               // Convert to triangles
+    aiProcess_JoinIdenticalVertices |     // Optimize vertices
+    aiProcess_GenSmoothNormals |          // Generate normals if missing
+    aiProcess_CalcTangentSpace |          // Calculate tangents
+    aiProcess_OptimizeMeshes |            // Optimize mesh
+    aiProcess_PreTransformVertices;       // Apply node transformations
+
+// Cooked mesh file: header, submesh table, LOD table, vertex blob, index blob (Uint32).
+// Blobs are in GPU layout and 16-byte aligned so they upload from the mapping.
+constexpr uint32_t COOKED_MESH_MAGIC = 0x48534D50;  // "PMSH"
+constexpr uint32_t COOKED_MESH_VERSION = 4;
+constexpr uint64_t COOKED_MESH_ALIGNMENT = 16;
+
+constexpr uint32_t COOKED_MESH_HAS_NORMALS = 1u << 0;
+constexpr uint32_t COOKED_MESH_HAS_TEXCOORDS = 1u << 1;
+
+struct CookedMeshHeader {
+    uint32_t magic = COOKED_MESH_MAGIC;
+    uint32_t version = COOKED_MESH_VERSION;
+    uint32_t flags = 0;
+    uint32_t vertexStride = 0;
+    uint32_t positionOffset = 0;
+    uint32_t normalOffset = 0;
+    uint32_t texCoordOffset = 0;
+    uint32_t positionFormat = 0;  // pers::VertexFormat
+    uint32_t normalFormat = 0;
+    uint32_t texCoordFormat = 0;
+    uint32_t lodCount = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t submeshCount = 0;
+    float minBounds[3] = {};
+    float maxBounds[3] = {};
+    uint64_t submeshOffset = 0;
+    uint64_t lodOffset = 0;
+    uint64_t vertexDataOffset = 0;
+    uint64_t indexDataOffset = 0;
+};
+static_assert(sizeof(CookedMeshHeader) == 112, "Cooked mesh header layout changed, bump COOKED_MESH_VERSION");
+
+uint64_t alignCookedOffset(uint64_t offset) {
+    return (offset + COOKED_MESH_ALIGNMENT - 1) & ~(COOKED_MESH_ALIGNMENT - 1);
+}
+
+int16_t quantizeSnorm16(float value) {
+    return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+int8_t quantizeSnorm8(float value) {
+    return static_cast<int8_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 127.0f));
+}
+
+// IEEE 754 binary16, round to nearest even; overflow goes to infinity
+uint16_t quantizeFloat16(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+    const uint32_t absBits = bits & 0x7FFFFFFF;
+    
+    if (absBits >= 0x7F800000) {
+        return sign | (absBits > 0x7F800000 ? 0x7E00 : 0x7C00);  // NaN or infinity
+    }
+    if (absBits >= 0x477FF000) {
+        return sign | 0x7C00;  // Rounds past the largest half
+    }
+    if (absBits < 0x38800000) {
+        // Subnormal half: shift the implicit-one mantissa into place
+        if (absBits < 0x33000000) {
+            return sign;
+        }
+        const uint32_t exponent = absBits >> 23;
+        const uint32_t mantissa = (absBits & 0x007FFFFF) | 0x00800000;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1))) {
+            ++half;
+        }
+        return sign | static_cast<uint16_t>(half);
+    }
+    
+    uint32_t half = ((absBits - 0x38000000) >> 13);
+    const uint32_t remainder = absBits & 0x1FFF;
+    if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1))) {
+        ++half;
+    }
+    return sign | static_cast<uint16_t>(half);
+}
+
+// Repack float vertices as position Snorm16x4, normal Snorm8x4, UV Float16x2
+std::vector<uint8_t> quantizeVertices(const MeshData& mesh, MeshData& outLayout) {
+    outLayout.positionFormat = pers::VertexFormat::Snorm16x4;
+    outLayout.positionOffset = 0;
+    outLayout.vertexStride = pers::getVertexFormatSize(outLayout.positionFormat);
+    if (mesh.hasNormals) {
+        outLayout.normalFormat = pers::VertexFormat::Snorm8x4;
+        outLayout.normalOffset = outLayout.vertexStride;
+        outLayout.vertexStride += pers::getVertexFormatSize(outLayout.normalFormat);
+    }
+    if (mesh.hasTexCoords) {
+        outLayout.texCoordFormat = pers::VertexFormat::Float16x2;
+        outLayout.texCoordOffset = outLayout.vertexStride;
+        outLayout.vertexStride += pers::getVertexFormatSize(outLayout.texCoordFormat);
+    }
+    
+    const size_t floatsPerVertex = mesh.vertexStride / sizeof(float);
+    const size_t vertexCount = mesh.vertices.size() / floatsPerVertex;
+    std::vector<uint8_t> packed(vertexCount * outLayout.vertexStride);
+    
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* src = mesh.vertices.data() + i * floatsPerVertex;
+        uint8_t* dst = packed.data() + i * outLayout.vertexStride;
+        
+        const int16_t position[4] = {
+            quantizeSnorm16(src[mesh.positionOffset / sizeof(float) + 0]),
+            quantizeSnorm16(src[mesh.positionOffset / sizeof(float) + 1]),
+            quantizeSnorm16(src[mesh.positionOffset / sizeof(float) + 2]),
+            32767
+        };
+        std::memcpy(dst + outLayout.positionOffset, position, sizeof(position));
+        
+        if (mesh.hasNormals) {
+            const int8_t normal[4] = {
+                quantizeSnorm8(src[mesh.normalOffset / sizeof(float) + 0]),
+                quantizeSnorm8(src[mesh.normalOffset / sizeof(float) + 1]),
+                quantizeSnorm8(src[mesh.normalOffset / sizeof(float) + 2]),
+                0
+            };
+            std::memcpy(dst + outLayout.normalOffset, normal, sizeof(normal));
+        }
+        
+        if (mesh.hasTexCoords) {
+            const uint16_t texCoord[2] = {
+                quantizeFloat16(src[mesh.texCoordOffset / sizeof(float) + 0]),
+                quantizeFloat16(src[mesh.texCoordOffset / sizeof(float) + 1])
+            };
+            std::memcpy(dst + outLayout.texCoordOffset, texCoord, sizeof(texCoord));
+        }
+    }
+    
+    return packed;
+}
+
+} // anonymous namespace
 
 bool ResourceLoader::loadMesh(const std::string& filepath, MeshData& outMesh) {
     LOG_INFO("ResourceLoader", "Loading mesh from: " + filepath);
@@ -34,26 +184,40 @@ bool ResourceLoader::loadMesh(const std::string& filepath, MeshData& outMesh) {
     
     // Use Assimp to load the mesh
     Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(filepath, MESH_IMPORT_FLAGS);
+    
+    if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+        LOG_ERROR("ResourceLoader", "Assimp error: " + std::string(importer.GetErrorString()));
+        return false;
+    }
     
-    // Configure import options
-    unsigned int flags = 
-        aiProcess_Triangulate |               // Convert to triangles
-        aiProcess_JoinIdenticalVertices |     // Optimize vertices
-        aiProcess_GenSmoothNormals |                // Generate normals if missing
-        aiProcess_CalcTangentSpace |          // Calculate tangents
-        aiProcess_OptimizeMeshes |            // Optimize mesh
-        aiProcess_PreTransformVertices;       // Apply node transformations
+    buildMeshData(scene, outMesh);
+    return true;
+}
+
+bool ResourceLoader::loadMeshFromMemory(const void* data, size_t size, const std::string& extensionHint, MeshData& outMesh) {
+    if (!data || size == 0) {
+        LOG_ERROR("ResourceLoader", "Mesh data is empty");
+        return false;
+    }
     
-    const aiScene* scene = importer.ReadFile(filepath, flags);
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFileFromMemory(data, size, MESH_IMPORT_FLAGS, extensionHint.c_str());
     
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         LOG_ERROR("ResourceLoader", "Assimp error: " + std::string(importer.GetErrorString()));
         return false;
     }
     
+    buildMeshData(scene, outMesh);
+    return true;
+}
+
+void ResourceLoader::buildMeshData(const aiScene* scene, MeshData& outMesh) {
     // Clear output mesh
     outMesh.vertices.clear();
     outMesh.indices.clear();
+    outMesh.submeshes.clear();
     
     // Initialize bounds
     outMesh.minBounds = glm::vec3(std::numeric_limits<float>::max());
@@ -121,12 +285,16 @@ bool ResourceLoader::loadMesh(const std::string& filepath, MeshData& outMesh) {
         }
         
         // Process indices
+        MeshData::SubMesh submesh;
+        submesh.firstIndex = static_cast<uint32_t>(outMesh.indices.size());
         for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
             const aiFace& face = mesh->mFaces[i];
             for (unsigned int j = 0; j < face.mNumIndices; j++) {
                 outMesh.indices.push_back(baseVertex + face.mIndices[j]);
             }
         }
+        submesh.indexCount = static_cast<uint32_t>(outMesh.indices.size()) - submesh.firstIndex;
+        outMesh.submeshes.push_back(submesh);
         
         baseVertex += mesh->mNumVertices;
     }
@@ -138,7 +306,8 @@ bool ResourceLoader::loadMesh(const std::string& filepath, MeshData& outMesh) {
     // Normalize the mesh to fit in [-1, 1] cube
     normalizeMesh(outMesh);
     
-    return true;
+    // Reorder for the post-transform cache and vertex fetch before anything is uploaded or cooked
+    MeshOptimizer::optimize(outMesh);
 }
 
 bool ResourceLoader::loadStanfordBunny(MeshData& outMesh) {
@@ -245,6 +414,9 @@ bool ResourceLoader::loadStanfordBunny(MeshData& outMesh) {
         }
     }
     
+    outMesh.submeshes.clear();
+    outMesh.submeshes.push_back({0, static_cast<uint32_t>(outMesh.indices.size())});
+    
     // Set bounds
     outMesh.minBounds = glm::vec3(-0.5f, -0.6f, -0.5f);
     outMesh.maxBounds = glm::vec3(0.5f, 0.6f, 0.5f);
@@ -274,6 +446,13 @@ bool ResourceLoader::createGPUBuffers(
         return false;
     }
     
+    // Staging buffers are recycled through the device pool
+    const auto& stagingPool = device->getStagingBufferPool();
+    if (!stagingPool) {
+        LOG_ERROR("ResourceLoader", "Failed to get staging buffer pool");
+        return false;
+    }
+    
     // Create vertex buffer using staging buffer
     size_t vertexDataSize = mesh.vertices.size() * sizeof(float);
     
@@ -285,7 +464,7 @@ bool ResourceLoader::createGPUBuffers(
         //stagingDesc.debugName = "BunnyVertexStagingBuffer";
         
         auto stagingBuffer = std::make_shared<pers::ImmediateStagingBuffer>();
-        if (!stagingBuffer->create(vertexDataSize, device, "BunnyVertexStagingBuffer")) {
+        if (!stagingBuffer->create(vertexDataSize, stagingPool, "BunnyVertexStagingBuffer")) {
             LOG_ERROR("ResourceLoader", "Failed to create vertex staging buffer");
             return false;
         }
@@ -348,7 +527,7 @@ bool ResourceLoader::createGPUBuffers(
         stagingDesc.debugName = "BunnyIndexStagingBuffer";
         
         auto stagingBuffer = std::make_shared<pers::ImmediateStagingBuffer>();
-        if (!stagingBuffer->create(indexDataSize, device, "BunnyIndexStagingBuffer")) {
+        if (!stagingBuffer->create(indexDataSize, stagingPool, "BunnyIndexStagingBuffer")) {
             LOG_ERROR("ResourceLoader", "Failed to create index staging buffer");
             return false;
         }
@@ -404,6 +583,223 @@ bool ResourceLoader::createGPUBuffers(
     return true;
 }
 
+bool ResourceLoader::cookMesh(const MeshData& mesh, const std::string& outputPath, const MeshCookOptions& options) {
+    if (mesh.vertices.empty() || mesh.vertexStride == 0) {
+        LOG_ERROR("ResourceLoader", "Cannot cook an empty mesh");
+        return false;
+    }
+    
+    // Snorm positions only hold the normalized [-1, 1] range
+    bool quantize = options.quantize;
+    const float maxExtent = (std::max)({std::abs(mesh.minBounds.x), std::abs(mesh.minBounds.y), std::abs(mesh.minBounds.z),
+                                        std::abs(mesh.maxBounds.x), std::abs(mesh.maxBounds.y), std::abs(mesh.maxBounds.z)});
+    if (quantize && maxExtent > 1.0f + 1e-4f) {
+        LOG_WARNING("ResourceLoader", "Mesh is not normalized, cooking without quantization");
+        quantize = false;
+    }
+    
+    MeshData layout;
+    std::vector<uint8_t> quantizedVertices;
+    const void* vertexData = mesh.vertices.data();
+    uint64_t vertexBytes = mesh.vertices.size() * sizeof(float);
+    const uint64_t vertexCount = vertexBytes / mesh.vertexStride;
+    if (quantize) {
+        quantizedVertices = quantizeVertices(mesh, layout);
+        vertexData = quantizedVertices.data();
+        vertexBytes = quantizedVertices.size();
+    } else {
+        layout.vertexStride = mesh.vertexStride;
+        layout.positionOffset = mesh.positionOffset;
+        layout.normalOffset = mesh.normalOffset;
+        layout.texCoordOffset = mesh.texCoordOffset;
+        layout.positionFormat = mesh.positionFormat;
+        layout.normalFormat = mesh.normalFormat;
+        layout.texCoordFormat = mesh.texCoordFormat;
+    }
+    const uint64_t indexBytes = mesh.indices.size() * sizeof(uint32_t);
+    
+    CookedMeshHeader header;
+    header.flags = (mesh.hasNormals ? COOKED_MESH_HAS_NORMALS : 0) |
+                   (mesh.hasTexCoords ? COOKED_MESH_HAS_TEXCOORDS : 0);
+    header.vertexStride = static_cast<uint32_t>(layout.vertexStride);
+    header.positionOffset = static_cast<uint32_t>(layout.positionOffset);
+    header.normalOffset = static_cast<uint32_t>(layout.normalOffset);
+    header.texCoordOffset = static_cast<uint32_t>(layout.texCoordOffset);
+    header.positionFormat = static_cast<uint32_t>(layout.positionFormat);
+    header.normalFormat = static_cast<uint32_t>(layout.normalFormat);
+    header.texCoordFormat = static_cast<uint32_t>(layout.texCoordFormat);
+    header.vertexCount = static_cast<uint32_t>(vertexCount);
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.submeshCount = static_cast<uint32_t>(mesh.submeshes.size());
+    std::memcpy(header.minBounds, &mesh.minBounds.x, sizeof(header.minBounds));
+    std::memcpy(header.maxBounds, &mesh.maxBounds.x, sizeof(header.maxBounds));
+    header.lodCount = static_cast<uint32_t>(mesh.lods.size());
+    header.submeshOffset = sizeof(CookedMeshHeader);
+    header.lodOffset = header.submeshOffset + header.submeshCount * sizeof(MeshData::SubMesh);
+    header.vertexDataOffset = alignCookedOffset(header.lodOffset + header.lodCount * sizeof(MeshData::LOD));
+    header.indexDataOffset = alignCookedOffset(header.vertexDataOffset + vertexBytes);
+    
+    std::error_code ec;
+    const std::filesystem::path parent = std::filesystem::path(outputPath).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ec);
+    }
+    
+    // Write to a temporary file so a failed cook never leaves a truncated mesh behind
+    const std::string tempPath = outputPath + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG_ERROR("ResourceLoader", "Failed to open cooked mesh for writing: " + tempPath);
+            return false;
+        }
+        
+        const char padding[COOKED_MESH_ALIGNMENT] = {};
+        auto padTo = [&](uint64_t offset) {
+            file.write(padding, static_cast<std::streamsize>(offset - static_cast<uint64_t>(file.tellp())));
+        };
+        
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(mesh.submeshes.data()),
+                   static_cast<std::streamsize>(header.submeshCount * sizeof(MeshData::SubMesh)));
+        file.write(reinterpret_cast<const char*>(mesh.lods.data()),
+                   static_cast<std::streamsize>(header.lodCount * sizeof(MeshData::LOD)));
+        padTo(header.vertexDataOffset);
+        file.write(reinterpret_cast<const char*>(vertexData), static_cast<std::streamsize>(vertexBytes));
+        padTo(header.indexDataOffset);
+        file.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(indexBytes));
+        
+        if (!file) {
+            LOG_ERROR("ResourceLoader", "Failed to write cooked mesh: " + tempPath);
+            return false;
+        }
+    }
+    
+    std::filesystem::rename(tempPath, outputPath, ec);
+    if (ec) {
+        LOG_ERROR("ResourceLoader", "Failed to move cooked mesh into place: " + outputPath);
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    
+    LOG_INFO("ResourceLoader", "Cooked mesh to: " + outputPath);
+    return true;
+}
+
+bool ResourceLoader::mapCookedMesh(const std::string& filepath, MappedFile& file, MeshData& outLayout,
+                                   CookedMeshBlobs& outBlobs) {
+    if (!file.open(filepath)) {
+        return false;
+    }
+    
+    CookedMeshHeader header;
+    if (file.size() < sizeof(header)) {
+        LOG_WARNING("ResourceLoader", "Cooked mesh is truncated: " + filepath);
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+    
+    if (header.magic != COOKED_MESH_MAGIC || header.version != COOKED_MESH_VERSION) {
+        LOG_WARNING("ResourceLoader", "Cooked mesh has an old version, re-cook: " + filepath);
+        return false;
+    }
+    
+    const uint64_t vertexBytes = static_cast<uint64_t>(header.vertexCount) * header.vertexStride;
+    const uint64_t indexBytes = static_cast<uint64_t>(header.indexCount) * sizeof(uint32_t);
+    const uint64_t submeshBytes = static_cast<uint64_t>(header.submeshCount) * sizeof(MeshData::SubMesh);
+    const uint64_t lodBytes = static_cast<uint64_t>(header.lodCount) * sizeof(MeshData::LOD);
+    if (vertexBytes == 0 ||
+        header.submeshOffset + submeshBytes > file.size() ||
+        header.lodOffset + lodBytes > file.size() ||
+        header.vertexDataOffset + vertexBytes > file.size() ||
+        header.indexDataOffset + indexBytes > file.size()) {
+        LOG_WARNING("ResourceLoader", "Cooked mesh is truncated: " + filepath);
+        return false;
+    }
+    
+    outLayout.vertices.clear();
+    outLayout.indices.clear();
+    outLayout.submeshes.resize(header.submeshCount);
+    std::memcpy(outLayout.submeshes.data(), file.data() + header.submeshOffset, submeshBytes);
+    outLayout.lods.resize(header.lodCount);
+    std::memcpy(outLayout.lods.data(), file.data() + header.lodOffset, lodBytes);
+    outLayout.vertexStride = header.vertexStride;
+    outLayout.positionOffset = header.positionOffset;
+    outLayout.normalOffset = header.normalOffset;
+    outLayout.texCoordOffset = header.texCoordOffset;
+    outLayout.positionFormat = static_cast<pers::VertexFormat>(header.positionFormat);
+    outLayout.normalFormat = static_cast<pers::VertexFormat>(header.normalFormat);
+    outLayout.texCoordFormat = static_cast<pers::VertexFormat>(header.texCoordFormat);
+    outLayout.hasNormals = (header.flags & COOKED_MESH_HAS_NORMALS) != 0;
+    outLayout.hasTexCoords = (header.flags & COOKED_MESH_HAS_TEXCOORDS) != 0;
+    outLayout.minBounds = glm::vec3(header.minBounds[0], header.minBounds[1], header.minBounds[2]);
+    outLayout.maxBounds = glm::vec3(header.maxBounds[0], header.maxBounds[1], header.maxBounds[2]);
+    
+    outBlobs.vertices = file.data() + header.vertexDataOffset;
+    outBlobs.indices = reinterpret_cast<const uint32_t*>(file.data() + header.indexDataOffset);
+    outBlobs.vertexCount = header.vertexCount;
+    outBlobs.indexCount = header.indexCount;
+    return true;
+}
+
+bool ResourceLoader::loadCookedMesh(
+    const std::string& filepath,
+    const std::shared_ptr<pers::ILogicalDevice>& device,
+    MeshData& outLayout,
+    uint32_t& outIndexCount,
+    std::shared_ptr<pers::IBuffer>& outVertexBuffer,
+    std::shared_ptr<pers::IBuffer>& outIndexBuffer) {
+    
+    if (!device) {
+        LOG_ERROR("ResourceLoader", "Invalid device");
+        return false;
+    }
+    
+    const auto& factory = device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("ResourceLoader", "Failed to get resource factory");
+        return false;
+    }
+    
+    MappedFile file;
+    MeshData layout;
+    CookedMeshBlobs blobs;
+    if (!mapCookedMesh(filepath, file, layout, blobs)) {
+        return false;
+    }
+    
+    const uint64_t vertexBytes = static_cast<uint64_t>(blobs.vertexCount) * layout.vertexStride;
+    const uint64_t indexBytes = static_cast<uint64_t>(blobs.indexCount) * sizeof(uint32_t);
+    
+    // Vertex and index blobs go from the mapping into mapped-at-creation buffers
+    auto vertexBuffer = std::make_shared<pers::ImmediateDeviceBuffer>(
+        factory, vertexBytes, pers::BufferUsage::Vertex,
+        blobs.vertices, vertexBytes, "CookedMeshVertexBuffer");
+    if (!vertexBuffer->isValid()) {
+        LOG_ERROR("ResourceLoader", "Failed to create cooked vertex buffer");
+        return false;
+    }
+    
+    std::shared_ptr<pers::ImmediateDeviceBuffer> indexBuffer;
+    if (indexBytes > 0) {
+        indexBuffer = std::make_shared<pers::ImmediateDeviceBuffer>(
+            factory, indexBytes, pers::BufferUsage::Index,
+            blobs.indices, indexBytes, "CookedMeshIndexBuffer");
+        if (!indexBuffer->isValid()) {
+            LOG_ERROR("ResourceLoader", "Failed to create cooked index buffer");
+            return false;
+        }
+    }
+    
+    outLayout = std::move(layout);
+    outIndexCount = blobs.indexCount;
+    outVertexBuffer = vertexBuffer;
+    outIndexBuffer = indexBuffer;
+    
+    LOG_INFO("ResourceLoader", "Loaded cooked mesh from: " + filepath);
+    return true;
+}
+
 void ResourceLoader::normalizeMesh(MeshData& mesh) {
     // Calculate center and scale
     glm::vec3 center = (mesh.minBounds + mesh.maxBounds) * 0.5f;
@@ -438,23 +834,21 @@ void ResourceLoader::normalizeMesh(MeshData& mesh) {
 }
 
 bool ResourceLoader::downloadFile(const std::string& url, const std::string& outputPath) {
-#ifdef _WIN32
-    // Use Windows URLDownloadToFile
-    HRESULT hr = URLDownloadToFileA(NULL, url.c_str(), outputPath.c_str(), 0, NULL);
-    if (SUCCEEDED(hr)) {
-        return true;
-    }
-    LOG_ERROR("ResourceLoader", "Failed to download file from: " + url);
-#else
-    // Use curl on Linux/Mac
-    std::string command = "curl -L -o \"" + outputPath + "\" \"" + url + "\"";
-    int result = system(command.c_str());
-    if (result == 0) {
-        return true;
-    }
-    LOG_ERROR("ResourceLoader", "Failed to download file using curl");
-#endif
-    return false;
+    // Shared so repeated downloads reuse the cache and its transfer threads
+    static DownloadManager downloads;
+    const DownloadResult result = downloads.download(url).get();
+    if (!result.ok) {
+        LOG_ERROR("ResourceLoader", "Failed to download file from: " + url);
+        return false;
+    }
+    
+    std::error_code error;
+    std::filesystem::copy_file(result.path, outputPath, std::filesystem::copy_options::overwrite_existing, error);
+    if (error) {
+        LOG_ERROR("ResourceLoader", "Failed to copy download to: " + outputPath);
+        return false;
+    }
+    return true;
 }
 
 bool ResourceLoader::fileExists(const std::string& path) {
@@ -6,6 +6,9 @@
 #include <glm/vec3.hpp>
 #include <glm/vec2.hpp>
 #include <glm/common.hpp>
+#include "pers/graphics/GraphicsFormats.h"
+
+struct aiScene;
 
 namespace pers {
     class IBuffer;
@@ -14,8 +17,22 @@ namespace pers {
 }
 
 struct MeshData {
+    struct SubMesh {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+    };
+    
+    struct LOD {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;  // Geometric deviation from LOD 0, in mesh units
+        uint32_t vertexCount = 0;  // Leading vertices this level uses, 0 = not ordered by LOD
+    };
+    
     std::vector<float> vertices;  // Interleaved vertex data
     std::vector<uint32_t> indices;
+    std::vector<SubMesh> submeshes;  // One per source mesh, indices are absolute
+    std::vector<LOD> lods;           // Optional, LOD 0 is the full mesh; all levels share the vertices
     
     // Vertex attributes info
     size_t vertexStride = 0;  // Bytes per vertex
@@ -23,6 +40,11 @@ struct MeshData {
     size_t normalOffset = 0;
     size_t texCoordOffset = 0;
     
+    // Attribute formats; loaded meshes are always float, cooked meshes may be quantized
+    pers::VertexFormat positionFormat = pers::VertexFormat::Float32x3;
+    pers::VertexFormat normalFormat = pers::VertexFormat::Float32x3;
+    pers::VertexFormat texCoordFormat = pers::VertexFormat::Float32x2;
+    
     bool hasNormals = false;
     bool hasTexCoords = false;
     
@@ -31,6 +53,22 @@ struct MeshData {
     glm::vec3 maxBounds;
 };
 
+struct MeshCookOptions {
+    // Positions to Snorm16x4 (mesh must be normalized), normals to Snorm8x4 and
+    // UVs to Float16x2: 16 bytes per vertex instead of 32
+    bool quantize = false;
+};
+
+// Blobs of a mapped cooked mesh; pointers stay valid while its MappedFile is open
+struct CookedMeshBlobs {
+    const uint8_t* vertices = nullptr;  // vertexCount * vertexStride bytes in GPU layout
+    const uint32_t* indices = nullptr;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+};
+
+class MappedFile;
+
 class ResourceLoader {
 public:
     ResourceLoader() = default;
@@ -39,6 +77,10 @@ public:
     // Load mesh from file (supports .obj, .ply, etc. via Assimp)
     static bool loadMesh(const std::string& filepath, MeshData& outMesh);
     
+    // Load mesh from file contents already in memory; extensionHint is e.g. "ply".
+    // Safe to call from several threads at once, each call uses its own importer.
+    static bool loadMeshFromMemory(const void* data, size_t size, const std::string& extensionHint, MeshData& outMesh);
+    
     // Load Stanford Bunny (downloads if necessary)
     static bool loadStanfordBunny(MeshData& outMesh);
     
@@ -51,11 +93,35 @@ public:
         std::shared_ptr<pers::IBuffer>& outIndexBuffer
     );
     
+    // Write a loaded (and normalized) mesh as a cooked binary mesh, see loadCookedMesh
+    static bool cookMesh(const MeshData& mesh, const std::string& outputPath, const MeshCookOptions& options = {});
+    
+    // Map a cooked mesh and create its GPU buffers straight from the mapping.
+    // outLayout receives stride, offsets, bounds and submeshes; vertices and
+    // indices stay empty since the data never passes through CPU arrays.
+    // Fails on a missing file or a version mismatch, re-cook in that case.
+    static bool loadCookedMesh(
+        const std::string& filepath,
+        const std::shared_ptr<pers::ILogicalDevice>& device,
+        MeshData& outLayout,
+        uint32_t& outIndexCount,
+        std::shared_ptr<pers::IBuffer>& outVertexBuffer,
+        std::shared_ptr<pers::IBuffer>& outIndexBuffer
+    );
+    
+    // Map a cooked mesh and validate it without creating buffers, for callers
+    // that upload parts of it (see MeshStreamer). Same failures as loadCookedMesh.
+    static bool mapCookedMesh(const std::string& filepath, MappedFile& file, MeshData& outLayout,
+                              CookedMeshBlobs& outBlobs);
+    
 private:
+    // Convert an imported scene to interleaved vertices and normalize it
+    static void buildMeshData(const aiScene* scene, MeshData& outMesh);
+    
     // Helper to normalize mesh to fit in [-1, 1] cube
     static void normalizeMesh(MeshData& mesh);
     
-    // Download file from URL
+    // Download file from URL through a shared DownloadManager, so copies are cached and revalidated
     static bool downloadFile(const std::string& url, const std::string& outputPath);
     
     // Check if file exists
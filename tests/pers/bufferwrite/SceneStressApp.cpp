@@ -0,0 +1,243 @@
+#include "SceneStressApp.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+// Frames in a row that may fail to render before the run is abandoned
+constexpr uint32_t MAX_FAILED_FRAMES = 100;
+
+struct Summary {
+    size_t samples = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Nearest-rank percentiles; negative values are missing samples
+Summary summarize(std::vector<double> values) {
+    values.erase(std::remove_if(values.begin(), values.end(), [](double v) { return v < 0.0; }), values.end());
+    Summary summary;
+    summary.samples = values.size();
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    auto rank = [&](double p) {
+        const size_t index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+        return values[std::min(index, values.size() - 1)];
+    };
+    double total = 0.0;
+    for (double v : values) {
+        total += v;
+    }
+    summary.mean = total / static_cast<double>(values.size());
+    summary.p50 = rank(0.50);
+    summary.p95 = rank(0.95);
+    summary.p99 = rank(0.99);
+    summary.max = values.back();
+    return summary;
+}
+
+void writeSummary(std::ofstream& out, const char* name, const Summary& summary) {
+    out << "    \"" << name << "\": {\"samples\": " << summary.samples
+        << ", \"mean\": " << summary.mean << ", \"p50\": " << summary.p50
+        << ", \"p95\": " << summary.p95 << ", \"p99\": " << summary.p99
+        << ", \"max\": " << summary.max << "}";
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+const char* presentModeName(pers::PresentMode mode) {
+    switch (mode) {
+        case pers::PresentMode::Fifo: return "fifo";
+        case pers::PresentMode::FifoRelaxed: return "fifo_relaxed";
+        case pers::PresentMode::Immediate: return "immediate";
+        case pers::PresentMode::Mailbox: return "mailbox";
+    }
+    return "unknown";
+}
+
+} // namespace
+
+SceneStressApp::SceneStressApp(const SceneStressOptions& options)
+    : _options(options) {
+    _windowTitle = "PERS Scene Stress";
+    _windowWidth = static_cast<int>(options.scene.width);
+    _windowHeight = static_cast<int>(options.scene.height);
+}
+
+SceneStressApp::~SceneStressApp() = default;
+
+bool SceneStressApp::onInitialize() {
+    SceneStressConfig config = _options.scene;
+    pers::NativeSurfaceHandle surface;
+    if (!isHeadless()) {
+        const glm::ivec2 size = getFramebufferSize();
+        config.width = static_cast<uint32_t>(size.x);
+        config.height = static_cast<uint32_t>(size.y);
+        surface = createSurface();
+        if (!surface.isValid()) {
+            LOG_ERROR("SceneStressApp", "Failed to create surface");
+            return false;
+        }
+    }
+
+    _renderer = std::make_unique<SceneStressRenderer>();
+    if (!_renderer->initialize(getInstance(), surface, config)) {
+        LOG_ERROR("SceneStressApp", "Failed to initialize renderer");
+        return false;
+    }
+    return true;
+}
+
+void SceneStressApp::onRender() {
+    if (!_renderer) {
+        return;
+    }
+
+    const size_t rendered = _renderer->getFrames().size();
+    const pers::SubmissionFence fence = _renderer->renderFrame();
+    if (fence) {
+        getFramePacer().trackSubmission(fence);
+    }
+    if (_renderer->getFrames().size() == rendered) {
+        if (++_failedFrames >= MAX_FAILED_FRAMES) {
+            LOG_ERROR("SceneStressApp", "Too many frames failed to render, giving up");
+            requestExit();
+        }
+        return;
+    }
+    _failedFrames = 0;
+
+    if (_renderer->getFrames().size() < static_cast<size_t>(_options.warmup) + _options.frames) {
+        return;
+    }
+
+    _renderer->finish();
+    const auto& all = _renderer->getFrames();
+    const std::vector<SceneStressFrame> measured(all.begin() + _options.warmup, all.end());
+    _succeeded = writeCsv(measured) && writeJson(measured);
+
+    std::vector<double> cpuTimes;
+    for (const SceneStressFrame& frame : measured) {
+        cpuTimes.push_back(frame.cpuMs);
+    }
+    const Summary cpu = summarize(cpuTimes);
+    pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "SceneStressApp", PERS_SOURCE_LOC,
+        "%u frames: CPU mean %.3f ms, p95 %.3f ms, p99 %.3f ms", _options.frames, cpu.mean, cpu.p95, cpu.p99);
+    requestExit();
+}
+
+void SceneStressApp::onResize(int width, int height) {
+    if (_renderer) {
+        _renderer->onResize(width, height);
+    }
+}
+
+void SceneStressApp::onCleanup() {
+    _renderer.reset();
+}
+
+bool SceneStressApp::writeCsv(const std::vector<SceneStressFrame>& frames) const {
+    if (_options.csvPath.empty()) {
+        return true;
+    }
+    std::ofstream out(_options.csvPath);
+    if (!out) {
+        LOG_ERROR("SceneStressApp", "Failed to open " + _options.csvPath);
+        return false;
+    }
+    out << "frame,cpu_ms,gpu_ms,draws,pipeline_switches,bind_group_switches,uploaded_bytes\n";
+    out << std::fixed << std::setprecision(4);
+    for (const SceneStressFrame& frame : frames) {
+        out << frame.frame << ',' << frame.cpuMs << ',';
+        if (frame.gpuMs >= 0.0) {
+            out << frame.gpuMs;
+        }
+        out << ',' << frame.draws << ',' << frame.pipelineSwitches << ',' << frame.bindGroupSwitches
+            << ',' << frame.uploadedBytes << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+bool SceneStressApp::writeJson(const std::vector<SceneStressFrame>& frames) const {
+    if (_options.jsonPath.empty()) {
+        return true;
+    }
+    std::ofstream out(_options.jsonPath);
+    if (!out) {
+        LOG_ERROR("SceneStressApp", "Failed to open " + _options.jsonPath);
+        return false;
+    }
+
+    std::vector<double> cpuTimes;
+    std::vector<double> gpuTimes;
+    uint64_t draws = 0;
+    uint64_t pipelineSwitches = 0;
+    uint64_t bindGroupSwitches = 0;
+    uint64_t uploadedBytes = 0;
+    for (const SceneStressFrame& frame : frames) {
+        cpuTimes.push_back(frame.cpuMs);
+        gpuTimes.push_back(frame.gpuMs);
+        draws += frame.draws;
+        pipelineSwitches += frame.pipelineSwitches;
+        bindGroupSwitches += frame.bindGroupSwitches;
+        uploadedBytes += frame.uploadedBytes;
+    }
+
+    // Renderer config, after clamping and any present mode fallback
+    const SceneStressConfig& scene = _renderer->getConfig();
+    out << std::fixed << std::setprecision(4);
+    out << "{\n";
+    out << "  \"config\": {\n";
+    out << "    \"instances\": " << scene.instanceCount << ",\n";
+    out << "    \"pipelines\": " << scene.pipelineCount << ",\n";
+    out << "    \"materials\": " << scene.materialCount << ",\n";
+    out << "    \"dynamic_fraction\": " << scene.dynamicFraction << ",\n";
+    out << "    \"instanced\": " << (scene.instanced ? "true" : "false") << ",\n";
+    out << "    \"lod\": " << scene.lod << ",\n";
+    out << "    \"width\": " << scene.width << ",\n";
+    out << "    \"height\": " << scene.height << ",\n";
+    out << "    \"headless\": " << (isHeadless() ? "true" : "false") << ",\n";
+    out << "    \"present_mode\": \"" << presentModeName(scene.presentMode) << "\",\n";
+    out << "    \"frames\": " << _options.frames << ",\n";
+    out << "    \"warmup\": " << _options.warmup << "\n";
+    out << "  },\n";
+    out << "  \"adapter\": \"" << escapeJson(_renderer->getAdapterName()) << "\",\n";
+    out << "  \"gpu_timing\": " << (_renderer->hasGpuTiming() ? "true" : "false") << ",\n";
+    out << "  \"summary\": {\n";
+    writeSummary(out, "cpu_ms", summarize(cpuTimes));
+    out << ",\n";
+    writeSummary(out, "gpu_ms", summarize(gpuTimes));
+    out << ",\n";
+    const double frameCount = frames.empty() ? 1.0 : static_cast<double>(frames.size());
+    out << "    \"draws_per_frame\": " << static_cast<double>(draws) / frameCount << ",\n";
+    out << "    \"pipeline_switches_per_frame\": " << static_cast<double>(pipelineSwitches) / frameCount << ",\n";
+    out << "    \"bind_group_switches_per_frame\": " << static_cast<double>(bindGroupSwitches) / frameCount << ",\n";
+    out << "    \"uploaded_bytes_total\": " << uploadedBytes << ",\n";
+    out << "    \"uploaded_bytes_per_frame\": " << static_cast<double>(uploadedBytes) / frameCount << "\n";
+    out << "  }\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "SceneStressRenderer.h"
+#include "pers/core/Application.h"
+#include <memory>
+#include <string>
+
+struct SceneStressOptions {
+    SceneStressConfig scene;
+    uint32_t frames = 500;   // Measured frames
+    uint32_t warmup = 60;    // Rendered first and left out of the reports
+    bool headless = false;
+    std::string csvPath = "scene_stress.csv";    // One row per measured frame, empty = none
+    std::string jsonPath = "scene_stress.json";  // Configuration and summary, empty = none
+};
+
+// Runs the scene stress renderer for a fixed number of frames, then writes
+// the reports and leaves run(). Headless when initialized with
+// initializeHeadless(), rendering offscreen at the configured size.
+class SceneStressApp : public pers::Application {
+public:
+    explicit SceneStressApp(const SceneStressOptions& options);
+    ~SceneStressApp() override;
+
+    // False until every frame was rendered and the reports were written
+    bool succeeded() const { return _succeeded; }
+
+protected:
+    bool onInitialize() override;
+    void onRender() override;
+    void onResize(int width, int height) override;
+    void onCleanup() override;
+
+private:
+    bool writeCsv(const std::vector<SceneStressFrame>& frames) const;
+    bool writeJson(const std::vector<SceneStressFrame>& frames) const;
+
+    SceneStressOptions _options;
+    std::unique_ptr<SceneStressRenderer> _renderer;
+    uint32_t _failedFrames = 0;  // In a row
+    bool _succeeded = false;
+};
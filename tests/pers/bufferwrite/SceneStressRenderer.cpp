@@ -0,0 +1,601 @@
+#include "SceneStressRenderer.h"
+#include "MeshSimplifier.h"
+#include "pers/graphics/GpuPassTimer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IFramebuffer.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/ObjectDataBuffer.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/RenderPassConfig.h"
+#include "pers/graphics/SurfaceFramebuffer.h"
+#include "pers/graphics/SwapChainDescBuilder.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
+#include "pers/utils/Logger.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/mat4x4.hpp>
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace {
+
+constexpr float TWO_PI = 6.28318531f;
+
+// Bind group indices shared by every pipeline
+constexpr uint32_t OBJECT_GROUP = 0;
+constexpr uint32_t MATERIAL_GROUP = 1;
+constexpr uint32_t CAMERA_GROUP = 2;
+
+const char* const SHARED_DECLARATIONS = R"(
+struct ObjectConstants {
+    positionScale: vec4<f32>,
+    rotation: vec4<f32>,
+}
+
+struct Material {
+    tint: vec4<f32>,
+}
+
+struct Camera {
+    viewProjection: mat4x4<f32>,
+}
+
+@group(1) @binding(0) var<uniform> material: Material;
+@group(2) @binding(0) var<uniform> camera: Camera;
+
+struct VertexOutput {
+    @builtin(position) position: vec4<f32>,
+    @location(0) normal: vec3<f32>,
+}
+)";
+
+const char* const VERTEX_MAIN = R"(
+@vertex
+fn main(@location(0) position: vec3<f32>,
+        @location(1) normal: vec3<f32>,
+        @builtin(instance_index) id: u32) -> VertexOutput {
+    let object = objects[id];
+    let c = cos(object.rotation.x);
+    let s = sin(object.rotation.x);
+    let rotated = vec3<f32>(position.x * c - position.z * s, position.y, position.x * s + position.z * c);
+    let world = rotated * object.positionScale.w + object.positionScale.xyz;
+
+    var output: VertexOutput;
+    output.position = camera.viewProjection * vec4<f32>(world, 1.0);
+    output.normal = vec3<f32>(normal.x * c - normal.z * s, normal.y, normal.x * s + normal.z * c);
+    return output;
+}
+)";
+
+// Each pipeline compiles this with its own VARIANT, so no two share a shader
+const char* const FRAGMENT_MAIN = R"(
+@fragment
+fn main(input: VertexOutput) -> @location(0) vec4<f32> {
+    let angle = f32(VARIANT) * 0.7;
+    let light = normalize(vec3<f32>(cos(angle), 1.0, sin(angle)));
+    let n = normalize(input.normal);
+    var shade = max(dot(n, light), 0.0) * 0.8 + 0.2;
+    if ((VARIANT & 1u) == 1u) {
+        shade = floor(shade * 4.0) / 4.0;  // Banded
+    }
+    return vec4<f32>(material.tint.rgb * shade, 1.0);
+}
+)";
+
+std::span<const std::byte> bytesOf(const glm::mat4& matrix) {
+    return std::as_bytes(std::span<const float>(glm::value_ptr(matrix), 16));
+}
+
+} // namespace
+
+SceneStressRenderer::SceneStressRenderer() = default;
+
+SceneStressRenderer::~SceneStressRenderer() {
+    if (_device) {
+        _device->waitIdle();
+    }
+    // Views retire into the heaps, so the streamer goes first
+    _bunny = {};
+    _meshStreamer.reset();
+    _indexHeap.reset();
+    _vertexHeap.reset();
+}
+
+bool SceneStressRenderer::initialize(const std::shared_ptr<pers::IInstance>& instance,
+                                     const pers::NativeSurfaceHandle& surface,
+                                     const SceneStressConfig& config) {
+    _config = config;
+    _instance = instance;
+    if (!_instance) {
+        LOG_ERROR("SceneStressRenderer", "Invalid instance provided");
+        return false;
+    }
+
+    _config.instanceCount = std::clamp(_config.instanceCount, 1u, SceneStressConfig::MAX_INSTANCES);
+    _config.pipelineCount = std::max(_config.pipelineCount, 1u);
+    _config.materialCount = std::max(_config.materialCount, 1u);
+    _config.dynamicFraction = std::clamp(_config.dynamicFraction, 0.0f, 1.0f);
+
+    return createDevice(surface) && createMesh() && createPipelines() && createScene();
+}
+
+bool SceneStressRenderer::createDevice(const pers::NativeSurfaceHandle& surface) {
+    pers::PhysicalDeviceOptions options;
+    options.powerPreference = pers::PowerPreference::HighPerformance;
+    if (surface.isValid()) {
+        options.compatibleSurface = surface;
+    }
+    _physicalDevice = _instance->requestPhysicalDevice(options);
+    if (!_physicalDevice) {
+        LOG_ERROR("SceneStressRenderer", "Failed to get physical device");
+        return false;
+    }
+    _adapterName = _physicalDevice->getCapabilities().deviceName;
+
+    // Validation off: the benchmark measures the engine, not the validation layer
+    pers::LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = false;
+    deviceDesc.debugName = "SceneStressDevice";
+    deviceDesc.preferredFeatures = {pers::DeviceFeature::TimestampQuery};
+    _device = _physicalDevice->createLogicalDevice(deviceDesc);
+    if (!_device) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create logical device");
+        return false;
+    }
+    _queue = _device->getQueue();
+    if (!_queue) {
+        LOG_ERROR("SceneStressRenderer", "Failed to get queue from device");
+        return false;
+    }
+
+    if (surface.isValid()) {
+        auto surfaceFramebuffer = std::make_shared<pers::SurfaceFramebuffer>(_device);
+        auto makeDesc = [&](pers::PresentMode mode) {
+            return pers::SwapChainDescBuilder()
+                .setSize(_config.width, _config.height)
+                .setFormat(_config.colorFormat)
+                .setPresentMode(mode)
+                .setUsage(pers::TextureUsage::RenderAttachment)
+                .setDebugName("SceneStressSwapChain")
+                .build();
+        };
+        if (!surfaceFramebuffer->create(surface, makeDesc(_config.presentMode), _config.depthFormat)) {
+            // Fifo is the only mode every surface supports
+            LOG_WARNING("SceneStressRenderer", "Present mode not supported, falling back to Fifo");
+            _config.presentMode = pers::PresentMode::Fifo;
+            if (!surfaceFramebuffer->create(surface, makeDesc(_config.presentMode), _config.depthFormat)) {
+                LOG_ERROR("SceneStressRenderer", "Failed to create swap chain");
+                return false;
+            }
+        }
+        _surfaceFramebuffer = surfaceFramebuffer;
+    } else {
+        pers::OffscreenFramebufferConfig offscreenConfig;
+        offscreenConfig.width = _config.width;
+        offscreenConfig.height = _config.height;
+        offscreenConfig.colorFormats = {_config.colorFormat};
+        offscreenConfig.depthFormat = _config.depthFormat;
+        _offscreenFramebuffer = std::make_shared<pers::OffscreenFramebuffer>(_device->getResourceFactory(), offscreenConfig);
+    }
+
+    _gpuTimer = std::make_unique<pers::GpuPassTimer>(_device);
+    if (!_gpuTimer->isActive()) {
+        LOG_WARNING("SceneStressRenderer", "Timestamp queries unavailable, GPU times are not reported");
+    }
+
+    _renderPassConfig = std::make_unique<pers::RenderPassConfig>();
+    pers::RenderPassConfig::ColorConfig colorConfig;
+    colorConfig.loadOp = pers::LoadOp::Clear;
+    colorConfig.storeOp = pers::StoreOp::Store;
+    colorConfig.clearColor = {0.05, 0.05, 0.08, 1.0};
+    _renderPassConfig->addColorAttachment(colorConfig);
+
+    pers::RenderPassConfig::DepthStencilConfig depthConfig;
+    depthConfig.depthLoadOp = pers::LoadOp::Clear;
+    depthConfig.depthStoreOp = pers::StoreOp::Store;
+    depthConfig.depthClearValue = 1.0f;
+    _renderPassConfig->setDepthStencilConfig(depthConfig);
+    _renderPassConfig->setLabel("SceneStressPass");
+    return true;
+}
+
+bool SceneStressRenderer::createMesh() {
+    const auto& factory = _device->getResourceFactory();
+    const std::string cookedBunnyPath = "resources/bunny.pmesh";
+    _vertexHeap = std::make_shared<pers::DeviceBufferHeap>(factory, pers::BufferUsage::Vertex,
+        pers::DeviceBufferHeap::DEFAULT_PAGE_SIZE, "SceneStressVertexHeap");
+    _indexHeap = std::make_shared<pers::DeviceBufferHeap>(factory, pers::BufferUsage::Index,
+        pers::DeviceBufferHeap::DEFAULT_PAGE_SIZE, "SceneStressIndexHeap");
+    _meshStreamer = std::make_unique<MeshStreamer>(_device, _vertexHeap, _indexHeap);
+    _bunny = _meshStreamer->add(cookedBunnyPath);
+
+    // Same cooking as the bufferwrite sample, so either one leaves the file for the other
+    if (!_bunny) {
+        MeshData bunnyMesh;
+        if (!ResourceLoader::loadStanfordBunny(bunnyMesh)) {
+            LOG_ERROR("SceneStressRenderer", "Failed to load Stanford Bunny mesh");
+            return false;
+        }
+        MeshSimplifier::generateLODs(bunnyMesh);
+        MeshCookOptions cookOptions;
+        cookOptions.quantize = true;
+        if (ResourceLoader::cookMesh(bunnyMesh, cookedBunnyPath, cookOptions)) {
+            _bunny = _meshStreamer->add(cookedBunnyPath);
+        }
+        if (!_bunny) {
+            LOG_ERROR("SceneStressRenderer", "Failed to cook and stream bunny mesh");
+            return false;
+        }
+    }
+
+    _bunnyLayout = *_meshStreamer->getLayout(_bunny);
+    if (!_bunnyLayout.hasNormals) {
+        LOG_ERROR("SceneStressRenderer", "Bunny mesh has no normals");
+        return false;
+    }
+    return true;
+}
+
+bool SceneStressRenderer::createPipelines() {
+    const auto& factory = _device->getResourceFactory();
+
+    pers::ObjectDataBuffer::Config objectConfig;
+    objectConfig.capacity = _config.instanceCount;
+    objectConfig.objectSize = sizeof(ObjectConstants);
+    objectConfig.visibility = pers::ShaderStage::Vertex;
+    objectConfig.debugName = "SceneStressObjects";
+    _objects = std::make_unique<pers::ObjectDataBuffer>(_device, objectConfig);
+    if (!_objects->isValid()) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create object data buffer");
+        return false;
+    }
+
+    pers::BindGroupLayoutDesc uniformLayoutDesc;
+    uniformLayoutDesc.entries.push_back({});
+    uniformLayoutDesc.entries[0].binding = 0;
+    uniformLayoutDesc.entries[0].type = pers::BindingType::UniformBuffer;
+    uniformLayoutDesc.entries[0].visibility = pers::ShaderStage::Fragment;
+    uniformLayoutDesc.debugName = "SceneStressMaterialLayout";
+    auto materialLayout = factory->createBindGroupLayout(uniformLayoutDesc);
+    uniformLayoutDesc.entries[0].visibility = pers::ShaderStage::Vertex;
+    uniformLayoutDesc.debugName = "SceneStressCameraLayout";
+    auto cameraLayout = factory->createBindGroupLayout(uniformLayoutDesc);
+    if (!materialLayout || !cameraLayout) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create bind group layouts");
+        return false;
+    }
+
+    pers::PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_objects->getBindGroupLayout(), materialLayout, cameraLayout};
+    pipelineLayoutDesc.debugName = "SceneStressPipelineLayout";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create pipeline layout");
+        return false;
+    }
+
+    // One material per (pipeline, material) group, tinted apart along the hue circle
+    const uint32_t groupCount = _config.pipelineCount * _config.materialCount;
+    for (uint32_t i = 0; i < groupCount; ++i) {
+        const float hue = TWO_PI * static_cast<float>(i) / static_cast<float>(groupCount);
+        const float tint[4] = {0.6f + 0.4f * std::cos(hue), 0.6f + 0.4f * std::cos(hue - 2.094f),
+                               0.6f + 0.4f * std::cos(hue + 2.094f), 1.0f};
+        auto buffer = std::make_shared<pers::ImmediateDeviceBuffer>(factory, sizeof(tint),
+            pers::BufferUsage::Uniform, tint, sizeof(tint), "SceneStressMaterial");
+
+        pers::BindGroupDesc bindGroupDesc;
+        bindGroupDesc.layout = materialLayout;
+        bindGroupDesc.entries.push_back({});
+        bindGroupDesc.entries[0].binding = 0;
+        bindGroupDesc.entries[0].buffer = buffer;
+        bindGroupDesc.debugName = "SceneStressMaterial";
+        auto bindGroup = factory->createBindGroup(bindGroupDesc);
+        if (!bindGroup) {
+            LOG_ERROR("SceneStressRenderer", "Failed to create material bind group");
+            return false;
+        }
+        _materialBuffers.push_back(buffer);
+        _materials.push_back(bindGroup);
+    }
+
+    // Placed by onResize() once the grid exists, and again as the aspect ratio changes
+    const glm::mat4 identity(1.0f);
+    _cameraBuffer = std::make_shared<pers::ImmediateDeviceBuffer>(factory, sizeof(identity),
+        pers::BufferUsage::Uniform | pers::BufferUsage::CopyDst, glm::value_ptr(identity), sizeof(identity),
+        "SceneStressCamera");
+    pers::BindGroupDesc cameraDesc;
+    cameraDesc.layout = cameraLayout;
+    cameraDesc.entries.push_back({});
+    cameraDesc.entries[0].binding = 0;
+    cameraDesc.entries[0].buffer = _cameraBuffer;
+    cameraDesc.debugName = "SceneStressCamera";
+    _cameraBindGroup = factory->createBindGroup(cameraDesc);
+    if (!_cameraBindGroup) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create camera bind group");
+        return false;
+    }
+
+    const std::string declarations = SHARED_DECLARATIONS +
+        _objects->getShaderDeclarations(OBJECT_GROUP, "ObjectConstants");
+
+    pers::ShaderModuleDesc vertexDesc;
+    vertexDesc.code = declarations + VERTEX_MAIN;
+    vertexDesc.stage = pers::ShaderStage::Vertex;
+    vertexDesc.entryPoint = "main";
+    vertexDesc.debugName = "SceneStressVertexShader";
+    auto vertexShader = factory->createShaderModule(vertexDesc);
+    if (!vertexShader) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create vertex shader");
+        return false;
+    }
+
+    pers::VertexBufferLayout vertexLayout;
+    vertexLayout.arrayStride = _bunnyLayout.vertexStride;
+    vertexLayout.stepMode = pers::VertexStepMode::Vertex;
+    vertexLayout.attributes.push_back({_bunnyLayout.positionFormat, _bunnyLayout.positionOffset, 0});
+    vertexLayout.attributes.push_back({_bunnyLayout.normalFormat, _bunnyLayout.normalOffset, 1});
+
+    for (uint32_t variant = 0; variant < _config.pipelineCount; ++variant) {
+        pers::ShaderModuleDesc fragmentDesc;
+        fragmentDesc.code = declarations + "const VARIANT: u32 = " + std::to_string(variant) + "u;\n" + FRAGMENT_MAIN;
+        fragmentDesc.stage = pers::ShaderStage::Fragment;
+        fragmentDesc.entryPoint = "main";
+        fragmentDesc.debugName = "SceneStressFragmentShader" + std::to_string(variant);
+        auto fragmentShader = factory->createShaderModule(fragmentDesc);
+        if (!fragmentShader) {
+            LOG_ERROR("SceneStressRenderer", "Failed to create fragment shader");
+            return false;
+        }
+
+        pers::RenderPipelineDesc pipelineDesc;
+        pipelineDesc.vertex = vertexShader;
+        pipelineDesc.fragment = fragmentShader;
+        pipelineDesc.layout = pipelineLayout;
+        pipelineDesc.debugName = "SceneStressPipeline" + std::to_string(variant);
+        pipelineDesc.vertexLayouts.push_back(vertexLayout);
+        pipelineDesc.primitive.topology = pers::PrimitiveTopology::TriangleList;
+        pipelineDesc.primitive.frontFace = pers::FrontFace::CCW;
+        pipelineDesc.primitive.cullMode = pers::CullMode::None;
+
+        pers::ColorTargetState colorTarget;
+        colorTarget.format = _config.colorFormat;
+        colorTarget.writeMask = pers::ColorWriteMask::All;
+        pipelineDesc.colorTargets.push_back(colorTarget);
+        pipelineDesc.multisample.count = 1;
+        pipelineDesc.depthStencil.format = _config.depthFormat;
+        pipelineDesc.depthStencil.depthWriteEnabled = true;
+        pipelineDesc.depthStencil.depthCompare = pers::CompareFunction::Less;
+
+        auto pipeline = factory->createRenderPipeline(pipelineDesc);
+        if (!pipeline) {
+            LOG_ERROR("SceneStressRenderer", "Failed to create render pipeline");
+            return false;
+        }
+        _pipelines.push_back(pipeline);
+    }
+    return true;
+}
+
+bool SceneStressRenderer::createScene() {
+    const uint32_t count = _config.instanceCount;
+    const uint32_t groupCount = _config.pipelineCount * _config.materialCount;
+
+    // A square grid with a bunny's extent and a half between neighbours
+    const glm::vec3 extent = _bunnyLayout.maxBounds - _bunnyLayout.minBounds;
+    const float size = std::max({extent.x, extent.y, extent.z, 0.001f});
+    const float spacing = size * 1.5f;
+    const uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const float half = 0.5f * spacing * static_cast<float>(side - 1);
+
+    _objectData.resize(count);
+    _groups.clear();
+    for (uint32_t id = 0; id < count; ++id) {
+        ObjectConstants& object = _objectData[id];
+        object.positionScale[0] = static_cast<float>(id % side) * spacing - half;
+        object.positionScale[1] = 0.0f;
+        object.positionScale[2] = static_cast<float>(id / side) * spacing - half;
+        object.positionScale[3] = 1.0f;
+        object.rotation[0] = std::fmod(static_cast<float>(id) * 2.39996f, TWO_PI);  // Golden angle
+        object.rotation[1] = 0.0f;
+        object.rotation[2] = 0.0f;
+        object.rotation[3] = 0.0f;
+
+        // Fresh buffer, so ids come out in allocation order
+        if (_objects->allocate(object) != id) {
+            LOG_ERROR("SceneStressRenderer", "Object data buffer handed out an unexpected id");
+            return false;
+        }
+
+        const uint32_t group = static_cast<uint32_t>(static_cast<uint64_t>(id) * groupCount / count);
+        if (_groups.empty() || _groups.back().pipeline * _config.materialCount + _groups.back().material != group) {
+            _groups.push_back({group / _config.materialCount, group % _config.materialCount, id, 0});
+        }
+        ++_groups.back().instanceCount;
+    }
+
+    // Spread evenly, so uploads touch records all over the buffer as a real scene would
+    const uint32_t dynamicCount = static_cast<uint32_t>(std::lround(_config.dynamicFraction * static_cast<float>(count)));
+    _dynamicIds.clear();
+    _dynamicIds.reserve(dynamicCount);
+    for (uint32_t i = 0; i < dynamicCount; ++i) {
+        const uint32_t id = static_cast<uint32_t>(static_cast<uint64_t>(i) * count / dynamicCount);
+        _objectData[id].rotation[1] = 0.01f + 0.002f * static_cast<float>(id % 8);
+        _dynamicIds.push_back(id);
+    }
+
+    if (!_objects->upload()) {
+        LOG_ERROR("SceneStressRenderer", "Failed to upload initial object data");
+        return false;
+    }
+    _lastObjectBytes = _objects->getBuffer().getStats().uploadedBytes;
+
+    onResize(static_cast<int>(_config.width), static_cast<int>(_config.height));
+
+    pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "SceneStressRenderer", PERS_SOURCE_LOC,
+        "%u instances in %zu groups, %zu dynamic, on %s", count, _groups.size(), _dynamicIds.size(),
+        _adapterName.c_str());
+    return true;
+}
+
+void SceneStressRenderer::updateObjects() {
+    for (uint32_t id : _dynamicIds) {
+        ObjectConstants& object = _objectData[id];
+        object.rotation[0] = std::fmod(object.rotation[0] + object.rotation[1], TWO_PI);
+        _objects->update(id, object);
+    }
+    _objects->upload();
+}
+
+pers::SubmissionFence SceneStressRenderer::renderFrame() {
+    if (!_queue || _pipelines.empty()) {
+        return {};
+    }
+    const auto start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<pers::IFramebuffer> framebuffer = _offscreenFramebuffer;
+    if (_surfaceFramebuffer) {
+        if (!_surfaceFramebuffer->acquireNextImage()) {
+            LOG_WARNING("SceneStressRenderer", "Failed to acquire next image");
+            return {};
+        }
+        framebuffer = _surfaceFramebuffer;
+    }
+
+    SceneStressFrame frame;
+    frame.frame = static_cast<uint32_t>(_frames.size() + 1);
+
+    updateObjects();
+    _meshStreamer->requestLod(_bunny, _config.lod);
+    _meshStreamer->update();
+    const StreamedMeshDraw mesh = _meshStreamer->getDraw(_bunny);
+
+    auto encoder = _device->createCommandEncoder();
+    if (!encoder) {
+        LOG_ERROR("SceneStressRenderer", "Failed to create command encoder");
+        return {};
+    }
+
+    _gpuTimer->beginFrame();
+    pers::RenderPassDesc passDesc = _renderPassConfig->makeDescriptor(framebuffer);
+    passDesc.timestampWrites = _gpuTimer->timestampWrites("Scene");
+    auto pass = encoder->beginRenderPass(passDesc);
+    if (!pass) {
+        LOG_ERROR("SceneStressRenderer", "Failed to begin render pass");
+        return {};
+    }
+
+    pass->setBindGroup(OBJECT_GROUP, _objects->getBindGroup());
+    pass->setBindGroup(CAMERA_GROUP, _cameraBindGroup);
+    pass->setVertexBuffer(0, mesh.vertexBuffer, 0);
+    pass->setIndexBuffer(mesh.indexBuffer, pers::IndexFormat::Uint32, 0);
+
+    // Groups are sorted by pipeline, so each pipeline and material is set once
+    for (const DrawGroup& group : _groups) {
+        pass->setPipeline(_pipelines[group.pipeline]);
+        pass->setBindGroup(MATERIAL_GROUP, _materials[group.pipeline * _config.materialCount + group.material]);
+        if (_config.instanced) {
+            pass->drawIndexed(mesh.indexCount, group.instanceCount, 0, 0, group.firstInstance);
+        } else {
+            for (uint32_t i = 0; i < group.instanceCount; ++i) {
+                pass->drawIndexed(mesh.indexCount, 1, 0, 0, group.firstInstance + i);
+            }
+        }
+    }
+
+    const pers::RenderPassEncoderStats stats = pass->getStats();
+    pass->end();
+    _gpuTimer->resolve(encoder);
+
+    auto commandBuffer = encoder->finish();
+    if (!commandBuffer) {
+        LOG_ERROR("SceneStressRenderer", "Failed to finish command encoder");
+        return {};
+    }
+    pers::SubmissionFence fence = _queue->submit(commandBuffer);
+    _gpuTimer->submitted();
+    if (_surfaceFramebuffer) {
+        _surfaceFramebuffer->present();
+    }
+
+    const uint64_t objectBytes = _objects->getBuffer().getStats().uploadedBytes;
+    frame.draws = stats.draws;
+    frame.pipelineSwitches = stats.pipelineSets - stats.pipelinesElided;
+    frame.bindGroupSwitches = stats.bindGroupSets - stats.bindGroupsElided;
+    frame.uploadedBytes = objectBytes - _lastObjectBytes + _meshStreamer->getStats().uploadedBytes;
+    _lastObjectBytes = objectBytes;
+    frame.cpuMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _frames.push_back(frame);
+
+    collectGpuTimes();
+    return fence;
+}
+
+void SceneStressRenderer::collectGpuTimes() {
+    // Frames whose results arrive together keep only the last one; collecting every frame keeps that rare
+    if (_gpuTimer->collect() == 0) {
+        return;
+    }
+    const pers::GpuFrameTiming& report = _gpuTimer->getLastReport();
+    if (report.frameIndex >= 1 && report.frameIndex <= _frames.size()) {
+        _frames[report.frameIndex - 1].gpuMs = report.totalMilliseconds;
+    }
+}
+
+void SceneStressRenderer::finish() {
+    if (!_device) {
+        return;
+    }
+    _device->waitIdle();
+    if (!hasGpuTiming()) {
+        return;
+    }
+    // Readbacks map asynchronously after the GPU is done
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        _instance->processEvents();
+        collectGpuTimes();
+        if (!_frames.empty() && _frames.back().gpuMs >= 0.0) {
+            break;
+        }
+    }
+}
+
+void SceneStressRenderer::onResize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    _config.width = static_cast<uint32_t>(width);
+    _config.height = static_cast<uint32_t>(height);
+    if (_surfaceFramebuffer) {
+        _surfaceFramebuffer->resize(_config.width, _config.height);
+    }
+    if (!_cameraBuffer || _objectData.empty()) {
+        return;
+    }
+
+    // Looking down at the grid from one side, far enough to fit it all
+    const glm::vec3 extent = _bunnyLayout.maxBounds - _bunnyLayout.minBounds;
+    const float size = std::max({extent.x, extent.y, extent.z, 0.001f});
+    const float radius = std::max(std::abs(_objectData.front().positionScale[0]), size) * 1.5f;
+    const glm::vec3 eye(0.0f, radius * 0.9f, radius * 1.3f);
+    const float aspect = static_cast<float>(width) / static_cast<float>(height);
+    const glm::mat4 viewProjection =
+        glm::perspectiveRH_ZO(glm::radians(60.0f), aspect, size * 0.1f, radius * 4.0f) *
+        glm::lookAtRH(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    _queue->writeBuffer(_cameraBuffer, 0, bytesOf(viewProjection));
+}
+
+bool SceneStressRenderer::hasGpuTiming() const {
+    return _gpuTimer && _gpuTimer->isActive();
+}
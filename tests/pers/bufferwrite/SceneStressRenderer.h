@@ -0,0 +1,147 @@
+#pragma once
+
+#include "MeshStreamer.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/graphics/SwapChainTypes.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace pers {
+    class IInstance;
+    class IPhysicalDevice;
+    class ILogicalDevice;
+    class IQueue;
+    class IBuffer;
+    class IBindGroup;
+    class IRenderPipeline;
+    class IFramebuffer;
+    class ISurfaceFramebuffer;
+    class ObjectDataBuffer;
+    class GpuPassTimer;
+    class RenderPassConfig;
+    class DeviceBufferHeap;
+}
+
+struct SceneStressConfig {
+    uint32_t instanceCount = 1000;      // 1 to MAX_INSTANCES bunnies on a grid
+    uint32_t pipelineCount = 1;         // Distinct fragment shaders, hence pipelines
+    uint32_t materialCount = 1;         // Distinct material bind groups per pipeline
+    float dynamicFraction = 0.1f;       // Instances whose transform changes every frame
+    bool instanced = false;             // One draw per pipeline/material group instead of per instance
+    uint32_t lod = 0;                   // Bunny level requested from the MeshStreamer
+
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    pers::TextureFormat colorFormat = pers::TextureFormat::BGRA8Unorm;
+    pers::TextureFormat depthFormat = pers::TextureFormat::Depth24PlusStencil8;
+    pers::PresentMode presentMode = pers::PresentMode::Immediate;  // Windowed only
+
+    static constexpr uint32_t MAX_INSTANCES = 100000;
+};
+
+// Measurements of one rendered frame
+struct SceneStressFrame {
+    uint32_t frame = 0;          // 1-based, warmup frames included
+    double cpuMs = 0.0;          // Scene update, encoding, submit and present
+    double gpuMs = -1.0;         // Scene pass GPU time, < 0 until or unless timestamps arrive
+    uint32_t draws = 0;
+    uint32_t pipelineSwitches = 0;
+    uint32_t bindGroupSwitches = 0;
+    uint64_t uploadedBytes = 0;  // Object data and streamed mesh bytes written this frame
+};
+
+// The bufferwrite scene scaled up: N bunnies from one streamed mesh, spread
+// over pipeline and material variants, each with its own record in an
+// ObjectDataBuffer. A fraction of them turn every frame, so object uploads
+// scale with the scene. Renders into the window's surface, or into an
+// OffscreenFramebuffer when initialized without one.
+//
+// Instances are allocated grouped by (pipeline, material), so their object
+// ids are contiguous per group and draws are issued in that order: per
+// instance with firstInstance = id, or instanced with one drawIndexed per
+// group. GPU time comes from a GpuPassTimer when the adapter has
+// timestamp queries.
+class SceneStressRenderer {
+public:
+    SceneStressRenderer();
+    ~SceneStressRenderer();
+
+    SceneStressRenderer(const SceneStressRenderer&) = delete;
+    SceneStressRenderer& operator=(const SceneStressRenderer&) = delete;
+
+    // Invalid surface = headless
+    bool initialize(const std::shared_ptr<pers::IInstance>& instance,
+                    const pers::NativeSurfaceHandle& surface,
+                    const SceneStressConfig& config);
+
+    // Render and record one frame; the fence of its submission, for frame pacing
+    pers::SubmissionFence renderFrame();
+
+    // Wait for the GPU and pick up GPU times of the frames still in flight
+    void finish();
+
+    // Every frame rendered so far, in order
+    const std::vector<SceneStressFrame>& getFrames() const { return _frames; }
+
+    void onResize(int width, int height);
+
+    bool hasGpuTiming() const;
+    const SceneStressConfig& getConfig() const { return _config; }
+    std::string getAdapterName() const { return _adapterName; }
+
+private:
+    struct ObjectConstants {
+        float positionScale[4];  // xyz position, w scale
+        float rotation[4];       // x yaw, y yaw per frame, zw unused
+    };
+
+    struct DrawGroup {
+        uint32_t pipeline = 0;
+        uint32_t material = 0;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+    };
+
+    bool createDevice(const pers::NativeSurfaceHandle& surface);
+    bool createMesh();
+    bool createPipelines();
+    bool createScene();
+    void updateObjects();
+    void collectGpuTimes();
+
+    SceneStressConfig _config;
+    std::shared_ptr<pers::IInstance> _instance;
+    std::shared_ptr<pers::IPhysicalDevice> _physicalDevice;
+    std::shared_ptr<pers::ILogicalDevice> _device;
+    std::shared_ptr<pers::IQueue> _queue;
+    std::string _adapterName;
+
+    std::shared_ptr<pers::ISurfaceFramebuffer> _surfaceFramebuffer;
+    std::shared_ptr<pers::IFramebuffer> _offscreenFramebuffer;
+    std::unique_ptr<pers::RenderPassConfig> _renderPassConfig;
+    std::unique_ptr<pers::GpuPassTimer> _gpuTimer;
+
+    std::shared_ptr<pers::DeviceBufferHeap> _vertexHeap;
+    std::shared_ptr<pers::DeviceBufferHeap> _indexHeap;
+    std::unique_ptr<MeshStreamer> _meshStreamer;
+    StreamedMeshHandle _bunny;
+    MeshData _bunnyLayout;
+
+    std::unique_ptr<pers::ObjectDataBuffer> _objects;
+    std::vector<ObjectConstants> _objectData;  // CPU copy, indexed by object id
+    std::shared_ptr<pers::IBuffer> _cameraBuffer;
+    std::shared_ptr<pers::IBindGroup> _cameraBindGroup;
+    std::vector<std::shared_ptr<pers::IBuffer>> _materialBuffers;
+    std::vector<std::shared_ptr<pers::IBindGroup>> _materials;
+    std::vector<std::shared_ptr<pers::IRenderPipeline>> _pipelines;
+    std::vector<DrawGroup> _groups;
+
+    std::vector<uint32_t> _dynamicIds;  // Spread over the whole scene, not one contiguous range
+    uint64_t _lastObjectBytes = 0;
+    uint64_t _lastMeshBytes = 0;
+    std::vector<SceneStressFrame> _frames;
+};
@@ -0,0 +1,365 @@
+#include "SoakApp.h"
+#include "pers/graphics/GpuMemoryTracker.h"
+#include "pers/utils/Logger.h"
+#include "pers/utils/Metrics.h"
+#include "pers/utils/ProcessMemory.h"
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+
+namespace {
+
+// Frames in a row that may fail to render before the run is abandoned
+constexpr uint32_t MAX_FAILED_FRAMES = 100;
+
+// Post-warmup samples needed before quarters say anything
+constexpr size_t MIN_TREND_SAMPLES = 8;
+
+constexpr double MEGABYTE = 1024.0 * 1024.0;
+
+// Frame time drift below this is noise whatever the relative change
+constexpr double MIN_FRAME_DRIFT_MS = 1.0;
+
+// Nearest-rank percentile of sorted values
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    return percentile(values, 0.5);
+}
+
+// A level checked for growth over the run
+struct TrendMetric {
+    const char* name;
+    double slack;  // Absolute growth always tolerated, in the metric's unit
+    std::function<double(const SoakSample&)> value;
+};
+
+std::vector<TrendMetric> trendMetrics() {
+    return {
+        {"resident_bytes", 32.0 * MEGABYTE, [](const SoakSample& s) { return static_cast<double>(s.residentBytes); }},
+        {"gpu_tracked_bytes", 8.0 * MEGABYTE, [](const SoakSample& s) { return static_cast<double>(s.gpuTrackedBytes); }},
+        {"live_buffers", 16.0, [](const SoakSample& s) { return static_cast<double>(s.liveBuffers); }},
+        {"live_textures", 16.0, [](const SoakSample& s) { return static_cast<double>(s.liveTextures); }},
+        {"live_render_pipelines", 4.0, [](const SoakSample& s) { return static_cast<double>(s.liveRenderPipelines); }},
+        {"live_bind_groups", 32.0, [](const SoakSample& s) { return static_cast<double>(s.liveBindGroups); }},
+        {"heap_allocated_bytes", 4.0 * MEGABYTE,
+            [](const SoakSample& s) { return static_cast<double>(s.resources.heap.allocatedBytes); }},
+        {"staging_pooled_bytes", 4.0 * MEGABYTE,
+            [](const SoakSample& s) { return static_cast<double>(s.resources.staging.pooledBytes); }},
+        {"texture_pool_free", 8.0,
+            [](const SoakSample& s) { return static_cast<double>(s.resources.texturePool.freeTextures); }},
+        {"deletion_pending", 64.0,
+            [](const SoakSample& s) { return static_cast<double>(s.resources.deletion.pending); }},
+    };
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+SoakApp::SoakApp(const SoakOptions& options)
+    : _options(options) {
+    _windowTitle = "PERS Soak";
+    _windowWidth = static_cast<int>(options.workload.width);
+    _windowHeight = static_cast<int>(options.workload.height);
+}
+
+SoakApp::~SoakApp() = default;
+
+bool SoakApp::onInitialize() {
+    SoakConfig config = _options.workload;
+    pers::NativeSurfaceHandle surface;
+    if (!isHeadless()) {
+        const glm::ivec2 size = getFramebufferSize();
+        config.width = static_cast<uint32_t>(size.x);
+        config.height = static_cast<uint32_t>(size.y);
+        surface = createSurface();
+        if (!surface.isValid()) {
+            LOG_ERROR("SoakApp", "Failed to create surface");
+            return false;
+        }
+    }
+
+    _renderer = std::make_unique<SoakRenderer>();
+    if (!_renderer->initialize(getInstance(), surface, config)) {
+        LOG_ERROR("SoakApp", "Failed to initialize renderer");
+        return false;
+    }
+
+    if (!_options.csvPath.empty()) {
+        _csv.open(_options.csvPath);
+        if (!_csv) {
+            LOG_ERROR("SoakApp", "Failed to open " + _options.csvPath);
+            return false;
+        }
+        _csv << "elapsed_s,frames,frame_p50_ms,frame_p95_ms,frame_p99_ms,frame_max_ms,"
+                "rss_bytes,gpu_tracked_bytes,live_buffers,live_textures,live_render_pipelines,live_bind_groups,"
+                "heap_pages,heap_reserved_bytes,heap_allocated_bytes,heap_free_blocks,heap_largest_free_block,"
+                "staging_pooled_bytes,staging_in_flight,texture_pool_free,deletion_pending\n";
+        _csv << std::fixed << std::setprecision(3);
+    }
+    return true;
+}
+
+void SoakApp::onRender() {
+    if (!_renderer || _completed) {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (!_started) {
+        _start = now;
+        _started = true;
+    } else {
+        _frameTimes.push_back(std::chrono::duration<double, std::milli>(now - _lastFrame).count());
+    }
+    _lastFrame = now;
+
+    const pers::SubmissionFence fence = _renderer->renderFrame();
+    if (!fence) {
+        if (++_failedFrames >= MAX_FAILED_FRAMES) {
+            LOG_ERROR("SoakApp", "Too many frames failed to render, giving up");
+            requestExit();
+        }
+        return;
+    }
+    getFramePacer().trackSubmission(fence);
+    _failedFrames = 0;
+    ++_frames;
+
+    const double elapsed = std::chrono::duration<double>(Clock::now() - _start).count();
+    if (elapsed - _lastSampleSeconds >= _options.sampleSeconds) {
+        _lastSampleSeconds = elapsed;
+        _samples.push_back(takeSample(elapsed));
+        writeCsvRow(_samples.back());
+
+        const SoakSample& sample = _samples.back();
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "SoakApp", PERS_SOURCE_LOC,
+            "%.1f min: RSS %.1f MB, GPU %.1f MB, heap %.1f/%.1f MB, frame p99 %.2f ms",
+            elapsed / 60.0, static_cast<double>(sample.residentBytes) / MEGABYTE,
+            static_cast<double>(sample.gpuTrackedBytes) / MEGABYTE,
+            static_cast<double>(sample.resources.heap.allocatedBytes) / MEGABYTE,
+            static_cast<double>(sample.resources.heap.reservedBytes) / MEGABYTE, sample.frameP99);
+    }
+
+    if (elapsed < _options.durationSeconds) {
+        return;
+    }
+
+    // Settled state: everything retired has been released
+    _renderer->finish();
+    _samples.push_back(takeSample(elapsed));
+    writeCsvRow(_samples.back());
+    analyze();
+    writeJson();
+    _completed = true;
+
+    if (_findings.empty()) {
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "SoakApp", PERS_SOURCE_LOC,
+            "Soak finished after %.1f min and %llu frames without findings",
+            elapsed / 60.0, static_cast<unsigned long long>(_frames));
+    }
+    requestExit();
+}
+
+SoakSample SoakApp::takeSample(double elapsedSeconds) {
+    SoakSample sample;
+    sample.elapsedSeconds = elapsedSeconds;
+    sample.frames = _frames;
+
+    std::sort(_frameTimes.begin(), _frameTimes.end());
+    sample.frameP50 = percentile(_frameTimes, 0.50);
+    sample.frameP95 = percentile(_frameTimes, 0.95);
+    sample.frameP99 = percentile(_frameTimes, 0.99);
+    sample.frameMax = _frameTimes.empty() ? 0.0 : _frameTimes.back();
+    _frameTimes.clear();
+
+    sample.residentBytes = pers::getProcessMemoryInfo().residentBytes;
+    sample.gpuTrackedBytes = pers::GpuMemoryTracker::instance().getUsage();
+    sample.liveBuffers = pers::Metrics::gauge("pers_buffers_live").value();
+    sample.liveTextures = pers::Metrics::gauge("pers_textures_live").value();
+    sample.liveRenderPipelines = pers::Metrics::gauge("pers_render_pipelines_live").value();
+    sample.liveBindGroups = pers::Metrics::gauge("pers_bind_groups_live").value();
+    sample.resources = _renderer->getResourceStats();
+    return sample;
+}
+
+void SoakApp::writeCsvRow(const SoakSample& sample) {
+    if (!_csv.is_open()) {
+        return;
+    }
+    const SoakResourceStats& r = sample.resources;
+    _csv << sample.elapsedSeconds << ',' << sample.frames << ','
+         << sample.frameP50 << ',' << sample.frameP95 << ',' << sample.frameP99 << ',' << sample.frameMax << ','
+         << sample.residentBytes << ',' << sample.gpuTrackedBytes << ','
+         << sample.liveBuffers << ',' << sample.liveTextures << ','
+         << sample.liveRenderPipelines << ',' << sample.liveBindGroups << ','
+         << r.heap.pageCount << ',' << r.heap.reservedBytes << ',' << r.heap.allocatedBytes << ','
+         << r.heap.freeBlockCount << ',' << r.heap.largestFreeBlock << ','
+         << r.staging.pooledBytes << ',' << r.staging.inFlight << ','
+         << r.texturePool.freeTextures << ',' << r.deletion.pending << '\n';
+    // Flushed per row, so a run that dies after hours still left its record
+    _csv.flush();
+}
+
+void SoakApp::analyze() {
+    std::vector<SoakSample> trend;
+    for (const SoakSample& sample : _samples) {
+        if (sample.elapsedSeconds >= _options.warmupSeconds) {
+            trend.push_back(sample);
+        }
+    }
+    if (trend.size() < MIN_TREND_SAMPLES) {
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Warning, "SoakApp", PERS_SOURCE_LOC,
+            "Only %zu samples after warmup, at least %zu are needed for trend analysis",
+            trend.size(), MIN_TREND_SAMPLES);
+        return;
+    }
+
+    const size_t quarter = trend.size() / 4;
+    const auto early = [&](const std::function<double(const SoakSample&)>& value) {
+        double highest = value(trend.front());
+        for (size_t i = 0; i < quarter; ++i) {
+            highest = std::max(highest, value(trend[i]));
+        }
+        return highest;
+    };
+    const auto late = [&](const std::function<double(const SoakSample&)>& value) {
+        double lowest = value(trend.back());
+        for (size_t i = trend.size() - quarter; i < trend.size(); ++i) {
+            lowest = std::min(lowest, value(trend[i]));
+        }
+        return lowest;
+    };
+    const auto grew = [&](double before, double after, double slack) {
+        return after > before * (1.0 + _options.tolerance) + slack;
+    };
+
+    for (const TrendMetric& metric : trendMetrics()) {
+        const double before = early(metric.value);
+        const double after = late(metric.value);
+        if (grew(before, after, metric.slack)) {
+            _findings.push_back({metric.name, "leak", before, after});
+        }
+    }
+
+    // Pages piling up while the bytes in use stay level: free space the buddy
+    // allocator cannot hand out any more
+    const auto reserved = [](const SoakSample& s) { return static_cast<double>(s.resources.heap.reservedBytes); };
+    const auto allocated = [](const SoakSample& s) { return static_cast<double>(s.resources.heap.allocatedBytes); };
+    const double reservedBefore = early(reserved);
+    const double reservedAfter = late(reserved);
+    if (grew(reservedBefore, reservedAfter, 0.0) && !grew(early(allocated), late(allocated), 4.0 * MEGABYTE)) {
+        _findings.push_back({"heap_reserved_bytes", "fragmentation", reservedBefore, reservedAfter});
+    }
+
+    std::vector<double> earlyP99;
+    std::vector<double> lateP99;
+    for (size_t i = 0; i < quarter; ++i) {
+        earlyP99.push_back(trend[i].frameP99);
+        lateP99.push_back(trend[trend.size() - quarter + i].frameP99);
+    }
+    const double p99Before = median(earlyP99);
+    const double p99After = median(lateP99);
+    if (p99After > p99Before * (1.0 + _options.frameTolerance) && p99After - p99Before > MIN_FRAME_DRIFT_MS) {
+        _findings.push_back({"frame_p99_ms", "frame_time", p99Before, p99After});
+    }
+
+    for (const SoakFinding& finding : _findings) {
+        pers::Logger::Instance().LogFormat(pers::LogLevel::Warning, "SoakApp", PERS_SOURCE_LOC,
+            "%s: %s grew from %.1f to %.1f", finding.kind.c_str(), finding.metric.c_str(),
+            finding.early, finding.late);
+    }
+}
+
+bool SoakApp::writeJson() const {
+    if (_options.jsonPath.empty()) {
+        return true;
+    }
+    std::ofstream out(_options.jsonPath);
+    if (!out) {
+        LOG_ERROR("SoakApp", "Failed to open " + _options.jsonPath);
+        return false;
+    }
+
+    const SoakConfig& workload = _renderer->getConfig();
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"config\": {\n";
+    out << "    \"duration_s\": " << _options.durationSeconds << ",\n";
+    out << "    \"sample_s\": " << _options.sampleSeconds << ",\n";
+    out << "    \"warmup_s\": " << _options.warmupSeconds << ",\n";
+    out << "    \"tolerance\": " << _options.tolerance << ",\n";
+    out << "    \"frame_tolerance\": " << _options.frameTolerance << ",\n";
+    out << "    \"buffers_per_frame\": " << workload.buffersPerFrame << ",\n";
+    out << "    \"max_buffer_lifetime\": " << workload.maxBufferLifetime << ",\n";
+    out << "    \"max_buffer_size\": " << workload.maxBufferSize << ",\n";
+    out << "    \"textures_per_frame\": " << workload.texturesPerFrame << ",\n";
+    out << "    \"pipeline_interval\": " << workload.pipelineInterval << ",\n";
+    out << "    \"resize_interval\": " << workload.resizeInterval << ",\n";
+    out << "    \"headless\": " << (isHeadless() ? "true" : "false") << "\n";
+    out << "  },\n";
+    out << "  \"adapter\": \"" << escapeJson(_renderer->getAdapterName()) << "\",\n";
+    out << "  \"frames\": " << _frames << ",\n";
+    out << "  \"samples\": " << _samples.size() << ",\n";
+    if (!_samples.empty()) {
+        const SoakSample& last = _samples.back();
+        out << "  \"final\": {\n";
+        out << "    \"rss_bytes\": " << last.residentBytes << ",\n";
+        out << "    \"peak_rss_bytes\": " << pers::getProcessMemoryInfo().peakResidentBytes << ",\n";
+        out << "    \"gpu_tracked_bytes\": " << last.gpuTrackedBytes << ",\n";
+        out << "    \"gpu_peak_bytes\": " << pers::GpuMemoryTracker::instance().getStats().peakBytes << ",\n";
+        out << "    \"live_buffers\": " << last.liveBuffers << ",\n";
+        out << "    \"live_textures\": " << last.liveTextures << ",\n";
+        out << "    \"live_render_pipelines\": " << last.liveRenderPipelines << ",\n";
+        out << "    \"live_bind_groups\": " << last.liveBindGroups << ",\n";
+        out << "    \"heap_reserved_bytes\": " << last.resources.heap.reservedBytes << ",\n";
+        out << "    \"heap_allocated_bytes\": " << last.resources.heap.allocatedBytes << ",\n";
+        out << "    \"heap_largest_free_block\": " << last.resources.heap.largestFreeBlock << "\n";
+        out << "  },\n";
+    }
+    out << "  \"findings\": [";
+    for (size_t i = 0; i < _findings.size(); ++i) {
+        const SoakFinding& finding = _findings[i];
+        out << (i ? ",\n" : "\n") << "    {\"metric\": \"" << escapeJson(finding.metric)
+            << "\", \"kind\": \"" << finding.kind << "\", \"early\": " << finding.early
+            << ", \"late\": " << finding.late << "}";
+    }
+    out << (_findings.empty() ? "]\n" : "\n  ]\n");
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+void SoakApp::onResize(int width, int height) {
+    if (_renderer) {
+        _renderer->onResize(width, height);
+    }
+}
+
+void SoakApp::onCleanup() {
+    _renderer.reset();
+    _csv.close();
+}
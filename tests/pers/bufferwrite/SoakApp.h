@@ -0,0 +1,92 @@
+#pragma once
+
+#include "SoakRenderer.h"
+#include "pers/core/Application.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct SoakOptions {
+    SoakConfig workload;
+    double durationSeconds = 4.0 * 3600.0;
+    double sampleSeconds = 10.0;    // One CSV row per interval
+    double warmupSeconds = 120.0;   // Left out of the trend analysis while caches and pools fill
+    double tolerance = 0.10;        // Relative growth of a level treated as a trend
+    double frameTolerance = 0.50;   // Relative growth of the frame time p99
+    bool headless = false;
+    std::string csvPath = "soak.csv";    // Written as the run goes, one row per sample
+    std::string jsonPath = "soak.json";  // Configuration, final sample and findings, empty = none
+};
+
+// One row of the soak record
+struct SoakSample {
+    double elapsedSeconds = 0.0;
+    uint64_t frames = 0;           // Rendered so far
+    double frameP50 = 0.0;         // Frame interval percentiles over the sample, ms
+    double frameP95 = 0.0;
+    double frameP99 = 0.0;
+    double frameMax = 0.0;
+    uint64_t residentBytes = 0;
+    uint64_t gpuTrackedBytes = 0;  // GpuMemoryTracker total
+    int64_t liveBuffers = 0;       // pers_*_live gauges
+    int64_t liveTextures = 0;
+    int64_t liveRenderPipelines = 0;
+    int64_t liveBindGroups = 0;
+    SoakResourceStats resources;
+};
+
+// A level that kept growing after warmup, or frame times that drifted
+struct SoakFinding {
+    std::string metric;
+    std::string kind;    // "leak", "fragmentation" or "frame_time"
+    double early = 0.0;  // Highest value of the first quarter after warmup
+    double late = 0.0;   // Lowest value of the last quarter
+};
+
+// Runs the soak workload for a fixed wall-clock duration, sampling process,
+// GPU and pool state every interval. At the end, the samples after warmup
+// are split in quarters: a level whose lowest value in the last quarter is
+// above its highest in the first (beyond tolerance and a small absolute
+// slack) grew the whole run, which frame-to-frame churn cannot explain.
+// The heap counts as fragmented when its reserved pages grew that way but
+// the bytes handed out did not.
+class SoakApp : public pers::Application {
+public:
+    explicit SoakApp(const SoakOptions& options);
+    ~SoakApp() override;
+
+    // True once the run completed; findings say whether it was clean
+    bool completed() const { return _completed; }
+    const std::vector<SoakFinding>& getFindings() const { return _findings; }
+
+protected:
+    bool onInitialize() override;
+    void onRender() override;
+    void onResize(int width, int height) override;
+    void onCleanup() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    SoakSample takeSample(double elapsedSeconds);
+    void writeCsvRow(const SoakSample& sample);
+    void analyze();
+    bool writeJson() const;
+
+    SoakOptions _options;
+    std::unique_ptr<SoakRenderer> _renderer;
+    std::ofstream _csv;
+
+    Clock::time_point _start;
+    Clock::time_point _lastFrame;
+    double _lastSampleSeconds = 0.0;
+    std::vector<double> _frameTimes;  // Since the last sample
+    uint64_t _frames = 0;
+    uint32_t _failedFrames = 0;       // In a row
+    std::vector<SoakSample> _samples;
+    std::vector<SoakFinding> _findings;
+    bool _started = false;
+    bool _completed = false;
+};
@@ -0,0 +1,444 @@
+#include "SoakRenderer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/RenderPassConfig.h"
+#include "pers/graphics/SurfaceFramebuffer.h"
+#include "pers/graphics/SwapChainDescBuilder.h"
+#include "pers/utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+
+namespace {
+
+// Every this many heap ranges also gets a bind group over its first bytes
+constexpr uint32_t BIND_GROUP_STRIDE = 4;
+constexpr uint64_t TINT_SIZE = 16;
+
+// Transient textures are held for 1 to this many frames
+constexpr uint32_t MAX_TEXTURE_LIFETIME = 8;
+
+const char* const VERTEX_SHADER = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.5, 1.0);
+}
+)";
+
+// Prefixed with a distinct VARIANT, so every new pipeline is a real compilation
+const char* const FRAGMENT_SHADER = R"(
+@group(0) @binding(0) var<uniform> tint: vec4<f32>;
+
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    let shade = fract(f32(VARIANT) * 0.618034 + position.x * 0.001);
+    return vec4<f32>(tint.rgb * shade, 0.25);
+}
+)";
+
+} // namespace
+
+SoakRenderer::SoakRenderer() = default;
+
+SoakRenderer::~SoakRenderer() {
+    if (_device) {
+        _device->waitIdle();
+    }
+    // Views and pooled textures go back before their heap and pool
+    _ranges.clear();
+    _textures.clear();
+    _pipelines.clear();
+    _target.reset();
+    if (_deletionQueue) {
+        _deletionQueue->flush();
+    }
+    _heap.reset();
+    _texturePool.reset();
+}
+
+bool SoakRenderer::initialize(const std::shared_ptr<pers::IInstance>& instance,
+                              const pers::NativeSurfaceHandle& surface,
+                              const SoakConfig& config) {
+    _config = config;
+    _instance = instance;
+    if (!_instance) {
+        LOG_ERROR("SoakRenderer", "Invalid instance provided");
+        return false;
+    }
+
+    _config.maxBufferLifetime = std::max(_config.maxBufferLifetime, 1u);
+    _config.maxBufferSize = std::max(_config.maxBufferSize, pers::DeviceBufferHeap::MIN_BLOCK_SIZE);
+    _config.maxPipelines = std::max(_config.maxPipelines, 1u);
+    _random.seed(_config.seed);
+
+    return createDevice(surface) && createResources() && createPipeline();
+}
+
+bool SoakRenderer::createDevice(const pers::NativeSurfaceHandle& surface) {
+    pers::PhysicalDeviceOptions options;
+    options.powerPreference = pers::PowerPreference::HighPerformance;
+    if (surface.isValid()) {
+        options.compatibleSurface = surface;
+    }
+    _physicalDevice = _instance->requestPhysicalDevice(options);
+    if (!_physicalDevice) {
+        LOG_ERROR("SoakRenderer", "Failed to get physical device");
+        return false;
+    }
+    _adapterName = _physicalDevice->getCapabilities().deviceName;
+
+    // Validation off: hours of validation bookkeeping would dominate the memory profile
+    pers::LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = false;
+    deviceDesc.debugName = "SoakDevice";
+    _device = _physicalDevice->createLogicalDevice(deviceDesc);
+    if (!_device) {
+        LOG_ERROR("SoakRenderer", "Failed to create logical device");
+        return false;
+    }
+    _queue = _device->getQueue();
+    _deletionQueue = _device->getDeletionQueue();
+    if (!_queue || !_deletionQueue) {
+        LOG_ERROR("SoakRenderer", "Failed to get queue from device");
+        return false;
+    }
+
+    if (surface.isValid()) {
+        auto surfaceFramebuffer = std::make_shared<pers::SurfaceFramebuffer>(_device);
+        const pers::SwapChainDesc swapChainDesc = pers::SwapChainDescBuilder()
+            .setSize(_config.width, _config.height)
+            .setFormat(_config.colorFormat)
+            .setPresentMode(_config.presentMode)
+            .setUsage(pers::TextureUsage::RenderAttachment)
+            .setDebugName("SoakSwapChain")
+            .build();
+        if (!surfaceFramebuffer->create(surface, swapChainDesc, _config.depthFormat)) {
+            LOG_ERROR("SoakRenderer", "Failed to create swap chain");
+            return false;
+        }
+        _surfaceFramebuffer = surfaceFramebuffer;
+    }
+    return true;
+}
+
+bool SoakRenderer::createResources() {
+    const auto& factory = _device->getResourceFactory();
+
+    _texturePool = std::make_shared<pers::TransientTexturePool>(factory);
+    pers::OffscreenFramebufferConfig targetConfig;
+    targetConfig.width = _config.width;
+    targetConfig.height = _config.height;
+    targetConfig.colorFormats = {_config.colorFormat};
+    targetConfig.depthFormat = _config.depthFormat;
+    _target = std::make_shared<pers::OffscreenFramebuffer>(factory, targetConfig, _texturePool);
+
+    // Small pages, so page creation and trimming are part of the churn
+    _heap = std::make_shared<pers::DeviceBufferHeap>(factory,
+        pers::BufferUsage::Vertex | pers::BufferUsage::Uniform, 16ull * 1024 * 1024, "SoakHeap");
+    _scratch.resize(static_cast<size_t>(_config.maxBufferSize));
+    for (size_t i = 0; i < _scratch.size(); ++i) {
+        _scratch[i] = static_cast<uint8_t>(i * 37u);
+    }
+
+    pers::BindGroupLayoutDesc tintLayoutDesc;
+    tintLayoutDesc.entries.push_back({});
+    tintLayoutDesc.entries[0].binding = 0;
+    tintLayoutDesc.entries[0].type = pers::BindingType::UniformBuffer;
+    tintLayoutDesc.entries[0].visibility = pers::ShaderStage::Fragment;
+    tintLayoutDesc.entries[0].minBindingSize = TINT_SIZE;
+    tintLayoutDesc.debugName = "SoakTintLayout";
+    _tintLayout = factory->createBindGroupLayout(tintLayoutDesc);
+    if (!_tintLayout) {
+        LOG_ERROR("SoakRenderer", "Failed to create bind group layout");
+        return false;
+    }
+
+    pers::PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {_tintLayout};
+    pipelineLayoutDesc.debugName = "SoakPipelineLayout";
+    _pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!_pipelineLayout) {
+        LOG_ERROR("SoakRenderer", "Failed to create pipeline layout");
+        return false;
+    }
+
+    pers::ShaderModuleDesc vertexDesc;
+    vertexDesc.code = VERTEX_SHADER;
+    vertexDesc.stage = pers::ShaderStage::Vertex;
+    vertexDesc.entryPoint = "main";
+    vertexDesc.debugName = "SoakVertexShader";
+    _vertexShader = factory->createShaderModule(vertexDesc);
+    if (!_vertexShader) {
+        LOG_ERROR("SoakRenderer", "Failed to create vertex shader");
+        return false;
+    }
+
+    _targetPassConfig = std::make_unique<pers::RenderPassConfig>();
+    pers::RenderPassConfig::ColorConfig colorConfig;
+    colorConfig.loadOp = pers::LoadOp::Clear;
+    colorConfig.storeOp = pers::StoreOp::Store;
+    colorConfig.clearColor = {0.05, 0.05, 0.08, 1.0};
+    _targetPassConfig->addColorAttachment(colorConfig);
+    pers::RenderPassConfig::DepthStencilConfig depthConfig;
+    depthConfig.depthLoadOp = pers::LoadOp::Clear;
+    depthConfig.depthStoreOp = pers::StoreOp::Discard;
+    depthConfig.depthClearValue = 1.0f;
+    _targetPassConfig->setDepthStencilConfig(depthConfig);
+    _targetPassConfig->setLabel("SoakTargetPass");
+
+    _surfacePassConfig = std::make_unique<pers::RenderPassConfig>();
+    _surfacePassConfig->addColorAttachment(colorConfig);
+    _surfacePassConfig->setDepthStencilConfig(depthConfig);
+    _surfacePassConfig->setLabel("SoakSurfacePass");
+    return true;
+}
+
+bool SoakRenderer::createPipeline() {
+    const auto& factory = _device->getResourceFactory();
+    const uint32_t variant = _pipelineVariant++;
+
+    pers::ShaderModuleDesc fragmentDesc;
+    fragmentDesc.code = "const VARIANT: u32 = " + std::to_string(variant) + "u;\n" + FRAGMENT_SHADER;
+    fragmentDesc.stage = pers::ShaderStage::Fragment;
+    fragmentDesc.entryPoint = "main";
+    fragmentDesc.debugName = "SoakFragmentShader" + std::to_string(variant);
+    auto fragmentShader = factory->createShaderModule(fragmentDesc);
+    if (!fragmentShader) {
+        LOG_ERROR("SoakRenderer", "Failed to create fragment shader");
+        return false;
+    }
+
+    pers::RenderPipelineDesc pipelineDesc;
+    pipelineDesc.vertex = _vertexShader;
+    pipelineDesc.fragment = fragmentShader;
+    pipelineDesc.layout = _pipelineLayout;
+    pipelineDesc.debugName = "SoakPipeline" + std::to_string(variant);
+    pipelineDesc.primitive.topology = pers::PrimitiveTopology::TriangleList;
+    pipelineDesc.primitive.cullMode = pers::CullMode::None;
+
+    pers::ColorTargetState colorTarget;
+    colorTarget.format = _config.colorFormat;
+    colorTarget.writeMask = pers::ColorWriteMask::All;
+    pipelineDesc.colorTargets.push_back(colorTarget);
+    pipelineDesc.multisample.count = 1;
+    pipelineDesc.depthStencil.format = _config.depthFormat;
+    pipelineDesc.depthStencil.depthWriteEnabled = false;
+    pipelineDesc.depthStencil.depthCompare = pers::CompareFunction::Always;
+
+    auto pipeline = factory->createRenderPipeline(pipelineDesc);
+    if (!pipeline) {
+        LOG_ERROR("SoakRenderer", "Failed to create render pipeline");
+        return false;
+    }
+    _pipelines.push_back(pipeline);
+
+    // Previous frames may still draw with the oldest one
+    while (_pipelines.size() > _config.maxPipelines) {
+        _deletionQueue->retire(std::move(_pipelines.front()));
+        _pipelines.erase(_pipelines.begin());
+    }
+    return true;
+}
+
+void SoakRenderer::churnBuffers() {
+    // Retire expired ranges; submitted frames may still read them
+    auto expired = std::partition(_ranges.begin(), _ranges.end(),
+                                  [&](const LiveRange& range) { return range.expiresAt > _frame; });
+    for (auto it = expired; it != _ranges.end(); ++it) {
+        if (it->bindGroup) {
+            _deletionQueue->retire(std::move(it->bindGroup));
+        }
+        _deletionQueue->retire(std::move(it->view));
+    }
+    _ranges.erase(expired, _ranges.end());
+
+    // Log-uniform sizes, so small and large blocks interleave in the buddy heap
+    const double maxLog = std::log2(static_cast<double>(_config.maxBufferSize));
+    const double minLog = std::log2(static_cast<double>(pers::DeviceBufferHeap::MIN_BLOCK_SIZE));
+    std::uniform_real_distribution<double> sizeLog(minLog, maxLog);
+    std::uniform_int_distribution<uint32_t> lifetime(1, _config.maxBufferLifetime);
+    const auto& factory = _device->getResourceFactory();
+
+    for (uint32_t i = 0; i < _config.buffersPerFrame; ++i) {
+        const uint64_t size = std::min<uint64_t>(
+            static_cast<uint64_t>(std::exp2(sizeLog(_random))) & ~uint64_t(3), _config.maxBufferSize);
+        LiveRange range;
+        range.view = _heap->allocate(std::max<uint64_t>(size, TINT_SIZE));
+        if (!range.view) {
+            continue;
+        }
+        const std::span<const std::byte> data(reinterpret_cast<const std::byte*>(_scratch.data()),
+                                              static_cast<size_t>(range.view->getSize()));
+        _queue->writeBuffer(range.view, 0, data);
+
+        if (_ranges.size() % BIND_GROUP_STRIDE == 0) {
+            pers::BindGroupDesc bindGroupDesc;
+            bindGroupDesc.layout = _tintLayout;
+            bindGroupDesc.entries.push_back({});
+            bindGroupDesc.entries[0].binding = 0;
+            bindGroupDesc.entries[0].buffer = range.view;
+            bindGroupDesc.entries[0].size = TINT_SIZE;
+            bindGroupDesc.debugName = "SoakTint";
+            range.bindGroup = factory->createBindGroup(bindGroupDesc);
+        }
+        range.expiresAt = _frame + lifetime(_random);
+        _ranges.push_back(std::move(range));
+    }
+}
+
+void SoakRenderer::churnTextures() {
+    auto expired = std::partition(_textures.begin(), _textures.end(),
+                                  [&](const LiveTexture& texture) { return texture.expiresAt > _frame; });
+    for (auto it = expired; it != _textures.end(); ++it) {
+        _texturePool->release(std::move(it->texture));
+    }
+    _textures.erase(expired, _textures.end());
+
+    std::uniform_int_distribution<uint32_t> sizeShift(0, 4);
+    std::uniform_int_distribution<uint32_t> lifetime(1, MAX_TEXTURE_LIFETIME);
+    for (uint32_t i = 0; i < _config.texturesPerFrame; ++i) {
+        pers::TextureDesc desc;
+        desc.width = 64u << sizeShift(_random);
+        desc.height = 64u << sizeShift(_random);
+        desc.format = pers::TextureFormat::RGBA8Unorm;
+        desc.usage = pers::TextureUsage::RenderAttachment | pers::TextureUsage::TextureBinding;
+        desc.label = "SoakTransient";
+
+        LiveTexture texture;
+        texture.texture = _texturePool->acquire(desc);
+        if (!texture.texture) {
+            continue;
+        }
+        texture.expiresAt = _frame + lifetime(_random);
+        _textures.push_back(std::move(texture));
+    }
+}
+
+void SoakRenderer::resizeTarget() {
+    // Full, three quarter and half size in turn, back and forth through the pool
+    static constexpr uint32_t SCALES[] = {4, 3, 2, 3};
+    const uint32_t scale = SCALES[++_resizeStep % std::size(SCALES)];
+    _target->resize(std::max(_config.width * scale / 4, 1u), std::max(_config.height * scale / 4, 1u));
+
+    // Hand back pages emptied since the last resize, so new ones get created later
+    _heap->trim();
+}
+
+pers::SubmissionFence SoakRenderer::renderFrame() {
+    if (!_device || !_target) {
+        return {};
+    }
+    ++_frame;
+
+    if (_config.pipelineInterval > 0 && _frame % _config.pipelineInterval == 0) {
+        createPipeline();
+    }
+    if (_config.resizeInterval > 0 && _frame % _config.resizeInterval == 0) {
+        resizeTarget();
+    }
+    churnBuffers();
+    churnTextures();
+
+    if (_surfaceFramebuffer && !_surfaceFramebuffer->acquireNextImage()) {
+        return {};
+    }
+
+    auto encoder = _device->createCommandEncoder();
+    if (!encoder) {
+        LOG_ERROR("SoakRenderer", "Failed to create command encoder");
+        return {};
+    }
+
+    auto pass = encoder->beginRenderPass(_targetPassConfig->makeDescriptor(_target));
+    if (!pass) {
+        LOG_ERROR("SoakRenderer", "Failed to begin target render pass");
+        return {};
+    }
+    // One draw per pipeline, each through the bind group of a live range
+    size_t source = _frame % std::max<size_t>(_ranges.size(), 1);
+    for (const auto& pipeline : _pipelines) {
+        for (size_t tried = 0; tried < _ranges.size() && !_ranges[source].bindGroup; ++tried) {
+            source = (source + 1) % _ranges.size();
+        }
+        if (_ranges.empty() || !_ranges[source].bindGroup) {
+            break;
+        }
+        pass->setPipeline(pipeline);
+        pass->setBindGroup(0, _ranges[source].bindGroup);
+        pass->draw(3);
+        source = (source + 1) % _ranges.size();
+    }
+    pass->end();
+
+    if (_surfaceFramebuffer) {
+        auto surfacePass = encoder->beginRenderPass(_surfacePassConfig->makeDescriptor(_surfaceFramebuffer));
+        if (!surfacePass) {
+            LOG_ERROR("SoakRenderer", "Failed to begin surface render pass");
+            return {};
+        }
+        surfacePass->end();
+    }
+
+    auto commandBuffer = encoder->finish();
+    if (!commandBuffer) {
+        LOG_ERROR("SoakRenderer", "Failed to finish command encoder");
+        return {};
+    }
+    pers::SubmissionFence fence = _queue->submit(commandBuffer);
+    if (_surfaceFramebuffer) {
+        _surfaceFramebuffer->present();
+    } else {
+        // The swap chain collects on present; headless nobody else does
+        _deletionQueue->collect();
+    }
+    _texturePool->endFrame();
+    return fence;
+}
+
+void SoakRenderer::finish() {
+    if (!_device) {
+        return;
+    }
+    _device->waitIdle();
+    _deletionQueue->flush();
+}
+
+void SoakRenderer::onResize(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    _config.width = static_cast<uint32_t>(width);
+    _config.height = static_cast<uint32_t>(height);
+    if (_surfaceFramebuffer) {
+        _surfaceFramebuffer->resize(_config.width, _config.height);
+    }
+}
+
+SoakResourceStats SoakRenderer::getResourceStats() const {
+    SoakResourceStats stats;
+    if (!_device) {
+        return stats;
+    }
+    stats.heap = _heap->getStats();
+    if (const auto& staging = _device->getStagingBufferPool()) {
+        stats.staging = staging->getStats();
+    }
+    stats.texturePool = _texturePool->getStats();
+    stats.deletion = _deletionQueue->getStats();
+    stats.liveHeapRanges = _ranges.size();
+    stats.liveTextures = _textures.size();
+    stats.livePipelines = static_cast<uint32_t>(_pipelines.size());
+    return stats;
+}
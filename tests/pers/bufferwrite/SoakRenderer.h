@@ -0,0 +1,141 @@
+#pragma once
+
+#include "pers/graphics/DeferredDeletionQueue.h"
+#include "pers/graphics/GraphicsTypes.h"
+#include "pers/graphics/SubmissionFence.h"
+#include "pers/graphics/SwapChainTypes.h"
+#include "pers/graphics/TransientTexturePool.h"
+#include "pers/graphics/buffers/DeviceBufferHeap.h"
+#include "pers/graphics/buffers/StagingBufferPool.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace pers {
+    class IInstance;
+    class IPhysicalDevice;
+    class ILogicalDevice;
+    class IQueue;
+    class IBindGroup;
+    class IBindGroupLayout;
+    class IPipelineLayout;
+    class IShaderModule;
+    class IRenderPipeline;
+    class ISurfaceFramebuffer;
+    class OffscreenFramebuffer;
+    class RenderPassConfig;
+}
+
+struct SoakConfig {
+    uint32_t buffersPerFrame = 32;      // Heap ranges allocated, written and later freed every frame
+    uint32_t maxBufferLifetime = 240;   // Frames; lifetimes are spread uniformly up to this
+    uint64_t maxBufferSize = 64 * 1024; // Sizes are log-uniform from 256 bytes up to this
+    uint32_t texturesPerFrame = 2;      // Transient pool acquisitions, released after a few frames
+    uint32_t pipelineInterval = 300;    // Frames between new pipelines, 0 = never
+    uint32_t maxPipelines = 4;          // Oldest pipeline is retired past this
+    uint32_t resizeInterval = 600;      // Frames between offscreen target resizes, 0 = never
+    uint32_t seed = 1;
+
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    pers::TextureFormat colorFormat = pers::TextureFormat::BGRA8Unorm;
+    pers::TextureFormat depthFormat = pers::TextureFormat::Depth24PlusStencil8;
+    pers::PresentMode presentMode = pers::PresentMode::Fifo;  // Windowed only
+};
+
+// Engine-side resource state, sampled between frames
+struct SoakResourceStats {
+    pers::DeviceBufferHeap::Stats heap;
+    pers::StagingBufferPool::Stats staging;
+    pers::TransientTexturePool::Stats texturePool;
+    pers::DeferredDeletionQueue::Stats deletion;
+    uint64_t liveHeapRanges = 0;   // Held by the workload itself
+    uint64_t liveTextures = 0;
+    uint32_t livePipelines = 0;
+};
+
+// Workload for long soak runs. Every frame it churns through the resource
+// paths an application leans on: ranges from a DeviceBufferHeap written
+// through the queue's staging pool, with bind groups over some of them;
+// textures from a TransientTexturePool; periodically a freshly compiled
+// pipeline and a resize of the offscreen target. Everything it drops goes
+// through the device's DeferredDeletionQueue, so a steady state should hold
+// a steady amount of memory however long it runs.
+//
+// Draws into an OffscreenFramebuffer that shares the texture pool; when
+// initialized with a surface, the frame is also presented so the swap chain
+// path soaks along.
+class SoakRenderer {
+public:
+    SoakRenderer();
+    ~SoakRenderer();
+
+    SoakRenderer(const SoakRenderer&) = delete;
+    SoakRenderer& operator=(const SoakRenderer&) = delete;
+
+    // Invalid surface = headless
+    bool initialize(const std::shared_ptr<pers::IInstance>& instance,
+                    const pers::NativeSurfaceHandle& surface,
+                    const SoakConfig& config);
+
+    // Churn, render and submit one frame; invalid fence on failure
+    pers::SubmissionFence renderFrame();
+
+    // Wait for the GPU and release everything retired so far
+    void finish();
+
+    void onResize(int width, int height);
+
+    SoakResourceStats getResourceStats() const;
+    const SoakConfig& getConfig() const { return _config; }
+    const std::string& getAdapterName() const { return _adapterName; }
+
+private:
+    struct LiveRange {
+        std::shared_ptr<pers::DeviceBufferView> view;
+        std::shared_ptr<pers::IBindGroup> bindGroup;  // Every few ranges only
+        uint64_t expiresAt = 0;
+    };
+
+    struct LiveTexture {
+        pers::PooledTexture texture;
+        uint64_t expiresAt = 0;
+    };
+
+    bool createDevice(const pers::NativeSurfaceHandle& surface);
+    bool createResources();
+    bool createPipeline();
+    void churnBuffers();
+    void churnTextures();
+    void resizeTarget();
+
+    SoakConfig _config;
+    std::shared_ptr<pers::IInstance> _instance;
+    std::shared_ptr<pers::IPhysicalDevice> _physicalDevice;
+    std::shared_ptr<pers::ILogicalDevice> _device;
+    std::shared_ptr<pers::IQueue> _queue;
+    std::shared_ptr<pers::DeferredDeletionQueue> _deletionQueue;
+    std::string _adapterName;
+
+    std::shared_ptr<pers::ISurfaceFramebuffer> _surfaceFramebuffer;
+    std::shared_ptr<pers::TransientTexturePool> _texturePool;
+    std::shared_ptr<pers::OffscreenFramebuffer> _target;
+    std::unique_ptr<pers::RenderPassConfig> _targetPassConfig;
+    std::unique_ptr<pers::RenderPassConfig> _surfacePassConfig;
+
+    std::shared_ptr<pers::DeviceBufferHeap> _heap;
+    std::shared_ptr<pers::IBindGroupLayout> _tintLayout;
+    std::shared_ptr<pers::IPipelineLayout> _pipelineLayout;
+    std::shared_ptr<pers::IShaderModule> _vertexShader;
+    std::vector<std::shared_ptr<pers::IRenderPipeline>> _pipelines;  // Oldest first
+    uint32_t _pipelineVariant = 0;
+
+    std::vector<LiveRange> _ranges;
+    std::vector<LiveTexture> _textures;
+    std::vector<uint8_t> _scratch;  // Source bytes for range uploads
+    std::mt19937 _random;
+    uint64_t _frame = 0;
+    uint32_t _resizeStep = 0;
+};
@@ -0,0 +1,132 @@
+#include "SceneStressApp.h"
+#include "GLFWWindowFactory.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --instances N    Bunnies to draw, 1 to " << SceneStressConfig::MAX_INSTANCES << " (default 1000)\n"
+              << "  --pipelines P    Distinct pipelines (default 1)\n"
+              << "  --materials M    Material bind groups per pipeline (default 1)\n"
+              << "  --dynamic F      Fraction of instances moving every frame, 0 to 1 (default 0.1)\n"
+              << "  --instanced      One draw per pipeline/material group instead of per instance\n"
+              << "  --lod L          Bunny level of detail (default 0, the full mesh)\n"
+              << "  --frames F       Measured frames (default 500)\n"
+              << "  --warmup W       Frames rendered before measuring (default 60)\n"
+              << "  --width W        Framebuffer width (default 1280)\n"
+              << "  --height H       Framebuffer height (default 720)\n"
+              << "  --headless       Render offscreen, without a window\n"
+              << "  --vsync          Present with Fifo instead of Immediate\n"
+              << "  --csv PATH       Per-frame CSV, empty for none (default scene_stress.csv)\n"
+              << "  --json PATH      JSON summary, empty for none (default scene_stress.json)\n";
+}
+
+bool parseArguments(int argc, char** argv, SceneStressOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        auto number = [&](uint32_t& out) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            out = static_cast<uint32_t>(std::strtoul(text, nullptr, 10));
+            return true;
+        };
+
+        bool ok = true;
+        if (std::strcmp(arg, "--instances") == 0) {
+            ok = number(options.scene.instanceCount);
+        } else if (std::strcmp(arg, "--pipelines") == 0) {
+            ok = number(options.scene.pipelineCount);
+        } else if (std::strcmp(arg, "--materials") == 0) {
+            ok = number(options.scene.materialCount);
+        } else if (std::strcmp(arg, "--lod") == 0) {
+            ok = number(options.scene.lod);
+        } else if (std::strcmp(arg, "--frames") == 0) {
+            ok = number(options.frames);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            ok = number(options.warmup);
+        } else if (std::strcmp(arg, "--width") == 0) {
+            ok = number(options.scene.width);
+        } else if (std::strcmp(arg, "--height") == 0) {
+            ok = number(options.scene.height);
+        } else if (std::strcmp(arg, "--dynamic") == 0) {
+            const char* text = value();
+            ok = text != nullptr;
+            if (ok) {
+                options.scene.dynamicFraction = std::strtof(text, nullptr);
+            }
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            const char* text = value();
+            ok = text != nullptr;
+            if (ok) {
+                options.csvPath = text;
+            }
+        } else if (std::strcmp(arg, "--json") == 0) {
+            const char* text = value();
+            ok = text != nullptr;
+            if (ok) {
+                options.jsonPath = text;
+            }
+        } else if (std::strcmp(arg, "--instanced") == 0) {
+            options.scene.instanced = true;
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(arg, "--vsync") == 0) {
+            options.scene.presentMode = pers::PresentMode::Fifo;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (options.scene.instanceCount == 0 || options.scene.instanceCount > SceneStressConfig::MAX_INSTANCES) {
+        std::cerr << "--instances must be between 1 and " << SceneStressConfig::MAX_INSTANCES << std::endl;
+        return false;
+    }
+    if (options.frames == 0 || options.scene.width == 0 || options.scene.height == 0) {
+        std::cerr << "--frames, --width and --height must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SceneStressOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    auto graphicsFactory = std::make_shared<pers::WebGPUInstanceFactory>();
+
+    SceneStressApp app(options);
+    const bool initialized = options.headless
+        ? app.initializeHeadless(graphicsFactory)
+        : app.initialize(std::make_shared<GLFWWindowFactory>(), graphicsFactory);
+    if (!initialized) {
+        std::cerr << "Failed to initialize scene stress app" << std::endl;
+        return 1;
+    }
+
+    app.run();
+    return app.succeeded() ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include "SoakApp.h"
+#include "GLFWWindowFactory.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --minutes M        Run time (default 240)\n"
+              << "  --sample S         Seconds between samples (default 10)\n"
+              << "  --warmup S         Seconds left out of the trend analysis (default 120)\n"
+              << "  --tolerance T      Relative growth of a level reported as a leak (default 0.10)\n"
+              << "  --buffers N        Heap ranges allocated per frame (default 32)\n"
+              << "  --lifetime F       Longest range lifetime in frames (default 240)\n"
+              << "  --textures N       Transient textures acquired per frame (default 2)\n"
+              << "  --pipeline-every F Frames between new pipelines, 0 = never (default 300)\n"
+              << "  --resize-every F   Frames between target resizes, 0 = never (default 600)\n"
+              << "  --seed S           Random seed of the churn (default 1)\n"
+              << "  --width W          Framebuffer width (default 1280)\n"
+              << "  --height H         Framebuffer height (default 720)\n"
+              << "  --headless         Render offscreen, without a window\n"
+              << "  --csv PATH         Sample CSV, empty for none (default soak.csv)\n"
+              << "  --json PATH        Summary and findings, empty for none (default soak.json)\n";
+}
+
+bool parseArguments(int argc, char** argv, SoakOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        auto number = [&](uint32_t& out) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            out = static_cast<uint32_t>(std::strtoul(text, nullptr, 10));
+            return true;
+        };
+        auto real = [&](double& out) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            out = std::strtod(text, nullptr);
+            return true;
+        };
+        auto path = [&](std::string& out) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            out = text;
+            return true;
+        };
+
+        bool ok = true;
+        if (std::strcmp(arg, "--minutes") == 0) {
+            double minutes = 0.0;
+            ok = real(minutes);
+            options.durationSeconds = minutes * 60.0;
+        } else if (std::strcmp(arg, "--sample") == 0) {
+            ok = real(options.sampleSeconds);
+        } else if (std::strcmp(arg, "--warmup") == 0) {
+            ok = real(options.warmupSeconds);
+        } else if (std::strcmp(arg, "--tolerance") == 0) {
+            ok = real(options.tolerance);
+        } else if (std::strcmp(arg, "--buffers") == 0) {
+            ok = number(options.workload.buffersPerFrame);
+        } else if (std::strcmp(arg, "--lifetime") == 0) {
+            ok = number(options.workload.maxBufferLifetime);
+        } else if (std::strcmp(arg, "--textures") == 0) {
+            ok = number(options.workload.texturesPerFrame);
+        } else if (std::strcmp(arg, "--pipeline-every") == 0) {
+            ok = number(options.workload.pipelineInterval);
+        } else if (std::strcmp(arg, "--resize-every") == 0) {
+            ok = number(options.workload.resizeInterval);
+        } else if (std::strcmp(arg, "--seed") == 0) {
+            ok = number(options.workload.seed);
+        } else if (std::strcmp(arg, "--width") == 0) {
+            ok = number(options.workload.width);
+        } else if (std::strcmp(arg, "--height") == 0) {
+            ok = number(options.workload.height);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            ok = path(options.csvPath);
+        } else if (std::strcmp(arg, "--json") == 0) {
+            ok = path(options.jsonPath);
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (options.durationSeconds <= 0.0 || options.sampleSeconds <= 0.0 ||
+        options.workload.width == 0 || options.workload.height == 0) {
+        std::cerr << "--minutes, --sample, --width and --height must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    SoakOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    auto graphicsFactory = std::make_shared<pers::WebGPUInstanceFactory>();
+
+    SoakApp app(options);
+    const bool initialized = options.headless
+        ? app.initializeHeadless(graphicsFactory)
+        : app.initialize(std::make_shared<GLFWWindowFactory>(), graphicsFactory);
+    if (!initialized) {
+        std::cerr << "Failed to initialize soak app" << std::endl;
+        return 1;
+    }
+
+    app.run();
+    if (!app.completed()) {
+        return 1;
+    }
+    // Distinct from failing to run, so schedulers can tell a leak from a crash
+    return app.getFindings().empty() ? 0 : 3;
+}
@@ -0,0 +1,94 @@
+#include "pers/graphics/FrameCapture.h"
+#include "pers/graphics/FrameReplayer.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/utils/Logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+namespace {
+
+void printTiming(const char* name, const pers::FrameReplayer::Timing& timing) {
+    std::printf("  %-8s min %8.3f ms  median %8.3f ms  max %8.3f ms  mean %8.3f ms\n",
+                name, timing.minMs, timing.medianMs, timing.maxMs, timing.meanMs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <capture> [iterations]\n", argv[0]);
+        return 1;
+    }
+    const std::string path = argv[1];
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 100;
+    if (iterations <= 0) {
+        std::fprintf(stderr, "iterations must be positive\n");
+        return 1;
+    }
+
+    // Keep per-resource creation logs out of the report
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Trace, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Debug, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Info, false);
+
+    pers::FrameCapture capture;
+    if (!capture.load(path)) {
+        return 1;
+    }
+
+    auto factory = std::make_shared<pers::WebGPUInstanceFactory>();
+    pers::InstanceDesc instanceDesc;
+    instanceDesc.applicationName = "Pers Frame Replayer";
+    instanceDesc.enableValidation = false;
+    auto instance = factory->createInstance(instanceDesc);
+    if (!instance) {
+        std::fprintf(stderr, "Failed to create instance\n");
+        return 1;
+    }
+
+    pers::PhysicalDeviceOptions options;
+    options.powerPreference = pers::PowerPreference::HighPerformance;
+    auto physicalDevice = instance->requestPhysicalDevice(options);
+    if (!physicalDevice) {
+        std::fprintf(stderr, "No suitable adapter\n");
+        return 1;
+    }
+
+    pers::LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = false;
+    deviceDesc.preferredFeatures = {pers::DeviceFeature::PushConstants};  // Captured layouts may use them
+    auto device = physicalDevice->createLogicalDevice(deviceDesc);
+    if (!device) {
+        std::fprintf(stderr, "Failed to create logical device\n");
+        return 1;
+    }
+
+    pers::FrameReplayer replayer(device);
+    if (!replayer.prepare(capture)) {
+        return 1;
+    }
+
+    // Warm up pipelines and driver caches before measuring
+    pers::FrameReplayer::Stats stats;
+    if (!replayer.replay(1, stats) || !replayer.replay(static_cast<uint32_t>(iterations), stats)) {
+        return 1;
+    }
+
+    std::printf("%s: %u commands, %zu buffers, %zu textures, %zu pipelines\n", path.c_str(),
+                capture.commandCount, capture.buffers.size(), capture.textures.size(), capture.pipelines.size());
+    if (capture.skippedCommands > 0) {
+        std::printf("  %u calls were not captured and are missing from the replay\n", capture.skippedCommands);
+    }
+    if (stats.skippedDraws > 0) {
+        std::printf("  %u draws skipped for lack of a pipeline\n", stats.skippedDraws);
+    }
+    std::printf("%u iterations\n", stats.iterations);
+    printTiming("encode", stats.encode);
+    printTiming("frame", stats.frame);
+    return 0;
+}
@@ -0,0 +1,320 @@
+#include "pers/graphics/ShaderBinary.h"
+#include "pers/graphics/ShaderBundle.h"
+#include "pers/graphics/ShaderLibrary.h"
+#include "pers/graphics/ShaderReflection.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/utils/Logger.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CookOptions {
+    std::string input;    // WGSL source, or the manifest with --bundle
+    std::string output;
+    bool bundle = false;  // Cook every permutation of the manifest into one ShaderBundle
+    pers::ShaderDefines defines;
+    std::string naga;     // WGSL to SPIR-V translator, naga-cli
+    bool verify = false;  // Create every entry point from the binary on a device
+};
+
+void printUsage(const char* program) {
+    std::fprintf(stderr,
+        "usage: %s <input.wgsl> -o <output.spv> [options]\n"
+        "       %s --bundle <manifest> -o <output.psb> [options]\n"
+        "  -D NAME[=VALUE]  Define applied by the ShaderLibrary preprocessor, repeatable\n"
+        "  --bundle         Input is a manifest, one '<name> <path.wgsl> [NAME[=VALUE]...]'\n"
+        "                   permutation per line, paths relative to the manifest, # comments\n"
+        "  --naga PATH      naga executable (default $PERS_NAGA, then naga on PATH)\n"
+        "  --verify         Create a module per entry point from the result on a device\n",
+        program, program);
+}
+
+void addDefine(const std::string& define, pers::ShaderDefines& defines) {
+    const size_t equals = define.find('=');
+    if (equals == std::string::npos) {
+        defines[define] = "";
+    } else {
+        defines[define.substr(0, equals)] = define.substr(equals + 1);
+    }
+}
+
+bool parseArguments(int argc, char** argv, CookOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg);
+                return nullptr;
+            }
+            return argv[++i];
+        };
+
+        if (std::strcmp(arg, "-o") == 0) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            options.output = text;
+        } else if (std::strcmp(arg, "-D") == 0) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            addDefine(text, options.defines);
+        } else if (std::strcmp(arg, "--naga") == 0) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            options.naga = text;
+        } else if (std::strcmp(arg, "--verify") == 0) {
+            options.verify = true;
+        } else if (std::strcmp(arg, "--bundle") == 0) {
+            options.bundle = true;
+        } else if (arg[0] == '-') {
+            std::fprintf(stderr, "Unknown option: %s\n", arg);
+            return false;
+        } else if (options.input.empty()) {
+            options.input = arg;
+        } else {
+            std::fprintf(stderr, "Unexpected argument: %s\n", arg);
+            return false;
+        }
+    }
+
+    if (options.input.empty() || options.output.empty()) {
+        return false;
+    }
+    if (options.naga.empty()) {
+        const char* env = std::getenv("PERS_NAGA");
+        options.naga = env && *env ? env : "naga";
+    }
+    return true;
+}
+
+bool readText(const std::string& path, std::string& contents) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::stringstream ss;
+    ss << file.rdbuf();
+    contents = ss.str();
+    return true;
+}
+
+bool writeText(const std::string& path, const std::string& contents) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << contents;
+    return static_cast<bool>(file);
+}
+
+// naga picks the output language from the extension and writes every entry point
+bool translate(const std::string& naga, const std::string& wgslPath, const std::string& spirvPath) {
+    const std::string command = "\"" + naga + "\" \"" + wgslPath + "\" \"" + spirvPath + "\"";
+    const int status = std::system(command.c_str());
+    if (status != 0) {
+        std::fprintf(stderr, "%s failed (%d); install it with `cargo install naga-cli` or pass --naga\n",
+                     naga.c_str(), status);
+        return false;
+    }
+    return true;
+}
+
+// The translator and the runtime can disagree, catch that here instead of at launch
+bool verify(const std::vector<uint32_t>& spirv, const pers::ShaderReflection& reflection) {
+    auto factory = std::make_shared<pers::WebGPUInstanceFactory>();
+    pers::InstanceDesc instanceDesc;
+    instanceDesc.applicationName = "Pers Shader Cook";
+    instanceDesc.enableValidation = true;
+    auto instance = factory->createInstance(instanceDesc);
+    if (!instance) {
+        std::fprintf(stderr, "Failed to create instance\n");
+        return false;
+    }
+
+    auto physicalDevice = instance->requestPhysicalDevice(pers::PhysicalDeviceOptions{});
+    if (!physicalDevice) {
+        std::fprintf(stderr, "No suitable adapter\n");
+        return false;
+    }
+
+    pers::LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = true;
+    auto device = physicalDevice->createLogicalDevice(deviceDesc);
+    if (!device) {
+        std::fprintf(stderr, "Failed to create logical device\n");
+        return false;
+    }
+
+    bool ok = true;
+    for (const auto& entryPoint : reflection.getEntryPoints()) {
+        pers::ShaderModuleDesc desc;
+        desc.spirv = spirv;
+        desc.stage = entryPoint.stage;
+        desc.entryPoint = entryPoint.name;
+        desc.debugName = entryPoint.name;
+        if (!device->getResourceFactory()->createShaderModule(desc)) {
+            std::fprintf(stderr, "Entry point %s does not load from the binary\n", entryPoint.name.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+// Preprocess, translate and reflect one permutation; spirvPath is left on disk
+bool cook(const CookOptions& options, const std::string& input, const pers::ShaderDefines& defines,
+          const std::string& spirvPath, std::string& wgsl, std::vector<uint32_t>& spirv,
+          pers::ShaderReflection& reflection) {
+    std::string source;
+    if (!readText(input, source)) {
+        std::fprintf(stderr, "Failed to read %s\n", input.c_str());
+        return false;
+    }
+
+    // Same preprocessor as runtime permutations, so defines cook identically
+    std::string error;
+    if (!pers::ShaderLibrary::preprocess(source, defines, wgsl, &error)) {
+        std::fprintf(stderr, "%s: %s\n", input.c_str(), error.c_str());
+        return false;
+    }
+
+    const std::string preprocessedPath = spirvPath + ".wgsl";
+    if (!writeText(preprocessedPath, wgsl)) {
+        std::fprintf(stderr, "Failed to write %s\n", preprocessedPath.c_str());
+        return false;
+    }
+
+    const bool translated = translate(options.naga, preprocessedPath, spirvPath);
+    std::error_code removeError;
+    std::filesystem::remove(preprocessedPath, removeError);
+    if (!translated) {
+        return false;
+    }
+
+    if (!pers::loadSpirvFile(spirvPath, spirv, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return false;
+    }
+
+    reflection = pers::ShaderReflection::reflect(wgsl);
+    if (options.verify) {
+        if (!reflection.isValid()) {
+            std::fprintf(stderr, "Cannot list the entry points of %s to verify\n", input.c_str());
+            return false;
+        }
+        if (!verify(spirv, reflection)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int cookBundle(const CookOptions& options) {
+    std::string manifest;
+    if (!readText(options.input, manifest)) {
+        std::fprintf(stderr, "Failed to read %s\n", options.input.c_str());
+        return 1;
+    }
+
+    const std::filesystem::path root = std::filesystem::path(options.input).parent_path();
+    const std::string spirvPath = options.output + ".spv";
+    pers::ShaderBundleWriter writer;
+
+    std::istringstream lines(manifest);
+    std::string line;
+    for (int lineNumber = 1; std::getline(lines, line); ++lineNumber) {
+        const size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream fields(line);
+        std::string name;
+        std::string path;
+        if (!(fields >> name)) {
+            continue;
+        }
+        if (!(fields >> path)) {
+            std::fprintf(stderr, "%s:%d: expected '<name> <path.wgsl> [NAME[=VALUE]...]'\n",
+                         options.input.c_str(), lineNumber);
+            return 1;
+        }
+
+        // Command line defines apply to every permutation, the line's own win
+        pers::ShaderDefines defines = options.defines;
+        for (std::string define; fields >> define;) {
+            addDefine(define, defines);
+        }
+
+        std::string wgsl;
+        std::vector<uint32_t> spirv;
+        pers::ShaderReflection reflection;
+        const bool cooked = cook(options, (root / path).string(), defines, spirvPath, wgsl, spirv, reflection);
+        std::error_code removeError;
+        std::filesystem::remove(spirvPath, removeError);
+        if (!cooked) {
+            return 1;
+        }
+
+        std::string error;
+        if (!writer.add(name, defines, std::move(spirv), reflection, &error)) {
+            std::fprintf(stderr, "%s:%d: %s\n", options.input.c_str(), lineNumber, error.c_str());
+            return 1;
+        }
+    }
+
+    std::string error;
+    if (!writer.save(options.output, &error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::error_code sizeError;
+    const auto size = std::filesystem::file_size(options.output, sizeError);
+    std::printf("%s -> %s (%zu permutations, %zu unique blobs, %llu bytes)\n",
+                options.input.c_str(), options.output.c_str(), writer.getPermutationCount(),
+                writer.getBlobCount(), sizeError ? 0ull : static_cast<unsigned long long>(size));
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CookOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Trace, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Debug, false);
+    pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Info, false);
+
+    if (options.bundle) {
+        return cookBundle(options);
+    }
+
+    std::string wgsl;
+    std::vector<uint32_t> spirv;
+    pers::ShaderReflection reflection;
+    if (!cook(options, options.input, options.defines, options.output, wgsl, spirv, reflection)) {
+        return 1;
+    }
+
+    std::printf("%s -> %s (%zu bytes of WGSL, %zu bytes of SPIR-V, %zu entry points)\n",
+                options.input.c_str(), options.output.c_str(), wgsl.size(),
+                spirv.size() * sizeof(uint32_t), reflection.getEntryPoints().size());
+    return 0;
+}
@@ -33,24 +33,45 @@ bool PersTriangleApp::onInitialize() {
     return true;
 }
 
-bool PersTriangleApp::initializeRenderer() {
-    // Create and initialize the renderer
+bool PersTriangleApp::onConfigureStartup(pers::DeviceStartup& startup, pers::DeviceStartupDesc& desc) {
+    // The renderer exists before the window so its pipeline can compile during window creation
     _renderer = std::make_unique<TriangleRenderer>();
     
-    // Get framebuffer size to pass to renderer
-    glm::ivec2 size = getFramebufferSize();
-    
-    // Create configuration for renderer
     TriangleRendererConfig config;
-    config.windowSize = size;
-    
-    // Initialize renderer with the instance we got from base class
+    config.windowSize = glm::ivec2(_windowWidth, _windowHeight);
     if (!_renderer->initialize(getInstance(), config)) {
         LOG_ERROR("PersTriangleApp",
             "Failed to initialize renderer");
+        _renderer.reset();
         return false;
     }
     
+    desc = _renderer->getDeviceStartupDesc();
+    startup.onDeviceReady([renderer = _renderer.get()](const std::shared_ptr<pers::ILogicalDevice>& device) {
+        renderer->preparePipeline(device);
+    });
+    return true;
+}
+
+bool PersTriangleApp::initializeRenderer() {
+    pers::DeviceStartup& startup = getDeviceStartup();
+    
+    if (!startup.isStarted()) {
+        // Create and initialize the renderer
+        _renderer = std::make_unique<TriangleRenderer>();
+        
+        // Create configuration for renderer
+        TriangleRendererConfig config;
+        config.windowSize = getFramebufferSize();
+        
+        // Initialize renderer with the instance we got from base class
+        if (!_renderer->initialize(getInstance(), config)) {
+            LOG_ERROR("PersTriangleApp",
+                "Failed to initialize renderer");
+            return false;
+        }
+    }
+    
     // Create surface using base class helper and initialize graphics
     pers::NativeSurfaceHandle surface = createSurface();
     if (!surface.isValid()) {
@@ -59,7 +80,26 @@ bool PersTriangleApp::initializeRenderer() {
         return false;
     }
     
-    if (!_renderer->initializeGraphics(surface)) {
+    bool initialized = false;
+    if (startup.isStarted()) {
+        // Waits for the worker, after which the renderer is ours alone again
+        auto device = startup.wait();
+        _renderer->setWindowSize(getFramebufferSize());
+        
+        if (device && startup.supportsSurface(surface)) {
+            pers::Logger::Instance().LogFormat(pers::LogLevel::Info, "PersTriangleApp", PERS_SOURCE_LOC,
+                "Device ready %lld us after startup began", static_cast<long long>(startup.getElapsed().count()));
+            initialized = _renderer->initializeGraphics(surface, startup.getPhysicalDevice(), device);
+        } else {
+            LOG_WARNING("PersTriangleApp",
+                "Startup device cannot present to the window, requesting a surface-compatible adapter");
+            initialized = _renderer->initializeGraphics(surface);
+        }
+    } else {
+        initialized = _renderer->initializeGraphics(surface);
+    }
+    
+    if (!initialized) {
         LOG_ERROR("PersTriangleApp",
             "Failed to initialize graphics");
         return false;
@@ -12,6 +12,7 @@ public:
     
 protected:
     // Override virtual methods from Application
+    bool onConfigureStartup(pers::DeviceStartup& startup, pers::DeviceStartupDesc& desc) override;
     bool onInitialize() override;
     void onUpdate(float deltaTime) override;
     void onRender() override;
@@ -0,0 +1,290 @@
+#include "StartupBenchmarkApp.h"
+#include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IInstance.h"
+#include "pers/graphics/ILogicalDevice.h"
+#include "pers/graphics/IPhysicalDevice.h"
+#include "pers/graphics/IQueue.h"
+#include "pers/graphics/IRenderPassEncoder.h"
+#include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/IResourceFactory.h"
+#include "pers/graphics/IShaderModule.h"
+#include "pers/graphics/OffscreenFramebuffer.h"
+#include "pers/graphics/PipelineDiskCache.h"
+#include "pers/graphics/RenderPassConfig.h"
+#include "pers/graphics/SurfaceFramebuffer.h"
+#include "pers/graphics/SwapChainDescBuilder.h"
+#include "pers/graphics/backends/IGraphicsInstanceFactory.h"
+#include "pers/utils/Logger.h"
+
+namespace {
+
+constexpr pers::TextureFormat COLOR_FORMAT = pers::TextureFormat::BGRA8Unorm;
+constexpr pers::TextureFormat DEPTH_FORMAT = pers::TextureFormat::Depth24PlusStencil8;
+
+// Fullscreen triangle, no vertex buffer
+const char* const VERTEX_SHADER = R"(
+@vertex
+fn main(@builtin(vertex_index) index: u32) -> @builtin(position) vec4<f32> {
+    let uv = vec2<f32>(f32((index << 1u) & 2u), f32(index & 2u));
+    return vec4<f32>(uv * 2.0 - 1.0, 0.5, 1.0);
+}
+)";
+
+// Prefixed with a distinct VARIANT per pipeline, so no two share a compilation
+const char* const FRAGMENT_SHADER = R"(
+@fragment
+fn main(@builtin(position) position: vec4<f32>) -> @location(0) vec4<f32> {
+    let shade = fract(f32(VARIANT) * 0.618034 + position.x * 0.001);
+    return vec4<f32>(shade, 1.0 - shade, 0.5, 1.0);
+}
+)";
+
+} // namespace
+
+StartupBenchmarkApp::StartupBenchmarkApp(const StartupBenchmarkConfig& config, Clock::time_point launchStart)
+    : _config(config)
+    , _launchStart(launchStart)
+    , _initializeStart(launchStart)
+    , _mark(launchStart) {
+    _windowTitle = "PERS Startup Benchmark";
+    _windowWidth = static_cast<int>(config.width);
+    _windowHeight = static_cast<int>(config.height);
+}
+
+StartupBenchmarkApp::~StartupBenchmarkApp() = default;
+
+void StartupBenchmarkApp::markInitializeStart() {
+    _initializeStart = Clock::now();
+    _mark = _initializeStart;
+}
+
+void StartupBenchmarkApp::markInitializeEnd() {
+    _mark = Clock::now();
+    _phases.emplace_back("application_initialize",
+        std::chrono::duration<double, std::milli>(_mark - _initializeStart).count());
+}
+
+void StartupBenchmarkApp::phase(const char* name) {
+    const Clock::time_point now = Clock::now();
+    _phases.emplace_back(name, std::chrono::duration<double, std::milli>(now - _mark).count());
+    _mark = now;
+}
+
+void StartupBenchmarkApp::onConfigureInstance(pers::InstanceDesc& desc) {
+    // Everything initialize() did before creating the instance
+    phase("job_system");
+    if (!_config.enableValidation) {
+        desc = pers::InstanceDesc::fastInit();
+        desc.applicationName = _windowTitle;
+    }
+}
+
+bool StartupBenchmarkApp::onConfigureStartup(pers::DeviceStartup&, pers::DeviceStartupDesc&) {
+    // Called right after the instance was created; the device is created in onInitialize() so it can be timed
+    phase("instance");
+    return false;
+}
+
+bool StartupBenchmarkApp::onInitialize() {
+    pers::NativeSurfaceHandle surface;
+    if (!isHeadless()) {
+        phase("window");
+        surface = createSurface();
+        if (!surface.isValid()) {
+            LOG_ERROR("StartupBenchmarkApp", "Failed to create surface");
+            return false;
+        }
+        phase("surface");
+    }
+
+    pers::PhysicalDeviceOptions options;
+    options.powerPreference = pers::PowerPreference::HighPerformance;
+    if (surface.isValid()) {
+        options.compatibleSurface = surface;
+    }
+    _physicalDevice = getInstance()->requestPhysicalDevice(options);
+    if (!_physicalDevice) {
+        LOG_ERROR("StartupBenchmarkApp", "Failed to get physical device");
+        return false;
+    }
+    phase("request_adapter");
+    _adapterName = _physicalDevice->getCapabilities().deviceName;
+
+    pers::LogicalDeviceDesc deviceDesc;
+    deviceDesc.enableValidation = _config.enableValidation;
+    deviceDesc.debugName = "StartupBenchmarkDevice";
+    _device = _physicalDevice->createLogicalDevice(deviceDesc);
+    if (!_device) {
+        LOG_ERROR("StartupBenchmarkApp", "Failed to create logical device");
+        return false;
+    }
+    phase("create_device");
+
+    const glm::ivec2 size = isHeadless() ? glm::ivec2(_windowWidth, _windowHeight) : getFramebufferSize();
+    if (surface.isValid()) {
+        auto surfaceFramebuffer = std::make_shared<pers::SurfaceFramebuffer>(_device);
+        const pers::SwapChainDesc swapChainDesc = pers::SwapChainDescBuilder()
+            .setSize(static_cast<uint32_t>(size.x), static_cast<uint32_t>(size.y))
+            .setFormat(COLOR_FORMAT)
+            .setPresentMode(pers::PresentMode::Fifo)
+            .setUsage(pers::TextureUsage::RenderAttachment)
+            .setDebugName("StartupBenchmarkSwapChain")
+            .build();
+        if (!surfaceFramebuffer->create(surface, swapChainDesc, DEPTH_FORMAT)) {
+            LOG_ERROR("StartupBenchmarkApp", "Failed to create swap chain");
+            return false;
+        }
+        _surfaceFramebuffer = surfaceFramebuffer;
+        phase("swapchain");
+    } else {
+        pers::OffscreenFramebufferConfig targetConfig;
+        targetConfig.width = static_cast<uint32_t>(size.x);
+        targetConfig.height = static_cast<uint32_t>(size.y);
+        targetConfig.colorFormats = {COLOR_FORMAT};
+        targetConfig.depthFormat = DEPTH_FORMAT;
+        _offscreenFramebuffer = std::make_shared<pers::OffscreenFramebuffer>(_device->getResourceFactory(), targetConfig);
+        phase("offscreen_target");
+    }
+
+    // A missing or stale cache is the cold case, not an error
+    _pipelineCache = std::make_unique<pers::PipelineDiskCache>(_config.cachePath, _physicalDevice->getCapabilities());
+    if (_pipelineCache->load()) {
+        _pipelineCache->prewarm(_device->getResourceFactory());
+    }
+    phase("pipeline_cache_prewarm");
+
+    return createPipelines();
+}
+
+bool StartupBenchmarkApp::createPipelines() {
+    const auto& factory = _device->getResourceFactory();
+
+    pers::ShaderModuleDesc vertexDesc;
+    vertexDesc.code = VERTEX_SHADER;
+    vertexDesc.stage = pers::ShaderStage::Vertex;
+    vertexDesc.entryPoint = "main";
+    vertexDesc.debugName = "StartupBenchmarkVertex";
+    auto vertexShader = _pipelineCache->createShaderModule(factory, vertexDesc);
+    if (!vertexShader) {
+        LOG_ERROR("StartupBenchmarkApp", "Failed to create vertex shader");
+        return false;
+    }
+
+    std::vector<std::shared_ptr<pers::IShaderModule>> fragmentShaders;
+    for (uint32_t variant = 0; variant < _config.pipelineCount; ++variant) {
+        pers::ShaderModuleDesc fragmentDesc;
+        fragmentDesc.code = "const VARIANT: u32 = " + std::to_string(variant) + "u;\n" + FRAGMENT_SHADER;
+        fragmentDesc.stage = pers::ShaderStage::Fragment;
+        fragmentDesc.entryPoint = "main";
+        fragmentDesc.debugName = "StartupBenchmarkFragment" + std::to_string(variant);
+        auto fragmentShader = _pipelineCache->createShaderModule(factory, fragmentDesc);
+        if (!fragmentShader) {
+            LOG_ERROR("StartupBenchmarkApp", "Failed to create fragment shader " + std::to_string(variant));
+            return false;
+        }
+        fragmentShaders.push_back(fragmentShader);
+    }
+    phase("shader_modules");
+
+    for (uint32_t variant = 0; variant < _config.pipelineCount; ++variant) {
+        pers::RenderPipelineDesc pipelineDesc;
+        pipelineDesc.vertex = vertexShader;
+        pipelineDesc.fragment = fragmentShaders[variant];
+        pipelineDesc.debugName = "StartupBenchmarkPipeline" + std::to_string(variant);
+        pipelineDesc.primitive.topology = pers::PrimitiveTopology::TriangleList;
+        pipelineDesc.primitive.cullMode = pers::CullMode::None;
+
+        pers::ColorTargetState colorTarget;
+        colorTarget.format = COLOR_FORMAT;
+        colorTarget.writeMask = pers::ColorWriteMask::All;
+        pipelineDesc.colorTargets.push_back(colorTarget);
+        pipelineDesc.multisample.count = 1;
+        pipelineDesc.depthStencil.format = DEPTH_FORMAT;
+        pipelineDesc.depthStencil.depthWriteEnabled = false;
+        pipelineDesc.depthStencil.depthCompare = pers::CompareFunction::Always;
+
+        auto pipeline = _pipelineCache->createRenderPipeline(factory, pipelineDesc);
+        if (!pipeline) {
+            LOG_ERROR("StartupBenchmarkApp", "Failed to create render pipeline");
+            return false;
+        }
+        _pipelines.push_back(pipeline);
+    }
+    phase("pipelines");
+    return true;
+}
+
+void StartupBenchmarkApp::onRender() {
+    if (_firstFrameDone) {
+        return;
+    }
+    if (!renderFirstFrame()) {
+        LOG_ERROR("StartupBenchmarkApp", "Failed to render the first frame");
+        requestExit();
+        return;
+    }
+    phase("first_frame");
+    _phases.emplace_back("time_to_first_frame",
+        std::chrono::duration<double, std::milli>(_mark - _launchStart).count());
+    _firstFrameDone = true;
+
+    // After the first frame, as an application would, so it does not count against it
+    _pipelineCache->save();
+    phase("pipeline_cache_save");
+    requestExit();
+}
+
+bool StartupBenchmarkApp::renderFirstFrame() {
+    std::shared_ptr<pers::IFramebuffer> framebuffer = _offscreenFramebuffer;
+    if (_surfaceFramebuffer) {
+        if (!_surfaceFramebuffer->acquireNextImage()) {
+            return false;
+        }
+        framebuffer = _surfaceFramebuffer;
+    }
+
+    pers::RenderPassConfig passConfig;
+    pers::RenderPassConfig::ColorConfig colorConfig;
+    colorConfig.loadOp = pers::LoadOp::Clear;
+    colorConfig.storeOp = pers::StoreOp::Store;
+    passConfig.addColorAttachment(colorConfig);
+    pers::RenderPassConfig::DepthStencilConfig depthConfig;
+    depthConfig.depthLoadOp = pers::LoadOp::Clear;
+    depthConfig.depthStoreOp = pers::StoreOp::Discard;
+    passConfig.setDepthStencilConfig(depthConfig);
+    passConfig.setLabel("StartupBenchmarkPass");
+
+    auto encoder = _device->createCommandEncoder();
+    if (!encoder) {
+        return false;
+    }
+    auto pass = encoder->beginRenderPass(passConfig.makeDescriptor(framebuffer));
+    if (!pass) {
+        return false;
+    }
+    // Every pipeline draws, so none is still compiling in the background when the frame completes
+    for (const auto& pipeline : _pipelines) {
+        pass->setPipeline(pipeline);
+        pass->draw(3);
+    }
+    pass->end();
+
+    auto commandBuffer = encoder->finish();
+    if (!commandBuffer) {
+        return false;
+    }
+    pers::SubmissionFence fence = _device->getQueue()->submit(commandBuffer);
+    if (_surfaceFramebuffer) {
+        _surfaceFramebuffer->present();
+    }
+    return fence && fence.wait();
+}
+
+void StartupBenchmarkApp::onCleanup() {
+    _pipelines.clear();
+    _pipelineCache.reset();
+    _surfaceFramebuffer.reset();
+    _offscreenFramebuffer.reset();
+    _device.reset();
+    _physicalDevice.reset();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "pers/core/Application.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pers {
+    class IPhysicalDevice;
+    class ILogicalDevice;
+    class IFramebuffer;
+    class ISurfaceFramebuffer;
+    class IRenderPipeline;
+    class PipelineDiskCache;
+}
+
+struct StartupBenchmarkConfig {
+    uint32_t pipelineCount = 16;      // Distinct fragment shaders, one pipeline each
+    bool enableValidation = false;    // Off measures the InstanceDesc::fastInit() path
+    std::string cachePath = "startup_pipelines.cache";
+    uint32_t width = 800;
+    uint32_t height = 600;
+};
+
+// One launch of the startup benchmark: initializes like an application
+// would, draws one frame with every pipeline and exits once it completed.
+//
+// Each phase of that path is timed on its own. Application::initialize()
+// runs job system, instance and window creation back to back; the phases
+// inside it are split at the onConfigureInstance(), onConfigureStartup() and
+// onInitialize() hooks, which it calls in that order. Pipelines go through a
+// PipelineDiskCache, so a launch that finds the cache of a previous one
+// compiles in the prewarm phase instead of the pipeline phase.
+class StartupBenchmarkApp : public pers::Application {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // launchStart: as close to process start as main() can tell
+    StartupBenchmarkApp(const StartupBenchmarkConfig& config, Clock::time_point launchStart);
+    ~StartupBenchmarkApp() override;
+
+    // Call right before and after initialize() or initializeHeadless()
+    void markInitializeStart();
+    void markInitializeEnd();
+
+    // Phase names and milliseconds in startup order, complete once run() returned
+    const std::vector<std::pair<std::string, double>>& getPhases() const { return _phases; }
+    const std::string& getAdapterName() const { return _adapterName; }
+    bool succeeded() const { return _firstFrameDone; }
+
+protected:
+    void onConfigureInstance(pers::InstanceDesc& desc) override;
+    bool onConfigureStartup(pers::DeviceStartup& startup, pers::DeviceStartupDesc& desc) override;
+    bool onInitialize() override;
+    void onRender() override;
+    void onCleanup() override;
+
+private:
+    // Close the phase that started at the previous mark
+    void phase(const char* name);
+
+    bool createPipelines();
+    bool renderFirstFrame();
+
+    StartupBenchmarkConfig _config;
+    Clock::time_point _launchStart;
+    Clock::time_point _initializeStart;
+    Clock::time_point _mark;
+    std::vector<std::pair<std::string, double>> _phases;
+    std::string _adapterName;
+
+    std::shared_ptr<pers::IPhysicalDevice> _physicalDevice;
+    std::shared_ptr<pers::ILogicalDevice> _device;
+    std::shared_ptr<pers::ISurfaceFramebuffer> _surfaceFramebuffer;
+    std::shared_ptr<pers::IFramebuffer> _offscreenFramebuffer;
+    std::unique_ptr<pers::PipelineDiskCache> _pipelineCache;
+    std::vector<std::shared_ptr<pers::IRenderPipeline>> _pipelines;
+    bool _firstFrameDone = false;
+};
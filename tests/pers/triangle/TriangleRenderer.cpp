@@ -14,6 +14,7 @@
 #include "pers/graphics/buffers/ImmediateDeviceBuffer.h"
 #include "pers/graphics/IShaderModule.h"
 #include "pers/graphics/IRenderPipeline.h"
+#include "pers/graphics/AsyncRenderPipeline.h"
 #include "pers/graphics/IRenderPassEncoder.h"
 #include "pers/graphics/SwapChainDescBuilder.h"
 #include "pers/utils/Logger.h"
@@ -50,6 +51,9 @@ bool TriangleRenderer::initialize(const std::shared_ptr<pers::IInstance>& instan
 }
 
 bool TriangleRenderer::initializeGraphics(const pers::NativeSurfaceHandle& surface) {
+    // A pipeline prepared on a startup device does not belong to the device created here
+    _renderPipeline.reset();
+    
     // Step 1: Set surface
     setSurface(surface);
     if (!_surface.isValid()) {
@@ -87,6 +91,36 @@ bool TriangleRenderer::initializeGraphics(const pers::NativeSurfaceHandle& surfa
     }
     setQueue(queue);
     
+    return createSurfaceResources(surface);
+}
+
+bool TriangleRenderer::initializeGraphics(const pers::NativeSurfaceHandle& surface,
+                                          const std::shared_ptr<pers::IPhysicalDevice>& physicalDevice,
+                                          const std::shared_ptr<pers::ILogicalDevice>& logicalDevice) {
+    setSurface(surface);
+    if (!_surface.isValid() || !physicalDevice || !logicalDevice) {
+        LOG_ERROR("TriangleRenderer",
+            "Invalid surface or device provided");
+        return false;
+    }
+    
+    setPhysicalDevice(physicalDevice);
+    setLogicalDevice(logicalDevice);
+    
+    auto queue = logicalDevice->getQueue();
+    if (!queue) {
+        LOG_ERROR("TriangleRenderer",
+            "Failed to get queue from device");
+        return false;
+    }
+    setQueue(queue);
+    
+    return createSurfaceResources(surface);
+}
+
+bool TriangleRenderer::createSurfaceResources(const pers::NativeSurfaceHandle& surface) {
+    const auto& logicalDevice = _device;
+    
     // Step 3: Create surface framebuffer and swap chain
     LOG_INFO("TriangleRenderer",
         "Creating surface framebuffer and swap chain...");
@@ -148,6 +182,15 @@ void TriangleRenderer::setQueue(const std::shared_ptr<pers::IQueue>& queue) {
 }
 
 
+pers::DeviceStartupDesc TriangleRenderer::getDeviceStartupDesc() const {
+    pers::DeviceStartupDesc desc;
+    desc.physicalDevice.powerPreference = pers::PowerPreference::HighPerformance;
+    desc.logicalDevice.enableValidation = _config.enableValidation;  // Use configured validation setting
+    desc.logicalDevice.debugName = "TriangleRendererDevice";
+    desc.logicalDevice.timeout = _config.deviceTimeout;  // Use configured timeout
+    return desc;
+}
+
 std::shared_ptr<pers::IPhysicalDevice> TriangleRenderer::requestPhysicalDevice(const pers::NativeSurfaceHandle& surface) {
     if (!_instance || !surface.isValid()) {
         LOG_ERROR("TriangleRenderer",
@@ -156,8 +199,7 @@ std::shared_ptr<pers::IPhysicalDevice> TriangleRenderer::requestPhysicalDevice(c
     }
     
     // Request adapter compatible with our surface
-    pers::PhysicalDeviceOptions options;
-    options.powerPreference = pers::PowerPreference::HighPerformance;
+    pers::PhysicalDeviceOptions options = getDeviceStartupDesc().physicalDevice;
     options.compatibleSurface = surface;  // Request adapter compatible with this surface
     
     LOG_INFO("TriangleRenderer",
@@ -207,10 +249,7 @@ std::shared_ptr<pers::ILogicalDevice> TriangleRenderer::createLogicalDevice(cons
     }
     
     // Setup device descriptor
-    pers::LogicalDeviceDesc deviceDesc;
-    deviceDesc.enableValidation = _config.enableValidation;  // Use configured validation setting
-    deviceDesc.debugName = "TriangleRendererDevice";
-    deviceDesc.timeout = _config.deviceTimeout;  // Use configured timeout
+    pers::LogicalDeviceDesc deviceDesc = getDeviceStartupDesc().logicalDevice;
     
     // For now, we don't request any special features or limits
     // Just use the adapter's defaults
@@ -237,50 +276,25 @@ std::shared_ptr<pers::ILogicalDevice> TriangleRenderer::createLogicalDevice(cons
 }
 
 
-bool TriangleRenderer::createTriangleResources() {
-    LOG_INFO("TriangleRenderer",
-        "Creating triangle resources...");
-    
-    if (!_device) {
-        LOG_ERROR("TriangleRenderer",
-            "Device not ready");
-        return false;
+void TriangleRenderer::preparePipeline(const std::shared_ptr<pers::ILogicalDevice>& device) {
+    // Runs on the startup worker while the window is created
+    _renderPipeline = createPipeline(device, true);
+    if (!_renderPipeline) {
+        LOG_WARNING("TriangleRenderer",
+            "Failed to start pipeline compilation, creating it with the triangle resources");
     }
-    
-    // Get resource factory
-    const auto& factory = _device->getResourceFactory();
+}
+
+std::shared_ptr<pers::IRenderPipeline> TriangleRenderer::createPipeline(
+    const std::shared_ptr<pers::ILogicalDevice>& device, bool async) {
+    const auto& factory = device ? device->getResourceFactory() : nullptr;
     if (!factory) {
         LOG_ERROR("TriangleRenderer",
             "Failed to get resource factory");
-        return false;
-    }
-    
-    // 1. Create vertex buffer with triangle data
-    // Simple triangle vertices (position only, NDC coordinates)
-    const std::array<float, 9> vertices = {
-        // x,    y,    z
-         0.0f,  0.5f, 0.0f,  // Top
-        -0.5f, -0.5f, 0.0f,  // Bottom left
-         0.5f, -0.5f, 0.0f   // Bottom right
-    };
-    
-      // Use ImmediateDeviceBuffer for synchronous data upload
-    _vertexBuffer = std::make_shared<pers::ImmediateDeviceBuffer>(
-        factory,
-        vertices.size() * sizeof(float),
-        pers::BufferUsage::Vertex | pers::BufferUsage::CopyDst,
-        vertices.data(),
-        vertices.size() * sizeof(float),
-        "TriangleVertexBuffer"
-    );
-
-    if (!_vertexBuffer) {
-        LOG_ERROR("TriangleRenderer",
-            "Failed to create vertex buffer with initial data");
-        return false;
+        return nullptr;
     }
     
-    // 2. Create shaders
+    // Create shaders
     // Simple vertex shader
     const char* vertexShaderCode = R"(
 @vertex
@@ -307,7 +321,7 @@ fn main() -> @location(0) vec4<f32> {
     if (!vertexShader) {
         LOG_ERROR("TriangleRenderer",
             "Failed to create vertex shader");
-        return false;
+        return nullptr;
     }
     
     pers::ShaderModuleDesc fragmentShaderDesc;
@@ -320,10 +334,10 @@ fn main() -> @location(0) vec4<f32> {
     if (!fragmentShader) {
         LOG_ERROR("TriangleRenderer",
             "Failed to create fragment shader");
-        return false;
+        return nullptr;
     }
     
-    // 3. Create render pipeline
+    // Create render pipeline
     pers::RenderPipelineDesc pipelineDesc;
     pipelineDesc.vertex = vertexShader;
     pipelineDesc.fragment = fragmentShader;
@@ -361,7 +375,59 @@ fn main() -> @location(0) vec4<f32> {
     pipelineDesc.depthStencil.depthWriteEnabled = true;
     pipelineDesc.depthStencil.depthCompare = pers::CompareFunction::Less;
     
-    _renderPipeline = factory->createRenderPipeline(pipelineDesc);
+    if (async) {
+        return factory->createRenderPipelineAsync(pipelineDesc);
+    }
+    return factory->createRenderPipeline(pipelineDesc);
+}
+
+bool TriangleRenderer::createTriangleResources() {
+    LOG_INFO("TriangleRenderer",
+        "Creating triangle resources...");
+    
+    if (!_device) {
+        LOG_ERROR("TriangleRenderer",
+            "Device not ready");
+        return false;
+    }
+    
+    // Get resource factory
+    const auto& factory = _device->getResourceFactory();
+    if (!factory) {
+        LOG_ERROR("TriangleRenderer",
+            "Failed to get resource factory");
+        return false;
+    }
+    
+    // 1. Create vertex buffer with triangle data
+    // Simple triangle vertices (position only, NDC coordinates)
+    const std::array<float, 9> vertices = {
+        // x,    y,    z
+         0.0f,  0.5f, 0.0f,  // Top
+        -0.5f, -0.5f, 0.0f,  // Bottom left
+         0.5f, -0.5f, 0.0f   // Bottom right
+    };
+    
+      // Use ImmediateDeviceBuffer for synchronous data upload
+    _vertexBuffer = std::make_shared<pers::ImmediateDeviceBuffer>(
+        factory,
+        vertices.size() * sizeof(float),
+        pers::BufferUsage::Vertex | pers::BufferUsage::CopyDst,
+        vertices.data(),
+        vertices.size() * sizeof(float),
+        "TriangleVertexBuffer"
+    );
+
+    if (!_vertexBuffer) {
+        LOG_ERROR("TriangleRenderer",
+            "Failed to create vertex buffer with initial data");
+        return false;
+    }
+    
+    // 2. Create shaders and pipeline, unless preparePipeline() already started them
+    if (!_renderPipeline) {
+        _renderPipeline = createPipeline(_device, false);
+    }
     if (!_renderPipeline) {
         LOG_ERROR("TriangleRenderer",
             "Failed to create render pipeline");
@@ -420,24 +486,31 @@ void TriangleRenderer::renderFrame() {
         return;
     }
     
-    // Make descriptor from config + current framebuffer
-    pers::RenderPassDesc renderPassDesc = _renderPassConfig->makeDescriptor(_surfaceFramebuffer);
+    // Translate the descriptor once, then only swap in the current image's views
+    if (!_preparedRenderPass) {
+        const auto& factory = _device->getResourceFactory();
+        _preparedRenderPass = factory->createPreparedRenderPass(_renderPassConfig->makeDescriptor(_surfaceFramebuffer));
+    }
+    if (!_preparedRenderPass || !_renderPassConfig->retarget(*_preparedRenderPass, _surfaceFramebuffer)) {
+        LOG_ERROR("TriangleRenderer",
+            "Failed to prepare render pass");
+        return;
+    }
     
-    auto renderPass = commandEncoder->beginRenderPass(renderPassDesc);
+    auto renderPass = commandEncoder->beginRenderPass(*_preparedRenderPass);
     if (!renderPass) {
         LOG_ERROR("TriangleRenderer",
             "Failed to begin render pass");
         return;
     }
     
-    // 4. Set pipeline
-    renderPass->setPipeline(_renderPipeline);
-    
-    // 5. Set vertex buffer
-    renderPass->setVertexBuffer(0, _vertexBuffer, 0);
-    
-    // 6. Draw
-    renderPass->draw(3, 1, 0, 0);  // 3 vertices, 1 instance
+    // 4-6. Draw once the pipeline can be bound; an async pipeline still
+    // compiling leaves a cleared frame instead of holding up the first one
+    if (_renderPipeline->getNativePipelineHandle()) {
+        renderPass->setPipeline(_renderPipeline);
+        renderPass->setVertexBuffer(0, _vertexBuffer, 0);
+        renderPass->draw(3, 1, 0, 0);  // 3 vertices, 1 instance
+    }
     
     // 7. End render pass
     renderPass->end();
@@ -484,6 +557,7 @@ void TriangleRenderer::cleanup() {
     // Clean up in EXACT reverse order of creation
     
     // 8. _renderPassConfig (created last in createTriangleResources)
+    _preparedRenderPass.reset();
     _renderPassConfig.reset();
     
     // 7. _renderPipeline (created in createTriangleResources)
@@ -7,6 +7,7 @@
 #include "pers/graphics/GraphicsTypes.h"
 #include "pers/graphics/SurfaceFramebuffer.h"
 #include "pers/graphics/RenderPassConfig.h"
+#include "pers/core/DeviceStartup.h"
 
 namespace pers {
     class IGraphicsInstanceFactory;
@@ -57,6 +58,20 @@ public:
     // Initialize graphics (surface, device, swapchain)
     bool initializeGraphics(const pers::NativeSurfaceHandle& surface);
     
+    // Initialize graphics with a device created ahead of the window (see DeviceStartup)
+    bool initializeGraphics(const pers::NativeSurfaceHandle& surface,
+                            const std::shared_ptr<pers::IPhysicalDevice>& physicalDevice,
+                            const std::shared_ptr<pers::ILogicalDevice>& logicalDevice);
+    
+    // Adapter and device settings used by both initialization paths
+    pers::DeviceStartupDesc getDeviceStartupDesc() const;
+    
+    // Start compiling the pipeline as soon as a device exists, safe to call off the main thread
+    void preparePipeline(const std::shared_ptr<pers::ILogicalDevice>& device);
+    
+    // Swap chain size, set before initializeGraphics
+    void setWindowSize(const glm::ivec2& size) { _config.windowSize = size; }
+    
     // Create triangle resources (vertex buffer, shaders, pipeline)
     bool createTriangleResources();
     
@@ -79,6 +94,8 @@ private:
     // Device initialization helpers
     std::shared_ptr<pers::IPhysicalDevice> requestPhysicalDevice(const pers::NativeSurfaceHandle& surface);
     std::shared_ptr<pers::ILogicalDevice> createLogicalDevice(const std::shared_ptr<pers::IPhysicalDevice>& physicalDevice);
+    bool createSurfaceResources(const pers::NativeSurfaceHandle& surface);
+    std::shared_ptr<pers::IRenderPipeline> createPipeline(const std::shared_ptr<pers::ILogicalDevice>& device, bool async);
     
 private:
     // Configuration
@@ -99,6 +116,7 @@ private:
     
     // Render pass configuration (created once, reused every frame)
     std::unique_ptr<pers::RenderPassConfig> _renderPassConfig;
+    std::shared_ptr<pers::IPreparedRenderPass> _preparedRenderPass;  // Retargeted to each swapchain image
     
     // Frame counter for performance logging
     uint32_t _frameCounter = 0;
@@ -0,0 +1,505 @@
+#include "StartupBenchmarkApp.h"
+#include "GLFWWindowFactory.h"
+#include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
+#include "pers/utils/Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Taken during static initialization, before main() runs
+const StartupBenchmarkApp::Clock::time_point LAUNCH_START = StartupBenchmarkApp::Clock::now();
+
+// Phase added by the parent: wall time of the whole child process, including its teardown
+constexpr const char* PROCESS_PHASE = "process";
+
+// Regressions smaller than this are noise whatever the relative change
+constexpr double MIN_REGRESSION_MS = 1.0;
+
+struct Options {
+    StartupBenchmarkConfig app;
+    uint32_t launches = 10;
+    uint32_t coldLaunches = 1;      // The first launches, each started without a pipeline cache
+    bool headless = false;
+    bool trace = false;             // Every launch writes startup_trace_<n>.json
+    std::string jsonPath = "startup_benchmark.json";
+    std::string csvPath = "startup_benchmark.csv";
+    std::string baselinePath;       // Summary CSV of an earlier run to compare to
+    double tolerance = 0.25;        // Allowed relative growth of a median over the baseline
+
+    // Child mode: one launch, phases written to outputPath
+    bool child = false;
+    std::string outputPath;
+    std::string tracePath;
+};
+
+struct Launch {
+    bool cold = false;
+    bool succeeded = false;
+    std::string adapter;
+    std::vector<std::pair<std::string, double>> phases;
+};
+
+struct Summary {
+    size_t samples = 0;
+    double median = 0.0;
+    double mean = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+Summary summarize(std::vector<double> values) {
+    Summary summary;
+    summary.samples = values.size();
+    if (values.empty()) {
+        return summary;
+    }
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    summary.median = values.size() % 2 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+    double total = 0.0;
+    for (double v : values) {
+        total += v;
+    }
+    summary.mean = total / static_cast<double>(values.size());
+    summary.min = values.front();
+    summary.max = values.back();
+    return summary;
+}
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --launches N     Process launches to measure (default 10)\n"
+              << "  --cold C         Leading launches started without a pipeline cache (default 1)\n"
+              << "  --pipelines P    Distinct render pipelines created at startup (default 16)\n"
+              << "  --cache PATH     Pipeline cache file (default startup_pipelines.cache)\n"
+              << "  --validation     Keep instance and device validation enabled\n"
+              << "  --headless       Render the first frame offscreen, without a window\n"
+              << "  --width W        Window width (default 800)\n"
+              << "  --height H       Window height (default 600)\n"
+              << "  --trace          Write a Chrome trace of every launch\n"
+              << "  --csv PATH       Per-phase summary CSV, empty for none (default startup_benchmark.csv)\n"
+              << "  --json PATH      Per-launch phases and summary, empty for none (default startup_benchmark.json)\n"
+              << "  --baseline PATH  Summary CSV of an earlier run; exit with 3 if a median regressed\n"
+              << "  --tolerance T    Relative growth allowed over the baseline (default 0.25)\n";
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto value = [&]() -> const char* {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return nullptr;
+            }
+            return argv[++i];
+        };
+        auto number = [&](uint32_t& out) {
+            const char* text = value();
+            if (!text) {
+                return false;
+            }
+            out = static_cast<uint32_t>(std::strtoul(text, nullptr, 10));
+            return true;
+        };
+        auto text = [&](std::string& out) {
+            const char* v = value();
+            if (!v) {
+                return false;
+            }
+            out = v;
+            return true;
+        };
+
+        bool ok = true;
+        if (std::strcmp(arg, "--launches") == 0) {
+            ok = number(options.launches);
+        } else if (std::strcmp(arg, "--cold") == 0) {
+            ok = number(options.coldLaunches);
+        } else if (std::strcmp(arg, "--pipelines") == 0) {
+            ok = number(options.app.pipelineCount);
+        } else if (std::strcmp(arg, "--width") == 0) {
+            ok = number(options.app.width);
+        } else if (std::strcmp(arg, "--height") == 0) {
+            ok = number(options.app.height);
+        } else if (std::strcmp(arg, "--cache") == 0) {
+            ok = text(options.app.cachePath);
+        } else if (std::strcmp(arg, "--csv") == 0) {
+            ok = text(options.csvPath);
+        } else if (std::strcmp(arg, "--json") == 0) {
+            ok = text(options.jsonPath);
+        } else if (std::strcmp(arg, "--baseline") == 0) {
+            ok = text(options.baselinePath);
+        } else if (std::strcmp(arg, "--tolerance") == 0) {
+            const char* v = value();
+            ok = v != nullptr;
+            if (ok) {
+                options.tolerance = std::strtod(v, nullptr);
+            }
+        } else if (std::strcmp(arg, "--validation") == 0) {
+            options.app.enableValidation = true;
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            options.headless = true;
+        } else if (std::strcmp(arg, "--trace") == 0) {
+            options.trace = true;
+        } else if (std::strcmp(arg, "--child") == 0) {
+            options.child = true;
+        } else if (std::strcmp(arg, "--output") == 0) {
+            ok = text(options.outputPath);
+        } else if (std::strcmp(arg, "--trace-file") == 0) {
+            ok = text(options.tracePath);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            ok = false;
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if (options.child && options.outputPath.empty()) {
+        std::cerr << "--child needs --output" << std::endl;
+        return false;
+    }
+    if (options.launches == 0 || options.app.pipelineCount == 0 ||
+        options.app.width == 0 || options.app.height == 0) {
+        std::cerr << "--launches, --pipelines, --width and --height must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// One launch in this process; the phases go to options.outputPath as "name<TAB>milliseconds" lines
+int runChild(const Options& options) {
+    if (!options.tracePath.empty()) {
+        pers::Profiler::setEnabled(true);
+    }
+
+    auto graphicsFactory = std::make_shared<pers::WebGPUInstanceFactory>();
+    StartupBenchmarkApp app(options.app, LAUNCH_START);
+    app.markInitializeStart();
+    const bool initialized = options.headless
+        ? app.initializeHeadless(graphicsFactory)
+        : app.initialize(std::make_shared<GLFWWindowFactory>(), graphicsFactory);
+    app.markInitializeEnd();
+    if (initialized) {
+        app.run();
+    }
+
+    std::ofstream out(options.outputPath);
+    if (!out) {
+        std::cerr << "Failed to open " << options.outputPath << std::endl;
+        return 1;
+    }
+    out << std::fixed << std::setprecision(4);
+    out << "adapter\t" << app.getAdapterName() << '\n';
+    out << "succeeded\t" << (app.succeeded() ? 1 : 0) << '\n';
+    for (const auto& [name, milliseconds] : app.getPhases()) {
+        out << name << '\t' << milliseconds << '\n';
+    }
+    out.close();
+
+    if (!options.tracePath.empty()) {
+        pers::Profiler::setEnabled(false);
+        pers::Profiler::writeChromeTrace(options.tracePath);
+    }
+    return app.succeeded() ? 0 : 1;
+}
+
+std::string quote(const std::string& text) {
+    return "\"" + text + "\"";
+}
+
+bool readLaunch(const std::string& path, Launch& launch) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t tab = line.find('\t');
+        if (tab == std::string::npos) {
+            continue;
+        }
+        const std::string key = line.substr(0, tab);
+        const std::string value = line.substr(tab + 1);
+        if (key == "adapter") {
+            launch.adapter = value;
+        } else if (key == "succeeded") {
+            launch.succeeded = value == "1";
+        } else {
+            launch.phases.emplace_back(key, std::strtod(value.c_str(), nullptr));
+        }
+    }
+    return true;
+}
+
+bool launchChild(const char* program, const Options& options, uint32_t index, Launch& launch) {
+    namespace fs = std::filesystem;
+    launch.cold = index < options.coldLaunches;
+    if (launch.cold) {
+        std::error_code error;
+        fs::remove(options.app.cachePath, error);
+    }
+
+    const std::string outputPath = (fs::temp_directory_path() / ("pers_startup_" + std::to_string(index) + ".txt")).string();
+    std::ostringstream command;
+    command << quote(program) << " --child --output " << quote(outputPath)
+            << " --pipelines " << options.app.pipelineCount
+            << " --width " << options.app.width << " --height " << options.app.height
+            << " --cache " << quote(options.app.cachePath);
+    if (options.app.enableValidation) {
+        command << " --validation";
+    }
+    if (options.headless) {
+        command << " --headless";
+    }
+    if (options.trace) {
+        command << " --trace-file " << quote("startup_trace_" + std::to_string(index) + ".json");
+    }
+    std::string commandLine = command.str();
+#ifdef _WIN32
+    // cmd.exe strips the outer quotes of a command that starts with a quoted path
+    commandLine = quote(commandLine);
+#endif
+
+    const auto start = StartupBenchmarkApp::Clock::now();
+    const int status = std::system(commandLine.c_str());
+    const double wallMilliseconds = std::chrono::duration<double, std::milli>(
+        StartupBenchmarkApp::Clock::now() - start).count();
+
+    const bool read = readLaunch(outputPath, launch);
+    std::error_code error;
+    fs::remove(outputPath, error);
+    if (!read || status != 0 || !launch.succeeded) {
+        std::cerr << "Launch " << index << " failed (exit status " << status << ")" << std::endl;
+        launch.succeeded = false;
+        return false;
+    }
+    launch.phases.emplace_back(PROCESS_PHASE, wallMilliseconds);
+    return true;
+}
+
+// Phase names in the order the first successful launch reported them
+std::vector<std::string> phaseNames(const std::vector<Launch>& launches) {
+    std::vector<std::string> names;
+    for (const Launch& launch : launches) {
+        for (const auto& phase : launch.phases) {
+            if (std::find(names.begin(), names.end(), phase.first) == names.end()) {
+                names.push_back(phase.first);
+            }
+        }
+    }
+    return names;
+}
+
+Summary summarizePhase(const std::vector<Launch>& launches, const std::string& name, bool cold) {
+    std::vector<double> values;
+    for (const Launch& launch : launches) {
+        if (launch.cold != cold) {
+            continue;
+        }
+        for (const auto& phase : launch.phases) {
+            if (phase.first == name) {
+                values.push_back(phase.second);
+            }
+        }
+    }
+    return summarize(values);
+}
+
+std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            escaped += code;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+void writeSummary(std::ostream& out, const Summary& summary) {
+    out << "{\"samples\": " << summary.samples << ", \"median\": " << summary.median
+        << ", \"mean\": " << summary.mean << ", \"min\": " << summary.min << ", \"max\": " << summary.max << "}";
+}
+
+bool writeCsv(const std::string& path, const std::vector<Launch>& launches) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    out << "phase,cold_samples,cold_median_ms,cold_mean_ms,warm_samples,warm_median_ms,warm_mean_ms,warm_min_ms,warm_max_ms\n";
+    out << std::fixed << std::setprecision(4);
+    for (const std::string& name : phaseNames(launches)) {
+        const Summary cold = summarizePhase(launches, name, true);
+        const Summary warm = summarizePhase(launches, name, false);
+        out << name << ',' << cold.samples << ',' << cold.median << ',' << cold.mean << ','
+            << warm.samples << ',' << warm.median << ',' << warm.mean << ',' << warm.min << ',' << warm.max << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+bool writeJson(const std::string& path, const Options& options, const std::vector<Launch>& launches) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Failed to open " << path << std::endl;
+        return false;
+    }
+    const std::string adapter = launches.empty() ? std::string() : launches.front().adapter;
+    out << std::fixed << std::setprecision(4);
+    out << "{\n";
+    out << "  \"config\": {\n";
+    out << "    \"launches\": " << options.launches << ",\n";
+    out << "    \"cold_launches\": " << std::min(options.coldLaunches, options.launches) << ",\n";
+    out << "    \"pipelines\": " << options.app.pipelineCount << ",\n";
+    out << "    \"validation\": " << (options.app.enableValidation ? "true" : "false") << ",\n";
+    out << "    \"headless\": " << (options.headless ? "true" : "false") << ",\n";
+    out << "    \"width\": " << options.app.width << ",\n";
+    out << "    \"height\": " << options.app.height << "\n";
+    out << "  },\n";
+    out << "  \"adapter\": \"" << escapeJson(adapter) << "\",\n";
+    out << "  \"launches\": [\n";
+    for (size_t i = 0; i < launches.size(); ++i) {
+        out << "    {\"cold\": " << (launches[i].cold ? "true" : "false") << ", \"phases\": {";
+        for (size_t p = 0; p < launches[i].phases.size(); ++p) {
+            out << (p ? ", " : "") << "\"" << escapeJson(launches[i].phases[p].first) << "\": "
+                << launches[i].phases[p].second;
+        }
+        out << "}}" << (i + 1 < launches.size() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"summary\": {\n";
+    const std::vector<std::string> names = phaseNames(launches);
+    for (size_t i = 0; i < names.size(); ++i) {
+        out << "    \"" << escapeJson(names[i]) << "\": {\"cold\": ";
+        writeSummary(out, summarizePhase(launches, names[i], true));
+        out << ", \"warm\": ";
+        writeSummary(out, summarizePhase(launches, names[i], false));
+        out << "}" << (i + 1 < names.size() ? "," : "") << "\n";
+    }
+    out << "  }\n";
+    out << "}\n";
+    return static_cast<bool>(out);
+}
+
+void printTable(const std::vector<Launch>& launches) {
+    std::cout << std::left << std::setw(26) << "phase" << std::right
+              << std::setw(14) << "cold median" << std::setw(14) << "warm median"
+              << std::setw(12) << "warm min" << std::setw(12) << "warm max" << "   (ms)\n";
+    std::cout << std::fixed << std::setprecision(2);
+    for (const std::string& name : phaseNames(launches)) {
+        const Summary cold = summarizePhase(launches, name, true);
+        const Summary warm = summarizePhase(launches, name, false);
+        std::cout << std::left << std::setw(26) << name << std::right
+                  << std::setw(14) << cold.median << std::setw(14) << warm.median
+                  << std::setw(12) << warm.min << std::setw(12) << warm.max << '\n';
+    }
+}
+
+// Compares cold and warm medians to a summary CSV written by an earlier run
+bool compareToBaseline(const Options& options, const std::vector<Launch>& launches) {
+    std::ifstream in(options.baselinePath);
+    if (!in) {
+        std::cerr << "Failed to open baseline " << options.baselinePath << std::endl;
+        return false;
+    }
+    std::map<std::string, std::pair<double, double>> baseline;  // phase -> cold, warm median
+    std::string line;
+    std::getline(in, line);  // Header
+    while (std::getline(in, line)) {
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        std::string field;
+        while (std::getline(row, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() >= 6) {
+            baseline[fields[0]] = {std::strtod(fields[2].c_str(), nullptr), std::strtod(fields[5].c_str(), nullptr)};
+        }
+    }
+
+    bool regressed = false;
+    auto check = [&](const std::string& name, const char* kind, const Summary& current, double previous) {
+        if (current.samples == 0 || previous <= 0.0) {
+            return;
+        }
+        if (current.median > previous * (1.0 + options.tolerance) && current.median - previous > MIN_REGRESSION_MS) {
+            std::cout << "REGRESSION " << name << " (" << kind << "): " << std::setprecision(2)
+                      << previous << " ms -> " << current.median << " ms\n";
+            regressed = true;
+        }
+    };
+    for (const std::string& name : phaseNames(launches)) {
+        const auto it = baseline.find(name);
+        if (it == baseline.end()) {
+            continue;
+        }
+        check(name, "cold", summarizePhase(launches, name, true), it->second.first);
+        check(name, "warm", summarizePhase(launches, name, false), it->second.second);
+    }
+    if (!regressed) {
+        std::cout << "No phase regressed against " << options.baselinePath << '\n';
+    }
+    return !regressed;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (options.child) {
+        return runChild(options);
+    }
+
+    // Every launch is a fresh process, so nothing the driver or the engine keeps in memory carries over
+    std::vector<Launch> launches;
+    for (uint32_t i = 0; i < options.launches; ++i) {
+        Launch launch;
+        if (launchChild(argv[0], options, i, launch)) {
+            launches.push_back(std::move(launch));
+        }
+    }
+    if (launches.empty()) {
+        std::cerr << "No launch succeeded" << std::endl;
+        return 1;
+    }
+
+    std::cout << launches.size() << " of " << options.launches << " launches on "
+              << launches.front().adapter << "\n";
+    printTable(launches);
+
+    bool written = true;
+    if (!options.csvPath.empty()) {
+        written = writeCsv(options.csvPath, launches) && written;
+    }
+    if (!options.jsonPath.empty()) {
+        written = writeJson(options.jsonPath, options, launches) && written;
+    }
+    if (!options.baselinePath.empty() && !compareToBaseline(options, launches)) {
+        return 3;
+    }
+    return written && launches.size() == options.launches ? 0 : 1;
+}
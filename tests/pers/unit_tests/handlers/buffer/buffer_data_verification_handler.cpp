@@ -1,4 +1,5 @@
 #include "buffer_data_verification_handler.h"
+#include "../../shared_test_device.h"
 #include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
 #include "pers/graphics/GraphicsEnumStrings.h"
 #include "pers/graphics/buffers/DeviceBuffer.h"
@@ -9,14 +10,118 @@
 #include "pers/graphics/ICommandEncoder.h"
 #include "pers/graphics/IQueue.h"
 #include "pers/graphics/ICommandBuffer.h"
+#include "pers/graphics/IBindGroup.h"
+#include "pers/graphics/IComputePassEncoder.h"
+#include "pers/graphics/IPipelineLayout.h"
+#include "pers/graphics/IShaderModule.h"
 #include "pers/utils/Logger.h"
 #include <iostream>
 #include <iomanip>
 #include <cstring>
 #include <numeric>
+#include <span>
 
 namespace pers::tests {
 
+namespace {
+
+// Every invocation folds a grid-stride slice into registers, the workgroup
+// merges them in shared atomics and one invocation per group touches the
+// result. The hash is order-independent so the CPU can mirror it serially.
+const char* VERIFY_SHADER = R"(
+const WORKGROUP_SIZE: u32 = 256u;
+
+struct Params {
+    wordBase: u32,
+    wordCount: u32,
+}
+
+struct VerifyResult {
+    mismatches: atomic<u32>,
+    firstMismatch: atomic<u32>,
+    hashSum: atomic<u32>,
+    hashXor: atomic<u32>,
+}
+
+@group(0) @binding(0) var<storage, read> data: array<u32>;
+@group(0) @binding(1) var<storage, read> expected: array<u32>;
+@group(0) @binding(2) var<storage, read_write> result: VerifyResult;
+@group(0) @binding(3) var<uniform> params: Params;
+
+var<workgroup> groupMismatches: atomic<u32>;
+var<workgroup> groupFirst: atomic<u32>;
+var<workgroup> groupSum: atomic<u32>;
+var<workgroup> groupXor: atomic<u32>;
+
+fn mixWord(value: u32, index: u32) -> u32 {
+    var h = value ^ (index * 0x9E3779B9u);
+    h = (h ^ (h >> 16u)) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13u)) * 0xC2B2AE35u;
+    return h ^ (h >> 16u);
+}
+
+@compute @workgroup_size(256)
+fn main(@builtin(global_invocation_id) id: vec3<u32>,
+        @builtin(local_invocation_index) local: u32,
+        @builtin(num_workgroups) groups: vec3<u32>) {
+    if (local == 0u) {
+        atomicStore(&groupFirst, 0xFFFFFFFFu);
+    }
+    workgroupBarrier();
+
+    var mismatches = 0u;
+    var first = 0xFFFFFFFFu;
+    var sum = 0u;
+    var folded = 0u;
+    let stride = groups.x * WORKGROUP_SIZE;
+    for (var i = id.x; i < params.wordCount; i = i + stride) {
+        let word = data[i];
+        let index = params.wordBase + i;
+        if (word != expected[i]) {
+            mismatches = mismatches + 1u;
+            first = min(first, index);
+        }
+        sum = sum + mixWord(word, index);
+        folded = folded ^ mixWord(word, ~index);
+    }
+
+    if (mismatches > 0u) {
+        atomicAdd(&groupMismatches, mismatches);
+        atomicMin(&groupFirst, first);
+    }
+    atomicAdd(&groupSum, sum);
+    atomicXor(&groupXor, folded);
+    workgroupBarrier();
+
+    if (local == 0u) {
+        let groupMismatchCount = atomicLoad(&groupMismatches);
+        if (groupMismatchCount > 0u) {
+            atomicAdd(&result.mismatches, groupMismatchCount);
+            atomicMin(&result.firstMismatch, atomicLoad(&groupFirst));
+        }
+        atomicAdd(&result.hashSum, atomicLoad(&groupSum));
+        atomicXor(&result.hashXor, atomicLoad(&groupXor));
+    }
+}
+)";
+
+constexpr uint32_t VERIFY_WORKGROUP_SIZE = 256;
+// Enough groups to fill the device; more only adds result atomics
+constexpr uint32_t VERIFY_MAX_WORKGROUPS = 1024;
+constexpr uint64_t VERIFY_RESULT_SIZE = 4 * sizeof(uint32_t);
+// Chunk offsets and per-chunk uniforms honour the default 256-byte alignments
+constexpr uint64_t VERIFY_BINDING_ALIGNMENT = 256;
+constexpr uint64_t DEFAULT_MAX_STORAGE_BINDING_SIZE = 128ull * 1024 * 1024;
+
+uint32_t mixWord(uint32_t value, uint32_t index) {
+    uint32_t h = value ^ (index * 0x9E3779B9u);
+    h = (h ^ (h >> 16)) * 0x85EBCA6Bu;
+    h = (h ^ (h >> 13)) * 0xC2B2AE35u;
+    return h ^ (h >> 16);
+}
+
+} // anonymous namespace
+
 BufferDataVerificationHandler::BufferDataVerificationHandler()
     : _factory(std::make_shared<WebGPUInstanceFactory>()) {
 }
@@ -45,6 +150,24 @@ bool BufferDataVerificationHandler::initializeDevice(bool enableLogging, bool en
         pers::Logger::Instance().SetLogLevelEnabled(pers::LogLevel::Warning, true);
     }
     
+    // Cases asking for a different validation setting get the matching shared device
+    if (_sharedDevices) {
+        auto device = _sharedDevices->getDevice({enableValidation, PowerPreference::HighPerformance});
+        if (!device) {
+            return false;
+        }
+        if (device != _logicalDevice) {
+            _instance = _sharedDevices->getInstance(enableValidation);
+            _logicalDevice = device;
+            _queue = _logicalDevice->getQueue();
+            _stagingVerifier.queue = _queue;
+            _computeVerifier.device = _logicalDevice;
+            _computeVerifier.instance = _instance;
+            _renderVerifier.device = _logicalDevice;
+        }
+        return true;
+    }
+    
     if (_logicalDevice) {
         return true;  // Device already initialized
     }
@@ -84,6 +207,7 @@ bool BufferDataVerificationHandler::initializeDevice(bool enableLogging, bool en
     // Setup verifiers
     _stagingVerifier.queue = _queue;
     _computeVerifier.device = _logicalDevice;
+    _computeVerifier.instance = _instance;
     _renderVerifier.device = _logicalDevice;
     
     return true;
@@ -817,24 +941,445 @@ TestResult BufferDataVerificationHandler::verifyThroughDirectMapping(const TestV
 
 TestResult BufferDataVerificationHandler::verifyThroughComputeShader(const TestVariation& variation) {
     TestResult result;
-    
+
     // Set source location info
     result.addSourceLocation(__FUNCTION__, __FILE__, __LINE__);
-    
+
     size_t bufferSize = getOption<size_t>(variation.options, "size", 4096);
     std::string patternType = getOption<std::string>(variation.options, "pattern", "sequential");
-    
-    // Compute shader verification not yet implemented
-    result.passed = false;
-    result.actualBehavior = "Compute shader verification not yet implemented";
-    result.failureReason = "Compute pipeline infrastructure not available";
+    // "compare" uploads the expected data and counts mismatching words,
+    // "checksum" only hashes the buffer against a CPU-side hash of the pattern
+    std::string gpuCheck = getOption<std::string>(variation.options, "gpu_check", "compare");
+
     result.actualProperties["buffer_size"] = bufferSize;
     result.actualProperties["pattern_type"] = patternType;
-    result.actualProperties["implementation_status"] = "NOT_IMPLEMENTED";
-    
+    result.actualProperties["gpu_check"] = gpuCheck;
+
+    if (gpuCheck != "compare" && gpuCheck != "checksum") {
+        result.passed = false;
+        result.failureReason = "Unknown gpu_check: " + gpuCheck;
+        return result;
+    }
+
+    // Buffer copies and storage bindings both work in whole words
+    if (bufferSize == 0 || bufferSize % 4 != 0) {
+        result.passed = false;
+        result.failureReason = "Compute shader verification needs a size that is a multiple of 4";
+        return result;
+    }
+
+    // Map pattern type
+    TestPattern::Type type = TestPattern::Sequential;
+    if (patternType == "random") type = TestPattern::Random;
+    else if (patternType == "gradient") type = TestPattern::Gradient;
+    else if (patternType == "binary") type = TestPattern::Binary;
+
+    auto pattern = TestPattern::generate(type, bufferSize);
+
+    auto deviceBuffer = std::make_shared<DeviceBuffer>();
+    if (!deviceBuffer->create(bufferSize, DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc, _logicalDevice, "TestBuffer")) {
+        result.passed = false;
+        result.failureReason = "Failed to create device buffer";
+        return result;
+    }
+
+    auto immediateStaging = std::make_shared<ImmediateStagingBuffer>();
+    if (!immediateStaging->create(bufferSize, _logicalDevice, "ImmediateStagingBuffer")) {
+        result.passed = false;
+        result.failureReason = "Failed to create immediate staging buffer";
+        return result;
+    }
+
+    // Write pattern data through the same staging path as the readback method
+    auto startWrite = std::chrono::high_resolution_clock::now();
+
+    uint64_t bytesWritten = immediateStaging->writeBytes(pattern.data.data(), bufferSize, 0);
+    if (bytesWritten != bufferSize) {
+        result.passed = false;
+        result.failureReason = "Failed to write all data to staging buffer";
+        return result;
+    }
+    immediateStaging->finalize();
+
+    auto endWrite = std::chrono::high_resolution_clock::now();
+    double writeTimeMs = std::chrono::duration<double, std::milli>(endWrite - startWrite).count();
+
+    BufferCopyDesc copyDesc;
+    copyDesc.srcOffset = 0;
+    copyDesc.dstOffset = 0;
+    copyDesc.size = bufferSize;
+
+    _commandEncoder = _logicalDevice->createCommandEncoder();
+    if (!_commandEncoder) {
+        result.passed = false;
+        result.failureReason = "Failed to create command encoder";
+        return result;
+    }
+
+    if (!_commandEncoder->uploadToDeviceBuffer(immediateStaging, deviceBuffer, copyDesc)) {
+        result.passed = false;
+        result.failureReason = "Failed to upload data to buffer";
+        return result;
+    }
+
+    auto commandBuffer = _commandEncoder->finish();
+    if (!commandBuffer) {
+        result.passed = false;
+        result.failureReason = "Failed to finish command encoding";
+        return result;
+    }
+
+    _queue->submit({commandBuffer});
+
+    auto startVerify = std::chrono::high_resolution_clock::now();
+
+    std::shared_ptr<DeviceBuffer> expectedBuffer;
+    uint32_t expectedSum = 0;
+    uint32_t expectedXor = 0;
+    if (gpuCheck == "compare") {
+        expectedBuffer = std::make_shared<DeviceBuffer>();
+        if (!expectedBuffer->create(bufferSize, DeviceBufferUsage::Storage, _logicalDevice, "ExpectedBuffer")) {
+            result.passed = false;
+            result.failureReason = "Failed to create expected data buffer";
+            return result;
+        }
+
+        std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(pattern.data.data()), bufferSize);
+        if (!_queue->writeBuffer(expectedBuffer, 0, bytes)) {
+            result.passed = false;
+            result.failureReason = "Failed to upload expected data";
+            return result;
+        }
+    } else {
+        ComputeShaderVerification::hashPattern(pattern, expectedSum, expectedXor);
+    }
+
+    ComputeShaderVerification::Result gpuResult;
+    if (!_computeVerifier.execute(deviceBuffer, expectedBuffer, bufferSize, gpuResult)) {
+        result.passed = false;
+        result.actualBehavior = "Compute verification did not complete";
+        result.failureReason = "Failed to run verification compute pass";
+        return result;
+    }
+
+    auto endVerify = std::chrono::high_resolution_clock::now();
+    double verifyTimeMs = std::chrono::duration<double, std::milli>(endVerify - startVerify).count();
+
+    bool dataMatches = false;
+    if (expectedBuffer) {
+        dataMatches = gpuResult.mismatchCount == 0;
+    } else {
+        dataMatches = gpuResult.hashSum == expectedSum && gpuResult.hashXor == expectedXor;
+    }
+
+    VerificationMetrics metrics;
+    metrics.writeTimeMs = writeTimeMs;
+    metrics.verifyTimeMs = verifyTimeMs;
+    metrics.totalTimeMs = writeTimeMs + verifyTimeMs;
+    metrics.bytesVerified = bufferSize;
+    metrics.verificationPassed = dataMatches;
+    metrics.verificationMethod = "compute_shader";
+
+    result.passed = dataMatches;
+    result.actualProperties["data_verified"] = dataMatches;
+    result.actualProperties["write_time_ms"] = writeTimeMs;
+    result.actualProperties["verify_time_ms"] = verifyTimeMs;
+    result.actualProperties["bytes_read_back"] = VERIFY_RESULT_SIZE;
+    result.actualProperties["gpu_hash_sum"] = gpuResult.hashSum;
+    result.actualProperties["gpu_hash_xor"] = gpuResult.hashXor;
+    if (expectedBuffer) {
+        result.actualProperties["mismatch_count"] = gpuResult.mismatchCount;
+    }
+
+    if (dataMatches) {
+        result.actualBehavior = "Data successfully written to device buffer and verified by a compute shader";
+
+        double throughputGBps = (bufferSize * 2.0) / ((writeTimeMs + verifyTimeMs) * 1e6);
+        result.actualProperties["throughput_gbps"] = throughputGBps;
+    } else if (expectedBuffer) {
+        const uint64_t firstMismatch = static_cast<uint64_t>(gpuResult.firstMismatchWord) * 4;
+        metrics.failureDetails = std::to_string(gpuResult.mismatchCount) +
+            " mismatching words, first at byte " + std::to_string(firstMismatch);
+        result.actualBehavior = "Data verification failed - corruption detected";
+        result.failureReason = "Data mismatch in the word at byte " + std::to_string(firstMismatch);
+        result.actualProperties["first_mismatch_byte"] = firstMismatch;
+    } else {
+        metrics.failureDetails = "GPU hash does not match the pattern";
+        result.actualBehavior = "Data verification failed - corruption detected";
+        result.failureReason = "GPU checksum does not match the expected pattern";
+    }
+    _allMetrics.push_back(metrics);
+
     return result;
 }
 
+// ComputeShaderVerification implementation
+bool BufferDataVerificationHandler::ComputeShaderVerification::execute(
+    const std::shared_ptr<DeviceBuffer>& dataBuffer,
+    const std::shared_ptr<DeviceBuffer>& expectedBuffer,
+    uint64_t size,
+    Result& result) {
+
+    if (!device || !dataBuffer || size == 0 || size % 4 != 0) {
+        return false;
+    }
+
+    if (!createPipeline()) {
+        return false;
+    }
+
+    auto resultBuffer = createResultBuffer();
+    if (!resultBuffer) {
+        return false;
+    }
+
+    auto readback = std::make_shared<DeferredStagingBuffer>();
+    if (!readback->create(VERIFY_RESULT_SIZE, MapMode::Read, device, "VerifyResultReadback")) {
+        return false;
+    }
+
+    if (!runVerificationCompute(dataBuffer, expectedBuffer, resultBuffer, readback, size)) {
+        return false;
+    }
+
+    return readResults(readback, result);
+}
+
+void BufferDataVerificationHandler::ComputeShaderVerification::hashPattern(
+    const TestPattern& pattern, uint32_t& hashSum, uint32_t& hashXor) {
+
+    hashSum = 0;
+    hashXor = 0;
+    const size_t wordCount = pattern.data.size() / 4;
+    for (size_t i = 0; i < wordCount; i++) {
+        uint32_t word = 0;
+        std::memcpy(&word, pattern.data.data() + i * 4, sizeof(word));
+        const uint32_t index = static_cast<uint32_t>(i);
+        hashSum += mixWord(word, index);
+        hashXor ^= mixWord(word, ~index);
+    }
+}
+
+bool BufferDataVerificationHandler::ComputeShaderVerification::createPipeline() {
+    // Pipelines belong to a device; shared devices can change between cases
+    if (_pipeline && _pipelineDevice.lock() == device) {
+        return true;
+    }
+    _pipeline.reset();
+    _bindGroupLayout.reset();
+
+    const auto& factory = device->getResourceFactory();
+    if (!factory) {
+        return false;
+    }
+
+    ShaderModuleDesc shaderDesc;
+    shaderDesc.code = VERIFY_SHADER;
+    shaderDesc.stage = ShaderStage::Compute;
+    shaderDesc.debugName = "BufferVerify";
+    auto shader = factory->createShaderModule(shaderDesc);
+    if (!shader || !shader->isValid()) {
+        LOG_ERROR("BufferDataVerificationHandler", "Failed to create verification shader");
+        return false;
+    }
+
+    BindGroupLayoutDesc layoutDesc;
+    layoutDesc.debugName = "BufferVerify";
+    layoutDesc.entries = {
+        {.binding = 0, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 1, .visibility = ShaderStage::Compute, .type = BindingType::ReadOnlyStorageBuffer},
+        {.binding = 2, .visibility = ShaderStage::Compute, .type = BindingType::StorageBuffer},
+        {.binding = 3, .visibility = ShaderStage::Compute, .type = BindingType::UniformBuffer},
+    };
+    auto bindGroupLayout = factory->createBindGroupLayout(layoutDesc);
+    if (!bindGroupLayout) {
+        LOG_ERROR("BufferDataVerificationHandler", "Failed to create verification bind group layout");
+        return false;
+    }
+
+    PipelineLayoutDesc pipelineLayoutDesc;
+    pipelineLayoutDesc.bindGroupLayouts = {bindGroupLayout};
+    pipelineLayoutDesc.debugName = "BufferVerify";
+    auto pipelineLayout = factory->createPipelineLayout(pipelineLayoutDesc);
+    if (!pipelineLayout) {
+        LOG_ERROR("BufferDataVerificationHandler", "Failed to create verification pipeline layout");
+        return false;
+    }
+
+    ComputePipelineDesc pipelineDesc;
+    pipelineDesc.compute = shader;
+    pipelineDesc.layout = pipelineLayout;
+    pipelineDesc.debugName = "BufferVerify";
+    auto pipeline = factory->createComputePipeline(pipelineDesc);
+    if (!pipeline) {
+        LOG_ERROR("BufferDataVerificationHandler", "Failed to create verification pipeline");
+        return false;
+    }
+
+    _bindGroupLayout = bindGroupLayout;
+    _pipeline = pipeline;
+    _pipelineDevice = device;
+    return true;
+}
+
+std::shared_ptr<DeviceBuffer> BufferDataVerificationHandler::ComputeShaderVerification::createResultBuffer() {
+    auto resultBuffer = std::make_shared<DeviceBuffer>();
+    if (!resultBuffer->create(VERIFY_RESULT_SIZE, DeviceBufferUsage::Storage | DeviceBufferUsage::CopySrc,
+                              device, "VerifyResult")) {
+        return nullptr;
+    }
+
+    // Mismatch count, first mismatching word, hash sum, hash xor
+    const uint32_t initial[4] = {0, UINT32_MAX, 0, 0};
+    auto queue = device->getQueue();
+    if (!queue || !queue->writeBuffer(resultBuffer, 0, std::as_bytes(std::span(initial)))) {
+        return nullptr;
+    }
+    return resultBuffer;
+}
+
+bool BufferDataVerificationHandler::ComputeShaderVerification::runVerificationCompute(
+    const std::shared_ptr<DeviceBuffer>& dataBuffer,
+    const std::shared_ptr<DeviceBuffer>& expectedBuffer,
+    const std::shared_ptr<DeviceBuffer>& resultBuffer,
+    const std::shared_ptr<DeferredStagingBuffer>& readback,
+    uint64_t size) {
+
+    const auto& factory = device->getResourceFactory();
+    auto queue = device->getQueue();
+    if (!factory || !queue) {
+        return false;
+    }
+
+    // Buffers past the storage binding limit are walked in aligned chunks
+    const DeviceLimits limits = device->getLimits();
+    const uint64_t maxBinding = limits.maxStorageBufferBindingSize > 0
+        ? limits.maxStorageBufferBindingSize : DEFAULT_MAX_STORAGE_BINDING_SIZE;
+    const uint64_t chunkSize = std::min(size, maxBinding / VERIFY_BINDING_ALIGNMENT * VERIFY_BINDING_ALIGNMENT);
+    const uint64_t chunkCount = (size + chunkSize - 1) / chunkSize;
+
+    // One aligned Params slot per chunk, all chunks go out in one submission
+    const size_t slotWords = VERIFY_BINDING_ALIGNMENT / sizeof(uint32_t);
+    std::vector<uint32_t> params(chunkCount * slotWords, 0);
+    for (uint64_t chunk = 0; chunk < chunkCount; chunk++) {
+        const uint64_t offset = chunk * chunkSize;
+        params[chunk * slotWords] = static_cast<uint32_t>(offset / 4);
+        params[chunk * slotWords + 1] = static_cast<uint32_t>(std::min(chunkSize, size - offset) / 4);
+    }
+
+    auto paramsBuffer = std::make_shared<DeviceBuffer>();
+    if (!paramsBuffer->create(params.size() * sizeof(uint32_t), DeviceBufferUsage::Uniform, device, "VerifyParams")) {
+        return false;
+    }
+    if (!queue->writeBuffer(paramsBuffer, 0, std::as_bytes(std::span(params)))) {
+        return false;
+    }
+
+    auto encoder = device->createCommandEncoder();
+    if (!encoder) {
+        return false;
+    }
+
+    ComputePassDesc passDesc;
+    passDesc.label = "BufferVerify";
+    auto pass = encoder->beginComputePass(passDesc);
+    if (!pass) {
+        return false;
+    }
+    pass->setPipeline(_pipeline);
+
+    const uint32_t maxGroups = std::min(VERIFY_MAX_WORKGROUPS,
+        limits.maxComputeWorkgroupsPerDimension > 0 ? limits.maxComputeWorkgroupsPerDimension : 65535u);
+    for (uint64_t chunk = 0; chunk < chunkCount; chunk++) {
+        const uint64_t offset = chunk * chunkSize;
+        const uint64_t bytes = std::min(chunkSize, size - offset);
+
+        // Hash-only runs read the data twice instead of binding an expected copy
+        const auto& expected = expectedBuffer ? expectedBuffer : dataBuffer;
+
+        BindGroupDesc desc;
+        desc.layout = _bindGroupLayout;
+        desc.debugName = "BufferVerify";
+        desc.entries.resize(4);
+        desc.entries[0].binding = 0;
+        desc.entries[0].buffer = dataBuffer;
+        desc.entries[0].offset = offset;
+        desc.entries[0].size = bytes;
+        desc.entries[1].binding = 1;
+        desc.entries[1].buffer = expected;
+        desc.entries[1].offset = offset;
+        desc.entries[1].size = bytes;
+        desc.entries[2].binding = 2;
+        desc.entries[2].buffer = resultBuffer;
+        desc.entries[2].size = VERIFY_RESULT_SIZE;
+        desc.entries[3].binding = 3;
+        desc.entries[3].buffer = paramsBuffer;
+        desc.entries[3].offset = chunk * VERIFY_BINDING_ALIGNMENT;
+        desc.entries[3].size = 2 * sizeof(uint32_t);
+        auto bindGroup = factory->createBindGroup(desc);
+        if (!bindGroup) {
+            pass->end();
+            return false;
+        }
+
+        const uint64_t words = bytes / 4;
+        const uint32_t groups = static_cast<uint32_t>(std::min<uint64_t>(
+            (words + VERIFY_WORKGROUP_SIZE - 1) / VERIFY_WORKGROUP_SIZE, maxGroups));
+        pass->setBindGroup(0, bindGroup);
+        pass->dispatch(groups);
+    }
+    pass->end();
+
+    BufferCopyDesc copyDesc;
+    copyDesc.srcOffset = 0;
+    copyDesc.dstOffset = 0;
+    copyDesc.size = VERIFY_RESULT_SIZE;
+    if (!encoder->downloadFromDeviceBuffer(resultBuffer, readback, copyDesc)) {
+        return false;
+    }
+
+    auto commandBuffer = encoder->finish();
+    if (!commandBuffer) {
+        return false;
+    }
+    queue->submit({commandBuffer});
+    return true;
+}
+
+bool BufferDataVerificationHandler::ComputeShaderVerification::readResults(
+    const std::shared_ptr<DeferredStagingBuffer>& readback, Result& result) {
+
+    auto mapFuture = readback->mapAsync(MapMode::Read, {0, VERIFY_RESULT_SIZE});
+    // Large buffers take a while on the GPU, but only the result has to map
+    auto mapStart = std::chrono::high_resolution_clock::now();
+    while (mapFuture.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+        if (instance) {
+            instance->processEvents();
+        }
+        auto elapsed = std::chrono::high_resolution_clock::now() - mapStart;
+        if (elapsed > std::chrono::seconds(30)) break;
+    }
+    if (mapFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+
+    auto mapped = mapFuture.get();
+    if (!mapped.data()) {
+        readback->unmap();
+        return false;
+    }
+
+    uint32_t values[4] = {};
+    std::memcpy(values, mapped.data(), sizeof(values));
+    readback->unmap();
+
+    result.mismatchCount = values[0];
+    result.firstMismatchWord = values[1];
+    result.hashSum = values[2];
+    result.hashXor = values[3];
+    return true;
+}
+
 TestResult BufferDataVerificationHandler::verifyThroughRendering(const TestVariation& variation) {
     TestResult result;
     
@@ -7,6 +7,8 @@
 #include "pers/graphics/ILogicalDevice.h"
 #include "pers/graphics/IResourceFactory.h"
 #include "pers/graphics/ICommandEncoder.h"
+#include "pers/graphics/IBindGroupLayout.h"
+#include "pers/graphics/IComputePipeline.h"
 #include "pers/graphics/IQueue.h"
 #include "pers/graphics/buffers/BufferTypes.h"
 #include "pers/graphics/buffers/IBuffer.h"
@@ -39,6 +41,9 @@ public:
     std::string getTestType() const override;
     TestResult execute(const TestVariation& variation) override;
     
+    // Toggles process-wide logger levels per case, so always runs on its own
+    bool canRunInParallel() const override { return false; }
+    
 private:
     // Verification methods
     TestResult verifyThroughDirectMapping(const TestVariation& variation);
@@ -104,24 +109,44 @@ private:
     };
     
     // Method 3: Compute Shader Verification
+    // Compares and hashes the buffer on the GPU, so only a 16-byte result is read back
     struct ComputeShaderVerification {
         std::shared_ptr<ILogicalDevice> device;
-        std::shared_ptr<IResourceFactory> resourceFactory;
+        std::shared_ptr<IInstance> instance;  // Pumped while the result maps
+        
+        struct Result {
+            uint32_t mismatchCount = 0;
+            uint32_t firstMismatchWord = UINT32_MAX;  // UINT32_MAX when every word matched
+            uint32_t hashSum = 0;
+            uint32_t hashXor = 0;
+        };
         
+        // Null expectedBuffer skips the compare and only hashes; size must be a multiple of 4
         bool execute(
-            std::shared_ptr<IBuffer> buffer,
-            const TestPattern& pattern
+            const std::shared_ptr<DeviceBuffer>& dataBuffer,
+            const std::shared_ptr<DeviceBuffer>& expectedBuffer,
+            uint64_t size,
+            Result& result
         );
         
+        // CPU mirror of the kernel's hash
+        static void hashPattern(const TestPattern& pattern, uint32_t& hashSum, uint32_t& hashXor);
+        
     private:
-        std::string generateVerificationShader(size_t dataSize);
-        std::shared_ptr<IBuffer> createResultBuffer();
+        bool createPipeline();
+        std::shared_ptr<DeviceBuffer> createResultBuffer();
         bool runVerificationCompute(
-            std::shared_ptr<IBuffer> dataBuffer,
-            std::shared_ptr<IBuffer> expectedBuffer,
-            std::shared_ptr<IBuffer> resultBuffer
+            const std::shared_ptr<DeviceBuffer>& dataBuffer,
+            const std::shared_ptr<DeviceBuffer>& expectedBuffer,
+            const std::shared_ptr<DeviceBuffer>& resultBuffer,
+            const std::shared_ptr<DeferredStagingBuffer>& readback,
+            uint64_t size
         );
-        bool checkResults(std::shared_ptr<IBuffer> resultBuffer);
+        bool readResults(const std::shared_ptr<DeferredStagingBuffer>& readback, Result& result);
+        
+        std::weak_ptr<ILogicalDevice> _pipelineDevice;
+        std::shared_ptr<IBindGroupLayout> _bindGroupLayout;
+        std::shared_ptr<IComputePipeline> _pipeline;
     };
     
     // Method 4: Rendering Verification
@@ -1,4 +1,5 @@
 #include "webgpu_buffer_handler.h"
+#include "../../shared_test_device.h"
 #include "pers/graphics/backends/webgpu/WebGPUInstanceFactory.h"
 #include "pers/graphics/GraphicsEnumStrings.h"
 #include <iostream>
@@ -24,6 +25,15 @@ bool WebGPUBufferHandler::initializeDevice() {
         return true;
     }
     
+    if (_sharedDevices) {
+        _logicalDevice = _sharedDevices->getDevice({false, PowerPreference::HighPerformance});
+        if (!_logicalDevice) {
+            return false;
+        }
+        _resourceFactory = _logicalDevice->getResourceFactory();
+        return _resourceFactory != nullptr;
+    }
+    
     // Create instance
     InstanceDesc instanceDesc;
     instanceDesc.applicationName = "WebGPUBuffer Test";
@@ -150,6 +160,18 @@ TestResult WebGPUBufferHandler::testBasicCreation(const TestVariation& variation
     if (result.passed) {
         result.actualBehavior = "Buffer created successfully with correct properties";
         _createdBuffers.push_back(buffer);
+        
+        // Creation plus release of the native handle, as one streaming allocation would pay
+        if (variation.timing.isEnabled()) {
+            bool timed = measureTiming(variation.timing, result, [this, &desc]() {
+                auto timedBuffer = _resourceFactory->createBuffer(desc);
+                return timedBuffer != nullptr;
+            });
+            if (!timed) {
+                result.passed = false;
+                result.failureReason = "Buffer creation failed during timing iterations";
+            }
+        }
     } else {
         result.actualBehavior = "Buffer creation failed or properties incorrect";
     }
@@ -24,6 +24,7 @@ public:
     
     std::string getTestType() const override;
     TestResult execute(const TestVariation& variation) override;
+    bool canRunInParallel() const override { return true; }
     
 private:
     // Test methods
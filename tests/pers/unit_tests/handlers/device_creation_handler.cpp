@@ -1,4 +1,5 @@
 #include "device_creation_handler.h"
+#include "../shared_test_device.h"
 #include <pers/graphics/ILogicalDevice.h>
 
 namespace pers::tests {
@@ -8,6 +9,12 @@ bool DeviceCreationHandler::initializeAdapter() {
             return true;
         }
         
+        // Each case creates its own device from the shared adapter
+        if (_sharedDevices) {
+            _adapter = _sharedDevices->getAdapter(SharedDeviceKey{});
+            return _adapter != nullptr;
+        }
+        
         // Create instance
         if (!_instance) {
             InstanceDesc instanceDesc;
@@ -126,8 +133,13 @@ TestResult DeviceCreationHandler::execute(const TestVariation& variation) {
                             } catch (...) {}
                         }
                     } else if (key == "maxBufferSize") {
-                        // Note: DeviceLimits doesn't have maxBufferSize field
-                        // This may need to be handled differently or ignored
+                        try {
+                            limits->maxBufferSize = std::any_cast<int>(value);
+                        } catch (...) {
+                            try {
+                                limits->maxBufferSize = std::any_cast<size_t>(value);
+                            } catch (...) {}
+                        }
                     } else if (key == "maxTextureDimension2D") {
                         try {
                             limits->maxTextureDimension2D = std::any_cast<int>(value);
@@ -18,6 +18,7 @@ public:
     DeviceCreationHandler();
     std::string getTestType() const override;
     TestResult execute(const TestVariation& variation) override;
+    bool canRunInParallel() const override { return true; }
 };
 
 } // namespace pers::tests
\ No newline at end of file
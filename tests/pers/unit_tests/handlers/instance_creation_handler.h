@@ -12,6 +12,7 @@ public:
     InstanceCreationHandler();
     std::string getTestType() const override;
     TestResult execute(const TestVariation& variation) override;
+    bool canRunInParallel() const override { return true; }
 };
 
 } // namespace pers::tests
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "request_adapter_handler.h"
+#include "../shared_test_device.h"
 #include <pers/graphics/IPhysicalDevice.h>
 #include <pers/graphics/backends/IGraphicsInstanceFactory.h>
 
@@ -9,6 +10,11 @@ bool RequestAdapterHandler::initializeInstance() {
             return true;
         }
         
+        if (_sharedDevices) {
+            _instance = _sharedDevices->getInstance(false);
+            return _instance != nullptr;
+        }
+        
         InstanceDesc desc;
         desc.applicationName = "Adapter Test";
         desc.engineName = "Pers Graphics Engine";
@@ -16,6 +16,7 @@ public:
     RequestAdapterHandler();
     std::string getTestType() const override;
     TestResult execute(const TestVariation& variation) override;
+    bool canRunInParallel() const override { return true; }
 };
 
 } // namespace pers::tests
\ No newline at end of file
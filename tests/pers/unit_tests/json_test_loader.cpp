@@ -123,6 +123,22 @@ TestVariation JsonTestLoader::parseVariation(const void* jsonObj) {
         variation.expectedBehavior = parseExpectedBehavior(&obj["expectedBehavior"]);
     }
     
+    if (obj.HasMember("timing") && obj["timing"].IsObject()) {
+        const auto& timing = obj["timing"];
+        if (timing.HasMember("iterations") && timing["iterations"].IsInt()) {
+            variation.timing.iterations = timing["iterations"].GetInt();
+        }
+        if (timing.HasMember("warmup") && timing["warmup"].IsInt()) {
+            variation.timing.warmup = timing["warmup"].GetInt();
+        }
+        if (timing.HasMember("p50_budget_ms") && timing["p50_budget_ms"].IsNumber()) {
+            variation.timing.p50BudgetMs = timing["p50_budget_ms"].GetDouble();
+        }
+        if (timing.HasMember("p99_budget_ms") && timing["p99_budget_ms"].IsNumber()) {
+            variation.timing.p99BudgetMs = timing["p99_budget_ms"].GetDouble();
+        }
+    }
+    
     return variation;
 }
 
@@ -258,7 +274,8 @@ std::unordered_map<std::string, std::any> JsonTestLoader::parseOptions(const voi
 bool JsonTestLoader::saveTestResults(const std::string& filePath,
                                      const std::vector<TestTypeDefinition>& testTypes,
                                      const std::vector<std::vector<TestResult>>& results,
-                                     const std::string& testCaseJsonPath) {
+                                     const std::string& testCaseJsonPath,
+                                     const RunnerInfo& runner) {
     Document doc;
     doc.SetObject();
     auto& allocator = doc.GetAllocator();
@@ -333,6 +350,14 @@ bool JsonTestLoader::saveTestResults(const std::string& filePath,
     metadata.AddMember("pass_rate", passRate, allocator);
     metadata.AddMember("total_time_ms", totalTime, allocator);
     
+    // total_time_ms sums the cases; with parallel workers the run took wall_time_ms
+    Value runnerObj(kObjectType);
+    runnerObj.AddMember("mode", Value().SetString(runner.parallel ? "parallel" : "sequential", allocator), allocator);
+    runnerObj.AddMember("jobs", runner.jobs, allocator);
+    runnerObj.AddMember("shared_device", runner.sharedDevice, allocator);
+    runnerObj.AddMember("wall_time_ms", runner.wallTimeMs, allocator);
+    metadata.AddMember("runner", runnerObj, allocator);
+    
     // Add test case JSON path
     if (!testCaseJsonPath.empty()) {
         metadata.AddMember("test_case_json", Value().SetString(testCaseJsonPath.c_str(), allocator), allocator);
@@ -484,8 +509,31 @@ bool JsonTestLoader::saveTestResults(const std::string& filePath,
                 execTime = std::any_cast<double>(result.actualProperties.at("executionTime"));
             }
             resultObj.AddMember("execution_time_ms", execTime, allocator);
+            resultObj.AddMember("start_offset_ms", result.startOffsetMs, allocator);
+            resultObj.AddMember("worker", result.worker, allocator);
             resultObj.AddMember("timestamp", Value().SetString(timeStr, allocator), allocator);
             
+            // Add timing statistics for performance variations
+            if (result.timing.hasSamples()) {
+                Value timingObj(kObjectType);
+                timingObj.AddMember("iterations", static_cast<int>(result.timing.samplesMs.size()), allocator);
+                timingObj.AddMember("warmup", result.timing.warmup, allocator);
+                timingObj.AddMember("p50_ms", result.timing.p50Ms, allocator);
+                timingObj.AddMember("p99_ms", result.timing.p99Ms, allocator);
+                timingObj.AddMember("mean_ms", result.timing.meanMs, allocator);
+                timingObj.AddMember("min_ms", result.timing.minMs, allocator);
+                timingObj.AddMember("max_ms", result.timing.maxMs, allocator);
+                if (variation.timing.p50BudgetMs > 0.0) {
+                    timingObj.AddMember("p50_budget_ms", variation.timing.p50BudgetMs, allocator);
+                }
+                if (variation.timing.p99BudgetMs > 0.0) {
+                    timingObj.AddMember("p99_budget_ms", variation.timing.p99BudgetMs, allocator);
+                }
+                timingObj.AddMember("within_budget",
+                                    checkTimingBudget(variation.timing, result.timing).empty(), allocator);
+                resultObj.AddMember("timing", timingObj, allocator);
+            }
+            
             // Add structured log messages from test result
             Value logMessages(kArrayType);
             for (const auto& log : result.logMessages) {
@@ -546,6 +594,88 @@ bool JsonTestLoader::saveTestResults(const std::string& filePath,
     return true;
 }
 
+bool JsonTestLoader::appendTimingHistory(const std::string& historyPath,
+                                         const std::string& sessionId,
+                                         const std::vector<TestTypeDefinition>& testTypes,
+                                         const std::vector<std::vector<TestResult>>& results) {
+    Document doc;
+    
+    // Start a new history if the file is missing or unreadable
+    FILE* fp = std::fopen(historyPath.c_str(), "rb");
+    if (fp) {
+        char readBuffer[65536];
+        FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+        doc.ParseStream(is);
+        std::fclose(fp);
+    }
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("runs") || !doc["runs"].IsArray()) {
+        doc.SetObject();
+        Value runs(kArrayType);
+        doc.AddMember("fileType", Value().SetString("perf_history", doc.GetAllocator()), doc.GetAllocator());
+        doc.AddMember("runs", runs, doc.GetAllocator());
+    }
+    auto& allocator = doc.GetAllocator();
+    
+    Value entries(kArrayType);
+    for (size_t i = 0; i < testTypes.size() && i < results.size(); i++) {
+        const auto& testType = testTypes[i];
+        for (size_t j = 0; j < testType.variations.size() && j < results[i].size(); j++) {
+            const auto& variation = testType.variations[j];
+            const auto& result = results[i][j];
+            if (!result.timing.hasSamples()) {
+                continue;
+            }
+            
+            Value entry(kObjectType);
+            entry.AddMember("id", Value().SetString(variation.combinedId.c_str(), allocator), allocator);
+            entry.AddMember("testType", Value().SetString(testType.testType.c_str(), allocator), allocator);
+            entry.AddMember("variationName", Value().SetString(variation.variationName.c_str(), allocator), allocator);
+            entry.AddMember("iterations", static_cast<int>(result.timing.samplesMs.size()), allocator);
+            entry.AddMember("p50_ms", result.timing.p50Ms, allocator);
+            entry.AddMember("p99_ms", result.timing.p99Ms, allocator);
+            entry.AddMember("mean_ms", result.timing.meanMs, allocator);
+            entry.AddMember("p50_budget_ms", variation.timing.p50BudgetMs, allocator);
+            entry.AddMember("p99_budget_ms", variation.timing.p99BudgetMs, allocator);
+            entry.AddMember("passed", result.passed, allocator);
+            entries.PushBack(entry, allocator);
+        }
+    }
+    
+    // Nothing to track, leave the history untouched
+    if (entries.Empty()) {
+        return true;
+    }
+    
+    auto now = std::chrono::system_clock::now();
+    auto time_t = std::chrono::system_clock::to_time_t(now);
+    char timeStr[100];
+    std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&time_t));
+    
+    Value run(kObjectType);
+    run.AddMember("timestamp", Value().SetString(timeStr, allocator), allocator);
+    run.AddMember("session", Value().SetString(sessionId.c_str(), allocator), allocator);
+    run.AddMember("results", entries, allocator);
+    
+    auto& runs = doc["runs"];
+    runs.PushBack(run, allocator);
+    while (runs.Size() > MAX_HISTORY_RUNS) {
+        runs.Erase(runs.Begin());
+    }
+    
+    fp = std::fopen(historyPath.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    
+    char writeBuffer[65536];
+    FileWriteStream os(fp, writeBuffer, sizeof(writeBuffer));
+    PrettyWriter<FileWriteStream> writer(os);
+    doc.Accept(writer);
+    std::fclose(fp);
+    
+    return true;
+}
+
 std::string JsonTestLoader::generateFileHash(const std::string& filePath) {
     // Combine file path and current timestamp
     auto now = std::chrono::system_clock::now();
@@ -16,7 +16,17 @@ public:
     static bool saveTestResults(const std::string& filePath,
                                const std::vector<TestTypeDefinition>& testTypes,
                                const std::vector<std::vector<TestResult>>& results,
-                               const std::string& testCaseJsonPath = "");
+                               const std::string& testCaseJsonPath = "",
+                               const RunnerInfo& runner = RunnerInfo());
+    
+    // Append timing results of this run to the performance history file,
+    // keeping the most recent MAX_HISTORY_RUNS runs
+    static bool appendTimingHistory(const std::string& historyPath,
+                                    const std::string& sessionId,
+                                    const std::vector<TestTypeDefinition>& testTypes,
+                                    const std::vector<std::vector<TestResult>>& results);
+    
+    static constexpr size_t MAX_HISTORY_RUNS = 200;
     
     // Generate a 5-character hash from file path and timestamp
     static std::string generateFileHash(const std::string& filePath);
@@ -1,5 +1,8 @@
 #include "test_handler_base.h"
 #include "json_test_loader.h"
+#include "shared_test_device.h"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <chrono>
@@ -9,6 +12,8 @@
 #include <sstream>
 #include <ctime>
 #include <filesystem>
+#include <map>
+#include <mutex>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -97,6 +102,12 @@ void printTestResult(const TestTypeDefinition& testType,
     std::cout << testType.category << " - " << testType.testType << " - " << variation.variationName;
     std::cout << " (ID: " << variation.combinedId << ")";
     
+    if (result.timing.hasSamples()) {
+        std::cout << std::fixed << std::setprecision(3)
+                  << " [p50 " << result.timing.p50Ms << " ms, p99 " << result.timing.p99Ms
+                  << " ms, n=" << result.timing.samplesMs.size() << "]";
+    }
+    
     if (!result.passed) {
         std::cout << "\n  Reason: " << result.failureReason;
         std::cout << "\n  Actual: " << result.actualBehavior;
@@ -104,6 +115,77 @@ void printTestResult(const TestTypeDefinition& testType,
     std::cout << std::endl;
 }
 
+// Runner flags, anywhere on the command line:
+//   --parallel[=N]    run handlers that allow it on N worker threads (default:
+//                     hardware threads); implies --shared-device
+//   --shared-device   share instances, adapters and devices between cases
+struct RunnerOptions {
+    bool parallel = false;
+    bool sharedDevice = false;
+    unsigned jobs = 1;
+};
+
+bool parseRunnerOption(const std::string& arg, RunnerOptions& options) {
+    if (arg == "--shared-device") {
+        options.sharedDevice = true;
+        return true;
+    }
+    if (arg == "--parallel" || arg.rfind("--parallel=", 0) == 0) {
+        options.parallel = true;
+        options.sharedDevice = true;
+        unsigned jobs = 0;
+        if (arg.size() > 11) {
+            jobs = static_cast<unsigned>(std::strtoul(arg.c_str() + 11, nullptr, 10));
+        }
+        options.jobs = jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency());
+        return true;
+    }
+    return false;
+}
+
+bool hasTodoOrDieLog(const TestResult& result) {
+    for (const auto& log : result.logMessages) {
+        if (log.level == "TODO_OR_DIE") {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Timing and budget checks shared by both runner modes
+TestResult runVariation(ITestHandler& handler, const TestVariation& variation,
+                        std::chrono::high_resolution_clock::time_point runStart, int worker) {
+    auto testStart = std::chrono::high_resolution_clock::now();
+    TestResult result = handler.execute(variation);
+    auto testEnd = std::chrono::high_resolution_clock::now();
+    
+    // Handlers that return before transferring their logs leave the capture open
+    ThreadLogCapture::end();
+    
+    // Calculate execution time in milliseconds
+    auto testDuration = std::chrono::duration_cast<std::chrono::microseconds>(testEnd - testStart);
+    double executionTimeMs = testDuration.count() / 1000.0;
+    result.actualProperties["executionTime"] = executionTimeMs;
+    result.startOffsetMs = std::chrono::duration<double, std::milli>(testStart - runStart).count();
+    result.worker = worker;
+    
+    // Budgets only apply once the functional checks passed
+    if (variation.timing.isEnabled() && result.passed) {
+        if (!result.timing.hasSamples()) {
+            result.passed = false;
+            result.failureReason = "Timing requested but handler reported no samples";
+        } else {
+            std::string budgetFailure = checkTimingBudget(variation.timing, result.timing);
+            if (!budgetFailure.empty()) {
+                result.passed = false;
+                result.failureReason = "Performance regression: " + budgetFailure;
+            }
+        }
+    }
+    
+    return result;
+}
+
 // Include handler headers
 #include "handlers/instance_creation_handler.h"
 #include "handlers/request_adapter_handler.h"  
@@ -173,10 +255,18 @@ int main(int argc, char* argv[]) {
     std::string outputFile = resultsDir + "/result.json";
     std::string inputPath;
     
-    if (argc >= 2) {
-        inputPath = argv[1];
-        if (argc >= 3) {
-            outputFile = argv[2];
+    RunnerOptions options;
+    std::vector<std::string> positional;
+    for (int i = 1; i < argc; i++) {
+        if (!parseRunnerOption(argv[i], options)) {
+            positional.push_back(argv[i]);
+        }
+    }
+    
+    if (!positional.empty()) {
+        inputPath = positional[0];
+        if (positional.size() >= 2) {
+            outputFile = positional[1];
         }
     } else {
         // Use default directory from CMake or fallback
@@ -244,11 +334,25 @@ int main(int argc, char* argv[]) {
     for (const auto& testType : testTypes) {
         totalTests += testType.variations.size();
     }
-    std::cout << "Total test variations: " << totalTests << std::endl << std::endl;
+    std::cout << "Total test variations: " << totalTests << std::endl;
+    if (options.parallel) {
+        std::cout << "Runner: parallel, " << options.jobs << " worker(s)";
+    } else {
+        std::cout << "Runner: sequential";
+    }
+    std::cout << (options.sharedDevice ? ", shared device" : "") << std::endl << std::endl;
     
     // Execute tests
     auto& registry = TestHandlerRegistry::Instance();
-    std::vector<std::vector<TestResult>> allResults;
+    std::vector<std::vector<TestResult>> allResults(testTypes.size());
+    
+    std::shared_ptr<SharedTestDevicePool> sharedDevices;
+    if (options.sharedDevice) {
+        sharedDevices = std::make_shared<SharedTestDevicePool>();
+        for (const auto& type : registry.getAllTestTypes()) {
+            registry.getHandler(type)->setSharedDevices(sharedDevices);
+        }
+    }
     
     size_t passedCount = 0;
     size_t failedCount = 0;
@@ -257,8 +361,17 @@ int main(int argc, char* argv[]) {
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    for (const auto& testType : testTypes) {
-        std::vector<TestResult> typeResults;
+    // All test types of one handler run in order on one thread, since handlers
+    // keep state between cases; one handler may serve several test types
+    struct HandlerLane {
+        std::shared_ptr<ITestHandler> handler;
+        std::vector<size_t> typeIndices;
+        size_t variationCount = 0;
+    };
+    std::map<ITestHandler*, HandlerLane> lanesByHandler;
+    
+    for (size_t i = 0; i < testTypes.size(); i++) {
+        const auto& testType = testTypes[i];
         
         // Get handler for this test type
         auto handler = registry.getHandler(testType.testType);
@@ -272,49 +385,85 @@ int main(int argc, char* argv[]) {
                 result.passed = false;
                 result.actualBehavior = "Test Not Implemented";
                 result.failureReason = "No test handler for " + testType.testType;
-                typeResults.push_back(result);
-                testNotImplementedCount++;
+                allResults[i].push_back(result);
                 
                 std::cout << "[NYI ] " << testType.category << " - " << testType.testType 
                          << " - " << variation.variationName << " (ID: " << variation.combinedId << ")" << std::endl;
             }
-        } else {
-            // Execute each variation
+            continue;
+        }
+        
+        auto& lane = lanesByHandler[handler.get()];
+        lane.handler = handler;
+        lane.typeIndices.push_back(i);
+        lane.variationCount += testType.variations.size();
+    }
+    
+    std::mutex printMutex;
+    auto runLane = [&](const HandlerLane& lane, int worker) {
+        for (size_t typeIndex : lane.typeIndices) {
+            const auto& testType = testTypes[typeIndex];
+            auto& typeResults = allResults[typeIndex];
+            typeResults.reserve(testType.variations.size());
             for (const auto& variation : testType.variations) {
-                // Measure execution time
-                auto testStart = std::chrono::high_resolution_clock::now();
-                TestResult result = handler->execute(variation);
-                auto testEnd = std::chrono::high_resolution_clock::now();
-                
-                // Calculate execution time in milliseconds
-                auto testDuration = std::chrono::duration_cast<std::chrono::microseconds>(testEnd - testStart);
-                double executionTimeMs = testDuration.count() / 1000.0;
-                result.actualProperties["executionTime"] = executionTimeMs;
-                
-                // Check for TodoOrDie logs to detect engine NYI
-                bool hasTodoOrDie = false;
-                for (const auto& log : result.logMessages) {
-                    if (log.level == "TODO_OR_DIE") {
-                        hasTodoOrDie = true;
-                        break;
-                    }
-                }
+                typeResults.push_back(runVariation(*lane.handler, variation, startTime, worker));
                 
-                typeResults.push_back(result);
-                
-                if (result.passed) {
-                    passedCount++;
-                } else if (hasTodoOrDie) {
-                    engineFeatureNYICount++;
-                } else {
-                    failedCount++;
+                std::lock_guard<std::mutex> lock(printMutex);
+                printTestResult(testType, variation, typeResults.back());
+            }
+        }
+    };
+    
+    std::vector<const HandlerLane*> parallelLanes;
+    std::vector<const HandlerLane*> serialLanes;
+    for (const auto& [handlerPtr, lane] : lanesByHandler) {
+        if (options.parallel && lane.handler->canRunInParallel()) {
+            parallelLanes.push_back(&lane);
+        } else {
+            serialLanes.push_back(&lane);
+        }
+    }
+    
+    // Longest lanes first so one big handler does not finish last on its own
+    std::sort(parallelLanes.begin(), parallelLanes.end(), [](const HandlerLane* a, const HandlerLane* b) {
+        return a->variationCount > b->variationCount;
+    });
+    
+    if (!parallelLanes.empty()) {
+        std::atomic<size_t> nextLane{0};
+        size_t workerCount = std::min<size_t>(options.jobs, parallelLanes.size());
+        std::vector<std::thread> workers;
+        workers.reserve(workerCount);
+        for (size_t w = 0; w < workerCount; w++) {
+            workers.emplace_back([&, worker = static_cast<int>(w + 1)]() {
+                for (size_t lane = nextLane++; lane < parallelLanes.size(); lane = nextLane++) {
+                    runLane(*parallelLanes[lane], worker);
                 }
-                
-                printTestResult(testType, variation, result);
+            });
+        }
+        for (auto& thread : workers) {
+            thread.join();
+        }
+    }
+    
+    // Handlers touching process-wide state (windows, logger levels) run alone on the main thread
+    for (const HandlerLane* lane : serialLanes) {
+        runLane(*lane, 0);
+    }
+    
+    // Count in test order once every case finished
+    for (size_t i = 0; i < testTypes.size(); i++) {
+        for (const auto& result : allResults[i]) {
+            if (result.actualBehavior == "Test Not Implemented") {
+                testNotImplementedCount++;
+            } else if (result.passed) {
+                passedCount++;
+            } else if (hasTodoOrDieLog(result)) {
+                engineFeatureNYICount++;
+            } else {
+                failedCount++;
             }
         }
-        
-        allResults.push_back(typeResults);
     }
     
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -343,13 +492,25 @@ int main(int argc, char* argv[]) {
     // Get absolute path for input path (directory or file)
     fs::path inputAbsolutePath = fs::absolute(inputPath);
     
+    RunnerInfo runner;
+    runner.parallel = options.parallel;
+    runner.jobs = options.parallel ? options.jobs : 1;
+    runner.sharedDevice = options.sharedDevice;
+    runner.wallTimeMs = static_cast<double>(duration.count());
+    
     // Save results
-    if (JsonTestLoader::saveTestResults(outputFile, testTypes, allResults, inputAbsolutePath.string())) {
+    if (JsonTestLoader::saveTestResults(outputFile, testTypes, allResults, inputAbsolutePath.string(), runner)) {
         std::cout << "Results saved to: " << outputFile << std::endl;
     } else {
         std::cerr << "Failed to save results to: " << outputFile << std::endl;
     }
     
+    // Keep timings across sessions for the viewer's performance history
+    std::string historyFile = "./unit_test_results/perf_history.json";
+    if (!JsonTestLoader::appendTimingHistory(historyFile, ss.str(), testTypes, allResults)) {
+        std::cerr << "Failed to update performance history: " << historyFile << std::endl;
+    }
+    
 #ifdef _WIN32
     // Get absolute paths
     fs::path absoluteResultPath = fs::absolute(outputFile);
@@ -361,6 +522,9 @@ int main(int argc, char* argv[]) {
     
     // Clear all handlers before main exits to ensure proper destruction order
     registry.clear();
+    if (sharedDevices) {
+        sharedDevices->clear();
+    }
     
     return (failedCount == 0) ? 0 : 1;
 }
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "shared_test_device.h"
+#include <pers/graphics/backends/webgpu/WebGPUInstanceFactory.h>
+#include <pers/graphics/IPhysicalDevice.h>
+#include <pers/graphics/ILogicalDevice.h>
+
+namespace pers::tests {
+
+SharedTestDevicePool::SharedTestDevicePool()
+    : _factory(std::make_shared<WebGPUInstanceFactory>()) {
+}
+
+SharedTestDevicePool::~SharedTestDevicePool() {
+    clear();
+}
+
+std::shared_ptr<IInstance> SharedTestDevicePool::getInstance(bool enableValidation) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getInstanceLocked(enableValidation);
+}
+
+std::shared_ptr<IPhysicalDevice> SharedTestDevicePool::getAdapter(const SharedDeviceKey& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getAdapterLocked(key);
+}
+
+std::shared_ptr<ILogicalDevice> SharedTestDevicePool::getDevice(const SharedDeviceKey& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto& device = _devices[key];
+    if (!device) {
+        auto adapter = getAdapterLocked(key);
+        if (!adapter) {
+            return nullptr;
+        }
+        LogicalDeviceDesc desc;
+        desc.enableValidation = key.enableValidation;
+        desc.debugName = "Shared Test Device";
+        device = adapter->createLogicalDevice(desc);
+    }
+    return device;
+}
+
+void SharedTestDevicePool::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _devices.clear();
+    _adapters.clear();
+    _instances.clear();
+}
+
+std::shared_ptr<IInstance> SharedTestDevicePool::getInstanceLocked(bool enableValidation) {
+    auto& instance = _instances[enableValidation];
+    if (!instance) {
+        InstanceDesc desc;
+        desc.applicationName = "Pers Unit Tests";
+        desc.engineName = "Pers Graphics Engine";
+        desc.enableValidation = enableValidation;
+        instance = _factory->createInstance(desc);
+    }
+    return instance;
+}
+
+std::shared_ptr<IPhysicalDevice> SharedTestDevicePool::getAdapterLocked(const SharedDeviceKey& key) {
+    auto& adapter = _adapters[key];
+    if (!adapter) {
+        auto instance = getInstanceLocked(key.enableValidation);
+        if (!instance) {
+            return nullptr;
+        }
+        PhysicalDeviceOptions options;
+        options.powerPreference = key.powerPreference;
+        adapter = instance->requestPhysicalDevice(options);
+    }
+    return adapter;
+}
+
+} // namespace pers::tests
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <pers/graphics/IInstance.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace pers {
+    class IGraphicsInstanceFactory;
+    class IPhysicalDevice;
+    class ILogicalDevice;
+}
+
+namespace pers::tests {
+
+// Cases that would create the same device can share one
+struct SharedDeviceKey {
+    bool enableValidation = false;
+    PowerPreference powerPreference = PowerPreference::Default;
+    
+    bool operator<(const SharedDeviceKey& other) const {
+        return std::pair(enableValidation, powerPreference) < std::pair(other.enableValidation, other.powerPreference);
+    }
+};
+
+// Instances, adapters and devices shared by handlers across a test run, so
+// each case does not pay for creating them again. Created on first request
+// and kept until clear(). Thread-safe; handlers running in parallel get the
+// same objects for the same key.
+class SharedTestDevicePool {
+public:
+    SharedTestDevicePool();
+    ~SharedTestDevicePool();
+    
+    std::shared_ptr<IInstance> getInstance(bool enableValidation);
+    std::shared_ptr<IPhysicalDevice> getAdapter(const SharedDeviceKey& key);
+    
+    // Default features and limits
+    std::shared_ptr<ILogicalDevice> getDevice(const SharedDeviceKey& key);
+    
+    // Devices first, then adapters and instances
+    void clear();
+    
+private:
+    std::shared_ptr<IInstance> getInstanceLocked(bool enableValidation);
+    std::shared_ptr<IPhysicalDevice> getAdapterLocked(const SharedDeviceKey& key);
+    
+    std::mutex _mutex;
+    std::shared_ptr<IGraphicsInstanceFactory> _factory;
+    std::map<bool, std::shared_ptr<IInstance>> _instances;
+    std::map<SharedDeviceKey, std::shared_ptr<IPhysicalDevice>> _adapters;
+    std::map<SharedDeviceKey, std::shared_ptr<ILogicalDevice>> _devices;
+};
+
+} // namespace pers::tests
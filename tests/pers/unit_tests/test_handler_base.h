@@ -8,9 +8,12 @@
 #include <iomanip>
 #include <ctime>
 #include <chrono>
+#include <mutex>
 
 namespace pers::tests {
 
+class SharedTestDevicePool;
+
 // Base interface for all test handlers
 class ITestHandler {
 public:
@@ -21,84 +24,171 @@ public:
     
     // Get test type this handler handles
     virtual std::string getTestType() const = 0;
+    
+    // Whether this handler's cases may run on a worker thread, concurrently
+    // with other handlers. Calls to one handler are never concurrent.
+    virtual bool canRunInParallel() const { return false; }
+    
+    // Pool to take instances, adapters and devices from instead of creating
+    // them per handler; null (the default) keeps handlers self-contained
+    virtual void setSharedDevices(const std::shared_ptr<SharedTestDevicePool>& pool) {}
 };
 
+// Routes logger callbacks to the capture started on the logging thread, so
+// handlers running on different threads keep their logs apart. Callbacks
+// stay installed while any thread captures.
+class ThreadLogCapture {
+public:
+    static void begin(std::vector<LogEntry>* logs);
+    
+    // No-op if the calling thread is not capturing
+    static void end();
+    
+private:
+    static std::vector<LogEntry>*& target() {
+        thread_local std::vector<LogEntry>* t_target = nullptr;
+        return t_target;
+    }
+    
+    static std::mutex& mutex() {
+        static std::mutex instance;
+        return instance;
+    }
+    
+    static size_t& activeCount() {
+        static size_t count = 0;
+        return count;
+    }
+    
+    static void setCallbacks(const pers::Logger::LogCallback& callback) {
+        pers::Logger::Instance().setCallback(pers::LogLevel::Trace, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::Debug, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::Info, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::TodoSomeday, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::Warning, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::TodoOrDie, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::Error, callback);
+        pers::Logger::Instance().setCallback(pers::LogLevel::Critical, callback);
+    }
+    
+    static void captureCallback(pers::LogLevel level, const std::string& category,
+                                const std::string& message, const pers::LogSource& source,
+                                const std::chrono::system_clock::time_point& timestamp,
+                                bool& skipLogging) {
+        skipLogging = false;
+        std::vector<LogEntry>* logs = target();
+        if (!logs) {
+            return;  // Another thread's capture, or a thread the engine started
+        }
+        
+        // Create structured log entry
+        LogEntry entry;
+        
+        const char* levelStr = "UNKNOWN";
+        switch (level) {
+            case pers::LogLevel::Trace: levelStr = "TRACE"; break;
+            case pers::LogLevel::Debug: levelStr = "DEBUG"; break;
+            case pers::LogLevel::Info: levelStr = "INFO"; break;
+            case pers::LogLevel::TodoSomeday: levelStr = "TODO_SOMEDAY"; break;
+            case pers::LogLevel::Warning: levelStr = "WARNING"; break;
+            case pers::LogLevel::TodoOrDie: levelStr = "TODO_OR_DIE"; break;
+            case pers::LogLevel::Error: levelStr = "ERROR"; break;
+            case pers::LogLevel::Critical: levelStr = "CRITICAL"; break;
+        }
+        
+        // Format timestamp
+        auto time_t = std::chrono::system_clock::to_time_t(timestamp);
+        auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
+            timestamp.time_since_epoch()).count() % 1000;
+        std::tm tm_buf;
+#ifdef _WIN32
+        localtime_s(&tm_buf, &time_t);
+#else
+        localtime_r(&time_t, &tm_buf);
+#endif
+        
+        // Format: HH:MM:SS.mmm
+        char timeStr[20];
+        strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm_buf);
+        std::stringstream ss;
+        ss << timeStr << "." << std::setfill('0') << std::setw(3) << millis;
+        
+        entry.timestamp = ss.str();
+        entry.level = levelStr;
+        entry.category = category;
+        entry.message = message;
+        entry.file = source.file ? source.file : "";
+        entry.line = source.line;
+        entry.function = source.function ? source.function : "";
+        
+        logs->push_back(entry);
+    }
+};
+
+inline void ThreadLogCapture::begin(std::vector<LogEntry>* logs) {
+    std::lock_guard<std::mutex> lock(mutex());
+    if (!target()) {
+        if (activeCount()++ == 0) {
+            setCallbacks(&ThreadLogCapture::captureCallback);
+        }
+    }
+    target() = logs;
+}
+
+inline void ThreadLogCapture::end() {
+    std::lock_guard<std::mutex> lock(mutex());
+    if (!target()) {
+        return;
+    }
+    target() = nullptr;
+    if (--activeCount() == 0) {
+        setCallbacks(nullptr);
+    }
+}
+
 // Base class with common functionality
 class TestHandlerBase : public ITestHandler {
 protected:
     std::vector<LogEntry> _capturedLogs;
+    std::shared_ptr<SharedTestDevicePool> _sharedDevices;
     
     void setupLogCapture() {
         _capturedLogs.clear();
-        
-        auto captureCallback = [this](pers::LogLevel level, const std::string& category, 
-                                      const std::string& message, const pers::LogSource& source,
-                                      const std::chrono::system_clock::time_point& timestamp,
-                                      bool& skipLogging) {
-            // Create structured log entry
-            LogEntry entry;
-            
-            const char* levelStr = "UNKNOWN";
-            switch (level) {
-                case pers::LogLevel::Trace: levelStr = "TRACE"; break;
-                case pers::LogLevel::Debug: levelStr = "DEBUG"; break;
-                case pers::LogLevel::Info: levelStr = "INFO"; break;
-                case pers::LogLevel::TodoSomeday: levelStr = "TODO_SOMEDAY"; break;
-                case pers::LogLevel::Warning: levelStr = "WARNING"; break;
-                case pers::LogLevel::TodoOrDie: levelStr = "TODO_OR_DIE"; break;
-                case pers::LogLevel::Error: levelStr = "ERROR"; break;
-                case pers::LogLevel::Critical: levelStr = "CRITICAL"; break;
-            }
-            
-            // Format timestamp
-            auto time_t = std::chrono::system_clock::to_time_t(timestamp);
-            auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(
-                timestamp.time_since_epoch()).count() % 1000;
-            std::tm tm_buf;
-#ifdef _WIN32
-            localtime_s(&tm_buf, &time_t);
-#else
-            localtime_r(&time_t, &tm_buf);
-#endif
-            
-            // Format: HH:MM:SS.mmm
-            char timeStr[20];
-            strftime(timeStr, sizeof(timeStr), "%H:%M:%S", &tm_buf);
-            std::stringstream ss;
-            ss << timeStr << "." << std::setfill('0') << std::setw(3) << millis;
-            
-            entry.timestamp = ss.str();
-            entry.level = levelStr;
-            entry.category = category;
-            entry.message = message;
-            entry.file = source.file ? source.file : "";
-            entry.line = source.line;
-            entry.function = source.function ? source.function : "";
-            
-            _capturedLogs.push_back(entry);
-            skipLogging = false;
-        };
-        
-        // Register callbacks
-        pers::Logger::Instance().setCallback(pers::LogLevel::Trace, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Debug, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Info, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::TodoSomeday, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Warning, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::TodoOrDie, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Error, captureCallback);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Critical, captureCallback);
+        ThreadLogCapture::begin(&_capturedLogs);
     }
     
     void clearLogCallbacks() {
-        pers::Logger::Instance().setCallback(pers::LogLevel::Trace, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Debug, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Info, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::TodoSomeday, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Warning, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::TodoOrDie, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Error, nullptr);
-        pers::Logger::Instance().setCallback(pers::LogLevel::Critical, nullptr);
+        ThreadLogCapture::end();
+    }
+    
+    // Run op for the variation's warmup and measured iterations, recording
+    // each measured run into result.timing. op returns false to stop early.
+    template<typename Op>
+    bool measureTiming(const TimingExpectation& expectation, TestResult& result, Op&& op) {
+        result.timing = TimingResult();
+        result.timing.warmup = expectation.warmup;
+        
+        for (int i = 0; i < expectation.warmup; i++) {
+            if (!op()) {
+                return false;
+            }
+        }
+        
+        result.timing.samplesMs.reserve(expectation.iterations);
+        bool completed = true;
+        for (int i = 0; i < expectation.iterations; i++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            bool ok = op();
+            auto end = std::chrono::high_resolution_clock::now();
+            if (!ok) {
+                completed = false;
+                break;
+            }
+            result.timing.samplesMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        
+        computeTimingStats(result.timing);
+        return completed;
     }
     
     void transferLogsToResult(TestResult& result) {
@@ -108,6 +198,10 @@ protected:
     
 public:
     virtual ~TestHandlerBase() = default;
+    
+    void setSharedDevices(const std::shared_ptr<SharedTestDevicePool>& pool) override {
+        _sharedDevices = pool;
+    }
 };
 
 // Registry for test handlers
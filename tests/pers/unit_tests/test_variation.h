@@ -4,6 +4,9 @@
 #include <unordered_map>
 #include <any>
 #include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
 
 #include <iostream>
 namespace pers::tests {
@@ -24,6 +27,16 @@ struct ExpectedBehavior {
     std::unordered_map<std::string, std::string> numericChecks; // e.g., "maxBufferSize": ">=256"
 };
 
+// Timing expectations for performance regression tests ("timing" object)
+struct TimingExpectation {
+    int iterations = 0;         // Measured runs; 0 disables timing
+    int warmup = 0;             // Unmeasured runs before sampling starts
+    double p50BudgetMs = 0.0;   // Median budget, 0 = no budget
+    double p99BudgetMs = 0.0;   // Tail budget, 0 = no budget
+    
+    bool isEnabled() const { return iterations > 0; }
+};
+
 // Test variation with options and expected behavior
 struct TestVariation {
     int id;
@@ -33,6 +46,7 @@ struct TestVariation {
     std::unordered_map<std::string, std::any> executionDetails;  // execution_details object
     std::unordered_map<std::string, std::any> options;
     ExpectedBehavior expectedBehavior;
+    TimingExpectation timing;
 };
 
 // Test type definition
@@ -69,6 +83,19 @@ struct SourceLocation {
     }
 };
 
+// Per-iteration timings reported by a handler
+struct TimingResult {
+    std::vector<double> samplesMs;
+    int warmup = 0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double meanMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    
+    bool hasSamples() const { return !samplesMs.empty(); }
+};
+
 // Test execution result
 struct TestResult {
     bool passed;
@@ -80,12 +107,27 @@ struct TestResult {
     // Source code locations for handler execution path
     std::vector<SourceLocation> handlerSourceLocations;
     
+    // Timings when the variation declares a "timing" object
+    TimingResult timing;
+    
+    // When the runner executed the case, relative to the start of the run
+    double startOffsetMs = 0.0;
+    int worker = 0;  // 0 = main thread, 1.. = parallel workers
+    
     // Helper to add source location
     void addSourceLocation(const std::string& func, const std::string& file, int line) {
         handlerSourceLocations.push_back({func, file, line});
     }
 };
 
+// How the runner executed a session, saved with the results
+struct RunnerInfo {
+    bool parallel = false;
+    unsigned jobs = 1;
+    bool sharedDevice = false;
+    double wallTimeMs = 0.0;
+};
+
 // Helper to parse size strings like "1MB", "64KB", etc.
 inline size_t parseSizeString(const std::string& sizeStr) {
     size_t value = 0;
@@ -160,6 +202,42 @@ T getOption(const std::unordered_map<std::string, std::any>& options,
 }
 
 
+// Fill percentiles from samplesMs (nearest-rank)
+inline void computeTimingStats(TimingResult& timing) {
+    if (timing.samplesMs.empty()) {
+        return;
+    }
+    
+    std::vector<double> sorted = timing.samplesMs;
+    std::sort(sorted.begin(), sorted.end());
+    
+    auto percentile = [&sorted](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    };
+    
+    timing.p50Ms = percentile(0.50);
+    timing.p99Ms = percentile(0.99);
+    timing.meanMs = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    timing.minMs = sorted.front();
+    timing.maxMs = sorted.back();
+}
+
+// Compare timings against the budgets, returns a failure reason or empty string
+inline std::string checkTimingBudget(const TimingExpectation& expectation, const TimingResult& timing) {
+    std::string reason;
+    if (expectation.p50BudgetMs > 0.0 && timing.p50Ms > expectation.p50BudgetMs) {
+        reason = "p50 " + std::to_string(timing.p50Ms) + " ms exceeds budget " +
+                 std::to_string(expectation.p50BudgetMs) + " ms";
+    }
+    if (expectation.p99BudgetMs > 0.0 && timing.p99Ms > expectation.p99BudgetMs) {
+        if (!reason.empty()) reason += "; ";
+        reason += "p99 " + std::to_string(timing.p99Ms) + " ms exceeds budget " +
+                  std::to_string(expectation.p99BudgetMs) + " ms";
+    }
+    return reason;
+}
+
 // Helper to check numeric conditions
 inline bool checkNumericCondition(const std::string& condition, double actualValue) {
     if (condition.empty()) return true;
@@ -368,6 +368,9 @@ async function loadResults() {
         filteredResults = [...allResults];
         displayResults();
         
+        // Timing history is optional, older sessions have none
+        loadPerformanceHistory();
+        
         // Hide loading
         document.getElementById('loading').style.display = 'none';
     } catch (error) {
@@ -770,6 +773,11 @@ function displayResults() {
                     ${actualPropsHtml}
                 ` : ''}
                 
+                ${result.timing ? `
+                    <h4>Timing</h4>
+                    ${formatInputParameters(result.timing)}
+                ` : ''}
+                
                 ${result.failure_reason ? `
                     <h4>Failure Reason</h4>
                     <pre>${result.failure_reason}</pre>
@@ -2625,6 +2633,15 @@ document.addEventListener('DOMContentLoaded', () => {
             if (tabName === 'logs') {
                 createFullLogsView();
             }
+            
+            // Canvas has no layout while hidden, redraw once visible
+            if (tabName === 'performance') {
+                drawPerformanceChart();
+            }
+            if (tabName === 'live') {
+                connectTelemetry();
+                drawLiveCharts();
+            }
         });
     });
     
@@ -3905,6 +3922,308 @@ function hideObjectValueAutocomplete(input) {
     }
 }
 
+// Performance history across runs, keyed by test ID
+let perfHistory = new Map();
+
+async function loadPerformanceHistory() {
+    try {
+        const response = await fetch('/api/history');
+        if (!response.ok) {
+            return;
+        }
+        const history = await response.json();
+        
+        perfHistory = new Map();
+        (history.runs || []).forEach(run => {
+            (run.results || []).forEach(entry => {
+                if (!perfHistory.has(entry.id)) {
+                    perfHistory.set(entry.id, { label: `${entry.id} - ${entry.variationName}`, points: [] });
+                }
+                perfHistory.get(entry.id).points.push({ ...entry, timestamp: run.timestamp, session: run.session });
+            });
+        });
+        
+        const select = document.getElementById('perf-test-select');
+        if (perfHistory.size === 0) {
+            return;
+        }
+        select.innerHTML = '';
+        for (const [id, series] of perfHistory) {
+            const option = document.createElement('option');
+            option.value = id;
+            option.textContent = series.label;
+            select.appendChild(option);
+        }
+        select.onchange = () => {
+            drawPerformanceChart();
+            displayPerformanceTable();
+        };
+        displayPerformanceTable();
+    } catch (error) {
+        console.log('No performance history available');
+    }
+}
+
+function selectedPerfSeries() {
+    const id = document.getElementById('perf-test-select').value;
+    return perfHistory.get(id);
+}
+
+function displayPerformanceTable() {
+    const tbody = document.getElementById('perf-body');
+    const series = selectedPerfSeries();
+    tbody.innerHTML = '';
+    if (!series) {
+        return;
+    }
+    
+    // Newest run first
+    [...series.points].reverse().forEach(point => {
+        const row = document.createElement('tr');
+        row.innerHTML = `
+            <td>${escapeHtml(point.timestamp)}</td>
+            <td>${escapeHtml(point.session)}</td>
+            <td>${point.iterations}</td>
+            <td>${point.p50_ms.toFixed(3)}</td>
+            <td>${point.p99_ms.toFixed(3)}</td>
+            <td>${point.mean_ms.toFixed(3)}</td>
+            <td><span class="${point.passed ? 'status-passed' : 'status-failed'}">${point.passed ? 'PASS' : 'FAIL'}</span></td>
+        `;
+        tbody.appendChild(row);
+    });
+}
+
+function drawPerformanceChart() {
+    const canvas = document.getElementById('perf-chart');
+    const ctx = canvas.getContext('2d');
+    ctx.clearRect(0, 0, canvas.width, canvas.height);
+    
+    const series = selectedPerfSeries();
+    if (!series || series.points.length === 0) {
+        return;
+    }
+    
+    const points = series.points;
+    const pad = { left: 60, right: 20, top: 20, bottom: 40 };
+    const width = canvas.width - pad.left - pad.right;
+    const height = canvas.height - pad.top - pad.bottom;
+    
+    const last = points[points.length - 1];
+    const budgets = [last.p50_budget_ms, last.p99_budget_ms].filter(b => b > 0);
+    const maxValue = Math.max(...points.map(p => p.p99_ms), ...budgets) * 1.1 || 1;
+    
+    const x = i => pad.left + (points.length === 1 ? width / 2 : (i / (points.length - 1)) * width);
+    const y = v => pad.top + height - (v / maxValue) * height;
+    
+    // Axes and grid
+    ctx.strokeStyle = 'rgba(255, 255, 255, 0.15)';
+    ctx.fillStyle = '#a0aec0';
+    ctx.font = '12px sans-serif';
+    ctx.lineWidth = 1;
+    for (let i = 0; i <= 4; i++) {
+        const value = (maxValue / 4) * i;
+        ctx.beginPath();
+        ctx.moveTo(pad.left, y(value));
+        ctx.lineTo(pad.left + width, y(value));
+        ctx.stroke();
+        ctx.fillText(value.toFixed(2), 8, y(value) + 4);
+    }
+    ctx.fillText('ms', 8, pad.top - 6);
+    ctx.fillText(`${points.length} run(s)`, pad.left, canvas.height - 12);
+    
+    const drawBudget = (budget, color) => {
+        if (!(budget > 0)) return;
+        ctx.save();
+        ctx.setLineDash([6, 4]);
+        ctx.strokeStyle = color;
+        ctx.beginPath();
+        ctx.moveTo(pad.left, y(budget));
+        ctx.lineTo(pad.left + width, y(budget));
+        ctx.stroke();
+        ctx.restore();
+    };
+    
+    const drawLine = (key, color) => {
+        ctx.strokeStyle = color;
+        ctx.fillStyle = color;
+        ctx.lineWidth = 2;
+        ctx.beginPath();
+        points.forEach((p, i) => {
+            if (i === 0) ctx.moveTo(x(i), y(p[key]));
+            else ctx.lineTo(x(i), y(p[key]));
+        });
+        ctx.stroke();
+        points.forEach((p, i) => {
+            ctx.beginPath();
+            ctx.arc(x(i), y(p[key]), 3, 0, Math.PI * 2);
+            ctx.fill();
+        });
+    };
+    
+    drawBudget(last.p50_budget_ms, '#667eea');
+    drawBudget(last.p99_budget_ms, '#f6ad55');
+    drawLine('p50_ms', '#667eea');
+    drawLine('p99_ms', '#f6ad55');
+    
+    // Legend
+    ctx.fillStyle = '#667eea';
+    ctx.fillText('p50', pad.left + width - 80, pad.top + 4);
+    ctx.fillStyle = '#f6ad55';
+    ctx.fillText('p99', pad.left + width - 40, pad.top + 4);
+}
+
+// Live telemetry streamed by server.js from pers::TelemetryStream
+const LIVE_WINDOW = 240;  // Samples kept per chart, one minute at the default 250 ms
+const LIVE_COLORS = ['#667eea', '#f6ad55', '#68d391', '#fc8181', '#63b3ed', '#d6bcfa'];
+let liveSamples = [];
+let liveSocket = null;
+
+function connectTelemetry() {
+    if (liveSocket) {
+        return;
+    }
+    const status = document.getElementById('live-status');
+    const protocol = window.location.protocol === 'https:' ? 'wss' : 'ws';
+    liveSocket = new WebSocket(`${protocol}://${window.location.host}/telemetry`);
+    liveSocket.onopen = () => { status.textContent = 'Connected, waiting for samples'; };
+    liveSocket.onclose = () => {
+        status.textContent = 'Disconnected, retrying';
+        liveSocket = null;
+        setTimeout(connectTelemetry, 2000);
+    };
+    liveSocket.onmessage = event => {
+        JSON.parse(event.data).forEach(line => {
+            if (line.type === 'session') {
+                liveSamples = [];
+            } else if (line.type === 'sample') {
+                liveSamples.push(line);
+            }
+        });
+        if (liveSamples.length > LIVE_WINDOW + 1) {
+            liveSamples = liveSamples.slice(-(LIVE_WINDOW + 1));
+        }
+        updateLiveMetricSelect();
+        const last = liveSamples[liveSamples.length - 1];
+        if (last) {
+            status.textContent = `Sample ${last.seq} at ${last.t.toFixed(1)} s`;
+        }
+        if (document.getElementById('live-tab').classList.contains('active')) {
+            drawLiveCharts();
+        }
+    };
+}
+
+function updateLiveMetricSelect() {
+    const select = document.getElementById('live-metric-select');
+    const last = liveSamples[liveSamples.length - 1];
+    if (!last) {
+        return;
+    }
+    const names = Object.keys(last.metrics);
+    const existing = Array.from(select.options).map(option => option.value);
+    if (names.length === existing.length && names.every((name, i) => name === existing[i])) {
+        return;
+    }
+    const selected = select.value || (names.includes('pers_draw_calls_total') ? 'pers_draw_calls_total' : names[0]);
+    select.innerHTML = '';
+    names.forEach(name => {
+        const option = document.createElement('option');
+        option.value = name;
+        option.textContent = name;
+        select.appendChild(option);
+    });
+    select.value = selected;
+    select.onchange = drawLiveCharts;
+}
+
+// Counters become rates over each sample's dt; gauges are drawn as they are
+function liveMetricSeries(name) {
+    const isCounter = name.endsWith('_total');
+    const points = [];
+    for (let i = 1; i < liveSamples.length; i++) {
+        const sample = liveSamples[i];
+        const value = sample.metrics[name];
+        if (value === undefined) continue;
+        if (!isCounter) {
+            points.push(value);
+            continue;
+        }
+        const previous = liveSamples[i - 1].metrics[name] || 0;
+        points.push(sample.dt > 0 ? (value - previous) / sample.dt : 0);
+    }
+    return { points, unit: isCounter ? '/s' : '' };
+}
+
+function liveZoneSeries() {
+    const totals = new Map();
+    liveSamples.forEach(sample => (sample.zones || []).forEach(zone => {
+        totals.set(zone.name, (totals.get(zone.name) || 0) + zone.ms);
+    }));
+    const names = [...totals.keys()].sort((a, b) => totals.get(b) - totals.get(a)).slice(0, LIVE_COLORS.length);
+    return names.map(name => ({
+        name,
+        points: liveSamples.slice(1).map(sample => {
+            const zone = (sample.zones || []).find(z => z.name === name);
+            return zone && sample.dt > 0 ? zone.ms / sample.dt : 0;
+        })
+    }));
+}
+
+function drawLiveChart(canvas, series, unit) {
+    const ctx = canvas.getContext('2d');
+    ctx.clearRect(0, 0, canvas.width, canvas.height);
+    if (series.length === 0 || series.every(s => s.points.length === 0)) {
+        return;
+    }
+
+    const pad = { left: 70, right: 20, top: 20, bottom: 30 };
+    const width = canvas.width - pad.left - pad.right;
+    const height = canvas.height - pad.top - pad.bottom;
+    const maxValue = Math.max(...series.flatMap(s => s.points)) * 1.1 || 1;
+    const x = i => pad.left + (i / (LIVE_WINDOW - 1)) * width;
+    const y = v => pad.top + height - (v / maxValue) * height;
+
+    ctx.strokeStyle = 'rgba(255, 255, 255, 0.15)';
+    ctx.fillStyle = '#a0aec0';
+    ctx.font = '12px sans-serif';
+    ctx.lineWidth = 1;
+    for (let i = 0; i <= 4; i++) {
+        const value = (maxValue / 4) * i;
+        ctx.beginPath();
+        ctx.moveTo(pad.left, y(value));
+        ctx.lineTo(pad.left + width, y(value));
+        ctx.stroke();
+        ctx.fillText(value.toFixed(value < 10 ? 2 : 0), 8, y(value) + 4);
+    }
+    ctx.fillText(unit, 8, pad.top - 6);
+
+    // Newest sample at the right edge
+    series.forEach((s, index) => {
+        const offset = LIVE_WINDOW - s.points.length;
+        ctx.strokeStyle = LIVE_COLORS[index % LIVE_COLORS.length];
+        ctx.lineWidth = 2;
+        ctx.beginPath();
+        s.points.forEach((value, i) => {
+            if (i === 0) ctx.moveTo(x(offset + i), y(value));
+            else ctx.lineTo(x(offset + i), y(value));
+        });
+        ctx.stroke();
+        if (s.name) {
+            ctx.fillStyle = ctx.strokeStyle;
+            ctx.fillText(s.name, pad.left + 8, pad.top + 14 * (index + 1));
+        }
+    });
+}
+
+function drawLiveCharts() {
+    const name = document.getElementById('live-metric-select').value;
+    if (name) {
+        const metric = liveMetricSeries(name);
+        drawLiveChart(document.getElementById('live-metric-chart'), [{ name, points: metric.points }], metric.unit);
+    }
+    drawLiveChart(document.getElementById('live-zone-chart'), liveZoneSeries(), 'ms/s');
+}
+
 // Toggle log source details visibility
 function toggleLogSource(logId) {
     const sourceDetails = document.getElementById(logId);
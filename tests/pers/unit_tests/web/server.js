@@ -1,22 +1,22 @@
 const path = require('path');
 const fs = require('fs');
 
-// Custom module loader for express
-let express;
-try {
-    // Try to load express normally first
-    express = require('express');
-} catch (e) {
-    // If not found, use the path from environment variable
-    const nodeModulesPath = process.env.NODE_MODULES_PATH;
-    if (nodeModulesPath) {
-        const expressPath = path.join(nodeModulesPath.replace(/"/g, ''), 'express');
-        express = require(expressPath);
-    } else {
-        throw new Error('Cannot find express module. Please set NODE_MODULES_PATH environment variable.');
+// Custom module loader: node_modules first, then NODE_MODULES_PATH
+function loadModule(name) {
+    try {
+        return require(name);
+    } catch (e) {
+        const nodeModulesPath = process.env.NODE_MODULES_PATH;
+        if (nodeModulesPath) {
+            return require(path.join(nodeModulesPath.replace(/"/g, ''), name));
+        }
+        throw new Error(`Cannot find ${name} module. Please set NODE_MODULES_PATH environment variable.`);
     }
 }
 
+const express = loadModule('express');
+const WebSocket = loadModule('ws');
+
 const app = express();
 const PORT = 5000;
 
@@ -25,8 +25,17 @@ const resultPath = process.argv[2];
 const dataPath = resultPath || path.join(__dirname, '../../../../build/bin/Debug/test_results.json');
 const sessionId = resultPath ? path.basename(path.dirname(resultPath)) : 'current';
 
+// Performance history is shared by all sessions, one level above the session directory
+const historyPath = process.argv[3] || path.join(path.dirname(dataPath), '..', 'perf_history.json');
+
+// Live telemetry written by pers::TelemetryStream, tailed and pushed to /telemetry clients
+const telemetryPath = process.argv[4] || path.join(path.dirname(dataPath), 'pers_telemetry.ndjson');
+const TELEMETRY_POLL_MS = 250;
+const TELEMETRY_BACKLOG = 240;  // Samples sent to a client when it connects
+
 console.log('Starting server with session ID:', sessionId);
 console.log('Data path:', dataPath);
+console.log('Telemetry path:', telemetryPath);
 
 // Serve static files
 app.use(express.static(path.join(__dirname, 'public')));
@@ -46,6 +55,21 @@ app.get('/api/results', (req, res) => {
     }
 });
 
+// API endpoint to get timing history across runs
+app.get('/api/history', (req, res) => {
+    try {
+        if (fs.existsSync(historyPath)) {
+            const data = fs.readFileSync(historyPath, 'utf8');
+            res.json(JSON.parse(data));
+        } else {
+            res.json({ fileType: 'perf_history', runs: [] });
+        }
+    } catch (error) {
+        console.error('Error reading performance history:', error);
+        res.status(500).json({ error: 'Failed to read performance history' });
+    }
+});
+
 // API endpoint to get session info
 app.get('/api/session', (req, res) => {
     const absolutePath = path.resolve(dataPath);
@@ -60,7 +84,87 @@ app.get('/', (req, res) => {
     res.sendFile(path.join(__dirname, 'public', 'index.html'));
 });
 
-app.listen(PORT, () => {
+// Telemetry session line and most recent samples, for clients connecting mid-session
+let telemetrySession = null;
+let telemetryBacklog = [];
+let telemetryOffset = 0;
+let telemetryPartial = '';
+
+// API endpoint to get the buffered telemetry without a websocket
+app.get('/api/telemetry', (req, res) => {
+    res.json({ path: path.resolve(telemetryPath), session: telemetrySession, samples: telemetryBacklog });
+});
+
+const server = app.listen(PORT, () => {
     console.log(`Test results viewer running at http://localhost:${PORT}`);
     console.log('Press Ctrl+C to stop the server');
-});
\ No newline at end of file
+});
+
+const telemetrySocket = new WebSocket.Server({ server, path: '/telemetry' });
+
+telemetrySocket.on('connection', (client) => {
+    const lines = telemetrySession ? [telemetrySession, ...telemetryBacklog] : telemetryBacklog;
+    if (lines.length > 0) {
+        client.send(JSON.stringify(lines));
+    }
+});
+
+function broadcastTelemetry(lines) {
+    const message = JSON.stringify(lines);
+    telemetrySocket.clients.forEach(client => {
+        if (client.readyState === WebSocket.OPEN) {
+            client.send(message);
+        }
+    });
+}
+
+// Read lines appended since the last poll; a shorter file means a new session or a rollover
+function pollTelemetry() {
+    fs.stat(telemetryPath, (error, stats) => {
+        if (error) {
+            return;
+        }
+        if (stats.size < telemetryOffset) {
+            telemetryOffset = 0;
+            telemetryPartial = '';
+        }
+        if (stats.size === telemetryOffset) {
+            return;
+        }
+
+        const stream = fs.createReadStream(telemetryPath, { start: telemetryOffset, end: stats.size - 1, encoding: 'utf8' });
+        let text = telemetryPartial;
+        stream.on('data', chunk => { text += chunk; });
+        stream.on('end', () => {
+            telemetryOffset = stats.size;
+            const parts = text.split('\n');
+            telemetryPartial = parts.pop();
+
+            const lines = [];
+            parts.forEach(part => {
+                if (!part.trim()) return;
+                try {
+                    const line = JSON.parse(part);
+                    if (line.type === 'session') {
+                        telemetrySession = line;
+                        telemetryBacklog = [];
+                    } else {
+                        telemetryBacklog.push(line);
+                    }
+                    lines.push(line);
+                } catch (e) {
+                    console.error('Skipping malformed telemetry line');
+                }
+            });
+            if (telemetryBacklog.length > TELEMETRY_BACKLOG) {
+                telemetryBacklog = telemetryBacklog.slice(-TELEMETRY_BACKLOG);
+            }
+            if (lines.length > 0) {
+                broadcastTelemetry(lines);
+            }
+        });
+        stream.on('error', () => {});
+    });
+}
+
+setInterval(pollTelemetry, TELEMETRY_POLL_MS);
\ No newline at end of file